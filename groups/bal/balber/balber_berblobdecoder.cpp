@@ -0,0 +1,305 @@
+// balber_berblobdecoder.cpp                                          -*-C++-*-
+#include <balber_berblobdecoder.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(balber_berblobdecoder_cpp,"$Id$ $CSID$")
+
+#include <bsl_algorithm.h>
+#include <bsl_climits.h>
+
+// IMPLEMENTATION NOTES: A BER element (X.690, section 8.1) consists of
+// identifier octets, length octets, contents octets and, if the length is
+// indefinite, an end-of-contents marker (an element whose identifier and
+// length octets are both 0).  To find the end of a message, the scan needs to
+// descend only into constructed elements having an indefinite length, since
+// the end of any other element is known from its length octets: the state of
+// the scan therefore consists of the state of the element being scanned, and
+// of the number of enclosing elements having an indefinite length, with no
+// need for a stack.  The end of an element is detected when the number of its
+// content bytes still to be skipped reaches 0: an end-of-contents marker, and
+// an element of length 0, are therefore treated as elements whose contents
+// are skipped immediately.
+
+namespace BloombergLP {
+namespace balber {
+
+namespace {
+
+enum {
+    k_CONSTRUCTED_MASK     = 0x20,  // bit of the identifier octet indicating
+                                    // a constructed element
+
+    k_TAG_NUMBER_MASK      = 0x1F,  // bits of the identifier octet holding the
+                                    // tag number, or indicating a long-form
+                                    // tag number if all set
+
+    k_MORE_OCTETS_MASK     = 0x80,  // bit indicating that a tag octet is
+                                    // followed by another one, or that the
+                                    // initial length octet is not in short
+                                    // form
+
+    k_INDEFINITE_LENGTH    = 0x80,  // initial octet of an indefinite length
+
+    k_MAX_LENGTH_OCTETS    = 4,     // maximum number of subsequent length
+                                    // octets supported
+
+    k_END_OF_CONTENTS_SIZE = 2      // size of an end-of-contents marker
+};
+
+}  // close unnamed namespace
+
+                            // --------------------
+                            // class BerBlobDecoder
+                            // --------------------
+
+// PRIVATE MANIPULATORS
+int BerBlobDecoder::scan(const btlb::Blob& blob)
+{
+    // The state of the scan is kept in local variables while scanning, so
+    // that it need not be reloaded from memory after each octet is read.
+
+    State state           = d_state;
+    int   bufferIndex     = d_bufferIndex;
+    int   bufferOffset    = d_bufferOffset;
+    int   numBytesScanned = d_numBytesScanned;
+    int   depth           = d_depth;
+    bool  isEndOfContents = d_isEndOfContents;
+    bool  isConstructed   = d_isConstructed;
+    int   numLengthOctets = d_numLengthOctets;
+    int   length          = d_length;
+    int   messageLength   = d_messageLength;
+
+    const int numDataBuffers = blob.numDataBuffers();
+
+    const unsigned char *data         = 0;
+    int                  bufferLength = 0;
+    if (bufferIndex < numDataBuffers) {
+        data         = reinterpret_cast<const unsigned char *>(
+                                              blob.buffer(bufferIndex).data());
+        bufferLength = bufferIndex == numDataBuffers - 1
+                       ? blob.lastDataBufferLength()
+                       : blob.buffer(bufferIndex).size();
+    }
+
+    while (e_ERROR != state && e_COMPLETE != state) {
+        if (e_CONTENTS == state) {
+            // Skip the contents without reading them.
+
+            const int numBytes = bsl::min(bufferLength - bufferOffset, length);
+
+            bufferOffset    += numBytes;
+            numBytesScanned += numBytes;
+            length          -= numBytes;
+
+            if (0 == length) {
+                // This is the end of the element.
+
+                if (isEndOfContents) {
+                    --depth;
+                }
+
+                if (0 == depth) {
+                    messageLength = numBytesScanned;
+                    state         = e_COMPLETE;
+                    break;
+                }
+                state = e_IDENTIFIER;
+            }
+        }
+
+        if (bufferOffset == bufferLength) {
+            if (bufferIndex >= numDataBuffers - 1) {
+                break;
+            }
+
+            ++bufferIndex;
+            bufferOffset = 0;
+            data         = reinterpret_cast<const unsigned char *>(
+                                              blob.buffer(bufferIndex).data());
+            bufferLength = bufferIndex == numDataBuffers - 1
+                           ? blob.lastDataBufferLength()
+                           : blob.buffer(bufferIndex).size();
+            continue;
+        }
+
+        const unsigned char octet = data[bufferOffset++];
+        ++numBytesScanned;
+
+        switch (state) {
+          case e_IDENTIFIER: {
+            isEndOfContents = 0 == octet && 0 < depth;
+            isConstructed   = 0 != (octet & k_CONSTRUCTED_MASK);
+            state           = k_TAG_NUMBER_MASK == (octet & k_TAG_NUMBER_MASK)
+                              ? e_TAG_NUMBER
+                              : e_LENGTH;
+            continue;
+          }
+          case e_TAG_NUMBER: {
+            if (0 == (octet & k_MORE_OCTETS_MASK)) {
+                state = e_LENGTH;
+            }
+            continue;
+          }
+          case e_LENGTH: {
+            if (isEndOfContents) {
+                if (0 != octet) {
+                    state = e_ERROR;
+                }
+                else {
+                    length = 0;
+                    state  = e_CONTENTS;
+                }
+                continue;
+            }
+
+            if (k_INDEFINITE_LENGTH == octet) {
+                if (!isConstructed || depth >= d_maxDepth) {
+                    state = e_ERROR;
+                }
+                else {
+                    ++depth;
+                    state = e_IDENTIFIER;
+                }
+                continue;
+            }
+
+            if (octet & k_MORE_OCTETS_MASK) {
+                numLengthOctets = octet & ~k_MORE_OCTETS_MASK;
+                length          = 0;
+                state           = k_MAX_LENGTH_OCTETS < numLengthOctets
+                                  ? e_ERROR
+                                  : e_LENGTH_OCTETS;
+                continue;
+            }
+
+            length = octet;
+          } break;
+          case e_LENGTH_OCTETS: {
+            if (length > (INT_MAX >> 8)) {
+                state = e_ERROR;
+                continue;
+            }
+
+            length = (length << 8) | octet;
+            if (0 != --numLengthOctets) {
+                continue;
+            }
+          } break;
+          default: {
+            BSLS_ASSERT_OPT(!"Unreachable");
+          }
+        }
+
+        // The length octets of a definite-length element are complete.
+
+        if (length > INT_MAX - numBytesScanned) {
+            state = e_ERROR;
+            continue;
+        }
+
+        if (0 == depth) {
+            messageLength = numBytesScanned + length;
+        }
+        state = e_CONTENTS;
+    }
+
+    d_state           = state;
+    d_bufferIndex     = bufferIndex;
+    d_bufferOffset    = bufferOffset;
+    d_numBytesScanned = numBytesScanned;
+    d_depth           = depth;
+    d_isEndOfContents = isEndOfContents;
+    d_isConstructed   = isConstructed;
+    d_numLengthOctets = numLengthOctets;
+    d_length          = length;
+    d_messageLength   = messageLength;
+
+    return e_COMPLETE == state ? 0
+         : e_ERROR    == state ? -1
+         :                       1;
+}
+
+// CREATORS
+BerBlobDecoder::BerBlobDecoder(bslma::Allocator *basicAllocator)
+: d_decoder(0, basicAllocator)
+, d_maxDepth(BerDecoderOptions::DEFAULT_MAX_DEPTH)
+{
+    reset();
+}
+
+BerBlobDecoder::BerBlobDecoder(const BerDecoderOptions *options,
+                               bslma::Allocator        *basicAllocator)
+: d_decoder(options, basicAllocator)
+, d_maxDepth(options ? options->maxDepth()
+                     : BerDecoderOptions::DEFAULT_MAX_DEPTH)
+{
+    reset();
+}
+
+// MANIPULATORS
+void BerBlobDecoder::reset()
+{
+    d_state           = e_IDENTIFIER;
+    d_bufferIndex     = 0;
+    d_bufferOffset    = 0;
+    d_numBytesScanned = 0;
+    d_depth           = 0;
+    d_isEndOfContents = false;
+    d_isConstructed   = false;
+    d_numLengthOctets = 0;
+    d_length          = 0;
+    d_messageLength   = -1;
+}
+
+// ACCESSORS
+int BerBlobDecoder::numBytesNeeded() const
+{
+    const int numEndOfContentsBytes = d_depth * k_END_OF_CONTENTS_SIZE;
+
+    switch (d_state) {
+      case e_IDENTIFIER: {
+        // At least an identifier octet and a length octet, which may be those
+        // of an end-of-contents marker already accounted for.
+
+        return bsl::max(numEndOfContentsBytes, 2);                    // RETURN
+      }
+      case e_TAG_NUMBER: {
+        return 2 + numEndOfContentsBytes;                             // RETURN
+      }
+      case e_LENGTH: {
+        // The identifier octet of an end-of-contents marker has already been
+        // scanned.
+
+        return d_isEndOfContents ? numEndOfContentsBytes - 1
+                                 : numEndOfContentsBytes + 1;         // RETURN
+      }
+      case e_LENGTH_OCTETS: {
+        return d_numLengthOctets + numEndOfContentsBytes;             // RETURN
+      }
+      case e_CONTENTS: {
+        return d_length + numEndOfContentsBytes;                      // RETURN
+      }
+      default: {
+        return 0;                                                     // RETURN
+      }
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
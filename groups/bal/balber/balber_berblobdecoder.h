@@ -0,0 +1,403 @@
+// balber_berblobdecoder.h                                            -*-C++-*-
+#ifndef INCLUDED_BALBER_BERBLOBDECODER
+#define INCLUDED_BALBER_BERBLOBDECODER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a resumable BER decoder reading messages from a blob.
+//
+//@CLASSES:
+//  balber::BerBlobDecoder: incremental BER decoder over 'btlb::Blob' data
+//
+//@SEE_ALSO: balber_berdecoder, btlb_blob, btlmt_channelpool
+//
+//@DESCRIPTION: This component provides a mechanism, 'balber::BerBlobDecoder',
+// that decodes a stream of BER-encoded messages (see {'balber_berdecoder'})
+// arriving, possibly in fragments, in a 'btlb::Blob', such as the blob
+// supplied to the blob-based read callback of a 'btlmt::ChannelPool'.
+//
+// A 'balber::BerDecoder' reads its input from a 'bsl::streambuf' and expects
+// the whole message to be available: a partially received message causes the
+// decoding to fail, and the work done so far is lost.  Clients receiving
+// messages in 'btlb::Blob' chunks therefore typically wait until "enough"
+// data has arrived, according to some framing protocol, and then copy the
+// data into a contiguous buffer before decoding it.  A 'BerBlobDecoder'
+// removes the need for both the framing protocol and the copy:
+//
+//: o Each call to 'decode' first *scans* the data available in the blob to
+//:   determine whether it holds a complete message.  Only the
+//:   identifier-and-length headers of the BER elements are examined; the
+//:   contents of primitive elements, and of constructed elements having a
+//:   definite length, are skipped by offset arithmetic, without being read.
+//:
+//: o If the message is incomplete, 'decode' returns a positive value, having
+//:   retained the state of the scan, so that the next call resumes where this
+//:   one stopped: every byte of a message is scanned exactly once, however
+//:   many fragments the message arrives in.  'numBytesNeeded' then reports the
+//:   (minimum) number of additional bytes required to complete the message,
+//:   and 'messageLength' reports its total length as soon as it is known.
+//:
+//: o Once the message is complete, it is decoded by a 'balber::BerDecoder'
+//:   reading *directly* from the buffers of the blob (through a
+//:   'bdlsb::FixedMemInStreamBuf' if the message is held by the first buffer
+//:   of the blob, and through a 'btlb::InBlobStreamBuf' otherwise), and is
+//:   then removed from the front of the blob.
+//
+// Note that the *decoding* of a message into an object of a 'bdlat'-compatible
+// type is not itself resumable, since 'balber::BerDecoder' recursively visits
+// the object being decoded; it is the detection of message boundaries that
+// proceeds incrementally.
+//
+///Message Length
+///--------------
+// The total length of a message is known once the length octets of its
+// outermost element have been scanned, provided that element has a definite
+// length.  Constructed elements encoded by 'balber::BerEncoder' have an
+// *indefinite* length, however, and are terminated by an end-of-contents
+// marker: the total length of such a message is known only once the message
+// has been completely received.  In that case, 'numBytesNeeded' reports a
+// lower bound computed from the element being scanned and the end-of-contents
+// markers still expected.  In either case, waiting for at least
+// 'numBytesNeeded' more bytes before calling 'decode' again guarantees that
+// no call to 'decode' is wasted, and is suitable for the 'numNeeded' value
+// returned by a 'btlmt::ChannelPool' blob-based read callback.
+//
+///Modifying the Blob Between Calls
+///--------------------------------
+// The state retained by a 'BerBlobDecoder' after a call to 'decode' returning
+// a positive value refers to the data in the blob supplied to that call.  The
+// next call to 'decode' must supply the same blob, and the blob must not have
+// been modified in the interim, except by appending data to it (e.g., by
+// 'btlb::Blob::appendDataBuffer', or by increasing its length to include data
+// written into its last data buffer or into its capacity).  To start decoding
+// from different data, call 'reset' first.
+//
+///Thread Safety
+///-------------
+// 'balber::BerBlobDecoder' is *const* *thread-safe*, but not *thread-safe*:
+// a given object should be used by at most one thread at a time.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Decoding Requests as They Arrive
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a server receives, on each of its connections, a stream of
+// BER-encoded 'balb::SimpleRequest' objects (a 'bdlat'-compatible sequence
+// type), in fragments whose boundaries have no relation to those of the
+// messages.
+//
+// First, we encode a request, and split its encoding in two fragments, to
+// simulate its transmission:
+//..
+//  balb::SimpleRequest request;
+//  request.data()           = "Hello, world!";
+//  request.responseLength() = 1024;
+//
+//  bdlsb::MemOutStreamBuf osb;
+//  balber::BerEncoder     encoder;
+//  int                    rc = encoder.encode(&osb, request);
+//  assert(0 == rc);
+//
+//  const char *encoding = osb.data();
+//  const int   length   = static_cast<int>(osb.length());
+//  const int   split    = length / 2;
+//..
+// Then, we create a blob, in which data will be received, and a decoder,
+// which we will use for all messages received on this connection:
+//..
+//  btlb::PooledBlobBufferFactory factory(8);
+//  btlb::Blob                    blob(&factory);
+//
+//  balber::BerBlobDecoder decoder;
+//  balb::SimpleRequest    received;
+//..
+// Next, we simulate the arrival of the first fragment, and attempt to decode
+// a request: 'decode' returns a positive value, indicating that the message
+// is incomplete, and reports how many more bytes are required at a minimum:
+//..
+//  btlb::BlobUtil::append(&blob, encoding, split);
+//
+//  rc = decoder.decode(&received, &blob);
+//  assert(0 <  rc);
+//  assert(0 <  decoder.numBytesNeeded());
+//  assert(decoder.numBytesNeeded() <= length - split);
+//  assert(split == blob.length());
+//..
+// Then, the rest of the message arrives, and 'decode' resumes scanning from
+// where it stopped, finds the message to be complete, and decodes it:
+//..
+//  btlb::BlobUtil::append(&blob, encoding + split, length - split);
+//
+//  rc = decoder.decode(&received, &blob);
+//  assert(0 == rc);
+//  assert(request == received);
+//..
+// Finally, we observe that the message has been removed from the blob, and
+// that the decoder is ready for the next one:
+//..
+//  assert(0 == blob.length());
+//  assert(-1 == decoder.messageLength());
+//..
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BALBER_BERDECODER
+#include <balber_berdecoder.h>
+#endif
+
+#ifndef INCLUDED_BALBER_BERDECODEROPTIONS
+#include <balber_berdecoderoptions.h>
+#endif
+
+#ifndef INCLUDED_BDLSB_FIXEDMEMINSTREAMBUF
+#include <bdlsb_fixedmeminstreambuf.h>
+#endif
+
+#ifndef INCLUDED_BTLB_BLOB
+#include <btlb_blob.h>
+#endif
+
+#ifndef INCLUDED_BTLB_BLOBSTREAMBUF
+#include <btlb_blobstreambuf.h>
+#endif
+
+#ifndef INCLUDED_BTLB_BLOBUTIL
+#include <btlb_blobutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+namespace BloombergLP {
+namespace balber {
+
+                            // ====================
+                            // class BerBlobDecoder
+                            // ====================
+
+class BerBlobDecoder {
+    // This class provides a mechanism for decoding a stream of BER-encoded
+    // messages received, in arbitrary fragments, in a 'btlb::Blob'.  The
+    // boundaries of messages are found by incrementally scanning the headers
+    // of their BER elements, and complete messages are decoded, without being
+    // copied, by a 'balber::BerDecoder'.
+
+    // PRIVATE TYPES
+    enum State {
+        e_IDENTIFIER,     // expecting the identifier octet of an element
+        e_TAG_NUMBER,     // expecting a subsequent (long-form) tag octet
+        e_LENGTH,         // expecting the initial length octet
+        e_LENGTH_OCTETS,  // expecting a subsequent (long-form) length octet
+        e_CONTENTS,       // skipping the contents of an element
+        e_COMPLETE,       // a complete message has been scanned
+        e_ERROR           // the data scanned is not valid BER
+    };
+
+    // DATA
+    BerDecoder  d_decoder;          // decoder of complete messages
+
+    int         d_maxDepth;         // maximum number of nested elements
+                                    // having an indefinite length
+
+    State       d_state;            // state of the scan
+
+    int         d_bufferIndex;      // index, in the blob, of the buffer
+                                    // holding the next byte to scan
+
+    int         d_bufferOffset;     // offset, in that buffer, of the next
+                                    // byte to scan
+
+    int         d_numBytesScanned;  // number of bytes of the current message
+                                    // scanned so far
+
+    int         d_depth;            // number of enclosing elements having an
+                                    // indefinite length, and not yet closed
+
+    bool        d_isEndOfContents;  // 'true' if the element being scanned
+                                    // may be an end-of-contents marker
+
+    bool        d_isConstructed;    // 'true' if the element being scanned is
+                                    // constructed
+
+    int         d_numLengthOctets;  // number of length octets still expected
+
+    int         d_length;           // length of the element being scanned,
+                                    // or number of its content bytes still
+                                    // to be skipped
+
+    int         d_messageLength;    // total length of the current message,
+                                    // or -1 if not (yet) known
+
+  private:
+    // NOT IMPLEMENTED
+    BerBlobDecoder(const BerBlobDecoder&);             // = delete
+    BerBlobDecoder& operator=(const BerBlobDecoder&);  // = delete
+
+    // PRIVATE MANIPULATORS
+    int scan(const btlb::Blob& blob);
+        // Resume scanning the specified 'blob' for the end of the current
+        // message.  Return 0 if 'blob' holds a complete message, a positive
+        // value if more data is required, and a negative value if the data in
+        // 'blob' is not valid BER.
+
+  public:
+    // CREATORS
+    explicit BerBlobDecoder(bslma::Allocator *basicAllocator = 0);
+    explicit BerBlobDecoder(const BerDecoderOptions *options,
+                            bslma::Allocator        *basicAllocator = 0);
+        // Create a decoder of BER-encoded messages received in a
+        // 'btlb::Blob'.  Optionally specify 'options' controlling the
+        // decoding of messages.  If 'options' is 0 or not specified, default
+        // options are used.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless
+        // 'options', if specified and not 0, remains valid for the lifetime
+        // of this object.
+
+    //! ~BerBlobDecoder() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    template <class TYPE>
+    int decode(TYPE *object, btlb::Blob *blob);
+        // Decode into the specified 'object' the BER-encoded message at the
+        // front of the specified 'blob', if 'blob' holds the complete
+        // message, and remove the message from 'blob'.  Return 0 on success, a
+        // positive value if 'blob' does not (yet) hold a complete message, and
+        // a negative value if the data in 'blob' is not valid BER or if the
+        // message could not be decoded into 'object'.  If a positive value is
+        // returned, neither 'object' nor 'blob' is modified, and
+        // 'numBytesNeeded' reports the minimum number of bytes that must be
+        // appended to 'blob' for the message to become complete.  If the
+        // message is complete but cannot be decoded into 'object', the message
+        // is nevertheless removed from 'blob', and the value of 'object' is
+        // unspecified.  If the data in 'blob' is not valid BER, 'blob' is not
+        // modified, and subsequent calls fail until 'reset' is called.  The
+        // behavior is undefined unless, if the previous call to 'decode'
+        // returned a positive value, 'blob' is the blob supplied to that call
+        // and has since been modified only by appending data to it.  Note that
+        // 'blob' may hold more than one message, in which case only the first
+        // is decoded.
+
+    void reset();
+        // Reset this decoder to its initial state, discarding the state of
+        // any partial scan, so that the next call to 'decode' starts scanning
+        // from the front of the blob supplied to that call.
+
+    // ACCESSORS
+    const BerDecoderOptions *decoderOptions() const;
+        // Return the address of the options supplied at construction, or 0
+        // if no options were supplied.
+
+    bslstl::StringRef loggedMessages() const;
+        // Return a string containing the messages logged by the underlying
+        // 'balber::BerDecoder' while decoding the most recent complete
+        // message.
+
+    int messageLength() const;
+        // Return the total length, in bytes, of the message being scanned,
+        // if known, and -1 otherwise.  Note that the length of a message
+        // whose outermost element has an indefinite length is known only once
+        // the whole message has been received.
+
+    int numBytesNeeded() const;
+        // Return the minimum number of bytes that must be appended to the
+        // blob supplied to the last call to 'decode' for the message being
+        // scanned to become complete, if that call returned a positive value.
+        // Return 0 if the data scanned is not valid BER.  Note that the value
+        // returned is exact if 'messageLength' does not return -1, and is 2
+        // (the size of the smallest BER element) if no part of a message has
+        // been scanned.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                            // --------------------
+                            // class BerBlobDecoder
+                            // --------------------
+
+// MANIPULATORS
+template <class TYPE>
+int BerBlobDecoder::decode(TYPE *object, btlb::Blob *blob)
+{
+    BSLS_ASSERT(object);
+    BSLS_ASSERT(blob);
+
+    int rc = scan(*blob);
+    if (0 != rc) {
+        return rc;                                                    // RETURN
+    }
+
+    const int length = d_messageLength;
+
+    const btlb::BlobBuffer& first = blob->buffer(0);
+    if (length <= first.size()) {
+        // The message is held by the first buffer: decode it in place.
+
+        bdlsb::FixedMemInStreamBuf streamBuf(first.data(), length);
+        rc = d_decoder.decode(&streamBuf, object);
+    }
+    else {
+        btlb::InBlobStreamBuf streamBuf(blob);
+        rc = d_decoder.decode(&streamBuf, object);
+    }
+
+    btlb::BlobUtil::erase(blob, 0, length);
+    reset();
+
+    return 0 == rc ? 0 : -1;
+}
+
+// ACCESSORS
+inline
+const BerDecoderOptions *BerBlobDecoder::decoderOptions() const
+{
+    return d_decoder.decoderOptions();
+}
+
+inline
+bslstl::StringRef BerBlobDecoder::loggedMessages() const
+{
+    return d_decoder.loggedMessages();
+}
+
+inline
+int BerBlobDecoder::messageLength() const
+{
+    return d_messageLength;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
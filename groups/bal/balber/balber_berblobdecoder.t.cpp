@@ -0,0 +1,958 @@
+// balber_berblobdecoder.t.cpp                                        -*-C++-*-
+#include <balber_berblobdecoder.h>
+
+#include <balber_berencoder.h>
+
+#include <balb_testmessages.h>                   // for testing only
+
+#include <btlb_blobutil.h>
+#include <btlb_pooledblobbufferfactory.h>
+
+#include <bdlsb_fixedmeminstreambuf.h>
+#include <bdlsb_memoutstreambuf.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_testallocator.h>
+
+#include <bsls_stopwatch.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_climits.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a mechanism decoding BER-encoded messages from
+// a 'btlb::Blob'.  The decoding itself is delegated to 'balber::BerDecoder',
+// so we concentrate on the detection of message boundaries: we feed encoded
+// messages to the decoder in fragments of various sizes, in blobs having
+// buffers of various sizes, and verify that the decoder reports incomplete
+// messages, and the number of bytes they need, correctly, and decodes and
+// removes complete messages.  We then verify that invalid data is detected.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 1] explicit BerBlobDecoder(Allocator *);
+// [ 4] explicit BerBlobDecoder(const BerDecoderOptions *, Allocator *);
+//
+// MANIPULATORS
+// [ 1] int decode(TYPE *, btlb::Blob *);
+// [ 4] void reset();
+//
+// ACCESSORS
+// [ 4] const BerDecoderOptions *decoderOptions() const;
+// [ 4] bslstl::StringRef loggedMessages() const;
+// [ 2] int messageLength() const;
+// [ 2] int numBytesNeeded() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 2] DECODING FRAGMENTED MESSAGES
+// [ 3] DECODING DATA WRITTEN INTO THE BLOB
+// [ 4] INVALID DATA
+// [ 5] USAGE EXAMPLE
+// [-1] COPY-THEN-DECODE BENCHMARK
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef balber::BerBlobDecoder Obj;
+
+static int verbose;
+static int veryVerbose;
+static int veryVeryVerbose;
+
+// ============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+template <class TYPE>
+bsl::string encode(const TYPE& object)
+    // Return the BER encoding of the specified 'object'.
+{
+    bdlsb::MemOutStreamBuf osb;
+    balber::BerEncoder     encoder;
+
+    int rc = encoder.encode(&osb, object);
+    ASSERT(0 == rc);
+
+    return bsl::string(osb.data(), osb.length());
+}
+
+balb::SimpleRequest makeRequest(int dataLength, int responseLength)
+    // Return a request having a 'data' attribute of the specified
+    // 'dataLength' and the specified 'responseLength'.
+{
+    balb::SimpleRequest request;
+    request.data().resize(dataLength);
+    for (int i = 0; i < dataLength; ++i) {
+        request.data()[i] = static_cast<char>('a' + i % 26);
+    }
+    request.responseLength() = responseLength;
+    return request;
+}
+
+template <class TYPE>
+void testFragmented(int          line,
+                    const TYPE&  expected,
+                    int          bufferSize,
+                    int          fragmentSize,
+                    bool         isLengthDefinite)
+    // Encode the specified 'expected' object, feed the encoding, in fragments
+    // of the specified 'fragmentSize', to a 'balber::BerBlobDecoder' through
+    // a blob having buffers of the specified 'bufferSize', followed by a
+    // second copy of the encoding, and verify that the decoder reports each
+    // incomplete message and decodes each complete one as expected.  Use the
+    // specified 'line' and 'isLengthDefinite' (indicating whether the
+    // outermost element of the encoding has a definite length) in reporting
+    // errors.
+{
+    const bsl::string ENCODING = encode(expected);
+    const int         LENGTH   = static_cast<int>(ENCODING.length());
+    const bsl::string STREAM   = ENCODING + ENCODING;
+
+    btlb::PooledBlobBufferFactory factory(bufferSize);
+    btlb::Blob                    blob(&factory);
+
+    Obj  mX;  const Obj& X = mX;
+    TYPE object;
+
+    ASSERTV(line, 2 == X.numBytesNeeded());
+    ASSERTV(line, -1 == X.messageLength());
+
+    int numDecoded  = 0;
+    int numConsumed = 0;
+    for (int offset = 0; offset < static_cast<int>(STREAM.length()); ) {
+        const int numBytes = bsl::min(
+                               fragmentSize,
+                               static_cast<int>(STREAM.length()) - offset);
+        btlb::BlobUtil::append(&blob, STREAM.data() + offset, numBytes);
+        offset += numBytes;
+
+        while (0 < blob.length()) {
+            const int numAvailable = blob.length();
+            const int numMissing   = LENGTH - numAvailable;
+
+            int rc = mX.decode(&object, &blob);
+
+            if (0 < numMissing) {
+                ASSERTV(line, bufferSize, fragmentSize, rc, 0 < rc);
+                ASSERTV(line, numAvailable == blob.length());
+                ASSERTV(line,
+                        numMissing,
+                        X.numBytesNeeded(),
+                        0 < X.numBytesNeeded());
+                ASSERTV(line,
+                        numMissing,
+                        X.numBytesNeeded(),
+                        X.numBytesNeeded() <= numMissing);
+                if (-1 != X.messageLength()) {
+                    ASSERTV(line, isLengthDefinite);
+                    ASSERTV(line, LENGTH, X.messageLength(),
+                            LENGTH == X.messageLength());
+                    ASSERTV(line, numMissing == X.numBytesNeeded());
+                }
+                else {
+                    ASSERTV(line,
+                            numAvailable,
+                            !isLengthDefinite || numAvailable < 6);
+                }
+                break;
+            }
+
+            ASSERTV(line, bufferSize, fragmentSize, rc, 0 == rc);
+            ASSERTV(line, expected == object);
+            ASSERTV(line, numAvailable - LENGTH == blob.length());
+            ASSERTV(line, -1 == X.messageLength());
+            ASSERTV(line, 2 == X.numBytesNeeded());
+
+            object = TYPE();
+            ++numDecoded;
+            numConsumed += LENGTH;
+        }
+    }
+
+    ASSERTV(line, bufferSize, fragmentSize, numDecoded, 2 == numDecoded);
+    ASSERTV(line, 2 * LENGTH == numConsumed);
+}
+
+// ============================================================================
+//                       HELPER FUNCTIONS FOR BENCHMARK
+// ----------------------------------------------------------------------------
+
+namespace TEST_CASE_BENCHMARK {
+
+void receive(btlb::Blob         *blob,
+             const bsl::string&  encoding,
+             int                 offset,
+             int                 fragmentSize)
+    // Append to the specified 'blob' the bytes of the specified 'encoding'
+    // starting at the specified 'offset', up to the specified 'fragmentSize'.
+{
+    const int numBytes = bsl::min(
+                            fragmentSize,
+                            static_cast<int>(encoding.size()) - offset);
+    btlb::BlobUtil::append(blob, encoding.data() + offset, numBytes);
+}
+
+double measureCopyThenDecode(const balb::SimpleRequest& expected,
+                             const bsl::string&         encoding,
+                             int                        bufferSize,
+                             int                        fragmentSize,
+                             int                        numMessages)
+    // Return the user time taken to decode the specified 'numMessages'
+    // copies of the specified 'encoding' of the specified 'expected' request,
+    // received in fragments of the specified 'fragmentSize' in a blob having
+    // buffers of the specified 'bufferSize', by copying the data received so
+    // far into a contiguous buffer and attempting to decode it, after each
+    // fragment.
+{
+    btlb::PooledBlobBufferFactory factory(bufferSize);
+    balber::BerDecoder            decoder;
+    bsl::vector<char>             buffer;
+    balb::SimpleRequest           request;
+    const int                     length =
+                                         static_cast<int>(encoding.size());
+
+    bsls::Stopwatch stopwatch;
+    stopwatch.start(true);
+
+    for (int i = 0; i < numMessages; ++i) {
+        btlb::Blob blob(&factory);
+
+        int rc = -1;
+        for (int offset = 0; 0 != rc && offset < length; ) {
+            receive(&blob, encoding, offset, fragmentSize);
+            offset = blob.length();
+
+            buffer.resize(blob.length());
+            btlb::BlobUtil::copy(&buffer[0], blob, 0, blob.length());
+
+            bdlsb::FixedMemInStreamBuf isb(&buffer[0], buffer.size());
+            rc = decoder.decode(&isb, &request);
+        }
+        ASSERT(0 == rc);
+
+        btlb::BlobUtil::erase(&blob, 0, length);
+    }
+
+    stopwatch.stop();
+
+    ASSERT(expected == request);
+    return stopwatch.accumulatedUserTime();
+}
+
+double measureBlobDecoder(const balb::SimpleRequest& expected,
+                          const bsl::string&         encoding,
+                          int                        bufferSize,
+                          int                        fragmentSize,
+                          int                        numMessages)
+    // Return the user time taken to decode the specified 'numMessages'
+    // copies of the specified 'encoding' of the specified 'expected' request,
+    // received in fragments of the specified 'fragmentSize' in a blob having
+    // buffers of the specified 'bufferSize', using a
+    // 'balber::BerBlobDecoder'.
+{
+    btlb::PooledBlobBufferFactory factory(bufferSize);
+    balber::BerBlobDecoder        decoder;
+    balb::SimpleRequest           request;
+    const int                     length =
+                                         static_cast<int>(encoding.size());
+
+    bsls::Stopwatch stopwatch;
+    stopwatch.start(true);
+
+    for (int i = 0; i < numMessages; ++i) {
+        btlb::Blob blob(&factory);
+
+        int rc = -1;
+        for (int offset = 0; 0 != rc && offset < length; ) {
+            receive(&blob, encoding, offset, fragmentSize);
+            offset = blob.length();
+
+            rc = decoder.decode(&request, &blob);
+        }
+        ASSERT(0 == rc);
+    }
+
+    stopwatch.stop();
+
+    ASSERT(expected == request);
+    return stopwatch.accumulatedUserTime();
+}
+
+}  // close namespace TEST_CASE_BENCHMARK
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    verbose = argc > 2;
+    veryVerbose = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Decoding Requests as They Arrive
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a server receives, on each of its connections, a stream of
+// BER-encoded 'balb::SimpleRequest' objects (a 'bdlat'-compatible sequence
+// type), in fragments whose boundaries have no relation to those of the
+// messages.
+//
+// First, we encode a request, and split its encoding in two fragments, to
+// simulate its transmission:
+//..
+    balb::SimpleRequest request;
+    request.data()           = "Hello, world!";
+    request.responseLength() = 1024;
+
+    bdlsb::MemOutStreamBuf osb;
+    balber::BerEncoder     encoder;
+    int                    rc = encoder.encode(&osb, request);
+    ASSERT(0 == rc);
+
+    const char *encoding = osb.data();
+    const int   length   = static_cast<int>(osb.length());
+    const int   split    = length / 2;
+//..
+// Then, we create a blob, in which data will be received, and a decoder,
+// which we will use for all messages received on this connection:
+//..
+    btlb::PooledBlobBufferFactory factory(8);
+    btlb::Blob                    blob(&factory);
+
+    balber::BerBlobDecoder decoder;
+    balb::SimpleRequest    received;
+//..
+// Next, we simulate the arrival of the first fragment, and attempt to decode
+// a request: 'decode' returns a positive value, indicating that the message
+// is incomplete, and reports how many more bytes are required at a minimum:
+//..
+    btlb::BlobUtil::append(&blob, encoding, split);
+
+    rc = decoder.decode(&received, &blob);
+    ASSERT(0 <  rc);
+    ASSERT(0 <  decoder.numBytesNeeded());
+    ASSERT(decoder.numBytesNeeded() <= length - split);
+    ASSERT(split == blob.length());
+//..
+// Then, the rest of the message arrives, and 'decode' resumes scanning from
+// where it stopped, finds the message to be complete, and decodes it:
+//..
+    btlb::BlobUtil::append(&blob, encoding + split, length - split);
+
+    rc = decoder.decode(&received, &blob);
+    ASSERT(0 == rc);
+    ASSERT(request == received);
+//..
+// Finally, we observe that the message has been removed from the blob, and
+// that the decoder is ready for the next one:
+//..
+    ASSERT(0 == blob.length());
+    ASSERT(-1 == decoder.messageLength());
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // INVALID DATA
+        //
+        // Concerns:
+        //: 1 Data that is not valid BER is detected, whether it arrives at
+        //:   once or in fragments, and the blob is then left unmodified.
+        //:
+        //: 2 Once invalid data is detected, 'decode' fails until 'reset' is
+        //:   called.
+        //:
+        //: 3 The number of nested elements having an indefinite length is
+        //:   limited by the maximum depth specified in the decoder options.
+        //:
+        //: 4 A complete message that cannot be decoded into the supplied
+        //:   object is removed from the blob, and the next message can be
+        //:   decoded.
+        //:
+        //: 5 The options supplied at construction are used.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, feed invalid data to a decoder,
+        //:   one byte at a time, and verify that 'decode' fails once the
+        //:   invalid byte has been supplied, and that the blob is left
+        //:   unmodified.  (C-1..2)
+        //:
+        //: 2 Feed nested elements of indefinite length to decoders having
+        //:   various maximum depths.  (C-3, 5)
+        //:
+        //: 3 Encode an 'int' followed by a 'balb::SimpleRequest', and decode
+        //:   both into 'balb::SimpleRequest' objects.  (C-4)
+        //
+        // Testing:
+        //   explicit BerBlobDecoder(const BerDecoderOptions *, Allocator *);
+        //   void reset();
+        //   const BerDecoderOptions *decoderOptions() const;
+        //   bslstl::StringRef loggedMessages() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INVALID DATA" << endl
+                          << "============" << endl;
+
+        if (verbose) cout << "\nInvalid BER." << endl;
+        {
+            static const struct {
+                int         d_line;
+                const char *d_data;
+                int         d_length;
+                int         d_numValid;  // number of bytes before the
+                                         // invalid one
+            } DATA[] = {
+                //LINE  DATA                                  LEN  VALID
+                //----  ------------------------------------  ---  -----
+                { L_,   "\x04\x80",                             2,     1 },
+                { L_,   "\x04\x85\x00\x00\x00\x00\x01",         7,     1 },
+                { L_,   "\x04\xFF",                             2,     1 },
+                { L_,   "\x04\x84\x7F\xFF\xFF\xFF",             6,     5 },
+                { L_,   "\x04\x84\x80\x00\x00\x00",             6,     5 },
+                { L_,   "\x30\x80\x00\x01",                     4,     3 },
+                { L_,   "\x30\x80\x30\x80\x00\x02",             6,     5 },
+                { L_,   "\x30\x80\x04\x80",                     4,     3 },
+                { L_,   "\x5F\x81\x01\x80",                     4,     3 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int   LINE      = DATA[ti].d_line;
+                const char *INPUT     = DATA[ti].d_data;
+                const int   LENGTH    = DATA[ti].d_length;
+                const int   NUM_VALID = DATA[ti].d_numValid;
+
+                if (veryVerbose) { T_ P_(LINE) P(NUM_VALID) }
+
+                btlb::PooledBlobBufferFactory factory(2);
+                btlb::Blob                    blob(&factory);
+
+                Obj mX;  const Obj& X = mX;
+                int value;
+
+                for (int i = 0; i < LENGTH; ++i) {
+                    btlb::BlobUtil::append(&blob, INPUT + i, 1);
+
+                    int rc = mX.decode(&value, &blob);
+                    if (i < NUM_VALID) {
+                        ASSERTV(LINE, i, rc, 0 < rc);
+                        ASSERTV(LINE, i, 0 < X.numBytesNeeded());
+                    }
+                    else {
+                        ASSERTV(LINE, i, rc, 0 > rc);
+                        ASSERTV(LINE, i, 0 == X.numBytesNeeded());
+                        ASSERTV(LINE, i, i + 1 == blob.length());
+                    }
+                }
+
+                // The error persists until 'reset' is called.
+
+                btlb::BlobUtil::erase(&blob, 0, blob.length());
+                btlb::BlobUtil::append(&blob, "\x02\x01\x05", 3);
+
+                ASSERTV(LINE, 0 > mX.decode(&value, &blob));
+                ASSERTV(LINE, 3 == blob.length());
+
+                mX.reset();
+
+                ASSERTV(LINE, 0 == mX.decode(&value, &blob));
+                ASSERTV(LINE, 5 == value);
+                ASSERTV(LINE, 0 == blob.length());
+            }
+        }
+
+        if (verbose) cout << "\nMaximum depth." << endl;
+        {
+            const char NESTED[] = "\x30\x80\x30\x80\x30\x80\x00\x00"
+                                  "\x00\x00\x00\x00";
+
+            for (int maxDepth = 1; maxDepth <= 4; ++maxDepth) {
+                balber::BerDecoderOptions options;
+                options.setMaxDepth(maxDepth);
+
+                btlb::PooledBlobBufferFactory factory(16);
+                btlb::Blob                    blob(&factory);
+                btlb::BlobUtil::append(&blob, NESTED, sizeof NESTED - 1);
+
+                Obj mX(&options);  const Obj& X = mX;
+                ASSERTV(maxDepth, &options == X.decoderOptions());
+
+                int value;
+                int rc = mX.decode(&value, &blob);
+
+                // Note that the message, if complete, is not a valid 'int'.
+
+                ASSERTV(maxDepth, rc, 0 > rc);
+                ASSERTV(maxDepth,
+                        blob.length(),
+                        (3 > maxDepth ? 12 : 0) == blob.length());
+            }
+
+            Obj mX;  const Obj& X = mX;
+            ASSERT(0 == X.decoderOptions());
+        }
+
+        if (verbose) cout << "\nUndecodable message." << endl;
+        {
+            const balb::SimpleRequest REQUEST = makeRequest(10, 20);
+
+            const bsl::string STREAM = encode(12345) + encode(REQUEST);
+
+            btlb::PooledBlobBufferFactory factory(4);
+            btlb::Blob                    blob(&factory);
+            btlb::BlobUtil::append(&blob,
+                                   STREAM.data(),
+                                   static_cast<int>(STREAM.length()));
+
+            Obj mX;  const Obj& X = mX;
+
+            balb::SimpleRequest request;
+            ASSERT(0 > mX.decode(&request, &blob));
+            ASSERT(0 != X.loggedMessages().length());
+            ASSERT(static_cast<int>(STREAM.length()) - 4 == blob.length());
+
+            ASSERT(0 == mX.decode(&request, &blob));
+            ASSERT(REQUEST == request);
+            ASSERT(0 == blob.length());
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // DECODING DATA WRITTEN INTO THE BLOB
+        //
+        // Concerns:
+        //: 1 Data written into the last data buffer of the blob, or into its
+        //:   capacity, and included by increasing the length of the blob (as
+        //:   done by 'btlmt::ChannelPool'), is scanned as if it had been
+        //:   appended.
+        //:
+        //: 2 Several messages held in the same blob are decoded in turn.
+        //
+        // Plan:
+        //: 1 Create a blob having buffers of various sizes.  Write a stream
+        //:   of encoded messages of various sizes into the blob, a few bytes
+        //:   at a time, by increasing the length of the blob and copying the
+        //:   bytes into it, and decode messages whenever 'decode' reports
+        //:   them complete.  (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: Data can be written into the capacity of the blob.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DECODING DATA WRITTEN INTO THE BLOB" << endl
+                          << "===================================" << endl;
+
+        bsl::vector<balb::SimpleRequest> requests;
+        bsl::string                      stream;
+        for (int i = 0; i < 20; ++i) {
+            requests.push_back(makeRequest(i * i * 7, i));
+            stream += encode(requests.back());
+        }
+        const int STREAM_LENGTH = static_cast<int>(stream.length());
+
+        const int BUFFER_SIZES[] = { 1, 3, 16, 100, 4096 };
+        const int NUM_BUFFER_SIZES = sizeof BUFFER_SIZES
+                                   / sizeof *BUFFER_SIZES;
+
+        for (int ti = 0; ti < NUM_BUFFER_SIZES; ++ti) {
+            const int BUFFER_SIZE = BUFFER_SIZES[ti];
+
+            for (int chunkSize = 1; chunkSize < 64; chunkSize += 7) {
+                if (veryVerbose) { T_ P_(BUFFER_SIZE) P(chunkSize) }
+
+                btlb::PooledBlobBufferFactory factory(BUFFER_SIZE);
+                btlb::Blob                    blob(&factory);
+
+                Obj mX;
+
+                bsl::size_t numDecoded = 0;
+                for (int offset = 0; offset < STREAM_LENGTH; ) {
+                    const int numBytes = bsl::min(chunkSize,
+                                                  STREAM_LENGTH - offset);
+                    const int oldLength = blob.length();
+                    blob.setLength(oldLength + numBytes);
+
+                    for (int i = 0; i < numBytes; ++i) {
+                        bsl::pair<int, int> place =
+                                   btlb::BlobUtil::findBufferIndexAndOffset(
+                                                              blob,
+                                                              oldLength + i);
+                        blob.buffer(place.first).data()[place.second] =
+                                                           stream[offset + i];
+                    }
+                    offset += numBytes;
+
+                    balb::SimpleRequest request;
+                    while (0 == mX.decode(&request, &blob)) {
+                        ASSERTV(BUFFER_SIZE, chunkSize, numDecoded,
+                                numDecoded < requests.size());
+                        if (numDecoded < requests.size()) {
+                            ASSERTV(BUFFER_SIZE, chunkSize, numDecoded,
+                                    requests[numDecoded] == request);
+                        }
+                        ++numDecoded;
+                    }
+                }
+
+                ASSERTV(BUFFER_SIZE, chunkSize, numDecoded,
+                        requests.size() == numDecoded);
+                ASSERTV(BUFFER_SIZE, chunkSize, 0 == blob.length());
+            }
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // DECODING FRAGMENTED MESSAGES
+        //
+        // Concerns:
+        //: 1 A message is decoded only once it is complete, whatever the
+        //:   sizes of the fragments in which it arrives and of the buffers of
+        //:   the blob.
+        //:
+        //: 2 While the message is incomplete, the blob is not modified, and
+        //:   'numBytesNeeded' reports a positive number of bytes not greater
+        //:   than the number of bytes missing.
+        //:
+        //: 3 The length of a message whose outermost element has a definite
+        //:   length is reported as soon as its length octets are received,
+        //:   after which 'numBytesNeeded' is exact.
+        //:
+        //: 4 Elements having long-form lengths are handled.
+        //:
+        //: 5 A complete message is removed from the blob, leaving the data
+        //:   following it to be decoded by the next call.
+        //
+        // Plan:
+        //: 1 For messages of various types and sizes, encoded with both
+        //:   definite and indefinite lengths, feed their encoding twice to a
+        //:   decoder, in fragments of various sizes, through blobs having
+        //:   buffers of various sizes, and verify the results of 'decode'
+        //:   and of the accessors after each fragment.  (C-1..5)
+        //
+        // Testing:
+        //   int messageLength() const;
+        //   int numBytesNeeded() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DECODING FRAGMENTED MESSAGES" << endl
+                          << "============================" << endl;
+
+        const int BUFFER_SIZES[]   = { 1, 2, 5, 64, 4096 };
+        const int NUM_BUFFER_SIZES = sizeof BUFFER_SIZES
+                                   / sizeof *BUFFER_SIZES;
+
+        const int FRAGMENT_SIZES[]   = { 1, 3, 17, 1000, 100000 };
+        const int NUM_FRAGMENT_SIZES = sizeof FRAGMENT_SIZES
+                                     / sizeof *FRAGMENT_SIZES;
+
+        const int DATA_LENGTHS[]   = { 0, 1, 127, 128, 255, 256, 70000 };
+        const int NUM_DATA_LENGTHS = sizeof DATA_LENGTHS
+                                   / sizeof *DATA_LENGTHS;
+
+        for (int bi = 0; bi < NUM_BUFFER_SIZES; ++bi) {
+            const int BUFFER_SIZE = BUFFER_SIZES[bi];
+
+            for (int fi = 0; fi < NUM_FRAGMENT_SIZES; ++fi) {
+                const int FRAGMENT_SIZE = FRAGMENT_SIZES[fi];
+
+                for (int di = 0; di < NUM_DATA_LENGTHS; ++di) {
+                    const int DATA_LENGTH = DATA_LENGTHS[di];
+
+                    if (1 == BUFFER_SIZE
+                     && 1 == FRAGMENT_SIZE
+                     && 256 < DATA_LENGTH) {
+                        continue;
+                    }
+
+                    if (veryVerbose) {
+                        T_ P_(BUFFER_SIZE) P_(FRAGMENT_SIZE) P(DATA_LENGTH)
+                    }
+
+                    // Indefinite length
+
+                    testFragmented(L_,
+                                   makeRequest(DATA_LENGTH, DATA_LENGTH),
+                                   BUFFER_SIZE,
+                                   FRAGMENT_SIZE,
+                                   false);
+
+                    // Definite length
+
+                    testFragmented(L_,
+                                   makeRequest(DATA_LENGTH, 0).data(),
+                                   BUFFER_SIZE,
+                                   FRAGMENT_SIZE,
+                                   true);
+                }
+
+                testFragmented(L_, 0,          BUFFER_SIZE, FRAGMENT_SIZE,
+                               true);
+                testFragmented(L_, -123456789, BUFFER_SIZE, FRAGMENT_SIZE,
+                               true);
+            }
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Decode a message received in one, then in two fragments.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   explicit BerBlobDecoder(Allocator *);
+        //   int decode(TYPE *, btlb::Blob *);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+
+        const balb::SimpleRequest REQUEST  = makeRequest(100, 7);
+        const bsl::string         ENCODING = encode(REQUEST);
+        const int                 LENGTH   =
+                                        static_cast<int>(ENCODING.length());
+
+        btlb::PooledBlobBufferFactory factory(16);
+        {
+            btlb::Blob blob(&factory);
+            btlb::BlobUtil::append(&blob, ENCODING.data(), LENGTH);
+
+            Obj mX(&ta);  const Obj& X = mX;
+            ASSERT(2 == X.numBytesNeeded());
+            ASSERT(-1 == X.messageLength());
+
+            balb::SimpleRequest request;
+            ASSERT(0 == mX.decode(&request, &blob));
+            ASSERT(REQUEST == request);
+            ASSERT(0 == blob.length());
+        }
+        {
+            btlb::Blob blob(&factory);
+            btlb::BlobUtil::append(&blob, ENCODING.data(), 10);
+
+            Obj mX(&ta);  const Obj& X = mX;
+
+            balb::SimpleRequest request;
+            ASSERT(0 < mX.decode(&request, &blob));
+            ASSERT(0 < X.numBytesNeeded());
+            ASSERT(10 == blob.length());
+
+            btlb::BlobUtil::append(&blob, ENCODING.data() + 10, LENGTH - 10);
+
+            ASSERT(0 == mX.decode(&request, &blob));
+            ASSERT(REQUEST == request);
+            ASSERT(0 == blob.length());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // COPY-THEN-DECODE BENCHMARK
+        //
+        // Concerns:
+        //: 1 Decoding messages directly from the buffers of a blob is not
+        //:   slower than copying them into a contiguous buffer first, even
+        //:   when the boundaries of the messages are known in advance.
+        //:
+        //: 2 When messages arrive in fragments, resuming the scan of a
+        //:   message is faster than attempting to decode the whole message
+        //:   after each fragment.
+        //
+        // Plan:
+        //: 1 For messages of various sizes, held in blobs having buffers of
+        //:   various sizes, measure the time taken to decode the messages
+        //:   using a 'balber::BerBlobDecoder', and by copying each message
+        //:   into a contiguous buffer and decoding it using a
+        //:   'balber::BerDecoder'.  (C-1)
+        //:
+        //: 2 Repeat P-1, delivering each message in fragments of the size of
+        //:   a typical TCP segment, and, in the copy-then-decode case,
+        //:   copying and attempting to decode the data received so far after
+        //:   each fragment.  (C-2)
+        //
+        // Testing:
+        //   COPY-THEN-DECODE BENCHMARK
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "COPY-THEN-DECODE BENCHMARK" << endl
+             << "==========================" << endl;
+
+        using namespace TEST_CASE_BENCHMARK;
+
+        const int k_NUM_BYTES = argc > 2 ? atoi(argv[2]) : 100 * 1000 * 1000;
+
+        const int k_SEGMENT_SIZE = 1460;
+
+        const int DATA_LENGTHS[]   = { 16, 256, 4096, 65536 };
+        const int NUM_DATA_LENGTHS = sizeof DATA_LENGTHS
+                                   / sizeof *DATA_LENGTHS;
+
+        const int BUFFER_SIZES[]   = { 256, 4096 };
+        const int NUM_BUFFER_SIZES = sizeof BUFFER_SIZES
+                                   / sizeof *BUFFER_SIZES;
+
+        for (int fragmented = 0; fragmented < 2; ++fragmented) {
+            const int FRAGMENT_SIZE = fragmented ? k_SEGMENT_SIZE : INT_MAX;
+
+            cout << (fragmented ? "\nFragmented messages:"
+                                : "\nWhole messages:") << endl;
+
+            for (int di = 0; di < NUM_DATA_LENGTHS; ++di) {
+                const int                 DATA_LENGTH = DATA_LENGTHS[di];
+                const balb::SimpleRequest REQUEST     =
+                                               makeRequest(DATA_LENGTH, 42);
+                const bsl::string         ENCODING    = encode(REQUEST);
+                const int                 NUM_MESSAGES = bsl::max(
+                              1,
+                              k_NUM_BYTES / static_cast<int>(ENCODING.size()));
+
+                for (int bi = 0; bi < NUM_BUFFER_SIZES; ++bi) {
+                    const int BUFFER_SIZE = BUFFER_SIZES[bi];
+
+                    const double copyTime = measureCopyThenDecode(
+                                                               REQUEST,
+                                                               ENCODING,
+                                                               BUFFER_SIZE,
+                                                               FRAGMENT_SIZE,
+                                                               NUM_MESSAGES);
+                    const double blobTime = measureBlobDecoder(REQUEST,
+                                                               ENCODING,
+                                                               BUFFER_SIZE,
+                                                               FRAGMENT_SIZE,
+                                                               NUM_MESSAGES);
+
+                    cout << "message: "            << ENCODING.size()
+                         << "\tbuffer: "           << BUFFER_SIZE
+                         << "\tcopy-then-decode: " << copyTime << "s"
+                         << "\tblob decoder: "     << blobTime << "s"
+                         << endl;
+                }
+            }
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
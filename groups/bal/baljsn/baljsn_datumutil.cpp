@@ -0,0 +1,493 @@
+// baljsn_datumutil.cpp                                               -*-C++-*-
+#include <baljsn_datumutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(baljsn_datumutil_cpp,"$Id$ $CSID$")
+
+#include <baljsn_parserutil.h>
+#include <baljsn_tokenizer.h>
+
+#include <bdlb_chartype.h>
+#include <bdlma_localsequentialallocator.h>
+
+#include <bslma_default.h>
+
+#include <bsls_assert.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstring.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+// IMPLEMENTATION NOTES: The elements of the arrays, and the entries of the
+// objects, being decoded are accumulated on two stacks shared by all nesting
+// levels, and are copied into a 'bdld::Datum' array or map, allocated with its
+// exact size, once the closing bracket is reached.  Until then, each element
+// is a fully constructed 'bdld::Datum', so that, on failure, the elements
+// remaining on the stacks are exactly those that need to be destroyed.
+
+namespace BloombergLP {
+namespace {
+
+                             // ==================
+                             // class DatumDecoder
+                             // ==================
+
+class DatumDecoder {
+    // This component-private class provides a mechanism for decoding the JSON
+    // data read by a tokenizer into a 'bdld::Datum'.
+
+    // PRIVATE TYPES
+    enum { k_SCRATCH_BUFFER_SIZE = 2048 };  // size of the local buffer used
+                                            // for temporary memory
+
+    // DATA
+    bdlma::LocalSequentialAllocator<k_SCRATCH_BUFFER_SIZE>
+                                      d_scratch;      // temporary memory
+
+    baljsn::Tokenizer                 d_tokenizer;    // JSON tokenizer
+
+    bsl::vector<bdld::Datum>          d_elements;     // elements of the
+                                                      // arrays being decoded
+
+    bsl::vector<bdld::DatumMapEntry>  d_entries;      // entries of the
+                                                      // objects being decoded
+
+    bsl::string                       d_buffer;       // unescaped string
+
+    const char                       *d_input_p;      // input being decoded
+                                                      // (held, not owned)
+
+    const char                       *d_inputEnd_p;   // end of the input
+
+    int                               d_depth;        // current depth
+
+    int                               d_maxDepth;     // maximum depth
+
+    bslma::Allocator                 *d_allocator_p;  // allocator of the
+                                                      // result (held, not
+                                                      // owned)
+
+    // PRIVATE MANIPULATORS
+    int decodeArray(bdld::Datum *result);
+        // Load into the specified 'result' the array starting at the current
+        // token.  Return 0 on success, and a non-zero value otherwise.
+
+    int decodeObject(bdld::Datum *result);
+        // Load into the specified 'result' the object starting at the current
+        // token.  Return 0 on success, and a non-zero value otherwise.
+
+    int decodeScalar(bdld::Datum *result);
+        // Load into the specified 'result' the string, number, or literal
+        // value of the current token.  Return 0 on success, and a non-zero
+        // value otherwise.
+
+    int decodeString(bdld::Datum *result, const bslstl::StringRef& quoted);
+        // Load into the specified 'result' the value of the specified
+        // 'quoted' string, referring to the characters of 'quoted' if it has
+        // no escape sequence.  Return 0 on success, and a non-zero value
+        // otherwise.
+
+    int decodeValue(bdld::Datum *result);
+        // Load into the specified 'result' the value starting at the current
+        // token.  Return 0 on success, and a non-zero value otherwise.
+
+    int nameToKey(bslstl::StringRef *key, bool *isCopied);
+        // Load into the specified 'key' the unescaped value of the element
+        // name that is the current token, and load into the specified
+        // 'isCopied' whether 'key' refers to a copy of that value, held in
+        // temporary memory, rather than to the input.  Return 0 on success,
+        // and a non-zero value otherwise.
+
+    bslstl::StringRef quotedName() const;
+        // Return the element name that is the current token, including its
+        // enclosing quotes.
+
+    void destroyPending();
+        // Destroy the elements and entries remaining on the stacks of this
+        // object.
+
+  private:
+    // NOT IMPLEMENTED
+    DatumDecoder(const DatumDecoder&);
+    DatumDecoder& operator=(const DatumDecoder&);
+
+  public:
+    // CREATORS
+    DatumDecoder(int maxDepth, bslma::Allocator *resultAllocator);
+        // Create a decoder for JSON data having the specified 'maxDepth'
+        // maximum nesting depth, using the specified 'resultAllocator' to
+        // supply the memory of the decoded values.
+
+    // MANIPULATORS
+    int decode(bdld::Datum *result, const bslstl::StringRef& json);
+        // Load into the specified 'result' the value of the specified 'json'.
+        // Return 0 on success, and a non-zero value otherwise.
+};
+
+                             // ------------------
+                             // class DatumDecoder
+                             // ------------------
+
+// PRIVATE MANIPULATORS
+int DatumDecoder::decodeArray(bdld::Datum *result)
+{
+    if (++d_depth > d_maxDepth) {
+        return -1;                                                    // RETURN
+    }
+
+    const bsl::size_t begin = d_elements.size();
+
+    int rc = d_tokenizer.advanceToNextToken();
+    while (0 == rc && baljsn::Tokenizer::e_END_ARRAY
+                                                 != d_tokenizer.tokenType()) {
+        bdld::Datum element;
+
+        rc = decodeValue(&element);
+        if (rc) {
+            return rc;                                                // RETURN
+        }
+
+        d_elements.push_back(element);
+
+        rc = d_tokenizer.advanceToNextToken();
+    }
+
+    if (rc) {
+        return rc;                                                    // RETURN
+    }
+
+    const bdld::Datum::SizeType length = d_elements.size() - begin;
+
+    bdld::DatumMutableArrayRef array;
+    bdld::Datum::createUninitializedArray(&array, length, d_allocator_p);
+    bsl::copy(d_elements.begin() + begin, d_elements.end(), array.data());
+    *array.length() = length;
+
+    *result = bdld::Datum::adoptArray(array);
+
+    d_elements.resize(begin);
+    --d_depth;
+    return 0;
+}
+
+int DatumDecoder::decodeObject(bdld::Datum *result)
+{
+    if (++d_depth > d_maxDepth) {
+        return -1;                                                    // RETURN
+    }
+
+    const bsl::size_t begin        = d_entries.size();
+    bsl::size_t       keysCapacity = 0;
+    bool              hasCopiedKey = false;
+
+    int rc = d_tokenizer.advanceToNextToken();
+    while (0 == rc && baljsn::Tokenizer::e_ELEMENT_NAME
+                                                  == d_tokenizer.tokenType()) {
+        bslstl::StringRef key;
+        bool              isCopied;
+
+        rc = nameToKey(&key, &isCopied);
+        if (rc) {
+            return rc;                                                // RETURN
+        }
+
+        rc = d_tokenizer.advanceToNextToken();
+        if (rc) {
+            return rc;                                                // RETURN
+        }
+
+        bdld::Datum value;
+        rc = decodeValue(&value);
+        if (rc) {
+            return rc;                                                // RETURN
+        }
+
+        d_entries.push_back(bdld::DatumMapEntry(key, value));
+
+        keysCapacity += key.length();
+        hasCopiedKey  = hasCopiedKey || isCopied;
+
+        rc = d_tokenizer.advanceToNextToken();
+    }
+
+    if (rc || baljsn::Tokenizer::e_END_OBJECT != d_tokenizer.tokenType()) {
+        return -1;                                                    // RETURN
+    }
+
+    const bdld::Datum::SizeType size = d_entries.size() - begin;
+
+    if (!hasCopiedKey) {
+        // All keys refer to the input.
+
+        bdld::DatumMutableMapRef map;
+        bdld::Datum::createUninitializedMap(&map, size, d_allocator_p);
+        bsl::copy(d_entries.begin() + begin, d_entries.end(), map.data());
+        *map.size()   = size;
+        *map.sorted() = false;
+
+        *result = bdld::Datum::adoptMap(map);
+    }
+    else {
+        // Some keys were unescaped into temporary memory: copy all keys into
+        // the map.
+
+        bdld::DatumMutableMapOwningKeysRef map;
+        bdld::Datum::createUninitializedMap(
+                                     &map,
+                                     size,
+                                     static_cast<bdld::Datum::SizeType>(
+                                                                 keysCapacity),
+                                     d_allocator_p);
+
+        char *keys = map.keys();
+        for (bdld::Datum::SizeType i = 0; i < size; ++i) {
+            const bdld::DatumMapEntry& entry = d_entries[begin + i];
+            const bsl::size_t          keyLength = entry.key().length();
+
+            if (keyLength) {
+                bsl::memcpy(keys, entry.key().data(), keyLength);
+            }
+            map.data()[i] = bdld::DatumMapEntry(
+                                   bslstl::StringRef(keys,
+                                                     static_cast<int>(
+                                                                   keyLength)),
+                                   entry.value());
+            keys += keyLength;
+        }
+        *map.size()   = size;
+        *map.sorted() = false;
+
+        *result = bdld::Datum::adoptMap(map);
+    }
+
+    d_entries.resize(begin);
+    --d_depth;
+    return 0;
+}
+
+int DatumDecoder::decodeScalar(bdld::Datum *result)
+{
+    bslstl::StringRef token;
+    if (d_tokenizer.value(&token)) {
+        return -1;                                                    // RETURN
+    }
+
+    switch (token[0]) {
+      case '"': {
+        return decodeString(result, token);                           // RETURN
+      }
+      case 't': {
+        if ("true" != token) {
+            return -1;                                                // RETURN
+        }
+        *result = bdld::Datum::createBoolean(true);
+      } break;
+      case 'f': {
+        if ("false" != token) {
+            return -1;                                                // RETURN
+        }
+        *result = bdld::Datum::createBoolean(false);
+      } break;
+      case 'n': {
+        if ("null" != token) {
+            return -1;                                                // RETURN
+        }
+        *result = bdld::Datum::createNull();
+      } break;
+      default: {
+        double value;
+        if (baljsn::ParserUtil::getValue(&value, token)) {
+            return -1;                                                // RETURN
+        }
+        *result = bdld::Datum::createDouble(value);
+      } break;
+    }
+    return 0;
+}
+
+int DatumDecoder::decodeString(bdld::Datum              *result,
+                               const bslstl::StringRef&  quoted)
+{
+    bslstl::StringRef value;
+    const int rc = baljsn::ParserUtil::getStringValue(&value,
+                                                      &d_buffer,
+                                                      quoted);
+    if (rc) {
+        return rc;                                                    // RETURN
+    }
+
+    if (quoted.begin() < value.data() && value.data() < quoted.end()) {
+        // The string has no escape sequence.
+
+        *result = bdld::Datum::createStringRef(value, d_allocator_p);
+    }
+    else {
+        *result = bdld::Datum::copyString(value, d_allocator_p);
+    }
+    return 0;
+}
+
+int DatumDecoder::decodeValue(bdld::Datum *result)
+{
+    switch (d_tokenizer.tokenType()) {
+      case baljsn::Tokenizer::e_START_OBJECT: {
+        return decodeObject(result);                                  // RETURN
+      }
+      case baljsn::Tokenizer::e_START_ARRAY: {
+        return decodeArray(result);                                   // RETURN
+      }
+      case baljsn::Tokenizer::e_ELEMENT_VALUE: {
+        return decodeScalar(result);                                  // RETURN
+      }
+      default: {
+        return -1;                                                    // RETURN
+      }
+    }
+}
+
+int DatumDecoder::nameToKey(bslstl::StringRef *key, bool *isCopied)
+{
+    const bslstl::StringRef quoted = quotedName();
+
+    const int rc = baljsn::ParserUtil::getStringValue(key, &d_buffer, quoted);
+    if (rc) {
+        return rc;                                                    // RETURN
+    }
+
+    *isCopied = !(quoted.begin() < key->data() && key->data() < quoted.end());
+    if (*isCopied && !key->isEmpty()) {
+        // Keep a copy of the unescaped key until the map is created.
+
+        char *copy = static_cast<char *>(d_scratch.allocate(key->length()));
+        bsl::memcpy(copy, key->data(), key->length());
+        key->assign(copy, copy + key->length());
+    }
+    return 0;
+}
+
+bslstl::StringRef DatumDecoder::quotedName() const
+{
+    // The input is contiguous, and the name is followed by its closing quote,
+    // which is the last byte consumed by the tokenizer.
+
+    const char *end = d_input_p + d_tokenizer.numBytesConsumed();
+
+    bslstl::StringRef name;
+    const int length = d_tokenizer.value(&name)
+                       ? 2
+                       : static_cast<int>(name.length()) + 2;
+    return bslstl::StringRef(end - length, length);
+}
+
+void DatumDecoder::destroyPending()
+{
+    for (bsl::size_t i = 0; i < d_elements.size(); ++i) {
+        bdld::Datum::destroy(d_elements[i], d_allocator_p);
+    }
+    for (bsl::size_t i = 0; i < d_entries.size(); ++i) {
+        bdld::Datum::destroy(d_entries[i].value(), d_allocator_p);
+    }
+    d_elements.clear();
+    d_entries.clear();
+}
+
+// CREATORS
+DatumDecoder::DatumDecoder(int maxDepth, bslma::Allocator *resultAllocator)
+: d_scratch()
+, d_tokenizer(&d_scratch)
+, d_elements(&d_scratch)
+, d_entries(&d_scratch)
+, d_buffer(&d_scratch)
+, d_input_p(0)
+, d_inputEnd_p(0)
+, d_depth(0)
+, d_maxDepth(maxDepth)
+, d_allocator_p(resultAllocator)
+{
+}
+
+// MANIPULATORS
+int DatumDecoder::decode(bdld::Datum *result, const bslstl::StringRef& json)
+{
+    d_input_p    = json.data();
+    d_inputEnd_p = json.data() + json.length();
+
+    d_tokenizer.reset(json);
+    d_tokenizer.setAllowStandAloneValues(true);
+    d_tokenizer.setAllowHeterogenousArrays(true);
+
+    bdld::Datum value;
+
+    int rc = d_tokenizer.advanceToNextToken();
+    if (0 == rc) {
+        rc = decodeValue(&value);
+    }
+
+    if (rc) {
+        destroyPending();
+        return rc;                                                    // RETURN
+    }
+
+    // Only whitespace may follow the value.
+
+    for (const char *next = d_input_p + d_tokenizer.numBytesConsumed();
+         next < d_inputEnd_p;
+         ++next) {
+        if (!bdlb::CharType::isSpace(*next)) {
+            bdld::Datum::destroy(value, d_allocator_p);
+            return -1;                                                // RETURN
+        }
+    }
+
+    *result = value;
+    return 0;
+}
+
+}  // close unnamed namespace
+
+namespace baljsn {
+
+                              // ----------------
+                              // struct DatumUtil
+                              // ----------------
+
+// CLASS METHODS
+int DatumUtil::decode(bdld::Datum              *result,
+                      const bslstl::StringRef&  json,
+                      bslma::Allocator         *basicAllocator)
+{
+    const DecoderOptions options;
+    return decode(result, json, options, basicAllocator);
+}
+
+int DatumUtil::decode(bdld::Datum              *result,
+                      const bslstl::StringRef&  json,
+                      const DecoderOptions&     options,
+                      bslma::Allocator         *basicAllocator)
+{
+    BSLS_ASSERT(result);
+
+    DatumDecoder decoder(options.maxDepth(),
+                         bslma::Default::allocator(basicAllocator));
+    return decoder.decode(result, json);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,179 @@
+// baljsn_datumutil.h                                                 -*-C++-*-
+#ifndef INCLUDED_BALJSN_DATUMUTIL
+#define INCLUDED_BALJSN_DATUMUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a utility for decoding JSON data into 'bdld::Datum'.
+//
+//@CLASSES:
+//  baljsn::DatumUtil: utility for decoding JSON data into 'bdld::Datum'
+//
+//@SEE_ALSO: baljsn_decoder, baljsn_tokenizer, bdld_datum
+//
+//@DESCRIPTION: This component provides a 'struct' of utility functions,
+// 'baljsn::DatumUtil', for decoding JSON data held in contiguous memory into a
+// 'bdld::Datum', without requiring a schema.  The following table describes
+// the 'bdld::Datum' types into which JSON values are decoded:
+//..
+//  JSON value               Datum type
+//  ----------               ----------
+//  object                   map ('e_MAP')
+//  array                    array ('e_ARRAY')
+//  string                   string ('e_STRING')
+//  number                   double ('e_DOUBLE')
+//  'true', 'false'          boolean ('e_BOOLEAN')
+//  'null'                   null ('e_NIL')
+//..
+// The JSON data is tokenized in place, and decoding avoids copying it where
+// possible: a string (or object member name) having no escape sequence is
+// decoded as a reference to the characters of the JSON data, and only
+// strings having escape sequences are copied, once unescaped, into memory
+// supplied by the allocator specified to 'decode'.  A decoded 'bdld::Datum'
+// therefore remains valid only as long as the JSON data from which it was
+// decoded remains valid and unmodified.
+//
+// A decoded 'bdld::Datum' is released, as any other 'bdld::Datum', by calling
+// 'bdld::Datum::destroy' with the allocator specified to 'decode'.  Since the
+// memory of the maps, arrays, and unescaped strings composing the result is
+// obtained from that allocator and released all at once, decoding into a
+// sequential (arena) allocator, such as a 'bdlma::SequentialAllocator' that is
+// released (or destroyed) once the result is no longer needed, avoids both the
+// cost of individual deallocations and that of calling 'destroy'.
+//
+// Note that, as JSON does not distinguish integral from floating-point
+// numbers, all numbers are decoded as 'double' values, and that members of an
+// object are kept in the order in which they appear in the JSON data, the
+// resulting map being unsorted.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Decoding JSON Data into a 'bdld::Datum'
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we receive JSON data describing an employee, whose schema is not
+// known in advance, and need to inspect it.
+//
+// First, we define the JSON data:
+//..
+//  const char JSON[] = "{\"name\":\"Bob\",\"age\":21,"
+//                      "\"skills\":[\"C++\",\"JSON\"],\"manager\":null}";
+//..
+// Then, we create the sequential allocator that will supply the memory of the
+// decoded 'bdld::Datum':
+//..
+//  bdlma::SequentialAllocator arena;
+//..
+// Next, we decode the JSON data into a 'bdld::Datum':
+//..
+//  bdld::Datum employee;
+//  int rc = baljsn::DatumUtil::decode(&employee, JSON, &arena);
+//  assert(0 == rc);
+//..
+// Now, we inspect the decoded value.  Note that the string values refer to
+// the characters of 'JSON', which was not copied:
+//..
+//  assert(employee.isMap());
+//
+//  const bdld::DatumMapRef map = employee.theMap();
+//  assert(4 == map.size());
+//
+//  assert(map.find("name")->isString());
+//  assert("Bob" == map.find("name")->theString());
+//
+//  assert(map.find("age")->isDouble());
+//  assert(21 == map.find("age")->theDouble());
+//
+//  assert(map.find("skills")->isArray());
+//  assert(2 == map.find("skills")->theArray().length());
+//
+//  assert(map.find("manager")->isNull());
+//..
+// Finally, we observe that the whole of the decoded value is released along
+// with the arena, once it is no longer needed, without calling
+// 'bdld::Datum::destroy':
+//..
+//  arena.release();
+//..
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BALJSN_DECODEROPTIONS
+#include <baljsn_decoderoptions.h>
+#endif
+
+#ifndef INCLUDED_BDLD_DATUM
+#include <bdld_datum.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
+namespace BloombergLP {
+namespace baljsn {
+
+                              // ================
+                              // struct DatumUtil
+                              // ================
+
+struct DatumUtil {
+    // This 'struct' provides a namespace for utility functions decoding JSON
+    // data held in contiguous memory into a 'bdld::Datum'.
+
+    // CLASS METHODS
+    static int decode(bdld::Datum              *result,
+                      const bslstl::StringRef&  json,
+                      bslma::Allocator         *basicAllocator);
+    static int decode(bdld::Datum              *result,
+                      const bslstl::StringRef&  json,
+                      const DecoderOptions&     options,
+                      bslma::Allocator         *basicAllocator);
+        // Load into the specified 'result' the value of the JSON data in the
+        // specified 'json', using the specified 'basicAllocator' to supply
+        // memory, and, optionally, the 'maxDepth' of the specified 'options'
+        // as the maximum nesting depth of objects and arrays.  Return 0 on
+        // success, and a non-zero value, leaving 'result' unchanged,
+        // otherwise.  'json' shall hold exactly one JSON value (object,
+        // array, string, number, 'true', 'false', or 'null'), optionally
+        // surrounded by whitespace.  The strings, and object member names,
+        // of 'result' that have no escape sequence in 'json' refer to the
+        // characters of 'json', which must therefore remain valid and
+        // unmodified as long as 'result' is used.  The memory used by
+        // 'result' must be released with 'bdld::Datum::destroy' using
+        // 'basicAllocator', unless 'basicAllocator' releases it all at once
+        // (e.g., is a sequential allocator that is released).  Note that
+        // temporary memory used while decoding is supplied by the default
+        // allocator.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,813 @@
+// baljsn_datumutil.t.cpp                                             -*-C++-*-
+#include <baljsn_datumutil.h>
+
+#include <baljsn_decoderoptions.h>
+
+#include <bdld_datum.h>
+#include <bdlma_sequentialallocator.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+
+using namespace BloombergLP;
+using bsl::cout;
+using bsl::cerr;
+using bsl::endl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// The component under test implements a utility for decoding JSON data into a
+// 'bdld::Datum'.  We verify the decoded values using a canonical textual
+// representation of 'bdld::Datum' values, that the strings without escape
+// sequences refer to the input, that no memory is leaked, whether decoding
+// succeeds or fails, and that invalid JSON data is rejected.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] int decode(Datum *r, const StringRef& json, Allocator *bA);
+// [ 5] int decode(Datum *r, const StringRef& j, options, Allocator *bA);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCERN: ARRAYS AND OBJECTS ARE DECODED
+// [ 4] CONCERN: STRINGS WITHOUT ESCAPE SEQUENCES ARE NOT COPIED
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef baljsn::DatumUtil   Obj;
+typedef bsls::Types::Int64  Int64;
+
+// ============================================================================
+//                          GLOBAL HELPER FUNCTIONS
+// ----------------------------------------------------------------------------
+
+void render(bsl::ostream& stream, const bdld::Datum& value)
+    // Write to the specified 'stream' a canonical representation of the
+    // specified 'value': maps as '{key:value,...}', arrays as '[value,...]',
+    // strings enclosed in single quotes, doubles, booleans, and nulls as
+    // 'true', 'false', and 'null'.
+{
+    switch (value.type()) {
+      case bdld::Datum::e_MAP: {
+        const bdld::DatumMapRef map = value.theMap();
+        stream << '{';
+        for (bdld::Datum::SizeType i = 0; i < map.size(); ++i) {
+            if (i) {
+                stream << ',';
+            }
+            stream << map[i].key() << ':';
+            render(stream, map[i].value());
+        }
+        stream << '}';
+      } break;
+      case bdld::Datum::e_ARRAY: {
+        const bdld::DatumArrayRef array = value.theArray();
+        stream << '[';
+        for (bdld::Datum::SizeType i = 0; i < array.length(); ++i) {
+            if (i) {
+                stream << ',';
+            }
+            render(stream, array[i]);
+        }
+        stream << ']';
+      } break;
+      case bdld::Datum::e_STRING: {
+        stream << '\'' << value.theString() << '\'';
+      } break;
+      case bdld::Datum::e_DOUBLE: {
+        stream << value.theDouble();
+      } break;
+      case bdld::Datum::e_BOOLEAN: {
+        stream << (value.theBoolean() ? "true" : "false");
+      } break;
+      case bdld::Datum::e_NIL: {
+        stream << "null";
+      } break;
+      default: {
+        stream << "<unexpected type " << value.type() << '>';
+      } break;
+    }
+}
+
+bsl::string render(const bdld::Datum& value)
+    // Return the canonical representation of the specified 'value'.
+{
+    bsl::ostringstream oss;
+    render(oss, value);
+    return oss.str();
+}
+
+bool isInRange(const bslstl::StringRef& value, const bsl::string& input)
+    // Return 'true' if the characters of the specified 'value' are part of
+    // the specified 'input', and 'false' otherwise.
+{
+    return input.data() <= value.data()
+        && value.data() + value.length() <= input.data() + input.length();
+}
+
+void appendRecord(bsl::string *document, int index)
+    // Append to the specified 'document' a JSON object having the specified
+    // 'index' as one of its values.
+{
+    bsl::ostringstream oss;
+    oss << "{\"name\":\"record " << index << "\","
+        << "\"description\":\"A record with a \\\"quoted\\\" word and "
+        << "enough text to make its value longer than its name\","
+        << "\"id\":" << index << ","
+        << "\"price\":" << index * 0.25 << ","
+        << "\"tags\":[\"alpha\",\"beta\",\"gamma\"],"
+        << "\"active\":" << (index % 2 ? "true" : "false") << ","
+        << "\"parent\":null}";
+
+    document->append(oss.str());
+}
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    bool verbose         = argc > 2;
+    bool veryVerbose     = argc > 3;
+    bool veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Decoding JSON Data into a 'bdld::Datum'
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we receive JSON data describing an employee, whose schema is not
+// known in advance, and need to inspect it.
+//
+// First, we define the JSON data:
+//..
+    const char JSON[] = "{\"name\":\"Bob\",\"age\":21,"
+                        "\"skills\":[\"C++\",\"JSON\"],\"manager\":null}";
+//..
+// Then, we create the sequential allocator that will supply the memory of the
+// decoded 'bdld::Datum':
+//..
+    bdlma::SequentialAllocator arena;
+//..
+// Next, we decode the JSON data into a 'bdld::Datum':
+//..
+    bdld::Datum employee;
+    int rc = baljsn::DatumUtil::decode(&employee, JSON, &arena);
+    ASSERT(0 == rc);
+//..
+// Now, we inspect the decoded value.  Note that the string values refer to
+// the characters of 'JSON', which was not copied:
+//..
+    ASSERT(employee.isMap());
+
+    const bdld::DatumMapRef map = employee.theMap();
+    ASSERT(4 == map.size());
+
+    ASSERT(map.find("name")->isString());
+    ASSERT("Bob" == map.find("name")->theString());
+
+    ASSERT(map.find("age")->isDouble());
+    ASSERT(21 == map.find("age")->theDouble());
+
+    ASSERT(map.find("skills")->isArray());
+    ASSERT(2 == map.find("skills")->theArray().length());
+
+    ASSERT(map.find("manager")->isNull());
+//..
+// Finally, we observe that the whole of the decoded value is released along
+// with the arena, once it is no longer needed, without calling
+// 'bdld::Datum::destroy':
+//..
+    arena.release();
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'decode' WITH OPTIONS
+        //
+        // Concerns:
+        //: 1 Arrays and objects nested up to the 'maxDepth' of the options
+        //:   are decoded, and deeper nesting is rejected.
+        //:
+        //: 2 The default maximum depth is that of default 'DecoderOptions'.
+        //:
+        //: 3 No memory is leaked when the maximum depth is exceeded.
+        //
+        // Plan:
+        //: 1 For a set of maximum depths, decode arrays and objects nested up
+        //:   to, and beyond, that depth, and verify the return code, and that
+        //:   no memory remains in use once the result is destroyed.  (C-1,3)
+        //:
+        //: 2 Repeat P-1 without options at the default depth.  (C-2)
+        //
+        // Testing:
+        //   int decode(Datum *r, const StringRef& j, options, Allocator *bA);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'decode' WITH OPTIONS" << endl
+                          << "=============================" << endl;
+
+        const int MAX_DEPTHS[] = { 0, 1, 2, 5, 32 };
+        const int NUM_MAX_DEPTHS = sizeof MAX_DEPTHS / sizeof *MAX_DEPTHS;
+
+        for (int ti = 0; ti < NUM_MAX_DEPTHS; ++ti) {
+            const int MAX_DEPTH = MAX_DEPTHS[ti];
+
+            baljsn::DecoderOptions options;
+            options.setMaxDepth(MAX_DEPTH);
+
+            for (int depth = 1; depth <= MAX_DEPTH + 1; ++depth) {
+                bsl::string arrays;
+                bsl::string objects;
+                for (int i = 0; i < depth; ++i) {
+                    arrays.append("[");
+                    objects.append("{\"a\":");
+                }
+                objects.append("1");
+                for (int i = 0; i < depth; ++i) {
+                    arrays.append("]");
+                    objects.append("}");
+                }
+
+                const bool IS_VALID = depth <= MAX_DEPTH;
+
+                bslma::TestAllocator ta("result", veryVeryVerbose);
+
+                for (int cfg = 0; cfg < 2; ++cfg) {
+                    const bsl::string& INPUT = cfg ? objects : arrays;
+
+                    bdld::Datum result;
+                    const int rc = Obj::decode(&result, INPUT, options, &ta);
+
+                    ASSERTV(MAX_DEPTH, depth, cfg, rc, IS_VALID == (0 == rc));
+                    if (0 == rc) {
+                        bdld::Datum::destroy(result, &ta);
+                    }
+                    ASSERTV(MAX_DEPTH, depth, cfg, 0 == ta.numBytesInUse());
+
+                    if (32 == MAX_DEPTH) {
+                        const int rc = Obj::decode(&result, INPUT, &ta);
+
+                        ASSERTV(depth, cfg, rc, IS_VALID == (0 == rc));
+                        if (0 == rc) {
+                            bdld::Datum::destroy(result, &ta);
+                        }
+                        ASSERTV(depth, cfg, 0 == ta.numBytesInUse());
+                    }
+                }
+            }
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCERN: STRINGS WITHOUT ESCAPE SEQUENCES ARE NOT COPIED
+        //
+        // Concerns:
+        //: 1 Strings, and object member names, having no escape sequence
+        //:   refer to the characters of the input.
+        //:
+        //: 2 Strings, and object member names, having escape sequences are
+        //:   unescaped into memory owned by the result.
+        //:
+        //: 3 Temporary memory is supplied by the default allocator, and is
+        //:   released once decoding completes.
+        //
+        // Plan:
+        //: 1 Decode an object whose member names and string values have, or
+        //:   do not have, escape sequences, and verify whether each refers to
+        //:   the input.  (C-1..2)
+        //:
+        //: 2 Install a test allocator as the default allocator, and verify
+        //:   that no memory remains in use once decoding completes, and that
+        //:   no memory remains in use from the allocator supplied to 'decode'
+        //:   once the result is destroyed.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: STRINGS WITHOUT ESCAPE SEQUENCES ARE NOT COPIED
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                  << "CONCERN: STRINGS WITHOUT ESCAPE SEQUENCES ARE NOT COPIED"
+                  << endl
+                  << "========================================================"
+                  << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        bslma::TestAllocator ia("input",  veryVeryVerbose);
+        bslma::TestAllocator ta("result", veryVeryVerbose);
+
+        if (verbose) cout << "\nMember names without escape sequences."
+                          << endl;
+        {
+            const bsl::string INPUT("{\"plain\":\"value\","
+                                    "\"escaped\":\"va\\\"lue\","
+                                    "\"array\":[\"one\",\"t\\u0077o\"]}",
+                                    &ia);
+
+            bdld::Datum result;
+            ASSERT(0 == Obj::decode(&result, INPUT, &ta));
+            ASSERTV(render(result),
+                    "{plain:'value',escaped:'va\"lue',array:['one','two']}"
+                                                            == render(result));
+
+            const bdld::DatumMapRef map = result.theMap();
+            ASSERT(!map.ownsKeys());
+
+            for (bdld::Datum::SizeType i = 0; i < map.size(); ++i) {
+                ASSERTV(i, isInRange(map[i].key(), INPUT));
+            }
+
+            ASSERT( isInRange(map[0].value().theString(), INPUT));
+            ASSERT(!isInRange(map[1].value().theString(), INPUT));
+
+            const bdld::DatumArrayRef array = map[2].value().theArray();
+            ASSERT( isInRange(array[0].theString(), INPUT));
+            ASSERT(!isInRange(array[1].theString(), INPUT));
+
+            bdld::Datum::destroy(result, &ta);
+            ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+            ASSERTV(da.numBytesInUse(), 0 == da.numBytesInUse());
+        }
+
+        if (verbose) cout << "\nMember names with escape sequences." << endl;
+        {
+            const bsl::string INPUT("{\"plain\":1,\"esc\\taped\":2,\"\":3}",
+                                    &ia);
+
+            bdld::Datum result;
+            ASSERT(0 == Obj::decode(&result, INPUT, &ta));
+            ASSERTV(render(result),
+                    "{plain:1,esc\taped:2,:3}" == render(result));
+
+            const bdld::DatumMapRef map = result.theMap();
+            ASSERT(map.ownsKeys());
+
+            for (bdld::Datum::SizeType i = 0; i < map.size(); ++i) {
+                ASSERTV(i, !isInRange(map[i].key(), INPUT)
+                                                  || map[i].key().isEmpty());
+            }
+
+            bdld::Datum::destroy(result, &ta);
+            ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+            ASSERTV(da.numBytesInUse(), 0 == da.numBytesInUse());
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCERN: ARRAYS AND OBJECTS ARE DECODED
+        //
+        // Concerns:
+        //: 1 Arrays and objects, possibly empty, nested, or having elements
+        //:   of different types, are decoded into 'bdld::Datum' arrays and
+        //:   maps, keeping the order of their elements.
+        //:
+        //: 2 Whitespace is allowed around any token.
+        //:
+        //: 3 Invalid JSON data is rejected, leaving the result unchanged.
+        //:
+        //: 4 No memory is leaked, whether decoding succeeds or fails.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, specify a set of JSON inputs,
+        //:   whether each is valid, and the canonical representation of the
+        //:   value it holds.
+        //:
+        //: 2 For each row of the table, decode the input using a test
+        //:   allocator, verify the return code, and, on success, the decoded
+        //:   value; otherwise verify that the result is unchanged.  Verify
+        //:   that no memory remains in use once the result is destroyed.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   CONCERN: ARRAYS AND OBJECTS ARE DECODED
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: ARRAYS AND OBJECTS ARE DECODED" << endl
+                          << "=======================================" << endl;
+
+        static const struct {
+            int         d_line;     // source line number
+            const char *d_input_p;  // JSON input
+            bool        d_isValid;  // whether the input is valid
+            const char *d_exp_p;    // canonical representation of the result
+        } DATA[] = {
+            //line input                          valid expected
+            //---- -----                          ----- --------
+            { L_,  "[]",                          true, "[]"                },
+            { L_,  "{}",                          true, "{}"                },
+            { L_,  " [ ] ",                       true, "[]"                },
+            { L_,  "[1]",                         true, "[1]"               },
+            { L_,  "[1,2,3]",                     true, "[1,2,3]"           },
+            { L_,  "[\"a\",\"b\"]",               true, "['a','b']"         },
+            { L_,  "[1,\"a\",true,null]",         true, "[1,'a',true,null]" },
+            { L_,  "[[]]",                        true, "[[]]"              },
+            { L_,  "[[],[]]",                     true, "[[],[]]"           },
+            { L_,  "[[1],2]",                     true, "[[1],2]"           },
+            { L_,  "[[1],\"a\"]",                 true, "[[1],'a']"         },
+            { L_,  "[{},1]",                      true, "[{},1]"            },
+            { L_,  "[{},\"a\"]",                  true, "[{},'a']"          },
+            { L_,  "[{},[]]",                     true, "[{},[]]"           },
+            { L_,  "[[],{}]",                     true, "[[],{}]"           },
+            { L_,  "[1,[2],3,\"x\"]",             true, "[1,[2],3,'x']"     },
+            { L_,  "{\"a\":1}",                   true, "{a:1}"             },
+            { L_,  "{\"a\":1,\"b\":\"c\"}",       true, "{a:1,b:'c'}"       },
+            { L_,  "{\"b\":1,\"a\":2}",           true, "{b:1,a:2}"         },
+            { L_,  "{\"a\":1,\"a\":2}",           true, "{a:1,a:2}"         },
+            { L_,  "{\"a\":[1,{\"b\":[]}]}",      true, "{a:[1,{b:[]}]}"    },
+            { L_,  "{\"a\":{},\"b\":[]}",         true, "{a:{},b:[]}"       },
+            { L_,  "{\"a\":[1],\"b\":2}",         true, "{a:[1],b:2}"       },
+            { L_,  "{\"\":1}",                    true, "{:1}"              },
+            { L_,  " { \"a\" : [ 1 , 2 ] } \n",   true, "{a:[1,2]}"         },
+
+            { L_,  "[",                           false, ""                 },
+            { L_,  "]",                           false, ""                 },
+            { L_,  "{",                           false, ""                 },
+            { L_,  "[1,]",                        false, ""                 },
+            { L_,  "[,1]",                        false, ""                 },
+            { L_,  "[1 2]",                       false, ""                 },
+            { L_,  "[[1],\"a\":2]",               false, ""                 },
+            { L_,  "[1}",                         false, ""                 },
+            { L_,  "{1}",                         false, ""                 },
+            { L_,  "{\"a\"}",                     false, ""                 },
+            { L_,  "{\"a\":}",                    false, ""                 },
+            { L_,  "{\"a\":1,}",                  false, ""                 },
+            { L_,  "{\"a\":1 \"b\":2}",           false, ""                 },
+            { L_,  "{\"a\":[1],2}",               false, ""                 },
+            { L_,  "{\"a\":{},[]}",               false, ""                 },
+            { L_,  "{\"a\":[\"b\",[1],\"c\"}",    false, ""                 },
+            { L_,  "[1] [2]",                     false, ""                 },
+            { L_,  "[1] x",                       false, ""                 },
+            { L_,  "{\"a\":\"b\\x\"}",            false, ""                 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int          LINE     = DATA[ti].d_line;
+            const bsl::string  INPUT    = DATA[ti].d_input_p;
+            const bool         IS_VALID = DATA[ti].d_isValid;
+            const bsl::string  EXP      = DATA[ti].d_exp_p;
+
+            if (veryVerbose) {
+                P_(LINE) P(INPUT)
+            }
+
+            bslma::TestAllocator ta("result", veryVeryVerbose);
+
+            bdld::Datum result = bdld::Datum::createInteger(7);
+
+            const int rc = Obj::decode(&result, INPUT, &ta);
+            ASSERTV(LINE, rc, IS_VALID == (0 == rc));
+
+            if (0 == rc) {
+                ASSERTV(LINE, EXP, render(result), EXP == render(result));
+                bdld::Datum::destroy(result, &ta);
+            }
+            else {
+                ASSERTV(LINE, result.isInteger() && 7 == result.theInteger());
+            }
+            ASSERTV(LINE, ta.numBytesInUse(), 0 == ta.numBytesInUse());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'decode' OF SCALAR VALUES
+        //
+        // Concerns:
+        //: 1 Strings, numbers, 'true', 'false', and 'null' are decoded into
+        //:   the corresponding 'bdld::Datum' types.
+        //:
+        //: 2 Escape sequences in strings are unescaped.
+        //:
+        //: 3 Invalid values are rejected.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, specify a set of JSON inputs
+        //:   holding a single value, whether each is valid, and the canonical
+        //:   representation of the value it holds.
+        //:
+        //: 2 For each row of the table, decode the input, both alone and as
+        //:   the single element of an array, and verify the return code and,
+        //:   on success, the decoded value.  (C-1..3)
+        //
+        // Testing:
+        //   int decode(Datum *r, const StringRef& json, Allocator *bA);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'decode' OF SCALAR VALUES" << endl
+                          << "=================================" << endl;
+
+        static const struct {
+            int         d_line;     // source line number
+            const char *d_input_p;  // JSON input
+            bool        d_isValid;  // whether the input is valid
+            const char *d_exp_p;    // canonical representation of the result
+        } DATA[] = {
+            //line input                   valid  expected
+            //---- -----                   -----  --------
+            { L_,  "\"\"",                 true,  "''"              },
+            { L_,  "\"abc\"",              true,  "'abc'"           },
+            { L_,  "\"a b\"",              true,  "'a b'"           },
+            { L_,  "\"a\\\"b\"",           true,  "'a\"b'"          },
+            { L_,  "\"a\\\\b\"",           true,  "'a\\b'"          },
+            { L_,  "\"a\\/b\"",            true,  "'a/b'"           },
+            { L_,  "\"\\n\\t\"",           true,  "'\n\t'"          },
+            { L_,  "\"\\u0041\"",          true,  "'A'"             },
+            { L_,  "0",                    true,  "0"               },
+            { L_,  "1",                    true,  "1"               },
+            { L_,  "-1",                   true,  "-1"              },
+            { L_,  "1.5",                  true,  "1.5"             },
+            { L_,  "-2.5e3",               true,  "-2500"           },
+            { L_,  "1E2",                  true,  "100"             },
+            { L_,  "true",                 true,  "true"            },
+            { L_,  "false",                true,  "false"           },
+            { L_,  "null",                 true,  "null"            },
+
+            { L_,  "",                     false, ""                },
+            { L_,  "\"abc",                false, ""                },
+            { L_,  "\"a\\qb\"",            false, ""                },
+            { L_,  "tru",                  false, ""                },
+            { L_,  "truex",                false, ""                },
+            { L_,  "nul",                  false, ""                },
+            { L_,  "False",                false, ""                },
+            { L_,  "1x",                   false, ""                },
+            { L_,  "abc",                  false, ""                },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int          LINE     = DATA[ti].d_line;
+            const bsl::string  INPUT    = DATA[ti].d_input_p;
+            const bool         IS_VALID = DATA[ti].d_isValid;
+            const bsl::string  EXP      = DATA[ti].d_exp_p;
+
+            if (veryVerbose) {
+                P_(LINE) P(INPUT)
+            }
+
+            bslma::TestAllocator ta("result", veryVeryVerbose);
+
+            {
+                bdld::Datum result;
+                const int rc = Obj::decode(&result, INPUT, &ta);
+                ASSERTV(LINE, rc, IS_VALID == (0 == rc));
+
+                if (0 == rc) {
+                    ASSERTV(LINE, EXP, render(result), EXP == render(result));
+                    bdld::Datum::destroy(result, &ta);
+                }
+            }
+            if (bsl::string::npos != INPUT.find_first_not_of(" \t\n\r")) {
+                // An input having no value would make a valid empty array.
+
+                const bsl::string ARRAY = "[" + INPUT + "]";
+
+                bdld::Datum result;
+                const int rc = Obj::decode(&result, ARRAY, &ta);
+                ASSERTV(LINE, rc, IS_VALID == (0 == rc));
+
+                if (0 == rc) {
+                    ASSERTV(LINE, EXP, render(result),
+                            "[" + EXP + "]" == render(result));
+                    bdld::Datum::destroy(result, &ta);
+                }
+            }
+            ASSERTV(LINE, ta.numBytesInUse(), 0 == ta.numBytesInUse());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Decode a JSON object holding values of each type, and verify the
+        //:   decoded value.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("result", veryVeryVerbose);
+
+        const char INPUT[] = "{\"s\":\"text\",\"n\":-1.25,\"b\":true,"
+                             "\"z\":null,\"a\":[1,\"two\",false],"
+                             "\"o\":{\"k\":\"v\"}}";
+
+        bdld::Datum result;
+        ASSERT(0 == Obj::decode(&result, INPUT, &ta));
+
+        const bsl::string EXP = "{s:'text',n:-1.25,b:true,z:null,"
+                                "a:[1,'two',false],o:{k:'v'}}";
+        ASSERTV(render(result), EXP == render(result));
+
+        bdld::Datum::destroy(result, &ta);
+        ASSERTV(ta.numBytesInUse(), 0 == ta.numBytesInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Measure the throughput of decoding a large document.
+        //
+        // Concerns:
+        //: 1 Decoding into a 'bdld::Datum' using a sequential allocator
+        //:   avoids the cost of individual allocations and deallocations.
+        //
+        // Plan:
+        //: 1 Create a document holding an array of objects whose values are
+        //:   strings, some with escaped characters, numbers, arrays, and
+        //:   literals, and decode it a number of times, specified on the
+        //:   command line, using a sequential allocator that is released
+        //:   after each decoding, and using the new-delete allocator and
+        //:   destroying the result after each decoding, reporting the
+        //:   throughput in MB/s.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        const int REPS        = argc > 2 ? atoi(argv[2]) : 10;
+        const int NUM_RECORDS = 20000;
+
+        bsl::string document("[");
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            if (i) {
+                document.append(",");
+            }
+            appendRecord(&document, i);
+        }
+        document.append("]");
+
+        const double megabytes =
+                          static_cast<double>(document.length()) * REPS / 1e6;
+
+        for (int useArena = 1; useArena >= 0; --useArena) {
+            bdlma::SequentialAllocator arena;
+            bslma::Allocator          *allocator =
+                                 useArena
+                                 ? static_cast<bslma::Allocator *>(&arena)
+                                 : &bslma::NewDeleteAllocator::singleton();
+
+            bsls::Stopwatch stopwatch;
+            stopwatch.start();
+
+            for (int i = 0; i < REPS; ++i) {
+                bdld::Datum result;
+                const int rc = Obj::decode(&result, document, allocator);
+                ASSERTV(rc, 0 == rc);
+                ASSERTV(NUM_RECORDS == result.theArray().length());
+
+                if (useArena) {
+                    arena.release();
+                }
+                else {
+                    bdld::Datum::destroy(result, allocator);
+                }
+            }
+
+            stopwatch.stop();
+
+            const double elapsed = stopwatch.elapsedTime();
+
+            cout << (useArena ? "Sequential allocator: "
+                              : "New-delete allocator: ")
+                 << document.length() << " bytes, "
+                 << elapsed << " seconds, "
+                 << (elapsed > 0 ? megabytes / elapsed : 0) << " MB/s"
+                 << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -22,6 +22,12 @@ BSLS_IDENT("$Id: $")
 //
 //: o one that reads from a 'bsl::streambuf'
 //: o one that reads from a 'bsl::istream'
+//: o one that reads from contiguous memory, supplied as a 'bslstl::StringRef'
+//
+// When the JSON data is already held in contiguous memory, the overload
+// taking a 'bslstl::StringRef' should be preferred: the data is tokenized in
+// place, without being copied into an internal buffer, and values are
+// converted directly from the supplied characters.
 //
 // This component can be used with types that support the 'bdeat' framework
 // (see the 'bdeat' package for details), which is a compile-time interface for
@@ -197,6 +203,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 #endif
 
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
 #ifndef INCLUDED_BSL_IOSTREAM
 #include <bsl_iostream.h>
 #endif
@@ -274,6 +284,13 @@ class Decoder {
         // formatting mode as specified in 'bdlat_FormattingMode'.  Note that
         // 'ANY_CATEGORY' shall be a tag-type defined in 'bdlat_TypeCategory'.
 
+    template <class TYPE>
+    int decodeFromTokenizer(TYPE *value, const DecoderOptions& options);
+        // Decode into the specified 'value', of a (template parameter) 'TYPE',
+        // the JSON data read by the tokenizer owned by this object, which has
+        // just been reset, using the specified 'options'.  Return 0 on
+        // success, and a non-zero value otherwise.
+
     int skipUnknownElement(const bslstl::StringRef& elementName);
         // Skip the unknown element specified by 'elementName' by discarding
         // all the data associated with it and advancing the parser to the next
@@ -329,6 +346,24 @@ class Decoder {
         // if decoding is successful, will attempt to update the input position
         // of 'stream' to the last unprocessed byte.
 
+    template <class TYPE>
+    int decode(const bslstl::StringRef&  input,
+               TYPE                     *value,
+               const DecoderOptions&     options);
+    template <class TYPE>
+    int decode(const bslstl::StringRef&  input,
+               TYPE                     *value,
+               const DecoderOptions     *options);
+        // Decode into the specified 'value', of a (template parameter) 'TYPE',
+        // the JSON data held in the specified 'input' and using the specified
+        // 'options'.  'TYPE' shall be a 'bdeat'-compatible sequence, choice,
+        // or array type, or a 'bdeat'-compatible dynamic type referring to
+        // one of those types.  Specifying a nullptr 'options' is equivalent to
+        // passing a default-constructed DecoderOptions in 'options'.  Return 0
+        // on success, and a non-zero value otherwise.  Note that 'input' is
+        // read in place, without being copied, and that any characters
+        // following the decoded JSON value are ignored.
+
     template <class TYPE>
     int decode(bsl::streambuf *streamBuf, TYPE *value);
         // Decode an object of (template parameter) 'TYPE' from the specified
@@ -934,13 +969,9 @@ Decoder::Decoder(bslma::Allocator *basicAllocator)
 {
 }
 
-// MANIPULATORS
 template <class TYPE>
-int Decoder::decode(bsl::streambuf        *streamBuf,
-                    TYPE                  *value,
-                    const DecoderOptions&  options)
+int Decoder::decodeFromTokenizer(TYPE *value, const DecoderOptions& options)
 {
-    BSLS_ASSERT(streamBuf);
     BSLS_ASSERT(value);
 
     bdlat_TypeCategory::Value category =
@@ -954,7 +985,6 @@ int Decoder::decode(bsl::streambuf        *streamBuf,
         return -1;                                                    // RETURN
     }
 
-    d_tokenizer.reset(streamBuf);
     d_tokenizer.setAllowStandAloneValues(false);
     d_tokenizer.setAllowHeterogenousArrays(false);
 
@@ -975,7 +1005,21 @@ int Decoder::decode(bsl::streambuf        *streamBuf,
     d_maxDepth            = options.maxDepth();
     d_skipUnknownElements = options.skipUnknownElements();
 
-    rc = decodeImp(value, 0, TypeCategory());
+    return decodeImp(value, 0, TypeCategory());
+}
+
+// MANIPULATORS
+template <class TYPE>
+int Decoder::decode(bsl::streambuf        *streamBuf,
+                    TYPE                  *value,
+                    const DecoderOptions&  options)
+{
+    BSLS_ASSERT(streamBuf);
+    BSLS_ASSERT(value);
+
+    d_tokenizer.reset(streamBuf);
+
+    const int rc = decodeFromTokenizer(value, options);
 
     d_tokenizer.resetStreamBufGetPointer();
 
@@ -1017,6 +1061,28 @@ int Decoder::decode(bsl::istream&          stream,
     return decode(stream, value, options ? *options : localOpts);
 }
 
+template <class TYPE>
+inline
+int Decoder::decode(const bslstl::StringRef&  input,
+                    TYPE                     *value,
+                    const DecoderOptions&     options)
+{
+    BSLS_ASSERT(value);
+
+    d_tokenizer.reset(input);
+
+    return decodeFromTokenizer(value, options);
+}
+
+template <class TYPE>
+int Decoder::decode(const bslstl::StringRef&  input,
+                    TYPE                     *value,
+                    const DecoderOptions     *options)
+{
+    DecoderOptions localOpts;
+    return decode(input, value, options ? *options : localOpts);
+}
+
 template <class TYPE>
 int Decoder::decode(bsl::streambuf *streamBuf, TYPE *value)
 {
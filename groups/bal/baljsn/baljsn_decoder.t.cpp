@@ -72,6 +72,8 @@ using bsl::endl;
 // [ 4] int decode(bsl::istream& stream, TYPE *v, options);
 // [ 4] int decode(bsl::streambuf *streamBuf, TYPE *v, &options);
 // [ 4] int decode(bsl::istream& stream, TYPE *v, &options);
+// [ 2] int decode(const bslstl::StringRef& input, TYPE *v, options);
+// [ 4] int decode(const bslstl::StringRef& input, TYPE *v, &options);
 //
 // ACCESSORS
 // [ 4] bsl::string loggedMessages() const;
@@ -38026,6 +38028,7 @@ int main(int argc, char *argv[])
         //   int decode(bsl::istream& stream, TYPE *v, options);
         //   int decode(bsl::streambuf *streamBuf, TYPE *v, &options);
         //   int decode(bsl::istream& stream, TYPE *v, &options);
+        //   int decode(const bslstl::StringRef& input, TYPE *v, &options);
         //   bsl::string loggedMessages() const;
         // --------------------------------------------------------------------
 
@@ -39005,6 +39008,23 @@ int main(int argc, char *argv[])
             }
         }
 
+        // Testing sequences read from contiguous memory
+        {
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int          LINE  = DATA[ti].d_lineNum;
+                const bsl::string& INPUT = DATA[ti].d_text_p;
+                case4::Employee bob;
+
+                baljsn::DecoderOptions options;
+                baljsn::Decoder        decoder;
+                const int RC = decoder.decode(INPUT, &bob, &options);
+                ASSERTV(LINE, RC, 0 != RC);
+                if (veryVerbose) {
+                    P(decoder.loggedMessages())
+                }
+            }
+        }
+
         // Testing choices
         {
             for (int ti = 0; ti < NUM_DATA; ++ti) {
@@ -39781,13 +39801,16 @@ int main(int argc, char *argv[])
         //:   5 Verify that the decoded object matches the original object
         //:     from step 1.
         //:
-        //:   6 Repeat steps 1 - 5 using JSON in the compact format.
+        //:   6 Repeat steps 4 - 5 decoding the JSON from contiguous memory.
+        //:
+        //:   7 Repeat steps 1 - 6 using JSON in the compact format.
         //
         // Testing:
         //   baljsn::Decoder(bslma::Allocator *basicAllocator = 0);
         //   ~baljsn::Decoder();
         //   int decode(bsl::streambuf *streamBuf, TYPE *v, options);
         //   int decode(bsl::istream& stream, TYPE *v, options);
+        //   int decode(const bslstl::StringRef& input, TYPE *v, options);
         // --------------------------------------------------------------------
 
         if (verbose) cout << endl
@@ -39833,6 +39856,17 @@ int main(int argc, char *argv[])
                 ASSERTV(LINE, decoder.loggedMessages(), EXP, value,
                         EXP == value);
             }
+
+            {
+                balb::FeatureTestMessage value;
+                baljsn::DecoderOptions   options;
+                baljsn::Decoder          decoder;
+
+                const int rc = decoder.decode(PRETTY, &value, options);
+                ASSERTV(LINE, decoder.loggedMessages(), rc, 0 == rc);
+                ASSERTV(LINE, decoder.loggedMessages(), EXP, value,
+                        EXP == value);
+            }
         }
 
         for (int ti = 0; ti < NUM_JSON_COMPACT_MESSAGES; ++ti) {
@@ -39860,6 +39894,17 @@ int main(int argc, char *argv[])
                 ASSERTV(LINE, decoder.loggedMessages(), EXP, value,
                         EXP == value);
             }
+
+            {
+                balb::FeatureTestMessage value;
+                baljsn::DecoderOptions   options;
+                baljsn::Decoder          decoder;
+
+                const int rc = decoder.decode(COMPACT, &value, options);
+                ASSERTV(LINE, decoder.loggedMessages(), rc, 0 == rc);
+                ASSERTV(LINE, decoder.loggedMessages(), EXP, value,
+                        EXP == value);
+            }
         }
       } break;
       case 1: {
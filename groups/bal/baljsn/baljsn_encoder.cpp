@@ -113,6 +113,20 @@ int Encoder_Formatter::openElement(const bsl::string& name)
     return 0;
 }
 
+void Encoder_Formatter::openElementWithQuotedName(
+                                         const bslstl::StringRef& quotedName)
+{
+    if (d_usePrettyStyle) {
+        bdlb::Print::indent(d_outputStream, d_indentLevel, d_spacesPerLevel);
+        d_outputStream.write(quotedName.data(), quotedName.length());
+        d_outputStream << " : ";
+    }
+    else {
+        d_outputStream.write(quotedName.data(), quotedName.length());
+        d_outputStream << ':';
+    }
+}
+
 void Encoder_Formatter::closeElement()
 {
     d_outputStream << ',';
@@ -135,6 +149,51 @@ void Encoder_Formatter::closeDocument()
     }
 }
 
+                       // ------------------------------
+                       // class Encoder_ElementNameTable
+                       // ------------------------------
+
+// CREATORS
+Encoder_ElementNameTable::Encoder_ElementNameTable(
+                                              bslma::Allocator *basicAllocator)
+: d_entries(basicAllocator)
+, d_buffer(basicAllocator)
+{
+}
+
+// MANIPULATORS
+void Encoder_ElementNameTable::addName(const char *name, int nameLength)
+{
+    Entry entry;
+    entry.d_nameOffset = static_cast<int>(d_buffer.length());
+    entry.d_nameLength = nameLength;
+
+    d_buffer.append(name, nameLength);
+
+    // Format the name exactly as 'Encoder_Formatter::openElement' does.  If
+    // that fails, the entry is left without a quoted name, so that the
+    // failure is reported when an element having that name is encoded.
+
+    bslma::Allocator *allocator = d_buffer.get_allocator().mechanism();
+
+    const bsl::string  unquotedName(name, nameLength, allocator);
+    bsl::ostringstream stream(allocator);
+
+    const int rc = PrintUtil::printValue(stream, unquotedName);
+
+    entry.d_quotedNameOffset = static_cast<int>(d_buffer.length());
+    entry.d_quotedNameLength = 0;
+
+    if (0 == rc && stream) {
+        const bsl::string& quotedName = stream.str();
+
+        d_buffer.append(quotedName);
+        entry.d_quotedNameLength = static_cast<int>(quotedName.length());
+    }
+
+    d_entries.push_back(entry);
+}
+
                           // ------------------------
                           // class Encoder_EncodeImpl
                           // ------------------------
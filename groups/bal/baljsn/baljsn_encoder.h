@@ -12,7 +12,7 @@ BSLS_IDENT("$Id: $")
 //@CLASSES:
 // baljsn::Encoder: JSON decoder for 'bdeat'-compliant types
 //
-//@SEE_ALSO: baljsn_decoder, baljsn_printutil
+//@SEE_ALSO: baljsn_decoder, baljsn_printutil, btlb_blobstreambuf
 //
 //@DESCRIPTION: This component provides a class, 'baljsn::Encoder', for
 // encoding value-semantic objects in the JSON format.  In particular, the
@@ -22,6 +22,7 @@ BSLS_IDENT("$Id: $")
 //
 //: o one that writes to a 'bsl::streambuf'
 //: o one that writes to an 'bsl::ostream'
+//: o one that appends to a 'btlb::Blob'
 //
 // This component can be used with types that support the 'bdeat' framework
 // (see the 'bdeat' package for details), which is a compile-time interface for
@@ -40,6 +41,43 @@ BSLS_IDENT("$Id: $")
 // Refer to the details of the JSON encoding format supported by this decoder
 // in the package documentation file (doc/baljsn.txt).
 //
+///Element Names
+///-------------
+// The names of the elements of a sequence are the same in every object of a
+// given sequence type, but the quoting and escaping required to write a name
+// as a JSON string is not free.  The first time an object of a sequence type
+// is encoded, the encoder therefore records the names of the attributes of
+// that type, already quoted and escaped, in a table that lives for the rest of
+// the program and is shared by all encoders and all threads.  Subsequent
+// encodings of that type copy each element name from this table instead of
+// formatting it again.  An attribute whose name does not match the one
+// recorded (as may happen with dynamic types, whose attributes can differ from
+// one object to the next) has its name formatted as usual, so the encoded
+// output is unaffected by the table.  Note that the tables are allocated from
+// the global allocator (see 'bslma_default'), and are never deallocated.
+//
+///Output Destinations
+///-------------------
+// The encoder writes its output directly to the destination, without
+// buffering the whole of the encoded data, so the memory needed to encode an
+// object does not depend on its size, beyond that of the destination itself.
+// In particular:
+//
+//: o The 'encode' overloads taking a 'btlb::Blob' append the output to the
+//:   blob, writing it directly into the buffers of the blob, which are
+//:   obtained as needed from the blob buffer factory of the blob (e.g., a
+//:   'btlb::PooledBlobBufferFactory').  Data to be sent from a blob, such as
+//:   by a 'btlmt::ChannelPool', therefore need not be encoded into a
+//:   'bsl::ostringstream' first, and then copied into a blob.
+//:
+//: o Encoding into a 'bdlsb::FixedMemOutStreamBuf' writes the output into a
+//:   buffer supplied by the caller, such as a buffer taken from a pool,
+//:   without allocating memory.
+//
+// Encoding fails if the destination does not accept all of the output, as
+// happens when the output does not fit in the buffer of a
+// 'bdlsb::FixedMemOutStreamBuf'.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -184,6 +222,26 @@ BSLS_IDENT("$Id: $")
 #include <bdlb_print.h>
 #endif
 
+#ifndef INCLUDED_BTLB_BLOB
+#include <btlb_blob.h>
+#endif
+
+#ifndef INCLUDED_BTLB_BLOBSTREAMBUF
+#include <btlb_blobstreambuf.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_ONCE
+#include <bslmt_once.h>
+#endif
+
 #ifndef INCLUDED_BSLS_ASSERT
 #include <bsls_assert.h>
 #endif
@@ -192,6 +250,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 #endif
 
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
 #ifndef INCLUDED_BSL_IOSTREAM
 #include <bsl_iostream.h>
 #endif
@@ -289,6 +351,27 @@ class Encoder {
         // type, or a 'bdeat'-compatible dynamic type referring to one of those
         // types.  Return 0 on success, and a non-zero value otherwise.
 
+    template <class TYPE>
+    int encode(btlb::Blob            *blob,
+               const TYPE&            value,
+               const EncoderOptions&  options);
+    template <class TYPE>
+    int encode(btlb::Blob            *blob,
+               const TYPE&            value,
+               const EncoderOptions  *options);
+        // Encode the specified 'value', of (template parameter) 'TYPE', in the
+        // JSON format using the specified 'options' and append the output to
+        // the specified 'blob', writing it directly into the buffers of
+        // 'blob', which are obtained, as needed, from the blob buffer factory
+        // of 'blob'.  Specifying a nullptr 'options' is equivalent to passing
+        // a default-constructed EncoderOptions in 'options'.  'TYPE' shall be
+        // a 'bdeat'-compatible sequence, choice, or array type, or a
+        // 'bdeat'-compatible dynamic type referring to one of those types.
+        // Return 0 on success, and a non-zero value, leaving the length of
+        // 'blob' unchanged, otherwise.  Note that, on failure, the buffers
+        // added to 'blob' to hold the partial output are kept in 'blob',
+        // beyond its length.
+
     template <class TYPE>
     int encode(bsl::streambuf *streamBuf, const TYPE& value);
         // Encode the specified 'value' of (template parameter) 'TYPE' into the
@@ -381,6 +464,12 @@ class Encoder_Formatter {
         // characters designating the start of an element having the specified
         // 'name'.  Return 0 on success and a non-zero value otherwise.
 
+    void openElementWithQuotedName(const bslstl::StringRef& quotedName);
+        // Print onto the stream supplied at construction the sequence of
+        // characters designating the start of an element having the specified
+        // 'quotedName', which is the name of the element already formatted as
+        // a JSON string.
+
     void closeElement();
         // Print onto the stream supplied at construction the sequence of
         // characters designating the end of an element.
@@ -403,6 +492,86 @@ class Encoder_Formatter {
         // to an array element.
 };
 
+                       // ==============================
+                       // class Encoder_ElementNameTable
+                       // ==============================
+
+class Encoder_ElementNameTable {
+    // This class provides a table of the names of the attributes of a 'bdeat'
+    // sequence type, in the order in which they are visited by
+    // 'bdlat_SequenceFunctions::accessAttributes', each formatted as a JSON
+    // string.  A table is created, by the 'forType' class method, the first
+    // time an object of a given sequence type is encoded, and is then shared
+    // by all encoders and all threads.  This is a component-private class and
+    // should not be used outside of this component.
+
+    // PRIVATE TYPES
+    struct Entry {
+        // This 'struct' locates the name of an attribute, and its quoted
+        // form, in the buffer of a table.
+
+        int d_nameOffset;        // offset of the name
+        int d_nameLength;        // length of the name
+        int d_quotedNameOffset;  // offset of the quoted name
+        int d_quotedNameLength;  // length of the quoted name, or 0 if the
+                                 // name could not be formatted
+    };
+
+    // DATA
+    bsl::vector<Entry> d_entries;  // one entry per attribute
+    bsl::string        d_buffer;   // names and quoted names of all attributes
+
+  private:
+    // NOT IMPLEMENTED
+    Encoder_ElementNameTable(const Encoder_ElementNameTable&);
+    Encoder_ElementNameTable& operator=(const Encoder_ElementNameTable&);
+
+  public:
+    // CLASS METHODS
+    template <class TYPE>
+    static const Encoder_ElementNameTable& forType(const TYPE& object);
+        // Return a reference to the table of the names of the attributes of
+        // the (template parameter) 'TYPE', creating it from the attributes of
+        // the specified 'object' if this is the first call for 'TYPE'.  The
+        // behavior is undefined unless 'TYPE' is a 'bdeat' sequence type.
+        // Note that the table is allocated from the global allocator (not the
+        // allocator of any encoder, nor the default allocator) and is
+        // intentionally never destroyed: it is created at most once per
+        // 'TYPE', so the memory it holds is bounded by the number of sequence
+        // types encoded, and it remains valid for encoders used during the
+        // destruction of static objects.  Leak checkers may therefore report
+        // the memory of each table at exit.
+
+    // CREATORS
+    explicit Encoder_ElementNameTable(bslma::Allocator *basicAllocator = 0);
+        // Create an empty table.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    //! ~Encoder_ElementNameTable() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void addName(const char *name, int nameLength);
+        // Append to this table the specified 'name' having the specified
+        // 'nameLength', and its form quoted and escaped as a JSON string.
+
+    template <class TYPE, class INFO>
+    int operator()(const TYPE&, const INFO& info);
+        // Append to this table the name of the attribute described by the
+        // specified 'info', and return 0.  Note that this operator matches the
+        // signature required of the visitors passed to
+        // 'bdlat_SequenceFunctions::accessAttributes'.
+
+    // ACCESSORS
+    bslstl::StringRef quotedName(int         index,
+                                 const char *name,
+                                 int         nameLength) const;
+        // Return the quoted form of the name of the attribute at the specified
+        // 'index' in this table if that name is the specified 'name' having
+        // the specified 'nameLength', and an empty string reference otherwise.
+};
+
                           // ========================
                           // class Encoder_EncodeImpl
                           // ========================
@@ -501,6 +670,10 @@ class Encoder_EncodeImpl {
     const EncoderOptions *encoderOptions() const;
         // Return a reference to the non-modifiable encoder options currently
         // being used by this encoder.
+
+    bool isOutputValid() const;
+        // Return 'true' if all of the output was accepted by the 'streambuf'
+        // supplied at construction, and 'false' otherwise.
 };
 
                        // =============================
@@ -547,10 +720,20 @@ class Encoder_SequenceVisitor {
     // sequence types.
 
     // DATA
-    Encoder_EncodeImpl *d_encoder_p;        // encoder (held, not owned)
-    bool                       d_isFirstElement;   // flag indicating if an
-                                                   // current element is the
-                                                   // first
+    Encoder_EncodeImpl             *d_encoder_p;        // encoder (held, not
+                                                        // owned)
+
+    const Encoder_ElementNameTable *d_elementNames_p;   // names of the
+                                                        // attributes of the
+                                                        // sequence (held, not
+                                                        // owned)
+
+    int                             d_index;            // index of the next
+                                                        // attribute visited
+
+    bool                            d_isFirstElement;   // flag indicating if
+                                                        // an current element
+                                                        // is the first
 
     // PRIVATE CLASS METHODS
     template <class TYPE>
@@ -574,9 +757,11 @@ class Encoder_SequenceVisitor {
 
   public:
     // CREATORS
-    explicit Encoder_SequenceVisitor(Encoder_EncodeImpl *encoder);
+    Encoder_SequenceVisitor(Encoder_EncodeImpl             *encoder,
+                            const Encoder_ElementNameTable *elementNames);
         // Create a 'Encoder_SequenceVisitor' object using the specified
-        // 'encoder'.
+        // 'encoder', and the specified 'elementNames' of the attributes of the
+        // sequence being visited.
 
     // MANIPULATORS
     template <class TYPE, class INFO>
@@ -687,6 +872,11 @@ int Encoder::encode(bsl::streambuf        *streamBuf,
 
     streamBuf->pubsync();
 
+    if (!rc && !encoderImpl.isOutputValid()) {
+        logStream() << "Unable to write the encoded data." << bsl::endl;
+        return -1;                                                    // RETURN
+    }
+
     return rc;
 }
 
@@ -699,6 +889,37 @@ int Encoder::encode(bsl::streambuf        *streamBuf,
     return encode(streamBuf, value, options ? *options : localOpts);
 }
 
+template <class TYPE>
+int Encoder::encode(btlb::Blob            *blob,
+                    const TYPE&            value,
+                    const EncoderOptions&  options)
+{
+    BSLS_ASSERT(blob);
+
+    const int length = blob->length();
+
+    int rc;
+    {
+        btlb::OutBlobStreamBuf streamBuf(blob);
+        rc = encode(&streamBuf, value, options);
+    }
+
+    if (rc) {
+        blob->setLength(length);
+    }
+
+    return rc;
+}
+
+template <class TYPE>
+int Encoder::encode(btlb::Blob            *blob,
+                    const TYPE&            value,
+                    const EncoderOptions  *options)
+{
+    EncoderOptions localOpts;
+    return encode(blob, value, options ? *options : localOpts);
+}
+
 template <class TYPE>
 int Encoder::encode(bsl::ostream&         stream,
                     const TYPE&           value,
@@ -751,6 +972,65 @@ bool Encoder_Formatter::isArrayElement() const
     return d_isArrayElement;
 }
 
+                       // ------------------------------
+                       // class Encoder_ElementNameTable
+                       // ------------------------------
+
+// CLASS METHODS
+template <class TYPE>
+const Encoder_ElementNameTable& Encoder_ElementNameTable::forType(
+                                                            const TYPE& object)
+{
+    static const Encoder_ElementNameTable *s_table_p = 0;
+
+    BSLMT_ONCE_DO {
+        // The table is intentionally leaked (see the contract of 'forType').
+
+        bslma::Allocator *allocator = bslma::Default::globalAllocator();
+
+        Encoder_ElementNameTable *table =
+                         new (*allocator) Encoder_ElementNameTable(allocator);
+        bdlat_SequenceFunctions::accessAttributes(object, *table);
+
+        s_table_p = table;
+    }
+
+    return *s_table_p;
+}
+
+// MANIPULATORS
+template <class TYPE, class INFO>
+inline
+int Encoder_ElementNameTable::operator()(const TYPE&, const INFO& info)
+{
+    addName(info.name(), info.nameLength());
+    return 0;
+}
+
+// ACCESSORS
+inline
+bslstl::StringRef Encoder_ElementNameTable::quotedName(
+                                                int         index,
+                                                const char *name,
+                                                int         nameLength) const
+{
+    if (index >= static_cast<int>(d_entries.size())) {
+        return bslstl::StringRef();                                   // RETURN
+    }
+
+    const Entry& entry = d_entries[index];
+    if (nameLength != entry.d_nameLength
+     || 0 != d_buffer.compare(entry.d_nameOffset,
+                              nameLength,
+                              name,
+                              nameLength)) {
+        return bslstl::StringRef();                                   // RETURN
+    }
+
+    return bslstl::StringRef(d_buffer.data() + entry.d_quotedNameOffset,
+                             entry.d_quotedNameLength);
+}
+
                           // ------------------------
                           // class Encoder_EncodeImpl
                           // ------------------------
@@ -812,7 +1092,8 @@ int Encoder_EncodeImpl::encodeImp(const TYPE&                  value,
         d_formatter.openObject();
     }
 
-    Encoder_SequenceVisitor visitor(this);
+    Encoder_SequenceVisitor visitor(this,
+                                    &Encoder_ElementNameTable::forType(value));
 
     const bool isArrayElement = d_formatter.isArrayElement();
 
@@ -959,6 +1240,12 @@ const EncoderOptions *Encoder_EncodeImpl::encoderOptions() const
     return d_encoderOptions_p;
 }
 
+inline
+bool Encoder_EncodeImpl::isOutputValid() const
+{
+    return d_outputStream.good();
+}
+
                        // ------------------------------
                        // struct Encoder_SequenceVisitor
                        // ------------------------------
@@ -1023,8 +1310,11 @@ bool Encoder_SequenceVisitor::isEmptyArray(const TYPE& value)
 // CREATORS
 inline
 Encoder_SequenceVisitor::Encoder_SequenceVisitor(
-                                            Encoder_EncodeImpl *encoder)
+                                Encoder_EncodeImpl             *encoder,
+                                const Encoder_ElementNameTable *elementNames)
 : d_encoder_p(encoder)
+, d_elementNames_p(elementNames)
+, d_index(0)
 , d_isFirstElement(true)
 {
 }
@@ -1033,6 +1323,8 @@ Encoder_SequenceVisitor::Encoder_SequenceVisitor(
 template <class TYPE, class INFO>
 int Encoder_SequenceVisitor::operator()(const TYPE& value, const INFO& info)
 {
+    const int index = d_index++;
+
     // Determine if 'value' is null or an empty array where we don't want to
     // encode empty arrays.  In either of those cases, do not encode 'value'.
 
@@ -1048,9 +1340,34 @@ int Encoder_SequenceVisitor::operator()(const TYPE& value, const INFO& info)
 
     d_isFirstElement = false;
 
-    Encoder_ElementVisitor visitor = { d_encoder_p,
-                                              info.formattingMode() };
-    return visitor(value, info);
+    const int mode = info.formattingMode();
+
+    Encoder_ElementVisitor visitor = { d_encoder_p, mode };
+
+    if (bdlat_FormattingMode::e_UNTAGGED & mode) {
+        return visitor(value, info);                                  // RETURN
+    }
+
+    const bslstl::StringRef quotedName = d_elementNames_p->quotedName(
+                                                         index,
+                                                         info.name(),
+                                                         info.nameLength());
+    if (quotedName.isEmpty()) {
+        // The name is not in the table: format it.
+
+        return visitor(value, info);                                  // RETURN
+    }
+
+    d_encoder_p->d_formatter.openElementWithQuotedName(quotedName);
+
+    const int rc = d_encoder_p->encode(value, mode);
+    if (rc) {
+        d_encoder_p->logStream() << "Unable to encode value of element "
+                                 << "named: '" << info.name() << "'."
+                                 << bsl::endl;
+        return rc;                                                    // RETURN
+    }
+    return 0;
 }
 
                        // -----------------------------
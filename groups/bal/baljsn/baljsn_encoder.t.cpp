@@ -18,8 +18,12 @@
 #include <bdlde_utf8util.h>
 
 #include <bdlsb_fixedmeminstreambuf.h>
+#include <bdlsb_fixedmemoutstreambuf.h>
 #include <bdlsb_memoutstreambuf.h>
 
+#include <btlb_blob.h>
+#include <btlb_pooledblobbufferfactory.h>
+
 // These header are for testing only and the hierarchy level of 'baljsn' was
 // increase because of them.  They should be remove when possible.
 #include <balxml_decoder.h>
@@ -45,9 +49,13 @@
 
 #include <bslmf_assert.h>
 
+#include <bsls_stopwatch.h>
+
+#include <bsl_algorithm.h>
 #include <bsl_climits.h>
 #include <bsl_cstddef.h>
 #include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
 #include <bsl_iostream.h>
 #include <bsl_limits.h>
 #include <bsl_memory.h>
@@ -85,12 +93,18 @@ using bsl::endl;
 // [13] int encode(bsl::ostream& stream, const TYPE& v, options);
 // [13] int encode(bsl::streambuf *streamBuf, const TYPE& v, &options);
 // [13] int encode(bsl::ostream& stream, const TYPE& v, &options);
+// [16] int encode(btlb::Blob *blob, const TYPE& v, options);
+// [16] int encode(btlb::Blob *blob, const TYPE& v, &options);
 //
 // ACCESSORS
 // [13] bsl::string loggedMessages() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [14] USAGE EXAMPLE
+// [15] CONCERN: ELEMENT NAMES ARE FORMATTED ONCE PER TYPE
+// [16] CONCERN: OUTPUT IS WRITTEN DIRECTLY TO BLOBS AND FIXED BUFFERS
+// [-1] PERFORMANCE TEST
+// [-2] PERFORMANCE TEST: OUTPUT DESTINATIONS
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -30276,6 +30290,20 @@ void testNumber()
     }
 }
 
+bsl::string blobToString(const btlb::Blob& blob)
+    // Return the data held by the specified 'blob'.
+{
+    bsl::string result;
+    for (int i = 0, remaining = blob.length(); 0 < remaining; ++i) {
+        const btlb::BlobBuffer& buffer = blob.buffer(i);
+        const int               length = bsl::min(buffer.size(), remaining);
+
+        result.append(buffer.data(), length);
+        remaining -= length;
+    }
+    return result;
+}
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -30294,6 +30322,298 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
+      case 16: {
+        // --------------------------------------------------------------------
+        // CONCERN: OUTPUT IS WRITTEN DIRECTLY TO BLOBS AND FIXED BUFFERS
+        //
+        // Concerns:
+        //: 1 Encoding into a blob appends to the blob the same output as
+        //:   encoding into a stream, spanning as many blob buffers as
+        //:   needed.
+        //:
+        //: 2 Encoding into a blob that already holds data keeps that data.
+        //:
+        //: 3 If encoding into a blob fails, the length of the blob is
+        //:   unchanged.
+        //:
+        //: 4 Encoding into a fixed buffer succeeds if the output fits in the
+        //:   buffer, and fails otherwise.
+        //
+        // Plan:
+        //: 1 Encode each of the test messages, in both styles, into a stream
+        //:   and into blobs whose buffers are much smaller than the output,
+        //:   with and without prior content, and verify that the contents of
+        //:   the blobs are as expected.  (C-1..2)
+        //:
+        //: 2 Encode an object that cannot be encoded into a blob holding
+        //:   data, and verify that the length of the blob is unchanged.
+        //:   (C-3)
+        //:
+        //: 3 Encode an object into fixed buffers as large as the output, and
+        //:   one byte smaller, and verify the results.  (C-4)
+        //
+        // Testing:
+        //   int encode(btlb::Blob *blob, const TYPE& v, options);
+        //   int encode(btlb::Blob *blob, const TYPE& v, &options);
+        //   CONCERN: OUTPUT IS WRITTEN DIRECTLY TO BLOBS AND FIXED BUFFERS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+           << endl
+           << "CONCERN: OUTPUT IS WRITTEN DIRECTLY TO BLOBS AND FIXED BUFFERS"
+           << endl
+           << "=============================================================="
+           << endl;
+
+        bsl::vector<bsl::pair<int, balb::FeatureTestMessage> > testObjects;
+        constructFeatureTestMessage(&testObjects);
+
+        const int NUM_OBJECTS = static_cast<int>(testObjects.size());
+
+        if (verbose) cout << "\nTesting encoding into blobs." << endl;
+        {
+            bslma::TestAllocator           ta("blob", veryVeryVerbose);
+            btlb::PooledBlobBufferFactory  factory(16, &ta);
+
+            for (int style = 0; style < 2; ++style) {
+                Options options;
+                if (style) {
+                    options.setEncodingStyle(Options::e_PRETTY);
+                    options.setSpacesPerLevel(2);
+                }
+
+                for (int j = 0; j < NUM_OBJECTS; ++j) {
+                    const int                       LINE  =
+                                                         testObjects[j].first;
+                    const balb::FeatureTestMessage& VALUE =
+                                                         testObjects[j].second;
+
+                    Obj                encoder;
+                    bsl::ostringstream oss;
+                    ASSERTV(LINE, 0 == encoder.encode(oss, VALUE, options));
+
+                    const bsl::string& EXP = oss.str();
+
+                    btlb::Blob blob(&factory, &ta);
+                    ASSERTV(LINE, 0 == encoder.encode(&blob, VALUE, options));
+                    ASSERTV(LINE, EXP, blobToString(blob),
+                            EXP == blobToString(blob));
+                    ASSERTV(LINE, static_cast<int>(EXP.length()) <= 16
+                                                     || 1 < blob.numBuffers());
+
+                    btlb::Blob prefixed(&factory, &ta);
+                    prefixed.setLength(5);
+                    bsl::memcpy(prefixed.buffer(0).data(), "abcde", 5);
+
+                    ASSERTV(LINE, 0 == encoder.encode(&prefixed,
+                                                      VALUE,
+                                                      &options));
+                    ASSERTV(LINE, "abcde" + EXP == blobToString(prefixed));
+                }
+            }
+            ASSERTV(ta.numBlocksTotal(), 0 < ta.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nTesting failures to encode into blobs."
+                          << endl;
+        {
+            btlb::PooledBlobBufferFactory factory(16);
+
+            balb::Sequence2 mX;  const balb::Sequence2& X = mX;
+            mX.element1() = balb::CustomString("Hello");
+            mX.element2() = 4;
+            mX.element3() = bdlt::DatetimeTz(bdlt::Datetime(2018, 1, 2), 0);
+            mX.element5() = bsl::numeric_limits<double>::quiet_NaN();
+
+            btlb::Blob blob(&factory);
+            blob.setLength(5);
+            bsl::memcpy(blob.buffer(0).data(), "abcde", 5);
+
+            Obj encoder;
+            ASSERT(0 != encoder.encode(&blob, X, Options()));
+            ASSERTV(blob.length(), 5 == blob.length());
+            ASSERTV(blobToString(blob), "abcde" == blobToString(blob));
+
+            mX.element5() = 0.5;
+
+            ASSERT(0 == encoder.encode(&blob, X, Options()));
+            ASSERTV(blobToString(blob),
+                    "abcde{\"element1\":\"Hello\",\"element2\":4,"
+                    "\"element3\":\"2018-01-02T00:00:00.000+00:00\","
+                    "\"element5\":0.5}" == blobToString(blob));
+        }
+
+        if (verbose) cout << "\nTesting encoding into fixed buffers." << endl;
+        {
+            for (int j = 0; j < NUM_OBJECTS; ++j) {
+                const int                       LINE  = testObjects[j].first;
+                const balb::FeatureTestMessage& VALUE = testObjects[j].second;
+
+                Obj                encoder;
+                bsl::ostringstream oss;
+                ASSERTV(LINE, 0 == encoder.encode(oss, VALUE, Options()));
+
+                const bsl::string& EXP    = oss.str();
+                const int          LENGTH = static_cast<int>(EXP.length());
+
+                bsl::vector<char> buffer(LENGTH + 1, '#');
+
+                bdlsb::FixedMemOutStreamBuf osb(buffer.data(), LENGTH);
+                ASSERTV(LINE, 0 == encoder.encode(&osb, VALUE, Options()));
+                ASSERTV(LINE, LENGTH == osb.length());
+                ASSERTV(LINE, EXP == bsl::string(buffer.data(), LENGTH));
+                ASSERTV(LINE, '#' == buffer[LENGTH]);
+
+                bdlsb::FixedMemOutStreamBuf smaller(buffer.data(), LENGTH - 1);
+                ASSERTV(LINE, 0 != encoder.encode(&smaller, VALUE, Options()));
+                ASSERTV(LINE, encoder.loggedMessages(),
+                        !encoder.loggedMessages().empty());
+            }
+        }
+      } break;
+      case 15: {
+        // --------------------------------------------------------------------
+        // CONCERN: ELEMENT NAMES ARE FORMATTED ONCE PER TYPE
+        //
+        // Concerns:
+        //: 1 The table of element names holds each name quoted and escaped
+        //:   exactly as the encoder formats it.
+        //:
+        //: 2 A name is found only at its index in the table, and only if it
+        //:   matches the name being looked up, whose length is not taken
+        //:   from a null terminator.
+        //:
+        //: 3 A single table is created for each type, from the names of its
+        //:   attributes in the order in which they are visited.
+        //:
+        //: 4 Encoding objects of the same type, in both styles and with
+        //:   several encoders, produces the same output as the first
+        //:   encoding.
+        //
+        // Plan:
+        //: 1 Add names, one of which requires escaping, to a table, and
+        //:   verify the quoted names found by index and name, as well as the
+        //:   names that are not found.  (C-1..2)
+        //:
+        //: 2 Obtain the table for 'balb::Sequence2' twice, and verify that
+        //:   the same table is returned, holding the names of the attributes
+        //:   of 'balb::Sequence2'.  (C-3)
+        //:
+        //: 3 Encode a 'balb::Sequence2' object alternately in the compact and
+        //:   the pretty style with different encoders, and verify that the
+        //:   output of each style is the same every time.  (C-4)
+        //
+        // Testing:
+        //   CONCERN: ELEMENT NAMES ARE FORMATTED ONCE PER TYPE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                     << endl
+                     << "CONCERN: ELEMENT NAMES ARE FORMATTED ONCE PER TYPE"
+                     << endl
+                     << "=================================================="
+                     << endl;
+
+        typedef baljsn::Encoder_ElementNameTable Obj;
+
+        if (verbose) cout << "\nTesting a table of names." << endl;
+        {
+            bslma::TestAllocator ta("table", veryVeryVerbose);
+
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(X.quotedName(0, "name", 4).isEmpty());
+
+            mX.addName("name", 4);
+            mX.addName("a\"b\\c", 5);
+            mX.addName("prefixIgnored", 6);
+
+            ASSERT(0 < ta.numBlocksInUse());
+
+            ASSERTV(X.quotedName(0, "name", 4),
+                    "\"name\"" == X.quotedName(0, "name", 4));
+            ASSERTV(X.quotedName(1, "a\"b\\c", 5),
+                    "\"a\\\"b\\\\c\"" == X.quotedName(1, "a\"b\\c", 5));
+            ASSERTV(X.quotedName(2, "prefix", 6),
+                    "\"prefix\"" == X.quotedName(2, "prefixOther", 6));
+
+            ASSERT(X.quotedName(0, "nam",   3).isEmpty());
+            ASSERT(X.quotedName(0, "names", 5).isEmpty());
+            ASSERT(X.quotedName(0, "Name",  4).isEmpty());
+            ASSERT(X.quotedName(1, "name",  4).isEmpty());
+            ASSERT(X.quotedName(3, "name",  4).isEmpty());
+
+            // The name to encode is checked by value, not by address.
+
+            const char NAME[] = { 'n', 'a', 'm', 'e', '!' };
+            ASSERT("\"name\"" == X.quotedName(0, NAME, 4));
+        }
+
+        if (verbose) cout << "\nTesting the table of a type." << endl;
+        {
+            balb::Sequence2 mX;  const balb::Sequence2& X = mX;
+
+            const Obj& TABLE1 = Obj::forType(X);
+            const Obj& TABLE2 = Obj::forType(balb::Sequence2());
+
+            ASSERT(&TABLE1 == &TABLE2);
+
+            const bdlat_AttributeInfo *INFO =
+                                         balb::Sequence2::ATTRIBUTE_INFO_ARRAY;
+            const int NUM_ATTRIBUTES = balb::Sequence2::k_NUM_ATTRIBUTES;
+
+            for (int i = 0; i < NUM_ATTRIBUTES; ++i) {
+                const bsl::string EXP = bsl::string("\"")
+                                      + INFO[i].name()
+                                      + "\"";
+
+                ASSERTV(i, EXP == TABLE1.quotedName(i,
+                                                    INFO[i].name(),
+                                                    INFO[i].nameLength()));
+            }
+            ASSERT(TABLE1.quotedName(NUM_ATTRIBUTES,
+                                     INFO[0].name(),
+                                     INFO[0].nameLength()).isEmpty());
+        }
+
+        if (verbose) cout << "\nTesting repeated encodings." << endl;
+        {
+            balb::Sequence2 mX;  const balb::Sequence2& X = mX;
+            mX.element1() = balb::CustomString("Hello");
+            mX.element2() = 4;
+            mX.element3() = bdlt::DatetimeTz(bdlt::Datetime(2018, 1, 2), 0);
+            mX.element5() = 0.5;
+
+            baljsn::EncoderOptions compact;
+            baljsn::EncoderOptions pretty;
+            pretty.setEncodingStyle(baljsn::EncoderOptions::e_PRETTY);
+            pretty.setSpacesPerLevel(2);
+
+            bsl::string expected[2];
+
+            for (int i = 0; i < 6; ++i) {
+                const int STYLE = i % 2;
+
+                baljsn::Encoder    encoder;
+                bsl::ostringstream oss;
+
+                ASSERTV(i, 0 == encoder.encode(oss,
+                                               X,
+                                               STYLE ? pretty : compact));
+
+                if (i < 2) {
+                    expected[STYLE] = oss.str();
+                    if (veryVerbose) { P(oss.str()); }
+                }
+                ASSERTV(i, oss.str(), expected[STYLE] == oss.str());
+            }
+
+            ASSERTV(expected[0],
+                    "{\"element1\":\"Hello\",\"element2\":4,"
+                    "\"element3\":\"2018-01-02T00:00:00.000+00:00\","
+                    "\"element5\":0.5}" == expected[0]);
+        }
+      } break;
       case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
@@ -32641,6 +32961,184 @@ int main(int argc, char *argv[])
             }
         }
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Measure the time taken to encode 'balb::FeatureTestMessage'
+        //   objects, whose element names are mostly spelled out once per type
+        //   and repeated in every message.
+        //
+        // Concerns:
+        //: 1 Encoding the same types repeatedly does not redo the work of
+        //:   formatting their element names.
+        //
+        // Plan:
+        //: 1 Encode each of the test messages a number of times, specified on
+        //:   the command line, in both the compact and the pretty style, and
+        //:   report the time taken.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        const int REPS = argc > 2 ? atoi(argv[2]) : 10000;
+
+        bsl::vector<bsl::pair<int, balb::FeatureTestMessage> > testObjects;
+        constructFeatureTestMessage(&testObjects);
+
+        const int NUM_OBJECTS = static_cast<int>(testObjects.size());
+
+        for (int style = 0; style < 2; ++style) {
+            baljsn::EncoderOptions options;
+            if (style) {
+                options.setEncodingStyle(baljsn::EncoderOptions::e_PRETTY);
+                options.setInitialIndentLevel(0);
+                options.setSpacesPerLevel(2);
+            }
+
+            baljsn::Encoder        encoder;
+            bdlsb::MemOutStreamBuf osb;
+            bsls::Types::Int64     numBytes = 0;
+
+            bsls::Stopwatch stopwatch;
+            stopwatch.start();
+
+            for (int i = 0; i < REPS; ++i) {
+                for (int j = 0; j < NUM_OBJECTS; ++j) {
+                    osb.pubseekpos(0);
+                    ASSERTV(j, 0 == encoder.encode(&osb,
+                                                   testObjects[j].second,
+                                                   options));
+                    numBytes += osb.length();
+                }
+            }
+
+            stopwatch.stop();
+
+            const double elapsed = stopwatch.elapsedTime();
+
+            cout << (style ? "Pretty:  " : "Compact: ")
+                 << REPS * NUM_OBJECTS << " messages, "
+                 << numBytes << " bytes, "
+                 << elapsed << " seconds, "
+                 << (elapsed > 0 ? REPS * NUM_OBJECTS / elapsed : 0)
+                 << " messages/sec" << endl;
+        }
+      } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: OUTPUT DESTINATIONS
+        //   Measure the throughput of encoding 'balb::FeatureTestMessage'
+        //   objects into blobs, either directly or through a string stream
+        //   whose output is then copied into the blob, and into a fixed
+        //   buffer.
+        //
+        // Concerns:
+        //: 1 Encoding directly into a blob is not slower than encoding into a
+        //:   string stream and copying the output into a blob.
+        //
+        // Plan:
+        //: 1 Encode each of the test messages a number of times, specified on
+        //:   the command line, into each destination, and report the
+        //:   throughput.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: OUTPUT DESTINATIONS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST: OUTPUT DESTINATIONS" << endl
+                          << "=====================================" << endl;
+
+        const int REPS = argc > 2 ? atoi(argv[2]) : 10000;
+
+        bsl::vector<bsl::pair<int, balb::FeatureTestMessage> > testObjects;
+        constructFeatureTestMessage(&testObjects);
+
+        const int NUM_OBJECTS = static_cast<int>(testObjects.size());
+
+        enum { e_STRING_STREAM, e_BLOB, e_FIXED_BUFFER, e_NUM_DESTINATIONS };
+
+        const char *NAMES[] = { "String stream, copied to blob: ",
+                                "Blob:                          ",
+                                "Fixed buffer:                  " };
+
+        btlb::PooledBlobBufferFactory factory(4096);
+        bsl::vector<char>             buffer(1024 * 1024);
+
+        for (int dest = 0; dest < e_NUM_DESTINATIONS; ++dest) {
+            baljsn::Encoder    encoder;
+            bsls::Types::Int64 numBytes = 0;
+
+            bsls::Stopwatch stopwatch;
+            stopwatch.start();
+
+            for (int i = 0; i < REPS; ++i) {
+                for (int j = 0; j < NUM_OBJECTS; ++j) {
+                    const balb::FeatureTestMessage& VALUE =
+                                                         testObjects[j].second;
+
+                    switch (dest) {
+                      case e_STRING_STREAM: {
+                        bsl::ostringstream oss;
+                        ASSERTV(j, 0 == encoder.encode(oss, VALUE, Options()));
+
+                        const bsl::string output = oss.str();
+
+                        btlb::Blob blob(&factory);
+                        blob.setLength(static_cast<int>(output.length()));
+
+                        int offset = 0;
+                        for (int k = 0; offset < blob.length(); ++k) {
+                            const btlb::BlobBuffer& blobBuffer =
+                                                                blob.buffer(k);
+                            const int length = bsl::min(blobBuffer.size(),
+                                                        blob.length()
+                                                                    - offset);
+                            bsl::memcpy(blobBuffer.data(),
+                                        output.data() + offset,
+                                        length);
+                            offset += length;
+                        }
+                        numBytes += blob.length();
+                      } break;
+                      case e_BLOB: {
+                        btlb::Blob blob(&factory);
+                        ASSERTV(j, 0 == encoder.encode(&blob,
+                                                       VALUE,
+                                                       Options()));
+                        numBytes += blob.length();
+                      } break;
+                      default: {
+                        bdlsb::FixedMemOutStreamBuf osb(
+                                           buffer.data(),
+                                           static_cast<int>(buffer.size()));
+                        ASSERTV(j, 0 == encoder.encode(&osb,
+                                                       VALUE,
+                                                       Options()));
+                        numBytes += osb.length();
+                      } break;
+                    }
+                }
+            }
+
+            stopwatch.stop();
+
+            const double elapsed = stopwatch.elapsedTime();
+
+            cout << NAMES[dest]
+                 << numBytes << " bytes, "
+                 << elapsed << " seconds, "
+                 << (elapsed > 0 ? static_cast<double>(numBytes) / elapsed
+                                                                        / 1e6
+                                 : 0)
+                 << " MB/s" << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
@@ -253,7 +253,16 @@ int ParserUtil::getString(bsl::string *value, bslstl::StringRef data)
             return 0;                                                 // RETURN
         }
         else {
-            *value += *iter;
+            // Append the whole run of characters up to the next quote or
+            // backslash at once.
+
+            const char *runEnd = iter + 1;
+            while (runEnd < end && '"' != *runEnd && '\\' != *runEnd) {
+                ++runEnd;
+            }
+            value->append(iter, runEnd);
+            iter = runEnd;
+            continue;
         }
         ++iter;
     }
@@ -261,6 +270,41 @@ int ParserUtil::getString(bsl::string *value, bslstl::StringRef data)
     return -1;
 }
 
+int ParserUtil::getStringValue(bslstl::StringRef *value,
+                               bsl::string       *buffer,
+                               bslstl::StringRef  data)
+{
+    BSLS_ASSERT(value);
+    BSLS_ASSERT(buffer);
+
+    const char *iter = data.begin();
+    const char *end  = data.end();
+
+    if (iter == end || '"' != *iter) {
+        return -1;                                                    // RETURN
+    }
+
+    const char *begin = ++iter;
+    while (iter < end && '"' != *iter && '\\' != *iter) {
+        ++iter;
+    }
+
+    if (iter < end && '"' == *iter) {
+        // There is no escape sequence: refer to the characters of 'data'.
+
+        value->assign(begin, iter);
+        return 0;                                                     // RETURN
+    }
+
+    const int rc = getString(buffer, data);
+    if (rc) {
+        return rc;                                                    // RETURN
+    }
+
+    value->assign(buffer->data(), buffer->data() + buffer->length());
+    return 0;
+}
+
 int ParserUtil::getValue(bdldfp::Decimal64 *value,
                                 bslstl::StringRef data)
 {
@@ -174,6 +174,20 @@ struct ParserUtil {
         // Load into the specified 'value' the characters read from the
         // specified 'data'.  Return 0 on success or a non-zero value on
         // failure.
+
+    static int getStringValue(bslstl::StringRef *value,
+                              bsl::string       *buffer,
+                              bslstl::StringRef  data);
+        // Load into the specified 'value' a reference to the characters of
+        // the string value in the specified 'data', using the specified
+        // 'buffer' to hold the unescaped characters if 'data' contains escape
+        // sequences.  Return 0 on success or a non-zero value on failure.  If
+        // 'data' contains no escape sequence, 'value' refers to characters of
+        // 'data' and 'buffer' is not modified; otherwise 'value' refers to
+        // the characters of 'buffer'.  Note that, unlike the 'getValue'
+        // overload for 'bsl::string', this function does not allocate memory
+        // unless 'data' contains escape sequences, and that 'value' is valid
+        // only as long as both 'data' and 'buffer' are unmodified.
 };
 
 // ============================================================================
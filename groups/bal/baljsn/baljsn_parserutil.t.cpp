@@ -76,6 +76,7 @@ using bsl::endl;
 // [19] static int getValue(bdlt::DatetimeTz    *v, bslstl::StringRef s);
 // [20] static int getValue(vector<char>        *v, bslstl::StringRef s);
 // [21] static int getValue(bdldfp::Decimal64   *v, bslstl::StringRef s);
+// [23] static int getStringValue(StringRef *v, string *b, StringRef s);
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [22] USAGE EXAMPLE
@@ -172,6 +173,115 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 23: {
+        // --------------------------------------------------------------------
+        // TESTING 'getStringValue'
+        //
+        // Concerns:
+        //: 1 A string value having no escape sequence is loaded as a
+        //:   reference to the characters of the data, without modifying the
+        //:   buffer and without allocating memory.
+        //:
+        //: 2 A string value having escape sequences is unescaped into the
+        //:   buffer, and loaded as a reference to the characters of the
+        //:   buffer.
+        //:
+        //: 3 The return code is 0 on success and non-zero on failure.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, specify a set of distinct
+        //:   rows of string value, expected value, whether the value refers
+        //:   to the data, and return code.
+        //:
+        //: 2 For each row in the table of P-1, invoke 'getStringValue' with
+        //:   a buffer using a test allocator, verify the return code and, on
+        //:   success, the value, and whether the value refers to the data or
+        //:   to the buffer.  Verify that the value is the same as that
+        //:   obtained with the 'getValue' overload for 'bsl::string'.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   static int getStringValue(StringRef *v, string *b, StringRef s);
+        // --------------------------------------------------------------------
+
+        if (verbose) bsl::cout << "\nTESTING 'getStringValue'"
+                               << "\n========================"
+                               << bsl::endl;
+        {
+            static const struct {
+                int         d_line;       // line number
+                const char *d_input_p;    // input
+                const char *d_exp_p;      // expected value
+                bool        d_isInPlace;  // value refers to the input
+                bool        d_isValid;    // isValid flag
+            } DATA[] = {
+                //line  input                  exp            inPlace valid
+                //----  -----                  ---            ------- -----
+                { L_,   "\"\"",                "",            true,   true  },
+                { L_,   "\"ABC\"",             "ABC",         true,   true  },
+                { L_,   "\"ABC\" ",            "ABC",         true,   true  },
+                { L_,   "\"u0001\"",           "u0001",       true,   true  },
+                { L_,   "\"A long string value without escapes\"",
+                                    "A long string value without escapes",
+                                                              true,   true  },
+
+                { L_,   "\"\\\"\"",            "\"",          false,  true  },
+                { L_,   "\"\\\\\"",            "\\",          false,  true  },
+                { L_,   "\"A\\nB\"",           "A\nB",        false,  true  },
+                { L_,   "\"ABC\\u0041\"",      "ABCA",        false,  true  },
+                { L_,   "\"A\\\"B\\\\C\"",     "A\"B\\C",     false,  true  },
+
+                { L_,   "",                    "",            false,  false },
+                { L_,   "ABC",                 "",            false,  false },
+                { L_,   "\"ABC",               "",            false,  false },
+                { L_,   "\"ABC\\",             "",            false,  false },
+                { L_,   "\"ABC\\\"",           "",            false,  false },
+                { L_,   "\"\\UXXXX\"",         "",            false,  false },
+            };
+            const int NUM_DATA = sizeof(DATA) / sizeof(*DATA);
+
+            for (int i = 0; i < NUM_DATA; ++i) {
+                const int    LINE        = DATA[i].d_line;
+                const string INPUT       = DATA[i].d_input_p;
+                const string EXP         = DATA[i].d_exp_p;
+                const bool   IS_IN_PLACE = DATA[i].d_isInPlace;
+                const bool   IS_VALID    = DATA[i].d_isValid;
+
+                bslma::TestAllocator ba("buffer", veryVeryVerbose);
+
+                bsl::string buffer("sentinel", &ba);
+                StringRef   value;
+
+                const Int64 NUM_BLOCKS = ba.numBlocksTotal();
+
+                StringRef isb(INPUT.data(), static_cast<int>(INPUT.length()));
+                const int rc = Util::getStringValue(&value, &buffer, isb);
+                if (!IS_VALID) {
+                    LOOP2_ASSERT(LINE, rc, rc);
+                    continue;
+                }
+
+                LOOP2_ASSERT(LINE, rc, 0 == rc);
+                LOOP3_ASSERT(LINE, EXP, value, EXP == value);
+
+                if (IS_IN_PLACE) {
+                    LOOP_ASSERT(LINE, INPUT.data() < value.data()
+                                   && INPUT.data() + INPUT.length()
+                                                              > value.data());
+                    LOOP_ASSERT(LINE, "sentinel" == buffer);
+                    LOOP_ASSERT(LINE, NUM_BLOCKS == ba.numBlocksTotal());
+                }
+                else {
+                    LOOP_ASSERT(LINE, buffer.data() == value.data());
+                    LOOP_ASSERT(LINE, buffer.length() == value.length());
+                }
+
+                bsl::string expected;
+                LOOP_ASSERT(LINE, 0 == Util::getValue(&expected, isb));
+                LOOP_ASSERT(LINE, expected == value);
+            }
+        }
+      } break;
       case 22: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
@@ -27,6 +27,45 @@ void writeEscapedChar(bsl::ostream&   stream,
     *currBegin = iter + 1;
 }
 
+inline
+char *formatDigits(char *end, bsls::Types::Uint64 value)
+    // Format the decimal digits of the specified 'value' into the buffer
+    // ending at the specified 'end', two digits at a time, and return the
+    // address of the first digit.  The behavior is undefined unless the buffer
+    // has room for at least 20 characters before 'end'.
+{
+    static const char DIGIT_PAIRS[] = "00010203040506070809"
+                                      "10111213141516171819"
+                                      "20212223242526272829"
+                                      "30313233343536373839"
+                                      "40414243444546474849"
+                                      "50515253545556575859"
+                                      "60616263646566676869"
+                                      "70717273747576777879"
+                                      "80818283848586878889"
+                                      "90919293949596979899";
+
+    char *begin = end;
+
+    while (value >= 100) {
+        const unsigned int pair = static_cast<unsigned int>(value % 100) * 2;
+        value /= 100;
+        *--begin = DIGIT_PAIRS[pair + 1];
+        *--begin = DIGIT_PAIRS[pair];
+    }
+
+    if (value >= 10) {
+        const unsigned int pair = static_cast<unsigned int>(value) * 2;
+        *--begin = DIGIT_PAIRS[pair + 1];
+        *--begin = DIGIT_PAIRS[pair];
+    }
+    else {
+        *--begin = static_cast<char>('0' + value);
+    }
+
+    return begin;
+}
+
 }  // close unnamed namespace
 
 namespace baljsn {
@@ -35,6 +74,42 @@ namespace baljsn {
                               // class PrintUtil
                               // ---------------
 
+// PRIVATE CLASS METHODS
+void PrintUtil::printInteger(bsl::ostream& stream, bsls::Types::Int64 value)
+{
+    enum { k_BUFFER_SIZE = 24 };  // digits of 'Uint64' and a sign
+
+    char  buffer[k_BUFFER_SIZE];
+    char *end = buffer + k_BUFFER_SIZE;
+
+    // Negating in unsigned arithmetic is well defined for the smallest
+    // 'Int64' value.
+
+    typedef bsls::Types::Uint64 Uint64;
+
+    const Uint64 magnitude = value < 0 ? 0 - static_cast<Uint64>(value)
+                                       : static_cast<Uint64>(value);
+
+    char *begin = formatDigits(end, magnitude);
+    if (value < 0) {
+        *--begin = '-';
+    }
+
+    stream.write(begin, end - begin);
+}
+
+void PrintUtil::printInteger(bsl::ostream& stream, bsls::Types::Uint64 value)
+{
+    enum { k_BUFFER_SIZE = 24 };  // digits of 'Uint64'
+
+    char  buffer[k_BUFFER_SIZE];
+    char *end   = buffer + k_BUFFER_SIZE;
+    char *begin = formatDigits(end, value);
+
+    stream.write(begin, end - begin);
+}
+
+// CLASS METHODS
 int PrintUtil::printString(bsl::ostream&            stream,
                            const bslstl::StringRef& value)
 {
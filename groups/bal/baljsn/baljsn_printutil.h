@@ -23,6 +23,10 @@ BSLS_IDENT("$Id: $")
 // Refer to the details of the JSON encoding format supported by this utility
 // in the package documentation file (doc/baljsn.txt).
 //
+// Integral values are always encoded in decimal: their digits are formatted
+// directly, without using the numeric formatting of the output stream, whose
+// formatting flags (e.g., 'bsl::hex') are therefore ignored.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -158,6 +162,13 @@ struct PrintUtil {
         // template parameter 'TYPE' using the specified 'options' to decide.
         // The behavior is undefined unless 'TYPE' is 'float' or 'double'.
 
+    static void printInteger(bsl::ostream& stream, bsls::Types::Int64 value);
+    static void printInteger(bsl::ostream& stream, bsls::Types::Uint64 value);
+        // Print the decimal representation of the specified 'value' onto the
+        // specified 'stream'.  Note that the digits are formatted into a local
+        // buffer and written with a single call to 'stream.write', bypassing
+        // the locale-dependent numeric formatting of 'stream'.
+
   public:
     // CLASS METHODS
     template <class TYPE>
@@ -370,7 +381,7 @@ int PrintUtil::printValue(bsl::ostream& stream,
                           short         value,
                           const EncoderOptions *)
 {
-    stream << value;
+    printInteger(stream, static_cast<bsls::Types::Int64>(value));
     return 0;
 }
 
@@ -379,7 +390,7 @@ int PrintUtil::printValue(bsl::ostream& stream,
                           int           value,
                           const EncoderOptions *)
 {
-    stream << value;
+    printInteger(stream, static_cast<bsls::Types::Int64>(value));
     return 0;
 }
 
@@ -388,7 +399,7 @@ int PrintUtil::printValue(bsl::ostream&      stream,
                           bsls::Types::Int64 value,
                           const EncoderOptions *)
 {
-    stream << value;
+    printInteger(stream, value);
     return 0;
 }
 
@@ -397,7 +408,7 @@ int PrintUtil::printValue(bsl::ostream& stream,
                           unsigned char value,
                           const EncoderOptions *)
 {
-    stream << static_cast<int>(value);
+    printInteger(stream, static_cast<bsls::Types::Uint64>(value));
     return 0;
 }
 
@@ -406,7 +417,7 @@ int PrintUtil::printValue(bsl::ostream&  stream,
                           unsigned short value,
                           const EncoderOptions *)
 {
-    stream << value;
+    printInteger(stream, static_cast<bsls::Types::Uint64>(value));
     return 0;
 }
 
@@ -415,7 +426,7 @@ int PrintUtil::printValue(bsl::ostream& stream,
                           unsigned int  value,
                           const EncoderOptions *)
 {
-    stream << value;
+    printInteger(stream, static_cast<bsls::Types::Uint64>(value));
     return 0;
 }
 
@@ -424,7 +435,7 @@ int PrintUtil::printValue(bsl::ostream&       stream,
                           bsls::Types::Uint64 value,
                           const EncoderOptions *)
 {
-    stream << value;
+    printInteger(stream, value);
     return 0;
 }
 
@@ -497,7 +508,16 @@ int PrintUtil::printValue(bsl::ostream& stream,
 {
     signed char tmp(value);  // Note that 'char' is unsigned on IBM.
 
-    stream << static_cast<int>(tmp);
+    printInteger(stream, static_cast<bsls::Types::Int64>(tmp));
+    return 0;
+}
+
+inline
+int PrintUtil::printValue(bsl::ostream& stream,
+                          signed char   value,
+                          const EncoderOptions *)
+{
+    printInteger(stream, static_cast<bsls::Types::Int64>(value));
     return 0;
 }
 
@@ -1006,6 +1006,63 @@ int main(int argc, char *argv[])
             testNumber<unsigned int>();
             testNumber<Uint64>();
         }
+
+        if (verbose) cout << "Encode integers around powers of 10" << endl;
+        {
+            // Integers are formatted two digits at a time: verify each number
+            // of digits, and the largest 'Uint64', against the output of the
+            // stream insertion operator.
+
+            Uint64 power = 1;
+            for (int digits = 1; digits <= 20; ++digits) {
+                const Uint64 VALUES[] = { power - 1, power, power + 1 };
+
+                for (int vi = 0; vi < 3; ++vi) {
+                    const Uint64 VALUE = VALUES[vi];
+
+                    bsl::ostringstream expected;
+                    expected << VALUE;
+
+                    bsl::ostringstream oss;
+                    ASSERTV(VALUE, 0 == Obj::printValue(oss, VALUE));
+                    ASSERTV(VALUE, oss.str(), expected.str() == oss.str());
+
+                    if (VALUE <= static_cast<Uint64>(LLONG_MAX)) {
+                        const Int64 NEGATIVE = -static_cast<Int64>(VALUE);
+
+                        bsl::ostringstream expectedNegative;
+                        expectedNegative << NEGATIVE;
+
+                        bsl::ostringstream ossNegative;
+                        ASSERTV(NEGATIVE,
+                                0 == Obj::printValue(ossNegative, NEGATIVE));
+                        ASSERTV(NEGATIVE, ossNegative.str(),
+                                expectedNegative.str() == ossNegative.str());
+                    }
+                }
+
+                power *= 10;
+            }
+
+            bsl::ostringstream oss;
+            ASSERT(0 == Obj::printValue(oss, ULLONG_MAX));
+            ASSERTV(oss.str(), "18446744073709551615" == oss.str());
+        }
+
+        if (verbose) cout << "Encode integers ignoring stream formatting"
+                          << endl;
+        {
+            // JSON numbers are always decimal, whatever the formatting flags
+            // of the stream.
+
+            bsl::ostringstream oss;
+            oss << bsl::hex << bsl::showpos;
+
+            ASSERT(0 == Obj::printValue(oss, 255));
+            ASSERT(0 == Obj::printValue(oss, ' '));
+            ASSERT(0 == Obj::printValue(oss, static_cast<Uint64>(16)));
+            ASSERTV(oss.str(), "2553216" == oss.str());
+        }
       } break;
       case 3: {
         // --------------------------------------------------------------------
@@ -4,12 +4,19 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(baljsn_tokenizer_cpp,"$Id$ $CSID$")
 
-#include <bdlb_chartype.h>
+#include <bdlb_bitutil.h>
 
-#include <bsl_cstring.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstdint.h>
 #include <bsl_ios.h>
 #include <bsl_streambuf.h>
 
+#if defined(BSLS_PLATFORM_CPU_X86_64) || defined(__SSE2__)
+#define BALJSN_TOKENIZER_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
 #include <baljsn_parserutil.h>                 // for testing only
 
 // IMPLEMENTATION NOTES
@@ -52,12 +59,155 @@ BSLS_IDENT_RCSID(baljsn_tokenizer_cpp,"$Id$ $CSID$")
 //   END_OBJECT                   '}'         ']'              END_ARRAY
 //   END_ARRAY                    ']'         ']'              END_ARRAY
 //..
+//
+// The characters of the internal buffer are scanned by the functions in the
+// unnamed namespace below, which look for the end of a run of whitespace, for
+// the end of a value that is not a string, and for the next quote or
+// backslash within a string.  Where SSE2 instructions are available (always
+// on x86-64), whitespace and strings are scanned 16 characters at a time,
+// which matters for the long strings and the indentation of large documents;
+// the characters left over, and all characters on other platforms, are
+// classified through a table.  A backslash in a string escapes the character
+// following it, so that a string ends at the first quote that does not
+// follow a backslash.
 
 namespace BloombergLP {
 namespace {
 
-    static const char *WHITESPACE = " \n\t\v\f\r";
-    static const char *TOKENS     = "{}[]:,";
+enum {
+    k_WHITESPACE = 0x1,  // ' ', '\t', '\n', '\v', '\f', and '\r'
+    k_TOKEN      = 0x2,  // '{', '}', '[', ']', ':', ',', and '\0'
+    k_STRING     = 0x4   // '"' and '\\'
+};
+
+const unsigned char CHARACTER_CLASSES[256] = {
+    // The class of each character: a combination of the above values.
+
+    //  0  1  2  3  4  5  6  7  8  9  A  B  C  D  E  F
+        2, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 0,  // 00
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 10
+        1, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0,  // 20
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0,  // 30
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 40
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 4, 2, 0, 0,  // 50
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 60
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 0,  // 70
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 80
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 90
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // A0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // B0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // C0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // D0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // E0
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0   // F0
+};
+
+inline
+bool hasClass(char character, int characterClass)
+    // Return 'true' if the specified 'character' belongs to any of the
+    // specified 'characterClass' combination of classes, and 'false'
+    // otherwise.
+{
+    return 0 != (CHARACTER_CLASSES[static_cast<unsigned char>(character)]
+                 & characterClass);
+}
+
+#ifdef BALJSN_TOKENIZER_USE_SSE2
+inline
+int firstSetBit(int mask)
+    // Return the index of the lowest bit set in the specified 'mask'.  The
+    // behavior is undefined unless '0 != mask'.
+{
+    return bdlb::BitUtil::numTrailingUnsetBits(
+                                            static_cast<bsl::uint32_t>(mask));
+}
+#endif
+
+const char *findNonWhitespace(const char *begin, const char *end)
+    // Return the address of the first character in the specified range
+    // '[begin, end)' that is not whitespace, or 'end' if there is no such
+    // character.
+{
+#ifdef BALJSN_TOKENIZER_USE_SSE2
+    // Runs of whitespace are often empty (between the tokens of a compact
+    // document) or a single space, which are not worth a vector comparison.
+
+    if (begin < end && !hasClass(*begin, k_WHITESPACE)) {
+        return begin;                                                 // RETURN
+    }
+    if (begin + 1 < end && !hasClass(begin[1], k_WHITESPACE)) {
+        return begin + 1;                                             // RETURN
+    }
+
+    // Whitespace characters are ' ' and the characters in the range
+    // '[0x09, 0x0D]'.  Note that the comparisons are signed, so that
+    // characters having their high bit set are not in that range.
+
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i low   = _mm_set1_epi8(0x08);
+    const __m128i high  = _mm_set1_epi8(0x0E);
+
+    while (end - begin >= 16) {
+        const __m128i chunk = _mm_loadu_si128(
+                                     reinterpret_cast<const __m128i *>(begin));
+        const __m128i isWhitespace = _mm_or_si128(
+                            _mm_cmpeq_epi8(chunk, space),
+                            _mm_and_si128(_mm_cmpgt_epi8(chunk, low),
+                                          _mm_cmplt_epi8(chunk, high)));
+        const int mask = ~_mm_movemask_epi8(isWhitespace) & 0xFFFF;
+        if (mask) {
+            return begin + firstSetBit(mask);                         // RETURN
+        }
+        begin += 16;
+    }
+#endif
+
+    while (begin < end && hasClass(*begin, k_WHITESPACE)) {
+        ++begin;
+    }
+    return begin;
+}
+
+const char *findQuoteOrBackslash(const char *begin, const char *end)
+    // Return the address of the first '"' or '\\' character in the specified
+    // range '[begin, end)', or 'end' if there is no such character.
+{
+#ifdef BALJSN_TOKENIZER_USE_SSE2
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+
+    while (end - begin >= 16) {
+        const __m128i chunk = _mm_loadu_si128(
+                                     reinterpret_cast<const __m128i *>(begin));
+        const __m128i isSpecial = _mm_or_si128(
+                                            _mm_cmpeq_epi8(chunk, quote),
+                                            _mm_cmpeq_epi8(chunk, backslash));
+        const int     mask      = _mm_movemask_epi8(isSpecial);
+        if (mask) {
+            return begin + firstSetBit(mask);                         // RETURN
+        }
+        begin += 16;
+    }
+#endif
+
+    while (begin < end && !hasClass(*begin, k_STRING)) {
+        ++begin;
+    }
+    return begin;
+}
+
+inline
+const char *findWhitespaceOrToken(const char *begin, const char *end)
+    // Return the address of the first whitespace or token character in the
+    // specified range '[begin, end)', or 'end' if there is no such character.
+    // Note that the values scanned by this function (numbers and literals)
+    // are short, so that they are not worth scanning 16 characters at a time.
+{
+    while (begin < end && !hasClass(*begin, k_WHITESPACE | k_TOKEN)) {
+        ++begin;
+    }
+    return begin;
+}
 
 }  // close unnamed namespace
 
@@ -70,17 +220,26 @@ namespace baljsn {
 // PRIVATE MANIPULATORS
 int Tokenizer::reloadStringBuffer()
 {
+    if (d_isInputContiguous) {
+        return 0;                                                     // RETURN
+    }
+
     d_stringBuffer.resize(k_MAX_STRING_SIZE);
     const int numRead =
                      static_cast<int>(d_streambuf_p->sgetn(&d_stringBuffer[0],
                                                            k_MAX_STRING_SIZE));
     d_cursor = 0;
     d_stringBuffer.resize(numRead);
+    updateDataFromStringBuffer();
     return numRead;
 }
 
 int Tokenizer::expandBufferForLargeValue()
 {
+    if (d_isInputContiguous) {
+        return -1;                                                    // RETURN
+    }
+
     const bsl::string::size_type currLength = d_stringBuffer.length();
     d_stringBuffer.resize(currLength + k_MAX_STRING_SIZE);
 
@@ -88,11 +247,16 @@ int Tokenizer::expandBufferForLargeValue()
             static_cast<int>(d_streambuf_p->sgetn(&d_stringBuffer[d_valueIter],
                                                   k_MAX_STRING_SIZE));
     d_stringBuffer.resize(currLength + numRead);
+    updateDataFromStringBuffer();
     return numRead ? 0 : -1;
 }
 
 int Tokenizer::moveValueCharsToStartAndReloadBuffer()
 {
+    if (d_isInputContiguous) {
+        return 0;                                                     // RETURN
+    }
+
     d_stringBuffer.erase(d_stringBuffer.begin(),
                          d_stringBuffer.begin() + d_valueBegin);
     d_stringBuffer.resize(k_MAX_STRING_SIZE);
@@ -105,6 +269,7 @@ int Tokenizer::moveValueCharsToStartAndReloadBuffer()
                                              k_MAX_STRING_SIZE - d_valueIter));
 
     d_stringBuffer.resize(d_valueIter + numRead);
+    updateDataFromStringBuffer();
 
     return numRead;
 }
@@ -112,11 +277,14 @@ int Tokenizer::moveValueCharsToStartAndReloadBuffer()
 int Tokenizer::skipWhitespace()
 {
     while (true) {
-        bsl::size_t pos = d_stringBuffer.find_first_not_of(WHITESPACE,
-                                                           d_cursor);
-        if (bsl::string::npos != pos) {
-            d_cursor = pos;
-            break;
+        if (d_cursor < d_dataLength) {
+            const char *end  = d_data_p + d_dataLength;
+            const char *next = findNonWhitespace(d_data_p + d_cursor, end);
+
+            if (end != next) {
+                d_cursor = next - d_data_p;
+                break;
+            }
         }
 
         const int numRead = reloadStringBuffer();
@@ -129,64 +297,64 @@ int Tokenizer::skipWhitespace()
 
 int Tokenizer::extractStringValue()
 {
-    bool firstTime    = true;
-    char previousChar = 0;
+    bool firstTime = true;
+    bool isEscaped = false;  // 'true' if the character at 'd_valueIter' is
+                             // preceded by an escaping backslash
 
     while (true) {
-        while (d_valueIter < d_stringBuffer.length()
-            && '"' != d_stringBuffer[d_valueIter]) {
+        const char        *data   = d_data_p;
+        const bsl::size_t  length = d_dataLength;
 
-            if ('\\' == d_stringBuffer[d_valueIter]
-             && '\\' == previousChar) {
-                previousChar = 0;
-            }
-            else {
-                previousChar = d_stringBuffer[d_valueIter];
+        while (d_valueIter < length) {
+            if (isEscaped) {
+                ++d_valueIter;
+                isEscaped = false;
+                continue;
             }
 
-            ++d_valueIter;
-        }
+            d_valueIter = findQuoteOrBackslash(data + d_valueIter,
+                                               data + length) - data;
 
-        if (d_valueIter >= d_stringBuffer.length()) {
+            if (d_valueIter < length) {
+                if ('"' == data[d_valueIter]) {
+                    d_valueEnd = d_valueIter;
+                    return 0;                                         // RETURN
+                }
 
-            // There isn't enough room in the internal buffer to hold the
-            // value.  If this is the first time through the loop, we move the
-            // current sequence of characters being processed to the front of
-            // the internal buffer, otherwise we must expand the internal
-            // buffer to hold additional characters.  If we are at the
-            // beginning of the string buffer then we dont need to move any
-            // characters and we simply expand the string buffer.
+                // Skip the backslash, and then the character it escapes.
 
-            if (0 == d_valueBegin) {
-                firstTime = false;
+                ++d_valueIter;
+                isEscaped = true;
             }
+        }
 
-            if (firstTime) {
-                const int numRead = moveValueCharsToStartAndReloadBuffer();
-                if (0 == numRead) {
-                    return -1;                                        // RETURN
-                }
+        // There isn't enough room in the internal buffer to hold the value.
+        // If this is the first time through the loop, we move the current
+        // sequence of characters being processed to the front of the internal
+        // buffer, otherwise we must expand the internal buffer to hold
+        // additional characters.  If we are at the beginning of the string
+        // buffer then we dont need to move any characters and we simply
+        // expand the string buffer.
 
-                firstTime = false;
-            }
-            else {
-                const int rc = expandBufferForLargeValue();
-                if (rc) {
-                    return rc;                                        // RETURN
-                }
+        if (0 == d_valueBegin) {
+            firstTime = false;
+        }
+
+        if (firstTime) {
+            const int numRead = moveValueCharsToStartAndReloadBuffer();
+            if (0 == numRead) {
+                return -1;                                            // RETURN
             }
+
+            firstTime = false;
         }
         else {
-            if ('\\' == previousChar) {
-                ++d_valueIter;
-                previousChar = 0;
-                continue;
+            const int rc = expandBufferForLargeValue();
+            if (rc) {
+                return rc;                                            // RETURN
             }
-            d_valueEnd = d_valueIter;
-            return 0;                                                 // RETURN
         }
     }
-    return 0;
 }
 
 int Tokenizer::skipNonWhitespaceOrTillToken()
@@ -194,13 +362,15 @@ int Tokenizer::skipNonWhitespaceOrTillToken()
     bool firstTime = true;
 
     while (true) {
-        while (d_valueIter < d_stringBuffer.length()
-            && !bdlb::CharType::isSpace(d_stringBuffer[d_valueIter])
-            && !bsl::strchr(TOKENS, d_stringBuffer[d_valueIter])) {
-            ++d_valueIter;
+        if (d_valueIter < d_dataLength) {
+            const char *end  = d_data_p + d_dataLength;
+            const char *next = findWhitespaceOrToken(d_data_p + d_valueIter,
+                                                     end);
+
+            d_valueIter = next - d_data_p;
         }
 
-        if (d_valueIter >= d_stringBuffer.length()) {
+        if (d_valueIter >= d_dataLength) {
 
             // There isn't enough room in the internal buffer to hold the
             // value.  If this is the first time through the loop, we move the
@@ -239,7 +409,7 @@ int Tokenizer::advanceToNextToken()
         return -1;                                                    // RETURN
     }
 
-    if (d_cursor >= d_stringBuffer.size()) {
+    if (d_cursor >= d_dataLength) {
         const int numRead = reloadStringBuffer();
         if (0 == numRead) {
             d_tokenType = e_ERROR;
@@ -258,7 +428,7 @@ int Tokenizer::advanceToNextToken()
             return -1;                                                // RETURN
         }
 
-        switch (d_stringBuffer[d_cursor]) {
+        switch (d_data_p[d_cursor]) {
           case '{': {
             if ((e_ELEMENT_NAME == d_tokenType && ':' == previousChar)
              || e_START_ARRAY   == d_tokenType
@@ -270,6 +440,7 @@ int Tokenizer::advanceToNextToken()
 
                 d_tokenType  = e_START_OBJECT;
                 d_context    = e_OBJECT_CONTEXT;
+                d_contextStack.push_back(e_OBJECT_CONTEXT);
                 previousChar = '{';
 
                 ++d_cursor;
@@ -287,8 +458,8 @@ int Tokenizer::advanceToNextToken()
              || e_END_ARRAY      == d_tokenType) {
 
                 d_tokenType  = e_END_OBJECT;
-                d_context    = e_OBJECT_CONTEXT;
                 previousChar = '}';
+                popContext();
 
                 ++d_cursor;
             }
@@ -309,6 +480,7 @@ int Tokenizer::advanceToNextToken()
 
                 d_tokenType  = e_START_ARRAY;
                 d_context    = e_ARRAY_CONTEXT;
+                d_contextStack.push_back(e_ARRAY_CONTEXT);
                 previousChar = '[';
 
                 ++d_cursor;
@@ -325,9 +497,9 @@ int Tokenizer::advanceToNextToken()
              || (e_END_ARRAY     == d_tokenType && ',' != previousChar)
              || (e_END_OBJECT    == d_tokenType && ',' != previousChar)) {
 
-                d_tokenType = e_END_ARRAY;
-                d_context   = e_OBJECT_CONTEXT;
+                d_tokenType  = e_END_ARRAY;
                 previousChar = ']';
+                popContext();
 
                 ++d_cursor;
             }
@@ -374,16 +546,23 @@ int Tokenizer::advanceToNextToken()
             // CURRENT TOKEN           CONTEXT           NEXT TOKEN
             // -------------           -------           ----------
             // START_OBJECT  ('{')                       ELEMENT_NAME
-            // END_OBJECT    ('}')                       ELEMENT_NAME
+            // END_OBJECT    ('}')     OBJECT_CONTEXT    ELEMENT_NAME
+            // END_OBJECT    ('}')     ARRAY_CONTEXT     ELEMENT_VALUE (*)
             // START_ARRAY   ('[')                       ELEMENT_VALUE
-            // END_ARRAY     (']')                       ELEMENT_VALUE
+            // END_ARRAY     (']')     OBJECT_CONTEXT    ELEMENT_NAME
+            // END_ARRAY     (']')     ARRAY_CONTEXT     ELEMENT_VALUE (*)
             // ELEMENT_NAME  (':')                       ELEMENT_VALUE
             // ELEMENT_VALUE (   )     OBJECT_CONTEXT    ELEMENT_NAME
             // ELEMENT_VALUE (   )     ARRAY_CONTEXT     ELEMENT_VALUE
+            //
+            // (*) Only if heterogenous arrays are allowed.  The context is
+            // that of the innermost object or array still open.
 
             if (e_START_OBJECT   == d_tokenType
-             || (e_END_OBJECT    == d_tokenType && ',' == previousChar)
-             || (e_END_ARRAY     == d_tokenType && ',' == previousChar)
+             || (e_END_OBJECT    == d_tokenType && ',' == previousChar
+               && e_OBJECT_CONTEXT == d_context)
+             || (e_END_ARRAY     == d_tokenType && ',' == previousChar
+               && e_OBJECT_CONTEXT == d_context)
              || (e_ELEMENT_VALUE   == d_tokenType
                && ','              == previousChar
                && e_OBJECT_CONTEXT == d_context)) {
@@ -396,6 +575,9 @@ int Tokenizer::advanceToNextToken()
                   || (e_ELEMENT_VALUE == d_tokenType
                    && ','             == previousChar
                    && e_ARRAY_CONTEXT == d_context)
+                  || (d_allowHeterogenousArrays
+                   && ','             == previousChar
+                   && e_ARRAY_CONTEXT == d_context)
                  || (e_BEGIN == d_tokenType && d_allowStandAloneValues)) {
                 d_tokenType  = e_ELEMENT_VALUE;
                 d_valueBegin = d_cursor;
@@ -433,8 +615,8 @@ int Tokenizer::advanceToNextToken()
               && ','                  == previousChar
               && e_ARRAY_CONTEXT == d_context)
              || (d_allowHeterogenousArrays
-              && e_END_ARRAY == d_tokenType
-              && ','         == previousChar)
+              && ','             == previousChar
+              && e_ARRAY_CONTEXT == d_context)
              || (e_BEGIN == d_tokenType && d_allowStandAloneValues)) {
 
                 d_tokenType = e_ELEMENT_VALUE;
@@ -464,6 +646,10 @@ int Tokenizer::advanceToNextToken()
 
 int Tokenizer::resetStreamBufGetPointer()
 {
+    if (d_isInputContiguous) {
+        return -1;                                                    // RETURN
+    }
+
     if (d_cursor >= d_stringBuffer.size()) {
         return 0;                                                     // RETURN
     }
@@ -483,8 +669,7 @@ int Tokenizer::value(bslstl::StringRef *data) const
     if ((e_ELEMENT_NAME == d_tokenType
                                         || e_ELEMENT_VALUE == d_tokenType)
      && d_valueBegin != d_valueEnd) {
-        data->assign(&d_stringBuffer[d_valueBegin],
-                     &d_stringBuffer[d_valueEnd]);
+        data->assign(d_data_p + d_valueBegin, d_data_p + d_valueEnd);
         return 0;                                                     // RETURN
     }
     return -1;
@@ -25,6 +25,21 @@ BSLS_IDENT("$Id: $")
 // package and in most cases clients should use the 'baljsn_decoder' component
 // instead of using this 'class'.
 //
+// The tokenizer reads the 'bsl::streambuf' in blocks of several kilobytes, and
+// the value of a token refers to the characters of the block that holds it,
+// without copying them.
+//
+// Alternatively, a tokenizer can be reset to read JSON data held in
+// contiguous memory, supplied as a 'bslstl::StringRef'.  The data is then
+// tokenized in place, without being copied into the internal buffer, and the
+// value of each token refers directly to the data supplied, so that it
+// remains valid after the tokenizer advances, for as long as that data
+// remains valid and unmodified.
+//
+// Where the platform supports SSE2 instructions (e.g., on all x86-64
+// processors), whitespace and strings are scanned 16 characters at a time;
+// elsewhere, they are scanned one character at a time.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -141,10 +156,26 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 #endif
 
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
 #ifndef INCLUDED_BSL_STRING
 #include <bsl_string.h>
 #endif
 
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
 #ifndef INCLUDED_BSL_STREAMBUF
 #include <bsl_streambuf.h>
 #endif
@@ -193,6 +224,13 @@ class Tokenizer {
         k_MAX_STRING_SIZE = k_BUFSIZE - 1
     };
 
+    // Number of nested objects and arrays whose contexts are tracked without
+    // allocating memory.
+
+    enum {
+        k_CONTEXT_STACK_CAPACITY = 64
+    };
+
     // DATA
     bsls::AlignedBuffer<k_BUFSIZE>  d_buffer;               // buffer
 
@@ -203,9 +241,28 @@ class Tokenizer {
                                                                  // buffer
 
     bsl::streambuf                      *d_streambuf_p;          // streambuf
+                                                                 // (held, not
+                                                                 // owned), or
+                                                                 // 0 if the
+                                                                 // input is
+                                                                 // contiguous
+
+    const char                          *d_data_p;               // characters
+                                                                 // being
+                                                                 // tokenized:
+                                                                 // the string
+                                                                 // buffer, or
+                                                                 // the
+                                                                 // contiguous
+                                                                 // input
                                                                  // (held, not
                                                                  // owned)
 
+    bsl::size_t                          d_dataLength;           // number of
+                                                                 // characters
+                                                                 // at
+                                                                 // 'd_data_p'
+
     bsl::size_t                          d_cursor;               // current
                                                                  // cursor
 
@@ -226,6 +283,26 @@ class Tokenizer {
     ContextType                          d_context;              // context
                                                                  // type
 
+    bsls::AlignedBuffer<k_CONTEXT_STACK_CAPACITY * sizeof(ContextType)>
+                                         d_contextBuffer;        // buffer
+
+    bdlma::BufferedSequentialAllocator   d_contextAllocator;     // allocator
+                                                                 // for
+                                                                 // context
+                                                                 // stack
+
+    bsl::vector<ContextType>             d_contextStack;         // contexts
+                                                                 // of the
+                                                                 // enclosing
+                                                                 // objects and
+                                                                 // arrays
+
+    bool                                 d_isInputContiguous;    // 'true' if
+                                                                 // the input
+                                                                 // is
+                                                                 // contiguous
+                                                                 // memory
+
     bool                                 d_allowStandAloneValues;// option for
                                                                  // allowing
                                                                  // stand alone
@@ -239,6 +316,16 @@ class Tokenizer {
                                                                 // values
 
     // PRIVATE MANIPULATORS
+    void popContext();
+        // Leave the innermost object or array being tokenized, and set the
+        // current context to that of the enclosing object or array, if any,
+        // and to 'e_OBJECT_CONTEXT' otherwise.
+
+    void updateDataFromStringBuffer();
+        // Set the characters being tokenized to those held in the internal
+        // string buffer, 'd_stringBuffer'.  This method must be called after
+        // each modification of 'd_stringBuffer'.
+
     int extractStringValue();
         // Extract the string value starting at the current data cursor and
         // update the value begin and end pointers to refer to the begin and
@@ -251,19 +338,22 @@ class Tokenizer {
         // additional characters, from the internally-held 'streambuf'
         // ('d_streambuf_p') to the end of that sequence up to a maximum
         // sequence length of 'd_buffer.size()' characters.  Return the number
-        // of bytes read from the 'streambuf'.
+        // of bytes read from the 'streambuf', which is 0 if the input is
+        // contiguous.
 
     int reloadStringBuffer();
         // Reload the string buffer with new data read from the underlying
         // 'streambuf' and overwriting the current buffer.  After reading
         // update the cursor to the new read location.  Return the number of
-        // bytes read from the 'streambuf'.
+        // bytes read from the 'streambuf', which is 0 if the input is
+        // contiguous.
 
     int expandBufferForLargeValue();
         // Increase the size of the string buffer, 'd_stringBuffer', and then
         // append additional characters, from the internally-held 'streambuf' (
         // 'd_streambuf_p') to the end of the current sequence of characters.
-        // Return 0 on success and a non-zero value otherwise.
+        // Return 0 on success and a non-zero value otherwise.  Note that this
+        // operation fails if the input is contiguous.
 
     int skipWhitespace();
         // Skip all whitespace characters and position the cursor onto the
@@ -295,6 +385,17 @@ class Tokenizer {
         // 'advanceToNextToken' is called.  Note that this function does not
         // change the value of the 'allowStandAloneValues' option.
 
+    void reset(const bslstl::StringRef& input);
+        // Reset this tokenizer to read the JSON data in the specified 'input'
+        // in place, without copying it.  The string references returned by
+        // the 'value' accessor refer to 'input', and remain valid after
+        // subsequent calls to 'advanceToNextToken'.  The behavior is undefined
+        // unless 'input' remains valid and unmodified until this tokenizer is
+        // reset or destroyed.  Note that the reader will not be on a valid
+        // node until 'advanceToNextToken' is called.  Also note that this
+        // function does not change the value of the 'allowStandAloneValues'
+        // option.
+
     int advanceToNextToken();
         // Move to the next token in the data steam.  Return 0 on success and a
         // non-zero value otherwise.  Note that each call to
@@ -311,7 +412,9 @@ class Tokenizer {
         // from where this object stopped.  Also note that this call implies
         // the end of processing for this object and any subsequent methods
         // invoked on this object should only be done after calling 'reset' and
-        // specifying a new 'streambuf'.
+        // specifying a new 'streambuf'.  Also note that this operation fails
+        // if the input of this tokenizer is contiguous, which has no
+        // 'streambuf' ('numBytesConsumed' can be used instead).
 
     void setAllowStandAloneValues(bool value);
         // Set the 'allowStandAloneValues' option to the specified 'value'.  If
@@ -342,6 +445,16 @@ class Tokenizer {
         // Return the value of the 'allowHeterogenousArrays' option of this
         // tokenizer.
 
+    bool isInputContiguous() const;
+        // Return 'true' if this tokenizer reads contiguous input, supplied to
+        // 'reset' as a 'bslstl::StringRef', and 'false' otherwise.
+
+    bsl::size_t numBytesConsumed() const;
+        // Return the number of bytes of contiguous input consumed by this
+        // tokenizer, i.e., the offset, in that input, of the byte following
+        // the current token.  The behavior is undefined unless
+        // 'isInputContiguous()'.
+
     int value(bslstl::StringRef *data) const;
         // Load into the specified 'data' the value of the specified token if
         // the current token's type is 'BAEJSN_ELEMENT_NAME' or
@@ -359,16 +472,25 @@ Tokenizer::Tokenizer(bslma::Allocator *basicAllocator)
 : d_allocator(d_buffer.buffer(), k_BUFSIZE, basicAllocator)
 , d_stringBuffer(&d_allocator)
 , d_streambuf_p(0)
+, d_data_p(0)
+, d_dataLength(0)
 , d_cursor(0)
 , d_valueBegin(0)
 , d_valueEnd(0)
 , d_valueIter(0)
 , d_tokenType(e_BEGIN)
 , d_context(e_OBJECT_CONTEXT)
+, d_contextAllocator(d_contextBuffer.buffer(),
+                       k_CONTEXT_STACK_CAPACITY * sizeof(ContextType),
+                       basicAllocator)
+, d_contextStack(&d_contextAllocator)
+, d_isInputContiguous(false)
 , d_allowStandAloneValues(true)
 , d_allowHeterogenousArrays(true)
 {
     d_stringBuffer.reserve(k_MAX_STRING_SIZE);
+    d_contextStack.reserve(k_CONTEXT_STACK_CAPACITY);
+    updateDataFromStringBuffer();
 }
 
 inline
@@ -376,17 +498,56 @@ Tokenizer::~Tokenizer()
 {
 }
 
+// PRIVATE MANIPULATORS
+inline
+void Tokenizer::popContext()
+{
+    if (!d_contextStack.empty()) {
+        d_contextStack.pop_back();
+    }
+    d_context = d_contextStack.empty() ? e_OBJECT_CONTEXT
+                                       : d_contextStack.back();
+}
+
+inline
+void Tokenizer::updateDataFromStringBuffer()
+{
+    d_data_p     = d_stringBuffer.data();
+    d_dataLength = d_stringBuffer.length();
+}
+
 // MANIPULATORS
 inline
 void Tokenizer::reset(bsl::streambuf *streambuf)
 {
-    d_streambuf_p = streambuf;
+    d_streambuf_p       = streambuf;
+    d_stringBuffer.clear();
+    updateDataFromStringBuffer();
+    d_cursor            = 0;
+    d_valueBegin        = 0;
+    d_valueEnd          = 0;
+    d_valueIter         = 0;
+    d_tokenType         = e_BEGIN;
+    d_context           = e_OBJECT_CONTEXT;
+    d_isInputContiguous = false;
+    d_contextStack.clear();
+}
+
+inline
+void Tokenizer::reset(const bslstl::StringRef& input)
+{
+    d_streambuf_p       = 0;
     d_stringBuffer.clear();
-    d_cursor      = 0;
-    d_valueBegin  = 0;
-    d_valueEnd    = 0;
-    d_valueIter   = 0;
-    d_tokenType   = e_BEGIN;
+    d_data_p            = input.data();
+    d_dataLength        = input.length();
+    d_cursor            = 0;
+    d_valueBegin        = 0;
+    d_valueEnd          = 0;
+    d_valueIter         = 0;
+    d_tokenType         = e_BEGIN;
+    d_context           = e_OBJECT_CONTEXT;
+    d_isInputContiguous = true;
+    d_contextStack.clear();
 }
 
 inline
@@ -420,6 +581,20 @@ bool Tokenizer::allowHeterogenousArrays() const
     return d_allowHeterogenousArrays;
 }
 
+inline
+bool Tokenizer::isInputContiguous() const
+{
+    return d_isInputContiguous;
+}
+
+inline
+bsl::size_t Tokenizer::numBytesConsumed() const
+{
+    BSLS_ASSERT_SAFE(isInputContiguous());
+
+    return d_cursor;
+}
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -10,6 +10,7 @@
 #include <bsl_climits.h>
 #include <bsl_limits.h>
 #include <bsl_iostream.h>
+#include <bsl_vector.h>
 
 #include <bslma_default.h>
 #include <bslma_defaultallocatorguard.h>
@@ -19,6 +20,8 @@
 #include <bdlsb_fixedmemoutstreambuf.h>       // for testing only
 #include <bdlsb_fixedmeminstreambuf.h>        // for testing only
 
+#include <bsls_stopwatch.h>
+
 #include <bsl_cstring.h>
 #include <bsl_cstdlib.h>
 
@@ -47,6 +50,7 @@ using bsl::endl;
 //
 // MANIPULATORS
 // [ 9] void reset(bsl::streambuf &streamBuf);
+// [18] void reset(const bslstl::StringRef& input);
 // [12] void resetStreamBufGetPointer();
 // [13] void setAllowStandAloneValues(bool value);
 // [14] void setAllowHeterogenousArrays(bool value);
@@ -57,9 +61,14 @@ using bsl::endl;
 // [13] bool allowStandAloneValues() const;
 // [14] bool allowHeterogenousArrays() const;
 // [ 3] int value(bslstl::StringRef *data) const;
+// [18] bool isInputContiguous() const;
+// [18] bsl::size_t numBytesConsumed() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [16] USAGE EXAMPLE
+// [17] CONCERN: TOKENS SPANNING READS FROM THE 'streambuf'
+// [18] CONCERN: CONTIGUOUS INPUT IS TOKENIZED IN PLACE
+// [-1] PERFORMANCE TEST
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -173,6 +182,32 @@ void confirmStreamBufReset(bsl::streambuf     *sb,
     }
 }
 
+void appendRecord(bsl::string *document, int index, bool pretty)
+    // Append to the specified 'document' a JSON object having the specified
+    // 'index' as one of its values, in the pretty style if the specified
+    // 'pretty' is 'true', and in the compact style otherwise.
+{
+    const char *separator = pretty ? "\n        " : "";
+    const char *colon     = pretty ? " : " : ":";
+
+    bsl::ostringstream oss;
+    oss << (pretty ? "    {" : "{") << separator
+        << "\"name\"" << colon << "\"record " << index << "\","
+        << separator
+        << "\"description\"" << colon
+        << "\"A record with a \\\"quoted\\\" word, a \\\\ backslash and "
+        << "enough text to make its value longer than its name\","
+        << separator
+        << "\"id\"" << colon << index << "," << separator
+        << "\"price\"" << colon << index * 0.25 << "," << separator
+        << "\"tags\"" << colon << "[\"alpha\",\"beta\",\"gamma\"],"
+        << separator
+        << "\"active\"" << colon << (index % 2 ? "true" : "false")
+        << (pretty ? "\n    }" : "}");
+
+    document->append(oss.str());
+}
+
 // ============================================================================
 //                               MAIN PROGRAM
 // ----------------------------------------------------------------------------
@@ -194,6 +229,391 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 18: {
+        // --------------------------------------------------------------------
+        // CONCERN: CONTIGUOUS INPUT IS TOKENIZED IN PLACE
+        //
+        // Concerns:
+        //: 1 A tokenizer reset with a 'bslstl::StringRef' produces the same
+        //:   tokens and values as one reading the same data from a
+        //:   'streambuf', including for values longer than a block of data
+        //:   read from a 'streambuf'.
+        //:
+        //: 2 The values of the tokens refer to the input, and remain valid
+        //:   after the tokenizer advances.
+        //:
+        //: 3 'numBytesConsumed' returns the offset of the byte following the
+        //:   current token.
+        //:
+        //: 4 Unterminated input is reported as an error.
+        //:
+        //: 5 'resetStreamBufGetPointer' fails for contiguous input.
+        //:
+        //: 6 Resetting the tokenizer with a 'streambuf' ends the contiguous
+        //:   mode.
+        //:
+        //: 7 No memory is allocated.
+        //
+        // Plan:
+        //: 1 For a set of documents, tokenize each document both from a
+        //:   'streambuf' and from contiguous memory, and verify that the
+        //:   token types and values are the same, that the values refer to
+        //:   the input, and that they are unchanged once the whole document
+        //:   is tokenized.  (C-1..2)
+        //:
+        //: 2 Verify the number of bytes consumed after each token of a short
+        //:   document.  (C-3)
+        //:
+        //: 3 Tokenize unterminated documents, and verify that an error is
+        //:   reported.  (C-4)
+        //:
+        //: 4 Verify that 'resetStreamBufGetPointer' fails, and that
+        //:   'isInputContiguous' reflects the last call to 'reset'.  (C-5..6)
+        //:
+        //: 5 Use a test allocator, and verify that no memory is allocated
+        //:   from it while tokenizing contiguous input.  (C-7)
+        //
+        // Testing:
+        //   void reset(const bslstl::StringRef& input);
+        //   bool isInputContiguous() const;
+        //   bsl::size_t numBytesConsumed() const;
+        //   CONCERN: CONTIGUOUS INPUT IS TOKENIZED IN PLACE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: CONTIGUOUS INPUT IS TOKENIZED IN PLACE"
+                          << endl
+                          << "==============================================="
+                          << endl;
+
+        const int BLOCK_SIZE = 8 * 1024 - 1;  // size of a read by 'Obj'
+
+        if (verbose) cout << "\nComparing with a 'streambuf'." << endl;
+        {
+            bsl::string longString(3 * BLOCK_SIZE, 'x');
+            longString[BLOCK_SIZE] = '\\';
+
+            bsl::string largeDocument("[");
+            for (int i = 0; i < 200; ++i) {
+                if (i) {
+                    largeDocument.append(",\n");
+                }
+                appendRecord(&largeDocument, i, i % 2);
+            }
+            largeDocument.append("]");
+
+            const bsl::string DOCUMENTS[] = {
+                "{}",
+                "[]",
+                " { \"a\" : 1, \"b\" : [ true, false, null ] } ",
+                "{\"a\\\"b\":\"c\\\\\",\"d\":[\"e\",{\"f\":-1.5e3}]}",
+                "[{\"long\":\"" + longString + "\"}]",
+                largeDocument,
+            };
+            const int NUM_DOCUMENTS = sizeof DOCUMENTS / sizeof *DOCUMENTS;
+
+            for (int ti = 0; ti < NUM_DOCUMENTS; ++ti) {
+                const bsl::string& DOCUMENT = DOCUMENTS[ti];
+
+                bdlsb::FixedMemInStreamBuf isb(DOCUMENT.data(),
+                                               DOCUMENT.length());
+
+                bslma::TestAllocator da("default", veryVeryVerbose);
+                bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+                Obj mY;  const Obj& Y = mY;
+                mY.reset(&isb);
+                ASSERTV(ti, !Y.isInputContiguous());
+
+                Obj mX(&sa);  const Obj& X = mX;
+                mX.reset(bslstl::StringRef(DOCUMENT.data(),
+                                           static_cast<int>(
+                                                          DOCUMENT.length())));
+                ASSERTV(ti, X.isInputContiguous());
+
+                const Int64 NUM_BLOCKS = sa.numBlocksTotal();
+
+                bsl::vector<bslstl::StringRef> values;
+                bsl::vector<bsl::string>       expected;
+
+                int rcY = 0;
+                int rcX = 0;
+                do {
+                    rcY = mY.advanceToNextToken();
+                    rcX = mX.advanceToNextToken();
+
+                    ASSERTV(ti, rcY, rcX, rcY == rcX);
+                    ASSERTV(ti, Y.tokenType(), X.tokenType(),
+                            Y.tokenType() == X.tokenType());
+
+                    bslstl::StringRef valueY;
+                    bslstl::StringRef valueX;
+                    if (0 == Y.value(&valueY)) {
+                        ASSERTV(ti, 0 == X.value(&valueX));
+                        ASSERTV(ti, valueY == valueX);
+                        ASSERTV(ti, DOCUMENT.data() <= valueX.data());
+                        ASSERTV(ti, DOCUMENT.data() + DOCUMENT.length()
+                                              >= valueX.end());
+
+                        values.push_back(valueX);
+                        expected.push_back(valueY);
+                    }
+                } while (0 == rcY && 0 == rcX);
+
+                ASSERTV(ti, Obj::e_ERROR == X.tokenType());
+                ASSERTV(ti, NUM_BLOCKS == sa.numBlocksTotal());
+
+                for (bsl::size_t i = 0; i < values.size(); ++i) {
+                    ASSERTV(ti, i, expected[i] == values[i]);
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting 'numBytesConsumed'." << endl;
+        {
+            const char DOCUMENT[] = " {\"ab\" : \"cd\", \"e\":12 }  ";
+
+            const struct {
+                Obj::TokenType d_type;
+                bsl::size_t    d_numBytesConsumed;
+            } DATA[] = {
+                { Obj::e_START_OBJECT,   2 },
+                { Obj::e_ELEMENT_NAME,   6 },
+                { Obj::e_ELEMENT_VALUE, 13 },
+                { Obj::e_ELEMENT_NAME,  18 },
+                { Obj::e_ELEMENT_VALUE, 21 },
+                { Obj::e_END_OBJECT,    23 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            Obj mX;  const Obj& X = mX;
+            mX.reset(bslstl::StringRef(DOCUMENT, sizeof DOCUMENT - 1));
+            ASSERTV(X.numBytesConsumed(), 0 == X.numBytesConsumed());
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                ASSERTV(ti, 0 == mX.advanceToNextToken());
+                ASSERTV(ti, X.tokenType(), DATA[ti].d_type == X.tokenType());
+                ASSERTV(ti, X.numBytesConsumed(),
+                        DATA[ti].d_numBytesConsumed == X.numBytesConsumed());
+            }
+            ASSERTV(0 != mX.advanceToNextToken());
+        }
+
+        if (verbose) cout << "\nTesting unterminated input." << endl;
+        {
+            const char *const INPUTS[] = {
+                "",
+                "   ",
+                "[\"abc",
+                "[\"abc\\",
+                "[\"abc\\\"",
+                "{\"a",
+            };
+            const int NUM_INPUTS = sizeof INPUTS / sizeof *INPUTS;
+
+            for (int ti = 0; ti < NUM_INPUTS; ++ti) {
+                Obj mX;  const Obj& X = mX;
+                mX.reset(bslstl::StringRef(INPUTS[ti]));
+
+                while (0 == mX.advanceToNextToken()) {
+                }
+                ASSERTV(ti, Obj::e_ERROR == X.tokenType());
+            }
+
+            // A number at the end of the input is a complete value.
+
+            Obj mX;  const Obj& X = mX;
+            mX.reset(bslstl::StringRef("[12"));
+
+            bslstl::StringRef token;
+            ASSERTV(0 == mX.advanceToNextToken());
+            ASSERTV(0 == mX.advanceToNextToken());
+            ASSERTV(Obj::e_ELEMENT_VALUE == X.tokenType());
+            ASSERTV(0 == X.value(&token));
+            ASSERTV(token, "12" == token);
+        }
+
+        if (verbose) cout << "\nTesting mode switches." << endl;
+        {
+            const char DOCUMENT[] = "[1,2]";
+
+            Obj mX;  const Obj& X = mX;
+            mX.reset(bslstl::StringRef(DOCUMENT));
+            ASSERTV(X.isInputContiguous());
+
+            ASSERTV(0 == mX.advanceToNextToken());
+            ASSERTV(0 != mX.resetStreamBufGetPointer());
+
+            bdlsb::FixedMemInStreamBuf isb(DOCUMENT, sizeof DOCUMENT - 1);
+            mX.reset(&isb);
+            ASSERTV(!X.isInputContiguous());
+
+            ASSERTV(0 == mX.advanceToNextToken());
+            ASSERTV(Obj::e_START_ARRAY == X.tokenType());
+            ASSERTV(0 == mX.advanceToNextToken());
+            ASSERTV(Obj::e_ELEMENT_VALUE == X.tokenType());
+            ASSERTV(0 == mX.resetStreamBufGetPointer());
+
+            mX.reset(bslstl::StringRef(DOCUMENT));
+            ASSERTV(X.isInputContiguous());
+            ASSERTV(0 == mX.advanceToNextToken());
+            ASSERTV(Obj::e_START_ARRAY == X.tokenType());
+        }
+      } break;
+      case 17: {
+        // --------------------------------------------------------------------
+        // CONCERN: TOKENS SPANNING READS FROM THE 'streambuf'
+        //
+        // Concerns:
+        //: 1 Whitespace, names, string values, and other values are
+        //:   tokenized correctly wherever they start and end relative to the
+        //:   blocks of data read from the 'streambuf', including when an
+        //:   escaping backslash is the last character read.
+        //:
+        //: 2 A string value containing escaped quotes and backslashes ends at
+        //:   the first quote that is not escaped.
+        //:
+        //: 3 Values longer than a block of data are tokenized correctly.
+        //
+        // Plan:
+        //: 1 For a set of string, number, and whitespace lengths, and for
+        //:   each offset, around the size of the blocks read from the
+        //:   'streambuf', at which to place the tokens, create a JSON
+        //:   document having whitespace up to the offset followed by an
+        //:   object holding the string and number values, and verify the
+        //:   tokens and values of the document.  (C-1..3)
+        //
+        // Testing:
+        //   CONCERN: TOKENS SPANNING READS FROM THE 'streambuf'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                       << endl
+                       << "CONCERN: TOKENS SPANNING READS FROM THE 'streambuf'"
+                       << endl
+                       << "==================================================="
+                       << endl;
+
+        const int BLOCK_SIZE = 8 * 1024 - 1;  // size of a read by 'Obj'
+
+        const char *const STRINGS[] = {
+            "",
+            "a",
+            "\\\\",
+            "\\\"",
+            "ab\\\"cd\\\\\\\"ef\\\\",
+            "\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\\",
+            "0123456789abcdef0123456789abcdef\\u0041\\n",
+        };
+        const int NUM_STRINGS = sizeof STRINGS / sizeof *STRINGS;
+
+        const int WHITESPACE_LENGTHS[] = { 0, 1, 17, 100 };
+        const int NUM_WHITESPACE_LENGTHS = sizeof  WHITESPACE_LENGTHS
+                                         / sizeof *WHITESPACE_LENGTHS;
+
+        for (int si = 0; si < NUM_STRINGS + 1; ++si) {
+            bsl::string value;
+            if (si < NUM_STRINGS) {
+                value = STRINGS[si];
+            }
+            else {
+                // A string longer than a block, alternating escapes.
+
+                for (int i = 0; value.length() < 3 * BLOCK_SIZE; ++i) {
+                    value.append(i % 3 ? "x\\\"" : "\\\\y");
+                }
+            }
+
+            for (int wi = 0; wi < NUM_WHITESPACE_LENGTHS; ++wi) {
+                const bsl::string WS_(WHITESPACE_LENGTHS[wi], ' ');
+
+                for (int offset = BLOCK_SIZE - 48;
+                     offset <= BLOCK_SIZE + 8;
+                     ++offset) {
+                    const bsl::string NAME = "n" + value;
+                    const bsl::string NUMBER(wi * 3 + 1, '7');
+
+                    bsl::string input(offset, ' ');
+                    input += "{" + WS_ + "\"" + NAME + "\"" + WS_ + ":" + WS_
+                           + "\"" + value + "\"" + WS_ + "," + WS_
+                           + "\"m\":" + NUMBER + WS_ + "}";
+
+                    bdlsb::FixedMemInStreamBuf isb(input.data(),
+                                                   input.length());
+
+                    Obj mX;  const Obj& X = mX;
+                    mX.reset(&isb);
+
+                    bslstl::StringRef token;
+
+                    ASSERTV(si, wi, offset, 0 == mX.advanceToNextToken());
+                    ASSERTV(si, wi, offset,
+                            Obj::e_START_OBJECT == X.tokenType());
+
+                    ASSERTV(si, wi, offset, 0 == mX.advanceToNextToken());
+                    ASSERTV(si, wi, offset,
+                            Obj::e_ELEMENT_NAME == X.tokenType());
+                    ASSERTV(si, wi, offset, 0 == X.value(&token));
+                    ASSERTV(si, wi, offset, NAME == token);
+
+                    ASSERTV(si, wi, offset, 0 == mX.advanceToNextToken());
+                    ASSERTV(si, wi, offset,
+                            Obj::e_ELEMENT_VALUE == X.tokenType());
+                    ASSERTV(si, wi, offset, 0 == X.value(&token));
+                    ASSERTV(si, wi, offset, "\"" + value + "\"" == token);
+
+                    ASSERTV(si, wi, offset, 0 == mX.advanceToNextToken());
+                    ASSERTV(si, wi, offset,
+                            Obj::e_ELEMENT_NAME == X.tokenType());
+                    ASSERTV(si, wi, offset, 0 == X.value(&token));
+                    ASSERTV(si, wi, offset, "m" == token);
+
+                    ASSERTV(si, wi, offset, 0 == mX.advanceToNextToken());
+                    ASSERTV(si, wi, offset,
+                            Obj::e_ELEMENT_VALUE == X.tokenType());
+                    ASSERTV(si, wi, offset, 0 == X.value(&token));
+                    ASSERTV(si, wi, offset, NUMBER == token);
+
+                    ASSERTV(si, wi, offset, 0 == mX.advanceToNextToken());
+                    ASSERTV(si, wi, offset,
+                            Obj::e_END_OBJECT == X.tokenType());
+
+                    ASSERTV(si, wi, offset, 0 != mX.advanceToNextToken());
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTesting unterminated strings." << endl;
+        {
+            for (int offset = BLOCK_SIZE - 4;
+                 offset <= BLOCK_SIZE + 4;
+                 ++offset) {
+                const char *const INPUTS[] = {
+                    "\"abc",
+                    "\"abc\\",
+                    "\"abc\\\"",
+                };
+                const int NUM_INPUTS = sizeof INPUTS / sizeof *INPUTS;
+
+                for (int i = 0; i < NUM_INPUTS; ++i) {
+                    bsl::string input(offset, ' ');
+                    input += "[";
+                    input += INPUTS[i];
+
+                    bdlsb::FixedMemInStreamBuf isb(input.data(),
+                                                   input.length());
+
+                    Obj mX;  const Obj& X = mX;
+                    mX.reset(&isb);
+
+                    ASSERTV(offset, i, 0 == mX.advanceToNextToken());
+                    ASSERTV(offset, i, Obj::e_START_ARRAY == X.tokenType());
+                    ASSERTV(offset, i, 0 != mX.advanceToNextToken());
+                    ASSERTV(offset, i, Obj::e_ERROR == X.tokenType());
+                }
+            }
+        }
+      } break;
       case 16: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
@@ -613,6 +1033,54 @@ int main(int argc, char *argv[])
                 true,
                 Obj::e_ELEMENT_VALUE,
             },
+            {
+                L_,
+                "[{},1]",
+                3,
+                true,
+                true,
+                Obj::e_ELEMENT_VALUE,
+            },
+            {
+                L_,
+                "[{},1]",
+                3,
+                false,
+                false,
+                Obj::e_ERROR,
+            },
+            {
+                L_,
+                "[[],{}]",
+                3,
+                true,
+                true,
+                Obj::e_START_OBJECT,
+            },
+            {
+                L_,
+                "[[],{}]",
+                3,
+                false,
+                false,
+                Obj::e_ERROR,
+            },
+            {
+                L_,
+                "[{},[]]",
+                3,
+                true,
+                true,
+                Obj::e_START_ARRAY,
+            },
+            {
+                L_,
+                "[{},[]]",
+                3,
+                false,
+                false,
+                Obj::e_ERROR,
+            },
             // {
             //     L_,
             //     "[[], \"Hello\"]",
@@ -6606,6 +7074,75 @@ int main(int argc, char *argv[])
         Obj mX;  const Obj& X = mX;
         ASSERTV(X.tokenType(), Obj::e_BEGIN == X.tokenType());
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Measure the throughput of the tokenizer on a large document.
+        //
+        // Concerns:
+        //: 1 Tokenizing a large document is limited by the speed of scanning
+        //:   its characters.
+        //
+        // Plan:
+        //: 1 Create a document, in the compact and in the pretty style,
+        //:   holding an array of objects whose values are strings, some with
+        //:   escaped characters, numbers, and arrays, and tokenize it a
+        //:   number of times, specified on the command line, reporting the
+        //:   throughput in MB/s.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        const int REPS        = argc > 2 ? atoi(argv[2]) : 10;
+        const int NUM_RECORDS = 20000;
+
+        for (int pretty = 0; pretty < 2; ++pretty) {
+            bsl::string document("[");
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                if (i) {
+                    document.append(pretty ? ",\n" : ",");
+                }
+                appendRecord(&document, i, pretty);
+            }
+            document.append("]");
+
+            Int64 numTokens = 0;
+
+            bsls::Stopwatch stopwatch;
+            stopwatch.start();
+
+            for (int i = 0; i < REPS; ++i) {
+                bdlsb::FixedMemInStreamBuf isb(document.data(),
+                                               document.length());
+
+                Obj mX;  const Obj& X = mX;
+                mX.reset(&isb);
+
+                while (0 == mX.advanceToNextToken()) {
+                    ++numTokens;
+                }
+                ASSERTV(X.tokenType(), Obj::e_ERROR == X.tokenType());
+            }
+
+            stopwatch.stop();
+
+            const double elapsed = stopwatch.elapsedTime();
+            const double megabytes =
+                         static_cast<double>(document.length()) * REPS / 1e6;
+
+            cout << (pretty ? "Pretty:  " : "Compact: ")
+                 << document.length() << " bytes, "
+                 << numTokens / REPS << " tokens, "
+                 << elapsed << " seconds, "
+                 << (elapsed > 0 ? megabytes / elapsed : 0) << " MB/s"
+                 << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
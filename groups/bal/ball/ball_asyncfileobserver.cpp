@@ -27,10 +27,13 @@ BSLS_IDENT_RCSID(ball_asyncfileobserver_cpp,"$Id$ $CSID$")
 #include <bslmt_lockguard.h>
 #include <bslmt_threadattributes.h>
 #include <bsls_assert.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
 
 #include <bsl_functional.h>
 #include <bsl_iostream.h>
 #include <bsl_memory.h>
+#include <bsl_vector.h>
 
 // IMPLEMENTATION NOTE: 'shutdownThread' clears the queue in order to simplify
 // the implementation.  To guarantee that a thread sees the
@@ -49,6 +52,7 @@ namespace {
 
 enum {
     DEFAULT_FIXED_QUEUE_SIZE = 8192,
+    DEFAULT_MAX_BATCH_SIZE   = 256,
     FORCE_WARN_THRESHOLD     = 5000
 };
 
@@ -93,20 +97,59 @@ void AsyncFileObserver::publishThreadEntryPoint()
                                           bslmt::ThreadUtil::selfIdAsUint64());
 
     while (!done) {
-        AsyncRecord asyncRecord = d_recordQueue.popFront();
+        const bsl::size_t maxBatchSize = d_maxBatchSize.loadRelaxed();
+
+        d_recordQueue.popFront(maxBatchSize, &d_batch);
+
+        // If the queue was drained before a full batch was collected, wait up
+        // to the configured flush latency for more records to arrive, unless
+        // the thread has been asked to stop.
+
+        const bsls::Types::Int64 latency = d_flushLatency.loadRelaxed();
+        if (0 < latency
+         && d_batch.size() < maxBatchSize
+         && Transmission::e_END !=
+                                d_batch.back().d_context.transmissionCause()
+         && !d_shuttingDownFlag) {
+            bsls::TimeInterval sleepInterval;
+            sleepInterval.addMicroseconds(latency);
+            bslmt::ThreadUtil::sleep(sleepInterval);
+
+            d_recordQueue.tryPopFront(maxBatchSize - d_batch.size(),
+                                      &d_batch);
+        }
 
-        // Publish the next log record on the queue only if the observer is
-        // not shutting down.
+        // Publish the batch only if the observer is not shutting down.  Note
+        // that records enqueued after an 'e_END' record (by a thread that
+        // published while the thread was being stopped) are published rather
+        // than discarded.
 
-        if (Transmission::e_END == asyncRecord.d_context.transmissionCause()
-            || d_shuttingDownFlag) {
+        d_batchRecords.clear();
+        for (bsl::size_t i = 0; i < d_batch.size(); ++i) {
+            if (Transmission::e_END ==
+                                   d_batch[i].d_context.transmissionCause()) {
+                done = true;
+            }
+            else {
+                d_batchRecords.push_back(d_batch[i].d_record.get());
+            }
+        }
+
+        if (d_shuttingDownFlag) {
             done = true;
         }
-        else {
-            d_fileObserver.publish(*asyncRecord.d_record,
-                                   asyncRecord.d_context);
+        else if (!d_batchRecords.empty()) {
+            d_fileObserver.publishBatch(&d_batchRecords.front(),
+                                        static_cast<int>(
+                                                       d_batchRecords.size()));
         }
 
+        // Release the shared references to the published records before
+        // (potentially) blocking on the queue.
+
+        d_batch.clear();
+        d_batchRecords.clear();
+
         // Publish the count of dropped records.  To avoid repeatedly
         // publishing this information when the record queue is full, we
         // publish the number of dropped records only when the queue becomes
@@ -204,6 +247,10 @@ AsyncFileObserver::AsyncFileObserver(Severity::Level   stdoutThreshold,
 , d_shuttingDownFlag(0)
 , d_dropRecordsOnFullQueueThreshold(Severity::e_OFF)
 , d_droppedRecordWarning(basicAllocator)
+, d_maxBatchSize(DEFAULT_MAX_BATCH_SIZE)
+, d_flushLatency(0)
+, d_batch(basicAllocator)
+, d_batchRecords(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     construct();
@@ -217,6 +264,10 @@ AsyncFileObserver::AsyncFileObserver(Severity::Level   stdoutThreshold,
 , d_shuttingDownFlag(0)
 , d_dropRecordsOnFullQueueThreshold(Severity::e_OFF)
 , d_droppedRecordWarning(basicAllocator)
+, d_maxBatchSize(DEFAULT_MAX_BATCH_SIZE)
+, d_flushLatency(0)
+, d_batch(basicAllocator)
+, d_batchRecords(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     construct();
@@ -231,6 +282,10 @@ AsyncFileObserver::AsyncFileObserver(Severity::Level   stdoutThreshold,
 , d_shuttingDownFlag(0)
 , d_dropRecordsOnFullQueueThreshold(Severity::e_OFF)
 , d_droppedRecordWarning(basicAllocator)
+, d_maxBatchSize(DEFAULT_MAX_BATCH_SIZE)
+, d_flushLatency(0)
+, d_batch(basicAllocator)
+, d_batchRecords(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     construct();
@@ -247,6 +302,10 @@ AsyncFileObserver::AsyncFileObserver(
 , d_shuttingDownFlag(0)
 , d_dropRecordsOnFullQueueThreshold(dropRecordsOnFullQueueThreshold)
 , d_droppedRecordWarning(basicAllocator)
+, d_maxBatchSize(DEFAULT_MAX_BATCH_SIZE)
+, d_flushLatency(0)
+, d_batch(basicAllocator)
+, d_batchRecords(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
     construct();
@@ -95,12 +95,16 @@ using bsl::flush;
 // [ 3] void forceRotation()
 // [ 3] void rotateOnSize(int size)
 // [ 3] void rotateOnTimeInterval(const bdlt::DatetimeInterval timeInterval)
+// [10] void setFlushLatency(const bsls::TimeInterval& latency)
+// [10] void setMaxBatchSize(int maxNumRecords)
 // [ 1] void setStdoutThreshold(ball::Severity::Level stdoutThreshold)
 // [ 1] void setLogFormat(const char*, const char*)
 // [ 1] void startPublicationThread();
 // [ 1] void stopPublicationThread();
 //
 // ACCESSORS
+// [10] bsls::TimeInterval flushLatency() const
+// [10] int maxBatchSize() const
 // [ 9] int recordQueueLength() const
 // [ 1] bool isFileLoggingEnabled() const
 // [ 1] bool isStdoutLoggingPrefixEnabled() const
@@ -111,7 +115,9 @@ using bsl::flush;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 8] CONCERN: CONCURRENT PUBLICATION
-// [10] USAGE EXAMPLE
+// [10] CONCERN: BATCHED PUBLICATION
+// [11] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: BURST PUBLICATION
 //
 //=============================================================================
 //                        STANDARD BDE ASSERT TEST MACROS
@@ -346,6 +352,35 @@ bsl::string readPartialFile(bsl::string& fileName, int startOffset)
     return result;
 }
 
+bsl::string readWholeFile(const bsl::string& fileName)
+    // Return the contents of the file having the specified 'fileName'.
+{
+    bsl::ifstream fs(fileName.c_str(), bsl::ifstream::in);
+    ASSERT(fs.is_open());
+
+    bsl::ostringstream oss;
+    oss << fs.rdbuf();
+    return oss.str();
+}
+
+void publishNumberedRecords(Obj *observer, int numRecords)
+    // Publish to the specified 'observer' the specified 'numRecords' records
+    // having 'INFO' severity and the messages "record 0", "record 1", etc.
+{
+    ball::Context context;
+    for (int i = 0; i < numRecords; ++i) {
+        bsl::shared_ptr<ball::Record> record;
+        record.createInplace();
+
+        bsl::ostringstream message;
+        message << "record " << i;
+
+        record->fixedFields().setSeverity(ball::Severity::e_INFO);
+        record->fixedFields().setMessage(message.str().c_str());
+        observer->publish(record, context);
+    }
+}
+
 int countLoggedRecords(const bsl::string& fileName)
 {
     bsl::string line;
@@ -540,7 +575,7 @@ int main(int argc, char *argv[])
     bslma::TestAllocator allocator; bslma::TestAllocator *Z = &allocator;
 
     switch (test) { case 0:
-      case 10: {
+      case 11: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //
@@ -599,6 +634,180 @@ int main(int argc, char *argv[])
         asyncFileObserver.stopPublicationThread();
         removeFilesByPrefix(fileName.c_str());
       } break;
+      case 10: {
+        // --------------------------------------------------------------------
+        // TESTING: BATCHED PUBLICATION
+        //
+        // Concerns:
+        //:  1 By default, up to 256 records are published per batch, and no
+        //:    flush latency is applied.
+        //:
+        //:  2 'setMaxBatchSize' and 'setFlushLatency' set the values returned
+        //:    by 'maxBatchSize' and 'flushLatency', respectively.
+        //:
+        //:  3 Every published record is written to the log file exactly once,
+        //:    and in order, irrespective of the batch size and flush latency.
+        //:
+        //:  4 A partial batch is written after (at most approximately) the
+        //:    flush latency, even if no further records are published.
+        //
+        // Plan:
+        //:  1 Create an async file observer and verify the default values of
+        //:    'maxBatchSize' and 'flushLatency'.  Set a series of values and
+        //:    verify the accessors reflect them.  (C-1..2)
+        //:
+        //:  2 For a table of batch sizes and flush latencies, create a
+        //:    blocking async file observer, publish a sequence of numbered
+        //:    records while the publication thread is running, stop the
+        //:    publication thread, and verify that every record appears in the
+        //:    log file in publication order.  (C-3)
+        //:
+        //:  3 Configure a flush latency, publish a single record, and verify
+        //:    the record is written to the log file without publishing any
+        //:    further records.  (C-4)
+        //
+        // Testing:
+        //   void setFlushLatency(const bsls::TimeInterval& latency);
+        //   void setMaxBatchSize(int maxNumRecords);
+        //   bsls::TimeInterval flushLatency() const;
+        //   int maxBatchSize() const;
+        //   CONCERN: BATCHED PUBLICATION
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << endl
+                 << "TESTING: BATCHED PUBLICATION" << endl
+                 << "============================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&ta);
+
+        if (veryVerbose) cout << "\tTesting default values and accessors."
+                              << endl;
+        {
+            Obj mX(ball::Severity::e_OFF, &ta);  const Obj& X = mX;
+
+            ASSERT(256                  == X.maxBatchSize());
+            ASSERT(bsls::TimeInterval() == X.flushLatency());
+
+            mX.setMaxBatchSize(1);
+            ASSERT(1 == X.maxBatchSize());
+
+            mX.setMaxBatchSize(4096);
+            ASSERT(4096 == X.maxBatchSize());
+
+            mX.setFlushLatency(bsls::TimeInterval(0, 250000));
+            ASSERT(bsls::TimeInterval(0, 250000) == X.flushLatency());
+
+            mX.setFlushLatency(bsls::TimeInterval(2, 0));
+            ASSERT(bsls::TimeInterval(2, 0) == X.flushLatency());
+
+            mX.setFlushLatency(bsls::TimeInterval());
+            ASSERT(bsls::TimeInterval() == X.flushLatency());
+        }
+
+        if (veryVerbose) cout << "\tTesting record order and completeness."
+                              << endl;
+        {
+            static const struct {
+                int d_line;          // source line number
+                int d_maxBatchSize;  // maximum records per batch
+                int d_latencyUs;     // flush latency (microseconds)
+            } DATA[] = {
+                //LINE  BATCH  LATENCY
+                //----  -----  -------
+                { L_,       1,       0 },
+                { L_,       2,       0 },
+                { L_,      17,       0 },
+                { L_,     256,       0 },
+                { L_,    4096,       0 },
+                { L_,       1,    1000 },
+                { L_,      64,    1000 },
+                { L_,    4096,   10000 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            enum { NUM_RECORDS = 2000, MAX_QUEUE_LENGTH = 512 };
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE       = DATA[ti].d_line;
+                const int BATCH_SIZE = DATA[ti].d_maxBatchSize;
+                const int LATENCY    = DATA[ti].d_latencyUs;
+
+                if (veryVeryVerbose) { T_() P_(LINE) P_(BATCH_SIZE) P(LATENCY) }
+
+                bsl::string fileName = tempFileName(veryVerbose);
+
+                // Set up a blocking async observer, so that no records are
+                // dropped.
+
+                Obj mX(ball::Severity::e_OFF,
+                       false,
+                       MAX_QUEUE_LENGTH,
+                       ball::Severity::e_TRACE,
+                       &ta);
+
+                mX.setMaxBatchSize(BATCH_SIZE);
+                mX.setFlushLatency(bsls::TimeInterval(0, LATENCY * 1000));
+                ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+                ASSERT(0 == mX.startPublicationThread());
+
+                publishNumberedRecords(&mX, NUM_RECORDS);
+
+                ASSERT(0 == mX.stopPublicationThread());
+                mX.disableFileLogging();
+
+                const bsl::string content = readWholeFile(fileName);
+
+                LOOP_ASSERT(LINE, NUM_RECORDS == countLoggedRecords(fileName));
+
+                bsl::string::size_type position = 0;
+                for (int i = 0; i < NUM_RECORDS; ++i) {
+                    bsl::ostringstream message;
+                    message << "record " << i << " ";
+
+                    position = content.find(message.str(), position);
+                    LOOP2_ASSERT(LINE, i, bsl::string::npos != position);
+                    if (bsl::string::npos == position) {
+                        break;
+                    }
+                }
+
+                removeFilesByPrefix(fileName.c_str());
+            }
+        }
+
+        if (veryVerbose) cout << "\tTesting a partial batch is flushed."
+                              << endl;
+        {
+            bsl::string fileName = tempFileName(veryVerbose);
+
+            Obj mX(ball::Severity::e_OFF, &ta);
+
+            mX.setFlushLatency(bsls::TimeInterval(0, 100 * 1000 * 1000));
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+            ASSERT(0 == mX.startPublicationThread());
+
+            publishNumberedRecords(&mX, 1);
+
+            bsls::Stopwatch timer;
+            timer.start();
+            while (1 != countLoggedRecords(fileName)) {
+                if (timer.elapsedTime() > 5) {
+                    ASSERTV("Partial batch not flushed",
+                            timer.elapsedTime(),
+                            false);
+                    break;
+                }
+                bslmt::ThreadUtil::microSleep(10000, 0);
+            }
+            ASSERTV(timer.elapsedTime(), timer.elapsedTime() < 5);
+
+            ASSERT(0 == mX.stopPublicationThread());
+            mX.disableFileLogging();
+            removeFilesByPrefix(fileName.c_str());
+        }
+      } break;
       case 9: {
         // --------------------------------------------------------------------
         // TESTING: 'recordQueueLength'
@@ -3001,6 +3210,70 @@ int main(int argc, char *argv[])
         fclose(stdout);
         removeFilesByPrefix(fileName.c_str());
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: BURST PUBLICATION
+        //
+        // Concerns:
+        //:  1 Publishing records in batches, written with one system call per
+        //:    batch, yields higher throughput under burst load than writing
+        //:    each record individually.
+        //
+        // Plan:
+        //:  1 For a series of maximum batch sizes (including 1, which writes
+        //:    records individually), create a blocking async file observer,
+        //:    publish a burst of records, and measure the time until the
+        //:    publication thread has written all of them to the log file.
+        //:    Report the throughput for each batch size.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: BURST PUBLICATION
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << endl
+                 << "PERFORMANCE TEST: BURST PUBLICATION" << endl
+                 << "===================================" << endl;
+
+        enum { NUM_RECORDS = 200000 };
+
+        const int BATCH_SIZES[] = { 1, 16, 256, 4096 };
+        const int NUM_BATCH_SIZES = sizeof BATCH_SIZES / sizeof *BATCH_SIZES;
+
+        for (int ti = 0; ti < NUM_BATCH_SIZES; ++ti) {
+            const int BATCH_SIZE = BATCH_SIZES[ti];
+
+            bsl::string fileName = tempFileName(veryVerbose);
+
+            Obj mX(ball::Severity::e_OFF,
+                   false,
+                   8192,
+                   ball::Severity::e_TRACE);
+
+            mX.setMaxBatchSize(BATCH_SIZE);
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+            ASSERT(0 == mX.startPublicationThread());
+
+            bsls::Stopwatch timer;
+            timer.start();
+
+            publishNumberedRecords(&mX, NUM_RECORDS);
+            ASSERT(0 == mX.stopPublicationThread());
+
+            timer.stop();
+
+            mX.disableFileLogging();
+            ASSERT(NUM_RECORDS == countLoggedRecords(fileName));
+            removeFilesByPrefix(fileName.c_str());
+
+            cout << "maxBatchSize = " << BATCH_SIZE
+                 << ": " << NUM_RECORDS << " records in "
+                 << timer.elapsedTime() << "s ("
+                 << static_cast<bsls::Types::Int64>(
+                                        NUM_RECORDS / timer.elapsedTime())
+                 << " records/s)" << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
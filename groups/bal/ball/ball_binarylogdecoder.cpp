@@ -0,0 +1,200 @@
+// ball_binarylogdecoder.cpp                                          -*-C++-*-
+#include <ball_binarylogdecoder.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_binarylogdecoder_cpp,"$Id$ $CSID$")
+
+#include <ball_binaryrecordutil.h>
+#include <ball_recordattributes.h>
+
+#include <bdls_filesystemutil.h>
+#include <bdls_memoryutil.h>
+
+#include <bsls_assert.h>
+
+#include <bsl_ostream.h>
+
+namespace BloombergLP {
+namespace ball {
+
+                          // ----------------------
+                          // class BinaryLogDecoder
+                          // ----------------------
+
+// PRIVATE MANIPULATORS
+int BinaryLogDecoder::decodeImp(bsl::ostream         *stream,
+                                const RecordVisitor  *visitor,
+                                const char           *data,
+                                bsl::size_t           length)
+{
+    BSLS_ASSERT(!stream != !visitor);
+    BSLS_ASSERT(data || 0 == length);
+
+    typedef BinaryRecordUtil Util;
+
+    int version;
+    if (0 != Util::readHeader(&version, data, length)
+     || Util::k_VERSION != version) {
+        return -1;                                                    // RETURN
+    }
+
+    d_strings.clear();
+
+    const char      *position = data + Util::k_HEADER_SIZE;
+    const char      *end      = data + length;
+    Util::EntryType  type;
+    const char      *payload;
+    int              payloadLength;
+
+    int rc;
+    while (0 == (rc = Util::readEntry(&type,
+                                      &payload,
+                                      &payloadLength,
+                                      &position,
+                                      end))) {
+        if (Util::e_STRING_ENTRY == type) {
+            int               id;
+            bslstl::StringRef value;
+            if (0 != Util::decodeStringEntry(&id,
+                                             &value,
+                                             payload,
+                                             payloadLength)) {
+                return -2;                                            // RETURN
+            }
+            d_strings[id].assign(value.begin(), value.end());
+            continue;
+        }
+
+        int categoryId;
+        int fileNameId;
+        if (0 != Util::decodeRecordEntry(&d_record,
+                                         &categoryId,
+                                         &fileNameId,
+                                         payload,
+                                         payloadLength)) {
+            return -3;                                                // RETURN
+        }
+
+        StringTable::const_iterator category = d_strings.find(categoryId);
+        StringTable::const_iterator fileName = d_strings.find(fileNameId);
+        if (d_strings.end() == category || d_strings.end() == fileName) {
+            return -4;                                                // RETURN
+        }
+
+        d_record.fixedFields().setCategory(category->second.c_str());
+        d_record.fixedFields().setFileName(fileName->second.c_str());
+
+        if (stream) {
+            d_formatter(*stream, d_record);
+        }
+        else {
+            (*visitor)(d_record);
+        }
+    }
+
+    return 1 == rc ? 0 : -5;
+}
+
+int BinaryLogDecoder::decodeFileImp(bsl::ostream         *stream,
+                                    const RecordVisitor  *visitor,
+                                    const char           *segmentFileName)
+{
+    BSLS_ASSERT(segmentFileName);
+
+    typedef bdls::FilesystemUtil FileUtil;
+
+    const FileUtil::Offset size = FileUtil::getFileSize(segmentFileName);
+    if (size < BinaryRecordUtil::k_HEADER_SIZE) {
+        return -1;                                                    // RETURN
+    }
+
+    const FileUtil::FileDescriptor descriptor =
+                                     FileUtil::open(segmentFileName,
+                                                    FileUtil::e_OPEN,
+                                                    FileUtil::e_READ_ONLY);
+    if (FileUtil::k_INVALID_FD == descriptor) {
+        return -1;                                                    // RETURN
+    }
+
+    void *address = 0;
+    if (0 != FileUtil::map(descriptor,
+                           &address,
+                           0,
+                           static_cast<bsl::size_t>(size),
+                           bdls::MemoryUtil::k_ACCESS_READ)) {
+        FileUtil::close(descriptor);
+        return -1;                                                    // RETURN
+    }
+
+    const int rc = decodeImp(stream,
+                             visitor,
+                             static_cast<const char *>(address),
+                             static_cast<bsl::size_t>(size));
+
+    FileUtil::unmap(address, static_cast<bsl::size_t>(size));
+    FileUtil::close(descriptor);
+    return rc;
+}
+
+// CREATORS
+BinaryLogDecoder::BinaryLogDecoder(bslma::Allocator *basicAllocator)
+: d_formatter(basicAllocator)
+, d_strings(basicAllocator)
+, d_record(basicAllocator)
+{
+}
+
+BinaryLogDecoder::BinaryLogDecoder(
+                                  const RecordStringFormatter&  formatter,
+                                  bslma::Allocator             *basicAllocator)
+: d_formatter(formatter, basicAllocator)
+, d_strings(basicAllocator)
+, d_record(basicAllocator)
+{
+}
+
+// MANIPULATORS
+int BinaryLogDecoder::decode(const RecordVisitor&  visitor,
+                             const char           *data,
+                             bsl::size_t           length)
+{
+    return decodeImp(0, &visitor, data, length);
+}
+
+int BinaryLogDecoder::decode(bsl::ostream&  stream,
+                             const char    *data,
+                             bsl::size_t    length)
+{
+    return decodeImp(&stream, 0, data, length);
+}
+
+int BinaryLogDecoder::decodeFile(const RecordVisitor&  visitor,
+                                 const char           *segmentFileName)
+{
+    return decodeFileImp(0, &visitor, segmentFileName);
+}
+
+int BinaryLogDecoder::decodeFile(bsl::ostream&  stream,
+                                 const char    *segmentFileName)
+{
+    return decodeFileImp(&stream, 0, segmentFileName);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
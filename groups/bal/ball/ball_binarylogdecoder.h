@@ -0,0 +1,282 @@
+// ball_binarylogdecoder.h                                            -*-C++-*-
+#ifndef INCLUDED_BALL_BINARYLOGDECODER
+#define INCLUDED_BALL_BINARYLOGDECODER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a decoder rendering binary log segments as text.
+//
+//@CLASSES:
+//  ball::BinaryLogDecoder: decoder of binary log segments
+//
+//@SEE_ALSO: ball_binaryrecordutil, ball_mappedfileobserver,
+//           ball_recordstringformatter
+//
+//@DESCRIPTION: This component provides a mechanism, 'ball::BinaryLogDecoder',
+// that decodes the log records held in a binary log segment (see
+// 'ball_binaryrecordutil'), such as one written by a
+// 'ball::MappedFileObserver', and either renders them as text, using a
+// 'ball::RecordStringFormatter', or supplies them to a caller-supplied
+// function.  By default, records are rendered in the same format as that used
+// by 'ball::FileObserver' and 'ball::FileObserver2', so that the text decoded
+// from a binary segment is identical to that which a file observer would have
+// written had it published the same records:
+//..
+//  "\n%d %p:%t %s %f:%l %c %m %u\n"
+//..
+// A segment is decoded up to its end-of-data marker (or its end).  If an entry
+// of the segment is found to be malformed, or a record refers to a string
+// identifier that the segment does not define, decoding stops and an error
+// status is returned; the records that precede the malformed entry have been
+// decoded at that point.
+//
+///Thread Safety
+///-------------
+// 'ball::BinaryLogDecoder' is *const* *thread-safe*, meaning that accessors
+// may be invoked concurrently from different threads, but it is not safe to
+// access or modify a 'ball::BinaryLogDecoder' in one thread while another
+// thread modifies the same object.  Note that the 'decode' methods are
+// manipulators.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Rendering a Segment as Text
+///- - - - - - - - - - - - - - - - - - -
+// In this example, we render, as text, a segment that was written by a
+// 'ball::MappedFileObserver'.
+//
+// First, we publish a record to a segment file named by 'segmentName':
+//..
+//  ball::MappedFileObserver observer;
+//  observer.setSegmentSize(64 * 1024);
+//  observer.enableFileLogging(baseName.c_str());
+//
+//  bsl::string segmentName;
+//  observer.isFileLoggingEnabled(&segmentName);
+//
+//  ball::RecordAttributes attributes(bdlt::Datetime(2018, 5, 1, 12, 30),
+//                                    1234,
+//                                    5678,
+//                                    "server.cpp",
+//                                    42,
+//                                    "SERVER",
+//                                    ball::Severity::e_INFO,
+//                                    "request complete");
+//  observer.publish(ball::Record(attributes, ball::UserFields()),
+//                   ball::Context(ball::Transmission::e_PASSTHROUGH, 0, 1));
+//  observer.disableFileLogging();
+//..
+// Then, we create a decoder that renders records in a compact format:
+//..
+//  ball::BinaryLogDecoder decoder(
+//                      ball::RecordStringFormatter("%d %s %c %m\n"));
+//..
+// Finally, we decode the segment, and verify the rendered text:
+//..
+//  bsl::ostringstream stream;
+//
+//  int rc = decoder.decodeFile(stream, segmentName.c_str());
+//  assert(0 == rc);
+//  assert("01MAY2018_12:30:00.000 INFO SERVER request complete\n"
+//                                                            == stream.str());
+//..
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BALL_RECORD
+#include <ball_record.h>
+#endif
+
+#ifndef INCLUDED_BALL_RECORDSTRINGFORMATTER
+#include <ball_recordstringformatter.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_FUNCTIONAL
+#include <bsl_functional.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOSFWD
+#include <bsl_iosfwd.h>
+#endif
+
+#ifndef INCLUDED_BSL_STRING
+#include <bsl_string.h>
+#endif
+
+#ifndef INCLUDED_BSL_UNORDERED_MAP
+#include <bsl_unordered_map.h>
+#endif
+
+namespace BloombergLP {
+namespace ball {
+
+                          // ======================
+                          // class BinaryLogDecoder
+                          // ======================
+
+class BinaryLogDecoder {
+    // This class provides a mechanism for decoding the log records held in a
+    // binary log segment, and rendering them as text.
+
+  public:
+    // TYPES
+    typedef bsl::function<void(const Record&)> RecordVisitor;
+        // 'RecordVisitor' is an alias for a function invoked with each record
+        // decoded from a segment.
+
+  private:
+    // PRIVATE TYPES
+    typedef bsl::unordered_map<int, bsl::string> StringTable;
+        // maps each string identifier defined by a segment to its string
+
+    // DATA
+    RecordStringFormatter  d_formatter;  // renders records as text
+
+    StringTable            d_strings;    // strings defined by the segment
+                                         // being decoded
+
+    Record                 d_record;     // record being decoded
+
+    // NOT IMPLEMENTED
+    BinaryLogDecoder(const BinaryLogDecoder&);
+    BinaryLogDecoder& operator=(const BinaryLogDecoder&);
+
+  private:
+    // PRIVATE MANIPULATORS
+    int decodeImp(bsl::ostream         *stream,
+                  const RecordVisitor  *visitor,
+                  const char           *data,
+                  bsl::size_t           length);
+        // Render each record held by the segment having the specified 'data'
+        // of the specified 'length' to the specified 'stream' if 'stream' is
+        // not 0, and invoke the specified 'visitor' with it otherwise.  Return
+        // 0 on success, and a non-zero value otherwise.  The behavior is
+        // undefined unless exactly one of 'stream' and 'visitor' is 0.
+
+    int decodeFileImp(bsl::ostream         *stream,
+                      const RecordVisitor  *visitor,
+                      const char           *segmentFileName);
+        // Decode, as for 'decodeImp', the segment file having the specified
+        // 'segmentFileName', rendering its records to the specified 'stream',
+        // or supplying them to the specified 'visitor'.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(BinaryLogDecoder,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit BinaryLogDecoder(bslma::Allocator *basicAllocator = 0);
+        // Create a decoder that renders records using a default-constructed
+        // 'RecordStringFormatter' (i.e., in the format used by the file
+        // observers, with timestamps in UTC).  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    explicit BinaryLogDecoder(
+                          const RecordStringFormatter&  formatter,
+                          bslma::Allocator             *basicAllocator = 0);
+        // Create a decoder that renders records using the specified
+        // 'formatter'.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+
+    //! ~BinaryLogDecoder() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    int decode(const RecordVisitor&  visitor,
+               const char           *data,
+               bsl::size_t           length);
+        // Invoke the specified 'visitor' with each record held by the segment
+        // having the specified 'data' of the specified 'length', in order.
+        // Return 0 on success, and a non-zero value if 'data' does not start
+        // with a segment header of a supported version, or if a malformed
+        // entry is found (in which case 'visitor' has been invoked with each
+        // record preceding that entry).  The record supplied to 'visitor' is
+        // valid only for the duration of the call.
+
+    int decode(bsl::ostream& stream, const char *data, bsl::size_t length);
+        // Write to the specified 'stream' the text rendering of each record
+        // held by the segment having the specified 'data' of the specified
+        // 'length', in order.  Return 0 on success, and a non-zero value if
+        // 'data' does not start with a segment header of a supported version,
+        // or if a malformed entry is found (in which case the records
+        // preceding that entry have been written to 'stream').
+
+    int decodeFile(const RecordVisitor& visitor, const char *segmentFileName);
+        // Invoke the specified 'visitor' with each record held by the segment
+        // file having the specified 'segmentFileName', in order.  Return 0 on
+        // success, and a non-zero value if the file cannot be read, or if the
+        // segment is not well-formed (see 'decode').
+
+    int decodeFile(bsl::ostream& stream, const char *segmentFileName);
+        // Write to the specified 'stream' the text rendering of each record
+        // held by the segment file having the specified 'segmentFileName', in
+        // order.  Return 0 on success, and a non-zero value if the file cannot
+        // be read, or if the segment is not well-formed (see 'decode').
+
+    // ACCESSORS
+    const RecordStringFormatter& formatter() const;
+        // Return a reference providing non-modifiable access to the formatter
+        // used by this decoder to render records as text.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                          // ----------------------
+                          // class BinaryLogDecoder
+                          // ----------------------
+
+// ACCESSORS
+inline
+const RecordStringFormatter& BinaryLogDecoder::formatter() const
+{
+    return d_formatter;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,997 @@
+// ball_binarylogdecoder.t.cpp                                        -*-C++-*-
+
+#include <ball_binarylogdecoder.h>
+
+#include <ball_binaryrecordutil.h>
+#include <ball_context.h>
+#include <ball_mappedfileobserver.h>
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_recordstringformatter.h>
+#include <ball_severity.h>
+#include <ball_transmission.h>
+#include <ball_userfields.h>
+
+#include <bdls_filesystemutil.h>
+#include <bdls_pathutil.h>
+
+#include <bdlt_datetime.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a mechanism that decodes binary log segments.
+// We build segments in memory using 'ball::BinaryRecordUtil', decode them, and
+// verify both the records supplied to a visitor and the text rendered to a
+// stream, which must be identical to that rendered by the formatter from the
+// original records.  We then verify that malformed segments are detected, and
+// that the records preceding a malformed entry are still delivered.  Finally,
+// we decode segment files written by 'ball::MappedFileObserver'.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit BinaryLogDecoder(bslma::Allocator *basicAllocator = 0);
+// [ 3] BinaryLogDecoder(const RecordStringFormatter&, Allocator *);
+//
+// MANIPULATORS
+// [ 2] int decode(const RecordVisitor& visitor, const char *, size_t);
+// [ 3] int decode(bsl::ostream& stream, const char *data, size_t length);
+// [ 5] int decodeFile(const RecordVisitor&, const char *segmentFileName);
+// [ 5] int decodeFile(bsl::ostream& stream, const char *segmentFileName);
+//
+// ACCESSORS
+// [ 3] const RecordStringFormatter& formatter() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] MALFORMED SEGMENTS
+// [ 6] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool             verbose;
+bool         veryVerbose;
+bool     veryVeryVerbose;
+bool veryVeryVeryVerbose;
+
+typedef ball::BinaryLogDecoder Obj;
+typedef ball::BinaryRecordUtil Util;
+typedef bdls::FilesystemUtil   FileUtil;
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+namespace {
+
+void makeRecord(ball::Record *record,
+                const char   *category,
+                const char   *fileName,
+                int           lineNumber,
+                const char   *message)
+    // Load into the specified 'record' a record having the specified
+    // 'category', 'fileName', 'lineNumber', and 'message', and a user field
+    // holding 'lineNumber'.
+{
+    ball::RecordAttributes& attributes = record->fixedFields();
+    attributes.setTimestamp(bdlt::Datetime(2018, 6, 7, 8, 9, 10, 11));
+    attributes.setProcessID(4321);
+    attributes.setThreadID(99);
+    attributes.setSeverity(ball::Severity::e_WARN);
+    attributes.setCategory(category);
+    attributes.setFileName(fileName);
+    attributes.setLineNumber(lineNumber);
+    attributes.setMessage(message);
+
+    record->customFields().removeAll();
+    record->customFields().appendInt64(lineNumber);
+}
+
+class SegmentBuilder {
+    // This class provides a mechanism for building a binary log segment in
+    // memory.
+
+    // DATA
+    bsl::vector<char> d_data;  // segment contents
+
+  public:
+    // CREATORS
+    explicit SegmentBuilder(bslma::Allocator *basicAllocator)
+        // Create a builder of a segment holding only a header, using the
+        // specified 'basicAllocator' to supply memory.
+    : d_data(Util::k_HEADER_SIZE, 0, basicAllocator)
+    {
+        Util::writeHeader(d_data.data());
+    }
+
+    // MANIPULATORS
+    void addString(int id, const char *value)
+        // Append to the segment a string entry defining the specified 'id' as
+        // the specified 'value'.
+    {
+        const bsl::size_t offset = d_data.size();
+        d_data.resize(offset + Util::stringEntrySize(value));
+        Util::writeStringEntry(d_data.data() + offset, id, value);
+    }
+
+    void addRecord(const ball::Record& record, int categoryId, int fileNameId)
+        // Append to the segment a record entry for the specified 'record',
+        // having the specified 'categoryId' and 'fileNameId'.
+    {
+        const bsl::size_t offset = d_data.size();
+        d_data.resize(offset + Util::recordEntrySize(record));
+        Util::writeRecordEntry(d_data.data() + offset,
+                               record,
+                               categoryId,
+                               fileNameId);
+    }
+
+    void addEndOfData()
+        // Append to the segment an end-of-data marker.
+    {
+        const bsl::size_t offset = d_data.size();
+        d_data.resize(offset + Util::k_FRAME_SIZE);
+        Util::writeEndOfData(d_data.data() + offset);
+    }
+
+    bsl::vector<char>& data()
+        // Return a reference providing modifiable access to the contents of
+        // the segment.
+    {
+        return d_data;
+    }
+};
+
+class RecordCollector {
+    // This class provides a function object appending each record with which
+    // it is invoked to a vector.
+
+    // DATA
+    bsl::vector<ball::Record> *d_records_p;  // collected records (held)
+
+  public:
+    // CREATORS
+    explicit RecordCollector(bsl::vector<ball::Record> *records)
+        // Create a collector appending to the specified 'records'.
+    : d_records_p(records)
+    {
+    }
+
+    // ACCESSORS
+    void operator()(const ball::Record& record) const
+        // Append the specified 'record' to the collected records.
+    {
+        d_records_p->push_back(record);
+    }
+};
+
+class TempDirectoryGuard {
+    // This class creates a temporary directory on construction, and removes
+    // it, along with its contents, on destruction.
+
+    // DATA
+    bsl::string d_dirName;  // name of the temporary directory
+
+    // NOT IMPLEMENTED
+    TempDirectoryGuard(const TempDirectoryGuard&);
+    TempDirectoryGuard& operator=(const TempDirectoryGuard&);
+
+  public:
+    // CREATORS
+    explicit TempDirectoryGuard(bslma::Allocator *basicAllocator)
+        // Create a temporary directory, using the specified 'basicAllocator'
+        // to supply memory.
+    : d_dirName(basicAllocator)
+    {
+        int rc = FileUtil::createTemporaryDirectory(&d_dirName,
+                                                    "ball_binarylogdecoder");
+        BSLS_ASSERT_OPT(0 == rc);
+    }
+
+    ~TempDirectoryGuard()
+        // Remove the temporary directory and its contents.
+    {
+        FileUtil::remove(d_dirName, true);
+    }
+
+    // ACCESSORS
+    bsl::string path(const char *fileName) const
+        // Return the path of the specified 'fileName' within the temporary
+        // directory.
+    {
+        bsl::string result(d_dirName);
+        bdls::PathUtil::appendRaw(&result, fileName);
+        return result;
+    }
+};
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+    bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+    bslma::TestAllocatorMonitor gam(&globalAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, replace 'assert' with
+        //:   'ASSERT', and insert 'if (veryVerbose)' before all output
+        //:   operations.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        // The example allocates from the default allocator.
+
+        bslma::TestAllocator         da("example", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        TempDirectoryGuard tempDir(&da);
+        const bsl::string  baseName = tempDir.path("server.log");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Rendering a Segment as Text
+///- - - - - - - - - - - - - - - - - - -
+// In this example, we render, as text, a segment that was written by a
+// 'ball::MappedFileObserver'.
+//
+// First, we publish a record to a segment file named by 'segmentName':
+//..
+    ball::MappedFileObserver observer;
+    observer.setSegmentSize(64 * 1024);
+    observer.enableFileLogging(baseName.c_str());
+
+    bsl::string segmentName;
+    observer.isFileLoggingEnabled(&segmentName);
+
+    ball::RecordAttributes attributes(bdlt::Datetime(2018, 5, 1, 12, 30),
+                                      1234,
+                                      5678,
+                                      "server.cpp",
+                                      42,
+                                      "SERVER",
+                                      ball::Severity::e_INFO,
+                                      "request complete");
+    observer.publish(ball::Record(attributes, ball::UserFields()),
+                     ball::Context(ball::Transmission::e_PASSTHROUGH, 0, 1));
+    observer.disableFileLogging();
+//..
+// Then, we create a decoder that renders records in a compact format:
+//..
+    ball::BinaryLogDecoder decoder(
+                        ball::RecordStringFormatter("%d %s %c %m\n"));
+//..
+// Finally, we decode the segment, and verify the rendered text:
+//..
+    bsl::ostringstream stream;
+
+    int rc = decoder.decodeFile(stream, segmentName.c_str());
+    ASSERT(0 == rc);
+    ASSERT("01MAY2018_12:30:00.000 INFO SERVER request complete\n"
+                                                              == stream.str());
+//..
+
+        if (veryVerbose) { P(stream.str()) }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // DECODING SEGMENT FILES
+        //
+        // Concerns:
+        //: 1 'decodeFile' decodes each record of a segment file written by a
+        //:   'ball::MappedFileObserver', including one that is still open.
+        //:
+        //: 2 The stream overload of 'decodeFile' renders the same text as the
+        //:   formatter does from the original records.
+        //:
+        //: 3 'decodeFile' returns a non-zero value for a file that does not
+        //:   exist, or is too short to hold a header.
+        //
+        // Plan:
+        //: 1 Publish records to a 'ball::MappedFileObserver', decode its
+        //:   segment with both overloads while file logging is enabled and
+        //:   after it is disabled, and verify the decoded records and text.
+        //:   (C-1..2)
+        //:
+        //: 2 Decode a file that does not exist, an empty file, and a file
+        //:   holding a truncated header.  (C-3)
+        //
+        // Testing:
+        //   int decodeFile(const RecordVisitor&, const char *segmentFileName);
+        //   int decodeFile(bsl::ostream& stream, const char *segmentFileName);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DECODING SEGMENT FILES" << endl
+                          << "======================" << endl;
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        TempDirectoryGuard tempDir(&ta);
+        const bsl::string  baseName = tempDir.path("segment");
+
+        const ball::Context CONTEXT(ball::Transmission::e_PASSTHROUGH, 0, 1);
+
+        ball::MappedFileObserver observer(&ta);
+        observer.setSegmentSize(64 * 1024);
+        ASSERT(0 == observer.enableFileLogging(baseName.c_str()));
+
+        bsl::string segmentName(&ta);
+        ASSERT(observer.isFileLoggingEnabled(&segmentName));
+
+        const ball::RecordStringFormatter formatter(&ta);
+
+        bsl::vector<ball::Record> expected(&ta);
+        bsl::ostringstream        expectedText(&ta);
+        for (int i = 0; i < 10; ++i) {
+            ball::Record record(&ta);
+            makeRecord(&record,
+                       i % 3 ? "CATEGORY" : "OTHER",
+                       "file.cpp",
+                       i,
+                       "message");
+            observer.publish(record, CONTEXT);
+            expected.push_back(record);
+            formatter(expectedText, record);
+        }
+
+        Obj mX(&ta);
+
+        for (int closed = 0; closed < 2; ++closed) {
+            if (closed) {
+                observer.disableFileLogging();
+            }
+
+            bsl::vector<ball::Record> records(&ta);
+            ASSERTV(closed, 0 == mX.decodeFile(RecordCollector(&records),
+                                               segmentName.c_str()));
+            ASSERTV(closed, expected == records);
+
+            bsl::ostringstream text(&ta);
+            ASSERTV(closed, 0 == mX.decodeFile(text, segmentName.c_str()));
+            ASSERTV(closed, expectedText.str() == text.str());
+        }
+
+        const bsl::string missing = tempDir.path("missing");
+        const bsl::string empty   = tempDir.path("empty");
+        const bsl::string short_  = tempDir.path("short");
+        {
+            FileUtil::FileDescriptor fd = FileUtil::open(
+                                                       empty,
+                                                       FileUtil::e_CREATE,
+                                                       FileUtil::e_WRITE_ONLY);
+            ASSERT(FileUtil::k_INVALID_FD != fd);
+            FileUtil::close(fd);
+
+            SegmentBuilder builder(&ta);
+            fd = FileUtil::open(short_,
+                                FileUtil::e_CREATE,
+                                FileUtil::e_WRITE_ONLY);
+            ASSERT(FileUtil::k_INVALID_FD != fd);
+            ASSERT(Util::k_HEADER_SIZE - 1 == FileUtil::write(
+                                                  fd,
+                                                  builder.data().data(),
+                                                  Util::k_HEADER_SIZE - 1));
+            FileUtil::close(fd);
+        }
+
+        bsl::ostringstream text(&ta);
+        ASSERT(0 != mX.decodeFile(text, missing.c_str()));
+        ASSERT(0 != mX.decodeFile(text, empty.c_str()));
+        ASSERT(0 != mX.decodeFile(text, short_.c_str()));
+        ASSERT(text.str().empty());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // MALFORMED SEGMENTS
+        //
+        // Concerns:
+        //: 1 Decoding fails, and no record is delivered, if the segment does
+        //:   not start with a header of a supported version.
+        //:
+        //: 2 Decoding fails if an entry is truncated, malformed, or refers to
+        //:   a string identifier not defined by the segment (including one
+        //:   defined only by a previously decoded segment).
+        //:
+        //: 3 The records preceding a malformed entry are delivered.
+        //:
+        //: 4 A segment lacking an end-of-data marker is decoded to its end.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Decode a segment having a corrupt magic number, and one having an
+        //:   unsupported version.  (C-1)
+        //:
+        //: 2 Build a segment holding two records, followed by a third
+        //:   record, and decode each prefix of the segment, verifying the
+        //:   status returned and the records delivered.  (C-2..4)
+        //:
+        //: 3 Decode a segment whose record refers to an undefined identifier,
+        //:   and one having a corrupt string entry.  (C-2..3)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   MALFORMED SEGMENTS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MALFORMED SEGMENTS" << endl
+                          << "==================" << endl;
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        Obj mX(&ta);
+
+        ball::Record record1(&ta);
+        ball::Record record2(&ta);
+        ball::Record record3(&ta);
+        makeRecord(&record1, "ONE", "one.cpp", 1, "first");
+        makeRecord(&record2, "ONE", "one.cpp", 2, "second");
+        makeRecord(&record3, "TWO", "one.cpp", 3, "third");
+
+        if (verbose) cout << "\tHeader." << endl;
+        {
+            for (int i = 0; i < 2; ++i) {
+                SegmentBuilder builder(&ta);
+                builder.addString(0, "ONE");
+                builder.addString(1, "one.cpp");
+                builder.addRecord(record1, 0, 1);
+                builder.addEndOfData();
+
+                // Corrupt the magic number, or the version (the last byte of
+                // the version field at offset 8).
+
+                builder.data()[i ? 11 : 0] ^= 0x40;
+
+                bsl::vector<ball::Record> records(&ta);
+                ASSERTV(i, 0 != mX.decode(RecordCollector(&records),
+                                          builder.data().data(),
+                                          builder.data().size()));
+                ASSERTV(i, records.empty());
+            }
+        }
+
+        if (verbose) cout << "\tTruncation." << endl;
+        {
+            // A segment truncated at the end of any entry is well-formed.
+
+            SegmentBuilder builder(&ta);
+            builder.addString(0, "ONE");
+            const bsl::size_t STR1 = builder.data().size();
+            builder.addString(1, "one.cpp");
+            const bsl::size_t STR2 = builder.data().size();
+            builder.addRecord(record1, 0, 1);
+            const bsl::size_t END1 = builder.data().size();
+            builder.addRecord(record2, 0, 1);
+            const bsl::size_t END2 = builder.data().size();
+            builder.addString(2, "TWO");
+            const bsl::size_t STR3 = builder.data().size();
+            builder.addRecord(record3, 2, 1);
+            const bsl::size_t END3 = builder.data().size();
+
+            for (bsl::size_t len = 0; len <= END3; ++len) {
+                bsl::vector<ball::Record> records(&ta);
+                const int rc = mX.decode(RecordCollector(&records),
+                                         builder.data().data(),
+                                         len);
+
+                const bool        complete   = len == Util::k_HEADER_SIZE
+                                            || len == STR1
+                                            || len == STR2
+                                            || len == STR3
+                                            || len == END1
+                                            || len == END2
+                                            || len == END3;
+                const bsl::size_t numRecords = len < Util::k_HEADER_SIZE
+                                             ? 0
+                                             : len < END1 ? 0
+                                             : len < END2 ? 1
+                                             : len < END3 ? 2
+                                             : 3;
+
+                if (veryVerbose) { T_ P_(len) P_(rc) P(records.size()) }
+
+                ASSERTV(len, rc, complete == (0 == rc));
+                ASSERTV(len, records.size(), numRecords == records.size());
+                if (0 < records.size()) {
+                    ASSERTV(len, record1 == records[0]);
+                }
+                if (1 < records.size()) {
+                    ASSERTV(len, record2 == records[1]);
+                }
+                if (2 < records.size()) {
+                    ASSERTV(len, record3 == records[2]);
+                }
+            }
+        }
+
+        if (verbose) cout << "\tUndefined identifiers." << endl;
+        {
+            // Identifiers defined by a previously decoded segment are not
+            // retained.
+
+            SegmentBuilder first(&ta);
+            first.addString(0, "ONE");
+            first.addString(1, "one.cpp");
+            first.addString(2, "TWO");
+            first.addRecord(record1, 0, 1);
+
+            bsl::vector<ball::Record> records(&ta);
+            ASSERT(0 == mX.decode(RecordCollector(&records),
+                                  first.data().data(),
+                                  first.data().size()));
+            ASSERT(1 == records.size());
+
+            SegmentBuilder second(&ta);
+            second.addString(0, "ONE");
+            second.addString(1, "one.cpp");
+            second.addRecord(record1, 0, 1);
+            second.addRecord(record3, 2, 1);
+            second.addEndOfData();
+
+            records.clear();
+            bsl::ostringstream text(&ta);
+            ASSERT(0 != mX.decode(RecordCollector(&records),
+                                  second.data().data(),
+                                  second.data().size()));
+            ASSERT(0 != mX.decode(text,
+                                  second.data().data(),
+                                  second.data().size()));
+            ASSERT(1       == records.size());
+            ASSERT(record1 == records[0]);
+
+            bsl::ostringstream expected(&ta);
+            mX.formatter()(expected, record1);
+            ASSERT(expected.str() == text.str());
+        }
+
+        if (verbose) cout << "\tCorrupt string entry." << endl;
+        {
+            SegmentBuilder builder(&ta);
+            builder.addString(0, "ONE");
+            builder.addString(1, "one.cpp");
+            builder.addRecord(record1, 0, 1);
+            builder.addEndOfData();
+
+            // Shorten the payload of the first string entry to its type byte,
+            // so that it no longer holds an identifier.
+
+            bsl::vector<char>& data = builder.data();
+            data[Util::k_HEADER_SIZE + 1] = 0;
+            data[Util::k_HEADER_SIZE + 2] = 0;
+            data[Util::k_HEADER_SIZE + 3] = 1;
+
+            bsl::vector<ball::Record> records(&ta);
+            ASSERT(0 != mX.decode(RecordCollector(&records),
+                                  data.data(),
+                                  data.size()));
+            ASSERT(records.empty());
+        }
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            SegmentBuilder builder(&ta);
+            bsl::ostringstream text(&ta);
+
+            ASSERT_PASS(mX.decode(text, builder.data().data(), 0));
+            ASSERT_PASS(mX.decode(text, 0, 0));
+            ASSERT_FAIL(mX.decode(text, 0, Util::k_HEADER_SIZE));
+
+            ASSERT_FAIL(mX.decodeFile(text, 0));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // RENDERING AS TEXT
+        //
+        // Concerns:
+        //: 1 The text rendered for each record of a segment is identical to
+        //:   that rendered by the decoder's formatter from the original
+        //:   record, in the order of the records.
+        //:
+        //: 2 A default-constructed decoder renders records in the format used
+        //:   by the file observers, in UTC.
+        //:
+        //: 3 A decoder constructed with a formatter uses (a copy of) that
+        //:   formatter, accessible by 'formatter'.
+        //:
+        //: 4 All memory is supplied by the object allocator.
+        //
+        // Plan:
+        //: 1 For each of a set of format specifications, create a decoder
+        //:   having a formatter with that specification, and decode, to a
+        //:   stream, a segment holding several records, comparing the text
+        //:   rendered with that rendered from the records by a formatter
+        //:   having the same specification.  (C-1, 3..4)
+        //:
+        //: 2 Verify the format specification and timezone offset of the
+        //:   formatter of a default-constructed decoder.  (C-2)
+        //
+        // Testing:
+        //   BinaryLogDecoder(const RecordStringFormatter&, Allocator *);
+        //   int decode(bsl::ostream& stream, const char *data, size_t length);
+        //   const RecordStringFormatter& formatter() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RENDERING AS TEXT" << endl
+                          << "=================" << endl;
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            const ball::RecordStringFormatter DEFAULT(&ta);
+            ASSERT(0 == bsl::strcmp(DEFAULT.format(), X.formatter().format()));
+            ASSERT(DEFAULT.timestampOffset() ==
+                                             X.formatter().timestampOffset());
+            ASSERT(0 == bsl::strcmp("\n%d %p:%t %s %f:%l %c %m %u\n",
+                                   X.formatter().format()));
+        }
+
+        static const struct {
+            int         d_line;
+            const char *d_format;
+        } DATA[] = {
+            //LINE  FORMAT
+            //----  ---------------------------------
+            { L_,   "\n%d %p:%t %s %f:%l %c %m %u\n"  },
+            { L_,   "%d %s %c %m\n"                   },
+            { L_,   "%I %F:%l %m %u\n"                },
+            { L_,   ""                                },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        ball::Record record1(&ta);
+        ball::Record record2(&ta);
+        ball::Record record3(&ta);
+        makeRecord(&record1, "ONE", "dir/one.cpp", 1, "first");
+        makeRecord(&record2, "TWO", "dir/one.cpp", 2, "second");
+        makeRecord(&record3, "ONE", "two.cpp",     3, "");
+
+        SegmentBuilder builder(&ta);
+        builder.addString(0, "ONE");
+        builder.addString(1, "dir/one.cpp");
+        builder.addRecord(record1, 0, 1);
+        builder.addString(2, "TWO");
+        builder.addRecord(record2, 2, 1);
+        builder.addString(3, "two.cpp");
+        builder.addRecord(record3, 0, 3);
+        builder.addEndOfData();
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE   = DATA[ti].d_line;
+            const char *FORMAT = DATA[ti].d_format;
+
+            const ball::RecordStringFormatter formatter(FORMAT, &ta);
+
+            bsl::ostringstream expected(&ta);
+            formatter(expected, record1);
+            formatter(expected, record2);
+            formatter(expected, record3);
+
+            bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+            Obj mX(formatter, &oa);  const Obj& X = mX;
+            ASSERTV(LINE, 0 == bsl::strcmp(FORMAT, X.formatter().format()));
+
+            bsl::ostringstream text(&ta);
+            ASSERTV(LINE, 0 == mX.decode(text,
+                                         builder.data().data(),
+                                         builder.data().size()));
+
+            if (veryVerbose) { T_ P_(LINE) P(text.str()) }
+
+            ASSERTV(LINE, expected.str() == text.str());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // DECODING TO A VISITOR
+        //
+        // Concerns:
+        //: 1 The visitor is invoked with each record of a segment, in order,
+        //:   with its category and file name resolved from the string entries
+        //:   of the segment.
+        //:
+        //: 2 Decoding stops at the end-of-data marker.
+        //:
+        //: 3 A segment holding no record is decoded successfully, without
+        //:   invoking the visitor.
+        //:
+        //: 4 A decoder can be reused to decode successive segments.
+        //:
+        //: 5 All memory is supplied by the object allocator.
+        //
+        // Plan:
+        //: 1 Build segments holding sequences of records, sharing and
+        //:   interleaving string entries, followed by an end-of-data marker
+        //:   and further (unused) bytes, decode them with a single decoder,
+        //:   and compare the records collected by the visitor with the
+        //:   originals.  (C-1..5)
+        //
+        // Testing:
+        //   explicit BinaryLogDecoder(bslma::Allocator *basicAllocator = 0);
+        //   int decode(const RecordVisitor& visitor, const char *, size_t);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DECODING TO A VISITOR" << endl
+                          << "=====================" << endl;
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        bslma::TestAllocator oa("object", veryVeryVeryVerbose);
+
+        Obj mX(&oa);
+
+        for (int numRecords = 0; numRecords < 8; ++numRecords) {
+            static const char *const CATEGORIES[] = { "A", "B", "C" };
+            static const char *const FILES[]      = { "a.cpp", "b.cpp" };
+
+            SegmentBuilder            builder(&ta);
+            bsl::vector<ball::Record> expected(&ta);
+
+            // Category 'i' has identifier 'i', and file 'j' has identifier
+            // '10 + j'; each is defined before its first use.
+
+            bool defined[13] = { false };
+            for (int i = 0; i < numRecords; ++i) {
+                const int category = (i * 7 + numRecords) % 3;
+                const int file     = (i + numRecords) % 2;
+
+                if (!defined[category]) {
+                    builder.addString(category, CATEGORIES[category]);
+                    defined[category] = true;
+                }
+                if (!defined[10 + file]) {
+                    builder.addString(10 + file, FILES[file]);
+                    defined[10 + file] = true;
+                }
+
+                ball::Record record(&ta);
+                makeRecord(&record,
+                           CATEGORIES[category],
+                           FILES[file],
+                           i,
+                           "message");
+                builder.addRecord(record, category, 10 + file);
+                expected.push_back(record);
+            }
+            builder.addEndOfData();
+
+            // Bytes following the marker are not decoded.
+
+            builder.data().resize(builder.data().size() + 64, 'x');
+
+            bsl::vector<ball::Record> records(&ta);
+            ASSERTV(numRecords, 0 == mX.decode(RecordCollector(&records),
+                                               builder.data().data(),
+                                               builder.data().size()));
+            ASSERTV(numRecords, expected == records);
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Build a segment holding a record, and decode it both to a visitor
+        //:   and to a stream.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        ball::Record record(&ta);
+        makeRecord(&record, "BREATHING", "breathing.cpp", 7, "hello");
+
+        SegmentBuilder builder(&ta);
+        builder.addString(0, "BREATHING");
+        builder.addString(1, "breathing.cpp");
+        builder.addRecord(record, 0, 1);
+        builder.addEndOfData();
+
+        Obj mX(&ta);
+
+        bsl::vector<ball::Record> records(&ta);
+        ASSERT(0 == mX.decode(RecordCollector(&records),
+                              builder.data().data(),
+                              builder.data().size()));
+        ASSERT(1      == records.size());
+        ASSERT(record == records[0]);
+
+        bsl::ostringstream expected(&ta);
+        const ball::RecordStringFormatter formatter(&ta);
+        formatter(expected, record);
+
+        bsl::ostringstream text(&ta);
+        ASSERT(0 == mX.decode(text,
+                              builder.data().data(),
+                              builder.data().size()));
+        ASSERT(expected.str() == text.str());
+
+        if (veryVerbose) { P(text.str()) }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (test >= 0) {
+        // CONCERN: In no case does memory come from the default allocator.
+
+        ASSERT(dam.isTotalSame());
+
+        // CONCERN: In no case does memory come from the global allocator.
+
+        ASSERT(gam.isTotalSame());
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
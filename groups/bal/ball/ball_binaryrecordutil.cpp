@@ -0,0 +1,577 @@
+// ball_binaryrecordutil.cpp                                          -*-C++-*-
+#include <ball_binaryrecordutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_binaryrecordutil_cpp,"$Id$ $CSID$")
+
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_userfields.h>
+#include <ball_userfieldtype.h>
+#include <ball_userfieldvalue.h>
+
+#include <bdlt_datetime.h>
+#include <bdlt_datetimeinterval.h>
+#include <bdlt_datetimetz.h>
+
+#include <bslx_marshallingutil.h>
+
+#include <bsls_assert.h>
+#include <bsls_types.h>
+
+#include <bsl_cstring.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace ball {
+
+namespace {
+
+typedef bslx::MarshallingUtil MU;
+
+const char k_MAGIC[8] = { 'B', 'A', 'L', 'L', 'B', 'I', 'N', 'L' };
+
+enum {
+    k_TYPE_SIZE        = MU::k_SIZEOF_INT8,
+    k_RECORD_HEADER    = k_TYPE_SIZE
+                       + MU::k_SIZEOF_INT64     // timestamp
+                       + MU::k_SIZEOF_INT32     // process id
+                       + MU::k_SIZEOF_INT64     // thread id
+                       + MU::k_SIZEOF_INT32     // severity
+                       + MU::k_SIZEOF_INT32     // category id
+                       + MU::k_SIZEOF_INT32     // file name id
+                       + MU::k_SIZEOF_INT32     // line number
+                       + MU::k_SIZEOF_INT32     // message length
+                       + MU::k_SIZEOF_INT32     // number of user fields
+};
+
+inline
+bsls::Types::Int64 toMicroseconds(const bdlt::Datetime& datetime)
+    // Return the number of microseconds from '0001/01/01_00:00:00.000000' to
+    // the specified 'datetime'.
+{
+    return (datetime - bdlt::Datetime(1, 1, 1)).totalMicroseconds();
+}
+
+inline
+int fromMicroseconds(bdlt::Datetime *result, bsls::Types::Int64 value)
+    // Load into the specified 'result' the datetime the specified 'value'
+    // microseconds after '0001/01/01_00:00:00.000000'.  Return 0 on success,
+    // and a non-zero value if 'value' does not identify a valid datetime.
+{
+    if (value < 0) {
+        return -1;                                                    // RETURN
+    }
+    *result = bdlt::Datetime(1, 1, 1);
+    return result->addMicrosecondsIfValid(value);
+}
+
+inline
+char *putInt8(char *buffer, int value)
+    // Write the specified 'value' to the specified 'buffer' as a one-byte
+    // integer, and return the address one past the last byte written.
+{
+    MU::putInt8(buffer, value);
+    return buffer + MU::k_SIZEOF_INT8;
+}
+
+inline
+char *putInt32(char *buffer, int value)
+    // Write the specified 'value' to the specified 'buffer' as a four-byte
+    // integer, and return the address one past the last byte written.
+{
+    MU::putInt32(buffer, value);
+    return buffer + MU::k_SIZEOF_INT32;
+}
+
+inline
+char *putInt64(char *buffer, bsls::Types::Int64 value)
+    // Write the specified 'value' to the specified 'buffer' as an eight-byte
+    // integer, and return the address one past the last byte written.
+{
+    MU::putInt64(buffer, value);
+    return buffer + MU::k_SIZEOF_INT64;
+}
+
+inline
+char *putBytes(char *buffer, const char *data, bsl::size_t length)
+    // Write the specified 'length' as a four-byte integer to the specified
+    // 'buffer', followed by the specified 'length' bytes of 'data', and
+    // return the address one past the last byte written.
+{
+    buffer = putInt32(buffer, static_cast<int>(length));
+    if (length) {
+        bsl::memcpy(buffer, data, length);
+    }
+    return buffer + length;
+}
+
+bsl::size_t userFieldSize(const UserFieldValue& value)
+    // Return the number of bytes used to encode the specified 'value'.
+{
+    switch (value.type()) {
+      case UserFieldType::e_INT64:
+      case UserFieldType::e_DOUBLE: {
+        return k_TYPE_SIZE + MU::k_SIZEOF_INT64;                      // RETURN
+      }
+      case UserFieldType::e_STRING: {
+        return k_TYPE_SIZE + MU::k_SIZEOF_INT32
+                           + value.theString().length();              // RETURN
+      }
+      case UserFieldType::e_DATETIMETZ: {
+        return k_TYPE_SIZE + MU::k_SIZEOF_INT64
+                           + MU::k_SIZEOF_INT32;                      // RETURN
+      }
+      case UserFieldType::e_CHAR_ARRAY: {
+        return k_TYPE_SIZE + MU::k_SIZEOF_INT32
+                           + value.theCharArray().size();             // RETURN
+      }
+      default: {
+        return k_TYPE_SIZE;                                           // RETURN
+      }
+    }
+}
+
+char *putUserField(char *buffer, const UserFieldValue& value)
+    // Write the specified 'value' to the specified 'buffer', and return the
+    // address one past the last byte written.
+{
+    buffer = putInt8(buffer, value.type());
+
+    switch (value.type()) {
+      case UserFieldType::e_INT64: {
+        buffer = putInt64(buffer, value.theInt64());
+      } break;
+      case UserFieldType::e_DOUBLE: {
+        MU::putFloat64(buffer, value.theDouble());
+        buffer += MU::k_SIZEOF_FLOAT64;
+      } break;
+      case UserFieldType::e_STRING: {
+        const bsl::string& string = value.theString();
+        buffer = putBytes(buffer, string.data(), string.length());
+      } break;
+      case UserFieldType::e_DATETIMETZ: {
+        const bdlt::DatetimeTz& datetimeTz = value.theDatetimeTz();
+        buffer = putInt64(buffer,
+                          toMicroseconds(datetimeTz.localDatetime()));
+        buffer = putInt32(buffer, datetimeTz.offset());
+      } break;
+      case UserFieldType::e_CHAR_ARRAY: {
+        const bsl::vector<char>& array = value.theCharArray();
+        buffer = putBytes(buffer,
+                          array.empty() ? 0 : &array.front(),
+                          array.size());
+      } break;
+      default: {
+      } break;
+    }
+    return buffer;
+}
+
+class PayloadReader {
+    // This class provides a bounds-checked cursor over the payload of an
+    // entry.  Each 'get' method fails (returning a non-zero value, and
+    // leaving the cursor unchanged) if fewer bytes remain than are required.
+
+    // DATA
+    const char *d_position_p;  // next byte to read
+    const char *d_end_p;       // one past the last byte of the payload
+
+  public:
+    // CREATORS
+    PayloadReader(const char *payload, int length)
+        // Create a reader of the specified 'length' bytes of 'payload'.
+    : d_position_p(payload)
+    , d_end_p(payload + length)
+    {
+    }
+
+    // MANIPULATORS
+    int getInt8(int *value)
+        // Load a one-byte integer into the specified 'value'.
+    {
+        if (d_end_p - d_position_p < MU::k_SIZEOF_INT8) {
+            return -1;                                                // RETURN
+        }
+        signed char result;
+        MU::getInt8(&result, d_position_p);
+        *value = result;
+        d_position_p += MU::k_SIZEOF_INT8;
+        return 0;
+    }
+
+    int getInt32(int *value)
+        // Load a four-byte integer into the specified 'value'.
+    {
+        if (d_end_p - d_position_p < MU::k_SIZEOF_INT32) {
+            return -1;                                                // RETURN
+        }
+        MU::getInt32(value, d_position_p);
+        d_position_p += MU::k_SIZEOF_INT32;
+        return 0;
+    }
+
+    int getInt64(bsls::Types::Int64 *value)
+        // Load an eight-byte integer into the specified 'value'.
+    {
+        if (d_end_p - d_position_p < MU::k_SIZEOF_INT64) {
+            return -1;                                                // RETURN
+        }
+        MU::getInt64(value, d_position_p);
+        d_position_p += MU::k_SIZEOF_INT64;
+        return 0;
+    }
+
+    int getFloat64(double *value)
+        // Load an eight-byte floating-point number into the specified
+        // 'value'.
+    {
+        if (d_end_p - d_position_p < MU::k_SIZEOF_FLOAT64) {
+            return -1;                                                // RETURN
+        }
+        MU::getFloat64(value, d_position_p);
+        d_position_p += MU::k_SIZEOF_FLOAT64;
+        return 0;
+    }
+
+    int getBytes(bslstl::StringRef *value)
+        // Load into the specified 'value' a reference to a sequence of bytes
+        // preceded by its four-byte length.
+    {
+        int length;
+        if (0 != getInt32(&length)) {
+            return -1;                                                // RETURN
+        }
+        if (length < 0 || d_end_p - d_position_p < length) {
+            d_position_p -= MU::k_SIZEOF_INT32;
+            return -1;                                                // RETURN
+        }
+        value->assign(d_position_p, length);
+        d_position_p += length;
+        return 0;
+    }
+
+    // ACCESSORS
+    int remaining() const
+        // Return the number of unread bytes.
+    {
+        return static_cast<int>(d_end_p - d_position_p);
+    }
+
+    const char *position() const
+        // Return the address of the next unread byte.
+    {
+        return d_position_p;
+    }
+};
+
+int getUserField(UserFields *fields, PayloadReader *reader)
+    // Append to the specified 'fields' the user field read by the specified
+    // 'reader'.  Return 0 on success, and a non-zero value otherwise.
+{
+    int type;
+    if (0 != reader->getInt8(&type)) {
+        return -1;                                                    // RETURN
+    }
+
+    switch (type) {
+      case UserFieldType::e_VOID: {
+        fields->appendNull();
+      } break;
+      case UserFieldType::e_INT64: {
+        bsls::Types::Int64 value;
+        if (0 != reader->getInt64(&value)) {
+            return -1;                                                // RETURN
+        }
+        fields->appendInt64(value);
+      } break;
+      case UserFieldType::e_DOUBLE: {
+        double value;
+        if (0 != reader->getFloat64(&value)) {
+            return -1;                                                // RETURN
+        }
+        fields->appendDouble(value);
+      } break;
+      case UserFieldType::e_STRING: {
+        bslstl::StringRef value;
+        if (0 != reader->getBytes(&value)) {
+            return -1;                                                // RETURN
+        }
+        fields->appendString(value);
+      } break;
+      case UserFieldType::e_DATETIMETZ: {
+        bsls::Types::Int64 localTime;
+        int                offset;
+        bdlt::Datetime     datetime;
+        if (0 != reader->getInt64(&localTime)
+         || 0 != reader->getInt32(&offset)
+         || 0 != fromMicroseconds(&datetime, localTime)
+         || !bdlt::DatetimeTz::isValid(datetime, offset)) {
+            return -1;                                                // RETURN
+        }
+        fields->appendDatetimeTz(bdlt::DatetimeTz(datetime, offset));
+      } break;
+      case UserFieldType::e_CHAR_ARRAY: {
+        bslstl::StringRef value;
+        if (0 != reader->getBytes(&value)) {
+            return -1;                                                // RETURN
+        }
+        fields->appendCharArray(bsl::vector<char>(value.begin(),
+                                                  value.end(),
+                                                  fields->allocator()));
+      } break;
+      default: {
+        return -1;                                                    // RETURN
+      }
+    }
+    return 0;
+}
+
+}  // close unnamed namespace
+
+                          // -----------------------
+                          // struct BinaryRecordUtil
+                          // -----------------------
+
+// CLASS METHODS
+void BinaryRecordUtil::writeHeader(char *buffer)
+{
+    BSLS_ASSERT(buffer);
+
+    bsl::memcpy(buffer, k_MAGIC, sizeof k_MAGIC);
+    MU::putInt32(buffer + sizeof k_MAGIC, k_VERSION);
+    MU::putInt32(buffer + sizeof k_MAGIC + MU::k_SIZEOF_INT32, 0);
+}
+
+int BinaryRecordUtil::readHeader(int         *version,
+                                 const char  *buffer,
+                                 bsl::size_t  length)
+{
+    BSLS_ASSERT(version);
+    BSLS_ASSERT(buffer || 0 == length);
+
+    if (length < k_HEADER_SIZE
+     || 0 != bsl::memcmp(buffer, k_MAGIC, sizeof k_MAGIC)) {
+        return -1;                                                    // RETURN
+    }
+    MU::getInt32(version, buffer + sizeof k_MAGIC);
+    return 0;
+}
+
+void BinaryRecordUtil::writeEndOfData(char *buffer)
+{
+    BSLS_ASSERT(buffer);
+
+    MU::putInt32(buffer, 0);
+}
+
+bsl::size_t BinaryRecordUtil::stringEntrySize(const bslstl::StringRef& value)
+{
+    return k_FRAME_SIZE + k_TYPE_SIZE + MU::k_SIZEOF_INT32 + value.length();
+}
+
+char *BinaryRecordUtil::writeStringEntry(char                     *buffer,
+                                         int                       id,
+                                         const bslstl::StringRef&  value)
+{
+    BSLS_ASSERT(buffer);
+
+    const int payloadLength = static_cast<int>(stringEntrySize(value))
+                            - k_FRAME_SIZE;
+
+    buffer = putInt32(buffer, payloadLength);
+    buffer = putInt8(buffer, e_STRING_ENTRY);
+    buffer = putInt32(buffer, id);
+    if (value.length()) {
+        bsl::memcpy(buffer, value.data(), value.length());
+    }
+    return buffer + value.length();
+}
+
+bsl::size_t BinaryRecordUtil::recordEntrySize(const Record& record)
+{
+    bsl::size_t size = k_FRAME_SIZE
+                     + k_RECORD_HEADER
+                     + record.fixedFields().messageRef().length();
+
+    const UserFields& fields = record.customFields();
+    for (int i = 0; i < fields.length(); ++i) {
+        size += userFieldSize(fields[i]);
+    }
+    return size;
+}
+
+char *BinaryRecordUtil::writeRecordEntry(char          *buffer,
+                                         const Record&  record,
+                                         int            categoryId,
+                                         int            fileNameId)
+{
+    BSLS_ASSERT(buffer);
+
+    const RecordAttributes& attributes = record.fixedFields();
+    const bslstl::StringRef message    = attributes.messageRef();
+    const UserFields&       fields     = record.customFields();
+
+    const int payloadLength = static_cast<int>(recordEntrySize(record))
+                            - k_FRAME_SIZE;
+
+    buffer = putInt32(buffer, payloadLength);
+    buffer = putInt8(buffer, e_RECORD_ENTRY);
+    buffer = putInt64(buffer, toMicroseconds(attributes.timestamp()));
+    buffer = putInt32(buffer, attributes.processID());
+    buffer = putInt64(buffer,
+                      static_cast<bsls::Types::Int64>(attributes.threadID()));
+    buffer = putInt32(buffer, attributes.severity());
+    buffer = putInt32(buffer, categoryId);
+    buffer = putInt32(buffer, fileNameId);
+    buffer = putInt32(buffer, attributes.lineNumber());
+    buffer = putBytes(buffer, message.data(), message.length());
+    buffer = putInt32(buffer, fields.length());
+    for (int i = 0; i < fields.length(); ++i) {
+        buffer = putUserField(buffer, fields[i]);
+    }
+    return buffer;
+}
+
+int BinaryRecordUtil::readEntry(EntryType   *type,
+                                const char **payload,
+                                int         *payloadLength,
+                                const char **position,
+                                const char  *end)
+{
+    BSLS_ASSERT(type);
+    BSLS_ASSERT(payload);
+    BSLS_ASSERT(payloadLength);
+    BSLS_ASSERT(position);
+    BSLS_ASSERT(*position <= end);
+
+    const char *cursor = *position;
+    if (end == cursor) {
+        return 1;                                                     // RETURN
+    }
+    if (end - cursor < k_FRAME_SIZE) {
+        return -1;                                                    // RETURN
+    }
+
+    int length;
+    MU::getInt32(&length, cursor);
+    if (0 == length) {
+        return 1;                                                     // RETURN
+    }
+
+    cursor += k_FRAME_SIZE;
+    if (length < k_TYPE_SIZE || end - cursor < length) {
+        return -1;                                                    // RETURN
+    }
+
+    signed char entryType;
+    MU::getInt8(&entryType, cursor);
+    if (e_STRING_ENTRY != entryType && e_RECORD_ENTRY != entryType) {
+        return -2;                                                    // RETURN
+    }
+
+    *type          = static_cast<EntryType>(entryType);
+    *payload       = cursor;
+    *payloadLength = length;
+    *position      = cursor + length;
+    return 0;
+}
+
+int BinaryRecordUtil::decodeStringEntry(int               *id,
+                                        bslstl::StringRef *value,
+                                        const char        *payload,
+                                        int                payloadLength)
+{
+    BSLS_ASSERT(id);
+    BSLS_ASSERT(value);
+    BSLS_ASSERT(payload);
+
+    PayloadReader reader(payload, payloadLength);
+
+    int type;
+    if (0 != reader.getInt8(&type)
+     || e_STRING_ENTRY != type
+     || 0 != reader.getInt32(id)) {
+        return -1;                                                    // RETURN
+    }
+    value->assign(reader.position(), reader.remaining());
+    return 0;
+}
+
+int BinaryRecordUtil::decodeRecordEntry(Record     *record,
+                                        int        *categoryId,
+                                        int        *fileNameId,
+                                        const char *payload,
+                                        int         payloadLength)
+{
+    BSLS_ASSERT(record);
+    BSLS_ASSERT(categoryId);
+    BSLS_ASSERT(fileNameId);
+    BSLS_ASSERT(payload);
+
+    PayloadReader reader(payload, payloadLength);
+
+    int                type;
+    bsls::Types::Int64 timestamp;
+    int                processId;
+    bsls::Types::Int64 threadId;
+    int                severity;
+    int                lineNumber;
+    bslstl::StringRef  message;
+    int                numFields;
+    bdlt::Datetime     datetime;
+
+    if (0 != reader.getInt8(&type)
+     || e_RECORD_ENTRY != type
+     || 0 != reader.getInt64(&timestamp)
+     || 0 != reader.getInt32(&processId)
+     || 0 != reader.getInt64(&threadId)
+     || 0 != reader.getInt32(&severity)
+     || 0 != reader.getInt32(categoryId)
+     || 0 != reader.getInt32(fileNameId)
+     || 0 != reader.getInt32(&lineNumber)
+     || 0 != reader.getBytes(&message)
+     || 0 != reader.getInt32(&numFields)
+     || numFields < 0
+     || 0 != fromMicroseconds(&datetime, timestamp)) {
+        return -1;                                                    // RETURN
+    }
+
+    RecordAttributes& attributes = record->fixedFields();
+    attributes.setTimestamp(datetime);
+    attributes.setProcessID(processId);
+    attributes.setThreadID(static_cast<bsls::Types::Uint64>(threadId));
+    attributes.setSeverity(severity);
+    attributes.setLineNumber(lineNumber);
+    attributes.clearMessage();
+    attributes.messageStreamBuf().sputn(message.data(), message.length());
+
+    UserFields& fields = record->customFields();
+    fields.removeAll();
+    for (int i = 0; i < numFields; ++i) {
+        if (0 != getUserField(&fields, &reader)) {
+            return -1;                                                // RETURN
+        }
+    }
+
+    return 0 == reader.remaining() ? 0 : -1;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
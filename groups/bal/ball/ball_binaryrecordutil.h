@@ -0,0 +1,328 @@
+// ball_binaryrecordutil.h                                            -*-C++-*-
+#ifndef INCLUDED_BALL_BINARYRECORDUTIL
+#define INCLUDED_BALL_BINARYRECORDUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide utilities to encode and decode log records in binary form.
+//
+//@CLASSES:
+//  ball::BinaryRecordUtil: namespace for binary log record encoding functions
+//
+//@SEE_ALSO: ball_mappedfileobserver, ball_binarylogdecoder, ball_record
+//
+//@DESCRIPTION: This component provides a namespace, 'ball::BinaryRecordUtil',
+// for functions that write log records (i.e., 'ball::Record' objects) into,
+// and read them back from, a compact binary representation.  Rendering a
+// record as text (see 'ball_recordstringformatter') typically dominates the
+// cost of publishing it to a file; encoding a record in binary form instead
+// costs little more than copying its message, and the text rendering can be
+// produced later, offline (see 'ball_binarylogdecoder').
+//
+///Binary Log Format
+///-----------------
+// A binary log *segment* is a sequence of bytes consisting of a fixed-size
+// header followed by a sequence of *entries*, terminated either by the end of
+// the segment or by an entry length of 0.  All integral values are written in
+// network byte order (see 'bslx_marshallingutil'), so that segments may be
+// decoded on a platform other than the one on which they were written.
+//
+// The segment header has the following layout:
+//..
+//  Offset  Size  Contents
+//  ------  ----  ---------------------------------------------------------
+//       0     8  magic characters "BALLBINL"
+//       8     4  format version ('k_VERSION')
+//      12     4  reserved (0)
+//..
+// Each entry consists of a 4-byte payload length (which is not 0) followed by
+// the payload, whose first byte identifies the type of the entry.  There are
+// two types of entries:
+//
+//: 'e_STRING': defines an identifier for a string (the category name or the
+//:   file name of a record), so that each distinct string is written to a
+//:   segment only once.  The payload is the type byte, the 4-byte identifier,
+//:   and the characters of the string (which is not null-terminated).
+//:
+//: 'e_RECORD': a log record.  The payload is the type byte followed by:
+//..
+//  Size  Contents
+//  ----  -------------------------------------------------------------------
+//     8  timestamp (microseconds since '0001/01/01_00:00:00.000000')
+//     4  process id
+//     8  thread id
+//     4  severity
+//     4  identifier of the category name (an 'e_STRING' entry)
+//     4  identifier of the file name (an 'e_STRING' entry)
+//     4  line number
+//     4  message length, 'n'
+//     n  message characters
+//     4  number of user fields
+//     *  user fields, each a 1-byte 'ball::UserFieldType' followed by the
+//        value: 8 bytes for 'e_INT64' and 'e_DOUBLE'; 8 bytes (local
+//        datetime, as for the timestamp) and a 4-byte offset (in minutes)
+//        for 'e_DATETIMETZ'; a 4-byte length and the characters for
+//        'e_STRING' and 'e_CHAR_ARRAY'; nothing for 'e_VOID'
+//..
+// An 'e_STRING' entry always precedes the first 'e_RECORD' entry that refers
+// to its identifier.  The assignment of identifiers to strings is left to the
+// writer of a segment (see 'ball_mappedfileobserver'), and the association of
+// identifiers with strings to the reader (see 'ball_binarylogdecoder').
+//
+// The functions in this component write entries into, and read them from,
+// caller-supplied memory, and do not allocate memory.  A writer first
+// computes the size of an entry (e.g., 'recordEntrySize'), obtains that many
+// bytes of contiguous storage (e.g., within a memory-mapped file), and then
+// writes the entry (e.g., 'writeRecordEntry').
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Encoding and Decoding a Record
+///- - - - - - - - - - - - - - - - - - - - -
+// In this example we encode a record, along with the strings it refers to,
+// into a segment in memory, and then decode the segment.
+//
+// First, we create the record to be encoded:
+//..
+//  ball::RecordAttributes attributes(bdlt::Datetime(2018, 5, 1, 12, 30),
+//                                    1234,
+//                                    5678,
+//                                    "server.cpp",
+//                                    42,
+//                                    "SERVER",
+//                                    ball::Severity::e_INFO,
+//                                    "request complete");
+//  ball::Record record(attributes, ball::UserFields());
+//..
+// Next, we compute the size of the segment, consisting of the header, two
+// string entries (for the category and file name), the record entry, and a
+// terminating 0 length:
+//..
+//  typedef ball::BinaryRecordUtil Util;
+//
+//  const bsl::size_t size = Util::k_HEADER_SIZE
+//                         + Util::stringEntrySize("SERVER")
+//                         + Util::stringEntrySize("server.cpp")
+//                         + Util::recordEntrySize(record)
+//                         + Util::k_FRAME_SIZE;
+//  bsl::vector<char> segment(size);
+//..
+// Then, we write the segment, assigning the identifiers 0 and 1 to the
+// category and the file name, respectively:
+//..
+//  char *cursor = segment.data();
+//  Util::writeHeader(cursor);
+//  cursor += Util::k_HEADER_SIZE;
+//  cursor  = Util::writeStringEntry(cursor, 0, "SERVER");
+//  cursor  = Util::writeStringEntry(cursor, 1, "server.cpp");
+//  cursor  = Util::writeRecordEntry(cursor, record, 0, 1);
+//  Util::writeEndOfData(cursor);
+//..
+// Now, we read back the header, and the first entry:
+//..
+//  const char *data = segment.data();
+//  const char *end  = data + segment.size();
+//
+//  int version;
+//  int rc = Util::readHeader(&version, data, segment.size());
+//  assert(0                == rc);
+//  assert(Util::k_VERSION  == version);
+//
+//  const char      *payload;
+//  int              payloadLength;
+//  Util::EntryType  type;
+//
+//  data += Util::k_HEADER_SIZE;
+//  rc = Util::readEntry(&type, &payload, &payloadLength, &data, end);
+//  assert(0                    == rc);
+//  assert(Util::e_STRING_ENTRY == type);
+//
+//  int               id;
+//  bslstl::StringRef string;
+//  rc = Util::decodeStringEntry(&id, &string, payload, payloadLength);
+//  assert(0        == rc);
+//  assert(0        == id);
+//  assert("SERVER" == string);
+//..
+// Finally, we skip the second string entry, and decode the record entry:
+//..
+//  rc = Util::readEntry(&type, &payload, &payloadLength, &data, end);
+//  assert(0 == rc);
+//
+//  rc = Util::readEntry(&type, &payload, &payloadLength, &data, end);
+//  assert(0                    == rc);
+//  assert(Util::e_RECORD_ENTRY == type);
+//
+//  ball::Record decoded;
+//  int          categoryId;
+//  int          fileNameId;
+//  rc = Util::decodeRecordEntry(&decoded,
+//                               &categoryId,
+//                               &fileNameId,
+//                               payload,
+//                               payloadLength);
+//  assert(0                  == rc);
+//  assert(0                  == categoryId);
+//  assert(1                  == fileNameId);
+//  assert(42                 == decoded.fixedFields().lineNumber());
+//  assert("request complete" == decoded.fixedFields().messageRef());
+//
+//  assert(1 == Util::readEntry(&type, &payload, &payloadLength, &data, end));
+//..
+// Note that 'decodeRecordEntry' does not set the category and file name of
+// the decoded record, as the segment refers to them by identifier.
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace ball {
+
+class Record;
+
+                          // =======================
+                          // struct BinaryRecordUtil
+                          // =======================
+
+struct BinaryRecordUtil {
+    // This 'struct' provides a namespace for utility functions that write log
+    // records into, and read them from, the binary log format described in
+    // the component-level documentation.
+
+    // TYPES
+    enum {
+        k_VERSION     =  1,  // version of the format written by this utility
+        k_HEADER_SIZE = 16,  // size of a segment header (in bytes)
+        k_FRAME_SIZE  =  4   // size of the length preceding each entry
+    };
+
+    enum EntryType {
+        // Enumeration of the types of entries in a binary log segment.
+
+        e_STRING_ENTRY = 1,  // defines the identifier of a string
+        e_RECORD_ENTRY = 2   // a log record
+    };
+
+    // CLASS METHODS
+    static void writeHeader(char *buffer);
+        // Write a segment header to the specified 'buffer'.  The behavior is
+        // undefined unless 'buffer' has at least 'k_HEADER_SIZE' bytes.
+
+    static int readHeader(int         *version,
+                          const char  *buffer,
+                          bsl::size_t  length);
+        // Load into the specified 'version' the format version of the segment
+        // header at the start of the specified 'buffer' of the specified
+        // 'length'.  Return 0 on success, and a non-zero value (with no effect
+        // on 'version') if 'length < k_HEADER_SIZE' or 'buffer' does not start
+        // with a segment header.
+
+    static void writeEndOfData(char *buffer);
+        // Write an entry length of 0, indicating the end of the entries of a
+        // segment, to the specified 'buffer'.  The behavior is undefined
+        // unless 'buffer' has at least 'k_FRAME_SIZE' bytes.  Note that a
+        // writer that appends entries to a segment in place (e.g., in a
+        // memory-mapped file) can follow each entry with an end-of-data
+        // marker, so that the segment can be read up to the last complete
+        // entry at any time.
+
+    static bsl::size_t stringEntrySize(const bslstl::StringRef& value);
+        // Return the number of bytes written by 'writeStringEntry' for the
+        // specified 'value' (including the entry length).
+
+    static char *writeStringEntry(char                     *buffer,
+                                  int                       id,
+                                  const bslstl::StringRef&  value);
+        // Write to the specified 'buffer' an entry defining the specified
+        // 'id' as the identifier of the specified 'value', and return the
+        // address one past the last byte written.  The behavior is undefined
+        // unless 'buffer' has at least 'stringEntrySize(value)' bytes.
+
+    static bsl::size_t recordEntrySize(const Record& record);
+        // Return the number of bytes written by 'writeRecordEntry' for the
+        // specified 'record' (including the entry length).
+
+    static char *writeRecordEntry(char          *buffer,
+                                  const Record&  record,
+                                  int            categoryId,
+                                  int            fileNameId);
+        // Write to the specified 'buffer' an entry holding the specified
+        // 'record', referring to its category and file name by the specified
+        // 'categoryId' and 'fileNameId', respectively, and return the address
+        // one past the last byte written.  The behavior is undefined unless
+        // 'buffer' has at least 'recordEntrySize(record)' bytes.
+
+    static int readEntry(EntryType   *type,
+                         const char **payload,
+                         int         *payloadLength,
+                         const char **position,
+                         const char  *end);
+        // Read the entry at the specified '*position' in a segment ending at
+        // the specified 'end' and, on success, load its type into the
+        // specified 'type', the address and length of its payload into the
+        // specified 'payload' and 'payloadLength', and advance '*position' to
+        // the next entry.  Return 0 on success, 1 (with no effect on any
+        // argument) if there are no more entries (i.e., '*position' is at the
+        // end of the segment or at an entry length of 0), and a negative value
+        // if the entry is malformed (e.g., it extends past 'end').  The
+        // behavior is undefined unless '*position <= end'.
+
+    static int decodeStringEntry(int               *id,
+                                 bslstl::StringRef *value,
+                                 const char        *payload,
+                                 int                payloadLength);
+        // Load into the specified 'id' and 'value' the identifier and string
+        // defined by the 'e_STRING_ENTRY' entry having the specified 'payload'
+        // of the specified 'payloadLength'.  Return 0 on success, and a
+        // non-zero value if the payload is not a well-formed string entry.
+        // Note that 'value' refers into 'payload'.
+
+    static int decodeRecordEntry(Record     *record,
+                                 int        *categoryId,
+                                 int        *fileNameId,
+                                 const char *payload,
+                                 int         payloadLength);
+        // Load into the specified 'record' the log record held by the
+        // 'e_RECORD_ENTRY' entry having the specified 'payload' of the
+        // specified 'payloadLength', and load into the specified 'categoryId'
+        // and 'fileNameId' the identifiers of its category and file name.
+        // Return 0 on success, and a non-zero value if the payload is not a
+        // well-formed record entry.  The category and file name attributes of
+        // 'record' are not modified (see 'categoryId' and 'fileNameId').  On
+        // failure, the state of 'record' is valid, but unspecified.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1081 @@
+// ball_binaryrecordutil.t.cpp                                        -*-C++-*-
+
+#include <ball_binaryrecordutil.h>
+
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_severity.h>
+#include <ball_userfields.h>
+
+#include <bdlt_datetime.h>
+#include <bdlt_datetimetz.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is a utility for writing log records into, and
+// reading them from, a binary format.  We verify that each kind of entry
+// (header, end-of-data marker, string, and record) has the documented layout
+// and size, that every record (including every type of user field) survives a
+// round trip, and that the read functions reject, without reading past the
+// supplied bounds, every truncation and corruption of a well-formed segment.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] void writeHeader(char *buffer);
+// [ 2] int readHeader(int *version, const char *buffer, size_t length);
+// [ 2] void writeEndOfData(char *buffer);
+// [ 3] size_t stringEntrySize(const StringRef& value);
+// [ 3] char *writeStringEntry(char *buffer, int id, const StringRef& value);
+// [ 4] size_t recordEntrySize(const Record& record);
+// [ 4] char *writeRecordEntry(char *, const Record&, int, int);
+// [ 3] int readEntry(EntryType *, const char **, int *, const char **, end);
+// [ 3] int decodeStringEntry(int *, StringRef *, const char *, int);
+// [ 4] int decodeRecordEntry(Record *, int *, int *, const char *, int);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] MALFORMED INPUT
+// [ 6] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool             verbose;
+bool         veryVerbose;
+bool     veryVeryVerbose;
+bool veryVeryVeryVerbose;
+
+typedef ball::BinaryRecordUtil Util;
+typedef bsls::Types::Int64     Int64;
+typedef bsls::Types::Uint64    Uint64;
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+void makeRecord(ball::Record          *record,
+                const bdlt::Datetime&  timestamp,
+                int                    lineNumber,
+                const char            *message)
+    // Load into the specified 'record' a record having the specified
+    // 'timestamp', 'lineNumber', and 'message', and the category "CAT" and
+    // file name "file.cpp".
+{
+    ball::RecordAttributes& attributes = record->fixedFields();
+    attributes.setTimestamp(timestamp);
+    attributes.setProcessID(1234);
+    attributes.setThreadID((static_cast<Uint64>(0xFEDCBA98) << 32)
+                           | 0x76543210);
+    attributes.setSeverity(ball::Severity::e_WARN);
+    attributes.setCategory("CAT");
+    attributes.setFileName("file.cpp");
+    attributes.setLineNumber(lineNumber);
+    attributes.setMessage(message);
+}
+
+int encodeSegment(bsl::vector<char> *segment, const ball::Record& record)
+    // Load into the specified 'segment' a segment holding string entries
+    // defining the identifiers 7 and 9 for the category and file name of the
+    // specified 'record', followed by an entry holding 'record' and an
+    // end-of-data marker.  Return the size of the segment, excluding the
+    // end-of-data marker.
+{
+    const ball::RecordAttributes& attributes = record.fixedFields();
+
+    const bsl::size_t size = Util::k_HEADER_SIZE
+                           + Util::stringEntrySize(attributes.category())
+                           + Util::stringEntrySize(attributes.fileName())
+                           + Util::recordEntrySize(record);
+
+    segment->assign(size + Util::k_FRAME_SIZE, '\xA5');
+
+    char *cursor = &segment->front();
+    Util::writeHeader(cursor);
+    cursor += Util::k_HEADER_SIZE;
+    cursor  = Util::writeStringEntry(cursor, 7, attributes.category());
+    cursor  = Util::writeStringEntry(cursor, 9, attributes.fileName());
+    cursor  = Util::writeRecordEntry(cursor, record, 7, 9);
+    Util::writeEndOfData(cursor);
+
+    return static_cast<int>(size);
+}
+
+int decodeSegment(ball::Record *record, const char *data, bsl::size_t size)
+    // Decode into the specified 'record' the single record in the segment
+    // having the specified 'data' of the specified 'size' that was written by
+    // 'encodeSegment', resolving its category and file name.  Return 0 on
+    // success, and a non-zero value otherwise.
+{
+    int version;
+    if (0 != Util::readHeader(&version, data, size)) {
+        return 1;                                                     // RETURN
+    }
+
+    const char      *position = data + Util::k_HEADER_SIZE;
+    const char      *end      = data + size;
+    Util::EntryType  type;
+    const char      *payload;
+    int              payloadLength;
+    bsl::string      strings[10];
+    int              numRecords = 0;
+
+    int rc;
+    while (0 == (rc = Util::readEntry(&type,
+                                      &payload,
+                                      &payloadLength,
+                                      &position,
+                                      end))) {
+        if (Util::e_STRING_ENTRY == type) {
+            int               id;
+            bslstl::StringRef value;
+            if (0 != Util::decodeStringEntry(&id,
+                                             &value,
+                                             payload,
+                                             payloadLength)
+             || id < 0 || id >= 10) {
+                return 2;                                             // RETURN
+            }
+            strings[id] = value;
+        }
+        else {
+            int categoryId, fileNameId;
+            if (0 != Util::decodeRecordEntry(record,
+                                             &categoryId,
+                                             &fileNameId,
+                                             payload,
+                                             payloadLength)
+             || categoryId < 0 || categoryId >= 10
+             || fileNameId < 0 || fileNameId >= 10) {
+                return 3;                                             // RETURN
+            }
+            record->fixedFields().setCategory(strings[categoryId].c_str());
+            record->fixedFields().setFileName(strings[fileNameId].c_str());
+            ++numRecords;
+        }
+    }
+    return 1 == rc && 1 == numRecords ? 0 : 4;
+}
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+    bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+    bslma::TestAllocatorMonitor gam(&globalAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, replace 'assert' with
+        //:   'ASSERT', and insert 'if (veryVerbose)' before all output
+        //:   operations.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        // The example allocates from the default allocator.
+
+        bslma::TestAllocator         da("example", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Encoding and Decoding a Record
+///- - - - - - - - - - - - - - - - - - - - -
+// In this example we encode a record, along with the strings it refers to,
+// into a segment in memory, and then decode the segment.
+//
+// First, we create the record to be encoded:
+//..
+    ball::RecordAttributes attributes(bdlt::Datetime(2018, 5, 1, 12, 30),
+                                      1234,
+                                      5678,
+                                      "server.cpp",
+                                      42,
+                                      "SERVER",
+                                      ball::Severity::e_INFO,
+                                      "request complete");
+    ball::Record record(attributes, ball::UserFields());
+//..
+// Next, we compute the size of the segment, consisting of the header, two
+// string entries (for the category and file name), the record entry, and a
+// terminating 0 length:
+//..
+    typedef ball::BinaryRecordUtil Util;
+
+    const bsl::size_t size = Util::k_HEADER_SIZE
+                           + Util::stringEntrySize("SERVER")
+                           + Util::stringEntrySize("server.cpp")
+                           + Util::recordEntrySize(record)
+                           + Util::k_FRAME_SIZE;
+    bsl::vector<char> segment(size);
+//..
+// Then, we write the segment, assigning the identifiers 0 and 1 to the
+// category and the file name, respectively:
+//..
+    char *cursor = segment.data();
+    Util::writeHeader(cursor);
+    cursor += Util::k_HEADER_SIZE;
+    cursor  = Util::writeStringEntry(cursor, 0, "SERVER");
+    cursor  = Util::writeStringEntry(cursor, 1, "server.cpp");
+    cursor  = Util::writeRecordEntry(cursor, record, 0, 1);
+    Util::writeEndOfData(cursor);
+//..
+// Now, we read back the header, and the first entry:
+//..
+    const char *data = segment.data();
+    const char *end  = data + segment.size();
+
+    int version;
+    int rc = Util::readHeader(&version, data, segment.size());
+    ASSERT(0                == rc);
+    ASSERT(Util::k_VERSION  == version);
+
+    const char      *payload;
+    int              payloadLength;
+    Util::EntryType  type;
+
+    data += Util::k_HEADER_SIZE;
+    rc = Util::readEntry(&type, &payload, &payloadLength, &data, end);
+    ASSERT(0                    == rc);
+    ASSERT(Util::e_STRING_ENTRY == type);
+
+    int               id;
+    bslstl::StringRef string;
+    rc = Util::decodeStringEntry(&id, &string, payload, payloadLength);
+    ASSERT(0        == rc);
+    ASSERT(0        == id);
+    ASSERT("SERVER" == string);
+//..
+// Finally, we skip the second string entry, and decode the record entry:
+//..
+    rc = Util::readEntry(&type, &payload, &payloadLength, &data, end);
+    ASSERT(0 == rc);
+
+    rc = Util::readEntry(&type, &payload, &payloadLength, &data, end);
+    ASSERT(0                    == rc);
+    ASSERT(Util::e_RECORD_ENTRY == type);
+
+    ball::Record decoded;
+    int          categoryId;
+    int          fileNameId;
+    rc = Util::decodeRecordEntry(&decoded,
+                                 &categoryId,
+                                 &fileNameId,
+                                 payload,
+                                 payloadLength);
+    ASSERT(0                  == rc);
+    ASSERT(0                  == categoryId);
+    ASSERT(1                  == fileNameId);
+    ASSERT(42                 == decoded.fixedFields().lineNumber());
+    ASSERT("request complete" == decoded.fixedFields().messageRef());
+
+    ASSERT(1 == Util::readEntry(&type, &payload, &payloadLength, &data, end));
+//..
+// Note that 'decodeRecordEntry' does not set the category and file name of
+// the decoded record, as the segment refers to them by identifier.
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // MALFORMED INPUT
+        //
+        // Concerns:
+        //: 1 'readHeader' rejects buffers that are too short, or that do not
+        //:   start with the magic characters.
+        //:
+        //: 2 Every truncation of a well-formed segment is either read up to
+        //:   its last complete entry or rejected, and no read function
+        //:   accesses memory beyond the supplied bounds.
+        //:
+        //: 3 'readEntry' rejects entries of unknown type, and entries whose
+        //:   length is negative or extends past the end of the segment.
+        //:
+        //: 4 The decode functions reject payloads of the wrong type, payloads
+        //:   with trailing bytes, and payloads holding invalid values.
+        //
+        // Plan:
+        //: 1 Call 'readHeader' with every length less than 'k_HEADER_SIZE',
+        //:   and with a corrupted magic character.  (C-1)
+        //:
+        //: 2 For every prefix of an encoded segment, copy the prefix to a
+        //:   buffer of exactly that size (so that a read past its end is
+        //:   exposed to memory checkers), and decode it.  Verify that
+        //:   only the complete segment decodes successfully.  (C-2)
+        //:
+        //: 3 Corrupt the type and length of an entry, and verify that
+        //:   'readEntry' fails.  (C-3)
+        //:
+        //: 4 Call each decode function on a payload of the other type, on a
+        //:   payload having an extra byte, and on payloads holding an invalid
+        //:   timestamp, user-field type, and time zone offset.  (C-4)
+        //
+        // Testing:
+        //   MALFORMED INPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MALFORMED INPUT" << endl
+                          << "===============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        // Assigning a string to a 'ball::UserFieldValue' creates a temporary
+        // string using the default allocator.
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        ball::Record record(&ta);
+        makeRecord(&record,
+                   bdlt::Datetime(2018, 7, 4, 1, 2, 3, 4, 5),
+                   17,
+                   "truncated");
+        record.customFields().appendString("field");
+        record.customFields().appendDatetimeTz(
+                 bdlt::DatetimeTz(bdlt::Datetime(2018, 7, 4, 1, 2, 3), -300));
+
+        bsl::vector<char> segment(&ta);
+        const int         SIZE = encodeSegment(&segment, record);
+
+        if (verbose) cout << "\tTesting 'readHeader'." << endl;
+        {
+            int version = -1;
+            for (int i = 0; i < Util::k_HEADER_SIZE; ++i) {
+                ASSERTV(i, 0 != Util::readHeader(&version,
+                                                 segment.data(),
+                                                 i));
+                ASSERTV(i, -1 == version);
+            }
+            ASSERT(0 == Util::readHeader(&version,
+                                         segment.data(),
+                                         Util::k_HEADER_SIZE));
+            ASSERT(Util::k_VERSION == version);
+
+            bsl::vector<char> corrupt(segment, &ta);
+            corrupt[3] = 'X';
+            ASSERT(0 != Util::readHeader(&version,
+                                         corrupt.data(),
+                                         corrupt.size()));
+        }
+
+        if (verbose) cout << "\tTesting truncation." << endl;
+        {
+            for (int length = 0; length <= SIZE; ++length) {
+                char *buffer = static_cast<char *>(
+                                         ta.allocate(length ? length : 1));
+                bsl::memcpy(buffer, segment.data(), length);
+
+                ball::Record decoded(&ta);
+                const int    rc = decodeSegment(&decoded, buffer, length);
+
+                if (veryVerbose) { T_ P_(length) P(rc) }
+
+                if (SIZE == length) {
+                    ASSERTV(length, rc, 0 == rc);
+                    ASSERTV(length, record == decoded);
+                }
+                else {
+                    ASSERTV(length, rc, 0 != rc);
+                }
+                ta.deallocate(buffer);
+            }
+        }
+
+        if (verbose) cout << "\tTesting 'readEntry'." << endl;
+        {
+            const char *data = segment.data() + Util::k_HEADER_SIZE;
+
+            bsl::vector<char> corrupt(segment, &ta);
+            char             *entry = corrupt.data() + Util::k_HEADER_SIZE;
+            const char       *end   = corrupt.data() + SIZE;
+
+            Util::EntryType  type;
+            const char      *payload;
+            int              payloadLength;
+            const char      *position;
+
+            // unknown type
+
+            entry[Util::k_FRAME_SIZE] = 3;
+            position = entry;
+            ASSERT(0 >  Util::readEntry(&type,
+                                        &payload,
+                                        &payloadLength,
+                                        &position,
+                                        end));
+            ASSERT(entry == position);
+            entry[Util::k_FRAME_SIZE] = Util::e_STRING_ENTRY;
+
+            // negative length
+
+            bsl::memcpy(entry, "\xFF\xFF\xFF\xFF", 4);
+            position = entry;
+            ASSERT(0 >  Util::readEntry(&type,
+                                        &payload,
+                                        &payloadLength,
+                                        &position,
+                                        end));
+            ASSERT(entry == position);
+
+            // length extending past the end
+
+            bsl::memcpy(entry, "\x00\x01\x00\x00", 4);
+            position = entry;
+            ASSERT(0 >  Util::readEntry(&type,
+                                        &payload,
+                                        &payloadLength,
+                                        &position,
+                                        end));
+            ASSERT(entry == position);
+
+            // restored entry
+
+            bsl::memcpy(entry, data, 4);
+            position = entry;
+            ASSERT(0 == Util::readEntry(&type,
+                                        &payload,
+                                        &payloadLength,
+                                        &position,
+                                        end));
+            ASSERT(Util::e_STRING_ENTRY == type);
+        }
+
+        if (verbose) cout << "\tTesting decode functions." << endl;
+        {
+            const char *position = segment.data() + Util::k_HEADER_SIZE;
+            const char *end      = segment.data() + SIZE;
+
+            Util::EntryType  type;
+            const char      *stringPayload;
+            int              stringLength;
+            const char      *recordPayload;
+            int              recordLength;
+            const char      *unused;
+            int              unusedLength;
+
+            ASSERT(0 == Util::readEntry(&type,
+                                        &stringPayload,
+                                        &stringLength,
+                                        &position,
+                                        end));
+            ASSERT(0 == Util::readEntry(&type,
+                                        &unused,
+                                        &unusedLength,
+                                        &position,
+                                        end));
+            ASSERT(0 == Util::readEntry(&type,
+                                        &recordPayload,
+                                        &recordLength,
+                                        &position,
+                                        end));
+            ASSERT(Util::e_RECORD_ENTRY == type);
+
+            int               id;
+            bslstl::StringRef value;
+            ball::Record      decoded(&ta);
+            int               categoryId;
+            int               fileNameId;
+
+            // wrong type
+
+            ASSERT(0 != Util::decodeStringEntry(&id,
+                                                &value,
+                                                recordPayload,
+                                                recordLength));
+            ASSERT(0 != Util::decodeRecordEntry(&decoded,
+                                                &categoryId,
+                                                &fileNameId,
+                                                stringPayload,
+                                                stringLength));
+
+            // trailing byte
+
+            bsl::vector<char> payload(recordPayload,
+                                      recordPayload + recordLength,
+                                      &ta);
+            ASSERT(0 == Util::decodeRecordEntry(&decoded,
+                                                &categoryId,
+                                                &fileNameId,
+                                                payload.data(),
+                                                recordLength));
+            payload.push_back('\0');
+            ASSERT(0 != Util::decodeRecordEntry(&decoded,
+                                                &categoryId,
+                                                &fileNameId,
+                                                payload.data(),
+                                                recordLength + 1));
+            payload.pop_back();
+
+            // invalid timestamp (negative)
+
+            payload[1] = '\x80';
+            ASSERT(0 != Util::decodeRecordEntry(&decoded,
+                                                &categoryId,
+                                                &fileNameId,
+                                                payload.data(),
+                                                recordLength));
+            payload[1] = recordPayload[1];
+
+            // invalid timestamp (past 9999/12/31)
+
+            payload[1] = '\x7F';
+            ASSERT(0 != Util::decodeRecordEntry(&decoded,
+                                                &categoryId,
+                                                &fileNameId,
+                                                payload.data(),
+                                                recordLength));
+            payload[1] = recordPayload[1];
+
+            // The user fields are at the end of the payload: a string field
+            // ("field") followed by a 'DatetimeTz' field (1 + 8 + 4 bytes).
+
+            const int TZ_FIELD = recordLength - 13;
+            const int OFFSET   = recordLength - 4;
+
+            // invalid user-field type
+
+            payload[TZ_FIELD] = 42;
+            ASSERT(0 != Util::decodeRecordEntry(&decoded,
+                                                &categoryId,
+                                                &fileNameId,
+                                                payload.data(),
+                                                recordLength));
+            payload[TZ_FIELD] = recordPayload[TZ_FIELD];
+
+            // invalid time zone offset (more than a day)
+
+            bsl::memcpy(&payload[OFFSET], "\x00\x01\x00\x00", 4);
+            ASSERT(0 != Util::decodeRecordEntry(&decoded,
+                                                &categoryId,
+                                                &fileNameId,
+                                                payload.data(),
+                                                recordLength));
+            bsl::memcpy(&payload[OFFSET], recordPayload + OFFSET, 4);
+
+            ASSERT(0 == Util::decodeRecordEntry(&decoded,
+                                                &categoryId,
+                                                &fileNameId,
+                                                payload.data(),
+                                                recordLength));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Util::EntryType  type;
+            const char      *payload;
+            int              payloadLength;
+            const char      *position = segment.data();
+            const char      *end      = segment.data() + 1;
+
+            ASSERT_FAIL(Util::writeHeader(0));
+            ASSERT_FAIL(Util::writeEndOfData(0));
+            ASSERT_FAIL(Util::writeStringEntry(0, 0, "x"));
+            ASSERT_FAIL(Util::writeRecordEntry(0, record, 0, 0));
+            ASSERT_PASS(Util::readEntry(&type,
+                                        &payload,
+                                        &payloadLength,
+                                        &position,
+                                        end));
+            position = end + 1;
+            ASSERT_FAIL(Util::readEntry(&type,
+                                        &payload,
+                                        &payloadLength,
+                                        &position,
+                                        end));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // RECORD ENTRIES
+        //
+        // Concerns:
+        //: 1 'recordEntrySize' returns the number of bytes written by
+        //:   'writeRecordEntry'.
+        //:
+        //: 2 Every attribute of a record, and every type of user field,
+        //:   survives a round trip, including empty messages and strings,
+        //:   messages containing null characters, and the extreme timestamps.
+        //:
+        //: 3 The category and file name identifiers survive a round trip, and
+        //:   the category and file name of the decoded record are unchanged.
+        //:
+        //: 4 The user fields of the decoded record replace any it had before.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, encode a set of records
+        //:   having distinct messages, timestamps, and user fields, into a
+        //:   buffer filled with a marker byte, and verify the returned end
+        //:   address and that the byte after the entry is unchanged.  (C-1)
+        //:
+        //: 2 Decode each entry into a record holding stale user fields, set
+        //:   its category and file name, and compare with the original.
+        //:   (C-2..4)
+        //
+        // Testing:
+        //   size_t recordEntrySize(const Record& record);
+        //   char *writeRecordEntry(char *, const Record&, int, int);
+        //   int decodeRecordEntry(Record *, int *, int *, const char *, int);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RECORD ENTRIES" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        // Assigning a string to a 'ball::UserFieldValue' creates a temporary
+        // string using the default allocator.
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        const bsl::string LONG_MESSAGE(1000, 'm', &ta);
+
+        static const struct {
+            int         d_line;
+            int         d_year;     // timestamp year
+            int         d_usec;     // timestamp microsecond
+            const char *d_message;
+            int         d_length;   // message length, or -1 for 'strlen'
+            int         d_numFields;
+        } DATA[] = {
+            //LINE  YEAR  USEC  MESSAGE        LENGTH  FIELDS
+            //----  ----  ----  -------------  ------  ------
+            { L_,      1,    0, "",                -1,      0 },
+            { L_,   9999,  999, "x",               -1,      0 },
+            { L_,   2018,    1, "hello world",     -1,      1 },
+            { L_,   2018,  500, 0,                 -1,      2 },
+            { L_,   2018,   17, "a\0b",             3,      6 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE   = DATA[ti].d_line;
+            const int   YEAR   = DATA[ti].d_year;
+            const int   USEC   = DATA[ti].d_usec;
+            const char *MSG    = DATA[ti].d_message ? DATA[ti].d_message
+                                                    : LONG_MESSAGE.c_str();
+            const int   LENGTH = DATA[ti].d_length;
+            const int   FIELDS = DATA[ti].d_numFields;
+
+            ball::Record record(&ta);
+            makeRecord(&record,
+                       9999 == YEAR
+                       ? bdlt::Datetime(9999, 12, 31, 23, 59, 59, 999, USEC)
+                       : bdlt::Datetime(YEAR, 1, 1, 0, 0, 0, 0, USEC),
+                       LINE,
+                       MSG);
+            if (0 <= LENGTH) {
+                record.fixedFields().clearMessage();
+                record.fixedFields().messageStreamBuf().sputn(MSG, LENGTH);
+            }
+
+            ball::UserFields& fields = record.customFields();
+            if (FIELDS >= 1) fields.appendInt64(-1234567890 * Int64(1000));
+            if (FIELDS >= 2) fields.appendString(LONG_MESSAGE);
+            if (FIELDS >= 3) fields.appendDouble(-0.125);
+            if (FIELDS >= 4) fields.appendNull();
+            if (FIELDS >= 5) {
+                bsl::vector<char> array(&ta);
+                array.push_back('\0');
+                array.push_back('\xFF');
+                fields.appendCharArray(array);
+            }
+            if (FIELDS >= 6) {
+                fields.appendDatetimeTz(bdlt::DatetimeTz(
+                                        bdlt::Datetime(2018, 2, 3, 4, 5, 6, 7),
+                                        -1439));
+            }
+
+            const bsl::size_t SIZE = Util::recordEntrySize(record);
+
+            if (veryVerbose) { T_ P_(LINE) P(SIZE) }
+
+            bsl::vector<char> buffer(SIZE + 1, '\xA5', &ta);
+            char *end = Util::writeRecordEntry(buffer.data(), record, 3, 5);
+            ASSERTV(LINE, buffer.data() + SIZE == end);
+            ASSERTV(LINE, '\xA5' == buffer[SIZE]);
+
+            const char      *position = buffer.data();
+            Util::EntryType  type;
+            const char      *payload;
+            int              payloadLength;
+            ASSERTV(LINE, 0 == Util::readEntry(&type,
+                                               &payload,
+                                               &payloadLength,
+                                               &position,
+                                               buffer.data() + SIZE));
+            ASSERTV(LINE, Util::e_RECORD_ENTRY == type);
+            ASSERTV(LINE, buffer.data() + SIZE == position);
+            ASSERTV(LINE, static_cast<int>(SIZE) - Util::k_FRAME_SIZE
+                                                            == payloadLength);
+
+            ball::Record decoded(&ta);
+            decoded.fixedFields().setCategory("stale category");
+            decoded.customFields().appendString("stale field");
+
+            int categoryId = -1;
+            int fileNameId = -1;
+            ASSERTV(LINE, 0 == Util::decodeRecordEntry(&decoded,
+                                                       &categoryId,
+                                                       &fileNameId,
+                                                       payload,
+                                                       payloadLength));
+            ASSERTV(LINE, 3 == categoryId);
+            ASSERTV(LINE, 5 == fileNameId);
+            ASSERTV(LINE, "stale category" == bsl::string(
+                                          decoded.fixedFields().category()));
+
+            decoded.fixedFields().setCategory("CAT");
+            decoded.fixedFields().setFileName("file.cpp");
+
+            ASSERTV(LINE, record.fixedFields() == decoded.fixedFields());
+            ASSERTV(LINE, record.customFields() == decoded.customFields());
+            ASSERTV(LINE, record == decoded);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // STRING ENTRIES
+        //
+        // Concerns:
+        //: 1 'stringEntrySize' returns the number of bytes written by
+        //:   'writeStringEntry'.
+        //:
+        //: 2 The identifier and string survive a round trip, including empty
+        //:   strings and strings containing null characters.
+        //:
+        //: 3 'readEntry' reads consecutive entries, and stops (returning 1,
+        //:   with no effect on its arguments) at an end-of-data marker or the
+        //:   end of the segment.
+        //:
+        //: 4 The decoded string refers into the payload.
+        //
+        // Plan:
+        //: 1 Write a sequence of string entries, having distinct identifiers
+        //:   and values, into a buffer, and verify the returned addresses.
+        //:   (C-1)
+        //:
+        //: 2 Read and decode the entries, and compare with the originals.
+        //:   Verify the result of 'readEntry' at the end of the buffer, both
+        //:   with and without an end-of-data marker.  (C-2..4)
+        //
+        // Testing:
+        //   size_t stringEntrySize(const StringRef& value);
+        //   char *writeStringEntry(char *buffer, int id, const StringRef&);
+        //   int readEntry(EntryType *, const char **, int *, const char**, E);
+        //   int decodeStringEntry(int *, StringRef *, const char *, int);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "STRING ENTRIES" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        const bslstl::StringRef VALUES[] = {
+            bslstl::StringRef(""),
+            bslstl::StringRef("a"),
+            bslstl::StringRef("a\0b", 3),
+            bslstl::StringRef("category.name.with.dots"),
+        };
+        const int NUM_VALUES = static_cast<int>(sizeof VALUES
+                                                / sizeof *VALUES);
+
+        bsl::size_t size = 0;
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            const bsl::size_t EXP = Util::k_FRAME_SIZE + 1 + 4
+                                                       + VALUES[i].length();
+            ASSERTV(i, EXP == Util::stringEntrySize(VALUES[i]));
+            size += EXP;
+        }
+
+        bsl::vector<char> buffer(size + Util::k_FRAME_SIZE, '\xA5', &ta);
+        char             *cursor = buffer.data();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            char *next = Util::writeStringEntry(cursor, i * 100, VALUES[i]);
+            ASSERTV(i, cursor + Util::stringEntrySize(VALUES[i]) == next);
+            cursor = next;
+        }
+
+        for (int marker = 0; marker < 2; ++marker) {
+            const char *end = buffer.data() + size;
+            if (marker) {
+                Util::writeEndOfData(buffer.data() + size);
+                end += Util::k_FRAME_SIZE;
+            }
+
+            const char *position = buffer.data();
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                Util::EntryType    type;
+                const char        *payload;
+                int                payloadLength;
+                ASSERTV(i, 0 == Util::readEntry(&type,
+                                                &payload,
+                                                &payloadLength,
+                                                &position,
+                                                end));
+                ASSERTV(i, Util::e_STRING_ENTRY == type);
+
+                int               id = -1;
+                bslstl::StringRef value;
+                ASSERTV(i, 0 == Util::decodeStringEntry(&id,
+                                                        &value,
+                                                        payload,
+                                                        payloadLength));
+                ASSERTV(i, i * 100   == id);
+                ASSERTV(i, VALUES[i] == value);
+                ASSERTV(i, payload < value.data() || value.isEmpty());
+            }
+
+            Util::EntryType  type          = Util::e_RECORD_ENTRY;
+            const char      *payload       = 0;
+            int              payloadLength = -1;
+            const char      *last          = position;
+            ASSERTV(marker, 1 == Util::readEntry(&type,
+                                                 &payload,
+                                                 &payloadLength,
+                                                 &position,
+                                                 end));
+            ASSERTV(marker, last                 == position);
+            ASSERTV(marker, Util::e_RECORD_ENTRY == type);
+            ASSERTV(marker, 0                    == payload);
+            ASSERTV(marker, -1                   == payloadLength);
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // SEGMENT HEADER AND END-OF-DATA MARKER
+        //
+        // Concerns:
+        //: 1 'writeHeader' writes exactly 'k_HEADER_SIZE' bytes having the
+        //:   documented layout.
+        //:
+        //: 2 'readHeader' loads the version of a header written by
+        //:   'writeHeader'.
+        //:
+        //: 3 'writeEndOfData' writes exactly 'k_FRAME_SIZE' zero bytes.
+        //
+        // Plan:
+        //: 1 Write a header and an end-of-data marker into buffers filled
+        //:   with a marker byte, and compare the buffers with the expected
+        //:   contents.  (C-1, 3)
+        //:
+        //: 2 Read the header and verify the version.  (C-2)
+        //
+        // Testing:
+        //   void writeHeader(char *buffer);
+        //   int readHeader(int *version, const char *buffer, size_t length);
+        //   void writeEndOfData(char *buffer);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SEGMENT HEADER AND END-OF-DATA MARKER" << endl
+                          << "=====================================" << endl;
+
+        char buffer[Util::k_HEADER_SIZE + 1];
+        bsl::memset(buffer, '\xA5', sizeof buffer);
+
+        Util::writeHeader(buffer);
+
+        const char EXP[] = "BALLBINL\0\0\0\1\0\0\0\0\xA5";
+        ASSERT(0 == bsl::memcmp(EXP, buffer, sizeof buffer));
+
+        int version = -1;
+        ASSERT(0 == Util::readHeader(&version, buffer, sizeof buffer));
+        ASSERT(Util::k_VERSION == version);
+
+        char marker[Util::k_FRAME_SIZE + 1];
+        bsl::memset(marker, '\xA5', sizeof marker);
+
+        Util::writeEndOfData(marker);
+        ASSERT(0 == bsl::memcmp("\0\0\0\0\xA5", marker, sizeof marker));
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Encode a segment holding a record and the strings it refers to,
+        //:   decode it, and compare the decoded record with the original.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        ball::Record record(&ta);
+        makeRecord(&record,
+                   bdlt::Datetime(2018, 1, 2, 3, 4, 5, 6, 7),
+                   99,
+                   "breathing");
+        record.customFields().appendInt64(5);
+
+        bsl::vector<char> segment(&ta);
+        const int         SIZE = encodeSegment(&segment, record);
+
+        if (veryVerbose) { T_ P(SIZE) }
+
+        ball::Record decoded(&ta);
+        ASSERT(0 == decodeSegment(&decoded, segment.data(), segment.size()));
+        ASSERT(record == decoded);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (test >= 0) {
+        // CONCERN: In no case does memory come from the default allocator.
+
+        ASSERT(dam.isTotalSame());
+
+        // CONCERN: In no case does memory come from the global allocator.
+
+        ASSERT(gam.isTotalSame());
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
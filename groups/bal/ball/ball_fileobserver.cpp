@@ -22,6 +22,7 @@ BSLS_IDENT_RCSID(ball_fileobserver_cpp,"$Id$ $CSID$")
 #include <ball_multiplexobserver.h>           // for testing only
 
 #include <bslmt_lockguard.h>
+#include <bsls_assert.h>
 
 #include <bsl_cstdio.h>
 #include <bsl_cstring.h>   // for 'bsl::strcmp'
@@ -205,6 +206,32 @@ void FileObserver::publish(const Record& record, const Context& context)
     d_fileObserver2.publish(record, context);
 }
 
+void FileObserver::publishBatch(const Record * const *records,
+                                int                  numRecords)
+{
+    BSLS_ASSERT(records || 0 == numRecords);
+    BSLS_ASSERT(0 <= numRecords);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    bsl::ostringstream oss;
+    bool               stdoutFlag = false;
+    for (int i = 0; i < numRecords; ++i) {
+        if (records[i]->fixedFields().severity() <= d_stdoutThreshold) {
+            d_stdoutFormatter(oss, *records[i]);
+            stdoutFlag = true;
+        }
+    }
+
+    if (stdoutFlag) {
+        const bsl::string& output = oss.str();
+        bsl::fwrite(output.c_str(), 1, output.length(), stdout);
+        bsl::fflush(stdout);
+    }
+
+    d_fileObserver2.publishBatch(records, numRecords);
+}
+
 void FileObserver::setStdoutThreshold(Severity::Level stdoutThreshold)
 {
     bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
@@ -40,6 +40,7 @@ BSLS_IDENT("$Id: $")
 //                         |              enableStdoutLoggingPrefix
 //                         |              enablePublishInLocalTime
 //                         |              forceRotation
+//                         |              publishBatch
 //                         |              rotateOnSize
 //                         |              rotateOnTimeInterval
 //                         |              setOnFileRotationCallback
@@ -509,6 +510,17 @@ class FileObserver : public Observer {
         // 'stdout' if the severity of 'record' is at least as severe as the
         // severity level specified at construction.
 
+    void publishBatch(const Record * const *records, int numRecords);
+        // Process the specified sequence of 'numRecords' 'records', in order,
+        // by writing them to a file if file logging is enabled for this file
+        // observer, and writing those records whose severity is at least as
+        // severe as the 'stdout' threshold to 'stdout'.  The file output of
+        // the sequence is written with one 'write' system call per batch (see
+        // 'FileObserver2::publishBatch'), and the 'stdout' output with a
+        // single 'fwrite'.  The behavior is undefined unless
+        // '0 <= numRecords' and each of the 'numRecords' elements of 'records'
+        // refers to a valid record.
+
     void releaseRecords();
         // Discard any shared reference to a 'Record' object that was supplied
         // to the 'publish' method, and is held by this observer.  Note that
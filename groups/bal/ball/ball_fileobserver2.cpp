@@ -44,10 +44,12 @@ BSLS_IDENT_RCSID(ball_fileobserver2_cpp,"$Id$ $CSID$")
 
 #include <bslstl_stringref.h>
 
+#include <bsl_algorithm.h>
 #include <bsl_cstdio.h>
 #include <bsl_cstring.h>
 #include <bsl_iomanip.h>
 #include <bsl_iostream.h>
+#include <bsl_limits.h>
 #include <bsl_memory.h>
 #include <bsl_sstream.h>
 
@@ -521,6 +523,88 @@ int FileObserver2::rotateIfNecessary(bsl::string           *rotatedLogFileName,
     return 1;
 }
 
+int FileObserver2::writeBatch(const Record * const *records, int numRecords)
+{
+    BSLS_ASSERT(records);
+    BSLS_ASSERT(0 < numRecords);
+    BSLS_ASSERT(d_logStreamBuf.isOpened());
+
+    typedef bdls::FilesystemUtil FileUtil;
+
+    // The caller has already performed any rotation required by the first
+    // record.  Stop formatting before any subsequent record that would
+    // trigger a rotation, so that it is written only after the rotation.
+    // Note that 'tellp' is consulted once per batch rather than once per
+    // record, and returns -1 on failure (in which case only the first record
+    // is consumed so that 'rotateIfNecessary' handles the error).
+
+    const bsls::Types::Int64 fileSize = d_rotationSize
+                                        ? static_cast<bsls::Types::Int64>(
+                                                      d_logOutStream.tellp())
+                                        : 0;
+    const bsls::Types::Int64 maxFileSize =
+                       static_cast<bsls::Types::Int64>(d_rotationSize) * 1024;
+    const bool rotateOnTimeFlag = 0 < d_rotationInterval.totalSeconds();
+
+    d_batchStreamBuf.pubseekpos(0);
+    bsl::ostream batchStream(&d_batchStreamBuf);
+
+    int numFormatted = 0;
+    do {
+        const Record& record = *records[numFormatted];
+
+        if (0 < numFormatted) {
+            const bsls::Types::Int64 pendingSize =
+                   static_cast<bsls::Types::Int64>(d_batchStreamBuf.length());
+
+            if (d_rotationSize
+             && (fileSize < 0 || fileSize + pendingSize > maxFileSize)) {
+                break;
+            }
+            if (rotateOnTimeFlag
+             && d_nextRotationTimeUtc <= record.fixedFields().timestamp()) {
+                break;
+            }
+        }
+
+        d_logFileFunctor(batchStream, record);
+        ++numFormatted;
+    } while (numFormatted < numRecords);
+
+    // Anything already buffered by 'd_logOutStream' must reach the file
+    // before the batch, which is then written directly to the underlying
+    // descriptor (opened in binary mode, so no translation is bypassed).
+
+    d_logOutStream.flush();
+
+    const char *data   = d_batchStreamBuf.data();
+    bsl::size_t length = d_batchStreamBuf.length();
+    while (d_logOutStream && 0 < length) {
+        const int chunk = static_cast<int>(bsl::min<bsl::size_t>(
+                                          length,
+                                          bsl::numeric_limits<int>::max()));
+        const int rc    = FileUtil::write(d_logStreamBuf.fileDescriptor(),
+                                          data,
+                                          chunk);
+        if (0 >= rc) {
+            d_logOutStream.setstate(bsl::ios_base::badbit);
+            break;
+        }
+        data   += rc;
+        length -= rc;
+    }
+
+    if (!d_logOutStream) {
+        fprintf(stderr, "%s Error on file stream for %s: %s\n",
+                errorMsgPrefix,
+                d_logFileName.c_str(), bsl::strerror(getErrorCode()));
+
+        d_logStreamBuf.clear();
+    }
+
+    return numFormatted;
+}
+
 // CREATORS
 FileObserver2::FileObserver2(bslma::Allocator *basicAllocator)
 : d_logStreamBuf(bdls::FilesystemUtil::k_INVALID_FD, false)
@@ -536,6 +620,7 @@ FileObserver2::FileObserver2(bslma::Allocator *basicAllocator)
 , d_rotationInterval(0)
 , d_onRotationCb()
 , d_rotationCbMutex()
+, d_batchStreamBuf(basicAllocator)
 {
 }
 
@@ -682,6 +767,41 @@ void FileObserver2::publish(const Record& record, const Context&)
     }
 }
 
+void FileObserver2::publishBatch(const Record * const *records,
+                                 int                  numRecords)
+{
+    BSLS_ASSERT(records || 0 == numRecords);
+    BSLS_ASSERT(0 <= numRecords);
+
+    int numPublished = 0;
+    while (numPublished < numRecords) {
+        bsl::string rotatedFileName;
+        int         rotationStatus;
+
+        {
+            bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+            rotationStatus = rotateIfNecessary(
+                             &rotatedFileName,
+                             records[numPublished]->fixedFields().timestamp());
+
+            if (d_logStreamBuf.isOpened()) {
+                numPublished += writeBatch(records + numPublished,
+                                           numRecords - numPublished);
+            }
+            else {
+                numPublished = numRecords;
+            }
+        }
+
+        if (0 >= rotationStatus) {
+            bslmt::LockGuard<bslmt::Mutex> guard(&d_rotationCbMutex);
+            if (d_onRotationCb) {
+                d_onRotationCb(rotationStatus, rotatedFileName);
+            }
+        }
+    }
+}
+
 void FileObserver2::rotateOnLifetime(
                                     const bdlt::DatetimeInterval& timeInterval)
 {
@@ -39,6 +39,7 @@ BSLS_IDENT("$Id: $")
 //                         |              enableFileLogging
 //                         |              enablePublishInLocalTime
 //                         |              forceRotation
+//                         |              publishBatch
 //                         |              rotateOnSize
 //                         |              rotateOnTimeInterval
 //                         |              setLogFileFunctor
@@ -166,6 +167,19 @@ BSLS_IDENT("$Id: $")
 // Note that timestamp pattern elements in a log file name are typically
 // selected so they produce unique names for each rotation.
 //
+///Batched Publication
+///--------------------
+// Each call to 'publish' formats a single record and writes it to the log
+// file, which costs (at least) one 'write' system call per record.  Clients
+// that have many records available at once (e.g., an asynchronous publication
+// thread draining a queue) can instead call 'publishBatch', which formats a
+// sequence of records into a reusable contiguous buffer and writes the buffer
+// to the log file with a single 'write' system call.  Rotation rules are
+// honored between the records of a batch exactly as they would be for
+// successive calls to 'publish': if a record would trigger a rotation, the
+// records preceding it are written to the current log file, the file is
+// rotated, and the remaining records are written to the new log file.
+//
 ///Thread Safety
 ///-------------
 // All methods of 'ball::FileObserver2' are thread-safe, and can be called
@@ -225,6 +239,10 @@ BSLS_IDENT("$Id: $")
 #include <bdls_fdstreambuf.h>
 #endif
 
+#ifndef INCLUDED_BDLSB_MEMOUTSTREAMBUF
+#include <bdlsb_memoutstreambuf.h>
+#endif
+
 #ifndef INCLUDED_BDLT_DATETIME
 #include <bdlt_datetime.h>
 #endif
@@ -368,6 +386,11 @@ class FileObserver2 : public Observer {
                                                        // called with 'd_mutex'
                                                        // unlocked
 
+    bdlsb::MemOutStreamBuf d_batchStreamBuf;           // reusable buffer into
+                                                       // which a batch of
+                                                       // records is formatted
+                                                       // by 'publishBatch'
+
   private:
     // NOT IMPLEMENTED
     FileObserver2(const FileObserver2&);
@@ -402,6 +425,16 @@ class FileObserver2 : public Observer {
         // and the 'rotateOnSize' methods respectively.  The behavior is
         // undefined unless the caller acquired the lock for this object.
 
+    int writeBatch(const Record * const *records, int numRecords);
+        // Format, into the batch buffer of this object, the longest prefix of
+        // the specified sequence of 'numRecords' 'records' that can be written
+        // to the current log file without requiring a rotation (always at
+        // least the first record), and write the formatted prefix to the log
+        // file using a single 'write' system call.  Return the number of
+        // records consumed.  The behavior is undefined unless the caller
+        // acquired the lock for this object, the log file is open, and
+        // '0 < numRecords'.
+
   public:
     // TRAITS
     BSLMF_NESTED_TRAIT_DECLARATION(FileObserver2, bslma::UsesBslmaAllocator);
@@ -514,6 +547,18 @@ class FileObserver2 : public Observer {
         // a file if file logging is enabled for this file observer.  The
         // method has no effect if file logging is not enabled.
 
+    void publishBatch(const Record * const *records, int numRecords);
+        // Process the specified sequence of 'numRecords' 'records', in order,
+        // by writing them to a file if file logging is enabled for this file
+        // observer.  Records are formatted into a contiguous buffer that is
+        // written to the log file with one 'write' system call per batch
+        // (rather than per record), except that a rotation triggered by a
+        // record in the sequence is performed, and the rotation callback
+        // invoked, before that record is written.  This method has no effect
+        // if file logging is not enabled.  The behavior is undefined unless
+        // '0 <= numRecords' and each of the 'numRecords' elements of 'records'
+        // refers to a valid record.
+
     void releaseRecords();
         // Discard any shared reference to a 'Record' object that was supplied
         // to the 'publish' method, and is held by this observer.  Note that
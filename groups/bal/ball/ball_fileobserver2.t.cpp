@@ -111,6 +111,7 @@ using bsl::flush;
 // [ 3] void setMaxLogFiles();
 // [ 6] void setOnFileRotationCallback(const OnFileRotationCallback&);
 // [ 3] int removeExcessLogFiles();
+// [13] void publishBatch(const Record * const *records, int numRecords);
 //
 // ACCESSORS
 // [ 1] bool isFileLoggingEnabled() const
@@ -123,6 +124,7 @@ using bsl::flush;
 // [ 8] CONCERN: 'rotateOnSize' triggers correctly for existing files
 // [ 7] CONCERN: Rotation on size is based on file size
 // [12] CONCERN: Published Records Show Current Local-Time Offset
+// [13] CONCERN: 'publishBatch' output matches per-record 'publish'
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -509,6 +511,17 @@ void publishRecord(Obj *mX, const char *message)
 }
 
 
+bsl::string readWholeFile(const bsl::string& filename)
+    // Return the contents of the file having the specified 'filename'.
+{
+    bsl::ifstream fs(filename.c_str(), bsl::ifstream::in);
+    ASSERT(fs.is_open());
+
+    bsl::ostringstream oss;
+    oss << fs.rdbuf();
+    return oss.str();
+}
+
 int getNumLines(const char *filename)
 {
     bsl::ifstream fs;
@@ -731,6 +744,170 @@ int main(int argc, char *argv[])
     bslma::DefaultAllocatorGuard guard(&defaultAllocator);
 
     switch (test) { case 0:
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING: 'publishBatch'
+        //
+        // Concerns:
+        //: 1 Publishing a sequence of records with 'publishBatch' writes the
+        //:   same bytes to the log file, in the same order, as publishing
+        //:   each record with 'publish'.
+        //:
+        //: 2 The result does not depend on how the sequence is split into
+        //:   batches, and an empty batch has no effect.
+        //:
+        //: 3 'publishBatch' has no effect if file logging is disabled.
+        //:
+        //: 4 A rotation-on-size rule is evaluated between the records of a
+        //:   batch, so the number of rotations (and invocations of the
+        //:   rotation callback) is the same as for per-record publication,
+        //:   and the records following the last rotation are written to the
+        //:   new log file.
+        //
+        // Plan:
+        //: 1 Create a sequence of records having distinct messages and a
+        //:   fixed timestamp.  Publish the sequence to a reference observer
+        //:   using 'publish', and, for a number of batch sizes, to a second
+        //:   observer using 'publishBatch'.  Verify the log files are
+        //:   identical.  (C-1..2)
+        //:
+        //: 2 Call 'publishBatch' on an observer without file logging
+        //:   enabled and verify no file is created.  (C-3)
+        //:
+        //: 3 Repeat P-1 with a small rotation-on-size rule and a rotation
+        //:   callback installed on both observers, publishing the whole
+        //:   sequence in a single batch.  Verify the number of callback
+        //:   invocations matches, and the contents of the current log files
+        //:   are identical.  (C-4)
+        //
+        // Testing:
+        //   void publishBatch(const Record * const *records, int numRecords);
+        //   CONCERN: 'publishBatch' output matches per-record 'publish'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING: 'publishBatch'"
+                          << "\n=======================" << endl;
+
+        enum { NUM_RECORDS = 200 };
+
+        const bdlt::Datetime TIMESTAMP(2018, 3, 14, 15, 9, 26, 535);
+
+        bsl::vector<ball::Record>          records(Z);
+        bsl::vector<const ball::Record *>  recordPtrs(Z);
+        records.reserve(NUM_RECORDS);
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            bsl::ostringstream message;
+            message << "batched message " << i;
+
+            ball::RecordAttributes attr(TIMESTAMP,
+                                        1,
+                                        2,
+                                        "FILENAME",
+                                        3,
+                                        "CATEGORY",
+                                        ball::Severity::e_WARN,
+                                        message.str().c_str(),
+                                        Z);
+            records.push_back(ball::Record(attr, ball::UserFields(), Z));
+        }
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            recordPtrs.push_back(&records[i]);
+        }
+
+        const ball::Context context(ball::Transmission::e_PASSTHROUGH, 0, 1);
+
+        if (verbose) cout << "\tCompare with per-record publication." << endl;
+        {
+            const bsl::string expFileName = tempFileName(veryVerbose);
+
+            Obj mE(Z);
+            ASSERT(0 == mE.enableFileLogging(expFileName.c_str()));
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                mE.publish(records[i], context);
+            }
+            mE.disableFileLogging();
+
+            const bsl::string EXPECTED = readWholeFile(expFileName);
+            ASSERT(!EXPECTED.empty());
+
+            const int BATCH_SIZES[] = { 1, 2, 7, 64, NUM_RECORDS };
+            const int NUM_BATCH_SIZES =
+                                 sizeof BATCH_SIZES / sizeof *BATCH_SIZES;
+
+            for (int ti = 0; ti < NUM_BATCH_SIZES; ++ti) {
+                const int BATCH_SIZE = BATCH_SIZES[ti];
+
+                if (veryVerbose) { T_ P(BATCH_SIZE) }
+
+                const bsl::string fileName = tempFileName(veryVerbose);
+
+                Obj mX(Z);
+                ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+                mX.publishBatch(&recordPtrs.front(), 0);
+                for (int i = 0; i < NUM_RECORDS; i += BATCH_SIZE) {
+                    const int n = bsl::min<int>(BATCH_SIZE, NUM_RECORDS - i);
+                    mX.publishBatch(&recordPtrs[i], n);
+                }
+                mX.disableFileLogging();
+
+                LOOP_ASSERT(BATCH_SIZE, EXPECTED == readWholeFile(fileName));
+
+                removeFilesByPrefix(fileName.c_str());
+            }
+
+            removeFilesByPrefix(expFileName.c_str());
+        }
+
+        if (verbose) cout << "\tFile logging disabled." << endl;
+        {
+            const bsl::string fileName = tempFileName(veryVerbose);
+
+            Obj mX(Z);
+            mX.publishBatch(&recordPtrs.front(), NUM_RECORDS);
+            ASSERT(!FileUtil::exists(fileName.c_str()));
+        }
+
+        if (verbose) cout << "\tRotation within a batch." << endl;
+        {
+            const bsl::string expFileName = tempFileName(veryVerbose);
+            const bsl::string fileName    = tempFileName(veryVerbose);
+
+            RotCb expCb(Z);
+            RotCb cb(Z);
+
+            Obj mE(Z);
+            mE.setOnFileRotationCallback(expCb);
+            mE.rotateOnSize(1);
+            ASSERT(0 == mE.enableFileLogging(expFileName.c_str()));
+
+            Obj mX(Z);
+            mX.setOnFileRotationCallback(cb);
+            mX.rotateOnSize(1);
+            ASSERT(0 == mX.enableFileLogging(fileName.c_str()));
+
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                mE.publish(records[i], context);
+            }
+            mX.publishBatch(&recordPtrs.front(), NUM_RECORDS);
+
+            mE.disableFileLogging();
+            mX.disableFileLogging();
+
+            ASSERTV(expCb.numInvocations(), 1 < expCb.numInvocations());
+            ASSERTV(expCb.numInvocations(),
+                    cb.numInvocations(),
+                    expCb.numInvocations() == cb.numInvocations());
+            ASSERT(0 == cb.status());
+
+            const bsl::string EXPECTED = readWholeFile(expFileName);
+            ASSERT(!EXPECTED.empty());
+            ASSERT(EXPECTED == readWholeFile(fileName));
+
+            removeFilesByPrefix(expFileName.c_str());
+            removeFilesByPrefix(fileName.c_str());
+        }
+      } break;
       case 12: {
         // --------------------------------------------------------------------
         // TESTING: Published Records Show Current Local-Time Offset
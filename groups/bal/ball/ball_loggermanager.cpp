@@ -22,6 +22,7 @@ BSLS_IDENT_RCSID(ball_loggermanager_cpp,"$Id$ $CSID$")
 #include <bdlt_datetime.h>
 #include <bdlt_datetimeutil.h>
 
+#include <bslma_deallocatorproctor.h>
 #include <bslma_default.h>
 #include <bslma_managedptr.h>
 
@@ -239,20 +240,23 @@ void copyAttributesWithoutMessage(ball::Record                  *record,
 
 // PRIVATE CREATORS
 Logger::Logger(
-           Observer                                   *observer,
-           RecordBuffer                               *recordBuffer,
-           const Logger::UserFieldsPopulatorCallback&  populator,
-           const PublishAllTriggerCallback&            publishAllCallback,
-           int                                         scratchBufferSize,
-           LoggerManagerConfiguration::LogOrder        logOrder,
-           LoggerManagerConfiguration::TriggerMarkers  triggerMarkers,
-           bslma::Allocator                           *globalAllocator)
+        Observer                                      *observer,
+        RecordBuffer                                  *recordBuffer,
+        const Logger::UserFieldsPopulatorCallback&     populator,
+        const PublishAllTriggerCallback&               publishAllCallback,
+        int                                            scratchBufferSize,
+        LoggerManagerConfiguration::LogOrder           logOrder,
+        LoggerManagerConfiguration::TriggerMarkers     triggerMarkers,
+        LoggerManagerConfiguration::MessageBufferMode  messageBufferMode,
+        bslma::Allocator                              *globalAllocator)
 : d_recordPool(-1, globalAllocator)
 , d_observer_p(observer)
 , d_recordBuffer_p(recordBuffer)
 , d_populator(populator)
 , d_publishAll(publishAllCallback)
 , d_scratchBufferSize(scratchBufferSize)
+, d_numScratchBuffers(LoggerManagerConfiguration::e_POOLED_MESSAGE_BUFFERS
+                      == messageBufferMode ? k_NUM_POOLED_MESSAGE_BUFFERS : 1)
 , d_logOrder(logOrder)
 , d_triggerMarkers(triggerMarkers)
 , d_allocator_p(globalAllocator)
@@ -261,8 +265,19 @@ Logger::Logger(
     BSLS_ASSERT(d_recordBuffer_p);
     BSLS_ASSERT(d_allocator_p);
 
-    // 'snprintf' message buffer
-    d_scratchBuffer_p = (char *)d_allocator_p->allocate(d_scratchBufferSize);
+    // 'snprintf' message buffers
+    d_scratchBuffer_p = (char *)d_allocator_p->allocate(
+                                    d_scratchBufferSize * d_numScratchBuffers);
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(d_scratchBuffer_p,
+                                                        d_allocator_p);
+
+    d_scratchBufferMutexes_p = static_cast<ScratchBufferMutex *>(
+                     d_allocator_p->allocate(d_numScratchBuffers
+                                             * sizeof(ScratchBufferMutex)));
+    for (int i = 0; i < d_numScratchBuffers; ++i) {
+        new (&d_scratchBufferMutexes_p[i].d_mutex) bslmt::Mutex();
+    }
+    proctor.release();
 }
 
 Logger::~Logger()
@@ -271,9 +286,14 @@ Logger::~Logger()
     BSLS_ASSERT(d_recordBuffer_p);
     BSLS_ASSERT(d_publishAll);
     BSLS_ASSERT(d_scratchBuffer_p);
+    BSLS_ASSERT(d_scratchBufferMutexes_p);
     BSLS_ASSERT(d_allocator_p);
 
     d_recordBuffer_p->removeAll();
+    for (int i = 0; i < d_numScratchBuffers; ++i) {
+        d_scratchBufferMutexes_p[i].d_mutex.~Mutex();
+    }
+    d_allocator_p->deallocate(d_scratchBufferMutexes_p);
     d_allocator_p->deallocate(d_scratchBuffer_p);
 }
 
@@ -469,10 +489,42 @@ void Logger::removeAll()
 
 char *Logger::obtainMessageBuffer(bslmt::Mutex **mutex, int *bufferSize)
 {
-    d_scratchBufferMutex.lock();
-    *mutex = &d_scratchBufferMutex;
+    int index = 0;
+
+    if (1 < d_numScratchBuffers) {
+        // Start from a buffer determined by the thread id, so that threads
+        // logging concurrently usually try different buffers, and take the
+        // first available one; block on the starting buffer only if none is
+        // available.  Thread ids are typically addresses of per-thread data,
+        // which differ mostly in their middle bits: fold them, then use a
+        // multiplicative hash.
+
+        const bsls::Types::Uint64 id   = bslmt::ThreadUtil::selfIdAsUint64();
+        const unsigned int        hash = static_cast<unsigned int>(
+                                              id ^ (id >> 32)) * 2654435769U;
+
+        const int start = static_cast<int>(hash >> 16) % d_numScratchBuffers;
+
+        index = -1;
+        for (int i = 0; i < d_numScratchBuffers; ++i) {
+            const int candidate = (start + i) % d_numScratchBuffers;
+            if (0 == d_scratchBufferMutexes_p[candidate].d_mutex.tryLock()) {
+                index = candidate;
+                break;
+            }
+        }
+        if (0 > index) {
+            index = start;
+            d_scratchBufferMutexes_p[index].d_mutex.lock();
+        }
+    }
+    else {
+        d_scratchBufferMutexes_p[0].d_mutex.lock();
+    }
+
+    *mutex = &d_scratchBufferMutexes_p[index].d_mutex;
     *bufferSize = d_scratchBufferSize;
-    return d_scratchBuffer_p;
+    return d_scratchBuffer_p + index * d_scratchBufferSize;
 }
 
 
@@ -482,6 +534,11 @@ int Logger::messageBufferSize() const
     return d_scratchBufferSize;
 }
 
+int Logger::numMessageBuffers() const
+{
+    return d_numScratchBuffers;
+}
+
 int Logger::numRecordsInUse() const
 {
     return d_recordPool.numObjects() -
@@ -699,6 +756,7 @@ void LoggerManager::constructObject(
                                             d_scratchBufferSize,
                                             d_logOrder,
                                             d_triggerMarkers,
+                                            d_messageBufferMode,
                                             d_allocator_p);
     d_loggers.insert(d_logger_p);
     d_defaultCategory_p = d_categoryManager.addCategory(
@@ -736,6 +794,7 @@ LoggerManager::LoggerManager(
 , d_defaultLoggers(bslma::Default::globalAllocator(globalAllocator))
 , d_logOrder(configuration.logOrder())
 , d_triggerMarkers(configuration.triggerMarkers())
+, d_messageBufferMode(configuration.messageBufferMode())
 , d_allocator_p(bslma::Default::globalAllocator(globalAllocator))
 {
     BSLS_ASSERT(observer);
@@ -790,6 +849,7 @@ Logger *LoggerManager::allocateLogger(RecordBuffer *buffer)
                                                 d_scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_messageBufferMode,
                                                 d_allocator_p);
     d_loggers.insert(logger);
 
@@ -808,6 +868,7 @@ Logger *LoggerManager::allocateLogger(RecordBuffer *buffer,
                                                 scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_messageBufferMode,
                                                 d_allocator_p);
     d_loggers.insert(logger);
 
@@ -826,6 +887,7 @@ Logger *LoggerManager::allocateLogger(RecordBuffer *buffer,
                                                 d_scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_messageBufferMode,
                                                 d_allocator_p);
     d_loggers.insert(logger);
 
@@ -845,6 +907,7 @@ Logger *LoggerManager::allocateLogger(RecordBuffer *buffer,
                                                 scratchBufferSize,
                                                 d_logOrder,
                                                 d_triggerMarkers,
+                                                d_messageBufferMode,
                                                 d_allocator_p);
 
     d_loggers.insert(logger);
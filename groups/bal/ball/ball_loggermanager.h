@@ -327,6 +327,20 @@ BSLS_IDENT("$Id: $")
 // have them share a common logger so that the trace-back log *does* include
 // all relevant records.
 //
+// The 'printf'-style logging macros (see 'ball_log') format their messages in
+// a buffer obtained from the logger of the calling thread (see
+// 'ball::Logger::obtainMessageBuffer'), to which the thread has exclusive
+// access while it formats the message.  By default, each logger has a single
+// such buffer, so that threads logging concurrently through the same logger
+// (e.g., the default logger) serialize on formatting their messages.  If the
+// 'messageBufferMode' attribute of the configuration supplied to the logger
+// manager is 'ball::LoggerManagerConfiguration::e_POOLED_MESSAGE_BUFFERS',
+// each logger instead has a pool of buffers, and threads logging concurrently
+// usually format their messages in different buffers, serializing only on the
+// hand-off of their records to the observer.  Note that the stream-style
+// logging macros format their messages directly in the log record, and are
+// not affected by this attribute.
+//
 ///'bsls::Log' Logging Redirection
 ///-------------------------------
 // The 'ball::LoggerManager' singleton, on construction, will redirect the
@@ -890,6 +904,10 @@ BSLS_IDENT("$Id: $")
 #include <bslmt_mutex.h>
 #endif
 
+#ifndef INCLUDED_BSLMT_PLATFORM
+#include <bslmt_platform.h>
+#endif
+
 #ifndef INCLUDED_BSLMT_RWMUTEX
 #include <bslmt_rwmutex.h>
 #endif
@@ -936,7 +954,22 @@ class Logger {
         // invoked with the publication cause to publish all record buffers of
         // all loggers that are allocated by the logger manager.
 
+    enum {
+        k_NUM_POOLED_MESSAGE_BUFFERS = 16  // number of message buffers of a
+                                           // logger in the
+                                           // 'e_POOLED_MESSAGE_BUFFERS' mode
+    };
+
   private:
+    // PRIVATE TYPES
+    struct ScratchBufferMutex {
+        // This 'struct' provides a mutex followed by enough padding that the
+        // mutexes of an array of this type never share a cache line.
+
+        bslmt::Mutex d_mutex;
+        char         d_padding[bslmt::Platform::e_CACHE_LINE_SIZE];
+    };
+
     // DATA
     bdlcc::ObjectPool<Record>
                           d_recordPool;         // pool of records
@@ -952,13 +985,22 @@ class Logger {
     PublishAllTriggerCallback
                           d_publishAll;         // publishAll callback functor
 
-    char                 *d_scratchBuffer_p;    // buffer for formatting log
-                                                // messages (owned)
+    char                 *d_scratchBuffer_p;    // 'd_numScratchBuffers'
+                                                // consecutive buffers for
+                                                // formatting log messages
+                                                // (owned)
 
     int                   d_scratchBufferSize;  // message buffer size (bytes)
 
-    bslmt::Mutex          d_scratchBufferMutex; // ensure thread-safety of
-                                                // message buffer
+    int                   d_numScratchBuffers;  // number of message buffers
+
+    ScratchBufferMutex   *d_scratchBufferMutexes_p;
+                                                // array of
+                                                // 'd_numScratchBuffers'
+                                                // mutexes, ensuring
+                                                // thread-safety of the
+                                                // respective message buffers
+                                                // (owned)
 
     LoggerManagerConfiguration::LogOrder
                           d_logOrder;           // logging order
@@ -977,27 +1019,30 @@ class Logger {
     Logger& operator=(const Logger&);
 
     // PRIVATE CREATORS
-    Logger(Observer                                   *observer,
-           RecordBuffer                               *recordBuffer,
-           const UserFieldsPopulatorCallback&          populator,
-           const PublishAllTriggerCallback&            publishAllCallback,
-           int                                         scratchBufferSize,
-           LoggerManagerConfiguration::LogOrder        logOrder,
-           LoggerManagerConfiguration::TriggerMarkers  triggerMarkers,
-           bslma::Allocator                           *globalAllocator);
+    Logger(Observer                                      *observer,
+           RecordBuffer                                  *recordBuffer,
+           const UserFieldsPopulatorCallback&             populator,
+           const PublishAllTriggerCallback&               publishAllCallback,
+           int                                            scratchBufferSize,
+           LoggerManagerConfiguration::LogOrder           logOrder,
+           LoggerManagerConfiguration::TriggerMarkers     triggerMarkers,
+           LoggerManagerConfiguration::MessageBufferMode  messageBufferMode,
+           bslma::Allocator                              *globalAllocator);
         // Create a logger having the specified 'observer' that receives
         // published log records, the specified 'recordBuffer' that stores log
         // records, the specified 'populator' that populates the user-defined
         // fields of log records, the specified 'publishAllCallback' that is
         // invoked when a Trigger-All event occurs, the specified
-        // 'scratchBufferSize' for the internal message buffer accessible via
+        // 'scratchBufferSize' for each internal message buffer accessible via
         // 'obtainMessageBuffer', and the specified 'globalAllocator' used to
         // supply memory.  On a Trigger or Trigger-All event, the messages are
-        // published in the specified 'logOrder'.  The behavior is undefined
-        // unless 'observer', 'recordBuffer', and 'globalAllocator' are
-        // non-null.  Note that this constructor is 'private' since the
-        // creation of instances of 'Logger' is managed by its 'friend'
-        // 'LoggerManager'.
+        // published in the specified 'logOrder'.  The specified
+        // 'messageBufferMode' indicates whether this logger has a single
+        // message buffer or a pool of 'k_NUM_POOLED_MESSAGE_BUFFERS' message
+        // buffers.  The behavior is undefined unless 'observer',
+        // 'recordBuffer', and 'globalAllocator' are non-null.  Note that this
+        // constructor is 'private' since the creation of instances of 'Logger'
+        // is managed by its 'friend' 'LoggerManager'.
 
     ~Logger();
         // Destroy this logger.
@@ -1099,7 +1144,7 @@ class Logger {
         // Remove all log records from the record buffer of this logger.
 
     char *obtainMessageBuffer(bslmt::Mutex **mutex, int *bufferSize);
-        // Block until access to the buffer of this logger used for formatting
+        // Block until access to a buffer of this logger used for formatting
         // messages is available.  Return the address of the modifiable buffer
         // to which this thread of execution has exclusive access, load the
         // address of the mutex that protects the buffer into the specified
@@ -1107,17 +1152,24 @@ class Logger {
         // the specified 'bufferSize' address.  The address remains valid, and
         // the buffer remains locked by this thread of execution, until this
         // thread calls 'mutex->unlock()'.  The behavior is undefined if this
-        // thread of execution currently holds a lock on the buffer.  Note that
-        // the buffer is intended to be used *only* for formatting log messages
-        // immediately before calling 'logMessage'; other use may adversely
-        // affect performance for the entire program.
+        // thread of execution currently holds a lock on a buffer of this
+        // logger.  Note that the buffer is intended to be used *only* for
+        // formatting log messages immediately before calling 'logMessage';
+        // other use may adversely affect performance for the entire program.
+        // Also note that, if this logger has a pool of message buffers (see
+        // 'numMessageBuffers'), threads obtaining a buffer concurrently
+        // usually obtain different buffers, and block only if none is
+        // available.
 
 
     // ACCESSORS
     int messageBufferSize() const;
-        // Return the size, in bytes, of the message buffer managed by this
+        // Return the size, in bytes, of each message buffer managed by this
         // logger.
 
+    int numMessageBuffers() const;
+        // Return the number of message buffers managed by this logger.
+
     int numRecordsInUse() const;
         // Return a *snapshot* of number of records that have been dispensed by
         // 'getRecord' but have not yet been supplied (returned) using
@@ -1227,6 +1279,10 @@ class LoggerManager {
     LoggerManagerConfiguration::TriggerMarkers
                            d_triggerMarkers;     // trigger markers
 
+    LoggerManagerConfiguration::MessageBufferMode
+                           d_messageBufferMode;  // message buffer mode of
+                                                 // allocated loggers
+
     bslma::Allocator      *d_allocator_p;        // memory allocator (held,
                                                  // not owned)
 
@@ -42,6 +42,7 @@
 #include <bsls_atomic.h>
 #include <bsls_log.h>
 #include <bsls_platform.h>
+#include <bsls_stopwatch.h>
 #include <bsls_types.h>
 
 #include <bslstl_stringref.h>
@@ -105,6 +106,7 @@ using namespace bdlf::PlaceHolders;
 // [ 7] char *obtainMessageBuffer(Mutex **mutex, int *bufferSize);
 // [ 7] char *messageBuffer();
 // [ 7] int messageBufferSize() const;
+// [30] int numMessageBuffers() const;
 // [27] int numRecordsInUse() const;
 //
 // 'ball::LoggerManager' private interface (tested indirectly):
@@ -170,6 +172,8 @@ using namespace bdlf::PlaceHolders;
 // [27] USAGE EXAMPLE #2
 // [28] USAGE EXAMPLE #3
 // [29] USAGE EXAMPLE #4
+// [30] TESTING: POOLED MESSAGE BUFFERS
+// [-2] PERFORMANCE TEST: MULTI-THREADED LOGGING THROUGHPUT
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -1287,6 +1291,193 @@ extern "C" {
 
 }  // close namespace BALL_LOGGERMANAGER_TEST_CASE_24
 
+//=============================================================================
+//                         CASE 30 RELATED ENTITIES
+//-----------------------------------------------------------------------------
+namespace BALL_LOGGERMANAGER_TEST_CASE_30 {
+
+void holdMessageBuffer(ball::Logger          *logger,
+                       const ball::Category  *category,
+                       bslmt::Barrier        *barrier,
+                       char                 **buffer)
+    // Obtain a message buffer from the specified 'logger', load its address
+    // into the specified 'buffer', format a message in it, and wait on the
+    // specified 'barrier' twice before logging the message to the specified
+    // 'category'.
+{
+    bslmt::Mutex *mutex;
+    int           bufferSize;
+
+    *buffer = logger->obtainMessageBuffer(&mutex, &bufferSize);
+    ASSERT(32 <= bufferSize);
+    bsl::sprintf(*buffer, "message in %p", static_cast<void *>(*buffer));
+
+    barrier->wait();  // all threads hold a buffer
+    barrier->wait();  // main thread has verified the buffers
+
+    bslmt::LockGuard<bslmt::Mutex> guard(mutex, 1);
+
+    logger->logMessage(*category,
+                       ball::Severity::e_WARN,
+                       __FILE__,
+                       __LINE__,
+                       *buffer);
+}
+
+}  // close namespace BALL_LOGGERMANAGER_TEST_CASE_30
+
+//=============================================================================
+//                         CASE -2 RELATED ENTITIES
+//-----------------------------------------------------------------------------
+namespace BALL_LOGGERMANAGER_TEST_CASE_MINUS_2 {
+
+enum {
+    NUM_MSGS = 100000  // number of messages logged by each thread
+};
+
+class CountingObserver : public ball::Observer {
+    // This concrete implementation of 'ball::Observer' counts the records
+    // published to it, from any thread, and otherwise ignores them, so that
+    // the cost of logging is not dominated by the cost of output.
+
+    bsls::AtomicInt d_count;
+
+  public:
+    // CREATORS
+    CountingObserver()
+    : d_count(0)
+    {
+    }
+
+    // MANIPULATORS
+    void publish(const bsl::shared_ptr<const ball::Record>&,
+                 const ball::Context&)
+    {
+        d_count.addRelaxed(1);
+    }
+
+    void releaseRecords()
+    {
+    }
+
+    // ACCESSORS
+    int count() const
+    {
+        return d_count.loadRelaxed();
+    }
+};
+
+void logPrintfStyle(ball::Logger         *logger,
+                    const ball::Category *category,
+                    bslmt::Barrier       *barrier,
+                    int                   id)
+    // Wait on the specified 'barrier', then log 'NUM_MSGS' messages
+    // identifying the specified 'id' to the specified 'category' through the
+    // specified 'logger', as the 'printf'-style logging macros do (i.e.,
+    // formatting each message in a message buffer of 'logger').
+{
+    barrier->wait();
+
+    for (int i = 0; i < NUM_MSGS; ++i) {
+        ball::Record *record = logger->getRecord(__FILE__, __LINE__);
+
+        bslmt::Mutex *mutex;
+        int           bufferSize;
+        char         *buffer = logger->obtainMessageBuffer(&mutex,
+                                                           &bufferSize);
+        {
+            bslmt::LockGuard<bslmt::Mutex> guard(mutex, 1);
+
+            bsl::sprintf(buffer,
+                         "thread %d message %d value %f",
+                         id,
+                         i,
+                         i * 0.5);
+            record->fixedFields().setMessage(buffer);
+        }
+        logger->logMessage(*category, ball::Severity::e_INFO, record);
+    }
+}
+
+void logStreamStyle(ball::Logger         *logger,
+                    const ball::Category *category,
+                    bslmt::Barrier       *barrier,
+                    int                   id)
+    // Wait on the specified 'barrier', then log 'NUM_MSGS' messages
+    // identifying the specified 'id' to the specified 'category' through the
+    // specified 'logger', as the stream-style logging macros do (i.e.,
+    // formatting each message in its record).
+{
+    barrier->wait();
+
+    for (int i = 0; i < NUM_MSGS; ++i) {
+        ball::Record *record = logger->getRecord(__FILE__, __LINE__);
+        {
+            bsl::ostream stream(&record->fixedFields().messageStreamBuf());
+            stream << "thread " << id << " message " << i
+                   << " value " << i * 0.5;
+        }
+        logger->logMessage(*category, ball::Severity::e_INFO, record);
+    }
+}
+
+typedef void (*LogFunction)(ball::Logger *,
+                            const ball::Category *,
+                            bslmt::Barrier *,
+                            int);
+
+double messagesPerSecond(
+              int                                                 numThreads,
+              ball::LoggerManagerConfiguration::MessageBufferMode mode,
+              LogFunction                                         function)
+    // Return the number of messages per second logged by the specified
+    // 'numThreads' threads, each executing the specified 'function' on the
+    // default logger of a logger manager configured with the specified
+    // message buffer 'mode' and an observer counting the published records.
+{
+    bslma::TestAllocator ta;
+    CountingObserver     observer;
+
+    ball::LoggerManagerConfiguration configuration;
+    configuration.setDefaultThresholdLevelsIfValid(
+                                           ball::Severity::e_OFF,   // record
+                                           ball::Severity::e_INFO,  // pass
+                                           ball::Severity::e_OFF,   // trigger
+                                           ball::Severity::e_OFF);  // all
+    configuration.setMessageBufferMode(mode);
+
+    ball::LoggerManager   mLM(configuration, &observer, &ta);
+    ball::Logger         *logger   = &mLM.getLogger();
+    const ball::Category *category = &mLM.defaultCategory();
+
+    bslmt::Barrier                         barrier(numThreads + 1);
+    bsl::vector<bslmt::ThreadUtil::Handle> handles(numThreads, &ta);
+
+    for (int i = 0; i < numThreads; ++i) {
+        ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                              bdlf::BindUtil::bind(function,
+                                                                   logger,
+                                                                   category,
+                                                                   &barrier,
+                                                                   i)));
+    }
+
+    bsls::Stopwatch timer;
+    timer.start();
+    barrier.wait();
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+    timer.stop();
+
+    ASSERTV(numThreads, observer.count(),
+            numThreads * NUM_MSGS == observer.count());
+
+    return static_cast<double>(numThreads) * NUM_MSGS / timer.elapsedTime();
+}
+
+}  // close namespace BALL_LOGGERMANAGER_TEST_CASE_MINUS_2
+
 //=============================================================================
 //                  GLOBAL HELPER FUNCTIONS FOR TESTING
 //-----------------------------------------------------------------------------
@@ -1339,6 +1530,129 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;;
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 30: {
+        // --------------------------------------------------------------------
+        // TESTING: POOLED MESSAGE BUFFERS
+        //
+        // Concerns:
+        //: 1 By default, a logger has a single message buffer.
+        //:
+        //: 2 In the 'e_POOLED_MESSAGE_BUFFERS' message buffer mode, the
+        //:   default logger and the allocated loggers have
+        //:   'k_NUM_POOLED_MESSAGE_BUFFERS' message buffers of the configured
+        //:   size.
+        //:
+        //: 3 Threads holding a message buffer concurrently hold different
+        //:   buffers, as long as there are no more of them than buffers.
+        //:
+        //: 4 The messages formatted in the buffers are logged.
+        //:
+        //: 5 The buffers are released by the destruction of the logger.
+        //
+        // Plan:
+        //: 1 Verify the number of message buffers of loggers in the default
+        //:   and in the 'e_POOLED_MESSAGE_BUFFERS' modes.  (C-1..2)
+        //:
+        //: 2 Have as many threads as buffers obtain a buffer and format a
+        //:   message, and verify, while they all hold their buffer, that the
+        //:   buffers are distinct; then have the threads log their message,
+        //:   and verify the number of published records.  (C-3..4)
+        //:
+        //: 3 Use a test allocator for the logger manager, and verify that
+        //:   no memory is in use after its destruction.  (C-5)
+        //
+        // Testing:
+        //   int numMessageBuffers() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING: POOLED MESSAGE BUFFERS" << endl
+                                  << "===============================" << endl;
+
+        using namespace BALL_LOGGERMANAGER_TEST_CASE_30;
+
+        typedef ball::LoggerManagerConfiguration Config;
+
+        const int NUM_BUFFERS = ball::Logger::k_NUM_POOLED_MESSAGE_BUFFERS;
+        const int BUFFER_SIZE = 256;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        for (int pooled = 0; pooled < 2; ++pooled) {
+            if (veryVerbose) { T_ P(pooled) }
+
+            ball::TestObserver observer(cout);
+
+            Config configuration;
+            ASSERT(Config::e_SHARED_MESSAGE_BUFFER ==
+                                            configuration.messageBufferMode());
+
+            configuration.setDefaultLoggerBufferSizeIfValid(BUFFER_SIZE);
+            configuration.setDefaultThresholdLevelsIfValid(
+                                                      0,
+                                                      ball::Severity::e_WARN,
+                                                      0,
+                                                      0);
+            if (pooled) {
+                configuration.setMessageBufferMode(
+                                             Config::e_POOLED_MESSAGE_BUFFERS);
+            }
+
+            const int EXP_NUM_BUFFERS = pooled ? NUM_BUFFERS : 1;
+            {
+                Obj mLM(configuration, &observer, &ta);
+
+                ball::Logger& defaultLogger = mLM.getLogger();
+                ASSERTV(pooled, EXP_NUM_BUFFERS ==
+                                            defaultLogger.numMessageBuffers());
+                ASSERTV(pooled, BUFFER_SIZE ==
+                                            defaultLogger.messageBufferSize());
+
+                ball::FixedSizeRecordBuffer recordBuffer(1024, &ta);
+                ball::Logger *logger = mLM.allocateLogger(&recordBuffer, 64);
+                ASSERTV(pooled, EXP_NUM_BUFFERS ==
+                                                  logger->numMessageBuffers());
+                ASSERTV(pooled, 64 == logger->messageBufferSize());
+                mLM.deallocateLogger(logger);
+
+                if (pooled) {
+                    bslmt::Barrier            barrier(NUM_BUFFERS + 1);
+                    bsl::vector<char *>       buffers(NUM_BUFFERS,
+                                                      static_cast<char *>(0),
+                                                      &ta);
+                    bslmt::ThreadUtil::Handle handles[NUM_BUFFERS];
+
+                    const ball::Category *CATEGORY = &mLM.defaultCategory();
+
+                    for (int i = 0; i < NUM_BUFFERS; ++i) {
+                        ASSERT(0 == bslmt::ThreadUtil::create(
+                                     &handles[i],
+                                     bdlf::BindUtil::bind(&holdMessageBuffer,
+                                                          &defaultLogger,
+                                                          CATEGORY,
+                                                          &barrier,
+                                                          &buffers[i])));
+                    }
+
+                    barrier.wait();
+
+                    bsl::vector<char *> sorted(buffers, &ta);
+                    bsl::sort(sorted.begin(), sorted.end());
+                    for (int i = 1; i < NUM_BUFFERS; ++i) {
+                        ASSERTV(i, sorted[i - 1] + BUFFER_SIZE <= sorted[i]);
+                    }
+
+                    barrier.wait();
+
+                    for (int i = 0; i < NUM_BUFFERS; ++i) {
+                        bslmt::ThreadUtil::join(handles[i]);
+                    }
+
+                    ASSERT(NUM_BUFFERS == observer.numPublishedRecords());
+                }
+            }
+            ASSERTV(pooled, 0 == ta.numBytesInUse());
+        }
+      } break;
       case 29: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE #4
@@ -4624,6 +4938,61 @@ int main(int argc, char *argv[])
         ball::LoggerManager::shutDownSingleton();
 
       } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: MULTI-THREADED LOGGING THROUGHPUT
+        //
+        // Concerns:
+        //: 1 The throughput of threads logging concurrently through the same
+        //:   logger, with messages formatted in the message buffers of the
+        //:   logger, scales with the number of threads when the logger has a
+        //:   pool of message buffers.
+        //
+        // Plan:
+        //: 1 For 1, 2, 4, 8, and 16 threads, have each thread log a fixed
+        //:   number of messages through the default logger to an observer
+        //:   counting the published records, as the 'printf'-style logging
+        //:   macros do with a shared message buffer and with pooled message
+        //:   buffers, and as the stream-style logging macros do, for
+        //:   reference.  Report the number of messages per second, and verify
+        //:   the number of published records.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: MULTI-THREADED LOGGING THROUGHPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST: MULTI-THREADED LOGGING"
+                          << " THROUGHPUT" << endl
+                          << "========================================"
+                          << "===========" << endl;
+
+        using namespace BALL_LOGGERMANAGER_TEST_CASE_MINUS_2;
+
+        typedef ball::LoggerManagerConfiguration Config;
+
+        cout << "threads    printf (shared)    printf (pooled)    stream"
+             << endl;
+
+        for (int numThreads = 1; numThreads <= 16; numThreads *= 2) {
+            const double shared = messagesPerSecond(
+                                               numThreads,
+                                               Config::e_SHARED_MESSAGE_BUFFER,
+                                               &logPrintfStyle);
+            const double pooled = messagesPerSecond(
+                                              numThreads,
+                                              Config::e_POOLED_MESSAGE_BUFFERS,
+                                              &logPrintfStyle);
+            const double stream = messagesPerSecond(
+                                               numThreads,
+                                               Config::e_SHARED_MESSAGE_BUFFER,
+                                               &logStreamStyle);
+
+            bsl::printf("%7d    %15.0f    %15.0f    %6.0f\n",
+                        numThreads, shared, pooled, stream);
+        }
+        cout << "(messages per second)" << endl;
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
@@ -58,6 +58,7 @@ LoggerManagerConfiguration::LoggerManagerConfiguration(
                 bsl::allocator<DefaultThresholdLevelsCallback>(basicAllocator))
 , d_logOrder(e_LIFO)
 , d_triggerMarkers(e_BEGIN_END_MARKERS)
+, d_messageBufferMode(e_SHARED_MESSAGE_BUFFER)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
@@ -79,6 +80,7 @@ LoggerManagerConfiguration::LoggerManagerConfiguration(
                 original.d_defaultThresholdsCb)
 , d_logOrder(original.d_logOrder)
 , d_triggerMarkers(original.d_triggerMarkers)
+, d_messageBufferMode(original.d_messageBufferMode)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
 }
@@ -93,6 +95,7 @@ LoggerManagerConfiguration::operator=(const LoggerManagerConfiguration& rhs)
     d_defaultThresholdsCb = rhs.d_defaultThresholdsCb;
     d_logOrder            = rhs.d_logOrder;
     d_triggerMarkers      = rhs.d_triggerMarkers;
+    d_messageBufferMode   = rhs.d_messageBufferMode;
 
     return *this;
 }
@@ -159,6 +162,11 @@ void LoggerManagerConfiguration::setTriggerMarkers(TriggerMarkers value)
     d_triggerMarkers = value;
 }
 
+void LoggerManagerConfiguration::setMessageBufferMode(MessageBufferMode value)
+{
+    d_messageBufferMode = value;
+}
+
 // ACCESSORS
 const LoggerManagerDefaults& LoggerManagerConfiguration::defaults() const
 {
@@ -225,6 +233,12 @@ LoggerManagerConfiguration::triggerMarkers() const
     return d_triggerMarkers;
 }
 
+LoggerManagerConfiguration::MessageBufferMode
+LoggerManagerConfiguration::messageBufferMode() const
+{
+    return d_messageBufferMode;
+}
+
 bsl::ostream&
 LoggerManagerConfiguration::print(bsl::ostream& stream,
                                   int           level,
@@ -272,6 +286,12 @@ LoggerManagerConfiguration::print(bsl::ostream& stream,
                                                  : "BEGIN_END_MARKERS";
     stream << "Trigger markers are " << triggerMarker << NL;
 
+    bdlb::Print::indent(stream, level + 1, spacesPerLevel);
+    const char *bufferMode = d_messageBufferMode == e_SHARED_MESSAGE_BUFFER
+                                                 ? "SHARED_MESSAGE_BUFFER"
+                                                 : "POOLED_MESSAGE_BUFFERS";
+    stream << "Message buffers are " << bufferMode << NL;
+
     bdlb::Print::indent(stream, level, spacesPerLevel);
     stream << ']' << NL;
 
@@ -295,7 +315,8 @@ bool ball::operator==(const ball::LoggerManagerConfiguration& lhs,
         && (bool)lhs.d_categoryNameFilter  == (bool)rhs.d_categoryNameFilter
         && (bool)lhs.d_defaultThresholdsCb == (bool)rhs.d_defaultThresholdsCb
         && lhs.d_logOrder                  == rhs.d_logOrder
-        && lhs.d_triggerMarkers            == rhs.d_triggerMarkers;
+        && lhs.d_triggerMarkers            == rhs.d_triggerMarkers
+        && lhs.d_messageBufferMode         == rhs.d_messageBufferMode;
 }
 
 bool ball::operator!=(const ball::LoggerManagerConfiguration& lhs,
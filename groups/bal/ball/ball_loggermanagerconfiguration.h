@@ -64,6 +64,8 @@ BSLS_IDENT("$Id: $")
 //
 //  TriggerMarkers                               triggerMarkers
 //
+//  MessageBufferMode                            messageBufferMode
+//
 //  NAME                            DESCRIPTION
 //  -------------------             -------------------------------------------
 //  defaults                        constrained defaults for buffer size and
@@ -92,6 +94,14 @@ BSLS_IDENT("$Id: $")
 //                                  sequence of records logged due to a Trigger
 //                                  or Trigger-All event; default is
 //                                  'e_BEGIN_END_MARKERS'.
+//
+//  messageBufferMode               defines whether each logger formats the
+//                                  messages of the 'printf'-style logging
+//                                  macros in a single buffer shared by all
+//                                  threads, or in one of a pool of buffers,
+//                                  so that threads logging concurrently
+//                                  rarely wait for each other; default is
+//                                  'e_SHARED_MESSAGE_BUFFER'.
 //..
 // The constraints are as follows:
 //..
@@ -109,6 +119,8 @@ BSLS_IDENT("$Id: $")
 //  +--------------------------------+--------------------------------+
 //  | triggerMarkers                 | (none)                         |
 //  +--------------------------------+--------------------------------+
+//  | messageBufferMode              | (none)                         |
+//  +--------------------------------+--------------------------------+
 //..
 // For convenience, the 'ball::LoggerManagerConfiguration' interface contains
 // manipulators and accessors to configure and inspect the value of its
@@ -203,6 +215,7 @@ BSLS_IDENT("$Id: $")
 //      Default Threshold Callback functor is null
 //      Logging order is FIFO
 //      Trigger markers are NO_MARKERS
+//      Message buffers are SHARED_MESSAGE_BUFFER
 //  ]
 //..
 
@@ -309,6 +322,27 @@ class LoggerManagerConfiguration {
 
     };
 
+    enum MessageBufferMode {
+        // The 'MessageBufferMode' enumeration defines how a logger provides
+        // the buffers in which the 'printf'-style logging macros format their
+        // messages (see 'ball::Logger::obtainMessageBuffer').  A thread has
+        // exclusive access to a buffer, under a mutex, while it formats a
+        // message.  If this attribute is 'e_SHARED_MESSAGE_BUFFER', a logger
+        // has a single such buffer, and threads logging concurrently through
+        // the same logger serialize on its mutex.  If this attribute is
+        // 'e_POOLED_MESSAGE_BUFFERS', a logger has a pool of such buffers,
+        // each protected by its own mutex, and a thread formats its message
+        // in the first available buffer of the pool, starting from one
+        // determined by its thread id, so that only the hand-off of the
+        // record to the observer is serialized.  The default value of this
+        // attribute is 'e_SHARED_MESSAGE_BUFFER'.
+
+        e_SHARED_MESSAGE_BUFFER,  // a single buffer per logger (default)
+
+        e_POOLED_MESSAGE_BUFFERS  // a pool of buffers per logger
+
+    };
+
   private:
     // DATA
     LoggerManagerDefaults d_defaults;             // default buffer size for
@@ -336,6 +370,8 @@ class LoggerManagerConfiguration {
 
     TriggerMarkers        d_triggerMarkers;       // trigger marker
 
+    MessageBufferMode     d_messageBufferMode;    // message buffer mode
+
     bslma::Allocator     *d_allocator_p;          // memory allocator (held,
                                                   // not owned)
 
@@ -458,6 +494,10 @@ class LoggerManagerConfiguration {
         // Set the trigger marker attribute of this object to the specified
         // 'value'.
 
+    void setMessageBufferMode(MessageBufferMode value);
+        // Set the message buffer mode attribute of this object to the
+        // specified 'value'.
+
     // ACCESSORS
     const LoggerManagerDefaults& defaults() const;
         // Return a reference to the non-modifiable defaults object attribute
@@ -508,6 +548,10 @@ class LoggerManagerConfiguration {
         // Return the trigger marker attribute of this object.  See attributes
         // description for effects of the trigger markers.
 
+    MessageBufferMode messageBufferMode() const;
+        // Return the message buffer mode attribute of this object.  See
+        // attributes description for effects of the message buffer mode.
+
     bsl::ostream& print(bsl::ostream& stream,
                         int           level          = 0,
                         int           spacesPerLevel = 4) const;
@@ -54,6 +54,7 @@ using namespace bsl;  // automatically added by script
 // [ 1] void setDefaultValues(const ball::LMD& defaults);
 // [ 5] void setLogOrder(LogOrder value);
 // [ 6] void setTriggerMarkers(TriggerMarkers value);
+// [ 7] void setMessageBufferMode(MessageBufferMode value);
 // [ 1] void setUserFieldsPopulatorCallback(const Populator&);
 // [ 1] void setCategoryNameFilterCallback(const CNF& nameFilter);
 // [ 1] void setDefaultThresholdLevelsCallback(const DTC& );
@@ -61,6 +62,7 @@ using namespace bsl;  // automatically added by script
 // [ 1] const ball::LMD& defaults() const;
 // [ 5] const LogOrder logOrder() const;
 // [ 6] const TriggerMarkers triggerMarkers() const;
+// [ 7] MessageBufferMode messageBufferMode() const;
 // [ 1] const Populator& userFieldsPopulatorCallback() const;
 // [ 1] const CNF& categoryNameFilterCallback() const;
 // [ 1] const DTC& defaultThresholdLevelsCallback() const;
@@ -70,7 +72,7 @@ using namespace bsl;  // automatically added by script
 // [ 1] bool operator!=(const ball::LMC& lhs, const ball::LMC& rhs);
 // [ 1] bsl::ostream& operator<<(bsl::ostream&, const ball::LMC);
 //-----------------------------------------------------------------------------
-// [ 7] USAGE EXAMPLE
+// [ 8] USAGE EXAMPLE
 //-----------------------------------------------------------------------------
 
 // ============================================================================
@@ -223,6 +225,7 @@ typedef bsl::function<void(int *, int *, int *, int *, const char*)> DtCb;
 //      Default Threshold Callback functor is null
 //      Logging order is FIFO
 //      Trigger markers are NO_MARKERS
+//      Message buffers are SHARED_MESSAGE_BUFFER
 //  ]
 //..
 
@@ -309,7 +312,7 @@ int main(int argc, char *argv[])
     const DtCb   DTCB1(dtCb1);
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 7: {
+      case 8: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //   The usage example provided in the component header file must
@@ -328,6 +331,57 @@ int main(int argc, char *argv[])
 
         initializeConfiguration(verbose);
 
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // TESTING  'setMessageBufferMode' AND 'messageBufferMode':
+        //   Verify 'setMessageBufferMode' and 'messageBufferMode'.
+        //
+        // Concern:
+        //   That 'setMessageBufferMode' and 'messageBufferMode' work
+        //   correctly, and that the attribute participates in equality
+        //   comparison, copy construction, and assignment.
+        //
+        // Plan:
+        //   1. Create a configuration and verify 'messageBufferMode'.
+        //   2. Invoke 'setMessageBufferMode' with 'e_POOLED_MESSAGE_BUFFERS'
+        //      and verify 'messageBufferMode'.
+        //   3. Verify that the configuration differs from a default one, and
+        //      equals its copies.
+        //   4. Invoke 'setMessageBufferMode' with 'e_SHARED_MESSAGE_BUFFER'
+        //      and verify 'messageBufferMode'.
+        //
+        // Testing:
+        //   void setMessageBufferMode(MessageBufferMode value);
+        //   MessageBufferMode messageBufferMode() const;
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << "\nTESTING 'setMessageBufferMode' AND 'messageBufferMode'"
+                 << "\n===================================================="
+                 << "=\n";
+
+        Obj lmc;
+        ASSERT(lmc.messageBufferMode() == Obj::e_SHARED_MESSAGE_BUFFER);
+
+        lmc.setMessageBufferMode(Obj::e_POOLED_MESSAGE_BUFFERS);
+        ASSERT(lmc.messageBufferMode() == Obj::e_POOLED_MESSAGE_BUFFERS);
+
+        const Obj DEFAULT;
+        ASSERT(DEFAULT != lmc);
+
+        const Obj COPY(lmc);
+        ASSERT(COPY == lmc);
+        ASSERT(COPY.messageBufferMode() == Obj::e_POOLED_MESSAGE_BUFFERS);
+
+        Obj assigned;
+        assigned = lmc;
+        ASSERT(assigned == lmc);
+
+        lmc.setMessageBufferMode(Obj::e_SHARED_MESSAGE_BUFFER);
+        ASSERT(lmc.messageBufferMode() == Obj::e_SHARED_MESSAGE_BUFFER);
+        ASSERT(DEFAULT == lmc);
+
       } break;
       case 6: {
         // --------------------------------------------------------------------
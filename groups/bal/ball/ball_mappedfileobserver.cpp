@@ -0,0 +1,310 @@
+// ball_mappedfileobserver.cpp                                        -*-C++-*-
+#include <ball_mappedfileobserver.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(ball_mappedfileobserver_cpp,"$Id$ $CSID$")
+
+#include <ball_binaryrecordutil.h>
+#include <ball_context.h>
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+
+#include <bdls_memoryutil.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bsls_assert.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_climits.h>
+#include <bsl_cstdio.h>
+
+namespace BloombergLP {
+namespace ball {
+
+                          // ------------------------
+                          // class MappedFileObserver
+                          // ------------------------
+
+// PRIVATE MANIPULATORS
+void MappedFileObserver::closeSegment()
+{
+    if (d_segment_p) {
+        bdls::FilesystemUtil::unmap(d_segment_p, d_mappedSize);
+        bdls::FilesystemUtil::close(d_descriptor);
+
+        d_segment_p  = 0;
+        d_descriptor = bdls::FilesystemUtil::k_INVALID_FD;
+        d_mappedSize = 0;
+        d_offset     = 0;
+    }
+    d_stringIds.clear();
+    d_strings.clear();
+}
+
+int MappedFileObserver::openSegment(bsl::size_t minimumSize)
+{
+    BSLS_ASSERT(0 == d_segment_p);
+
+    typedef bdls::FilesystemUtil FileUtil;
+
+    const bsl::size_t size = bsl::max<bsl::size_t>(
+                       d_segmentSize,
+                       BinaryRecordUtil::k_HEADER_SIZE
+                           + bsl::max<bsl::size_t>(
+                                             minimumSize,
+                                             BinaryRecordUtil::k_FRAME_SIZE));
+
+    FileDescriptor descriptor;
+    do {
+        char suffix[16];
+        bsl::sprintf(suffix, ".%d", ++d_sequenceNumber);
+
+        d_segmentName  = d_baseName;
+        d_segmentName += suffix;
+    } while (FileUtil::exists(d_segmentName));
+
+    descriptor = FileUtil::open(d_segmentName,
+                                FileUtil::e_CREATE,
+                                FileUtil::e_READ_WRITE);
+    if (FileUtil::k_INVALID_FD == descriptor) {
+        bsl::fprintf(stderr,
+                     "Cannot create binary log segment %s\n",
+                     d_segmentName.c_str());
+        return -1;                                                    // RETURN
+    }
+
+    void *address = 0;
+    if (0 != FileUtil::growFile(descriptor,
+                                static_cast<FileUtil::Offset>(size))
+     || 0 != FileUtil::map(descriptor,
+                           &address,
+                           0,
+                           size,
+                           bdls::MemoryUtil::k_ACCESS_READ_WRITE)) {
+        bsl::fprintf(stderr,
+                     "Cannot map binary log segment %s\n",
+                     d_segmentName.c_str());
+        FileUtil::close(descriptor);
+        FileUtil::remove(d_segmentName);
+        return -2;                                                    // RETURN
+    }
+
+    d_descriptor = descriptor;
+    d_segment_p  = static_cast<char *>(address);
+    d_mappedSize = size;
+    d_offset     = BinaryRecordUtil::k_HEADER_SIZE;
+
+    BinaryRecordUtil::writeHeader(d_segment_p);
+    BinaryRecordUtil::writeEndOfData(d_segment_p + d_offset);
+    return 0;
+}
+
+int MappedFileObserver::stringId(bsl::size_t              *entrySize,
+                                 const bslstl::StringRef&  value)
+{
+    StringIdMap::const_iterator it = d_stringIds.find(value);
+    if (d_stringIds.end() != it) {
+        return it->second;                                            // RETURN
+    }
+
+    const int id = static_cast<int>(d_strings.size());
+    d_strings.resize(d_strings.size() + 1);
+    d_strings.back().assign(value.begin(), value.end());
+    d_stringIds[d_strings.back()] = id;
+
+    *entrySize += BinaryRecordUtil::stringEntrySize(value);
+    return id;
+}
+
+// CREATORS
+MappedFileObserver::MappedFileObserver(bslma::Allocator *basicAllocator)
+: d_baseName(basicAllocator)
+, d_segmentName(basicAllocator)
+, d_sequenceNumber(0)
+, d_descriptor(bdls::FilesystemUtil::k_INVALID_FD)
+, d_segment_p(0)
+, d_mappedSize(0)
+, d_offset(0)
+, d_segmentSize(k_DEFAULT_SEGMENT_SIZE)
+, d_strings(basicAllocator)
+, d_stringIds(basicAllocator)
+{
+}
+
+MappedFileObserver::~MappedFileObserver()
+{
+    closeSegment();
+}
+
+// MANIPULATORS
+void MappedFileObserver::disableFileLogging()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    closeSegment();
+    d_baseName.clear();
+}
+
+int MappedFileObserver::enableFileLogging(const char *baseName)
+{
+    BSLS_ASSERT(baseName);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (d_segment_p) {
+        return 1;                                                     // RETURN
+    }
+
+    d_baseName       = baseName;
+    d_sequenceNumber = 0;
+
+    if (0 != openSegment(0)) {
+        d_baseName.clear();
+        return -1;                                                    // RETURN
+    }
+    return 0;
+}
+
+void MappedFileObserver::forceRotation()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (d_segment_p) {
+        closeSegment();
+        if (0 != openSegment(0)) {
+            d_baseName.clear();
+        }
+    }
+}
+
+void MappedFileObserver::publish(const Record& record, const Context&)
+{
+    const RecordAttributes& attributes = record.fixedFields();
+    const bslstl::StringRef category(attributes.category());
+    const bslstl::StringRef fileName(attributes.fileName());
+    const bsl::size_t       recordSize =
+                                    BinaryRecordUtil::recordEntrySize(record);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (!d_segment_p) {
+        return;                                                       // RETURN
+    }
+
+    // Assign the identifiers, computing the size of the string entries to be
+    // written for strings new to the current segment.  If the entries do not
+    // fit, continue with the next segment, and assign them again there.
+
+    bsl::size_t numStrings  = d_strings.size();
+    bsl::size_t stringsSize = 0;
+    int         categoryId  = stringId(&stringsSize, category);
+    int         fileNameId  = stringId(&stringsSize, fileName);
+
+    if (d_mappedSize - d_offset
+                 < stringsSize + recordSize + BinaryRecordUtil::k_FRAME_SIZE) {
+        closeSegment();
+
+        const bsl::size_t maximumSize =
+                                   BinaryRecordUtil::stringEntrySize(category)
+                                 + BinaryRecordUtil::stringEntrySize(fileName)
+                                 + recordSize
+                                 + BinaryRecordUtil::k_FRAME_SIZE;
+        if (0 != openSegment(maximumSize)) {
+            d_baseName.clear();
+            return;                                                   // RETURN
+        }
+
+        numStrings  = 0;
+        stringsSize = 0;
+        categoryId  = stringId(&stringsSize, category);
+        fileNameId  = stringId(&stringsSize, fileName);
+    }
+
+    // Write the new entries over the current end-of-data marker, and follow
+    // them with a new marker.
+
+    char *cursor = d_segment_p + d_offset;
+
+    if (numStrings <= static_cast<bsl::size_t>(categoryId)) {
+        cursor = BinaryRecordUtil::writeStringEntry(cursor,
+                                                    categoryId,
+                                                    category);
+    }
+    if (numStrings <= static_cast<bsl::size_t>(fileNameId)
+     && fileNameId != categoryId) {
+        cursor = BinaryRecordUtil::writeStringEntry(cursor,
+                                                    fileNameId,
+                                                    fileName);
+    }
+    cursor = BinaryRecordUtil::writeRecordEntry(cursor,
+                                                record,
+                                                categoryId,
+                                                fileNameId);
+    BinaryRecordUtil::writeEndOfData(cursor);
+
+    d_offset = cursor - d_segment_p;
+}
+
+void MappedFileObserver::publish(const bsl::shared_ptr<const Record>& record,
+                                 const Context&                       context)
+{
+    publish(*record, context);
+}
+
+void MappedFileObserver::setSegmentSize(bsl::size_t numBytes)
+{
+    BSLS_ASSERT(0 < numBytes);
+    BSLS_ASSERT(numBytes <= static_cast<bsl::size_t>(INT_MAX));
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    d_segmentSize = numBytes;
+}
+
+// ACCESSORS
+bool MappedFileObserver::isFileLoggingEnabled() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return 0 != d_segment_p;
+}
+
+bool MappedFileObserver::isFileLoggingEnabled(bsl::string *result) const
+{
+    BSLS_ASSERT(result);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (d_segment_p) {
+        *result = d_segmentName;
+        return true;                                                  // RETURN
+    }
+    return false;
+}
+
+bsl::size_t MappedFileObserver::segmentSize() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_segmentSize;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,371 @@
+// ball_mappedfileobserver.h                                          -*-C++-*-
+#ifndef INCLUDED_BALL_MAPPEDFILEOBSERVER
+#define INCLUDED_BALL_MAPPEDFILEOBSERVER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an observer writing binary log records to mapped files.
+//
+//@CLASSES:
+//  ball::MappedFileObserver: observer appending binary records to segments
+//
+//@SEE_ALSO: ball_binaryrecordutil, ball_binarylogdecoder, ball_fileobserver2
+//
+//@DESCRIPTION: This component provides a concrete implementation of the
+// 'ball::Observer' protocol, 'ball::MappedFileObserver', that writes the log
+// records it receives, in the binary format defined by
+// 'ball_binaryrecordutil', to a sequence of memory-mapped *segment* files:
+//..
+//                ,------------------------.
+//               ( ball::MappedFileObserver )
+//                `------------------------'
+//                             |             ctor
+//                             |             disableFileLogging
+//                             |             enableFileLogging
+//                             |             forceRotation
+//                             |             setSegmentSize
+//                             |             isFileLoggingEnabled
+//                             |             segmentSize
+//                             V
+//                      ,--------------.
+//                     ( ball::Observer )
+//                      `--------------'
+//                                           dtor
+//                                           publish
+//                                           releaseRecords
+//..
+// Unlike the text-based file observers (see 'ball_fileobserver2'), this
+// observer does not format the records it publishes: the fixed fields of a
+// record are copied into the current segment as integers, its category and
+// file name are written to each segment only once and thereafter referred to
+// by an integer identifier, and its message and user fields are copied
+// verbatim.  Publishing a record therefore costs little more than copying its
+// message into memory, with no system call in the common case.  The segments
+// are rendered as text offline, by 'ball::BinaryLogDecoder'.
+//
+///Segment Files
+///-------------
+// File logging is enabled by calling 'enableFileLogging' with a *base* *name*.
+// Each segment is named by appending a period and a sequence number to the
+// base name (e.g., "server.log.1", "server.log.2", ...); the first segment
+// takes the lowest sequence number for which no file exists, so that enabling
+// file logging never overwrites an existing segment.
+//
+// A segment is created at its full size ('segmentSize', 64MB by default) and
+// mapped into memory in its entirety.  When a record does not fit in the
+// remaining space of the current segment, the segment is closed and the next
+// one created; a record larger than 'segmentSize' is written to a segment of
+// its own, created large enough to hold it.  Each segment is self-contained,
+// and can be decoded independently of the others.
+//
+// Each record is followed by an end-of-data marker, so that a segment that was
+// never closed (e.g., because the process terminated abnormally) can be
+// decoded up to its last complete record.  Note that the unused tail of a
+// segment is not truncated when the segment is closed.
+//
+///Thread Safety
+///-------------
+// 'ball::MappedFileObserver' is fully *thread-safe*, meaning that all
+// non-creator operations on an object can be safely invoked simultaneously
+// from multiple threads.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Publishing Records to Binary Segments
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// In this example, we publish a record to binary segment files and then
+// inspect the resulting segment.
+//
+// First, we create an observer and enable file logging, supplying the base
+// name of the segment files:
+//..
+//  ball::MappedFileObserver observer;
+//  observer.setSegmentSize(1024 * 1024);
+//
+//  int rc = observer.enableFileLogging(baseName.c_str());
+//  assert(0 == rc);
+//
+//  bsl::string segmentName;
+//  assert(true            == observer.isFileLoggingEnabled(&segmentName));
+//  assert(baseName + ".1" == segmentName);
+//..
+// Then, we publish a record:
+//..
+//  ball::RecordAttributes attributes(bdlt::Datetime(2018, 5, 1, 12, 30),
+//                                    1234,
+//                                    5678,
+//                                    "server.cpp",
+//                                    42,
+//                                    "SERVER",
+//                                    ball::Severity::e_INFO,
+//                                    "request complete");
+//  bsl::shared_ptr<const ball::Record> record =
+//             bsl::make_shared<ball::Record>(attributes, ball::UserFields());
+//
+//  observer.publish(record,
+//                   ball::Context(ball::Transmission::e_PASSTHROUGH, 0, 1));
+//..
+// Finally, we close the segment, which holds a header, the category and file
+// name of the record, and the record itself:
+//..
+//  observer.disableFileLogging();
+//  assert(false == observer.isFileLoggingEnabled());
+//
+//  assert(1024 * 1024 == bdls::FilesystemUtil::getFileSize(segmentName));
+//..
+// The segment can now be rendered as text by a 'ball::BinaryLogDecoder' (see
+// 'ball_binarylogdecoder').
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BALL_OBSERVER
+#include <ball_observer.h>
+#endif
+
+#ifndef INCLUDED_BDLS_FILESYSTEMUTIL
+#include <bdls_filesystemutil.h>
+#endif
+
+#ifndef INCLUDED_BSLH_HASH
+#include <bslh_hash.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_DEQUE
+#include <bsl_deque.h>
+#endif
+
+#ifndef INCLUDED_BSL_MEMORY
+#include <bsl_memory.h>
+#endif
+
+#ifndef INCLUDED_BSL_STRING
+#include <bsl_string.h>
+#endif
+
+#ifndef INCLUDED_BSL_UNORDERED_MAP
+#include <bsl_unordered_map.h>
+#endif
+
+namespace BloombergLP {
+namespace ball {
+
+class Context;
+class Record;
+
+                          // ========================
+                          // class MappedFileObserver
+                          // ========================
+
+class MappedFileObserver : public Observer {
+    // This class implements the 'Observer' protocol.  The 'publish' method of
+    // this class writes each record it receives, in binary form, to the
+    // current memory-mapped segment file, if file logging is enabled.  This
+    // class is thread-safe.
+
+    // PRIVATE TYPES
+    typedef bdls::FilesystemUtil::FileDescriptor FileDescriptor;
+
+    typedef bsl::unordered_map<bslstl::StringRef, int, bslh::Hash<> >
+                                                                   StringIdMap;
+        // maps each string written to the current segment to its identifier
+
+    // DATA
+    bsl::string              d_baseName;       // base name of segment files
+                                               // (empty if file logging is
+                                               // disabled)
+
+    bsl::string              d_segmentName;    // name of the current segment
+
+    int                      d_sequenceNumber; // sequence number of the
+                                               // current segment
+
+    FileDescriptor           d_descriptor;     // current segment file
+
+    char                    *d_segment_p;      // mapping of the current
+                                               // segment (0 if none)
+
+    bsl::size_t              d_mappedSize;     // size of the current segment
+
+    bsl::size_t              d_offset;         // offset of the end-of-data
+                                               // marker in the current
+                                               // segment
+
+    bsl::size_t              d_segmentSize;    // size of new segments
+
+    bsl::deque<bsl::string>  d_strings;        // strings written to the
+                                               // current segment, indexed by
+                                               // identifier
+
+    StringIdMap              d_stringIds;      // identifiers of 'd_strings'
+
+    mutable bslmt::Mutex     d_mutex;          // serializes access to this
+                                               // observer
+
+    // NOT IMPLEMENTED
+    MappedFileObserver(const MappedFileObserver&);
+    MappedFileObserver& operator=(const MappedFileObserver&);
+
+  private:
+    // PRIVATE MANIPULATORS
+    void closeSegment();
+        // Unmap and close the current segment, if any.  The behavior is
+        // undefined unless the caller holds 'd_mutex'.
+
+    int openSegment(bsl::size_t minimumSize);
+        // Create, and map into memory, the segment file having the lowest
+        // sequence number greater than that of the current segment for which
+        // no file exists, sized to hold at least the specified 'minimumSize'
+        // bytes of entries, and write its header.  Return 0 on success, and a
+        // non-zero value (with no segment open) otherwise.  The behavior is
+        // undefined unless the caller holds 'd_mutex', and no segment is open.
+
+    int stringId(bsl::size_t *entrySize, const bslstl::StringRef& value);
+        // Return the identifier of the specified 'value' in the current
+        // segment, assigning the next identifier to 'value' if it has not
+        // been written to the segment, and add to the specified 'entrySize'
+        // the size of the string entry to be written for 'value' in that
+        // case.  The behavior is undefined unless the caller holds 'd_mutex'.
+
+  public:
+    // CONSTANTS
+    enum {
+        k_DEFAULT_SEGMENT_SIZE = 64 * 1024 * 1024  // default size of a
+                                                   // segment (in bytes)
+    };
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(MappedFileObserver,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit MappedFileObserver(bslma::Allocator *basicAllocator = 0);
+        // Create a mapped file observer having file logging disabled, and a
+        // segment size of 'k_DEFAULT_SEGMENT_SIZE'.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    virtual ~MappedFileObserver();
+        // Close the current segment, if any, and destroy this observer.
+
+    // MANIPULATORS
+    void disableFileLogging();
+        // Disable file logging for this observer, closing the current
+        // segment.  This method has no effect if file logging is not enabled.
+
+    int enableFileLogging(const char *baseName);
+        // Enable logging of all records published to this observer to
+        // segment files named by appending a period and a sequence number to
+        // the specified 'baseName', and create the first segment.  Return 0
+        // on success, a positive value if file logging is already enabled,
+        // and a negative value otherwise.  If file logging is already enabled,
+        // fail with no effect.  See {Segment Files}.
+
+    void forceRotation();
+        // Close the current segment, and continue logging to the next one.
+        // This method has no effect if file logging is not enabled.  If the
+        // next segment cannot be created, file logging is disabled.
+
+    using Observer::publish;  // Avoid hiding base class method.
+
+    virtual void publish(const Record& record, const Context& context);
+        // Write the specified log 'record' to the current segment if file
+        // logging is enabled, ignoring the specified 'context'.  If 'record'
+        // does not fit in the current segment, continue with the next one; if
+        // that segment cannot be created, disable file logging.
+
+    virtual void publish(const bsl::shared_ptr<const Record>& record,
+                         const Context&                       context);
+        // Write the specified log 'record' to the current segment if file
+        // logging is enabled, ignoring the specified 'context'.  If 'record'
+        // does not fit in the current segment, continue with the next one; if
+        // that segment cannot be created, disable file logging.
+
+    virtual void releaseRecords();
+        // Discard any shared reference to a 'Record' object that was supplied
+        // to the 'publish' method, and is held by this observer.  Note that
+        // this observer holds no such references, and this method has no
+        // effect.
+
+    void setSegmentSize(bsl::size_t numBytes);
+        // Set the size of the segments created by this observer to the
+        // specified 'numBytes'.  The size of the current segment, if any, is
+        // unaffected.  The behavior is undefined unless
+        // '0 < numBytes <= INT_MAX'.
+
+    // ACCESSORS
+    bool isFileLoggingEnabled() const;
+    bool isFileLoggingEnabled(bsl::string *result) const;
+        // Return 'true' if file logging is enabled for this observer, and
+        // 'false' otherwise.  Load the optionally specified 'result' with the
+        // name of the current segment if file logging is enabled, and leave
+        // 'result' unaffected otherwise.
+
+    bsl::size_t segmentSize() const;
+        // Return the size of the segments created by this observer.
+};
+
+// ============================================================================
+//                              INLINE DEFINITIONS
+// ============================================================================
+
+                          // ------------------------
+                          // class MappedFileObserver
+                          // ------------------------
+
+// MANIPULATORS
+inline
+void MappedFileObserver::releaseRecords()
+{
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
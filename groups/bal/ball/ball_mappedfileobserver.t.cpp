@@ -0,0 +1,1225 @@
+// ball_mappedfileobserver.t.cpp                                      -*-C++-*-
+
+#include <ball_mappedfileobserver.h>
+
+#include <ball_binaryrecordutil.h>
+#include <ball_context.h>
+#include <ball_fileobserver2.h>                // for testing only
+#include <ball_record.h>
+#include <ball_recordattributes.h>
+#include <ball_severity.h>
+#include <ball_transmission.h>
+#include <ball_userfields.h>
+
+#include <bdls_filesystemutil.h>
+#include <bdls_pathutil.h>
+
+#include <bdlt_datetime.h>
+#include <bdlt_datetimetz.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_memory.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test is an observer that writes the records it receives
+// in binary form to memory-mapped segment files.  We verify the records it
+// writes by reading back its segments with 'ball::BinaryRecordUtil', checking
+// both the records themselves and the string entries defining their category
+// and file names (each of which must be written to a segment exactly once,
+// before its first use).  We then verify the naming and sizing of segments,
+// rotation (both when a segment is full and on demand), and publication from
+// multiple threads.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit MappedFileObserver(bslma::Allocator *basicAllocator = 0);
+// [ 2] ~MappedFileObserver();
+//
+// MANIPULATORS
+// [ 2] void disableFileLogging();
+// [ 2] int enableFileLogging(const char *baseName);
+// [ 4] void forceRotation();
+// [ 3] void publish(const Record& record, const Context& context);
+// [ 3] void publish(const shared_ptr<const Record>&, const Context&);
+// [ 3] void releaseRecords();
+// [ 2] void setSegmentSize(bsl::size_t numBytes);
+//
+// ACCESSORS
+// [ 2] bool isFileLoggingEnabled() const;
+// [ 2] bool isFileLoggingEnabled(bsl::string *result) const;
+// [ 2] bsl::size_t segmentSize() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] SEGMENT ROTATION
+// [ 5] CONCURRENT PUBLICATION
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: PUBLICATION COST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool             verbose;
+bool         veryVerbose;
+bool     veryVeryVerbose;
+bool veryVeryVeryVerbose;
+
+typedef ball::MappedFileObserver Obj;
+typedef ball::BinaryRecordUtil   Util;
+typedef bdls::FilesystemUtil     FileUtil;
+
+const ball::Context CONTEXT(ball::Transmission::e_PASSTHROUGH, 0, 1);
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+namespace {
+
+class TempDirectoryGuard {
+    // This class creates a temporary directory on construction, and removes
+    // it, along with its contents, on destruction.
+
+    // DATA
+    bsl::string d_dirName;  // name of the temporary directory
+
+    // NOT IMPLEMENTED
+    TempDirectoryGuard(const TempDirectoryGuard&);
+    TempDirectoryGuard& operator=(const TempDirectoryGuard&);
+
+  public:
+    // CREATORS
+    explicit TempDirectoryGuard(bslma::Allocator *basicAllocator)
+        // Create a temporary directory, using the specified 'basicAllocator'
+        // to supply memory.
+    : d_dirName(basicAllocator)
+    {
+        int rc = FileUtil::createTemporaryDirectory(&d_dirName,
+                                                    "ball_mappedfileobserver");
+        BSLS_ASSERT_OPT(0 == rc);
+    }
+
+    ~TempDirectoryGuard()
+        // Remove the temporary directory and its contents.
+    {
+        FileUtil::remove(d_dirName, true);
+    }
+
+    // ACCESSORS
+    bsl::string path(const char *fileName) const
+        // Return the path of the specified 'fileName' within the temporary
+        // directory.
+    {
+        bsl::string result(d_dirName);
+        bdls::PathUtil::appendRaw(&result, fileName);
+        return result;
+    }
+};
+
+void makeRecord(ball::Record *record,
+                const char   *category,
+                const char   *fileName,
+                int           lineNumber,
+                const char   *message)
+    // Load into the specified 'record' a record having the specified
+    // 'category', 'fileName', 'lineNumber', and 'message'.
+{
+    ball::RecordAttributes& attributes = record->fixedFields();
+    attributes.setTimestamp(bdlt::Datetime(2018, 6, 7, 8, 9, 10, 11, 12));
+    attributes.setProcessID(4321);
+    attributes.setThreadID(lineNumber * 10);
+    attributes.setSeverity(ball::Severity::e_ERROR);
+    attributes.setCategory(category);
+    attributes.setFileName(fileName);
+    attributes.setLineNumber(lineNumber);
+    attributes.setMessage(message);
+}
+
+int readFile(bsl::vector<char> *result, const bsl::string& fileName)
+    // Load into the specified 'result' the contents of the file having the
+    // specified 'fileName'.  Return 0 on success, and a non-zero value
+    // otherwise.
+{
+    FileUtil::FileDescriptor fd = FileUtil::open(fileName,
+                                                 FileUtil::e_OPEN,
+                                                 FileUtil::e_READ_ONLY);
+    if (FileUtil::k_INVALID_FD == fd) {
+        return -1;                                                    // RETURN
+    }
+
+    result->resize(static_cast<bsl::size_t>(FileUtil::getFileSize(fileName)));
+
+    const int size    = static_cast<int>(result->size());
+    int       numRead = 0;
+    int       total   = 0;
+    while (total < size
+        && 0 < (numRead = FileUtil::read(fd,
+                                         result->data() + total,
+                                         size - total))) {
+        total += numRead;
+    }
+    FileUtil::close(fd);
+    return total == size ? 0 : -2;
+}
+
+int readSegment(bsl::vector<ball::Record> *records,
+                int                       *numStrings,
+                const bsl::string&         fileName)
+    // Append to the specified 'records' the records held by the segment file
+    // having the specified 'fileName', resolving their category and file
+    // names, and load into the specified 'numStrings' the number of string
+    // entries in the segment.  Return 0 on success, and a non-zero value if
+    // the segment cannot be read, is malformed, defines an identifier more
+    // than once, or uses an identifier before defining it.
+{
+    bslma::Allocator  *allocator = records->get_allocator().mechanism();
+    bsl::vector<char>  data(allocator);
+    if (0 != readFile(&data, fileName)) {
+        return 1;                                                     // RETURN
+    }
+
+    int version;
+    if (0 != Util::readHeader(&version, data.data(), data.size())
+     || Util::k_VERSION != version) {
+        return 2;                                                     // RETURN
+    }
+
+    bsl::map<int, bsl::string> strings(allocator);
+
+    const char      *position = data.data() + Util::k_HEADER_SIZE;
+    const char      *end      = data.data() + data.size();
+    Util::EntryType  type;
+    const char      *payload;
+    int              payloadLength;
+
+    *numStrings = 0;
+
+    int rc;
+    while (0 == (rc = Util::readEntry(&type,
+                                      &payload,
+                                      &payloadLength,
+                                      &position,
+                                      end))) {
+        if (Util::e_STRING_ENTRY == type) {
+            int               id;
+            bslstl::StringRef value;
+            if (0 != Util::decodeStringEntry(&id,
+                                             &value,
+                                             payload,
+                                             payloadLength)
+             || strings.count(id)) {
+                return 3;                                             // RETURN
+            }
+            strings[id].assign(value.begin(), value.end());
+            ++*numStrings;
+        }
+        else {
+            ball::Record record(allocator);
+            int          categoryId, fileNameId;
+            if (0 != Util::decodeRecordEntry(&record,
+                                             &categoryId,
+                                             &fileNameId,
+                                             payload,
+                                             payloadLength)
+             || !strings.count(categoryId)
+             || !strings.count(fileNameId)) {
+                return 4;                                             // RETURN
+            }
+            record.fixedFields().setCategory(strings[categoryId].c_str());
+            record.fixedFields().setFileName(strings[fileNameId].c_str());
+            records->push_back(record);
+        }
+    }
+    return 1 == rc ? 0 : 5;
+}
+
+class PublishJob {
+    // This class provides a function object publishing a sequence of records,
+    // identifying the publishing thread, to an observer.
+
+    // DATA
+    Obj *d_observer_p;   // observer to publish to (held, not owned)
+    int  d_threadId;     // identifier of the publishing thread
+    int  d_numRecords;   // number of records to publish
+
+  public:
+    // CREATORS
+    PublishJob(Obj *observer, int threadId, int numRecords)
+        // Create a job publishing the specified 'numRecords' records to the
+        // specified 'observer', identified by the specified 'threadId'.
+    : d_observer_p(observer)
+    , d_threadId(threadId)
+    , d_numRecords(numRecords)
+    {
+    }
+
+    // ACCESSORS
+    void operator()() const
+        // Publish the records.  Each record has a line number of
+        // 'd_threadId', a thread id equal to its sequence number, and a
+        // category and file name that depend on its sequence number.
+    {
+        static const char *const CATEGORIES[] = { "A", "B", "C" };
+
+        bslma::TestAllocator ta("job", veryVeryVeryVerbose);
+        for (int i = 0; i < d_numRecords; ++i) {
+            char message[64];
+            bsl::sprintf(message, "thread %d record %d", d_threadId, i);
+
+            ball::Record record(&ta);
+            makeRecord(&record, CATEGORIES[i % 3], "job.cpp", d_threadId,
+                       message);
+            record.fixedFields().setThreadID(i);
+            d_observer_p->publish(record, CONTEXT);
+        }
+    }
+};
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+    bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+    bslma::TestAllocatorMonitor gam(&globalAllocator);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, replace 'assert' with
+        //:   'ASSERT', and insert 'if (veryVerbose)' before all output
+        //:   operations.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        // The example allocates from the default allocator.
+
+        bslma::TestAllocator         da("example", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        TempDirectoryGuard tempDir(&da);
+        const bsl::string  baseName = tempDir.path("server.log");
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Publishing Records to Binary Segments
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// In this example, we publish a record to binary segment files and then
+// inspect the resulting segment.
+//
+// First, we create an observer and enable file logging, supplying the base
+// name of the segment files:
+//..
+    ball::MappedFileObserver observer;
+    observer.setSegmentSize(1024 * 1024);
+
+    int rc = observer.enableFileLogging(baseName.c_str());
+    ASSERT(0 == rc);
+
+    bsl::string segmentName;
+    ASSERT(true            == observer.isFileLoggingEnabled(&segmentName));
+    ASSERT(baseName + ".1" == segmentName);
+//..
+// Then, we publish a record:
+//..
+    ball::RecordAttributes attributes(bdlt::Datetime(2018, 5, 1, 12, 30),
+                                      1234,
+                                      5678,
+                                      "server.cpp",
+                                      42,
+                                      "SERVER",
+                                      ball::Severity::e_INFO,
+                                      "request complete");
+    bsl::shared_ptr<const ball::Record> record =
+               bsl::make_shared<ball::Record>(attributes, ball::UserFields());
+
+    observer.publish(record,
+                     ball::Context(ball::Transmission::e_PASSTHROUGH, 0, 1));
+//..
+// Finally, we close the segment, which holds a header, the category and file
+// name of the record, and the record itself:
+//..
+    observer.disableFileLogging();
+    ASSERT(false == observer.isFileLoggingEnabled());
+
+    ASSERT(1024 * 1024 == bdls::FilesystemUtil::getFileSize(segmentName));
+//..
+// The segment can now be rendered as text by a 'ball::BinaryLogDecoder' (see
+// 'ball_binarylogdecoder').
+
+        bsl::vector<ball::Record> records(&da);
+        int                       numStrings;
+        ASSERT(0         == readSegment(&records, &numStrings, segmentName));
+        ASSERT(2         == numStrings);
+        ASSERT(1         == records.size());
+        ASSERT(*record   == records[0]);
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENT PUBLICATION
+        //
+        // Concerns:
+        //: 1 Records published concurrently from multiple threads are each
+        //:   written exactly once, and the records published by each thread
+        //:   appear in the order in which they were published.
+        //:
+        //: 2 Segments written concurrently, and rotated, are well-formed.
+        //
+        // Plan:
+        //: 1 Using a small segment size, publish a sequence of records from
+        //:   each of several threads concurrently.  Read back every segment,
+        //:   and verify that the records of each thread are all present, in
+        //:   order.  (C-1..2)
+        //
+        // Testing:
+        //   CONCURRENT PUBLICATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT PUBLICATION" << endl
+                          << "======================" << endl;
+
+        enum { NUM_THREADS = 4, NUM_RECORDS = 2000 };
+
+        // Concatenating segment names allocates from the default allocator.
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        TempDirectoryGuard tempDir(&ta);
+        const bsl::string  baseName = tempDir.path("concurrent");
+
+        {
+            Obj mX(&ta);
+            mX.setSegmentSize(8192);
+            ASSERT(0 == mX.enableFileLogging(baseName.c_str()));
+
+            bslmt::ThreadUtil::Handle handles[NUM_THREADS];
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::createWithAllocator(
+                                             &handles[i],
+                                             PublishJob(&mX, i, NUM_RECORDS),
+                                             &ta));
+            }
+            for (int i = 0; i < NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+        }
+
+        int next[NUM_THREADS] = { 0 };
+        int numSegments       = 0;
+        for (int seq = 1; ; ++seq) {
+            char suffix[16];
+            bsl::sprintf(suffix, ".%d", seq);
+
+            const bsl::string segmentName = baseName + suffix;
+            if (!FileUtil::exists(segmentName)) {
+                break;
+            }
+            ++numSegments;
+
+            bsl::vector<ball::Record> records(&ta);
+            int                       numStrings;
+            ASSERTV(seq, 0 == readSegment(&records,
+                                          &numStrings,
+                                          segmentName));
+            ASSERTV(seq, numStrings <= 4);
+
+            for (bsl::size_t i = 0; i < records.size(); ++i) {
+                const ball::RecordAttributes& attributes =
+                                                      records[i].fixedFields();
+                const int thread = attributes.lineNumber();
+                ASSERTV(seq, thread, 0 <= thread && thread < NUM_THREADS);
+                if (0 > thread || thread >= NUM_THREADS) {
+                    continue;
+                }
+                ASSERTV(seq, thread, next[thread] ==
+                                  static_cast<int>(attributes.threadID()));
+                next[thread] = static_cast<int>(attributes.threadID()) + 1;
+            }
+        }
+
+        if (veryVerbose) { T_ P(numSegments) }
+
+        ASSERT(1 < numSegments);
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            ASSERTV(i, next[i], NUM_RECORDS == next[i]);
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // SEGMENT ROTATION
+        //
+        // Concerns:
+        //: 1 When a record does not fit in the current segment, the segment is
+        //:   closed and the record written to the next one.
+        //:
+        //: 2 Each segment is self-contained: the strings used by its records
+        //:   are defined in the segment itself.
+        //:
+        //: 3 A record larger than the segment size is written to a segment of
+        //:   its own, created large enough to hold it, and subsequent segments
+        //:   have the configured size.
+        //:
+        //: 4 'forceRotation' continues logging to the next segment, and has no
+        //:   effect if file logging is disabled.
+        //:
+        //: 5 Segment files that already exist are skipped, not overwritten.
+        //:
+        //: 6 A change of segment size applies to subsequent segments only.
+        //
+        // Plan:
+        //: 1 Create a file named as the second segment of a base name.  Using
+        //:   a small segment size, publish a sequence of records, and verify
+        //:   that the pre-existing file is unchanged, and that the records
+        //:   are distributed, in order, over well-formed segments of the
+        //:   expected size, each defining the strings it uses.  (C-1..2, 5)
+        //:
+        //: 2 Publish a record larger than the segment size, followed by a
+        //:   small record, and verify the segments that result.  (C-3)
+        //:
+        //: 3 Call 'forceRotation', and verify the name of the current segment,
+        //:   and that a record published subsequently is written to it.
+        //:   Change the segment size, call 'forceRotation' again, and verify
+        //:   the size of the new segment.  (C-4, 6)
+        //
+        // Testing:
+        //   void forceRotation();
+        //   SEGMENT ROTATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SEGMENT ROTATION" << endl
+                          << "================" << endl;
+
+        // Concatenating segment names allocates from the default allocator.
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        TempDirectoryGuard tempDir(&ta);
+        const bsl::string  baseName = tempDir.path("rotation");
+
+        // Occupy the name of the second segment.
+
+        {
+            FileUtil::FileDescriptor fd = FileUtil::open(
+                                                       baseName + ".2",
+                                                       FileUtil::e_CREATE,
+                                                       FileUtil::e_WRITE_ONLY);
+            ASSERT(FileUtil::k_INVALID_FD != fd);
+            ASSERT(3 == FileUtil::write(fd, "abc", 3));
+            FileUtil::close(fd);
+        }
+
+        enum { SEGMENT_SIZE = 1024, NUM_RECORDS = 100 };
+
+        Obj mX(&ta);  const Obj& X = mX;
+
+        if (verbose) cout << "\tForced rotation while disabled." << endl;
+
+        mX.forceRotation();
+        ASSERT(false == X.isFileLoggingEnabled());
+
+        mX.setSegmentSize(SEGMENT_SIZE);
+        ASSERT(0 == mX.enableFileLogging(baseName.c_str()));
+
+        if (verbose) cout << "\tRotation on full segments." << endl;
+
+        bsl::vector<ball::Record> expected(&ta);
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            char message[32];
+            bsl::sprintf(message, "message %d", i);
+
+            ball::Record record(&ta);
+            makeRecord(&record, i % 2 ? "ODD" : "EVEN", "rotation.cpp", i,
+                       message);
+            mX.publish(record, CONTEXT);
+            expected.push_back(record);
+        }
+
+        bsl::string segmentName(&ta);
+        ASSERT(true == X.isFileLoggingEnabled(&segmentName));
+
+        int lastSegment;
+        ASSERT(1 == bsl::sscanf(segmentName.c_str() + baseName.length(),
+                                ".%d",
+                                &lastSegment));
+        ASSERTV(lastSegment, 3 < lastSegment);
+
+        // Decode the segments written so far (the last is still open).
+
+        bsl::vector<ball::Record> records(&ta);
+        for (int seq = 1; seq <= lastSegment; ++seq) {
+            if (2 == seq) {
+                bsl::vector<char> contents(&ta);
+                ASSERT(0 == readFile(&contents, baseName + ".2"));
+                ASSERT(bsl::string("abc", &ta) == bsl::string(contents.begin(),
+                                                              contents.end(),
+                                                              &ta));
+                continue;
+            }
+
+            char suffix[16];
+            bsl::sprintf(suffix, ".%d", seq);
+
+            const bsl::size_t recordsBefore = records.size();
+            int               numStrings;
+            ASSERTV(seq, 0 == readSegment(&records,
+                                          &numStrings,
+                                          baseName + suffix));
+            ASSERTV(seq, SEGMENT_SIZE == FileUtil::getFileSize(
+                                                          baseName + suffix));
+            ASSERTV(seq, recordsBefore < records.size());
+            ASSERTV(seq, numStrings, 3 == numStrings);
+        }
+        ASSERT(expected == records);
+
+        if (verbose) cout << "\tRecord larger than a segment." << endl;
+
+        {
+            const bsl::string LARGE(3 * SEGMENT_SIZE, 'x', &ta);
+
+            ball::Record large(&ta);
+            makeRecord(&large, "LARGE", "rotation.cpp", 1, LARGE.c_str());
+            mX.publish(large, CONTEXT);
+
+            ball::Record small(&ta);
+            makeRecord(&small, "SMALL", "rotation.cpp", 2, "small");
+            mX.publish(small, CONTEXT);
+
+            const int largeSeq = lastSegment + 1;
+            char      largeName[16];
+            char      smallName[16];
+            bsl::sprintf(largeName, ".%d", largeSeq);
+            bsl::sprintf(smallName, ".%d", largeSeq + 1);
+
+            ASSERT(true == X.isFileLoggingEnabled(&segmentName));
+            ASSERT(baseName + smallName == segmentName);
+
+            ASSERT(3 * SEGMENT_SIZE < FileUtil::getFileSize(
+                                                       baseName + largeName));
+
+            bsl::vector<ball::Record> largeRecords(&ta);
+            int                       numStrings;
+            ASSERT(0 == readSegment(&largeRecords,
+                                    &numStrings,
+                                    baseName + largeName));
+            ASSERT(1     == largeRecords.size());
+            ASSERT(large == largeRecords[0]);
+
+            bsl::vector<ball::Record> smallRecords(&ta);
+            ASSERT(0 == readSegment(&smallRecords,
+                                    &numStrings,
+                                    baseName + smallName));
+            ASSERT(1     == smallRecords.size());
+            ASSERT(small == smallRecords[0]);
+            ASSERT(SEGMENT_SIZE == FileUtil::getFileSize(
+                                                       baseName + smallName));
+
+            lastSegment = largeSeq + 1;
+        }
+
+        if (verbose) cout << "\tForced rotation." << endl;
+
+        {
+            mX.forceRotation();
+
+            char name[16];
+            bsl::sprintf(name, ".%d", lastSegment + 1);
+
+            ASSERT(true == X.isFileLoggingEnabled(&segmentName));
+            ASSERT(baseName + name == segmentName);
+
+            ball::Record record(&ta);
+            makeRecord(&record, "FORCED", "forced.cpp", 3, "forced");
+            mX.publish(record, CONTEXT);
+
+            bsl::vector<ball::Record> forced(&ta);
+            int                       numStrings;
+            ASSERT(0 == readSegment(&forced, &numStrings, segmentName));
+            ASSERT(1      == forced.size());
+            ASSERT(record == forced[0]);
+
+            mX.setSegmentSize(2 * SEGMENT_SIZE);
+            ASSERT(SEGMENT_SIZE == FileUtil::getFileSize(segmentName));
+
+            mX.forceRotation();
+            ASSERT(true == X.isFileLoggingEnabled(&segmentName));
+            ASSERT(2 * SEGMENT_SIZE == FileUtil::getFileSize(segmentName));
+
+            forced.clear();
+            ASSERT(0 == readSegment(&forced, &numStrings, segmentName));
+            ASSERT(0 == forced.size());
+            ASSERT(0 == numStrings);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // PUBLISH
+        //
+        // Concerns:
+        //: 1 Each record published while file logging is enabled is written
+        //:   to the current segment, with all of its attributes and user
+        //:   fields, in the order of publication.
+        //:
+        //: 2 Each distinct category and file name is written to a segment
+        //:   exactly once, before the first record that uses it (including
+        //:   when a category equals a file name).
+        //:
+        //: 3 The segment can be read, up to the last record published, while
+        //:   it is still open.
+        //:
+        //: 4 Records published while file logging is disabled are discarded.
+        //:
+        //: 5 Both 'publish' overloads write the record, and 'releaseRecords'
+        //:   has no effect.
+        //
+        // Plan:
+        //: 1 Publish records having a set of categories and file names (one
+        //:   category having the same name as a file), and varied user
+        //:   fields, reading back the segment after each publication, and
+        //:   compare the records read with those published, and the number
+        //:   of string entries with the number of distinct strings.
+        //:   (C-1..3, 5)
+        //:
+        //: 2 Publish records before enabling, and after disabling, file
+        //:   logging, and verify that they are not written.  (C-4)
+        //
+        // Testing:
+        //   void publish(const Record& record, const Context& context);
+        //   void publish(const shared_ptr<const Record>&, const Context&);
+        //   void releaseRecords();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PUBLISH" << endl
+                          << "=======" << endl;
+
+        // Assigning a string to a 'ball::UserFieldValue' creates a temporary
+        // string using the default allocator.
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        TempDirectoryGuard tempDir(&ta);
+        const bsl::string  baseName = tempDir.path("publish");
+
+        static const struct {
+            int         d_line;
+            const char *d_category;
+            const char *d_fileName;
+            int         d_numStrings;  // expected strings after publication
+        } DATA[] = {
+            //LINE  CATEGORY    FILE NAME     NUM STRINGS
+            //----  ----------  ------------  -----------
+            { L_,   "A",        "a.cpp",                2 },
+            { L_,   "A",        "a.cpp",                2 },
+            { L_,   "B",        "a.cpp",                3 },
+            { L_,   "A",        "b.cpp",                4 },
+            { L_,   "b.cpp",    "b.cpp",                4 },
+            { L_,   "C",        "C",                    5 },
+            { L_,   "",         "",                     6 },
+            { L_,   "B",        "a.cpp",                6 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        Obj mX(&ta);  const Obj& X = mX;
+
+        ball::Record discarded(&ta);
+        makeRecord(&discarded, "X", "x.cpp", 1, "discarded");
+        mX.publish(discarded, CONTEXT);
+
+        mX.setSegmentSize(64 * 1024);
+        ASSERT(0 == mX.enableFileLogging(baseName.c_str()));
+
+        bsl::string segmentName(&ta);
+        ASSERT(X.isFileLoggingEnabled(&segmentName));
+
+        bsl::vector<ball::Record> expected(&ta);
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE        = DATA[ti].d_line;
+            const char *CATEGORY    = DATA[ti].d_category;
+            const char *FILE_NAME   = DATA[ti].d_fileName;
+            const int   NUM_STRINGS = DATA[ti].d_numStrings;
+
+            bsl::shared_ptr<ball::Record> record =
+                                      bsl::allocate_shared<ball::Record>(&ta);
+            makeRecord(record.get(), CATEGORY, FILE_NAME, LINE, "message");
+
+            ball::UserFields& fields = record->customFields();
+            for (int i = 0; i < ti % 4; ++i) {
+                fields.appendInt64(LINE * i);
+                fields.appendString("user field");
+            }
+            if (ti % 2) {
+                fields.appendDatetimeTz(bdlt::DatetimeTz(
+                                      bdlt::Datetime(2018, 1, 1, 1, 1), 60));
+                mX.publish(*record, CONTEXT);
+            }
+            else {
+                mX.publish(bsl::shared_ptr<const ball::Record>(record),
+                           CONTEXT);
+            }
+            mX.releaseRecords();
+            expected.push_back(*record);
+
+            bsl::vector<ball::Record> records(&ta);
+            int                       numStrings = -1;
+            ASSERTV(LINE, 0 == readSegment(&records,
+                                           &numStrings,
+                                           segmentName));
+            ASSERTV(LINE, numStrings, NUM_STRINGS == numStrings);
+            ASSERTV(LINE, expected == records);
+        }
+
+        mX.disableFileLogging();
+        mX.publish(discarded, CONTEXT);
+
+        bsl::vector<ball::Record> records(&ta);
+        int                       numStrings = -1;
+        ASSERT(0 == readSegment(&records, &numStrings, segmentName));
+        ASSERT(expected == records);
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // FILE LOGGING AND SEGMENT SIZE
+        //
+        // Concerns:
+        //: 1 A default-constructed observer has file logging disabled, and a
+        //:   segment size of 'k_DEFAULT_SEGMENT_SIZE'.
+        //:
+        //: 2 'enableFileLogging' creates the segment having the lowest unused
+        //:   sequence number, of the configured size, holding a header and no
+        //:   entries, and fails, with no effect, if file logging is already
+        //:   enabled.
+        //:
+        //: 3 'enableFileLogging' returns a negative value, and leaves file
+        //:   logging disabled, if the segment cannot be created.
+        //:
+        //: 4 'disableFileLogging' closes the segment, and has no effect if
+        //:   file logging is disabled.
+        //:
+        //: 5 'isFileLoggingEnabled' loads the name of the current segment only
+        //:   if file logging is enabled.
+        //:
+        //: 6 The destructor closes the current segment.
+        //:
+        //: 7 All memory is supplied by the object allocator.
+        //:
+        //: 8 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create an observer and verify its initial state.  (C-1)
+        //:
+        //: 2 Enable, disable, and re-enable file logging, verifying the
+        //:   names, sizes and contents of the segments created, and the
+        //:   results of 'isFileLoggingEnabled'.  (C-2, 4..5)
+        //:
+        //: 3 Enable file logging with a base name in a directory that does
+        //:   not exist.  (C-3)
+        //:
+        //: 4 Destroy an observer with file logging enabled, and verify that
+        //:   the segment can be read.  (C-6)
+        //:
+        //: 5 Supply a test allocator to each observer, and verify that the
+        //:   default allocator is not used.  (C-7)
+        //:
+        //: 6 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-8)
+        //
+        // Testing:
+        //   explicit MappedFileObserver(bslma::Allocator *basicAllocator = 0);
+        //   ~MappedFileObserver();
+        //   void disableFileLogging();
+        //   int enableFileLogging(const char *baseName);
+        //   void setSegmentSize(bsl::size_t numBytes);
+        //   bool isFileLoggingEnabled() const;
+        //   bool isFileLoggingEnabled(bsl::string *result) const;
+        //   bsl::size_t segmentSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "FILE LOGGING AND SEGMENT SIZE" << endl
+                          << "=============================" << endl;
+
+        // Concatenating segment names allocates from the default allocator.
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        TempDirectoryGuard tempDir(&ta);
+        const bsl::string  baseName = tempDir.path("enable");
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(false                       == X.isFileLoggingEnabled());
+            ASSERT(Obj::k_DEFAULT_SEGMENT_SIZE == X.segmentSize());
+
+            bsl::string name("unchanged", &ta);
+            ASSERT(false       == X.isFileLoggingEnabled(&name));
+            ASSERT("unchanged" == name);
+
+            mX.disableFileLogging();
+            ASSERT(false == X.isFileLoggingEnabled());
+
+            mX.setSegmentSize(4096);
+            ASSERT(4096 == X.segmentSize());
+
+            ASSERT(0    == mX.enableFileLogging(baseName.c_str()));
+            ASSERT(true == X.isFileLoggingEnabled());
+            ASSERT(true == X.isFileLoggingEnabled(&name));
+            ASSERT(baseName + ".1" == name);
+            ASSERT(4096 == FileUtil::getFileSize(name));
+
+            ASSERT(0 <  mX.enableFileLogging(baseName.c_str()));
+            ASSERT(true == X.isFileLoggingEnabled(&name));
+            ASSERT(baseName + ".1" == name);
+
+            mX.disableFileLogging();
+            ASSERT(false == X.isFileLoggingEnabled());
+            mX.disableFileLogging();
+            ASSERT(false == X.isFileLoggingEnabled());
+
+            bsl::vector<ball::Record> records(&ta);
+            int                       numStrings = -1;
+            ASSERT(0 == readSegment(&records,
+                                    &numStrings,
+                                    baseName + ".1"));
+            ASSERT(0 == records.size());
+            ASSERT(0 == numStrings);
+
+            mX.setSegmentSize(1);
+            ASSERT(0    == mX.enableFileLogging(baseName.c_str()));
+            ASSERT(true == X.isFileLoggingEnabled(&name));
+            ASSERT(baseName + ".2" == name);
+            ASSERT(Util::k_HEADER_SIZE + Util::k_FRAME_SIZE ==
+                                                  FileUtil::getFileSize(name));
+
+            ball::Record record(&ta);
+            makeRecord(&record, "CAT", "file.cpp", 1, "message");
+            mX.publish(record, CONTEXT);
+            ASSERT(true == X.isFileLoggingEnabled(&name));
+            ASSERT(baseName + ".3" == name);
+
+            mX.setSegmentSize(4096);
+        }
+
+        bsl::vector<ball::Record> records(&ta);
+        int                       numStrings = -1;
+        ASSERT(0 == readSegment(&records, &numStrings, baseName + ".3"));
+        ASSERT(1 == records.size());
+        ASSERT(2 == numStrings);
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            const bsl::string badName = tempDir.path("missing/enable");
+            ASSERT(0     >  mX.enableFileLogging(badName.c_str()));
+            ASSERT(false == X.isFileLoggingEnabled());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(&ta);  const Obj& X = mX;
+
+            bsl::string name(&ta);
+            ASSERT_PASS(X.isFileLoggingEnabled(&name));
+            ASSERT_FAIL(X.isFileLoggingEnabled(0));
+
+            ASSERT_PASS(mX.setSegmentSize(1));
+            ASSERT_FAIL(mX.setSegmentSize(0));
+
+            ASSERT_FAIL(mX.enableFileLogging(0));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Enable file logging, publish a few records, disable file logging,
+        //:   and read back the records.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        // Creating a temporary directory allocates from the default allocator.
+
+        bslma::TestAllocator         da("temporary", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        TempDirectoryGuard tempDir(&ta);
+        const bsl::string  baseName = tempDir.path("breathing");
+
+        Obj mX(&ta);  const Obj& X = mX;
+
+        mX.setSegmentSize(64 * 1024);
+        ASSERT(0 == mX.enableFileLogging(baseName.c_str()));
+
+        bsl::vector<ball::Record> expected(&ta);
+        for (int i = 0; i < 3; ++i) {
+            ball::Record record(&ta);
+            makeRecord(&record, "BREATHING", "breathing.cpp", i, "hello");
+            mX.publish(record, CONTEXT);
+            expected.push_back(record);
+        }
+
+        bsl::string segmentName(&ta);
+        ASSERT(true == X.isFileLoggingEnabled(&segmentName));
+
+        mX.disableFileLogging();
+        ASSERT(false == X.isFileLoggingEnabled());
+
+        bsl::vector<ball::Record> records(&ta);
+        int                       numStrings;
+        ASSERT(0 == readSegment(&records, &numStrings, segmentName));
+        ASSERT(2 == numStrings);
+        ASSERT(expected == records);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: PUBLICATION COST
+        //
+        // Concerns:
+        //: 1 Publishing a record in binary form to a mapped segment costs
+        //:   substantially less than formatting it as text and writing it to
+        //:   a file.
+        //
+        // Plan:
+        //: 1 Publish the same sequence of records to a 'MappedFileObserver'
+        //:   and to a 'FileObserver2', and report the throughput of each.
+        //:   (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: PUBLICATION COST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST: PUBLICATION COST" << endl
+                          << "==================================" << endl;
+
+        enum { NUM_RECORDS = 500000 };
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        TempDirectoryGuard tempDir(&ta);
+
+        ball::Record record(&ta);
+        makeRecord(&record,
+                   "PERFORMANCE.CATEGORY",
+                   "groups/bal/ball/ball_mappedfileobserver.t.cpp",
+                   1234,
+                   "request 12345 completed with status 0 in 42 us");
+        record.customFields().appendInt64(12345);
+
+        {
+            Obj mX(&ta);
+            ASSERT(0 == mX.enableFileLogging(
+                                          tempDir.path("binary").c_str()));
+
+            bsls::Stopwatch timer;
+            timer.start();
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                mX.publish(record, CONTEXT);
+            }
+            timer.stop();
+
+            cout << "MappedFileObserver: " << NUM_RECORDS << " records in "
+                 << timer.elapsedTime() << "s ("
+                 << static_cast<bsls::Types::Int64>(
+                                        NUM_RECORDS / timer.elapsedTime())
+                 << " records/s)" << endl;
+        }
+        {
+            ball::FileObserver2 mX(&ta);
+            ASSERT(0 == mX.enableFileLogging(tempDir.path("text").c_str()));
+
+            bsls::Stopwatch timer;
+            timer.start();
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                mX.publish(record, CONTEXT);
+            }
+            timer.stop();
+
+            cout << "FileObserver2:      " << NUM_RECORDS << " records in "
+                 << timer.elapsedTime() << "s ("
+                 << static_cast<bsls::Types::Int64>(
+                                        NUM_RECORDS / timer.elapsedTime())
+                 << " records/s)" << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (test >= 0) {
+        // CONCERN: In no case does memory come from the default allocator.
+
+        ASSERT(dam.isTotalSame());
+
+        // CONCERN: In no case does memory come from the global allocator.
+
+        ASSERT(gam.isTotalSame());
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
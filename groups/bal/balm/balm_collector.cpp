@@ -12,12 +12,183 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(balm_collector_cpp,"$Id$ $CSID$")
 
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_new.h>
+
 namespace BloombergLP {
 
                               // ---------------
                               // class Collector
                               // ---------------
 
+namespace balm {
+
+// PRIVATE CLASS METHODS
+void Collector::resetCell(Cell *cell)
+{
+    cell->d_count.storeRelease(0);
+    cell->d_total.storeRelease(toBits(0.0));
+    cell->d_min.storeRelease(toBits(MetricRecord::k_DEFAULT_MIN));
+    cell->d_max.storeRelease(toBits(MetricRecord::k_DEFAULT_MAX));
+}
+
+// PRIVATE MANIPULATORS
+void Collector::allocateCells()
+{
+    // The buffer holds one cache line more than the cells, so that the cells
+    // can be aligned on a cache line (see 'cell').
+
+    char *cellBuffer = static_cast<char *>(
+                    d_allocator_p->allocate((k_NUM_CELLS + 1) * k_CELL_SIZE));
+
+    for (int i = 0; i < k_NUM_CELLS; ++i) {
+        resetCell(new (&cell(cellBuffer, i)) Cell());
+    }
+
+    if (0 != d_cellBuffer_p.testAndSwapAcqRel(0, cellBuffer)) {
+        // Another thread allocated the cells first.
+
+        d_allocator_p->deallocate(cellBuffer);
+    }
+}
+
+void Collector::resetCells()
+{
+    resetCell(&d_cell);
+
+    char *cellBuffer = d_cellBuffer_p.loadAcquire();
+    if (cellBuffer) {
+        for (int i = 0; i < k_NUM_CELLS; ++i) {
+            resetCell(&cell(cellBuffer, i));
+        }
+    }
+}
+
+// CREATORS
+Collector::Collector(const MetricId&   metricId,
+                     bslma::Allocator *basicAllocator)
+: d_metricId(metricId)
+, d_cell()
+, d_cellBuffer_p(0)
+, d_lock()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    resetCell(&d_cell);
+}
+
+Collector::~Collector()
+{
+    char *cellBuffer = d_cellBuffer_p.loadAcquire();
+    if (cellBuffer) {
+        d_allocator_p->deallocate(cellBuffer);
+    }
+}
+
+// MANIPULATORS
+void Collector::reset()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
+    resetCells();
+}
+
+void Collector::loadAndReset(MetricRecord *record)
+{
+    const bsls::Types::Int64 defaultMin = toBits(MetricRecord::k_DEFAULT_MIN);
+    const bsls::Types::Int64 defaultMax = toBits(MetricRecord::k_DEFAULT_MAX);
+    const bsls::Types::Int64 zero       = toBits(0.0);
+
+    int    count = 0;
+    double total = 0.0;
+    double min   = MetricRecord::k_DEFAULT_MIN;
+    double max   = MetricRecord::k_DEFAULT_MAX;
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
+
+    // Merge 'd_cell' (at index -1) and the cells updated by concurrent
+    // threads, if they were allocated.
+
+    char      *cellBuffer = d_cellBuffer_p.loadAcquire();
+    const int  numCells   = cellBuffer ? k_NUM_CELLS : 0;
+
+    for (int i = -1; i < numCells; ++i) {
+        Cell& c = 0 <= i ? cell(cellBuffer, i) : d_cell;
+        count += c.d_count.swapAcqRel(0);
+        total += fromBits(c.d_total.swapAcqRel(zero));
+        min    = bsl::min(min, fromBits(c.d_min.swapAcqRel(defaultMin)));
+        max    = bsl::max(max, fromBits(c.d_max.swapAcqRel(defaultMax)));
+    }
+
+    record->metricId() = d_metricId;
+    record->count()    = count;
+    record->total()    = total;
+    record->min()      = min;
+    record->max()      = max;
+}
+
+void Collector::accumulateCountTotalMinMax(int    count,
+                                           double total,
+                                           double min,
+                                           double max)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
+
+    d_cell.d_count.addRelaxed(count);
+    atomicAdd(&d_cell.d_total, total);
+    atomicMin(&d_cell.d_min,   min);
+    atomicMax(&d_cell.d_max,   max);
+}
+
+void Collector::setCountTotalMinMax(int    count,
+                                    double total,
+                                    double min,
+                                    double max)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
+
+    resetCells();
+
+    d_cell.d_count.storeRelease(count);
+    d_cell.d_total.storeRelease(toBits(total));
+    d_cell.d_min.storeRelease(toBits(min));
+    d_cell.d_max.storeRelease(toBits(max));
+}
+
+// ACCESSORS
+void Collector::load(MetricRecord *record) const
+{
+    int    count = 0;
+    double total = 0.0;
+    double min   = MetricRecord::k_DEFAULT_MIN;
+    double max   = MetricRecord::k_DEFAULT_MAX;
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
+
+    // Merge 'd_cell' (at index -1) and the cells updated by concurrent
+    // threads, if they were allocated.
+
+    char      *cellBuffer = d_cellBuffer_p.loadAcquire();
+    const int  numCells   = cellBuffer ? k_NUM_CELLS : 0;
+
+    for (int i = -1; i < numCells; ++i) {
+        const Cell& c = 0 <= i ? cell(cellBuffer, i) : d_cell;
+        count += c.d_count.loadAcquire();
+        total += fromBits(c.d_total.loadAcquire());
+        min    = bsl::min(min, fromBits(c.d_min.loadAcquire()));
+        max    = bsl::max(max, fromBits(c.d_max.loadAcquire()));
+    }
+
+    record->metricId() = d_metricId;
+    record->count()    = count;
+    record->total()    = total;
+    record->min()      = min;
+    record->max()      = max;
+}
+
+}  // close package namespace
 }  // close enterprise namespace
 
 // ----------------------------------------------------------------------------
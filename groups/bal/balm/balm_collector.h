@@ -42,6 +42,35 @@ BSLS_IDENT("$Id: balm_collector.h,v 1.7 2008/04/16 20:00:49 hversche Exp $")
 // operations on a given instance can be safely invoked simultaneously from
 // multiple threads.
 //
+// The 'update' method, which is typically invoked far more frequently than
+// the other methods, does not acquire a lock.  Instead, a collector holds its
+// aggregates in a cell of atomic count, total, minimum, and maximum values,
+// which 'update' modifies (using a compare-and-swap loop for the total,
+// minimum, and maximum).  The first time 'update' finds that the cell was
+// modified concurrently by another thread, the collector allocates a small
+// array of cache-line-aligned cells (see {Memory Usage}), and 'update' then
+// modifies the cell selected by a hash of the id of the calling thread, so
+// that threads updating the same collector concurrently rarely contend for
+// the same cache line.  The cells are merged by 'load' and 'loadAndReset'.
+// The remaining operations are serialized with respect to each other by a
+// mutex, and so are atomic with respect to each other, but not with respect
+// to 'update': the effect of an 'update' that is concurrent with a
+// 'loadAndReset' may be split between the record loaded by that
+// 'loadAndReset' and the following collection period (e.g., the count may be
+// reported in one period and the value in the next), although no update is
+// ever lost.
+//
+///Memory Usage
+///------------
+// A collector that is only updated by one thread at a time occupies about 100
+// bytes (on 64-bit platforms), and allocates no memory.  A collector that has
+// been updated concurrently additionally holds, until it is destroyed, 16
+// cells of 'bslmt::Platform::e_CACHE_LINE_SIZE' bytes (about 1 KB on usual
+// platforms), supplied by the allocator specified at construction.  Note that
+// a 'balm::CollectorRepository' holds a 'balm::Collector' and a
+// 'balm::IntegerCollector' for each metric, so this memory is allocated only
+// for the metrics that are updated concurrently.
+//
 ///Usage
 ///-----
 // The following example creates a 'balm::Collector', modifies its values, then
@@ -89,18 +118,46 @@ BSLS_IDENT("$Id: balm_collector.h,v 1.7 2008/04/16 20:00:49 hversche Exp $")
 #include <balm_metricid.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
 #ifndef INCLUDED_BSLMT_MUTEX
 #include <bslmt_mutex.h>
 #endif
 
-#ifndef INCLUDED_BSLMT_LOCKGUARD
-#include <bslmt_lockguard.h>
+#ifndef INCLUDED_BSLMT_PLATFORM
+#include <bslmt_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
 #endif
 
 #ifndef INCLUDED_BSL_ALGORITHM
 #include <bsl_algorithm.h>
 #endif
 
+#ifndef INCLUDED_BSL_CSTRING
+#include <bsl_cstring.h>
+#endif
+
 namespace BloombergLP {
 
 
@@ -113,28 +170,115 @@ namespace balm {
 class Collector {
     // This class provides a mechanism for collecting and aggregating the
     // value of a metric over a period of time.  The collector contains a
-    // 'MetricRecord' object that holds the identity of the metric being
-    // collected, the number of times an event occurred, and the total,
-    // minimum, and maximum aggregates of the associated measurement value.
-    // The default value for the count is 0, the default value for the total
-    // is 0.0, the default minimum value is 'MetricRecord::k_DEFAULT_MIN', and
-    // the default maximum value is 'MetricRecord::k_DEFAULT_MAX'.
+    // 'MetricId' object identifying the metric being collected, the number of
+    // times an event occurred, and the total, minimum, and maximum aggregates
+    // of the associated measurement value.  The default value for the count
+    // is 0, the default value for the total is 0.0, the default minimum value
+    // is 'MetricRecord::k_DEFAULT_MIN', and the default maximum value is
+    // 'MetricRecord::k_DEFAULT_MAX'.
+
+    // PRIVATE TYPES
+    struct Cell {
+        // This 'struct' holds the aggregates of the values supplied to
+        // 'update' by the threads assigned to one cell of a collector.  The
+        // total, minimum, and maximum are stored as the bit patterns of
+        // 'double' values.
+
+        bsls::AtomicInt   d_count;  // aggregated count of events
+        bsls::AtomicInt64 d_total;  // total of values across events
+        bsls::AtomicInt64 d_min;    // minimum value across events
+        bsls::AtomicInt64 d_max;    // maximum value across events
+    };
+
+    enum {
+        k_NUM_CELLS_LOG2 = 4,                      // log2 of 'k_NUM_CELLS'
+
+        k_NUM_CELLS      = 1 << k_NUM_CELLS_LOG2,  // number of stripes
+
+        k_CELL_SIZE      = bslmt::Platform::e_CACHE_LINE_SIZE
+                                                   // distance between cells
+    };
 
     // DATA
-    MetricRecord         d_record;  // the recorded metric information
-    mutable bslmt::Mutex d_lock;    // record synchronization mechanism
+    MetricId                  d_metricId;      // metric identifier
+
+    Cell                      d_cell;          // cell updated until 'update'
+                                               // is first called concurrently
+
+    bsls::AtomicPointer<char> d_cellBuffer_p;  // storage for 'k_NUM_CELLS'
+                                               // cells aligned on a cache
+                                               // line, or 0 if not yet
+                                               // allocated (owned)
+
+    mutable bslmt::Mutex      d_lock;          // serializes the operations
+                                               // other than 'update'
+
+    bslma::Allocator         *d_allocator_p;   // memory allocator (held, not
+                                               // owned)
 
     // NOT IMPLEMENTED
     Collector(const Collector&);
     Collector& operator=(const Collector&);
 
+    // PRIVATE CLASS METHODS
+    static int cellIndex();
+        // Return the index of the cell updated by the calling thread.
+
+    static Cell& cell(char *cellBuffer, int index);
+        // Return a reference to the modifiable cell at the specified 'index'
+        // within the specified 'cellBuffer'.
+
+    static void resetCell(Cell *cell);
+        // Reset the specified 'cell' to its default state.
+
+    static bool incrementCount(bsls::AtomicInt *count);
+        // Atomically increment the specified 'count' by 1.  Return 'true' if
+        // 'count' was concurrently modified by another thread, and 'false'
+        // otherwise.
+
+    static double fromBits(bsls::Types::Int64 bits);
+        // Return the 'double' value having the specified 'bits'.
+
+    static bsls::Types::Int64 toBits(double value);
+        // Return the bit pattern of the specified 'value'.
+
+    static void atomicAdd(bsls::AtomicInt64 *bits, double value);
+        // Atomically add the specified 'value' to the 'double' value having
+        // the specified 'bits'.
+
+    static void atomicMin(bsls::AtomicInt64 *bits, double value);
+        // Atomically set the 'double' value having the specified 'bits' to
+        // the specified 'value' if 'value' is less than that 'double' value.
+
+    static void atomicMax(bsls::AtomicInt64 *bits, double value);
+        // Atomically set the 'double' value having the specified 'bits' to
+        // the specified 'value' if 'value' is greater than that 'double'
+        // value.
+
+    // PRIVATE MANIPULATORS
+    void allocateCells();
+        // Allocate the 'k_NUM_CELLS' cells updated by concurrent threads, in
+        // their default states, unless another thread did so.
+
+    void resetCells();
+        // Reset all the cells to their default states.  The behavior is
+        // undefined unless 'd_lock' is held by the calling thread.
+
   public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(Collector, bslma::UsesBslmaAllocator);
+
      // CREATORS
-    Collector(const MetricId& metricId);
+    Collector(const MetricId&   metricId,
+              bslma::Allocator *basicAllocator = 0);
         // Create a collector for a metric having the specified 'metricId',
         // and having an initial count of 0, total of 0.0, min of
         // 'MetricRecord::k_DEFAULT_MIN', and max of
-        // 'MetricRecord::k_DEFAULT_MAX'.
+        // 'MetricRecord::k_DEFAULT_MAX'.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  Note that
+        // memory is allocated only once this collector is updated
+        // concurrently (see {Memory Usage}).
 
     ~Collector();
         // Destroy this object.
@@ -156,13 +300,16 @@ class Collector {
         // will be 'MetricRecord::k_DEFAULT_MIN', and the maximum value will be
         // 'MetricRecord::k_DEFAULT_MAX'.  Note that this operation is
         // logically equivalent to calling the 'load' and then the 'reset'
-        // methods except that it is performed as a single atomic operation.
+        // methods except that it is performed as a single atomic operation
+        // with respect to all the other manipulators except 'update' (see
+        // {Thread Safety}).
 
     void update(double value);
         // Increment the event count by 1, add the specified 'value' to the
         // total, if 'value' is less than the minimum value, set 'value' to be
         // the minimum value, and if 'value' is greater than the maximum
-        // value, set 'value' to be the maximum value.
+        // value, set 'value' to be the maximum value.  Note that this
+        // operation does not acquire a lock (see {Thread Safety}).
 
     void accumulateCountTotalMinMax(int    count,
                                     double total,
@@ -198,92 +345,130 @@ class Collector {
                               // class Collector
                               // ---------------
 
-// CREATORS
+// PRIVATE CLASS METHODS
 inline
-Collector::Collector(const MetricId& metricId)
-: d_record(metricId)
-, d_lock()
+int Collector::cellIndex()
 {
+    // Thread identifiers are typically addresses of per-thread data, which
+    // differ mostly in their middle bits: fold them, then use the high-order
+    // bits of a multiplicative hash.
+
+    const bsls::Types::Uint64 id   = bslmt::ThreadUtil::selfIdAsUint64();
+    const unsigned int        hash = static_cast<unsigned int>(id ^ (id >> 32))
+                                   * 2654435769U;
+
+    return static_cast<int>(hash >> (32 - k_NUM_CELLS_LOG2));
 }
 
 inline
-Collector::~Collector()
+Collector::Cell& Collector::cell(char *cellBuffer, int index)
 {
+    // Skip to the first cache line boundary within 'cellBuffer'.
+
+    const bsls::Types::UintPtr address =
+                           reinterpret_cast<bsls::Types::UintPtr>(cellBuffer);
+    char *cells = cellBuffer + (k_CELL_SIZE - address % k_CELL_SIZE);
+
+    return *reinterpret_cast<Cell *>(cells + index * k_CELL_SIZE);
 }
 
-// MANIPULATORS
 inline
-void Collector::reset()
+bool Collector::incrementCount(bsls::AtomicInt *count)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
-    d_record.count() = 0;
-    d_record.total() = 0.0;
-    d_record.min()   = MetricRecord::k_DEFAULT_MIN;
-    d_record.max()   = MetricRecord::k_DEFAULT_MAX;
+    const int current = count->loadRelaxed();
+    if (current == count->testAndSwapAcqRel(current, current + 1)) {
+        return false;                                                 // RETURN
+    }
+    count->addRelaxed(1);
+    return true;
 }
 
 inline
-void Collector::loadAndReset(MetricRecord *record)
+double Collector::fromBits(bsls::Types::Int64 bits)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
-    *record          = d_record;
-    d_record.count() = 0;
-    d_record.total() = 0.0;
-    d_record.min()   = MetricRecord::k_DEFAULT_MIN;
-    d_record.max()   = MetricRecord::k_DEFAULT_MAX;
+    double value;
+    bsl::memcpy(&value, &bits, sizeof value);
+    return value;
 }
 
 inline
-void Collector::update(double value)
+bsls::Types::Int64 Collector::toBits(double value)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
-    ++d_record.count();
-    d_record.total() += value;
-    d_record.min()   =  bsl::min(d_record.min(), value);
-    d_record.max()   =  bsl::max(d_record.max(), value);
+    bsls::Types::Int64 bits;
+    bsl::memcpy(&bits, &value, sizeof bits);
+    return bits;
 }
 
 inline
-void Collector::accumulateCountTotalMinMax(int    count,
-                                           double total,
-                                           double min,
-                                           double max)
+void Collector::atomicAdd(bsls::AtomicInt64 *bits, double value)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
-    d_record.count() += count;
-    d_record.total() += total;
-    d_record.min()   =  bsl::min(d_record.min(), min);
-    d_record.max()   =  bsl::max(d_record.max(), max);
+    bsls::Types::Int64 current = bits->loadRelaxed();
+    for (;;) {
+        const bsls::Types::Int64 previous = bits->testAndSwapAcqRel(
+                                           current,
+                                           toBits(fromBits(current) + value));
+        if (previous == current) {
+            return;                                                   // RETURN
+        }
+        current = previous;
+    }
 }
 
 inline
-void Collector::setCountTotalMinMax(int    count,
-                                    double total,
-                                    double min,
-                                    double max)
+void Collector::atomicMin(bsls::AtomicInt64 *bits, double value)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
-    d_record.count() = count;
-    d_record.total() = total;
-    d_record.min()   = min;
-    d_record.max()   = max;
+    bsls::Types::Int64 current = bits->loadRelaxed();
+    while (value < fromBits(current)) {
+        const bsls::Types::Int64 previous = bits->testAndSwapAcqRel(
+                                                              current,
+                                                              toBits(value));
+        if (previous == current) {
+            return;                                                   // RETURN
+        }
+        current = previous;
+    }
 }
 
-// ACCESSORS
 inline
-const MetricId& Collector::metricId() const
+void Collector::atomicMax(bsls::AtomicInt64 *bits, double value)
 {
-    return d_record.metricId();
+    bsls::Types::Int64 current = bits->loadRelaxed();
+    while (fromBits(current) < value) {
+        const bsls::Types::Int64 previous = bits->testAndSwapAcqRel(
+                                                              current,
+                                                              toBits(value));
+        if (previous == current) {
+            return;                                                   // RETURN
+        }
+        current = previous;
+    }
 }
 
+// MANIPULATORS
 inline
-void Collector::load(MetricRecord *record) const
+void Collector::update(double value)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_lock);
-    *record = d_record;
+    char *cellBuffer = d_cellBuffer_p.loadAcquire();
+    Cell& c          = cellBuffer ? cell(cellBuffer, cellIndex()) : d_cell;
+
+    const bool contended = incrementCount(&c.d_count);
+    atomicAdd(&c.d_total, value);
+    atomicMin(&c.d_min,   value);
+    atomicMax(&c.d_max,   value);
+
+    if (contended && !cellBuffer) {
+        allocateCells();
+    }
 }
-}  // close package namespace
 
+// ACCESSORS
+inline
+const MetricId& Collector::metricId() const
+{
+    return d_metricId;
+}
+
+}  // close package namespace
 }  // close enterprise namespace
 
 #endif
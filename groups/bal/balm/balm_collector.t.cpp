@@ -14,10 +14,15 @@
 
 #include <bslma_testallocator.h>
 #include <bslmt_barrier.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadgroup.h>
+#include <bsls_stopwatch.h>
 #include <bdlmt_fixedthreadpool.h>
 #include <bdlf_bind.h>
 
 #include <bsl_functional.h>
+#include <bsl_iomanip.h>
 #include <bsl_iostream.h>
 #include <bsl_limits.h>
 #include <bsl_ostream.h>
@@ -45,6 +50,7 @@ using bsl::flush;
 // ----------------------------------------------------------------------------
 // CREATORS
 // [ 3]  balm::Collector(const balm::MetricId& metric);
+// [ 9]  balm::Collector(const balm::MetricId&, bslma::Allocator *);
 // [ 3]  ~balm::Collector();
 //
 // MANIPULATORS
@@ -64,7 +70,9 @@ using bsl::flush;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 8] CONCURRENCY TEST
-// [ 9] USAGE EXAMPLE
+// [ 9] MEMORY USAGE
+// [10] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: 'update'
 
 // ============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -216,6 +224,95 @@ void ConcurrencyTest::runTest()
     d_pool.drain();
 }
 
+// ============================================================================
+//                        GLOBAL CLASSES FOR BENCHMARKS
+// ----------------------------------------------------------------------------
+
+namespace benchmark {
+
+class MutexCollector {
+    // This class provides a baseline for the cost of the 'update' method of a
+    // 'balm::Collector': it aggregates the same values under a single mutex,
+    // as 'balm::Collector' did prior to striping its cells.
+
+    // DATA
+    int                d_count;
+    double             d_total;
+    double             d_min;
+    double             d_max;
+    bslmt::Mutex       d_mutex;
+
+  public:
+    // CREATORS
+    MutexCollector()
+    : d_count(0)
+    , d_total(0)
+    , d_min(bsl::numeric_limits<double>::max())
+    , d_max(-bsl::numeric_limits<double>::max())
+    {
+    }
+
+    // MANIPULATORS
+    void update(double value)
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        ++d_count;
+        d_total += value;
+        d_min    = bsl::min(d_min, value);
+        d_max    = bsl::max(d_max, value);
+    }
+
+    // ACCESSORS
+    int count()
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_count;
+    }
+};
+
+template <class COLLECTOR>
+void updateLoop(COLLECTOR      *collector,
+                int             numUpdates,
+                bslmt::Barrier *barrier)
+    // Wait on the specified 'barrier', then invoke 'update' on the specified
+    // 'collector' the specified 'numUpdates' times.
+{
+    barrier->wait();
+    for (int i = 0; i < numUpdates; ++i) {
+        collector->update(static_cast<double>(i & 0xff));
+    }
+}
+
+template <class COLLECTOR>
+double runUpdates(COLLECTOR *collector, int numThreads, int numUpdates)
+    // Invoke 'update' on the specified 'collector' the specified 'numUpdates'
+    // times from each of the specified 'numThreads' threads, and return the
+    // elapsed wall time, in nanoseconds, per 'update'.
+{
+    bslma::TestAllocator ta;
+    bslmt::Barrier       barrier(numThreads + 1);
+    bslmt::ThreadGroup   threads(&ta);
+
+    threads.addThreads(bdlf::BindUtil::bindS(&ta,
+                                             &updateLoop<COLLECTOR>,
+                                             collector,
+                                             numUpdates,
+                                             &barrier),
+                       numThreads);
+
+    bsls::Stopwatch timer;
+    timer.start();
+    barrier.wait();
+    threads.joinAll();
+    timer.stop();
+
+    const double totalUpdates = static_cast<double>(numThreads) * numUpdates;
+
+    return timer.elapsedTime() * 1e9 / totalUpdates;
+}
+
+}  // close namespace benchmark
+
 // ============================================================================
 //                               USAGE EXAMPLE
 // ----------------------------------------------------------------------------
@@ -245,7 +342,7 @@ int main(int argc, char *argv[])
     Id metric_B(DESC_B); const Id& METRIC_B = metric_B;
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 9: {
+      case 10: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //
@@ -299,6 +396,74 @@ int main(int argc, char *argv[])
         ASSERT(3.0      == record.max());
 //..
       } break;
+      case 9: {
+        // --------------------------------------------------------------------
+        // MEMORY USAGE
+        //
+        // Concerns:
+        //: 1 A collector updated by a single thread allocates no memory.
+        //:
+        //: 2 A collector updated concurrently allocates its cells at most
+        //:   once, from the allocator supplied at construction, and no update
+        //:   is lost.
+        //:
+        //: 3 The cells are released on destruction.
+        //
+        // Plan:
+        //: 1 Update a collector from the main thread, and verify that neither
+        //:   the supplied nor the default allocator is used.  (C-1)
+        //:
+        //: 2 Update the collector from several threads, and verify that at
+        //:   most one block is allocated from the supplied allocator, and
+        //:   that the aggregated values are correct.  Note that the cells may
+        //:   not be allocated if the threads happen not to contend.  (C-2)
+        //:
+        //: 3 Destroy the collector, and verify that no memory is in use.
+        //:   (C-3)
+        //
+        // Testing:
+        //   MEMORY USAGE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TEST MEMORY USAGE" << endl
+                                  << "=================" << endl;
+
+        bslma::TestAllocator defaultAllocator;
+        bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+        bslma::TestAllocator ta;
+        {
+            Obj mX(METRIC_A, &ta); const Obj& MX = mX;
+
+            for (int i = 0; i < 1000; ++i) {
+                mX.update(static_cast<double>(i & 0xff));
+            }
+            ASSERT(0 == ta.numBlocksTotal());
+
+            const int NUM_THREADS = 4;
+            const int NUM_UPDATES = 100000;
+
+            benchmark::runUpdates(&mX, NUM_THREADS, NUM_UPDATES);
+            if (verbose) {
+                P(ta.numBlocksTotal());
+            }
+            ASSERT(1 >= ta.numBlocksTotal());
+
+            balm::MetricRecord record;
+            MX.load(&record);
+            ASSERT(1000 + NUM_THREADS * NUM_UPDATES == record.count());
+            ASSERT(0   == record.min());
+            ASSERT(255 == record.max());
+
+            mX.loadAndReset(&record);
+            ASSERT(1000 + NUM_THREADS * NUM_UPDATES == record.count());
+
+            MX.load(&record);
+            ASSERT(0 == record.count());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
       case 8: {
         // --------------------------------------------------------------------
         // CONCURRENCY TEST
@@ -778,6 +943,56 @@ int main(int argc, char *argv[])
         ASSERT(Rec::k_DEFAULT_MAX == r1.max());
 
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: 'update'
+        //
+        // Concerns:
+        //: 1 The cost of 'update' does not grow significantly with the
+        //:   number of threads concurrently updating the same collector.
+        //
+        // Plan:
+        //: 1 For 1, 2, 4, ..., 64 threads, invoke 'update' on a single
+        //:   collector from every thread, and report the elapsed wall time
+        //:   per 'update' for a 'balm::Collector' and for a mutex-protected
+        //:   collector.  Verify the loaded count.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: 'update'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "PERFORMANCE TEST: 'update'" << endl
+                                  << "==========================" << endl;
+
+        const int NUM_UPDATES = 1000000;
+
+        cout << "threads  ns/update  ns/update (mutex)" << endl;
+
+        for (int numThreads = 1; numThreads <= 64; numThreads *= 2) {
+            const int numUpdates = NUM_UPDATES / numThreads;
+
+            Obj mX(METRIC_A);
+            const double lockFree = benchmark::runUpdates(&mX,
+                                                          numThreads,
+                                                          numUpdates);
+
+            Rec record;
+            mX.load(&record);
+            LOOP_ASSERT(numThreads,
+                        numThreads * numUpdates == record.count());
+
+            benchmark::MutexCollector mY;
+            const double locked = benchmark::runUpdates(&mY,
+                                                        numThreads,
+                                                        numUpdates);
+
+            LOOP_ASSERT(numThreads, numThreads * numUpdates == mY.count());
+
+            cout << bsl::setw(7)  << numThreads << "  "
+                 << bsl::setw(9)  << lockFree   << "  "
+                 << bsl::setw(17) << locked     << endl;
+        }
+      } break;
       default: {
         bsl::cerr << "WARNING: CASE `" << test << "' NOT FOUND." << bsl::endl;
         testStatus = -1;
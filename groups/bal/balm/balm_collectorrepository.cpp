@@ -159,7 +159,7 @@ template <class COLLECTOR>
 CollectorRepository_Collectors<COLLECTOR>::
       CollectorRepository_Collectors(const MetricId&   metricId,
                                      bslma::Allocator *basicAllocator)
-: d_defaultCollector(metricId)
+: d_defaultCollector(metricId, basicAllocator)
 , d_addedCollectors(basicAllocator)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
@@ -186,7 +186,8 @@ bsl::shared_ptr<COLLECTOR>
 CollectorRepository_Collectors<COLLECTOR>::addCollector()
 {
     Collector collectorPtr(
-                new (*d_allocator_p) COLLECTOR(d_defaultCollector.metricId()),
+                new (*d_allocator_p) COLLECTOR(d_defaultCollector.metricId(),
+                                               d_allocator_p),
                 d_allocator_p);
     d_addedCollectors.insert(collectorPtr);
     return collectorPtr;
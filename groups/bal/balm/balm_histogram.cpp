@@ -0,0 +1,220 @@
+// balm_histogram.cpp                                                 -*-C++-*-
+#include <balm_histogram.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(balm_histogram_cpp,"$Id$ $CSID$")
+
+#include <bsl_algorithm.h>
+#include <bsl_cmath.h>
+#include <bsl_limits.h>
+
+namespace BloombergLP {
+namespace balm {
+
+                              // ---------------
+                              // class Histogram
+                              // ---------------
+
+// PUBLIC CONSTANTS
+const int                Histogram::k_DEFAULT_SIGNIFICANT_BITS;
+const int                Histogram::k_MAX_SIGNIFICANT_BITS;
+const bsls::Types::Int64 Histogram::k_DEFAULT_MIN =
+                               bsl::numeric_limits<bsls::Types::Int64>::max();
+const bsls::Types::Int64 Histogram::k_DEFAULT_MAX =
+                               bsl::numeric_limits<bsls::Types::Int64>::min();
+
+// CREATORS
+Histogram::Histogram(bslma::Allocator *basicAllocator)
+: d_significantBits(k_DEFAULT_SIGNIFICANT_BITS)
+, d_highestTrackableValue(bsl::numeric_limits<bsls::Types::Int64>::max())
+, d_buckets(basicAllocator)
+, d_count(0)
+, d_total(0)
+, d_min(k_DEFAULT_MIN)
+, d_max(k_DEFAULT_MAX)
+{
+    d_buckets.resize(bucketIndex(d_highestTrackableValue, d_significantBits)
+                                                                         + 1);
+}
+
+Histogram::Histogram(int                 significantBits,
+                     bsls::Types::Int64  highestTrackableValue,
+                     bslma::Allocator   *basicAllocator)
+: d_significantBits(significantBits)
+, d_highestTrackableValue(highestTrackableValue)
+, d_buckets(basicAllocator)
+, d_count(0)
+, d_total(0)
+, d_min(k_DEFAULT_MIN)
+, d_max(k_DEFAULT_MAX)
+{
+    BSLS_ASSERT(1 <= significantBits);
+    BSLS_ASSERT(significantBits <= k_MAX_SIGNIFICANT_BITS);
+    BSLS_ASSERT(0 <= highestTrackableValue);
+
+    d_buckets.resize(bucketIndex(highestTrackableValue, significantBits) + 1);
+}
+
+Histogram::Histogram(const Histogram&  original,
+                     bslma::Allocator *basicAllocator)
+: d_significantBits(original.d_significantBits)
+, d_highestTrackableValue(original.d_highestTrackableValue)
+, d_buckets(original.d_buckets, basicAllocator)
+, d_count(original.d_count)
+, d_total(original.d_total)
+, d_min(original.d_min)
+, d_max(original.d_max)
+{
+}
+
+// MANIPULATORS
+Histogram& Histogram::operator=(const Histogram& rhs)
+{
+    d_buckets               = rhs.d_buckets;
+    d_significantBits       = rhs.d_significantBits;
+    d_highestTrackableValue = rhs.d_highestTrackableValue;
+    d_count                 = rhs.d_count;
+    d_total                 = rhs.d_total;
+    d_min                   = rhs.d_min;
+    d_max                   = rhs.d_max;
+
+    return *this;
+}
+
+void Histogram::record(bsls::Types::Int64 value, bsls::Types::Int64 count)
+{
+    BSLS_ASSERT_SAFE(0 <= count);
+
+    if (0 == count) {
+        return;                                                       // RETURN
+    }
+
+    const int index = value <= 0
+                    ? 0
+                    : value >= d_highestTrackableValue
+                    ? numBuckets() - 1
+                    : bucketIndex(value, d_significantBits);
+
+    d_buckets[index] += count;
+    d_count          += count;
+    d_total          += value * count;
+    if (value < d_min) {
+        d_min = value;
+    }
+    if (value > d_max) {
+        d_max = value;
+    }
+}
+
+void Histogram::merge(const Histogram& other)
+{
+    BSLS_ASSERT(d_significantBits == other.d_significantBits);
+
+    const int numShared = bsl::min(numBuckets(), other.numBuckets());
+    for (int i = 0; i < numShared; ++i) {
+        d_buckets[i] += other.d_buckets[i];
+    }
+    for (int i = numShared; i < other.numBuckets(); ++i) {
+        d_buckets.back() += other.d_buckets[i];
+    }
+    d_count += other.d_count;
+    accumulateTotalMinMax(other.d_total, other.d_min, other.d_max);
+}
+
+void Histogram::reset(int                significantBits,
+                      bsls::Types::Int64 highestTrackableValue)
+{
+    BSLS_ASSERT(1 <= significantBits);
+    BSLS_ASSERT(significantBits <= k_MAX_SIGNIFICANT_BITS);
+    BSLS_ASSERT(0 <= highestTrackableValue);
+
+    d_significantBits       = significantBits;
+    d_highestTrackableValue = highestTrackableValue;
+    d_buckets.assign(bucketIndex(highestTrackableValue, significantBits) + 1,
+                     0);
+    d_count                 = 0;
+    d_total                 = 0;
+    d_min                   = k_DEFAULT_MIN;
+    d_max                   = k_DEFAULT_MAX;
+}
+
+// ACCESSORS
+bsls::Types::Int64 Histogram::valueAtQuantile(double quantile) const
+{
+    BSLS_ASSERT(0.0 <= quantile);
+    BSLS_ASSERT(quantile <= 1.0);
+
+    if (0 == d_count) {
+        return 0;                                                     // RETURN
+    }
+
+    // Find the bucket holding the value of rank 'ceil(quantile * count)'
+    // (counting from 1).
+
+    bsls::Types::Int64 rank = static_cast<bsls::Types::Int64>(
+                           bsl::ceil(quantile * static_cast<double>(d_count)));
+    if (rank < 1) {
+        rank = 1;
+    }
+    else if (rank > d_count) {
+        rank = d_count;
+    }
+
+    bsls::Types::Int64 cumulative = 0;
+    int                index      = 0;
+    for (; index < numBuckets() - 1; ++index) {
+        cumulative += d_buckets[index];
+        if (cumulative >= rank) {
+            break;
+        }
+    }
+
+    // The last bucket also holds the values greater than
+    // 'highestTrackableValue', the greatest of which is 'd_max'.
+
+    const bsls::Types::Int64 value = index == numBuckets() - 1
+                                   ? d_max
+                                   : bucketHighestValue(index,
+                                                        d_significantBits);
+
+    return value > d_max ? d_max : value < d_min ? d_min : value;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+bool balm::operator==(const Histogram& lhs, const Histogram& rhs)
+{
+    if (lhs.significantBits()       != rhs.significantBits()
+     || lhs.highestTrackableValue() != rhs.highestTrackableValue()
+     || lhs.count()                 != rhs.count()
+     || lhs.total()                 != rhs.total()
+     || lhs.min()                   != rhs.min()
+     || lhs.max()                   != rhs.max()) {
+        return false;                                                 // RETURN
+    }
+    for (int i = 0; i < lhs.numBuckets(); ++i) {
+        if (lhs.bucketCount(i) != rhs.bucketCount(i)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,536 @@
+// balm_histogram.h                                                   -*-C++-*-
+#ifndef INCLUDED_BALM_HISTOGRAM
+#define INCLUDED_BALM_HISTOGRAM
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a mergeable log-linear histogram of integral values.
+//
+//@CLASSES:
+//  balm::Histogram: log-linear (HDR-style) histogram of integral values
+//
+//@SEE_ALSO: balm_histogramcollector, balm_metricrecord
+//
+//@DESCRIPTION: This component provides a value-semantic class,
+// 'balm::Histogram', that records the distribution of a set of non-negative
+// integral values (typically latencies measured in some unit of time) in
+// bounded memory, and computes approximate quantiles (e.g., the median, or the
+// 99th percentile) of that distribution.  A 'balm::Histogram' also maintains
+// the exact count, total, minimum, and maximum of the recorded values, as
+// 'balm::MetricRecord' does.
+//
+///Bucket Layout
+///-------------
+// A 'balm::Histogram' counts values in buckets whose width grows with the
+// magnitude of the values they hold, so that every bucket has (about) the
+// same *relative* width.  The layout is determined by the 'significantBits'
+// attribute, 'p', supplied at construction: each of the values in
+// '[0 .. 2^p)' has its own bucket, and each subsequent power-of-two range
+// '[2^m .. 2^(m+1))' is divided into '2^(p-1)' buckets of equal width.  A
+// value is therefore identified by its bucket to within a relative error of
+// at most '2^(1-p)' (e.g., 1.6% for the default of 7 significant bits).  This
+// is the "log-linear" layout of the HDR histogram.
+//
+// The number of buckets (and therefore the memory used by a histogram) is
+// bounded by the 'highestTrackableValue' attribute, also supplied at
+// construction: a histogram has just enough buckets to hold values up to
+// 'highestTrackableValue'.  Values greater than 'highestTrackableValue' are
+// counted in the last bucket, and values less than 0 are counted in the first
+// bucket; such values are nevertheless reflected exactly in 'total', 'min',
+// and 'max'.  For example, a histogram of latencies in microseconds with a
+// 'highestTrackableValue' of one hour ('3600000000', or about '2^32') and 7
+// significant bits has 1708 buckets.
+//
+// The buckets are exposed through the 'bucketIndex', 'bucketLowestValue', and
+// 'bucketHighestValue' class methods, and the 'numBuckets' and 'bucketCount'
+// accessors, so that other components (such as 'balm_histogramcollector') can
+// maintain a compatible representation and transfer it to a histogram with
+// 'addToBucket' and 'accumulateTotalMinMax'.
+//
+///Merging
+///-------
+// Histograms having the same number of significant bits can be merged (using
+// the 'merge' method) exactly, by adding their bucket counts: the result is
+// the histogram that would have been obtained by recording the values of both
+// histograms in one.  This allows, for instance, per-thread or per-process
+// histograms to be combined at publication time.
+//
+///Quantiles
+///---------
+// The 'valueAtQuantile' method returns an approximation of the value below
+// which the specified fraction of the recorded values fall.  The returned
+// value is the highest value of the bucket containing the quantile, limited to
+// the range '[min() .. max()]' of the recorded values, or 'max()' if the
+// quantile is in the last bucket; in particular, 'valueAtQuantile(1.0)' is
+// 'max()'.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Computing Latency Percentiles
+/// - - - - - - - - - - - - - - - - - - - -
+// Suppose we measure the latency, in microseconds, of a number of requests,
+// and want to report the median and the 99th percentile.
+//
+// First, we create a histogram that can distinguish values within 1.6% of
+// each other, for latencies of up to one minute:
+//..
+//  balm::Histogram histogram(7, 60 * 1000 * 1000);
+//..
+// Then, we record 1000 latencies, 990 of which are between 100 and 199
+// microseconds, and 10 of which are 5 milliseconds:
+//..
+//  for (int i = 0; i < 990; ++i) {
+//      histogram.record(100 + i % 100);
+//  }
+//  for (int i = 0; i < 10; ++i) {
+//      histogram.record(5000);
+//  }
+//..
+// Next, we verify the exact aggregates:
+//..
+//  assert(1000   == histogram.count());
+//  assert(100    == histogram.min());
+//  assert(5000   == histogram.max());
+//..
+// Finally, we obtain the approximate median, which is within 1.6% of the
+// exact median of 149, and the 99th and 100th percentiles:
+//..
+//  const bsls::Types::Int64 median = histogram.valueAtQuantile(0.5);
+//  assert(149 <= median && median <= 149 + 149 / 64);
+//
+//  assert(199  == histogram.valueAtQuantile(0.99));
+//  assert(5000 == histogram.valueAtQuantile(1.0));
+//..
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDINT
+#include <bsl_cstdint.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace balm {
+
+                              // ===============
+                              // class Histogram
+                              // ===============
+
+class Histogram {
+    // This value-semantic class records the distribution of a set of integral
+    // values in log-linear buckets (see {Bucket Layout}), along with the exact
+    // count, total, minimum, and maximum of those values.
+
+    // DATA
+    int                               d_significantBits;
+                                            // number of significant bits
+                                            // distinguished by the buckets
+
+    bsls::Types::Int64                d_highestTrackableValue;
+                                            // highest value having its own
+                                            // bucket
+
+    bsl::vector<bsls::Types::Int64>   d_buckets;
+                                            // count of values in each bucket
+
+    bsls::Types::Int64                d_count;  // number of values
+    bsls::Types::Int64                d_total;  // total of the values
+    bsls::Types::Int64                d_min;    // minimum value
+    bsls::Types::Int64                d_max;    // maximum value
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(Histogram, bslma::UsesBslmaAllocator);
+
+    // PUBLIC CONSTANTS
+    static const int                k_DEFAULT_SIGNIFICANT_BITS = 7;
+        // default number of significant bits
+
+    static const int                k_MAX_SIGNIFICANT_BITS = 20;
+        // maximum number of significant bits
+
+    static const bsls::Types::Int64 k_DEFAULT_MIN;
+        // value of 'min' for an empty histogram (the maximum 'Int64' value)
+
+    static const bsls::Types::Int64 k_DEFAULT_MAX;
+        // value of 'max' for an empty histogram (the minimum 'Int64' value)
+
+    // CLASS METHODS
+    static int bucketIndex(bsls::Types::Int64 value, int significantBits);
+        // Return the index of the bucket holding the specified non-negative
+        // 'value' in a histogram having the specified 'significantBits', and
+        // an unlimited 'highestTrackableValue'.  The behavior is undefined
+        // unless '0 <= value' and
+        // '1 <= significantBits <= k_MAX_SIGNIFICANT_BITS'.
+
+    static bsls::Types::Int64 bucketLowestValue(int index,
+                                                int significantBits);
+        // Return the lowest value held by the bucket at the specified 'index'
+        // in a histogram having the specified 'significantBits'.  The
+        // behavior is undefined unless '0 <= index',
+        // '1 <= significantBits <= k_MAX_SIGNIFICANT_BITS', and 'index' is the
+        // index of a bucket for some 'Int64' value.
+
+    static bsls::Types::Int64 bucketHighestValue(int index,
+                                                 int significantBits);
+        // Return the highest value held by the bucket at the specified
+        // 'index' in a histogram having the specified 'significantBits'.  The
+        // behavior is undefined unless '0 <= index',
+        // '1 <= significantBits <= k_MAX_SIGNIFICANT_BITS', and 'index' is the
+        // index of a bucket for some 'Int64' value.
+
+    // CREATORS
+    explicit Histogram(bslma::Allocator *basicAllocator = 0);
+        // Create an empty histogram having 'k_DEFAULT_SIGNIFICANT_BITS'
+        // significant bits, and able to track all non-negative 'Int64'
+        // values.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+
+    Histogram(int                 significantBits,
+              bsls::Types::Int64  highestTrackableValue,
+              bslma::Allocator   *basicAllocator = 0);
+        // Create an empty histogram having the specified 'significantBits',
+        // and having buckets for values up to the specified
+        // 'highestTrackableValue'.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless
+        // '1 <= significantBits <= k_MAX_SIGNIFICANT_BITS' and
+        // '0 <= highestTrackableValue'.
+
+    Histogram(const Histogram&  original,
+              bslma::Allocator *basicAllocator = 0);
+        // Create a histogram having the same value as the specified
+        // 'original' histogram.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    //! ~Histogram() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    Histogram& operator=(const Histogram& rhs);
+        // Assign to this histogram the value of the specified 'rhs' histogram,
+        // and return a reference to this modifiable histogram.
+
+    void record(bsls::Types::Int64 value);
+        // Record the specified 'value' in this histogram.  Note that a
+        // 'value' less than 0 or greater than 'highestTrackableValue()' is
+        // counted in the first or last bucket, respectively, but is reflected
+        // exactly in 'total', 'min', and 'max'.
+
+    void record(bsls::Types::Int64 value, bsls::Types::Int64 count);
+        // Record the specified 'count' occurrences of the specified 'value' in
+        // this histogram.  The behavior is undefined unless '0 <= count'.
+
+    void merge(const Histogram& other);
+        // Add the values recorded in the specified 'other' histogram to this
+        // histogram.  Values of 'other' in buckets beyond the last bucket of
+        // this histogram are counted in the last bucket.  The behavior is
+        // undefined unless 'significantBits() == other.significantBits()'.
+
+    void addToBucket(int index, bsls::Types::Int64 count);
+        // Add the specified 'count' to the number of values in the bucket at
+        // the specified 'index', and to the 'count' of this histogram.  The
+        // behavior is undefined unless '0 <= index < numBuckets()' and
+        // '0 <= count'.  Note that this method does not modify 'total',
+        // 'min', or 'max' (see 'accumulateTotalMinMax').
+
+    void accumulateTotalMinMax(bsls::Types::Int64 total,
+                               bsls::Types::Int64 min,
+                               bsls::Types::Int64 max);
+        // Add the specified 'total' to the total of this histogram, and set
+        // the minimum to the specified 'min' if 'min' is less than the
+        // minimum, and the maximum to the specified 'max' if 'max' is greater
+        // than the maximum.  Note that this method, together with
+        // 'addToBucket', allows a histogram to be populated from a compatible
+        // representation.
+
+    void reset();
+        // Remove all the values recorded in this histogram.
+
+    void reset(int significantBits, bsls::Types::Int64 highestTrackableValue);
+        // Remove all the values recorded in this histogram, and set its
+        // number of significant bits to the specified 'significantBits' and
+        // its highest trackable value to the specified
+        // 'highestTrackableValue'.  The behavior is undefined unless
+        // '1 <= significantBits <= k_MAX_SIGNIFICANT_BITS' and
+        // '0 <= highestTrackableValue'.
+
+    // ACCESSORS
+    int significantBits() const;
+        // Return the number of significant bits distinguished by the buckets
+        // of this histogram.
+
+    bsls::Types::Int64 highestTrackableValue() const;
+        // Return the highest value for which this histogram has a bucket of
+        // the nominal precision.
+
+    int numBuckets() const;
+        // Return the number of buckets of this histogram.
+
+    bsls::Types::Int64 bucketCount(int index) const;
+        // Return the number of values recorded in the bucket at the specified
+        // 'index'.  The behavior is undefined unless
+        // '0 <= index < numBuckets()'.
+
+    bsls::Types::Int64 count() const;
+        // Return the number of values recorded in this histogram.
+
+    bsls::Types::Int64 total() const;
+        // Return the total of the values recorded in this histogram.
+
+    bsls::Types::Int64 min() const;
+        // Return the minimum value recorded in this histogram, or
+        // 'k_DEFAULT_MIN' if this histogram is empty.
+
+    bsls::Types::Int64 max() const;
+        // Return the maximum value recorded in this histogram, or
+        // 'k_DEFAULT_MAX' if this histogram is empty.
+
+    bsls::Types::Int64 valueAtQuantile(double quantile) const;
+        // Return an approximation of the value below which the specified
+        // 'quantile' fraction of the values recorded in this histogram fall
+        // (e.g., 'valueAtQuantile(0.99)' is the 99th percentile), or 0 if
+        // this histogram is empty.  The returned value is the highest value of
+        // the bucket containing the quantile, limited to the range
+        // '[min() .. max()]', or 'max()' if the quantile is in the last
+        // bucket.  The behavior is undefined unless
+        // '0.0 <= quantile <= 1.0'.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+};
+
+// FREE OPERATORS
+bool operator==(const Histogram& lhs, const Histogram& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' histograms have the same
+    // value, and 'false' otherwise.  Two histograms have the same value if
+    // they have the same number of significant bits, highest trackable
+    // value, bucket counts, total, minimum, and maximum.
+
+bool operator!=(const Histogram& lhs, const Histogram& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' histograms do not have
+    // the same value, and 'false' otherwise.  Two histograms do not have the
+    // same value if they differ in their number of significant bits, highest
+    // trackable value, bucket counts, total, minimum, or maximum.
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                              // ---------------
+                              // class Histogram
+                              // ---------------
+
+// CLASS METHODS
+inline
+int Histogram::bucketIndex(bsls::Types::Int64 value, int significantBits)
+{
+    BSLS_ASSERT_SAFE(0 <= value);
+    BSLS_ASSERT_SAFE(1 <= significantBits);
+    BSLS_ASSERT_SAFE(significantBits <= k_MAX_SIGNIFICANT_BITS);
+
+    // The values in '[2^m .. 2^(m+1))', for 'm >= significantBits', are
+    // shifted right by 'm - significantBits + 1' bits, leaving
+    // 'significantBits' bits whose leading bit is set.  The values less than
+    // '2^significantBits' are not shifted.
+
+    const bsl::uint64_t bits  = static_cast<bsl::uint64_t>(value);
+    const int           log2  =
+                            63 - bdlb::BitUtil::numLeadingUnsetBits(bits | 1);
+    const int           shift = log2 < significantBits
+                              ? 0
+                              : log2 - significantBits + 1;
+
+    return (shift << (significantBits - 1)) + static_cast<int>(bits >> shift);
+}
+
+inline
+bsls::Types::Int64 Histogram::bucketLowestValue(int index, int significantBits)
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(1 <= significantBits);
+    BSLS_ASSERT_SAFE(significantBits <= k_MAX_SIGNIFICANT_BITS);
+
+    const int halfCount = 1 << (significantBits - 1);
+    const int shift     = index < 2 * halfCount ? 0 : index / halfCount - 1;
+
+    const bsls::Types::Int64 subBucket = index - (shift << (significantBits
+                                                                        - 1));
+    return subBucket << shift;
+}
+
+inline
+bsls::Types::Int64 Histogram::bucketHighestValue(int index,
+                                                 int significantBits)
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(1 <= significantBits);
+    BSLS_ASSERT_SAFE(significantBits <= k_MAX_SIGNIFICANT_BITS);
+
+    const int halfCount = 1 << (significantBits - 1);
+    const int shift     = index < 2 * halfCount ? 0 : index / halfCount - 1;
+
+    return bucketLowestValue(index, significantBits)
+         + ((static_cast<bsls::Types::Int64>(1) << shift) - 1);
+}
+
+// MANIPULATORS
+inline
+void Histogram::record(bsls::Types::Int64 value)
+{
+    record(value, 1);
+}
+
+inline
+void Histogram::addToBucket(int index, bsls::Types::Int64 count)
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numBuckets());
+    BSLS_ASSERT_SAFE(0 <= count);
+
+    d_buckets[index] += count;
+    d_count          += count;
+}
+
+inline
+void Histogram::accumulateTotalMinMax(bsls::Types::Int64 total,
+                                      bsls::Types::Int64 min,
+                                      bsls::Types::Int64 max)
+{
+    d_total += total;
+    if (min < d_min) {
+        d_min = min;
+    }
+    if (max > d_max) {
+        d_max = max;
+    }
+}
+
+inline
+void Histogram::reset()
+{
+    reset(d_significantBits, d_highestTrackableValue);
+}
+
+// ACCESSORS
+inline
+int Histogram::significantBits() const
+{
+    return d_significantBits;
+}
+
+inline
+bsls::Types::Int64 Histogram::highestTrackableValue() const
+{
+    return d_highestTrackableValue;
+}
+
+inline
+int Histogram::numBuckets() const
+{
+    return static_cast<int>(d_buckets.size());
+}
+
+inline
+bsls::Types::Int64 Histogram::bucketCount(int index) const
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numBuckets());
+
+    return d_buckets[index];
+}
+
+inline
+bsls::Types::Int64 Histogram::count() const
+{
+    return d_count;
+}
+
+inline
+bsls::Types::Int64 Histogram::total() const
+{
+    return d_total;
+}
+
+inline
+bsls::Types::Int64 Histogram::min() const
+{
+    return d_min;
+}
+
+inline
+bsls::Types::Int64 Histogram::max() const
+{
+    return d_max;
+}
+
+inline
+bslma::Allocator *Histogram::allocator() const
+{
+    return d_buckets.get_allocator().mechanism();
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+inline
+bool balm::operator!=(const Histogram& lhs, const Histogram& rhs)
+{
+    return !(lhs == rhs);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
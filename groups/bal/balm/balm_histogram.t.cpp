@@ -0,0 +1,947 @@
+// balm_histogram.t.cpp                                               -*-C++-*-
+
+#include <balm_histogram.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cmath.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_limits.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test defines a value-semantic class, 'balm::Histogram',
+// counting values in log-linear buckets.  We first verify the bucket layout
+// computed by the class methods (every value lies within the bounds of its
+// bucket, buckets are contiguous, and their relative width is bounded), then
+// the manipulators and accessors, the value-semantic operations, 'merge', and
+// finally that 'valueAtQuantile' approximates exact quantiles to within the
+// documented precision.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] int bucketIndex(Int64 value, int significantBits);
+// [ 2] Int64 bucketLowestValue(int index, int significantBits);
+// [ 2] Int64 bucketHighestValue(int index, int significantBits);
+//
+// CREATORS
+// [ 3] explicit Histogram(bslma::Allocator *basicAllocator = 0);
+// [ 3] Histogram(int significantBits, Int64 highestValue, alloc);
+// [ 4] Histogram(const Histogram& original, alloc);
+//
+// MANIPULATORS
+// [ 4] Histogram& operator=(const Histogram& rhs);
+// [ 3] void record(Int64 value);
+// [ 3] void record(Int64 value, Int64 count);
+// [ 5] void merge(const Histogram& other);
+// [ 3] void addToBucket(int index, Int64 count);
+// [ 3] void accumulateTotalMinMax(Int64 total, Int64 min, Int64 max);
+// [ 3] void reset();
+// [ 3] void reset(int significantBits, Int64 highestTrackableValue);
+//
+// ACCESSORS
+// [ 3] int significantBits() const;
+// [ 3] Int64 highestTrackableValue() const;
+// [ 3] int numBuckets() const;
+// [ 3] Int64 bucketCount(int index) const;
+// [ 3] Int64 count() const;
+// [ 3] Int64 total() const;
+// [ 3] Int64 min() const;
+// [ 3] Int64 max() const;
+// [ 6] Int64 valueAtQuantile(double quantile) const;
+// [ 3] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 4] bool operator==(const Histogram& lhs, const Histogram& rhs);
+// [ 4] bool operator!=(const Histogram& lhs, const Histogram& rhs);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool             verbose;
+bool         veryVerbose;
+bool     veryVeryVerbose;
+bool veryVeryVeryVerbose;
+
+typedef balm::Histogram    Obj;
+typedef bsls::Types::Int64 Int64;
+
+const Int64 INT64_MAX_VALUE = bsl::numeric_limits<Int64>::max();
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+Int64 exactQuantile(const bsl::vector<Int64>& sortedValues, double quantile)
+    // Return the value of rank 'ceil(quantile * sortedValues.size())'
+    // (counting from 1, and at least 1) in the specified 'sortedValues'.
+{
+    Int64 rank = static_cast<Int64>(
+                    bsl::ceil(quantile * static_cast<double>(
+                                                      sortedValues.size())));
+    if (rank < 1) {
+        rank = 1;
+    }
+    return sortedValues[static_cast<bsl::size_t>(rank - 1)];
+}
+
+unsigned int nextRandom(unsigned int *state)
+    // Return the next value of the linear congruential generator having the
+    // specified 'state'.
+{
+    *state = *state * 1103515245U + 12345U;
+    return *state >> 8;
+}
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+    bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+    bslma::TestAllocatorMonitor gam(&globalAllocator);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+        bslma::TestAllocator         ta("usage", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&ta);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Computing Latency Percentiles
+/// - - - - - - - - - - - - - - - - - - - -
+// Suppose we measure the latency, in microseconds, of a number of requests,
+// and want to report the median and the 99th percentile.
+//
+// First, we create a histogram that can distinguish values within 1.6% of
+// each other, for latencies of up to one minute:
+//..
+    balm::Histogram histogram(7, 60 * 1000 * 1000);
+//..
+// Then, we record 1000 latencies, 990 of which are between 100 and 199
+// microseconds, and 10 of which are 5 milliseconds:
+//..
+    for (int i = 0; i < 990; ++i) {
+        histogram.record(100 + i % 100);
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(5000);
+    }
+//..
+// Next, we verify the exact aggregates:
+//..
+    ASSERT(1000   == histogram.count());
+    ASSERT(100    == histogram.min());
+    ASSERT(5000   == histogram.max());
+//..
+// Finally, we obtain the approximate median, which is within 1.6% of the
+// exact median of 149, and the 99th and 100th percentiles:
+//..
+    const bsls::Types::Int64 median = histogram.valueAtQuantile(0.5);
+    ASSERT(149 <= median && median <= 149 + 149 / 64);
+
+    ASSERT(199  == histogram.valueAtQuantile(0.99));
+    ASSERT(5000 == histogram.valueAtQuantile(1.0));
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // QUANTILES
+        //
+        // Concerns:
+        //: 1 'valueAtQuantile' returns 0 for an empty histogram.
+        //:
+        //: 2 'valueAtQuantile(q)' is not less than the exact quantile, and
+        //:   exceeds it by at most the documented relative error.
+        //:
+        //: 3 'valueAtQuantile(1.0)' is 'max()', and the result is never
+        //:   outside '[min() .. max()]'.
+        //:
+        //: 4 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Query an empty histogram.  (C-1)
+        //:
+        //: 2 For several numbers of significant bits, record pseudo-random
+        //:   values spanning several orders of magnitude, and compare the
+        //:   result of 'valueAtQuantile' with the exact quantile of the
+        //:   sorted values for a range of quantiles.  (C-2..3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for out-of-range quantiles.  (C-4)
+        //
+        // Testing:
+        //   Int64 valueAtQuantile(double quantile) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "QUANTILES" << endl
+                                  << "=========" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        {
+            const Obj X(7, 1000, &ta);
+            ASSERT(0 == X.valueAtQuantile(0.0));
+            ASSERT(0 == X.valueAtQuantile(0.5));
+            ASSERT(0 == X.valueAtQuantile(1.0));
+        }
+
+        const double QUANTILES[] = {
+            0.0, 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0
+        };
+        const int NUM_QUANTILES = sizeof QUANTILES / sizeof *QUANTILES;
+
+        for (int bits = 1; bits <= 12; ++bits) {
+            Obj mX(bits, INT64_MAX_VALUE, &ta);  const Obj& X = mX;
+
+            bsl::vector<Int64> values(&ta);
+            unsigned int       state = bits;
+
+            for (int i = 0; i < 5000; ++i) {
+                // Values of varying magnitude, up to about 2^30.
+
+                const unsigned int magnitude = nextRandom(&state) % 31;
+                const Int64        range     = static_cast<Int64>(1)
+                                                                 << magnitude;
+                const Int64        value     =
+                                static_cast<Int64>(nextRandom(&state)) % range;
+                values.push_back(value);
+                mX.record(value);
+            }
+            bsl::sort(values.begin(), values.end());
+
+            for (int q = 0; q < NUM_QUANTILES; ++q) {
+                const double QUANTILE = QUANTILES[q];
+                const Int64  EXACT    = exactQuantile(values, QUANTILE);
+                const Int64  RESULT   = X.valueAtQuantile(QUANTILE);
+
+                if (veryVerbose) {
+                    T_ P_(bits) P_(QUANTILE) P_(EXACT) P(RESULT)
+                }
+
+                ASSERTV(bits, QUANTILE, EXACT, RESULT, EXACT <= RESULT);
+                ASSERTV(bits, QUANTILE, EXACT, RESULT,
+                        RESULT - EXACT <= (EXACT >> (bits - 1)));
+                ASSERTV(bits, QUANTILE, X.min() <= RESULT);
+                ASSERTV(bits, QUANTILE, RESULT <= X.max());
+            }
+            ASSERTV(bits, X.max() == X.valueAtQuantile(1.0));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(7, 1000, &ta);  const Obj& X = mX;
+            mX.record(5);
+
+            ASSERT_PASS(X.valueAtQuantile(0.0));
+            ASSERT_PASS(X.valueAtQuantile(1.0));
+            ASSERT_FAIL(X.valueAtQuantile(-0.1));
+            ASSERT_FAIL(X.valueAtQuantile(1.1));
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // MERGE
+        //
+        // Concerns:
+        //: 1 Merging two histograms having the same layout gives the
+        //:   histogram obtained by recording the values of both in one.
+        //:
+        //: 2 Values of a histogram having more buckets are counted in the
+        //:   last bucket of the merged-into histogram.
+        //:
+        //: 3 Merging an empty histogram has no effect.
+        //:
+        //: 4 Merging histograms having different numbers of significant bits
+        //:   is detected when enabled.
+        //
+        // Plan:
+        //: 1 Record disjoint sets of values in two histograms, and in a third
+        //:   histogram; merge the first two and compare with the third.
+        //:   (C-1)
+        //:
+        //: 2 Merge a histogram having a higher 'highestTrackableValue', and
+        //:   verify the last bucket.  (C-2)
+        //:
+        //: 3 Merge an empty histogram.  (C-3)
+        //:
+        //: 4 Use 'BSLS_ASSERTTEST_*' macros.  (C-4)
+        //
+        // Testing:
+        //   void merge(const Histogram& other);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "MERGE" << endl
+                                  << "=====" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        {
+            Obj mA(5, 100000, &ta);  const Obj& A = mA;
+            Obj mB(5, 100000, &ta);  const Obj& B = mB;
+            Obj mC(5, 100000, &ta);  const Obj& C = mC;
+
+            for (int i = 0; i < 1000; ++i) {
+                const Int64 value = (i * 7919) % 100000;
+                (i % 3 ? mA : mB).record(value);
+                mC.record(value);
+            }
+            ASSERT(A != C);
+            ASSERT(B != C);
+
+            mA.merge(B);
+            ASSERT(A == C);
+
+            const Obj EMPTY(5, 100000, &ta);
+            mA.merge(EMPTY);
+            ASSERT(A == C);
+        }
+        {
+            Obj mA(5, 100, &ta);      const Obj& A = mA;
+            Obj mB(5, 100000, &ta);   const Obj& B = mB;
+
+            ASSERT(A.numBuckets() < B.numBuckets());
+
+            mA.record(50);
+            mB.record(50);
+            mB.record(5000);
+            mB.record(90000);
+
+            mA.merge(B);
+
+            ASSERT(4     == A.count());
+            ASSERT(95100 == A.total());
+            ASSERT(50    == A.min());
+            ASSERT(90000 == A.max());
+            ASSERT(2     == A.bucketCount(A.numBuckets() - 1));
+            ASSERT(2     == A.bucketCount(Obj::bucketIndex(50, 5)));
+            ASSERT(90000 == A.valueAtQuantile(1.0));
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj       mX(5, 100, &ta);
+            const Obj SAME(5, 1000, &ta);
+            const Obj OTHER(6, 100, &ta);
+
+            ASSERT_PASS(mX.merge(SAME));
+            ASSERT_FAIL(mX.merge(OTHER));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // VALUE-SEMANTIC OPERATIONS
+        //
+        // Concerns:
+        //: 1 Two histograms compare equal if and only if they have the same
+        //:   layout, bucket counts, total, minimum, and maximum.
+        //:
+        //: 2 The copy constructor creates an equal object using the supplied
+        //:   (or default) allocator.
+        //:
+        //: 3 Assignment makes the target equal to the source, including the
+        //:   layout, does not change the allocator of the target, and
+        //:   supports aliasing.
+        //
+        // Plan:
+        //: 1 Create histograms differing in each attribute and compare them
+        //:   pairwise.  (C-1)
+        //:
+        //: 2 Copy-construct and assign histograms, and verify equality and
+        //:   allocators.  (C-2..3)
+        //
+        // Testing:
+        //   Histogram(const Histogram& original, alloc);
+        //   Histogram& operator=(const Histogram& rhs);
+        //   bool operator==(const Histogram& lhs, const Histogram& rhs);
+        //   bool operator!=(const Histogram& lhs, const Histogram& rhs);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "VALUE-SEMANTIC OPERATIONS" << endl
+                                  << "=========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        enum { k_NUM_OBJECTS = 7 };
+
+        Obj mV0(7, 1000, &ta);
+        Obj mV1(6, 1000, &ta);
+        Obj mV2(7, 2000, &ta);
+        Obj mV3(7, 1000, &ta);  mV3.record(5);
+        Obj mV4(7, 1000, &ta);  mV4.record(6);
+        Obj mV5(7, 1000, &ta);  mV5.record(5);  mV5.record(900);
+        Obj mV6(7, 1000, &ta);  mV6.record(5);  mV6.record(2000);
+
+        const Obj *VALUES[k_NUM_OBJECTS] = {
+            &mV0, &mV1, &mV2, &mV3, &mV4, &mV5, &mV6
+        };
+
+        for (int i = 0; i < k_NUM_OBJECTS; ++i) {
+            for (int j = 0; j < k_NUM_OBJECTS; ++j) {
+                ASSERTV(i, j, (i == j) == (*VALUES[i] == *VALUES[j]));
+                ASSERTV(i, j, (i != j) == (*VALUES[i] != *VALUES[j]));
+            }
+        }
+
+        for (int i = 0; i < k_NUM_OBJECTS; ++i) {
+            const Obj& V = *VALUES[i];
+
+            const Obj X(V, &sa);
+            ASSERTV(i, V == X);
+            ASSERTV(i, &sa == X.allocator());
+
+            for (int j = 0; j < k_NUM_OBJECTS; ++j) {
+                Obj mY(*VALUES[j], &sa);  const Obj& Y = mY;
+
+                Obj *mR = &(mY = V);
+                ASSERTV(i, j, mR == &mY);
+                ASSERTV(i, j, V == Y);
+                ASSERTV(i, j, &sa == Y.allocator());
+
+                mY = Y;
+                ASSERTV(i, j, V == Y);
+            }
+        }
+
+        {
+            bslma::TestAllocator         da("local", veryVeryVeryVerbose);
+            bslma::DefaultAllocatorGuard guard(&da);
+
+            const Obj X(mV5);
+            ASSERT(mV5 == X);
+            ASSERT(&da == X.allocator());
+            ASSERT(0 < da.numBytesInUse());
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CREATORS, MANIPULATORS, AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 A default-constructed histogram is empty, has the default
+        //:   number of significant bits, and tracks all non-negative values.
+        //:
+        //: 2 A histogram has exactly the buckets needed to hold values up to
+        //:   'highestTrackableValue'.
+        //:
+        //: 3 'record' updates the bucket of the value, the count, the total,
+        //:   the minimum, and the maximum; values less than 0 and greater
+        //:   than 'highestTrackableValue' are counted in the first and last
+        //:   buckets, respectively, but are otherwise reflected exactly.
+        //:
+        //: 4 'addToBucket' and 'accumulateTotalMinMax' update only the
+        //:   documented attributes.
+        //:
+        //: 5 'reset' empties the histogram, optionally changing its layout.
+        //:
+        //: 6 Memory is supplied by the specified allocator.
+        //:
+        //: 7 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Exercise each method and verify the state using the accessors.
+        //:   (C-1..6)
+        //:
+        //: 2 Use 'BSLS_ASSERTTEST_*' macros.  (C-7)
+        //
+        // Testing:
+        //   explicit Histogram(bslma::Allocator *basicAllocator = 0);
+        //   Histogram(int significantBits, Int64 highestValue, alloc);
+        //   void record(Int64 value);
+        //   void record(Int64 value, Int64 count);
+        //   void addToBucket(int index, Int64 count);
+        //   void accumulateTotalMinMax(Int64 total, Int64 min, Int64 max);
+        //   void reset();
+        //   void reset(int significantBits, Int64 highestTrackableValue);
+        //   int significantBits() const;
+        //   Int64 highestTrackableValue() const;
+        //   int numBuckets() const;
+        //   Int64 bucketCount(int index) const;
+        //   Int64 count() const;
+        //   Int64 total() const;
+        //   Int64 min() const;
+        //   Int64 max() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CREATORS, MANIPULATORS, AND ACCESSORS"
+                          << endl << "====================================="
+                          << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\nDefault construction." << endl;
+        {
+            const Obj X(&ta);
+
+            ASSERT(Obj::k_DEFAULT_SIGNIFICANT_BITS == X.significantBits());
+            ASSERT(INT64_MAX_VALUE == X.highestTrackableValue());
+            ASSERT(Obj::bucketIndex(INT64_MAX_VALUE,
+                                    Obj::k_DEFAULT_SIGNIFICANT_BITS) + 1 ==
+                                                             X.numBuckets());
+            ASSERT(0 == X.count());
+            ASSERT(0 == X.total());
+            ASSERT(Obj::k_DEFAULT_MIN == X.min());
+            ASSERT(Obj::k_DEFAULT_MAX == X.max());
+            ASSERT(&ta == X.allocator());
+            ASSERT(0 < ta.numBytesInUse());
+
+            for (int i = 0; i < X.numBuckets(); ++i) {
+                ASSERTV(i, 0 == X.bucketCount(i));
+            }
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\nNumber of buckets." << endl;
+        {
+            // 7 bits: 128 values in '[0 .. 128)', then 64 buckets per power
+            // of two.
+
+            const Obj A(7, 127, &ta);
+            ASSERT(128 == A.numBuckets());
+
+            const Obj B(7, 128, &ta);
+            ASSERT(129 == B.numBuckets());
+
+            const Obj C(7, 255, &ta);
+            ASSERT(192 == C.numBuckets());
+
+            const Obj D(7, static_cast<Int64>(3600) * 1000 * 1000, &ta);
+            ASSERT(1708 == D.numBuckets());
+
+            const Obj E(1, 0, &ta);
+            ASSERT(1 == E.numBuckets());
+        }
+
+        if (verbose) cout << "\n'record'." << endl;
+        {
+            Obj mX(5, 1000, &ta);  const Obj& X = mX;
+
+            ASSERT(5    == X.significantBits());
+            ASSERT(1000 == X.highestTrackableValue());
+
+            mX.record(10);
+            ASSERT(1  == X.count());
+            ASSERT(10 == X.total());
+            ASSERT(10 == X.min());
+            ASSERT(10 == X.max());
+            ASSERT(1  == X.bucketCount(Obj::bucketIndex(10, 5)));
+
+            mX.record(500, 3);
+            ASSERT(4    == X.count());
+            ASSERT(1510 == X.total());
+            ASSERT(10   == X.min());
+            ASSERT(500  == X.max());
+            ASSERT(3    == X.bucketCount(Obj::bucketIndex(500, 5)));
+
+            mX.record(7, 0);
+            ASSERT(4    == X.count());
+            ASSERT(10   == X.min());
+
+            mX.record(-20);
+            ASSERT(5    == X.count());
+            ASSERT(1490 == X.total());
+            ASSERT(-20  == X.min());
+            ASSERT(1    == X.bucketCount(0));
+
+            mX.record(1000000);
+            ASSERT(6       == X.count());
+            ASSERT(1001490 == X.total());
+            ASSERT(1000000 == X.max());
+            ASSERT(1       == X.bucketCount(X.numBuckets() - 1));
+
+            Int64 sum = 0;
+            for (int i = 0; i < X.numBuckets(); ++i) {
+                sum += X.bucketCount(i);
+            }
+            ASSERT(X.count() == sum);
+
+            if (verbose) cout << "\n'reset'." << endl;
+
+            const int NUM_BUCKETS = X.numBuckets();
+
+            mX.reset();
+            ASSERT(5           == X.significantBits());
+            ASSERT(1000        == X.highestTrackableValue());
+            ASSERT(NUM_BUCKETS == X.numBuckets());
+            ASSERT(0           == X.count());
+            ASSERT(0           == X.total());
+            ASSERT(Obj::k_DEFAULT_MIN == X.min());
+            ASSERT(Obj::k_DEFAULT_MAX == X.max());
+            for (int i = 0; i < X.numBuckets(); ++i) {
+                ASSERTV(i, 0 == X.bucketCount(i));
+            }
+
+            mX.record(10);
+            mX.reset(8, 100000);
+            ASSERT(8      == X.significantBits());
+            ASSERT(100000 == X.highestTrackableValue());
+            ASSERT(Obj::bucketIndex(100000, 8) + 1 == X.numBuckets());
+            ASSERT(0      == X.count());
+            ASSERT(0      == X.bucketCount(Obj::bucketIndex(10, 8)));
+        }
+
+        if (verbose) cout << "\n'addToBucket', 'accumulateTotalMinMax'."
+                          << endl;
+        {
+            Obj mX(5, 1000, &ta);  const Obj& X = mX;
+
+            mX.addToBucket(3, 4);
+            ASSERT(4 == X.count());
+            ASSERT(4 == X.bucketCount(3));
+            ASSERT(0 == X.total());
+            ASSERT(Obj::k_DEFAULT_MIN == X.min());
+            ASSERT(Obj::k_DEFAULT_MAX == X.max());
+
+            mX.accumulateTotalMinMax(12, 3, 3);
+            ASSERT(4  == X.count());
+            ASSERT(12 == X.total());
+            ASSERT(3  == X.min());
+            ASSERT(3  == X.max());
+
+            mX.accumulateTotalMinMax(10, 5, 1);
+            ASSERT(22 == X.total());
+            ASSERT(3  == X.min());
+            ASSERT(3  == X.max());
+
+            mX.accumulateTotalMinMax(10, 1, 5);
+            ASSERT(1  == X.min());
+            ASSERT(5  == X.max());
+
+            Obj mY(5, 1000, &ta);  const Obj& Y = mY;
+            mY.record(3, 4);
+            mX.reset();
+            mX.addToBucket(Obj::bucketIndex(3, 5), 4);
+            mX.accumulateTotalMinMax(12, 3, 3);
+            ASSERT(X == Y);
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_FAIL(Obj(0, 100, &ta));
+            ASSERT_PASS(Obj(1, 100, &ta));
+            ASSERT_PASS(Obj(Obj::k_MAX_SIGNIFICANT_BITS, 100, &ta));
+            ASSERT_FAIL(Obj(Obj::k_MAX_SIGNIFICANT_BITS + 1, 100, &ta));
+            ASSERT_FAIL(Obj(7, -1, &ta));
+
+            Obj mX(5, 1000, &ta);  const Obj& X = mX;
+
+            ASSERT_SAFE_PASS(mX.addToBucket(0, 1));
+            ASSERT_SAFE_PASS(mX.addToBucket(X.numBuckets() - 1, 1));
+            ASSERT_SAFE_FAIL(mX.addToBucket(-1, 1));
+            ASSERT_SAFE_FAIL(mX.addToBucket(X.numBuckets(), 1));
+            ASSERT_SAFE_FAIL(mX.addToBucket(0, -1));
+
+            ASSERT_SAFE_PASS(mX.record(5, 0));
+            ASSERT_SAFE_FAIL(mX.record(5, -1));
+
+            ASSERT_SAFE_PASS(X.bucketCount(0));
+            ASSERT_SAFE_FAIL(X.bucketCount(-1));
+            ASSERT_SAFE_FAIL(X.bucketCount(X.numBuckets()));
+
+            ASSERT_FAIL(mX.reset(0, 100));
+            ASSERT_FAIL(mX.reset(7, -1));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // BUCKET LAYOUT
+        //
+        // Concerns:
+        //: 1 Each of the values less than '2^significantBits' has its own
+        //:   bucket, whose index is the value.
+        //:
+        //: 2 Every value lies within the bounds of its bucket.
+        //:
+        //: 3 The buckets are contiguous: the lowest value of a bucket is one
+        //:   more than the highest value of the preceding bucket.
+        //:
+        //: 4 The width of a bucket is at most '2^(1 - significantBits)' times
+        //:   its lowest value.
+        //:
+        //: 5 The layout extends to the maximum 'Int64' value.
+        //:
+        //: 6 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For every valid number of significant bits, verify the index of
+        //:   the small values, and walk the buckets from the first up to the
+        //:   bucket of the maximum 'Int64' value, checking contiguity and
+        //:   width; verify that 'bucketIndex' maps both bounds of each bucket
+        //:   to that bucket.  (C-1..5)
+        //:
+        //: 2 Use 'BSLS_ASSERTTEST_*' macros.  (C-6)
+        //
+        // Testing:
+        //   int bucketIndex(Int64 value, int significantBits);
+        //   Int64 bucketLowestValue(int index, int significantBits);
+        //   Int64 bucketHighestValue(int index, int significantBits);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BUCKET LAYOUT" << endl
+                                  << "=============" << endl;
+
+        for (int bits = 1; bits <= Obj::k_MAX_SIGNIFICANT_BITS; ++bits) {
+            if (veryVerbose) { T_ P(bits) }
+
+            const Int64 LINEAR = static_cast<Int64>(1) << bits;
+
+            for (Int64 v = 0; v < LINEAR && v < 4096; ++v) {
+                ASSERTV(bits, v, v == Obj::bucketIndex(v, bits));
+            }
+
+            const int LAST = Obj::bucketIndex(INT64_MAX_VALUE, bits);
+
+            ASSERTV(bits, 0 == Obj::bucketLowestValue(0, bits));
+            ASSERTV(bits, INT64_MAX_VALUE ==
+                                        Obj::bucketHighestValue(LAST, bits));
+
+            // Walking every bucket is slow for many significant bits: sample
+            // the buckets at a stride instead.
+
+            const int STRIDE = bits <= 12 ? 1 : 1 << (bits - 12);
+
+            for (int i = 0; i <= LAST; i += (i < 2 * LINEAR ? 1 : STRIDE)) {
+                const Int64 LOW  = Obj::bucketLowestValue(i, bits);
+                const Int64 HIGH = Obj::bucketHighestValue(i, bits);
+
+                ASSERTV(bits, i, LOW <= HIGH);
+                ASSERTV(bits, i, i == Obj::bucketIndex(LOW, bits));
+                ASSERTV(bits, i, i == Obj::bucketIndex(HIGH, bits));
+                ASSERTV(bits, i, i == Obj::bucketIndex(LOW + (HIGH - LOW) / 2,
+                                                      bits));
+                ASSERTV(bits, i, HIGH - LOW <= (LOW >> (bits - 1)));
+
+                if (i < LAST) {
+                    ASSERTV(bits, i,
+                            HIGH + 1 == Obj::bucketLowestValue(i + 1, bits));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_SAFE_PASS(Obj::bucketIndex(0, 1));
+            ASSERT_SAFE_FAIL(Obj::bucketIndex(-1, 7));
+            ASSERT_SAFE_FAIL(Obj::bucketIndex(5, 0));
+            ASSERT_SAFE_FAIL(Obj::bucketIndex(
+                                            5,
+                                            Obj::k_MAX_SIGNIFICANT_BITS + 1));
+
+            ASSERT_SAFE_PASS(Obj::bucketLowestValue(0, 7));
+            ASSERT_SAFE_FAIL(Obj::bucketLowestValue(-1, 7));
+            ASSERT_SAFE_FAIL(Obj::bucketLowestValue(0, 0));
+
+            ASSERT_SAFE_PASS(Obj::bucketHighestValue(0, 7));
+            ASSERT_SAFE_FAIL(Obj::bucketHighestValue(-1, 7));
+            ASSERT_SAFE_FAIL(Obj::bucketHighestValue(0, 0));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Record values, query the aggregates and quantiles, merge, copy,
+        //:   and reset.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        Obj mX(7, 1000000, &ta);  const Obj& X = mX;
+
+        for (int i = 1; i <= 100; ++i) {
+            mX.record(i);
+        }
+
+        ASSERT(100  == X.count());
+        ASSERT(5050 == X.total());
+        ASSERT(1    == X.min());
+        ASSERT(100  == X.max());
+        ASSERT(1    == X.valueAtQuantile(0.0));
+        ASSERT(50   == X.valueAtQuantile(0.5));
+        ASSERT(99   == X.valueAtQuantile(0.99));
+        ASSERT(100  == X.valueAtQuantile(1.0));
+
+        Obj mY(X, &ta);  const Obj& Y = mY;
+        ASSERT(X == Y);
+
+        mY.merge(X);
+        ASSERT(X    != Y);
+        ASSERT(200  == Y.count());
+        ASSERT(50   == Y.valueAtQuantile(0.5));
+
+        mY.reset();
+        ASSERT(0    == Y.count());
+        ASSERT(0    == Y.valueAtQuantile(0.5));
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (test >= 0) {
+        // CONCERN: In no case does memory come from the default allocator.
+
+        ASSERT(dam.isTotalSame());
+
+        // CONCERN: In no case does memory come from the global allocator.
+
+        ASSERT(gam.isTotalSame());
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,181 @@
+// balm_histogramcollector.cpp                                        -*-C++-*-
+#include <balm_histogramcollector.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(balm_histogramcollector_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+#include <bslmt_lockguard.h>
+
+#include <bsls_assert.h>
+
+#include <bsl_climits.h>
+#include <bsl_new.h>
+
+namespace BloombergLP {
+namespace balm {
+
+                          // ------------------------
+                          // class HistogramCollector
+                          // ------------------------
+
+// PRIVATE MANIPULATORS
+void HistogramCollector::loadImp(Histogram *histogram, bool resetFlag)
+{
+    histogram->reset(d_significantBits, d_highestTrackableValue);
+
+    if (resetFlag) {
+        for (int i = 0; i < d_numBuckets; ++i) {
+            histogram->addToBucket(i, d_buckets_p[i].swapAcqRel(0));
+        }
+        histogram->accumulateTotalMinMax(
+                                  d_total.swapAcqRel(0),
+                                  d_min.swapAcqRel(Histogram::k_DEFAULT_MIN),
+                                  d_max.swapAcqRel(Histogram::k_DEFAULT_MAX));
+    }
+    else {
+        for (int i = 0; i < d_numBuckets; ++i) {
+            histogram->addToBucket(i, d_buckets_p[i].loadAcquire());
+        }
+        histogram->accumulateTotalMinMax(d_total.loadAcquire(),
+                                         d_min.loadAcquire(),
+                                         d_max.loadAcquire());
+    }
+}
+
+// CREATORS
+HistogramCollector::HistogramCollector(
+                               const MetricId&     metricId,
+                               int                 significantBits,
+                               bsls::Types::Int64  highestTrackableValue,
+                               bslma::Allocator   *basicAllocator)
+: d_metricId(metricId)
+, d_significantBits(significantBits)
+, d_highestTrackableValue(highestTrackableValue)
+, d_numBuckets(0)
+, d_buckets_p(0)
+, d_total(0)
+, d_min(Histogram::k_DEFAULT_MIN)
+, d_max(Histogram::k_DEFAULT_MAX)
+, d_quantiles(basicAllocator)
+, d_mutex()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(1 <= significantBits);
+    BSLS_ASSERT(significantBits <= Histogram::k_MAX_SIGNIFICANT_BITS);
+    BSLS_ASSERT(0 <= highestTrackableValue);
+
+    d_numBuckets = Histogram::bucketIndex(highestTrackableValue,
+                                          significantBits) + 1;
+    d_buckets_p  = static_cast<bsls::AtomicInt64 *>(
+              d_allocator_p->allocate(d_numBuckets * sizeof *d_buckets_p));
+
+    for (int i = 0; i < d_numBuckets; ++i) {
+        new (d_buckets_p + i) bsls::AtomicInt64(0);
+    }
+}
+
+HistogramCollector::~HistogramCollector()
+{
+    d_allocator_p->deallocate(d_buckets_p);
+}
+
+// MANIPULATORS
+void HistogramCollector::reset()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    for (int i = 0; i < d_numBuckets; ++i) {
+        d_buckets_p[i].storeRelease(0);
+    }
+    d_total.storeRelease(0);
+    d_min.storeRelease(Histogram::k_DEFAULT_MIN);
+    d_max.storeRelease(Histogram::k_DEFAULT_MAX);
+}
+
+void HistogramCollector::loadAndReset(Histogram *histogram)
+{
+    BSLS_ASSERT(histogram);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    loadImp(histogram, true);
+}
+
+void HistogramCollector::addQuantile(double quantile, const MetricId& metricId)
+{
+    BSLS_ASSERT(0.0 <= quantile);
+    BSLS_ASSERT(quantile <= 1.0);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    d_quantiles.push_back(Quantile(quantile, metricId));
+}
+
+void HistogramCollector::collect(bsl::vector<MetricRecord> *records,
+                                 bool                       resetFlag)
+{
+    BSLS_ASSERT(records);
+
+    Histogram histogram(d_allocator_p);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    loadImp(&histogram, resetFlag);
+
+    if (0 == histogram.count()) {
+        records->push_back(MetricRecord(d_metricId));
+        for (bsl::size_t i = 0; i < d_quantiles.size(); ++i) {
+            records->push_back(MetricRecord(d_quantiles[i].second));
+        }
+        return;                                                       // RETURN
+    }
+
+    // 'MetricRecord' holds an 'int' count: saturate rather than wrap.
+
+    const int count = histogram.count() > INT_MAX
+                    ? INT_MAX
+                    : static_cast<int>(histogram.count());
+
+    records->push_back(MetricRecord(d_metricId,
+                                    count,
+                                    static_cast<double>(histogram.total()),
+                                    static_cast<double>(histogram.min()),
+                                    static_cast<double>(histogram.max())));
+
+    for (bsl::size_t i = 0; i < d_quantiles.size(); ++i) {
+        const double value = static_cast<double>(
+                          histogram.valueAtQuantile(d_quantiles[i].first));
+
+        records->push_back(MetricRecord(d_quantiles[i].second,
+                                        count,
+                                        value * count,
+                                        value,
+                                        value));
+    }
+}
+
+// ACCESSORS
+void HistogramCollector::load(Histogram *histogram) const
+{
+    BSLS_ASSERT(histogram);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    const_cast<HistogramCollector *>(this)->loadImp(histogram, false);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,402 @@
+// balm_histogramcollector.h                                          -*-C++-*-
+#ifndef INCLUDED_BALM_HISTOGRAMCOLLECTOR
+#define INCLUDED_BALM_HISTOGRAMCOLLECTOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a lock-free collector of the distribution of a metric.
+//
+//@CLASSES:
+//  balm::HistogramCollector: collects a metric's values into a histogram
+//
+//@SEE_ALSO: balm_histogram, balm_integercollector, balm_metricsmanager,
+//           balm_streampublisher
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'balm::HistogramCollector', that collects the values of an integral metric
+// (typically a latency) into a log-linear histogram (see 'balm_histogram'),
+// so that quantiles of the metric (e.g., its median, or its 99th percentile)
+// can be published along with the count, total, minimum, and maximum provided
+// by 'balm::IntegerCollector'.
+//
+// The 'update' method records a value without acquiring a lock: it atomically
+// increments the count of the bucket holding the value and the total, and
+// updates the minimum and maximum (with a compare-and-swap, only if the value
+// is a new extreme).  The memory used by a collector is fixed at construction
+// by the 'significantBits' and 'highestTrackableValue' arguments, exactly as
+// for 'balm::Histogram' (see {'balm_histogram'|Bucket Layout}).
+//
+// The collected values are retrieved, at publication time, as a
+// 'balm::Histogram' using 'load' or 'loadAndReset'; histograms obtained from
+// several collectors (e.g., one per thread, or per process) can be combined
+// with 'balm::Histogram::merge'.
+//
+///Publishing Quantiles
+///--------------------
+// A 'balm::MetricsManager' publishes 'balm::MetricRecord' objects, which hold
+// only a count, total, minimum, and maximum.  A 'balm::HistogramCollector'
+// publishes each quantile of interest as a separate metric: the 'addQuantile'
+// method associates a quantile (e.g., 0.99) with the 'balm::MetricId' under
+// which it is published, and the 'collect' method, whose signature matches
+// 'balm::MetricsManager::RecordsCollectionCallback', appends to a vector of
+// records a record for the metric itself followed by a record for each
+// quantile.  The record for a quantile has the count of the collected values,
+// and the (approximate) value of the quantile as its minimum, maximum, and
+// average ('total / count').  Giving the quantile metrics the
+// 'balm::PublicationType::e_QUANTILE' preferred publication type causes
+// 'balm::StreamPublisher' to report them as quantiles.
+//
+///Thread Safety
+///-------------
+// 'balm::HistogramCollector' is fully *thread-safe*, meaning that all
+// non-creator operations on a given instance can be safely invoked
+// simultaneously from multiple threads.  'update' does not acquire a lock;
+// the other manipulators, and 'load', are serialized by a mutex, and so are
+// atomic with respect to each other.  As for 'balm::IntegerCollector', the
+// effect of an 'update' that is concurrent with a 'loadAndReset' may be split
+// between the histogram loaded by that 'loadAndReset' and the following
+// collection period, although no update is ever lost.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Publishing Latency Percentiles
+///- - - - - - - - - - - - - - - - - - - - -
+// In this example we collect the latency of requests, in microseconds, and
+// publish its count, total, minimum, and maximum, as well as its median and
+// 99th percentile, using a 'balm::MetricsManager'.
+//
+// First, we create a metrics manager, and obtain the metric ids for the
+// latency and for each of its quantiles from its registry.  We set the
+// preferred publication type of the quantile metrics so that publishers
+// report them as quantiles:
+//..
+//  balm::MetricsManager  manager;
+//  balm::MetricRegistry& registry = manager.metricRegistry();
+//
+//  balm::MetricId latencyId = registry.getId("Server", "latency");
+//  balm::MetricId p50Id     = registry.getId("Server", "latency.p50");
+//  balm::MetricId p99Id     = registry.getId("Server", "latency.p99");
+//
+//  registry.setPreferredPublicationType(p50Id,
+//                                       balm::PublicationType::e_QUANTILE);
+//  registry.setPreferredPublicationType(p99Id,
+//                                       balm::PublicationType::e_QUANTILE);
+//..
+// Then, we create a collector for latencies of up to one minute, tell it
+// which quantiles to publish, and register its 'collect' method with the
+// metrics manager:
+//..
+//  balm::HistogramCollector collector(latencyId, 7, 60 * 1000 * 1000);
+//  collector.addQuantile(0.50, p50Id);
+//  collector.addQuantile(0.99, p99Id);
+//
+//  balm::MetricsManager::CallbackHandle handle =
+//      manager.registerCollectionCallback(
+//                     "Server",
+//                     bdlf::BindUtil::bind(&balm::HistogramCollector::collect,
+//                                          &collector,
+//                                          bdlf::PlaceHolders::_1,
+//                                          bdlf::PlaceHolders::_2));
+//..
+// Next, the threads processing requests record their latencies (here, 100
+// latencies from 1 to 100 microseconds):
+//..
+//  for (int i = 1; i <= 100; ++i) {
+//      collector.update(i);
+//  }
+//..
+// Now, we collect a sample of the metrics, as a publisher would see it:
+//..
+//  balm::MetricSample              sample;
+//  bsl::vector<balm::MetricRecord> records;
+//
+//  manager.collectSample(&sample, &records);
+//
+//  assert(3 == records.size());
+//
+//  assert(latencyId == records[0].metricId());
+//  assert(100       == records[0].count());
+//  assert(5050      == records[0].total());
+//  assert(1         == records[0].min());
+//  assert(100       == records[0].max());
+//
+//  assert(p50Id     == records[1].metricId());
+//  assert(50        == records[1].max());
+//
+//  assert(p99Id     == records[2].metricId());
+//  assert(99        == records[2].max());
+//..
+// Finally, we remove the callback before the collector is destroyed:
+//..
+//  manager.removeCollectionCallback(handle);
+//..
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BALM_HISTOGRAM
+#include <balm_histogram.h>
+#endif
+
+#ifndef INCLUDED_BALM_METRICID
+#include <balm_metricid.h>
+#endif
+
+#ifndef INCLUDED_BALM_METRICRECORD
+#include <balm_metricrecord.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_UTILITY
+#include <bsl_utility.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace balm {
+
+                          // ========================
+                          // class HistogramCollector
+                          // ========================
+
+class HistogramCollector {
+    // This class provides a mechanism for collecting the distribution of the
+    // values of an integral metric over a period of time.  Values are
+    // recorded, without acquiring a lock, in atomic bucket counts having the
+    // layout of a 'Histogram' with the number of significant bits and highest
+    // trackable value supplied at construction.
+
+    // PRIVATE TYPES
+    typedef bsl::pair<double, MetricId> Quantile;
+        // quantile and the id of the metric under which it is published
+
+    // DATA
+    MetricId               d_metricId;     // metric identifier
+
+    int                    d_significantBits;
+                                           // number of significant bits
+
+    bsls::Types::Int64     d_highestTrackableValue;
+                                           // highest value having its own
+                                           // bucket
+
+    int                    d_numBuckets;   // number of buckets
+
+    bsls::AtomicInt64     *d_buckets_p;    // count of values in each bucket
+                                           // (owned)
+
+    bsls::AtomicInt64      d_total;        // total of the values
+
+    bsls::AtomicInt64      d_min;          // minimum value
+
+    bsls::AtomicInt64      d_max;          // maximum value
+
+    bsl::vector<Quantile>  d_quantiles;    // published quantiles
+
+    mutable bslmt::Mutex   d_mutex;        // serializes the operations other
+                                           // than 'update'
+
+    bslma::Allocator      *d_allocator_p;  // memory allocator (held, not
+                                           // owned)
+
+    // NOT IMPLEMENTED
+    HistogramCollector(const HistogramCollector&);
+    HistogramCollector& operator=(const HistogramCollector&);
+
+    // PRIVATE MANIPULATORS
+    void loadImp(Histogram *histogram, bool resetFlag);
+        // Load into the specified 'histogram' the values collected by this
+        // object and, if the specified 'resetFlag' is 'true', reset this
+        // collector to its default state.  The behavior is undefined unless
+        // 'd_mutex' is held by the calling thread.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(HistogramCollector,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    HistogramCollector(const MetricId&     metricId,
+                       int                 significantBits,
+                       bsls::Types::Int64  highestTrackableValue,
+                       bslma::Allocator   *basicAllocator = 0);
+        // Create a collector for the metric having the specified 'metricId',
+        // whose values are recorded in buckets having the layout of a
+        // 'Histogram' having the specified 'significantBits' and
+        // 'highestTrackableValue'.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless
+        // '1 <= significantBits <= Histogram::k_MAX_SIGNIFICANT_BITS' and
+        // '0 <= highestTrackableValue'.
+
+    ~HistogramCollector();
+        // Destroy this object.
+
+    // MANIPULATORS
+    void update(bsls::Types::Int64 value);
+        // Record the specified 'value'.  Note that this operation does not
+        // acquire a lock.
+
+    void reset();
+        // Discard the values collected by this object.
+
+    void loadAndReset(Histogram *histogram);
+        // Load into the specified 'histogram' the values collected by this
+        // object, then discard them, as a single atomic operation with
+        // respect to the other manipulators except 'update'.  'histogram' is
+        // reset to the number of significant bits and highest trackable value
+        // of this collector.
+
+    void addQuantile(double quantile, const MetricId& metricId);
+        // Publish the specified 'quantile' of the collected values under the
+        // specified 'metricId' (see 'collect').  The behavior is undefined
+        // unless '0.0 <= quantile <= 1.0'.
+
+    void collect(bsl::vector<MetricRecord> *records, bool resetFlag);
+        // Append to the specified 'records' a record for the metric of this
+        // collector, holding the count, total, minimum, and maximum of the
+        // collected values, followed by a record for each quantile added with
+        // 'addQuantile' (in the order in which they were added), holding the
+        // count of the collected values, and the value of the quantile as its
+        // minimum, maximum, and average.  If the specified 'resetFlag' is
+        // 'true', discard the collected values.  If no value has been
+        // collected, the records have a count of 0, and the default total,
+        // minimum, and maximum of 'MetricRecord'.  Note that this method can
+        // be registered with a 'MetricsManager' as a
+        // 'MetricsManager::RecordsCollectionCallback'.
+
+    // ACCESSORS
+    const MetricId& metricId() const;
+        // Return a reference to the non-modifiable 'MetricId' object
+        // identifying the metric for which this object collects values.
+
+    int significantBits() const;
+        // Return the number of significant bits of the buckets of this
+        // collector.
+
+    bsls::Types::Int64 highestTrackableValue() const;
+        // Return the highest value for which this collector has a bucket of
+        // the nominal precision.
+
+    void load(Histogram *histogram) const;
+        // Load into the specified 'histogram' the values collected by this
+        // object.  'histogram' is reset to the number of significant bits and
+        // highest trackable value of this collector.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                          // ------------------------
+                          // class HistogramCollector
+                          // ------------------------
+
+// MANIPULATORS
+inline
+void HistogramCollector::update(bsls::Types::Int64 value)
+{
+    const int index = value <= 0
+                    ? 0
+                    : value >= d_highestTrackableValue
+                    ? d_numBuckets - 1
+                    : Histogram::bucketIndex(value, d_significantBits);
+
+    d_buckets_p[index].addRelaxed(1);
+    d_total.addRelaxed(value);
+
+    // The extremes rarely change once a few values have been recorded, so a
+    // relaxed load usually suffices to determine that no update is needed.
+
+    bsls::Types::Int64 current = d_min.loadRelaxed();
+    while (value < current) {
+        const bsls::Types::Int64 previous = d_min.testAndSwapAcqRel(current,
+                                                                    value);
+        if (previous == current) {
+            break;
+        }
+        current = previous;
+    }
+
+    current = d_max.loadRelaxed();
+    while (value > current) {
+        const bsls::Types::Int64 previous = d_max.testAndSwapAcqRel(current,
+                                                                    value);
+        if (previous == current) {
+            break;
+        }
+        current = previous;
+    }
+}
+
+// ACCESSORS
+inline
+const MetricId& HistogramCollector::metricId() const
+{
+    return d_metricId;
+}
+
+inline
+int HistogramCollector::significantBits() const
+{
+    return d_significantBits;
+}
+
+inline
+bsls::Types::Int64 HistogramCollector::highestTrackableValue() const
+{
+    return d_highestTrackableValue;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
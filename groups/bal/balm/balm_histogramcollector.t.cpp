@@ -0,0 +1,825 @@
+// balm_histogramcollector.t.cpp                                      -*-C++-*-
+
+#include <balm_histogramcollector.h>
+
+#include <balm_category.h>
+#include <balm_histogram.h>
+#include <balm_metricdescription.h>
+#include <balm_metricregistry.h>
+#include <balm_metricsample.h>
+#include <balm_metricsmanager.h>
+#include <balm_publicationtype.h>
+
+#include <bdlf_bind.h>
+#include <bdlf_placeholder.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadgroup.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iomanip.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test defines a mechanism, 'balm::HistogramCollector',
+// that records values, without acquiring a lock, in bucket counts having the
+// layout of a 'balm::Histogram' (which is tested in its own test driver).  We
+// verify that the histogram loaded from a collector is the histogram obtained
+// by recording the same values in a 'balm::Histogram', that 'collect'
+// produces the documented records, and that concurrent updates are neither
+// lost nor duplicated, even when interleaved with 'loadAndReset'.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] HistogramCollector(id, significantBits, highestValue, alloc);
+// [ 2] ~HistogramCollector();
+//
+// MANIPULATORS
+// [ 2] void update(bsls::Types::Int64 value);
+// [ 2] void reset();
+// [ 2] void loadAndReset(Histogram *histogram);
+// [ 3] void addQuantile(double quantile, const MetricId& metricId);
+// [ 3] void collect(bsl::vector<MetricRecord> *records, bool resetFlag);
+//
+// ACCESSORS
+// [ 2] const MetricId& metricId() const;
+// [ 2] int significantBits() const;
+// [ 2] bsls::Types::Int64 highestTrackableValue() const;
+// [ 2] void load(Histogram *histogram) const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] CONCURRENT UPDATES
+// [ 5] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: 'update'
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool             verbose;
+bool         veryVerbose;
+bool     veryVeryVerbose;
+bool veryVeryVeryVerbose;
+
+typedef balm::HistogramCollector Obj;
+typedef balm::Histogram          Histogram;
+typedef balm::MetricRecord       Rec;
+typedef bsls::Types::Int64       Int64;
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+namespace concurrent {
+
+void updateLoop(Obj *collector, int threadIndex, int numUpdates)
+    // Record, in the specified 'collector', the values '1' to the specified
+    // 'numUpdates' multiplied by one more than the specified 'threadIndex'.
+{
+    for (int i = 1; i <= numUpdates; ++i) {
+        collector->update(static_cast<Int64>(i) * (threadIndex + 1));
+    }
+}
+
+void collectLoop(Obj             *collector,
+                 Histogram       *result,
+                 bsls::AtomicInt *done)
+    // Repeatedly load and reset the specified 'collector', merging the
+    // loaded histograms into the specified 'result', until the specified
+    // 'done' flag is set, then merge the values remaining in 'collector'.
+{
+    Histogram histogram(result->allocator());
+    while (!done->loadAcquire()) {
+        collector->loadAndReset(&histogram);
+        result->merge(histogram);
+        bslmt::ThreadUtil::yield();
+    }
+    collector->loadAndReset(&histogram);
+    result->merge(histogram);
+}
+
+}  // close namespace concurrent
+
+namespace benchmark {
+
+class MutexHistogram {
+    // This class provides a baseline for the cost of
+    // 'balm::HistogramCollector::update': it records values in a
+    // 'balm::Histogram' under a mutex.
+
+    // DATA
+    Histogram    d_histogram;
+    bslmt::Mutex d_mutex;
+
+  public:
+    // CREATORS
+    MutexHistogram(int               significantBits,
+                   Int64             highestTrackableValue,
+                   bslma::Allocator *basicAllocator)
+    : d_histogram(significantBits, highestTrackableValue, basicAllocator)
+    {
+    }
+
+    // MANIPULATORS
+    void update(Int64 value)
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_histogram.record(value);
+    }
+
+    // ACCESSORS
+    Int64 count()
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        return d_histogram.count();
+    }
+};
+
+template <class COLLECTOR>
+void updateLoop(COLLECTOR      *collector,
+                int             numUpdates,
+                bslmt::Barrier *barrier)
+    // Wait on the specified 'barrier', then invoke 'update' on the specified
+    // 'collector' the specified 'numUpdates' times.
+{
+    barrier->wait();
+    for (int i = 0; i < numUpdates; ++i) {
+        collector->update((i * 2654435761U) & 0xfffff);
+    }
+}
+
+template <class COLLECTOR>
+double runUpdates(COLLECTOR *collector, int numThreads, int numUpdates)
+    // Invoke 'update' on the specified 'collector' the specified 'numUpdates'
+    // times from each of the specified 'numThreads' threads, and return the
+    // elapsed wall time, in nanoseconds, per 'update'.
+{
+    bslma::TestAllocator ta;
+    bslmt::Barrier       barrier(numThreads + 1);
+    bslmt::ThreadGroup   threads(&ta);
+
+    threads.addThreads(bdlf::BindUtil::bindS(&ta,
+                                             &updateLoop<COLLECTOR>,
+                                             collector,
+                                             numUpdates,
+                                             &barrier),
+                       numThreads);
+
+    bsls::Stopwatch timer;
+    timer.start();
+    barrier.wait();
+    threads.joinAll();
+    timer.stop();
+
+    const double totalUpdates = static_cast<double>(numThreads) * numUpdates;
+
+    return timer.elapsedTime() * 1e9 / totalUpdates;
+}
+
+}  // close namespace benchmark
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+    bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+    bslma::TestAllocatorMonitor gam(&globalAllocator);
+
+    balm::Category          category("Category");
+    balm::MetricDescription descA(&category, "A");
+    balm::MetricDescription descB(&category, "B");
+    balm::MetricDescription descC(&category, "C");
+
+    const balm::MetricId METRIC_A(&descA);
+    const balm::MetricId METRIC_B(&descB);
+    const balm::MetricId METRIC_C(&descC);
+
+    switch (test) { case 0:
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+        bslma::TestAllocator         ta("usage", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&ta);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Publishing Latency Percentiles
+///- - - - - - - - - - - - - - - - - - - - -
+// In this example we collect the latency of requests, in microseconds, and
+// publish its count, total, minimum, and maximum, as well as its median and
+// 99th percentile, using a 'balm::MetricsManager'.
+//
+// First, we create a metrics manager, and obtain the metric ids for the
+// latency and for each of its quantiles from its registry.  We set the
+// preferred publication type of the quantile metrics so that publishers
+// report them as quantiles:
+//..
+    balm::MetricsManager  manager;
+    balm::MetricRegistry& registry = manager.metricRegistry();
+
+    balm::MetricId latencyId = registry.getId("Server", "latency");
+    balm::MetricId p50Id     = registry.getId("Server", "latency.p50");
+    balm::MetricId p99Id     = registry.getId("Server", "latency.p99");
+
+    registry.setPreferredPublicationType(p50Id,
+                                         balm::PublicationType::e_QUANTILE);
+    registry.setPreferredPublicationType(p99Id,
+                                         balm::PublicationType::e_QUANTILE);
+//..
+// Then, we create a collector for latencies of up to one minute, tell it
+// which quantiles to publish, and register its 'collect' method with the
+// metrics manager:
+//..
+    balm::HistogramCollector collector(latencyId, 7, 60 * 1000 * 1000);
+    collector.addQuantile(0.50, p50Id);
+    collector.addQuantile(0.99, p99Id);
+
+    balm::MetricsManager::CallbackHandle handle =
+        manager.registerCollectionCallback(
+                       "Server",
+                       bdlf::BindUtil::bind(&balm::HistogramCollector::collect,
+                                            &collector,
+                                            bdlf::PlaceHolders::_1,
+                                            bdlf::PlaceHolders::_2));
+//..
+// Next, the threads processing requests record their latencies (here, 100
+// latencies from 1 to 100 microseconds):
+//..
+    for (int i = 1; i <= 100; ++i) {
+        collector.update(i);
+    }
+//..
+// Now, we collect a sample of the metrics, as a publisher would see it:
+//..
+    balm::MetricSample              sample;
+    bsl::vector<balm::MetricRecord> records;
+
+    manager.collectSample(&sample, &records);
+
+    ASSERT(3 == records.size());
+
+    ASSERT(latencyId == records[0].metricId());
+    ASSERT(100       == records[0].count());
+    ASSERT(5050      == records[0].total());
+    ASSERT(1         == records[0].min());
+    ASSERT(100       == records[0].max());
+
+    ASSERT(p50Id     == records[1].metricId());
+    ASSERT(50        == records[1].max());
+
+    ASSERT(p99Id     == records[2].metricId());
+    ASSERT(99        == records[2].max());
+//..
+// Finally, we remove the callback before the collector is destroyed:
+//..
+    manager.removeCollectionCallback(handle);
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCURRENT UPDATES
+        //
+        // Concerns:
+        //: 1 Concurrent invocations of 'update' are neither lost nor
+        //:   duplicated.
+        //:
+        //: 2 The values recorded by 'update' invocations concurrent with
+        //:   'loadAndReset' are reported exactly once across the loaded
+        //:   histograms.
+        //
+        // Plan:
+        //: 1 Have several threads record known sets of values, with and
+        //:   without another thread repeatedly invoking 'loadAndReset' and
+        //:   merging the loaded histograms; compare the result with the
+        //:   histogram of the same values recorded in a single thread.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   CONCURRENT UPDATES
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CONCURRENT UPDATES" << endl
+                                  << "==================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        enum { k_NUM_THREADS = 6, k_NUM_UPDATES = 20000 };
+
+        Histogram expected(5, 1 << 16, &ta);
+        for (int t = 0; t < k_NUM_THREADS; ++t) {
+            for (int i = 1; i <= k_NUM_UPDATES; ++i) {
+                expected.record(static_cast<Int64>(i) * (t + 1));
+            }
+        }
+
+        for (int withCollector = 0; withCollector < 2; ++withCollector) {
+            if (veryVerbose) { T_ P(withCollector) }
+
+            Obj                mX(METRIC_A, 5, 1 << 16, &ta);
+            Histogram          result(&ta);
+            bsls::AtomicInt    done(0);
+            bslmt::ThreadGroup threads(&ta);
+
+            const int NUM_UPDATES = k_NUM_UPDATES;
+
+            result.reset(5, 1 << 16);
+
+            if (withCollector) {
+                threads.addThread(bdlf::BindUtil::bindS(
+                                                     &ta,
+                                                     &concurrent::collectLoop,
+                                                     &mX,
+                                                     &result,
+                                                     &done));
+            }
+
+            bslmt::ThreadGroup updaters(&ta);
+            for (int t = 0; t < k_NUM_THREADS; ++t) {
+                updaters.addThread(bdlf::BindUtil::bindS(
+                                                     &ta,
+                                                     &concurrent::updateLoop,
+                                                     &mX,
+                                                     t,
+                                                     NUM_UPDATES));
+            }
+            updaters.joinAll();
+
+            done.storeRelease(1);
+            threads.joinAll();
+
+            if (!withCollector) {
+                mX.loadAndReset(&result);
+            }
+
+            ASSERTV(withCollector, expected.count(), result.count(),
+                    expected == result);
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'addQuantile' AND 'collect'
+        //
+        // Concerns:
+        //: 1 'collect' appends a record for the metric followed by a record
+        //:   for each quantile, in the order in which they were added.
+        //:
+        //: 2 The record for the metric holds the count, total, minimum, and
+        //:   maximum of the collected values.
+        //:
+        //: 3 The record for a quantile holds the count of the collected
+        //:   values and the value of the quantile as its minimum, maximum,
+        //:   and average.
+        //:
+        //: 4 If no value has been collected, the records have the default
+        //:   values of 'MetricRecord' (other than the metric id).
+        //:
+        //: 5 The collected values are discarded if and only if 'resetFlag' is
+        //:   'true'.
+        //:
+        //: 6 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Collect from an empty collector, and from one having recorded
+        //:   known values, with and without reset.  (C-1..5)
+        //:
+        //: 2 Use 'BSLS_ASSERTTEST_*' macros.  (C-6)
+        //
+        // Testing:
+        //   void addQuantile(double quantile, const MetricId& metricId);
+        //   void collect(bsl::vector<MetricRecord> *records, bool resetFlag);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'addQuantile' AND 'collect'" << endl
+                                  << "===========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        Obj mX(METRIC_A, 7, 100000, &ta);
+
+        bsl::vector<Rec> records(&ta);
+
+        mX.collect(&records, false);
+        ASSERT(1 == records.size());
+        ASSERT(Rec(METRIC_A) == records[0]);
+
+        mX.addQuantile(0.9, METRIC_B);
+        mX.addQuantile(0.5, METRIC_C);
+
+        records.clear();
+        mX.collect(&records, true);
+        ASSERT(3 == records.size());
+        ASSERT(Rec(METRIC_A) == records[0]);
+        ASSERT(Rec(METRIC_B) == records[1]);
+        ASSERT(Rec(METRIC_C) == records[2]);
+
+        for (int i = 1; i <= 1000; ++i) {
+            mX.update(i);
+        }
+
+        for (int reset = 0; reset < 2; ++reset) {
+            records.clear();
+            mX.collect(&records, reset);
+            ASSERTV(reset, 3 == records.size());
+
+            ASSERTV(reset, Rec(METRIC_A, 1000, 500500, 1, 1000) ==
+                                                                 records[0]);
+
+            // 900 and 500 are in the buckets [900 .. 903] and [500 .. 503].
+
+            ASSERTV(reset, Rec(METRIC_B, 1000, 903 * 1000.0, 903, 903) ==
+                                                                 records[1]);
+            ASSERTV(reset, Rec(METRIC_C, 1000, 503 * 1000.0, 503, 503) ==
+                                                                 records[2]);
+        }
+
+        records.clear();
+        mX.collect(&records, false);
+        ASSERT(3 == records.size());
+        ASSERT(Rec(METRIC_A) == records[0]);
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_PASS(mX.addQuantile(0.0, METRIC_B));
+            ASSERT_PASS(mX.addQuantile(1.0, METRIC_B));
+            ASSERT_FAIL(mX.addQuantile(-0.5, METRIC_B));
+            ASSERT_FAIL(mX.addQuantile(1.5, METRIC_B));
+            ASSERT_FAIL(mX.collect(0, false));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS, 'update', 'load', 'loadAndReset', AND 'reset'
+        //
+        // Concerns:
+        //: 1 The constructor sets the attributes of the collector, and
+        //:   allocates memory from the supplied allocator, which the
+        //:   destructor releases.
+        //:
+        //: 2 The histogram loaded from a collector is the histogram obtained
+        //:   by recording the same values in a 'balm::Histogram' having the
+        //:   same layout, including values less than 0 or greater than the
+        //:   highest trackable value.
+        //:
+        //: 3 'load' does not modify the collector; 'loadAndReset' and 'reset'
+        //:   discard the collected values.
+        //:
+        //: 4 The loaded histogram takes the layout of the collector.
+        //:
+        //: 5 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Record values in a collector and a histogram, and compare the
+        //:   histogram loaded from the collector with the histogram.
+        //:   (C-1..4)
+        //:
+        //: 2 Use 'BSLS_ASSERTTEST_*' macros.  (C-5)
+        //
+        // Testing:
+        //   HistogramCollector(id, significantBits, highestValue, alloc);
+        //   ~HistogramCollector();
+        //   void update(bsls::Types::Int64 value);
+        //   void reset();
+        //   void loadAndReset(Histogram *histogram);
+        //   const MetricId& metricId() const;
+        //   int significantBits() const;
+        //   bsls::Types::Int64 highestTrackableValue() const;
+        //   void load(Histogram *histogram) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                 << "CREATORS, 'update', 'load', 'loadAndReset', AND 'reset'"
+                 << endl
+                 << "======================================================="
+                 << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+        bslma::TestAllocator sa("scratch", veryVeryVeryVerbose);
+
+        const int   BITS[]     = { 1, 3, 7, 10 };
+        const Int64 K_2_40     = static_cast<Int64>(1) << 40;
+        const Int64 HIGHEST[]  = { 0, 100, 1000000, K_2_40 };
+
+        for (int b = 0; b < 4; ++b) {
+            for (int h = 0; h < 4; ++h) {
+                const int   BITS_V    = BITS[b];
+                const Int64 HIGHEST_V = HIGHEST[h];
+
+                if (veryVerbose) { T_ P_(BITS_V) P(HIGHEST_V) }
+
+                {
+                    Obj mX(METRIC_A, BITS_V, HIGHEST_V, &ta);
+                    const Obj& X = mX;
+
+                    ASSERT(0 < ta.numBytesInUse());
+                    ASSERT(METRIC_A  == X.metricId());
+                    ASSERT(BITS_V    == X.significantBits());
+                    ASSERT(HIGHEST_V == X.highestTrackableValue());
+
+                    Histogram expected(BITS_V, HIGHEST_V, &sa);
+                    Histogram result(&sa);
+
+                    X.load(&result);
+                    ASSERTV(BITS_V, HIGHEST_V, expected == result);
+
+                    const Int64 VALUES[] = {
+                        0, 1, 2, 3, 17, 100, 101, 12345, 999999, 1000000,
+                        1000001, K_2_40 + 5, -7, 42, 42, 42
+                    };
+                    const int NUM_VALUES = sizeof VALUES / sizeof *VALUES;
+
+                    for (int i = 0; i < NUM_VALUES; ++i) {
+                        mX.update(VALUES[i]);
+                        expected.record(VALUES[i]);
+                    }
+
+                    X.load(&result);
+                    ASSERTV(BITS_V, HIGHEST_V, expected == result);
+
+                    X.load(&result);
+                    ASSERTV(BITS_V, HIGHEST_V, expected == result);
+
+                    mX.loadAndReset(&result);
+                    ASSERTV(BITS_V, HIGHEST_V, expected == result);
+
+                    expected.reset();
+                    X.load(&result);
+                    ASSERTV(BITS_V, HIGHEST_V, expected == result);
+
+                    mX.update(5);
+                    mX.reset();
+                    X.load(&result);
+                    ASSERTV(BITS_V, HIGHEST_V, expected == result);
+                }
+                ASSERT(0 == ta.numBytesInUse());
+            }
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_PASS(Obj(METRIC_A, 1, 0, &ta));
+            ASSERT_FAIL(Obj(METRIC_A, 0, 100, &ta));
+            ASSERT_FAIL(Obj(METRIC_A,
+                            Histogram::k_MAX_SIGNIFICANT_BITS + 1,
+                            100,
+                            &ta));
+            ASSERT_FAIL(Obj(METRIC_A, 7, -1, &ta));
+
+            Obj mX(METRIC_A, 7, 100, &ta);
+
+            ASSERT_FAIL(mX.load(0));
+            ASSERT_FAIL(mX.loadAndReset(0));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Update a collector, then load and collect its values.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        Obj mX(METRIC_A, 7, 1000000, &ta);  const Obj& X = mX;
+
+        for (int i = 1; i <= 100; ++i) {
+            mX.update(i);
+        }
+
+        Histogram histogram(&ta);
+        X.load(&histogram);
+
+        ASSERT(100  == histogram.count());
+        ASSERT(5050 == histogram.total());
+        ASSERT(1    == histogram.min());
+        ASSERT(100  == histogram.max());
+        ASSERT(50   == histogram.valueAtQuantile(0.5));
+
+        mX.addQuantile(0.5, METRIC_B);
+
+        bsl::vector<Rec> records(&ta);
+        mX.collect(&records, true);
+
+        ASSERT(2 == records.size());
+        ASSERT(Rec(METRIC_A, 100, 5050, 1, 100) == records[0]);
+        ASSERT(Rec(METRIC_B, 100, 5000, 50, 50) == records[1]);
+
+        mX.loadAndReset(&histogram);
+        ASSERT(0 == histogram.count());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: 'update'
+        //
+        // Concerns:
+        //: 1 The cost of 'update' does not grow significantly with the
+        //:   number of threads concurrently updating the same collector.
+        //
+        // Plan:
+        //: 1 For 1, 2, 4, ..., 64 threads, invoke 'update' on a single
+        //:   collector from every thread, and report the elapsed wall time
+        //:   per 'update' for a 'balm::HistogramCollector' and for a
+        //:   'balm::Histogram' protected by a mutex.  Verify the count.
+        //:   (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST: 'update'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "PERFORMANCE TEST: 'update'" << endl
+                                  << "==========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVeryVerbose);
+
+        const int NUM_UPDATES = 1000000;
+
+        cout << "threads  ns/update  ns/update (mutex)" << endl;
+
+        for (int numThreads = 1; numThreads <= 64; numThreads *= 2) {
+            const int numUpdates = NUM_UPDATES / numThreads;
+
+            Obj mX(METRIC_A, 7, 1 << 20, &ta);
+            const double lockFree = benchmark::runUpdates(&mX,
+                                                          numThreads,
+                                                          numUpdates);
+
+            Histogram histogram(&ta);
+            mX.load(&histogram);
+            ASSERTV(numThreads,
+                    numThreads * numUpdates == histogram.count());
+
+            benchmark::MutexHistogram mY(7, 1 << 20, &ta);
+            const double locked = benchmark::runUpdates(&mY,
+                                                        numThreads,
+                                                        numUpdates);
+
+            ASSERTV(numThreads, numThreads * numUpdates == mY.count());
+
+            cout << setw(7)  << numThreads << "  "
+                 << setw(9)  << lockFree   << "  "
+                 << setw(17) << locked     << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (test >= 0) {
+        // CONCERN: In no case does memory come from the default allocator.
+
+        ASSERT(dam.isTotalSame());
+
+        // CONCERN: In no case does memory come from the global allocator.
+
+        ASSERT(gam.isTotalSame());
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------------------------------------------------------
@@ -12,9 +12,14 @@
 #include <bsls_ident.h>
 BSLS_IDENT_RCSID(balm_integercollector_cpp,"$Id$ $CSID$")
 
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+
 #include <bsls_types.h>
 
 #include <bsl_climits.h>
+#include <bsl_new.h>
 
 namespace BloombergLP {
 
@@ -27,24 +32,97 @@ const int balm::IntegerCollector::k_DEFAULT_MIN = INT_MAX;
 const int balm::IntegerCollector::k_DEFAULT_MAX = INT_MIN;
 
 namespace balm {
+
+// PRIVATE CLASS METHODS
+void IntegerCollector::resetCell(Cell *cell)
+{
+    cell->d_count.storeRelease(0);
+    cell->d_total.storeRelease(0);
+    cell->d_min.storeRelease(k_DEFAULT_MIN);
+    cell->d_max.storeRelease(k_DEFAULT_MAX);
+}
+
+// PRIVATE MANIPULATORS
+void IntegerCollector::allocateCells()
+{
+    // The buffer holds one cache line more than the cells, so that the cells
+    // can be aligned on a cache line (see 'cell').
+
+    char *cellBuffer = static_cast<char *>(
+                    d_allocator_p->allocate((k_NUM_CELLS + 1) * k_CELL_SIZE));
+
+    for (int i = 0; i < k_NUM_CELLS; ++i) {
+        resetCell(new (&cell(cellBuffer, i)) Cell());
+    }
+
+    if (0 != d_cellBuffer_p.testAndSwapAcqRel(0, cellBuffer)) {
+        // Another thread allocated the cells first.
+
+        d_allocator_p->deallocate(cellBuffer);
+    }
+}
+
+void IntegerCollector::resetCells()
+{
+    resetCell(&d_cell);
+
+    char *cellBuffer = d_cellBuffer_p.loadAcquire();
+    if (cellBuffer) {
+        for (int i = 0; i < k_NUM_CELLS; ++i) {
+            resetCell(&cell(cellBuffer, i));
+        }
+    }
+}
+
+// CREATORS
+IntegerCollector::IntegerCollector(const MetricId&   metricId,
+                                   bslma::Allocator *basicAllocator)
+: d_metricId(metricId)
+, d_cell()
+, d_cellBuffer_p(0)
+, d_mutex()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    resetCell(&d_cell);
+}
+
+IntegerCollector::~IntegerCollector()
+{
+    char *cellBuffer = d_cellBuffer_p.loadAcquire();
+    if (cellBuffer) {
+        d_allocator_p->deallocate(cellBuffer);
+    }
+}
+
 // MANIPULATORS
+void IntegerCollector::reset()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+    resetCells();
+}
+
 void IntegerCollector::loadAndReset(MetricRecord *records)
 {
-    int                count;
-    bsls::Types::Int64 total;
-    int                min;
-    int                max;
+    int                count = 0;
+    bsls::Types::Int64 total = 0;
+    int                min   = k_DEFAULT_MIN;
+    int                max   = k_DEFAULT_MAX;
     {
         bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
-        count = d_count;
-        total = d_total;
-        min   = d_min;
-        max   = d_max;
-
-        d_count = 0;
-        d_total = 0;
-        d_min   = k_DEFAULT_MIN;
-        d_max   = k_DEFAULT_MAX;
+
+        // Merge 'd_cell' (at index -1) and the cells updated by concurrent
+        // threads, if they were allocated.
+
+        char      *cellBuffer = d_cellBuffer_p.loadAcquire();
+        const int  numCells   = cellBuffer ? k_NUM_CELLS : 0;
+
+        for (int i = -1; i < numCells; ++i) {
+            Cell& c = 0 <= i ? cell(cellBuffer, i) : d_cell;
+            count += c.d_count.swapAcqRel(0);
+            total += c.d_total.swapAcqRel(0);
+            min    = bsl::min(min, c.d_min.swapAcqRel(k_DEFAULT_MIN));
+            max    = bsl::max(max, c.d_max.swapAcqRel(k_DEFAULT_MAX));
+        }
     }
     // Perform the conversion to double values outside of the lock.
     records->metricId() = d_metricId;
@@ -58,20 +136,58 @@ void IntegerCollector::loadAndReset(MetricRecord *records)
                         : max;
 }
 
+void IntegerCollector::accumulateCountTotalMinMax(int count,
+                                                  int total,
+                                                  int min,
+                                                  int max)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    d_cell.d_count.addRelaxed(count);
+    d_cell.d_total.addRelaxed(total);
+    atomicMin(&d_cell.d_min, min);
+    atomicMax(&d_cell.d_max, max);
+}
+
+void IntegerCollector::setCountTotalMinMax(int count,
+                                           int total,
+                                           int min,
+                                           int max)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    resetCells();
+
+    d_cell.d_count.storeRelease(count);
+    d_cell.d_total.storeRelease(total);
+    d_cell.d_min.storeRelease(min);
+    d_cell.d_max.storeRelease(max);
+}
+
 // ACCESSORS
 void IntegerCollector::load(MetricRecord *record) const
 {
-    int                count;
-    bsls::Types::Int64 total;
-    int                min;
-    int                max;
+    int                count = 0;
+    bsls::Types::Int64 total = 0;
+    int                min   = k_DEFAULT_MIN;
+    int                max   = k_DEFAULT_MAX;
 
     {
         bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
-        count = d_count;
-        total = d_total;
-        min   = d_min;
-        max   = d_max;
+
+        // Merge 'd_cell' (at index -1) and the cells updated by concurrent
+        // threads, if they were allocated.
+
+        char      *cellBuffer = d_cellBuffer_p.loadAcquire();
+        const int  numCells   = cellBuffer ? k_NUM_CELLS : 0;
+
+        for (int i = -1; i < numCells; ++i) {
+            const Cell& c = 0 <= i ? cell(cellBuffer, i) : d_cell;
+            count += c.d_count.loadAcquire();
+            total += c.d_total.loadAcquire();
+            min    = bsl::min(min, c.d_min.loadAcquire());
+            max    = bsl::max(max, c.d_max.loadAcquire());
+        }
     }
 
     // Perform the conversion to double values outside of the lock.
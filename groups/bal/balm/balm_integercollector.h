@@ -41,6 +41,34 @@ BSLS_IDENT("$Id: $")
 // non-creator operations on a given instance can be safely invoked
 // simultaneously from multiple threads.
 //
+// The 'update' method, which is typically invoked far more frequently than
+// the other methods, does not acquire a lock.  Instead, a collector holds its
+// aggregates in a cell of atomic count, total, minimum, and maximum values,
+// which 'update' modifies (using a compare-and-swap loop for the minimum and
+// maximum).  The first time 'update' finds that the count of the cell was
+// modified concurrently by another thread, the collector allocates a small
+// array of cache-line-aligned cells (see {Memory Usage}), and 'update' then
+// modifies the cell selected by a hash of the id of the calling thread, so
+// that threads updating the same collector concurrently rarely contend for
+// the same cache line.  The cells are merged by 'load' and 'loadAndReset'.
+// The remaining operations are serialized with respect to each other by a
+// mutex, and so are atomic with respect to each other, but not with respect
+// to 'update': the effect of an 'update' that is concurrent with a
+// 'loadAndReset' may be split between the record loaded by that
+// 'loadAndReset' and the following collection period, although no update is
+// ever lost.
+//
+///Memory Usage
+///------------
+// An integer collector that is only updated by one thread at a time occupies
+// about 100 bytes (on 64-bit platforms), and allocates no memory.  An integer
+// collector that has been updated concurrently additionally holds, until it
+// is destroyed, 16 cells of 'bslmt::Platform::e_CACHE_LINE_SIZE' bytes (about
+// 1 KB on usual platforms), supplied by the allocator specified at
+// construction.  Note that a 'balm::CollectorRepository' holds a
+// 'balm::IntegerCollector' for each metric, so this memory is allocated only
+// for the metrics that are updated concurrently.
+//
 ///Usage
 ///-----
 // The following example creates a 'balm::IntegerCollector', modifies its
@@ -92,12 +120,32 @@ BSLS_IDENT("$Id: $")
 #include <balm_metricrecord.h>
 #endif
 
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
 #ifndef INCLUDED_BSLMT_MUTEX
 #include <bslmt_mutex.h>
 #endif
 
-#ifndef INCLUDED_BSLMT_LOCKGUARD
-#include <bslmt_lockguard.h>
+#ifndef INCLUDED_BSLMT_PLATFORM
+#include <bslmt_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
 #endif
 
 #ifndef INCLUDED_BSLS_TYPES
@@ -121,28 +169,99 @@ class IntegerCollector {
     // default value for the minimum is 'k_DEFAULT_MIN', and the default value
     // for the maximum is 'k_DEFAULT_MAX'.
 
+    // PRIVATE TYPES
+    struct Cell {
+        // This 'struct' holds the aggregates of the values supplied to
+        // 'update' by the threads assigned to one cell of a collector.
+
+        bsls::AtomicInt   d_count;  // aggregated count of events
+        bsls::AtomicInt64 d_total;  // total of values across events
+        bsls::AtomicInt   d_min;    // minimum value across events
+        bsls::AtomicInt   d_max;    // maximum value across events
+    };
+
+    enum {
+        k_NUM_CELLS_LOG2 = 4,                      // log2 of 'k_NUM_CELLS'
+
+        k_NUM_CELLS      = 1 << k_NUM_CELLS_LOG2,  // number of stripes
+
+        k_CELL_SIZE      = bslmt::Platform::e_CACHE_LINE_SIZE
+                                                   // distance between cells
+    };
+
     // DATA
-    MetricId             d_metricId;  // metric identifier
-    int                  d_count;     // aggregated count of events
-    bsls::Types::Int64   d_total;     // total of values across events
-    int                  d_min;       // minimum value across events
-    int                  d_max;       // maximum value across events
-    mutable bslmt::Mutex d_mutex;     // synchronizes access to data
+    MetricId                  d_metricId;      // metric identifier
+
+    Cell                      d_cell;          // cell updated until 'update'
+                                               // is first called concurrently
+
+    bsls::AtomicPointer<char> d_cellBuffer_p;  // storage for 'k_NUM_CELLS'
+                                               // cells aligned on a cache
+                                               // line, or 0 if not yet
+                                               // allocated (owned)
+
+    mutable bslmt::Mutex      d_mutex;         // serializes the operations
+                                               // other than 'update'
+
+    bslma::Allocator         *d_allocator_p;   // memory allocator (held, not
+                                               // owned)
 
     // NOT IMPLEMENTED
     IntegerCollector(const IntegerCollector&);
     IntegerCollector& operator=(const IntegerCollector&);
 
+    // PRIVATE CLASS METHODS
+    static int cellIndex();
+        // Return the index of the cell updated by the calling thread.
+
+    static Cell& cell(char *cellBuffer, int index);
+        // Return a reference to the modifiable cell at the specified 'index'
+        // within the specified 'cellBuffer'.
+
+    static void resetCell(Cell *cell);
+        // Reset the specified 'cell' to its default state.
+
+    static bool incrementCount(bsls::AtomicInt *count);
+        // Atomically increment the specified 'count' by 1.  Return 'true' if
+        // 'count' was concurrently modified by another thread, and 'false'
+        // otherwise.
+
+    static void atomicMin(bsls::AtomicInt *minimum, int value);
+        // Atomically set the specified 'minimum' to the specified 'value' if
+        // 'value' is less than 'minimum'.
+
+    static void atomicMax(bsls::AtomicInt *maximum, int value);
+        // Atomically set the specified 'maximum' to the specified 'value' if
+        // 'value' is greater than 'maximum'.
+
+    // PRIVATE MANIPULATORS
+    void allocateCells();
+        // Allocate the 'k_NUM_CELLS' cells updated by concurrent threads, in
+        // their default states, unless another thread did so.
+
+    void resetCells();
+        // Reset all the cells to their default states.  The behavior is
+        // undefined unless 'd_mutex' is held by the calling thread.
+
   public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(IntegerCollector,
+                                   bslma::UsesBslmaAllocator);
+
     // PUBLIC CONSTANTS
     static const int k_DEFAULT_MIN;  // default minimum value (INT_MAX)
     static const int k_DEFAULT_MAX;  // default maximum value (INT_MIN)
 
     // CREATORS
-    IntegerCollector(const MetricId& metricId);
+    IntegerCollector(const MetricId&   metricId,
+                     bslma::Allocator *basicAllocator = 0);
         // Create an integer collector for a metric having the specified
         // 'metricId', and having an initial count of 0, total of 0, min of
-        // 'k_DEFAULT_MIN', and max of 'k_DEFAULT_MAX'.
+        // 'k_DEFAULT_MIN', and max of 'k_DEFAULT_MAX'.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  Note that
+        // memory is allocated only once this collector is updated
+        // concurrently (see {Memory Usage}).
 
     ~IntegerCollector();
         // Destroy this object.
@@ -174,7 +293,8 @@ class IntegerCollector {
         // Increment the event count by 1, add the specified 'value' to the
         // total, if 'value' is less than the minimum value, set 'value' to be
         // the minimum value, and if 'value' is greater than the maximum
-        // value, set 'value' to be the maximum value.
+        // value, set 'value' to be the maximum value.  Note that this
+        // operation does not acquire a lock (see {Thread Safety}).
 
     void accumulateCountTotalMinMax(int count, int total, int min, int max);
         // Increment the event count by the specified 'count', add the
@@ -214,68 +334,85 @@ class IntegerCollector {
                            // class IntegerCollector
                            // ----------------------
 
-// CREATORS
+// PRIVATE CLASS METHODS
 inline
-IntegerCollector::IntegerCollector(const MetricId& metricId)
-: d_metricId(metricId)
-, d_count(0)
-, d_total(0)
-, d_min(k_DEFAULT_MIN)
-, d_max(k_DEFAULT_MAX)
-, d_mutex()
+int IntegerCollector::cellIndex()
 {
+    // Thread identifiers are typically addresses of per-thread data, which
+    // differ mostly in their middle bits: fold them, then use the high-order
+    // bits of a multiplicative hash.
+
+    const bsls::Types::Uint64 id   = bslmt::ThreadUtil::selfIdAsUint64();
+    const unsigned int        hash = static_cast<unsigned int>(id ^ (id >> 32))
+                                   * 2654435769U;
+
+    return static_cast<int>(hash >> (32 - k_NUM_CELLS_LOG2));
 }
 
 inline
-IntegerCollector::~IntegerCollector()
+IntegerCollector::Cell& IntegerCollector::cell(char *cellBuffer, int index)
 {
+    // Skip to the first cache line boundary within 'cellBuffer'.
+
+    const bsls::Types::UintPtr address =
+                           reinterpret_cast<bsls::Types::UintPtr>(cellBuffer);
+    char *cells = cellBuffer + (k_CELL_SIZE - address % k_CELL_SIZE);
+
+    return *reinterpret_cast<Cell *>(cells + index * k_CELL_SIZE);
 }
 
-// MANIPULATORS
 inline
-void IntegerCollector::reset()
+bool IntegerCollector::incrementCount(bsls::AtomicInt *count)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
-    d_count = 0;
-    d_total = 0;
-    d_min   = k_DEFAULT_MIN;
-    d_max   = k_DEFAULT_MAX;
+    const int current = count->loadRelaxed();
+    if (current == count->testAndSwapAcqRel(current, current + 1)) {
+        return false;                                                 // RETURN
+    }
+    count->addRelaxed(1);
+    return true;
 }
 
 inline
-void IntegerCollector::update(int value)
+void IntegerCollector::atomicMin(bsls::AtomicInt *minimum, int value)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
-    ++d_count;
-    d_total += value;
-    d_min = bsl::min(value, d_min);
-    d_max = bsl::max(value, d_max);
+    int current = minimum->loadRelaxed();
+    while (value < current) {
+        const int previous = minimum->testAndSwapAcqRel(current, value);
+        if (previous == current) {
+            return;                                                   // RETURN
+        }
+        current = previous;
+    }
 }
 
 inline
-void IntegerCollector::accumulateCountTotalMinMax(int count,
-                                                  int total,
-                                                  int min,
-                                                  int max)
+void IntegerCollector::atomicMax(bsls::AtomicInt *maximum, int value)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
-    d_count += count;
-    d_total += total;
-    d_min   = bsl::min(min, d_min);
-    d_max   = bsl::max(max, d_max);
+    int current = maximum->loadRelaxed();
+    while (current < value) {
+        const int previous = maximum->testAndSwapAcqRel(current, value);
+        if (previous == current) {
+            return;                                                   // RETURN
+        }
+        current = previous;
+    }
 }
 
+// MANIPULATORS
 inline
-void IntegerCollector::setCountTotalMinMax(int count,
-                                           int total,
-                                           int min,
-                                           int max)
+void IntegerCollector::update(int value)
 {
-    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
-    d_count = count;
-    d_total = total;
-    d_min   = min;
-    d_max   = max;
+    char *cellBuffer = d_cellBuffer_p.loadAcquire();
+    Cell& c          = cellBuffer ? cell(cellBuffer, cellIndex()) : d_cell;
+
+    const bool contended = incrementCount(&c.d_count);
+    c.d_total.addRelaxed(value);
+    atomicMin(&c.d_min, value);
+    atomicMax(&c.d_max, value);
+
+    if (contended && !cellBuffer) {
+        allocateCells();
+    }
 }
 
 // ACCESSORS
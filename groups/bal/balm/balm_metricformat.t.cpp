@@ -526,7 +526,8 @@ int main(int argc, char *argv[])
             " MAX = NULL "
             " AVG = [ scale = 2 format = \"%x\" ] "
             " RATE = NULL "
-            " RATE_COUNT = NULL  ] ";
+            " RATE_COUNT = NULL "
+            " QUANTILE = NULL  ] ";
 
         const char *EXP_2 =
             "   [\n"
@@ -538,6 +539,7 @@ int main(int argc, char *argv[])
             "      AVG = [ scale = 2 format = \"%x\" ]\n"
             "      RATE = NULL\n"
             "      RATE_COUNT = NULL\n"
+            "      QUANTILE = NULL\n"
             "    ]\n";
 
         bsl::string printVal(printBuf.str());
@@ -46,6 +46,7 @@ int PublicationType::fromInt(PublicationType::Value *result,
       case PublicationType::e_AVG:
       case PublicationType::e_RATE:
       case PublicationType::e_RATE_COUNT:
+      case PublicationType::e_QUANTILE:
         *result = (PublicationType::Value)number;
         return 0;                                                     // RETURN
       default:
@@ -143,6 +144,25 @@ int PublicationType::fromString(PublicationType::Value *result,
                 }
             }
         } break;
+        case 13: {
+            if (string[0]=='B'
+             && string[1]=='A'
+             && string[2]=='E'
+             && string[3]=='M'
+             && string[4]=='_'
+             && string[5]=='Q'
+             && string[6]=='U'
+             && string[7]=='A'
+             && string[8]=='N'
+             && string[9]=='T'
+             && string[10]=='I'
+             && string[11]=='L'
+             && string[12]=='E')
+            {
+                *result = PublicationType::e_QUANTILE;
+                return 0;                                             // RETURN
+            }
+        } break;
         case 15: {
             if (string[0]=='B'
              && string[1]=='A'
@@ -218,6 +238,9 @@ const char *PublicationType::toString(PublicationType::Value value)
       case e_RATE_COUNT: {
         return "RATE_COUNT";                                          // RETURN
       } break;
+      case e_QUANTILE: {
+        return "QUANTILE";                                            // RETURN
+      } break;
     }
 
     BSLS_ASSERT(!"invalid enumerator");
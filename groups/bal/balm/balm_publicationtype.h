@@ -87,11 +87,15 @@ struct PublicationType {
       , e_RATE_COUNT  = 7
             // The count of measured events per second over the published
             // interval (i.e., count / sample interval).
+      , e_QUANTILE    = 8
+            // A quantile of the measured metric values over the published
+            // interval, held as both the minimum and the maximum of the
+            // metric record (see 'balm_histogramcollector').
 
     };
 
     enum {
-        k_LENGTH = 8
+        k_LENGTH = 9
     };
 
     // CLASS METHODS
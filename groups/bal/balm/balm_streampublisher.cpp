@@ -55,6 +55,9 @@ const char *publicationTypeString(balm::PublicationType::Value value)
       case balm::PublicationType::e_RATE_COUNT: {
         return "rate (count/elapsedTime)";                            // RETURN
       }
+      case balm::PublicationType::e_QUANTILE: {
+        return "quantile";                                            // RETURN
+      }
     }
     return "Undefined";
 }
@@ -115,6 +118,14 @@ void formatValue(bsl::ostream&                 stream,
       case balm::PublicationType::e_RATE_COUNT: {
         formatValue(stream, record.count() / elapsedTime, formatSpec);
       } break;
+      case balm::PublicationType::e_QUANTILE: {
+        if (0 == record.count()) {
+            stream << "undefined";
+        }
+        else {
+            formatValue(stream, record.max(), formatSpec);
+        }
+      } break;
     }
 }
 
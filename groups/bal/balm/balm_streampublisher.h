@@ -37,6 +37,15 @@ BSLS_IDENT("$Id: $")
 // This implementation of the publisher protocol publishes records to an output
 // stream that is supplied at construction.
 //
+// A record whose metric has a preferred publication type (see
+// 'balm::MetricDescription') is published as the single value of that type
+// (e.g., 'avg (total/count) = 5').  In particular, a record of a metric whose
+// preferred publication type is 'balm::PublicationType::e_QUANTILE', such as
+// those published by a 'balm::HistogramCollector' for the quantiles of a
+// metric, is published as 'quantile = <value>', where '<value>' is the
+// maximum of the record, or as 'quantile = undefined' if the record is empty.
+// Other records are published with their count, total, minimum, and maximum.
+//
 ///Usage
 ///-----
 // In the following example we illustrate how to create and publish records
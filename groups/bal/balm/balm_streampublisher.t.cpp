@@ -39,7 +39,10 @@ using bsl::flush;
 //                                 Overview
 //                                 --------
 // ----------------------------------------------------------------------------
+// [ 2] PUBLISHING QUANTILES
 // ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] USAGE EXAMPLE
 // ----------------------------------------------------------------------------
 
 // ============================================================================
@@ -48,6 +51,28 @@ using bsl::flush;
 
 static int testStatus = 0;
 
+static void aSsErT(int c, const char *s, int i)
+{
+    if (c) {
+        cout << "Error " << __FILE__ << "(" << i << "): " << s
+             << "    (failed)" << endl;
+        if (0 <= testStatus && testStatus <= 100) ++testStatus;
+    }
+}
+
+// ============================================================================
+//                      STANDARD BDE TEST DRIVER MACROS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
 // ============================================================================
 //                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
 // ----------------------------------------------------------------------------
@@ -70,7 +95,7 @@ int main(int argc, char *argv[])
     bsl::cout << "TEST " << __FILE__ << " CASE " << test << bsl::endl;;
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 2: {
+      case 3: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //
@@ -137,6 +162,88 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PUBLISHING QUANTILES
+        //
+        // Concerns:
+        //: 1 A record whose metric has the preferred publication type
+        //:   'e_QUANTILE' is published as the maximum of the record.
+        //:
+        //: 2 An empty quantile record is published as 'undefined'.
+        //:
+        //: 3 The format of the metric, if any, applies to the quantile.
+        //
+        // Plan:
+        //: 1 Publish quantile records with and without a count, and with and
+        //:   without a format, to a string stream and verify the output.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   PUBLISHING QUANTILES
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PUBLISHING QUANTILES" << endl
+                          << "====================" << endl;
+
+        bslma::TestAllocator ta, da;
+        bslma::DefaultAllocatorGuard guard(&da);
+
+        balm::Category          category("Server");
+        balm::MetricDescription desc(&category, "latency.p99");
+        desc.setPreferredPublicationType(balm::PublicationType::e_QUANTILE);
+
+        balm::MetricId metricId(&desc);
+
+        balm::MetricRecord records[] = {
+            balm::MetricRecord(metricId, 100, 9900, 99, 99),
+            balm::MetricRecord(metricId)
+        };
+
+        balm::MetricSample sample(&ta);
+        sample.setTimeStamp(bdlt::DatetimeTz(bdlt::CurrentTime::utc(), 0));
+        sample.appendGroup(records, 2, bsls::TimeInterval(1, 0));
+
+        {
+            bsl::ostringstream stream;
+            Obj mX(stream);
+            mX.publish(sample);
+
+            const bsl::string output = stream.str();
+            if (verbose) { P(output) }
+
+            ASSERTV(output,
+                    bsl::string::npos != output.find(
+                                      "Server.latency.p99[ quantile = 99 ]"));
+            ASSERTV(output,
+                    bsl::string::npos != output.find(
+                               "Server.latency.p99[ quantile = undefined ]"));
+        }
+
+        balm::MetricFormat format(&ta);
+        format.setFormatSpec(balm::PublicationType::e_QUANTILE,
+                             balm::MetricFormatSpec(1000, "%.0fus"));
+        bsl::shared_ptr<const balm::MetricFormat> format_p(
+                                    &format, bslstl::SharedPtrNilDeleter(), 0);
+        desc.setFormat(format_p);
+
+        {
+            bsl::ostringstream stream;
+            Obj mX(stream);
+            mX.publish(sample);
+
+            const bsl::string output = stream.str();
+            if (verbose) { P(output) }
+
+            ASSERTV(output,
+                    bsl::string::npos != output.find(
+                                  "Server.latency.p99[ quantile = 99000us ]"));
+            ASSERTV(output,
+                    bsl::string::npos != output.find(
+                               "Server.latency.p99[ quantile = undefined ]"));
+        }
+      } break;
       case 1: {
         // --------------------------------------------------------------------
         // BREATHING TEST:
@@ -0,0 +1,872 @@
+// bdlc_flathashmap.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLC_FLATHASHMAP
+#define INCLUDED_BDLC_FLATHASHMAP
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an open-addressed unordered map container.
+//
+//@CLASSES:
+//  bdlc::FlatHashMap: open-addressed unordered map container
+//  bdlc::FlatHashMap_EntryUtil: entry access for the underlying table
+//
+//@SEE_ALSO: bdlc_flathashtable, bdlc_flathashset, bslstl_unorderedmap
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlc::FlatHashMap', implementing an unordered map of unique keys of
+// (template parameter) type 'KEY' to values of (template parameter) type
+// 'VALUE', whose interface is a subset of that of 'bsl::unordered_map'.
+//
+// Unlike 'bsl::unordered_map', which allocates a node per element, a
+// 'bdlc::FlatHashMap' stores its elements inline in a single array of slots,
+// and probes 16 slots at a time using a parallel array of control bytes (see
+// 'bdlc_flathashtable'), so that lookups touch fewer cache lines, and
+// inserting and erasing elements does not allocate memory (except when the
+// map is rehashed).  The price of this layout is that elements are moved when
+// the map is rehashed, so that, unlike those of 'bsl::unordered_map', the
+// iterators, pointers, and references to the elements of a
+// 'bdlc::FlatHashMap' are invalidated by any insertion (see
+// {'bdlc_flathashtable'|Iterator, Pointer, and Reference Invalidation}).
+// 'bdlc::FlatHashMap' is best suited to maps of small elements that are
+// looked up far more often than they are inserted.  Elements whose type is
+// bitwise moveable (see 'bslmf_isbitwisemoveable') are relocated without
+// being copied when the map is rehashed.
+//
+// The (template parameter) type 'HASH' defaults to 'bslh::Hash<>', which
+// supports any key type implementing the 'hashAppend' free function, and the
+// (template parameter) type 'EQUAL' defaults to 'bsl::equal_to<KEY>'.  A map
+// uses a 'bslma::Allocator' to supply memory, which is also passed to the
+// elements if they use one.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Counting Words
+///- - - - - - - - - - - - -
+// Suppose we want to count the occurrences of each word of a text.
+//
+// First, we create a map from words to counts:
+//..
+//  bdlc::FlatHashMap<bsl::string, int> counts;
+//..
+// Then, we count the words of the text, relying on 'operator[]' to insert a
+// count of 0 for words seen for the first time:
+//..
+//  const char *words[] = { "the", "quick", "fox", "jumps", "over",
+//                          "the", "lazy", "dog", "the", "end" };
+//
+//  for (bsl::size_t i = 0; i < sizeof words / sizeof *words; ++i) {
+//      ++counts[words[i]];
+//  }
+//..
+// Finally, we verify the counts:
+//..
+//  assert(8 == counts.size());
+//  assert(3 == counts["the"]);
+//  assert(1 == counts.at("fox"));
+//  assert(false == counts.contains("cat"));
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLC_FLATHASHTABLE
+#include <bdlc_flathashtable.h>
+#endif
+
+#ifndef INCLUDED_BSLH_HASH
+#include <bslh_hash.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_CONSTRUCTIONUTIL
+#include <bslma_constructionutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STDEXCEPTUTIL
+#include <bslstl_stdexceptutil.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_FUNCTIONAL
+#include <bsl_functional.h>
+#endif
+
+#ifndef INCLUDED_BSL_UTILITY
+#include <bsl_utility.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                        // ============================
+                        // struct FlatHashMap_EntryUtil
+                        // ============================
+
+template <class KEY, class VALUE, class ENTRY>
+struct FlatHashMap_EntryUtil {
+    // This 'struct' provides the 'ENTRY_UTIL' operations required by
+    // 'FlatHashTable' for entries of (template parameter) type 'ENTRY', a
+    // 'bsl::pair<const KEY, VALUE>'.
+
+    // CLASS METHODS
+    static void constructFromKey(ENTRY            *entry,
+                                 bslma::Allocator *allocator,
+                                 const KEY&        key);
+        // Create, at the specified 'entry' address, an entry having the
+        // specified 'key' and a default-constructed value, using the
+        // specified 'allocator' to supply memory.
+
+    static const KEY& key(const ENTRY& entry);
+        // Return the key of the specified 'entry'.
+};
+
+                             // =================
+                             // class FlatHashMap
+                             // =================
+
+template <class KEY,
+          class VALUE,
+          class HASH  = bslh::Hash<>,
+          class EQUAL = bsl::equal_to<KEY> >
+class FlatHashMap {
+    // This class template implements a value-semantic container mapping
+    // unique keys of (template parameter) type 'KEY' to values of (template
+    // parameter) type 'VALUE', stored inline in an open-addressed hash table.
+
+    // PRIVATE TYPES
+    typedef bsl::pair<const KEY, VALUE>                          Entry;
+    typedef FlatHashMap_EntryUtil<KEY, VALUE, Entry>             EntryUtil;
+    typedef FlatHashTable<KEY, Entry, EntryUtil, HASH, EQUAL>    ImplType;
+
+    // DATA
+    ImplType d_impl;  // underlying flat hash table
+
+    // FRIENDS
+    template <class K, class V, class H, class E>
+    friend bool operator==(const FlatHashMap<K, V, H, E>&,
+                           const FlatHashMap<K, V, H, E>&);
+
+  public:
+    // TYPES
+    typedef KEY                                key_type;
+    typedef VALUE                              mapped_type;
+    typedef Entry                              value_type;
+    typedef bsl::size_t                        size_type;
+    typedef bsl::ptrdiff_t                     difference_type;
+    typedef HASH                               hasher;
+    typedef EQUAL                              key_equal;
+    typedef value_type&                        reference;
+    typedef const value_type&                  const_reference;
+    typedef value_type                        *pointer;
+    typedef const value_type                  *const_pointer;
+    typedef typename ImplType::iterator        iterator;
+    typedef typename ImplType::const_iterator  const_iterator;
+
+    // CREATORS
+    FlatHashMap();
+    explicit FlatHashMap(bslma::Allocator *basicAllocator);
+    explicit FlatHashMap(bsl::size_t capacity);
+    FlatHashMap(bsl::size_t capacity, bslma::Allocator *basicAllocator);
+    FlatHashMap(bsl::size_t       capacity,
+                const HASH&       hash,
+                bslma::Allocator *basicAllocator = 0);
+    FlatHashMap(bsl::size_t       capacity,
+                const HASH&       hash,
+                const EQUAL&      equal,
+                bslma::Allocator *basicAllocator = 0);
+        // Create an empty map.  Optionally specify a 'capacity', the minimum
+        // number of slots of the map; if 'capacity' is not specified, or is
+        // 0, no memory is allocated until the first insertion.  Optionally
+        // specify a 'hash' functor used to hash keys; if 'hash' is not
+        // specified, a default-constructed 'HASH' is used.  Optionally
+        // specify an 'equal' functor used to compare keys; if 'equal' is not
+        // specified, a default-constructed 'EQUAL' is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    template <class INPUT_ITERATOR>
+    FlatHashMap(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a map holding the elements in the specified range
+        // '[first, last)', ignoring the elements whose key is equivalent to
+        // that of a previous element of the range.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless 'first' and 'last' refer to a sequence of valid
+        // values where 'first' is at a position at or before 'last'.
+
+    FlatHashMap(const FlatHashMap&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a map having the same value, hash and equality functors as
+        // the specified 'original' map.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    //! ~FlatHashMap() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    FlatHashMap& operator=(const FlatHashMap& rhs);
+        // Assign to this object the value, hash and equality functors of the
+        // specified 'rhs' object, and return a reference providing modifiable
+        // access to this object.
+
+    VALUE& operator[](const KEY& key);
+        // Return a reference providing modifiable access to the value mapped
+        // to the specified 'key', inserting an element mapping 'key' to a
+        // default-constructed value if this map has no element whose key is
+        // equivalent to 'key'.
+
+    VALUE& at(const KEY& key);
+        // Return a reference providing modifiable access to the value mapped
+        // to the specified 'key'.  Throw a 'std::out_of_range' exception if
+        // this map has no element whose key is equivalent to 'key'.
+
+    void clear();
+        // Remove all elements from this map.  Note that the capacity of this
+        // map is unchanged.
+
+    bsl::pair<iterator, iterator> equal_range(const KEY& key);
+        // Return a pair of iterators delimiting the sequence of elements of
+        // this map whose key is equivalent to the specified 'key' (holding at
+        // most one element).
+
+    bsl::size_t erase(const KEY& key);
+        // Remove the element whose key is equivalent to the specified 'key',
+        // if any, and return the number of elements removed (0 or 1).
+
+    iterator erase(const_iterator position);
+        // Remove the element at the specified 'position', and return an
+        // iterator referring to the element following it, or 'end()' if
+        // there is no such element.  The behavior is undefined unless
+        // 'position' refers to an element of this map.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove the elements in the specified range '[first, last)', and
+        // return 'last'.  The behavior is undefined unless 'first' and 'last'
+        // refer to elements of this map (or 'end()'), and 'first' is at a
+        // position at or before 'last'.
+
+    iterator find(const KEY& key);
+        // Return an iterator referring to the element whose key is equivalent
+        // to the specified 'key', or 'end()' if there is no such element.
+
+    bsl::pair<iterator, bool> insert(const value_type& value);
+        // Insert a copy of the specified 'value' if this map has no element
+        // whose key is equivalent to that of 'value'.  Return a pair whose
+        // first member is an iterator referring to the element of this map
+        // having that key, and whose second member is 'true' if 'value' was
+        // inserted, and 'false' otherwise.  Note that all iterators to the
+        // elements of this map are invalidated if the map is rehashed.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Insert a copy of each element in the specified range
+        // '[first, last)' whose key is not equivalent to that of an element
+        // of this map.  The behavior is undefined unless 'first' and 'last'
+        // refer to a sequence of valid values where 'first' is at a position
+        // at or before 'last'.
+
+    void rehash(bsl::size_t minimumCapacity);
+        // Change the capacity of this map to the smallest power of two (not
+        // less than 16) that is not less than the specified 'minimumCapacity'
+        // and can hold 'size()' elements, and rehash the elements.
+
+    void reserve(bsl::size_t numEntries);
+        // Grow this map, if needed, so that it can hold the specified
+        // 'numEntries' elements without being rehashed.
+
+    void reset();
+        // Remove all elements from this map, and release all memory allocated
+        // by this map.
+
+                             // Iterators
+
+    iterator begin();
+        // Return an iterator referring to the first element of this map, or
+        // 'end()' if this map is empty.
+
+    iterator end();
+        // Return the past-the-end iterator of this map.
+
+                                  // Aspects
+
+    void swap(FlatHashMap& other);
+        // Exchange the value, capacity, hash and equality functors of this
+        // object with those of the specified 'other' object.  This method
+        // provides the no-throw exception-safety guarantee.  The behavior is
+        // undefined unless this object was created with the same allocator as
+        // 'other'.
+
+    // ACCESSORS
+    const VALUE& at(const KEY& key) const;
+        // Return a reference providing non-modifiable access to the value
+        // mapped to the specified 'key'.  Throw a 'std::out_of_range'
+        // exception if this map has no element whose key is equivalent to
+        // 'key'.
+
+    bsl::size_t capacity() const;
+        // Return the number of slots of this map.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this map has an element whose key is equivalent to
+        // the specified 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of elements of this map whose key is equivalent
+        // to the specified 'key' (0 or 1).
+
+    bool empty() const;
+        // Return 'true' if this map has no element, and 'false' otherwise.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of iterators delimiting the sequence of elements of
+        // this map whose key is equivalent to the specified 'key' (holding at
+        // most one element).
+
+    const_iterator find(const KEY& key) const;
+        // Return an iterator referring to the element whose key is equivalent
+        // to the specified 'key', or 'end()' if there is no such element.
+
+    HASH hash_function() const;
+        // Return (a copy of) the hash functor of this map.
+
+    EQUAL key_eq() const;
+        // Return (a copy of) the key-equivalence functor of this map.
+
+    float load_factor() const;
+        // Return the ratio of the number of elements to the number of slots
+        // of this map, or 0 if this map has no slot.
+
+    float max_load_factor() const;
+        // Return the maximum ratio of the number of slots holding an element,
+        // or having held an erased element, to the number of slots of this
+        // map, beyond which the map is rehashed.
+
+    bsl::size_t size() const;
+        // Return the number of elements of this map.
+
+                             // Iterators
+
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+        // Return an iterator referring to the first element of this map, or
+        // 'end()' if this map is empty.
+
+    const_iterator end() const;
+    const_iterator cend() const;
+        // Return the past-the-end iterator of this map.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this map to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bool operator==(const FlatHashMap<KEY, VALUE, HASH, EQUAL>& lhs,
+                const FlatHashMap<KEY, VALUE, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' maps have the same value,
+    // and 'false' otherwise.  Two maps have the same value if they have the
+    // same number of elements, and for each element of 'lhs', 'rhs' has an
+    // element having an equivalent key and an equal value.
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bool operator!=(const FlatHashMap<KEY, VALUE, HASH, EQUAL>& lhs,
+                const FlatHashMap<KEY, VALUE, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' maps do not have the same
+    // value, and 'false' otherwise.  Two maps do not have the same value if
+    // they do not have the same number of elements, or if for some element of
+    // 'lhs', 'rhs' has no element having an equivalent key and an equal value.
+
+// FREE FUNCTIONS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void swap(FlatHashMap<KEY, VALUE, HASH, EQUAL>& a,
+          FlatHashMap<KEY, VALUE, HASH, EQUAL>& b);
+    // Exchange the values of the specified 'a' and 'b' maps.  The behavior is
+    // undefined unless both maps were created with the same allocator.
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                        // ----------------------------
+                        // struct FlatHashMap_EntryUtil
+                        // ----------------------------
+
+// CLASS METHODS
+template <class KEY, class VALUE, class ENTRY>
+inline
+void FlatHashMap_EntryUtil<KEY, VALUE, ENTRY>::constructFromKey(
+                                                  ENTRY            *entry,
+                                                  bslma::Allocator *allocator,
+                                                  const KEY&        key)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bslma::ConstructionUtil::construct(entry, allocator, key, VALUE());
+}
+
+template <class KEY, class VALUE, class ENTRY>
+inline
+const KEY& FlatHashMap_EntryUtil<KEY, VALUE, ENTRY>::key(const ENTRY& entry)
+{
+    return entry.first;
+}
+
+                             // -----------------
+                             // class FlatHashMap
+                             // -----------------
+
+// CREATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap()
+: d_impl(0, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                             bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(bsl::size_t capacity)
+: d_impl(capacity, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                             bsl::size_t       capacity,
+                                             bslma::Allocator *basicAllocator)
+: d_impl(capacity, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                             bsl::size_t       capacity,
+                                             const HASH&       hash,
+                                             bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                             bsl::size_t       capacity,
+                                             const HASH&       hash,
+                                             const EQUAL&      equal,
+                                             bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, equal, basicAllocator)
+{
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                             INPUT_ITERATOR    first,
+                                             INPUT_ITERATOR    last,
+                                             bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::FlatHashMap(
+                                         const FlatHashMap&  original,
+                                         bslma::Allocator   *basicAllocator)
+: d_impl(original.d_impl, basicAllocator)
+{
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+FlatHashMap<KEY, VALUE, HASH, EQUAL>&
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator=(const FlatHashMap& rhs)
+{
+    d_impl = rhs.d_impl;
+    return *this;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::operator[](const KEY& key)
+{
+    return d_impl.try_emplace(key).first->second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::at(const KEY& key)
+{
+    iterator it = d_impl.find(key);
+    if (it == d_impl.end()) {
+        BloombergLP::bslstl::StdExceptUtil::throwOutOfRange(
+                                "FlatHashMap<...>::at(key_type): invalid key");
+    }
+    return it->second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::clear()
+{
+    d_impl.clear();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator,
+          typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::equal_range(const KEY& key)
+{
+    iterator it = d_impl.find(key);
+    if (it == d_impl.end()) {
+        return bsl::pair<iterator, iterator>(it, it);                 // RETURN
+    }
+    iterator next = it;
+    ++next;
+    return bsl::pair<iterator, iterator>(it, next);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(const KEY& key)
+{
+    return d_impl.erase(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(const_iterator position)
+{
+    return d_impl.erase(position);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::erase(const_iterator first,
+                                            const_iterator last)
+{
+    // Erasing an entry does not move the other entries, so that 'last'
+    // remains valid.
+
+    while (first != last) {
+        first = d_impl.erase(first);
+    }
+    return iterator(last.imp());
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::find(const KEY& key)
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator, bool>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::insert(const value_type& value)
+{
+    return d_impl.insert(value);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::insert(INPUT_ITERATOR first,
+                                                  INPUT_ITERATOR last)
+{
+    for (; first != last; ++first) {
+        d_impl.insert(*first);
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::rehash(bsl::size_t minimumCapacity)
+{
+    d_impl.rehash(minimumCapacity);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::reserve(bsl::size_t numEntries)
+{
+    d_impl.reserve(numEntries);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::reset()
+{
+    d_impl.reset();
+}
+
+                             // Iterators
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::begin()
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::end()
+{
+    return d_impl.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void FlatHashMap<KEY, VALUE, HASH, EQUAL>::swap(FlatHashMap& other)
+{
+    d_impl.swap(other.d_impl);
+}
+
+// ACCESSORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+const VALUE& FlatHashMap<KEY, VALUE, HASH, EQUAL>::at(const KEY& key) const
+{
+    const_iterator it = d_impl.find(key);
+    if (it == d_impl.end()) {
+        BloombergLP::bslstl::StdExceptUtil::throwOutOfRange(
+                                "FlatHashMap<...>::at(key_type): invalid key");
+    }
+    return it->second;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::capacity() const
+{
+    return d_impl.capacity();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool FlatHashMap<KEY, VALUE, HASH, EQUAL>::contains(const KEY& key) const
+{
+    return d_impl.contains(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::count(const KEY& key) const
+{
+    return d_impl.count(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool FlatHashMap<KEY, VALUE, HASH, EQUAL>::empty() const
+{
+    return d_impl.empty();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator,
+          typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator>
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::equal_range(const KEY& key) const
+{
+    const_iterator it = d_impl.find(key);
+    if (it == d_impl.end()) {
+        return bsl::pair<const_iterator, const_iterator>(it, it);     // RETURN
+    }
+    const_iterator next = it;
+    ++next;
+    return bsl::pair<const_iterator, const_iterator>(it, next);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::find(const KEY& key) const
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+HASH FlatHashMap<KEY, VALUE, HASH, EQUAL>::hash_function() const
+{
+    return d_impl.hash_function();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+EQUAL FlatHashMap<KEY, VALUE, HASH, EQUAL>::key_eq() const
+{
+    return d_impl.key_eq();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+float FlatHashMap<KEY, VALUE, HASH, EQUAL>::load_factor() const
+{
+    return d_impl.load_factor();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+float FlatHashMap<KEY, VALUE, HASH, EQUAL>::max_load_factor() const
+{
+    return d_impl.max_load_factor();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashMap<KEY, VALUE, HASH, EQUAL>::size() const
+{
+    return d_impl.size();
+}
+
+                             // Iterators
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::begin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::cbegin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::end() const
+{
+    return d_impl.end();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename FlatHashMap<KEY, VALUE, HASH, EQUAL>::const_iterator
+FlatHashMap<KEY, VALUE, HASH, EQUAL>::cend() const
+{
+    return d_impl.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bslma::Allocator *FlatHashMap<KEY, VALUE, HASH, EQUAL>::allocator() const
+{
+    return d_impl.allocator();
+}
+
+// FREE OPERATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool operator==(const FlatHashMap<KEY, VALUE, HASH, EQUAL>& lhs,
+                const FlatHashMap<KEY, VALUE, HASH, EQUAL>& rhs)
+{
+    return lhs.d_impl == rhs.d_impl;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bool operator!=(const FlatHashMap<KEY, VALUE, HASH, EQUAL>& lhs,
+                const FlatHashMap<KEY, VALUE, HASH, EQUAL>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void swap(FlatHashMap<KEY, VALUE, HASH, EQUAL>& a,
+          FlatHashMap<KEY, VALUE, HASH, EQUAL>& b)
+{
+    a.swap(b);
+}
+
+}  // close package namespace
+
+// TRAITS
+
+namespace bslma {
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+struct UsesBslmaAllocator<bdlc::FlatHashMap<KEY, VALUE, HASH, EQUAL> >
+                                                           : bsl::true_type {};
+
+}  // close namespace bslma
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
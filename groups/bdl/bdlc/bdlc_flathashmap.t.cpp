@@ -0,0 +1,911 @@
+// bdlc_flathashmap.t.cpp                                             -*-C++-*-
+#include <bdlc_flathashmap.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_stdexcept.h>
+#include <bsl_string.h>
+#include <bsl_unordered_map.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test implements an unordered map on top of
+// 'bdlc::FlatHashTable', which is tested thoroughly in its own test driver.
+// This test driver verifies that each method forwards to the table as
+// documented, the map-specific operations ('operator[]', 'at', and
+// 'equal_range'), and the propagation of the allocator to the elements.
+// Benchmarks comparing the map to 'bsl::unordered_map' are provided as
+// negative test cases.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashMap();
+// [ 2] explicit FlatHashMap(bslma::Allocator *basicAllocator);
+// [ 2] explicit FlatHashMap(bsl::size_t capacity);
+// [ 2] FlatHashMap(bsl::size_t capacity, bslma::Allocator *basicAllocator);
+// [ 2] FlatHashMap(capacity, hash, basicAllocator);
+// [ 2] FlatHashMap(capacity, hash, equal, basicAllocator);
+// [ 2] FlatHashMap(INPUT_ITERATOR first, last, basicAllocator);
+// [ 4] FlatHashMap(const FlatHashMap& original, basicAllocator);
+//
+// MANIPULATORS
+// [ 4] FlatHashMap& operator=(const FlatHashMap& rhs);
+// [ 3] VALUE& operator[](const KEY& key);
+// [ 3] VALUE& at(const KEY& key);
+// [ 3] void clear();
+// [ 3] bsl::pair<iterator, iterator> equal_range(const KEY& key);
+// [ 3] bsl::size_t erase(const KEY& key);
+// [ 3] iterator erase(const_iterator position);
+// [ 3] iterator erase(const_iterator first, const_iterator last);
+// [ 3] iterator find(const KEY& key);
+// [ 3] bsl::pair<iterator, bool> insert(const value_type& value);
+// [ 3] void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+// [ 3] void rehash(bsl::size_t minimumCapacity);
+// [ 3] void reserve(bsl::size_t numEntries);
+// [ 3] void reset();
+// [ 3] iterator begin();
+// [ 3] iterator end();
+// [ 4] void swap(FlatHashMap& other);
+//
+// ACCESSORS
+// [ 3] const VALUE& at(const KEY& key) const;
+// [ 2] bsl::size_t capacity() const;
+// [ 3] bool contains(const KEY& key) const;
+// [ 3] bsl::size_t count(const KEY& key) const;
+// [ 2] bool empty() const;
+// [ 3] bsl::pair<cIter, cIter> equal_range(const KEY& key) const;
+// [ 3] const_iterator find(const KEY& key) const;
+// [ 2] HASH hash_function() const;
+// [ 2] EQUAL key_eq() const;
+// [ 2] float load_factor() const;
+// [ 2] float max_load_factor() const;
+// [ 2] bsl::size_t size() const;
+// [ 3] const_iterator begin() const;
+// [ 3] const_iterator cbegin() const;
+// [ 3] const_iterator end() const;
+// [ 3] const_iterator cend() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 4] bool operator==(lhs, rhs);
+// [ 4] bool operator!=(lhs, rhs);
+// [ 4] void swap(FlatHashMap& a, FlatHashMap& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+// [ 3] CONCERN: The allocator is propagated to the elements.
+// [-1] PERFORMANCE: 'int' KEYS
+// [-2] PERFORMANCE: 'bsl::string' KEYS
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+#define ASSERT_OPT_FAIL_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL_RAW(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::FlatHashMap<int, bsl::string>         Obj;
+typedef bdlc::FlatHashMap<bsl::string, bsl::string> StringObj;
+
+// Define 'bsl::string' value long enough to ensure dynamic memory allocation.
+#define SUFFICIENTLY_LONG_STRING "1234567890123456789012345678901234567890" \
+                                 "1234567890123456789012345678901234567890"
+
+const char *const LONG_STRING = "a_" SUFFICIENTLY_LONG_STRING;
+
+struct IdentityHash {
+    // This 'struct' provides a hash functor returning 'int' keys unchanged,
+    // as 'bsl::hash<int>' does.
+
+    bsl::size_t operator()(int key) const
+        // Return the specified 'key'.
+    {
+        return static_cast<bsl::size_t>(key);
+    }
+};
+
+// ============================================================================
+//                            BENCHMARK SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+template <class MAP, class KEY>
+void benchmark(const char              *name,
+               const bsl::vector<KEY>&  keys,
+               const bsl::vector<KEY>&  missingKeys,
+               int                      numRounds)
+    // Print the time taken, by a map of the (template parameter) type 'MAP',
+    // to insert the specified 'keys', find each of them and each of the
+    // specified 'missingKeys' the specified 'numRounds' times, iterate over
+    // the map 'numRounds' times, and erase the keys, labeled with the
+    // specified 'name'.  Keys are looked up in a pseudo-random order, so that
+    // the order in which nodes were allocated does not favor node-based maps.
+{
+    const bsl::size_t  numKeys = keys.size();
+    bsls::Stopwatch    timer;
+    bsl::size_t        sum = 0;
+
+    bsl::vector<KEY> lookupKeys(keys);
+    unsigned int     seed = 12345;
+    for (bsl::size_t i = numKeys; i > 1; --i) {
+        seed = seed * 1103515245 + 12345;
+        bsl::swap(lookupKeys[i - 1], lookupKeys[(seed >> 4) % i]);
+    }
+
+    MAP map;
+
+    timer.start(true);
+    for (bsl::size_t i = 0; i < numKeys; ++i) {
+        map[keys[i]] = static_cast<int>(i);
+    }
+    timer.stop();
+    const double insertTime = timer.accumulatedWallTime();
+
+    timer.reset();
+    timer.start(true);
+    for (int round = 0; round < numRounds; ++round) {
+        for (bsl::size_t i = 0; i < numKeys; ++i) {
+            sum += map.find(lookupKeys[i])->second;
+        }
+    }
+    timer.stop();
+    const double findHitTime = timer.accumulatedWallTime();
+
+    timer.reset();
+    timer.start(true);
+    for (int round = 0; round < numRounds; ++round) {
+        for (bsl::size_t i = 0; i < numKeys; ++i) {
+            sum += map.count(missingKeys[i]);
+        }
+    }
+    timer.stop();
+    const double findMissTime = timer.accumulatedWallTime();
+
+    timer.reset();
+    timer.start(true);
+    for (int round = 0; round < numRounds; ++round) {
+        for (typename MAP::const_iterator it = map.begin();
+                                                    it != map.end(); ++it) {
+            sum += it->second;
+        }
+    }
+    timer.stop();
+    const double iterateTime = timer.accumulatedWallTime();
+
+    timer.reset();
+    timer.start(true);
+    for (bsl::size_t i = 0; i < numKeys; ++i) {
+        sum += map.erase(keys[i]);
+    }
+    timer.stop();
+    const double eraseTime = timer.accumulatedWallTime();
+
+    cout << name
+         << ": insert "    << insertTime
+         << "s, find hit " << findHitTime
+         << "s, find miss " << findMissTime
+         << "s, iterate "  << iterateTime
+         << "s, erase "    << eraseTime
+         << "s (" << sum << ")" << endl;
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                test = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    int             verbose = argc > 2;
+    int         veryVerbose = argc > 3;
+    int     veryVeryVerbose = argc > 4;
+    int veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Counting Words
+///- - - - - - - - - - - - -
+// Suppose we want to count the occurrences of each word of a text.
+//
+// First, we create a map from words to counts:
+//..
+    bdlc::FlatHashMap<bsl::string, int> counts;
+//..
+// Then, we count the words of the text, relying on 'operator[]' to insert a
+// count of 0 for words seen for the first time:
+//..
+    const char *words[] = { "the", "quick", "fox", "jumps", "over",
+                            "the", "lazy", "dog", "the", "end" };
+
+    for (bsl::size_t i = 0; i < sizeof words / sizeof *words; ++i) {
+        ++counts[words[i]];
+    }
+//..
+// Finally, we verify the counts:
+//..
+    ASSERT(8 == counts.size());
+    ASSERT(3 == counts["the"]);
+    ASSERT(1 == counts.at("fox"));
+    ASSERT(false == counts.contains("cat"));
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // COPY, ASSIGNMENT, EQUALITY, AND SWAP
+        //
+        // Concerns:
+        //: 1 A copy has the same value as the original, and uses the supplied
+        //:   allocator, or the default allocator.
+        //:
+        //: 2 Assignment gives the same value, and is alias-safe.
+        //:
+        //: 3 Maps compare equal if and only if they have the same elements.
+        //:
+        //: 4 'swap' exchanges the values of the maps.
+        //
+        // Plan:
+        //: 1 Copy, assign, compare, and swap maps of various values.  (C-1..4)
+        //
+        // Testing:
+        //   FlatHashMap(const FlatHashMap& original, basicAllocator);
+        //   FlatHashMap& operator=(const FlatHashMap& rhs);
+        //   void swap(FlatHashMap& other);
+        //   bool operator==(lhs, rhs);
+        //   bool operator!=(lhs, rhs);
+        //   void swap(FlatHashMap& a, FlatHashMap& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY, ASSIGNMENT, EQUALITY, AND SWAP" << endl
+                          << "====================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        bslma::TestAllocator oa("other",    veryVeryVeryVerbose);
+
+        for (int n = 0; n < 100; n += 9) {
+            Obj mX(&sa);  const Obj& X = mX;
+            for (int i = 0; i < n; ++i) {
+                mX[i] = LONG_STRING;
+            }
+
+            Obj mY(X, &oa);  const Obj& Y = mY;
+            ASSERTV(n, X == Y);
+            ASSERTV(n, !(X != Y));
+            ASSERTV(n, &oa == Y.allocator());
+            ASSERTV(n, (n ? 1 : 0) + n == oa.numBlocksInUse());
+
+            if (n) {
+                mY[0] = "different";
+                ASSERTV(n, X != Y);
+                ASSERTV(n, Y != X);
+
+                mY[0] = LONG_STRING;
+                ASSERTV(n, X == Y);
+
+                mY.erase(n - 1);
+                ASSERTV(n, X != Y);
+            }
+
+            {
+                bslma::DefaultAllocatorGuard guard(&oa);
+
+                const Obj Z(X);
+                ASSERTV(n, &oa == Z.allocator());
+                ASSERTV(n, X == Z);
+            }
+
+            Obj mZ(&sa);  const Obj& Z = mZ;
+            mZ[-1] = "x";
+            mZ = X;
+            ASSERTV(n, X == Z);
+            ASSERTV(n, &sa == Z.allocator());
+
+            mZ = Z;
+            ASSERTV(n, X == Z);
+
+            mZ[-1] = "x";
+            mZ.swap(mX);
+            ASSERTV(n, X != Z);
+            ASSERTV(n, 1 + n == static_cast<int>(X.size()));
+            ASSERTV(n,     n == static_cast<int>(Z.size()));
+
+            swap(mX, mZ);
+            ASSERTV(n,     n == static_cast<int>(X.size()));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // MANIPULATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 'operator[]' inserts a default-constructed value for a missing
+        //:   key, and returns the value mapped to the key.
+        //:
+        //: 2 'at' returns the value mapped to the key, and throws
+        //:   'std::out_of_range' for a missing key.
+        //:
+        //: 3 'insert', 'erase', 'find', 'count', 'contains', and
+        //:   'equal_range' behave as for 'bsl::unordered_map'.
+        //:
+        //: 4 Iteration visits each element once.
+        //:
+        //: 5 'rehash', 'reserve', 'clear', and 'reset' affect the capacity as
+        //:   documented, and not the value (except for 'clear' and 'reset').
+        //:
+        //: 6 The allocator of the map is propagated to the elements, and no
+        //:   memory is allocated from the default allocator.
+        //
+        // Plan:
+        //: 1 Apply the operations to maps with 'bsl::string' keys and values,
+        //:   and compare the results to those of 'bsl::unordered_map'.
+        //:   (C-1..6)
+        //
+        // Testing:
+        //   VALUE& operator[](const KEY& key);
+        //   VALUE& at(const KEY& key);
+        //   void clear();
+        //   bsl::pair<iterator, iterator> equal_range(const KEY& key);
+        //   bsl::size_t erase(const KEY& key);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        //   iterator find(const KEY& key);
+        //   bsl::pair<iterator, bool> insert(const value_type& value);
+        //   void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        //   void rehash(bsl::size_t minimumCapacity);
+        //   void reserve(bsl::size_t numEntries);
+        //   void reset();
+        //   iterator begin();
+        //   iterator end();
+        //   const VALUE& at(const KEY& key) const;
+        //   bool contains(const KEY& key) const;
+        //   bsl::size_t count(const KEY& key) const;
+        //   bsl::pair<cIter, cIter> equal_range(const KEY& key) const;
+        //   const_iterator find(const KEY& key) const;
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   const_iterator end() const;
+        //   const_iterator cend() const;
+        //   CONCERN: The allocator is propagated to the elements.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MANIPULATORS AND ACCESSORS" << endl
+                          << "==========================" << endl;
+
+        typedef bsl::unordered_map<bsl::string, bsl::string> Oracle;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        bslma::TestAllocator xa("scratch",  veryVeryVeryVerbose);
+
+        bsl::vector<bsl::string> keys(&xa);
+        for (int i = 0; i < 500; ++i) {
+            char buffer[16];
+            bsl::sprintf(buffer, "%d", i);
+
+            bsl::string key(LONG_STRING, &xa);
+            key += buffer;
+            keys.push_back(key);
+        }
+
+        {
+            StringObj mX(&sa);  const StringObj& X = mX;
+            Oracle    oracle(&xa);
+
+            for (bsl::size_t i = 0; i < keys.size(); i += 2) {
+                mX[keys[i]] = keys[i + 1];
+                oracle[keys[i]] = keys[i + 1];
+            }
+            ASSERT(oracle.size() == X.size());
+
+            // 'operator[]' on a missing key inserts an empty value.
+
+            ASSERT(true == mX[keys[1]].empty());
+            ASSERT(X.contains(keys[1]));
+            ASSERT(1 == mX.erase(keys[1]));
+            ASSERT(0 == mX.erase(keys[1]));
+
+            // 'insert' does not overwrite.
+
+            const bsl::pair<StringObj::iterator, bool> RESULT =
+                mX.insert(StringObj::value_type(keys[0], bsl::string(), &xa));
+            ASSERT(false   == RESULT.second);
+            ASSERT(keys[1] == RESULT.first->second);
+
+            for (bsl::size_t i = 0; i < keys.size(); ++i) {
+                const bool EXP = 0 == i % 2;
+                ASSERTV(i, EXP == X.contains(keys[i]));
+                ASSERTV(i, EXP == static_cast<bool>(X.count(keys[i])));
+                ASSERTV(i, EXP == (X.find(keys[i]) != X.end()));
+                ASSERTV(i, EXP == (mX.find(keys[i]) != mX.end()));
+
+                const bsl::pair<StringObj::const_iterator,
+                                StringObj::const_iterator> R =
+                                                     X.equal_range(keys[i]);
+                const bsl::pair<StringObj::iterator,
+                                StringObj::iterator> MR =
+                                                    mX.equal_range(keys[i]);
+                ASSERTV(i, EXP == (R.first != R.second));
+                ASSERTV(i, EXP == (MR.first != MR.second));
+                if (EXP) {
+                    StringObj::const_iterator next = R.first;
+                    ASSERTV(i, ++next == R.second);
+                    ASSERTV(i, keys[i + 1] == X.at(keys[i]));
+                    ASSERTV(i, keys[i + 1] == mX.at(keys[i]));
+                }
+                else {
+                    bool caught = false;
+                    try {
+                        X.at(keys[i]);
+                    }
+                    catch (const std::out_of_range&) {
+                        caught = true;
+                    }
+                    ASSERTV(i, caught);
+
+                    caught = false;
+                    try {
+                        mX.at(keys[i]);
+                    }
+                    catch (const std::out_of_range&) {
+                        caught = true;
+                    }
+                    ASSERTV(i, caught);
+                }
+            }
+
+            // Iteration visits each element once.
+
+            bsl::size_t count = 0;
+            for (StringObj::const_iterator it = X.cbegin(); it != X.cend();
+                                                                        ++it) {
+                ASSERT(oracle[it->first] == it->second);
+                ++count;
+            }
+            ASSERT(oracle.size() == count);
+
+            for (StringObj::iterator it = mX.begin(); it != mX.end(); ++it) {
+                it->second = keys[0];
+            }
+            ASSERT(keys[0] == X.at(keys[2]));
+
+            // Capacity management.
+
+            const bsl::size_t CAPACITY = X.capacity();
+            mX.reserve(4 * X.size());
+            ASSERT(CAPACITY < X.capacity());
+            mX.rehash(0);
+            ASSERT(CAPACITY == X.capacity());
+            ASSERT(oracle.size() == X.size());
+
+            // Range insertion and erasure.
+
+            StringObj mY(oracle.begin(), oracle.end(), &sa);
+            ASSERT(oracle.size() == mY.size());
+            mY.insert(X.begin(), X.end());
+            ASSERT(oracle.size() == mY.size());
+
+            StringObj::const_iterator first = mY.begin();
+            ++first;
+            ASSERT(mY.end() == mY.erase(first, mY.cend()));
+            ASSERT(1 == mY.size());
+            ASSERT(mY.end() == mY.erase(mY.begin()));
+            ASSERT(mY.empty());
+
+            mX.clear();
+            ASSERT(X.empty());
+            ASSERT(CAPACITY == X.capacity());
+
+            mX.reset();
+            ASSERT(0 == X.capacity());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates an empty map having the specified
+        //:   capacity, functors, and allocator, or the defaults.
+        //:
+        //: 2 The range constructor inserts the elements of the range, keeping
+        //:   the first of equivalent keys.
+        //
+        // Plan:
+        //: 1 Create maps with each constructor and verify the accessors.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   FlatHashMap();
+        //   explicit FlatHashMap(bslma::Allocator *basicAllocator);
+        //   explicit FlatHashMap(bsl::size_t capacity);
+        //   FlatHashMap(bsl::size_t capacity, bslma::Allocator *bA);
+        //   FlatHashMap(capacity, hash, basicAllocator);
+        //   FlatHashMap(capacity, hash, equal, basicAllocator);
+        //   FlatHashMap(INPUT_ITERATOR first, last, basicAllocator);
+        //   bsl::size_t capacity() const;
+        //   bool empty() const;
+        //   HASH hash_function() const;
+        //   EQUAL key_eq() const;
+        //   float load_factor() const;
+        //   float max_load_factor() const;
+        //   bsl::size_t size() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTORS AND BASIC ACCESSORS" << endl
+                          << "================================" << endl;
+
+        typedef bdlc::FlatHashMap<int, int, IdentityHash> IdObj;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        {
+            const Obj X;
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(0 == X.size());
+            ASSERT(true == X.empty());
+            ASSERT(0.0f == X.load_factor());
+            ASSERT(0.875f == X.max_load_factor());
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+        }
+        {
+            const Obj X(&sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(0 == sa.numBlocksTotal());
+        }
+        {
+            const Obj X(100);
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(128 == X.capacity());
+            ASSERT(1 == defaultAllocator.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+        {
+            const Obj X(20, &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(32 == X.capacity());
+            ASSERT(1 == sa.numBlocksInUse());
+        }
+        {
+            const IdObj X(16, IdentityHash(), &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(16 == X.capacity());
+            ASSERT(7 == X.hash_function()(7));
+        }
+        {
+            const IdObj X(0, IdentityHash(), bsl::equal_to<int>(), &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(true == X.key_eq()(3, 3));
+        }
+        {
+            const bsl::pair<const int, int> DATA[] = {
+                bsl::make_pair(1, 10),
+                bsl::make_pair(2, 20),
+                bsl::make_pair(1, 30),
+                bsl::make_pair(3, 40),
+            };
+
+            const IdObj X(DATA, DATA + 4, &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(3 == X.size());
+            ASSERT(10 == X.at(1));
+            ASSERT(20 == X.at(2));
+            ASSERT(40 == X.at(3));
+            ASSERT(3.0f / 16 == X.load_factor());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Insert, look up, and erase elements, with 'int' keys and a hash
+        //:   functor returning the keys unchanged (so that consecutive keys
+        //:   fall in the same group), and compare to 'bsl::unordered_map'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        typedef bdlc::FlatHashMap<int, int, IdentityHash> IdObj;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        {
+            IdObj                   mX(&sa);  const IdObj& X = mX;
+            bsl::unordered_map<int, int> oracle(&sa);
+
+            for (int i = 0; i < 10000; ++i) {
+                const int key = (i * 7919) % 5003;
+                mX[key] += i;
+                oracle[key] += i;
+            }
+            ASSERT(oracle.size() == X.size());
+            for (int i = -10; i < 6000; ++i) {
+                ASSERTV(i, oracle.count(i) == X.count(i));
+                if (X.count(i)) {
+                    ASSERTV(i, oracle[i] == X.at(i));
+                }
+            }
+            for (int i = 0; i < 5003; i += 3) {
+                ASSERTV(i, oracle.erase(i) == mX.erase(i));
+            }
+            ASSERT(oracle.size() == X.size());
+            for (IdObj::const_iterator it = X.begin(); it != X.end(); ++it) {
+                ASSERTV(it->first, oracle[it->first] == it->second);
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'int' KEYS
+        //
+        // Concerns:
+        //: 1 'bdlc::FlatHashMap' is faster than 'bsl::unordered_map' for
+        //:   small keys and values.
+        //
+        // Plan:
+        //: 1 Time the insertion of 1M distinct 'int' keys, 5 rounds of
+        //:   lookups of each key and of as many missing keys, 5 iterations,
+        //:   and the erasure of the keys, with 'bsl::unordered_map' and
+        //:   'bdlc::FlatHashMap', each using 'bsl::hash' and 'bslh::Hash<>'.
+        //:   Optionally specify the number of keys as the second argument.
+        //
+        // Testing:
+        //   PERFORMANCE: 'int' KEYS
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: 'int' KEYS" << endl
+             << "=======================" << endl;
+
+        bslma::Default::setDefaultAllocatorRaw(
+                                     &bslma::NewDeleteAllocator::singleton());
+
+        const int NUM_KEYS = argc > 2 ? bsl::atoi(argv[2]) : 1000000;
+
+        bsl::vector<int> keys;
+        bsl::vector<int> missingKeys;
+
+        unsigned int seed = 1;
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            // Keys are distinct and scattered: multiplication by an odd
+            // constant is a bijection.
+
+            seed = static_cast<unsigned int>(i) * 2654435761u;
+            keys.push_back(static_cast<int>(seed & ~1u));
+            missingKeys.push_back(static_cast<int>(seed | 1u));
+        }
+
+        u::benchmark<bsl::unordered_map<int, int> >(
+                         "bsl::unordered_map<int, int>               ",
+                         keys, missingKeys, 5);
+        u::benchmark<bsl::unordered_map<int, int, bslh::Hash<> > >(
+                         "bsl::unordered_map<int, int, bslh::Hash<>> ",
+                         keys, missingKeys, 5);
+        u::benchmark<bdlc::FlatHashMap<int, int, bsl::hash<int> > >(
+                         "bdlc::FlatHashMap<int, int, bsl::hash<int>>",
+                         keys, missingKeys, 5);
+        u::benchmark<bdlc::FlatHashMap<int, int> >(
+                         "bdlc::FlatHashMap<int, int>                ",
+                         keys, missingKeys, 5);
+      } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'bsl::string' KEYS
+        //
+        // Concerns:
+        //: 1 'bdlc::FlatHashMap' is faster than 'bsl::unordered_map' for
+        //:   string keys.
+        //
+        // Plan:
+        //: 1 Time the insertion of 200K distinct string keys (of 10 to 30
+        //:   characters), 5 rounds of lookups of each key and of as many
+        //:   missing keys, 5 iterations, and the erasure of the keys, with
+        //:   'bsl::unordered_map' and 'bdlc::FlatHashMap', both using
+        //:   'bslh::Hash<>'.  Optionally specify the number of keys as the
+        //:   second argument.
+        //
+        // Testing:
+        //   PERFORMANCE: 'bsl::string' KEYS
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: 'bsl::string' KEYS" << endl
+             << "===============================" << endl;
+
+        bslma::Default::setDefaultAllocatorRaw(
+                                     &bslma::NewDeleteAllocator::singleton());
+
+        const int NUM_KEYS = argc > 2 ? bsl::atoi(argv[2]) : 200000;
+
+        bsl::vector<bsl::string> keys;
+        bsl::vector<bsl::string> missingKeys;
+
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            bsl::string key("key:");
+            key.append(static_cast<bsl::size_t>(i % 21), '_');
+            key += bsl::to_string(i);
+            keys.push_back(key);
+            missingKeys.push_back(key + "?");
+        }
+
+        u::benchmark<bsl::unordered_map<bsl::string, int, bslh::Hash<> > >(
+                         "bsl::unordered_map<string, int, bslh::Hash<>>",
+                         keys, missingKeys, 5);
+        u::benchmark<bdlc::FlatHashMap<bsl::string, int> >(
+                         "bdlc::FlatHashMap<string, int>               ",
+                         keys, missingKeys, 5);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,749 @@
+// bdlc_flathashset.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLC_FLATHASHSET
+#define INCLUDED_BDLC_FLATHASHSET
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an open-addressed unordered set container.
+//
+//@CLASSES:
+//  bdlc::FlatHashSet: open-addressed unordered set container
+//  bdlc::FlatHashSet_EntryUtil: entry access for the underlying table
+//
+//@SEE_ALSO: bdlc_flathashtable, bdlc_flathashmap, bslstl_unorderedset
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlc::FlatHashSet', implementing an unordered set of unique keys of
+// (template parameter) type 'KEY', whose interface is a subset of that of
+// 'bsl::unordered_set'.
+//
+// Unlike 'bsl::unordered_set', which allocates a node per element, a
+// 'bdlc::FlatHashSet' stores its elements inline in a single array of slots,
+// and probes 16 slots at a time using a parallel array of control bytes (see
+// 'bdlc_flathashtable').  As for 'bdlc::FlatHashMap', the price of this layout
+// is that elements are moved when the set is rehashed, so that the iterators,
+// pointers, and references to the elements of a 'bdlc::FlatHashSet' are
+// invalidated by any insertion (see {'bdlc_flathashtable'|Iterator, Pointer,
+// and Reference Invalidation}).
+//
+// The (template parameter) type 'HASH' defaults to 'bslh::Hash<>', and the
+// (template parameter) type 'EQUAL' defaults to 'bsl::equal_to<KEY>'.  A set
+// uses a 'bslma::Allocator' to supply memory, which is also passed to the
+// elements if they use one.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Removing Duplicates
+///- - - - - - - - - - - - - - -
+// Suppose we want to output the identifiers of a sequence of orders, skipping
+// the identifiers already seen.
+//
+// First, we create a set of the identifiers seen so far:
+//..
+//  bdlc::FlatHashSet<int> seen;
+//..
+// Then, we keep the identifiers that are inserted in the set, i.e., that were
+// not already in it:
+//..
+//  const int           ids[]   = { 12, 7, 12, 3, 7, 42 };
+//  const bsl::size_t   numIds  = sizeof ids / sizeof *ids;
+//  bsl::vector<int>    unique;
+//
+//  for (bsl::size_t i = 0; i < numIds; ++i) {
+//      if (seen.insert(ids[i]).second) {
+//          unique.push_back(ids[i]);
+//      }
+//  }
+//..
+// Finally, we verify the result:
+//..
+//  assert(4  == unique.size());
+//  assert(4  == seen.size());
+//  assert(42 == unique[3]);
+//  assert(seen.contains(3));
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLC_FLATHASHTABLE
+#include <bdlc_flathashtable.h>
+#endif
+
+#ifndef INCLUDED_BSLH_HASH
+#include <bslh_hash.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_CONSTRUCTIONUTIL
+#include <bslma_constructionutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_FUNCTIONAL
+#include <bsl_functional.h>
+#endif
+
+#ifndef INCLUDED_BSL_UTILITY
+#include <bsl_utility.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                        // ============================
+                        // struct FlatHashSet_EntryUtil
+                        // ============================
+
+template <class ENTRY>
+struct FlatHashSet_EntryUtil {
+    // This 'struct' provides the 'ENTRY_UTIL' operations required by
+    // 'FlatHashTable' for entries of (template parameter) type 'ENTRY' that
+    // are their own key.
+
+    // CLASS METHODS
+    static void constructFromKey(ENTRY            *entry,
+                                 bslma::Allocator *allocator,
+                                 const ENTRY&      key);
+        // Create, at the specified 'entry' address, a copy of the specified
+        // 'key', using the specified 'allocator' to supply memory.
+
+    static const ENTRY& key(const ENTRY& entry);
+        // Return the specified 'entry'.
+};
+
+                             // =================
+                             // class FlatHashSet
+                             // =================
+
+template <class KEY,
+          class HASH  = bslh::Hash<>,
+          class EQUAL = bsl::equal_to<KEY> >
+class FlatHashSet {
+    // This class template implements a value-semantic container of unique
+    // keys of (template parameter) type 'KEY', stored inline in an
+    // open-addressed hash table.
+
+    // PRIVATE TYPES
+    typedef FlatHashSet_EntryUtil<KEY>                       EntryUtil;
+    typedef FlatHashTable<KEY, KEY, EntryUtil, HASH, EQUAL>  ImplType;
+
+    // DATA
+    ImplType d_impl;  // underlying flat hash table
+
+    // FRIENDS
+    template <class K, class H, class E>
+    friend bool operator==(const FlatHashSet<K, H, E>&,
+                           const FlatHashSet<K, H, E>&);
+
+  public:
+    // TYPES
+    typedef KEY                                key_type;
+    typedef KEY                                value_type;
+    typedef bsl::size_t                        size_type;
+    typedef bsl::ptrdiff_t                     difference_type;
+    typedef HASH                               hasher;
+    typedef EQUAL                              key_equal;
+    typedef value_type&                        reference;
+    typedef const value_type&                  const_reference;
+    typedef value_type                        *pointer;
+    typedef const value_type                  *const_pointer;
+    typedef typename ImplType::const_iterator  iterator;
+    typedef typename ImplType::const_iterator  const_iterator;
+        // The elements of a set are not modifiable through its iterators.
+
+    // CREATORS
+    FlatHashSet();
+    explicit FlatHashSet(bslma::Allocator *basicAllocator);
+    explicit FlatHashSet(bsl::size_t capacity);
+    FlatHashSet(bsl::size_t capacity, bslma::Allocator *basicAllocator);
+    FlatHashSet(bsl::size_t       capacity,
+                const HASH&       hash,
+                bslma::Allocator *basicAllocator = 0);
+    FlatHashSet(bsl::size_t       capacity,
+                const HASH&       hash,
+                const EQUAL&      equal,
+                bslma::Allocator *basicAllocator = 0);
+        // Create an empty set.  Optionally specify a 'capacity', the minimum
+        // number of slots of the set; if 'capacity' is not specified, or is
+        // 0, no memory is allocated until the first insertion.  Optionally
+        // specify a 'hash' functor used to hash keys; if 'hash' is not
+        // specified, a default-constructed 'HASH' is used.  Optionally
+        // specify an 'equal' functor used to compare keys; if 'equal' is not
+        // specified, a default-constructed 'EQUAL' is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.
+
+    template <class INPUT_ITERATOR>
+    FlatHashSet(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a set holding the keys in the specified range
+        // '[first, last)', ignoring the keys equivalent to a previous key of
+        // the range.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless 'first' and
+        // 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last'.
+
+    FlatHashSet(const FlatHashSet&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a set having the same value, hash and equality functors as
+        // the specified 'original' set.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    //! ~FlatHashSet() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    FlatHashSet& operator=(const FlatHashSet& rhs);
+        // Assign to this object the value, hash and equality functors of the
+        // specified 'rhs' object, and return a reference providing modifiable
+        // access to this object.
+
+    void clear();
+        // Remove all elements from this set.  Note that the capacity of this
+        // set is unchanged.
+
+    bsl::size_t erase(const KEY& key);
+        // Remove the element equivalent to the specified 'key', if any, and
+        // return the number of elements removed (0 or 1).
+
+    iterator erase(const_iterator position);
+        // Remove the element at the specified 'position', and return an
+        // iterator referring to the element following it, or 'end()' if
+        // there is no such element.  The behavior is undefined unless
+        // 'position' refers to an element of this set.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove the elements in the specified range '[first, last)', and
+        // return 'last'.  The behavior is undefined unless 'first' and 'last'
+        // refer to elements of this set (or 'end()'), and 'first' is at a
+        // position at or before 'last'.
+
+    bsl::pair<iterator, bool> insert(const KEY& key);
+        // Insert a copy of the specified 'key' if this set has no element
+        // equivalent to 'key'.  Return a pair whose first member is an
+        // iterator referring to the element of this set equivalent to 'key',
+        // and whose second member is 'true' if 'key' was inserted, and
+        // 'false' otherwise.  Note that all iterators to the elements of this
+        // set are invalidated if the set is rehashed.
+
+    template <class INPUT_ITERATOR>
+    void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Insert a copy of each key in the specified range '[first, last)'
+        // that is not equivalent to an element of this set.  The behavior is
+        // undefined unless 'first' and 'last' refer to a sequence of valid
+        // values where 'first' is at a position at or before 'last'.
+
+    void rehash(bsl::size_t minimumCapacity);
+        // Change the capacity of this set to the smallest power of two (not
+        // less than 16) that is not less than the specified 'minimumCapacity'
+        // and can hold 'size()' elements, and rehash the elements.
+
+    void reserve(bsl::size_t numEntries);
+        // Grow this set, if needed, so that it can hold the specified
+        // 'numEntries' elements without being rehashed.
+
+    void reset();
+        // Remove all elements from this set, and release all memory allocated
+        // by this set.
+
+                                  // Aspects
+
+    void swap(FlatHashSet& other);
+        // Exchange the value, capacity, hash and equality functors of this
+        // object with those of the specified 'other' object.  This method
+        // provides the no-throw exception-safety guarantee.  The behavior is
+        // undefined unless this object was created with the same allocator as
+        // 'other'.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the number of slots of this set.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this set has an element equivalent to the
+        // specified 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of elements of this set equivalent to the
+        // specified 'key' (0 or 1).
+
+    bool empty() const;
+        // Return 'true' if this set has no element, and 'false' otherwise.
+
+    bsl::pair<const_iterator, const_iterator> equal_range(
+                                                         const KEY& key) const;
+        // Return a pair of iterators delimiting the sequence of elements of
+        // this set equivalent to the specified 'key' (holding at most one
+        // element).
+
+    const_iterator find(const KEY& key) const;
+        // Return an iterator referring to the element equivalent to the
+        // specified 'key', or 'end()' if there is no such element.
+
+    HASH hash_function() const;
+        // Return (a copy of) the hash functor of this set.
+
+    EQUAL key_eq() const;
+        // Return (a copy of) the key-equivalence functor of this set.
+
+    float load_factor() const;
+        // Return the ratio of the number of elements to the number of slots
+        // of this set, or 0 if this set has no slot.
+
+    float max_load_factor() const;
+        // Return the maximum ratio of the number of slots holding an element,
+        // or having held an erased element, to the number of slots of this
+        // set, beyond which the set is rehashed.
+
+    bsl::size_t size() const;
+        // Return the number of elements of this set.
+
+                             // Iterators
+
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+        // Return an iterator referring to the first element of this set, or
+        // 'end()' if this set is empty.
+
+    const_iterator end() const;
+    const_iterator cend() const;
+        // Return the past-the-end iterator of this set.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this set to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class HASH, class EQUAL>
+bool operator==(const FlatHashSet<KEY, HASH, EQUAL>& lhs,
+                const FlatHashSet<KEY, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' sets have the same value,
+    // and 'false' otherwise.  Two sets have the same value if they have the
+    // same number of elements, and for each element of 'lhs', 'rhs' has an
+    // equivalent element that compares equal to it.
+
+template <class KEY, class HASH, class EQUAL>
+bool operator!=(const FlatHashSet<KEY, HASH, EQUAL>& lhs,
+                const FlatHashSet<KEY, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' sets do not have the same
+    // value, and 'false' otherwise.  Two sets do not have the same value if
+    // they do not have the same number of elements, or if for some element of
+    // 'lhs', 'rhs' has no equivalent element that compares equal to it.
+
+// FREE FUNCTIONS
+template <class KEY, class HASH, class EQUAL>
+void swap(FlatHashSet<KEY, HASH, EQUAL>& a, FlatHashSet<KEY, HASH, EQUAL>& b);
+    // Exchange the values of the specified 'a' and 'b' sets.  The behavior is
+    // undefined unless both sets were created with the same allocator.
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                        // ----------------------------
+                        // struct FlatHashSet_EntryUtil
+                        // ----------------------------
+
+// CLASS METHODS
+template <class ENTRY>
+inline
+void FlatHashSet_EntryUtil<ENTRY>::constructFromKey(
+                                                  ENTRY            *entry,
+                                                  bslma::Allocator *allocator,
+                                                  const ENTRY&      key)
+{
+    BSLS_ASSERT_SAFE(entry);
+
+    bslma::ConstructionUtil::construct(entry, allocator, key);
+}
+
+template <class ENTRY>
+inline
+const ENTRY& FlatHashSet_EntryUtil<ENTRY>::key(const ENTRY& entry)
+{
+    return entry;
+}
+
+                             // -----------------
+                             // class FlatHashSet
+                             // -----------------
+
+// CREATORS
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet()
+: d_impl(0, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t capacity)
+: d_impl(capacity, HASH(), EQUAL())
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t       capacity,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, HASH(), EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t       capacity,
+                                           const HASH&       hash,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, EQUAL(), basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(bsl::size_t       capacity,
+                                           const HASH&       hash,
+                                           const EQUAL&      equal,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(capacity, hash, equal, basicAllocator)
+{
+}
+
+template <class KEY, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(INPUT_ITERATOR    first,
+                                           INPUT_ITERATOR    last,
+                                           bslma::Allocator *basicAllocator)
+: d_impl(0, HASH(), EQUAL(), basicAllocator)
+{
+    insert(first, last);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>::FlatHashSet(
+                                         const FlatHashSet&  original,
+                                         bslma::Allocator   *basicAllocator)
+: d_impl(original.d_impl, basicAllocator)
+{
+}
+
+// MANIPULATORS
+template <class KEY, class HASH, class EQUAL>
+inline
+FlatHashSet<KEY, HASH, EQUAL>&
+FlatHashSet<KEY, HASH, EQUAL>::operator=(const FlatHashSet& rhs)
+{
+    d_impl = rhs.d_impl;
+    return *this;
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::clear()
+{
+    d_impl.clear();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::erase(const KEY& key)
+{
+    return d_impl.erase(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::iterator
+FlatHashSet<KEY, HASH, EQUAL>::erase(const_iterator position)
+{
+    return d_impl.erase(position);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::iterator
+FlatHashSet<KEY, HASH, EQUAL>::erase(const_iterator first,
+                                     const_iterator last)
+{
+    // Erasing an entry does not move the other entries, so that 'last'
+    // remains valid.
+
+    while (first != last) {
+        first = d_impl.erase(first);
+    }
+    return last;
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashSet<KEY, HASH, EQUAL>::iterator, bool>
+FlatHashSet<KEY, HASH, EQUAL>::insert(const KEY& key)
+{
+    const bsl::pair<typename ImplType::iterator, bool> result =
+                                                          d_impl.insert(key);
+    return bsl::pair<iterator, bool>(result.first, result.second);
+}
+
+template <class KEY, class HASH, class EQUAL>
+template <class INPUT_ITERATOR>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::insert(INPUT_ITERATOR first,
+                                           INPUT_ITERATOR last)
+{
+    for (; first != last; ++first) {
+        d_impl.insert(*first);
+    }
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::rehash(bsl::size_t minimumCapacity)
+{
+    d_impl.rehash(minimumCapacity);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::reserve(bsl::size_t numEntries)
+{
+    d_impl.reserve(numEntries);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::reset()
+{
+    d_impl.reset();
+}
+
+                                  // Aspects
+
+template <class KEY, class HASH, class EQUAL>
+inline
+void FlatHashSet<KEY, HASH, EQUAL>::swap(FlatHashSet& other)
+{
+    d_impl.swap(other.d_impl);
+}
+
+// ACCESSORS
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::capacity() const
+{
+    return d_impl.capacity();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bool FlatHashSet<KEY, HASH, EQUAL>::contains(const KEY& key) const
+{
+    return d_impl.contains(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::count(const KEY& key) const
+{
+    return d_impl.count(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bool FlatHashSet<KEY, HASH, EQUAL>::empty() const
+{
+    return d_impl.empty();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::pair<typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator,
+          typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator>
+FlatHashSet<KEY, HASH, EQUAL>::equal_range(const KEY& key) const
+{
+    const_iterator it = d_impl.find(key);
+    if (it == d_impl.end()) {
+        return bsl::pair<const_iterator, const_iterator>(it, it);     // RETURN
+    }
+    const_iterator next = it;
+    ++next;
+    return bsl::pair<const_iterator, const_iterator>(it, next);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::find(const KEY& key) const
+{
+    return d_impl.find(key);
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+HASH FlatHashSet<KEY, HASH, EQUAL>::hash_function() const
+{
+    return d_impl.hash_function();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+EQUAL FlatHashSet<KEY, HASH, EQUAL>::key_eq() const
+{
+    return d_impl.key_eq();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+float FlatHashSet<KEY, HASH, EQUAL>::load_factor() const
+{
+    return d_impl.load_factor();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+float FlatHashSet<KEY, HASH, EQUAL>::max_load_factor() const
+{
+    return d_impl.max_load_factor();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashSet<KEY, HASH, EQUAL>::size() const
+{
+    return d_impl.size();
+}
+
+                             // Iterators
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::begin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::cbegin() const
+{
+    return d_impl.begin();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::end() const
+{
+    return d_impl.end();
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+typename FlatHashSet<KEY, HASH, EQUAL>::const_iterator
+FlatHashSet<KEY, HASH, EQUAL>::cend() const
+{
+    return d_impl.end();
+}
+
+                                  // Aspects
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bslma::Allocator *FlatHashSet<KEY, HASH, EQUAL>::allocator() const
+{
+    return d_impl.allocator();
+}
+
+// FREE OPERATORS
+template <class KEY, class HASH, class EQUAL>
+inline
+bool operator==(const FlatHashSet<KEY, HASH, EQUAL>& lhs,
+                const FlatHashSet<KEY, HASH, EQUAL>& rhs)
+{
+    return lhs.d_impl == rhs.d_impl;
+}
+
+template <class KEY, class HASH, class EQUAL>
+inline
+bool operator!=(const FlatHashSet<KEY, HASH, EQUAL>& lhs,
+                const FlatHashSet<KEY, HASH, EQUAL>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class HASH, class EQUAL>
+inline
+void swap(FlatHashSet<KEY, HASH, EQUAL>& a, FlatHashSet<KEY, HASH, EQUAL>& b)
+{
+    a.swap(b);
+}
+
+}  // close package namespace
+
+// TRAITS
+
+namespace bslma {
+
+template <class KEY, class HASH, class EQUAL>
+struct UsesBslmaAllocator<bdlc::FlatHashSet<KEY, HASH, EQUAL> >
+                                                           : bsl::true_type {};
+
+}  // close namespace bslma
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,612 @@
+// bdlc_flathashset.t.cpp                                             -*-C++-*-
+#include <bdlc_flathashset.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_unordered_set.h>
+#include <bsl_utility.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test implements an unordered set on top of
+// 'bdlc::FlatHashTable', which is tested thoroughly in its own test driver.
+// This test driver verifies that each method forwards to the table as
+// documented, and the propagation of the allocator to the elements.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] FlatHashSet();
+// [ 2] explicit FlatHashSet(bslma::Allocator *basicAllocator);
+// [ 2] explicit FlatHashSet(bsl::size_t capacity);
+// [ 2] FlatHashSet(bsl::size_t capacity, bslma::Allocator *basicAllocator);
+// [ 2] FlatHashSet(capacity, hash, basicAllocator);
+// [ 2] FlatHashSet(capacity, hash, equal, basicAllocator);
+// [ 2] FlatHashSet(INPUT_ITERATOR first, last, basicAllocator);
+// [ 4] FlatHashSet(const FlatHashSet& original, basicAllocator);
+//
+// MANIPULATORS
+// [ 4] FlatHashSet& operator=(const FlatHashSet& rhs);
+// [ 3] void clear();
+// [ 3] bsl::size_t erase(const KEY& key);
+// [ 3] iterator erase(const_iterator position);
+// [ 3] iterator erase(const_iterator first, const_iterator last);
+// [ 3] bsl::pair<iterator, bool> insert(const KEY& key);
+// [ 3] void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+// [ 3] void rehash(bsl::size_t minimumCapacity);
+// [ 3] void reserve(bsl::size_t numEntries);
+// [ 3] void reset();
+// [ 4] void swap(FlatHashSet& other);
+//
+// ACCESSORS
+// [ 2] bsl::size_t capacity() const;
+// [ 3] bool contains(const KEY& key) const;
+// [ 3] bsl::size_t count(const KEY& key) const;
+// [ 2] bool empty() const;
+// [ 3] bsl::pair<cIter, cIter> equal_range(const KEY& key) const;
+// [ 3] const_iterator find(const KEY& key) const;
+// [ 2] HASH hash_function() const;
+// [ 2] EQUAL key_eq() const;
+// [ 2] float load_factor() const;
+// [ 2] float max_load_factor() const;
+// [ 2] bsl::size_t size() const;
+// [ 3] const_iterator begin() const;
+// [ 3] const_iterator cbegin() const;
+// [ 3] const_iterator end() const;
+// [ 3] const_iterator cend() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 4] bool operator==(lhs, rhs);
+// [ 4] bool operator!=(lhs, rhs);
+// [ 4] void swap(FlatHashSet& a, FlatHashSet& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+// [ 3] CONCERN: The allocator is propagated to the elements.
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+#define ASSERT_OPT_FAIL_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL_RAW(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::FlatHashSet<int>         Obj;
+typedef bdlc::FlatHashSet<bsl::string> StringObj;
+
+// Define 'bsl::string' value long enough to ensure dynamic memory allocation.
+#define SUFFICIENTLY_LONG_STRING "1234567890123456789012345678901234567890" \
+                                 "1234567890123456789012345678901234567890"
+
+const char *const LONG_STRING = "a_" SUFFICIENTLY_LONG_STRING;
+
+struct ModuloHash {
+    // This 'struct' provides a hash functor of 'int' keys making every tenth
+    // key collide.
+
+    bsl::size_t operator()(int key) const
+        // Return the hash value of the specified 'key'.
+    {
+        return static_cast<bsl::size_t>(key % 10);
+    }
+};
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                test = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    int             verbose = argc > 2;
+    int         veryVerbose = argc > 3;
+    int     veryVeryVerbose = argc > 4;
+    int veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Removing Duplicates
+///- - - - - - - - - - - - - - -
+// Suppose we want to output the identifiers of a sequence of orders, skipping
+// the identifiers already seen.
+//
+// First, we create a set of the identifiers seen so far:
+//..
+    bdlc::FlatHashSet<int> seen;
+//..
+// Then, we keep the identifiers that are inserted in the set, i.e., that were
+// not already in it:
+//..
+    const int           ids[]   = { 12, 7, 12, 3, 7, 42 };
+    const bsl::size_t   numIds  = sizeof ids / sizeof *ids;
+    bsl::vector<int>    unique;
+
+    for (bsl::size_t i = 0; i < numIds; ++i) {
+        if (seen.insert(ids[i]).second) {
+            unique.push_back(ids[i]);
+        }
+    }
+//..
+// Finally, we verify the result:
+//..
+    ASSERT(4  == unique.size());
+    ASSERT(4  == seen.size());
+    ASSERT(42 == unique[3]);
+    ASSERT(seen.contains(3));
+//..
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // COPY, ASSIGNMENT, EQUALITY, AND SWAP
+        //
+        // Concerns:
+        //: 1 A copy has the same value as the original, and uses the supplied
+        //:   allocator.
+        //:
+        //: 2 Assignment gives the same value, and is alias-safe.
+        //:
+        //: 3 Sets compare equal if and only if they have the same elements.
+        //:
+        //: 4 'swap' exchanges the values of the sets.
+        //
+        // Plan:
+        //: 1 Copy, assign, compare, and swap sets of various values.  (C-1..4)
+        //
+        // Testing:
+        //   FlatHashSet(const FlatHashSet& original, basicAllocator);
+        //   FlatHashSet& operator=(const FlatHashSet& rhs);
+        //   void swap(FlatHashSet& other);
+        //   bool operator==(lhs, rhs);
+        //   bool operator!=(lhs, rhs);
+        //   void swap(FlatHashSet& a, FlatHashSet& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY, ASSIGNMENT, EQUALITY, AND SWAP" << endl
+                          << "====================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        bslma::TestAllocator oa("other",    veryVeryVeryVerbose);
+
+        for (int n = 0; n < 100; n += 9) {
+            Obj mX(&sa);  const Obj& X = mX;
+            for (int i = 0; i < n; ++i) {
+                mX.insert(i * 3);
+            }
+
+            Obj mY(X, &oa);  const Obj& Y = mY;
+            ASSERTV(n, X == Y);
+            ASSERTV(n, !(X != Y));
+            ASSERTV(n, &oa == Y.allocator());
+
+            mY.insert(-1);
+            ASSERTV(n, X != Y);
+            mY.erase(-1);
+            ASSERTV(n, X == Y);
+
+            Obj mZ(&sa);  const Obj& Z = mZ;
+            mZ.insert(-1);
+            mZ = X;
+            ASSERTV(n, X == Z);
+            ASSERTV(n, &sa == Z.allocator());
+
+            mZ = Z;
+            ASSERTV(n, X == Z);
+
+            mZ.insert(-1);
+            mZ.swap(mX);
+            ASSERTV(n, 1 + n == static_cast<int>(X.size()));
+            ASSERTV(n, X.contains(-1));
+
+            swap(mX, mZ);
+            ASSERTV(n, n == static_cast<int>(X.size()));
+            ASSERTV(n, !X.contains(-1));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // MANIPULATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 'insert', 'erase', 'find', 'count', 'contains', and
+        //:   'equal_range' behave as for 'bsl::unordered_set'.
+        //:
+        //: 2 Iteration visits each element once.
+        //:
+        //: 3 'rehash', 'reserve', 'clear', and 'reset' affect the capacity as
+        //:   documented.
+        //:
+        //: 4 The allocator of the set is propagated to the elements, and no
+        //:   memory is allocated from the default allocator.
+        //
+        // Plan:
+        //: 1 Apply the operations to sets of 'bsl::string', and compare the
+        //:   results to those of 'bsl::unordered_set'.  (C-1..4)
+        //
+        // Testing:
+        //   void clear();
+        //   bsl::size_t erase(const KEY& key);
+        //   iterator erase(const_iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        //   bsl::pair<iterator, bool> insert(const KEY& key);
+        //   void insert(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        //   void rehash(bsl::size_t minimumCapacity);
+        //   void reserve(bsl::size_t numEntries);
+        //   void reset();
+        //   bool contains(const KEY& key) const;
+        //   bsl::size_t count(const KEY& key) const;
+        //   bsl::pair<cIter, cIter> equal_range(const KEY& key) const;
+        //   const_iterator find(const KEY& key) const;
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   const_iterator end() const;
+        //   const_iterator cend() const;
+        //   CONCERN: The allocator is propagated to the elements.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MANIPULATORS AND ACCESSORS" << endl
+                          << "==========================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        bslma::TestAllocator xa("scratch",  veryVeryVeryVerbose);
+
+        bsl::vector<bsl::string> keys(&xa);
+        for (int i = 0; i < 500; ++i) {
+            char buffer[16];
+            bsl::sprintf(buffer, "%d", i);
+
+            bsl::string key(LONG_STRING, &xa);
+            key += buffer;
+            keys.push_back(key);
+        }
+
+        {
+            StringObj                     mX(&sa);  const StringObj& X = mX;
+            bsl::unordered_set<bsl::string> oracle(&xa);
+
+            for (bsl::size_t i = 0; i < keys.size(); i += 2) {
+                const bsl::pair<StringObj::iterator, bool> RESULT =
+                                                           mX.insert(keys[i]);
+                ASSERTV(i, true    == RESULT.second);
+                ASSERTV(i, keys[i] == *RESULT.first);
+                ASSERTV(i, false   == mX.insert(keys[i]).second);
+                oracle.insert(keys[i]);
+            }
+            ASSERT(oracle.size() == X.size());
+
+            for (bsl::size_t i = 0; i < keys.size(); ++i) {
+                const bool EXP = 0 == i % 2;
+                ASSERTV(i, EXP == X.contains(keys[i]));
+                ASSERTV(i, EXP == static_cast<bool>(X.count(keys[i])));
+                ASSERTV(i, EXP == (X.find(keys[i]) != X.end()));
+
+                const bsl::pair<StringObj::const_iterator,
+                                StringObj::const_iterator> R =
+                                                     X.equal_range(keys[i]);
+                ASSERTV(i, EXP == (R.first != R.second));
+                if (EXP) {
+                    ASSERTV(i, keys[i] == *R.first);
+                }
+            }
+
+            bsl::size_t count = 0;
+            for (StringObj::const_iterator it = X.cbegin(); it != X.cend();
+                                                                        ++it) {
+                ASSERT(1 == oracle.count(*it));
+                ++count;
+            }
+            ASSERT(oracle.size() == count);
+
+            const bsl::size_t CAPACITY = X.capacity();
+            mX.reserve(4 * X.size());
+            ASSERT(CAPACITY < X.capacity());
+            mX.rehash(0);
+            ASSERT(CAPACITY == X.capacity());
+            ASSERT(oracle.size() == X.size());
+
+            StringObj mY(oracle.begin(), oracle.end(), &sa);
+            ASSERT(X == mY);
+            mY.insert(keys.begin(), keys.end());
+            ASSERT(keys.size() == mY.size());
+
+            ASSERT(1 == mY.erase(keys[1]));
+            ASSERT(0 == mY.erase(keys[1]));
+
+            StringObj::const_iterator first = mY.begin();
+            ++first;
+            ASSERT(mY.end() == mY.erase(first, mY.cend()));
+            ASSERT(1 == mY.size());
+            ASSERT(mY.end() == mY.erase(mY.begin()));
+            ASSERT(mY.empty());
+
+            mX.clear();
+            ASSERT(X.empty());
+            ASSERT(CAPACITY == X.capacity());
+
+            mX.reset();
+            ASSERT(0 == X.capacity());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates an empty set having the specified
+        //:   capacity, functors, and allocator, or the defaults.
+        //:
+        //: 2 The range constructor inserts the keys of the range, ignoring
+        //:   duplicates.
+        //
+        // Plan:
+        //: 1 Create sets with each constructor and verify the accessors.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   FlatHashSet();
+        //   explicit FlatHashSet(bslma::Allocator *basicAllocator);
+        //   explicit FlatHashSet(bsl::size_t capacity);
+        //   FlatHashSet(bsl::size_t capacity, bslma::Allocator *bA);
+        //   FlatHashSet(capacity, hash, basicAllocator);
+        //   FlatHashSet(capacity, hash, equal, basicAllocator);
+        //   FlatHashSet(INPUT_ITERATOR first, last, basicAllocator);
+        //   bsl::size_t capacity() const;
+        //   bool empty() const;
+        //   HASH hash_function() const;
+        //   EQUAL key_eq() const;
+        //   float load_factor() const;
+        //   float max_load_factor() const;
+        //   bsl::size_t size() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTORS AND BASIC ACCESSORS" << endl
+                          << "================================" << endl;
+
+        typedef bdlc::FlatHashSet<int, ModuloHash> ModObj;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        {
+            const Obj X;
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(0 == X.size());
+            ASSERT(true == X.empty());
+            ASSERT(0.0f == X.load_factor());
+            ASSERT(0.875f == X.max_load_factor());
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+        }
+        {
+            const Obj X(&sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(0 == X.capacity());
+            ASSERT(0 == sa.numBlocksTotal());
+        }
+        {
+            const Obj X(100);
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(128 == X.capacity());
+        }
+        {
+            const Obj X(20, &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(32 == X.capacity());
+            ASSERT(1 == sa.numBlocksInUse());
+        }
+        {
+            const ModObj X(16, ModuloHash(), &sa);
+            ASSERT(16 == X.capacity());
+            ASSERT(7 == X.hash_function()(17));
+        }
+        {
+            const ModObj X(0, ModuloHash(), bsl::equal_to<int>(), &sa);
+            ASSERT(0 == X.capacity());
+            ASSERT(true == X.key_eq()(3, 3));
+        }
+        {
+            const int DATA[] = { 1, 2, 1, 3, 11, 21, 2 };
+
+            const ModObj X(DATA, DATA + 7, &sa);
+            ASSERT(&sa == X.allocator());
+            ASSERT(5 == X.size());
+            ASSERT(X.contains(21));
+            ASSERT(!X.contains(31));
+            ASSERT(5.0f / 16 == X.load_factor());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Insert, look up, and erase keys, and compare to
+        //:   'bsl::unordered_set'.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        {
+            Obj                     mX(&sa);  const Obj& X = mX;
+            bsl::unordered_set<int> oracle(&sa);
+
+            for (int i = 0; i < 10000; ++i) {
+                const int key = (i * 7919) % 5003;
+                ASSERTV(i, oracle.insert(key).second == mX.insert(key).second);
+            }
+            ASSERT(oracle.size() == X.size());
+            for (int i = -10; i < 6000; ++i) {
+                ASSERTV(i, oracle.count(i) == X.count(i));
+            }
+            for (int i = 0; i < 5003; i += 3) {
+                ASSERTV(i, oracle.erase(i) == mX.erase(i));
+            }
+            ASSERT(oracle.size() == X.size());
+            for (Obj::const_iterator it = X.begin(); it != X.end(); ++it) {
+                ASSERTV(*it, 1 == oracle.count(*it));
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
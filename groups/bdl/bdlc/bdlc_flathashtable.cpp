@@ -0,0 +1,78 @@
+// bdlc_flathashtable.cpp                                             -*-C++-*-
+#include <bdlc_flathashtable.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlc_flathashtable_cpp,"$Id$ $CSID$")
+
+namespace BloombergLP {
+namespace bdlc {
+
+                       // -----------------------------
+                       // struct FlatHashTable_ImplUtil
+                       // -----------------------------
+
+// CLASS DATA
+const bsl::uint8_t
+FlatHashTable_ImplUtil::s_emptyGroup[FlatHashTable_GroupControl::k_SIZE] = {
+    FlatHashTable_GroupControl::k_EMPTY, FlatHashTable_GroupControl::k_EMPTY,
+    FlatHashTable_GroupControl::k_EMPTY, FlatHashTable_GroupControl::k_EMPTY,
+    FlatHashTable_GroupControl::k_EMPTY, FlatHashTable_GroupControl::k_EMPTY,
+    FlatHashTable_GroupControl::k_EMPTY, FlatHashTable_GroupControl::k_EMPTY,
+    FlatHashTable_GroupControl::k_EMPTY, FlatHashTable_GroupControl::k_EMPTY,
+    FlatHashTable_GroupControl::k_EMPTY, FlatHashTable_GroupControl::k_EMPTY,
+    FlatHashTable_GroupControl::k_EMPTY, FlatHashTable_GroupControl::k_EMPTY,
+    FlatHashTable_GroupControl::k_EMPTY, FlatHashTable_GroupControl::k_EMPTY
+};
+
+// CLASS METHODS
+bsl::size_t FlatHashTable_ImplUtil::growthLimit(bsl::size_t capacity)
+{
+    // The maximum load factor is 7/8.
+
+    return capacity - capacity / 8;
+}
+
+bsl::size_t FlatHashTable_ImplUtil::minimalCapacity(bsl::size_t numEntries)
+{
+    if (0 == numEntries) {
+        return 0;                                                     // RETURN
+    }
+
+    bsl::size_t capacity = FlatHashTable_GroupControl::k_SIZE;
+    while (growthLimit(capacity) < numEntries) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+bsl::size_t FlatHashTable_ImplUtil::roundUpCapacity(bsl::size_t capacity)
+{
+    if (0 == capacity) {
+        return 0;                                                     // RETURN
+    }
+
+    bsl::size_t result = FlatHashTable_GroupControl::k_SIZE;
+    while (result < capacity) {
+        result *= 2;
+    }
+    return result;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
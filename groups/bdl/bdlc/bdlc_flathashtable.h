@@ -0,0 +1,1243 @@
+// bdlc_flathashtable.h                                               -*-C++-*-
+#ifndef INCLUDED_BDLC_FLATHASHTABLE
+#define INCLUDED_BDLC_FLATHASHTABLE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an open-addressed hash table storing entries inline.
+//
+//@CLASSES:
+//  bdlc::FlatHashTable: open-addressed hash table of inline entries
+//  bdlc::FlatHashTable_ImplUtil: non-templated utilities of the table
+//  bdlc::FlatHashTable_IteratorImp: forward iterator implementation
+//
+//@SEE_ALSO: bdlc_flathashmap, bdlc_flathashset, bslstl_hashtable
+//
+//@DESCRIPTION: This component provides a value-semantic class template,
+// 'bdlc::FlatHashTable', implementing an open-addressed hash table that
+// stores its entries of (template parameter) type 'ENTRY' inline, in a single
+// array, rather than in individually allocated nodes.  This table is the
+// implementation of 'bdlc::FlatHashMap' and 'bdlc::FlatHashSet', and is not
+// intended to be used directly.
+//
+// 'bslstl::HashTable' (the implementation of 'bsl::unordered_map' and
+// 'bsl::unordered_set') allocates one node per element and links all nodes in
+// a list, so that a lookup dereferences a bucket, then one node per probed
+// element, and an iteration follows the list through nodes scattered in
+// memory.  A 'bdlc::FlatHashTable' instead has a power-of-two number of
+// *slots*, each holding either nothing or one entry, and a parallel array of
+// one *control* *byte* per slot recording whether the slot is empty, was
+// erased, or is in use, and, in the latter case, 7 bits of the hash value of
+// the key of its entry.  The slots are divided in *groups* of 16 consecutive
+// slots, whose control bytes are examined all at once (using SSE2
+// instructions where available, see 'bdlc_flathashtable_groupcontrol'), so
+// that a lookup typically loads a single group of control bytes and compares
+// a single key, and an iteration scans the control bytes sequentially.
+//
+// The group in which the search for a key starts is determined by the hash
+// value of the key (scrambled, so that hash functors with poor high bits,
+// such as the identity, are usable); groups are then probed quadratically
+// until a slot whose key is equivalent to the key is found, or a group having
+// an empty slot is reached.  The table is grown, doubling the number of slots,
+// when inserting an entry would make the number of entries, and of slots of
+// erased entries, exceed seven eighths of the number of slots.
+//
+// The template parameter 'ENTRY_UTIL' provides the table with access to the
+// key of an entry, and the construction of an entry from a key, through the
+// following static member functions:
+//..
+//  static const KEY& key(const ENTRY& entry);
+//      // Return the key of the specified 'entry'.
+//
+//  static void constructFromKey(ENTRY            *entry,
+//                               bslma::Allocator *allocator,
+//                               const KEY&        key);
+//      // Create, at the specified 'entry' address, an entry whose key is the
+//      // specified 'key', using the specified 'allocator' to supply memory.
+//..
+//
+///Iterator, Pointer, and Reference Invalidation
+///---------------------------------------------
+// Unlike those of 'bsl::unordered_map', the entries of a flat hash table are
+// moved when the table is rehashed: any insertion may invalidate all
+// iterators, pointers, and references to the entries of the table.  Erasing
+// an entry invalidates only the iterators, pointers, and references to that
+// entry.
+//
+///Usage
+///-----
+// See 'bdlc_flathashmap' and 'bdlc_flathashset' for examples of use of the
+// containers implemented by this component.
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLC_FLATHASHTABLE_GROUPCONTROL
+#include <bdlc_flathashtable_groupcontrol.h>
+#endif
+
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SWAPUTIL
+#include <bslalg_swaputil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_CONSTRUCTIONUTIL
+#include <bslma_constructionutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DESTRUCTIONUTIL
+#include <bslma_destructionutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_FORWARDITERATOR
+#include <bslstl_forwarditerator.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDINT
+#include <bsl_cstdint.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTRING
+#include <bsl_cstring.h>
+#endif
+
+#ifndef INCLUDED_BSL_UTILITY
+#include <bsl_utility.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                       // =============================
+                       // struct FlatHashTable_ImplUtil
+                       // =============================
+
+struct FlatHashTable_ImplUtil {
+    // This 'struct' provides a namespace for the non-templated utilities and
+    // data of 'FlatHashTable'.
+
+    // CLASS DATA
+    static const bsl::uint8_t s_emptyGroup[FlatHashTable_GroupControl::k_SIZE];
+                                     // control bytes of the (single) group of
+                                     // a table having no slots
+
+    // CLASS METHODS
+    static bsl::size_t growthLimit(bsl::size_t capacity);
+        // Return the maximum number of slots holding an entry or having held
+        // an erased entry in a table having the specified 'capacity' slots.
+
+    static bsl::size_t minimalCapacity(bsl::size_t numEntries);
+        // Return the minimal capacity of a table holding the specified
+        // 'numEntries' entries, i.e., 0 if '0 == numEntries', and the smallest
+        // power of two not less than 'FlatHashTable_GroupControl::k_SIZE'
+        // whose 'growthLimit' is not less than 'numEntries' otherwise.
+
+    static bsl::size_t roundUpCapacity(bsl::size_t capacity);
+        // Return 0 if the specified 'capacity' is 0, and the smallest power of
+        // two not less than 'capacity' and
+        // 'FlatHashTable_GroupControl::k_SIZE' otherwise.
+};
+
+                     // ===============================
+                     // class FlatHashTable_IteratorImp
+                     // ===============================
+
+template <class ENTRY>
+class FlatHashTable_IteratorImp {
+    // This class implements the requirements of the 'ITER_IMP' template
+    // parameter of 'bslstl::ForwardIterator', iterating over the slots in use
+    // of a 'FlatHashTable'.
+
+    // DATA
+    ENTRY              *d_entry_p;       // current slot
+    const bsl::uint8_t *d_control_p;     // control byte of the current slot
+    const bsl::uint8_t *d_controlEnd_p;  // end of the control bytes
+
+  public:
+    // CREATORS
+    FlatHashTable_IteratorImp();
+        // Create an iterator implementation that does not refer to any table.
+
+    FlatHashTable_IteratorImp(ENTRY              *entry,
+                              const bsl::uint8_t *control,
+                              const bsl::uint8_t *controlEnd);
+        // Create an iterator implementation referring to the specified
+        // 'entry', whose control byte is at the specified 'control' address,
+        // of a table whose control bytes end at the specified 'controlEnd'
+        // address.  The behavior is undefined unless 'entry' is in use, or
+        // 'control == controlEnd' (denoting the past-the-end position).
+
+    //! FlatHashTable_IteratorImp(const FlatHashTable_IteratorImp&) = default;
+    //! ~FlatHashTable_IteratorImp() = default;
+
+    // MANIPULATORS
+    //! FlatHashTable_IteratorImp& operator=(
+    //!                           const FlatHashTable_IteratorImp&) = default;
+
+    void operator++();
+        // Advance this iterator to the next slot in use, or to the
+        // past-the-end position if there is no such slot.  The behavior is
+        // undefined if this iterator is at the past-the-end position.
+
+    // ACCESSORS
+    ENTRY& operator*() const;
+        // Return a reference to the entry of the current slot.  The behavior
+        // is undefined if this iterator is at the past-the-end position.
+
+    ENTRY *entry() const;
+        // Return the address of the current slot.
+};
+
+// FREE OPERATORS
+template <class ENTRY>
+bool operator==(const FlatHashTable_IteratorImp<ENTRY>& lhs,
+                const FlatHashTable_IteratorImp<ENTRY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' iterators refer to the
+    // same slot, and 'false' otherwise.
+
+                            // ===================
+                            // class FlatHashTable
+                            // ===================
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+class FlatHashTable {
+    // This class template implements an open-addressed hash table of entries
+    // of (template parameter) type 'ENTRY' stored inline, whose keys of
+    // (template parameter) type 'KEY' are accessed through the (template
+    // parameter) type 'ENTRY_UTIL', hashed with the (template parameter) type
+    // 'HASH', and compared with the (template parameter) type 'EQUAL'.
+
+    // PRIVATE TYPES
+    typedef FlatHashTable_GroupControl GroupControl;
+    typedef FlatHashTable_ImplUtil     ImplUtil;
+
+  public:
+    // TYPES
+    typedef FlatHashTable_IteratorImp<ENTRY>                  IteratorImp;
+    typedef bslstl::ForwardIterator<ENTRY, IteratorImp>       iterator;
+    typedef bslstl::ForwardIterator<const ENTRY, IteratorImp> const_iterator;
+
+  private:
+    // DATA
+    ENTRY            *d_entries_p;   // slots (owned)
+
+    bsl::uint8_t     *d_controls_p;  // control byte of each slot, following
+                                     // the slots in the same allocated block
+
+    bsl::size_t       d_size;        // number of entries
+
+    bsl::size_t       d_capacity;    // number of slots
+
+    bsl::size_t       d_growthLeft;  // number of empty slots that can be
+                                     // filled before growing
+
+    int               d_groupShift;  // shift selecting the first group of a
+                                     // scrambled hash value
+
+    HASH              d_hasher;      // hash functor
+
+    EQUAL             d_equal;       // key-equivalence functor
+
+    bslma::Allocator *d_allocator_p; // memory allocator (held, not owned)
+
+    // PRIVATE CLASS METHODS
+    static bsl::uint8_t hashControl(bsl::size_t hashValue);
+        // Return the control byte of a slot holding an entry whose key has
+        // the specified 'hashValue'.
+
+    // PRIVATE MANIPULATORS
+    void commitInsert(bsl::size_t index, bsl::size_t hashValue);
+        // Record that an entry whose key has the specified 'hashValue' was
+        // created in the available slot at the specified 'index'.
+
+    void eraseAt(bsl::size_t index);
+        // Destroy the entry at the specified 'index'.
+
+    bool findOrReserve(bsl::size_t *index,
+                       bsl::size_t *hashValue,
+                       const KEY&   key);
+        // Return 'true', and load into the specified 'index' the index of the
+        // entry, if this table has an entry whose key is equivalent to the
+        // specified 'key'; otherwise, grow this table if needed, load into
+        // 'index' the index of an available slot in which an entry having
+        // 'key' can be created, and return 'false'.  In both cases, load into
+        // the specified 'hashValue' the hash value of 'key'.
+
+    void rehashRaw(bsl::size_t newCapacity);
+        // Move the entries of this table into a new array of the specified
+        // 'newCapacity' slots.  The behavior is undefined unless
+        // 'newCapacity' is 0 or a power of two not less than
+        // 'GroupControl::k_SIZE', and
+        // 'size() <= ImplUtil::growthLimit(newCapacity)'.
+
+    void swapImp(FlatHashTable& other);
+        // Exchange the value of this table with that of the specified 'other'
+        // table, regardless of their allocators.
+
+    // PRIVATE ACCESSORS
+    bsl::size_t findAvailable(bsl::size_t hashValue) const;
+        // Return the index of the first available slot in the probe sequence
+        // of the specified 'hashValue'.  The behavior is undefined unless this
+        // table has an available slot.
+
+    bsl::size_t findKey(const KEY& key, bsl::size_t hashValue) const;
+        // Return the index of the entry whose key is equivalent to the
+        // specified 'key', having the specified 'hashValue', or 'capacity()'
+        // if there is no such entry.
+
+    bsl::size_t firstGroup(bsl::size_t hashValue) const;
+        // Return the index of the first group in the probe sequence of the
+        // specified 'hashValue'.
+
+    IteratorImp iteratorAt(bsl::size_t index) const;
+        // Return an iterator implementation referring to the slot at the
+        // specified 'index', or to the past-the-end position if
+        // 'capacity() == index'.
+
+  public:
+    // CREATORS
+    FlatHashTable(bsl::size_t       capacity,
+                  const HASH&       hash,
+                  const EQUAL&      equal,
+                  bslma::Allocator *basicAllocator = 0);
+        // Create an empty table having at least the specified 'capacity'
+        // slots, and using copies of the specified 'hash' and 'equal'
+        // functors.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  Note that no memory is allocated if 'capacity'
+        // is 0.
+
+    FlatHashTable(const FlatHashTable&  original,
+                  bslma::Allocator     *basicAllocator = 0);
+        // Create a table having the same value, and the same capacity, as the
+        // specified 'original' table.  Optionally specify a 'basicAllocator'
+        // used to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.
+
+    ~FlatHashTable();
+        // Destroy this object.
+
+    // MANIPULATORS
+    FlatHashTable& operator=(const FlatHashTable& rhs);
+        // Assign to this object the value, hash and equality functors of the
+        // specified 'rhs' object, and return a reference providing modifiable
+        // access to this object.  If an exception is thrown, this object is
+        // left unchanged.
+
+    void clear();
+        // Remove all entries from this table.  Note that the capacity of this
+        // table is unchanged.
+
+    bsl::size_t erase(const KEY& key);
+        // Remove the entry whose key is equivalent to the specified 'key', if
+        // any, and return the number of entries removed (0 or 1).
+
+    iterator erase(const_iterator position);
+        // Remove the entry at the specified 'position', and return an
+        // iterator referring to the entry following it, or 'end()' if there
+        // is no such entry.  The behavior is undefined unless 'position'
+        // refers to an entry of this table.
+
+    iterator find(const KEY& key);
+        // Return an iterator referring to the entry whose key is equivalent to
+        // the specified 'key', or 'end()' if there is no such entry.
+
+    bsl::pair<iterator, bool> insert(const ENTRY& entry);
+        // Insert a copy of the specified 'entry' if this table has no entry
+        // whose key is equivalent to the key of 'entry'.  Return a pair whose
+        // first member is an iterator referring to the entry of this table
+        // having that key, and whose second member is 'true' if 'entry' was
+        // inserted, and 'false' otherwise.  If an exception is thrown, this
+        // table is left unchanged.
+
+    void rehash(bsl::size_t minimumCapacity);
+        // Change the capacity of this table to the smallest power of two (not
+        // less than 16) that is not less than the specified 'minimumCapacity'
+        // and can hold 'size()' entries, and rehash the entries.  If an
+        // exception is thrown, this table is left unchanged.
+
+    void reserve(bsl::size_t numEntries);
+        // Grow this table, if needed, so that it can hold the specified
+        // 'numEntries' entries without being rehashed.  If an exception is
+        // thrown, this table is left unchanged.
+
+    void reset();
+        // Remove all entries from this table, and release all memory
+        // allocated by this table, leaving it with no slot.
+
+    bsl::pair<iterator, bool> try_emplace(const KEY& key);
+        // Insert an entry created by 'ENTRY_UTIL::constructFromKey' from the
+        // specified 'key' if this table has no entry whose key is equivalent
+        // to 'key'.  Return a pair whose first member is an iterator referring
+        // to the entry of this table having that key, and whose second member
+        // is 'true' if an entry was inserted, and 'false' otherwise.  If an
+        // exception is thrown, this table is left unchanged.
+
+                             // Iterators
+
+    iterator begin();
+        // Return an iterator referring to the first entry of this table, or
+        // 'end()' if this table is empty.
+
+    iterator end();
+        // Return the past-the-end iterator of this table.
+
+                                  // Aspects
+
+    void swap(FlatHashTable& other);
+        // Exchange the value, capacity, hash and equality functors of this
+        // object with those of the specified 'other' object.  This method
+        // provides the no-throw exception-safety guarantee.  The behavior is
+        // undefined unless this object was created with the same allocator as
+        // 'other'.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the number of slots of this table.
+
+    bool contains(const KEY& key) const;
+        // Return 'true' if this table has an entry whose key is equivalent to
+        // the specified 'key', and 'false' otherwise.
+
+    bsl::size_t count(const KEY& key) const;
+        // Return the number of entries of this table whose key is equivalent
+        // to the specified 'key' (0 or 1).
+
+    bool empty() const;
+        // Return 'true' if this table has no entry, and 'false' otherwise.
+
+    const_iterator find(const KEY& key) const;
+        // Return an iterator referring to the entry whose key is equivalent to
+        // the specified 'key', or 'end()' if there is no such entry.
+
+    const HASH& hash_function() const;
+        // Return the hash functor of this table.
+
+    const EQUAL& key_eq() const;
+        // Return the key-equivalence functor of this table.
+
+    float load_factor() const;
+        // Return the ratio of the number of entries to the number of slots of
+        // this table, or 0 if this table has no slot.
+
+    float max_load_factor() const;
+        // Return the maximum ratio of the number of slots holding an entry,
+        // or having held an erased entry, to the number of slots of this
+        // table, i.e., 0.875.
+
+    bsl::size_t size() const;
+        // Return the number of entries of this table.
+
+                             // Iterators
+
+    const_iterator begin() const;
+        // Return an iterator referring to the first entry of this table, or
+        // 'end()' if this table is empty.
+
+    const_iterator end() const;
+        // Return the past-the-end iterator of this table.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this table to supply memory.
+};
+
+// FREE OPERATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool operator==(
+             const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+             const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' tables have the same
+    // value, and 'false' otherwise.  Two tables have the same value if they
+    // have the same number of entries, and for each entry of 'lhs', 'rhs' has
+    // an entry having an equivalent key that compares equal to it.
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool operator!=(
+             const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+             const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' tables do not have the
+    // same value, and 'false' otherwise.  Two tables do not have the same
+    // value if they do not have the same number of entries, or if for some
+    // entry of 'lhs', 'rhs' has no entry having an equivalent key that
+    // compares equal to it.
+
+// FREE FUNCTIONS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void swap(FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& a,
+          FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& b);
+    // Exchange the values of the specified 'a' and 'b' tables.  The behavior
+    // is undefined unless both tables were created with the same allocator.
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                     // -------------------------------
+                     // class FlatHashTable_IteratorImp
+                     // -------------------------------
+
+// CREATORS
+template <class ENTRY>
+inline
+FlatHashTable_IteratorImp<ENTRY>::FlatHashTable_IteratorImp()
+: d_entry_p(0)
+, d_control_p(0)
+, d_controlEnd_p(0)
+{
+}
+
+template <class ENTRY>
+inline
+FlatHashTable_IteratorImp<ENTRY>::FlatHashTable_IteratorImp(
+                                        ENTRY              *entry,
+                                        const bsl::uint8_t *control,
+                                        const bsl::uint8_t *controlEnd)
+: d_entry_p(entry)
+, d_control_p(control)
+, d_controlEnd_p(controlEnd)
+{
+}
+
+// MANIPULATORS
+template <class ENTRY>
+inline
+void FlatHashTable_IteratorImp<ENTRY>::operator++()
+{
+    BSLS_ASSERT_SAFE(d_control_p != d_controlEnd_p);
+
+    do {
+        ++d_entry_p;
+        ++d_control_p;
+    } while (d_control_p != d_controlEnd_p && (*d_control_p & 0x80));
+}
+
+// ACCESSORS
+template <class ENTRY>
+inline
+ENTRY& FlatHashTable_IteratorImp<ENTRY>::operator*() const
+{
+    BSLS_ASSERT_SAFE(d_control_p != d_controlEnd_p);
+
+    return *d_entry_p;
+}
+
+template <class ENTRY>
+inline
+ENTRY *FlatHashTable_IteratorImp<ENTRY>::entry() const
+{
+    return d_entry_p;
+}
+
+// FREE OPERATORS
+template <class ENTRY>
+inline
+bool operator==(const FlatHashTable_IteratorImp<ENTRY>& lhs,
+                const FlatHashTable_IteratorImp<ENTRY>& rhs)
+{
+    return lhs.entry() == rhs.entry();
+}
+
+                            // -------------------
+                            // class FlatHashTable
+                            // -------------------
+
+// PRIVATE CLASS METHODS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::uint8_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::hashControl(
+                                                        bsl::size_t hashValue)
+{
+    return static_cast<bsl::uint8_t>(hashValue & 0x7F);
+}
+
+// PRIVATE MANIPULATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::commitInsert(
+                                                    bsl::size_t index,
+                                                    bsl::size_t hashValue)
+{
+    if (GroupControl::k_EMPTY == d_controls_p[index]) {
+        --d_growthLeft;
+    }
+    d_controls_p[index] = hashControl(hashValue);
+    ++d_size;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::eraseAt(
+                                                            bsl::size_t index)
+{
+    bslma::DestructionUtil::destroy(d_entries_p + index);
+
+    // The slot can be marked empty, rather than erased, if its group already
+    // has an empty slot: no probe sequence then continues past the group.
+
+    const bsl::size_t base = index & ~static_cast<bsl::size_t>(
+                                                     GroupControl::k_SIZE - 1);
+    if (GroupControl(d_controls_p + base).neverFull()) {
+        d_controls_p[index] = GroupControl::k_EMPTY;
+        ++d_growthLeft;
+    }
+    else {
+        d_controls_p[index] = GroupControl::k_ERASED;
+    }
+    --d_size;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::findOrReserve(
+                                                      bsl::size_t *index,
+                                                      bsl::size_t *hashValue,
+                                                      const KEY&   key)
+{
+    *hashValue = d_hasher(key);
+    *index     = findKey(key, *hashValue);
+    if (*index != d_capacity) {
+        return true;                                                  // RETURN
+    }
+
+    *index = findAvailable(*hashValue);
+    if (0 == d_growthLeft && GroupControl::k_EMPTY == d_controls_p[*index]) {
+        // Grow, unless most of the slots counted against the growth limit are
+        // those of erased entries, in which case rehashing at the same
+        // capacity is enough.
+
+        const bsl::size_t newCapacity =
+                       0 == d_capacity
+                       ? static_cast<bsl::size_t>(GroupControl::k_SIZE)
+                       : d_size * 2 < ImplUtil::growthLimit(d_capacity)
+                         ? d_capacity
+                         : d_capacity * 2;
+        rehashRaw(newCapacity);
+        *index = findAvailable(*hashValue);
+    }
+    return false;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::rehashRaw(
+                                                      bsl::size_t newCapacity)
+{
+    BSLS_ASSERT(d_size <= ImplUtil::growthLimit(newCapacity));
+
+    FlatHashTable other(newCapacity, d_hasher, d_equal, d_allocator_p);
+
+    for (bsl::size_t i = 0; i < d_capacity; ++i) {
+        if (d_controls_p[i] & 0x80) {
+            continue;
+        }
+
+        const bsl::size_t hashValue =
+                                  d_hasher(ENTRY_UTIL::key(d_entries_p[i]));
+        const bsl::size_t index     = other.findAvailable(hashValue);
+
+        if (bslmf::IsBitwiseMoveable<ENTRY>::value) {
+            // Entries are relocated without being copied: 'this' table is
+            // emptied below, without destroying them.
+
+            bsl::memcpy(static_cast<void *>(other.d_entries_p + index),
+                        static_cast<const void *>(d_entries_p + i),
+                        sizeof(ENTRY));
+        }
+        else {
+            bslma::ConstructionUtil::construct(other.d_entries_p + index,
+                                               d_allocator_p,
+                                               d_entries_p[i]);
+        }
+        other.commitInsert(index, hashValue);
+    }
+
+    if (bslmf::IsBitwiseMoveable<ENTRY>::value && d_capacity) {
+        bsl::memset(d_controls_p, GroupControl::k_EMPTY, d_capacity);
+        d_size = 0;
+    }
+
+    swapImp(other);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::swapImp(
+                                                         FlatHashTable& other)
+{
+    bslalg::SwapUtil::swap(&d_entries_p,  &other.d_entries_p);
+    bslalg::SwapUtil::swap(&d_controls_p, &other.d_controls_p);
+    bslalg::SwapUtil::swap(&d_size,       &other.d_size);
+    bslalg::SwapUtil::swap(&d_capacity,   &other.d_capacity);
+    bslalg::SwapUtil::swap(&d_growthLeft, &other.d_growthLeft);
+    bslalg::SwapUtil::swap(&d_groupShift, &other.d_groupShift);
+    bslalg::SwapUtil::swap(&d_hasher,     &other.d_hasher);
+    bslalg::SwapUtil::swap(&d_equal,      &other.d_equal);
+}
+
+// PRIVATE ACCESSORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::findAvailable(
+                                                  bsl::size_t hashValue) const
+{
+    const bsl::size_t groupMask = (d_capacity / GroupControl::k_SIZE) - 1;
+
+    bsl::size_t group = firstGroup(hashValue);
+    for (bsl::size_t step = 1; ; ++step) {
+        const bsl::size_t base = group * GroupControl::k_SIZE;
+
+        const GroupControl::BitMask available =
+                             GroupControl(d_controls_p + base).available();
+        if (available) {
+            return base + bdlb::BitUtil::numTrailingUnsetBits(        // RETURN
+                                        static_cast<bsl::uint32_t>(available));
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::findKey(
+                                                  const KEY&  key,
+                                                  bsl::size_t hashValue) const
+{
+    const bsl::size_t  groupMask = (d_capacity / GroupControl::k_SIZE) - 1;
+    const bsl::uint8_t control   = hashControl(hashValue);
+
+    bsl::size_t group = firstGroup(hashValue);
+    for (bsl::size_t step = 1; ; ++step) {
+        const bsl::size_t  base = group * GroupControl::k_SIZE;
+        const GroupControl groupControl(d_controls_p + base);
+
+        GroupControl::BitMask candidates = groupControl.match(control);
+        while (candidates) {
+            const bsl::size_t index = base
+                                    + bdlb::BitUtil::numTrailingUnsetBits(
+                                       static_cast<bsl::uint32_t>(candidates));
+            if (d_equal(ENTRY_UTIL::key(d_entries_p[index]), key)) {
+                return index;                                         // RETURN
+            }
+            candidates &= candidates - 1;
+        }
+        if (groupControl.neverFull()) {
+            return d_capacity;                                        // RETURN
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::firstGroup(
+                                                  bsl::size_t hashValue) const
+{
+    // Scramble the hash value (Fibonacci hashing) and keep its highest bits.
+    // The shift is split in two so that it is never as wide as the value,
+    // even when the table has a single group.
+
+    const bsls::Types::Uint64 scrambled =
+                  static_cast<bsls::Types::Uint64>(hashValue)
+                * 0x9E3779B97F4A7C15ULL;
+    return static_cast<bsl::size_t>((scrambled >> 1) >> d_groupShift);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::IteratorImp
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iteratorAt(
+                                                      bsl::size_t index) const
+{
+    return IteratorImp(d_entries_p + index,
+                       d_controls_p + index,
+                       d_controls_p + d_capacity);
+}
+
+// CREATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                                             bsl::size_t       capacity,
+                                             const HASH&       hash,
+                                             const EQUAL&      equal,
+                                             bslma::Allocator *basicAllocator)
+: d_entries_p(0)
+, d_controls_p(const_cast<bsl::uint8_t *>(ImplUtil::s_emptyGroup))
+, d_size(0)
+, d_capacity(0)
+, d_growthLeft(0)
+, d_groupShift(63)
+, d_hasher(hash)
+, d_equal(equal)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    capacity = ImplUtil::roundUpCapacity(capacity);
+    if (0 == capacity) {
+        return;                                                       // RETURN
+    }
+
+    char *block = static_cast<char *>(d_allocator_p->allocate(
+                                      capacity * (sizeof(ENTRY) + 1)));
+
+    d_entries_p  = reinterpret_cast<ENTRY *>(block);
+    d_controls_p = reinterpret_cast<bsl::uint8_t *>(block)
+                 + capacity * sizeof(ENTRY);
+    bsl::memset(d_controls_p, GroupControl::k_EMPTY, capacity);
+
+    d_capacity   = capacity;
+    d_growthLeft = ImplUtil::growthLimit(capacity);
+    d_groupShift = 63 - bdlb::BitUtil::log2(static_cast<bsl::uint64_t>(
+                                            capacity / GroupControl::k_SIZE));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::FlatHashTable(
+                                       const FlatHashTable&  original,
+                                       bslma::Allocator     *basicAllocator)
+: d_entries_p(0)
+, d_controls_p(const_cast<bsl::uint8_t *>(ImplUtil::s_emptyGroup))
+, d_size(0)
+, d_capacity(0)
+, d_growthLeft(0)
+, d_groupShift(63)
+, d_hasher(original.d_hasher)
+, d_equal(original.d_equal)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    if (0 == original.d_size) {
+        return;                                                       // RETURN
+    }
+
+    // Copy the entries at the same positions, so that they need not be
+    // rehashed, into a temporary table that is destroyed if an exception is
+    // thrown.
+
+    FlatHashTable other(original.d_capacity, d_hasher, d_equal, d_allocator_p);
+
+    for (bsl::size_t i = 0; i < original.d_capacity; ++i) {
+        const bsl::uint8_t control = original.d_controls_p[i];
+        if (0 == (control & 0x80)) {
+            bslma::ConstructionUtil::construct(other.d_entries_p + i,
+                                               d_allocator_p,
+                                               original.d_entries_p[i]);
+            ++other.d_size;
+        }
+        other.d_controls_p[i] = control;
+    }
+    other.d_growthLeft = original.d_growthLeft;
+
+    swapImp(other);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::~FlatHashTable()
+{
+    if (0 == d_capacity) {
+        return;                                                       // RETURN
+    }
+
+    if (d_size) {
+        for (bsl::size_t i = 0; i < d_capacity; ++i) {
+            if (0 == (d_controls_p[i] & 0x80)) {
+                bslma::DestructionUtil::destroy(d_entries_p + i);
+            }
+        }
+    }
+    d_allocator_p->deallocate(d_entries_p);
+}
+
+// MANIPULATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>&
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::operator=(
+                                                      const FlatHashTable& rhs)
+{
+    if (this != &rhs) {
+        FlatHashTable other(rhs, d_allocator_p);
+        swapImp(other);
+    }
+    return *this;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::clear()
+{
+    if (0 == d_capacity) {
+        return;                                                       // RETURN
+    }
+
+    for (bsl::size_t i = 0; d_size && i < d_capacity; ++i) {
+        if (0 == (d_controls_p[i] & 0x80)) {
+            bslma::DestructionUtil::destroy(d_entries_p + i);
+            --d_size;
+        }
+    }
+    bsl::memset(d_controls_p, GroupControl::k_EMPTY, d_capacity);
+    d_growthLeft = ImplUtil::growthLimit(d_capacity);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(
+                                                               const KEY& key)
+{
+    const bsl::size_t index = findKey(key, d_hasher(key));
+    if (index == d_capacity) {
+        return 0;                                                     // RETURN
+    }
+    eraseAt(index);
+    return 1;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::erase(
+                                                      const_iterator position)
+{
+    BSLS_ASSERT(position != end());
+
+    iterator next(position.imp());
+    ++next;
+
+    eraseAt(position.imp().entry() - d_entries_p);
+    return next;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::find(const KEY& key)
+{
+    return iterator(iteratorAt(findKey(key, d_hasher(key))));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::pair<
+        typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator,
+        bool>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::insert(const ENTRY& entry)
+{
+    bsl::size_t index;
+    bsl::size_t hashValue;
+    if (findOrReserve(&index, &hashValue, ENTRY_UTIL::key(entry))) {
+        return bsl::pair<iterator, bool>(iterator(iteratorAt(index)),
+                                         false);                      // RETURN
+    }
+
+    bslma::ConstructionUtil::construct(d_entries_p + index,
+                                       d_allocator_p,
+                                       entry);
+    commitInsert(index, hashValue);
+    return bsl::pair<iterator, bool>(iterator(iteratorAt(index)), true);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::rehash(
+                                                  bsl::size_t minimumCapacity)
+{
+    bsl::size_t newCapacity = ImplUtil::roundUpCapacity(minimumCapacity);
+
+    const bsl::size_t minimalCapacity = ImplUtil::minimalCapacity(d_size);
+    if (newCapacity < minimalCapacity) {
+        newCapacity = minimalCapacity;
+    }
+
+    if (newCapacity != d_capacity
+     || ImplUtil::growthLimit(d_capacity) - d_size != d_growthLeft) {
+        // The capacity changes, or there are slots of erased entries to
+        // reclaim.
+
+        rehashRaw(newCapacity);
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::reserve(
+                                                       bsl::size_t numEntries)
+{
+    const bsl::size_t minimalCapacity = ImplUtil::minimalCapacity(numEntries);
+    if (minimalCapacity > d_capacity) {
+        rehashRaw(minimalCapacity);
+    }
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::reset()
+{
+    FlatHashTable other(0, d_hasher, d_equal, d_allocator_p);
+    swapImp(other);
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::pair<
+        typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator,
+        bool>
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::try_emplace(
+                                                               const KEY& key)
+{
+    bsl::size_t index;
+    bsl::size_t hashValue;
+    if (findOrReserve(&index, &hashValue, key)) {
+        return bsl::pair<iterator, bool>(iterator(iteratorAt(index)),
+                                         false);                      // RETURN
+    }
+
+    ENTRY_UTIL::constructFromKey(d_entries_p + index, d_allocator_p, key);
+    commitInsert(index, hashValue);
+    return bsl::pair<iterator, bool>(iterator(iteratorAt(index)), true);
+}
+
+                             // Iterators
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::begin()
+{
+    bsl::size_t index = 0;
+    while (index < d_capacity && (d_controls_p[index] & 0x80)) {
+        ++index;
+    }
+    return iterator(iteratorAt(index));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::end()
+{
+    return iterator(iteratorAt(d_capacity));
+}
+
+                                  // Aspects
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::swap(
+                                                         FlatHashTable& other)
+{
+    BSLS_ASSERT(d_allocator_p == other.d_allocator_p);
+
+    swapImp(other);
+}
+
+// ACCESSORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::capacity() const
+{
+    return d_capacity;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bool FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::contains(
+                                                         const KEY& key) const
+{
+    return findKey(key, d_hasher(key)) != d_capacity;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::count(
+                                                         const KEY& key) const
+{
+    return contains(key) ? 1 : 0;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bool FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::empty() const
+{
+    return 0 == d_size;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::find(const KEY& key) const
+{
+    return const_iterator(iteratorAt(findKey(key, d_hasher(key))));
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+const HASH&
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::hash_function() const
+{
+    return d_hasher;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+const EQUAL& FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::key_eq() const
+{
+    return d_equal;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+float FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::load_factor() const
+{
+    return d_capacity ? static_cast<float>(d_size)
+                        / static_cast<float>(d_capacity)
+                      : 0.0f;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+float
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::max_load_factor() const
+{
+    return 0.875f;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bsl::size_t FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::size() const
+{
+    return d_size;
+}
+
+                             // Iterators
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::begin() const
+{
+    return const_cast<FlatHashTable *>(this)->begin();
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::const_iterator
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::end() const
+{
+    return const_iterator(iteratorAt(d_capacity));
+}
+
+                                  // Aspects
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bslma::Allocator *
+FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::allocator() const
+{
+    return d_allocator_p;
+}
+
+// FREE OPERATORS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+bool operator==(
+              const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+              const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs)
+{
+    typedef typename FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>::
+                                                 const_iterator ConstIterator;
+
+    if (lhs.size() != rhs.size()) {
+        return false;                                                 // RETURN
+    }
+
+    for (ConstIterator it = lhs.begin(); it != lhs.end(); ++it) {
+        const ConstIterator match = rhs.find(ENTRY_UTIL::key(*it));
+        if (match == rhs.end() || !(*match == *it)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+bool operator!=(
+              const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& lhs,
+              const FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+// FREE FUNCTIONS
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+inline
+void swap(FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& a,
+          FlatHashTable<KEY, ENTRY, ENTRY_UTIL, HASH, EQUAL>& b)
+{
+    a.swap(b);
+}
+
+}  // close package namespace
+
+// TRAITS
+
+namespace bslma {
+
+template <class KEY, class ENTRY, class ENTRY_UTIL, class HASH, class EQUAL>
+struct UsesBslmaAllocator<bdlc::FlatHashTable<KEY,
+                                              ENTRY,
+                                              ENTRY_UTIL,
+                                              HASH,
+                                              EQUAL> > : bsl::true_type {};
+
+}  // close namespace bslma
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
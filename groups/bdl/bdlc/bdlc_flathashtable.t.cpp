@@ -0,0 +1,1137 @@
+// bdlc_flathashtable.t.cpp                                           -*-C++-*-
+#include <bdlc_flathashtable.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_map.h>
+#include <bsl_string.h>
+#include <bsl_utility.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test implements an open-addressed hash table, whose
+// observable state is the set of its entries and its capacity.  The table is
+// tested with entries that are pairs of an 'int' key and a 'bsl::string'
+// value (which allocate memory, and are bitwise moveable), and with entries
+// of a type that is not bitwise moveable and asserts that it is never
+// relocated bitwise.  Randomized sequences of insertions and erasures are
+// checked against a 'bsl::map' oracle, using hash functors that make probe
+// sequences collide, to exercise probing across groups, erased slots, and
+// rehashing.
+// ----------------------------------------------------------------------------
+// FlatHashTable_ImplUtil
+// [ 2] static bsl::size_t growthLimit(bsl::size_t capacity);
+// [ 2] static bsl::size_t minimalCapacity(bsl::size_t numEntries);
+// [ 2] static bsl::size_t roundUpCapacity(bsl::size_t capacity);
+//
+// FlatHashTable
+// [ 3] FlatHashTable(capacity, hash, equal, basicAllocator);
+// [ 5] FlatHashTable(const FlatHashTable& original, basicAllocator);
+// [ 3] ~FlatHashTable();
+// [ 5] FlatHashTable& operator=(const FlatHashTable& rhs);
+// [ 6] void clear();
+// [ 4] bsl::size_t erase(const KEY& key);
+// [ 4] iterator erase(const_iterator position);
+// [ 4] iterator find(const KEY& key);
+// [ 4] bsl::pair<iterator, bool> insert(const ENTRY& entry);
+// [ 6] void rehash(bsl::size_t minimumCapacity);
+// [ 6] void reserve(bsl::size_t numEntries);
+// [ 6] void reset();
+// [ 4] bsl::pair<iterator, bool> try_emplace(const KEY& key);
+// [ 4] iterator begin();
+// [ 4] iterator end();
+// [ 5] void swap(FlatHashTable& other);
+// [ 3] bsl::size_t capacity() const;
+// [ 4] bool contains(const KEY& key) const;
+// [ 4] bsl::size_t count(const KEY& key) const;
+// [ 3] bool empty() const;
+// [ 4] const_iterator find(const KEY& key) const;
+// [ 3] const HASH& hash_function() const;
+// [ 3] const EQUAL& key_eq() const;
+// [ 3] float load_factor() const;
+// [ 3] float max_load_factor() const;
+// [ 3] bsl::size_t size() const;
+// [ 4] const_iterator begin() const;
+// [ 4] const_iterator end() const;
+// [ 3] bslma::Allocator *allocator() const;
+// [ 5] bool operator==(lhs, rhs);
+// [ 5] bool operator!=(lhs, rhs);
+// [ 5] void swap(FlatHashTable& a, FlatHashTable& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] CONCERN: Entries that are not bitwise moveable are copied.
+// [ 8] CONCERN: Exceptions leave the table unchanged.
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+#define ASSERT_OPT_FAIL_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL_RAW(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bsl::pair<const int, bsl::string> Entry;
+
+struct EntryUtil {
+    // This 'struct' provides the 'ENTRY_UTIL' operations of the test entries.
+
+    static void constructFromKey(Entry            *entry,
+                                 bslma::Allocator *allocator,
+                                 const int&        key)
+        // Create, at the specified 'entry' address, an entry having the
+        // specified 'key' and an empty value, using the specified 'allocator'
+        // to supply memory.
+    {
+        bslma::ConstructionUtil::construct(entry,
+                                           allocator,
+                                           key,
+                                           bsl::string());
+    }
+
+    static const int& key(const Entry& entry)
+        // Return the key of the specified 'entry'.
+    {
+        return entry.first;
+    }
+};
+
+class TestHash {
+    // This class provides a hash functor of 'int' keys whose quality is
+    // configurable, in order to make probe sequences collide.
+
+    // DATA
+    int d_mode;  // 0: good, 1: same low bits, 2: constant
+
+  public:
+    // CREATORS
+    explicit TestHash(int mode = 0)
+        // Create a hash functor having the optionally specified 'mode'.
+    : d_mode(mode)
+    {
+    }
+
+    // ACCESSORS
+    bsl::size_t operator()(int key) const
+        // Return the hash value of the specified 'key'.
+    {
+        const bsl::size_t value = static_cast<bsl::size_t>(key);
+        switch (d_mode) {
+          case 0: return value * 0x2545F4914F6CDD1DULL;               // RETURN
+          case 1: return value << 7;                                  // RETURN
+          default: return 42;                                         // RETURN
+        }
+    }
+
+    int mode() const
+        // Return the mode of this hash functor.
+    {
+        return d_mode;
+    }
+};
+
+typedef bdlc::FlatHashTable<int,
+                            Entry,
+                            EntryUtil,
+                            TestHash,
+                            bsl::equal_to<int> >      Obj;
+typedef bdlc::FlatHashTable_ImplUtil                  ImplUtil;
+typedef bsl::map<int, bsl::string>                    Oracle;
+
+                           // =================
+                           // class NotBitwise
+                           // =================
+
+class NotBitwise {
+    // This class holds an 'int' value and the address of the object, and
+    // reports an error if it is accessed after having been relocated without
+    // being copied.
+
+    // DATA
+    int         d_value;
+    NotBitwise *d_self_p;
+
+  public:
+    // CLASS DATA
+    static int s_numObjects;
+
+    // CREATORS
+    explicit NotBitwise(int value)
+    : d_value(value)
+    , d_self_p(this)
+    {
+        ++s_numObjects;
+    }
+
+    NotBitwise(const NotBitwise& original)
+    : d_value(original.value())
+    , d_self_p(this)
+    {
+        ++s_numObjects;
+    }
+
+    ~NotBitwise()
+    {
+        ASSERT(this == d_self_p);
+        --s_numObjects;
+    }
+
+    // ACCESSORS
+    int value() const
+    {
+        ASSERT(this == d_self_p);
+        return d_value;
+    }
+};
+
+int NotBitwise::s_numObjects = 0;
+
+bool operator==(const NotBitwise& lhs, const NotBitwise& rhs)
+{
+    return lhs.value() == rhs.value();
+}
+
+struct NotBitwiseUtil {
+    // This 'struct' provides the 'ENTRY_UTIL' operations of 'NotBitwise'
+    // entries, whose key is their value.
+
+    static void constructFromKey(NotBitwise       *entry,
+                                 bslma::Allocator *,
+                                 const int&        key)
+    {
+        new (entry) NotBitwise(key);
+    }
+
+    static const int& key(const NotBitwise& entry)
+    {
+        static int value;  // single-threaded test
+        value = entry.value();
+        return value;
+    }
+};
+
+struct NotBitwiseHash {
+    bsl::size_t operator()(int key) const
+    {
+        return static_cast<bsl::size_t>(key) * 0x9E3779B97F4A7C15ULL;
+    }
+};
+
+typedef bdlc::FlatHashTable<int,
+                            NotBitwise,
+                            NotBitwiseUtil,
+                            NotBitwiseHash,
+                            bsl::equal_to<int> > NotBitwiseObj;
+
+// ============================================================================
+//                            HELPER FUNCTIONS
+// ----------------------------------------------------------------------------
+
+static unsigned int nextRandom(unsigned int *seed)
+    // Return the next pseudo-random number of the sequence of the specified
+    // 'seed'.
+{
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 8) & 0xFFFFFF;
+}
+
+static bool isEqual(const Obj& table, const Oracle& oracle)
+    // Return 'true' if the specified 'table' holds the entries of the
+    // specified 'oracle', iterating over the table and looking up each entry
+    // of the oracle, and 'false' otherwise.
+{
+    if (table.size() != oracle.size()) {
+        return false;                                                 // RETURN
+    }
+
+    bsl::size_t count = 0;
+    for (Obj::const_iterator it = table.begin(); it != table.end(); ++it) {
+        Oracle::const_iterator match = oracle.find(it->first);
+        if (match == oracle.end() || match->second != it->second) {
+            return false;                                             // RETURN
+        }
+        ++count;
+    }
+    if (count != oracle.size()) {
+        return false;                                                 // RETURN
+    }
+
+    for (Oracle::const_iterator it = oracle.begin(); it != oracle.end();
+                                                                        ++it) {
+        Obj::const_iterator match = table.find(it->first);
+        if (match == table.end() || match->second != it->second) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+static bsl::string valueOf(int key)
+    // Return a value, long enough to allocate memory, for the specified 'key'.
+{
+    bsl::string result("value of key ");
+    result += bsl::to_string(key);
+    result += " that is long enough to allocate memory";
+    return result;
+}
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                test = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    int             verbose = argc > 2;
+    int         veryVerbose = argc > 3;
+    int     veryVeryVerbose = argc > 4;
+    int veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 8: {
+        // --------------------------------------------------------------------
+        // CONCERN: Exceptions leave the table unchanged.
+        //
+        // Concerns:
+        //: 1 If the allocation of a new array of slots, or the copy of an
+        //:   entry, throws during an insertion, the table is left unchanged.
+        //:
+        //: 2 If the copy of an entry throws during a copy construction or an
+        //:   assignment, no memory is leaked, and the assigned-to table is
+        //:   left unchanged.
+        //
+        // Plan:
+        //: 1 Insert entries into tables of various sizes within the
+        //:   exception-test macros, and verify the value of the table against
+        //:   the oracle whether or not an exception is thrown.  (C-1)
+        //:
+        //: 2 Copy and assign tables within the exception-test macros.  (C-2)
+        //
+        // Testing:
+        //   CONCERN: Exceptions leave the table unchanged.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCERN: Exceptions leave the table unchanged"
+                          << endl
+                          << "============================================="
+                          << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        for (int n = 0; n < 40; ++n) {
+            Obj    mX(0, TestHash(0), bsl::equal_to<int>(), &sa);
+            Oracle oracle;
+
+            for (int i = 0; i < n; ++i) {
+                mX.insert(Entry(i, valueOf(i)));
+                oracle[i] = valueOf(i);
+            }
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                ASSERTV(n, isEqual(mX, oracle));
+
+                mX.insert(Entry(n, valueOf(n)));
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            oracle[n] = valueOf(n);
+            ASSERTV(n, isEqual(mX, oracle));
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                Obj mY(mX, &sa);
+                ASSERTV(n, mY == mX);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            Obj mZ(0, TestHash(0), bsl::equal_to<int>(), &sa);
+            mZ.insert(Entry(-1, valueOf(-1)));
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                ASSERTV(n, 1 == mZ.size() || mZ == mX);
+
+                mZ = mX;
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            ASSERTV(n, mZ == mX);
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCERN: Entries that are not bitwise moveable are copied.
+        //
+        // Concerns:
+        //: 1 Entries that are not bitwise moveable are copied, and the
+        //:   originals destroyed, when the table is rehashed.
+        //:
+        //: 2 All entries are destroyed by 'erase', 'clear', and the
+        //:   destructor.
+        //
+        // Plan:
+        //: 1 Insert and erase entries of a type that checks that it is not
+        //:   relocated bitwise, and verify the number of live objects.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: Entries that are not bitwise moveable are copied.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+              << "CONCERN: Entries that are not bitwise moveable are copied"
+              << endl
+              << "========================================================="
+              << endl;
+
+        ASSERT(false == bslmf::IsBitwiseMoveable<NotBitwise>::value);
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        {
+            NotBitwiseObj mX(0, NotBitwiseHash(), bsl::equal_to<int>(), &sa);
+            const NotBitwiseObj& X = mX;
+
+            for (int i = 0; i < 1000; ++i) {
+                ASSERTV(i, true == mX.try_emplace(i).second);
+                ASSERTV(i, i + 1 == NotBitwise::s_numObjects);
+            }
+            for (int i = 0; i < 1000; i += 2) {
+                ASSERTV(i, 1 == mX.erase(i));
+            }
+            ASSERT(500 == NotBitwise::s_numObjects);
+
+            mX.rehash(0);
+            ASSERT(500 == NotBitwise::s_numObjects);
+            ASSERT(1024 == X.capacity());
+
+            for (int i = 0; i < 1000; ++i) {
+                ASSERTV(i, (i % 2) == static_cast<int>(X.count(i)));
+            }
+
+            NotBitwiseObj mY(X, &sa);
+            ASSERT(1000 == NotBitwise::s_numObjects);
+            ASSERT(X == mY);
+
+            mY.clear();
+            ASSERT(500 == NotBitwise::s_numObjects);
+        }
+        ASSERT(0 == NotBitwise::s_numObjects);
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CLEAR, RESET, REHASH, AND RESERVE
+        //
+        // Concerns:
+        //: 1 'clear' destroys all entries and keeps the capacity.
+        //:
+        //: 2 'reset' destroys all entries and releases all memory.
+        //:
+        //: 3 'rehash' sets the capacity to the smallest power of two not less
+        //:   than the requested capacity that can hold the entries, and
+        //:   reclaims the slots of erased entries.
+        //:
+        //: 4 'reserve' grows the table so that the requested number of
+        //:   entries can be inserted without rehashing.
+        //
+        // Plan:
+        //: 1 Exercise each method on tables of various sizes, and verify the
+        //:   capacity, the value against an oracle, and the memory in use.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   void clear();
+        //   void rehash(bsl::size_t minimumCapacity);
+        //   void reserve(bsl::size_t numEntries);
+        //   void reset();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CLEAR, RESET, REHASH, AND RESERVE" << endl
+                          << "=================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        for (int n = 0; n < 300; n += 7) {
+            Obj mX(0, TestHash(0), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            Oracle oracle;
+            for (int i = 0; i < n; ++i) {
+                mX.insert(Entry(i, valueOf(i)));
+                oracle[i] = valueOf(i);
+            }
+
+            const bsl::size_t CAPACITY = X.capacity();
+            ASSERTV(n, CAPACITY == ImplUtil::minimalCapacity(n));
+
+            // 'rehash' to a smaller capacity keeps a capacity holding 'n'.
+
+            mX.rehash(0);
+            ASSERTV(n, CAPACITY == X.capacity());
+            ASSERTV(n, isEqual(X, oracle));
+
+            mX.rehash(4 * CAPACITY + 1);
+            ASSERTV(n, X.capacity(), (n ? 8 * CAPACITY : 16) == X.capacity());
+            ASSERTV(n, isEqual(X, oracle));
+
+            mX.rehash(0);
+            ASSERTV(n, CAPACITY == X.capacity());
+            ASSERTV(n, isEqual(X, oracle));
+
+            // 'reserve' never shrinks, and avoids rehashing.
+
+            mX.reserve(n / 2);
+            ASSERTV(n, CAPACITY == X.capacity());
+
+            mX.reserve(2 * n + 100);
+            const bsl::size_t RESERVED = X.capacity();
+            ASSERTV(n, RESERVED == ImplUtil::minimalCapacity(2 * n + 100));
+            for (int i = n; i < 2 * n + 100; ++i) {
+                mX.insert(Entry(i, valueOf(i)));
+                oracle[i] = valueOf(i);
+            }
+            ASSERTV(n, RESERVED == X.capacity());
+            ASSERTV(n, isEqual(X, oracle));
+
+            // 'clear' keeps the memory of the slots.
+
+            const bsls::Types::Int64 NUM_BLOCKS = sa.numBlocksInUse();
+            mX.clear();
+            oracle.clear();
+            ASSERTV(n, RESERVED == X.capacity());
+            ASSERTV(n, true == X.empty());
+            ASSERTV(n, 1 == sa.numBlocksInUse());
+            ASSERTV(n, NUM_BLOCKS >= 1);
+            ASSERTV(n, X.begin() == X.end());
+
+            mX.insert(Entry(n, valueOf(n)));
+            oracle[n] = valueOf(n);
+            ASSERTV(n, isEqual(X, oracle));
+
+            // 'reset' releases all memory.
+
+            mX.reset();
+            ASSERTV(n, 0 == X.capacity());
+            ASSERTV(n, 0 == X.size());
+            ASSERTV(n, 0 == sa.numBlocksInUse());
+            ASSERTV(n, X.end() == X.find(n));
+
+            mX.insert(Entry(n, valueOf(n)));
+            ASSERTV(n, 16 == X.capacity());
+        }
+
+        if (verbose) cout << "\tReclaiming erased slots." << endl;
+        {
+            // With the low bits of the hash values equal, erased slots are
+            // never marked empty, and accumulate until the table is rehashed
+            // in place.
+
+            Obj mX(0, TestHash(1), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            for (int i = 0; i < 1000; ++i) {
+                mX.insert(Entry(i, valueOf(i)));
+            }
+            const bsl::size_t CAPACITY = X.capacity();
+
+            for (int round = 0; round < 20; ++round) {
+                for (int i = 0; i < 1000; ++i) {
+                    ASSERTV(round, i, 1 == mX.erase(i));
+                    mX.insert(Entry(i + 1000000, valueOf(i)));
+                    ASSERTV(round, i, 1 == mX.erase(i + 1000000));
+                    mX.insert(Entry(i, valueOf(i)));
+                }
+                ASSERTV(round, CAPACITY == X.capacity());
+                ASSERTV(round, 1000 == X.size());
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // COPY, ASSIGNMENT, EQUALITY, AND SWAP
+        //
+        // Concerns:
+        //: 1 A copy has the same value and capacity as the original, and uses
+        //:   the supplied allocator.
+        //:
+        //: 2 Assignment gives the same value, and is alias-safe.
+        //:
+        //: 3 Two tables compare equal if and only if they hold the same
+        //:   entries, regardless of their capacity and of the order of
+        //:   insertion.
+        //:
+        //: 4 'swap' exchanges the values and functors without allocating.
+        //
+        // Plan:
+        //: 1 Create tables of various sizes, holding erased slots, and
+        //:   verify copies, assignments, comparisons, and swaps.  (C-1..4)
+        //
+        // Testing:
+        //   FlatHashTable(const FlatHashTable& original, basicAllocator);
+        //   FlatHashTable& operator=(const FlatHashTable& rhs);
+        //   void swap(FlatHashTable& other);
+        //   bool operator==(lhs, rhs);
+        //   bool operator!=(lhs, rhs);
+        //   void swap(FlatHashTable& a, FlatHashTable& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY, ASSIGNMENT, EQUALITY, AND SWAP" << endl
+                          << "====================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        bslma::TestAllocator oa("other",    veryVeryVeryVerbose);
+
+        for (int n = 0; n < 200; n += 13) {
+            Obj mX(0, TestHash(0), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            Obj mR(n, TestHash(0), bsl::equal_to<int>(), &sa);
+            const Obj& R = mR;
+
+            Oracle oracle;
+            for (int i = 0; i < 2 * n; ++i) {
+                mX.insert(Entry(i, valueOf(i)));
+            }
+            for (int i = 0; i < 2 * n; ++i) {
+                if (i % 2) {
+                    mX.erase(i);
+                }
+                else {
+                    oracle[i] = valueOf(i);
+                }
+            }
+            for (int i = 2 * n - 1; i >= 0; i -= 2) {
+                mR.insert(Entry(i - 1, valueOf(i - 1)));
+            }
+            ASSERTV(n, isEqual(X, oracle));
+            ASSERTV(n, isEqual(R, oracle));
+            ASSERTV(n, X == R);
+            ASSERTV(n, !(X != R));
+
+            {
+                Obj mY(X, &oa);  const Obj& Y = mY;
+
+                ASSERTV(n, X.capacity() == Y.capacity());
+                ASSERTV(n, &oa == Y.allocator());
+                ASSERTV(n, isEqual(Y, oracle));
+                ASSERTV(n, X == Y);
+
+                // Insertion in the copy reuses the erased slots as the
+                // original does.
+
+                for (int i = 1; i < 2 * n; i += 2) {
+                    mY.insert(Entry(i, valueOf(i)));
+                }
+                ASSERTV(n, X.capacity() == Y.capacity());
+                ASSERTV(n, n ? X != Y : X == Y);
+
+                mY.insert(Entry(-1, valueOf(-1)));
+                ASSERTV(n, X != Y);
+            }
+            ASSERTV(n, 0 == oa.numBlocksInUse());
+
+            {
+                Obj mY(0, TestHash(2), bsl::equal_to<int>(), &oa);
+                const Obj& Y = mY;
+
+                mY.insert(Entry(-5, valueOf(-5)));
+                mY = X;
+                ASSERTV(n, isEqual(Y, oracle));
+                ASSERTV(n, 0 == Y.hash_function().mode());
+                ASSERTV(n, &oa == Y.allocator());
+
+                mY = Y;
+                ASSERTV(n, isEqual(Y, oracle));
+            }
+
+            {
+                Obj mY(0, TestHash(2), bsl::equal_to<int>(), &sa);
+                const Obj& Y = mY;
+
+                mY.insert(Entry(-5, valueOf(-5)));
+
+                const bsls::Types::Int64 NUM_ALLOCATIONS =
+                                                       sa.numAllocations();
+
+                mY.swap(mX);
+                ASSERTV(n, isEqual(Y, oracle));
+                ASSERTV(n, 0 == Y.hash_function().mode());
+                ASSERTV(n, 2 == X.hash_function().mode());
+                ASSERTV(n, 1 == X.size());
+                ASSERTV(n, X.contains(-5));
+
+                swap(mX, mY);
+                ASSERTV(n, isEqual(X, oracle));
+                ASSERTV(n, NUM_ALLOCATIONS == sa.numAllocations());
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // INSERT, FIND, AND ERASE
+        //
+        // Concerns:
+        //: 1 'insert' and 'try_emplace' insert an entry if and only if its
+        //:   key is not in the table, and return an iterator to the entry
+        //:   having the key.
+        //:
+        //: 2 'find', 'contains', and 'count' find the inserted entries, and
+        //:   only them, including when the probe sequences of many keys
+        //:   collide.
+        //:
+        //: 3 'erase' removes the entry having the key, and returns the number
+        //:   of entries removed, or the iterator following the position.
+        //:
+        //: 4 Iteration visits each entry exactly once.
+        //:
+        //: 5 The table grows when its load reaches 7/8 of its capacity.
+        //:
+        //: 6 All memory comes from the supplied allocator.
+        //
+        // Plan:
+        //: 1 For hash functors of good quality, hash values colliding in their
+        //:   low bits, and constant hash values, apply a pseudo-random
+        //:   sequence of insertions and erasures to the table and to an
+        //:   oracle, and compare them periodically.  (C-1..4, 6)
+        //:
+        //: 2 Insert consecutive keys and verify the capacity.  (C-5)
+        //
+        // Testing:
+        //   bsl::size_t erase(const KEY& key);
+        //   iterator erase(const_iterator position);
+        //   iterator find(const KEY& key);
+        //   bsl::pair<iterator, bool> insert(const ENTRY& entry);
+        //   bsl::pair<iterator, bool> try_emplace(const KEY& key);
+        //   iterator begin();
+        //   iterator end();
+        //   bool contains(const KEY& key) const;
+        //   bsl::size_t count(const KEY& key) const;
+        //   const_iterator find(const KEY& key) const;
+        //   const_iterator begin() const;
+        //   const_iterator end() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INSERT, FIND, AND ERASE" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\tRandomized operations." << endl;
+
+        for (int mode = 0; mode < 3; ++mode) {
+            const int RANGE = 2 == mode ? 100 : 3000;
+            const int NUM_OPERATIONS = 2 == mode ? 3000 : 30000;
+
+            Obj mX(0, TestHash(mode), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            Oracle       oracle;
+            unsigned int seed = 42 + mode;
+
+            for (int op = 0; op < NUM_OPERATIONS; ++op) {
+                const int key    = nextRandom(&seed) % RANGE;
+                const int action = nextRandom(&seed) % 5;
+
+                if (veryVerbose) { P_(mode) P_(op) P_(key) P(action) }
+
+                switch (action) {
+                  case 0:
+                  case 1: {
+                    const bool EXP = 0 == oracle.count(key);
+                    bsl::pair<Obj::iterator, bool> result =
+                                           mX.insert(Entry(key, valueOf(key)));
+                    ASSERTV(mode, op, EXP == result.second);
+                    ASSERTV(mode, op, key == result.first->first);
+                    oracle.insert(Oracle::value_type(key, valueOf(key)));
+                  } break;
+                  case 2: {
+                    const bool EXP = 0 == oracle.count(key);
+                    bsl::pair<Obj::iterator, bool> result =
+                                                         mX.try_emplace(key);
+                    ASSERTV(mode, op, EXP == result.second);
+                    ASSERTV(mode, op, key == result.first->first);
+                    if (EXP) {
+                        ASSERTV(mode, op, result.first->second.empty());
+                        result.first->second = valueOf(key);
+                    }
+                    oracle.insert(Oracle::value_type(key, valueOf(key)));
+                  } break;
+                  case 3: {
+                    const bsl::size_t EXP = oracle.erase(key);
+                    ASSERTV(mode, op, EXP == mX.erase(key));
+                  } break;
+                  case 4: {
+                    Obj::iterator it = mX.find(key);
+                    ASSERTV(mode, op, (it != mX.end()) == X.contains(key));
+                    ASSERTV(mode, op, oracle.count(key) == X.count(key));
+                    if (it != mX.end()) {
+                        Obj::iterator next = it;
+                        ++next;
+                        ASSERTV(mode, op, next == mX.erase(it));
+                        oracle.erase(key);
+                    }
+                  } break;
+                }
+
+                ASSERTV(mode, op, oracle.size() == X.size());
+                ASSERTV(mode, op, X.load_factor() <= X.max_load_factor());
+
+                if (0 == op % 1000) {
+                    ASSERTV(mode, op, isEqual(X, oracle));
+                }
+            }
+            ASSERTV(mode, isEqual(X, oracle));
+
+            for (int key = -10; key < RANGE + 10; ++key) {
+                ASSERTV(mode, key, oracle.count(key) == X.count(key));
+            }
+
+            // Erase everything through iterators.
+
+            Obj::iterator it = mX.begin();
+            while (it != mX.end()) {
+                it = mX.erase(it);
+            }
+            ASSERTV(mode, X.empty());
+            ASSERTV(mode, X.begin() == X.end());
+        }
+
+        if (verbose) cout << "\tGrowth." << endl;
+        {
+            Obj mX(0, TestHash(0), bsl::equal_to<int>(), &sa);
+            const Obj& X = mX;
+
+            ASSERT(0 == X.capacity());
+            for (int i = 0; i < 5000; ++i) {
+                mX.try_emplace(i);
+
+                const bsl::size_t EXP = ImplUtil::minimalCapacity(i + 1);
+                ASSERTV(i, EXP, X.capacity(), EXP == X.capacity());
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTOR AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The constructor creates an empty table whose capacity is the
+        //:   specified capacity rounded up to a power of two not less than
+        //:   16, or 0.
+        //:
+        //: 2 No memory is allocated for a table of capacity 0, and the
+        //:   memory of the slots is allocated from the supplied allocator, or
+        //:   the default allocator.
+        //:
+        //: 3 The accessors return the functors, allocator, size, and load.
+        //
+        // Plan:
+        //: 1 Create tables of various capacities, and verify the accessors
+        //:   and the memory allocated.  (C-1..3)
+        //
+        // Testing:
+        //   FlatHashTable(capacity, hash, equal, basicAllocator);
+        //   ~FlatHashTable();
+        //   bsl::size_t capacity() const;
+        //   bool empty() const;
+        //   const HASH& hash_function() const;
+        //   const EQUAL& key_eq() const;
+        //   float load_factor() const;
+        //   float max_load_factor() const;
+        //   bsl::size_t size() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTOR AND BASIC ACCESSORS" << endl
+                          << "===============================" << endl;
+
+        static const struct {
+            int         d_line;
+            bsl::size_t d_capacity;
+            bsl::size_t d_expCapacity;
+        } DATA[] = {
+            { L_,    0,    0 },
+            { L_,    1,   16 },
+            { L_,   15,   16 },
+            { L_,   16,   16 },
+            { L_,   17,   32 },
+            { L_,  100,  128 },
+            { L_, 1024, 1024 },
+            { L_, 1025, 2048 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE = DATA[ti].d_line;
+            const bsl::size_t CAP  = DATA[ti].d_capacity;
+            const bsl::size_t EXP  = DATA[ti].d_expCapacity;
+
+            bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+            {
+                Obj mX(CAP, TestHash(1), bsl::equal_to<int>(), &sa);
+                const Obj& X = mX;
+
+                ASSERTV(LINE, EXP == X.capacity());
+                ASSERTV(LINE, 0 == X.size());
+                ASSERTV(LINE, true == X.empty());
+                ASSERTV(LINE, 0.0f == X.load_factor());
+                ASSERTV(LINE, 0.875f == X.max_load_factor());
+                ASSERTV(LINE, 1 == X.hash_function().mode());
+                ASSERTV(LINE, &sa == X.allocator());
+                ASSERTV(LINE, X.begin() == X.end());
+                ASSERTV(LINE, (EXP ? 1 : 0) == sa.numBlocksInUse());
+                ASSERTV(LINE, false == X.contains(0));
+
+                bsl::equal_to<int> equal = X.key_eq();
+                (void)equal;
+            }
+            ASSERTV(LINE, 0 == sa.numBlocksInUse());
+            ASSERTV(LINE, 0 == defaultAllocator.numBlocksTotal());
+        }
+
+        {
+            bslma::TestAllocator da("default", veryVeryVeryVerbose);
+            bslma::DefaultAllocatorGuard guard(&da);
+
+            Obj mX(16, TestHash(0), bsl::equal_to<int>());
+            const Obj& X = mX;
+
+            ASSERT(&da == X.allocator());
+            ASSERT(1   == da.numBlocksInUse());
+
+            mX.insert(Entry(1, valueOf(1)));
+            ASSERT(1.0f / 16 == X.load_factor());
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // IMPLEMENTATION UTILITIES
+        //
+        // Concerns:
+        //: 1 'growthLimit' is 7/8 of the capacity.
+        //:
+        //: 2 'minimalCapacity' returns the smallest power of two, not less
+        //:   than 16, whose growth limit is not less than the number of
+        //:   entries, and 0 for no entries.
+        //:
+        //: 3 'roundUpCapacity' returns the smallest power of two, not less
+        //:   than 16, not less than the capacity, and 0 for 0.
+        //
+        // Plan:
+        //: 1 Verify the functions using a table-driven technique, and against
+        //:   their definition for a range of values.  (C-1..3)
+        //
+        // Testing:
+        //   static bsl::size_t growthLimit(bsl::size_t capacity);
+        //   static bsl::size_t minimalCapacity(bsl::size_t numEntries);
+        //   static bsl::size_t roundUpCapacity(bsl::size_t capacity);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "IMPLEMENTATION UTILITIES" << endl
+                          << "========================" << endl;
+
+        ASSERT(   0 == ImplUtil::growthLimit(0));
+        ASSERT(  14 == ImplUtil::growthLimit(16));
+        ASSERT(  28 == ImplUtil::growthLimit(32));
+        ASSERT( 896 == ImplUtil::growthLimit(1024));
+
+        ASSERT(   0 == ImplUtil::minimalCapacity(0));
+        ASSERT(  16 == ImplUtil::minimalCapacity(1));
+        ASSERT(  16 == ImplUtil::minimalCapacity(14));
+        ASSERT(  32 == ImplUtil::minimalCapacity(15));
+        ASSERT(1024 == ImplUtil::minimalCapacity(896));
+        ASSERT(2048 == ImplUtil::minimalCapacity(897));
+
+        ASSERT(   0 == ImplUtil::roundUpCapacity(0));
+        ASSERT(  16 == ImplUtil::roundUpCapacity(1));
+        ASSERT(  16 == ImplUtil::roundUpCapacity(16));
+        ASSERT(  32 == ImplUtil::roundUpCapacity(17));
+
+        for (bsl::size_t n = 1; n < 5000; ++n) {
+            const bsl::size_t MIN = ImplUtil::minimalCapacity(n);
+            const bsl::size_t UP  = ImplUtil::roundUpCapacity(n);
+
+            ASSERTV(n, 0 == (MIN & (MIN - 1)));
+            ASSERTV(n, 16 <= MIN);
+            ASSERTV(n, n <= ImplUtil::growthLimit(MIN));
+            ASSERTV(n, 16 == MIN || n > ImplUtil::growthLimit(MIN / 2));
+
+            ASSERTV(n, 0 == (UP & (UP - 1)));
+            ASSERTV(n, 16 <= UP);
+            ASSERTV(n, n <= UP);
+            ASSERTV(n, 16 == UP || n > UP / 2);
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Insert, find, iterate over, and erase a few entries.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        Obj mX(0, TestHash(0), bsl::equal_to<int>(), &sa);
+        const Obj& X = mX;
+
+        ASSERT(0 == X.size());
+        ASSERT(0 == sa.numBlocksTotal());
+
+        ASSERT(true  == mX.insert(Entry(1, "one")).second);
+        ASSERT(true  == mX.insert(Entry(2, "two")).second);
+        ASSERT(false == mX.insert(Entry(1, "uno")).second);
+        ASSERT(2 == X.size());
+        ASSERT(16 == X.capacity());
+
+        ASSERT("one" == X.find(1)->second);
+        ASSERT("two" == X.find(2)->second);
+        ASSERT(X.end() == X.find(3));
+
+        int sum = 0;
+        for (Obj::const_iterator it = X.begin(); it != X.end(); ++it) {
+            sum += it->first;
+        }
+        ASSERT(3 == sum);
+
+        ASSERT(1 == mX.erase(1));
+        ASSERT(0 == mX.erase(1));
+        ASSERT(1 == X.size());
+        ASSERT(false == X.contains(1));
+        ASSERT(true  == X.contains(2));
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
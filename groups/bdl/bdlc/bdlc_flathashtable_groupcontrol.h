@@ -0,0 +1,254 @@
+// bdlc_flathashtable_groupcontrol.h                                  -*-C++-*-
+#ifndef INCLUDED_BDLC_FLATHASHTABLE_GROUPCONTROL
+#define INCLUDED_BDLC_FLATHASHTABLE_GROUPCONTROL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide inquiries to a flat hash table group of control values.
+//
+//@CLASSES:
+//  bdlc::FlatHashTable_GroupControl: flat hash table group control inquiries
+//
+//@SEE_ALSO: bdlc_flathashtable
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'bdlc::FlatHashTable_GroupControl', for inquiring about a *group* of
+// 'k_SIZE' consecutive *control* *bytes* of a 'bdlc::FlatHashTable'.  Each
+// slot of a flat hash table has a control byte that is either 'k_EMPTY' (the
+// slot has never held an entry since the table was last rehashed),
+// 'k_ERASED' (the slot held an entry that was erased), or, when the slot holds
+// an entry, the lowest 7 bits of the hash value of the key of the entry
+// (leaving the highest bit of the control byte unset).  A
+// 'bdlc::FlatHashTable_GroupControl' loads a group of control bytes and
+// returns, as a bit mask whose bit 'i' corresponds to the control byte at
+// offset 'i' in the group, the slots matching a given hash value, the slots
+// available for insertion, or the slots in use.
+//
+// Where SSE2 instructions are available, a group is loaded into a 128-bit
+// register and each inquiry is answered by a couple of vector instructions;
+// otherwise, the control bytes are examined one at a time.  This class is an
+// implementation detail of 'bdlc_flathashtable', and should not be used
+// directly.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Slots Matching a Hash Value
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a group of control bytes, in which the slots at offsets 2
+// and 9 hold entries whose hash values end with the bits '0x35', the slot at
+// offset 4 held an erased entry, and the slot at offset 5 holds an entry whose
+// hash value ends with the bits '0x11':
+//..
+//  typedef bdlc::FlatHashTable_GroupControl GroupControl;
+//
+//  bsl::uint8_t controls[GroupControl::k_SIZE];
+//  bsl::memset(controls, GroupControl::k_EMPTY, sizeof controls);
+//  controls[2] = 0x35;
+//  controls[4] = GroupControl::k_ERASED;
+//  controls[5] = 0x11;
+//  controls[9] = 0x35;
+//..
+// First, we load the group:
+//..
+//  GroupControl group(controls);
+//..
+// Then, we find the slots whose hash value matches '0x35':
+//..
+//  assert(((1 << 2) | (1 << 9)) == group.match(0x35));
+//..
+// Finally, we observe that the group has empty slots, so that a search for a
+// key need not continue past it, and that all but 3 slots are available:
+//..
+//  assert(true == group.neverFull());
+//  assert(((1 << 2) | (1 << 5) | (1 << 9)) == group.inUse());
+//  assert(0xffff - group.inUse() == group.available());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDINT
+#include <bsl_cstdint.h>
+#endif
+
+#if defined(BSLS_PLATFORM_CPU_X86_64) || defined(__SSE2__)
+#define BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2 1
+#ifndef INCLUDED_EMMINTRIN
+#include <emmintrin.h>
+#define INCLUDED_EMMINTRIN
+#endif
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                      // ================================
+                      // class FlatHashTable_GroupControl
+                      // ================================
+
+class FlatHashTable_GroupControl {
+    // This class provides inquiries to a group of 'k_SIZE' control bytes of a
+    // flat hash table.
+
+  public:
+    // TYPES
+    typedef unsigned int BitMask;
+        // Bit mask of the slots of a group, the bit 'i' corresponding to the
+        // control byte at offset 'i'.
+
+    // CONSTANTS
+    static const bsl::uint8_t k_EMPTY  = 0x80;  // control byte of an empty
+                                                // slot
+
+    static const bsl::uint8_t k_ERASED = 0xC0;  // control byte of a slot
+                                                // whose entry was erased
+
+    enum { k_SIZE = 16 };                       // number of control bytes in
+                                                // a group
+
+  private:
+    // DATA
+#ifdef BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2
+    __m128i             d_value;   // control bytes of the group
+#else
+    const bsl::uint8_t *d_data_p;  // control bytes of the group
+#endif
+
+    // NOT IMPLEMENTED
+    FlatHashTable_GroupControl(const FlatHashTable_GroupControl&);
+    FlatHashTable_GroupControl& operator=(const FlatHashTable_GroupControl&);
+
+  public:
+    // CREATORS
+    explicit FlatHashTable_GroupControl(const bsl::uint8_t *data);
+        // Create a group control object for the 'k_SIZE' control bytes at the
+        // specified 'data' address.  The behavior is undefined unless 'data'
+        // refers to at least 'k_SIZE' bytes that are not modified during the
+        // lifetime of this object.
+
+    // ACCESSORS
+    BitMask available() const;
+        // Return a bit mask of the slots of this group that are available for
+        // insertion, i.e., whose control byte is 'k_EMPTY' or 'k_ERASED'.
+
+    BitMask inUse() const;
+        // Return a bit mask of the slots of this group that hold an entry.
+
+    BitMask match(bsl::uint8_t value) const;
+        // Return a bit mask of the slots of this group whose control byte is
+        // the specified 'value'.  The behavior is undefined unless
+        // '0 == (value & 0x80)', 'k_EMPTY == value', or 'k_ERASED == value'.
+
+    bool neverFull() const;
+        // Return 'true' if at least one slot of this group is empty, i.e.,
+        // has a 'k_EMPTY' control byte, and 'false' otherwise.  Note that a
+        // search for a key never needs to continue past a group that has an
+        // empty slot, as the key would have been inserted in that slot.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                      // --------------------------------
+                      // class FlatHashTable_GroupControl
+                      // --------------------------------
+
+// CREATORS
+inline
+FlatHashTable_GroupControl::FlatHashTable_GroupControl(
+                                                    const bsl::uint8_t *data)
+{
+    BSLS_ASSERT_SAFE(data);
+
+#ifdef BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2
+    d_value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+#else
+    d_data_p = data;
+#endif
+}
+
+// ACCESSORS
+inline
+FlatHashTable_GroupControl::BitMask
+FlatHashTable_GroupControl::available() const
+{
+#ifdef BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2
+    return static_cast<BitMask>(_mm_movemask_epi8(d_value));
+#else
+    BitMask result = 0;
+    for (int i = 0; i < k_SIZE; ++i) {
+        result |= static_cast<BitMask>(d_data_p[i] >> 7) << i;
+    }
+    return result;
+#endif
+}
+
+inline
+FlatHashTable_GroupControl::BitMask
+FlatHashTable_GroupControl::inUse() const
+{
+    return available() ^ ((1u << k_SIZE) - 1);
+}
+
+inline
+FlatHashTable_GroupControl::BitMask
+FlatHashTable_GroupControl::match(bsl::uint8_t value) const
+{
+#ifdef BDLC_FLATHASHTABLE_GROUPCONTROL_USE_SSE2
+    const __m128i values = _mm_set1_epi8(static_cast<char>(value));
+    return static_cast<BitMask>(
+                     _mm_movemask_epi8(_mm_cmpeq_epi8(values, d_value)));
+#else
+    BitMask result = 0;
+    for (int i = 0; i < k_SIZE; ++i) {
+        result |= static_cast<BitMask>(value == d_data_p[i]) << i;
+    }
+    return result;
+#endif
+}
+
+inline
+bool FlatHashTable_GroupControl::neverFull() const
+{
+    return 0 != match(k_EMPTY);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
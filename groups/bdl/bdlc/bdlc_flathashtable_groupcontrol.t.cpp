@@ -0,0 +1,350 @@
+// bdlc_flathashtable_groupcontrol.t.cpp                              -*-C++-*-
+#include <bdlc_flathashtable_groupcontrol.h>
+
+#include <bslim_testutil.h>
+
+#include <bsls_asserttest.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides inquiries on a group of control bytes.
+// Each inquiry is verified against the expected bit mask computed, one byte
+// at a time, by the test driver, for groups of control bytes covering every
+// position of the empty, erased, and in-use control values.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit FlatHashTable_GroupControl(const bsl::uint8_t *data);
+//
+// ACCESSORS
+// [ 2] BitMask available() const;
+// [ 2] BitMask inUse() const;
+// [ 2] BitMask match(bsl::uint8_t value) const;
+// [ 2] bool neverFull() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+#define ASSERT_OPT_FAIL_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL_RAW(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlc::FlatHashTable_GroupControl Obj;
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int            test = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    int         verbose = argc > 2;
+    int     veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 3: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Slots Matching a Hash Value
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a group of control bytes, in which the slots at offsets 2
+// and 9 hold entries whose hash values end with the bits '0x35', the slot at
+// offset 4 held an erased entry, and the slot at offset 5 holds an entry whose
+// hash value ends with the bits '0x11':
+//..
+    typedef bdlc::FlatHashTable_GroupControl GroupControl;
+
+    bsl::uint8_t controls[GroupControl::k_SIZE];
+    bsl::memset(controls, GroupControl::k_EMPTY, sizeof controls);
+    controls[2] = 0x35;
+    controls[4] = GroupControl::k_ERASED;
+    controls[5] = 0x11;
+    controls[9] = 0x35;
+//..
+// First, we load the group:
+//..
+    GroupControl group(controls);
+//..
+// Then, we find the slots whose hash value matches '0x35':
+//..
+    ASSERT(((1 << 2) | (1 << 9)) == group.match(0x35));
+//..
+// Finally, we observe that the group has empty slots, so that a search for a
+// key need not continue past it, and that all but 3 slots are available:
+//..
+    ASSERT(true == group.neverFull());
+    ASSERT(((1 << 2) | (1 << 5) | (1 << 9)) == group.inUse());
+    ASSERT(0xffff - group.inUse() == group.available());
+//..
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // INQUIRIES
+        //
+        // Concerns:
+        //: 1 'match' returns the bit mask of the control bytes having the
+        //:   specified value, for hash values, 'k_EMPTY', and 'k_ERASED'.
+        //:
+        //: 2 'available' returns the bit mask of the 'k_EMPTY' and 'k_ERASED'
+        //:   control bytes, and 'inUse' its complement.
+        //:
+        //: 3 'neverFull' returns 'true' if and only if a control byte is
+        //:   'k_EMPTY'.
+        //:
+        //: 4 The data need not be aligned.
+        //
+        // Plan:
+        //: 1 For every offset in a buffer, load a group whose control bytes
+        //:   are generated pseudo-randomly from a set of hash values and the
+        //:   'k_EMPTY' and 'k_ERASED' values, and compare the result of each
+        //:   inquiry to the bit mask computed by examining the bytes one at a
+        //:   time.  (C-1..4)
+        //
+        // Testing:
+        //   explicit FlatHashTable_GroupControl(const bsl::uint8_t *data);
+        //   BitMask available() const;
+        //   BitMask inUse() const;
+        //   BitMask match(bsl::uint8_t value) const;
+        //   bool neverFull() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INQUIRIES" << endl
+                          << "=========" << endl;
+
+        const bsl::uint8_t VALUES[] = { Obj::k_EMPTY, Obj::k_ERASED,
+                                        0x00, 0x01, 0x35, 0x7F };
+        const int NUM_VALUES = static_cast<int>(sizeof VALUES);
+
+        bsl::uint8_t buffer[Obj::k_SIZE + 16];
+
+        unsigned int seed = 12345;
+        for (int iteration = 0; iteration < 2000; ++iteration) {
+            for (int i = 0; i < static_cast<int>(sizeof buffer); ++i) {
+                seed = seed * 1103515245 + 12345;
+
+                // Make groups without empty slots frequent.
+
+                const int choice = (seed >> 16) % (NUM_VALUES + 4);
+                buffer[i] = choice < NUM_VALUES ? VALUES[choice] : 0x35;
+            }
+
+            for (int offset = 0; offset < 16; ++offset) {
+                const bsl::uint8_t *DATA = buffer + offset;
+                const Obj           X(DATA);
+
+                Obj::BitMask expAvailable = 0;
+                bool         expNeverFull = false;
+                for (int i = 0; i < Obj::k_SIZE; ++i) {
+                    if (DATA[i] & 0x80) {
+                        expAvailable |= 1u << i;
+                    }
+                    if (Obj::k_EMPTY == DATA[i]) {
+                        expNeverFull = true;
+                    }
+                }
+
+                if (veryVerbose) {
+                    P_(offset) P_(expAvailable) P(expNeverFull)
+                }
+
+                ASSERTV(offset, expAvailable, X.available(),
+                        expAvailable == X.available());
+                ASSERTV(offset, expAvailable, X.inUse(),
+                        (expAvailable ^ 0xffff) == X.inUse());
+                ASSERTV(offset, expNeverFull, X.neverFull(),
+                        expNeverFull == X.neverFull());
+
+                for (int v = 0; v < NUM_VALUES; ++v) {
+                    Obj::BitMask expMatch = 0;
+                    for (int i = 0; i < Obj::k_SIZE; ++i) {
+                        if (VALUES[v] == DATA[i]) {
+                            expMatch |= 1u << i;
+                        }
+                    }
+                    ASSERTV(offset, v, expMatch, X.match(VALUES[v]),
+                            expMatch == X.match(VALUES[v]));
+                }
+            }
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Inquire about groups that are entirely empty, entirely erased,
+        //:   and entirely in use.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bsl::uint8_t data[Obj::k_SIZE];
+
+        bsl::memset(data, Obj::k_EMPTY, sizeof data);
+        {
+            const Obj X(data);
+
+            ASSERT(0xffff == X.available());
+            ASSERT(0      == X.inUse());
+            ASSERT(0xffff == X.match(Obj::k_EMPTY));
+            ASSERT(0      == X.match(Obj::k_ERASED));
+            ASSERT(0      == X.match(0));
+            ASSERT(true   == X.neverFull());
+        }
+
+        bsl::memset(data, Obj::k_ERASED, sizeof data);
+        {
+            const Obj X(data);
+
+            ASSERT(0xffff == X.available());
+            ASSERT(0      == X.inUse());
+            ASSERT(0      == X.match(Obj::k_EMPTY));
+            ASSERT(0xffff == X.match(Obj::k_ERASED));
+            ASSERT(false  == X.neverFull());
+        }
+
+        bsl::memset(data, 0x12, sizeof data);
+        {
+            const Obj X(data);
+
+            ASSERT(0      == X.available());
+            ASSERT(0xffff == X.inUse());
+            ASSERT(0xffff == X.match(0x12));
+            ASSERT(0      == X.match(0x13));
+            ASSERT(false  == X.neverFull());
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1646 @@
+// bdlc_smallvector.h                                                 -*-C++-*-
+#ifndef INCLUDED_BDLC_SMALLVECTOR
+#define INCLUDED_BDLC_SMALLVECTOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a vector storing a small number of elements inline.
+//
+//@CLASSES:
+//  bdlc::SmallVector: vector with inline storage for a few elements
+//  bdlc::SmallVector_EndProctor: restores the size after a failed relocation
+//
+//@SEE_ALSO: bslstl_vector, bslalg_arrayprimitives
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlc::SmallVector', implementing a sequence of elements of (template
+// parameter) type 'TYPE', stored contiguously, whose interface is a subset of
+// that of 'bsl::vector'.  Unlike a 'bsl::vector', which allocates memory for
+// its first element, a 'bdlc::SmallVector' has room for (template parameter)
+// 'INLINE_CAPACITY' elements within its own footprint, and uses its allocator
+// only when it grows beyond that many elements (it then *spills*, moving its
+// elements into allocated memory, as a 'bsl::vector' does when it grows).  A
+// 'bdlc::SmallVector' is best suited to sequences that usually hold few
+// elements, such as the repeated fields of a message, for which the cost of
+// allocating and freeing memory would dominate that of using the sequence.
+// The price of this layout is a larger footprint, and the fact that, unlike
+// those of a 'bsl::vector', the elements of a 'bdlc::SmallVector' that has
+// not spilled are moved when the vector itself is moved or swapped.
+//
+// Elements are created, moved, and destroyed using 'bslalg::ArrayPrimitives',
+// so that elements whose type is bitwise moveable (see
+// 'bslmf_isbitwisemoveable') are relocated with 'memcpy' when the vector
+// spills or grows, and elements that use a 'bslma::Allocator' are supplied
+// with the allocator of the vector.  A 'bdlc::SmallVector' holds no pointer
+// into its own footprint, so that it is itself bitwise moveable if 'TYPE' is:
+// for example, growing a 'bsl::vector' of 'bdlc::SmallVector<int, 4>' objects
+// relocates them with 'memcpy'.
+//
+// A 'bdlc::SmallVector' provides the same exception-safety guarantees as a
+// 'bsl::vector', except for 'swap', which provides the no-throw guarantee
+// only if 'TYPE' is bitwise moveable, or neither vector stores its elements
+// inline.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Storing the Legs of an Order
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that we are decoding orders, each of which has one or more legs,
+// and that very few orders have more than 4 legs.
+//
+// First, we define the type of a leg:
+//..
+//  struct Leg {
+//      // This 'struct' describes a leg of an order.
+//
+//      int    d_instrumentId;  // identifier of the instrument
+//      int    d_quantity;      // signed quantity
+//      double d_price;         // limit price
+//  };
+//..
+// Then, we create a vector of legs having room for 4 legs inline, using a
+// test allocator so that we can observe its use of memory:
+//..
+//  bslma::TestAllocator          allocator;
+//  bdlc::SmallVector<Leg, 4>     legs(&allocator);
+//
+//  assert(4    == legs.capacity());
+//  assert(true == legs.isInline());
+//..
+// Next, we add the legs of a spread order, and observe that no memory is
+// allocated:
+//..
+//  const Leg buy  = { 101,  10, 99.5  };
+//  const Leg sell = { 102, -10, 100.25 };
+//
+//  legs.push_back(buy);
+//  legs.push_back(sell);
+//
+//  assert(2   == legs.size());
+//  assert(102 == legs[1].d_instrumentId);
+//  assert(0   == allocator.numBlocksTotal());
+//..
+// Now, we add the legs of an unusually large order, and observe that the
+// vector spills its legs into allocated memory:
+//..
+//  for (int i = 0; i < 3; ++i) {
+//      legs.push_back(buy);
+//  }
+//
+//  assert(5     == legs.size());
+//  assert(false == legs.isInline());
+//  assert(1     == allocator.numBlocksInUse());
+//..
+// Finally, we remove the extra legs and return the remaining ones to the
+// inline storage, releasing the allocated memory:
+//..
+//  legs.erase(legs.begin() + 2, legs.end());
+//  legs.shrink_to_fit();
+//
+//  assert(2    == legs.size());
+//  assert(true == legs.isInline());
+//  assert(0    == allocator.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_ARRAYDESTRUCTIONPRIMITIVES
+#include <bslalg_arraydestructionprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_ARRAYPRIMITIVES
+#include <bslalg_arrayprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SWAPUTIL
+#include <bslalg_swaputil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_CONSTRUCTIONUTIL
+#include <bslma_constructionutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEALLOCATORPROCTOR
+#include <bslma_deallocatorproctor.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DESTRUCTIONUTIL
+#include <bslma_destructionutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ASSERT
+#include <bslmf_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_INTEGRALCONSTANT
+#include <bslmf_integralconstant.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISINTEGRAL
+#include <bslmf_isintegral.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNEDBUFFER
+#include <bsls_alignedbuffer.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTFROMTYPE
+#include <bsls_alignmentfromtype.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STDEXCEPTUTIL
+#include <bslstl_stdexceptutil.h>
+#endif
+
+#ifndef INCLUDED_BSL_ALGORITHM
+#include <bsl_algorithm.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTRING
+#include <bsl_cstring.h>
+#endif
+
+#ifndef INCLUDED_BSL_ITERATOR
+#include <bsl_iterator.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlc {
+
+                       // ============================
+                       // class SmallVector_EndProctor
+                       // ============================
+
+template <class TYPE>
+class SmallVector_EndProctor {
+    // This class implements a proctor that, on destruction, stores the number
+    // of elements in the range '[begin, end)' into a size, where 'end' is
+    // updated by 'bslalg::ArrayPrimitives' as the elements of the range are
+    // moved out of it, so that the size accounts only for the elements that
+    // remain valid if the move fails.
+
+    // DATA
+    TYPE        *d_begin_p;  // first element of the range
+    TYPE        *d_end_p;    // end of the valid elements of the range
+    bsl::size_t *d_size_p;   // size to update on destruction (held)
+
+  private:
+    // NOT IMPLEMENTED
+    SmallVector_EndProctor(const SmallVector_EndProctor&);
+    SmallVector_EndProctor& operator=(const SmallVector_EndProctor&);
+
+  public:
+    // CREATORS
+    SmallVector_EndProctor(TYPE *begin, bsl::size_t *size);
+        // Create a proctor for the range of '*size' elements starting at the
+        // specified 'begin' address, that updates the specified 'size' on
+        // destruction.
+
+    ~SmallVector_EndProctor();
+        // Load the number of elements in the range '[begin, end)' into the
+        // size supplied at construction.
+
+    // MANIPULATORS
+    TYPE **endAddress();
+        // Return the address of the end of the valid elements of the range,
+        // to be updated as the elements are moved out of the range.
+};
+
+                            // =================
+                            // class SmallVector
+                            // =================
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+class SmallVector {
+    // This class template implements a value-semantic sequence of elements of
+    // (template parameter) type 'TYPE', stored contiguously, either inline,
+    // if there are at most (template parameter) 'INLINE_CAPACITY' of them, or
+    // in memory supplied by an allocator.
+
+    BSLMF_ASSERT(0 < INLINE_CAPACITY);
+
+    // PRIVATE TYPES
+    typedef bslalg::ArrayPrimitives                ArrayPrimitives;
+    typedef bslalg::ArrayDestructionPrimitives     ArrayDestructionPrimitives;
+
+    typedef bsls::AlignedBuffer<INLINE_CAPACITY * sizeof(TYPE),
+                                bsls::AlignmentFromType<TYPE>::VALUE>
+                                                   InlineBuffer;
+
+  public:
+    // TYPES
+    typedef TYPE                                   value_type;
+    typedef TYPE&                                  reference;
+    typedef const TYPE&                            const_reference;
+    typedef TYPE                                  *pointer;
+    typedef const TYPE                            *const_pointer;
+    typedef TYPE                                  *iterator;
+    typedef const TYPE                            *const_iterator;
+    typedef bsl::reverse_iterator<iterator>        reverse_iterator;
+    typedef bsl::reverse_iterator<const_iterator>  const_reverse_iterator;
+    typedef bsl::size_t                            size_type;
+    typedef bsl::ptrdiff_t                         difference_type;
+
+  private:
+    // DATA
+    InlineBuffer      d_inline;       // storage of the elements if they are
+                                      // inline
+
+    TYPE             *d_heap_p;       // allocated storage of the elements
+                                      // (owned), or 0 if they are inline
+
+    size_type         d_size;         // number of elements
+
+    size_type         d_capacity;     // number of elements that can be
+                                      // stored without allocating memory
+
+    bslma::Allocator *d_allocator_p;  // memory allocator (held, not owned)
+
+    // PRIVATE MANIPULATORS
+    TYPE *allocateElements(size_type numElements);
+        // Return the address of newly allocated memory for the specified
+        // 'numElements' elements.
+
+    void adopt(TYPE *elements, size_type capacity, size_type size);
+        // Release the allocated storage of this vector, if any, and make the
+        // specified 'elements', an allocated array of the specified
+        // 'capacity' elements, the first specified 'size' of which are valid,
+        // the storage of this vector.  The behavior is undefined unless the
+        // elements of this vector have been destroyed or moved into
+        // 'elements'.
+
+    template <class INPUT_ITERATOR>
+    void insertDispatch(const_iterator  position,
+                        INPUT_ITERATOR  first,
+                        INPUT_ITERATOR  last,
+                        bsl::true_type);
+    template <class INPUT_ITERATOR>
+    void insertDispatch(const_iterator  position,
+                        INPUT_ITERATOR  first,
+                        INPUT_ITERATOR  last,
+                        bsl::false_type);
+        // Insert, at the specified 'position', the elements in the range
+        // '[first, last)' if the last parameter is 'bsl::false_type';
+        // otherwise 'first' and 'last' are integral values, and insert 'first'
+        // copies of 'last' (as 'bsl::vector' does).
+
+    template <class INPUT_ITERATOR>
+    void insertRange(const_iterator                 position,
+                     INPUT_ITERATOR                 first,
+                     INPUT_ITERATOR                 last,
+                     const bsl::input_iterator_tag&);
+    template <class FORWARD_ITERATOR>
+    void insertRange(const_iterator                   position,
+                     FORWARD_ITERATOR                 first,
+                     FORWARD_ITERATOR                 last,
+                     const bsl::forward_iterator_tag&);
+        // Insert, at the specified 'position', the elements in the range
+        // '[first, last)' traversed by iterators of the category of the last
+        // parameter.
+
+    void spillAndInsert(const_iterator position,
+                        size_type      numElements,
+                        const TYPE&    value);
+        // Move the elements of this vector to newly allocated storage large
+        // enough to hold 'size() + numElements' elements, inserting the
+        // specified 'numElements' copies of the specified 'value' at the
+        // specified 'position'.
+
+    // PRIVATE ACCESSORS
+    size_type grownCapacity(size_type minimumCapacity) const;
+        // Return the capacity to allocate for a vector that needs to hold the
+        // specified 'minimumCapacity' elements, doubling the current capacity
+        // if that is enough.  Throw 'std::length_error' if 'minimumCapacity'
+        // exceeds 'max_size()'.
+
+  public:
+    // CREATORS
+    explicit SmallVector(bslma::Allocator *basicAllocator = 0);
+        // Create an empty vector.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    explicit SmallVector(size_type         numElements,
+                         bslma::Allocator *basicAllocator = 0);
+        // Create a vector of the specified 'numElements' default-constructed
+        // elements.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.
+
+    SmallVector(size_type         numElements,
+                const TYPE&       value,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a vector of the specified 'numElements' copies of the
+        // specified 'value'.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    template <class INPUT_ITERATOR>
+    SmallVector(INPUT_ITERATOR    first,
+                INPUT_ITERATOR    last,
+                bslma::Allocator *basicAllocator = 0);
+        // Create a vector holding copies of the elements in the specified
+        // range '[first, last)'.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless 'first'
+        // and 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last'.  Note that, as for 'bsl::vector', if
+        // 'INPUT_ITERATOR' is an integral type, this constructor creates a
+        // vector of 'first' copies of 'last'.
+
+    SmallVector(const SmallVector&  original,
+                bslma::Allocator   *basicAllocator = 0);
+        // Create a vector having the same value as the specified 'original'
+        // vector.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  Note that the capacity of the new vector is the
+        // larger of 'INLINE_CAPACITY' and 'original.size()'.
+
+    ~SmallVector();
+        // Destroy this object.
+
+    // MANIPULATORS
+    SmallVector& operator=(const SmallVector& rhs);
+        // Assign to this object the value of the specified 'rhs' object, and
+        // return a reference providing modifiable access to this object.
+
+    void assign(size_type numElements, const TYPE& value);
+        // Assign to this vector the specified 'numElements' copies of the
+        // specified 'value'.
+
+    template <class INPUT_ITERATOR>
+    void assign(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        // Assign to this vector copies of the elements in the specified range
+        // '[first, last)'.  The behavior is undefined unless 'first' and
+        // 'last' refer to a sequence of valid values where 'first' is at a
+        // position at or before 'last', and that are not elements of this
+        // vector.
+
+    reference operator[](size_type position);
+        // Return a reference providing modifiable access to the element at
+        // the specified 'position'.  The behavior is undefined unless
+        // 'position < size()'.
+
+    reference at(size_type position);
+        // Return a reference providing modifiable access to the element at
+        // the specified 'position'.  Throw 'std::out_of_range' if
+        // 'position >= size()'.
+
+    reference front();
+        // Return a reference providing modifiable access to the first element
+        // of this vector.  The behavior is undefined unless this vector is not
+        // empty.
+
+    reference back();
+        // Return a reference providing modifiable access to the last element
+        // of this vector.  The behavior is undefined unless this vector is not
+        // empty.
+
+    TYPE *data();
+        // Return the address of the modifiable first element of this vector.
+
+    void clear();
+        // Remove all elements from this vector.  Note that the capacity of
+        // this vector is unchanged.
+
+    iterator erase(const_iterator position);
+        // Remove the element at the specified 'position', and return an
+        // iterator referring to the element following it, or 'end()' if there
+        // is no such element.  The behavior is undefined unless 'position'
+        // refers to an element of this vector.
+
+    iterator erase(const_iterator first, const_iterator last);
+        // Remove the elements in the specified range '[first, last)', and
+        // return an iterator referring to the element following them, or
+        // 'end()' if there is no such element.  The behavior is undefined
+        // unless 'first' and 'last' refer to elements of this vector (or
+        // 'end()'), and 'first' is at a position at or before 'last'.
+
+    iterator insert(const_iterator position, const TYPE& value);
+        // Insert a copy of the specified 'value' at the specified 'position',
+        // and return an iterator referring to the inserted element.  If this
+        // vector is full, its elements are moved into newly allocated storage,
+        // invalidating all iterators, pointers, and references to them.  The
+        // behavior is undefined unless 'position' refers to an element of this
+        // vector or is 'end()'.
+
+    iterator insert(const_iterator position,
+                    size_type      numElements,
+                    const TYPE&    value);
+        // Insert the specified 'numElements' copies of the specified 'value'
+        // at the specified 'position', and return an iterator referring to the
+        // first inserted element, or 'position' if 'numElements' is 0.  The
+        // behavior is undefined unless 'position' refers to an element of this
+        // vector or is 'end()'.
+
+    template <class INPUT_ITERATOR>
+    iterator insert(const_iterator position,
+                    INPUT_ITERATOR first,
+                    INPUT_ITERATOR last);
+        // Insert, at the specified 'position', copies of the elements in the
+        // specified range '[first, last)', and return an iterator referring to
+        // the first inserted element, or 'position' if the range is empty.
+        // The behavior is undefined unless 'position' refers to an element of
+        // this vector or is 'end()', and 'first' and 'last' refer to a
+        // sequence of valid values where 'first' is at a position at or before
+        // 'last', and that are not elements of this vector.
+
+    void pop_back();
+        // Remove the last element of this vector.  The behavior is undefined
+        // unless this vector is not empty.
+
+    void push_back(const TYPE& value);
+        // Append a copy of the specified 'value' to this vector.
+
+    void reserve(size_type newCapacity);
+        // Grow this vector, if needed, so that it can hold the specified
+        // 'newCapacity' elements without allocating memory.  Throw
+        // 'std::length_error' if 'newCapacity > max_size()'.
+
+    void resize(size_type newSize);
+        // Change the size of this vector to the specified 'newSize', removing
+        // its last elements or appending default-constructed elements.
+
+    void resize(size_type newSize, const TYPE& value);
+        // Change the size of this vector to the specified 'newSize', removing
+        // its last elements or appending copies of the specified 'value'.
+
+    void shrink_to_fit();
+        // Reduce the capacity of this vector to the larger of its size and
+        // 'INLINE_CAPACITY', moving its elements back inline, and releasing
+        // the allocated storage, if it has at most 'INLINE_CAPACITY'
+        // elements.
+
+                             // Iterators
+
+    iterator begin();
+        // Return an iterator referring to the first element of this vector,
+        // or 'end()' if this vector is empty.
+
+    iterator end();
+        // Return the past-the-end iterator of this vector.
+
+    reverse_iterator rbegin();
+        // Return a reverse iterator referring to the last element of this
+        // vector, or 'rend()' if this vector is empty.
+
+    reverse_iterator rend();
+        // Return the past-the-end reverse iterator of this vector.
+
+                                  // Aspects
+
+    void swap(SmallVector& other);
+        // Exchange the value of this object with that of the specified 'other'
+        // object.  This method provides the no-throw exception-safety
+        // guarantee if 'TYPE' is bitwise moveable, or if neither vector
+        // stores its elements inline.  The behavior is undefined unless this
+        // object was created with the same allocator as 'other'.
+
+    // ACCESSORS
+    const_reference operator[](size_type position) const;
+        // Return a reference providing non-modifiable access to the element at
+        // the specified 'position'.  The behavior is undefined unless
+        // 'position < size()'.
+
+    const_reference at(size_type position) const;
+        // Return a reference providing non-modifiable access to the element at
+        // the specified 'position'.  Throw 'std::out_of_range' if
+        // 'position >= size()'.
+
+    const_reference front() const;
+        // Return a reference providing non-modifiable access to the first
+        // element of this vector.  The behavior is undefined unless this
+        // vector is not empty.
+
+    const_reference back() const;
+        // Return a reference providing non-modifiable access to the last
+        // element of this vector.  The behavior is undefined unless this
+        // vector is not empty.
+
+    size_type capacity() const;
+        // Return the number of elements this vector can hold without
+        // allocating memory, which is 'INLINE_CAPACITY' if its elements are
+        // inline.
+
+    const TYPE *data() const;
+        // Return the address of the non-modifiable first element of this
+        // vector.
+
+    bool empty() const;
+        // Return 'true' if this vector has no element, and 'false' otherwise.
+
+    bool isInline() const;
+        // Return 'true' if the elements of this vector are stored inline, and
+        // 'false' if they are stored in allocated memory.
+
+    size_type max_size() const;
+        // Return the maximum number of elements a vector can hold.
+
+    size_type size() const;
+        // Return the number of elements of this vector.
+
+                             // Iterators
+
+    const_iterator begin() const;
+    const_iterator cbegin() const;
+        // Return an iterator referring to the first element of this vector, or
+        // 'end()' if this vector is empty.
+
+    const_iterator end() const;
+    const_iterator cend() const;
+        // Return the past-the-end iterator of this vector.
+
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator crbegin() const;
+        // Return a reverse iterator referring to the last element of this
+        // vector, or 'rend()' if this vector is empty.
+
+    const_reverse_iterator rend() const;
+    const_reverse_iterator crend() const;
+        // Return the past-the-end reverse iterator of this vector.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this vector to supply memory.
+};
+
+// FREE OPERATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+bool operator==(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                const SmallVector<TYPE, INLINE_CAPACITY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' vectors have the same
+    // value, and 'false' otherwise.  Two vectors have the same value if they
+    // have the same size, and their elements at each position compare equal.
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+bool operator!=(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                const SmallVector<TYPE, INLINE_CAPACITY>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' vectors do not have the
+    // same value, and 'false' otherwise.  Two vectors do not have the same
+    // value if they do not have the same size, or their elements at some
+    // position do not compare equal.
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+bool operator<(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+               const SmallVector<TYPE, INLINE_CAPACITY>& rhs);
+    // Return 'true' if the specified 'lhs' vector is lexicographically less
+    // than the specified 'rhs' vector, and 'false' otherwise.
+
+// FREE FUNCTIONS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void swap(SmallVector<TYPE, INLINE_CAPACITY>& a,
+          SmallVector<TYPE, INLINE_CAPACITY>& b);
+    // Exchange the values of the specified 'a' and 'b' vectors.  The behavior
+    // is undefined unless both vectors were created with the same allocator.
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                       // ----------------------------
+                       // class SmallVector_EndProctor
+                       // ----------------------------
+
+// CREATORS
+template <class TYPE>
+inline
+SmallVector_EndProctor<TYPE>::SmallVector_EndProctor(TYPE        *begin,
+                                                     bsl::size_t *size)
+: d_begin_p(begin)
+, d_end_p(begin + *size)
+, d_size_p(size)
+{
+}
+
+template <class TYPE>
+inline
+SmallVector_EndProctor<TYPE>::~SmallVector_EndProctor()
+{
+    *d_size_p = d_end_p - d_begin_p;
+}
+
+// MANIPULATORS
+template <class TYPE>
+inline
+TYPE **SmallVector_EndProctor<TYPE>::endAddress()
+{
+    return &d_end_p;
+}
+
+                            // -----------------
+                            // class SmallVector
+                            // -----------------
+
+// PRIVATE MANIPULATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+TYPE *SmallVector<TYPE, INLINE_CAPACITY>::allocateElements(
+                                                         size_type numElements)
+{
+    return static_cast<TYPE *>(
+                         d_allocator_p->allocate(numElements * sizeof(TYPE)));
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::adopt(TYPE      *elements,
+                                               size_type  capacity,
+                                               size_type  size)
+{
+    if (d_heap_p) {
+        d_allocator_p->deallocate(d_heap_p);
+    }
+    d_heap_p   = elements;
+    d_capacity = capacity;
+    d_size     = size;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITERATOR>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::insertDispatch(
+                                               const_iterator  position,
+                                               INPUT_ITERATOR  first,
+                                               INPUT_ITERATOR  last,
+                                               bsl::true_type)
+{
+    insert(position,
+           static_cast<size_type>(first),
+           static_cast<TYPE>(last));
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITERATOR>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::insertDispatch(
+                                               const_iterator  position,
+                                               INPUT_ITERATOR  first,
+                                               INPUT_ITERATOR  last,
+                                               bsl::false_type)
+{
+    typedef typename bsl::iterator_traits<INPUT_ITERATOR>::iterator_category
+                                                                      Category;
+
+    insertRange(position, first, last, Category());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITERATOR>
+void SmallVector<TYPE, INLINE_CAPACITY>::insertRange(
+                                       const_iterator                 position,
+                                       INPUT_ITERATOR                 first,
+                                       INPUT_ITERATOR                 last,
+                                       const bsl::input_iterator_tag&)
+{
+    // The length of the range is not known in advance: collect the elements
+    // in a temporary vector, so that this vector is unchanged if an exception
+    // is thrown, and then insert them all at once.
+
+    SmallVector temp(d_allocator_p);
+    for (; first != last; ++first) {
+        temp.push_back(*first);
+    }
+
+    insertRange(position,
+                temp.cbegin(),
+                temp.cend(),
+                bsl::forward_iterator_tag());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class FORWARD_ITERATOR>
+void SmallVector<TYPE, INLINE_CAPACITY>::insertRange(
+                                     const_iterator                   position,
+                                     FORWARD_ITERATOR                 first,
+                                     FORWARD_ITERATOR                 last,
+                                     const bsl::forward_iterator_tag&)
+{
+    const size_type numElements = bsl::distance(first, last);
+    TYPE           *pos         = const_cast<TYPE *>(position);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                       numElements > max_size() - d_size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwLengthError(
+                       "SmallVector<...>::insert(pos,first,last): too long");
+    }
+
+    const size_type newSize = d_size + numElements;
+
+    if (newSize <= d_capacity) {
+        ArrayPrimitives::insert(pos,
+                                data() + d_size,
+                                first,
+                                last,
+                                numElements,
+                                d_allocator_p);
+        d_size = newSize;
+        return;                                                       // RETURN
+    }
+
+    const size_type newCapacity = grownCapacity(newSize);
+    TYPE           *newData     = allocateElements(newCapacity);
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                        d_allocator_p);
+    {
+        TYPE                         *oldData = data();
+        SmallVector_EndProctor<TYPE>  endProctor(oldData, &d_size);
+
+        ArrayPrimitives::destructiveMoveAndInsert(newData,
+                                                  endProctor.endAddress(),
+                                                  oldData,
+                                                  pos,
+                                                  oldData + d_size,
+                                                  first,
+                                                  last,
+                                                  numElements,
+                                                  d_allocator_p);
+    }
+    proctor.release();
+
+    adopt(newData, newCapacity, newSize);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::spillAndInsert(
+                                                  const_iterator position,
+                                                  size_type      numElements,
+                                                  const TYPE&    value)
+{
+    const size_type newSize     = d_size + numElements;
+    const size_type newCapacity = grownCapacity(newSize);
+    TYPE           *newData     = allocateElements(newCapacity);
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                        d_allocator_p);
+    {
+        // Note that 'value' may be an element of this vector: it is copied
+        // before the elements are moved, and their storage is released only
+        // after the move.
+
+        TYPE                         *oldData = data();
+        SmallVector_EndProctor<TYPE>  endProctor(oldData, &d_size);
+
+        ArrayPrimitives::destructiveMoveAndInsert(
+                                              newData,
+                                              endProctor.endAddress(),
+                                              oldData,
+                                              const_cast<TYPE *>(position),
+                                              oldData + d_size,
+                                              value,
+                                              numElements,
+                                              d_allocator_p);
+    }
+    proctor.release();
+
+    adopt(newData, newCapacity, newSize);
+}
+
+// PRIVATE ACCESSORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::size_type
+SmallVector<TYPE, INLINE_CAPACITY>::grownCapacity(
+                                               size_type minimumCapacity) const
+{
+    const size_type maxSize = max_size();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(minimumCapacity > maxSize)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwLengthError(
+                                    "SmallVector<...>: capacity too large");
+    }
+
+    if (d_capacity > maxSize / 2) {
+        return maxSize;                                               // RETURN
+    }
+    return bsl::max(d_capacity * 2, minimumCapacity);
+}
+
+// CREATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                              bslma::Allocator *basicAllocator)
+: d_heap_p(0)
+, d_size(0)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                              size_type         numElements,
+                                              bslma::Allocator *basicAllocator)
+: d_heap_p(0)
+, d_size(0)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    resize(numElements);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                              size_type         numElements,
+                                              const TYPE&       value,
+                                              bslma::Allocator *basicAllocator)
+: d_heap_p(0)
+, d_size(0)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    insert(cend(), numElements, value);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITERATOR>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                              INPUT_ITERATOR    first,
+                                              INPUT_ITERATOR    last,
+                                              bslma::Allocator *basicAllocator)
+: d_heap_p(0)
+, d_size(0)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    insert(cend(), first, last);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>::SmallVector(
+                                            const SmallVector&  original,
+                                            bslma::Allocator   *basicAllocator)
+: d_heap_p(0)
+, d_size(0)
+, d_capacity(INLINE_CAPACITY)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    if (original.d_size <= INLINE_CAPACITY) {
+        ArrayPrimitives::copyConstruct(
+                                  reinterpret_cast<TYPE *>(d_inline.buffer()),
+                                  original.data(),
+                                  original.data() + original.d_size,
+                                  d_allocator_p);
+        d_size = original.d_size;
+        return;                                                       // RETURN
+    }
+
+    // Allocate exactly the needed capacity, as 'bsl::vector' does for a copy.
+
+    TYPE *newData = allocateElements(original.d_size);
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                        d_allocator_p);
+
+    ArrayPrimitives::copyConstruct(newData,
+                                   original.data(),
+                                   original.data() + original.d_size,
+                                   d_allocator_p);
+    proctor.release();
+
+    adopt(newData, original.d_size, original.d_size);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>::~SmallVector()
+{
+    ArrayDestructionPrimitives::destroy(data(), data() + d_size);
+    if (d_heap_p) {
+        d_allocator_p->deallocate(d_heap_p);
+    }
+}
+
+// MANIPULATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+SmallVector<TYPE, INLINE_CAPACITY>&
+SmallVector<TYPE, INLINE_CAPACITY>::operator=(const SmallVector& rhs)
+{
+    if (this != &rhs) {
+        if (rhs.d_size > d_capacity) {
+            // Copy into new storage first, so that this vector is unchanged
+            // if an exception is thrown.
+
+            const size_type newCapacity = grownCapacity(rhs.d_size);
+            TYPE           *newData     = allocateElements(newCapacity);
+
+            bslma::DeallocatorProctor<bslma::Allocator> proctor(
+                                                               newData,
+                                                               d_allocator_p);
+
+            ArrayPrimitives::copyConstruct(newData,
+                                           rhs.data(),
+                                           rhs.data() + rhs.d_size,
+                                           d_allocator_p);
+            proctor.release();
+
+            ArrayDestructionPrimitives::destroy(data(), data() + d_size);
+            adopt(newData, newCapacity, rhs.d_size);
+        }
+        else if (rhs.d_size <= d_size) {
+            bsl::copy(rhs.begin(), rhs.end(), begin());
+            erase(begin() + rhs.d_size, end());
+        }
+        else {
+            bsl::copy(rhs.begin(), rhs.begin() + d_size, begin());
+            insertRange(cend(),
+                        rhs.begin() + d_size,
+                        rhs.end(),
+                        bsl::forward_iterator_tag());
+        }
+    }
+    return *this;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::assign(size_type   numElements,
+                                                const TYPE& value)
+{
+    if (numElements > d_capacity) {
+        // Note that 'value' may be an element of this vector, which is
+        // destroyed only after 'value' has been copied.
+
+        const size_type newCapacity = grownCapacity(numElements);
+        TYPE           *newData     = allocateElements(newCapacity);
+
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                            d_allocator_p);
+
+        ArrayPrimitives::uninitializedFillN(newData,
+                                            numElements,
+                                            value,
+                                            d_allocator_p);
+        proctor.release();
+
+        ArrayDestructionPrimitives::destroy(data(), data() + d_size);
+        adopt(newData, newCapacity, numElements);
+    }
+    else if (numElements <= d_size) {
+        bsl::fill_n(begin(), numElements, value);
+        erase(begin() + numElements, end());
+    }
+    else {
+        bsl::fill_n(begin(), d_size, value);
+        ArrayPrimitives::uninitializedFillN(data() + d_size,
+                                            numElements - d_size,
+                                            value,
+                                            d_allocator_p);
+        d_size = numElements;
+    }
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITERATOR>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::assign(INPUT_ITERATOR first,
+                                                INPUT_ITERATOR last)
+{
+    clear();
+    insert(cend(), first, last);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::operator[](size_type position)
+{
+    BSLS_ASSERT_SAFE(position < d_size);
+
+    return data()[position];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::at(size_type position)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(position >= d_size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwOutOfRange(
+                                "SmallVector<...>::at(position): invalid");
+    }
+    return data()[position];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::front()
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return data()[0];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reference
+SmallVector<TYPE, INLINE_CAPACITY>::back()
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return data()[d_size - 1];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+TYPE *SmallVector<TYPE, INLINE_CAPACITY>::data()
+{
+    return d_heap_p ? d_heap_p : reinterpret_cast<TYPE *>(d_inline.buffer());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::clear()
+{
+    ArrayDestructionPrimitives::destroy(data(), data() + d_size);
+    d_size = 0;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::erase(const_iterator position)
+{
+    BSLS_ASSERT_SAFE(cbegin() <= position);
+    BSLS_ASSERT_SAFE(position <  cend());
+
+    return erase(position, position + 1);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::erase(const_iterator first,
+                                          const_iterator last)
+{
+    BSLS_ASSERT_SAFE(cbegin() <= first);
+    BSLS_ASSERT_SAFE(first    <= last);
+    BSLS_ASSERT_SAFE(last     <= cend());
+
+    TYPE *pos = const_cast<TYPE *>(first);
+
+    ArrayPrimitives::erase(pos,
+                           const_cast<TYPE *>(last),
+                           data() + d_size,
+                           d_allocator_p);
+    d_size -= last - first;
+    return pos;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::insert(const_iterator position,
+                                           const TYPE&    value)
+{
+    return insert(position, 1, value);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::insert(const_iterator position,
+                                           size_type      numElements,
+                                           const TYPE&    value)
+{
+    BSLS_ASSERT_SAFE(cbegin()  <= position);
+    BSLS_ASSERT_SAFE(position  <= cend());
+
+    const size_type index = position - cbegin();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                       numElements > max_size() - d_size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwLengthError(
+                              "SmallVector<...>::insert(pos,n,v): too long");
+    }
+
+    if (d_size + numElements <= d_capacity) {
+        ArrayPrimitives::insert(const_cast<TYPE *>(position),
+                                data() + d_size,
+                                value,
+                                numElements,
+                                d_allocator_p);
+        d_size += numElements;
+    }
+    else {
+        spillAndInsert(position, numElements, value);
+    }
+    return begin() + index;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+template <class INPUT_ITERATOR>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::insert(const_iterator position,
+                                           INPUT_ITERATOR first,
+                                           INPUT_ITERATOR last)
+{
+    BSLS_ASSERT_SAFE(cbegin()  <= position);
+    BSLS_ASSERT_SAFE(position  <= cend());
+
+    const size_type index = position - cbegin();
+
+    insertDispatch(position,
+                   first,
+                   last,
+                   typename bsl::is_integral<INPUT_ITERATOR>::type());
+    return begin() + index;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::pop_back()
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    --d_size;
+    bslma::DestructionUtil::destroy(data() + d_size);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void SmallVector<TYPE, INLINE_CAPACITY>::push_back(const TYPE& value)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(d_size < d_capacity)) {
+        bslma::ConstructionUtil::construct(data() + d_size,
+                                           d_allocator_p,
+                                           value);
+        ++d_size;
+    }
+    else {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        spillAndInsert(cend(), 1, value);
+    }
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::reserve(size_type newCapacity)
+{
+    if (newCapacity <= d_capacity) {
+        return;                                                       // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(newCapacity > max_size())) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwLengthError(
+                           "SmallVector<...>::reserve(newCapacity): too long");
+    }
+
+    TYPE *newData = allocateElements(newCapacity);
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                        d_allocator_p);
+
+    // If an exception is thrown, the elements are left unchanged.
+
+    ArrayPrimitives::destructiveMove(newData,
+                                     data(),
+                                     data() + d_size,
+                                     d_allocator_p);
+    proctor.release();
+
+    adopt(newData, newCapacity, d_size);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::resize(size_type newSize)
+{
+    if (newSize <= d_size) {
+        erase(cbegin() + newSize, cend());
+        return;                                                       // RETURN
+    }
+
+    if (newSize > d_capacity) {
+        const size_type newCapacity = grownCapacity(newSize);
+        TYPE           *newData     = allocateElements(newCapacity);
+
+        bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                            d_allocator_p);
+        {
+            TYPE                         *oldData = data();
+            SmallVector_EndProctor<TYPE>  endProctor(oldData, &d_size);
+
+            ArrayPrimitives::destructiveMoveAndInsert(
+                                                      newData,
+                                                      endProctor.endAddress(),
+                                                      oldData,
+                                                      oldData + d_size,
+                                                      oldData + d_size,
+                                                      newSize - d_size,
+                                                      d_allocator_p);
+        }
+        proctor.release();
+
+        adopt(newData, newCapacity, newSize);
+    }
+    else {
+        ArrayPrimitives::defaultConstruct(data() + d_size,
+                                          newSize - d_size,
+                                          d_allocator_p);
+        d_size = newSize;
+    }
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::resize(size_type   newSize,
+                                                const TYPE& value)
+{
+    if (newSize <= d_size) {
+        erase(cbegin() + newSize, cend());
+    }
+    else {
+        insert(cend(), newSize - d_size, value);
+    }
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::shrink_to_fit()
+{
+    if (!d_heap_p || d_size == d_capacity) {
+        return;                                                       // RETURN
+    }
+
+    if (d_size <= INLINE_CAPACITY) {
+        // If an exception is thrown, the elements are left unchanged in the
+        // allocated storage.
+
+        ArrayPrimitives::destructiveMove(
+                                  reinterpret_cast<TYPE *>(d_inline.buffer()),
+                                  d_heap_p,
+                                  d_heap_p + d_size,
+                                  d_allocator_p);
+
+        d_allocator_p->deallocate(d_heap_p);
+        d_heap_p   = 0;
+        d_capacity = INLINE_CAPACITY;
+        return;                                                       // RETURN
+    }
+
+    TYPE *newData = allocateElements(d_size);
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(newData,
+                                                        d_allocator_p);
+
+    ArrayPrimitives::destructiveMove(newData,
+                                     d_heap_p,
+                                     d_heap_p + d_size,
+                                     d_allocator_p);
+    proctor.release();
+
+    adopt(newData, d_size, d_size);
+}
+
+                             // Iterators
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::begin()
+{
+    return data();
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::iterator
+SmallVector<TYPE, INLINE_CAPACITY>::end()
+{
+    return data() + d_size;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+                                  // Aspects
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+void SmallVector<TYPE, INLINE_CAPACITY>::swap(SmallVector& other)
+{
+    BSLS_ASSERT_SAFE(allocator() == other.allocator());
+
+    if (bslmf::IsBitwiseMoveable<TYPE>::value
+     || (d_heap_p && other.d_heap_p)) {
+        // Neither vector holds a pointer into its own footprint, so that, if
+        // the elements are bitwise moveable or are not inline, the vectors
+        // can be exchanged bitwise.
+
+        InlineBuffer inlineBuffer;
+        bsl::memcpy(inlineBuffer.buffer(),
+                    d_inline.buffer(),
+                    sizeof(InlineBuffer));
+        bsl::memcpy(d_inline.buffer(),
+                    other.d_inline.buffer(),
+                    sizeof(InlineBuffer));
+        bsl::memcpy(other.d_inline.buffer(),
+                    inlineBuffer.buffer(),
+                    sizeof(InlineBuffer));
+
+        bslalg::SwapUtil::swap(&d_heap_p,   &other.d_heap_p);
+        bslalg::SwapUtil::swap(&d_size,     &other.d_size);
+        bslalg::SwapUtil::swap(&d_capacity, &other.d_capacity);
+        return;                                                       // RETURN
+    }
+
+    SmallVector temp(*this, d_allocator_p);
+    *this = other;
+    other = temp;
+}
+
+// ACCESSORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reference
+SmallVector<TYPE, INLINE_CAPACITY>::operator[](size_type position) const
+{
+    BSLS_ASSERT_SAFE(position < d_size);
+
+    return data()[position];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reference
+SmallVector<TYPE, INLINE_CAPACITY>::at(size_type position) const
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(position >= d_size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        bslstl::StdExceptUtil::throwOutOfRange(
+                                "SmallVector<...>::at(position): invalid");
+    }
+    return data()[position];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reference
+SmallVector<TYPE, INLINE_CAPACITY>::front() const
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return data()[0];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reference
+SmallVector<TYPE, INLINE_CAPACITY>::back() const
+{
+    BSLS_ASSERT_SAFE(!empty());
+
+    return data()[d_size - 1];
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::size_type
+SmallVector<TYPE, INLINE_CAPACITY>::capacity() const
+{
+    return d_capacity;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+const TYPE *SmallVector<TYPE, INLINE_CAPACITY>::data() const
+{
+    return d_heap_p ? d_heap_p
+                    : reinterpret_cast<const TYPE *>(d_inline.buffer());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool SmallVector<TYPE, INLINE_CAPACITY>::empty() const
+{
+    return 0 == d_size;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool SmallVector<TYPE, INLINE_CAPACITY>::isInline() const
+{
+    return 0 == d_heap_p;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::size_type
+SmallVector<TYPE, INLINE_CAPACITY>::max_size() const
+{
+    return ~size_type(0) / sizeof(TYPE);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::size_type
+SmallVector<TYPE, INLINE_CAPACITY>::size() const
+{
+    return d_size;
+}
+
+                             // Iterators
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::begin() const
+{
+    return data();
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::cbegin() const
+{
+    return data();
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::end() const
+{
+    return data() + d_size;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::cend() const
+{
+    return data() + d_size;
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::crbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+typename SmallVector<TYPE, INLINE_CAPACITY>::const_reverse_iterator
+SmallVector<TYPE, INLINE_CAPACITY>::crend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+                                  // Aspects
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bslma::Allocator *SmallVector<TYPE, INLINE_CAPACITY>::allocator() const
+{
+    return d_allocator_p;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool bdlc::operator==(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                      const SmallVector<TYPE, INLINE_CAPACITY>& rhs)
+{
+    return lhs.size() == rhs.size()
+        && bsl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool bdlc::operator!=(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                      const SmallVector<TYPE, INLINE_CAPACITY>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+bool bdlc::operator<(const SmallVector<TYPE, INLINE_CAPACITY>& lhs,
+                     const SmallVector<TYPE, INLINE_CAPACITY>& rhs)
+{
+    return bsl::lexicographical_compare(lhs.begin(),
+                                        lhs.end(),
+                                        rhs.begin(),
+                                        rhs.end());
+}
+
+// FREE FUNCTIONS
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+inline
+void bdlc::swap(SmallVector<TYPE, INLINE_CAPACITY>& a,
+                SmallVector<TYPE, INLINE_CAPACITY>& b)
+{
+    a.swap(b);
+}
+
+// TRAITS
+
+namespace bslma {
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+struct UsesBslmaAllocator<bdlc::SmallVector<TYPE, INLINE_CAPACITY> >
+                                                             : bsl::true_type {
+};
+
+}  // close namespace bslma
+
+namespace bslmf {
+
+template <class TYPE, bsl::size_t INLINE_CAPACITY>
+struct IsBitwiseMoveable<bdlc::SmallVector<TYPE, INLINE_CAPACITY> >
+                                                  : IsBitwiseMoveable<TYPE> {
+    // This template specialization for 'IsBitwiseMoveable' indicates that a
+    // 'SmallVector' is bitwise moveable if its elements are.
+};
+
+}  // close namespace bslmf
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1522 @@
+// bdlc_smallvector.t.cpp                                             -*-C++-*-
+#include <bdlc_smallvector.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_isbitwisemoveable.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_list.h>
+#include <bsl_sstream.h>
+#include <bsl_stdexcept.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test implements a vector storing a few elements
+// inline, and the rest in allocated memory.  The elements are managed by
+// 'bslalg::ArrayPrimitives', which is tested thoroughly in its own test
+// driver.  This test driver verifies that each method behaves as the same
+// method of 'bsl::vector' does, in particular at the boundary between inline
+// and allocated storage, that memory is allocated only when the elements do
+// not fit inline, that the vector is bitwise moveable if its elements are,
+// and that each method leaves the vector valid if an exception is thrown.
+// Benchmarks comparing the vector to 'bsl::vector' are provided as negative
+// test cases.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit SmallVector(bslma::Allocator *basicAllocator);
+// [ 2] explicit SmallVector(size_type numElements, basicAllocator);
+// [ 2] SmallVector(size_type numElements, value, basicAllocator);
+// [ 2] SmallVector(INPUT_ITERATOR first, last, basicAllocator);
+// [ 4] SmallVector(const SmallVector& original, basicAllocator);
+// [ 2] ~SmallVector();
+//
+// MANIPULATORS
+// [ 4] SmallVector& operator=(const SmallVector& rhs);
+// [ 3] void assign(size_type numElements, const TYPE& value);
+// [ 3] void assign(INPUT_ITERATOR first, INPUT_ITERATOR last);
+// [ 3] reference operator[](size_type position);
+// [ 3] reference at(size_type position);
+// [ 3] reference front();
+// [ 3] reference back();
+// [ 3] TYPE *data();
+// [ 3] void clear();
+// [ 3] iterator erase(const_iterator position);
+// [ 3] iterator erase(const_iterator first, const_iterator last);
+// [ 3] iterator insert(const_iterator position, const TYPE& value);
+// [ 3] iterator insert(const_iterator position, numElements, value);
+// [ 3] iterator insert(const_iterator position, first, last);
+// [ 3] void pop_back();
+// [ 3] void push_back(const TYPE& value);
+// [ 3] void reserve(size_type newCapacity);
+// [ 3] void resize(size_type newSize);
+// [ 3] void resize(size_type newSize, const TYPE& value);
+// [ 3] void shrink_to_fit();
+// [ 3] iterator begin();
+// [ 3] iterator end();
+// [ 3] reverse_iterator rbegin();
+// [ 3] reverse_iterator rend();
+// [ 4] void swap(SmallVector& other);
+//
+// ACCESSORS
+// [ 2] const_reference operator[](size_type position) const;
+// [ 3] const_reference at(size_type position) const;
+// [ 2] const_reference front() const;
+// [ 2] const_reference back() const;
+// [ 2] size_type capacity() const;
+// [ 2] const TYPE *data() const;
+// [ 2] bool empty() const;
+// [ 2] bool isInline() const;
+// [ 2] size_type max_size() const;
+// [ 2] size_type size() const;
+// [ 2] const_iterator begin() const;
+// [ 2] const_iterator cbegin() const;
+// [ 2] const_iterator end() const;
+// [ 2] const_iterator cend() const;
+// [ 2] const_reverse_iterator rbegin() const;
+// [ 2] const_reverse_iterator crbegin() const;
+// [ 2] const_reverse_iterator rend() const;
+// [ 2] const_reverse_iterator crend() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// FREE OPERATORS
+// [ 4] bool operator==(lhs, rhs);
+// [ 4] bool operator!=(lhs, rhs);
+// [ 4] bool operator<(lhs, rhs);
+// [ 4] void swap(SmallVector& a, SmallVector& b);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] USAGE EXAMPLE
+// [ 5] CONCERN: The vector is bitwise moveable if its elements are.
+// [ 5] CONCERN: The allocator is propagated to the elements.
+// [ 6] CONCERN: The vector is valid after an exception.
+// [-1] PERFORMANCE: 'int' ELEMENTS
+// [-2] PERFORMANCE: 'bsl::string' ELEMENTS
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+#define ASSERT_SAFE_PASS_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS_RAW(EXPR)
+#define ASSERT_SAFE_FAIL_RAW(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL_RAW(EXPR)
+#define ASSERT_PASS_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS_RAW(EXPR)
+#define ASSERT_FAIL_RAW(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL_RAW(EXPR)
+#define ASSERT_OPT_PASS_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS_RAW(EXPR)
+#define ASSERT_OPT_FAIL_RAW(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL_RAW(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+enum { k_INLINE_CAPACITY = 4 };
+
+typedef bdlc::SmallVector<int, k_INLINE_CAPACITY>         Obj;
+typedef bdlc::SmallVector<bsl::string, k_INLINE_CAPACITY> StringObj;
+
+// Define 'bsl::string' value long enough to ensure dynamic memory allocation.
+#define SUFFICIENTLY_LONG_STRING "1234567890123456789012345678901234567890" \
+                                 "1234567890123456789012345678901234567890"
+
+const char *const LONG_STRING = "a_" SUFFICIENTLY_LONG_STRING;
+
+bsl::string valueOf(int i)
+    // Return a string, long enough to allocate memory, that is distinct for
+    // each value of the specified 'i'.
+{
+    bsl::ostringstream stream;
+    stream << LONG_STRING << i;
+    return stream.str();
+}
+
+                              // ==============
+                              // class SelfLink
+                              // ==============
+
+class SelfLink {
+    // This class holds an 'int' value and a pointer to itself, and so is not
+    // bitwise moveable: an object that has been moved with 'memcpy' is
+    // detected by 'isValid'.  The class also counts its live objects.
+
+    // DATA
+    int       d_value;   // value
+    SelfLink *d_self_p;  // address of this object
+
+  public:
+    // CLASS DATA
+    static int s_numLive;  // number of live objects
+
+    // CREATORS
+    SelfLink(int value = 0)                                         // IMPLICIT
+        // Create an object having the optionally specified 'value'.
+    : d_value(value)
+    , d_self_p(this)
+    {
+        ++s_numLive;
+    }
+
+    SelfLink(const SelfLink& original)
+        // Create an object having the value of the specified 'original'.
+    : d_value(original.d_value)
+    , d_self_p(this)
+    {
+        ++s_numLive;
+    }
+
+    ~SelfLink()
+        // Destroy this object.
+    {
+        ASSERT(isValid());
+        --s_numLive;
+    }
+
+    // MANIPULATORS
+    SelfLink& operator=(const SelfLink& rhs)
+        // Assign to this object the value of the specified 'rhs', and return
+        // a reference providing modifiable access to this object.
+    {
+        d_value = rhs.d_value;
+        return *this;
+    }
+
+    // ACCESSORS
+    bool isValid() const
+        // Return 'true' if this object has not been moved bitwise, and
+        // 'false' otherwise.
+    {
+        return this == d_self_p;
+    }
+
+    int value() const
+        // Return the value of this object.
+    {
+        return d_value;
+    }
+};
+
+int SelfLink::s_numLive = 0;
+
+bool operator==(const SelfLink& lhs, const SelfLink& rhs)
+    // Return 'true' if the specified 'lhs' and 'rhs' have the same value, and
+    // 'false' otherwise.
+{
+    return lhs.value() == rhs.value();
+}
+
+typedef bdlc::SmallVector<SelfLink, k_INLINE_CAPACITY> SelfLinkObj;
+
+bool isValid(const SelfLinkObj& object)
+    // Return 'true' if none of the elements of the specified 'object' has
+    // been moved bitwise, and 'false' otherwise.
+{
+    for (bsl::size_t i = 0; i < object.size(); ++i) {
+        if (!object[i].isValid()) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+template <class VECTOR>
+bool isValue(const VECTOR& object, int numElements, int offset = 0)
+    // Return 'true' if the specified 'object' holds exactly the specified
+    // 'numElements' integer elements '0 + offset', '1 + offset', ..., and
+    // 'false' otherwise.  Optionally specify 'offset', which is 0 by default.
+{
+    if (object.size() != static_cast<bsl::size_t>(numElements)) {
+        return false;                                                 // RETURN
+    }
+    for (int i = 0; i < numElements; ++i) {
+        if (!(object[i] == i + offset)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+//                            USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+struct Leg {
+    // This 'struct' describes a leg of an order.
+
+    int    d_instrumentId;  // identifier of the instrument
+    int    d_quantity;      // signed quantity
+    double d_price;         // limit price
+};
+
+// ============================================================================
+//                            BENCHMARK SUPPORT
+// ----------------------------------------------------------------------------
+
+namespace {
+namespace u {
+
+template <class VECTOR>
+void benchmark(const char                                *name,
+               const bsl::vector<typename VECTOR::value_type>&  values,
+               int                                        numRounds)
+    // Print the time taken to build, by appending elements, and destroy
+    // vectors of the (template parameter) type 'VECTOR' having from 1 to 8
+    // elements (so, usually few) copied from the specified 'values', the
+    // specified 'numRounds' times, and to build and destroy, the same number
+    // of times, a 'bsl::vector' of 1000 such vectors, labeled with the
+    // specified 'name'.
+{
+    const int       sizes[]  = { 1, 2, 1, 3, 4, 1, 2, 8, 2, 5, 1, 3, 6, 2 };
+    const int       numSizes = static_cast<int>(sizeof sizes / sizeof *sizes);
+    bsls::Stopwatch timer;
+    bsl::size_t     sum = 0;
+
+    timer.start(true);
+    for (int round = 0; round < numRounds; ++round) {
+        VECTOR vector;
+
+        const int size = sizes[round % numSizes];
+        for (int i = 0; i < size; ++i) {
+            vector.push_back(values[(round + i) % values.size()]);
+        }
+        sum += vector.size();
+    }
+    timer.stop();
+    const double buildTime = timer.accumulatedWallTime();
+
+    timer.reset();
+    timer.start(true);
+    for (int round = 0; round < numRounds / 1000; ++round) {
+        bsl::vector<VECTOR> vectors;
+
+        for (int j = 0; j < 1000; ++j) {
+            vectors.push_back(VECTOR());
+
+            VECTOR&   vector = vectors.back();
+            const int size   = sizes[(round + j) % numSizes];
+            for (int i = 0; i < size; ++i) {
+                vector.push_back(values[(j + i) % values.size()]);
+            }
+        }
+        for (bsl::size_t j = 0; j < vectors.size(); ++j) {
+            sum += vectors[j].size();
+        }
+    }
+    timer.stop();
+    const double nestedTime = timer.accumulatedWallTime();
+
+    cout << name
+         << ": build and destroy " << buildTime
+         << "s, vector of vectors " << nestedTime
+         << "s (" << sum << ")" << endl;
+}
+
+}  // close namespace u
+}  // close unnamed namespace
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                test = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    int             verbose = argc > 2;
+    int         veryVerbose = argc > 3;
+    int     veryVeryVerbose = argc > 4;
+    int veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVerbose;
+    (void)veryVeryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Storing the Legs of an Order
+///- - - - - - - - - - - - - - - - - - - -
+// Suppose that we are decoding orders, each of which has one or more legs,
+// and that very few orders have more than 4 legs.
+//
+// First, we define the type of a leg (see 'Leg', defined at file scope).
+//
+// Then, we create a vector of legs having room for 4 legs inline, using a
+// test allocator so that we can observe its use of memory:
+//..
+    bslma::TestAllocator          allocator;
+    bdlc::SmallVector<Leg, 4>     legs(&allocator);
+
+    ASSERT(4    == legs.capacity());
+    ASSERT(true == legs.isInline());
+//..
+// Next, we add the legs of a spread order, and observe that no memory is
+// allocated:
+//..
+    const Leg buy  = { 101,  10, 99.5  };
+    const Leg sell = { 102, -10, 100.25 };
+
+    legs.push_back(buy);
+    legs.push_back(sell);
+
+    ASSERT(2   == legs.size());
+    ASSERT(102 == legs[1].d_instrumentId);
+    ASSERT(0   == allocator.numBlocksTotal());
+//..
+// Now, we add the legs of an unusually large order, and observe that the
+// vector spills its legs into allocated memory:
+//..
+    for (int i = 0; i < 3; ++i) {
+        legs.push_back(buy);
+    }
+
+    ASSERT(5     == legs.size());
+    ASSERT(false == legs.isInline());
+    ASSERT(1     == allocator.numBlocksInUse());
+//..
+// Finally, we remove the extra legs and return the remaining ones to the
+// inline storage, releasing the allocated memory:
+//..
+    legs.erase(legs.begin() + 2, legs.end());
+    legs.shrink_to_fit();
+
+    ASSERT(2    == legs.size());
+    ASSERT(true == legs.isInline());
+    ASSERT(0    == allocator.numBlocksInUse());
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCERN: The vector is valid after an exception.
+        //
+        // Concerns:
+        //: 1 If allocating memory, or copying an element, throws, the vector
+        //:   is left valid, no memory is leaked, and no element is leaked or
+        //:   destroyed twice.
+        //:
+        //: 2 If an exception is thrown while inserting elements at the end of
+        //:   the vector, reserving, or shrinking, the vector is unchanged.
+        //
+        // Plan:
+        //: 1 Using the 'BSLMA_TESTALLOCATOR_EXCEPTION_TEST_*' macros, insert
+        //:   strings, that allocate memory, at the end and in the middle of
+        //:   vectors of various sizes, crossing the boundary between inline
+        //:   and allocated storage, and resize, reserve, shrink, copy, and
+        //:   assign them.  Verify that the vector is valid in each iteration,
+        //:   and that no memory is in use at the end.  (C-1..2)
+        //
+        // Testing:
+        //   CONCERN: The vector is valid after an exception.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                  << "CONCERN: The vector is valid after an exception" << endl
+                  << "===============================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        for (int n = 0; n < 10; ++n) {
+            StringObj mX(&sa);  const StringObj& X = mX;
+            for (int i = 0; i < n; ++i) {
+                mX.push_back(valueOf(i));
+            }
+            const StringObj W(X, &sa);
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                ASSERTV(n, W == X);
+
+                mX.push_back(valueOf(n));
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERTV(n, n + 1 == static_cast<int>(X.size()));
+            ASSERTV(n, valueOf(n) == X.back());
+
+            mX.pop_back();
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                ASSERTV(n, W == X);
+
+                mX.insert(mX.end(), W.begin(), W.end());
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERTV(n, 2 * n == static_cast<int>(X.size()));
+
+            mX = W;
+            const bsl::string INSERTED = valueOf(-2);
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                // Insertion in the middle may leave the vector with an
+                // unspecified value, but it must remain valid.
+
+                mX = W;
+                mX.insert(mX.begin() + n / 2, 3, INSERTED);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERTV(n, n + 3 == static_cast<int>(X.size()));
+
+            mX = W;
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                mX.resize(2 * n + 1, valueOf(-1));
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERTV(n, 2 * n + 1 == static_cast<int>(X.size()));
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                mX.erase(mX.begin() + n, mX.end());
+                ASSERTV(n, W == X);
+
+                mX.shrink_to_fit();
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERTV(n, W == X);
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                ASSERTV(n, W == X);
+
+                mX.reserve(3 * n + 1);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERTV(n, W == X);
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                StringObj mY(X, &sa);
+                ASSERTV(n, W == mY);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            StringObj mZ(&sa);  const StringObj& Z = mZ;
+            mZ.push_back(valueOf(-1));
+            const StringObj V(Z, &sa);
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                // Assignment over existing elements may leave the vector with
+                // an unspecified value, as for 'bsl::vector'.
+
+                ASSERTV(n, 1 <= Z.size());
+                ASSERTV(n, Z.size() <= bsl::max<bsl::size_t>(1, W.size()));
+
+                mZ = X;
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERTV(n, W == Z);
+
+            mZ.clear();
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(sa) {
+                mZ.assign(static_cast<bsl::size_t>(n + 2), valueOf(n));
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+            ASSERTV(n, n + 2 == static_cast<int>(Z.size()));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCERN: The vector is bitwise moveable if its elements are.
+        //
+        // Concerns:
+        //: 1 'bdlc::SmallVector' declares the 'bslma::UsesBslmaAllocator'
+        //:   trait, and the 'bslmf::IsBitwiseMoveable' trait if and only if
+        //:   its elements are bitwise moveable.
+        //:
+        //: 2 A vector that is moved bitwise, whether its elements are inline
+        //:   or not, remains valid.
+        //:
+        //: 3 Elements that are not bitwise moveable are copied, and the
+        //:   originals destroyed, when the vector spills, grows, or shrinks,
+        //:   and are swapped by copy.
+        //:
+        //: 4 The allocator of the vector is propagated to its elements.
+        //
+        // Plan:
+        //: 1 Check the traits of vectors of 'int', 'bsl::string', and
+        //:   'SelfLink', a type that is not bitwise moveable.  (C-1)
+        //:
+        //: 2 Grow a 'bsl::vector' of vectors of strings, some of which are
+        //:   inline, so that they are moved bitwise, and verify their values.
+        //:   (C-2)
+        //:
+        //: 3 Grow, shrink, and swap vectors of 'SelfLink', and verify that
+        //:   no element has been moved bitwise, and that no element is
+        //:   leaked.  (C-3)
+        //:
+        //: 4 Verify that the elements of a vector of strings use the
+        //:   allocator of the vector.  (C-4)
+        //
+        // Testing:
+        //   CONCERN: The vector is bitwise moveable if its elements are.
+        //   CONCERN: The allocator is propagated to the elements.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+             << "CONCERN: The vector is bitwise moveable if its elements are"
+             << endl
+             << "==========================================================="
+             << endl;
+
+        ASSERT( bslma::UsesBslmaAllocator<Obj>::value);
+        ASSERT( bslma::UsesBslmaAllocator<StringObj>::value);
+        ASSERT( bslmf::IsBitwiseMoveable<Obj>::value);
+        ASSERT( bslmf::IsBitwiseMoveable<StringObj>::value);
+        ASSERT(!bslmf::IsBitwiseMoveable<SelfLinkObj>::value);
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        if (verbose) cout << "Vectors moved bitwise." << endl;
+        {
+            bsl::vector<StringObj> vectors(&sa);
+            for (int n = 0; n < 40; ++n) {
+                vectors.push_back(StringObj());
+                StringObj& mX = vectors.back();
+
+                ASSERTV(n, &sa == mX.allocator());
+                for (int i = 0; i < n % 7; ++i) {
+                    mX.push_back(valueOf(i));
+                }
+            }
+            for (int n = 0; n < 40; ++n) {
+                const StringObj& X = vectors[n];
+
+                ASSERTV(n, n % 7 == static_cast<int>(X.size()));
+                ASSERTV(n, (n % 7 <= k_INLINE_CAPACITY) == X.isInline());
+                for (int i = 0; i < n % 7; ++i) {
+                    ASSERTV(n, i, valueOf(i) == X[i]);
+                }
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "Elements that are not bitwise moveable." << endl;
+        {
+            for (int n = 0; n < 12; ++n) {
+                SelfLinkObj mX(&sa);  const SelfLinkObj& X = mX;
+                for (int i = 0; i < n; ++i) {
+                    mX.push_back(i);
+                }
+                ASSERTV(n, isValid(X));
+                ASSERTV(n, n == SelfLink::s_numLive);
+
+                if (n) {
+                    mX.insert(mX.begin(), X[n / 2]);
+                    ASSERTV(n, isValid(X));
+                    ASSERTV(n, n / 2 == X.front().value());
+
+                    mX.erase(mX.begin());
+                }
+                mX.reserve(2 * n);
+                ASSERTV(n, isValid(X));
+                ASSERTV(n, isValue(X, n));
+
+                mX.shrink_to_fit();
+                ASSERTV(n, isValid(X));
+                ASSERTV(n, isValue(X, n));
+                ASSERTV(n, (n <= k_INLINE_CAPACITY) == X.isInline());
+
+                for (int m = 0; m < 12; m += 3) {
+                    SelfLinkObj mY(&sa);  const SelfLinkObj& Y = mY;
+                    for (int i = 0; i < m; ++i) {
+                        mY.push_back(i + 100);
+                    }
+
+                    mX.swap(mY);
+                    ASSERTV(n, m, isValid(X) && isValid(Y));
+                    ASSERTV(n, m, isValue(X, m, 100));
+                    ASSERTV(n, m, isValue(Y, n));
+
+                    swap(mX, mY);
+                    ASSERTV(n, m, isValid(X) && isValid(Y));
+                    ASSERTV(n, m, isValue(X, n));
+                    ASSERTV(n, m, isValue(Y, m, 100));
+                }
+            }
+            ASSERT(0 == SelfLink::s_numLive);
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "Allocator propagation." << endl;
+        {
+            StringObj mX(&sa);  const StringObj& X = mX;
+
+            mX.push_back(LONG_STRING);
+            mX.insert(mX.begin(), 2, LONG_STRING);
+            mX.resize(k_INLINE_CAPACITY + 1);
+            mX.back() = LONG_STRING;
+
+            for (bsl::size_t i = 0; i < X.size(); ++i) {
+                ASSERTV(i, &sa == X[i].get_allocator().mechanism());
+            }
+            ASSERT(0 == defaultAllocator.numBlocksInUse());
+
+            const StringObj Y(X, &sa);
+            for (bsl::size_t i = 0; i < Y.size(); ++i) {
+                ASSERTV(i, &sa == Y[i].get_allocator().mechanism());
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // COPY, ASSIGNMENT, COMPARISON, AND SWAP
+        //
+        // Concerns:
+        //: 1 A copy has the same value as the original, and uses the supplied
+        //:   allocator, or the default allocator, allocating memory only if
+        //:   the elements do not fit inline.
+        //:
+        //: 2 Assignment gives the same value, whatever the sizes of the
+        //:   vectors, and is alias-safe.
+        //:
+        //: 3 Vectors compare equal if and only if they have the same
+        //:   elements, and are ordered lexicographically.
+        //:
+        //: 4 'swap' exchanges the values of the vectors, whether their
+        //:   elements are inline or not, without allocating memory.
+        //
+        // Plan:
+        //: 1 Copy, assign, compare, and swap vectors of each size from 0 to
+        //:   9, of 'int' and of 'bsl::string' elements.  (C-1..4)
+        //
+        // Testing:
+        //   SmallVector(const SmallVector& original, basicAllocator);
+        //   SmallVector& operator=(const SmallVector& rhs);
+        //   void swap(SmallVector& other);
+        //   bool operator==(lhs, rhs);
+        //   bool operator!=(lhs, rhs);
+        //   bool operator<(lhs, rhs);
+        //   void swap(SmallVector& a, SmallVector& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "COPY, ASSIGNMENT, COMPARISON, AND SWAP" << endl
+                          << "======================================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+        bslma::TestAllocator oa("other",    veryVeryVeryVerbose);
+
+        for (int n = 0; n < 10; ++n) {
+            Obj mX(&sa);  const Obj& X = mX;
+            for (int i = 0; i < n; ++i) {
+                mX.push_back(i);
+            }
+
+            const bool INLINE = n <= k_INLINE_CAPACITY;
+
+            Obj mY(X, &oa);  const Obj& Y = mY;
+            ASSERTV(n, X == Y);
+            ASSERTV(n, !(X != Y));
+            ASSERTV(n, !(X < Y) && !(Y < X));
+            ASSERTV(n, &oa == Y.allocator());
+            ASSERTV(n, INLINE == Y.isInline());
+            ASSERTV(n, bsl::max<bsl::size_t>(n, k_INLINE_CAPACITY)
+                                                             == Y.capacity());
+            ASSERTV(n, (INLINE ? 0 : 1) == oa.numBlocksInUse());
+
+            if (n) {
+                mY[n - 1] = -1;
+                ASSERTV(n, X != Y);
+                ASSERTV(n, Y != X);
+                ASSERTV(n, Y < X);
+                ASSERTV(n, !(X < Y));
+
+                mY[n - 1] = n - 1;
+                ASSERTV(n, X == Y);
+
+                mY.pop_back();
+                ASSERTV(n, X != Y);
+                ASSERTV(n, Y < X);
+            }
+
+            {
+                bslma::DefaultAllocatorGuard guard(&oa);
+
+                const Obj Z(X);
+                ASSERTV(n, &oa == Z.allocator());
+                ASSERTV(n, X == Z);
+            }
+
+            for (int m = 0; m < 10; ++m) {
+                Obj mZ(&sa);  const Obj& Z = mZ;
+                for (int i = 0; i < m; ++i) {
+                    mZ.push_back(i + 100);
+                }
+
+                Obj& result = (mZ = X);
+                ASSERTV(n, m, &result == &mZ);
+                ASSERTV(n, m, isValue(Z, n));
+
+                mZ = Z;
+                ASSERTV(n, m, isValue(Z, n));
+
+                Obj mW(&sa);  const Obj& W = mW;
+                for (int i = 0; i < m; ++i) {
+                    mW.push_back(i + 100);
+                }
+
+                const bsls::Types::Int64 numAllocations = sa.numAllocations();
+
+                mZ.swap(mW);
+                ASSERTV(n, m, isValue(Z, m, 100));
+                ASSERTV(n, m, isValue(W, n));
+
+                swap(mZ, mW);
+                ASSERTV(n, m, isValue(Z, n));
+                ASSERTV(n, m, isValue(W, m, 100));
+                ASSERTV(n, m, numAllocations == sa.numAllocations());
+
+                mZ.swap(mZ);
+                ASSERTV(n, m, isValue(Z, n));
+            }
+
+            for (int m = 0; m < 10; ++m) {
+                StringObj mS(&sa);  const StringObj& S = mS;
+                for (int i = 0; i < n; ++i) {
+                    mS.push_back(valueOf(i));
+                }
+                StringObj mT(&sa);  const StringObj& T = mT;
+                for (int i = 0; i < m; ++i) {
+                    mT.push_back(valueOf(i + 100));
+                }
+                const StringObj SS(S, &oa);
+                const StringObj TT(T, &oa);
+
+                mS.swap(mT);
+                ASSERTV(n, m, TT == S && SS == T);
+
+                mS = T;
+                ASSERTV(n, m, SS == S && SS == T);
+                ASSERTV(n, m, (m && n) ? TT != S : true);
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // MANIPULATORS
+        //
+        // Concerns:
+        //: 1 Each manipulator changes the elements of the vector as the same
+        //:   manipulator of 'bsl::vector' does, whether the elements are
+        //:   inline before and after the change, or not.
+        //:
+        //: 2 Memory is allocated only if the elements do not fit inline, and
+        //:   the vector returns to inline storage only on 'shrink_to_fit'.
+        //:
+        //: 3 Insertion of an element of the vector itself is alias-safe.
+        //:
+        //: 4 'at' throws 'std::out_of_range' for an invalid position, and
+        //:   'reserve' throws 'std::length_error' for too large a capacity.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For each size from 0 to 9, apply each manipulator to a vector of
+        //:   that size, at each position, and compare the result with that of
+        //:   applying the same manipulator to a 'bsl::vector'.  (C-1..3)
+        //:
+        //: 2 Call 'at' and 'reserve' with invalid arguments.  (C-4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid positions.  (C-5)
+        //
+        // Testing:
+        //   void assign(size_type numElements, const TYPE& value);
+        //   void assign(INPUT_ITERATOR first, INPUT_ITERATOR last);
+        //   reference operator[](size_type position);
+        //   reference at(size_type position);
+        //   reference front();
+        //   reference back();
+        //   TYPE *data();
+        //   void clear();
+        //   iterator erase(const_iterator position);
+        //   iterator erase(const_iterator first, const_iterator last);
+        //   iterator insert(const_iterator position, const TYPE& value);
+        //   iterator insert(const_iterator position, numElements, value);
+        //   iterator insert(const_iterator position, first, last);
+        //   void pop_back();
+        //   void push_back(const TYPE& value);
+        //   void reserve(size_type newCapacity);
+        //   void resize(size_type newSize);
+        //   void resize(size_type newSize, const TYPE& value);
+        //   void shrink_to_fit();
+        //   iterator begin();
+        //   iterator end();
+        //   reverse_iterator rbegin();
+        //   reverse_iterator rend();
+        //   const_reference at(size_type position) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MANIPULATORS" << endl
+                          << "============" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        typedef bsl::vector<int> Oracle;
+
+        if (verbose) cout << "Element access and push_back." << endl;
+        for (int n = 0; n < 10; ++n) {
+            Obj mX(&sa);  const Obj& X = mX;
+            for (int i = 0; i < n; ++i) {
+                mX.push_back(i);
+                ASSERTV(n, i, i == X.back());
+                ASSERTV(n, i, (i < k_INLINE_CAPACITY) == X.isInline());
+                ASSERTV(n, i, (i < k_INLINE_CAPACITY ? 0 : 1)
+                                                      == sa.numBlocksInUse());
+            }
+            ASSERTV(n, isValue(X, n));
+
+            for (int i = 0; i < n; ++i) {
+                mX[i] += 10;
+                mX.at(i) += 10;
+                ASSERTV(n, i, i + 20 == X.at(i));
+                ASSERTV(n, i, X.data() + i == &mX[i]);
+            }
+            if (1 < n) {
+                mX.front() = -1;
+                mX.back()  = -2;
+                ASSERTV(n, -1 == X[0]);
+                ASSERTV(n, -2 == X[n - 1]);
+                ASSERTV(n, mX.data() == mX.begin());
+                ASSERTV(n, mX.data() + n == mX.end());
+                ASSERTV(n, -2 == *mX.rbegin());
+                ASSERTV(n, n == mX.rend() - mX.rbegin());
+            }
+
+            bool caught = false;
+            try {
+                mX.at(n) = 0;
+            }
+            catch (const bsl::out_of_range&) {
+                caught = true;
+            }
+            ASSERTV(n, caught);
+
+            caught = false;
+            try {
+                (void)X.at(n);
+            }
+            catch (const bsl::out_of_range&) {
+                caught = true;
+            }
+            ASSERTV(n, caught);
+
+            for (int i = n; i > 0; --i) {
+                mX.pop_back();
+                ASSERTV(n, i, i - 1 == static_cast<int>(X.size()));
+            }
+            ASSERTV(n, X.empty());
+            ASSERTV(n, (n <= k_INLINE_CAPACITY) == X.isInline());
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "Insertion and erasure." << endl;
+        for (int n = 0; n < 10; ++n) {
+            for (int pos = 0; pos <= n; ++pos) {
+                for (int count = 0; count < 7; ++count) {
+                    Obj    mX(&sa);  const Obj& X = mX;
+                    Oracle oracle;
+                    for (int i = 0; i < n; ++i) {
+                        mX.push_back(i);
+                        oracle.push_back(i);
+                    }
+
+                    Obj::iterator it = mX.insert(X.begin() + pos,
+                                                 static_cast<bsl::size_t>(
+                                                                       count),
+                                                 -1);
+                    oracle.insert(oracle.begin() + pos,
+                                  static_cast<bsl::size_t>(count),
+                                  -1);
+                    ASSERTV(n, pos, count, mX.begin() + pos == it);
+                    ASSERTV(n, pos, count,
+                            Oracle(X.begin(), X.end()) == oracle);
+                    ASSERTV(n, pos, count,
+                            (n + count <= k_INLINE_CAPACITY) == X.isInline());
+
+                    const int source[] = { 10, 11, 12, 13, 14, 15, 16 };
+                    it = mX.insert(X.begin() + pos, source, source + count);
+                    oracle.insert(oracle.begin() + pos,
+                                  source,
+                                  source + count);
+                    ASSERTV(n, pos, count, mX.begin() + pos == it);
+                    ASSERTV(n, pos, count,
+                            Oracle(X.begin(), X.end()) == oracle);
+
+                    const bsl::list<int> list(source, source + count);
+                    it = mX.insert(X.begin() + pos, list.begin(), list.end());
+                    oracle.insert(oracle.begin() + pos,
+                                  list.begin(),
+                                  list.end());
+                    ASSERTV(n, pos, count, mX.begin() + pos == it);
+                    ASSERTV(n, pos, count,
+                            Oracle(X.begin(), X.end()) == oracle);
+
+                    it = mX.erase(X.begin() + pos, X.begin() + pos + count);
+                    oracle.erase(oracle.begin() + pos,
+                                 oracle.begin() + pos + count);
+                    ASSERTV(n, pos, count, mX.begin() + pos == it);
+                    ASSERTV(n, pos, count,
+                            Oracle(X.begin(), X.end()) == oracle);
+
+                    if (pos < static_cast<int>(X.size())) {
+                        it = mX.erase(X.begin() + pos);
+                        oracle.erase(oracle.begin() + pos);
+                        ASSERTV(n, pos, count, mX.begin() + pos == it);
+                        ASSERTV(n, pos, count,
+                                Oracle(X.begin(), X.end()) == oracle);
+                    }
+
+                    // Insert an element of the vector itself.
+
+                    if (!X.empty()) {
+                        const int last = static_cast<int>(X.size()) - 1;
+
+                        it = mX.insert(X.begin() + pos, X[last]);
+                        oracle.insert(oracle.begin() + pos, oracle[last]);
+                        ASSERTV(n, pos, count, mX.begin() + pos == it);
+                        ASSERTV(n, pos, count,
+                                Oracle(X.begin(), X.end()) == oracle);
+
+                        mX.insert(X.begin() + pos,
+                                  static_cast<bsl::size_t>(count),
+                                  X.back());
+                        oracle.insert(oracle.begin() + pos,
+                                      static_cast<bsl::size_t>(count),
+                                      oracle.back());
+                        ASSERTV(n, pos, count,
+                                Oracle(X.begin(), X.end()) == oracle);
+                    }
+
+                    // Integral arguments insert copies of a value.
+
+                    mX.insert(X.begin(), count, 7);
+                    oracle.insert(oracle.begin(), count, 7);
+                    ASSERTV(n, pos, count,
+                            Oracle(X.begin(), X.end()) == oracle);
+
+                    mX.clear();
+                    ASSERTV(n, pos, count, X.empty());
+                }
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "Resize, reserve, and shrink_to_fit." << endl;
+        for (int n = 0; n < 10; ++n) {
+            for (int m = 0; m < 10; ++m) {
+                Obj    mX(&sa);  const Obj& X = mX;
+                Oracle oracle;
+                for (int i = 0; i < n; ++i) {
+                    mX.push_back(i);
+                    oracle.push_back(i);
+                }
+
+                mX.resize(m);
+                oracle.resize(m);
+                ASSERTV(n, m, Oracle(X.begin(), X.end()) == oracle);
+
+                mX.resize(n, 5);
+                oracle.resize(n, 5);
+                ASSERTV(n, m, Oracle(X.begin(), X.end()) == oracle);
+
+                mX.resize(m, X.empty() ? 5 : X.front());
+                oracle.resize(m, oracle.empty() ? 5 : oracle.front());
+                ASSERTV(n, m, Oracle(X.begin(), X.end()) == oracle);
+
+                const bool SPILLED = !X.isInline();
+
+                mX.reserve(n);
+                ASSERTV(n, m, Oracle(X.begin(), X.end()) == oracle);
+                ASSERTV(n, m, bsl::max(n, m) <= static_cast<int>(
+                                                              X.capacity()));
+                ASSERTV(n, m, (SPILLED || n > k_INLINE_CAPACITY)
+                                                            == !X.isInline());
+
+                mX.shrink_to_fit();
+                ASSERTV(n, m, Oracle(X.begin(), X.end()) == oracle);
+                ASSERTV(n, m, (m <= k_INLINE_CAPACITY) == X.isInline());
+                ASSERTV(n, m, bsl::max<bsl::size_t>(m, k_INLINE_CAPACITY)
+                                                            == X.capacity());
+                ASSERTV(n, m, (m <= k_INLINE_CAPACITY ? 0 : 1)
+                                                      == sa.numBlocksInUse());
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "Assignment of values." << endl;
+        for (int n = 0; n < 10; ++n) {
+            for (int m = 0; m < 10; ++m) {
+                Obj mX(&sa);  const Obj& X = mX;
+                for (int i = 0; i < n; ++i) {
+                    mX.push_back(i);
+                }
+
+                mX.assign(static_cast<bsl::size_t>(m), 3);
+                ASSERTV(n, m, Oracle(X.begin(), X.end()) == Oracle(m, 3));
+
+                if (m) {
+                    mX[m - 1] = 4;
+                    mX.assign(static_cast<bsl::size_t>(m + 3), X.back());
+                    ASSERTV(n, m,
+                            Oracle(X.begin(), X.end()) == Oracle(m + 3, 4));
+                }
+
+                const int source[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+                mX.assign(source, source + m);
+                ASSERTV(n, m, isValue(X, m));
+
+                mX.assign(m, 2);
+                ASSERTV(n, m, Oracle(X.begin(), X.end()) == Oracle(m, 2));
+            }
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        if (verbose) cout << "Exceptions." << endl;
+        {
+            Obj mX(&sa);
+
+            bool caught = false;
+            try {
+                mX.reserve(mX.max_size() + 1);
+            }
+            catch (const bsl::length_error&) {
+                caught = true;
+            }
+            ASSERT(caught);
+            ASSERT(mX.isInline());
+        }
+
+        if (verbose) cout << "Negative testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            Obj mX(&sa);  const Obj& X = mX;
+
+            ASSERT_SAFE_FAIL(mX.front());
+            ASSERT_SAFE_FAIL(mX.back());
+            ASSERT_SAFE_FAIL(mX.pop_back());
+            ASSERT_SAFE_FAIL(mX[0]);
+            ASSERT_SAFE_FAIL(X[0]);
+
+            mX.push_back(1);
+
+            ASSERT_SAFE_PASS(mX.front());
+            ASSERT_SAFE_PASS(mX.back());
+            ASSERT_SAFE_PASS(mX[0]);
+            ASSERT_SAFE_FAIL(mX[1]);
+            ASSERT_SAFE_FAIL(mX.erase(X.end()));
+            ASSERT_SAFE_FAIL(mX.erase(X.end(), X.begin()));
+            ASSERT_SAFE_FAIL(mX.insert(X.end() + 1, 0));
+            ASSERT_SAFE_PASS(mX.erase(X.begin()));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates a vector having the specified elements,
+        //:   and uses the supplied allocator, or the default allocator.
+        //:
+        //: 2 No memory is allocated if the elements fit inline.
+        //:
+        //: 3 Iterator-pair arguments of an integral type create copies of a
+        //:   value, as they do for 'bsl::vector'.
+        //:
+        //: 4 The accessors report the state of the vector.
+        //:
+        //: 5 The destructor releases all memory.
+        //
+        // Plan:
+        //: 1 Create vectors of each size from 0 to 9 with each constructor,
+        //:   and verify their elements, capacity, and use of memory.
+        //:   (C-1..5)
+        //
+        // Testing:
+        //   explicit SmallVector(bslma::Allocator *basicAllocator);
+        //   explicit SmallVector(size_type numElements, basicAllocator);
+        //   SmallVector(size_type numElements, value, basicAllocator);
+        //   SmallVector(INPUT_ITERATOR first, last, basicAllocator);
+        //   ~SmallVector();
+        //   const_reference operator[](size_type position) const;
+        //   const_reference front() const;
+        //   const_reference back() const;
+        //   size_type capacity() const;
+        //   const TYPE *data() const;
+        //   bool empty() const;
+        //   bool isInline() const;
+        //   size_type max_size() const;
+        //   size_type size() const;
+        //   const_iterator begin() const;
+        //   const_iterator cbegin() const;
+        //   const_iterator end() const;
+        //   const_iterator cend() const;
+        //   const_reverse_iterator rbegin() const;
+        //   const_reverse_iterator crbegin() const;
+        //   const_reverse_iterator rend() const;
+        //   const_reverse_iterator crend() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        {
+            const Obj X;
+            ASSERT(&defaultAllocator == X.allocator());
+            ASSERT(X.empty());
+            ASSERT(0 == X.size());
+            ASSERT(k_INLINE_CAPACITY == X.capacity());
+            ASSERT(X.isInline());
+            ASSERT(X.begin() == X.end());
+            ASSERT(X.cbegin() == X.cend());
+            ASSERT(X.rbegin() == X.rend());
+            ASSERT(X.crbegin() == X.crend());
+            ASSERT(~bsl::size_t(0) / sizeof(int) == X.max_size());
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+        }
+
+        {
+            bsl::istringstream         stream("0 1 2 3 4 5 6 7 8 9");
+            bsl::istream_iterator<int> first(stream);
+            bsl::istream_iterator<int> last;
+
+            const Obj X(first, last, &sa);
+            ASSERT(isValue(X, 10));
+        }
+        ASSERT(0 == sa.numBlocksInUse());
+
+        const int source[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+        for (int n = 0; n < 10; ++n) {
+            const bool INLINE   = n <= k_INLINE_CAPACITY;
+            const int  CAPACITY = INLINE ? k_INLINE_CAPACITY : n;
+
+            {
+                const Obj X(n, &sa);
+                ASSERTV(n, n == static_cast<int>(X.size()));
+                ASSERTV(n, (0 == n) == X.empty());
+                ASSERTV(n, INLINE == X.isInline());
+                ASSERTV(n, CAPACITY <= static_cast<int>(X.capacity()));
+                ASSERTV(n, (INLINE ? 0 : 1) == sa.numBlocksInUse());
+                for (int i = 0; i < n; ++i) {
+                    ASSERTV(n, i, 0 == X[i]);
+                }
+            }
+            ASSERTV(n, 0 == sa.numBlocksInUse());
+
+            {
+                const Obj X(n, 7, &sa);
+                ASSERTV(n, n == static_cast<int>(X.size()));
+                ASSERTV(n, INLINE == X.isInline());
+                for (int i = 0; i < n; ++i) {
+                    ASSERTV(n, i, 7 == X[i]);
+                }
+            }
+            ASSERTV(n, 0 == sa.numBlocksInUse());
+
+            {
+                const Obj X(source, source + n, &sa);
+                ASSERTV(n, isValue(X, n));
+                ASSERTV(n, INLINE == X.isInline());
+                ASSERTV(n, &sa == X.allocator());
+                ASSERTV(n, X.data() == X.begin());
+                ASSERTV(n, X.data() + n == X.end());
+                ASSERTV(n, X.begin() == X.cbegin());
+                ASSERTV(n, X.end() == X.cend());
+                ASSERTV(n, n == X.rend() - X.rbegin());
+                ASSERTV(n, n == X.crend() - X.crbegin());
+                if (n) {
+                    ASSERTV(n, 0 == X.front());
+                    ASSERTV(n, n - 1 == X.back());
+                    ASSERTV(n, n - 1 == *X.rbegin());
+                    ASSERTV(n, 0 == *(X.crend() - 1));
+                }
+            }
+            ASSERTV(n, 0 == sa.numBlocksInUse());
+
+            {
+                const Obj X(n, 9, &sa);    // integral "iterators"
+                ASSERTV(n, n == static_cast<int>(X.size()));
+                for (int i = 0; i < n; ++i) {
+                    ASSERTV(n, i, 9 == X[i]);
+                }
+            }
+            ASSERTV(n, 0 == sa.numBlocksInUse());
+
+            {
+                const StringObj X(n, LONG_STRING, &sa);
+                ASSERTV(n, n == static_cast<int>(X.size()));
+                ASSERTV(n, INLINE == X.isInline());
+                ASSERTV(n, n + (INLINE ? 0 : 1) == sa.numBlocksInUse());
+            }
+            ASSERTV(n, 0 == sa.numBlocksInUse());
+        }
+        ASSERT(0 == defaultAllocator.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Append elements to a vector, past its inline capacity, and
+        //:   remove them.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator sa("supplied", veryVeryVeryVerbose);
+
+        StringObj mX(&sa);  const StringObj& X = mX;
+        ASSERT(X.empty());
+        ASSERT(X.isInline());
+
+        mX.push_back("a");
+        mX.push_back("b");
+        ASSERT(2 == X.size());
+        ASSERT("a" == X[0]);
+        ASSERT("b" == X[1]);
+        ASSERT(0 == sa.numBlocksTotal());
+
+        for (int i = 0; i < 10; ++i) {
+            mX.push_back(LONG_STRING);
+        }
+        ASSERT(12 == X.size());
+        ASSERT(!X.isInline());
+        ASSERT("b" == X[1]);
+        ASSERT(LONG_STRING == X[11]);
+
+        StringObj mY(X, &sa);  const StringObj& Y = mY;
+        ASSERT(X == Y);
+
+        mX.erase(mX.begin() + 2, mX.end());
+        ASSERT(X != Y);
+
+        mX.shrink_to_fit();
+        ASSERT(X.isInline());
+        ASSERT(2 == X.size());
+
+        mY.clear();
+        ASSERT(Y.empty());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'int' ELEMENTS
+        //
+        // Concerns:
+        //: 1 'bdlc::SmallVector' is faster than 'bsl::vector' for vectors of
+        //:   few 'int' elements.
+        //
+        // Plan:
+        //: 1 Time the creation, by appending 1 to 8 elements, and destruction
+        //:   of 10M vectors, and of 10K 'bsl::vector's of 1000 such vectors,
+        //:   with 'bsl::vector' and 'bdlc::SmallVector' of several inline
+        //:   capacities, using the new-delete allocator.
+        //
+        // Testing:
+        //   PERFORMANCE: 'int' ELEMENTS
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: 'int' ELEMENTS" << endl
+             << "===========================" << endl;
+
+        bslma::Default::setDefaultAllocatorRaw(
+                                     &bslma::NewDeleteAllocator::singleton());
+
+        const int NUM_ROUNDS = 10 * 1000 * 1000;
+
+        bsl::vector<int> values;
+        for (int i = 0; i < 64; ++i) {
+            values.push_back(i * 7);
+        }
+
+        u::benchmark<bsl::vector<int> >(
+                                    "bsl::vector<int>             ",
+                                    values, NUM_ROUNDS);
+        u::benchmark<bdlc::SmallVector<int, 2> >(
+                                    "bdlc::SmallVector<int, 2>    ",
+                                    values, NUM_ROUNDS);
+        u::benchmark<bdlc::SmallVector<int, 4> >(
+                                    "bdlc::SmallVector<int, 4>    ",
+                                    values, NUM_ROUNDS);
+        u::benchmark<bdlc::SmallVector<int, 8> >(
+                                    "bdlc::SmallVector<int, 8>    ",
+                                    values, NUM_ROUNDS);
+      } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: 'bsl::string' ELEMENTS
+        //
+        // Concerns:
+        //: 1 'bdlc::SmallVector' is faster than 'bsl::vector' for vectors of
+        //:   few short strings.
+        //
+        // Plan:
+        //: 1 Time the creation, by appending 1 to 8 short strings, and
+        //:   destruction of 5M vectors, and of 5K 'bsl::vector's of 1000 such
+        //:   vectors, with 'bsl::vector' and 'bdlc::SmallVector', using the
+        //:   new-delete allocator.
+        //
+        // Testing:
+        //   PERFORMANCE: 'bsl::string' ELEMENTS
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: 'bsl::string' ELEMENTS" << endl
+             << "===================================" << endl;
+
+        bslma::Default::setDefaultAllocatorRaw(
+                                     &bslma::NewDeleteAllocator::singleton());
+
+        const int NUM_ROUNDS = 5 * 1000 * 1000;
+
+        bsl::vector<bsl::string> values;
+        for (int i = 0; i < 64; ++i) {
+            values.push_back(bsl::to_string(i * 7));
+        }
+
+        u::benchmark<bsl::vector<bsl::string> >(
+                                    "bsl::vector<string>          ",
+                                    values, NUM_ROUNDS);
+        u::benchmark<bdlc::SmallVector<bsl::string, 4> >(
+                                    "bdlc::SmallVector<string, 4> ",
+                                    values, NUM_ROUNDS);
+        u::benchmark<bdlc::SmallVector<bsl::string, 8> >(
+                                    "bdlc::SmallVector<string, 8> ",
+                                    values, NUM_ROUNDS);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
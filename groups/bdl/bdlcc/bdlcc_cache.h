@@ -29,11 +29,21 @@ BSLS_IDENT("$Id: $")
 // fixed maximum size is obtained by setting the high and low watermarks to the
 // same value.
 //
-// Two eviction policies are supported: LRU (Least Recently Used) and FIFO
-// (First In, First Out).  With LRU, the item that has *not* been accessed for
-// the longest period of time will be evicted first.  With FIFO, the eviction
-// order is based on the order of insertion, with the earliest inserted item
-// being evicted first.
+// Three eviction policies are supported: LRU (Least Recently Used), FIFO
+// (First In, First Out), and CLOCK (an approximation of LRU).  With LRU, the
+// item that has *not* been accessed for the longest period of time will be
+// evicted first.  With FIFO, the eviction order is based on the order of
+// insertion, with the earliest inserted item being evicted first.
+//
+// With CLOCK (also known as "second chance"), each item carries a reference
+// flag that is set when the item is accessed through 'tryGetValue'.  Items are
+// kept in insertion order, and when an item is to be evicted the front of the
+// eviction queue is examined: if its reference flag is set, the flag is
+// cleared and the item is moved to the back of the queue; otherwise, the item
+// is evicted.  Items that are accessed between successive sweeps therefore
+// survive, approximating the LRU order, while accessing an item only needs to
+// set a flag rather than reorder the eviction queue (see {Thread
+// Contention}).
 //
 ///Thread Safety
 ///-------------
@@ -51,10 +61,14 @@ BSLS_IDENT("$Id: $")
 // All of the modifier methods of the cache potentially requires a write lock.
 // Of particular note is the 'tryGetValue' method, which requires a writer lock
 // only if the eviction queue needs to be modified.  This means 'tryGetValue'
-// requires only a read lock if the eviction policy is set to FIFO or the
-// argument 'modifyEvictionQueue' is set to 'false'.  For limited cases where
-// contention is likely, temporarily setting 'modifyEvictionQueue' to 'false'
-// might be of value.
+// requires only a read lock if the eviction policy is set to FIFO or CLOCK, or
+// the argument 'modifyEvictionQueue' is set to 'false'.  For limited cases
+// where contention is likely, temporarily setting 'modifyEvictionQueue' to
+// 'false' might be of value.  For read-heavy workloads in which contention is
+// the norm, the CLOCK eviction policy keeps the access recency information
+// that LRU provides, at the cost of precision, while allowing concurrent
+// 'tryGetValue' calls to proceed under the read lock: a CLOCK cache hit only
+// sets the atomic reference flag of the item.
 //
 // The 'visit' method acquires a read lock and calls the supplied visitor
 // function for every item in the cache, or until the visitor function returns
@@ -90,13 +104,17 @@ BSLS_IDENT("$Id: $")
 // +----------------------------------------------------+--------------------+
 // | tryGetValue                                        | O[1]               |
 // +----------------------------------------------------+--------------------+
-// | popFront                                           | O[1]               |
+// | popFront                                           | Average: O[1]      |
+// |                                                    | Worst:   O[n]      |
 // +----------------------------------------------------+--------------------+
 // | erase                                              | O[1]               |
 // +----------------------------------------------------+--------------------+
 // | visit                                              | O[n]               |
 // +----------------------------------------------------+--------------------+
 //..
+// Note that the worst case for 'popFront' applies only to the CLOCK eviction
+// policy, when the reference flags of many items at the front of the eviction
+// queue are set.
 //
 ///Usage
 ///-----
@@ -332,6 +350,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_assert.h>
 #endif
 
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
 #ifndef INCLUDED_BSL_MEMORY
 #include <bsl_memory.h>
 #endif
@@ -377,11 +399,69 @@ struct CacheEvictionPolicy {
     enum Enum {
         // Enumeration of supported cache eviction policies.
 
-        e_LRU,  // Least Recently Used
-        e_FIFO  // First In, First Out
+        e_LRU,   // Least Recently Used
+        e_FIFO,  // First In, First Out
+        e_CLOCK  // CLOCK (second chance), an approximation of LRU
     };
 };
 
+template <class VALUEPTR, class QUEUE_ITERATOR>
+class Cache_MapValue {
+    // This class implements the value type of the hash map of a
+    // 'bdlcc::Cache': the (shared pointer to the) cached value, the position
+    // of its key in the eviction queue, and the reference flag used by the
+    // CLOCK eviction policy.  The reference flag may be set concurrently by
+    // multiple threads holding only a read lock on the cache.
+
+    // DATA
+    VALUEPTR                 d_valuePtr;       // cached value
+    QUEUE_ITERATOR           d_queueIterator;  // position in eviction queue
+    mutable bsls::AtomicBool d_referenced;     // 'true' if accessed since
+                                               // last examined for eviction
+
+  public:
+    // CREATORS
+    Cache_MapValue(const VALUEPTR& valuePtr, const QUEUE_ITERATOR& queueIt);
+        // Create a 'Cache_MapValue' object holding the specified 'valuePtr'
+        // and 'queueIt', with the reference flag cleared.
+
+    Cache_MapValue(const Cache_MapValue& original);
+        // Create a 'Cache_MapValue' object having the same value as the
+        // specified 'original' object.
+
+    // MANIPULATORS
+    Cache_MapValue& operator=(const Cache_MapValue& rhs);
+        // Assign to this object the value of the specified 'rhs' object, and
+        // return a reference providing modifiable access to this object.
+
+    QUEUE_ITERATOR& queueIterator();
+        // Return a reference providing modifiable access to the eviction
+        // queue position held by this object.
+
+    VALUEPTR& valuePtr();
+        // Return a reference providing modifiable access to the value held by
+        // this object.
+
+    // ACCESSORS
+    void clearReferenced() const;
+        // Clear the reference flag of this object.
+
+    bool isReferenced() const;
+        // Return the value of the reference flag of this object.
+
+    const QUEUE_ITERATOR& queueIterator() const;
+        // Return a reference providing non-modifiable access to the eviction
+        // queue position held by this object.
+
+    void setReferenced() const;
+        // Set the reference flag of this object.  Note that this method may be
+        // called concurrently by multiple threads.
+
+    const VALUEPTR& valuePtr() const;
+        // Return a reference providing non-modifiable access to the value
+        // held by this object.
+};
+
 template <class KEY>
 class Cache_QueueProctor {
     // This class implements a proctor that, on destruction, removes the last
@@ -438,7 +518,8 @@ class Cache {
     typedef bsl::list<KEY>                                        QueueType;
         // Eviction queue type.
 
-    typedef bsl::pair<ValuePtrType, typename QueueType::iterator> MapValue;
+    typedef Cache_MapValue<ValuePtrType, typename QueueType::iterator>
+                                                                  MapValue;
         // Value type of the hash map.
 
     typedef bsl::unordered_map<KEY, MapValue, HASH, EQUAL>        MapType;
@@ -491,6 +572,17 @@ class Cache {
         // Evict the item at the specified 'mapIt' and invoke the post-eviction
         // callback for that item.
 
+    typename MapType::iterator nextVictim();
+        // Return an iterator to the item to be evicted next, i.e., the item at
+        // the front of the eviction queue.  If the eviction policy is CLOCK,
+        // first move each item at the front of the eviction queue whose
+        // reference flag is set to the back of the queue, clearing its flag.
+        // The behavior is undefined unless this cache is non-empty.
+
+    void touchItem(const typename MapType::iterator& mapIt);
+        // Move the item at the specified 'mapIt' to the back of the eviction
+        // queue, and clear its reference flag.
+
     void insertImp(const KEY& key, const ValuePtrType& valuePtr);
         // Insert the specified 'key' and its associated 'valuePtr' into this
         // cache.  If 'key' already exists, then its value will be replaced
@@ -584,7 +676,9 @@ class Cache {
     int popFront();
         // Remove the item at the front of the eviction queue.  Invoke the
         // post-eviction callback for the removed item.  Return 0 on success,
-        // and 1 if this cache is empty.
+        // and 1 if this cache is empty.  If the eviction policy is CLOCK,
+        // items at the front of the eviction queue whose reference flag is set
+        // are first given a second chance (see {Description}).
 
     void setPostEvictionCallback(
                              const PostEvictionCallback& postEvictionCallback);
@@ -598,9 +692,12 @@ class Cache {
         // Load, into the specified 'value', the value associated with the
         // specified 'key' in this cache.  If the optionally specified
         // 'modifyEvictionQueue' is 'true' and the eviction policy is LRU, then
-        // move the cached item to the back of the eviction queue.  Return 0 on
+        // move the cached item to the back of the eviction queue; if
+        // 'modifyEvictionQueue' is 'true' and the eviction policy is CLOCK,
+        // then set the reference flag of the cached item.  Return 0 on
         // success, and 1 if 'key' does not exist in this cache.  Note that a
-        // write lock is acquired only if this queue is modified.
+        // write lock is acquired only if this queue is modified, i.e., only
+        // for the LRU eviction policy.
 
     // ACCESSORS
     EQUAL equalFunction() const;
@@ -701,6 +798,100 @@ void Cache_QueueProctor<KEY>::release()
     d_queue_p = 0;
 }
 
+                          // --------------------
+                          // class Cache_MapValue
+                          // --------------------
+
+// CREATORS
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::Cache_MapValue(
+                                              const VALUEPTR&       valuePtr,
+                                              const QUEUE_ITERATOR& queueIt)
+: d_valuePtr(valuePtr)
+, d_queueIterator(queueIt)
+, d_referenced(false)
+{
+}
+
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::Cache_MapValue(
+                                                const Cache_MapValue& original)
+: d_valuePtr(original.d_valuePtr)
+, d_queueIterator(original.d_queueIterator)
+, d_referenced(original.d_referenced.loadRelaxed())
+{
+}
+
+// MANIPULATORS
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>&
+Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::operator=(const Cache_MapValue& rhs)
+{
+    d_valuePtr      = rhs.d_valuePtr;
+    d_queueIterator = rhs.d_queueIterator;
+    d_referenced.storeRelaxed(rhs.d_referenced.loadRelaxed());
+    return *this;
+}
+
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+QUEUE_ITERATOR& Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::queueIterator()
+{
+    return d_queueIterator;
+}
+
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+VALUEPTR& Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::valuePtr()
+{
+    return d_valuePtr;
+}
+
+// ACCESSORS
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+void Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::clearReferenced() const
+{
+    d_referenced.storeRelaxed(false);
+}
+
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+bool Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::isReferenced() const
+{
+    return d_referenced.loadRelaxed();
+}
+
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+const QUEUE_ITERATOR&
+Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::queueIterator() const
+{
+    return d_queueIterator;
+}
+
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+void Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::setReferenced() const
+{
+    // Avoid writing to the cache line if the flag is already set, so that
+    // concurrent readers of a frequently accessed item do not contend.
+
+    if (!d_referenced.loadRelaxed()) {
+        d_referenced.storeRelaxed(true);
+    }
+}
+
+template <class VALUEPTR, class QUEUE_ITERATOR>
+inline
+const VALUEPTR& Cache_MapValue<VALUEPTR, QUEUE_ITERATOR>::valuePtr() const
+{
+    return d_valuePtr;
+}
+
                         // -----------
                         // class Cache
                         // -----------
@@ -767,9 +958,7 @@ void Cache<KEY, VALUE, HASH, EQUAL>::enforceHighWatermark()
     }
 
     while (d_map.size() >= d_lowWatermark && d_map.size() > 0) {
-        const typename MapType::iterator mapIt = d_map.find(d_queue.front());
-        BSLS_ASSERT(mapIt != d_map.end());
-        evictItem(mapIt);
+        evictItem(nextVictim());
     }
 }
 
@@ -777,9 +966,9 @@ template <class KEY, class VALUE, class HASH, class EQUAL>
 void Cache<KEY, VALUE, HASH, EQUAL>::evictItem(
                                        const typename MapType::iterator& mapIt)
 {
-    ValuePtrType value = mapIt->second.first;
+    ValuePtrType value = mapIt->second.valuePtr();
 
-    d_queue.erase(mapIt->second.second);
+    d_queue.erase(mapIt->second.queueIterator());
     d_map.erase(mapIt);
 
     if (d_postEvictionCallback) {
@@ -787,6 +976,38 @@ void Cache<KEY, VALUE, HASH, EQUAL>::evictItem(
     }
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL>
+typename Cache<KEY, VALUE, HASH, EQUAL>::MapType::iterator
+Cache<KEY, VALUE, HASH, EQUAL>::nextVictim()
+{
+    BSLS_ASSERT(!d_queue.empty());
+
+    typename MapType::iterator mapIt = d_map.find(d_queue.front());
+    BSLS_ASSERT(mapIt != d_map.end());
+
+    if (CacheEvictionPolicy::e_CLOCK == d_evictionPolicy) {
+        // Each item is moved at most once, since its reference flag is
+        // cleared when it is moved, so this loop terminates after at most one
+        // full sweep of the eviction queue.
+
+        while (mapIt->second.isReferenced()) {
+            touchItem(mapIt);
+            mapIt = d_map.find(d_queue.front());
+            BSLS_ASSERT(mapIt != d_map.end());
+        }
+    }
+    return mapIt;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void Cache<KEY, VALUE, HASH, EQUAL>::touchItem(
+                                       const typename MapType::iterator& mapIt)
+{
+    mapIt->second.clearReferenced();
+    d_queue.splice(d_queue.end(), d_queue, mapIt->second.queueIterator());
+}
+
 template <class KEY, class VALUE, class HASH, class EQUAL>
 void Cache<KEY, VALUE, HASH, EQUAL>::insertImp(const KEY&          key,
                                                const ValuePtrType& valuePtr)
@@ -797,10 +1018,8 @@ void Cache<KEY, VALUE, HASH, EQUAL>::insertImp(const KEY&          key,
 
     typename MapType::iterator mapIt = d_map.find(key);
     if (mapIt != d_map.end()) {
-        mapIt->second.first = valuePtr;
-        typename QueueType::iterator queueIt = mapIt->second.second;
-
-        d_queue.splice(d_queue.end(), d_queue, queueIt);
+        mapIt->second.valuePtr() = valuePtr;
+        touchItem(mapIt);
     }
     else {
         d_queue.push_back(key);
@@ -808,7 +1027,7 @@ void Cache<KEY, VALUE, HASH, EQUAL>::insertImp(const KEY&          key,
         typename QueueType::iterator queueIt = d_queue.end();
         --queueIt;
 
-        d_map.emplace(key, MapValue(valuePtr, queueIt, d_allocator_p));
+        d_map.emplace(key, MapValue(valuePtr, queueIt));
         proctor.release();
     }
 }
@@ -905,10 +1124,8 @@ Cache<KEY, VALUE, HASH, EQUAL>::insertBulk(const bsl::vector<KVType>& data)
 
         typename MapType::iterator mapIt = d_map.find(data[i].first);
         if (mapIt != d_map.end()) {
-            mapIt->second.first = data[i].second;
-            typename QueueType::iterator queueIt = mapIt->second.second;
-
-            d_queue.splice(d_queue.end(), d_queue, queueIt);
+            mapIt->second.valuePtr() = data[i].second;
+            touchItem(mapIt);
         }
         else {
             d_queue.push_back(data[i].first);
@@ -916,8 +1133,7 @@ Cache<KEY, VALUE, HASH, EQUAL>::insertBulk(const bsl::vector<KVType>& data)
             typename QueueType::iterator queueIt = d_queue.end();
             --queueIt;
 
-            d_map.emplace(data[i].first, MapValue(data[i].second, queueIt,
-                                                               d_allocator_p));
+            d_map.emplace(data[i].first, MapValue(data[i].second, queueIt));
             proctor.release();
             ++count;
         }
@@ -932,9 +1148,7 @@ int Cache<KEY, VALUE, HASH, EQUAL>::popFront()
     bslmt::WriteLockGuard<LockType> guard(&d_rwlock);
 
     if (d_map.size() > 0) {
-        const typename MapType::iterator mapIt = d_map.find(d_queue.front());
-        BSLS_ASSERT(mapIt != d_map.end());
-        evictItem(mapIt);
+        evictItem(nextVictim());
         return 0;                                                     // RETURN
     }
 
@@ -974,16 +1188,20 @@ int Cache<KEY, VALUE, HASH, EQUAL>::tryGetValue(
         return 1;                                                     // RETURN
     }
 
-    *value = mapIt->second.first;
+    *value = mapIt->second.valuePtr();
 
     if (writeLock) {
-        typename QueueType::iterator queueIt = mapIt->second.second;
+        typename QueueType::iterator queueIt = mapIt->second.queueIterator();
         typename QueueType::iterator last = d_queue.end();
         --last;
         if (last != queueIt) {
             d_queue.splice(d_queue.end(), d_queue, queueIt);
         }
     }
+    else if (modifyEvictionQueue &&
+             CacheEvictionPolicy::e_CLOCK == d_evictionPolicy) {
+        mapIt->second.setReferenced();
+    }
 
     return 0;
 }
@@ -1045,7 +1263,7 @@ void Cache<KEY, VALUE, HASH, EQUAL>::visit(VISITOR& visitor) const
         const KEY&                             key = *queueIt;
         const typename MapType::const_iterator mapIt = d_map.find(key);
         BSLS_ASSERT(mapIt != d_map.end());
-        const ValuePtrType& valuePtr = mapIt->second.first;
+        const ValuePtrType& valuePtr = mapIt->second.valuePtr();
 
         if (!visitor(key, *valuePtr)) {
             break;
@@ -6,6 +6,9 @@
 #include <bdlt_datetime.h>
 #include <bdlt_datetimeinterval.h>
 
+#include <bdlf_bind.h>
+#include <bdlf_placeholder.h>
+
 #include <bdlb_random.h>
 #include <bdlb_randomdevice.h>
 
@@ -118,7 +121,8 @@ using namespace bsl;
 // [13] THREAD SAFETY
 // [14] LOCKING TEST UTIL
 // [15] LOCKING
-// [16] USAGE EXAMPLE
+// [16] CLOCK EVICTION POLICY
+// [17] USAGE EXAMPLE
 // [-1] INSERT PERFORMANCE
 // [-2] INSERT BULK PERFORMANCE
 // [-3] READ PERFORMANCE
@@ -1324,6 +1328,12 @@ void testLocking()
     //:   eviction policy, run 'tryGetValue' and measure how long it took to
     //:   complete.  It should be less than sec.
     //:
+    //:14 Spawn a thread that calls 'lockRead', sleep for 0.1sec, and calls
+    //:   'unlock'.  On the main thread, use a 'bdlcc:Cache' object with CLOCK
+    //:   eviction policy, run 'tryGetValue' (which sets the reference flag of
+    //:   an existing item) and measure how long it took to complete.  It
+    //:   should be less than 0.1 sec.
+    //:
     // Testing:
     //   void insert(const KEYTYPE& key, const VALUETYPE& value);
     //   void insert(const KEYTYPE& key, const ValuePtrType& valuePtr);
@@ -1620,9 +1630,238 @@ void testLocking()
         ASSERT(duration < k_SLEEP_PERIOD / 2);
     }
 
+    CacheType          clockCache(bdlcc::CacheEvictionPolicy::e_CLOCK, 10, 20,
+                                                                      &talloc);
+    Cache_TestUtilType clockCache_TestUtil(clockCache);
+    ThreadData         tdClockRead(&clockCache_TestUtil, k_SLEEP_PERIOD, 'R');
+    // LockRead / tryGetValue, CLOCK
+    {
+        clockCache.insert(8, "Eight");
+
+        bslmt::ThreadUtil::create(&handle, workThread, &tdClockRead);
+        smp.wait();
+
+        // Time the duration how long it took to run 'tryGetValue'
+
+        TimeType startTime = bsls::TimeUtil::getTimer();
+
+        bsl::shared_ptr<bsl::string> valuePtr;
+
+        int rc = clockCache.tryGetValue(&valuePtr, 8);
+
+        TimeType endTime = bsls::TimeUtil::getTimer();
+        int      duration = static_cast<int>((endTime - startTime) / 1000);
+        bslmt::ThreadUtil::join(handle, &result);
+
+        ASSERT(0 == rc);
+        ASSERT(duration < k_SLEEP_PERIOD / 2);
+    }
+
 }
 }  // close namespace testLock
 
+namespace testClock {
+
+typedef bdlcc::Cache<int, int> CacheType;
+
+struct KeyCollector {
+    // Visitor appending the visited keys to a vector.
+
+    bsl::vector<int> *d_keys_p;
+
+    explicit KeyCollector(bsl::vector<int> *keys)
+    : d_keys_p(keys)
+    {}
+
+    bool operator()(int key, int)
+    {
+        d_keys_p->push_back(key);
+        return true;
+    }
+};
+
+void recordEviction(bsl::vector<int>            *evicted,
+                    const bsl::shared_ptr<int>&  value)
+    // Append the specified 'value' to the specified 'evicted'.
+{
+    evicted->push_back(*value);
+}
+
+void loadKeys(bsl::vector<int> *keys, const CacheType& cache)
+    // Load into the specified 'keys' the keys of the specified 'cache' in the
+    // order of its eviction queue.
+{
+    keys->clear();
+    KeyCollector collector(keys);
+    cache.visit(collector);
+}
+
+void testClockEvictionPolicy()
+{
+    // ------------------------------------------------------------------------
+    // CLOCK EVICTION POLICY
+    //
+    // Concerns:
+    //: 1 With the CLOCK eviction policy, 'tryGetValue' does not reorder the
+    //:   eviction queue.
+    //:
+    //: 2 An item accessed through 'tryGetValue' with 'modifyEvictionQueue'
+    //:   set to 'true' survives the next eviction sweep (it is moved to the
+    //:   back of the queue and its reference flag is cleared), whereas an
+    //:   item accessed with 'modifyEvictionQueue' set to 'false' does not.
+    //:
+    //: 3 If every item has been accessed, eviction still terminates and
+    //:   removes the item that was at the front of the queue.
+    //:
+    //: 4 The watermarks and the post-eviction callback behave as for the
+    //:   other eviction policies.
+    //:
+    //: 5 Replacing the value of an existing key moves it to the back of the
+    //:   queue and clears its reference flag.
+    //
+    // Plan:
+    //: 1 Using a cache with low and high watermarks of 4 and 5, insert keys,
+    //:   access a subset of them, trigger evictions through 'insert' and
+    //:   'popFront', and verify the evicted values and the resulting
+    //:   eviction queue order using 'visit'.  (C-1..5)
+    //
+    // Testing:
+    //   CLOCK EVICTION POLICY
+    // ------------------------------------------------------------------------
+
+    bslma::TestAllocator talloc("tc", veryVeryVeryVerbose);
+
+    bsl::vector<int> keys(&talloc);
+    bsl::vector<int> evicted(&talloc);
+
+    bsl::shared_ptr<int> value;
+
+    {
+        CacheType mX(bdlcc::CacheEvictionPolicy::e_CLOCK, 4, 5, &talloc);
+        ASSERT(bdlcc::CacheEvictionPolicy::e_CLOCK == mX.evictionPolicy());
+
+        using bdlf::PlaceHolders::_1;
+        mX.setPostEvictionCallback(CacheType::PostEvictionCallback(
+                                     bsl::allocator_arg,
+                                     &talloc,
+                                     bdlf::BindUtil::bind(&recordEviction,
+                                                          &evicted,
+                                                          _1)));
+
+        for (int i = 0; i < 5; ++i) {
+            mX.insert(i, i * 10);
+        }
+        ASSERT(5 == mX.size());
+
+        // Access 0 and 2 (setting their reference flags) and 3 (without).
+
+        ASSERT(0 == mX.tryGetValue(&value, 0));
+        ASSERT(0 == mX.tryGetValue(&value, 2));
+        ASSERT(0 == mX.tryGetValue(&value, 3, false));
+        ASSERT(30 == *value);
+        ASSERT(1 == mX.tryGetValue(&value, 7));
+
+        // The eviction queue order is not modified by 'tryGetValue'.
+
+        loadKeys(&keys, mX);
+        ASSERT(5 == keys.size());
+        for (int i = 0; i < 5; ++i) {
+            LOOP_ASSERT(i, i == keys[i]);
+        }
+
+        // Inserting a sixth item evicts down to 3 items before insertion:
+        // 0 gets a second chance, 1 is evicted, 2 gets a second chance, and 3
+        // is evicted.
+
+        mX.insert(5, 50);
+        ASSERT(4 == mX.size());
+        ASSERT(2 == evicted.size());
+        ASSERT(10 == evicted[0]);
+        ASSERT(30 == evicted[1]);
+
+        loadKeys(&keys, mX);
+        ASSERT(4 == keys.size());
+        ASSERT(4 == keys[0]);
+        ASSERT(0 == keys[1]);
+        ASSERT(2 == keys[2]);
+        ASSERT(5 == keys[3]);
+
+        // The reference flags of 0 and 2 have been cleared, so they are not
+        // protected again unless accessed.
+
+        ASSERT(0 == mX.tryGetValue(&value, 4));
+        evicted.clear();
+        ASSERT(0 == mX.popFront());
+        ASSERT(1 == evicted.size());
+        ASSERT(0 == evicted[0]);
+
+        loadKeys(&keys, mX);
+        ASSERT(3 == keys.size());
+        ASSERT(2 == keys[0]);
+        ASSERT(5 == keys[1]);
+        ASSERT(4 == keys[2]);
+
+        // If every item has been accessed, a full sweep clears all the flags
+        // and the original front item is evicted.
+
+        ASSERT(0 == mX.tryGetValue(&value, 2));
+        ASSERT(0 == mX.tryGetValue(&value, 5));
+        ASSERT(0 == mX.tryGetValue(&value, 4));
+        evicted.clear();
+        ASSERT(0 == mX.popFront());
+        ASSERT(1 == evicted.size());
+        ASSERT(20 == evicted[0]);
+
+        loadKeys(&keys, mX);
+        ASSERT(2 == keys.size());
+        ASSERT(5 == keys[0]);
+        ASSERT(4 == keys[1]);
+
+        // Replacing a value moves the key to the back and clears its flag.
+
+        ASSERT(0 == mX.tryGetValue(&value, 5));
+        mX.insert(5, 55);
+        loadKeys(&keys, mX);
+        ASSERT(2 == keys.size());
+        ASSERT(4 == keys[0]);
+        ASSERT(5 == keys[1]);
+
+        evicted.clear();
+        ASSERT(0 == mX.popFront());
+        ASSERT(0 == mX.popFront());
+        ASSERT(1 == mX.popFront());
+        ASSERT(2 == evicted.size());
+        ASSERT(40 == evicted[0]);
+        ASSERT(55 == evicted[1]);
+        ASSERT(0 == mX.size());
+    }
+
+    // 'insertBulk' applies the same policy.
+    {
+        CacheType mX(bdlcc::CacheEvictionPolicy::e_CLOCK, 2, 3, &talloc);
+
+        typedef bsl::pair<int, bsl::shared_ptr<int> > PairType;
+        bsl::vector<PairType> data(&talloc);
+        for (int i = 0; i < 3; ++i) {
+            data.push_back(PairType(i,
+                                    bsl::allocate_shared<int>(&talloc, i)));
+        }
+        ASSERT(3 == mX.insertBulk(data));
+        ASSERT(0 == mX.tryGetValue(&value, 0));
+
+        data.clear();
+        data.push_back(PairType(3, bsl::allocate_shared<int>(&talloc, 3)));
+        ASSERT(1 == mX.insertBulk(data));
+
+        loadKeys(&keys, mX);
+        ASSERT(2 == keys.size());
+        ASSERT(0 == keys[0]);
+        ASSERT(3 == keys[1]);
+    }
+}
+
+}  // close namespace testClock
+
 namespace threaded {
 
 
@@ -3853,7 +4092,7 @@ int main(int argc, char *argv[])
 
     // BDE_VERIFY pragma: -TP17 These are defined in the various test functions
     switch (test) { case 0:
-      case 16: {
+      case 17: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -3875,6 +4114,9 @@ int main(int argc, char *argv[])
         usageExample2::example2();
       } break;
       // BDE_VERIFY pragma: -TP05 Defined in the various test functions
+      case 16: {
+        testClock::testClockEvictionPolicy();
+      } break;
       case 15: {
         testLock::testLocking();
       } break;
@@ -4012,7 +4254,8 @@ int main(int argc, char *argv[])
         //   control over the test, command line parameters are used.
         //   2nd parameter: number of threads.
         //   3rd parameter: number of rows to read.
-        //   4th parameter: if F, use FIFO for eviction policy; LRU othrwise.
+        //   4th parameter: if F, use FIFO for eviction policy; if C, use
+        //   CLOCK; LRU othrwise.
         //   5th parameter: sparsity of values loaded.  Sparsity is the
         //   distance between consecutive values inserted, and represents how
         //   likely is a read to find the key given. A value of 1 means
@@ -4042,6 +4285,8 @@ int main(int argc, char *argv[])
         bdlcc::CacheEvictionPolicy::Enum  evictionPolicy =
             (argc > 4 && argv[4][0] == 'F' ?
             bdlcc::CacheEvictionPolicy::e_FIFO :
+            argc > 4 && argv[4][0] == 'C' ?
+            bdlcc::CacheEvictionPolicy::e_CLOCK :
             bdlcc::CacheEvictionPolicy::e_LRU);
 
         int sparsity = argc > 5 ? atoi(argv[5]) : 1;
@@ -4072,7 +4317,8 @@ int main(int argc, char *argv[])
         //   2nd parameter: number of threads.
         //   3rd parameter: number of rows to read.
         //   4th parameter: number of writer threads.
-        //   5th parameter: if F, use FIFO for eviction policy; LRU othrwise.
+        //   5th parameter: if F, use FIFO for eviction policy; if C, use
+        //   CLOCK; LRU othrwise.
         //   6th parameter: sparsity of values loaded.  Sparsity is the
         //   distance between consecutive values inserted, and represents how
         //   likely is a read to find the key given. A value of 1 means
@@ -4105,6 +4351,8 @@ int main(int argc, char *argv[])
         bdlcc::CacheEvictionPolicy::Enum  evictionPolicy =
             (argc > 5 && argv[5][0] == 'F' ?
             bdlcc::CacheEvictionPolicy::e_FIFO :
+            argc > 5 && argv[5][0] == 'C' ?
+            bdlcc::CacheEvictionPolicy::e_CLOCK :
             bdlcc::CacheEvictionPolicy::e_LRU);
 
         int sparsity = argc > 6 ? atoi(argv[6]) : 1;
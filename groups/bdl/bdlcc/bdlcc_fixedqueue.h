@@ -32,6 +32,15 @@ BSLS_IDENT("$Id: $")
 // 'tryPushBack' and 'tryPopFront' are also provided, which fail immediately
 // returning a non-zero value in case of overflow or underflow.
 //
+// Batches of values may be pushed with the range overloads of 'pushBack' and
+// 'tryPushBack', and popped with the overloads of 'popFront' and 'tryPopFront'
+// taking a maximum number of items and a 'bsl::vector' to load.  A batch
+// operation reserves a contiguous run of cells in the underlying circular
+// buffer with a single index-manager operation, and wakes blocked threads
+// with a single semaphore post, which substantially reduces the per-element
+// synchronization cost when a producer or consumer handles elements in
+// bulk.
+//
 // The queue may be placed into a "disabled" state using the 'disable' method.
 // When disabled, 'pushBack' and 'tryPushBack' fail immediately (they do not
 // block and any blocked invocations will fail immediately).  The queue may be
@@ -58,8 +67,9 @@ BSLS_IDENT("$Id: $")
 ///----------------
 // A 'bdlcc::FixedQueue' is exception neutral, and all of the methods of
 // 'bdlcc::FixedQueue' provide the strong exception safety guarantee except for
-// 'pushBack' and 'tryPushBack', which provide the basic exception guarantee
-// (see 'bsldoc_glossary').
+// 'pushBack' and 'tryPushBack', and the batch overloads of 'popFront' and
+// 'tryPopFront', which provide the basic exception guarantee (see
+// 'bsldoc_glossary').
 //
 ///Memory Usage
 ///------------
@@ -241,6 +251,14 @@ BSLS_IDENT("$Id: $")
 #include <bsl_algorithm.h>
 #endif
 
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_ITERATOR
+#include <bsl_iterator.h>
+#endif
+
 #ifndef INCLUDED_BSL_VECTOR
 #include <bsl_vector.h>
 #endif
@@ -350,6 +368,30 @@ class FixedQueue {
         // unspecified state.  Return 0 on success, and a non-zero value if the
         // queue is full or disabled.
 
+    template <class FORWARD_ITER>
+    int pushBack(FORWARD_ITER begin, FORWARD_ITER end);
+        // Append the values in the specified range '[begin, end)' to the back
+        // of this queue, blocking until either space is available for all of
+        // them - if necessary - or the queue is disabled.  Return 0 if every
+        // value was appended, and a nonzero value if the queue was disabled
+        // (in which case some leading portion of the range may have been
+        // appended).  Values are appended in the order they appear in the
+        // range, though values appended concurrently by other threads may be
+        // interleaved with them.  The behavior is undefined unless
+        // 'FORWARD_ITER' is a forward iterator whose value type is
+        // convertible to 'TYPE'.  Note that the values are appended in
+        // batches, each of which is reserved using a single index-manager
+        // operation and wakes waiting poppers with a single semaphore post.
+
+    template <class FORWARD_ITER>
+    bsl::size_t tryPushBack(FORWARD_ITER begin, FORWARD_ITER end);
+        // Attempt to append the values in the specified range '[begin, end)'
+        // to the back of this queue without blocking, stopping at the first
+        // value for which no space is available, or if the queue is disabled.
+        // Return the number of values appended (a leading portion of the
+        // range).  The behavior is undefined unless 'FORWARD_ITER' is a
+        // forward iterator whose value type is convertible to 'TYPE'.
+
     void popFront(TYPE* value);
         // Remove the element from the front of this queue and load that
         // element into the specified 'value'.  If the queue is empty, block
@@ -359,12 +401,30 @@ class FixedQueue {
         // Remove the element from the front of this queue and return it's
         // value.  If the queue is empty, block until it is not empty.
 
+    bsl::size_t popFront(bsl::size_t maxNumItems, bsl::vector<TYPE> *buffer);
+        // Remove up to the specified 'maxNumItems' elements from the front of
+        // this queue and append them, in order, to the specified 'buffer'.  If
+        // the queue is empty, block until it is not empty.  Return the number
+        // of elements removed, which is at least 1.  The behavior is undefined
+        // unless '0 < maxNumItems'.  Note that fewer than 'maxNumItems'
+        // elements may be removed even if more are available (e.g., if other
+        // threads are concurrently popping elements).
+
     int tryPopFront(TYPE *value);
         // Attempt to remove the element from the front of this queue without
         // blocking, and, if successful, load the specified 'value' with the
         // removed element.  Return 0 on success, and a non-zero value if queue
         // was empty.  On failure, 'value' is not changed.
 
+    bsl::size_t tryPopFront(bsl::size_t        maxNumItems,
+                            bsl::vector<TYPE> *buffer);
+        // Attempt to remove up to the specified 'maxNumItems' elements from
+        // the front of this queue without blocking, and append them, in order,
+        // to the specified 'buffer'.  Return the number of elements removed
+        // (0 if the queue was empty).  Note that the removed elements are
+        // reserved using a single index-manager operation, and waiting
+        // pushers are woken with a single semaphore post.
+
     void removeAll();
         // Remove all items from this queue.  Note that this operation is not
         // atomic; if other threads are concurrently pushing items into the
@@ -416,9 +476,9 @@ class FixedQueue {
 template <class VALUE>
 class FixedQueue_PopGuard {
     // This class provides a guard that, upon its destruction, will remove
-    // (pop) the indicated element from the 'FixedQueue' object supplied at
+    // (pop) the indicated elements from the 'FixedQueue' object supplied at
     // construction.  Note that this guard is used to provide exception safety
-    // when popping an element from a 'FixedQueue' object.
+    // when popping elements from a 'FixedQueue' object.
 
     // DATA
     FixedQueue<VALUE> *d_parent_p;
@@ -426,10 +486,15 @@ class FixedQueue_PopGuard {
                                      // popped
 
     unsigned int                  d_generation;
-                                     // generation count of cell being popped
+                                     // generation count of first cell being
+                                     // popped
 
     unsigned int                  d_index;
-                                     // index of cell being popped
+                                     // index of first cell being popped
+
+    unsigned int                  d_numReserved;
+                                     // number of consecutive cells being
+                                     // popped
 
   private:
     // NOT IMPLEMENTED
@@ -440,19 +505,25 @@ class FixedQueue_PopGuard {
     // CREATORS
     FixedQueue_PopGuard(FixedQueue<VALUE> *queue,
                         unsigned int       generation,
-                        unsigned int       index);
+                        unsigned int       index,
+                        unsigned int       numReserved = 1);
         // Create a guard that, upon its destruction, will update the state of
         // the specified 'queue' to remove (pop) the element at the specified
         // 'index' having the specified 'generation', and destroy that popped
-        // object.  The behavior is undefined unless 'index' and 'generation'
-        // refer to a valid element in 'queue' that the current thread has
-        // acquired a reservation to pop (using
-        // 'FixedQueueIndexManager::reservePopIndex').
+        // object.  Optionally specify 'numReserved', the number of
+        // consecutive elements, starting at 'index', to remove.  If
+        // 'numReserved' is not specified, a single element is removed.  The
+        // behavior is undefined unless 'index' and 'generation' refer to a
+        // valid element in 'queue' that the current thread has acquired a
+        // reservation to pop (using
+        // 'FixedQueueIndexManager::reservePopIndex'), or unless 'index',
+        // 'generation', and 'numReserved' were loaded by
+        // 'FixedQueueIndexManager::reservePopIndices'.
 
     ~FixedQueue_PopGuard();
         // Update the state of the 'FixedQueue' object supplied at construction
-        // to remove (pop) the indicated element, and destroy the popped
-        // object.
+        // to remove (pop) the indicated elements, and destroy the popped
+        // objects.
 };
 
                         // ============================
@@ -480,6 +551,11 @@ class FixedQueue_PushProctor {
                                      // index of cell being pushed when an
                                      // exception was thrown
 
+    unsigned int                  d_numReserved;
+                                     // number of consecutive reserved cells,
+                                     // starting at 'd_index', that have not
+                                     // been committed
+
   private:
     // NOT IMPLEMENTED
     FixedQueue_PushProctor(const FixedQueue_PushProctor&);
@@ -490,19 +566,32 @@ class FixedQueue_PushProctor {
     // CREATORS
     FixedQueue_PushProctor(FixedQueue<VALUE> *queue,
                            unsigned int       generation,
-                           unsigned int       index);
+                           unsigned int       index,
+                           unsigned int       numReserved = 1);
         // Create a proctor that manages the specified 'queue' and, unless
         // 'release' is called, will remove and destroy all the elements from
         // 'queue' starting at the specified 'index' in the specified
-        // 'generation'.  The behavior is undefined unless 'index' and
-        // 'generation' refers to a valid element in 'queue'.
+        // 'generation'.  Optionally specify 'numReserved', the number of
+        // consecutive cells, starting at 'index', that the current thread has
+        // reserved for pushing and that will be released if an exception is
+        // thrown.  If 'numReserved' is not specified, a single cell is
+        // managed.  The behavior is undefined unless 'index' and 'generation'
+        // refers to a valid element in 'queue'.
 
     ~FixedQueue_PushProctor();
         // Destroy this proctor and, if 'release' was not called on this
         // object, remove and destroy all the elements from the 'FixedQueue'
-        // object supplied at construction.
+        // object supplied at construction, and release the reservations on
+        // the managed cells.
 
     // MANIPULATORS
+    void advance();
+        // Release from management the first of the cells managed by this
+        // proctor, which the caller has committed, and continue to manage the
+        // cells following it.  If no cells remain, release from management
+        // the 'FixedQueue' object supplied at construction.  The behavior is
+        // undefined unless this proctor manages at least one cell.
+
     void release();
         // Release from management the 'FixedQueue' object supplied at
         // construction.
@@ -625,6 +714,66 @@ int FixedQueue<TYPE>::tryPushBack(bslmf::MovableRef<TYPE> value)
     return 0;
 }
 
+template <class TYPE>
+template <class FORWARD_ITER>
+bsl::size_t FixedQueue<TYPE>::tryPushBack(FORWARD_ITER begin,
+                                          FORWARD_ITER end)
+{
+    bsl::size_t numRemaining = bsl::distance(begin, end);
+    bsl::size_t numPushed    = 0;
+
+    while (0 < numRemaining) {
+        unsigned int generation;
+        unsigned int index;
+        unsigned int numReserved;
+
+        // SYNCHRONIZATION POINT 1
+        //
+        // See 'tryPushBack(const TYPE&)'.  'reservePushIndices' writes
+        // 'FixedQueueIndexManager::d_pushIndex' with full sequential
+        // consistency before returning successfully.
+
+        const unsigned int maxNumReserved = static_cast<unsigned int>(
+                                 bsl::min(numRemaining, d_impl.capacity()));
+
+        if (0 != d_impl.reservePushIndices(&generation,
+                                           &index,
+                                           &numReserved,
+                                           maxNumReserved)) {
+            break;
+        }
+
+        // Copy each element into its cell, and commit the cell, in order.  If
+        // an exception is thrown by the copy constructor, PushProctor will pop
+        // and discard items until reaching the cell being written, and then
+        // release that cell and the remaining reserved cells.
+
+        FixedQueue_PushProctor<TYPE> guard(this,
+                                           generation,
+                                           index,
+                                           numReserved);
+        for (unsigned int i = 0; i < numReserved; ++i, ++begin) {
+            bslalg::ScalarPrimitives::copyConstruct(&d_elements[index],
+                                                    *begin,
+                                                    d_allocator_p);
+            guard.advance();
+            d_impl.commitPushIndex(generation, index);
+            d_impl.advanceIndex(&generation, &index);
+        }
+
+        numPushed    += numReserved;
+        numRemaining -= numReserved;
+
+        const int numWaitingPoppers = d_numWaitingPoppers;
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(numWaitingPoppers)) {
+            d_popControlSema.post(bsl::min(static_cast<int>(numReserved),
+                                           numWaitingPoppers));
+        }
+    }
+
+    return numPushed;
+}
+
 template <class TYPE>
 int FixedQueue<TYPE>::tryPopFront(TYPE *value)
 {
@@ -662,6 +811,56 @@ int FixedQueue<TYPE>::tryPopFront(TYPE *value)
     return 0;
 }
 
+template <class TYPE>
+bsl::size_t FixedQueue<TYPE>::tryPopFront(bsl::size_t        maxNumItems,
+                                          bsl::vector<TYPE> *buffer)
+{
+    BSLS_ASSERT(buffer);
+
+    if (0 == maxNumItems) {
+        return 0;                                                     // RETURN
+    }
+
+    unsigned int generation;
+    unsigned int index;
+    unsigned int numReserved;
+
+    // SYNCHRONIZATION POINT 2
+    //
+    // See 'tryPopFront(TYPE *)'.  'reservePopIndices' writes
+    // 'FixedQueueIndexManager::d_popIndex' with full sequential consistency
+    // before returning successfully.
+
+    const unsigned int maxNumReserved = static_cast<unsigned int>(
+                                  bsl::min(maxNumItems, d_impl.capacity()));
+
+    if (0 != d_impl.reservePopIndices(&generation,
+                                      &index,
+                                      &numReserved,
+                                      maxNumReserved)) {
+        return 0;                                                     // RETURN
+    }
+
+    // Copy or move the elements.  'FixedQueue_PopGuard' will destroy the
+    // original objects, update the queue, and release waiting pushers, even
+    // if an exception is thrown.
+
+    FixedQueue_PopGuard<TYPE> guard(this, generation, index, numReserved);
+
+    buffer->reserve(buffer->size() + numReserved);
+    for (unsigned int i = 0; i < numReserved; ++i) {
+        // See 'tryPopFront(TYPE *)' regarding the use of 'move'.
+
+#if defined(BSLMF_MOVABLEREF_USES_RVALUE_REFERENCES)
+        buffer->push_back(bslmf::MovableRefUtil::move(d_elements[index]));
+#else
+        buffer->push_back(d_elements[index]);
+#endif
+        d_impl.advanceIndex(&generation, &index);
+    }
+    return numReserved;
+}
+
 // MANIPULATORS
 template <class TYPE>
 int FixedQueue<TYPE>::pushBack(const TYPE& value)
@@ -725,6 +924,37 @@ int FixedQueue<TYPE>::pushBack(bslmf::MovableRef<TYPE> value)
     return 0;
 }
 
+template <class TYPE>
+template <class FORWARD_ITER>
+int FixedQueue<TYPE>::pushBack(FORWARD_ITER begin, FORWARD_ITER end)
+{
+    for (;;) {
+        bsl::advance(begin, tryPushBack(begin, end));
+
+        if (begin == end) {
+            return 0;                                                 // RETURN
+        }
+
+        if (!isEnabled()) {
+            // The queue is disabled.
+
+            return -1;                                                // RETURN
+        }
+
+        d_numWaitingPushers.addRelaxed(1);
+
+        // SYNCHRONIZATION POINT 1-Prime
+        //
+        // See 'pushBack(const TYPE&)'.
+
+        if (isFull() && isEnabled()) {
+            d_pushControlSema.wait();
+        }
+
+        d_numWaitingPushers.addRelaxed(-1);
+    }
+}
+
 template <class TYPE>
 void FixedQueue<TYPE>::popFront(TYPE *value)
 {
@@ -779,6 +1009,30 @@ TYPE FixedQueue<TYPE>::popFront()
 #endif
 }
 
+template <class TYPE>
+bsl::size_t FixedQueue<TYPE>::popFront(bsl::size_t        maxNumItems,
+                                       bsl::vector<TYPE> *buffer)
+{
+    BSLS_ASSERT(0 < maxNumItems);
+    BSLS_ASSERT(buffer);
+
+    bsl::size_t numPopped;
+    while (0 == (numPopped = tryPopFront(maxNumItems, buffer))) {
+        d_numWaitingPoppers.addRelaxed(1);
+
+        // SYNCHRONIZATION POINT 2-Prime
+        //
+        // See 'popFront(TYPE *)'.
+
+        if (isEmpty()) {
+            d_popControlSema.wait();
+        }
+
+        d_numWaitingPoppers.addRelaxed(-1);
+    }
+    return numPopped;
+}
+
 template <class TYPE>
 void FixedQueue<TYPE>::removeAll()
 {
@@ -883,31 +1137,46 @@ template <class VALUE>
 inline
 FixedQueue_PopGuard<VALUE>::FixedQueue_PopGuard(FixedQueue<VALUE> *queue,
                                                 unsigned int       generation,
-                                                unsigned int       index)
+                                                unsigned int       index,
+                                                unsigned int       numReserved)
 : d_parent_p(queue)
 , d_generation(generation)
 , d_index(index)
+, d_numReserved(numReserved)
 {
 }
 
 template <class VALUE>
 FixedQueue_PopGuard<VALUE>::~FixedQueue_PopGuard()
 {
-    // This popping thread currently has the cell at 'd_index' (in
-    // 'd_generation') reserved for popping.  Destroy the element at that
-    // position and then release the reservation.  Wake up to 1 waiting pusher
-    // thread.
+    // This popping thread currently has the 'd_numReserved' cells starting at
+    // 'd_index' (in 'd_generation') reserved for popping.  Destroy the
+    // elements at those positions and then release the reservations.  Wake up
+    // to 'd_numReserved' waiting pusher threads.
 
-    bslalg::ScalarDestructionPrimitives::destroy(
-                                             d_parent_p->d_elements + d_index);
+    unsigned int generation = d_generation;
+    unsigned int index      = d_index;
 
-    d_parent_p->d_impl.commitPopIndex(d_generation, d_index);
+    for (unsigned int i = 0; i < d_numReserved; ++i) {
+        bslalg::ScalarDestructionPrimitives::destroy(
+                                               d_parent_p->d_elements + index);
+
+        d_parent_p->d_impl.commitPopIndex(generation, index);
+        d_parent_p->d_impl.advanceIndex(&generation, &index);
+    }
 
-    // Notify pusher of available element.
+    // Notify pushers of available elements.
 
-    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
-            d_parent_p->d_numWaitingPushers)) {
-        d_parent_p->d_pushControlSema.post();
+    const int numWaitingPushers = d_parent_p->d_numWaitingPushers;
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(numWaitingPushers)) {
+        if (1 == d_numReserved) {
+            d_parent_p->d_pushControlSema.post();
+        }
+        else {
+            d_parent_p->d_pushControlSema.post(
+                              bsl::min(static_cast<int>(d_numReserved),
+                                       numWaitingPushers));
+        }
     }
 }
 
@@ -919,12 +1188,14 @@ FixedQueue_PopGuard<VALUE>::~FixedQueue_PopGuard()
 template <class VALUE>
 inline
 FixedQueue_PushProctor<VALUE>::FixedQueue_PushProctor(
-                                                 FixedQueue<VALUE> *queue,
-                                                 unsigned int       generation,
-                                                 unsigned int       index)
+                                                FixedQueue<VALUE> *queue,
+                                                unsigned int       generation,
+                                                unsigned int       index,
+                                                unsigned int       numReserved)
 : d_parent_p(queue)
 , d_generation(generation)
 , d_index(index)
+, d_numReserved(numReserved)
 {
 }
 
@@ -932,29 +1203,37 @@ template <class VALUE>
 FixedQueue_PushProctor<VALUE>::~FixedQueue_PushProctor()
 {
     if (d_parent_p) {
-        // This pushing thread currently has the cell at 'd_index' reserved as
-        // 'e_WRITING'.  Dispose of all the elements up to 'd_index'.
+        // This pushing thread currently has the 'd_numReserved' cells
+        // starting at 'd_index' reserved as 'e_WRITING'.  For each of those
+        // cells, in order, dispose of all the elements up to that cell, and
+        // then release the cell.
 
         unsigned int generation, index;
 
-        // We will always have at least 1 popped item for the cell reserved for
-        // writing by the current thread.
+        int poppedItems = 0;
+        for (unsigned int i = 0; i < d_numReserved; ++i) {
+            // We will always have at least 1 popped item for each cell
+            // reserved for writing by the current thread.
 
-        int poppedItems = 1;
-        while (0 == d_parent_p->d_impl.reservePopIndexForClear(&generation,
+            ++poppedItems;
+            while (0 == d_parent_p->d_impl.reservePopIndexForClear(
+                                                               &generation,
                                                                &index,
                                                                d_generation,
                                                                d_index)) {
-            bslalg::ScalarDestructionPrimitives::destroy(
+                bslalg::ScalarDestructionPrimitives::destroy(
                                               d_parent_p->d_elements + index);
-            ++poppedItems;
+                ++poppedItems;
 
-            d_parent_p->d_impl.commitPopIndex(generation, index);
-        }
+                d_parent_p->d_impl.commitPopIndex(generation, index);
+            }
 
-        // Release the currently held pop index.
+            // Release the currently held pop index.
 
-        d_parent_p->d_impl.abortPushIndexReservation(d_generation, d_index);
+            d_parent_p->d_impl.abortPushIndexReservation(d_generation,
+                                                         d_index);
+            d_parent_p->d_impl.advanceIndex(&d_generation, &d_index);
+        }
 
         while (poppedItems--) {
             // Wake up waiting pushers.
@@ -965,6 +1244,21 @@ FixedQueue_PushProctor<VALUE>::~FixedQueue_PushProctor()
 }
 
 // MANIPULATORS
+template <class VALUE>
+inline
+void FixedQueue_PushProctor<VALUE>::advance()
+{
+    BSLS_ASSERT(d_parent_p);
+    BSLS_ASSERT(0 < d_numReserved);
+
+    if (0 == --d_numReserved) {
+        d_parent_p = 0;
+    }
+    else {
+        d_parent_p->d_impl.advanceIndex(&d_generation, &d_index);
+    }
+}
+
 template <class VALUE>
 inline
 void FixedQueue_PushProctor<VALUE>::release()
@@ -1189,6 +1189,172 @@ int IncorrectlyMatchingMoveConstructorTestType::data() const
 
 }  // close namespace case18
 
+namespace case19 {
+
+enum { k_SENTINEL = -1 };
+
+void batchProducer(bdlcc::FixedQueue<int> *queue,
+                   int                     producerId,
+                   int                     numItems)
+    // Push the specified 'numItems' values, '(producerId << 20) + i' for 'i'
+    // in '[0, numItems)', into the specified 'queue' using the range
+    // 'pushBack' in batches of varying size.  The behavior is undefined
+    // unless 'numItems < (1 << 20)'.
+{
+    int values[32];
+    int seed = producerId;
+    int next = 0;
+    while (next < numItems) {
+        int batchSize = 1 + bdlb::Random::generate15(&seed) % 32;
+        if (batchSize > numItems - next) {
+            batchSize = numItems - next;
+        }
+        for (int i = 0; i < batchSize; ++i) {
+            values[i] = (producerId << 20) + next + i;
+        }
+        int rc = queue->pushBack(values, values + batchSize);
+        ASSERTT(0 == rc);
+        next += batchSize;
+    }
+}
+
+void batchConsumer(bdlcc::FixedQueue<int> *queue, bsl::vector<int> *result)
+    // Pop values from the specified 'queue' in batches using the blocking
+    // 'popFront', appending them to the specified 'result', until reading
+    // 'k_SENTINEL'.  Note that any sentinels that follow the first one in a
+    // batch are pushed back into 'queue' for the other consumers.
+{
+    bsl::vector<int> buffer;
+    for (;;) {
+        buffer.clear();
+        bsl::size_t numPopped = queue->popFront(16, &buffer);
+        ASSERTT(0 < numPopped && buffer.size() == numPopped);
+
+        for (bsl::size_t i = 0; i < buffer.size(); ++i) {
+            if (k_SENTINEL == buffer[i]) {
+                for (bsl::size_t j = i + 1; j < buffer.size(); ++j) {
+                    ASSERTT(k_SENTINEL == buffer[j]);
+                    queue->pushBack(buffer[j]);
+                }
+                return;                                               // RETURN
+            }
+            result->push_back(buffer[i]);
+        }
+    }
+}
+
+#ifdef BDE_BUILD_TARGET_EXC
+
+class CountdownTester {
+    // This class provides a test type whose copy constructor throws after a
+    // configurable number of copies, and that tracks the number of live
+    // objects.
+
+  public:
+    // CLASS DATA
+    static int s_numCopiesBeforeThrow;  // copies to allow before throwing
+                                        // (no throw if negative)
+    static int s_numLive;               // number of live objects
+
+    // DATA
+    int d_value;
+
+    // CREATORS
+    explicit CountdownTester(int value = 0)
+    : d_value(value)
+    {
+        ++s_numLive;
+    }
+
+    CountdownTester(const CountdownTester& original)
+    : d_value(original.d_value)
+    {
+        if (0 == s_numCopiesBeforeThrow) {
+            s_numCopiesBeforeThrow = -1;
+            throw 1;
+        }
+        if (0 < s_numCopiesBeforeThrow) {
+            --s_numCopiesBeforeThrow;
+        }
+        ++s_numLive;
+    }
+
+    ~CountdownTester()
+    {
+        --s_numLive;
+    }
+};
+
+int CountdownTester::s_numCopiesBeforeThrow = -1;
+int CountdownTester::s_numLive              = 0;
+
+#endif
+
+void pushBackRangeAndStoreResult(bdlcc::FixedQueue<int> *queue,
+                                 const int              *begin,
+                                 const int              *end,
+                                 bsls::AtomicInt        *result)
+    // Push the values in the specified range '[begin, end)' into the
+    // specified 'queue' using the blocking range 'pushBack', and store the
+    // returned status into the specified 'result'.
+{
+    *result = queue->pushBack(begin, end);
+}
+
+}  // close namespace case19
+
+namespace benchtst {
+
+struct BatchBenchArgs {
+    bdlcc::FixedQueue<int> *d_queue_p;        // queue under test
+    int                     d_numItems;       // items per producer
+    int                     d_batchSize;      // 0 for per-element calls
+    bsls::AtomicInt        *d_numRemaining_p; // items left to consume
+};
+
+void benchBatchProducer(BatchBenchArgs args)
+{
+    bsl::vector<int> values(args.d_batchSize ? args.d_batchSize : 1, 7);
+    for (int i = 0; i < args.d_numItems;) {
+        if (0 == args.d_batchSize) {
+            args.d_queue_p->pushBack(i);
+            ++i;
+        }
+        else {
+            const int n = bsl::min(args.d_batchSize, args.d_numItems - i);
+            args.d_queue_p->pushBack(values.begin(), values.begin() + n);
+            i += n;
+        }
+    }
+}
+
+void benchBatchConsumer(BatchBenchArgs args)
+{
+    bsl::vector<int> buffer;
+    buffer.reserve(args.d_batchSize);
+    while (0 < args.d_numRemaining_p->load()) {
+        int numPopped;
+        if (0 == args.d_batchSize) {
+            int value;
+            numPopped = 0 == args.d_queue_p->tryPopFront(&value) ? 1 : 0;
+        }
+        else {
+            buffer.clear();
+            numPopped = static_cast<int>(args.d_queue_p->tryPopFront(
+                                                              args.d_batchSize,
+                                                              &buffer));
+        }
+        if (0 == numPopped) {
+            bslmt::ThreadUtil::yield();
+        }
+        else {
+            args.d_numRemaining_p->add(-numPopped);
+        }
+    }
+}
+
+}  // close namespace benchtst
+
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -1303,7 +1469,7 @@ int main(int argc, char *argv[])
                     bslmt::Configuration::recommendedDefaultThreadStackSize());
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 19: {
+      case 20: {
         // ---------------------------------------------------------
         // Usage example test
         //
@@ -1319,6 +1485,299 @@ int main(int argc, char *argv[])
         break;
       }
 
+      case 19: {
+        // ---------------------------------------------------------
+        // Batch push and pop test
+        //
+        // Test the range overloads of 'pushBack' and 'tryPushBack', and the
+        // batch overloads of 'popFront' and 'tryPopFront':
+        //: 1 Values are pushed and popped in order, partial batches are
+        //:   pushed when the queue fills, and batches wrap around the end of
+        //:   the underlying buffer.
+        //:
+        //: 2 Range pushes fail on a disabled queue.
+        //:
+        //: 3 The blocking overloads block until space or values are
+        //:   available.
+        //:
+        //: 4 With concurrent batch producers and consumers, every value is
+        //:   popped exactly once, and each consumer sees the values of each
+        //:   producer in the order they were pushed.
+        //:
+        //: 5 If an exception is thrown, the queue is left in a valid state
+        //:   and no elements are leaked.
+        // ---------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "Batch push and pop test" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        if (verbose) cout << "\tSingle-threaded batches" << endl;
+        {
+            enum { k_CAPACITY = 5 };
+
+            bdlcc::FixedQueue<int> queue(k_CAPACITY, &ta);
+
+            const int VALUES[] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+            const int NUM_VALUES = sizeof VALUES / sizeof *VALUES;
+
+            bsl::vector<int> result(&ta);
+
+            ASSERT(0 == queue.tryPopFront(4, &result));
+            ASSERT(0 == queue.tryPopFront(0, &result));
+            ASSERT(result.empty());
+
+            ASSERT(0 == queue.tryPushBack(VALUES, VALUES));
+
+            ASSERT(k_CAPACITY == queue.tryPushBack(VALUES,
+                                                   VALUES + NUM_VALUES));
+            ASSERT(k_CAPACITY == queue.numElements());
+            ASSERT(0 == queue.tryPushBack(VALUES, VALUES + NUM_VALUES));
+
+            ASSERT(3 == queue.tryPopFront(3, &result));
+            ASSERT(3 == result.size());
+            ASSERT(0 == result[0] && 1 == result[1] && 2 == result[2]);
+            ASSERT(2 == queue.numElements());
+
+            // The next batch wraps around the end of the buffer.
+
+            ASSERT(3 == queue.tryPushBack(VALUES + 5, VALUES + NUM_VALUES));
+            ASSERT(queue.isFull());
+
+            ASSERT(5 == queue.tryPopFront(100, &result));
+            ASSERT(NUM_VALUES == result.size());
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                LOOP2_ASSERT(i, result[i], VALUES[i] == result[i]);
+            }
+            ASSERT(queue.isEmpty());
+
+            // Run many generations of uneven batches through the queue.
+
+            int nextPushed = 0;
+            int nextPopped = 0;
+            for (int i = 0; i < 1000; ++i) {
+                int values[k_CAPACITY + 2];
+                const int numValues = 1 + i % (k_CAPACITY + 2);
+                for (int j = 0; j < numValues; ++j) {
+                    values[j] = nextPushed + j;
+                }
+                nextPushed += static_cast<int>(
+                               queue.tryPushBack(values, values + numValues));
+
+                result.clear();
+                queue.tryPopFront(1 + i % 3, &result);
+                for (bsl::size_t j = 0; j < result.size(); ++j) {
+                    LOOP2_ASSERT(nextPopped, result[j],
+                                 nextPopped == result[j]);
+                    ++nextPopped;
+                }
+                LOOP_ASSERT(i, nextPushed - nextPopped == queue.length());
+            }
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\tDisabled queue" << endl;
+        {
+            bdlcc::FixedQueue<int> queue(4, &ta);
+
+            const int VALUES[] = { 1, 2, 3 };
+
+            queue.disable();
+            ASSERT(0 == queue.tryPushBack(VALUES, VALUES + 3));
+            ASSERT(0 != queue.pushBack(VALUES, VALUES + 3));
+            ASSERT(queue.isEmpty());
+
+            queue.enable();
+            ASSERT(0 == queue.pushBack(VALUES, VALUES + 3));
+            ASSERT(3 == queue.numElements());
+
+            // A blocked range push fails when the queue is disabled.
+
+            bslmt::ThreadGroup threads(&ta);
+            bsls::AtomicInt    rc(0);
+            const int *BEGIN = VALUES;
+            const int *END   = VALUES + 3;
+
+            threads.addThread(bdlf::BindUtil::bindS(
+                                      &ta,
+                                      &case19::pushBackRangeAndStoreResult,
+                                      &queue,
+                                      BEGIN,
+                                      END,
+                                      &rc));
+
+            while (!queue.isFull()) {
+                bslmt::ThreadUtil::yield();
+            }
+            bslmt::ThreadUtil::microSleep(10000);
+            queue.disable();
+            threads.joinAll();
+
+            ASSERT(0 != rc);
+            ASSERT(4 == queue.numElements());
+            queue.removeAll();
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\tBlocking batches" << endl;
+        {
+            enum { k_NUM_ITEMS = 10000 };
+
+            const int numItems = k_NUM_ITEMS;
+
+            bdlcc::FixedQueue<int> queue(7, &ta);
+
+            bslmt::ThreadGroup threads(&ta);
+            threads.addThread(bdlf::BindUtil::bindS(&ta,
+                                                    &case19::batchProducer,
+                                                    &queue,
+                                                    0,
+                                                    numItems));
+
+            bsl::vector<int> result(&ta);
+            while (result.size() < k_NUM_ITEMS) {
+                const bsl::size_t size = result.size();
+                const bsl::size_t n    = queue.popFront(5, &result);
+                ASSERT(1 <= n && n <= 5);
+                ASSERT(size + n == result.size());
+            }
+            threads.joinAll();
+
+            ASSERT(queue.isEmpty());
+            for (int i = 0; i < k_NUM_ITEMS; ++i) {
+                LOOP2_ASSERT(i, result[i], i == result[i]);
+            }
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\tConcurrent producers and consumers" << endl;
+        {
+            enum {
+                k_NUM_PRODUCERS = 4,
+                k_NUM_CONSUMERS = 4,
+                k_NUM_ITEMS     = 20000  // per producer
+            };
+
+            const int numItems = k_NUM_ITEMS;
+
+            bdlcc::FixedQueue<int> queue(61, &ta);
+
+            bsl::vector<bsl::vector<int> > results(k_NUM_CONSUMERS, &ta);
+
+            bslmt::ThreadGroup consumers(&ta);
+            for (int i = 0; i < k_NUM_CONSUMERS; ++i) {
+                consumers.addThread(bdlf::BindUtil::bindS(
+                                                       &ta,
+                                                       &case19::batchConsumer,
+                                                       &queue,
+                                                       &results[i]));
+            }
+
+            bslmt::ThreadGroup producers(&ta);
+            for (int i = 0; i < k_NUM_PRODUCERS; ++i) {
+                producers.addThread(bdlf::BindUtil::bindS(
+                                                       &ta,
+                                                       &case19::batchProducer,
+                                                       &queue,
+                                                       i,
+                                                       numItems));
+            }
+            producers.joinAll();
+
+            const int SENTINELS[k_NUM_CONSUMERS] = { case19::k_SENTINEL,
+                                                     case19::k_SENTINEL,
+                                                     case19::k_SENTINEL,
+                                                     case19::k_SENTINEL };
+            ASSERT(0 == queue.pushBack(SENTINELS,
+                                       SENTINELS + k_NUM_CONSUMERS));
+            consumers.joinAll();
+            ASSERT(queue.isEmpty());
+
+            bsl::vector<int> seen(k_NUM_PRODUCERS * k_NUM_ITEMS, 0, &ta);
+            for (int i = 0; i < k_NUM_CONSUMERS; ++i) {
+                int last[k_NUM_PRODUCERS] = { -1, -1, -1, -1 };
+
+                const bsl::vector<int>& result = results[i];
+                for (bsl::size_t j = 0; j < result.size(); ++j) {
+                    const int producer = result[j] >> 20;
+                    const int value    = result[j] & ((1 << 20) - 1);
+
+                    ASSERT(0 <= producer && producer < k_NUM_PRODUCERS);
+                    ASSERT(0 <= value    && value    < k_NUM_ITEMS);
+                    LOOP3_ASSERT(i, producer, value,
+                                 last[producer] < value);
+                    last[producer] = value;
+
+                    ++seen[producer * k_NUM_ITEMS + value];
+                }
+            }
+            for (bsl::size_t i = 0; i < seen.size(); ++i) {
+                LOOP2_ASSERT(i, seen[i], 1 == seen[i]);
+            }
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+#ifdef BDE_BUILD_TARGET_EXC
+        if (verbose) cout << "\tException safety" << endl;
+        {
+            typedef case19::CountdownTester Tester;
+
+            bdlcc::FixedQueue<Tester> queue(8, &ta);
+
+            const Tester VALUES[5];
+
+            ASSERT(0 == queue.pushBack(Tester(1)));
+            ASSERT(0 == queue.pushBack(Tester(2)));
+
+            // The third copy of the range throws: the queue is emptied and
+            // the remaining reserved cells are released.
+
+            Tester::s_numCopiesBeforeThrow = 2;
+            bool caught = false;
+            try {
+                queue.tryPushBack(VALUES, VALUES + 5);
+            }
+            catch (...) {
+                caught = true;
+            }
+            ASSERT(caught);
+            ASSERT(queue.isEmpty());
+            LOOP_ASSERT(Tester::s_numLive, 5 == Tester::s_numLive);
+
+            // The queue is still functional.
+
+            ASSERT(5 == queue.tryPushBack(VALUES, VALUES + 5));
+            ASSERT(3 == queue.tryPushBack(VALUES, VALUES + 5));
+            ASSERT(queue.isFull());
+
+            // The second copy into the buffer throws: the reserved elements
+            // are removed and destroyed.
+
+            {
+                bsl::vector<Tester> buffer(&ta);
+                Tester::s_numCopiesBeforeThrow = 1;
+                caught = false;
+                try {
+                    queue.tryPopFront(3, &buffer);
+                }
+                catch (...) {
+                    caught = true;
+                }
+                ASSERT(caught);
+                LOOP_ASSERT(queue.numElements(), 5 == queue.numElements());
+                LOOP_ASSERT(buffer.size(), 1 == buffer.size());
+
+                ASSERT(5 == queue.tryPopFront(8, &buffer));
+                ASSERT(queue.isEmpty());
+                ASSERT(6 == buffer.size());
+            }
+            LOOP_ASSERT(Tester::s_numLive, 5 == Tester::s_numLive);
+        }
+        ASSERT(0 == ta.numBytesInUse());
+#endif
+      } break;
       case 18: {
           // ---------------------------------------------------------
           // Moving tests
@@ -3112,6 +3571,77 @@ int main(int argc, char *argv[])
         bsl::cout << "Done.  testStatus = " << testStatus << bsl::endl;
       } break;
 
+      case -10: {
+        // --------------------------------------------------------------------
+        // BATCH THROUGHPUT BENCHMARK
+        //
+        // Compare the throughput of per-element 'pushBack' and 'tryPopFront'
+        // with the batch overloads for a series of batch sizes.
+        //
+        // Usage: -10 [numItems] [numProducers] [numConsumers] [capacity]
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BATCH THROUGHPUT BENCHMARK" << endl
+                          << "==========================" << endl;
+
+        const int numItems     = argc > 2 ? atoi(argv[2]) : 2000000;
+        const int numProducers = argc > 3 ? atoi(argv[3]) : 1;
+        const int numConsumers = argc > 4 ? atoi(argv[4]) : 1;
+        const int capacity     = argc > 5 ? atoi(argv[5]) : 1024;
+
+        cout << "items=" << numItems
+             << " producers=" << numProducers
+             << " consumers=" << numConsumers
+             << " capacity=" << capacity << endl;
+
+        const int BATCH_SIZES[] = { 0, 1, 4, 16, 64, 256 };
+        const int NUM_BATCH_SIZES = sizeof BATCH_SIZES / sizeof *BATCH_SIZES;
+
+        for (int i = 0; i < NUM_BATCH_SIZES; ++i) {
+            bdlcc::FixedQueue<int> queue(capacity);
+            bsls::AtomicInt        numRemaining(numItems * numProducers);
+
+            benchtst::BatchBenchArgs args;
+            args.d_queue_p        = &queue;
+            args.d_numItems       = numItems;
+            args.d_batchSize      = BATCH_SIZES[i];
+            args.d_numRemaining_p = &numRemaining;
+
+            bsls::Stopwatch timer;
+            timer.start(true);
+
+            bslmt::ThreadGroup threads;
+            threads.addThreads(bdlf::BindUtil::bind(
+                                             &benchtst::benchBatchConsumer,
+                                             args),
+                               numConsumers);
+            threads.addThreads(bdlf::BindUtil::bind(
+                                             &benchtst::benchBatchProducer,
+                                             args),
+                               numProducers);
+            threads.joinAll();
+
+            timer.stop();
+
+            double wall = timer.elapsedTime();
+            double rate = wall > 0
+                        ? static_cast<double>(numItems) * numProducers / wall
+                        : 0;
+
+            if (0 == BATCH_SIZES[i]) {
+                cout << "per-element:";
+            }
+            else {
+                cout << "batch " << BATCH_SIZES[i] << ":";
+            }
+            cout << " wall=" << wall
+                 << "s user=" << timer.accumulatedUserTime()
+                 << "s system=" << timer.accumulatedSystemTime()
+                 << "s items/s=" << static_cast<bsls::Types::Int64>(rate)
+                 << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
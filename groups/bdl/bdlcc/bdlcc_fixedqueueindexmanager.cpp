@@ -493,6 +493,85 @@ void FixedQueueIndexManager::commitPushIndex(unsigned int generation,
     d_states[index] = encodeElementState(generation, e_FULL);
 }
 
+int FixedQueueIndexManager::reservePushIndices(
+                                                  unsigned int *generation,
+                                                  unsigned int *index,
+                                                  unsigned int *numReserved,
+                                                  unsigned int  maxNumReserved)
+{
+    BSLS_ASSERT(0 != generation);
+    BSLS_ASSERT(0 != index);
+    BSLS_ASSERT(0 != numReserved);
+    BSLS_ASSERT(0 <  maxNumReserved);
+
+    unsigned int currGeneration, currIndex;
+
+    int rc = reservePushIndex(&currGeneration, &currIndex);
+    if (0 != rc) {
+        return rc;                                                    // RETURN
+    }
+
+    *generation = currGeneration;
+    *index      = currIndex;
+
+    // Attempt to extend the reservation over the cells that immediately follow
+    // the reserved cell.  A subsequent cell can be acquired only if it is
+    // empty in the generation at which the push index will reach it; we stop
+    // at the first cell that is still full (the queue is full) or that has
+    // been acquired by another pusher.  Note that 'reservePushIndex' advances
+    // the push index past any cell that is already marked 'e_WRITING' in the
+    // current generation, so acquiring a cell ahead of 'd_pushIndex' is
+    // indistinguishable, to other threads, from a pusher that has not yet
+    // incremented the push index.  Also note that the cell 'd_capacity'
+    // positions after the first reserved cell is the first reserved cell
+    // itself, which is marked 'e_WRITING', so at most 'd_capacity' cells can
+    // be reserved.
+
+    unsigned int count = 1;
+    while (count < maxNumReserved) {
+        unsigned int nextGen   = currGeneration;
+        unsigned int nextIndex = currIndex;
+        advanceIndex(&nextGen, &nextIndex);
+
+        const int compare = encodeElementState(nextGen, e_EMPTY);
+        const int swap    = encodeElementState(nextGen, e_WRITING);
+        if (compare != d_states[nextIndex].testAndSwap(compare, swap)) {
+            break;
+        }
+
+        currGeneration = nextGen;
+        currIndex      = nextIndex;
+        ++count;
+    }
+
+    if (1 < count) {
+        // Attempt to move the push index beyond the last reserved cell, unless
+        // another thread has already done so.  If the queue has been disabled
+        // we leave the push index unchanged; pushers will advance it past the
+        // reserved cells once the queue is re-enabled.
+
+        const unsigned int endCombinedIndex = nextCombinedIndex(
+                     currGeneration * static_cast<unsigned int>(d_capacity)
+                                                                  + currIndex);
+
+        unsigned int loadedPushIndex = d_pushIndex.loadRelaxed();
+        while (!isDisabledFlagSet(loadedPushIndex)
+            && 0 < circularDifference(endCombinedIndex,
+                                      loadedPushIndex,
+                                      d_maxCombinedIndex + 1)) {
+            const unsigned int was = d_pushIndex.testAndSwap(loadedPushIndex,
+                                                             endCombinedIndex);
+            if (was == loadedPushIndex) {
+                break;
+            }
+            loadedPushIndex = was;
+        }
+    }
+
+    *numReserved = count;
+    return 0;
+}
+
 int FixedQueueIndexManager::reservePopIndex(unsigned int *generation,
                                             unsigned int *index)
 {
@@ -606,6 +685,76 @@ int FixedQueueIndexManager::reservePopIndex(unsigned int *generation,
     return 0;
 }
 
+int FixedQueueIndexManager::reservePopIndices(
+                                                  unsigned int *generation,
+                                                  unsigned int *index,
+                                                  unsigned int *numReserved,
+                                                  unsigned int  maxNumReserved)
+{
+    BSLS_ASSERT(0 != generation);
+    BSLS_ASSERT(0 != index);
+    BSLS_ASSERT(0 != numReserved);
+    BSLS_ASSERT(0 <  maxNumReserved);
+
+    unsigned int currGeneration, currIndex;
+
+    int rc = reservePopIndex(&currGeneration, &currIndex);
+    if (0 != rc) {
+        return rc;                                                    // RETURN
+    }
+
+    *generation = currGeneration;
+    *index      = currIndex;
+
+    // Attempt to extend the reservation over the cells that immediately follow
+    // the reserved cell, stopping at the first cell that is not full in the
+    // expected generation (i.e., it is empty, still being written, or has been
+    // acquired by another popper).  As with 'reservePushIndices', other
+    // poppers will advance the pop index past any cell that is already marked
+    // 'e_READING' in the current generation.
+
+    unsigned int count = 1;
+    while (count < maxNumReserved) {
+        unsigned int nextGen   = currGeneration;
+        unsigned int nextIndex = currIndex;
+        advanceIndex(&nextGen, &nextIndex);
+
+        const int compare = encodeElementState(nextGen, e_FULL);
+        const int swap    = encodeElementState(nextGen, e_READING);
+        if (compare != d_states[nextIndex].testAndSwap(compare, swap)) {
+            break;
+        }
+
+        currGeneration = nextGen;
+        currIndex      = nextIndex;
+        ++count;
+    }
+
+    if (1 < count) {
+        // Attempt to move the pop index beyond the last reserved cell, unless
+        // another thread has already done so.
+
+        const unsigned int endCombinedIndex = nextCombinedIndex(
+                     currGeneration * static_cast<unsigned int>(d_capacity)
+                                                                  + currIndex);
+
+        unsigned int loadedPopIndex = d_popIndex.loadRelaxed();
+        while (0 < circularDifference(endCombinedIndex,
+                                      loadedPopIndex,
+                                      d_maxCombinedIndex + 1)) {
+            const unsigned int was = d_popIndex.testAndSwap(loadedPopIndex,
+                                                            endCombinedIndex);
+            if (was == loadedPopIndex) {
+                break;
+            }
+            loadedPopIndex = was;
+        }
+    }
+
+    *numReserved = count;
+    return 0;
+}
+
 void FixedQueueIndexManager::commitPopIndex(unsigned int generation,
                                             unsigned int index)
 {
@@ -36,6 +36,15 @@ BSLS_IDENT("$Id: $")
 // otherwise, other threads may "spin" indefinitely with severe performance
 // consequences.
 //
+///Reserving Multiple Indices
+///--------------------------
+// 'reservePushIndices' and 'reservePopIndices' reserve a contiguous run of
+// cells in a single operation, which lets a client enqueue or dequeue a batch
+// of elements while updating the shared push (or pop) index once per batch
+// rather than once per element.  The reserved cells are iterated using
+// 'advanceIndex', and each must be committed (in order) exactly as if it had
+// been reserved individually.
+//
 ///Thread Safety
 ///-------------
 // 'bdlcc::FixedQueueIndexManager' is fully *thread-safe*, meaning that all
@@ -207,6 +216,10 @@ BSLS_IDENT("$Id: $")
 #include <bslmf_nestedtraitdeclaration.h>
 #endif
 
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
 #ifndef INCLUDED_BSLS_ATOMIC
 #include <bsls_atomic.h>
 #endif
@@ -401,6 +414,30 @@ class FixedQueueIndexManager {
         // 'index' match those returned by a previous successful call to
         // 'reservePushIndex' (that has not previously been committed).
 
+    int reservePushIndices(unsigned int *generation,
+                           unsigned int *index,
+                           unsigned int *numReserved,
+                           unsigned int  maxNumReserved);
+        // Reserve a contiguous run of up to the specified 'maxNumReserved'
+        // available indices at which to enqueue elements in an (externally
+        // managed) circular buffer; load the specified 'index' and the
+        // specified 'generation' with the index and generation of the first
+        // reserved cell, and load the specified 'numReserved' with the number
+        // of reserved cells.  Return 0 on success, a negative value if the
+        // queue is disabled, and a positive value if the queue is full.  On
+        // success, at least one cell is reserved, and the reserved cells are
+        // the cell identified by 'generation' and 'index' followed by the
+        // 'numReserved - 1' cells obtained by repeatedly applying
+        // 'advanceIndex' to it; each reserved cell must be committed (in
+        // order) using 'commitPushIndex' quickly after this method returns,
+        // without performing any blocking operations.  If this method fails
+        // 'generation', 'index', and 'numReserved' will be unmodified.  The
+        // behavior is undefined unless '0 < maxNumReserved', or if the
+        // current thread is already holding a reservation on either a push or
+        // pop index.  Note that fewer than 'maxNumReserved' cells may be
+        // reserved even when the queue has sufficient free capacity (e.g., if
+        // another thread concurrently reserves one of the cells).
+
                          // Popping Elements
 
     int reservePopIndex(unsigned int *generation, unsigned int *index);
@@ -428,6 +465,27 @@ class FixedQueueIndexManager {
         // successful call to 'reservePopIndex' (that has not previously been
         // committed).
 
+    int reservePopIndices(unsigned int *generation,
+                          unsigned int *index,
+                          unsigned int *numReserved,
+                          unsigned int  maxNumReserved);
+        // Reserve a contiguous run of up to the specified 'maxNumReserved'
+        // available indices from which to dequeue elements from an
+        // (externally managed) circular buffer; load the specified 'index'
+        // and the specified 'generation' with the index and generation of the
+        // first reserved cell, and load the specified 'numReserved' with the
+        // number of reserved cells.  Return 0 on success, and a non-zero value
+        // if the queue is empty.  On success, at least one cell is reserved,
+        // and the reserved cells are the cell identified by 'generation' and
+        // 'index' followed by the 'numReserved - 1' cells obtained by
+        // repeatedly applying 'advanceIndex' to it; each reserved cell must be
+        // committed (in order) using 'commitPopIndex' quickly after this
+        // method returns, without performing any blocking operations.  If
+        // this method fails 'generation', 'index', and 'numReserved' will be
+        // unmodified.  The behavior is undefined unless '0 < maxNumReserved',
+        // or if the current thread is already holding a reservation on either
+        // a push or pop index.
+
                                 // Disabled State
 
     void disable();
@@ -472,6 +530,16 @@ class FixedQueueIndexManager {
         // for pushing, and committing that index.
 
     // ACCESSORS
+    void advanceIndex(unsigned int *generation, unsigned int *index) const;
+        // Load the specified 'generation' and 'index' with the generation and
+        // index of the cell that follows the cell identified by their current
+        // values in the circular buffer.  The behavior is undefined unless
+        // 'generation' and 'index' identify a cell returned by one of the
+        // 'reserve*' methods of this object (or a cell derived from such a
+        // cell by this method).  Note that this method is used to iterate
+        // over the cells reserved by 'reservePushIndices' and
+        // 'reservePopIndices'.
+
     bool isEnabled() const;
         // Return 'true' if the queue is enabled, and 'false' if it is
         // disabled.
@@ -526,6 +594,23 @@ unsigned int FixedQueueIndexManager::nextGeneration(
 }
 
 // ACCESSORS
+inline
+void FixedQueueIndexManager::advanceIndex(unsigned int *generation,
+                                          unsigned int *index) const
+{
+    BSLS_ASSERT(generation);
+    BSLS_ASSERT(index);
+    BSLS_ASSERT(*index < d_capacity);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_capacity == *index + 1)) {
+        *index      = 0;
+        *generation = nextGeneration(*generation);
+    }
+    else {
+        ++*index;
+    }
+}
+
 inline
 bsl::size_t FixedQueueIndexManager::capacity() const
 {
@@ -90,19 +90,22 @@ using namespace bsl;
 // [ 3] void commitPushIndex(unsigned int , unsigned int );
 // [ 3] int reservePopIndex(unsigned int *, unsigned int *);
 // [ 3] void commitPopIndex(unsigned int , unsigned int );
+// [13] int reservePushIndices(unsigned *,unsigned *,unsigned *,unsigned);
+// [13] int reservePopIndices(unsigned *,unsigned *,unsigned *,unsigned);
 // [ 6] int reservePopIndexForClear(unsigned *,unsigned *,unsigned,unsigned);
 // [ 7] void abortPushIndexReservation(unsigned int, unsigned int);
 // [ 5] void disable();
 // [ 5] void enable();
 // [ 7] void abortPushIndexReservation(unsigned int, unsigned int);
 // ACCESSORS
+// [13] void advanceIndex(unsigned int *, unsigned int *) const;
 // [ 5] bool isEnabled() const;
 // [ 3] unsigned int length() const;
 // [ 2] unsigned int capacity() const;
 // [10] bsl::ostream& print(bsl::ostream& ) const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [13] USAGE EXAMPLE
+// [14] USAGE EXAMPLE
 // [ 4] CONCERN: 'gg' generator and 'dirtyGG' generator
 // [11] CONCERN: Thread-Safety (concurrent access does not corrupt state)
 // [12] CONCERN: maxCombinedIndex
@@ -982,7 +985,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;;
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 13: {
+      case 14: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
         //   The usage example provided in the component header file must
@@ -1021,6 +1024,237 @@ int main(int argc, char *argv[])
     ASSERT(1 == result);
 //..
       } break;
+      case 13: {
+        // --------------------------------------------------------------------
+        // RESERVING MULTIPLE INDICES
+        //
+        // Concerns:
+        //  1 'reservePushIndices' reserves the largest available run of
+        //    cells, up to the requested maximum, starting at the current push
+        //    index, and advances the push index past the reserved cells.
+        //
+        //  2 'reservePopIndices' reserves the largest available run of full
+        //    cells, up to the requested maximum, starting at the current pop
+        //    index, and advances the pop index past the reserved cells.
+        //
+        //  3 'advanceIndex' iterates over the reserved cells, including when
+        //    the run wraps around the end of the buffer, and when the
+        //    generation count wraps at the maximum combined index.
+        //
+        //  4 'reservePushIndices' fails with a positive status if the queue
+        //    is full, and a negative status if the queue is disabled, and
+        //    'reservePopIndices' fails if the queue is empty; on failure the
+        //    output arguments are unmodified.
+        //
+        //  5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //  1 For a series of capacities, initial pop indices (both near 0 and
+        //    near the maximum combined index), initial lengths, and maximum
+        //    reservation sizes: initialize an index manager with 'gg' (or
+        //    'dirtyGG'), reserve a run of push indices, and verify the
+        //    returned position and count, the state of each reserved cell,
+        //    the length, and the resulting push index.  Commit the cells,
+        //    then reserve a run of pop indices and verify the same.  (C-1..3)
+        //
+        //  2 Verify the failure modes on a full, empty, and disabled queue.
+        //    (C-4)
+        //
+        //  3 Use the assertion test facility to test function preconditions.
+        //    (C-5)
+        //
+        // Testing:
+        //   int reservePushIndices(unsigned *,unsigned *,unsigned *,unsigned);
+        //   int reservePopIndices(unsigned *,unsigned *,unsigned *,unsigned);
+        //   void advanceIndex(unsigned int *, unsigned int *) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RESERVING MULTIPLE INDICES" << endl
+                          << "==========================" << endl;
+
+        if (verbose) cout << "\nReserve and commit runs of indices" << endl;
+        {
+            for (unsigned int cap = 1; cap < 9; ++cap) {
+            for (int nearMax = 0; nearMax < 2; ++nearMax) {
+            for (unsigned int offset = 0; offset < cap; ++offset) {
+            for (unsigned int len = 0; len <= cap; ++len) {
+            for (unsigned int max = 1; max <= cap + 1; ++max) {
+                bslma::TestAllocator oa;
+                Obj x(cap, &oa); const Obj& X = x;
+
+                const FixedQueueState STATE(&x);
+
+                const bsls::Types::Uint64 MODULO =
+                         static_cast<bsls::Types::Uint64>(
+                                                 STATE.maxCombinedIndex()) + 1;
+
+                const unsigned int POP = nearMax
+                            ? STATE.maxGeneration() * cap + offset
+                            : offset;
+
+                if (nearMax) {
+                    dirtyGG(&x, POP + len, POP);
+                }
+                else {
+                    gg(&x, POP + len, POP);
+                }
+                ASSERTV(cap, len, X.length(), len == X.length());
+
+                const unsigned int EXP_PUSHED = bsl::min(max, cap - len);
+
+                unsigned int generation  = 99;
+                unsigned int index       = 99;
+                unsigned int numReserved = 99;
+
+                int rc = x.reservePushIndices(&generation,
+                                              &index,
+                                              &numReserved,
+                                              max);
+                if (0 == EXP_PUSHED) {
+                    ASSERTV(cap, len, max, rc, 0 < rc);
+                    ASSERT(99 == generation);
+                    ASSERT(99 == index);
+                    ASSERT(99 == numReserved);
+                    continue;
+                }
+
+                ASSERTV(cap, len, max, rc, 0 == rc);
+                ASSERTV(cap, len, max, numReserved,
+                        EXP_PUSHED == numReserved);
+                ASSERTV(cap, len, max, X.length(),
+                        len + EXP_PUSHED == X.length());
+
+                bsls::Types::Uint64 combined = (POP + len) % MODULO;
+                for (unsigned int i = 0; i < numReserved; ++i) {
+                    ASSERTV(cap, len, max, i, generation,
+                            combined / cap == generation);
+                    ASSERTV(cap, len, max, i, index,
+                            combined % cap == index);
+                    ASSERTV(cap, len, max, i,
+                            e_WRITING == STATE.elementState(index));
+
+                    x.commitPushIndex(generation, index);
+                    x.advanceIndex(&generation, &index);
+                    combined = (combined + 1) % MODULO;
+                }
+                ASSERTV(cap, len, max,
+                        combined / cap == STATE.pushGeneration());
+                ASSERTV(cap, len, max, combined % cap == STATE.pushIndex());
+
+                const unsigned int EXP_POPPED =
+                                          bsl::min(max, len + EXP_PUSHED);
+
+                rc = x.reservePopIndices(&generation,
+                                         &index,
+                                         &numReserved,
+                                         max);
+                ASSERTV(cap, len, max, rc, 0 == rc);
+                ASSERTV(cap, len, max, numReserved,
+                        EXP_POPPED == numReserved);
+                ASSERTV(cap, len, max, X.length(),
+                        len + EXP_PUSHED - EXP_POPPED == X.length());
+
+                combined = POP;
+                for (unsigned int i = 0; i < numReserved; ++i) {
+                    ASSERTV(cap, len, max, i, generation,
+                            combined / cap == generation);
+                    ASSERTV(cap, len, max, i, index,
+                            combined % cap == index);
+                    ASSERTV(cap, len, max, i,
+                            e_READING == STATE.elementState(index));
+
+                    x.commitPopIndex(generation, index);
+                    x.advanceIndex(&generation, &index);
+                    combined = (combined + 1) % MODULO;
+                }
+                ASSERTV(cap, len, max,
+                        combined / cap == STATE.popGeneration());
+                ASSERTV(cap, len, max, combined % cap == STATE.popIndex());
+            }
+            }
+            }
+            }
+            }
+        }
+
+        if (verbose) cout << "\nVerify failure on empty and disabled queues"
+                          << endl;
+        {
+            bslma::TestAllocator oa;
+            Obj x(4, &oa); const Obj& X = x;
+
+            unsigned int generation  = 99;
+            unsigned int index       = 99;
+            unsigned int numReserved = 99;
+
+            ASSERT(0 != x.reservePopIndices(&generation,
+                                            &index,
+                                            &numReserved,
+                                            4));
+            ASSERT(99 == generation);
+            ASSERT(99 == index);
+            ASSERT(99 == numReserved);
+
+            x.disable();
+
+            ASSERT(0 > x.reservePushIndices(&generation,
+                                            &index,
+                                            &numReserved,
+                                            4));
+            ASSERT(99 == generation);
+            ASSERT(99 == index);
+            ASSERT(99 == numReserved);
+            ASSERT(0  == X.length());
+
+            x.enable();
+
+            ASSERT(0 == x.reservePushIndices(&generation,
+                                             &index,
+                                             &numReserved,
+                                             4));
+            ASSERT(0 == generation);
+            ASSERT(0 == index);
+            ASSERT(4 == numReserved);
+            ASSERT(4 == X.length());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            bslma::TestAllocator oa;
+            Obj x(4, &oa);
+
+            unsigned int generation, index, numReserved;
+
+            ASSERT_FAIL(x.reservePushIndices(0, &index, &numReserved, 1));
+            ASSERT_FAIL(x.reservePushIndices(&generation, 0, &numReserved, 1));
+            ASSERT_FAIL(x.reservePushIndices(&generation, &index, 0, 1));
+            ASSERT_FAIL(x.reservePushIndices(&generation,
+                                             &index,
+                                             &numReserved,
+                                             0));
+            ASSERT_FAIL(x.reservePopIndices(0, &index, &numReserved, 1));
+            ASSERT_FAIL(x.reservePopIndices(&generation, 0, &numReserved, 1));
+            ASSERT_FAIL(x.reservePopIndices(&generation, &index, 0, 1));
+            ASSERT_FAIL(x.reservePopIndices(&generation,
+                                            &index,
+                                            &numReserved,
+                                            0));
+
+            generation = 0;
+            index      = 3;
+            ASSERT_PASS(x.advanceIndex(&generation, &index));
+            ASSERT(1 == generation);
+            ASSERT(0 == index);
+
+            index = 4;
+            ASSERT_FAIL(x.advanceIndex(&generation, &index));
+            ASSERT_FAIL(x.advanceIndex(0, &index));
+            ASSERT_FAIL(x.advanceIndex(&generation, 0));
+        }
+      } break;
       case 12: {
         // --------------------------------------------------------------------
         // CONCERN: maxCombinedIndex
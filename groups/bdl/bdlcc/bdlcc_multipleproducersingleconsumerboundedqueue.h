@@ -0,0 +1,902 @@
+// bdlcc_multipleproducersingleconsumerboundedqueue.h                -*-C++-*-
+#ifndef INCLUDED_BDLCC_MULTIPLEPRODUCERSINGLECONSUMERBOUNDEDQUEUE
+#define INCLUDED_BDLCC_MULTIPLEPRODUCERSINGLECONSUMERBOUNDEDQUEUE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a lock-free multi-producer/single-consumer bounded queue.
+//
+//@CLASSES:
+//  bdlcc::MultipleProducerSingleConsumerBoundedQueue: lock-free MPSC queue
+//
+//@SEE_ALSO: bdlcc_fixedqueue, bdlcc_singleproducersingleconsumerboundedqueue
+//
+//@DESCRIPTION: This component defines a class template,
+// 'bdlcc::MultipleProducerSingleConsumerBoundedQueue', providing a lock-free,
+// fixed-capacity, in-order queue of values for any number of producer threads
+// and exactly one consumer thread.
+//
+// Compared with 'bdlcc::FixedQueue', which supports any number of consumers,
+// a pop from this queue requires no atomic read-modify-write operation: the
+// consumer alone owns the pop index, and learns whether the element at the
+// front of the queue has been published by reading a sequence number stored
+// alongside that element.  Producers claim positions with a single
+// compare-and-swap on a push index that resides on a different cache line
+// from the pop index, and check for available space against a cached copy of
+// the pop index (on the producers' cache line) that is refreshed only when the
+// queue appears to be full.
+//
+// The queue provides 'pushBack' and 'popFront' methods for pushing data into
+// the queue and popping it from the queue.  If the queue is full, 'pushBack'
+// blocks until there is space in the queue, and if the queue is empty,
+// 'popFront' blocks until there is an element in the queue.  Non-blocking
+// methods 'tryPushBack' and 'tryPopFront' are also provided, which fail
+// immediately returning a non-zero value in case of overflow or underflow.
+// Before blocking, 'pushBack' and 'popFront' yield the processor a bounded
+// number of times, since the thread on the other side of the queue is likely
+// to make progress shortly.
+//
+// The queue may be placed into a "disabled" state using the 'disable' method.
+// When disabled, 'pushBack' and 'tryPushBack' fail immediately (all blocked
+// invocations of 'pushBack' will also fail immediately).  The queue may be
+// restored to normal operation with the 'enable' method.  These are the same
+// semantics as those of 'bdlcc::FixedQueue'.
+//
+// Elements pushed by one producer are popped in the order in which they were
+// pushed.  Note that a producer that has claimed a position but not yet
+// published its element delays the consumer from popping any element behind
+// that position, even if that element has been published (i.e., the queue is
+// *not* lock-free for the consumer with respect to a preempted producer).
+//
+///Thread Safety
+///-------------
+// 'bdlcc::MultipleProducerSingleConsumerBoundedQueue' is *thread-safe*
+// provided that at most one thread at a time invokes the consumer methods
+// ('popFront', 'tryPopFront', and 'removeAll').  The producer methods
+// ('pushBack' and 'tryPushBack'), 'disable', 'enable', and the accessors may
+// be invoked from any thread.
+//
+///Template Requirements
+///---------------------
+// 'bdlcc::MultipleProducerSingleConsumerBoundedQueue' is a template that is
+// parameterized on the type of element contained within the queue.  The
+// supplied template argument, 'TYPE', must provide a copy constructor and an
+// assignment operator.  If 'TYPE' declares the 'bslma::UsesBslmaAllocator'
+// trait, the allocator of the queue is propagated to the elements contained in
+// the queue.
+//
+///Exception Safety
+///----------------
+// If the assignment operator of 'TYPE' throws when popping an element, the
+// queue is unchanged.  If the copy (or move) constructor of 'TYPE' throws when
+// pushing an element, no element is added to the queue, but the position
+// claimed by the push is marked as abandoned, and is skipped by the consumer;
+// until it is skipped, the abandoned position is counted by 'numElements'.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Funneling Work Into a Single Thread
+///- - - - - - - - - - - - - - - - - - - - - - -
+// In the following example, several producer threads report the number of
+// items they have processed to a single accounting thread, which owns the
+// total and therefore needs no synchronization to update it.
+//
+// First, we define the function executed by each producer, which pushes the
+// specified number of reports, each of size 1:
+//..
+//  void reportWork(
+//            bdlcc::MultipleProducerSingleConsumerBoundedQueue<int> *queue,
+//            int                                                     count)
+//  {
+//      for (int i = 0; i < count; ++i) {
+//          queue->pushBack(1);
+//      }
+//  }
+//..
+// Then, we create a queue, and start four producer threads, each sending 1000
+// reports:
+//..
+//  bdlcc::MultipleProducerSingleConsumerBoundedQueue<int> queue(64);
+//
+//  bslmt::ThreadGroup producers;
+//  for (int i = 0; i < 4; ++i) {
+//      producers.addThread(bdlf::BindUtil::bind(&reportWork, &queue, 1000));
+//  }
+//..
+// Next, the current thread acts as the consumer, accumulating the reports:
+//..
+//  int total = 0;
+//  for (int i = 0; i < 4 * 1000; ++i) {
+//      int size;
+//      queue.popFront(&size);
+//      total += size;
+//  }
+//..
+// Finally, we join the producers, and verify that the queue is empty and that
+// every report has been received:
+//..
+//  producers.joinAll();
+//  assert(queue.isEmpty());
+//  assert(4000 == total);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_PLATFORM
+#include <bslmt_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_SEMAPHORE
+#include <bslmt_semaphore.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARDESTRUCTIONPRIMITIVES
+#include <bslalg_scalardestructionprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARPRIMITIVES
+#include <bslalg_scalarprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_MOVABLEREF
+#include <bslmf_movableref.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_OBJECTBUFFER
+#include <bsls_objectbuffer.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_NEW
+#include <bsl_new.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlcc {
+
+            // ======================================================
+            // struct MultipleProducerSingleConsumerBoundedQueue_Node
+            // ======================================================
+
+template <class TYPE>
+struct MultipleProducerSingleConsumerBoundedQueue_Node {
+    // This private struct holds one position of the circular buffer of a
+    // 'MultipleProducerSingleConsumerBoundedQueue'.  The element at index 'i'
+    // of the queue is published when 'd_sequence' is '2 * (i + 1)', and the
+    // position is abandoned (by a producer whose copy of the element threw)
+    // when 'd_sequence' is '2 * (i + 1) + 1'.
+
+    // DATA
+    bsls::AtomicUint64       d_sequence;  // publication state of 'd_value'
+
+    bsls::ObjectBuffer<TYPE> d_value;     // element (uninitialized unless
+                                          // published)
+};
+
+           // ================================================
+           // class MultipleProducerSingleConsumerBoundedQueue
+           // ================================================
+
+template <class TYPE>
+class MultipleProducerSingleConsumerBoundedQueue {
+    // This class provides a lock-free, fixed-capacity, in-order queue of
+    // values for use by any number of producer threads and a single consumer
+    // thread.
+
+    // PRIVATE TYPES
+    typedef bsls::Types::Uint64                                   Uint64;
+    typedef MultipleProducerSingleConsumerBoundedQueue_Node<TYPE> Node;
+
+    class PushProctor {
+        // This class marks a claimed position as abandoned on destruction,
+        // unless released, so that the consumer skips that position if the
+        // construction of the pushed element throws.
+
+        // DATA
+        MultipleProducerSingleConsumerBoundedQueue *d_queue_p;
+        Uint64                                      d_index;
+
+        // NOT IMPLEMENTED
+        PushProctor(const PushProctor&);
+        PushProctor& operator=(const PushProctor&);
+
+      public:
+        // CREATORS
+        PushProctor(MultipleProducerSingleConsumerBoundedQueue *queue,
+                    Uint64                                      index)
+        : d_queue_p(queue)
+        , d_index(index)
+        {
+        }
+
+        ~PushProctor()
+        {
+            if (d_queue_p) {
+                d_queue_p->publish(d_index, 1);
+            }
+        }
+
+        // MANIPULATORS
+        void release()
+        {
+            d_queue_p = 0;
+        }
+    };
+
+    enum {
+        k_PUSH_PADDING = bslmt::Platform::e_CACHE_LINE_SIZE
+                       - 2 * sizeof(bsls::AtomicUint64),
+
+        k_POP_PADDING  = bslmt::Platform::e_CACHE_LINE_SIZE
+                       - sizeof(bsls::AtomicUint64),
+
+        k_MAX_YIELDS   = 64,   // number of times a blocking method yields
+                               // before waiting
+
+        k_DISABLED     = 0,
+        k_ENABLED      = 1
+    };
+
+    // DATA
+    bsls::AtomicUint64  d_pushIndex;           // number of positions ever
+                                               // claimed by producers
+
+    bsls::AtomicUint64  d_cachedPopIndex;      // a recently loaded value of
+                                               // 'd_popIndex', shared by the
+                                               // producers
+
+    const char          d_pushIndexPad[k_PUSH_PADDING];
+                                               // padding to prevent false
+                                               // sharing
+
+    bsls::AtomicUint64  d_popIndex;            // number of positions ever
+                                               // released by the consumer
+
+    const char          d_popIndexPad[k_POP_PADDING];
+                                               // padding to prevent false
+                                               // sharing
+
+    Node               *d_nodes_p;             // array of 'd_mask + 1'
+                                               // positions
+
+    const Uint64        d_mask;                // mask mapping an index to a
+                                               // position in 'd_nodes_p'
+
+    const Uint64        d_capacity;            // maximum number of elements
+
+    bsls::AtomicInt     d_state;               // 'k_ENABLED' or 'k_DISABLED'
+
+    bsls::AtomicInt     d_numWaitingPoppers;   // number of threads waiting on
+                                               // 'd_popControlSema'
+
+    bslmt::Semaphore    d_popControlSema;      // semaphore on which the
+                                               // consumer waiting for an
+                                               // element waits
+
+    bsls::AtomicInt     d_numWaitingPushers;   // number of threads waiting on
+                                               // 'd_pushControlSema'
+
+    bslmt::Semaphore    d_pushControlSema;     // semaphore on which producers
+                                               // waiting for space wait
+
+    bslma::Allocator   *d_allocator_p;         // allocator (held, not owned)
+
+    // FRIENDS
+    friend class PushProctor;
+
+    // NOT IMPLEMENTED
+    MultipleProducerSingleConsumerBoundedQueue(
+                            const MultipleProducerSingleConsumerBoundedQueue&);
+    MultipleProducerSingleConsumerBoundedQueue& operator=(
+                            const MultipleProducerSingleConsumerBoundedQueue&);
+
+    // PRIVATE MANIPULATORS
+    int claimPushIndex(Uint64 *index);
+        // Claim the next position of this queue, and load its index into the
+        // specified 'index'.  Return 0 on success, a negative value if this
+        // queue is disabled, and a positive value if this queue is full.
+
+    void publish(Uint64 index, int abandoned);
+        // Publish the position having the specified 'index' to the consumer,
+        // as an element if the specified 'abandoned' is 0, and as a position
+        // to be skipped otherwise, and wake the waiting consumer if there is
+        // one.  The behavior is undefined unless 'index' was claimed by
+        // 'claimPushIndex', and has not been published.
+
+    int popFrontImp(TYPE *value);
+        // Remove the element from the front of this queue, skipping any
+        // abandoned positions, and, if the specified 'value' is not 0, load
+        // that element into 'value'.  Return 0 on success, and a non-zero
+        // value if no published element is at the front of this queue.
+
+    void releasePopIndex(Uint64 index);
+        // Release the position having the specified 'index' to the producers,
+        // and wake a waiting producer if there is one.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(MultipleProducerSingleConsumerBoundedQueue,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    MultipleProducerSingleConsumerBoundedQueue(
+                                      bsl::size_t       capacity,
+                                      bslma::Allocator *basicAllocator = 0);
+        // Create a queue having the specified 'capacity'.  Optionally specify
+        // a 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '0 < capacity'.
+
+    ~MultipleProducerSingleConsumerBoundedQueue();
+        // Destroy this object.
+
+    // MANIPULATORS
+    int pushBack(const TYPE& value);
+        // Append the specified 'value' to the back of this queue, blocking
+        // until either space is available - if necessary - or the queue is
+        // disabled.  Return 0 on success, and a nonzero value if the queue is
+        // disabled.
+
+    int pushBack(bslmf::MovableRef<TYPE> value);
+        // Append the specified move-insertable 'value' to the back of this
+        // queue, blocking until either space is available - if necessary - or
+        // the queue is disabled.  'value' is left in a valid but unspecified
+        // state.  Return 0 on success, and a nonzero value if the queue is
+        // disabled.
+
+    int tryPushBack(const TYPE& value);
+        // Attempt to append the specified 'value' to the back of this queue
+        // without blocking.  Return 0 on success, and a non-zero value if the
+        // queue is full or disabled.
+
+    int tryPushBack(bslmf::MovableRef<TYPE> value);
+        // Attempt to append the specified move-insertable 'value' to the back
+        // of this queue without blocking.  'value' is left in a valid but
+        // unspecified state.  Return 0 on success, and a non-zero value if the
+        // queue is full or disabled.
+
+    void popFront(TYPE *value);
+        // Remove the element from the front of this queue and load that
+        // element into the specified 'value'.  If the queue is empty, block
+        // until it is not empty.  The behavior is undefined unless invoked by
+        // the consumer.
+
+    int tryPopFront(TYPE *value);
+        // Attempt to remove the element from the front of this queue without
+        // blocking, and, if successful, load the specified 'value' with the
+        // removed element.  Return 0 on success, and a non-zero value if the
+        // queue was empty.  On failure, 'value' is not changed.  The behavior
+        // is undefined unless invoked by the consumer.  Note that this method
+        // fails if the producer that claimed the front position of this queue
+        // has not yet published its element, even if elements pushed later
+        // have been published.
+
+    void removeAll();
+        // Remove all published items from the front of this queue.  The
+        // behavior is undefined unless invoked by the consumer.  Note that if
+        // producers are concurrently pushing items into the queue, the result
+        // of 'numElements' after this function returns is not guaranteed to be
+        // 0.
+
+    void disable();
+        // Disable this queue.  All subsequent invocations of 'pushBack' or
+        // 'tryPushBack' will fail immediately.  All blocked invocations of
+        // 'pushBack' will fail immediately.  If the queue is already disabled,
+        // this method has no effect.
+
+    void enable();
+        // Enable queuing.  If the queue is not disabled, this call has no
+        // effect.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the maximum number of elements that may be stored in this
+        // queue.
+
+    bool isEmpty() const;
+        // Return 'true' if this queue is empty (has no elements), or 'false'
+        // otherwise.
+
+    bool isEnabled() const;
+        // Return 'true' if this queue is enabled, and 'false' otherwise.  Note
+        // that the queue is created in the "enabled" state.
+
+    bool isFull() const;
+        // Return 'true' if this queue is full (when the number of elements
+        // currently in this queue equals its capacity), or 'false' otherwise.
+
+    bsl::size_t numElements() const;
+        // Return a snapshot of the number of elements currently in this queue,
+        // including the positions claimed by producers that have not yet
+        // published their elements.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+           // ------------------------------------------------
+           // class MultipleProducerSingleConsumerBoundedQueue
+           // ------------------------------------------------
+
+// PRIVATE MANIPULATORS
+template <class TYPE>
+inline
+int MultipleProducerSingleConsumerBoundedQueue<TYPE>::claimPushIndex(
+                                                                 Uint64 *index)
+{
+    enum { e_SUCCESS = 0, e_QUEUE_FULL = 1, e_DISABLED_QUEUE = -1 };
+
+    Uint64 pushIndex = d_pushIndex.loadRelaxed();
+
+    for (;;) {
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                       k_ENABLED != d_state.loadRelaxed())) {
+            return e_DISABLED_QUEUE;                                  // RETURN
+        }
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                 pushIndex - d_cachedPopIndex.loadAcquire() >= d_capacity)) {
+            // The queue appears full using the cached pop index; reload the
+            // pop index written by the consumer.  Producers may overwrite a
+            // newer cached value with an older one, which is harmless: the
+            // pop index only increases, so an older value is conservative.
+
+            const Uint64 popIndex = d_popIndex.loadAcquire();
+            d_cachedPopIndex.storeRelease(popIndex);
+            if (pushIndex - popIndex >= d_capacity) {
+                return e_QUEUE_FULL;                                  // RETURN
+            }
+        }
+
+        const Uint64 previous = d_pushIndex.testAndSwapAcqRel(pushIndex,
+                                                              pushIndex + 1);
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(previous == pushIndex)) {
+            break;
+        }
+        pushIndex = previous;
+    }
+
+    *index = pushIndex;
+    return e_SUCCESS;
+}
+
+template <class TYPE>
+inline
+void MultipleProducerSingleConsumerBoundedQueue<TYPE>::publish(
+                                                          Uint64 index,
+                                                          int    abandoned)
+{
+    // SYNCHRONIZATION POINT 1
+    //
+    // The following store to 'd_sequence' is sequentially consistent, which
+    // guarantees that the subsequent load of 'd_numWaitingPoppers' sees a
+    // consumer that incremented it before loading 'd_sequence' at
+    // SYNCHRONIZATION POINT 1-Prime.
+
+    d_nodes_p[index & d_mask].d_sequence = 2 * (index + 1) + (abandoned ? 1
+                                                                        : 0);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_numWaitingPoppers)) {
+        d_popControlSema.post();
+    }
+}
+
+template <class TYPE>
+int MultipleProducerSingleConsumerBoundedQueue<TYPE>::popFrontImp(
+                                                                   TYPE *value)
+{
+    Uint64 popIndex = d_popIndex.loadRelaxed();
+
+    for (;;) {
+        Node&        node     = d_nodes_p[popIndex & d_mask];
+        const Uint64 sequence = node.d_sequence.loadAcquire();
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                                             sequence == 2 * (popIndex + 1))) {
+            break;
+        }
+        if (sequence != 2 * (popIndex + 1) + 1) {
+            // The position has not been published.
+
+            return 1;                                                 // RETURN
+        }
+
+        // The position was abandoned by a producer; skip it.
+
+        releasePopIndex(popIndex);
+        ++popIndex;
+    }
+
+    TYPE& element = d_nodes_p[popIndex & d_mask].d_value.object();
+
+    if (value) {
+        // If the assignment throws, the element is not removed and the queue
+        // is unchanged.  See 'bdlcc_fixedqueue' regarding the use of 'move'.
+
+#if defined(BSLMF_MOVABLEREF_USES_RVALUE_REFERENCES)
+        *value = bslmf::MovableRefUtil::move(element);
+#else
+        *value = element;
+#endif
+    }
+
+    bslalg::ScalarDestructionPrimitives::destroy(&element);
+    releasePopIndex(popIndex);
+    return 0;
+}
+
+template <class TYPE>
+inline
+void MultipleProducerSingleConsumerBoundedQueue<TYPE>::releasePopIndex(
+                                                                  Uint64 index)
+{
+    // SYNCHRONIZATION POINT 2
+    //
+    // The following store to 'd_popIndex' is sequentially consistent, which
+    // guarantees that the subsequent load of 'd_numWaitingPushers' sees a
+    // producer that incremented it before testing 'isFull' at SYNCHRONIZATION
+    // POINT 2-Prime.
+
+    d_popIndex = index + 1;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_numWaitingPushers)) {
+        d_pushControlSema.post();
+    }
+}
+
+// CREATORS
+template <class TYPE>
+MultipleProducerSingleConsumerBoundedQueue<TYPE>::
+                                    MultipleProducerSingleConsumerBoundedQueue(
+                                              bsl::size_t       capacity,
+                                              bslma::Allocator *basicAllocator)
+: d_pushIndex(0)
+, d_cachedPopIndex(0)
+, d_pushIndexPad()
+, d_popIndex(0)
+, d_popIndexPad()
+, d_nodes_p(0)
+, d_mask(bdlb::BitUtil::roundUpToBinaryPower(
+                                        static_cast<bsl::uint64_t>(capacity))
+                                                                          - 1)
+, d_capacity(capacity)
+, d_state(k_ENABLED)
+, d_numWaitingPoppers(0)
+, d_popControlSema(0)
+, d_numWaitingPushers(0)
+, d_pushControlSema(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < capacity);
+
+    const bsl::size_t numNodes = static_cast<bsl::size_t>(d_mask + 1);
+
+    d_nodes_p = static_cast<Node *>(d_allocator_p->allocate(
+                                                    numNodes * sizeof(Node)));
+    for (bsl::size_t i = 0; i < numNodes; ++i) {
+        new (d_nodes_p + i) Node();
+    }
+}
+
+template <class TYPE>
+MultipleProducerSingleConsumerBoundedQueue<TYPE>::
+                                  ~MultipleProducerSingleConsumerBoundedQueue()
+{
+    const Uint64 pushIndex = d_pushIndex.loadRelaxed();
+    for (Uint64 i = d_popIndex.loadRelaxed(); i != pushIndex; ++i) {
+        Node& node = d_nodes_p[i & d_mask];
+        if (node.d_sequence.loadRelaxed() == 2 * (i + 1)) {
+            bslalg::ScalarDestructionPrimitives::destroy(
+                                                      &node.d_value.object());
+        }
+    }
+    d_allocator_p->deallocate(d_nodes_p);
+}
+
+// MANIPULATORS
+template <class TYPE>
+int MultipleProducerSingleConsumerBoundedQueue<TYPE>::pushBack(
+                                                             const TYPE& value)
+{
+    int retval;
+    int numYields = 0;
+    while (0 != (retval = tryPushBack(value))) {
+        if (retval < 0) {
+            // The queue is disabled.
+
+            return retval;                                            // RETURN
+        }
+
+        if (numYields < k_MAX_YIELDS) {
+            // Yield a bounded number of times before waiting: the consumer is
+            // likely to make space shortly, whereas waiting costs a pair of
+            // system calls (in this thread and in the consumer).
+
+            ++numYields;
+            bslmt::ThreadUtil::yield();
+            continue;
+        }
+
+        // SYNCHRONIZATION POINT 2-Prime
+        //
+        // 'isFull' loads 'd_popIndex' with sequential consistency after the
+        // (sequentially consistent) increment of 'd_numWaitingPushers'.
+
+        d_numWaitingPushers.add(1);
+        if (isFull() && isEnabled()) {
+            d_pushControlSema.wait();
+        }
+        d_numWaitingPushers.add(-1);
+    }
+    return 0;
+}
+
+template <class TYPE>
+int MultipleProducerSingleConsumerBoundedQueue<TYPE>::pushBack(
+                                                 bslmf::MovableRef<TYPE> value)
+{
+    int retval;
+    int numYields = 0;
+    while (0 != (retval = tryPushBack(bslmf::MovableRefUtil::move(value)))) {
+        if (retval < 0) {
+            // The queue is disabled.
+
+            return retval;                                            // RETURN
+        }
+
+        if (numYields < k_MAX_YIELDS) {
+            // See 'pushBack(const TYPE&)'.
+
+            ++numYields;
+            bslmt::ThreadUtil::yield();
+            continue;
+        }
+
+        // SYNCHRONIZATION POINT 2-Prime
+        //
+        // See 'pushBack(const TYPE&)'.
+
+        d_numWaitingPushers.add(1);
+        if (isFull() && isEnabled()) {
+            d_pushControlSema.wait();
+        }
+        d_numWaitingPushers.add(-1);
+    }
+    return 0;
+}
+
+template <class TYPE>
+int MultipleProducerSingleConsumerBoundedQueue<TYPE>::tryPushBack(
+                                                             const TYPE& value)
+{
+    Uint64 index;
+
+    int retval = claimPushIndex(&index);
+    if (0 != retval) {
+        return retval;                                                // RETURN
+    }
+
+    PushProctor guard(this, index);
+    bslalg::ScalarPrimitives::copyConstruct(
+                                   d_nodes_p[index & d_mask].d_value.address(),
+                                   value,
+                                   d_allocator_p);
+    guard.release();
+
+    publish(index, 0);
+    return 0;
+}
+
+template <class TYPE>
+int MultipleProducerSingleConsumerBoundedQueue<TYPE>::tryPushBack(
+                                                 bslmf::MovableRef<TYPE> value)
+{
+    Uint64 index;
+
+    int retval = claimPushIndex(&index);
+    if (0 != retval) {
+        return retval;                                                // RETURN
+    }
+
+    TYPE& dummy = value;
+
+    PushProctor guard(this, index);
+    bslalg::ScalarPrimitives::moveConstruct(
+                                   d_nodes_p[index & d_mask].d_value.address(),
+                                   dummy,
+                                   d_allocator_p);
+    guard.release();
+
+    publish(index, 0);
+    return 0;
+}
+
+template <class TYPE>
+void MultipleProducerSingleConsumerBoundedQueue<TYPE>::popFront(TYPE *value)
+{
+    BSLS_ASSERT(value);
+
+    int numYields = 0;
+    while (0 != popFrontImp(value)) {
+        if (numYields < k_MAX_YIELDS) {
+            // As in 'pushBack', except that a producer is likely to push an
+            // element shortly.
+
+            ++numYields;
+            bslmt::ThreadUtil::yield();
+            continue;
+        }
+
+        // SYNCHRONIZATION POINT 1-Prime
+        //
+        // 'isEmpty' loads 'd_pushIndex' with sequential consistency after the
+        // (sequentially consistent) increment of 'd_numWaitingPoppers', and a
+        // producer claims a position by a (sequentially consistent)
+        // compare-and-swap on 'd_pushIndex' before loading
+        // 'd_numWaitingPoppers' at SYNCHRONIZATION POINT 1.  If the queue is
+        // not empty, a producer has claimed the front position but not yet
+        // published it; rather than wait, yield to let that producer finish.
+
+        d_numWaitingPoppers.add(1);
+        if (isEmpty()) {
+            d_popControlSema.wait();
+        }
+        else {
+            bslmt::ThreadUtil::yield();
+        }
+        d_numWaitingPoppers.add(-1);
+    }
+}
+
+template <class TYPE>
+inline
+int MultipleProducerSingleConsumerBoundedQueue<TYPE>::tryPopFront(TYPE *value)
+{
+    BSLS_ASSERT(value);
+
+    return popFrontImp(value);
+}
+
+template <class TYPE>
+void MultipleProducerSingleConsumerBoundedQueue<TYPE>::removeAll()
+{
+    while (0 == popFrontImp(0)) {
+    }
+}
+
+template <class TYPE>
+void MultipleProducerSingleConsumerBoundedQueue<TYPE>::disable()
+{
+    d_state = k_DISABLED;
+
+    const int numWaitingPushers = d_numWaitingPushers;
+    if (numWaitingPushers) {
+        d_pushControlSema.post(numWaitingPushers);
+    }
+}
+
+template <class TYPE>
+inline
+void MultipleProducerSingleConsumerBoundedQueue<TYPE>::enable()
+{
+    d_state = k_ENABLED;
+}
+
+// ACCESSORS
+template <class TYPE>
+inline
+bsl::size_t MultipleProducerSingleConsumerBoundedQueue<TYPE>::capacity() const
+{
+    return static_cast<bsl::size_t>(d_capacity);
+}
+
+template <class TYPE>
+inline
+bool MultipleProducerSingleConsumerBoundedQueue<TYPE>::isEmpty() const
+{
+    return 0 == numElements();
+}
+
+template <class TYPE>
+inline
+bool MultipleProducerSingleConsumerBoundedQueue<TYPE>::isEnabled() const
+{
+    return k_ENABLED == d_state;
+}
+
+template <class TYPE>
+inline
+bool MultipleProducerSingleConsumerBoundedQueue<TYPE>::isFull() const
+{
+    return capacity() <= numElements();
+}
+
+template <class TYPE>
+inline
+bsl::size_t
+MultipleProducerSingleConsumerBoundedQueue<TYPE>::numElements() const
+{
+    // Load the pop index first: since 'd_popIndex' never exceeds
+    // 'd_pushIndex', the difference is never negative, but it may exceed the
+    // capacity if elements are pushed and popped between the two loads.
+
+    const Uint64 popIndex  = d_popIndex;
+    const Uint64 pushIndex = d_pushIndex;
+
+    const Uint64 length = pushIndex - popIndex;
+    return static_cast<bsl::size_t>(length < d_capacity ? length
+                                                        : d_capacity);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,833 @@
+// bdlcc_shardedcache.h                                               -*-C++-*-
+#ifndef INCLUDED_BDLCC_SHARDEDCACHE
+#define INCLUDED_BDLCC_SHARDEDCACHE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a lock-striped in-process cache partitioned by key hash.
+//
+//@CLASSES:
+//  bdlcc::ShardedCache: in-process key-value cache split into shards
+//
+//@SEE_ALSO: bdlcc_cache
+//
+//@DESCRIPTION: This component defines a single class template,
+// 'bdlcc::ShardedCache', implementing a thread-safe in-memory key-value cache
+// that is partitioned into a fixed number of independently locked segments
+// ("shards").  Each shard is a 'bdlcc::Cache' having its own reader-writer
+// lock, hash table, and eviction queue; the shard holding a given key is
+// selected by the hash value of that key.  'bdlcc::ShardedCache' provides the
+// same 'insert', 'tryGetValue', 'erase', 'popFront', and 'visit' interface as
+// 'bdlcc::Cache', so that one can be substituted for the other.
+//
+// The motivation for sharding is lock contention.  With the LRU eviction
+// policy every successful 'tryGetValue' on a 'bdlcc::Cache' must acquire the
+// write lock to move the accessed item to the back of the eviction queue, so
+// that concurrent readers of a single cache are serialized.  Spreading the
+// keys over 'numShards' independently locked caches allows up to 'numShards'
+// such operations to proceed in parallel.
+//
+///Eviction Policy and Watermarks
+///------------------------------
+// The eviction policy (see 'bdlcc::CacheEvictionPolicy') is applied per shard:
+// the eviction order among the items of one shard is exactly that of a
+// 'bdlcc::Cache' using the same policy, but there is no ordering between items
+// residing in different shards.
+//
+// The low and high watermarks supplied at construction apply to the cache as a
+// whole, and are divided evenly (rounding up) among the shards.  Eviction in a
+// shard starts when the size of that shard reaches its share of the high
+// watermark, and stops when the size of that shard falls below its share of
+// the low watermark.  Consequently, the total number of items held is bounded
+// by 'numShards() * ceil(highWatermark() / numShards())', which exceeds
+// 'highWatermark()' by less than 'numShards()'; and, if keys are not evenly
+// distributed among the shards, eviction may begin before the total size
+// reaches 'highWatermark()'.  For that reason, the number of shards should be
+// small compared to the watermarks.
+//
+// 'popFront' removes the item at the front of the eviction queue of one shard,
+// visiting the shards in round-robin order, so successive calls to 'popFront'
+// drain the shards evenly.
+//
+///Thread Safety
+///-------------
+// The 'bdlcc::ShardedCache' class template is fully thread-safe (see
+// 'bsldoc_glossary') provided that the allocator supplied at construction and
+// the default allocator in effect during the lifetime of cached items are both
+// fully thread-safe.
+//
+// Operations on a single key (e.g., 'insert', 'tryGetValue', and 'erase')
+// lock only the shard owning that key.  Operations on multiple keys (e.g.,
+// 'insertBulk' and 'eraseBulk') lock each affected shard in turn, and are
+// therefore *not* atomic with respect to the cache as a whole.  Likewise,
+// 'size' and 'visit' lock each shard in turn, so the values they observe may
+// reflect concurrent modifications to shards that were not yet visited.
+//
+///Post-eviction Callback and Potential Deadlocks
+///---------------------------------------------
+// The post-eviction callback is invoked by the shard from which an item is
+// removed while that shard's write lock is held.  As with 'bdlcc::Cache', the
+// cache object itself must not be used from within the post-eviction callback.
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Basic Usage
+/// - - - - - - - - - - -
+// This example shows some basic usage of the sharded cache.  First, we define
+// a 'bdlcc::ShardedCache' object, 'myCache', that maps 'int' to 'bsl::string',
+// is split into 4 shards, and uses the LRU eviction policy with a total
+// capacity of 1000 items:
+//..
+//  bdlcc::ShardedCache<int, bsl::string> myCache(
+//                                           4,
+//                                           bdlcc::CacheEvictionPolicy::e_LRU,
+//                                           1000,
+//                                           1000,
+//                                           &talloc);
+//  assert(4    == myCache.numShards());
+//  assert(1000 == myCache.lowWatermark());
+//  assert(1000 == myCache.highWatermark());
+//..
+// Then, we insert a few items into the cache, and verify that the size of the
+// cache has been updated correctly:
+//..
+//  myCache.insert(0, "Alex");
+//  myCache.insert(1, "John");
+//  myCache.insert(2, "Rob");
+//  assert(3 == myCache.size());
+//..
+// Next, we retrieve the value of an item from the cache, which, in LRU mode,
+// marks that item as most recently used in the shard that owns it.  Only the
+// lock of that shard is acquired:
+//..
+//  bsl::shared_ptr<bsl::string> value;
+//  int rc = myCache.tryGetValue(&value, 1);
+//  assert(0 == rc);
+//  assert("John" == *value);
+//..
+// Then, we erase an item, and observe that retrieving it fails:
+//..
+//  rc = myCache.erase(1);
+//  assert(0 == rc);
+//  rc = myCache.tryGetValue(&value, 1);
+//  assert(1 == rc);
+//  assert(2 == myCache.size());
+//..
+// Finally, we remove the remaining items using 'popFront', which removes the
+// front item of one non-empty shard per call:
+//..
+//  assert(0 == myCache.popFront());
+//  assert(0 == myCache.popFront());
+//  assert(1 == myCache.popFront());
+//  assert(0 == myCache.size());
+//..
+
+#ifndef INCLUDED_BDLCC_CACHE
+#include <bdlcc_cache.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_INTEGRALCONSTANT
+#include <bslmf_integralconstant.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>            // 'bsl::size_t'
+#endif
+
+#ifndef INCLUDED_BSL_FUNCTIONAL
+#include <bsl_functional.h>
+#endif
+
+#ifndef INCLUDED_BSL_LIMITS
+#include <bsl_limits.h>
+#endif
+
+#ifndef INCLUDED_BSL_MEMORY
+#include <bsl_memory.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                      // ==================================
+                      // class ShardedCache_VisitorAdapter
+                      // ==================================
+
+template <class KEY, class VALUE, class VISITOR>
+class ShardedCache_VisitorAdapter {
+    // This class implements a visitor, to be supplied to the 'visit' method of
+    // each shard of a 'ShardedCache', that forwards to a held visitor and
+    // records whether that visitor requested the visitation to stop.
+
+    // DATA
+    VISITOR *d_visitor_p;  // visitor to forward to (held, not owned)
+    bool     d_stopped;    // 'true' if 'd_visitor_p' has returned 'false'
+
+  public:
+    // CREATORS
+    explicit ShardedCache_VisitorAdapter(VISITOR *visitor);
+        // Create an adapter forwarding to the specified 'visitor'.
+
+    // MANIPULATORS
+    bool operator()(const KEY& key, const VALUE& value);
+        // Invoke the held visitor with the specified 'key' and 'value', and
+        // return its result.  If the result is 'false', record that the
+        // visitation has been stopped.
+
+    // ACCESSORS
+    bool isStopped() const;
+        // Return 'true' if the held visitor has returned 'false', and 'false'
+        // otherwise.
+};
+
+                            // ==================
+                            // class ShardedCache
+                            // ==================
+
+template <class KEY,
+          class VALUE,
+          class HASH  = bsl::hash<KEY>,
+          class EQUAL = bsl::equal_to<KEY> >
+class ShardedCache {
+    // This class represents an in-process key-value store partitioned into a
+    // fixed number of independently locked 'Cache' objects, selected by the
+    // hash of the key.
+
+  public:
+    // PUBLIC TYPES
+    typedef Cache<KEY, VALUE, HASH, EQUAL>            ShardType;
+        // Type of each of the independently locked segments of this cache.
+
+    typedef typename ShardType::ValuePtrType          ValuePtrType;
+        // Shared pointer type pointing to value type.
+
+    typedef typename ShardType::PostEvictionCallback  PostEvictionCallback;
+        // Type of function to call after an item has been evicted from the
+        // cache.
+
+    typedef typename ShardType::KVType                KVType;
+        // Value type of a bulk insert entry.
+
+  private:
+    // PRIVATE TYPES
+    typedef bsl::vector<bsl::shared_ptr<ShardType> >  ShardArray;
+        // Array of shards.
+
+    // DATA
+    bslma::Allocator          *d_allocator_p;    // memory allocator (held, not
+                                                 // owned)
+
+    ShardArray                 d_shards;         // independently locked
+                                                 // segments, each allocated
+                                                 // separately to avoid false
+                                                 // sharing between their locks
+
+    HASH                       d_hashFunction;   // hash functor used to select
+                                                 // the shard owning a key
+
+    CacheEvictionPolicy::Enum  d_evictionPolicy; // eviction policy
+
+    bsl::size_t                d_lowWatermark;   // low watermark of the cache
+                                                 // as a whole
+
+    bsl::size_t                d_highWatermark;  // high watermark of the cache
+                                                 // as a whole
+
+    bsls::AtomicUint           d_popFrontIndex;  // index of the shard to be
+                                                 // tried first by the next
+                                                 // call to 'popFront'
+
+    // PRIVATE CLASS METHODS
+    static bsl::size_t shardWatermark(bsl::size_t watermark,
+                                      bsl::size_t numShards);
+        // Return the share of the specified 'watermark' to be applied to each
+        // of the specified 'numShards' shards, i.e., 'watermark / numShards'
+        // rounded up, or 'watermark' itself if it is the maximum value of
+        // 'bsl::size_t'.
+
+    // PRIVATE MANIPULATORS
+    void createShards(bsl::size_t  numShards,
+                      const HASH&  hashFunction,
+                      const EQUAL& equalFunction);
+        // Create the specified 'numShards' shards, each using the eviction
+        // policy and the share of the watermarks of this cache, and the
+        // specified 'hashFunction' and 'equalFunction'.
+
+    // PRIVATE ACCESSORS
+    bsl::size_t shardIndex(const KEY& key) const;
+        // Return the index of the shard owning the specified 'key'.
+
+    ShardType& shardFor(const KEY& key) const;
+        // Return a reference providing modifiable access to the shard owning
+        // the specified 'key'.
+
+    // NOT IMPLEMENTED
+    ShardedCache(const ShardedCache&);
+    ShardedCache& operator=(const ShardedCache&);
+
+  public:
+    // CREATORS
+    explicit ShardedCache(bsl::size_t       numShards,
+                          bslma::Allocator *basicAllocator = 0);
+        // Create an empty LRU cache having no size limit and split into the
+        // specified 'numShards' shards.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '1 <= numShards'.
+
+    ShardedCache(bsl::size_t                numShards,
+                 CacheEvictionPolicy::Enum  evictionPolicy,
+                 bsl::size_t                lowWatermark,
+                 bsl::size_t                highWatermark,
+                 bslma::Allocator          *basicAllocator = 0);
+        // Create an empty cache split into the specified 'numShards' shards,
+        // using the specified 'evictionPolicy' in each shard, and the
+        // specified 'lowWatermark' and 'highWatermark' for the cache as a
+        // whole (see {Eviction Policy and Watermarks}).  Optionally specify
+        // the 'basicAllocator' used to supply memory.  If 'basicAllocator' is
+        // 0, the currently installed default allocator is used.  The behavior
+        // is undefined unless '1 <= numShards',
+        // 'lowWatermark <= highWatermark', '1 <= lowWatermark', and
+        // '1 <= highWatermark'.
+
+    ShardedCache(bsl::size_t                numShards,
+                 CacheEvictionPolicy::Enum  evictionPolicy,
+                 bsl::size_t                lowWatermark,
+                 bsl::size_t                highWatermark,
+                 const HASH&                hashFunction,
+                 const EQUAL&               equalFunction,
+                 bslma::Allocator          *basicAllocator = 0);
+        // Create an empty cache split into the specified 'numShards' shards,
+        // using the specified 'evictionPolicy' in each shard, and the
+        // specified 'lowWatermark' and 'highWatermark' for the cache as a
+        // whole (see {Eviction Policy and Watermarks}).  The specified
+        // 'hashFunction' is used both to select the shard owning a key and
+        // to generate the hash values within each shard, and the specified
+        // 'equalFunction' is used to determine whether two keys have the same
+        // value.  Optionally specify the 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '1 <= numShards', 'lowWatermark <= highWatermark',
+        // '1 <= lowWatermark', and '1 <= highWatermark'.
+
+    // ~ShardedCache() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void clear();
+        // Remove all items from this cache.  Do *not* invoke the post-eviction
+        // callback.  Note that the shards are cleared one at a time.
+
+    int erase(const KEY& key);
+        // Remove the item having the specified 'key' from this cache.  Invoke
+        // the post-eviction callback for the removed item.  Return 0 on
+        // success and 1 if 'key' does not exist.
+
+    int eraseBulk(const bsl::vector<KEY>& keys);
+        // Remove the items having the specified 'keys' from this cache.
+        // Invoke the post-eviction callback for each removed item.  Return
+        // the number of items successfully removed.
+
+    void insert(const KEY& key, const VALUE& value);
+        // Insert the specified 'key' and its associated 'value' into this
+        // cache.  If 'key' already exists, then its value will be replaced
+        // with 'value'.
+
+    void insert(const KEY& key, const ValuePtrType& valuePtr);
+        // Insert the specified 'key' and its associated 'valuePtr' into this
+        // cache.  If 'key' already exists, then its value will be replaced
+        // with 'value'.
+
+    int insertBulk(const bsl::vector<KVType>& data);
+        // Insert the specified 'data' (composed of Key-Value pairs) into this
+        // cache.  If a key already exists, then its value will be replaced
+        // with the value.  Return the number of items successfully inserted.
+        // Note that the items are grouped by shard, and each affected shard is
+        // locked once.
+
+    int popFront();
+        // Remove the item at the front of the eviction queue of the next
+        // non-empty shard in round-robin order.  Invoke the post-eviction
+        // callback for the removed item.  Return 0 on success, and 1 if this
+        // cache is empty.
+
+    void setPostEvictionCallback(
+                             const PostEvictionCallback& postEvictionCallback);
+        // Set the post-eviction callback of every shard to the specified
+        // 'postEvictionCallback'.  The post-eviction callback is invoked for
+        // each item evicted or removed from this cache.
+
+    int tryGetValue(bsl::shared_ptr<VALUE> *value,
+                    const KEY&              key,
+                    bool                    modifyEvictionQueue = true);
+        // Load, into the specified 'value', the value associated with the
+        // specified 'key' in this cache.  If the optionally specified
+        // 'modifyEvictionQueue' is 'true' and the eviction policy is LRU, then
+        // move the cached item to the back of the eviction queue of its
+        // shard.  Return 0 on success, and 1 if 'key' does not exist in this
+        // cache.  Note that only the lock of the shard owning 'key' is
+        // acquired.
+
+    // ACCESSORS
+    EQUAL equalFunction() const;
+        // Return (a copy of) the key-equality functor used by this cache that
+        // returns 'true' if two 'KEY' objects have the same value, and 'false'
+        // otherwise.
+
+    CacheEvictionPolicy::Enum evictionPolicy() const;
+        // Return the eviction policy used by each shard of this cache.
+
+    HASH hashFunction() const;
+        // Return (a copy of) the unary hash functor used by this cache to
+        // generate a hash value (of type 'std::size_t') for a 'KEY' object.
+
+    bsl::size_t highWatermark() const;
+        // Return the high watermark of this cache as a whole.
+
+    bsl::size_t lowWatermark() const;
+        // Return the low watermark of this cache as a whole.
+
+    bsl::size_t numShards() const;
+        // Return the number of independently locked shards of this cache.
+
+    const ShardType& shard(bsl::size_t index) const;
+        // Return a reference providing non-modifiable access to the shard at
+        // the specified 'index'.  The behavior is undefined unless
+        // 'index < numShards()'.
+
+    bsl::size_t size() const;
+        // Return the current size of this cache, i.e., the sum of the sizes of
+        // its shards.
+
+    template <class VISITOR>
+    void visit(VISITOR& visitor) const;
+        // Call the specified 'visitor' for every item stored in this cache,
+        // shard by shard and, within a shard, in the order of its eviction
+        // queue, until 'visitor' returns 'false'.  The 'VISITOR' type must be
+        // a callable object that can be invoked in the same way as the
+        // function 'bool (const KEY&, const VALUE&)'.
+};
+
+// ============================================================================
+//                        INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+                      // ----------------------------------
+                      // class ShardedCache_VisitorAdapter
+                      // ----------------------------------
+
+// CREATORS
+template <class KEY, class VALUE, class VISITOR>
+inline
+ShardedCache_VisitorAdapter<KEY, VALUE, VISITOR>::ShardedCache_VisitorAdapter(
+                                                              VISITOR *visitor)
+: d_visitor_p(visitor)
+, d_stopped(false)
+{
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE, class VISITOR>
+inline
+bool ShardedCache_VisitorAdapter<KEY, VALUE, VISITOR>::operator()(
+                                                            const KEY&   key,
+                                                            const VALUE& value)
+{
+    if (!(*d_visitor_p)(key, value)) {
+        d_stopped = true;
+        return false;                                                 // RETURN
+    }
+    return true;
+}
+
+// ACCESSORS
+template <class KEY, class VALUE, class VISITOR>
+inline
+bool ShardedCache_VisitorAdapter<KEY, VALUE, VISITOR>::isStopped() const
+{
+    return d_stopped;
+}
+
+                            // ------------------
+                            // class ShardedCache
+                            // ------------------
+
+// PRIVATE CLASS METHODS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ShardedCache<KEY, VALUE, HASH, EQUAL>::shardWatermark(
+                                                     bsl::size_t watermark,
+                                                     bsl::size_t numShards)
+{
+    if (bsl::numeric_limits<bsl::size_t>::max() == watermark) {
+        return watermark;                                             // RETURN
+    }
+    return (watermark + numShards - 1) / numShards;
+}
+
+// PRIVATE MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::createShards(
+                                                  bsl::size_t  numShards,
+                                                  const HASH&  hashFunction,
+                                                  const EQUAL& equalFunction)
+{
+    const bsl::size_t lowWatermark  = shardWatermark(d_lowWatermark,
+                                                     numShards);
+    const bsl::size_t highWatermark = shardWatermark(d_highWatermark,
+                                                     numShards);
+
+    // Note that 'allocate_shared' supplies 'd_allocator_p' to each shard.
+
+    d_shards.reserve(numShards);
+    for (bsl::size_t i = 0; i < numShards; ++i) {
+        d_shards.push_back(bsl::allocate_shared<ShardType>(d_allocator_p,
+                                                           d_evictionPolicy,
+                                                           lowWatermark,
+                                                           highWatermark,
+                                                           hashFunction,
+                                                           equalFunction));
+    }
+}
+
+// PRIVATE ACCESSORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ShardedCache<KEY, VALUE, HASH, EQUAL>::shardIndex(
+                                                          const KEY& key) const
+{
+    // Each shard also uses the hash value to select a bucket, so fold the
+    // high-order bits in to reduce the correlation between the choice of
+    // shard and the choice of bucket.
+
+    bsl::size_t hashValue = d_hashFunction(key);
+    hashValue ^= hashValue >> (sizeof(bsl::size_t) * 4);
+    return hashValue % d_shards.size();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+typename ShardedCache<KEY, VALUE, HASH, EQUAL>::ShardType&
+ShardedCache<KEY, VALUE, HASH, EQUAL>::shardFor(const KEY& key) const
+{
+    return *d_shards[shardIndex(key)];
+}
+
+// CREATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ShardedCache<KEY, VALUE, HASH, EQUAL>::ShardedCache(
+                                              bsl::size_t       numShards,
+                                              bslma::Allocator *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_shards(d_allocator_p)
+, d_hashFunction()
+, d_evictionPolicy(CacheEvictionPolicy::e_LRU)
+, d_lowWatermark(bsl::numeric_limits<bsl::size_t>::max())
+, d_highWatermark(bsl::numeric_limits<bsl::size_t>::max())
+, d_popFrontIndex(0)
+{
+    BSLS_ASSERT_SAFE(1 <= numShards);
+
+    createShards(numShards, HASH(), EQUAL());
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ShardedCache<KEY, VALUE, HASH, EQUAL>::ShardedCache(
+                                     bsl::size_t                numShards,
+                                     CacheEvictionPolicy::Enum  evictionPolicy,
+                                     bsl::size_t                lowWatermark,
+                                     bsl::size_t                highWatermark,
+                                     bslma::Allocator          *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_shards(d_allocator_p)
+, d_hashFunction()
+, d_evictionPolicy(evictionPolicy)
+, d_lowWatermark(lowWatermark)
+, d_highWatermark(highWatermark)
+, d_popFrontIndex(0)
+{
+    BSLS_ASSERT_SAFE(1 <= numShards);
+    BSLS_ASSERT_SAFE(lowWatermark <= highWatermark);
+    BSLS_ASSERT_SAFE(1 <= lowWatermark);
+    BSLS_ASSERT_SAFE(1 <= highWatermark);
+
+    createShards(numShards, HASH(), EQUAL());
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+ShardedCache<KEY, VALUE, HASH, EQUAL>::ShardedCache(
+                                     bsl::size_t                numShards,
+                                     CacheEvictionPolicy::Enum  evictionPolicy,
+                                     bsl::size_t                lowWatermark,
+                                     bsl::size_t                highWatermark,
+                                     const HASH&                hashFunction,
+                                     const EQUAL&               equalFunction,
+                                     bslma::Allocator          *basicAllocator)
+: d_allocator_p(bslma::Default::allocator(basicAllocator))
+, d_shards(d_allocator_p)
+, d_hashFunction(hashFunction)
+, d_evictionPolicy(evictionPolicy)
+, d_lowWatermark(lowWatermark)
+, d_highWatermark(highWatermark)
+, d_popFrontIndex(0)
+{
+    BSLS_ASSERT_SAFE(1 <= numShards);
+    BSLS_ASSERT_SAFE(lowWatermark <= highWatermark);
+    BSLS_ASSERT_SAFE(1 <= lowWatermark);
+    BSLS_ASSERT_SAFE(1 <= highWatermark);
+
+    createShards(numShards, hashFunction, equalFunction);
+}
+
+// MANIPULATORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::clear()
+{
+    for (bsl::size_t i = 0; i < d_shards.size(); ++i) {
+        d_shards[i]->clear();
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+int ShardedCache<KEY, VALUE, HASH, EQUAL>::erase(const KEY& key)
+{
+    return shardFor(key).erase(key);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ShardedCache<KEY, VALUE, HASH, EQUAL>::eraseBulk(
+                                                  const bsl::vector<KEY>& keys)
+{
+    if (1 == d_shards.size()) {
+        return d_shards[0]->eraseBulk(keys);                          // RETURN
+    }
+
+    bsl::vector<bsl::vector<KEY> > keysByShard(d_shards.size(),
+                                               bsl::vector<KEY>(),
+                                               d_allocator_p);
+    for (bsl::size_t i = 0; i < keys.size(); ++i) {
+        keysByShard[shardIndex(keys[i])].push_back(keys[i]);
+    }
+
+    int count = 0;
+    for (bsl::size_t i = 0; i < d_shards.size(); ++i) {
+        if (!keysByShard[i].empty()) {
+            count += d_shards[i]->eraseBulk(keysByShard[i]);
+        }
+    }
+    return count;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::insert(const KEY&   key,
+                                                   const VALUE& value)
+{
+    shardFor(key).insert(key, value);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::insert(
+                                                  const KEY&          key,
+                                                  const ValuePtrType& valuePtr)
+{
+    shardFor(key).insert(key, valuePtr);
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ShardedCache<KEY, VALUE, HASH, EQUAL>::insertBulk(
+                                               const bsl::vector<KVType>& data)
+{
+    if (1 == d_shards.size()) {
+        return d_shards[0]->insertBulk(data);                         // RETURN
+    }
+
+    bsl::vector<bsl::vector<KVType> > dataByShard(d_shards.size(),
+                                                  bsl::vector<KVType>(),
+                                                  d_allocator_p);
+    for (bsl::size_t i = 0; i < data.size(); ++i) {
+        dataByShard[shardIndex(data[i].first)].push_back(data[i]);
+    }
+
+    int count = 0;
+    for (bsl::size_t i = 0; i < d_shards.size(); ++i) {
+        if (!dataByShard[i].empty()) {
+            count += d_shards[i]->insertBulk(dataByShard[i]);
+        }
+    }
+    return count;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+int ShardedCache<KEY, VALUE, HASH, EQUAL>::popFront()
+{
+    const bsl::size_t numShards = d_shards.size();
+    const bsl::size_t start     = (d_popFrontIndex++) % numShards;
+
+    for (bsl::size_t i = 0; i < numShards; ++i) {
+        if (0 == d_shards[(start + i) % numShards]->popFront()) {
+            return 0;                                                 // RETURN
+        }
+    }
+    return 1;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::setPostEvictionCallback(
+                              const PostEvictionCallback& postEvictionCallback)
+{
+    for (bsl::size_t i = 0; i < d_shards.size(); ++i) {
+        d_shards[i]->setPostEvictionCallback(postEvictionCallback);
+    }
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+int ShardedCache<KEY, VALUE, HASH, EQUAL>::tryGetValue(
+                                   bsl::shared_ptr<VALUE> *value,
+                                   const KEY&              key,
+                                   bool                    modifyEvictionQueue)
+{
+    return shardFor(key).tryGetValue(value, key, modifyEvictionQueue);
+}
+
+// ACCESSORS
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+EQUAL ShardedCache<KEY, VALUE, HASH, EQUAL>::equalFunction() const
+{
+    return d_shards[0]->equalFunction();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+CacheEvictionPolicy::Enum
+ShardedCache<KEY, VALUE, HASH, EQUAL>::evictionPolicy() const
+{
+    return d_evictionPolicy;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+HASH ShardedCache<KEY, VALUE, HASH, EQUAL>::hashFunction() const
+{
+    return d_hashFunction;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ShardedCache<KEY, VALUE, HASH, EQUAL>::highWatermark() const
+{
+    return d_highWatermark;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ShardedCache<KEY, VALUE, HASH, EQUAL>::lowWatermark() const
+{
+    return d_lowWatermark;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+bsl::size_t ShardedCache<KEY, VALUE, HASH, EQUAL>::numShards() const
+{
+    return d_shards.size();
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+inline
+const typename ShardedCache<KEY, VALUE, HASH, EQUAL>::ShardType&
+ShardedCache<KEY, VALUE, HASH, EQUAL>::shard(bsl::size_t index) const
+{
+    BSLS_ASSERT_SAFE(index < d_shards.size());
+
+    return *d_shards[index];
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+bsl::size_t ShardedCache<KEY, VALUE, HASH, EQUAL>::size() const
+{
+    bsl::size_t result = 0;
+    for (bsl::size_t i = 0; i < d_shards.size(); ++i) {
+        result += d_shards[i]->size();
+    }
+    return result;
+}
+
+template <class KEY, class VALUE, class HASH, class EQUAL>
+template <class VISITOR>
+void ShardedCache<KEY, VALUE, HASH, EQUAL>::visit(VISITOR& visitor) const
+{
+    ShardedCache_VisitorAdapter<KEY, VALUE, VISITOR> adapter(&visitor);
+
+    for (bsl::size_t i = 0; i < d_shards.size(); ++i) {
+        d_shards[i]->visit(adapter);
+        if (adapter.isStopped()) {
+            break;
+        }
+    }
+}
+
+}  // close package namespace
+
+namespace bslma {
+
+template <class KEY,  class VALUE,  class HASH,  class EQUAL>
+struct UsesBslmaAllocator<bdlcc::ShardedCache<KEY, VALUE, HASH, EQUAL> >
+    : bsl::true_type
+{
+};
+
+}  // close namespace bslma
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1052 @@
+// bdlcc_shardedcache.t.cpp                                           -*-C++-*-
+
+#include <bdlcc_shardedcache.h>
+
+#include <bdlcc_cache.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadgroup.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+
+#include <bdlf_bind.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test defines a mechanism, 'bdlcc::ShardedCache', that
+// partitions keys among a number of 'bdlcc::Cache' objects.  Since the
+// eviction, locking, and value-handling logic is delegated to 'bdlcc::Cache'
+// (which is tested in its own test driver), we concentrate on verifying that
+// every key is routed to exactly one, consistently selected, shard; that the
+// operations spanning shards ('insertBulk', 'eraseBulk', 'popFront', 'size',
+// 'visit', 'clear', and 'setPostEvictionCallback') aggregate the shards
+// correctly; and that the watermarks are divided among the shards as
+// documented.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit ShardedCache(numShards, basicAllocator);
+// [ 2] ShardedCache(numShards, policy, lowWat, highWat, basicAllocator);
+// [ 2] ShardedCache(numShards, policy, lowWat, highWat, hash, eq, alloc);
+//
+// MANIPULATORS
+// [ 3] void insert(const KEY& key, const VALUE& value);
+// [ 3] void insert(const KEY& key, const ValuePtrType& valuePtr);
+// [ 3] int tryGetValue(value, key, modifyEvictionQueue);
+// [ 3] int erase(const KEY& key);
+// [ 4] int insertBulk(const bsl::vector<KVType>& data);
+// [ 4] int eraseBulk(const bsl::vector<KEY>& keys);
+// [ 5] int popFront();
+// [ 5] void clear();
+// [ 6] void setPostEvictionCallback(postEvictionCallback);
+//
+// ACCESSORS
+// [ 2] EQUAL equalFunction() const;
+// [ 2] CacheEvictionPolicy::Enum evictionPolicy() const;
+// [ 2] HASH hashFunction() const;
+// [ 2] bsl::size_t highWatermark() const;
+// [ 2] bsl::size_t lowWatermark() const;
+// [ 2] bsl::size_t numShards() const;
+// [ 2] const ShardType& shard(bsl::size_t index) const;
+// [ 3] bsl::size_t size() const;
+// [ 5] void visit(VISITOR& visitor) const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] CONCURRENT ACCESS
+// [ 8] USAGE EXAMPLE
+// [-1] HIT THROUGHPUT SCALING
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool             verbose;
+bool         veryVerbose;
+bool     veryVeryVerbose;
+bool veryVeryVeryVerbose;
+
+typedef bdlcc::ShardedCache<int, bsl::string> Obj;
+typedef Obj::ValuePtrType                     ValuePtr;
+typedef Obj::KVType                           KV;
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+struct CountingVisitor {
+    // Visitor that counts the items visited and stops after 'd_limit' items.
+
+    int d_count;
+    int d_limit;
+
+    explicit CountingVisitor(int limit = -1)
+    : d_count(0)
+    , d_limit(limit)
+    {}
+
+    bool operator()(int, const bsl::string&)
+    {
+        ++d_count;
+        return d_count != d_limit;
+    }
+};
+
+struct EvictionCounter {
+    // Post-eviction callback counting the number of items evicted.
+
+    bsls::AtomicInt *d_count_p;
+
+    explicit EvictionCounter(bsls::AtomicInt *count)
+    : d_count_p(count)
+    {}
+
+    void operator()(const ValuePtr&) const
+    {
+        ++*d_count_p;
+    }
+};
+
+class ModuloHash {
+    // Hash functor returning a value that is a fixed offset from the key, so
+    // that tests can verify that the supplied functor is used.
+
+    int d_offset;
+
+  public:
+    explicit ModuloHash(int offset = 0)
+    : d_offset(offset)
+    {}
+
+    bsl::size_t operator()(int key) const
+    {
+        return static_cast<bsl::size_t>(key + d_offset);
+    }
+
+    int offset() const
+    {
+        return d_offset;
+    }
+};
+
+                         // =========================
+                         // namespace hitThroughput
+                         // =========================
+
+namespace hitThroughput {
+
+template <class CACHE>
+void reader(CACHE           *cache,
+            bslmt::Barrier  *barrier,
+            int              numKeys,
+            int              numReads,
+            int              seed,
+            bsls::AtomicInt *misses)
+    // Wait on the specified 'barrier', then look up the specified 'numReads'
+    // pseudo-random keys in '[0 .. numKeys)' from the specified 'cache', using
+    // the specified 'seed', and add the number of failed look-ups to the
+    // specified 'misses'.
+{
+    bsl::shared_ptr<bsl::string> value;
+    unsigned int                 state = static_cast<unsigned int>(seed);
+    int                          count = 0;
+
+    barrier->wait();
+    for (int i = 0; i < numReads; ++i) {
+        state = state * 1103515245u + 12345u;
+        count += cache->tryGetValue(&value,
+                                    static_cast<int>((state >> 8) % numKeys));
+    }
+    *misses += count;
+}
+
+template <class CACHE>
+double run(CACHE *cache, int numThreads, int numKeys, int numReads)
+    // Look up the specified 'numReads' keys from each of the specified
+    // 'numThreads' threads concurrently on the specified 'cache', which holds
+    // the keys '[0 .. numKeys)'.  Return the number of look-ups per second.
+{
+    bslmt::Barrier     barrier(numThreads + 1);
+    bslmt::ThreadGroup threads;
+    bsls::AtomicInt    misses(0);
+
+    for (int i = 0; i < numThreads; ++i) {
+        threads.addThread(bdlf::BindUtil::bind(&reader<CACHE>,
+                                               cache,
+                                               &barrier,
+                                               numKeys,
+                                               numReads,
+                                               i + 1,
+                                               &misses));
+    }
+
+    bsls::Stopwatch timer;
+    barrier.wait();
+    timer.start();
+    threads.joinAll();
+    timer.stop();
+
+    ASSERT(0 == misses);
+
+    return static_cast<double>(numThreads) * numReads / timer.elapsedTime();
+}
+
+}  // close namespace hitThroughput
+
+                         // ==========================
+                         // namespace concurrentAccess
+                         // ==========================
+
+namespace concurrentAccess {
+
+void worker(Obj *cache, bslmt::Barrier *barrier, int id, int numIterations)
+    // Wait on the specified 'barrier', then perform the specified
+    // 'numIterations' of mixed insert, look-up, and erase operations on keys
+    // owned by the specified thread 'id' of the specified 'cache'.
+{
+    barrier->wait();
+
+    const int base = id * numIterations;
+    for (int i = 0; i < numIterations; ++i) {
+        cache->insert(base + i, bsl::string(8, static_cast<char>('a' + id)));
+
+        bsl::shared_ptr<bsl::string> value;
+        LOOP2_ASSERT(id, i, 0 == cache->tryGetValue(&value, base + i));
+        LOOP2_ASSERT(id, i, value && (*value)[0] == 'a' + id);
+
+        if (i % 2) {
+            LOOP2_ASSERT(id, i, 0 == cache->erase(base + i));
+        }
+    }
+}
+
+}  // close namespace concurrentAccess
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usageExample1 {
+
+void example1()
+{
+    bslma::TestAllocator talloc("ue1", veryVeryVeryVerbose);
+
+///Example 1: Basic Usage
+/// - - - - - - - - - - -
+// This example shows some basic usage of the sharded cache.  First, we define
+// a 'bdlcc::ShardedCache' object, 'myCache', that maps 'int' to 'bsl::string',
+// is split into 4 shards, and uses the LRU eviction policy with a total
+// capacity of 1000 items:
+//..
+    bdlcc::ShardedCache<int, bsl::string> myCache(
+                                             4,
+                                             bdlcc::CacheEvictionPolicy::e_LRU,
+                                             1000,
+                                             1000,
+                                             &talloc);
+    ASSERT(4    == myCache.numShards());
+    ASSERT(1000 == myCache.lowWatermark());
+    ASSERT(1000 == myCache.highWatermark());
+//..
+// Then, we insert a few items into the cache, and verify that the size of the
+// cache has been updated correctly:
+//..
+    myCache.insert(0, "Alex");
+    myCache.insert(1, "John");
+    myCache.insert(2, "Rob");
+    ASSERT(3 == myCache.size());
+//..
+// Next, we retrieve the value of an item from the cache, which, in LRU mode,
+// marks that item as most recently used in the shard that owns it.  Only the
+// lock of that shard is acquired:
+//..
+    bsl::shared_ptr<bsl::string> value;
+    int rc = myCache.tryGetValue(&value, 1);
+    ASSERT(0 == rc);
+    ASSERT("John" == *value);
+//..
+// Then, we erase an item, and observe that retrieving it fails:
+//..
+    rc = myCache.erase(1);
+    ASSERT(0 == rc);
+    rc = myCache.tryGetValue(&value, 1);
+    ASSERT(1 == rc);
+    ASSERT(2 == myCache.size());
+//..
+// Finally, we remove the remaining items using 'popFront', which removes the
+// front item of one non-empty shard per call:
+//..
+    ASSERT(0 == myCache.popFront());
+    ASSERT(0 == myCache.popFront());
+    ASSERT(1 == myCache.popFront());
+    ASSERT(0 == myCache.size());
+//..
+}
+
+}  // close namespace usageExample1
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+    bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+    bslma::TestAllocatorMonitor gam(&globalAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        usageExample1::example1();
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENT ACCESS
+        //
+        // Concerns:
+        //: 1 Operations on keys owned by different threads, and therefore
+        //:   spread among all the shards, do not interfere.
+        //
+        // Plan:
+        //: 1 Run several threads, each inserting, reading back, and erasing
+        //:   its own keys, and verify the final size of the cache.  (C-1)
+        //
+        // Testing:
+        //   CONCURRENT ACCESS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT ACCESS" << endl
+                          << "=================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        enum { k_NUM_THREADS = 8, k_NUM_ITERATIONS = 2000 };
+
+        bslma::DefaultAllocatorGuard guard(&ta);  // 'bslmt::ThreadGroup'
+
+        Obj                mX(7, &ta);  const Obj& X = mX;
+        bslmt::Barrier     barrier(k_NUM_THREADS);
+        bslmt::ThreadGroup threads(&ta);
+
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            threads.addThread(bdlf::BindUtil::bind(&concurrentAccess::worker,
+                                                   &mX,
+                                                   &barrier,
+                                                   i,
+                                                   k_NUM_ITERATIONS + 0));
+        }
+        threads.joinAll();
+
+        ASSERTV(X.size(), k_NUM_THREADS * k_NUM_ITERATIONS / 2 == X.size());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // EVICTION AND POST-EVICTION CALLBACK
+        //
+        // Concerns:
+        //: 1 The watermarks of each shard are the watermarks of the cache
+        //:   divided by the number of shards, rounded up.
+        //:
+        //: 2 The total size never exceeds the documented bound.
+        //:
+        //: 3 The post-eviction callback is installed in every shard and
+        //:   invoked for every item evicted or erased.
+        //
+        // Plan:
+        //: 1 Create caches with various shard counts and watermarks and
+        //:   verify the watermarks of each shard.  (C-1)
+        //:
+        //: 2 Insert many items and verify that the size stays within bound
+        //:   and that the callback counts the difference.  (C-2..3)
+        //
+        // Testing:
+        //   void setPostEvictionCallback(postEvictionCallback);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EVICTION AND POST-EVICTION CALLBACK" << endl
+                          << "===================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        static const struct {
+            int         d_line;
+            bsl::size_t d_numShards;
+            bsl::size_t d_low;
+            bsl::size_t d_high;
+            bsl::size_t d_expLow;
+            bsl::size_t d_expHigh;
+        } DATA[] = {
+            // LINE  SHARDS  LOW   HIGH  EXP_LOW  EXP_HIGH
+            // ----  ------  ---   ----  -------  --------
+            { L_,        1,   10,   20,      10,       20 },
+            { L_,        2,   10,   20,       5,       10 },
+            { L_,        3,   10,   20,       4,        7 },
+            { L_,        4,    1,    1,       1,        1 },
+            { L_,        8,  100,  120,      13,       15 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE     = DATA[ti].d_line;
+            const bsl::size_t SHARDS   = DATA[ti].d_numShards;
+            const bsl::size_t LOW      = DATA[ti].d_low;
+            const bsl::size_t HIGH     = DATA[ti].d_high;
+            const bsl::size_t EXP_LOW  = DATA[ti].d_expLow;
+            const bsl::size_t EXP_HIGH = DATA[ti].d_expHigh;
+
+            bsls::AtomicInt numEvicted(0);
+
+            Obj mX(SHARDS,
+                   bdlcc::CacheEvictionPolicy::e_FIFO,
+                   LOW,
+                   HIGH,
+                   &ta);
+            const Obj& X = mX;
+
+            const Obj::PostEvictionCallback callback(
+                                               bsl::allocator_arg,
+                                               &ta,
+                                               EvictionCounter(&numEvicted));
+            mX.setPostEvictionCallback(callback);
+
+            for (bsl::size_t i = 0; i < SHARDS; ++i) {
+                LOOP2_ASSERT(LINE, i, EXP_LOW  == X.shard(i).lowWatermark());
+                LOOP2_ASSERT(LINE, i, EXP_HIGH == X.shard(i).highWatermark());
+            }
+
+            const int NUM_ITEMS = 1000;
+            for (int i = 0; i < NUM_ITEMS; ++i) {
+                mX.insert(i, "x");
+                LOOP2_ASSERT(LINE, i, X.size() <= SHARDS * EXP_HIGH);
+            }
+
+            LOOP_ASSERT(LINE,
+                       NUM_ITEMS == numEvicted + static_cast<int>(X.size()));
+
+            const int SIZE = static_cast<int>(X.size());
+            mX.clear();
+            LOOP_ASSERT(LINE, 0 == X.size());
+            LOOP_ASSERT(LINE, NUM_ITEMS - SIZE == numEvicted);
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // POPFRONT, CLEAR, AND VISIT
+        //
+        // Concerns:
+        //: 1 'popFront' removes one item per call while any shard is
+        //:   non-empty, visiting shards in round-robin order, and returns 1
+        //:   once the cache is empty.
+        //:
+        //: 2 'visit' visits every item exactly once, and stops (across
+        //:   shards) as soon as the visitor returns 'false'.
+        //:
+        //: 3 'clear' empties every shard.
+        //
+        // Plan:
+        //: 1 Populate caches with various shard counts and exercise the
+        //:   methods under test, comparing against the shard sizes.  (C-1..3)
+        //
+        // Testing:
+        //   int popFront();
+        //   void clear();
+        //   void visit(VISITOR& visitor) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "POPFRONT, CLEAR, AND VISIT" << endl
+                          << "==========================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        for (bsl::size_t numShards = 1; numShards <= 9; ++numShards) {
+            Obj mX(numShards, &ta);  const Obj& X = mX;
+
+            const int NUM_ITEMS = 50;
+            for (int i = 0; i < NUM_ITEMS; ++i) {
+                mX.insert(i, "v");
+            }
+            LOOP_ASSERT(numShards, NUM_ITEMS == static_cast<int>(X.size()));
+
+            {
+                CountingVisitor visitor;
+                X.visit(visitor);
+                LOOP_ASSERT(numShards, NUM_ITEMS == visitor.d_count);
+            }
+            for (int limit = 1; limit <= NUM_ITEMS; limit += 7) {
+                CountingVisitor visitor(limit);
+                X.visit(visitor);
+                LOOP2_ASSERT(numShards, limit, limit == visitor.d_count);
+            }
+
+            // Remove a few items with 'popFront': each call must remove from
+            // a different shard until every shard has been visited.
+
+            bsl::vector<bsl::size_t> before(&ta);
+            for (bsl::size_t i = 0; i < numShards; ++i) {
+                before.push_back(X.shard(i).size());
+            }
+            for (int i = 0; i < 10; ++i) {
+                LOOP2_ASSERT(numShards, i, 0 == mX.popFront());
+            }
+            LOOP_ASSERT(numShards,
+                        NUM_ITEMS - 10 == static_cast<int>(X.size()));
+            for (bsl::size_t i = 0; i < numShards; ++i) {
+                const bsl::size_t removed = before[i] - X.shard(i).size();
+                LOOP2_ASSERT(numShards, i, removed <= 10 / numShards + 1);
+            }
+
+            for (int i = 10; i < 20; ++i) {
+                LOOP2_ASSERT(numShards, i, 0 == mX.popFront());
+            }
+            LOOP_ASSERT(numShards,
+                        NUM_ITEMS - 20 == static_cast<int>(X.size()));
+
+            mX.clear();
+            LOOP_ASSERT(numShards, 0 == X.size());
+            LOOP_ASSERT(numShards, 1 == mX.popFront());
+
+            mX.insert(1, "a");
+            LOOP_ASSERT(numShards, 0 == mX.popFront());
+            LOOP_ASSERT(numShards, 1 == mX.popFront());
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // BULK OPERATIONS
+        //
+        // Concerns:
+        //: 1 'insertBulk' inserts every item into its owning shard and returns
+        //:   the number of newly inserted keys.
+        //:
+        //: 2 'eraseBulk' erases every existing key and returns the number of
+        //:   keys erased.
+        //:
+        //: 3 No memory is allocated from the default allocator.
+        //
+        // Plan:
+        //: 1 Insert and erase overlapping batches of keys, checking the return
+        //:   values and subsequent look-ups.  (C-1..3)
+        //
+        // Testing:
+        //   int insertBulk(const bsl::vector<KVType>& data);
+        //   int eraseBulk(const bsl::vector<KEY>& keys);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BULK OPERATIONS" << endl
+                          << "===============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        bslma::TestAllocator da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        for (bsl::size_t numShards = 1; numShards <= 5; ++numShards) {
+            Obj mX(numShards, &ta);  const Obj& X = mX;
+
+            bsl::vector<KV> data(&ta);
+            for (int i = 0; i < 20; ++i) {
+                data.push_back(KV(i,
+                                  bsl::allocate_shared<bsl::string>(&ta,
+                                                                    "v1")));
+            }
+            LOOP_ASSERT(numShards, 20 == mX.insertBulk(data));
+            LOOP_ASSERT(numShards, 20 == X.size());
+
+            data.clear();
+            for (int i = 10; i < 30; ++i) {
+                data.push_back(KV(i,
+                                  bsl::allocate_shared<bsl::string>(&ta,
+                                                                    "v2")));
+            }
+            LOOP_ASSERT(numShards, 10 == mX.insertBulk(data));
+            LOOP_ASSERT(numShards, 30 == X.size());
+
+            for (int i = 0; i < 30; ++i) {
+                bsl::shared_ptr<bsl::string> value;
+                LOOP2_ASSERT(numShards, i, 0 == mX.tryGetValue(&value, i));
+                LOOP2_ASSERT(numShards, i, (i < 10 ? "v1" : "v2") == *value);
+            }
+
+            bsl::vector<int> keys(&ta);
+            for (int i = 25; i < 40; ++i) {
+                keys.push_back(i);
+            }
+            LOOP_ASSERT(numShards, 5 == mX.eraseBulk(keys));
+            LOOP_ASSERT(numShards, 25 == X.size());
+            LOOP_ASSERT(numShards, 0 == mX.eraseBulk(keys));
+        }
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // SINGLE-KEY OPERATIONS
+        //
+        // Concerns:
+        //: 1 Each key is held by exactly one shard, selected consistently.
+        //:
+        //: 2 'insert', 'tryGetValue', and 'erase' forward to the owning shard
+        //:   and return the result of that shard.
+        //:
+        //: 3 Keys are spread among all the shards.
+        //
+        // Plan:
+        //: 1 Insert a range of keys and verify the sum of the shard sizes,
+        //:   that every shard is used, and that look-ups and erasures behave
+        //:   as for a single cache.  (C-1..3)
+        //
+        // Testing:
+        //   void insert(const KEY& key, const VALUE& value);
+        //   void insert(const KEY& key, const ValuePtrType& valuePtr);
+        //   int tryGetValue(value, key, modifyEvictionQueue);
+        //   int erase(const KEY& key);
+        //   bsl::size_t size() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SINGLE-KEY OPERATIONS" << endl
+                          << "=====================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        for (bsl::size_t numShards = 1; numShards <= 16; ++numShards) {
+            Obj mX(numShards, &ta);  const Obj& X = mX;
+
+            const int NUM_ITEMS = 200;
+            for (int i = 0; i < NUM_ITEMS; ++i) {
+                if (i % 2) {
+                    mX.insert(i, bsl::string(1, static_cast<char>('a' + i % 26),
+                                             &ta));
+                }
+                else {
+                    mX.insert(i, bsl::allocate_shared<bsl::string>(
+                                       &ta,
+                                       1,
+                                       static_cast<char>('a' + i % 26)));
+                }
+            }
+            LOOP_ASSERT(numShards, NUM_ITEMS == static_cast<int>(X.size()));
+
+            bsl::size_t total = 0;
+            for (bsl::size_t s = 0; s < numShards; ++s) {
+                LOOP2_ASSERT(numShards, s, 0 < X.shard(s).size());
+                total += X.shard(s).size();
+            }
+            LOOP_ASSERT(numShards, NUM_ITEMS == static_cast<int>(total));
+
+            // Replacing a value does not change the size.
+
+            mX.insert(0, "replaced");
+            LOOP_ASSERT(numShards, NUM_ITEMS == static_cast<int>(X.size()));
+
+            bsl::shared_ptr<bsl::string> value;
+            LOOP_ASSERT(numShards, 0 == mX.tryGetValue(&value, 0));
+            LOOP_ASSERT(numShards, "replaced" == *value);
+
+            for (int i = 1; i < NUM_ITEMS; ++i) {
+                LOOP2_ASSERT(numShards, i,
+                             0 == mX.tryGetValue(&value, i, i % 2));
+                LOOP2_ASSERT(numShards, i,
+                             bsl::string(1, static_cast<char>('a' + i % 26))
+                                                                    == *value);
+            }
+            LOOP_ASSERT(numShards, 1 == mX.tryGetValue(&value, NUM_ITEMS));
+
+            for (int i = 0; i < NUM_ITEMS; i += 3) {
+                LOOP2_ASSERT(numShards, i, 0 == mX.erase(i));
+                LOOP2_ASSERT(numShards, i, 1 == mX.erase(i));
+                LOOP2_ASSERT(numShards, i, 1 == mX.tryGetValue(&value, i));
+            }
+            LOOP_ASSERT(numShards,
+                        NUM_ITEMS - 67 == static_cast<int>(X.size()));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates the requested number of empty shards
+        //:   configured with the requested policy.
+        //:
+        //: 2 The accessors return the values supplied at construction, and
+        //:   the default constructor yields an unbounded LRU cache.
+        //:
+        //: 3 All memory comes from the supplied allocator.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Construct objects with each constructor and verify the
+        //:   accessors.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   explicit ShardedCache(numShards, basicAllocator);
+        //   ShardedCache(numShards, policy, lowWat, highWat, basicAllocator);
+        //   ShardedCache(numShards, policy, lowWat, highWat, hash, eq, alloc);
+        //   EQUAL equalFunction() const;
+        //   CacheEvictionPolicy::Enum evictionPolicy() const;
+        //   HASH hashFunction() const;
+        //   bsl::size_t highWatermark() const;
+        //   bsl::size_t lowWatermark() const;
+        //   bsl::size_t numShards() const;
+        //   const ShardType& shard(bsl::size_t index) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND ACCESSORS" << endl
+                          << "======================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        const bsl::size_t MAX = bsl::numeric_limits<bsl::size_t>::max();
+
+        {
+            Obj mX(3, &ta);  const Obj& X = mX;
+
+            ASSERT(3 == X.numShards());
+            ASSERT(bdlcc::CacheEvictionPolicy::e_LRU == X.evictionPolicy());
+            ASSERT(MAX == X.lowWatermark());
+            ASSERT(MAX == X.highWatermark());
+            ASSERT(0   == X.size());
+            for (bsl::size_t i = 0; i < X.numShards(); ++i) {
+                ASSERT(MAX == X.shard(i).lowWatermark());
+                ASSERT(MAX == X.shard(i).highWatermark());
+                ASSERT(0   == X.shard(i).size());
+            }
+            ASSERT(0 < ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        {
+            Obj mX(5, bdlcc::CacheEvictionPolicy::e_FIFO, 10, 20, &ta);
+            const Obj& X = mX;
+
+            ASSERT(5  == X.numShards());
+            ASSERT(bdlcc::CacheEvictionPolicy::e_FIFO == X.evictionPolicy());
+            ASSERT(10 == X.lowWatermark());
+            ASSERT(20 == X.highWatermark());
+            for (bsl::size_t i = 0; i < X.numShards(); ++i) {
+                ASSERT(bdlcc::CacheEvictionPolicy::e_FIFO ==
+                                                  X.shard(i).evictionPolicy());
+            }
+        }
+        {
+            typedef bdlcc::ShardedCache<int,
+                                        bsl::string,
+                                        ModuloHash,
+                                        bsl::equal_to<int> > HObj;
+
+            HObj mX(2,
+                    bdlcc::CacheEvictionPolicy::e_LRU,
+                    1,
+                    2,
+                    ModuloHash(7),
+                    bsl::equal_to<int>(),
+                    &ta);
+            const HObj& X = mX;
+
+            ASSERT(7 == X.hashFunction().offset());
+            ASSERT(7 == X.shard(0).hashFunction().offset());
+            ASSERT(X.equalFunction()(3, 3));
+            ASSERT(1 == X.lowWatermark());
+            ASSERT(2 == X.highWatermark());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_SAFE_FAIL(Obj(0, &ta));
+            ASSERT_SAFE_PASS(Obj(1, &ta));
+            ASSERT_SAFE_FAIL(Obj(2,
+                                 bdlcc::CacheEvictionPolicy::e_LRU,
+                                 3,
+                                 2,
+                                 &ta));
+            ASSERT_SAFE_FAIL(Obj(2,
+                                 bdlcc::CacheEvictionPolicy::e_LRU,
+                                 0,
+                                 2,
+                                 &ta));
+            ASSERT_SAFE_PASS(Obj(2,
+                                 bdlcc::CacheEvictionPolicy::e_LRU,
+                                 2,
+                                 2,
+                                 &ta));
+            ASSERT_SAFE_FAIL(Obj(2,
+                                 bdlcc::CacheEvictionPolicy::e_LRU,
+                                 2,
+                                 2,
+                                 &ta).shard(2));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Insert, look up, and erase a few items.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        Obj mX(4, &ta);  const Obj& X = mX;
+        ASSERT(0 == X.size());
+
+        mX.insert(1, "one");
+        mX.insert(2, "two");
+        ASSERT(2 == X.size());
+
+        bsl::shared_ptr<bsl::string> value;
+        ASSERT(0 == mX.tryGetValue(&value, 1));
+        ASSERT("one" == *value);
+        ASSERT(1 == mX.tryGetValue(&value, 3));
+
+        ASSERT(0 == mX.erase(2));
+        ASSERT(1 == X.size());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // HIT THROUGHPUT SCALING
+        //   Compare the throughput of successful 'tryGetValue' calls on a
+        //   'bdlcc::Cache' and on 'bdlcc::ShardedCache' objects with various
+        //   shard counts as the number of reader threads grows.  To provide
+        //   control over the test, command line parameters are used.
+        //   2nd parameter: maximum number of threads (default 32).
+        //   3rd parameter: number of reads per thread (default 200000).
+        //   4th parameter: if F, use FIFO for eviction policy; LRU otherwise.
+        //
+        // Concerns:
+        //: 1 With the LRU policy, hit throughput of the sharded cache scales
+        //:   with the number of threads, whereas that of 'bdlcc::Cache' is
+        //:   limited by its single write lock.
+        //
+        // Plan:
+        //: 1 Pre-load each cache with the same keys, then run 1, 2, 4, ...
+        //:   threads doing random look-ups and report look-ups per second.
+        //
+        // Testing:
+        //   HIT THROUGHPUT SCALING
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "HIT THROUGHPUT SCALING" << endl
+                          << "======================" << endl;
+
+        const int maxThreads = argc > 2 ? atoi(argv[2]) : 32;
+        const int numReads   = argc > 3 ? atoi(argv[3]) : 200000;
+
+        const bdlcc::CacheEvictionPolicy::Enum evictionPolicy =
+            (argc > 4 && argv[4][0] == 'F' ?
+            bdlcc::CacheEvictionPolicy::e_FIFO :
+            bdlcc::CacheEvictionPolicy::e_LRU);
+
+        const int k_NUM_KEYS = 100000;
+        const int SHARDS[]   = { 4, 16, 64 };
+        const int NUM_SHARDS = sizeof SHARDS / sizeof *SHARDS;
+
+        bslma::DefaultAllocatorGuard guard(&globalAllocator);
+
+        bdlcc::Cache<int, bsl::string> cache(evictionPolicy,
+                                             2 * k_NUM_KEYS,
+                                             2 * k_NUM_KEYS,
+                                             &globalAllocator);
+        bsl::vector<bsl::shared_ptr<Obj> > sharded(&globalAllocator);
+        for (int i = 0; i < NUM_SHARDS; ++i) {
+            sharded.push_back(bsl::allocate_shared<Obj>(&globalAllocator,
+                                                        SHARDS[i],
+                                                        evictionPolicy,
+                                                        2 * k_NUM_KEYS,
+                                                        2 * k_NUM_KEYS));
+        }
+        for (int k = 0; k < k_NUM_KEYS; ++k) {
+            const bsl::string value("value");
+            cache.insert(k, value);
+            for (int i = 0; i < NUM_SHARDS; ++i) {
+                sharded[i]->insert(k, value);
+            }
+        }
+
+        cout << "threads\tCache";
+        for (int i = 0; i < NUM_SHARDS; ++i) {
+            cout << "\tSharded(" << SHARDS[i] << ")";
+        }
+        cout << "\t(look-ups/sec)" << endl;
+
+        for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+            cout << numThreads << '\t'
+                 << hitThroughput::run(&cache,
+                                       numThreads,
+                                       k_NUM_KEYS,
+                                       numReads);
+            for (int i = 0; i < NUM_SHARDS; ++i) {
+                cout << '\t'
+                     << hitThroughput::run(sharded[i].get(),
+                                           numThreads,
+                                           k_NUM_KEYS,
+                                           numReads);
+            }
+            cout << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (test >= 0) {
+        // CONCERN: In no case does memory come from the default allocator.
+
+        ASSERT(dam.isTotalSame());
+
+        // CONCERN: In no case does memory come from the global allocator.
+
+        ASSERT(gam.isTotalSame());
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------------------------------------------------------
@@ -0,0 +1,777 @@
+// bdlcc_singleproducersingleconsumerboundedqueue.h                  -*-C++-*-
+#ifndef INCLUDED_BDLCC_SINGLEPRODUCERSINGLECONSUMERBOUNDEDQUEUE
+#define INCLUDED_BDLCC_SINGLEPRODUCERSINGLECONSUMERBOUNDEDQUEUE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a lock-free single-producer/single-consumer bounded queue.
+//
+//@CLASSES:
+//  bdlcc::SingleProducerSingleConsumerBoundedQueue: lock-free SPSC queue
+//
+//@SEE_ALSO: bdlcc_fixedqueue, bdlcc_multipleproducersingleconsumerboundedqueue
+//
+//@DESCRIPTION: This component defines a class template,
+// 'bdlcc::SingleProducerSingleConsumerBoundedQueue', providing a lock-free,
+// fixed-capacity, in-order queue of values for exactly one producer thread
+// and one consumer thread.
+//
+// 'bdlcc::FixedQueue' supports any number of producers and consumers, and pays
+// for that generality with an atomic read-modify-write operation (on a cache
+// line shared by all threads) for every push and every pop.  When a pipeline
+// stage is known to have a single producer and a single consumer, neither is
+// necessary: each index is written by only one thread, so a push (or pop) is a
+// plain write of the element followed by a store to the producer's (or
+// consumer's) own index.  The push index and the pop index reside on separate
+// cache lines, together with a cached copy of the other thread's index, so
+// that in the common case neither thread reads a cache line being written by
+// the other thread.
+//
+// The queue provides 'pushBack' and 'popFront' methods for pushing data into
+// the queue and popping it from the queue.  If the queue is full, 'pushBack'
+// blocks until there is space in the queue, and if the queue is empty,
+// 'popFront' blocks until there is an element in the queue.  Non-blocking
+// methods 'tryPushBack' and 'tryPopFront' are also provided, which fail
+// immediately returning a non-zero value in case of overflow or underflow.
+// Before blocking, 'pushBack' and 'popFront' yield the processor a bounded
+// number of times, since the thread on the other side of the queue is likely
+// to make progress shortly.
+//
+// The queue may be placed into a "disabled" state using the 'disable' method.
+// When disabled, 'pushBack' and 'tryPushBack' fail immediately (a blocked
+// invocation of 'pushBack' will also fail immediately).  The queue may be
+// restored to normal operation with the 'enable' method.  These are the same
+// semantics as those of 'bdlcc::FixedQueue'.
+//
+///Thread Safety
+///-------------
+// 'bdlcc::SingleProducerSingleConsumerBoundedQueue' is *thread-safe* provided
+// that at most one thread at a time invokes the producer methods ('pushBack'
+// and 'tryPushBack'), and at most one thread at a time invokes the consumer
+// methods ('popFront', 'tryPopFront', and 'removeAll').  Typically, one thread
+// is dedicated to each role, but a role may move between threads provided the
+// transfer is externally synchronized.  'disable', 'enable', and the accessors
+// may be invoked from any thread.
+//
+///Template Requirements
+///---------------------
+// 'bdlcc::SingleProducerSingleConsumerBoundedQueue' is a template that is
+// parameterized on the type of element contained within the queue.  The
+// supplied template argument, 'TYPE', must provide a copy constructor and an
+// assignment operator.  If 'TYPE' declares the 'bslma::UsesBslmaAllocator'
+// trait, the allocator of the queue is propagated to the elements contained in
+// the queue.
+//
+///Exception Safety
+///----------------
+// All the methods of 'bdlcc::SingleProducerSingleConsumerBoundedQueue' provide
+// the strong exception guarantee: if the copy (or move) constructor of 'TYPE'
+// throws when pushing, or the assignment operator of 'TYPE' throws when
+// popping, the queue is unchanged.
+//
+///Memory Usage
+///------------
+// The elements of the queue are stored in a single array whose length is the
+// capacity of the queue rounded up to the next power of two, so that the
+// position of an element can be computed with a mask rather than a division.
+// The capacity observed by clients is exactly the value supplied at
+// construction.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A Pipeline Stage
+///- - - - - - - - - - - - - -
+// In the following example we use a
+// 'bdlcc::SingleProducerSingleConsumerBoundedQueue' to pass integers from a
+// producer thread to a consumer thread that computes their sum.  The producer
+// signals the end of the sequence with a negative value.
+//
+// First, we define the consumer's thread function:
+//..
+//  void sumValues(
+//         bdlcc::SingleProducerSingleConsumerBoundedQueue<int> *queue,
+//         int                                                  *sum)
+//  {
+//      *sum = 0;
+//      int value;
+//      for (queue->popFront(&value); 0 <= value; queue->popFront(&value)) {
+//          *sum += value;
+//      }
+//  }
+//..
+// Then, we create a queue, and start the consumer thread:
+//..
+//  bdlcc::SingleProducerSingleConsumerBoundedQueue<int> queue(16);
+//
+//  int sum = 0;
+//
+//  bslmt::ThreadGroup consumer;
+//  consumer.addThread(bdlf::BindUtil::bind(&sumValues, &queue, &sum));
+//..
+// Next, the current thread acts as the producer, pushing more values than the
+// capacity of the queue (so that 'pushBack' will block if the consumer falls
+// behind), followed by the terminating value:
+//..
+//  for (int i = 1; i <= 100; ++i) {
+//      queue.pushBack(i);
+//  }
+//  queue.pushBack(-1);
+//..
+// Finally, we join the consumer thread and verify the result:
+//..
+//  consumer.joinAll();
+//  assert(5050 == sum);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_PLATFORM
+#include <bslmt_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_SEMAPHORE
+#include <bslmt_semaphore.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARDESTRUCTIONPRIMITIVES
+#include <bslalg_scalardestructionprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_SCALARPRIMITIVES
+#include <bslalg_scalarprimitives.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_MOVABLEREF
+#include <bslmf_movableref.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlcc {
+
+              // ==============================================
+              // class SingleProducerSingleConsumerBoundedQueue
+              // ==============================================
+
+template <class TYPE>
+class SingleProducerSingleConsumerBoundedQueue {
+    // This class provides a lock-free, fixed-capacity, in-order queue of
+    // values for use by a single producer thread and a single consumer
+    // thread.
+
+    // PRIVATE TYPES
+    typedef bsls::Types::Uint64 Uint64;
+
+    enum {
+        k_INDEX_PADDING = bslmt::Platform::e_CACHE_LINE_SIZE
+                        - sizeof(bsls::AtomicUint64)
+                        - sizeof(Uint64),
+
+        k_MAX_YIELDS    = 64,  // number of times a blocking method yields
+                               // before waiting
+
+        k_DISABLED      = 0,
+        k_ENABLED       = 1
+    };
+
+    // DATA
+    bsls::AtomicUint64  d_pushIndex;           // number of elements ever
+                                               // pushed (written by the
+                                               // producer only)
+
+    Uint64              d_cachedPopIndex;      // producer's most recently
+                                               // loaded value of 'd_popIndex'
+
+    const char          d_pushIndexPad[k_INDEX_PADDING];
+                                               // padding to prevent false
+                                               // sharing
+
+    bsls::AtomicUint64  d_popIndex;            // number of elements ever
+                                               // popped (written by the
+                                               // consumer only)
+
+    Uint64              d_cachedPushIndex;     // consumer's most recently
+                                               // loaded value of 'd_pushIndex'
+
+    const char          d_popIndexPad[k_INDEX_PADDING];
+                                               // padding to prevent false
+                                               // sharing
+
+    TYPE               *d_elements_p;          // array of 'd_mask + 1'
+                                               // elements (empty elements hold
+                                               // uninitialized memory)
+
+    const Uint64        d_mask;                // mask mapping an index to a
+                                               // position in 'd_elements_p'
+
+    const Uint64        d_capacity;            // maximum number of elements
+
+    bsls::AtomicInt     d_state;               // 'k_ENABLED' or 'k_DISABLED'
+
+    bsls::AtomicInt     d_numWaitingPoppers;   // number of threads waiting on
+                                               // 'd_popControlSema'
+
+    bslmt::Semaphore    d_popControlSema;      // semaphore on which a consumer
+                                               // waiting for an element waits
+
+    bsls::AtomicInt     d_numWaitingPushers;   // number of threads waiting on
+                                               // 'd_pushControlSema'
+
+    bslmt::Semaphore    d_pushControlSema;     // semaphore on which a producer
+                                               // waiting for space waits
+
+    bslma::Allocator   *d_allocator_p;         // allocator (held, not owned)
+
+    // NOT IMPLEMENTED
+    SingleProducerSingleConsumerBoundedQueue(
+                              const SingleProducerSingleConsumerBoundedQueue&);
+    SingleProducerSingleConsumerBoundedQueue& operator=(
+                              const SingleProducerSingleConsumerBoundedQueue&);
+
+    // PRIVATE MANIPULATORS
+    int reservePushIndex(Uint64 *index);
+        // Load into the specified 'index' the index at which the next element
+        // may be pushed.  Return 0 on success, a negative value if this queue
+        // is disabled, and a positive value if this queue is full.  The
+        // behavior is undefined unless invoked by the producer.
+
+    void commitPushIndex(Uint64 index);
+        // Publish the element constructed at the specified 'index' to the
+        // consumer, and wake a waiting consumer if there is one.  The behavior
+        // is undefined unless 'index' was loaded by 'reservePushIndex'.
+
+    void commitPopIndex(Uint64 index);
+        // Destroy the element at the specified 'index', release its position
+        // to the producer, and wake a waiting producer if there is one.  The
+        // behavior is undefined unless 'index' is the index of the element at
+        // the front of this queue, and this method is invoked by the consumer.
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(SingleProducerSingleConsumerBoundedQueue,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    SingleProducerSingleConsumerBoundedQueue(
+                                      bsl::size_t       capacity,
+                                      bslma::Allocator *basicAllocator = 0);
+        // Create a queue having the specified 'capacity'.  Optionally specify
+        // a 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '0 < capacity'.
+
+    ~SingleProducerSingleConsumerBoundedQueue();
+        // Destroy this object.
+
+    // MANIPULATORS
+    int pushBack(const TYPE& value);
+        // Append the specified 'value' to the back of this queue, blocking
+        // until either space is available - if necessary - or the queue is
+        // disabled.  Return 0 on success, and a nonzero value if the queue is
+        // disabled.  The behavior is undefined unless invoked by the producer.
+
+    int pushBack(bslmf::MovableRef<TYPE> value);
+        // Append the specified move-insertable 'value' to the back of this
+        // queue, blocking until either space is available - if necessary - or
+        // the queue is disabled.  'value' is left in a valid but unspecified
+        // state.  Return 0 on success, and a nonzero value if the queue is
+        // disabled.  The behavior is undefined unless invoked by the producer.
+
+    int tryPushBack(const TYPE& value);
+        // Attempt to append the specified 'value' to the back of this queue
+        // without blocking.  Return 0 on success, and a non-zero value if the
+        // queue is full or disabled.  The behavior is undefined unless invoked
+        // by the producer.
+
+    int tryPushBack(bslmf::MovableRef<TYPE> value);
+        // Attempt to append the specified move-insertable 'value' to the back
+        // of this queue without blocking.  'value' is left in a valid but
+        // unspecified state.  Return 0 on success, and a non-zero value if the
+        // queue is full or disabled.  The behavior is undefined unless invoked
+        // by the producer.
+
+    void popFront(TYPE *value);
+        // Remove the element from the front of this queue and load that
+        // element into the specified 'value'.  If the queue is empty, block
+        // until it is not empty.  The behavior is undefined unless invoked by
+        // the consumer.
+
+    int tryPopFront(TYPE *value);
+        // Attempt to remove the element from the front of this queue without
+        // blocking, and, if successful, load the specified 'value' with the
+        // removed element.  Return 0 on success, and a non-zero value if the
+        // queue was empty.  On failure, 'value' is not changed.  The behavior
+        // is undefined unless invoked by the consumer.
+
+    void removeAll();
+        // Remove all items from this queue.  The behavior is undefined unless
+        // invoked by the consumer.  Note that if the producer is concurrently
+        // pushing items into the queue, the result of 'numElements' after this
+        // function returns is not guaranteed to be 0.
+
+    void disable();
+        // Disable this queue.  All subsequent invocations of 'pushBack' or
+        // 'tryPushBack' will fail immediately.  A blocked invocation of
+        // 'pushBack' will fail immediately.  If the queue is already disabled,
+        // this method has no effect.
+
+    void enable();
+        // Enable queuing.  If the queue is not disabled, this call has no
+        // effect.
+
+    // ACCESSORS
+    bsl::size_t capacity() const;
+        // Return the maximum number of elements that may be stored in this
+        // queue.
+
+    bool isEmpty() const;
+        // Return 'true' if this queue is empty (has no elements), or 'false'
+        // otherwise.
+
+    bool isEnabled() const;
+        // Return 'true' if this queue is enabled, and 'false' otherwise.  Note
+        // that the queue is created in the "enabled" state.
+
+    bool isFull() const;
+        // Return 'true' if this queue is full (when the number of elements
+        // currently in this queue equals its capacity), or 'false' otherwise.
+
+    bsl::size_t numElements() const;
+        // Return a snapshot of the number of elements currently in this queue.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+              // ----------------------------------------------
+              // class SingleProducerSingleConsumerBoundedQueue
+              // ----------------------------------------------
+
+// PRIVATE MANIPULATORS
+template <class TYPE>
+inline
+int SingleProducerSingleConsumerBoundedQueue<TYPE>::reservePushIndex(
+                                                                Uint64 *index)
+{
+    enum { e_SUCCESS = 0, e_QUEUE_FULL = 1, e_DISABLED_QUEUE = -1 };
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                       k_ENABLED != d_state.loadRelaxed())) {
+        return e_DISABLED_QUEUE;                                      // RETURN
+    }
+
+    const Uint64 pushIndex = d_pushIndex.loadRelaxed();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                             pushIndex - d_cachedPopIndex >= d_capacity)) {
+        // The queue appears full using the cached pop index; reload the pop
+        // index written by the consumer.
+
+        d_cachedPopIndex = d_popIndex.loadAcquire();
+        if (pushIndex - d_cachedPopIndex >= d_capacity) {
+            return e_QUEUE_FULL;                                      // RETURN
+        }
+    }
+
+    *index = pushIndex;
+    return e_SUCCESS;
+}
+
+template <class TYPE>
+inline
+void SingleProducerSingleConsumerBoundedQueue<TYPE>::commitPushIndex(
+                                                                  Uint64 index)
+{
+    // SYNCHRONIZATION POINT 1
+    //
+    // The following store to 'd_pushIndex' is sequentially consistent, which
+    // guarantees that the subsequent load of 'd_numWaitingPoppers' sees a
+    // consumer that incremented it before testing 'isEmpty' at
+    // SYNCHRONIZATION POINT 1-Prime (otherwise that consumer sees this
+    // element and does not wait).
+
+    d_pushIndex = index + 1;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_numWaitingPoppers)) {
+        d_popControlSema.post();
+    }
+}
+
+template <class TYPE>
+inline
+void SingleProducerSingleConsumerBoundedQueue<TYPE>::commitPopIndex(
+                                                                  Uint64 index)
+{
+    bslalg::ScalarDestructionPrimitives::destroy(
+                                          d_elements_p + (index & d_mask));
+
+    // SYNCHRONIZATION POINT 2
+    //
+    // The following store to 'd_popIndex' is sequentially consistent, which
+    // guarantees that the subsequent load of 'd_numWaitingPushers' sees a
+    // producer that incremented it before testing 'isFull' at SYNCHRONIZATION
+    // POINT 2-Prime.
+
+    d_popIndex = index + 1;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_numWaitingPushers)) {
+        d_pushControlSema.post();
+    }
+}
+
+// CREATORS
+template <class TYPE>
+SingleProducerSingleConsumerBoundedQueue<TYPE>::
+                                      SingleProducerSingleConsumerBoundedQueue(
+                                              bsl::size_t       capacity,
+                                              bslma::Allocator *basicAllocator)
+: d_pushIndex(0)
+, d_cachedPopIndex(0)
+, d_pushIndexPad()
+, d_popIndex(0)
+, d_cachedPushIndex(0)
+, d_popIndexPad()
+, d_elements_p(0)
+, d_mask(bdlb::BitUtil::roundUpToBinaryPower(
+                                        static_cast<bsl::uint64_t>(capacity))
+                                                                          - 1)
+, d_capacity(capacity)
+, d_state(k_ENABLED)
+, d_numWaitingPoppers(0)
+, d_popControlSema(0)
+, d_numWaitingPushers(0)
+, d_pushControlSema(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < capacity);
+
+    d_elements_p = static_cast<TYPE *>(d_allocator_p->allocate(
+                        static_cast<bsl::size_t>(d_mask + 1) * sizeof(TYPE)));
+}
+
+template <class TYPE>
+SingleProducerSingleConsumerBoundedQueue<TYPE>::
+                                    ~SingleProducerSingleConsumerBoundedQueue()
+{
+    const Uint64 pushIndex = d_pushIndex.loadRelaxed();
+    for (Uint64 i = d_popIndex.loadRelaxed(); i != pushIndex; ++i) {
+        bslalg::ScalarDestructionPrimitives::destroy(
+                                              d_elements_p + (i & d_mask));
+    }
+    d_allocator_p->deallocate(d_elements_p);
+}
+
+// MANIPULATORS
+template <class TYPE>
+int SingleProducerSingleConsumerBoundedQueue<TYPE>::pushBack(
+                                                             const TYPE& value)
+{
+    int retval;
+    int numYields = 0;
+    while (0 != (retval = tryPushBack(value))) {
+        if (retval < 0) {
+            // The queue is disabled.
+
+            return retval;                                            // RETURN
+        }
+
+        if (numYields < k_MAX_YIELDS) {
+            // Yield a bounded number of times before waiting: the consumer is
+            // likely to make space shortly, whereas waiting costs a pair of
+            // system calls (in this thread and in the consumer).
+
+            ++numYields;
+            bslmt::ThreadUtil::yield();
+            continue;
+        }
+
+        // SYNCHRONIZATION POINT 2-Prime
+        //
+        // 'isFull' loads 'd_popIndex' with sequential consistency after the
+        // (sequentially consistent) increment of 'd_numWaitingPushers'.
+
+        d_numWaitingPushers.add(1);
+        if (isFull() && isEnabled()) {
+            d_pushControlSema.wait();
+        }
+        d_numWaitingPushers.add(-1);
+    }
+    return 0;
+}
+
+template <class TYPE>
+int SingleProducerSingleConsumerBoundedQueue<TYPE>::pushBack(
+                                                 bslmf::MovableRef<TYPE> value)
+{
+    int retval;
+    int numYields = 0;
+    while (0 != (retval = tryPushBack(bslmf::MovableRefUtil::move(value)))) {
+        if (retval < 0) {
+            // The queue is disabled.
+
+            return retval;                                            // RETURN
+        }
+
+        if (numYields < k_MAX_YIELDS) {
+            // See 'pushBack(const TYPE&)'.
+
+            ++numYields;
+            bslmt::ThreadUtil::yield();
+            continue;
+        }
+
+        // SYNCHRONIZATION POINT 2-Prime
+        //
+        // See 'pushBack(const TYPE&)'.
+
+        d_numWaitingPushers.add(1);
+        if (isFull() && isEnabled()) {
+            d_pushControlSema.wait();
+        }
+        d_numWaitingPushers.add(-1);
+    }
+    return 0;
+}
+
+template <class TYPE>
+int SingleProducerSingleConsumerBoundedQueue<TYPE>::tryPushBack(
+                                                             const TYPE& value)
+{
+    Uint64 index;
+
+    int retval = reservePushIndex(&index);
+    if (0 != retval) {
+        return retval;                                                // RETURN
+    }
+
+    // If the copy constructor throws, the element is not published and the
+    // queue is unchanged.
+
+    bslalg::ScalarPrimitives::copyConstruct(d_elements_p + (index & d_mask),
+                                            value,
+                                            d_allocator_p);
+    commitPushIndex(index);
+    return 0;
+}
+
+template <class TYPE>
+int SingleProducerSingleConsumerBoundedQueue<TYPE>::tryPushBack(
+                                                 bslmf::MovableRef<TYPE> value)
+{
+    Uint64 index;
+
+    int retval = reservePushIndex(&index);
+    if (0 != retval) {
+        return retval;                                                // RETURN
+    }
+
+    TYPE& dummy = value;
+    bslalg::ScalarPrimitives::moveConstruct(d_elements_p + (index & d_mask),
+                                            dummy,
+                                            d_allocator_p);
+    commitPushIndex(index);
+    return 0;
+}
+
+template <class TYPE>
+void SingleProducerSingleConsumerBoundedQueue<TYPE>::popFront(TYPE *value)
+{
+    int numYields = 0;
+    while (0 != tryPopFront(value)) {
+        if (numYields < k_MAX_YIELDS) {
+            // As in 'pushBack', except that the producer is likely to push an
+            // element shortly.
+
+            ++numYields;
+            bslmt::ThreadUtil::yield();
+            continue;
+        }
+
+        // SYNCHRONIZATION POINT 1-Prime
+        //
+        // 'isEmpty' loads 'd_pushIndex' with sequential consistency after the
+        // (sequentially consistent) increment of 'd_numWaitingPoppers'.
+
+        d_numWaitingPoppers.add(1);
+        if (isEmpty()) {
+            d_popControlSema.wait();
+        }
+        d_numWaitingPoppers.add(-1);
+    }
+}
+
+template <class TYPE>
+int SingleProducerSingleConsumerBoundedQueue<TYPE>::tryPopFront(TYPE *value)
+{
+    BSLS_ASSERT(value);
+
+    const Uint64 popIndex = d_popIndex.loadRelaxed();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(popIndex == d_cachedPushIndex)) {
+        // The queue appears empty using the cached push index; reload the
+        // push index written by the producer.
+
+        d_cachedPushIndex = d_pushIndex.loadAcquire();
+        if (popIndex == d_cachedPushIndex) {
+            return 1;                                                 // RETURN
+        }
+    }
+
+    // If the assignment throws, the element is not removed and the queue is
+    // unchanged.  See 'bdlcc_fixedqueue' regarding the use of 'move'.
+
+#if defined(BSLMF_MOVABLEREF_USES_RVALUE_REFERENCES)
+    *value = bslmf::MovableRefUtil::move(d_elements_p[popIndex & d_mask]);
+#else
+    *value = d_elements_p[popIndex & d_mask];
+#endif
+
+    commitPopIndex(popIndex);
+    return 0;
+}
+
+template <class TYPE>
+void SingleProducerSingleConsumerBoundedQueue<TYPE>::removeAll()
+{
+    const Uint64 pushIndex = d_pushIndex.loadAcquire();
+
+    for (Uint64 i = d_popIndex.loadRelaxed(); i != pushIndex; ++i) {
+        commitPopIndex(i);
+    }
+}
+
+template <class TYPE>
+void SingleProducerSingleConsumerBoundedQueue<TYPE>::disable()
+{
+    d_state = k_DISABLED;
+
+    const int numWaitingPushers = d_numWaitingPushers;
+    if (numWaitingPushers) {
+        d_pushControlSema.post(numWaitingPushers);
+    }
+}
+
+template <class TYPE>
+inline
+void SingleProducerSingleConsumerBoundedQueue<TYPE>::enable()
+{
+    d_state = k_ENABLED;
+}
+
+// ACCESSORS
+template <class TYPE>
+inline
+bsl::size_t SingleProducerSingleConsumerBoundedQueue<TYPE>::capacity() const
+{
+    return static_cast<bsl::size_t>(d_capacity);
+}
+
+template <class TYPE>
+inline
+bool SingleProducerSingleConsumerBoundedQueue<TYPE>::isEmpty() const
+{
+    return 0 == numElements();
+}
+
+template <class TYPE>
+inline
+bool SingleProducerSingleConsumerBoundedQueue<TYPE>::isEnabled() const
+{
+    return k_ENABLED == d_state;
+}
+
+template <class TYPE>
+inline
+bool SingleProducerSingleConsumerBoundedQueue<TYPE>::isFull() const
+{
+    return capacity() <= numElements();
+}
+
+template <class TYPE>
+inline
+bsl::size_t SingleProducerSingleConsumerBoundedQueue<TYPE>::numElements() const
+{
+    // Load the pop index first: since 'd_popIndex' never exceeds
+    // 'd_pushIndex', the difference is never negative, but it may exceed the
+    // capacity if elements are pushed and popped between the two loads.
+
+    const Uint64 popIndex  = d_popIndex;
+    const Uint64 pushIndex = d_pushIndex;
+
+    const Uint64 length = pushIndex - popIndex;
+    return static_cast<bsl::size_t>(length < d_capacity ? length
+                                                        : d_capacity);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1106 @@
+// bdlcc_singleproducersingleconsumerboundedqueue.t.cpp              -*-C++-*-
+
+#include <bdlcc_singleproducersingleconsumerboundedqueue.h>
+
+#include <bdlcc_fixedqueue.h>
+#include <bdlcc_queue.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+
+#include <bdlf_bind.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test defines a lock-free queue,
+// 'bdlcc::SingleProducerSingleConsumerBoundedQueue', for use by one producer
+// thread and one consumer thread.  We verify the single-threaded behavior of
+// the manipulators and accessors (including the exact capacity for capacities
+// that are not powers of two, and the reuse of the circular buffer), the
+// enable/disable semantics shared with 'bdlcc::FixedQueue', exception
+// safety, and the blocking behavior of 'pushBack' and 'popFront'.  Finally,
+// we verify that a producer and a consumer running concurrently transfer
+// every element, in order.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] explicit SingleProducerSingleConsumerBoundedQueue(capacity, alloc);
+// [ 2] ~SingleProducerSingleConsumerBoundedQueue();
+//
+// MANIPULATORS
+// [ 2] int pushBack(const TYPE& value);
+// [ 3] int pushBack(bslmf::MovableRef<TYPE> value);
+// [ 2] int tryPushBack(const TYPE& value);
+// [ 3] int tryPushBack(bslmf::MovableRef<TYPE> value);
+// [ 2] void popFront(TYPE *value);
+// [ 2] int tryPopFront(TYPE *value);
+// [ 3] void removeAll();
+// [ 4] void disable();
+// [ 4] void enable();
+//
+// ACCESSORS
+// [ 2] bsl::size_t capacity() const;
+// [ 2] bool isEmpty() const;
+// [ 4] bool isEnabled() const;
+// [ 2] bool isFull() const;
+// [ 2] bsl::size_t numElements() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] EXCEPTION SAFETY
+// [ 6] BLOCKING
+// [ 7] CONCURRENT PRODUCER AND CONSUMER
+// [ 8] USAGE EXAMPLE
+// [-1] THROUGHPUT BENCHMARK
+// [-2] LATENCY BENCHMARK
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool             verbose;
+bool         veryVerbose;
+bool     veryVeryVerbose;
+bool veryVeryVeryVerbose;
+
+typedef bdlcc::SingleProducerSingleConsumerBoundedQueue<int> Obj;
+
+// ============================================================================
+//                      HELPER CLASSES AND FUNCTIONS
+// ----------------------------------------------------------------------------
+
+class ThrowingType {
+    // This class holds an 'int' value and throws from its copy constructor or
+    // its assignment operator when the corresponding class-wide flag is set.
+
+    int d_value;
+
+  public:
+    // CLASS DATA
+    static bool s_throwOnCopy;
+    static bool s_throwOnAssign;
+
+    // CREATORS
+    explicit ThrowingType(int value = 0)
+    : d_value(value)
+    {
+    }
+
+    ThrowingType(const ThrowingType& original)
+    : d_value(original.d_value)
+    {
+        if (s_throwOnCopy) {
+            throw 1;
+        }
+    }
+
+    // MANIPULATORS
+    ThrowingType& operator=(const ThrowingType& rhs)
+    {
+        if (s_throwOnAssign) {
+            throw 2;
+        }
+        d_value = rhs.d_value;
+        return *this;
+    }
+
+    // ACCESSORS
+    int value() const
+    {
+        return d_value;
+    }
+};
+
+bool ThrowingType::s_throwOnCopy   = false;
+bool ThrowingType::s_throwOnAssign = false;
+
+void pushAndStoreResult(Obj *queue, int value, bsls::AtomicInt *result)
+    // Push the specified 'value' into the specified 'queue', blocking if
+    // necessary, and load the result of 'pushBack' into the specified
+    // 'result'.
+{
+    *result = queue->pushBack(value);
+}
+
+void popAndStoreValue(Obj *queue, bsls::AtomicInt *value)
+    // Pop an element from the specified 'queue', blocking if necessary, and
+    // load it into the specified 'value'.
+{
+    int item;
+    queue->popFront(&item);
+    *value = item;
+}
+
+                          // ======================
+                          // namespace concurrentSP
+                          // ======================
+
+namespace concurrentSP {
+
+void producer(Obj *queue, int numItems, int useTry)
+    // Push the values '[0 .. numItems)' into the specified 'queue', using
+    // 'tryPushBack' (retrying on failure) if the specified 'useTry' is
+    // non-zero, and 'pushBack' otherwise.
+{
+    for (int i = 0; i < numItems; ++i) {
+        if (useTry) {
+            while (0 != queue->tryPushBack(i)) {
+                bslmt::ThreadUtil::yield();
+            }
+        }
+        else {
+            ASSERT(0 == queue->pushBack(i));
+        }
+    }
+}
+
+void consumer(Obj *queue, int numItems, int useTry)
+    // Pop the specified 'numItems' values from the specified 'queue', using
+    // 'tryPopFront' (retrying on failure) if the specified 'useTry' is
+    // non-zero, and 'popFront' otherwise, and verify that they are the values
+    // '[0 .. numItems)' in order.
+{
+    int numErrors = 0;
+    for (int i = 0; i < numItems; ++i) {
+        int value = -1;
+        if (useTry) {
+            while (0 != queue->tryPopFront(&value)) {
+                bslmt::ThreadUtil::yield();
+            }
+        }
+        else {
+            queue->popFront(&value);
+        }
+        if (value != i && numErrors++ < 10) {
+            ASSERTV(i, value, i == value);
+        }
+    }
+}
+
+}  // close namespace concurrentSP
+
+                          // ====================
+                          // namespace benchmarks
+                          // ====================
+
+namespace benchmarks {
+
+template <class QUEUE>
+void pushValues(QUEUE *queue, bslmt::Barrier *barrier, int numItems)
+    // Wait on the specified 'barrier', then push the values
+    // '[1 .. numItems]' into the specified 'queue'.
+{
+    barrier->wait();
+    for (int i = 1; i <= numItems; ++i) {
+        queue->pushBack(i);
+    }
+}
+
+template <class QUEUE>
+double throughput(QUEUE *queue, int numItems, bslma::Allocator *allocator)
+    // Transfer the specified 'numItems' values through the specified 'queue'
+    // from a producer thread to the calling thread, using the specified
+    // 'allocator' to supply memory, and return the number of values
+    // transferred per second.
+{
+    bslmt::Barrier     barrier(2);
+    bslmt::ThreadGroup threads(allocator);
+
+    threads.addThread(bdlf::BindUtil::bindS(allocator,
+                                            &pushValues<QUEUE>,
+                                            queue,
+                                            &barrier,
+                                            numItems));
+
+    bsls::Types::Int64 sum = 0;
+    bsls::Stopwatch    timer;
+
+    barrier.wait();
+    timer.start();
+    for (int i = 0; i < numItems; ++i) {
+        int value;
+        queue->popFront(&value);
+        sum += value;
+    }
+    timer.stop();
+    threads.joinAll();
+
+    ASSERT(static_cast<bsls::Types::Int64>(numItems) * (numItems + 1) / 2
+                                                                       == sum);
+
+    return numItems / timer.elapsedTime();
+}
+
+template <class QUEUE>
+void echo(QUEUE *requests, QUEUE *responses, int numRoundTrips)
+    // Pop the specified 'numRoundTrips' values from the specified 'requests'
+    // queue, pushing each into the specified 'responses' queue.
+{
+    for (int i = 0; i < numRoundTrips; ++i) {
+        int value;
+        requests->popFront(&value);
+        responses->pushBack(value);
+    }
+}
+
+template <class QUEUE>
+double latency(QUEUE            *requests,
+               QUEUE            *responses,
+               int               numRoundTrips,
+               bslma::Allocator *allocator)
+    // Perform the specified 'numRoundTrips' round trips of a value through the
+    // specified 'requests' queue to an echoing thread and back through the
+    // specified 'responses' queue, using the specified 'allocator' to supply
+    // memory, and return the mean round-trip time in microseconds.
+{
+    bslmt::ThreadGroup threads(allocator);
+
+    threads.addThread(bdlf::BindUtil::bindS(allocator,
+                                            &echo<QUEUE>,
+                                            requests,
+                                            responses,
+                                            numRoundTrips));
+
+    bsls::Stopwatch timer;
+    timer.start();
+    for (int i = 0; i < numRoundTrips; ++i) {
+        int value;
+        requests->pushBack(i);
+        responses->popFront(&value);
+        ASSERT(i == value);
+    }
+    timer.stop();
+    threads.joinAll();
+
+    return timer.elapsedTime() * 1e6 / numRoundTrips;
+}
+
+}  // close namespace benchmarks
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usageExample1 {
+
+///Example 1: A Pipeline Stage
+///- - - - - - - - - - - - - -
+// In the following example we use a
+// 'bdlcc::SingleProducerSingleConsumerBoundedQueue' to pass integers from a
+// producer thread to a consumer thread that computes their sum.  The producer
+// signals the end of the sequence with a negative value.
+//
+// First, we define the consumer's thread function:
+//..
+    void sumValues(
+           bdlcc::SingleProducerSingleConsumerBoundedQueue<int> *queue,
+           int                                                  *sum)
+    {
+        *sum = 0;
+        int value;
+        for (queue->popFront(&value); 0 <= value; queue->popFront(&value)) {
+            *sum += value;
+        }
+    }
+//..
+
+void example1()
+{
+    bslma::TestAllocator         talloc("ue1", veryVeryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&talloc);
+
+// Then, we create a queue, and start the consumer thread:
+//..
+    bdlcc::SingleProducerSingleConsumerBoundedQueue<int> queue(16);
+
+    int sum = 0;
+
+    bslmt::ThreadGroup consumer;
+    consumer.addThread(bdlf::BindUtil::bind(&sumValues, &queue, &sum));
+//..
+// Next, the current thread acts as the producer, pushing more values than the
+// capacity of the queue (so that 'pushBack' will block if the consumer falls
+// behind), followed by the terminating value:
+//..
+    for (int i = 1; i <= 100; ++i) {
+        queue.pushBack(i);
+    }
+    queue.pushBack(-1);
+//..
+// Finally, we join the consumer thread and verify the result:
+//..
+    consumer.joinAll();
+    ASSERT(5050 == sum);
+//..
+}
+
+}  // close namespace usageExample1
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the default allocator.
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVeryVerbose);
+    bslma::Default::setDefaultAllocator(&defaultAllocator);
+    bslma::TestAllocatorMonitor dam(&defaultAllocator);
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+    bslma::TestAllocatorMonitor gam(&globalAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        usageExample1::example1();
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENT PRODUCER AND CONSUMER
+        //
+        // Concerns:
+        //: 1 Every element pushed by the producer is popped by the consumer
+        //:   exactly once, and in the order pushed, for both the blocking and
+        //:   the non-blocking methods.
+        //:
+        //: 2 The queue is empty once all the elements have been popped.
+        //
+        // Plan:
+        //: 1 For small capacities (so that both the "full" and "empty"
+        //:   conditions occur frequently), run a producer thread pushing an
+        //:   increasing sequence and a consumer thread verifying it.  (C-1..2)
+        //
+        // Testing:
+        //   CONCURRENT PRODUCER AND CONSUMER
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT PRODUCER AND CONSUMER" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        const int CAPACITIES[]   = { 1, 2, 3, 7, 64 };
+        const int NUM_CAPACITIES = sizeof CAPACITIES / sizeof *CAPACITIES;
+        const int NUM_ITEMS      = 100000;
+
+        for (int ti = 0; ti < NUM_CAPACITIES; ++ti) {
+            for (int useTry = 0; useTry < 2; ++useTry) {
+                if (veryVerbose) { P_(CAPACITIES[ti]) P(useTry) }
+
+                Obj                mX(CAPACITIES[ti], &ta);
+                bslmt::ThreadGroup threads(&ta);
+
+                threads.addThread(bdlf::BindUtil::bindS(
+                                                      &ta,
+                                                      &concurrentSP::producer,
+                                                      &mX,
+                                                      NUM_ITEMS,
+                                                      useTry));
+                threads.addThread(bdlf::BindUtil::bindS(
+                                                      &ta,
+                                                      &concurrentSP::consumer,
+                                                      &mX,
+                                                      NUM_ITEMS,
+                                                      useTry));
+                threads.joinAll();
+
+                ASSERTV(CAPACITIES[ti], useTry, mX.isEmpty());
+            }
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // BLOCKING
+        //
+        // Concerns:
+        //: 1 'popFront' on an empty queue blocks until an element is pushed.
+        //:
+        //: 2 'pushBack' on a full queue blocks until an element is popped.
+        //
+        // Plan:
+        //: 1 Start a thread invoking 'popFront' on an empty queue, verify that
+        //:   it has not returned after a short delay, then push an element and
+        //:   verify that the thread pops it.  (C-1)
+        //:
+        //: 2 Fill a queue, start a thread invoking 'pushBack', verify that it
+        //:   has not returned after a short delay, then pop an element and
+        //:   verify that the push completes.  (C-2)
+        //
+        // Testing:
+        //   BLOCKING
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BLOCKING" << endl
+                          << "========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        if (verbose) cout << "\t'popFront' on an empty queue." << endl;
+        {
+            Obj                mX(4, &ta);
+            bsls::AtomicInt    value(-1);
+            bslmt::ThreadGroup threads(&ta);
+
+            threads.addThread(bdlf::BindUtil::bindS(&ta,
+                                                    &popAndStoreValue,
+                                                    &mX,
+                                                    &value));
+
+            bslmt::ThreadUtil::microSleep(100 * 1000);
+            ASSERTV(value, -1 == value);
+
+            ASSERT(0 == mX.pushBack(42));
+            threads.joinAll();
+
+            ASSERTV(value, 42 == value);
+            ASSERT(mX.isEmpty());
+        }
+
+        if (verbose) cout << "\t'pushBack' on a full queue." << endl;
+        {
+            Obj                mX(3, &ta);
+            bsls::AtomicInt    result(-1);
+            bslmt::ThreadGroup threads(&ta);
+
+            for (int i = 0; i < 3; ++i) {
+                ASSERT(0 == mX.pushBack(i));
+            }
+            ASSERT(mX.isFull());
+
+            threads.addThread(bdlf::BindUtil::bindS(&ta,
+                                                    &pushAndStoreResult,
+                                                    &mX,
+                                                    3,
+                                                    &result));
+
+            bslmt::ThreadUtil::microSleep(100 * 1000);
+            ASSERTV(result, -1 == result);
+            ASSERT(3 == mX.numElements());
+
+            int value;
+            mX.popFront(&value);
+            ASSERT(0 == value);
+
+            threads.joinAll();
+            ASSERTV(result, 0 == result);
+
+            for (int i = 1; i <= 3; ++i) {
+                mX.popFront(&value);
+                ASSERTV(i, value, i == value);
+            }
+            ASSERT(mX.isEmpty());
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // EXCEPTION SAFETY
+        //
+        // Concerns:
+        //: 1 If the copy constructor of the element type throws during a push,
+        //:   the queue is unchanged.
+        //:
+        //: 2 If the assignment operator of the element type throws during a
+        //:   pop, the queue is unchanged.
+        //
+        // Plan:
+        //: 1 Using a type whose copy constructor and assignment operator throw
+        //:   on demand, attempt pushes and pops that throw, and verify the
+        //:   state of the queue afterwards.  (C-1..2)
+        //
+        // Testing:
+        //   EXCEPTION SAFETY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "EXCEPTION SAFETY" << endl
+                          << "================" << endl;
+
+#ifdef BDE_BUILD_TARGET_EXC
+        typedef bdlcc::SingleProducerSingleConsumerBoundedQueue<ThrowingType>
+                                                                       TObj;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        TObj mX(2, &ta);  const TObj& X = mX;
+
+        ASSERT(0 == mX.pushBack(ThrowingType(1)));
+
+        ThrowingType::s_throwOnCopy = true;
+        try {
+            mX.pushBack(ThrowingType(2));
+            ASSERT(!"exception not thrown");
+        }
+        catch (int e) {
+            ASSERTV(e, 1 == e);
+        }
+        ThrowingType::s_throwOnCopy = false;
+        ASSERT(1 == X.numElements());
+
+        ASSERT(0 == mX.pushBack(ThrowingType(3)));
+        ASSERT(X.isFull());
+
+        ThrowingType value;
+
+        ThrowingType::s_throwOnAssign = true;
+        try {
+            mX.popFront(&value);
+            ASSERT(!"exception not thrown");
+        }
+        catch (int e) {
+            ASSERTV(e, 2 == e);
+        }
+        ThrowingType::s_throwOnAssign = false;
+        ASSERT(2 == X.numElements());
+
+        mX.popFront(&value);
+        ASSERTV(value.value(), 1 == value.value());
+        mX.popFront(&value);
+        ASSERTV(value.value(), 3 == value.value());
+        ASSERT(X.isEmpty());
+#else
+        if (verbose) cout << "\tSkipped: exceptions are disabled." << endl;
+#endif
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // DISABLE AND ENABLE
+        //
+        // Concerns:
+        //: 1 The queue is created enabled.
+        //:
+        //: 2 Pushing into a disabled queue fails immediately, with a negative
+        //:   value returned by 'tryPushBack', whether or not the queue is
+        //:   full.
+        //:
+        //: 3 Popping from a disabled queue succeeds until the queue is empty.
+        //:
+        //: 4 Disabling the queue releases a producer blocked in 'pushBack',
+        //:   which then fails.
+        //:
+        //: 5 'enable' restores normal operation.
+        //
+        // Plan:
+        //: 1 Exercise the methods in the states described above.  (C-1..5)
+        //
+        // Testing:
+        //   void disable();
+        //   void enable();
+        //   bool isEnabled() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DISABLE AND ENABLE" << endl
+                          << "==================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        Obj mX(2, &ta);  const Obj& X = mX;
+
+        ASSERT(true == X.isEnabled());
+
+        ASSERT(0 == mX.pushBack(1));
+
+        mX.disable();
+        ASSERT(false == X.isEnabled());
+
+        ASSERT(0 != mX.pushBack(2));
+        ASSERT(0 >  mX.tryPushBack(2));
+        ASSERT(1 == X.numElements());
+
+        int value;
+        ASSERT(0 == mX.tryPopFront(&value));
+        ASSERT(1 == value);
+        ASSERT(0 != mX.tryPopFront(&value));
+
+        mX.disable();
+        ASSERT(false == X.isEnabled());
+
+        mX.enable();
+        ASSERT(true == X.isEnabled());
+        ASSERT(0 == mX.tryPushBack(3));
+        ASSERT(0 == mX.pushBack(4));
+        ASSERT(0 <  mX.tryPushBack(5));
+
+        mX.disable();
+        ASSERT(0 >  mX.tryPushBack(5));
+
+        mX.enable();
+
+        if (verbose) cout << "\tDisabling releases a blocked producer."
+                          << endl;
+        {
+            bsls::AtomicInt    result(0);
+            bslmt::ThreadGroup threads(&ta);
+
+            threads.addThread(bdlf::BindUtil::bindS(&ta,
+                                                    &pushAndStoreResult,
+                                                    &mX,
+                                                    5,
+                                                    &result));
+
+            bslmt::ThreadUtil::microSleep(100 * 1000);
+            ASSERTV(result, 0 == result);
+
+            mX.disable();
+            threads.joinAll();
+
+            ASSERTV(result, 0 != result);
+            ASSERT(2 == X.numElements());
+        }
+
+        mX.removeAll();
+        ASSERT(X.isEmpty());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // MOVE, ALLOCATOR PROPAGATION, AND 'removeAll'
+        //
+        // Concerns:
+        //: 1 Elements are constructed using the allocator of the queue.
+        //:
+        //: 2 The move overloads of 'pushBack' and 'tryPushBack' insert the
+        //:   value.
+        //:
+        //: 3 'removeAll' destroys every element, and the queue remains usable.
+        //:
+        //: 4 The destructor destroys the elements remaining in the queue.
+        //
+        // Plan:
+        //: 1 Using 'bsl::string' elements too long for the short-string
+        //:   optimization, verify the memory in use from the queue's
+        //:   allocator, and that no memory is leaked.  (C-1..4)
+        //
+        // Testing:
+        //   int pushBack(bslmf::MovableRef<TYPE> value);
+        //   int tryPushBack(bslmf::MovableRef<TYPE> value);
+        //   void removeAll();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MOVE, ALLOCATOR PROPAGATION, AND 'removeAll'"
+                          << endl
+                          << "============================================"
+                          << endl;
+
+        typedef bdlcc::SingleProducerSingleConsumerBoundedQueue<bsl::string>
+                                                                       SObj;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        bslma::TestAllocator sa("string", veryVeryVeryVerbose);
+
+        const char *LONG = "a string too long for the short-string buffer";
+
+        {
+            SObj mX(5, &ta);  const SObj& X = mX;
+
+            const bsls::Types::Int64 numBlocks = ta.numBlocksInUse();
+
+            bsl::string s1(LONG, &sa);
+            bsl::string s2(LONG, &sa);
+            bsl::string s3(LONG, &sa);
+
+            ASSERT(0 == mX.pushBack(s1));
+            ASSERT(0 == mX.pushBack(bslmf::MovableRefUtil::move(s2)));
+            ASSERT(0 == mX.tryPushBack(bslmf::MovableRefUtil::move(s3)));
+            ASSERT(3 == X.numElements());
+
+            ASSERTV(ta.numBlocksInUse(), numBlocks + 3 == ta.numBlocksInUse());
+
+            bsl::string result(&sa);
+            mX.popFront(&result);
+            ASSERT(LONG == result);
+            ASSERTV(ta.numBlocksInUse(), numBlocks + 2 == ta.numBlocksInUse());
+
+            mX.removeAll();
+            ASSERT(X.isEmpty());
+            ASSERTV(ta.numBlocksInUse(), numBlocks == ta.numBlocksInUse());
+
+            for (int i = 0; i < 12; ++i) {
+                ASSERT(0 == mX.tryPushBack(s1));
+                if (i % 3) {
+                    ASSERT(0 == mX.tryPopFront(&result));
+                    ASSERT(LONG == result);
+                }
+            }
+            ASSERT(4 == X.numElements());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PUSH, POP, AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 The capacity of the queue is exactly that supplied at
+        //:   construction, including capacities that are not powers of two.
+        //:
+        //: 2 Elements are popped in the order pushed.
+        //:
+        //: 3 'tryPushBack' fails with a positive value when the queue is full,
+        //:   and 'tryPopFront' fails, leaving its argument unchanged, when the
+        //:   queue is empty.
+        //:
+        //: 4 The accessors reflect the number of elements in the queue.
+        //:
+        //: 5 The circular buffer is reused correctly over many cycles.
+        //
+        // Plan:
+        //: 1 For a range of capacities, fill and drain the queue a number of
+        //:   times, interleaving pushes and pops by a varying amount, and
+        //:   verify the values popped and the accessors at every step.
+        //:   (C-1..5)
+        //
+        // Testing:
+        //   SingleProducerSingleConsumerBoundedQueue(capacity, alloc);
+        //   ~SingleProducerSingleConsumerBoundedQueue();
+        //   int pushBack(const TYPE& value);
+        //   int tryPushBack(const TYPE& value);
+        //   void popFront(TYPE *value);
+        //   int tryPopFront(TYPE *value);
+        //   bsl::size_t capacity() const;
+        //   bool isEmpty() const;
+        //   bool isFull() const;
+        //   bsl::size_t numElements() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PUSH, POP, AND ACCESSORS" << endl
+                          << "========================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        const int CAPACITIES[]   = { 1, 2, 3, 4, 5, 7, 8, 9, 31, 100 };
+        const int NUM_CAPACITIES = sizeof CAPACITIES / sizeof *CAPACITIES;
+
+        for (int ti = 0; ti < NUM_CAPACITIES; ++ti) {
+            const int CAPACITY = CAPACITIES[ti];
+
+            if (veryVerbose) { P(CAPACITY) }
+
+            Obj mX(CAPACITY, &ta);  const Obj& X = mX;
+
+            ASSERTV(CAPACITY, CAPACITY == static_cast<int>(X.capacity()));
+            ASSERTV(CAPACITY, X.isEmpty());
+            ASSERTV(CAPACITY, !X.isFull());
+            ASSERTV(CAPACITY, 0 == X.numElements());
+
+            int pushed = 0;
+            int popped = 0;
+
+            for (int round = 0; round < 4 * CAPACITY + 4; ++round) {
+                // Fill the queue.
+
+                while (pushed - popped < CAPACITY) {
+                    ASSERTV(CAPACITY, pushed,
+                            0 == (round % 2 ? mX.tryPushBack(pushed)
+                                            : mX.pushBack(pushed)));
+                    ++pushed;
+                    ASSERTV(CAPACITY, pushed - popped ==
+                                            static_cast<int>(X.numElements()));
+                }
+                ASSERTV(CAPACITY, X.isFull());
+                ASSERTV(CAPACITY, 0 < mX.tryPushBack(-1));
+                ASSERTV(CAPACITY, CAPACITY ==
+                                            static_cast<int>(X.numElements()));
+
+                // Pop a number of elements depending on the round.
+
+                const int numToPop = round % 2 ? CAPACITY
+                                               : 1 + round % CAPACITY;
+                for (int i = 0; i < numToPop; ++i) {
+                    int value = -1;
+                    if (round % 3) {
+                        ASSERTV(CAPACITY, 0 == mX.tryPopFront(&value));
+                    }
+                    else {
+                        mX.popFront(&value);
+                    }
+                    ASSERTV(CAPACITY, popped, value, popped == value);
+                    ++popped;
+                    ASSERTV(CAPACITY, !X.isFull());
+                }
+                ASSERTV(CAPACITY, pushed - popped ==
+                                            static_cast<int>(X.numElements()));
+            }
+
+            while (popped < pushed) {
+                int value = -1;
+                ASSERTV(CAPACITY, 0 == mX.tryPopFront(&value));
+                ASSERTV(CAPACITY, popped, value, popped == value);
+                ++popped;
+            }
+
+            ASSERTV(CAPACITY, X.isEmpty());
+
+            int value = -7;
+            ASSERTV(CAPACITY, 0 != mX.tryPopFront(&value));
+            ASSERTV(CAPACITY, -7 == value);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Push and pop a few values.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        Obj mX(3, &ta);  const Obj& X = mX;
+
+        ASSERT(3 == X.capacity());
+        ASSERT(X.isEmpty());
+
+        ASSERT(0 == mX.pushBack(1));
+        ASSERT(0 == mX.tryPushBack(2));
+        ASSERT(0 == mX.pushBack(3));
+        ASSERT(X.isFull());
+        ASSERT(0 != mX.tryPushBack(4));
+
+        int value;
+        mX.popFront(&value);
+        ASSERT(1 == value);
+        ASSERT(0 == mX.tryPopFront(&value));
+        ASSERT(2 == value);
+        ASSERT(1 == X.numElements());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // THROUGHPUT BENCHMARK
+        //   Compare the throughput of a single producer and a single consumer
+        //   using this queue, 'bdlcc::FixedQueue', and 'bdlcc::Queue'.
+        //
+        // Plan:
+        //: 1 For each queue, and for a range of capacities, transfer a number
+        //:   of integers (optionally specified by the second argument) from a
+        //:   producer thread to a consumer thread, and report the number of
+        //:   integers transferred per second.
+        //
+        // Testing:
+        //   THROUGHPUT BENCHMARK
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "THROUGHPUT BENCHMARK" << endl
+             << "====================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        const int numItems = argc > 2 ? atoi(argv[2]) : 1000000;
+
+        const int CAPACITIES[]   = { 16, 256, 4096 };
+        const int NUM_CAPACITIES = sizeof CAPACITIES / sizeof *CAPACITIES;
+
+        cout << "capacity\tSPSC\tFixedQueue\tQueue\t(items/sec)" << endl;
+
+        for (int ti = 0; ti < NUM_CAPACITIES; ++ti) {
+            const int CAPACITY = CAPACITIES[ti];
+
+            Obj                    spsc(CAPACITY, &ta);
+            bdlcc::FixedQueue<int> fixed(CAPACITY, &ta);
+            bdlcc::Queue<int>      queue(CAPACITY, &ta);
+
+            cout << CAPACITY
+                 << '\t' << benchmarks::throughput(&spsc,  numItems, &ta)
+                 << '\t' << benchmarks::throughput(&fixed, numItems, &ta)
+                 << '\t' << benchmarks::throughput(&queue, numItems, &ta)
+                 << endl;
+        }
+      } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // LATENCY BENCHMARK
+        //   Compare the round-trip latency of a value passed between two
+        //   threads over a pair of queues, using this queue,
+        //   'bdlcc::FixedQueue', and 'bdlcc::Queue'.
+        //
+        // Plan:
+        //: 1 For each queue, perform a number of round trips (optionally
+        //:   specified by the second argument) between the main thread and an
+        //:   echoing thread, and report the mean round-trip time.
+        //
+        // Testing:
+        //   LATENCY BENCHMARK
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "LATENCY BENCHMARK" << endl
+             << "=================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        const int numRoundTrips = argc > 2 ? atoi(argv[2]) : 100000;
+
+        Obj                    spscRequests(16, &ta);
+        Obj                    spscResponses(16, &ta);
+        bdlcc::FixedQueue<int> fixedRequests(16, &ta);
+        bdlcc::FixedQueue<int> fixedResponses(16, &ta);
+        bdlcc::Queue<int>      queueRequests(16, &ta);
+        bdlcc::Queue<int>      queueResponses(16, &ta);
+
+        cout << "SPSC\tFixedQueue\tQueue\t(usec/round trip)" << endl
+             << benchmarks::latency(&spscRequests,
+                                    &spscResponses,
+                                    numRoundTrips,
+                                    &ta)
+             << '\t'
+             << benchmarks::latency(&fixedRequests,
+                                    &fixedResponses,
+                                    numRoundTrips,
+                                    &ta)
+             << '\t'
+             << benchmarks::latency(&queueRequests,
+                                    &queueResponses,
+                                    numRoundTrips,
+                                    &ta)
+             << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (test >= 0) {
+        // CONCERN: In no case does memory come from the default allocator.
+
+        ASSERT(dam.isTotalSame());
+
+        // CONCERN: In no case does memory come from the global allocator.
+
+        ASSERT(gam.isTotalSame());
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
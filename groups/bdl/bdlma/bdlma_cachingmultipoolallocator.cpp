@@ -0,0 +1,606 @@
+// bdlma_cachingmultipoolallocator.cpp                                -*-C++-*-
+#include <bdlma_cachingmultipoolallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_cachingmultipoolallocator_cpp,"$Id$ $CSID$")
+
+#include <bdlma_infrequentdeleteblocklist.h>
+
+#include <bslma_default.h>
+#include <bslmt_lockguard.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_new.h>
+
+// IMPLEMENTATION NOTES: Each block supplied by this allocator is preceded by a
+// 'CachingMultipoolAllocator_Header' recording the size class of the block,
+// or -1 if the block was allocated from 'd_largeBlocks'.  While a pooled block
+// is free, its first bytes (header included) are instead used as a
+// 'CachingMultipoolAllocator_Block' to link it in a magazine.  The first block
+// of a magazine stored in the depot of a size class additionally records the
+// number of blocks in the magazine, and links to the next magazine of the
+// depot.
+//
+// The cache of a thread holds, for each size class, a *loaded* magazine (from
+// which blocks are allocated and to which blocks are deallocated) and a
+// *previous* magazine that is either empty or full, following the same scheme
+// as 'btlb::CachingBlobBufferFactory': when the loaded magazine is empty upon
+// allocation, it is exchanged with the previous magazine if that one is full,
+// and is refilled from the depot otherwise; when the loaded magazine is full
+// upon deallocation, the previous magazine (if full) is returned to the
+// depot, and the loaded magazine becomes the previous one.  A thread
+// alternating between allocating and deallocating a block therefore never
+// accesses the depot, and a thread accesses the depot at most once every
+// 'magazineCapacity' operations otherwise.
+//
+// If no thread-specific storage key could be created, there is no thread
+// cache: each block is popped from, or pushed onto, the first magazine of the
+// depot, under the lock of the depot, so that the magazines of the depot hold
+// at most 'magazineCapacity' blocks as usual.
+
+namespace BloombergLP {
+namespace bdlma {
+
+                    // ======================================
+                    // union CachingMultipoolAllocator_Header
+                    // ======================================
+
+union CachingMultipoolAllocator_Header {
+    // This 'union' precedes each block supplied by the allocator.
+
+    // DATA
+    int                                 d_sizeClass;  // size class of the
+                                                      // block, or -1
+
+    bsls::AlignmentUtil::MaxAlignedType d_dummy;      // force alignment
+};
+
+                    // =====================================
+                    // struct CachingMultipoolAllocator_Block
+                    // =====================================
+
+struct CachingMultipoolAllocator_Block {
+    // This 'struct' overlays a free block, header included.
+
+    // DATA
+    CachingMultipoolAllocator_Block *d_next_p;          // next free block of
+                                                        // the magazine
+
+    CachingMultipoolAllocator_Block *d_nextMagazine_p;  // first block of the
+                                                        // next magazine of
+                                                        // the depot
+
+    int                              d_numBlocks;       // number of blocks in
+                                                        // the magazine
+};
+
+                   // ========================================
+                   // struct CachingMultipoolAllocator_Magazine
+                   // ========================================
+
+struct CachingMultipoolAllocator_Magazine {
+    // This 'struct' holds a list of free blocks of a size class in the cache
+    // of a thread.
+
+    // DATA
+    CachingMultipoolAllocator_Block *d_head_p;     // first free block
+    int                              d_numBlocks;  // number of free blocks
+};
+
+                  // =========================================
+                  // struct CachingMultipoolAllocator_SizeClass
+                  // =========================================
+
+struct CachingMultipoolAllocator_SizeClass {
+    // This 'struct' holds the depot of a size class.
+
+    // DATA
+    bslmt::Mutex                     d_mutex;        // protects the following
+
+    CachingMultipoolAllocator_Block *d_magazines_p;  // list of magazines in
+                                                     // the depot
+
+    InfrequentDeleteBlockList        d_slabs;        // memory from which new
+                                                     // blocks are carved
+
+    bsl::size_t                      d_blockSize;    // size of the blocks,
+                                                     // header included
+
+    // CREATORS
+    CachingMultipoolAllocator_SizeClass(bsl::size_t       blockSize,
+                                        bslma::Allocator *basicAllocator)
+    : d_magazines_p(0)
+    , d_slabs(basicAllocator)
+    , d_blockSize(blockSize)
+    {
+    }
+};
+
+                 // ===========================================
+                 // struct CachingMultipoolAllocator_ThreadCache
+                 // ===========================================
+
+struct CachingMultipoolAllocator_ThreadCache {
+    // This 'struct' holds the free blocks cached by a thread, and is followed
+    // in memory by the 'd_loaded_p' and 'd_previous_p' arrays.
+
+    // DATA
+    CachingMultipoolAllocator             *d_allocator_p;  // owning allocator
+
+    CachingMultipoolAllocator_ThreadCache *d_next_p;       // next thread cache
+                                                           // of the allocator
+
+    CachingMultipoolAllocator_ThreadCache *d_prev_p;       // previous thread
+                                                           // cache of the
+                                                           // allocator
+
+    CachingMultipoolAllocator_Magazine    *d_loaded_p;     // loaded magazine
+                                                           // of each size
+                                                           // class
+
+    CachingMultipoolAllocator_Magazine    *d_previous_p;   // previous magazine
+                                                           // of each size
+                                                           // class
+
+    // CLASS METHODS
+    static void threadExit(void *cache)
+        // Release the specified 'cache' of an exiting thread.
+    {
+        CachingMultipoolAllocator_ThreadCache *threadCache =
+                   static_cast<CachingMultipoolAllocator_ThreadCache *>(cache);
+        threadCache->d_allocator_p->releaseThreadCache(threadCache);
+    }
+};
+
+}  // close package namespace
+
+namespace {
+
+typedef bdlma::CachingMultipoolAllocator_Block    Block;
+typedef bdlma::CachingMultipoolAllocator_Header   Header;
+typedef bdlma::CachingMultipoolAllocator_Magazine Magazine;
+
+extern "C" void bdlma_CachingMultipoolAllocator_threadExit(void *cache)
+    // Release the specified 'cache' of an exiting thread.
+{
+    bdlma::CachingMultipoolAllocator_ThreadCache::threadExit(cache);
+}
+
+Block *carveMagazine(char *slab, bsl::size_t blockSize, int numBlocks)
+    // Link the specified 'numBlocks' blocks of the specified 'blockSize'
+    // bytes, carved out of the specified 'slab', into a list, and return the
+    // first block of the list.  Note that the blocks are first touched by the
+    // calling thread.
+{
+    Block *head = 0;
+    for (int i = numBlocks - 1; 0 <= i; --i) {
+        Block *block = reinterpret_cast<Block *>(slab + i * blockSize);
+        block->d_next_p = head;
+        head            = block;
+    }
+    return head;
+}
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                      // -------------------------------
+                      // class CachingMultipoolAllocator
+                      // -------------------------------
+
+// PRIVATE MANIPULATORS
+void *CachingMultipoolAllocator::allocateFromDepot(int sizeClass)
+{
+    SizeClass& depot = d_sizeClasses_p[sizeClass];
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+    Block *head = depot.d_magazines_p;
+    if (!head) {
+        char *slab = static_cast<char *>(depot.d_slabs.allocate(
+                                  static_cast<bsl::size_t>(d_magazineCapacity)
+                                                         * depot.d_blockSize));
+        head = carveMagazine(slab, depot.d_blockSize, d_magazineCapacity);
+        head->d_nextMagazine_p = 0;
+        head->d_numBlocks      = d_magazineCapacity;
+    }
+
+    if (1 < head->d_numBlocks) {
+        Block *next = head->d_next_p;
+        next->d_nextMagazine_p = head->d_nextMagazine_p;
+        next->d_numBlocks      = head->d_numBlocks - 1;
+        depot.d_magazines_p    = next;
+    }
+    else {
+        depot.d_magazines_p = head->d_nextMagazine_p;
+    }
+    return head;
+}
+
+void CachingMultipoolAllocator::deallocateToDepot(void *block, int sizeClass)
+{
+    SizeClass& depot = d_sizeClasses_p[sizeClass];
+    Block     *first = static_cast<Block *>(block);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+    Block *head = depot.d_magazines_p;
+    if (head && head->d_numBlocks < d_magazineCapacity) {
+        first->d_next_p         = head;
+        first->d_nextMagazine_p = head->d_nextMagazine_p;
+        first->d_numBlocks      = head->d_numBlocks + 1;
+    }
+    else {
+        first->d_next_p         = 0;
+        first->d_nextMagazine_p = head;
+        first->d_numBlocks      = 1;
+    }
+    depot.d_magazines_p = first;
+}
+
+void CachingMultipoolAllocator::flushThreadCache(ThreadCache *cache)
+{
+    for (int i = 0; i < d_numPools; ++i) {
+        Magazine *magazines[] = { cache->d_loaded_p + i,
+                                  cache->d_previous_p + i };
+
+        for (int j = 0; j < 2; ++j) {
+            Magazine& magazine = *magazines[j];
+            if (0 == magazine.d_numBlocks) {
+                continue;
+            }
+
+            SizeClass& depot = d_sizeClasses_p[i];
+
+            Block *head = magazine.d_head_p;
+            head->d_numBlocks = magazine.d_numBlocks;
+            {
+                bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+                head->d_nextMagazine_p = depot.d_magazines_p;
+                depot.d_magazines_p    = head;
+            }
+            magazine.d_head_p    = 0;
+            magazine.d_numBlocks = 0;
+        }
+    }
+}
+
+void CachingMultipoolAllocator::init()
+{
+    BSLS_ASSERT(1 <= d_numPools);
+    BSLS_ASSERT(d_numPools <= 28);
+    BSLS_ASSERT(1 <= d_magazineCapacity);
+
+    // If the platform has no thread-specific storage key left, blocks are
+    // allocated from, and deallocated to, the depots directly.
+
+    d_hasKey = 0 == bslmt::ThreadUtil::createKey(
+                                  &d_key,
+                                  &bdlma_CachingMultipoolAllocator_threadExit);
+
+    d_sizeClasses_p = static_cast<SizeClass *>(
+                     d_allocator_p->allocate(d_numPools * sizeof(SizeClass)));
+
+    bsl::size_t size = 8;
+    for (int i = 0; i < d_numPools; ++i, size <<= 1) {
+        const bsl::size_t blockSize = sizeof(Header)
+                      + bsls::AlignmentUtil::roundUpToMaximalAlignment(size);
+
+        new (d_sizeClasses_p + i) SizeClass(blockSize, d_allocator_p);
+    }
+}
+
+void CachingMultipoolAllocator::refill(ThreadCache *cache, int sizeClass)
+{
+    BSLS_ASSERT(0 == cache->d_loaded_p[sizeClass].d_numBlocks);
+
+    SizeClass& depot  = d_sizeClasses_p[sizeClass];
+    Magazine&  loaded = cache->d_loaded_p[sizeClass];
+
+    char *slab;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+        Block *head = depot.d_magazines_p;
+        if (head) {
+            depot.d_magazines_p = head->d_nextMagazine_p;
+            loaded.d_head_p     = head;
+            loaded.d_numBlocks  = head->d_numBlocks;
+            return;                                                   // RETURN
+        }
+
+        slab = static_cast<char *>(depot.d_slabs.allocate(
+                                  static_cast<bsl::size_t>(d_magazineCapacity)
+                                                         * depot.d_blockSize));
+    }
+
+    loaded.d_head_p    = carveMagazine(slab,
+                                       depot.d_blockSize,
+                                       d_magazineCapacity);
+    loaded.d_numBlocks = d_magazineCapacity;
+}
+
+void CachingMultipoolAllocator::releaseThreadCache(ThreadCache *cache)
+{
+    flushThreadCache(cache);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_threadCachesMutex);
+        if (cache->d_prev_p) {
+            cache->d_prev_p->d_next_p = cache->d_next_p;
+        }
+        else {
+            d_threadCaches_p = cache->d_next_p;
+        }
+        if (cache->d_next_p) {
+            cache->d_next_p->d_prev_p = cache->d_prev_p;
+        }
+    }
+
+    d_allocator_p->deallocate(cache);
+}
+
+CachingMultipoolAllocator::ThreadCache *
+CachingMultipoolAllocator::threadCache()
+{
+    ThreadCache *cache = static_cast<ThreadCache *>(
+                                       bslmt::ThreadUtil::getSpecific(d_key));
+    if (cache) {
+        return cache;                                                 // RETURN
+    }
+
+    cache = static_cast<ThreadCache *>(d_allocator_p->allocate(
+                    sizeof(ThreadCache) + 2 * d_numPools * sizeof(Magazine)));
+
+    cache->d_allocator_p = this;
+    cache->d_prev_p      = 0;
+    cache->d_loaded_p    = reinterpret_cast<Magazine *>(cache + 1);
+    cache->d_previous_p  = cache->d_loaded_p + d_numPools;
+    for (int i = 0; i < 2 * d_numPools; ++i) {
+        cache->d_loaded_p[i].d_head_p    = 0;
+        cache->d_loaded_p[i].d_numBlocks = 0;
+    }
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_threadCachesMutex);
+        cache->d_next_p = d_threadCaches_p;
+        if (d_threadCaches_p) {
+            d_threadCaches_p->d_prev_p = cache;
+        }
+        d_threadCaches_p = cache;
+    }
+
+    bslmt::ThreadUtil::setSpecific(d_key, cache);
+    return cache;
+}
+
+// CREATORS
+CachingMultipoolAllocator::CachingMultipoolAllocator(
+                                              bslma::Allocator *basicAllocator)
+: d_numPools(k_DEFAULT_NUM_POOLS)
+, d_magazineCapacity(k_DEFAULT_MAGAZINE_CAPACITY)
+, d_sizeClasses_p(0)
+, d_largeBlocks(basicAllocator)
+, d_hasKey(false)
+, d_threadCaches_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    init();
+}
+
+CachingMultipoolAllocator::CachingMultipoolAllocator(
+                                              int               numPools,
+                                              bslma::Allocator *basicAllocator)
+: d_numPools(numPools)
+, d_magazineCapacity(k_DEFAULT_MAGAZINE_CAPACITY)
+, d_sizeClasses_p(0)
+, d_largeBlocks(basicAllocator)
+, d_hasKey(false)
+, d_threadCaches_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    init();
+}
+
+CachingMultipoolAllocator::CachingMultipoolAllocator(
+                                            int               numPools,
+                                            int               magazineCapacity,
+                                            bslma::Allocator *basicAllocator)
+: d_numPools(numPools)
+, d_magazineCapacity(magazineCapacity)
+, d_sizeClasses_p(0)
+, d_largeBlocks(basicAllocator)
+, d_hasKey(false)
+, d_threadCaches_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    init();
+}
+
+CachingMultipoolAllocator::~CachingMultipoolAllocator()
+{
+    // Caches of threads that are still running are deallocated here; the
+    // deletion of the key ensures that they are not released again when these
+    // threads exit.
+
+    if (d_hasKey) {
+        bslmt::ThreadUtil::deleteKey(d_key);
+    }
+
+    while (d_threadCaches_p) {
+        ThreadCache *cache = d_threadCaches_p;
+        d_threadCaches_p = cache->d_next_p;
+        d_allocator_p->deallocate(cache);
+    }
+
+    for (int i = 0; i < d_numPools; ++i) {
+        d_sizeClasses_p[i].~SizeClass();
+    }
+    d_allocator_p->deallocate(d_sizeClasses_p);
+}
+
+// MANIPULATORS
+void *CachingMultipoolAllocator::allocate(bsls::Types::size_type size)
+{
+    if (0 == size) {
+        return 0;                                                     // RETURN
+    }
+
+    if (size > maxPooledBlockSize()) {
+        Header *header;
+        {
+            bslmt::LockGuard<bslmt::Mutex> guard(&d_largeBlocksMutex);
+            header = static_cast<Header *>(
+                                d_largeBlocks.allocate(sizeof(Header) + size));
+        }
+        header->d_sizeClass = -1;
+        return header + 1;                                            // RETURN
+    }
+
+    int                    sizeClass = 0;
+    bsls::Types::size_type blockSize = 8;
+    while (blockSize < size) {
+        blockSize <<= 1;
+        ++sizeClass;
+    }
+
+    if (!d_hasKey) {
+        Header *header = static_cast<Header *>(allocateFromDepot(sizeClass));
+        header->d_sizeClass = sizeClass;
+        return header + 1;                                            // RETURN
+    }
+
+    ThreadCache *cache = threadCache();
+
+    Magazine& loaded = cache->d_loaded_p[sizeClass];
+    if (0 == loaded.d_numBlocks) {
+        Magazine& previous = cache->d_previous_p[sizeClass];
+        if (previous.d_numBlocks) {
+            loaded               = previous;
+            previous.d_head_p    = 0;
+            previous.d_numBlocks = 0;
+        }
+        else {
+            refill(cache, sizeClass);
+        }
+    }
+
+    Block *block = loaded.d_head_p;
+    loaded.d_head_p = block->d_next_p;
+    --loaded.d_numBlocks;
+
+    Header *header = reinterpret_cast<Header *>(block);
+    header->d_sizeClass = sizeClass;
+    return header + 1;
+}
+
+void CachingMultipoolAllocator::deallocate(void *address)
+{
+    if (0 == address) {
+        return;                                                       // RETURN
+    }
+
+    Header    *header    = static_cast<Header *>(address) - 1;
+    const int  sizeClass = header->d_sizeClass;
+
+    if (0 > sizeClass) {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_largeBlocksMutex);
+        d_largeBlocks.deallocate(header);
+        return;                                                       // RETURN
+    }
+
+    BSLS_ASSERT(sizeClass < d_numPools);
+
+    if (!d_hasKey) {
+        deallocateToDepot(header, sizeClass);
+        return;                                                       // RETURN
+    }
+
+    ThreadCache *cache = threadCache();
+
+    Magazine& loaded = cache->d_loaded_p[sizeClass];
+    if (d_magazineCapacity == loaded.d_numBlocks) {
+        Magazine& previous = cache->d_previous_p[sizeClass];
+        if (previous.d_numBlocks) {
+            SizeClass& depot = d_sizeClasses_p[sizeClass];
+
+            Block *head = previous.d_head_p;
+            head->d_numBlocks = previous.d_numBlocks;
+
+            bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+            head->d_nextMagazine_p = depot.d_magazines_p;
+            depot.d_magazines_p    = head;
+        }
+        previous.d_head_p    = loaded.d_head_p;
+        previous.d_numBlocks = loaded.d_numBlocks;
+        loaded.d_head_p      = 0;
+        loaded.d_numBlocks   = 0;
+    }
+
+    Block *block = reinterpret_cast<Block *>(header);
+    block->d_next_p = loaded.d_head_p;
+    loaded.d_head_p = block;
+    ++loaded.d_numBlocks;
+}
+
+void CachingMultipoolAllocator::flushThreadCache()
+{
+    if (!d_hasKey) {
+        return;                                                       // RETURN
+    }
+
+    ThreadCache *cache = static_cast<ThreadCache *>(
+                                       bslmt::ThreadUtil::getSpecific(d_key));
+    if (cache) {
+        flushThreadCache(cache);
+    }
+}
+
+void CachingMultipoolAllocator::release()
+{
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_threadCachesMutex);
+        for (ThreadCache *cache = d_threadCaches_p;
+             cache;
+             cache = cache->d_next_p) {
+            for (int i = 0; i < 2 * d_numPools; ++i) {
+                cache->d_loaded_p[i].d_head_p    = 0;
+                cache->d_loaded_p[i].d_numBlocks = 0;
+            }
+        }
+    }
+
+    for (int i = 0; i < d_numPools; ++i) {
+        SizeClass& depot = d_sizeClasses_p[i];
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+        depot.d_magazines_p = 0;
+        depot.d_slabs.release();
+    }
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_largeBlocksMutex);
+    d_largeBlocks.release();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
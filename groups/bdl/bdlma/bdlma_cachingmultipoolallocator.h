@@ -0,0 +1,369 @@
+// bdlma_cachingmultipoolallocator.h                                  -*-C++-*-
+#ifndef INCLUDED_BDLMA_CACHINGMULTIPOOLALLOCATOR
+#define INCLUDED_BDLMA_CACHINGMULTIPOOLALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a multipool allocator with per-thread block caches.
+//
+//@CLASSES:
+//  bdlma::CachingMultipoolAllocator: multipool allocator caching per thread
+//
+//@SEE_ALSO: bdlma_concurrentmultipoolallocator, bdlma_managedallocator
+//
+//@DESCRIPTION: This component provides an allocator,
+// 'bdlma::CachingMultipoolAllocator', that implements the
+// 'bdlma::ManagedAllocator' protocol and dispenses memory blocks from a
+// configurable number of *size* *classes*, in a way that scales with the
+// number of threads allocating and deallocating memory concurrently.  As for
+// a 'bdlma::ConcurrentMultipoolAllocator', the blocks of the first size class
+// are eight bytes long, the blocks of each following size class are twice as
+// long as those of the previous one, each allocation request is served by the
+// size class of the smallest blocks not shorter than the requested size, and
+// larger requests are served by the allocator supplied at construction.
+//
+// A 'bdlma::ConcurrentMultipoolAllocator' serves every thread from a single
+// set of concurrent pools, so that each allocation and each deallocation
+// modifies the free list of a pool shared by all threads: when several
+// threads allocate and deallocate memory, the cache line holding the head of
+// that list moves from processor to processor on nearly every operation.  A
+// 'bdlma::CachingMultipoolAllocator' instead gives each thread its own cache
+// of free blocks, from which blocks are allocated and to which blocks are
+// deallocated without any synchronization.  Only when a thread's cache of a
+// size class runs empty, or overflows, does the thread access the shared
+// *depot* of that size class, exchanging a whole *magazine* of blocks (whose
+// number is the magazine capacity specified at construction) at once.  Blocks
+// deallocated by a thread other than the one that allocated them (e.g., by
+// the consumer of a queue filled by a producer thread) thus travel back to
+// the allocating threads lazily, in batches, through the depot.  New blocks
+// are carved out of large slabs of memory, one magazine at a time, by the
+// first thread needing them.
+//
+///Memory Usage
+///------------
+// Each block is preceded by a header (of the size of the maximal alignment,
+// 'bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT') recording its size class.
+// Memory of the pooled size classes is not returned to the allocator supplied
+// at construction until 'release' is called, or the allocator is destroyed.
+// In addition to the blocks in use, each thread that allocated or deallocated
+// blocks may hold up to two magazines of free blocks per size class in its
+// cache; the cache of a thread is returned to the depot when the thread
+// exits, or when the thread calls 'flushThreadCache'.
+//
+///Thread-Specific Storage Keys
+///-----------------------------
+// Each 'bdlma::CachingMultipoolAllocator' finds the cache of the calling
+// thread through a thread-specific storage key of its own (see
+// 'bslmt::ThreadUtil::createKey'), which it holds until it is destroyed.  The
+// number of such keys is limited by the platform (e.g., to
+// 'PTHREAD_KEYS_MAX', usually 1024, on POSIX platforms), and is shared with
+// every other component of the process.  An allocator created when no key is
+// available does not fail: it does not cache blocks per thread, and instead
+// allocates each block from, and deallocates each block to, the depot of its
+// size class, under the lock of the depot, as a
+// 'bdlma::ConcurrentMultipoolAllocator' does.  Such an allocator is fully
+// functional, but does not scale with the number of threads.  Applications
+// creating many allocators (e.g., one per object or per request) should
+// therefore prefer a 'bdlma::ConcurrentMultipoolAllocator', or share a few
+// caching allocators, and should not count on per-thread caching beyond the
+// first few hundred live instances.  'isCaching' indicates whether an
+// allocator caches blocks per thread.
+//
+///Thread Safety
+///-------------
+// 'bdlma::CachingMultipoolAllocator' is *fully* *thread-safe*, meaning that
+// 'allocate', 'deallocate', 'flushThreadCache', and the accessors can be
+// called on the *same* *instance* from any thread.  'release' must not be
+// called while another thread is using the allocator.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Passing Messages Between Threads
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose a thread receives messages that it passes to a processing thread,
+// which destroys them once processed.  Using a caching multipool allocator to
+// supply the memory of the messages, both threads allocate and deallocate
+// without contending with each other, and the memory of the processed
+// messages returns to the receiving thread in batches.
+//
+// First, we create the allocator, with the default number of size classes,
+// whose largest blocks are 4096 bytes long:
+//..
+//  bdlma::CachingMultipoolAllocator allocator;
+//  assert(4096 == allocator.maxPooledBlockSize());
+//..
+// Then, the receiving thread allocates the memory of a message:
+//..
+//  bsl::string *message = new (allocator) bsl::string("Hello", &allocator);
+//..
+// Next, the processing thread (here, the same thread, for brevity) destroys
+// the message once processed, returning the memory of the message to its own
+// cache:
+//..
+//  allocator.deleteObject(message);
+//..
+// Finally, a thread that is about to stop allocating memory for a long time
+// can make the blocks in its cache available to the other threads:
+//..
+//  allocator.flushThreadCache();
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_MANAGEDALLOCATOR
+#include <bdlma_managedallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+struct CachingMultipoolAllocator_SizeClass;
+struct CachingMultipoolAllocator_ThreadCache;
+
+                      // ===============================
+                      // class CachingMultipoolAllocator
+                      // ===============================
+
+class CachingMultipoolAllocator : public ManagedAllocator {
+    // This class implements the 'ManagedAllocator' protocol and provides a
+    // mechanism for allocating memory blocks from a set of size classes,
+    // caching free blocks in per-thread magazines that are exchanged with a
+    // shared depot in batches.
+
+    // PRIVATE TYPES
+    typedef CachingMultipoolAllocator_SizeClass   SizeClass;
+    typedef CachingMultipoolAllocator_ThreadCache ThreadCache;
+
+    // DATA
+    int                     d_numPools;           // number of size classes
+
+    int                     d_magazineCapacity;   // number of blocks in a
+                                                  // magazine
+
+    SizeClass              *d_sizeClasses_p;      // depot of each size class
+                                                  // (owned)
+
+    BlockList               d_largeBlocks;        // blocks larger than the
+                                                  // largest size class
+
+    bslmt::Mutex            d_largeBlocksMutex;   // protects 'd_largeBlocks'
+
+    bslmt::ThreadUtil::Key  d_key;                // key of the thread cache
+                                                  // of the calling thread
+
+    bool                    d_hasKey;             // 'true' if 'd_key' was
+                                                  // created, and blocks are
+                                                  // cached per thread
+
+    ThreadCache            *d_threadCaches_p;     // list of the thread caches
+                                                  // of all threads (owned)
+
+    bslmt::Mutex            d_threadCachesMutex;  // protects
+                                                  // 'd_threadCaches_p'
+
+    bslma::Allocator       *d_allocator_p;        // memory allocator (held)
+
+    // FRIENDS
+    friend struct CachingMultipoolAllocator_ThreadCache;
+
+  private:
+    // NOT IMPLEMENTED
+    CachingMultipoolAllocator(const CachingMultipoolAllocator&);
+    CachingMultipoolAllocator& operator=(const CachingMultipoolAllocator&);
+
+    // PRIVATE MANIPULATORS
+    void *allocateFromDepot(int sizeClass);
+        // Return the address of a free block (header included) of the
+        // specified 'sizeClass', taken directly from the depot of
+        // 'sizeClass', or carved out of a new slab if the depot is empty.
+        // This method is used only if no thread-specific storage key is
+        // available.
+
+    void deallocateToDepot(void *block, int sizeClass);
+        // Return the specified 'block' (header included) of the specified
+        // 'sizeClass' directly to the depot of 'sizeClass'.  This method is
+        // used only if no thread-specific storage key is available.
+
+    void flushThreadCache(ThreadCache *cache);
+        // Return all the blocks held by the specified 'cache' to the depot of
+        // their size class.
+
+    void init();
+        // Create the size classes of this allocator, and the key of the
+        // thread caches if one is available.  This method is invoked only by
+        // the constructors.
+
+    void refill(ThreadCache *cache, int sizeClass);
+        // Load into the specified 'cache' a magazine of free blocks of the
+        // specified 'sizeClass', taken from the depot or, if the depot is
+        // empty, carved out of a new slab.  The behavior is undefined unless
+        // 'cache' holds no block of 'sizeClass'.
+
+    void releaseThreadCache(ThreadCache *cache);
+        // Flush and deallocate the specified 'cache'.  This method is invoked
+        // when the thread owning 'cache' exits.
+
+    ThreadCache *threadCache();
+        // Return the cache of the calling thread, creating it if needed.
+
+  public:
+    // CONSTANTS
+    enum {
+        k_DEFAULT_NUM_POOLS         = 10,  // number of size classes used
+                                           // unless specified at construction
+
+        k_DEFAULT_MAGAZINE_CAPACITY = 32   // magazine capacity used unless
+                                           // specified at construction
+    };
+
+    // CREATORS
+    explicit
+    CachingMultipoolAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit
+    CachingMultipoolAllocator(int               numPools,
+                              bslma::Allocator *basicAllocator = 0);
+    CachingMultipoolAllocator(int               numPools,
+                              int               magazineCapacity,
+                              bslma::Allocator *basicAllocator = 0);
+        // Create a caching multipool allocator.  Optionally specify
+        // 'numPools', the number of size classes, where the blocks of the
+        // first size class are 8 bytes long, and those of each following size
+        // class are twice as long as those of the previous one; if 'numPools'
+        // is not specified, 'k_DEFAULT_NUM_POOLS' is used.  Optionally specify
+        // 'magazineCapacity', the number of blocks exchanged at once between
+        // the cache of a thread and the depot of a size class; if
+        // 'magazineCapacity' is not specified, 'k_DEFAULT_MAGAZINE_CAPACITY'
+        // is used.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '1 <= numPools <= 28' and '1 <= magazineCapacity'.  Note that, if
+        // no thread-specific storage key is available, the allocator does
+        // not cache blocks per thread (see {Thread-Specific Storage Keys}).
+
+    virtual ~CachingMultipoolAllocator();
+        // Destroy this allocator.  All memory allocated from this allocator is
+        // released.
+
+    // MANIPULATORS
+    virtual void *allocate(bsls::Types::size_type size);
+        // Return the address of a contiguous block of maximally aligned memory
+        // of (at least) the specified 'size' (in bytes).  If 'size' is 0, no
+        // memory is allocated and 0 is returned.  If
+        // 'size > maxPooledBlockSize()', the memory is allocated directly
+        // from the allocator supplied at construction, and is not pooled.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' to this
+        // allocator.  If 'address' is 0, this method has no effect.  The
+        // behavior is undefined unless 'address' was allocated by this
+        // allocator, and has not already been deallocated.  Note that
+        // 'address' may have been allocated by any thread.
+
+    void flushThreadCache();
+        // Return the free blocks cached by the calling thread to the depot of
+        // their size class, making them available to other threads.
+
+    virtual void release();
+        // Relinquish all memory currently allocated through this allocator.
+        // The behavior is undefined if another thread is using this allocator
+        // concurrently.  Note that the caches of all threads are emptied.
+
+    // ACCESSORS
+    bool isCaching() const;
+        // Return 'true' if this allocator caches free blocks per thread, and
+        // 'false' if it allocates and deallocates blocks directly from the
+        // depots because no thread-specific storage key was available at
+        // construction.
+
+    int magazineCapacity() const;
+        // Return the number of blocks exchanged at once between the cache of
+        // a thread and the depot of a size class.
+
+    bsls::Types::size_type maxPooledBlockSize() const;
+        // Return the size of the blocks of the largest size class of this
+        // allocator, that is '2 ^ (numPools() + 2)'.
+
+    int numPools() const;
+        // Return the number of size classes of this allocator.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                      // -------------------------------
+                      // class CachingMultipoolAllocator
+                      // -------------------------------
+
+// ACCESSORS
+inline
+bool CachingMultipoolAllocator::isCaching() const
+{
+    return d_hasKey;
+}
+
+inline
+int CachingMultipoolAllocator::magazineCapacity() const
+{
+    return d_magazineCapacity;
+}
+
+inline
+bsls::Types::size_type CachingMultipoolAllocator::maxPooledBlockSize() const
+{
+    return static_cast<bsls::Types::size_type>(8) << (d_numPools - 1);
+}
+
+inline
+int CachingMultipoolAllocator::numPools() const
+{
+    return d_numPools;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1232 @@
+// bdlma_cachingmultipoolallocator.t.cpp                              -*-C++-*-
+#include <bdlma_cachingmultipoolallocator.h>
+
+#include <bdlma_concurrentmultipoolallocator.h>
+
+#include <bdlf_bind.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_condition.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_deque.h>
+#include <bsl_iostream.h>
+#include <bsl_set.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a mechanism implementing the
+// 'bdlma::ManagedAllocator' protocol.  We first verify that the blocks it
+// supplies are suitably sized, aligned, distinct, and usable, then that
+// blocks are recycled through the caches of the threads and the depot, and
+// that the memory held by the allocator is bounded, and returned by 'release'
+// and on destruction.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] CachingMultipoolAllocator(Allocator *);
+// [ 2] CachingMultipoolAllocator(int, Allocator *);
+// [ 2] CachingMultipoolAllocator(int, int, Allocator *);
+// [ 1] ~CachingMultipoolAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type);
+// [ 3] void deallocate(void *);
+// [ 4] void flushThreadCache();
+// [ 5] void release();
+//
+// ACCESSORS
+// [ 2] bool isCaching() const;
+// [ 2] int magazineCapacity() const;
+// [ 2] size_type maxPooledBlockSize() const;
+// [ 2] int numPools() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] CONCURRENCY
+// [ 7] CONCERN: MORE ALLOCATORS THAN THREAD-SPECIFIC STORAGE KEYS
+// [ 8] USAGE EXAMPLE
+// [-1] ALLOCATION BENCHMARK
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::CachingMultipoolAllocator Obj;
+typedef bsls::Types::Int64               Int64;
+typedef bsls::Types::size_type           size_type;
+
+static int verbose;
+static int veryVerbose;
+static int veryVeryVerbose;
+
+// ============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+static bool isMaximallyAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == bsls::AlignmentUtil::calculateAlignmentOffset(
+                                  address,
+                                  bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT);
+}
+
+static size_type pooledSize(size_type size)
+    // Return the size of the blocks of the size class serving a request of
+    // the specified 'size', assuming that 'size' is pooled.
+{
+    size_type blockSize = 8;
+    while (blockSize < size) {
+        blockSize <<= 1;
+    }
+    return blockSize;
+}
+
+                        // ===============================
+                        // namespace TEST_CASE_CONCURRENCY
+                        // ===============================
+
+namespace TEST_CASE_CONCURRENCY {
+
+void allocateAndDeallocate(bslma::Allocator *allocator,
+                           bslmt::Barrier   *barrier,
+                           int               id,
+                           int               numIterations,
+                           int               numBlocks)
+    // Wait on the specified 'barrier', then repeat the specified
+    // 'numIterations' times: allocate the specified 'numBlocks' blocks of
+    // various sizes from the specified 'allocator', fill each with a pattern
+    // that is a function of the specified 'id', verify the patterns, and
+    // deallocate the blocks.
+{
+    bsl::vector<char *> blocks(numBlocks);
+
+    barrier->wait();
+
+    for (int i = 0; i < numIterations; ++i) {
+        for (int j = 0; j < numBlocks; ++j) {
+            const int size = 1 + (i * 7 + j * 13) % 200;
+            blocks[j] = static_cast<char *>(allocator->allocate(size));
+            bsl::memset(blocks[j], id + j, size);
+        }
+        for (int j = 0; j < numBlocks; ++j) {
+            const int size = 1 + (i * 7 + j * 13) % 200;
+            for (int k = 0; k < size; ++k) {
+                LOOP3_ASSERT(id, j, k, (char)(id + j) == blocks[j][k]);
+            }
+        }
+        for (int j = 0; j < numBlocks; ++j) {
+            allocator->deallocate(blocks[j]);
+        }
+    }
+}
+
+void deallocateBlocks(bslma::Allocator *allocator, bsl::vector<void *> *blocks)
+    // Deallocate the specified 'blocks' from the specified 'allocator'.
+{
+    for (bsl::size_t i = 0; i < blocks->size(); ++i) {
+        allocator->deallocate((*blocks)[i]);
+    }
+    blocks->clear();
+}
+
+}  // close namespace TEST_CASE_CONCURRENCY
+
+                      // ===============================
+                      // namespace TEST_CASE_BENCHMARK
+                      // ===============================
+
+namespace TEST_CASE_BENCHMARK {
+
+void churn(bslma::Allocator *allocator,
+           bslmt::Barrier   *barrier,
+           int               numObjects,
+           int               numIterations)
+    // Wait on the specified 'barrier', then repeat the specified
+    // 'numIterations' times: deallocate the next of the specified
+    // 'numObjects' objects (in round-robin order) held by the calling thread,
+    // and allocate a new object of a different size from the specified
+    // 'allocator' in its place.
+{
+    bsl::vector<void *> objects(numObjects, static_cast<void *>(0));
+
+    barrier->wait();
+
+    for (int i = 0; i < numIterations; ++i) {
+        void *& object = objects[i % numObjects];
+        allocator->deallocate(object);
+        object = allocator->allocate(8 + (i * 37) % 500);
+        *static_cast<char *>(object) = static_cast<char>(i);
+    }
+    for (int i = 0; i < numObjects; ++i) {
+        allocator->deallocate(objects[i]);
+    }
+}
+
+double measureChurn(bslma::Allocator *allocator,
+                    int               numThreads,
+                    int               numObjects,
+                    int               numIterations)
+    // Run 'churn' in the specified 'numThreads' threads with the specified
+    // 'allocator', 'numObjects' objects per thread and 'numIterations'
+    // iterations per thread, and return the elapsed wall time in seconds.
+{
+    bslmt::Barrier                         barrier(numThreads + 1);
+    bsl::vector<bslmt::ThreadUtil::Handle> handles(numThreads);
+
+    for (int i = 0; i < numThreads; ++i) {
+        int rc = bslmt::ThreadUtil::create(&handles[i],
+                                           bdlf::BindUtil::bind(
+                                                           &churn,
+                                                           allocator,
+                                                           &barrier,
+                                                           numObjects,
+                                                           numIterations));
+        BSLS_ASSERT_OPT(0 == rc);
+    }
+
+    bsls::Stopwatch timer;
+    timer.start(true);
+
+    barrier.wait();
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+
+    timer.stop();
+    return timer.elapsedTime();
+}
+
+class Queue {
+    // This class provides a queue of batches of objects, passed from a
+    // producer thread to a consumer thread.
+
+    // DATA
+    bslmt::Mutex                     d_mutex;
+    bslmt::Condition                 d_condition;
+    bsl::deque<bsl::vector<void *> > d_batches;
+
+  public:
+    // MANIPULATORS
+    void push(bsl::vector<void *> *batch)
+        // Append the contents of the specified 'batch' to this queue, leaving
+        // 'batch' empty.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_batches.push_back(bsl::vector<void *>());
+        d_batches.back().swap(*batch);
+        d_condition.signal();
+    }
+
+    void pop(bsl::vector<void *> *batch)
+        // Load into the specified 'batch' the first batch of this queue,
+        // waiting until one is available.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        while (d_batches.empty()) {
+            d_condition.wait(&d_mutex);
+        }
+        batch->swap(d_batches.front());
+        d_batches.pop_front();
+    }
+};
+
+void produce(bslma::Allocator *allocator,
+             Queue            *queue,
+             int               numBatches,
+             int               batchSize)
+    // Push onto the specified 'queue' the specified 'numBatches' batches of
+    // the specified 'batchSize' objects allocated from the specified
+    // 'allocator', followed by an empty batch.
+{
+    bsl::vector<void *> batch;
+    for (int i = 0; i < numBatches; ++i) {
+        batch.reserve(batchSize);
+        for (int j = 0; j < batchSize; ++j) {
+            void *object = allocator->allocate(8 + (j * 37) % 500);
+            *static_cast<char *>(object) = static_cast<char>(j);
+            batch.push_back(object);
+        }
+        queue->push(&batch);
+    }
+    queue->push(&batch);
+}
+
+void consume(bslma::Allocator *allocator, Queue *queue)
+    // Pop batches of objects from the specified 'queue' and deallocate them
+    // from the specified 'allocator', until an empty batch is popped.
+{
+    bsl::vector<void *> batch;
+    while (true) {
+        queue->pop(&batch);
+        if (batch.empty()) {
+            break;
+        }
+        for (bsl::size_t i = 0; i < batch.size(); ++i) {
+            allocator->deallocate(batch[i]);
+        }
+    }
+}
+
+double measureProducerConsumer(bslma::Allocator *allocator,
+                               int               numBatches,
+                               int               batchSize)
+    // Run a 'produce' thread and a 'consume' thread with the specified
+    // 'allocator', 'numBatches', and 'batchSize', and return the elapsed wall
+    // time in seconds.
+{
+    Queue                     queue;
+    bslmt::ThreadUtil::Handle producer, consumer;
+
+    bsls::Stopwatch timer;
+    timer.start(true);
+
+    int rc = bslmt::ThreadUtil::create(&consumer,
+                                       bdlf::BindUtil::bind(&consume,
+                                                            allocator,
+                                                            &queue));
+    BSLS_ASSERT_OPT(0 == rc);
+    rc = bslmt::ThreadUtil::create(&producer,
+                                   bdlf::BindUtil::bind(&produce,
+                                                        allocator,
+                                                        &queue,
+                                                        numBatches,
+                                                        batchSize));
+    BSLS_ASSERT_OPT(0 == rc);
+
+    bslmt::ThreadUtil::join(producer);
+    bslmt::ThreadUtil::join(consumer);
+
+    timer.stop();
+    return timer.elapsedTime();
+}
+
+}  // close namespace TEST_CASE_BENCHMARK
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    verbose = argc > 2;
+    veryVerbose = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Passing Messages Between Threads
+///- - - - - - - - - - - - - - - - - - - - - -
+// Suppose a thread receives messages that it passes to a processing thread,
+// which destroys them once processed.  Using a caching multipool allocator to
+// supply the memory of the messages, both threads allocate and deallocate
+// without contending with each other, and the memory of the processed
+// messages returns to the receiving thread in batches.
+//
+// First, we create the allocator, with the default number of size classes,
+// whose largest blocks are 4096 bytes long:
+//..
+    bdlma::CachingMultipoolAllocator allocator;
+    ASSERT(4096 == allocator.maxPooledBlockSize());
+//..
+// Then, the receiving thread allocates the memory of a message:
+//..
+    bsl::string *message = new (allocator) bsl::string("Hello", &allocator);
+//..
+// Next, the processing thread (here, the same thread, for brevity) destroys
+// the message once processed, returning the memory of the message to its own
+// cache:
+//..
+    allocator.deleteObject(message);
+//..
+// Finally, a thread that is about to stop allocating memory for a long time
+// can make the blocks in its cache available to the other threads:
+//..
+    allocator.flushThreadCache();
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCERN: MORE ALLOCATORS THAN THREAD-SPECIFIC STORAGE KEYS
+        //
+        // Concerns:
+        //: 1 More allocators than the platform has thread-specific storage
+        //:   keys can be alive at the same time.
+        //:
+        //: 2 An allocator created when no key is available allocates and
+        //:   deallocates blocks correctly, from any number of threads, and
+        //:   recycles the deallocated blocks.
+        //:
+        //: 3 The keys are returned when the allocators are destroyed.
+        //
+        // Plan:
+        //: 1 Create 2000 allocators (more than the 1024 keys of usual POSIX
+        //:   platforms), and allocate, fill, verify, and deallocate blocks of
+        //:   various sizes with each of them.  (C-1)
+        //:
+        //: 2 Verify that an allocator that does not cache blocks per thread
+        //:   returns the last deallocated block on the next allocation of its
+        //:   size class, and run several threads allocating and deallocating
+        //:   blocks concurrently with it.  (C-2)
+        //:
+        //: 3 Destroy the allocators, and verify that a new allocator caches
+        //:   blocks per thread.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: MORE ALLOCATORS THAN THREAD-SPECIFIC STORAGE KEYS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+          << "CONCERN: MORE ALLOCATORS THAN THREAD-SPECIFIC STORAGE KEYS"
+          << endl
+          << "=========================================================="
+          << endl;
+
+        using namespace TEST_CASE_CONCURRENCY;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+
+        {
+            const int k_NUM_ALLOCATORS = 2000;
+
+            bsl::vector<Obj *> allocators;
+            int                numCaching = 0;
+
+            for (int i = 0; i < k_NUM_ALLOCATORS; ++i) {
+                Obj *allocator = new (ta) Obj(4, 2, &ta);
+                allocators.push_back(allocator);
+                numCaching += allocator->isCaching();
+
+                char *blocks[5];
+                for (int j = 0; j < 5; ++j) {
+                    blocks[j] = static_cast<char *>(
+                                              allocator->allocate(1 + 15 * j));
+                    bsl::memset(blocks[j], j, 1 + 15 * j);
+                }
+                for (int j = 0; j < 5; ++j) {
+                    for (int k = 0; k < 1 + 15 * j; ++k) {
+                        LOOP3_ASSERT(i, j, k, j == blocks[j][k]);
+                    }
+                    allocator->deallocate(blocks[j]);
+                }
+
+                if (!allocator->isCaching()) {
+                    void *block = allocator->allocate(8);
+                    allocator->deallocate(block);
+                    LOOP_ASSERT(i, block == allocator->allocate(8));
+                    allocator->deallocate(block);
+                }
+            }
+            if (verbose) {
+                P(numCaching);
+            }
+
+            // Use the last allocator, which does not cache blocks per thread
+            // on usual POSIX platforms, from several threads.
+
+            const int k_NUM_THREADS = 4;
+
+            bslmt::Barrier barrier(k_NUM_THREADS);
+            bsl::vector<bslmt::ThreadUtil::Handle> handles(k_NUM_THREADS);
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::create(
+                                        &handles[i],
+                                        bdlf::BindUtil::bind(
+                                                        &allocateAndDeallocate,
+                                                        allocators.back(),
+                                                        &barrier,
+                                                        i * 16,
+                                                        200,
+                                                        i + 1)));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+
+            for (int i = 0; i < k_NUM_ALLOCATORS; ++i) {
+                ta.deleteObject(allocators[i]);
+            }
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            ASSERT(X.isCaching());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Several threads can allocate and deallocate blocks concurrently,
+        //:   and never obtain a block in use by another thread.
+        //:
+        //: 2 Blocks allocated by a thread and deallocated by another one are
+        //:   made available to the allocating thread through the depot.
+        //:
+        //: 3 The cache of a thread is returned when the thread exits.
+        //
+        // Plan:
+        //: 1 Run several threads allocating blocks, filling them with a
+        //:   pattern specific to the thread, verifying the patterns, and
+        //:   deallocating the blocks.  Verify that the number of slabs
+        //:   allocated is bounded.  (C-1)
+        //:
+        //: 2 Allocate blocks in the main thread, deallocate them in another
+        //:   thread, and allocate them again in the main thread: verify that
+        //:   the same blocks are obtained, and that no memory is allocated
+        //:   for the second round.  (C-2..3)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        using namespace TEST_CASE_CONCURRENCY;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+
+        if (verbose) cout << "\nConcurrent allocation and deallocation."
+                          << endl;
+        {
+            const int k_NUM_THREADS = 8;
+
+            Obj mX(1, 4, &ta);  const Obj& X = mX;
+            ASSERT(8 == X.maxPooledBlockSize());
+
+            Obj mY(8, 4, &ta);
+
+            bslmt::Barrier barrier(2 * k_NUM_THREADS);
+            bsl::vector<bslmt::ThreadUtil::Handle> handles(2 * k_NUM_THREADS);
+
+            for (int i = 0; i < 2 * k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::create(
+                                        &handles[i],
+                                        bdlf::BindUtil::bind(
+                                                   &allocateAndDeallocate,
+                                                   i % 2
+                                                   ? static_cast<Obj *>(&mX)
+                                                   : static_cast<Obj *>(&mY),
+                                                   &barrier,
+                                                   i * 16,
+                                                   200,
+                                                   i + 1)));
+            }
+            for (int i = 0; i < 2 * k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\nBounded number of slabs." << endl;
+        {
+            const int k_NUM_THREADS = 8;
+
+            bslma::TestAllocator ua("unused", veryVeryVerbose);
+            Obj mY(1, 4, &ua);
+            const Int64 IDLE_BLOCKS = ua.numBlocksInUse();
+
+            Obj mX(1, 4, &ta);
+
+            bslmt::Barrier barrier(k_NUM_THREADS);
+            bsl::vector<bslmt::ThreadUtil::Handle> handles(k_NUM_THREADS);
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::create(
+                                        &handles[i],
+                                        bdlf::BindUtil::bind(
+                                                        &allocateAndDeallocate,
+                                                        &mX,
+                                                        &barrier,
+                                                        i * 16,
+                                                        200,
+                                                        i + 1)));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+
+            // Only the slabs remain allocated (the caches of the exited
+            // threads having been deallocated), in addition to the memory of
+            // an idle allocator.  A thread holding 'n' blocks caches at most
+            // '2 * 4' free blocks in addition.
+
+            const Int64 NUM_SLABS = ta.numBlocksInUse() - IDLE_BLOCKS;
+            if (veryVerbose) { P(NUM_SLABS) }
+
+            ASSERT(0 < NUM_SLABS);
+            ASSERT(NUM_SLABS <= (8 * 9 / 2 + k_NUM_THREADS * 8) / 4 + 1);
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\nDeallocation by another thread." << endl;
+        {
+            const int k_NUM_BLOCKS = 100;
+
+            Obj mX(4, 10, &ta);
+
+            bsl::vector<void *> blocks;
+            bsl::set<void *>    addresses;
+            for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                blocks.push_back(mX.allocate(64));
+                addresses.insert(blocks.back());
+            }
+            ASSERT(k_NUM_BLOCKS == static_cast<int>(addresses.size()));
+
+            const Int64 NUM_ALLOCATIONS = ta.numAllocations();
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(
+                                  &handle,
+                                  bdlf::BindUtil::bind(&deallocateBlocks,
+                                                       &mX,
+                                                       &blocks)));
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+            // All blocks are in the depot, now that the deallocating thread
+            // has exited (having allocated, then deallocated, its cache).
+
+            const Int64 NUM_ALLOCATIONS2 = ta.numAllocations();
+            ASSERT(NUM_ALLOCATIONS + 1 == NUM_ALLOCATIONS2);
+
+            for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                void *block = mX.allocate(33);
+                LOOP_ASSERT(i, 1 == addresses.count(block));
+            }
+            ASSERT(NUM_ALLOCATIONS2 == ta.numAllocations());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // 'release'
+        //
+        // Concerns:
+        //: 1 'release' deallocates all memory allocated through the
+        //:   allocator, pooled or not, except the memory needed by an idle
+        //:   allocator and the caches of the threads.
+        //:
+        //: 2 The allocator is usable after 'release', and allocates new slabs
+        //:   as needed.
+        //
+        // Plan:
+        //: 1 Allocate pooled and large blocks, call 'release', and verify the
+        //:   number of blocks in use by the test allocator.  (C-1)
+        //:
+        //: 2 Allocate blocks again, and verify that new slabs are allocated,
+        //:   and that the blocks are usable.  (C-2)
+        //
+        // Testing:
+        //   void release();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'release'" << endl
+                          << "=========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+        {
+            Obj mX(4, 4, &ta);  const Obj& X = mX;
+
+            const Int64 IDLE_BLOCKS = ta.numBlocksInUse();
+
+            mX.release();
+            ASSERT(IDLE_BLOCKS == ta.numBlocksInUse());
+
+            for (int i = 0; i < 100; ++i) {
+                void *block = mX.allocate(1 + i % 40);
+                bsl::memset(block, i, 1 + i % 40);
+                if (i % 3) {
+                    mX.deallocate(block);
+                }
+            }
+            void *large = mX.allocate(X.maxPooledBlockSize() + 1);
+            (void)large;
+
+            // The calling thread keeps its (emptied) cache.
+
+            mX.release();
+            ASSERT(IDLE_BLOCKS + 1 == ta.numBlocksInUse());
+
+            const Int64 NUM_ALLOCATIONS = ta.numAllocations();
+            void *block = mX.allocate(32);
+            ASSERT(0 != block);
+            ASSERT(NUM_ALLOCATIONS + 1 == ta.numAllocations());
+            bsl::memset(block, 0xff, 32);
+            mX.deallocate(block);
+
+            mX.release();
+            ASSERT(IDLE_BLOCKS + 1 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // MAGAZINES AND 'flushThreadCache'
+        //
+        // Concerns:
+        //: 1 Memory is obtained from the allocator one magazine at a time,
+        //:   separately for each size class.
+        //:
+        //: 2 Deallocated blocks are reused, most recently deallocated first.
+        //:
+        //: 3 'flushThreadCache' returns the cached blocks to the depot, from
+        //:   which they are reused, and has no effect if the calling thread
+        //:   has no cache.
+        //
+        // Plan:
+        //: 1 Allocate blocks and verify the number of allocations from the
+        //:   test allocator.  (C-1)
+        //:
+        //: 2 Deallocate a block and allocate a new one of the same size class:
+        //:   verify that the same memory is returned.  (C-2)
+        //:
+        //: 3 Flush the cache after deallocating all blocks, then verify that
+        //:   allocating the same number of blocks does not allocate memory.
+        //:   (C-3)
+        //
+        // Testing:
+        //   void flushThreadCache();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MAGAZINES AND 'flushThreadCache'" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+        bslma::TestAllocator         ta("test", veryVeryVerbose);
+        bslma::TestAllocator         va("vector", veryVeryVerbose);
+
+        {
+            Obj mX(&ta);
+
+            mX.flushThreadCache();
+        }
+
+        const int CAPACITIES[] = { 1, 2, 3, 7, 16 };
+        const int NUM_CAPACITIES = sizeof CAPACITIES / sizeof *CAPACITIES;
+
+        for (int ti = 0; ti < NUM_CAPACITIES; ++ti) {
+            const int CAPACITY = CAPACITIES[ti];
+
+            Obj mX(3, CAPACITY, &ta);
+
+            const Int64 BASE = ta.numAllocations();
+
+            // The first allocation allocates the thread cache and a slab.
+
+            bsl::vector<void *> blocks(3 * CAPACITY,
+                                       static_cast<void *>(0),
+                                       &va);
+            blocks[0] = mX.allocate(20);
+            LOOP_ASSERT(CAPACITY, BASE + 2 == ta.numAllocations());
+
+            for (int i = 1; i < 3 * CAPACITY; ++i) {
+                blocks[i] = mX.allocate(17 + i % 16);
+                LOOP2_ASSERT(CAPACITY, i,
+                             BASE + 2 + i / CAPACITY == ta.numAllocations());
+            }
+
+            void *last = blocks.back();
+            mX.deallocate(last);
+
+            blocks.back() = mX.allocate(32);
+            LOOP_ASSERT(CAPACITY, last == blocks.back());
+
+            const Int64 NUM_ALLOCATIONS = ta.numAllocations();
+
+            for (int i = 0; i < 3 * CAPACITY; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            mX.flushThreadCache();
+            mX.flushThreadCache();
+
+            for (int i = 0; i < 3 * CAPACITY; ++i) {
+                blocks[i] = mX.allocate(32);
+            }
+            LOOP_ASSERT(CAPACITY, NUM_ALLOCATIONS == ta.numAllocations());
+
+            // Blocks of the other size classes are allocated from other
+            // slabs.
+
+            mX.allocate(16);
+            LOOP_ASSERT(CAPACITY, NUM_ALLOCATIONS + 1 == ta.numAllocations());
+
+            mX.allocate(1);
+            LOOP_ASSERT(CAPACITY, NUM_ALLOCATIONS + 2 == ta.numAllocations());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'allocate' AND 'deallocate'
+        //
+        // Concerns:
+        //: 1 'allocate' returns a maximally aligned block of at least the
+        //:   requested size, distinct from the other blocks in use.
+        //:
+        //: 2 Requests of the same size class are served from the same
+        //:   blocks.
+        //:
+        //: 3 Requests larger than 'maxPooledBlockSize()' are served by the
+        //:   allocator supplied at construction, to which the blocks are
+        //:   returned by 'deallocate'.
+        //:
+        //: 4 'allocate(0)' returns 0, and 'deallocate(0)' has no effect.
+        //:
+        //: 5 No memory is allocated from the default allocator.
+        //
+        // Plan:
+        //: 1 For every number of pools and every size up to twice the
+        //:   largest pooled size, allocate a block, verify its alignment, fill
+        //:   it, and verify that it does not overlap the other blocks in use.
+        //:   (C-1)
+        //:
+        //: 2 Deallocate a block, and allocate a block of another size of the
+        //:   same size class: verify that the same block is returned.  (C-2)
+        //:
+        //: 3 Verify the number of blocks in use by the test allocator after
+        //:   allocating and deallocating large blocks.  (C-3)
+        //:
+        //: 4 Call 'allocate(0)' and 'deallocate(0)'.  (C-4)
+        //:
+        //: 5 Install a test allocator as the default allocator, and verify
+        //:   that it is not used.  (C-5)
+        //
+        // Testing:
+        //   void *allocate(size_type);
+        //   void deallocate(void *);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'allocate' AND 'deallocate'" << endl
+                          << "===========================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+        bslma::TestAllocator         ta("test", veryVeryVerbose);
+        bslma::TestAllocator         va("vector", veryVeryVerbose);
+
+        for (int numPools = 1; numPools <= 10; ++numPools) {
+            Obj mX(numPools, &ta);  const Obj& X = mX;
+
+            const size_type MAX_SIZE = X.maxPooledBlockSize();
+
+            bsl::vector<char *>    blocks(&va);
+            bsl::vector<size_type> sizes(&va);
+
+            for (size_type size = 1; size <= 2 * MAX_SIZE; ++size) {
+                char *block = static_cast<char *>(mX.allocate(size));
+                LOOP2_ASSERT(numPools, size, 0 != block);
+                LOOP2_ASSERT(numPools, size, isMaximallyAligned(block));
+
+                bsl::memset(block, static_cast<char>(size), size);
+                blocks.push_back(block);
+                sizes.push_back(size);
+            }
+
+            for (bsl::size_t i = 0; i < blocks.size(); ++i) {
+                const char VALUE = static_cast<char>(sizes[i]);
+                for (size_type j = 0; j < sizes[i]; ++j) {
+                    LOOP3_ASSERT(numPools, i, j, VALUE == blocks[i][j]);
+                }
+            }
+
+            for (bsl::size_t i = 0; i < blocks.size(); ++i) {
+                const size_type SIZE = sizes[i];
+                if (SIZE > MAX_SIZE) {
+                    const Int64 NUM_BLOCKS = ta.numBlocksInUse();
+                    mX.deallocate(blocks[i]);
+                    LOOP2_ASSERT(numPools, SIZE,
+                                 NUM_BLOCKS - 1 == ta.numBlocksInUse());
+
+                    blocks[i] = static_cast<char *>(mX.allocate(SIZE));
+                    LOOP2_ASSERT(numPools, SIZE,
+                                 NUM_BLOCKS == ta.numBlocksInUse());
+                    LOOP2_ASSERT(numPools, SIZE,
+                                 isMaximallyAligned(blocks[i]));
+                }
+                else {
+                    // Pick another size of the same size class.
+
+                    const size_type BLOCK_SIZE = pooledSize(SIZE);
+                    const size_type HALF_SIZE  = 8 == BLOCK_SIZE
+                                               ? 0
+                                               : BLOCK_SIZE / 2;
+                    const size_type OTHER_SIZE = HALF_SIZE + 1
+                                   + (SIZE * 3) % (BLOCK_SIZE - HALF_SIZE);
+                    mX.deallocate(blocks[i]);
+
+                    char *block = static_cast<char *>(
+                                                     mX.allocate(OTHER_SIZE));
+                    LOOP3_ASSERT(numPools, SIZE, OTHER_SIZE,
+                                 blocks[i] == block);
+                }
+            }
+
+            for (bsl::size_t i = 0; i < blocks.size(); ++i) {
+                mX.deallocate(blocks[i]);
+            }
+
+            const Int64 NUM_ALLOCATIONS = ta.numAllocations();
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+            ASSERT(NUM_ALLOCATIONS == ta.numAllocations());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 'numPools' and 'magazineCapacity' return the values specified at
+        //:   construction, or 'k_DEFAULT_NUM_POOLS' and
+        //:   'k_DEFAULT_MAGAZINE_CAPACITY'.
+        //:
+        //: 2 'maxPooledBlockSize' returns '2 ^ (numPools() + 2)'.
+        //:
+        //: 3 The allocator supplied at construction (or the default allocator)
+        //:   is used to supply memory.
+        //
+        // Plan:
+        //: 1 Create allocators with each constructor and verify the
+        //:   accessors.  (C-1..2)
+        //:
+        //: 2 Verify that memory is allocated from the test allocator supplied
+        //:   at construction, or from the default allocator.  (C-3)
+        //
+        // Testing:
+        //   CachingMultipoolAllocator(Allocator *);
+        //   CachingMultipoolAllocator(int, Allocator *);
+        //   CachingMultipoolAllocator(int, int, Allocator *);
+        //   bool isCaching() const;
+        //   int magazineCapacity() const;
+        //   size_type maxPooledBlockSize() const;
+        //   int numPools() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND ACCESSORS" << endl
+                          << "======================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+        bslma::TestAllocator         ta("test", veryVeryVerbose);
+
+        {
+            Obj mX;  const Obj& X = mX;
+            ASSERT(Obj::k_DEFAULT_NUM_POOLS         == X.numPools());
+            ASSERT(Obj::k_DEFAULT_MAGAZINE_CAPACITY == X.magazineCapacity());
+            ASSERT(4096 == X.maxPooledBlockSize());
+            ASSERT(X.isCaching());
+            ASSERT(0 < da.numBlocksInUse());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+
+        const Int64 NUM_DEFAULT_ALLOCATIONS = da.numAllocations();
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+            ASSERT(Obj::k_DEFAULT_NUM_POOLS         == X.numPools());
+            ASSERT(Obj::k_DEFAULT_MAGAZINE_CAPACITY == X.magazineCapacity());
+            ASSERT(0 < ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(NUM_DEFAULT_ALLOCATIONS == da.numAllocations());
+
+        for (int numPools = 1; numPools <= 28; ++numPools) {
+            const size_type MAX_SIZE = static_cast<size_type>(4) << numPools;
+            {
+                Obj mX(numPools, &ta);  const Obj& X = mX;
+                LOOP_ASSERT(numPools, numPools == X.numPools());
+                LOOP_ASSERT(numPools, Obj::k_DEFAULT_MAGAZINE_CAPACITY ==
+                                                         X.magazineCapacity());
+                LOOP_ASSERT(numPools, MAX_SIZE == X.maxPooledBlockSize());
+            }
+            for (int capacity = 1; capacity <= 64; capacity *= 4) {
+                Obj mX(numPools, capacity, &ta);  const Obj& X = mX;
+                LOOP2_ASSERT(numPools, capacity, numPools == X.numPools());
+                LOOP2_ASSERT(numPools, capacity,
+                             capacity == X.magazineCapacity());
+                LOOP2_ASSERT(numPools, capacity,
+                             MAX_SIZE == X.maxPooledBlockSize());
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate, fill, verify, and deallocate blocks of various sizes,
+        //:   and verify that all memory is returned on destruction.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   ~CachingMultipoolAllocator();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+        {
+            Obj mX(&ta);
+
+            const int SIZES[] = { 1, 7, 8, 9, 100, 1000, 4096, 4097, 10000 };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            char *blocks[NUM_SIZES];
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                blocks[i] = static_cast<char *>(mX.allocate(SIZES[i]));
+                bsl::memset(blocks[i], i, SIZES[i]);
+            }
+            for (int i = 0; i < NUM_SIZES; ++i) {
+                LOOP_ASSERT(i, i == blocks[i][0]);
+                LOOP_ASSERT(i, i == blocks[i][SIZES[i] - 1]);
+            }
+            for (int i = 0; i < NUM_SIZES; i += 2) {
+                mX.deallocate(blocks[i]);
+            }
+
+            // The remaining blocks are released on destruction.
+        }
+        ASSERT(0 <  ta.numAllocations());
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // ALLOCATION BENCHMARK
+        //
+        // Concerns:
+        //: 1 Allocating and deallocating blocks concurrently in many threads
+        //:   scales better with a 'bdlma::CachingMultipoolAllocator' than with
+        //:   a 'bdlma::ConcurrentMultipoolAllocator'.
+        //:
+        //: 2 Blocks allocated by a thread and deallocated by another one are
+        //:   handled efficiently.
+        //
+        // Plan:
+        //: 1 For an increasing number of threads, each holding a number of
+        //:   objects and replacing each object in turn, measure the time taken
+        //:   with a caching multipool allocator, a concurrent multipool
+        //:   allocator, and the new/delete allocator.  (C-1)
+        //:
+        //: 2 Measure the time taken by a producer thread passing batches of
+        //:   objects to a consumer thread deallocating them, with each
+        //:   allocator.  (C-2)
+        //
+        // Testing:
+        //   ALLOCATION BENCHMARK
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "ALLOCATION BENCHMARK" << endl
+             << "====================" << endl;
+
+        using namespace TEST_CASE_BENCHMARK;
+
+        const int k_NUM_OBJECTS    = argc > 2 ? atoi(argv[2]) : 1000;
+        const int k_NUM_ITERATIONS = 2000000;
+        const int k_NUM_BATCHES    = 20000;
+        const int k_BATCH_SIZE     = 100;
+
+        bslma::Allocator *nda = &bslma::NewDeleteAllocator::singleton();
+
+        cout << "objects per thread: " << k_NUM_OBJECTS << endl;
+
+        for (int numThreads = 1; numThreads <= 8; numThreads *= 2) {
+            double concurrentTime;
+            {
+                bdlma::ConcurrentMultipoolAllocator allocator;
+                concurrentTime = measureChurn(&allocator,
+                                              numThreads,
+                                              k_NUM_OBJECTS,
+                                              k_NUM_ITERATIONS);
+            }
+
+            double cachingTime;
+            {
+                Obj allocator;
+                cachingTime = measureChurn(&allocator,
+                                           numThreads,
+                                           k_NUM_OBJECTS,
+                                           k_NUM_ITERATIONS);
+            }
+
+            const double newDeleteTime = measureChurn(nda,
+                                                      numThreads,
+                                                      k_NUM_OBJECTS,
+                                                      k_NUM_ITERATIONS);
+
+            cout << "threads: " << numThreads
+                 << "\tconcurrent: " << concurrentTime << "s"
+                 << "\tcaching: "    << cachingTime    << "s"
+                 << "\tnew/delete: " << newDeleteTime  << "s" << endl;
+        }
+
+        double concurrentTime;
+        {
+            bdlma::ConcurrentMultipoolAllocator allocator;
+            concurrentTime = measureProducerConsumer(&allocator,
+                                                     k_NUM_BATCHES,
+                                                     k_BATCH_SIZE);
+        }
+
+        double cachingTime;
+        {
+            Obj allocator;
+            cachingTime = measureProducerConsumer(&allocator,
+                                                  k_NUM_BATCHES,
+                                                  k_BATCH_SIZE);
+        }
+
+        const double newDeleteTime = measureProducerConsumer(nda,
+                                                             k_NUM_BATCHES,
+                                                             k_BATCH_SIZE);
+
+        cout << "producer/consumer"
+             << "\tconcurrent: " << concurrentTime << "s"
+             << "\tcaching: "    << cachingTime    << "s"
+             << "\tnew/delete: " << newDeleteTime  << "s" << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
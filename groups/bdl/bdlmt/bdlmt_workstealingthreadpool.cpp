@@ -0,0 +1,641 @@
+// bdlmt_workstealingthreadpool.cpp                                   -*-C++-*-
+#include <bdlmt_workstealingthreadpool.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlmt_workstealingthreadpool_cpp,"$Id$ $CSID$")
+
+#include <bdlf_bind.h>
+
+#include <bslma_default.h>
+#include <bslma_deallocatorproctor.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bsls_assert.h>
+#include <bsls_performancehint.h>
+
+#include <bsl_memory.h>
+
+// IMPLEMENTATION NOTES: Each processing thread owns one
+// 'WorkStealingThreadPool_Deque' of heap-allocated 'Job' objects.  The deque
+// is the Chase-Lev deque in the form given by "Correct and Efficient
+// Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Zappa Nardelli,
+// 2013), using sequentially-consistent operations on the 'd_back' and
+// 'd_front' indices where that paper uses sequentially-consistent fences.
+// The deque stores pointers, so that a thief can read an element that the
+// owner may concurrently be overwriting (a race the thief detects by failing
+// its compare-and-swap of 'd_front') without undefined behavior.
+//
+// A processing thread whose own deque is empty is "searching" (counted by
+// 'd_numThreadsSearching') until it either finds a job elsewhere or gives up
+// and blocks on 'd_idleSemaphore'.  A thread about to block first stops
+// searching, then increments 'd_numThreadsWaiting', and then re-checks every
+// queue; an enqueuing thread first publishes its job and then, only if no
+// thread is searching, reads 'd_numThreadsWaiting' and posts the semaphore.
+// A searching thread that finds a job hands the search over by waking another
+// thread if it was the last searcher and work remains.  Because all of these
+// operations are sequentially consistent, some thread always either observes
+// a newly published job or is woken to look for it, while a burst of
+// enqueues wakes threads one at a time (as they find work) instead of waking
+// every idle thread, most of which would find nothing to do.  Spurious posts
+// merely cause an idle thread to re-scan the queues.
+
+namespace {
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+void initBlockSet(sigset_t *blockSet)
+{
+    sigfillset(blockSet);
+
+    const int synchronousSignals[] = {
+      SIGBUS,
+      SIGFPE,
+      SIGILL,
+      SIGSEGV,
+      SIGSYS,
+      SIGABRT,
+      SIGTRAP,
+     #if !defined(BSLS_PLATFORM_OS_CYGWIN) || defined(SIGIOT)
+      SIGIOT
+     #endif
+    };
+
+    const int SIZE = sizeof synchronousSignals / sizeof *synchronousSignals;
+
+    for (int i=0; i < SIZE; ++i) {
+        sigdelset(blockSet, synchronousSignals[i]);
+    }
+}
+#endif
+
+inline
+unsigned int nextRandom(unsigned int *state)
+    // Advance the specified xorshift 'state' and return its new value.  The
+    // behavior is undefined unless '0 != *state'.
+{
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+}  // close unnamed namespace
+
+namespace BloombergLP {
+namespace bdlmt {
+
+                     // ----------------------------------
+                     // class WorkStealingThreadPool_Deque
+                     // ----------------------------------
+
+// CREATORS
+WorkStealingThreadPool_Deque::WorkStealingThreadPool_Deque(
+                                              int               capacityLog2,
+                                              bslma::Allocator *basicAllocator)
+: d_front(0)
+, d_frontPad()
+, d_back(0)
+, d_backPad()
+, d_slots_p(0)
+, d_mask((static_cast<bsls::Types::Int64>(1) << capacityLog2) - 1)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 <= capacityLog2);
+    BSLS_ASSERT(30 >= capacityLog2);
+
+    const bsl::size_t capacity = static_cast<bsl::size_t>(d_mask + 1);
+
+    d_slots_p = static_cast<Slot *>(d_allocator_p->allocate(
+                                                   capacity * sizeof(Slot)));
+
+    for (bsl::size_t i = 0; i < capacity; ++i) {
+        bsls::AtomicOperations::initPointer(d_slots_p + i, 0);
+    }
+}
+
+WorkStealingThreadPool_Deque::~WorkStealingThreadPool_Deque()
+{
+    d_allocator_p->deallocate(d_slots_p);
+}
+
+// MANIPULATORS
+int WorkStealingThreadPool_Deque::pushBack(void *element)
+{
+    BSLS_ASSERT(element);
+
+    const bsls::Types::Int64 back  = d_back.loadRelaxed();
+    const bsls::Types::Int64 front = d_front.loadAcquire();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(back - front > d_mask)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return 1;                                                     // RETURN
+    }
+
+    bsls::AtomicOperations::setPtrRelaxed(d_slots_p + (back & d_mask),
+                                          element);
+
+    // A sequentially-consistent store (rather than a release store) is used
+    // so that the owner's subsequent check for idle threads cannot be
+    // reordered before the element is published.
+
+    d_back = back + 1;
+
+    return 0;
+}
+
+void *WorkStealingThreadPool_Deque::tryPopBack()
+{
+    const bsls::Types::Int64 back = d_back.loadRelaxed() - 1;
+
+    d_back = back;
+
+    const bsls::Types::Int64 front = d_front;
+
+    if (front > back) {
+        // The deque was empty.
+
+        d_back.storeRelaxed(back + 1);
+        return 0;                                                     // RETURN
+    }
+
+    void *element = bsls::AtomicOperations::getPtrRelaxed(
+                                                 d_slots_p + (back & d_mask));
+
+    if (front == back) {
+        // This is the last element; race against thieves for it.
+
+        if (front != d_front.testAndSwap(front, front + 1)) {
+            element = 0;
+        }
+        d_back.storeRelaxed(back + 1);
+    }
+
+    return element;
+}
+
+void *WorkStealingThreadPool_Deque::tryPopFront()
+{
+    const bsls::Types::Int64 front = d_front;
+    const bsls::Types::Int64 back  = d_back;
+
+    if (front >= back) {
+        return 0;                                                     // RETURN
+    }
+
+    void *element = bsls::AtomicOperations::getPtrRelaxed(
+                                                d_slots_p + (front & d_mask));
+
+    if (front != d_front.testAndSwap(front, front + 1)) {
+        // Lost the race with the owner or with another thief.
+
+        return 0;                                                     // RETURN
+    }
+
+    return element;
+}
+
+                        // ----------------------------
+                        // class WorkStealingThreadPool
+                        // ----------------------------
+
+// PRIVATE MANIPULATORS
+void WorkStealingThreadPool::deleteJob(Job *job)
+{
+    job->~Job();
+    d_jobPool.deallocate(job);
+}
+
+int WorkStealingThreadPool::enqueueImp(Job *job)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!d_enabled)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return 1;                                                     // RETURN
+    }
+
+    ++d_numPendingJobs;
+
+    const int index = static_cast<int>(reinterpret_cast<bsls::Types::IntPtr>(
+                           bslmt::ThreadUtil::getSpecific(d_workerKey))) - 1;
+
+    if (0 > index || 0 != d_deques[index]->pushBack(job)) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_injectionMutex);
+
+        d_injectionQueue.push_back(job);
+        ++d_injectionLength;
+    }
+
+    if (0 == d_numThreadsSearching && d_numThreadsWaiting) {
+        // No thread is looking for work; wake up a waiting thread.
+
+        d_idleSemaphore.post();
+    }
+
+    return 0;
+}
+
+void WorkStealingThreadPool::initialize()
+{
+    BSLS_ASSERT_OPT(1 <= d_numThreads);
+
+    disable();
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    initBlockSet(&d_blockSet);
+#endif
+
+    int rc = bslmt::ThreadUtil::createKey(&d_workerKey, 0);
+    BSLS_ASSERT_OPT(0 == rc);  (void)rc;
+
+    d_deques.reserve(d_numThreads);
+    for (int i = 0; i < d_numThreads; ++i) {
+        Deque *deque = new (*d_allocator_p) Deque(k_DEQUE_CAPACITY_LOG2,
+                                                  d_allocator_p);
+        d_deques.push_back(deque);
+    }
+}
+
+void WorkStealingThreadPool::removeAll()
+{
+    int numRemoved = 0;
+
+    for (int i = 0; i < d_numThreads; ++i) {
+        while (void *job = d_deques[i]->tryPopBack()) {
+            deleteJob(static_cast<Job *>(job));
+            ++numRemoved;
+        }
+    }
+
+    while (Job *job = tryPopInjected(0)) {
+        deleteJob(job);
+        ++numRemoved;
+    }
+
+    if (numRemoved && 0 == d_numPendingJobs.add(-numRemoved)) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_drainMutex);
+        d_drainCondition.broadcast();
+    }
+}
+
+void WorkStealingThreadPool::runJob(Job *job)
+{
+    (*job)();
+    deleteJob(job);
+
+    if (0 == --d_numPendingJobs) {
+        bslmt::LockGuard<bslmt::Mutex> lock(&d_drainMutex);
+        d_drainCondition.broadcast();
+    }
+}
+
+WorkStealingThreadPool::Job *
+WorkStealingThreadPool::tryPopInjected(Deque *ownDeque)
+{
+    if (0 == d_injectionLength.loadRelaxed()) {
+        return 0;                                                     // RETURN
+    }
+
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_injectionMutex);
+
+    if (d_injectionQueue.empty()) {
+        return 0;                                                     // RETURN
+    }
+
+    Job *job = d_injectionQueue.front();
+    d_injectionQueue.pop_front();
+
+    int numTaken = 1;
+
+    if (ownDeque) {
+        // Move this thread's share of the remaining jobs, up to a limit, to
+        // its deque, where other threads can steal them without taking
+        // 'd_injectionMutex'.
+
+        int numToMove = static_cast<int>(d_injectionQueue.size())
+                                                                / d_numThreads;
+        if (numToMove > k_INJECTION_BATCH_SIZE) {
+            numToMove = k_INJECTION_BATCH_SIZE;
+        }
+
+        for (; numToMove > 0; --numToMove, ++numTaken) {
+            if (0 != ownDeque->pushBack(d_injectionQueue.front())) {
+                break;
+            }
+            d_injectionQueue.pop_front();
+        }
+    }
+
+    d_injectionLength.add(-numTaken);
+
+    return job;
+}
+
+void WorkStealingThreadPool::workerThread(int index)
+{
+    bslmt::ThreadUtil::setSpecific(
+                         d_workerKey,
+                         reinterpret_cast<void *>(
+                                 static_cast<bsls::Types::IntPtr>(index + 1)));
+
+    Deque        *ownDeque    = d_deques[index];
+    unsigned int  randomSeed  = 2654435761U * (index + 1);
+    bool          isSearching = false;
+
+    while (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(
+                                        e_RUN == d_control.loadRelaxed())) {
+        void *job = ownDeque->tryPopBack();
+
+        if (!job) {
+            if (!isSearching) {
+                isSearching = true;
+                ++d_numThreadsSearching;
+            }
+
+            job = tryPopInjected(ownDeque);
+
+            if (!job && 1 < d_numThreads) {
+                // Steal from randomly chosen victims, making (at least) as
+                // many attempts as there are other threads.
+
+                const unsigned int numVictims = d_numThreads - 1;
+
+                for (unsigned int i = 0; !job && i < 2 * numVictims; ++i) {
+                    int victim = static_cast<int>(nextRandom(&randomSeed)
+                                                                % numVictims);
+                    if (victim >= index) {
+                        ++victim;
+                    }
+                    job = d_deques[victim]->tryPopFront();
+                }
+
+                if (job) {
+                    d_numStolenJobs.addRelaxed(1);
+                }
+            }
+
+            if (job) {
+                // This thread stops searching.  If it was the last searching
+                // thread and there is more work, wake another thread to take
+                // over the search.
+
+                isSearching = false;
+                if (0 == --d_numThreadsSearching
+                 && d_numThreadsWaiting
+                 && isWorkAvailable()) {
+                    d_idleSemaphore.post();
+                }
+            }
+        }
+
+        if (job) {
+            runJob(static_cast<Job *>(job));
+        }
+        else {
+            isSearching = false;
+            --d_numThreadsSearching;
+
+            ++d_numThreadsWaiting;
+
+            if (e_RUN == d_control && !isWorkAvailable()) {
+                d_idleSemaphore.wait();
+            }
+
+            d_numThreadsWaiting.addRelaxed(-1);
+        }
+    }
+
+    if (isSearching) {
+        --d_numThreadsSearching;
+    }
+
+    bslmt::ThreadUtil::setSpecific(d_workerKey, 0);
+}
+
+int WorkStealingThreadPool::startNewThread(int index)
+{
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    // Block all asynchronous signals.
+
+    sigset_t oldset;
+    pthread_sigmask(SIG_BLOCK, &d_blockSet, &oldset);
+#endif
+
+    int rc = d_threadGroup.addThread(
+                    bdlf::BindUtil::bind(&WorkStealingThreadPool::workerThread,
+                                         this,
+                                         index),
+                    d_threadAttributes);
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    // Restore the mask.
+
+    pthread_sigmask(SIG_SETMASK, &oldset, &d_blockSet);
+#endif
+
+    return rc;
+}
+
+void WorkStealingThreadPool::wakeAll()
+{
+    d_idleSemaphore.post(d_numThreads);
+}
+
+// PRIVATE ACCESSORS
+bool WorkStealingThreadPool::isWorkAvailable() const
+{
+    if (d_injectionLength) {
+        return true;                                                  // RETURN
+    }
+
+    for (int i = 0; i < d_numThreads; ++i) {
+        if (!d_deques[i]->isEmpty()) {
+            return true;                                              // RETURN
+        }
+    }
+
+    return false;
+}
+
+// CREATORS
+WorkStealingThreadPool::WorkStealingThreadPool(
+                                              int               numThreads,
+                                              bslma::Allocator *basicAllocator)
+: d_jobPool(sizeof(Job), basicAllocator)
+, d_deques(basicAllocator)
+, d_injectionQueue(basicAllocator)
+, d_injectionLength(0)
+, d_numPendingJobs(0)
+, d_numStolenJobs(0)
+, d_idleSemaphore(0)
+, d_numThreadsWaiting(0)
+, d_numThreadsSearching(0)
+, d_control(e_STOP)
+, d_enabled(false)
+, d_threadGroup(basicAllocator)
+, d_numThreads(numThreads)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize();
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+                             const bslmt::ThreadAttributes&  threadAttributes,
+                             int                             numThreads,
+                             bslma::Allocator               *basicAllocator)
+: d_jobPool(sizeof(Job), basicAllocator)
+, d_deques(basicAllocator)
+, d_injectionQueue(basicAllocator)
+, d_injectionLength(0)
+, d_numPendingJobs(0)
+, d_numStolenJobs(0)
+, d_idleSemaphore(0)
+, d_numThreadsWaiting(0)
+, d_numThreadsSearching(0)
+, d_control(e_STOP)
+, d_enabled(false)
+, d_threadGroup(basicAllocator)
+, d_threadAttributes(threadAttributes)
+, d_numThreads(numThreads)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    initialize();
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    shutdown();
+    removeAll();
+
+    for (int i = 0; i < d_numThreads; ++i) {
+        d_allocator_p->deleteObjectRaw(d_deques[i]);
+    }
+
+    bslmt::ThreadUtil::deleteKey(d_workerKey);
+}
+
+// MANIPULATORS
+int WorkStealingThreadPool::enqueueJob(const Job& functor)
+{
+    BSLS_ASSERT(functor);
+
+    void *memory = d_jobPool.allocate();
+    bslma::DeallocatorProctor<bdlma::ConcurrentPool> proctor(memory,
+                                                             &d_jobPool);
+
+    Job *job = new (memory) Job(bsl::allocator_arg, d_allocator_p, functor);
+    proctor.release();
+
+    const int rc = enqueueImp(job);
+    if (rc) {
+        deleteJob(job);
+    }
+    return rc;
+}
+
+int WorkStealingThreadPool::enqueueJob(WorkStealingThreadPoolJobFunc  function,
+                                       void                          *userData)
+{
+    BSLS_ASSERT(function);
+
+    void *memory = d_jobPool.allocate();
+    bslma::DeallocatorProctor<bdlma::ConcurrentPool> proctor(memory,
+                                                             &d_jobPool);
+
+    Job *job = new (memory) Job(bsl::allocator_arg,
+                                d_allocator_p,
+                                bdlf::BindUtil::bindR<void>(function,
+                                                            userData));
+    proctor.release();
+
+    const int rc = enqueueImp(job);
+    if (rc) {
+        deleteJob(job);
+    }
+    return rc;
+}
+
+void WorkStealingThreadPool::drain()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_drainMutex);
+
+    while (d_numPendingJobs) {
+        d_drainCondition.wait(&d_drainMutex);
+    }
+}
+
+void WorkStealingThreadPool::shutdown()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    if (e_RUN == d_control.loadRelaxed()) {
+        disable();
+        d_control = e_STOP;
+
+        wakeAll();
+        d_threadGroup.joinAll();
+
+        removeAll();
+    }
+}
+
+int WorkStealingThreadPool::start()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    if (e_STOP != d_control.loadRelaxed()) {
+        return 0;                                                     // RETURN
+    }
+
+    d_control = e_RUN;
+
+    for (int i = 0; i < d_numThreads; ++i)  {
+        if (0 != startNewThread(i)) {
+            d_control = e_STOP;
+
+            wakeAll();
+            d_threadGroup.joinAll();
+            return -1;                                                // RETURN
+        }
+    }
+
+    enable();
+
+    return 0;
+}
+
+void WorkStealingThreadPool::stop()
+{
+    bslmt::LockGuard<bslmt::Mutex> lock(&d_metaMutex);
+
+    if (e_RUN == d_control.loadRelaxed()) {
+        disable();
+        drain();
+
+        d_control = e_STOP;
+
+        wakeAll();
+        d_threadGroup.joinAll();
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------------------------------------------------------
@@ -0,0 +1,715 @@
+// bdlmt_workstealingthreadpool.h                                     -*-C++-*-
+#ifndef INCLUDED_BDLMT_WORKSTEALINGTHREADPOOL
+#define INCLUDED_BDLMT_WORKSTEALINGTHREADPOOL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a fixed-size thread pool with per-thread work stealing.
+//
+//@CLASSES:
+//  bdlmt::WorkStealingThreadPool: fixed-size work-stealing thread pool
+//
+//@SEE_ALSO: bdlmt_fixedthreadpool, bdlmt_threadpool
+//
+//@DESCRIPTION: This component defines a thread pool,
+// 'bdlmt::WorkStealingThreadPool', that executes user-supplied functions
+// ("jobs") on a fixed number of processing threads, and that is optimized for
+// workloads consisting of many short jobs, and in particular for jobs that
+// themselves enqueue further jobs (e.g., fan-out/fan-in or divide-and-conquer
+// algorithms).
+//
+// Both 'bdlmt::ThreadPool' and 'bdlmt::FixedThreadPool' deliver every job
+// through a single queue that is shared by all of the processing threads.
+// When jobs are short, that queue becomes the point of contention that limits
+// throughput.  'bdlmt::WorkStealingThreadPool' instead gives each processing
+// thread its own double-ended queue of jobs (a "Chase-Lev" deque).  A job
+// enqueued by a job running in one of the pool's own threads is pushed onto
+// the back of that thread's deque, without contending with any other thread.
+// Each processing thread takes jobs from the back of its own deque (i.e., in
+// LIFO order, which keeps recently produced data in cache), and, when its
+// deque is empty, takes a job from a shared injection queue or "steals" the
+// oldest job from the front of the deque of another, randomly chosen,
+// processing thread.  Jobs enqueued from threads that are not managed by the
+// pool (and jobs that do not fit in a full per-thread deque) are appended to
+// the shared injection queue.
+//
+// Note that, as a consequence, jobs are *not* executed in the order in which
+// they were enqueued.  Applications that require FIFO ordering of jobs should
+// use 'bdlmt::FixedThreadPool' or 'bdlmt::ThreadPool' instead.
+//
+// The lifecycle of a 'bdlmt::WorkStealingThreadPool' follows that of
+// 'bdlmt::FixedThreadPool': the pool is created in the stopped, disabled
+// state; 'start' creates the processing threads and enables enqueuing;
+// 'drain' blocks until all enqueued jobs (including any jobs enqueued by
+// those jobs) have completed; 'stop' disables enqueuing, drains the pool, and
+// joins the processing threads; and 'shutdown' disables enqueuing, joins the
+// processing threads after their currently running jobs complete, and
+// discards any jobs that have not yet started.
+//
+///Thread Safety
+///-------------
+// The 'bdlmt::WorkStealingThreadPool' class is both *fully thread-safe*
+// (i.e., all non-creator methods can correctly execute concurrently), and is
+// *thread-enabled* (i.e., the class does not function correctly in a
+// non-multi-threading environment).  See 'bsldoc_glossary' for complete
+// definitions of *fully thread-safe* and *thread-enabled*.
+//
+// Note that 'drain', 'stop', and 'shutdown' must not be called from a job
+// executing in the pool; doing so results in deadlock.
+//
+///Synchronous Signals on Unix
+///---------------------------
+// A thread pool ensures that, on unix platforms, all the threads in the pool
+// block all asynchronous signals.  Specifically all the signals, except the
+// following synchronous signals are blocked:
+//..
+// SIGBUS
+// SIGFPE
+// SIGILL
+// SIGSEGV
+// SIGSYS
+// SIGABRT
+// SIGTRAP
+// SIGIOT
+//..
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Parallel Recursive Summation
+///- - - - - - - - - - - - - - - - - - - -
+// In this example we use a 'bdlmt::WorkStealingThreadPool' to sum the
+// elements of a large array by recursively splitting the array in half until
+// the ranges are small enough to be summed directly.  Each split enqueues a
+// job for one half; because the split is performed from within a job, the new
+// job is pushed on the deque of the processing thread that performed the
+// split, where it is available to be stolen by idle threads.
+//
+// First, we define a structure that describes one range to be summed, and the
+// function that processes it:
+//..
+//  struct SumJob {
+//      // This 'struct' describes a range of integers to be summed, and the
+//      // location that accumulates the result.
+//
+//      bdlmt::WorkStealingThreadPool *d_pool_p;     // pool to split into
+//      const int                     *d_begin_p;    // first element
+//      const int                     *d_end_p;      // one past last element
+//      bsls::AtomicInt64             *d_result_p;   // accumulated result
+//  };
+//
+//  void sumRange(SumJob job)
+//      // Add the sum of the range described by the specified 'job' to
+//      // '*job.d_result_p', enqueuing one half of the range as a separate job
+//      // on 'job.d_pool_p' if the range is large.
+//  {
+//      enum { k_GRAIN = 1024 };
+//
+//      while (job.d_end_p - job.d_begin_p > k_GRAIN) {
+//          SumJob half(job);
+//          half.d_begin_p = job.d_begin_p + (job.d_end_p - job.d_begin_p) / 2;
+//          job.d_end_p    = half.d_begin_p;
+//
+//          job.d_pool_p->enqueueJob(bdlf::BindUtil::bind(&sumRange, half));
+//      }
+//
+//      bsls::Types::Int64 sum = 0;
+//      for (const int *p = job.d_begin_p; p != job.d_end_p; ++p) {
+//          sum += *p;
+//      }
+//      job.d_result_p->add(sum);
+//  }
+//..
+// Then, we create and start a pool with four processing threads:
+//..
+//  bdlmt::WorkStealingThreadPool pool(4);
+//  int rc = pool.start();
+//  assert(0 == rc);
+//..
+// Next, we create the data to be summed:
+//..
+//  bsl::vector<int> data(1 << 20);
+//  for (bsl::size_t i = 0; i < data.size(); ++i) {
+//      data[i] = static_cast<int>(i % 100);
+//  }
+//..
+// Now, we enqueue a single job describing the whole array, and wait for it,
+// and all the jobs it spawns, to complete:
+//..
+//  bsls::AtomicInt64 result(0);
+//
+//  SumJob job = { &pool, &data[0], &data[0] + data.size(), &result };
+//  rc = pool.enqueueJob(bdlf::BindUtil::bind(&sumRange, job));
+//  assert(0 == rc);
+//
+//  pool.drain();
+//..
+// Finally, we verify the result and stop the pool:
+//..
+//  bsls::Types::Int64 expected = 0;
+//  for (bsl::size_t i = 0; i < data.size(); ++i) {
+//      expected += data[i];
+//  }
+//  assert(expected == result);
+//
+//  pool.stop();
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_CONCURRENTPOOL
+#include <bdlma_concurrentpool.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_CONDITION
+#include <bslmt_condition.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_PLATFORM
+#include <bslmt_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_SEMAPHORE
+#include <bslmt_semaphore.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADATTRIBUTES
+#include <bslmt_threadattributes.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADGROUP
+#include <bslmt_threadgroup.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMICOPERATIONS
+#include <bsls_atomicoperations.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_DEQUE
+#include <bsl_deque.h>
+#endif
+
+#ifndef INCLUDED_BSL_FUNCTIONAL
+#include <bsl_functional.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+#ifndef INCLUDED_BSL_C_SIGNAL
+#include <bsl_c_signal.h>              // sigset_t
+#endif
+#endif
+
+namespace BloombergLP {
+namespace bdlmt {
+
+extern "C" typedef void (*WorkStealingThreadPoolJobFunc)(void *);
+    // This type declares the prototype for functions that are suitable to be
+    // specified 'bdlmt::WorkStealingThreadPool::enqueueJob'.
+
+                     // ==================================
+                     // class WorkStealingThreadPool_Deque
+                     // ==================================
+
+class WorkStealingThreadPool_Deque {
+    // [!PRIVATE!] This class implements a fixed-capacity, lock-free,
+    // single-owner, multiple-thief double-ended queue of non-null pointers
+    // (the "Chase-Lev" deque, as formulated for weak memory models by Le,
+    // Pop, Cohen, and Zappa Nardelli).  Exactly one thread, the owner, may
+    // call 'pushBack' and 'tryPopBack'; any thread may call 'tryPopFront'
+    // (i.e., steal) concurrently with the owner and with other thieves.
+
+    // PRIVATE TYPES
+    typedef bsls::AtomicOperations::AtomicTypes::Pointer Slot;
+
+    // PRIVATE CONSTANTS
+    enum {
+        k_INT64_PADDING = bslmt::Platform::e_CACHE_LINE_SIZE -
+                                                     sizeof(bsls::AtomicInt64)
+    };
+
+    // DATA
+    bsls::AtomicInt64   d_front;           // index of the oldest element,
+                                           // advanced by thieves and by the
+                                           // owner when taking the last
+                                           // element
+
+    const char          d_frontPad[k_INT64_PADDING];
+                                           // padding to prevent false sharing
+
+    bsls::AtomicInt64   d_back;            // index one past the newest
+                                           // element, modified only by the
+                                           // owner
+
+    const char          d_backPad[k_INT64_PADDING];
+                                           // padding to prevent false sharing
+
+    Slot               *d_slots_p;         // circular array of elements
+
+    bsls::Types::Int64  d_mask;            // 'capacity() - 1'
+
+    bslma::Allocator   *d_allocator_p;     // memory allocator (held, not
+                                           // owned)
+
+  private:
+    // NOT IMPLEMENTED
+    WorkStealingThreadPool_Deque(const WorkStealingThreadPool_Deque&);
+    WorkStealingThreadPool_Deque& operator=(
+                                          const WorkStealingThreadPool_Deque&);
+
+  public:
+    // CREATORS
+    explicit
+    WorkStealingThreadPool_Deque(int               capacityLog2,
+                                 bslma::Allocator *basicAllocator = 0);
+        // Create an empty deque able to hold '1 << capacityLog2' elements.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 <= capacityLog2 <= 30'.
+
+    ~WorkStealingThreadPool_Deque();
+        // Destroy this deque.  Note that the pointers held by this deque, if
+        // any, are not deallocated.
+
+    // MANIPULATORS
+    int pushBack(void *element);
+        // Append the specified 'element' to the back of this deque.  Return 0
+        // on success, and a non-zero value if this deque is full.  The
+        // behavior is undefined unless this method is called by the owner of
+        // this deque and '0 != element'.
+
+    void *tryPopBack();
+        // Remove the element at the back of this deque and return it, or
+        // return 0 if this deque is empty.  The behavior is undefined unless
+        // this method is called by the owner of this deque.
+
+    void *tryPopFront();
+        // Remove the element at the front of this deque and return it, or
+        // return 0 if this deque is empty or if the front element was
+        // concurrently removed by another thread.  This method may be called
+        // from any thread.
+
+    // ACCESSORS
+    int capacity() const;
+        // Return the maximum number of elements this deque can hold.
+
+    bool isEmpty() const;
+        // Return 'true' if this deque contained no elements at some point
+        // during this call, and 'false' otherwise.
+
+    int length() const;
+        // Return a snapshot of the number of elements in this deque.
+};
+
+                        // ============================
+                        // class WorkStealingThreadPool
+                        // ============================
+
+class WorkStealingThreadPool {
+    // This class implements a fixed-size thread pool used for concurrently
+    // executing multiple user-defined functions ("jobs"), in which each
+    // processing thread has its own queue of jobs and idle threads steal jobs
+    // from busy ones.
+
+  public:
+    // TYPES
+    typedef bsl::function<void()> Job;
+
+    enum {
+        e_STOP
+      , e_RUN
+    };
+
+  private:
+    // PRIVATE TYPES
+    typedef WorkStealingThreadPool_Deque Deque;
+
+    // PRIVATE CONSTANTS
+    enum {
+        k_DEQUE_CAPACITY_LOG2  = 12,  // log2 of each per-thread deque
+                                      // capacity
+
+        k_INJECTION_BATCH_SIZE = 32   // maximum number of jobs moved from
+                                      // the injection queue to a deque at
+                                      // once
+    };
+
+    // DATA
+    bdlma::ConcurrentPool        d_jobPool;          // memory for queued
+                                                     // 'Job' objects
+
+    bsl::vector<Deque *>         d_deques;           // per-thread deques,
+                                                     // indexed by thread
+
+    bsl::deque<Job *>            d_injectionQueue;   // jobs enqueued by
+                                                     // threads not managed by
+                                                     // this pool
+
+    bslmt::Mutex                 d_injectionMutex;   // protects
+                                                     // 'd_injectionQueue'
+
+    bsls::AtomicInt              d_injectionLength;  // length of
+                                                     // 'd_injectionQueue',
+                                                     // readable without the
+                                                     // lock
+
+    bsls::AtomicInt              d_numPendingJobs;   // number of enqueued jobs
+                                                     // that have not completed
+
+    bsls::AtomicInt64            d_numStolenJobs;    // number of jobs executed
+                                                     // by a thread other than
+                                                     // the one they were
+                                                     // enqueued on
+
+    bslmt::Semaphore             d_idleSemaphore;    // idle threads wait here
+
+    bsls::AtomicInt              d_numThreadsWaiting;
+                                                     // number of idle threads
+
+    bsls::AtomicInt              d_numThreadsSearching;
+                                                     // number of threads
+                                                     // looking for a job
+                                                     // outside their own deque
+
+    bslmt::Mutex                 d_drainMutex;       // used with
+                                                     // 'd_drainCondition'
+
+    bslmt::Condition             d_drainCondition;   // signaled when
+                                                     // 'd_numPendingJobs'
+                                                     // becomes 0
+
+    bslmt::Mutex                 d_metaMutex;        // ensures that there is
+                                                     // only one controlling
+                                                     // thread at any time
+
+    bsls::AtomicInt              d_control;          // 'e_RUN' or 'e_STOP'
+
+    bsls::AtomicBool             d_enabled;          // 'true' if enqueuing is
+                                                     // permitted
+
+    bslmt::ThreadUtil::Key       d_workerKey;        // thread-specific key
+                                                     // holding '1 + index' of
+                                                     // the current processing
+                                                     // thread
+
+    bslmt::ThreadGroup           d_threadGroup;      // processing threads
+
+    bslmt::ThreadAttributes      d_threadAttributes; // attributes of the
+                                                     // processing threads
+
+    const int                    d_numThreads;       // number of configured
+                                                     // processing threads
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    sigset_t                     d_blockSet;         // set of signals to be
+                                                     // blocked in managed
+                                                     // threads
+#endif
+
+    bslma::Allocator            *d_allocator_p;      // memory allocator (held,
+                                                     // not owned)
+
+    // PRIVATE MANIPULATORS
+    void deleteJob(Job *job);
+        // Destroy the specified 'job' and return its memory to the job pool.
+
+    int enqueueImp(Job *job);
+        // Enqueue the specified 'job', taking ownership of it, and wake an
+        // idle processing thread if there is one.  Return 0 on success, and a
+        // non-zero value (without taking ownership of 'job') if enqueuing is
+        // disabled.
+
+    void initialize();
+        // Create the per-thread deques and the thread-specific key of this
+        // pool.  Note that this method is called only from the constructors.
+
+    void removeAll();
+        // Destroy, without executing, all jobs remaining in the queues of
+        // this pool.  The behavior is undefined unless no processing thread is
+        // running.
+
+    void runJob(Job *job);
+        // Execute and then destroy the specified 'job', and signal any
+        // threads blocked in 'drain' if it was the last pending job.
+
+    Job *tryPopInjected(Deque *ownDeque);
+        // Remove and return the job at the front of the injection queue, or
+        // return 0 if that queue is empty.  If the specified 'ownDeque' is not
+        // 0, also move a share of the other jobs in the injection queue to the
+        // back of 'ownDeque'.  The behavior is undefined unless 'ownDeque' is
+        // 0 or is the deque of the calling processing thread.
+
+    void workerThread(int index);
+        // The main function executed by the processing thread having the
+        // specified 'index'.
+
+    int startNewThread(int index);
+        // Spawn the processing thread having the specified 'index'.  Return 0
+        // on success, and a non-zero value otherwise.  Note that this method
+        // must be called with 'd_metaMutex' locked.
+
+    void wakeAll();
+        // Wake every idle processing thread.
+
+    // PRIVATE ACCESSORS
+    bool isWorkAvailable() const;
+        // Return 'true' if the injection queue or the deque of any processing
+        // thread was observed to be non-empty during this call, and 'false'
+        // otherwise.
+
+    // NOT IMPLEMENTED
+    WorkStealingThreadPool(const WorkStealingThreadPool&);
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(WorkStealingThreadPool,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    WorkStealingThreadPool(int               numThreads,
+                           bslma::Allocator *basicAllocator = 0);
+        // Construct a thread pool with the specified 'numThreads' number of
+        // processing threads.  Optionally specify a 'basicAllocator' used to
+        // supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  The behavior is undefined unless
+        // '1 <= numThreads'.
+
+    WorkStealingThreadPool(const bslmt::ThreadAttributes&  threadAttributes,
+                           int                             numThreads,
+                           bslma::Allocator               *basicAllocator = 0);
+        // Construct a thread pool with the specified 'threadAttributes' and
+        // 'numThreads' number of processing threads.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.  The behavior is
+        // undefined unless '1 <= numThreads'.
+
+    ~WorkStealingThreadPool();
+        // Discard all pending jobs without executing them, block until all
+        // currently running jobs complete, and then destroy this thread pool.
+
+    // MANIPULATORS
+    void disable();
+        // Disable enqueuing into this pool.  All subsequent invocations of
+        // 'enqueueJob' will fail immediately.  If the pool is already
+        // disabled, this method has no effect.  Note that jobs enqueued
+        // before this call are unaffected.
+
+    void enable();
+        // Enable enqueuing into this pool.  If the pool is already enabled,
+        // this method has no effect.
+
+    int enqueueJob(const Job& functor);
+        // Enqueue the specified 'functor' to be executed by one of the
+        // processing threads.  If called from a job executing in one of this
+        // pool's processing threads, the job is enqueued on the deque of that
+        // thread; otherwise it is enqueued on the shared injection queue.
+        // Return 0 if enqueuing succeeded, and a non-zero value if enqueuing
+        // is disabled.  The behavior is undefined unless 'functor' is not
+        // "unset".  See 'bsl::function' for more information on functors.
+
+    int enqueueJob(WorkStealingThreadPoolJobFunc  function,
+                   void                          *userData);
+        // Enqueue the specified 'function' to be executed by one of the
+        // processing threads, with the specified 'userData' as its argument.
+        // Return 0 if enqueuing succeeded, and a non-zero value if enqueuing
+        // is disabled.  The behavior is undefined unless '0 != function'.
+
+    void drain();
+        // Block until all jobs enqueued into this pool, including any jobs
+        // enqueued by those jobs, have completed.  Note that this method does
+        // not disable enqueuing.  The behavior is undefined if this method is
+        // called from a job executing in this pool.
+
+    void shutdown();
+        // Disable enqueuing into this pool, block until all currently
+        // executing jobs complete, and join the processing threads.  Jobs
+        // that have not started executing are discarded.  If the pool is not
+        // started, this method has no effect.  The behavior is undefined if
+        // this method is called from a job executing in this pool.
+
+    int start();
+        // Spawn the processing threads of this pool and enable enqueuing.
+        // Return 0 on success, and a non-zero value otherwise.  If the pool is
+        // already started, this method has no effect.  Note that, on failure,
+        // the pool remains stopped and disabled.
+
+    void stop();
+        // Disable enqueuing into this pool, block until all enqueued jobs
+        // have completed, and join the processing threads.  If the pool is
+        // not started, this method has no effect.  Note that, since enqueuing
+        // is disabled first, jobs that attempt to enqueue further jobs while
+        // the pool is stopping will fail to do so; call 'drain' before 'stop'
+        // to let such jobs run to completion.  The behavior is undefined if
+        // this method is called from a job executing in this pool.
+
+    // ACCESSORS
+    bool isEnabled() const;
+        // Return 'true' if enqueuing into this pool is enabled, and 'false'
+        // otherwise.
+
+    bool isStarted() const;
+        // Return 'true' if the processing threads of this pool are running,
+        // and 'false' otherwise.
+
+    int numPendingJobs() const;
+        // Return a snapshot of the number of jobs that have been enqueued
+        // into this pool and have not yet completed, including jobs that are
+        // currently executing.
+
+    bsls::Types::Int64 numStolenJobs() const;
+        // Return the number of jobs that have been taken from the deque of a
+        // processing thread by a different processing thread since this pool
+        // was created.
+
+    int numThreads() const;
+        // Return the number of processing threads configured for this pool.
+
+    int numThreadsStarted() const;
+        // Return the number of processing threads that have been started.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                     // ----------------------------------
+                     // class WorkStealingThreadPool_Deque
+                     // ----------------------------------
+
+// ACCESSORS
+inline
+int WorkStealingThreadPool_Deque::capacity() const
+{
+    return static_cast<int>(d_mask + 1);
+}
+
+inline
+bool WorkStealingThreadPool_Deque::isEmpty() const
+{
+    return d_back <= d_front;
+}
+
+inline
+int WorkStealingThreadPool_Deque::length() const
+{
+    const bsls::Types::Int64 length = d_back - d_front;
+    return length > 0 ? static_cast<int>(length) : 0;
+}
+
+                        // ----------------------------
+                        // class WorkStealingThreadPool
+                        // ----------------------------
+
+// MANIPULATORS
+inline
+void WorkStealingThreadPool::disable()
+{
+    d_enabled = false;
+}
+
+inline
+void WorkStealingThreadPool::enable()
+{
+    d_enabled = true;
+}
+
+// ACCESSORS
+inline
+bool WorkStealingThreadPool::isEnabled() const
+{
+    return d_enabled;
+}
+
+inline
+bool WorkStealingThreadPool::isStarted() const
+{
+    return e_RUN == d_control.loadRelaxed();
+}
+
+inline
+int WorkStealingThreadPool::numPendingJobs() const
+{
+    return d_numPendingJobs;
+}
+
+inline
+bsls::Types::Int64 WorkStealingThreadPool::numStolenJobs() const
+{
+    return d_numStolenJobs;
+}
+
+inline
+int WorkStealingThreadPool::numThreads() const
+{
+    return d_numThreads;
+}
+
+inline
+int WorkStealingThreadPool::numThreadsStarted() const
+{
+    return d_threadGroup.numThreads();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------------------------------------------------------
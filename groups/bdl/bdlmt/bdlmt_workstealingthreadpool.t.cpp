@@ -0,0 +1,1112 @@
+// bdlmt_workstealingthreadpool.t.cpp                                 -*-C++-*-
+
+#include <bdlmt_workstealingthreadpool.h>
+
+#include <bdlmt_fixedthreadpool.h>
+#include <bdlmt_threadpool.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatormonitor.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_semaphore.h>
+#include <bslmt_threadgroup.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_atomic.h>
+#include <bsls_platform.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bdlf_bind.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+#include <bsl_c_signal.h>
+#endif
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test consists of a component-private lock-free deque,
+// 'bdlmt::WorkStealingThreadPool_Deque', and a thread pool,
+// 'bdlmt::WorkStealingThreadPool', built on it.  The deque is tested first in
+// isolation, both single-threaded (to verify its LIFO/FIFO semantics and its
+// capacity limit) and with concurrent thieves (to verify that every element
+// is removed exactly once).  The pool is then tested for its lifecycle
+// ('start', 'stop', 'shutdown', 'enable', and 'disable'), for the execution
+// of jobs enqueued both from outside and from inside the pool (including jobs
+// that overflow a per-thread deque), and for the blocking of asynchronous
+// signals in its processing threads.
+//
+// In addition to the positive test cases, a negative test case -1 can be run
+// manually to compare the throughput of this pool against
+// 'bdlmt::FixedThreadPool' and 'bdlmt::ThreadPool' on fan-out/fan-in
+// workloads.
+// ----------------------------------------------------------------------------
+// WorkStealingThreadPool_Deque
+// [ 2] WorkStealingThreadPool_Deque(int capacityLog2, basicAllocator);
+// [ 2] int pushBack(void *element);
+// [ 2] void *tryPopBack();
+// [ 2] void *tryPopFront();
+// [ 2] int capacity() const;
+// [ 2] bool isEmpty() const;
+// [ 2] int length() const;
+//
+// WorkStealingThreadPool
+// [ 4] explicit WorkStealingThreadPool(int numThreads, basicAllocator);
+// [ 4] WorkStealingThreadPool(attributes, numThreads, basicAllocator);
+// [ 4] ~WorkStealingThreadPool();
+// [ 4] void disable();
+// [ 4] void enable();
+// [ 5] int enqueueJob(const Job& functor);
+// [ 5] int enqueueJob(WorkStealingThreadPoolJobFunc func, void *data);
+// [ 5] void drain();
+// [ 4] void shutdown();
+// [ 4] int start();
+// [ 4] void stop();
+// [ 4] bool isEnabled() const;
+// [ 4] bool isStarted() const;
+// [ 5] int numPendingJobs() const;
+// [ 6] bsls::Types::Int64 numStolenJobs() const;
+// [ 4] int numThreads() const;
+// [ 4] int numThreadsStarted() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] CONCURRENT STEALING FROM A DEQUE
+// [ 6] JOBS ENQUEUING JOBS
+// [ 7] SYNCHRONOUS SIGNALS
+// [ 8] USAGE EXAMPLE
+// [-1] FAN-OUT/FAN-IN THROUGHPUT
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+bool             verbose;
+bool         veryVerbose;
+bool     veryVeryVerbose;
+bool veryVeryVeryVerbose;
+
+typedef bdlmt::WorkStealingThreadPool       Obj;
+typedef bdlmt::WorkStealingThreadPool_Deque Deque;
+
+// ============================================================================
+//                  GLOBAL HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+void increment(bsls::AtomicInt *counter)
+    // Increment the specified 'counter'.
+{
+    ++*counter;
+}
+
+extern "C" void incrementCallback(void *counter)
+    // Increment the 'bsls::AtomicInt' addressed by the specified 'counter'.
+{
+    ++*static_cast<bsls::AtomicInt *>(counter);
+}
+
+void waitThenIncrement(bslmt::Semaphore *started,
+                       bslmt::Semaphore *gate,
+                       bsls::AtomicInt  *counter)
+    // Post the specified 'started' semaphore, wait on the specified 'gate'
+    // semaphore, and then increment the specified 'counter'.
+{
+    started->post();
+    gate->wait();
+    ++*counter;
+}
+
+void callShutdown(Obj *pool)
+    // Call 'shutdown' on the specified 'pool'.
+{
+    pool->shutdown();
+}
+
+void spawnTree(Obj *pool, int depth, bsls::AtomicInt *counter)
+    // Increment the specified 'counter' and, unless the specified 'depth' is
+    // 0, enqueue two jobs on the specified 'pool' that spawn trees of depth
+    // 'depth - 1'.
+{
+    ++*counter;
+    if (depth > 0) {
+        for (int i = 0; i < 2; ++i) {
+            int rc = pool->enqueueJob(bdlf::BindUtil::bind(&spawnTree,
+                                                           pool,
+                                                           depth - 1,
+                                                           counter));
+            ASSERTV(rc, 0 == rc);
+        }
+    }
+}
+
+void spawnFlat(Obj *pool, int numJobs, bsls::AtomicInt *counter)
+    // Enqueue the specified 'numJobs' jobs on the specified 'pool', each
+    // incrementing the specified 'counter'.
+{
+    for (int i = 0; i < numJobs; ++i) {
+        int rc = pool->enqueueJob(bdlf::BindUtil::bind(&increment, counter));
+        ASSERTV(rc, 0 == rc);
+    }
+}
+
+void stealAll(Deque *deque, bslmt::Barrier *barrier, bsls::AtomicBool *done)
+    // Wait on the specified 'barrier', then repeatedly steal elements, which
+    // are addresses of 'bsls::AtomicInt' counters, from the specified 'deque'
+    // and increment them, until the specified 'done' flag is set and 'deque'
+    // is empty.
+{
+    barrier->wait();
+
+    while (!*done || !deque->isEmpty()) {
+        void *element = deque->tryPopFront();
+        if (element) {
+            ++*static_cast<bsls::AtomicInt *>(element);
+        }
+    }
+}
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+void checkSignalMask(bsls::AtomicInt *numBlocked)
+    // Increment the specified 'numBlocked' if 'SIGINT' is blocked and
+    // 'SIGSEGV' is not blocked in the calling thread.
+{
+    sigset_t mask;
+    pthread_sigmask(SIG_SETMASK, 0, &mask);
+
+    if (sigismember(&mask, SIGINT) && !sigismember(&mask, SIGSEGV)) {
+        ++*numBlocked;
+    }
+}
+#endif
+
+                         // ========================
+                         // Fan-Out/Fan-In Benchmark
+                         // ========================
+
+enum { k_LEAF_WORK = 200 };
+
+bsls::AtomicInt g_benchSink(0);
+
+struct BenchState {
+    // This 'struct' tracks the completion of the jobs of one benchmark run.
+    // Completion is detected by counting, rather than by calling 'drain',
+    // since 'bdlmt::ThreadPool::drain' disables enqueuing.
+
+    bsls::AtomicInt  d_remaining;  // number of jobs yet to complete
+    bslmt::Semaphore d_done;       // posted when 'd_remaining' becomes 0
+};
+
+void doLeafWork(BenchState *state)
+    // Perform a small amount of computation, and then record the completion
+    // of a job in the specified 'state'.
+{
+    unsigned int x = 1;
+    for (int i = 0; i < k_LEAF_WORK; ++i) {
+        x = x * 1103515245U + 12345U;
+    }
+    if (0 == x) {
+        ++g_benchSink;
+    }
+    if (0 == --state->d_remaining) {
+        state->d_done.post();
+    }
+}
+
+template <class POOL>
+void benchTree(POOL *pool, int depth, BenchState *state)
+    // Unless the specified 'depth' is 0, enqueue two jobs on the specified
+    // 'pool' that do the same with 'depth - 1'; then perform a small amount
+    // of work and record its completion in the specified 'state'.
+{
+    if (depth > 0) {
+        pool->enqueueJob(bdlf::BindUtil::bind(&benchTree<POOL>,
+                                              pool,
+                                              depth - 1,
+                                              state));
+        pool->enqueueJob(bdlf::BindUtil::bind(&benchTree<POOL>,
+                                              pool,
+                                              depth - 1,
+                                              state));
+    }
+    doLeafWork(state);
+}
+
+template <class POOL>
+double runTreeBenchmark(POOL *pool, int depth)
+    // Return the number of seconds taken by the specified 'pool' to execute a
+    // binary tree of jobs of the specified 'depth'.
+{
+    BenchState state;
+    state.d_remaining = (1 << (depth + 1)) - 1;
+
+    bsls::Stopwatch timer;
+    timer.start(true);
+
+    pool->enqueueJob(bdlf::BindUtil::bind(&benchTree<POOL>,
+                                          pool,
+                                          depth,
+                                          &state));
+    state.d_done.wait();
+
+    timer.stop();
+    return timer.accumulatedWallTime();
+}
+
+template <class POOL>
+double runFlatBenchmark(POOL *pool, int numJobs)
+    // Return the number of seconds taken by the specified 'pool' to execute
+    // the specified 'numJobs' jobs enqueued by the calling thread.
+{
+    BenchState state;
+    state.d_remaining = numJobs;
+
+    bsls::Stopwatch timer;
+    timer.start(true);
+
+    for (int i = 0; i < numJobs; ++i) {
+        pool->enqueueJob(bdlf::BindUtil::bind(&doLeafWork, &state));
+    }
+    state.d_done.wait();
+
+    timer.stop();
+    return timer.accumulatedWallTime();
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace usage {
+
+///Example 1: Parallel Recursive Summation
+///- - - - - - - - - - - - - - - - - - - -
+// In this example we use a 'bdlmt::WorkStealingThreadPool' to sum the
+// elements of a large array by recursively splitting the array in half until
+// the ranges are small enough to be summed directly.  Each split enqueues a
+// job for one half; because the split is performed from within a job, the new
+// job is pushed on the deque of the processing thread that performed the
+// split, where it is available to be stolen by idle threads.
+//
+// First, we define a structure that describes one range to be summed, and the
+// function that processes it:
+//..
+    struct SumJob {
+        // This 'struct' describes a range of integers to be summed, and the
+        // location that accumulates the result.
+
+        bdlmt::WorkStealingThreadPool *d_pool_p;     // pool to split into
+        const int                     *d_begin_p;    // first element
+        const int                     *d_end_p;      // one past last element
+        bsls::AtomicInt64             *d_result_p;   // accumulated result
+    };
+
+    void sumRange(SumJob job)
+        // Add the sum of the range described by the specified 'job' to
+        // '*job.d_result_p', enqueuing one half of the range as a separate job
+        // on 'job.d_pool_p' if the range is large.
+    {
+        enum { k_GRAIN = 1024 };
+
+        while (job.d_end_p - job.d_begin_p > k_GRAIN) {
+            SumJob half(job);
+            half.d_begin_p = job.d_begin_p + (job.d_end_p - job.d_begin_p) / 2;
+            job.d_end_p    = half.d_begin_p;
+
+            job.d_pool_p->enqueueJob(bdlf::BindUtil::bind(&sumRange, half));
+        }
+
+        bsls::Types::Int64 sum = 0;
+        for (const int *p = job.d_begin_p; p != job.d_end_p; ++p) {
+            sum += *p;
+        }
+        job.d_result_p->add(sum);
+    }
+//..
+
+}  // close namespace usage
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test            = argc > 1 ? atoi(argv[1]) : 0;
+    verbose             = argc > 2;
+    veryVerbose         = argc > 3;
+    veryVeryVerbose     = argc > 4;
+    veryVeryVeryVerbose = argc > 5;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    bslma::TestAllocator globalAllocator("global", veryVeryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+    bslma::TestAllocatorMonitor gam(&globalAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        using namespace usage;
+
+// Then, we create and start a pool with four processing threads:
+//..
+    bdlmt::WorkStealingThreadPool pool(4);
+    int rc = pool.start();
+    ASSERT(0 == rc);
+//..
+// Next, we create the data to be summed:
+//..
+    bsl::vector<int> data(1 << 20);
+    for (bsl::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<int>(i % 100);
+    }
+//..
+// Now, we enqueue a single job describing the whole array, and wait for it,
+// and all the jobs it spawns, to complete:
+//..
+    bsls::AtomicInt64 result(0);
+
+    SumJob job = { &pool, &data[0], &data[0] + data.size(), &result };
+    rc = pool.enqueueJob(bdlf::BindUtil::bind(&sumRange, job));
+    ASSERT(0 == rc);
+
+    pool.drain();
+//..
+// Finally, we verify the result and stop the pool:
+//..
+    bsls::Types::Int64 expected = 0;
+    for (bsl::size_t i = 0; i < data.size(); ++i) {
+        expected += data[i];
+    }
+    ASSERT(expected == result);
+
+    pool.stop();
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // SYNCHRONOUS SIGNALS
+        //
+        // Concerns:
+        //: 1 On Unix, the processing threads block all asynchronous signals
+        //:   (e.g., 'SIGINT') but not the synchronous ones (e.g., 'SIGSEGV').
+        //
+        // Plan:
+        //: 1 Enqueue, on every processing thread, a job that inspects the
+        //:   signal mask of the thread executing it.  (C-1)
+        //
+        // Testing:
+        //   SYNCHRONOUS SIGNALS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SYNCHRONOUS SIGNALS" << endl
+                          << "===================" << endl;
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        const int NUM_JOBS = 100;
+
+        Obj mX(4, &ta);
+        ASSERT(0 == mX.start());
+
+        bsls::AtomicInt numBlocked(0);
+        for (int i = 0; i < NUM_JOBS; ++i) {
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&checkSignalMask,
+                                                           &numBlocked)));
+        }
+        mX.stop();
+
+        ASSERTV(numBlocked, NUM_JOBS == numBlocked);
+#endif
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // JOBS ENQUEUING JOBS
+        //
+        // Concerns:
+        //: 1 Jobs enqueued by jobs running in the pool are executed, whether
+        //:   they are kept on the deque of the enqueuing thread or overflow
+        //:   to the injection queue.
+        //:
+        //: 2 'drain' waits for jobs enqueued by jobs.
+        //:
+        //: 3 The pool is correct for any number of processing threads.
+        //
+        // Plan:
+        //: 1 For a range of thread counts, enqueue a job that spawns a binary
+        //:   tree of jobs, and a job that enqueues more jobs than a deque can
+        //:   hold, call 'drain', and verify the number of executed jobs.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   JOBS ENQUEUING JOBS
+        //   bsls::Types::Int64 numStolenJobs() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "JOBS ENQUEUING JOBS" << endl
+                          << "===================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        bslma::TestAllocator da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        const int THREADS[] = { 1, 2, 3, 4, 8 };
+        const int NUM_THREADS = sizeof THREADS / sizeof *THREADS;
+
+        const int DEPTH     = 12;
+        const int TREE_JOBS = (1 << (DEPTH + 1)) - 1;
+        const int FLAT_JOBS = 10000;
+
+        for (int ti = 0; ti < NUM_THREADS; ++ti) {
+            const int N = THREADS[ti];
+
+            Obj mX(N, &ta);  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+            ASSERT(0 == X.numStolenJobs());
+
+            bsls::AtomicInt counter(0);
+
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&spawnTree,
+                                                           &mX,
+                                                           DEPTH,
+                                                           &counter)));
+            mX.drain();
+            ASSERTV(N, counter, TREE_JOBS == counter);
+            ASSERTV(N, X.numPendingJobs(), 0 == X.numPendingJobs());
+
+            counter = 0;
+
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&spawnFlat,
+                                                           &mX,
+                                                           FLAT_JOBS,
+                                                           &counter)));
+            mX.drain();
+            ASSERTV(N, counter, FLAT_JOBS == counter);
+            ASSERTV(N, X.numPendingJobs(), 0 == X.numPendingJobs());
+
+            if (1 == N) {
+                ASSERT(0 == X.numStolenJobs());
+            }
+
+            if (veryVerbose) { P_(N) P(X.numStolenJobs()) }
+
+            mX.stop();
+        }
+
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // ENQUEUING JOBS
+        //
+        // Concerns:
+        //: 1 Jobs enqueued by threads not managed by the pool, in either the
+        //:   functor or the function pointer form, are all executed.
+        //:
+        //: 2 'drain' blocks until all jobs have completed, and then
+        //:   'numPendingJobs' is 0.
+        //:
+        //: 3 No memory is supplied by the default allocator.
+        //
+        // Plan:
+        //: 1 Enqueue a number of jobs of both forms from several threads,
+        //:   call 'drain', and verify the number of executed jobs.  (C-1..3)
+        //
+        // Testing:
+        //   int enqueueJob(const Job& functor);
+        //   int enqueueJob(WorkStealingThreadPoolJobFunc func, void *data);
+        //   void drain();
+        //   int numPendingJobs() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ENQUEUING JOBS" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        bslma::TestAllocator da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        const int NUM_JOBS    = 5000;
+        const int NUM_CLIENTS = 4;
+
+        Obj mX(4, &ta);  const Obj& X = mX;
+        ASSERT(0 == mX.start());
+
+        bsls::AtomicInt counter(0);
+
+        for (int i = 0; i < NUM_JOBS; ++i) {
+            ASSERT(0 == mX.enqueueJob(&incrementCallback, &counter));
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&increment,
+                                                           &counter)));
+        }
+        mX.drain();
+
+        ASSERTV(counter, 2 * NUM_JOBS == counter);
+        ASSERT(0 == X.numPendingJobs());
+
+        counter = 0;
+
+        bslmt::ThreadGroup clients(&ta);
+        clients.addThreads(bdlf::BindUtil::bind(&spawnFlat,
+                                                &mX,
+                                                NUM_JOBS,
+                                                &counter),
+                           NUM_CLIENTS);
+        clients.joinAll();
+        mX.drain();
+
+        ASSERTV(counter, NUM_CLIENTS * NUM_JOBS == counter);
+        ASSERT(0 == X.numPendingJobs());
+
+        mX.stop();
+
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // LIFECYCLE
+        //
+        // Concerns:
+        //: 1 A newly created pool is stopped and disabled, and enqueuing into
+        //:   it fails.
+        //:
+        //: 2 'start' starts 'numThreads' threads and enables enqueuing, and
+        //:   has no effect on a started pool.
+        //:
+        //: 3 'disable' and 'enable' control whether 'enqueueJob' succeeds.
+        //:
+        //: 4 'stop' executes all pending jobs, and the pool can be restarted.
+        //:
+        //: 5 'shutdown' waits for running jobs, but discards the jobs that
+        //:   have not started.
+        //:
+        //: 6 Both constructors are usable, and the destructor discards any
+        //:   pending jobs without leaking memory.
+        //
+        // Plan:
+        //: 1 Exercise the lifecycle methods in sequence, verifying the state
+        //:   with the accessors.  (C-1..4, 6)
+        //:
+        //: 2 Block the only processing thread in a job, enqueue more jobs,
+        //:   call 'shutdown' from another thread, and release the blocked job
+        //:   once the pool is no longer started.  Verify that the other jobs
+        //:   were discarded.  (C-5)
+        //
+        // Testing:
+        //   explicit WorkStealingThreadPool(int numThreads, basicAllocator);
+        //   WorkStealingThreadPool(attributes, numThreads, basicAllocator);
+        //   ~WorkStealingThreadPool();
+        //   void disable();
+        //   void enable();
+        //   void shutdown();
+        //   int start();
+        //   void stop();
+        //   bool isEnabled() const;
+        //   bool isStarted() const;
+        //   int numThreads() const;
+        //   int numThreadsStarted() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "LIFECYCLE" << endl
+                          << "=========" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+        bslma::TestAllocator da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        if (verbose) cout << "\tStart, stop, and restart." << endl;
+        {
+            Obj mX(3, &ta);  const Obj& X = mX;
+
+            ASSERT(3     == X.numThreads());
+            ASSERT(0     == X.numThreadsStarted());
+            ASSERT(false == X.isStarted());
+            ASSERT(false == X.isEnabled());
+
+            bsls::AtomicInt counter(0);
+
+            ASSERT(0 != mX.enqueueJob(&incrementCallback, &counter));
+
+            ASSERT(0     == mX.start());
+            ASSERT(3     == X.numThreadsStarted());
+            ASSERT(true  == X.isStarted());
+            ASSERT(true  == X.isEnabled());
+
+            ASSERT(0     == mX.start());
+            ASSERT(3     == X.numThreadsStarted());
+
+            mX.disable();
+            ASSERT(false == X.isEnabled());
+            ASSERT(0 != mX.enqueueJob(&incrementCallback, &counter));
+
+            mX.enable();
+            ASSERT(true  == X.isEnabled());
+
+            for (int i = 0; i < 100; ++i) {
+                ASSERT(0 == mX.enqueueJob(&incrementCallback, &counter));
+            }
+
+            mX.stop();
+            ASSERTV(counter, 100 == counter);
+            ASSERT(0     == X.numThreadsStarted());
+            ASSERT(false == X.isStarted());
+            ASSERT(false == X.isEnabled());
+
+            mX.stop();  // no effect
+
+            ASSERT(0     == mX.start());
+            ASSERT(0     == mX.enqueueJob(&incrementCallback, &counter));
+            mX.drain();
+            ASSERTV(counter, 101 == counter);
+        }
+
+        if (verbose) cout << "\tConstruct with attributes." << endl;
+        {
+            bslmt::ThreadAttributes attributes;
+            attributes.setStackSize(256 * 1024);
+
+            Obj mX(attributes, 2, &ta);  const Obj& X = mX;
+            ASSERT(2 == X.numThreads());
+
+            ASSERT(0 == mX.start());
+            ASSERT(2 == X.numThreadsStarted());
+
+            mX.shutdown();
+            ASSERT(0     == X.numThreadsStarted());
+            ASSERT(false == X.isStarted());
+            ASSERT(false == X.isEnabled());
+        }
+
+        if (verbose) cout << "\tShutdown discards pending jobs." << endl;
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+
+            bslmt::Semaphore started;
+            bslmt::Semaphore gate;
+            bsls::AtomicInt  counter(0);
+            bsls::AtomicInt  blockedCounter(0);
+
+            ASSERT(0 == mX.enqueueJob(bdlf::BindUtil::bind(&waitThenIncrement,
+                                                           &started,
+                                                           &gate,
+                                                           &blockedCounter)));
+            started.wait();
+
+            for (int i = 0; i < 10; ++i) {
+                ASSERT(0 == mX.enqueueJob(&incrementCallback, &counter));
+            }
+            ASSERT(11 == X.numPendingJobs());
+
+            bslmt::ThreadGroup shutdownThread(&ta);
+            ASSERT(0 == shutdownThread.addThread(
+                                      bdlf::BindUtil::bind(&callShutdown,
+                                                           &mX)));
+
+            while (X.isStarted()) {
+                bslmt::ThreadUtil::yield();
+            }
+            gate.post();
+
+            shutdownThread.joinAll();
+
+            ASSERT(1 == blockedCounter);
+            ASSERT(0 == counter);
+            ASSERT(0 == X.numPendingJobs());
+        }
+
+        if (verbose) cout << "\tDestroy with pending jobs." << endl;
+        {
+            Obj mX(2, &ta);
+
+            bsls::AtomicInt counter(0);
+
+            ASSERT(0 == mX.start());
+            mX.shutdown();
+            mX.enable();
+            for (int i = 0; i < 10; ++i) {
+                ASSERT(0 == mX.enqueueJob(&incrementCallback, &counter));
+            }
+            ASSERT(10 == mX.numPendingJobs());
+        }
+
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CONCURRENT STEALING FROM A DEQUE
+        //
+        // Concerns:
+        //: 1 When the owner pushes and pops while other threads steal, every
+        //:   element is removed exactly once.
+        //
+        // Plan:
+        //: 1 Use as elements the addresses of counters.  The owner pushes all
+        //:   of them, popping some of them along the way, while thieves steal
+        //:   concurrently; each remover increments the counter it removes.
+        //:   Verify that every counter is exactly 1.  (C-1)
+        //
+        // Testing:
+        //   CONCURRENT STEALING FROM A DEQUE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENT STEALING FROM A DEQUE" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        const int NUM_ELEMENTS = 200000;
+        const int NUM_THIEVES  = 3;
+
+        bsls::AtomicInt *seen = static_cast<bsls::AtomicInt *>(
+                        ta.allocate(NUM_ELEMENTS * sizeof(bsls::AtomicInt)));
+        for (int i = 0; i < NUM_ELEMENTS; ++i) {
+            new (seen + i) bsls::AtomicInt(0);
+        }
+
+        {
+            Deque            mX(6, &ta);
+            bslmt::Barrier   barrier(NUM_THIEVES + 1);
+            bsls::AtomicBool done(false);
+
+            bslmt::ThreadGroup thieves(&ta);
+            thieves.addThreads(bdlf::BindUtil::bind(&stealAll,
+                                                    &mX,
+                                                    &barrier,
+                                                    &done),
+                               NUM_THIEVES);
+
+            barrier.wait();
+
+            int next = 0;
+            while (next < NUM_ELEMENTS) {
+                if (0 == mX.pushBack(seen + next)) {
+                    ++next;
+                }
+                if (0 == next % 3) {
+                    void *element = mX.tryPopBack();
+                    if (element) {
+                        ++*static_cast<bsls::AtomicInt *>(element);
+                    }
+                }
+            }
+            while (void *element = mX.tryPopBack()) {
+                ++*static_cast<bsls::AtomicInt *>(element);
+            }
+            done = true;
+
+            thieves.joinAll();
+
+            ASSERT(mX.isEmpty());
+        }
+
+        int numBad = 0;
+        for (int i = 0; i < NUM_ELEMENTS; ++i) {
+            if (1 != seen[i]) {
+                ++numBad;
+            }
+        }
+        ASSERTV(numBad, 0 == numBad);
+
+        ta.deallocate(seen);
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // DEQUE
+        //
+        // Concerns:
+        //: 1 'tryPopBack' returns the most recently pushed element and
+        //:   'tryPopFront' returns the least recently pushed element.
+        //:
+        //: 2 Both return 0 on an empty deque.
+        //:
+        //: 3 'pushBack' fails when the deque holds 'capacity()' elements, and
+        //:   the deque remains usable after its indices wrap around the
+        //:   circular array.
+        //:
+        //: 4 'length' and 'isEmpty' report the number of elements.
+        //:
+        //: 5 Memory is supplied by the specified allocator.
+        //
+        // Plan:
+        //: 1 Perform a sequence of operations on a small deque and verify the
+        //:   results.  (C-1..5)
+        //
+        // Testing:
+        //   WorkStealingThreadPool_Deque(int capacityLog2, basicAllocator);
+        //   int pushBack(void *element);
+        //   void *tryPopBack();
+        //   void *tryPopFront();
+        //   int capacity() const;
+        //   bool isEmpty() const;
+        //   int length() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DEQUE" << endl
+                          << "=====" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        int values[8];
+
+        {
+            Deque mX(2, &ta);  const Deque& X = mX;
+
+            ASSERT(0 <  ta.numBlocksInUse());
+            ASSERT(4 == X.capacity());
+            ASSERT(0 == X.length());
+            ASSERT(X.isEmpty());
+            ASSERT(0 == mX.tryPopBack());
+            ASSERT(0 == mX.tryPopFront());
+
+            for (int round = 0; round < 5; ++round) {
+                for (int i = 0; i < 4; ++i) {
+                    ASSERTV(round, i, 0 == mX.pushBack(values + i));
+                    ASSERTV(round, i, i + 1 == X.length());
+                }
+                ASSERT(0 != mX.pushBack(values + 4));
+                ASSERT(4 == X.length());
+
+                ASSERT(values + 3 == mX.tryPopBack());
+                ASSERT(values + 0 == mX.tryPopFront());
+                ASSERT(values + 2 == mX.tryPopBack());
+                ASSERT(values + 1 == mX.tryPopFront());
+
+                ASSERT(X.isEmpty());
+                ASSERT(0 == mX.tryPopBack());
+                ASSERT(0 == mX.tryPopFront());
+            }
+
+            ASSERT(0 == mX.pushBack(values + 5));
+            ASSERT(values + 5 == mX.tryPopBack());
+            ASSERT(0 == mX.tryPopBack());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Start a pool, enqueue a few jobs, and stop it.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVeryVerbose);
+
+        Obj mX(2, &ta);  const Obj& X = mX;
+        ASSERT(2 == X.numThreads());
+        ASSERT(0 == mX.start());
+
+        bsls::AtomicInt counter(0);
+        for (int i = 0; i < 10; ++i) {
+            ASSERT(0 == mX.enqueueJob(&incrementCallback, &counter));
+        }
+        mX.drain();
+        ASSERT(10 == counter);
+
+        mX.stop();
+        ASSERT(!X.isStarted());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // FAN-OUT/FAN-IN THROUGHPUT
+        //   Compare the time taken by 'bdlmt::WorkStealingThreadPool',
+        //   'bdlmt::FixedThreadPool', and 'bdlmt::ThreadPool' to execute many
+        //   short jobs.
+        //
+        // Concerns:
+        //: 1 When jobs enqueue jobs, the work-stealing pool outperforms the
+        //:   pools that share a single queue, increasingly so as the number of
+        //:   threads grows.
+        //
+        // Plan:
+        //: 1 For each pool type and number of threads, time the execution of a
+        //:   binary tree of jobs, each of which enqueues its two children
+        //:   (fan-out), until the last job completes (fan-in).
+        //:
+        //: 2 For comparison, time the execution of the same number of jobs
+        //:   enqueued by the main thread.
+        //
+        // Testing:
+        //   FAN-OUT/FAN-IN THROUGHPUT
+        //
+        // Usage: <driver> -1 [maxThreads [depth]]
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "FAN-OUT/FAN-IN THROUGHPUT" << endl
+             << "=========================" << endl;
+
+        const int maxThreads = argc > 2 ? atoi(argv[2]) : 16;
+        const int depth      = argc > 3 ? atoi(argv[3]) : 17;
+        const int numJobs    = (1 << (depth + 1)) - 1;
+
+        cout << "jobs: " << numJobs
+             << ", leaf work: " << k_LEAF_WORK << endl
+             << "threads\tpool\t\ttree (s)\tflat (s)" << endl;
+
+        for (int n = 1; n <= maxThreads; n *= 2) {
+            {
+                bdlmt::WorkStealingThreadPool pool(n);
+                pool.start();
+                const double tree = runTreeBenchmark(&pool, depth);
+                const double flat = runFlatBenchmark(&pool, numJobs);
+                cout << n << "\twork-stealing\t" << tree << "\t" << flat
+                     << "\t(stolen: " << pool.numStolenJobs() << ")" << endl;
+                pool.stop();
+            }
+            {
+                bdlmt::FixedThreadPool pool(n, numJobs + 1);
+                pool.start();
+                const double tree = runTreeBenchmark(&pool, depth);
+                const double flat = runFlatBenchmark(&pool, numJobs);
+                cout << n << "\tfixed\t\t" << tree << "\t" << flat << endl;
+                pool.stop();
+            }
+            {
+                bslmt::ThreadAttributes attributes;
+                bdlmt::ThreadPool pool(attributes, n, n, 1000);
+                pool.start();
+                const double tree = runTreeBenchmark(&pool, depth);
+                const double flat = runFlatBenchmark(&pool, numJobs);
+                cout << n << "\tthread pool\t" << tree << "\t" << flat
+                     << endl;
+                pool.stop();
+            }
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global allocator.
+
+    ASSERT(gam.isTotalSame());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------------------------------------------------------
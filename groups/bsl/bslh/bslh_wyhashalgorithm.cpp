@@ -0,0 +1,39 @@
+// bslh_wyhashalgorithm.cpp                                           -*-C++-*-
+#include <bslh_wyhashalgorithm.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT("$Id$ $CSID$")
+
+namespace BloombergLP {
+
+namespace bslh {
+
+                          // ---------------------------
+                          // class bslh::WyHashAlgorithm
+                          // ---------------------------
+
+// CLASS DATA
+const bsls::Types::Uint64 WyHashAlgorithm::k_SECRET_0;
+const bsls::Types::Uint64 WyHashAlgorithm::k_SECRET_1;
+const bsls::Types::Uint64 WyHashAlgorithm::k_SECRET_2;
+const bsls::Types::Uint64 WyHashAlgorithm::k_SECRET_3;
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
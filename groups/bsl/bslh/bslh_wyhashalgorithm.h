@@ -0,0 +1,605 @@
+// bslh_wyhashalgorithm.h                                             -*-C++-*-
+#ifndef INCLUDED_BSLH_WYHASHALGORITHM
+#define INCLUDED_BSLH_WYHASHALGORITHM
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an implementation of the wyhash algorithm.
+//
+//@CLASSES:
+//  bslh::WyHashAlgorithm: functor implementing the wyhash algorithm
+//
+//@SEE_ALSO: bslh_hash, bslh_seededhash, bslh_spookyhashalgorithm
+//
+//@DESCRIPTION: 'bslh::WyHashAlgorithm' implements the wyhash algorithm (the
+// "final4" revision) by Wang Yi.  wyhash is a fast, non-cryptographic hashing
+// algorithm whose core operation, a 64x64 to 128-bit multiplication whose two
+// halves are folded together with exclusive-or, mixes 16 bytes of input per
+// multiplication.  Inputs of up to 16 bytes, which include all fundamental
+// types and most short strings, are hashed using two such multiplications
+// and no loop, making the algorithm particularly well suited to the small
+// keys that dominate many hash tables.  Full details of the algorithm can be
+// found at 'https://github.com/wangyi-fudan/wyhash'.
+//
+// The canonical wyhash is a one-shot function of a contiguous buffer.  This
+// implementation buffers input so that it can be supplied incrementally, as
+// required by 'bslh::Hash' and 'hashAppend', and produces the same value as
+// the canonical implementation (with its default secret) regardless of how
+// the input is divided between calls to 'operator()'.
+//
+// This class satisfies the requirements for regular 'bslh' hashing algorithms
+// and seeded 'bslh' hashing algorithms, defined in 'bslh_hash.h' and
+// 'bslh_seededhash.h' respectively.  More information can be found in the
+// package level documentation for 'bslh' (internal users can also find
+// information here {TEAM BDE:USING MODULAR HASHING<GO>})
+//
+///Security
+///--------
+// wyhash is *not* a cryptographically secure hash, nor is it a
+// cryptographically strong pseudo-random function: it provides no protection
+// against an attacker who deliberately chooses keys that collide, even if it
+// is given a secret seed.  Tables storing keys supplied by untrusted sources
+// should use 'bslh::SipHashAlgorithm' (see 'bslh_siphashalgorithm').
+//
+///Speed
+///-----
+// This algorithm is substantially faster than 'bslh::SpookyHashAlgorithm'
+// and 'bslh::SipHashAlgorithm' on keys of up to a few hundred bytes, and in
+// particular on integral keys and short strings, because it has little fixed
+// overhead for initialization and finalization.  Its throughput on long
+// inputs is comparable to that of 'bslh::SpookyHashAlgorithm'.
+//
+///Platform-Specific Multiplication
+///- - - - - - - - - - - - - - - -
+// The full 128-bit product computed by the algorithm is obtained with a
+// single instruction where the platform provides one: through the 'unsigned
+// __int128' type with GCC and Clang on 64-bit platforms, and through the
+// '_umul128' intrinsic with MSVC on x86-64.  On other platforms the product is
+// assembled from four 32x32 to 64-bit multiplications.  All paths produce
+// identical results.
+//
+///Hash Distribution
+///-----------------
+// Output hashes will be well distributed and will avalanche, which means
+// changing one bit of the input will change approximately 50% of the output
+// bits.  This will prevent similar values from funneling to the same hash or
+// bucket.
+//
+///Hash Consistency
+///----------------
+// This hash algorithm is endian-independent.  The hashes produced for a given
+// seed and sequence of bytes will be the same on big-endian and little-endian
+// platforms.  However, if the data is not just a character string but has
+// internal structure, such as being integral or floating-point, it is likely
+// ordered in different ways depending on the platform, and thus will not hash
+// to the same value.
+//
+///Usage
+///-----
+// This section illustrates intended usage of this component.
+//
+///Example: Hashing the Key of an Order Book
+///- - - - - - - - - - - - - - - - - - - - -
+// Suppose we maintain a table of order books indexed by a small key made of
+// an exchange identifier and a ticker symbol, and that computing the hash of
+// this key dominates the cost of looking up a book.  We would like to use a
+// hashing algorithm with low per-call overhead.
+//
+// First, we define the key type, and a 'hashAppend' function that passes its
+// salient attributes to a hashing algorithm:
+//..
+//  struct BookKey {
+//      // This 'struct' identifies an order book.
+//
+//      // DATA
+//      int  d_exchangeId;  // identifier of the exchange
+//      char d_ticker[8];   // null-padded ticker symbol
+//  };
+//
+//  template <class HASH_ALGORITHM>
+//  void hashAppend(HASH_ALGORITHM& hashAlg, const BookKey& key)
+//      // Pass the salient attributes of the specified 'key' to the specified
+//      // 'hashAlg'.
+//  {
+//      using bslh::hashAppend;
+//      hashAppend(hashAlg, key.d_exchangeId);
+//      hashAlg(key.d_ticker, sizeof key.d_ticker);
+//  }
+//..
+// Then, we create a hash functor that applies 'bslh::WyHashAlgorithm' to
+// 'BookKey' objects by instantiating 'bslh::Hash':
+//..
+//  typedef bslh::Hash<bslh::WyHashAlgorithm> BookKeyHash;
+//
+//  BookKey key1 = { 7, "IBM"  };
+//  BookKey key2 = { 7, "MSFT" };
+//
+//  BookKeyHash hasher;
+//  const bsls::Types::Uint64 hash1 = hasher(key1);
+//  const bsls::Types::Uint64 hash2 = hasher(key2);
+//
+//  assert(hash1 != hash2);
+//..
+// Next, we observe that the hash does not depend on how the data is divided
+// between calls to the algorithm: passing the same bytes in a single call
+// produces the same value as the two calls made by 'hashAppend':
+//..
+//  char buffer[sizeof(int) + sizeof key1.d_ticker];
+//  memcpy(buffer,               &key1.d_exchangeId, sizeof(int));
+//  memcpy(buffer + sizeof(int), key1.d_ticker,      sizeof key1.d_ticker);
+//
+//  bslh::WyHashAlgorithm algorithm;
+//  algorithm(buffer, sizeof buffer);
+//  assert(hash1 == algorithm.computeHash());
+//..
+// Finally, we use a seed to obtain a different, but equally well distributed,
+// family of hash values:
+//..
+//  const char seed[bslh::WyHashAlgorithm::k_SEED_LENGTH] = { 'x', 'y', 'z' };
+//
+//  bslh::WyHashAlgorithm seededAlgorithm(seed);
+//  seededAlgorithm(buffer, sizeof buffer);
+//  assert(hash1 != seededAlgorithm.computeHash());
+//..
+//
+///Changes
+///-------
+// The third party code is incorporated in the inline member function
+// definitions below.  Changes made to the original code include:
+//
+//: 1 Adding 'BloombergLP' and 'bslh' namespaces
+//:
+//: 2 Wrapping the one-shot 'wyhash' function in the 'WyHashAlgorithm' class,
+//:   which buffers input in 48-byte stripes (retaining the preceding 16
+//:   bytes) so that it may be supplied incrementally
+//:
+//: 3 Replacing '_wymum', '_wymix', '_wyr3', '_wyr4', and '_wyr8' with private
+//:   class methods, and the platform detection with 'bsls_platform' macros
+//:
+//: 4 Using 'bsls_byteorder' to read little-endian words
+//:
+//: 5 Adding 'k_SEED_LENGTH' and a constructor accepting a 'const char *'
+//:   seed
+//:
+//: 6 Removing the optional 'WYHASH_CONDOM' and 'WYHASH_32BIT_MUM' variants,
+//:   and the functions other than 'wyhash'
+//
+///Third-Party Documentation
+///-------------------------
+//------------------------------- wyhash.h ------------------------------------
+//
+// This is free and unencumbered software released into the public domain
+// under The Unlicense (http://unlicense.org/)
+//
+// main repo: https://github.com/wangyi-fudan/wyhash
+//
+// author: Wang Yi <godspeed_china@yeah.net>
+//
+// contributors: Reini Urban, Dietrich Epp, Joshua Haberman, Tommy Ettinger,
+// Daniel Lemire, Otmar Ertl, cocowalla, leo-yuriev, Diego Barrios Romero,
+// paulie-g, dumblob, Yann Collet, ivte-ms, hyb, James Z.M. Gao, easyaspi314
+// (Devin), TheOneric
+//
+//-----------------------------------------------------------------------------
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
+#include <bslmf_isbitwisemoveable.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_BYTEORDER
+#include <bsls_byteorder.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_STDDEF_H
+#include <stddef.h>  // for 'size_t'
+#define INCLUDED_STDDEF_H
+#endif
+
+#ifndef INCLUDED_STRING_H
+#include <string.h>  // for 'memcpy'
+#define INCLUDED_STRING_H
+#endif
+
+#if defined(BSLS_PLATFORM_CMP_MSVC) && defined(BSLS_PLATFORM_CPU_X86_64)
+#ifndef INCLUDED_INTRIN_H
+#include <intrin.h>  // for '_umul128'
+#define INCLUDED_INTRIN_H
+#endif
+#endif
+
+namespace BloombergLP {
+
+namespace bslh {
+
+                          // ===========================
+                          // class bslh::WyHashAlgorithm
+                          // ===========================
+
+class WyHashAlgorithm {
+    // This class wraps an implementation of the "wyhash" algorithm in an
+    // interface that is usable in the modular hashing system in 'bslh'.
+
+  private:
+    // PRIVATE TYPES
+    typedef bsls::Types::Uint64 Uint64;
+        // Typedef for a 64-bit integer type used in the hashing algorithm.
+
+    enum {
+        k_STRIPE_LENGTH  = 48,  // bytes consumed by each round of the main
+                                // loop of the algorithm
+
+        k_HISTORY_LENGTH = 16   // bytes preceding the final stripe that are
+                                // read when the hash is finalized
+    };
+
+    // CLASS DATA
+    static const Uint64 k_SECRET_0 = 0x2d358dccaa6c78a5ULL;
+    static const Uint64 k_SECRET_1 = 0x8bb84b93962eacc9ULL;
+    static const Uint64 k_SECRET_2 = 0x4b33a62ed433d4a3ULL;
+    static const Uint64 k_SECRET_3 = 0x4d5a2da51de1aa47ULL;
+        // The default secret of the canonical implementation.
+
+    // DATA
+    Uint64 d_seed;
+    Uint64 d_see1;
+    Uint64 d_see2;
+        // Stores the intermediate state of the algorithm as stripes are
+        // consumed
+
+    union {
+        Uint64        d_alignment;
+            // Provides alignment
+        unsigned char d_buffer[k_HISTORY_LENGTH + k_STRIPE_LENGTH];
+            // The last 'k_HISTORY_LENGTH' bytes of the most recently consumed
+            // stripe, followed by the input that has not yet been consumed.
+    };
+
+    size_t d_bufferLength;
+        // The number of unconsumed bytes, starting at offset
+        // 'k_HISTORY_LENGTH' of 'd_buffer'.
+
+    Uint64 d_totalLength;
+        // The total length of all data that has been passed into the
+        // algorithm.
+
+    // NOT IMPLEMENTED
+    WyHashAlgorithm(const WyHashAlgorithm& original); // = delete;
+        // Do not allow copy construction.
+
+    WyHashAlgorithm& operator=(const WyHashAlgorithm& rhs); // = delete;
+        // Do not allow assignment.
+
+    // PRIVATE CLASS METHODS
+    static void multiply(Uint64 *lhsAndLow, Uint64 *rhsAndHigh);
+        // Load into the specified 'lhsAndLow' and 'rhsAndHigh' the low and
+        // high 64 bits, respectively, of the 128-bit product of their
+        // original values.
+
+    static Uint64 mix(Uint64 lhs, Uint64 rhs);
+        // Return the exclusive-or of the low and high 64 bits of the 128-bit
+        // product of the specified 'lhs' and 'rhs'.
+
+    static Uint64 read3(const unsigned char *data, size_t numBytes);
+        // Return a value composed of the first, middle, and last bytes of the
+        // specified 'data' having the specified 'numBytes'.  The behavior is
+        // undefined unless '1 <= numBytes <= 3'.
+
+    static Uint64 read4(const unsigned char *data);
+        // Return the 32-bit little-endian integer stored at the specified
+        // 'data'.
+
+    static Uint64 read8(const unsigned char *data);
+        // Return the 64-bit little-endian integer stored at the specified
+        // 'data'.
+
+    // PRIVATE MANIPULATORS
+    void consumeStripe(const unsigned char *stripe);
+        // Incorporate the 'k_STRIPE_LENGTH' bytes at the specified 'stripe'
+        // into the internal state of the algorithm.
+
+    void initialize(Uint64 seed);
+        // Set the internal state of this object to that of the algorithm
+        // having the specified 'seed' and no input.
+
+  public:
+    // TYPES
+    typedef Uint64 result_type;
+        // Typedef indicating the value type returned by this algorithm.
+
+    // CONSTANTS
+    enum { k_SEED_LENGTH = 8 }; // Seed length in bytes.
+
+    // CREATORS
+    WyHashAlgorithm();
+        // Create a 'bslh::WyHashAlgorithm' using a seed of 0.
+
+    explicit WyHashAlgorithm(const char *seed);
+        // Create a 'bslh::WyHashAlgorithm', seeded with a 64-bit
+        // ('k_SEED_LENGTH' bytes) seed pointed to by the specified 'seed',
+        // interpreted as a little-endian integer.  Each bit of the supplied
+        // seed will contribute to the final hash produced by 'computeHash()'.
+        // The behavior is undefined unless 'seed' points to at least 8 bytes
+        // of initialized memory.
+
+    //! ~WyHashAlgorithm() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void operator()(const void *data, size_t numBytes);
+        // Incorporate the specified 'data', of at least the specified
+        // 'numBytes', into the internal state of the hashing algorithm.  Every
+        // bit of data incorporated into the internal state of the algorithm
+        // will contribute to the final hash produced by 'computeHash()'.  The
+        // same hash will be produced regardless of whether a sequence of bytes
+        // is passed in all at once or through multiple calls to this member
+        // function.  Input where 'numBytes' is 0 will have no effect on the
+        // internal state of the algorithm.  The behavior is undefined unless
+        // 'data' points to a valid memory location with at least 'numBytes'
+        // bytes of initialized memory or 'numBytes' is zero.
+
+    result_type computeHash();
+        // Return the finalized version of the hash that has been accumulated.
+        // Note that a value will be returned, even if data has not been passed
+        // into 'operator()'.  Also note that, unlike some other 'bslh'
+        // algorithms, this method does not modify the internal state of this
+        // object, so that repeated calls return the same value.
+};
+
+// ============================================================================
+//                          INLINE FUNCTION DEFINITIONS
+// ============================================================================
+
+// PRIVATE CLASS METHODS
+inline
+void WyHashAlgorithm::multiply(Uint64 *lhsAndLow, Uint64 *rhsAndHigh)
+{
+#if defined(BSLS_PLATFORM_CPU_64_BIT)                                         \
+ && (defined(BSLS_PLATFORM_CMP_GNU) || defined(BSLS_PLATFORM_CMP_CLANG))
+    __extension__ typedef unsigned __int128 Uint128;
+
+    Uint128 product = static_cast<Uint128>(*lhsAndLow) * *rhsAndHigh;
+    *lhsAndLow  = static_cast<Uint64>(product);
+    *rhsAndHigh = static_cast<Uint64>(product >> 64);
+#elif defined(BSLS_PLATFORM_CMP_MSVC) && defined(BSLS_PLATFORM_CPU_X86_64)
+    *lhsAndLow = _umul128(*lhsAndLow, *rhsAndHigh, rhsAndHigh);
+#else
+    const Uint64 lhsHigh = *lhsAndLow  >> 32;
+    const Uint64 rhsHigh = *rhsAndHigh >> 32;
+    const Uint64 lhsLow  = *lhsAndLow  & 0xffffffffULL;
+    const Uint64 rhsLow  = *rhsAndHigh & 0xffffffffULL;
+
+    const Uint64 high    = lhsHigh * rhsHigh;
+    const Uint64 middle0 = lhsHigh * rhsLow;
+    const Uint64 middle1 = rhsHigh * lhsLow;
+    const Uint64 low     = lhsLow  * rhsLow;
+
+    const Uint64 partial = low + (middle0 << 32);
+    Uint64       carry   = partial < low;
+    const Uint64 result  = partial + (middle1 << 32);
+    carry += result < partial;
+
+    *lhsAndLow  = result;
+    *rhsAndHigh = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+}
+
+inline
+WyHashAlgorithm::Uint64 WyHashAlgorithm::mix(Uint64 lhs, Uint64 rhs)
+{
+    multiply(&lhs, &rhs);
+    return lhs ^ rhs;
+}
+
+inline
+WyHashAlgorithm::Uint64 WyHashAlgorithm::read3(const unsigned char *data,
+                                               size_t               numBytes)
+{
+    BSLS_ASSERT_SAFE(1 <= numBytes && numBytes <= 3);
+
+    return (static_cast<Uint64>(data[0])               << 16)
+         | (static_cast<Uint64>(data[numBytes >> 1])   <<  8)
+         |  static_cast<Uint64>(data[numBytes - 1]);
+}
+
+inline
+WyHashAlgorithm::Uint64 WyHashAlgorithm::read4(const unsigned char *data)
+{
+    unsigned int value;
+    memcpy(&value, data, sizeof value);
+    return BSLS_BYTEORDER_LE_U32_TO_HOST(value);
+}
+
+inline
+WyHashAlgorithm::Uint64 WyHashAlgorithm::read8(const unsigned char *data)
+{
+    Uint64 value;
+    memcpy(&value, data, sizeof value);
+    return BSLS_BYTEORDER_LE_U64_TO_HOST(value);
+}
+
+// PRIVATE MANIPULATORS
+inline
+void WyHashAlgorithm::consumeStripe(const unsigned char *stripe)
+{
+    d_seed = mix(read8(stripe)      ^ k_SECRET_1, read8(stripe +  8) ^ d_seed);
+    d_see1 = mix(read8(stripe + 16) ^ k_SECRET_2, read8(stripe + 24) ^ d_see1);
+    d_see2 = mix(read8(stripe + 32) ^ k_SECRET_3, read8(stripe + 40) ^ d_see2);
+}
+
+inline
+void WyHashAlgorithm::initialize(Uint64 seed)
+{
+    d_seed         = seed ^ mix(seed ^ k_SECRET_0, k_SECRET_1);
+    d_see1         = d_seed;
+    d_see2         = d_seed;
+    d_bufferLength = 0;
+    d_totalLength  = 0;
+}
+
+// CREATORS
+inline
+WyHashAlgorithm::WyHashAlgorithm()
+{
+    initialize(0);
+}
+
+inline
+WyHashAlgorithm::WyHashAlgorithm(const char *seed)
+{
+    BSLS_ASSERT(seed);
+
+    initialize(read8(reinterpret_cast<const unsigned char *>(seed)));
+}
+
+// MANIPULATORS
+inline
+void WyHashAlgorithm::operator()(const void *data, size_t numBytes)
+{
+    BSLS_ASSERT_SAFE(0 != data || 0 == numBytes);
+
+    if (0 == numBytes) {
+        return;                                                       // RETURN
+    }
+
+    const unsigned char *input  = static_cast<const unsigned char *>(data);
+    unsigned char       *stripe = d_buffer + k_HISTORY_LENGTH;
+
+    d_totalLength += numBytes;
+
+    // A complete stripe is consumed only once more input follows it, as the
+    // algorithm treats the final 1 to 48 bytes of the input differently.
+
+    if (d_bufferLength) {
+        size_t length = k_STRIPE_LENGTH - d_bufferLength;
+        if (length > numBytes) {
+            length = numBytes;
+        }
+        memcpy(stripe + d_bufferLength, input, length);
+        d_bufferLength += length;
+        input          += length;
+        numBytes       -= length;
+
+        if (0 == numBytes) {
+            return;                                                   // RETURN
+        }
+
+        consumeStripe(stripe);
+        memcpy(d_buffer,
+               stripe + k_STRIPE_LENGTH - k_HISTORY_LENGTH,
+               k_HISTORY_LENGTH);
+    }
+
+    if (numBytes > k_STRIPE_LENGTH) {
+        do {
+            consumeStripe(input);
+            input    += k_STRIPE_LENGTH;
+            numBytes -= k_STRIPE_LENGTH;
+        } while (numBytes > k_STRIPE_LENGTH);
+
+        memcpy(d_buffer, input - k_HISTORY_LENGTH, k_HISTORY_LENGTH);
+    }
+
+    memcpy(stripe, input, numBytes);
+    d_bufferLength = numBytes;
+}
+
+inline
+WyHashAlgorithm::result_type WyHashAlgorithm::computeHash()
+{
+    const unsigned char *data   = d_buffer + k_HISTORY_LENGTH;
+    size_t               length = d_bufferLength;
+    Uint64               seed   = d_seed;
+    Uint64               a;
+    Uint64               b;
+
+    if (d_totalLength <= 16) {
+        if (length >= 4) {
+            const size_t offset = (length >> 3) << 2;
+
+            a = (read4(data) << 32) | read4(data + offset);
+            b = (read4(data + length - 4) << 32)
+              |  read4(data + length - 4 - offset);
+        }
+        else if (length > 0) {
+            a = read3(data, length);
+            b = 0;
+        }
+        else {
+            a = 0;
+            b = 0;
+        }
+    }
+    else {
+        if (d_totalLength > k_STRIPE_LENGTH) {
+            seed ^= d_see1 ^ d_see2;
+        }
+        while (length > 16) {
+            seed    = mix(read8(data) ^ k_SECRET_1, read8(data + 8) ^ seed);
+            data   += 16;
+            length -= 16;
+        }
+
+        // Note that this may read the final bytes of the previous stripe,
+        // retained in the history portion of 'd_buffer'.
+
+        a = read8(data + length - 16);
+        b = read8(data + length - 8);
+    }
+
+    a ^= k_SECRET_1;
+    b ^= seed;
+    multiply(&a, &b);
+
+    return mix(a ^ k_SECRET_0 ^ d_totalLength, b ^ k_SECRET_1);
+}
+
+}  // close package namespace
+
+// ============================================================================
+//                                TYPE TRAITS
+// ============================================================================
+
+namespace bslmf {
+template <>
+struct IsBitwiseMoveable<bslh::WyHashAlgorithm>
+    : bsl::true_type {};
+}  // close namespace bslmf
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
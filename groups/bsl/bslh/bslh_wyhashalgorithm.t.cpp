@@ -0,0 +1,1059 @@
+// bslh_wyhashalgorithm.t.cpp                                         -*-C++-*-
+#include <bslh_wyhashalgorithm.h>
+
+#include <bslh_defaulthashalgorithm.h>
+#include <bslh_hash.h>
+#include <bslh_siphashalgorithm.h>
+#include <bslh_spookyhashalgorithm.h>
+
+#include <bslmf_isbitwisemoveable.h>
+#include <bslmf_issame.h>
+
+#include <bsls_assert.h>
+#include <bsls_asserttest.h>
+#include <bsls_bsltestutil.h>
+#include <bsls_platform.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace BloombergLP;
+using namespace bslh;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a 'bslh' hashing algorithm.  The basic test plan
+// is to compare the output of the function call operator with the expected
+// output generated by a known-good implementation of the hashing algorithm,
+// and to verify that the output does not depend on how the input is divided
+// between calls to the function call operator (which is the part of this
+// component that is not present in the original one-shot implementation).
+// The component will also be tested for conformance to the requirements on
+// 'bslh' hashing algorithms, outlined in the 'bslh' package level
+// documentation, and the quality of the hash values produced will be checked
+// statistically.
+//-----------------------------------------------------------------------------
+// TYPEDEF
+// [ 4] typedef bsls::Types::Uint64 result_type;
+//
+// CONSTANTS
+// [ 5] enum { k_SEED_LENGTH = 8 };
+//
+// CREATORS
+// [ 2] WyHashAlgorithm();
+// [ 2] explicit WyHashAlgorithm(const char *seed);
+// [ 2] ~WyHashAlgorithm();
+//
+// MANIPULATORS
+// [ 3] void operator()(const void *data, size_t numBytes);
+// [ 3] result_type computeHash();
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] Trait IsBitwiseMoveable
+// [ 7] QUALITY OF HASH VALUES
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+//-----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BSL ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", line, message);
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BSL TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P            BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_           BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLS_BSLTESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  PRINTF FORMAT MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ZU BSLS_BSLTESTUTIL_FORMAT_ZU
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+typedef WyHashAlgorithm           Obj;
+typedef bsls::Types::Uint64       Uint64;
+
+//=============================================================================
+//                       GLOBAL HELPER FUNCTIONS FOR TESTING
+//-----------------------------------------------------------------------------
+
+namespace {
+
+Uint64 nextRandom(Uint64 *state)
+    // Return the next value of the pseudo-random sequence whose state is held
+    // in the specified 'state', and advance 'state'.  Note that this is the
+    // "xorshift64*" generator, chosen because it is self-contained and its
+    // output is unrelated to the algorithm under test.
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+void fillRandom(unsigned char *buffer, size_t length, Uint64 *state)
+    // Load into the specified 'buffer' of the specified 'length' bytes drawn
+    // from the pseudo-random sequence whose state is held in the specified
+    // 'state'.
+{
+    for (size_t i = 0; i < length; ++i) {
+        buffer[i] = static_cast<unsigned char>(nextRandom(state) >> 56);
+    }
+}
+
+int countBits(Uint64 value)
+    // Return the number of bits set in the specified 'value'.
+{
+    int count = 0;
+    while (value) {
+        value &= value - 1;
+        ++count;
+    }
+    return count;
+}
+
+Uint64 hashBytes(const void *data, size_t length)
+    // Return the hash of the specified 'data' having the specified 'length'
+    // computed by a default constructed 'WyHashAlgorithm'.
+{
+    Obj hashAlg;
+    hashAlg(data, length);
+    return hashAlg.computeHash();
+}
+
+extern "C" int compareUint64(const void *lhs, const void *rhs)
+    // Return a negative value, 0, or a positive value if the 'Uint64' at the
+    // specified 'lhs' is less than, equal to, or greater than the 'Uint64' at
+    // the specified 'rhs', respectively.
+{
+    const Uint64 a = *static_cast<const Uint64 *>(lhs);
+    const Uint64 b = *static_cast<const Uint64 *>(rhs);
+    return a < b ? -1 : b < a ? 1 : 0;
+}
+
+class SeededDefaultHashAlgorithm : public DefaultHashAlgorithm {
+    // This class provides a 'DefaultHashAlgorithm' that can be constructed
+    // with a seed, which is ignored, so that it may be timed in the same way
+    // as the seeded algorithms.
+
+  public:
+    // CREATORS
+    explicit SeededDefaultHashAlgorithm(const char *)
+        // Create a 'DefaultHashAlgorithm', ignoring the seed.
+    {
+    }
+};
+
+template <class HASH_ALGORITHM>
+double timeAlgorithm(const char *data, size_t keyLength, int numKeys)
+    // Return the number of seconds taken to hash, using a newly constructed
+    // (template parameter) 'HASH_ALGORITHM' per key, the specified 'numKeys'
+    // overlapping keys, each having the specified 'keyLength', taken from the
+    // specified 'data', which must be at least 'keyLength + numKeys' bytes.
+{
+    volatile Uint64 sink = 0;
+    const char      seed[64] = { 0 };
+
+    bsls::Stopwatch timer;
+    timer.start();
+    for (int i = 0; i < numKeys; ++i) {
+        HASH_ALGORITHM hashAlg(seed);
+        hashAlg(data + (i & 63), keyLength);
+        sink = sink + static_cast<Uint64>(hashAlg.computeHash());
+    }
+    timer.stop();
+
+    return timer.elapsedTime();
+}
+
+}  // close unnamed namespace
+
+//=============================================================================
+//                             USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+///Usage
+///-----
+// This section illustrates intended usage of this component.
+//
+///Example: Hashing the Key of an Order Book
+///- - - - - - - - - - - - - - - - - - - - -
+// Suppose we maintain a table of order books indexed by a small key made of
+// an exchange identifier and a ticker symbol, and that computing the hash of
+// this key dominates the cost of looking up a book.  We would like to use a
+// hashing algorithm with low per-call overhead.
+//
+// First, we define the key type, and a 'hashAppend' function that passes its
+// salient attributes to a hashing algorithm:
+//..
+    struct BookKey {
+        // This 'struct' identifies an order book.
+
+        // DATA
+        int  d_exchangeId;  // identifier of the exchange
+        char d_ticker[8];   // null-padded ticker symbol
+    };
+
+    template <class HASH_ALGORITHM>
+    void hashAppend(HASH_ALGORITHM& hashAlg, const BookKey& key)
+        // Pass the salient attributes of the specified 'key' to the specified
+        // 'hashAlg'.
+    {
+        using bslh::hashAppend;
+        hashAppend(hashAlg, key.d_exchangeId);
+        hashAlg(key.d_ticker, sizeof key.d_ticker);
+    }
+//..
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+    bool     veryVeryVerbose = argc > 4;
+    bool veryVeryVeryVerbose = argc > 5;
+
+    (void)veryVeryVeryVerbose;  // suppress warning
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   The hashing algorithm can be used to create more powerful
+        //   components such as functors that can be used to power hash tables.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("USAGE EXAMPLE\n"
+                            "=============\n");
+
+// Then, we create a hash functor that applies 'bslh::WyHashAlgorithm' to
+// 'BookKey' objects by instantiating 'bslh::Hash':
+//..
+    typedef bslh::Hash<bslh::WyHashAlgorithm> BookKeyHash;
+
+    BookKey key1 = { 7, "IBM"  };
+    BookKey key2 = { 7, "MSFT" };
+
+    BookKeyHash hasher;
+    const bsls::Types::Uint64 hash1 = hasher(key1);
+    const bsls::Types::Uint64 hash2 = hasher(key2);
+
+    ASSERT(hash1 != hash2);
+//..
+// Next, we observe that the hash does not depend on how the data is divided
+// between calls to the algorithm: passing the same bytes in a single call
+// produces the same value as the two calls made by 'hashAppend':
+//..
+    char buffer[sizeof(int) + sizeof key1.d_ticker];
+    memcpy(buffer,               &key1.d_exchangeId, sizeof(int));
+    memcpy(buffer + sizeof(int), key1.d_ticker,      sizeof key1.d_ticker);
+
+    bslh::WyHashAlgorithm algorithm;
+    algorithm(buffer, sizeof buffer);
+    ASSERT(hash1 == algorithm.computeHash());
+//..
+// Finally, we use a seed to obtain a different, but equally well distributed,
+// family of hash values:
+//..
+    const char seed[bslh::WyHashAlgorithm::k_SEED_LENGTH] = { 'x', 'y', 'z' };
+
+    bslh::WyHashAlgorithm seededAlgorithm(seed);
+    seededAlgorithm(buffer, sizeof buffer);
+    ASSERT(hash1 != seededAlgorithm.computeHash());
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // QUALITY OF HASH VALUES
+        //   Verify that the hash values produced are statistically well
+        //   distributed for the kinds of keys commonly found in hash tables.
+        //
+        // Concerns:
+        //: 1 Flipping any single bit of the input flips each bit of the output
+        //:   with a probability close to one half (avalanche).
+        //:
+        //: 2 No two of a large number of sequential integers, or of strings
+        //:   differing only in a numeric suffix, have the same hash value.
+        //:
+        //: 3 The low-order bits of the hash values of sequential integers,
+        //:   which are those used to select a bucket in a power-of-two sized
+        //:   table, are uniformly distributed.
+        //
+        // Plan:
+        //: 1 For keys of 8, 16, 32, 64, and 100 bytes, hash a number of random
+        //:   keys and, for each input bit, the same key with that bit flipped.
+        //:   Count, for every pair of input and output bits, how often the
+        //:   output bit changes, and verify that the observed frequency is
+        //:   between 0.4 and 0.6 (more than 6 standard deviations from the
+        //:   expected 0.5 for the number of samples taken).  (C-1)
+        //:
+        //: 2 Hash 2^20 sequential 64-bit integers and 2^20 strings of the form
+        //:   "key:<n>", sort the hash values, and verify that no two adjacent
+        //:   values are equal.  (C-2)
+        //:
+        //: 3 Distribute the hash values of 2^16 sequential 32-bit integers
+        //:   into 1024 buckets by their low 10 bits and verify that the
+        //:   chi-squared statistic is below a threshold more than 6 standard
+        //:   deviations above its expected value.  (C-3)
+        //
+        // Testing:
+        //   QUALITY OF HASH VALUES
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nQUALITY OF HASH VALUES"
+                            "\n======================\n");
+
+        if (verbose) printf("Verify avalanche behavior. (C-1)\n");
+        {
+            const size_t LENGTHS[]   = { 8, 16, 32, 64, 100 };
+            const int    NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+            const int    NUM_SAMPLES = 1000;
+            const int    MAX_BITS    = 100 * 8;
+
+            static int flips[MAX_BITS][64];
+            Uint64     state = 0x0123456789ABCDEFULL;
+
+            for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+                const size_t LENGTH   = LENGTHS[ti];
+                const int    NUM_BITS = static_cast<int>(LENGTH * 8);
+
+                memset(flips, 0, sizeof flips);
+
+                unsigned char key[100];
+                for (int si = 0; si < NUM_SAMPLES; ++si) {
+                    fillRandom(key, LENGTH, &state);
+                    const Uint64 HASH = hashBytes(key, LENGTH);
+
+                    for (int bi = 0; bi < NUM_BITS; ++bi) {
+                        key[bi / 8] ^= static_cast<unsigned char>(1 << bi % 8);
+                        const Uint64 DIFF = HASH ^ hashBytes(key, LENGTH);
+                        key[bi / 8] ^= static_cast<unsigned char>(1 << bi % 8);
+
+                        for (int oi = 0; oi < 64; ++oi) {
+                            flips[bi][oi] += static_cast<int>(DIFF >> oi & 1);
+                        }
+                    }
+                }
+
+                int minFlips = NUM_SAMPLES;
+                int maxFlips = 0;
+                for (int bi = 0; bi < NUM_BITS; ++bi) {
+                    for (int oi = 0; oi < 64; ++oi) {
+                        const int FLIPS = flips[bi][oi];
+                        minFlips = FLIPS < minFlips ? FLIPS : minFlips;
+                        maxFlips = FLIPS > maxFlips ? FLIPS : maxFlips;
+                    }
+                }
+
+                if (veryVerbose) {
+                    T_ P_(LENGTH) P_(minFlips) P(maxFlips)
+                }
+
+                ASSERTV(LENGTH, minFlips, NUM_SAMPLES * 4 / 10 <= minFlips);
+                ASSERTV(LENGTH, maxFlips, NUM_SAMPLES * 6 / 10 >= maxFlips);
+            }
+        }
+
+        if (verbose) printf("Verify absence of collisions. (C-2)\n");
+        {
+            const int NUM_KEYS = 1 << 20;
+
+            Uint64 *hashes = static_cast<Uint64 *>(
+                                          malloc(NUM_KEYS * sizeof(Uint64)));
+
+            for (int mode = 0; mode < 2; ++mode) {
+                for (int i = 0; i < NUM_KEYS; ++i) {
+                    if (0 == mode) {
+                        const Uint64 KEY = i;
+                        hashes[i] = hashBytes(&KEY, sizeof KEY);
+                    }
+                    else {
+                        char key[32];
+                        const int LENGTH = sprintf(key, "key:%d", i);
+                        hashes[i] = hashBytes(key, LENGTH);
+                    }
+                }
+
+                qsort(hashes, NUM_KEYS, sizeof(Uint64), &compareUint64);
+
+                int numCollisions = 0;
+                for (int i = 1; i < NUM_KEYS; ++i) {
+                    numCollisions += hashes[i - 1] == hashes[i];
+                }
+                ASSERTV(mode, numCollisions, 0 == numCollisions);
+            }
+
+            free(hashes);
+        }
+
+        if (verbose) printf("Verify distribution of low-order bits. (C-3)\n");
+        {
+            const int NUM_KEYS    = 1 << 16;
+            const int NUM_BUCKETS = 1 << 10;
+
+            static int buckets[NUM_BUCKETS];
+            memset(buckets, 0, sizeof buckets);
+
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                ++buckets[hashBytes(&i, sizeof i) & (NUM_BUCKETS - 1)];
+            }
+
+            const double EXPECTED = static_cast<double>(NUM_KEYS)
+                                                                 / NUM_BUCKETS;
+            double chiSquared = 0;
+            for (int i = 0; i < NUM_BUCKETS; ++i) {
+                const double DELTA = buckets[i] - EXPECTED;
+                chiSquared += DELTA * DELTA / EXPECTED;
+            }
+
+            if (veryVerbose) { T_ P(chiSquared) }
+
+            // The statistic has 1023 degrees of freedom: a mean of 1023 and a
+            // standard deviation of about 45.
+
+            ASSERTV(chiSquared, chiSquared < 1023 + 6 * 45);
+        }
+
+        // Also check that the 64-bit output is fully used by counting the set
+        // bits of the hashes of small integers.
+
+        if (verbose) printf("Verify the mean population count.\n");
+        {
+            const int NUM_KEYS = 1 << 16;
+
+            Uint64 totalBits = 0;
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                totalBits += countBits(hashBytes(&i, sizeof i));
+            }
+
+            const double MEAN = static_cast<double>(totalBits) / NUM_KEYS;
+
+            if (veryVerbose) { T_ P(MEAN) }
+
+            ASSERTV(MEAN, 31.9 < MEAN && MEAN < 32.1);
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING BDE TYPE TRAITS
+        //   The class is bitwise movable and should have a trait that
+        //   indicates that.
+        //
+        // Concerns:
+        //: 1 The class is marked as 'IsBitwiseMoveable'.
+        //
+        // Plan:
+        //: 1 ASSERT the presence of the trait using the
+        //:   'bslmf::IsBitwiseMoveable' metafunction. (C-1)
+        //
+        // Testing:
+        //   Trait IsBitwiseMoveable
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING BDE TYPE TRAITS"
+                            "\n=======================\n");
+
+        if (verbose) printf("ASSERT the presence of the trait using the"
+                            " 'bslmf::IsBitwiseMoveable' metafunction."
+                            " (C-1)\n");
+        {
+            ASSERT(bslmf::IsBitwiseMoveable<WyHashAlgorithm>::value);
+        }
+
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'k_SEED_LENGTH'
+        //   The class is a seeded algorithm and should expose a
+        //   'k_SEED_LENGTH' enum.
+        //
+        // Concerns:
+        //: 1 'k_SEED_LENGTH' is publicly accessible.
+        //:
+        //: 2 'k_SEED_LENGTH' is set to 8.
+        //
+        // Plan:
+        //: 1 Access 'k_SEED_LENGTH' and ASSERT it is equal to the expected
+        //:   value. (C-1,2)
+        //
+        // Testing:
+        //   enum { k_SEED_LENGTH = 8 };
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'k_SEED_LENGTH'"
+                            "\n=======================\n");
+
+        if (verbose) printf("Access 'k_SEED_LENGTH' and ASSERT it is equal to"
+                            " the expected value. (C-1,2)\n");
+        {
+            ASSERT(8 == WyHashAlgorithm::k_SEED_LENGTH);
+        }
+
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'result_type' TYPEDEF
+        //   Verify that the class offers the result_type typedef that needs to
+        //   be exposed by all 'bslh' hashing algorithms
+        //
+        // Concerns:
+        //: 1 The typedef 'result_type' is publicly accessible and an alias for
+        //:   'bsls::Types::Uint64'.
+        //:
+        //: 2 'computeHash()' returns 'result_type'
+        //
+        // Plan:
+        //: 1 ASSERT the typedef is accessible and is the correct type using
+        //:   'bslmf::IsSame'. (C-1)
+        //:
+        //: 2 Declare the expected signature of 'computeHash()' and then assign
+        //:   to it.  If it compiles, the test passes. (C-2)
+        //
+        // Testing:
+        //   typedef bsls::Types::Uint64 result_type;
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'result_type' TYPEDEF"
+                            "\n=============================\n");
+
+        if (verbose) printf("ASSERT the typedef is accessible and is the"
+                            " correct type using 'bslmf::IsSame'. (C-1)\n");
+        {
+            ASSERT((bslmf::IsSame<bsls::Types::Uint64,
+                                  Obj::result_type>::VALUE));
+        }
+
+        if (verbose) printf("Declare the expected signature of 'computeHash()'"
+                            " and then assign to it.  If it compiles, the test"
+                            " passes. (C-2)\n");
+        {
+            Obj::result_type (Obj::*expectedSignature) ();
+
+            expectedSignature = &Obj::computeHash;
+            (void)expectedSignature;
+        }
+
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'operator()' AND 'computeHash()'
+        //   Verify the class provides an overload for the function call
+        //   operator that can be called with some bytes and a length.  Verify
+        //   that calling 'operator()' will permute the algorithm's internal
+        //   state as specified by wyhash.  Verify that 'computeHash()' returns
+        //   the final value specified by the canonical wyhash implementation.
+        //
+        // Concerns:
+        //: 1 The function call operator is callable.
+        //:
+        //: 2 Given the same bytes, the function call operator will permute the
+        //:   internal state of the algorithm in the same way, regardless of
+        //:   how the bytes are divided between calls, including divisions
+        //:   that fall on, or either side of, the 48-byte stripe boundaries
+        //:   and the 16-byte boundary that selects the short-input path.
+        //:
+        //: 3 Byte sequences passed in to 'operator()' with a length of 0 will
+        //:   not contribute to the final hash.
+        //:
+        //: 4 'computeHash()' returns the appropriate value according to the
+        //:   wyhash (final version 4) specification, for both the default
+        //:   and explicitly supplied seeds.
+        //:
+        //: 5 'computeHash()' does not modify the state of the object.
+        //:
+        //: 6 'operator()' does a BSLS_ASSERT for null pointers and non-zero
+        //:   length, and not for null pointers and zero length.
+        //
+        // Plan:
+        //: 1 Check the output of 'computeHash()' against the expected results
+        //:   from a known good version of the algorithm. (C-1,4)
+        //:
+        //: 2 Insert the same values char by char, interleaved with calls to
+        //:   'operator()' with length 0, and verify the same results. (C-2,3)
+        //:
+        //: 3 For every length from 0 to 400 bytes, hash a random buffer in a
+        //:   single call, and again divided at a number of random and at all
+        //:   single split points, and verify that all results are the same.
+        //:   Call 'computeHash()' twice and verify that it returns the same
+        //:   value. (C-2,5)
+        //:
+        //: 4 Call 'operator()' with a null pointer. (C-6)
+        //
+        // Testing:
+        //   void operator()(const void *data, size_t numBytes);
+        //   result_type computeHash();
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTESTING 'operator()' AND 'computeHash()'"
+                            "\n========================================\n");
+
+        // The expected values were produced by the reference implementation
+        // ('wyhash(data, len, seed, _wyp)'), whose own test vectors use the
+        // seed 'i' for the 'i'th string.  Note that the algorithm reads its
+        // input as little-endian words, so the values are the same on all
+        // platforms.
+
+        static const struct {
+            int         d_line;
+            char        d_seed;
+            const char *d_value;
+            Uint64      d_expectedHash;
+        } DATA[] = {
+            // LINE SEED VALUE                             HASH
+            { L_,   0,   "",                        0x93228a4de0eec5a2ULL },
+            { L_,   1,   "a",                       0xc5bac3db178713c4ULL },
+            { L_,   2,   "abc",                     0xa97f2f7b1d9b3314ULL },
+            { L_,   3,   "message digest",          0x786d1f1df3801df4ULL },
+            { L_,   4,   "abcdefghijklmnopqrstuvwxyz",
+                                                    0xdca5a8138ad37c87ULL },
+            { L_,   5,   "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                         "abcdefghijklmnopqrstuvwxyz0123456789",
+                                                    0xb9e734f117cfaf70ULL },
+            { L_,   6,   "1234567890123456789012345678901234567890"
+                         "1234567890123456789012345678901234567890",
+                                                    0x6cc5eab49a92d617ULL },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        if (verbose) printf("Check the output of 'computeHash()' against the"
+                            " expected results from a known good version of"
+                            " the algorithm. (C-1,4)\n");
+        {
+            for (int i = 0; i != NUM_DATA; ++i) {
+                const int     LINE  = DATA[i].d_line;
+                const char    SEED  = DATA[i].d_seed;
+                const char   *VALUE = DATA[i].d_value;
+                const Uint64  HASH  = DATA[i].d_expectedHash;
+
+                if (veryVerbose) printf("Hashing: %s\n", VALUE);
+
+                const char seed[Obj::k_SEED_LENGTH] = { SEED };
+
+                Obj hash(seed);
+                hash(VALUE, strlen(VALUE));
+                ASSERTV(LINE, HASH == hash.computeHash());
+
+                if (0 == SEED) {
+                    Obj defaultHash;
+                    defaultHash(VALUE, strlen(VALUE));
+                    ASSERTV(LINE, HASH == defaultHash.computeHash());
+                }
+            }
+        }
+
+        if (verbose) printf("Insert the same values char by char, interleaved"
+                            " with calls to 'operator()' with length 0."
+                            " (C-2,3)\n");
+        {
+            for (int i = 0; i != NUM_DATA; ++i) {
+                const int     LINE  = DATA[i].d_line;
+                const char    SEED  = DATA[i].d_seed;
+                const char   *VALUE = DATA[i].d_value;
+                const Uint64  HASH  = DATA[i].d_expectedHash;
+
+                const char seed[Obj::k_SEED_LENGTH] = { SEED };
+
+                Obj dispirateHash(seed);
+                for (size_t j = 0; j < strlen(VALUE); ++j) {
+                    if (veryVeryVerbose) printf("Hashing by char: %c\n",
+                                                                     VALUE[j]);
+                    dispirateHash(&VALUE[j], sizeof(char));
+                    dispirateHash(VALUE, 0);
+                }
+                ASSERTV(LINE, HASH == dispirateHash.computeHash());
+            }
+        }
+
+        if (verbose) printf("Hash random buffers divided at various points."
+                            " (C-2,5)\n");
+        {
+            const size_t MAX_LENGTH  = 400;
+            const int    NUM_SPLITS  = 20;
+
+            unsigned char buffer[MAX_LENGTH];
+            Uint64        state = 0xFEDCBA9876543210ULL;
+
+            for (size_t length = 0; length <= MAX_LENGTH; ++length) {
+                fillRandom(buffer, length, &state);
+
+                Obj contiguousHash;
+                contiguousHash(buffer, length);
+                const Uint64 EXPECTED = contiguousHash.computeHash();
+
+                ASSERTV(length, EXPECTED == contiguousHash.computeHash());
+
+                for (size_t split = 0; split <= length; ++split) {
+                    Obj hash;
+                    hash(buffer, split);
+                    hash(buffer + split, length - split);
+                    ASSERTV(length, split, EXPECTED == hash.computeHash());
+                }
+
+                for (int si = 0; si < NUM_SPLITS; ++si) {
+                    Obj    hash;
+                    size_t offset = 0;
+                    while (offset < length) {
+                        size_t chunk = static_cast<size_t>(
+                                         nextRandom(&state) % 100);
+                        if (chunk > length - offset) {
+                            chunk = length - offset;
+                        }
+                        hash(buffer + offset, chunk);
+                        offset += chunk;
+                    }
+                    ASSERTV(length, si, EXPECTED == hash.computeHash());
+                }
+            }
+        }
+
+        if (verbose) printf("Call 'operator()' with null pointers. (C-6)\n");
+        {
+            const char data[5] = {'a', 'b', 'c', 'd', 'e'};
+
+            bsls::AssertTestHandlerGuard guard;
+
+            ASSERT_SAFE_FAIL(Obj().operator()(   0, 5));
+            ASSERT_SAFE_PASS(Obj().operator()(   0, 0));
+            ASSERT_SAFE_PASS(Obj().operator()(data, 5));
+        }
+
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS
+        //   Ensure that the implicit destructor as well as the explicit
+        //   default and parameterized constructors are publicly callable.
+        //   Verify that the algorithm can be instantiated with or without a
+        //   seed.
+        //
+        // Concerns:
+        //: 1 Objects can be created using the default constructor.
+        //:
+        //: 2 Objects can be created using the parameterized constructor.
+        //:
+        //: 3 Objects can be destroyed.
+        //:
+        //: 4 A default constructed object behaves as if seeded with 0.
+        //:
+        //: 5 Every byte of the seed affects the hash value.
+        //:
+        //: 6 The parameterized constructor asserts on a null 'seed'.
+        //
+        // Plan:
+        //: 1 Create a default constructed 'WyHashAlgorithm' and allow it to
+        //:   leave scope to be destroyed. (C-1,3)
+        //:
+        //: 2 Call the parameterized constructor with a seed of all zeros and
+        //:   verify that it produces the same hash as a default constructed
+        //:   object. (C-2,4)
+        //:
+        //: 3 For each byte of the seed, change that byte and verify that the
+        //:   hash of the same input changes. (C-5)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for a null 'seed' (using the 'BSLS_ASSERTTEST_*'
+        //:   macros). (C-6)
+        //
+        // Testing:
+        //   WyHashAlgorithm();
+        //   explicit WyHashAlgorithm(const char *seed);
+        //   ~WyHashAlgorithm();
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            printf("\nTESTING CREATORS"
+                   "\n================\n");
+
+        if (verbose) printf("Create a default constructed 'WyHashAlgorithm'"
+                            " and allow it to leave scope to be destroyed."
+                            " (C-1,3)\n");
+        {
+            Obj alg1;
+        }
+
+        const char *VALUE = "Hello World";
+
+        if (verbose) printf("Call the parameterized constructor with a zero"
+                            " seed. (C-2,4)\n");
+        {
+            const char seed[Obj::k_SEED_LENGTH] = { 0 };
+
+            Obj alg1(seed);
+            Obj alg2;
+            alg1(VALUE, strlen(VALUE));
+            alg2(VALUE, strlen(VALUE));
+            ASSERT(alg1.computeHash() == alg2.computeHash());
+        }
+
+        if (verbose) printf("Change each byte of the seed. (C-5)\n");
+        {
+            Obj alg0;
+            alg0(VALUE, strlen(VALUE));
+            const Uint64 HASH0 = alg0.computeHash();
+
+            for (int i = 0; i < Obj::k_SEED_LENGTH; ++i) {
+                char seed[Obj::k_SEED_LENGTH] = { 0 };
+                seed[i] = 1;
+
+                Obj alg(seed);
+                alg(VALUE, strlen(VALUE));
+                ASSERTV(i, HASH0 != alg.computeHash());
+            }
+        }
+
+        if (verbose) printf("Negative Testing. (C-6)\n");
+        {
+            const char seed[Obj::k_SEED_LENGTH] = { 0 };
+
+            bsls::AssertTestHandlerGuard guard;
+
+            ASSERT_FAIL(Obj(static_cast<const char *>(0)));
+            ASSERT_PASS(Obj(static_cast<const char *>(seed)));
+        }
+
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an instance of 'bslh::WyHashAlgorithm'. (C-1)
+        //:
+        //: 2 Verify different hashes are produced for different c-strings.
+        //:   (C-1)
+        //:
+        //: 3 Verify the same hashes are produced for the same c-strings. (C-1)
+        //:
+        //: 4 Verify different hashes are produced for different 'int's. (C-1)
+        //:
+        //: 5 Verify the same hashes are produced for the same 'int's. (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nBREATHING TEST"
+                            "\n==============\n");
+
+        if (verbose) printf("Instantiate 'bslh::WyHashAlgorithm'\n");
+        {
+            WyHashAlgorithm hashAlg;
+        }
+
+        if (verbose) printf("Verify different hashes are produced for"
+                            " different c-strings.\n");
+        {
+            WyHashAlgorithm hashAlg1;
+            WyHashAlgorithm hashAlg2;
+            const char * str1 = "Hello World";
+            const char * str2 = "Goodbye World";
+            hashAlg1(str1, strlen(str1));
+            hashAlg2(str2, strlen(str2));
+            ASSERT(hashAlg1.computeHash() != hashAlg2.computeHash());
+        }
+
+        if (verbose) printf("Verify the same hashes are produced for the same"
+                            " c-strings.\n");
+        {
+            WyHashAlgorithm hashAlg1;
+            WyHashAlgorithm hashAlg2;
+            const char * str1 = "Hello World";
+            const char * str2 = "Hello World";
+            hashAlg1(str1, strlen(str1));
+            hashAlg2(str2, strlen(str2));
+            ASSERT(hashAlg1.computeHash() == hashAlg2.computeHash());
+        }
+
+        if (verbose) printf("Verify different hashes are produced for"
+                            " different 'int's.\n");
+        {
+            WyHashAlgorithm hashAlg1;
+            WyHashAlgorithm hashAlg2;
+            int int1 = 123456;
+            int int2 = 654321;
+            hashAlg1(&int1, sizeof(int));
+            hashAlg2(&int2, sizeof(int));
+            ASSERT(hashAlg1.computeHash() != hashAlg2.computeHash());
+        }
+
+        if (verbose) printf("Verify the same hashes are produced for the same"
+                            " 'int's.\n");
+        {
+            WyHashAlgorithm hashAlg1;
+            WyHashAlgorithm hashAlg2;
+            int int1 = 123456;
+            int int2 = 123456;
+            hashAlg1(&int1, sizeof(int));
+            hashAlg2(&int2, sizeof(int));
+            ASSERT(hashAlg1.computeHash() == hashAlg2.computeHash());
+        }
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Compare the time taken to hash keys of various lengths with this
+        //   algorithm and the other 'bslh' algorithms.
+        //
+        // Concerns:
+        //: 1 The algorithm is faster than the other 'bslh' algorithms for the
+        //:   short keys typical of hash tables.
+        //
+        // Plan:
+        //: 1 For key lengths from 4 to 1024 bytes, time hashing a fixed
+        //:   number of keys with 'WyHashAlgorithm', 'SpookyHashAlgorithm',
+        //:   'SipHashAlgorithm', and 'DefaultHashAlgorithm', constructing a
+        //:   new seeded algorithm object per key as 'bslh::SeededHash' would,
+        //:   and print the results.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        printf("\nPERFORMANCE TEST"
+               "\n================\n");
+
+        const size_t LENGTHS[]   = { 4, 8, 16, 32, 64, 128, 256, 1024 };
+        const int    NUM_LENGTHS = sizeof LENGTHS / sizeof *LENGTHS;
+        const int    NUM_KEYS    = 10 * 1000 * 1000;
+
+        static char data[1024 + 64];
+        Uint64      state = 0x5555555555555555ULL;
+        fillRandom(reinterpret_cast<unsigned char *>(data),
+                   sizeof data,
+                   &state);
+
+        printf("%8s %12s %12s %12s %12s\n",
+               "LENGTH", "WYHASH", "SPOOKY", "SIPHASH", "DEFAULT");
+
+        for (int ti = 0; ti < NUM_LENGTHS; ++ti) {
+            const size_t LENGTH = LENGTHS[ti];
+            const size_t SCALE  = LENGTH < 64 ? 1 : LENGTH / 64;
+            const int    NUM    = static_cast<int>(NUM_KEYS / SCALE);
+
+            const double WY      = timeAlgorithm<WyHashAlgorithm>(data,
+                                                                  LENGTH,
+                                                                  NUM);
+            const double SPOOKY  = timeAlgorithm<SpookyHashAlgorithm>(data,
+                                                                      LENGTH,
+                                                                      NUM);
+            const double SIP     = timeAlgorithm<SipHashAlgorithm>(data,
+                                                                   LENGTH,
+                                                                   NUM);
+            const double DEFAULT = timeAlgorithm<SeededDefaultHashAlgorithm>(
+                                                                       data,
+                                                                       LENGTH,
+                                                                       NUM);
+
+            // Report nanoseconds per key.
+
+            printf("%8u %12.2f %12.2f %12.2f %12.2f\n",
+                   static_cast<unsigned>(LENGTH),
+                   WY      * 1e9 / NUM,
+                   SPOOKY  * 1e9 / NUM,
+                   SIP     * 1e9 / NUM,
+                   DEFAULT * 1e9 / NUM);
+        }
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
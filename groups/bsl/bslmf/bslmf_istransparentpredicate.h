@@ -0,0 +1,131 @@
+// bslmf_istransparentpredicate.h                                     -*-C++-*-
+#ifndef INCLUDED_BSLMF_ISTRANSPARENTPREDICATE
+#define INCLUDED_BSLMF_ISTRANSPARENTPREDICATE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a metafunction detecting transparent functors.
+//
+//@CLASSES:
+//  bslmf::IsTransparentPredicate: detects 'is_transparent' in a functor
+//
+//@SEE_ALSO: bslmf_voidtype, bslstl_unorderedmap
+//
+//@DESCRIPTION: This component provides a metafunction,
+// 'bslmf::IsTransparentPredicate', that derives from 'bsl::true_type' if the
+// (template parameter) type 'FUNCTOR' has a nested type named
+// 'is_transparent', and from 'bsl::false_type' otherwise.
+//
+// By the convention introduced in C++14, a comparator or hash functor
+// declaring 'is_transparent' accepts arguments of types other than the key
+// type of a container, and promises results consistent with those obtained
+// for the key type.  A container can then look up a key without first
+// converting the argument to the key type, e.g., find a 'bsl::string' key
+// from a 'bslstl::StringRef' without allocating memory.
+//
+// The second (template parameter) type, 'KEY', does not affect the result.
+// It is provided so that the metafunction can be named in the signature of a
+// member function template of a container, where the condition must depend
+// on a parameter of the member function template for SFINAE to apply:
+//..
+//  template <class LOOKUP_KEY>
+//  typename bsl::enable_if<
+//         bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+//         iterator>::type
+//  find(const LOOKUP_KEY& key);
+//..
+//
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Detecting a Transparent Comparator
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a comparator that can compare strings with null-terminated
+// character arrays, and declares itself transparent:
+//..
+//  struct TransparentStringEqual {
+//      typedef void is_transparent;
+//
+//      bool operator()(const char *lhs, const char *rhs) const;
+//          // Return 'true' if the specified 'lhs' and 'rhs' have the same
+//          // value, and 'false' otherwise.
+//  };
+//..
+// and a comparator that does not:
+//..
+//  struct OpaqueStringEqual {
+//      bool operator()(const char *lhs, const char *rhs) const;
+//          // Return 'true' if the specified 'lhs' and 'rhs' have the same
+//          // value, and 'false' otherwise.
+//  };
+//..
+// Then, we verify that 'bslmf::IsTransparentPredicate' detects only the
+// first:
+//..
+//  assert( (bslmf::IsTransparentPredicate<TransparentStringEqual,
+//                                         const char *>::value));
+//  assert(!(bslmf::IsTransparentPredicate<OpaqueStringEqual,
+//                                         const char *>::value));
+//..
+
+#ifndef INCLUDED_BSLSCM_VERSION
+#include <bslscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_INTEGRALCONSTANT
+#include <bslmf_integralconstant.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_VOIDTYPE
+#include <bslmf_voidtype.h>
+#endif
+
+namespace BloombergLP {
+namespace bslmf {
+
+                     // =====================================
+                     // class template IsTransparentPredicate
+                     // =====================================
+
+template <class FUNCTOR, class KEY, class = void>
+struct IsTransparentPredicate : bsl::false_type {
+    // This 'struct' template implements a metafunction deriving from
+    // 'bsl::false_type' for (template parameter) 'FUNCTOR' types lacking a
+    // nested 'is_transparent' type.
+};
+
+template <class FUNCTOR, class KEY>
+struct IsTransparentPredicate<
+                FUNCTOR,
+                KEY,
+                typename VoidType<typename FUNCTOR::is_transparent>::type>
+: bsl::true_type {
+    // This partial specialization of 'IsTransparentPredicate' derives from
+    // 'bsl::true_type' for (template parameter) 'FUNCTOR' types having a
+    // nested 'is_transparent' type.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,247 @@
+// bslmf_istransparentpredicate.t.cpp                                 -*-C++-*-
+#include <bslmf_istransparentpredicate.h>
+
+#include <bsls_bsltestutil.h>
+
+#include <stdio.h>   // 'printf'
+#include <stdlib.h>  // 'atoi'
+#include <string.h>  // 'strcmp'
+
+using namespace BloombergLP;
+
+//=============================================================================
+//                             TEST PLAN
+//-----------------------------------------------------------------------------
+// The metafunction defined in this component inspects a single property of
+// its first type parameter: the presence of a nested type named
+// 'is_transparent'.  We verify the result for types having such a nested
+// type (of several kinds), and for types lacking one, including non-class
+// types.
+//-----------------------------------------------------------------------------
+// [1] bslmf::IsTransparentPredicate<FUNCTOR, KEY>
+//-----------------------------------------------------------------------------
+// [2] USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+// ============================================================================
+//                     STANDARD BSL ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        printf("Error " __FILE__ "(%d): %s    (failed)\n", line, message);
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BSL TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLS_BSLTESTUTIL_ASSERT
+#define ASSERTV      BSLS_BSLTESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLS_BSLTESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLS_BSLTESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLS_BSLTESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLS_BSLTESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLS_BSLTESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLS_BSLTESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLS_BSLTESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLS_BSLTESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLS_BSLTESTUTIL_Q   // Quote identifier literally.
+#define P            BSLS_BSLTESTUTIL_P   // Print identifier and value.
+#define P_           BSLS_BSLTESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLS_BSLTESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLS_BSLTESTUTIL_L_  // current Line number
+
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+struct TransparentWithVoid {
+    typedef void is_transparent;
+};
+
+struct TransparentWithInt {
+    typedef int is_transparent;
+};
+
+struct TransparentWithClass {
+    struct is_transparent {};
+};
+
+struct Opaque {
+    typedef void is_not_transparent;
+};
+
+struct DerivedFromTransparent : TransparentWithVoid {
+};
+
+//=============================================================================
+//                             USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// In this section we show intended use of this component.
+//
+///Example 1: Detecting a Transparent Comparator
+///- - - - - - - - - - - - - - - - - - - - - - -
+// Suppose we have a comparator that can compare strings with null-terminated
+// character arrays, and declares itself transparent:
+//..
+    struct TransparentStringEqual {
+        typedef void is_transparent;
+
+        bool operator()(const char *lhs, const char *rhs) const
+            // Return 'true' if the specified 'lhs' and 'rhs' have the same
+            // value, and 'false' otherwise.
+        {
+            return 0 == strcmp(lhs, rhs);
+        }
+    };
+//..
+// and a comparator that does not:
+//..
+    struct OpaqueStringEqual {
+        bool operator()(const char *lhs, const char *rhs) const
+            // Return 'true' if the specified 'lhs' and 'rhs' have the same
+            // value, and 'false' otherwise.
+        {
+            return 0 == strcmp(lhs, rhs);
+        }
+    };
+//..
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    int verbose = argc > 2;
+
+    printf("TEST " __FILE__ " CASE %d\n", test);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 2: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nUSAGE EXAMPLE"
+                            "\n=============\n");
+
+// Then, we verify that 'bslmf::IsTransparentPredicate' detects only the
+// first:
+//..
+    ASSERT( (bslmf::IsTransparentPredicate<TransparentStringEqual,
+                                           const char *>::value));
+    ASSERT(!(bslmf::IsTransparentPredicate<OpaqueStringEqual,
+                                           const char *>::value));
+//..
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // 'bslmf::IsTransparentPredicate<FUNCTOR, KEY>'
+        //
+        // Concerns:
+        //: 1 The metafunction derives from 'bsl::true_type' for class types
+        //:   having a nested type 'is_transparent', whatever that type is, and
+        //:   including a nested type inherited from a base class.
+        //:
+        //: 2 The metafunction derives from 'bsl::false_type' for class types
+        //:   lacking a nested type 'is_transparent', and for non-class types.
+        //:
+        //: 3 The 'KEY' parameter does not affect the result.
+        //
+        // Plan:
+        //: 1 Instantiate the metafunction for a variety of types, and verify
+        //:   the value of the result and that it can be converted to the
+        //:   expected base class.  (C-1..3)
+        //
+        // Testing:
+        //   bslmf::IsTransparentPredicate<FUNCTOR, KEY>
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'bslmf::IsTransparentPredicate<FUNCTOR, KEY>'"
+                            "\n============================================="
+                            "\n");
+
+#define TEST(FUNCTOR, KEY, RESULT)                                            \
+        ASSERT(RESULT == (bslmf::IsTransparentPredicate<FUNCTOR,              \
+                                                        KEY>::value));        \
+        {                                                                     \
+            bsl::integral_constant<bool, RESULT> *p =                         \
+                         (bslmf::IsTransparentPredicate<FUNCTOR, KEY> *)0;    \
+            (void)p;                                                          \
+        }
+
+        TEST(TransparentWithVoid,    int,          true);
+        TEST(TransparentWithVoid,    const char *, true);
+        TEST(TransparentWithInt,     int,          true);
+        TEST(TransparentWithClass,   Opaque,       true);
+        TEST(DerivedFromTransparent, void,         true);
+
+        TEST(Opaque,                 int,          false);
+        TEST(OpaqueStringEqual,      const char *, false);
+        TEST(int,                    int,          false);
+        TEST(void,                   int,          false);
+        TEST(TransparentWithVoid *,  int,          false);
+        TEST(TransparentWithVoid &,  int,          false);
+
+#undef TEST
+      } break;
+      default: {
+        fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        fprintf(stderr, "Error, non-zero test status = %d.\n", testStatus);
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
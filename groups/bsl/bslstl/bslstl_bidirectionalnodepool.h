@@ -17,7 +17,10 @@ BSLS_IDENT("$Id: $")
 //@DESCRIPTION: This component implements a mechanism, 'BidirectionalNodePool',
 // that creates and destroys 'bslalg::BidirectionalListNode' objects holding
 // objects of a (template parameter) type 'VALUE' for use in hash-table-based
-// containers.
+// containers.  An optional third (template parameter) type, 'NODE', that
+// defaults to 'bslalg::BidirectionalNode<VALUE>', allows a container to
+// allocate nodes of a type derived from 'bslalg::BidirectionalNode<VALUE>'
+// that carry additional data (e.g., a cached hash code).
 //
 // A 'BidirectionalNodePool' uses a memory pool provided by the
 // 'bslstl_simplepool' component in its implementation to provide memory for
@@ -234,14 +237,18 @@ namespace bslstl {
                        // class BidirectionalNodePool
                        // ===========================
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE,
+          class ALLOCATOR,
+          class NODE = bslalg::BidirectionalNode<VALUE> >
 class BidirectionalNodePool {
     // This class provides methods for creating and destroying nodes using the
     // appropriate allocator-traits of the (template parameter) type
-    // 'ALLOCATOR'.
+    // 'ALLOCATOR'.  The (template parameter) type 'NODE' shall be
+    // 'bslalg::BidirectionalNode<VALUE>' or a class derived from it that, like
+    // it, is never constructed or destroyed as a whole.
 
     // PRIVATE TYPES
-    typedef SimplePool<bslalg::BidirectionalNode<VALUE>, ALLOCATOR> Pool;
+    typedef SimplePool<NODE, ALLOCATOR>                        Pool;
         // This 'typedef' is an alias for the memory pool allocator.
 
     typedef typename Pool::AllocatorTraits                     AllocatorTraits;
@@ -512,9 +519,9 @@ class BidirectionalNodePool {
 };
 
 // FREE FUNCTIONS
-template <class VALUE, class ALLOCATOR>
-void swap(BidirectionalNodePool<VALUE, ALLOCATOR>& a,
-          BidirectionalNodePool<VALUE, ALLOCATOR>& b);
+template <class VALUE, class ALLOCATOR, class NODE>
+void swap(BidirectionalNodePool<VALUE, ALLOCATOR, NODE>& a,
+          BidirectionalNodePool<VALUE, ALLOCATOR, NODE>& b);
     // Efficiently exchange the nodes of the specified 'a' object with those of
     // the specified 'b' object.  This method provides the no-throw
     // exception-safety guarantee.  The behavior is undefined unless
@@ -532,8 +539,9 @@ void swap(BidirectionalNodePool<VALUE, ALLOCATOR>& a,
 
 namespace bslmf {
 
-template <class VALUE, class ALLOCATOR>
-struct IsBitwiseMoveable<bslstl::BidirectionalNodePool<VALUE, ALLOCATOR> >
+template <class VALUE, class ALLOCATOR, class NODE>
+struct IsBitwiseMoveable<
+                       bslstl::BidirectionalNodePool<VALUE, ALLOCATOR, NODE> >
 : bsl::integral_constant<bool, bslmf::IsBitwiseMoveable<ALLOCATOR>::value>
 {};
 
@@ -546,45 +554,44 @@ struct IsBitwiseMoveable<bslstl::BidirectionalNodePool<VALUE, ALLOCATOR> >
 namespace bslstl {
 
 // CREATORS
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-BidirectionalNodePool<VALUE, ALLOCATOR>::BidirectionalNodePool(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::BidirectionalNodePool(
                                                     const ALLOCATOR& allocator)
 : d_pool(allocator)
 {
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-BidirectionalNodePool<VALUE, ALLOCATOR>::BidirectionalNodePool(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::BidirectionalNodePool(
                              bslmf::MovableRef<BidirectionalNodePool> original)
 : d_pool(MoveUtil::move(MoveUtil::access(original).d_pool))
 {
 }
 
 // MANIPULATORS
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-void BidirectionalNodePool<VALUE, ALLOCATOR>::adopt(
+void BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::adopt(
                                  bslmf::MovableRef<BidirectionalNodePool> pool)
 {
     BidirectionalNodePool& lvalue = pool;
     d_pool.adopt(MoveUtil::move(lvalue.d_pool));
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-typename
-SimplePool<bslalg::BidirectionalNode<VALUE>, ALLOCATOR>::AllocatorType&
-BidirectionalNodePool<VALUE, ALLOCATOR>::allocator()
+typename SimplePool<NODE, ALLOCATOR>::AllocatorType&
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::allocator()
 {
     return d_pool.allocator();
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::cloneNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::cloneNode(
                                      const bslalg::BidirectionalLink& original)
 {
     return emplaceIntoNewNode(
@@ -592,11 +599,11 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::cloneNode(
 }
 
 #if !BSLS_COMPILERFEATURES_SIMULATE_CPP11_FEATURES
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class... Args>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                                                            Args&&... arguments)
 {
     bslalg::BidirectionalNode<VALUE> *node = d_pool.allocate();
@@ -613,10 +620,10 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
 // {{{ BEGIN GENERATED CODE
 // The following section is automatically generated.  **DO NOT EDIT**
 // Generator command line: sim_cpp11_features.pl bslstl_bidirectionalnodepool.h
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                                )
 {
     bslalg::BidirectionalNode<VALUE> *node = d_pool.allocate();
@@ -628,11 +635,11 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01)
 {
     bslalg::BidirectionalNode<VALUE> *node = d_pool.allocate();
@@ -645,12 +652,12 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01,
           class Args_02>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_02) args_02)
 {
@@ -665,13 +672,13 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01,
           class Args_02,
           class Args_03>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_02) args_02,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_03) args_03)
@@ -688,14 +695,14 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01,
           class Args_02,
           class Args_03,
           class Args_04>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_02) args_02,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_03) args_03,
@@ -714,7 +721,7 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01,
           class Args_02,
           class Args_03,
@@ -722,7 +729,7 @@ template <class Args_01,
           class Args_05>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_02) args_02,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_03) args_03,
@@ -743,7 +750,7 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01,
           class Args_02,
           class Args_03,
@@ -752,7 +759,7 @@ template <class Args_01,
           class Args_06>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_02) args_02,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_03) args_03,
@@ -775,7 +782,7 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01,
           class Args_02,
           class Args_03,
@@ -785,7 +792,7 @@ template <class Args_01,
           class Args_07>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_02) args_02,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_03) args_03,
@@ -810,7 +817,7 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01,
           class Args_02,
           class Args_03,
@@ -821,7 +828,7 @@ template <class Args_01,
           class Args_08>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_02) args_02,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_03) args_03,
@@ -848,7 +855,7 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01,
           class Args_02,
           class Args_03,
@@ -860,7 +867,7 @@ template <class Args_01,
           class Args_09>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_02) args_02,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_03) args_03,
@@ -889,7 +896,7 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
     return node;
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class Args_01,
           class Args_02,
           class Args_03,
@@ -902,7 +909,7 @@ template <class Args_01,
           class Args_10>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_01) args_01,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_02) args_02,
                             BSLS_COMPILERFEATURES_FORWARD_REF(Args_03) args_03,
@@ -936,11 +943,11 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
 #else
 // The generated code below is a workaround for the absence of perfect
 // forwarding in some compilers.
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 template <class... Args>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::emplaceIntoNewNode(
                                BSLS_COMPILERFEATURES_FORWARD_REF(Args)... args)
 {
     bslalg::BidirectionalNode<VALUE> *node = d_pool.allocate();
@@ -955,18 +962,18 @@ BidirectionalNodePool<VALUE, ALLOCATOR>::emplaceIntoNewNode(
 // }}} END GENERATED CODE
 #endif
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
 bslalg::BidirectionalLink *
-BidirectionalNodePool<VALUE, ALLOCATOR>::moveIntoNewNode(
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::moveIntoNewNode(
                                            bslalg::BidirectionalLink *original)
 {
     return emplaceIntoNewNode(MoveUtil::move(
         static_cast<bslalg::BidirectionalNode<VALUE> *>(original)->value()));
 }
 
-template <class VALUE, class ALLOCATOR>
-void BidirectionalNodePool<VALUE, ALLOCATOR>::deleteNode(
+template <class VALUE, class ALLOCATOR, class NODE>
+void BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::deleteNode(
                                            bslalg::BidirectionalLink *linkNode)
 {
     BSLS_ASSERT(linkNode);
@@ -978,57 +985,56 @@ void BidirectionalNodePool<VALUE, ALLOCATOR>::deleteNode(
     d_pool.deallocate(node);
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-void BidirectionalNodePool<VALUE, ALLOCATOR>::release()
+void BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::release()
 {
     d_pool.release();
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-void BidirectionalNodePool<VALUE, ALLOCATOR>::reserveNodes(size_type numNodes)
+void BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::reserveNodes(
+                                                            size_type numNodes)
 {
     BSLS_ASSERT_SAFE(0 < numNodes);
 
     d_pool.reserve(numNodes);
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-void BidirectionalNodePool<VALUE, ALLOCATOR>::swapRetainAllocators(
-                                BidirectionalNodePool<VALUE, ALLOCATOR>& other)
+void BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::swapRetainAllocators(
+                          BidirectionalNodePool<VALUE, ALLOCATOR, NODE>& other)
 {
     BSLS_ASSERT_SAFE(allocator() == other.allocator());
 
     d_pool.quickSwapRetainAllocators(other.d_pool);
 }
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-void BidirectionalNodePool<VALUE, ALLOCATOR>::swapExchangeAllocators(
-                                BidirectionalNodePool<VALUE, ALLOCATOR>& other)
+void BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::swapExchangeAllocators(
+                          BidirectionalNodePool<VALUE, ALLOCATOR, NODE>& other)
 {
     d_pool.quickSwapExchangeAllocators(other.d_pool);
 }
 
 // ACCESSORS
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-const typename
-              SimplePool<bslalg::BidirectionalNode<VALUE>, ALLOCATOR>::
-                                                                 AllocatorType&
-BidirectionalNodePool<VALUE, ALLOCATOR>::allocator() const
+const typename SimplePool<NODE, ALLOCATOR>::AllocatorType&
+BidirectionalNodePool<VALUE, ALLOCATOR, NODE>::allocator() const
 {
     return d_pool.allocator();
 }
 
 }  // close package namespace
 
-template <class VALUE, class ALLOCATOR>
+template <class VALUE, class ALLOCATOR, class NODE>
 inline
-void bslstl::swap(bslstl::BidirectionalNodePool<VALUE, ALLOCATOR>& a,
-                  bslstl::BidirectionalNodePool<VALUE, ALLOCATOR>& b)
+void bslstl::swap(bslstl::BidirectionalNodePool<VALUE, ALLOCATOR, NODE>& a,
+                  bslstl::BidirectionalNodePool<VALUE, ALLOCATOR, NODE>& b)
 {
     a.swapRetainAllocators(b);
 }
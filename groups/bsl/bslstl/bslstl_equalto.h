@@ -11,6 +11,7 @@ BSLS_IDENT("$Id: $")
 //
 //@CLASSES:
 //  equal_to: C++11-compliant binary functor applying 'operator=='
+//  equal_to<void>: C++14-compliant transparent binary functor
 //
 //@SEE_ALSO: bslstl_unorderedmap, bslstl_unorderedset
 //
@@ -22,6 +23,15 @@ BSLS_IDENT("$Id: $")
 // 'bsl::unordered_map' and 'bsl::unordered_set'.  Also note that this class is
 // an empty POD type.
 //
+// The specialization 'bsl::equal_to<void>' (which can be named 'equal_to<>')
+// conforms to the C++14 standard: it compares objects of any two types for
+// which 'operator==' is defined, and declares the nested type
+// 'is_transparent'.  Unordered containers having a transparent comparator and
+// a transparent hash functor can look up keys using objects of types other
+// than their key type (see 'bslmf_istransparentpredicate').  Note that, in
+// C++03, the function-call operator of 'equal_to<void>' returns 'bool' rather
+// than the type of 'lhs == rhs'.
+//
 ///Usage
 ///-----
 // This section illustrates intended usage of this component.
@@ -270,7 +280,7 @@ namespace bsl {
                        // struct equal_to
                        // ===============
 
-template<class VALUE_TYPE>
+template<class VALUE_TYPE = void>
 struct equal_to {
     // This 'struct' defines a binary comparison functor applying 'operator=='
     // to two 'VALUE_TYPE' objects.  This class conforms to the C++11 standard
@@ -306,6 +316,46 @@ struct equal_to {
         // 'rhs' using the equality-comparison operator, 'lhs == rhs'.
 };
 
+                       // =====================
+                       // struct equal_to<void>
+                       // =====================
+
+template<>
+struct equal_to<void> {
+    // This 'struct' defines a transparent binary comparison functor applying
+    // 'operator==' to two objects of arbitrary types.  This class conforms to
+    // the C++14 standard specification of 'std::equal_to<void>'.  Note that
+    // this class is an empty POD type.
+
+    // PUBLIC TYPES
+    typedef void is_transparent;
+        // Type indicating that the function-call operator of this functor
+        // accepts arguments of arbitrary types.
+
+    //! equal_to() = default;
+        // Create a 'equal_to' object.
+
+    //! equal_to(const equal_to& original) = default;
+        // Create a 'equal_to' object.  Note that as 'equal_to' is an empty
+        // (stateless) type, this operation will have no observable effect.
+
+    //! ~equal_to() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    //! equal_to& operator=(const equal_to&) = default;
+        // Assign to this object the value of the specified 'rhs' object, and
+        // a return a reference providing modifiable access to this object.
+        // Note that as 'equal_to' is an empty (stateless) type, this operation
+        // will have no observable effect.
+
+    // ACCESSORS
+    template <class LHS_TYPE, class RHS_TYPE>
+    bool operator()(const LHS_TYPE& lhs, const RHS_TYPE& rhs) const;
+        // Return 'true' if the specified 'lhs' compares equal to the specified
+        // 'rhs' using the equality-comparison operator, 'lhs == rhs'.
+};
+
 }  // close namespace bsl
 
 namespace bsl {
@@ -327,6 +377,19 @@ bool equal_to<VALUE_TYPE>::operator()(const VALUE_TYPE& lhs,
     return lhs == rhs;
 }
 
+                       // --------------------------
+                       // struct bsl::equal_to<void>
+                       // --------------------------
+
+// ACCESSORS
+template <class LHS_TYPE, class RHS_TYPE>
+inline
+bool equal_to<void>::operator()(const LHS_TYPE& lhs,
+                                const RHS_TYPE& rhs) const
+{
+    return lhs == rhs;
+}
+
 }  // close namespace bsl
 
 // ============================================================================
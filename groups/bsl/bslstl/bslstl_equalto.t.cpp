@@ -34,6 +34,7 @@ using namespace bsl;
 // [ 2] equal_to(const equal_to)
 // [ 2] ~equal_to()
 // [ 2] equal_to& operator=(const equal_to&)
+// [ 9] bool equal_to<void>::operator()(const LHS&, const RHS&) const
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 7] USAGE EXAMPLE
@@ -92,6 +93,47 @@ void aSsErT(bool b, const char *s, int i)
 #define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
 #define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
 
+//=============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+//-----------------------------------------------------------------------------
+
+class Meters {
+    // This class holds a length that can be compared to, but not implicitly
+    // converted from, an 'int'.
+
+    // DATA
+    int d_value;
+
+  public:
+    // CREATORS
+    explicit Meters(int value)
+        // Create a 'Meters' object having the specified 'value'.
+    : d_value(value)
+    {
+    }
+
+    // ACCESSORS
+    int value() const
+        // Return the value of this object.
+    {
+        return d_value;
+    }
+};
+
+bool operator==(const Meters& lhs, int rhs)
+    // Return 'true' if the specified 'lhs' has the value of the specified
+    // 'rhs', and 'false' otherwise.
+{
+    return lhs.value() == rhs;
+}
+
+bool operator==(int lhs, const Meters& rhs)
+    // Return 'true' if the specified 'lhs' is the value of the specified
+    // 'rhs', and 'false' otherwise.
+{
+    return lhs == rhs.value();
+}
+
 //=============================================================================
 //                             USAGE EXAMPLE
 //-----------------------------------------------------------------------------
@@ -275,6 +317,55 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
+      case 9: {
+        // --------------------------------------------------------------------
+        // TRANSPARENT COMPARATOR 'equal_to<void>'
+        //
+        // Concerns:
+        //: 1 'equal_to<>' names the specialization 'equal_to<void>'.
+        //:
+        //: 2 'equal_to<void>' declares the nested type 'is_transparent'.
+        //:
+        //: 3 The function-call operator applies 'operator==' to arguments of
+        //:   different types, without converting one to the other.
+        //:
+        //: 4 'equal_to<void>' is an empty, trivial type.
+        //
+        // Plan:
+        //: 1 Verify the type identities and traits at compile time.
+        //:   (C-1..2, 4)
+        //:
+        //: 2 Compare values of different types, including a type having an
+        //:   explicit converting constructor, for which 'equal_to<int>' could
+        //:   not be used.  (C-3)
+        //
+        // Testing:
+        //   bool equal_to<void>::operator()(const LHS&, const RHS&) const
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nTRANSPARENT COMPARATOR 'equal_to<void>'"
+                            "\n=======================================\n");
+
+        typedef equal_to<> Obj;
+
+        ASSERT((bsl::is_same<Obj, equal_to<void> >::value));
+        ASSERT((bsl::is_same<void, Obj::is_transparent>::value));
+        ASSERT(bsl::is_trivially_copyable<Obj>::value);
+        ASSERT(bsl::is_trivially_default_constructible<Obj>::value);
+
+        const Obj X = Obj();
+
+        ASSERT(true  == X(1, 1L));
+        ASSERT(false == X(1, 2L));
+        ASSERT(true  == X(3L, 3));
+        ASSERT(true  == X(2.0, 2));
+
+        const Meters M(5);
+        ASSERT(true  == X(M, 5));
+        ASSERT(true  == X(5, M));
+        ASSERT(false == X(M, 6));
+        ASSERT(false == X(6, M));
+      } break;
       case 8: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE 2
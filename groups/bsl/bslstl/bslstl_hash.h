@@ -11,6 +11,7 @@ BSLS_IDENT("$Id: $")
 //
 //@CLASSES:
 //  bsl::hash: hash function for fundamental types
+//  bslstl::CacheHashCode: trait requesting cached hash codes in containers
 //
 //@SEE_ALSO: bsl+stdhdrs
 //
@@ -33,6 +34,33 @@ BSLS_IDENT("$Id: $")
 //:
 //: 3 The function should not modify its argument.
 //
+///Caching Hash Codes
+///------------------
+// This component also provides a trait, 'bslstl::CacheHashCode', that a hash
+// functor type can be associated with to request that the unordered
+// containers using it ('bsl::unordered_map', 'bsl::unordered_set', and their
+// multi-key variants) store the hash code of each element in the node holding
+// the element.  The containers then never invoke the hash functor on an
+// element already inserted: growing the bucket array and erasing elements use
+// the stored hash code, and a lookup invokes the equality comparator only on
+// elements whose stored hash code matches that of the key looked up.  Each
+// node grows by the size of a 'std::size_t'.  Caching is beneficial for keys
+// that are expensive to hash or to compare, such as strings, and is not
+// beneficial for keys such as integers.  The trait can be associated with a
+// hash functor either by specializing it, or by using the
+// 'BSLMF_NESTED_TRAIT_DECLARATION' macro:
+//..
+//  struct MyStringHash {
+//      // This 'struct' provides a hash functor for 'bsl::string' values.
+//
+//      // TRAITS
+//      BSLMF_NESTED_TRAIT_DECLARATION(MyStringHash, bslstl::CacheHashCode);
+//
+//      std::size_t operator()(const bsl::string& key) const;
+//          // Return a hash value for the specified 'key'.
+//  };
+//..
+//
 ///Usage
 ///-----
 // This section illustrates intended usage of this component.
@@ -424,6 +452,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslh_hash.h>
 #endif
 
+#ifndef INCLUDED_BSLMF_DETECTNESTEDTRAIT
+#include <bslmf_detectnestedtrait.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISTRIVIALLYCOPYABLE
 #include <bslmf_istriviallycopyable.h>
 #endif
@@ -1007,6 +1039,25 @@ struct is_trivially_copyable<hash<TYPE> >
 
 }  // close namespace bsl
 
+namespace BloombergLP {
+namespace bslstl {
+
+                          // ====================
+                          // struct CacheHashCode
+                          // ====================
+
+template <class HASHER>
+struct CacheHashCode : bslmf::DetectNestedTrait<HASHER, CacheHashCode>::type {
+    // This 'struct' template implements a trait requesting that unordered
+    // containers using the (template parameter) 'HASHER' functor store the
+    // hash code of each element alongside the element.  This trait derives
+    // from 'bsl::false_type' unless it is specialized, or declared as a nested
+    // trait, for 'HASHER'.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
 #endif
 
 // ----------------------------------------------------------------------------
@@ -7,6 +7,7 @@
 #include <bslma_testallocatormonitor.h>
 
 #include <bslmf_isbitwisemoveable.h>
+#include <bslmf_nestedtraitdeclaration.h>
 #include <bslmf_issame.h>
 #include <bslmf_istriviallycopyable.h>
 #include <bslmf_istriviallydefaultconstructible.h>
@@ -45,6 +46,7 @@ using namespace bsl;
 // [ 5] is_trivially_copyable trait
 // [ 5] is_trivially_default_constructible trait
 // [ 6] QoI: Support for empty base optimization
+// [ 9] bslstl::CacheHashCode trait
 
 // ============================================================================
 //                    STANDARD BDE ASSERT TEST MACROS
@@ -102,6 +104,45 @@ void aSsErT(bool b, const char *s, int i)
 
 #define ZU BSLS_BSLTESTUTIL_FORMAT_ZU
 
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+struct NestedCachingHash {
+    // This 'struct' provides a hash functor declaring the 'CacheHashCode'
+    // trait as a nested trait.
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(NestedCachingHash, bslstl::CacheHashCode);
+
+    std::size_t operator()(int key) const
+        // Return a hash value for the specified 'key'.
+    {
+        return static_cast<std::size_t>(key);
+    }
+};
+
+struct SpecializedCachingHash {
+    // This 'struct' provides a hash functor for which the 'CacheHashCode'
+    // trait is specialized.
+
+    std::size_t operator()(int key) const
+        // Return a hash value for the specified 'key'.
+    {
+        return static_cast<std::size_t>(key);
+    }
+};
+
+namespace BloombergLP {
+namespace bslstl {
+
+template <>
+struct CacheHashCode<SpecializedCachingHash> : bsl::true_type {
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
 //=============================================================================
 //                             USAGE EXAMPLE
 //-----------------------------------------------------------------------------
@@ -428,6 +469,35 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
+      case 9: {
+        // --------------------------------------------------------------------
+        // 'bslstl::CacheHashCode' TRAIT
+        //
+        // Concerns:
+        //: 1 The trait is 'false' for hash functors not associated with it,
+        //:   including 'bsl::hash' and 'bslh::Hash<>'.
+        //:
+        //: 2 The trait is 'true' for hash functors declaring it as a nested
+        //:   trait, or for which it is specialized.
+        //
+        // Plan:
+        //: 1 Verify the value of the trait for a set of functors.  (C-1..2)
+        //
+        // Testing:
+        //   bslstl::CacheHashCode trait
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\n'bslstl::CacheHashCode' TRAIT"
+                            "\n=============================\n");
+
+        ASSERT(!bslstl::CacheHashCode<bsl::hash<int> >::value);
+        ASSERT(!bslstl::CacheHashCode<bsl::hash<const char *> >::value);
+        ASSERT(!bslstl::CacheHashCode<bslh::Hash<> >::value);
+        ASSERT(!bslstl::CacheHashCode<int>::value);
+
+        ASSERT( bslstl::CacheHashCode<NestedCachingHash>::value);
+        ASSERT( bslstl::CacheHashCode<SpecializedCachingHash>::value);
+      } break;
       case 8: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE 2
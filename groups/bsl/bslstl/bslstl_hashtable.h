@@ -163,11 +163,23 @@ BSLS_IDENT("$Id: $")
 // the first and last element in the linked-list whose adjusted hash-values are
 // equal to that bucket's index.
 //
-// As we do not cache the hashed value, if any hash function throws we will
-// either do nothing and allow the exception to propagate, or, if some change
-// of state has already been made, clear the whole container to provide the
-// basic exception guarantee.  There are similar concerns for the 'COMPARATOR'
-// predicate.
+// By default we do not cache the hashed value, so if any hash function throws
+// we will either do nothing and allow the exception to propagate, or, if some
+// change of state has already been made, clear the whole container to provide
+// the basic exception guarantee.  There are similar concerns for the
+// 'COMPARATOR' predicate.
+//
+// If 'HASHER' has the 'bslstl::CacheHashCode' trait (see {'bslstl_hash'}),
+// each node additionally stores the hash code of its key, computed once when
+// the node is inserted.  Rehashing then never invokes the hasher (and so
+// cannot throw), erasing a node does not re-hash its key, and 'find' invokes
+// the 'COMPARATOR' only for nodes whose cached hash code equals that of the
+// sought key.
+//
+// 'findTransparent' passes its argument to the 'HASHER' and 'COMPARATOR'
+// without converting it to 'KeyType', allowing containers to support lookup
+// by a type other than their key type (e.g., by 'bslstl::StringRef' in a
+// table keyed by 'bsl::string') without creating a temporary key.
 //
 ///Usage
 ///-----
@@ -1508,6 +1520,10 @@ BSLS_IDENT("$Id: $")
 #include <bslstl_bidirectionalnodepool.h>
 #endif
 
+#ifndef INCLUDED_BSLSTL_HASH
+#include <bslstl_hash.h>
+#endif
+
 #ifndef INCLUDED_BSLALG_BIDIRECTIONALLINK
 #include <bslalg_bidirectionallink.h>
 #endif
@@ -1919,6 +1935,88 @@ void swap(HashTable_ComparatorWrapper<FUNCTOR> &lhs,
     // Swap the functor wrapped by the specified 'lhs' object with the functor
     // wrapped by the specified 'rhs' object.
 
+                       // ==========================
+                       // class HashTable_HashedNode
+                       // ==========================
+
+template <class VALUE_TYPE>
+class HashTable_HashedNode : public bslalg::BidirectionalNode<VALUE_TYPE> {
+    // This POD-like 'class' describes a node suitable for use in a
+    // 'HashTable' whose hash functor requests that hash codes be cached (see
+    // 'bslstl::CacheHashCode').  In addition to the value held by the base
+    // 'BidirectionalNode', each node records the hash code computed for its
+    // key when the node was inserted, so that rehashing, erasing, and probing
+    // the table need not invoke the hash functor again.  As with
+    // 'BidirectionalNode', this class is never constructed, destroyed, or
+    // assigned.
+
+  private:
+    // DATA
+    native_std::size_t d_hashCode;  // cached hash code of the key
+
+  private:
+    // NOT IMPLEMENTED
+    HashTable_HashedNode();
+    HashTable_HashedNode(const HashTable_HashedNode&);
+    HashTable_HashedNode& operator=(const HashTable_HashedNode&);
+    ~HashTable_HashedNode();
+
+  public:
+    // MANIPULATORS
+    void setHashCode(native_std::size_t value);
+        // Set the cached hash code of this node to the specified 'value'.
+
+    // ACCESSORS
+    native_std::size_t hashCode() const;
+        // Return the cached hash code of this node.
+};
+
+                       // =========================
+                       // struct HashTable_NodeUtil
+                       // =========================
+
+template <class VALUE_TYPE, class HASHER>
+struct HashTable_NodeUtil {
+    // This 'struct' provides a namespace for the node type used by a
+    // 'HashTable' holding elements of the (template parameter) type
+    // 'VALUE_TYPE' organized by the (template parameter) type 'HASHER', and
+    // for utility functions that exploit a cached hash code when 'HASHER'
+    // has the 'bslstl::CacheHashCode' trait.
+
+    // TYPES
+    enum { k_CACHES_HASH_CODE = CacheHashCode<HASHER>::value };
+        // 'true' if nodes store the hash code of their key.
+
+    typedef typename bsl::conditional<k_CACHES_HASH_CODE,
+                                      HashTable_HashedNode<VALUE_TYPE>,
+                                      bslalg::BidirectionalNode<VALUE_TYPE>
+                                     >::type NodeType;
+        // Alias for the type of node allocated by a 'HashTable'.
+
+    // CLASS METHODS
+    static void cacheHashCode(bslalg::BidirectionalLink *link,
+                              native_std::size_t         hashCode);
+        // Record the specified 'hashCode' in the node at the specified 'link'
+        // if 'k_CACHES_HASH_CODE' is 'true', and do nothing otherwise.  The
+        // behavior is undefined unless 'link' refers to a 'NodeType'.
+
+    static native_std::size_t cachedHashCode(
+                                       const bslalg::BidirectionalLink *link);
+        // Return the hash code cached in the node at the specified 'link'.
+        // The behavior is undefined unless 'k_CACHES_HASH_CODE' is 'true' and
+        // 'link' refers to a 'NodeType' whose hash code has been cached.
+
+    static void rehash(bslalg::HashTableAnchor   *newAnchor,
+                       bslalg::BidirectionalLink *elementList);
+        // Populate the specified 'newAnchor' with all the elements in the
+        // specified 'elementList', using the hash code cached in each node to
+        // determine its bucket.  The existing buckets of 'newAnchor' are
+        // cleared first.  This function does not throw.  The behavior is
+        // undefined unless 'k_CACHES_HASH_CODE' is 'true', 'newAnchor' has a
+        // non-empty bucket array, and every node in 'elementList' has a cached
+        // hash code.
+};
+
                            // ===============
                            // class HashTable
                            // ===============
@@ -1978,7 +2076,8 @@ class HashTable {
     typedef ::bsl::allocator_traits<AllocatorType> AllocatorTraits;
     typedef typename KEY_CONFIG::KeyType           KeyType;
     typedef typename KEY_CONFIG::ValueType         ValueType;
-    typedef bslalg::BidirectionalNode<ValueType>   NodeType;
+    typedef typename HashTable_NodeUtil<ValueType, HASHER>::NodeType
+                                                   NodeType;
     typedef typename AllocatorTraits::size_type    SizeType;
 
   private:
@@ -1987,6 +2086,11 @@ class HashTable {
     HashTable_ImplParameters<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>
                                                                 ImplParameters;
 
+    typedef HashTable_NodeUtil<ValueType, HASHER>               NodeUtil;
+        // This typedef is a convenient alias for the utility describing the
+        // layout of the nodes of this table, and whether they cache the hash
+        // code of their key.
+
     typedef bslmf::MovableRefUtil                               MoveUtil;
         // This typedef is a convenient alias for the utility associated with
         // movable references.
@@ -2075,6 +2179,19 @@ class HashTable {
         // with a new value, or when the hash table is going out of scope and
         // the extra bookkeeping is not necessary.
 
+    void insertNode(bslalg::BidirectionalLink *newNode,
+                    native_std::size_t         hashCode,
+                    bslalg::BidirectionalLink *position);
+        // Link the specified 'newNode', whose key has the specified
+        // 'hashCode', into this table immediately before the specified
+        // 'position', or at the front of its bucket if 'position' is 0, and
+        // record 'hashCode' in 'newNode' if the nodes of this table cache
+        // their hash codes.  This function does not throw, and does not update
+        // the size of this table.  The behavior is undefined unless 'newNode'
+        // was allocated by the node factory of this table, and 'position' is
+        // either 0 or refers to a node in this table whose key is equivalent
+        // to that of 'newNode'.
+
     // PRIVATE ACCESSORS
     template <class DEDUCED_KEY>
     bslalg::BidirectionalLink *find(DEDUCED_KEY&       key,
@@ -2966,6 +3083,18 @@ class HashTable {
         // first such element (from the contiguous sequence of elements having
         // the same key).
 
+    template <class LOOKUP_KEY>
+    bslalg::BidirectionalLink *findTransparent(const LOOKUP_KEY& key) const;
+        // Return the address of a link whose key compares equal to the
+        // specified 'key' (according to this hash-table's 'comparator'), and a
+        // null pointer value if no such link exists, passing 'key' to the
+        // 'hasher' and 'comparator' without first converting it to 'KeyType'.
+        // If this hash-table contains more than one such element, return the
+        // first of them.  The behavior is undefined unless the 'hasher' and
+        // 'comparator' accept arguments of type 'LOOKUP_KEY', and 'hasher'
+        // returns the same value for 'key' as for any 'KeyType' object
+        // comparing equal to 'key'.
+
     bslalg::BidirectionalLink *findEndOfRange(
                                        bslalg::BidirectionalLink *first) const;
         // Return the address of the first node after any nodes holding a value
@@ -3322,7 +3451,8 @@ class HashTable_ImplParameters
     typedef ALLOCATOR                                          AllocatorType;
     typedef ::bsl::allocator_traits<AllocatorType>             AllocatorTraits;
     typedef typename KEY_CONFIG::ValueType                     ValueType;
-    typedef bslalg::BidirectionalNode<ValueType>               NodeType;
+    typedef typename HashTable_NodeUtil<ValueType, HASHER>::NodeType
+                                                               NodeType;
 
   public:
     // PUBLIC TYPES
@@ -3331,8 +3461,7 @@ class HashTable_ImplParameters
                               template rebind_traits<NodeType> ReboundTraits;
     typedef typename ReboundTraits::allocator_type             NodeAllocator;
 
-    typedef
-    BidirectionalNodePool<typename HashTableType::ValueType, NodeAllocator>
+    typedef BidirectionalNodePool<ValueType, NodeAllocator, NodeType>
                                                                NodeFactory;
 
   private:
@@ -3651,6 +3780,87 @@ FUNCTOR& HashTable_ComparatorWrapper<FUNCTOR &>::functor() const
     return d_functor;
 }
 
+                    // --------------------------
+                    // class HashTable_HashedNode
+                    // --------------------------
+
+// MANIPULATORS
+template <class VALUE_TYPE>
+inline
+void HashTable_HashedNode<VALUE_TYPE>::setHashCode(native_std::size_t value)
+{
+    d_hashCode = value;
+}
+
+// ACCESSORS
+template <class VALUE_TYPE>
+inline
+native_std::size_t HashTable_HashedNode<VALUE_TYPE>::hashCode() const
+{
+    return d_hashCode;
+}
+
+                    // -------------------------
+                    // struct HashTable_NodeUtil
+                    // -------------------------
+
+// CLASS METHODS
+template <class VALUE_TYPE, class HASHER>
+inline
+void HashTable_NodeUtil<VALUE_TYPE, HASHER>::cacheHashCode(
+                                      bslalg::BidirectionalLink *link,
+                                      native_std::size_t         hashCode)
+{
+    BSLS_ASSERT_SAFE(link);
+
+    if (k_CACHES_HASH_CODE) {
+        static_cast<HashTable_HashedNode<VALUE_TYPE> *>(link)->setHashCode(
+                                                                     hashCode);
+    }
+}
+
+template <class VALUE_TYPE, class HASHER>
+inline
+native_std::size_t HashTable_NodeUtil<VALUE_TYPE, HASHER>::cachedHashCode(
+                                        const bslalg::BidirectionalLink *link)
+{
+    BSLS_ASSERT_SAFE(link);
+    BSLS_ASSERT_SAFE(k_CACHES_HASH_CODE);
+
+    return static_cast<const HashTable_HashedNode<VALUE_TYPE> *>(
+                                                             link)->hashCode();
+}
+
+template <class VALUE_TYPE, class HASHER>
+void HashTable_NodeUtil<VALUE_TYPE, HASHER>::rehash(
+                                       bslalg::HashTableAnchor   *newAnchor,
+                                       bslalg::BidirectionalLink *elementList)
+{
+    BSLS_ASSERT_SAFE(newAnchor);
+    BSLS_ASSERT_SAFE(newAnchor->bucketArrayAddress());
+    BSLS_ASSERT_SAFE(0 != newAnchor->bucketArraySize());
+    BSLS_ASSERT_SAFE(!elementList || !elementList->previousLink());
+
+    // As no user code is invoked, there is no need for the proctor used by
+    // 'bslalg::HashTableImpUtil::rehash'.
+
+    native_std::memset(newAnchor->bucketArrayAddress(),
+                       0,
+                       newAnchor->bucketArraySize()
+                                            * sizeof(bslalg::HashTableBucket));
+    newAnchor->setListRootAddress(0);
+
+    while (elementList) {
+        bslalg::BidirectionalLink *nextNode = elementList;
+        elementList = elementList->nextLink();
+
+        bslalg::HashTableImpUtil::insertAtBackOfBucket(
+                                                     newAnchor,
+                                                     nextNode,
+                                                     cachedHashCode(nextNode));
+    }
+}
+
                     // ---------------------------
                     // class HashTable_NodeProctor
                     // ---------------------------
@@ -4216,6 +4426,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::copyDataStructure(
         bslalg::BidirectionalLink *newNode =
                                  d_parameters.nodeFactory().cloneNode(*cursor);
 
+        NodeUtil::cacheHashCode(newNode, hashCode);
         bslalg::HashTableImpUtil::insertAtBackOfBucket(&d_anchor,
                                                        newNode,
                                                        hashCode);
@@ -4268,6 +4479,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::moveDataStructure(
         bslalg::BidirectionalLink *newNode =
                             d_parameters.nodeFactory().moveIntoNewNode(cursor);
 
+        NodeUtil::cacheHashCode(newNode, hashCode);
         bslalg::HashTableImpUtil::insertAtBackOfBucket(&d_anchor,
                                                        newNode,
                                                        hashCode);
@@ -4394,10 +4606,15 @@ rehashIntoExactlyNumBuckets(SizeType newNumBuckets, SizeType capacity)
     Proctor cleanUpIfUserHashThrows(this, &d_anchor, &newAnchor);
 
     if (d_anchor.listRootAddress()) {
-        bslalg::HashTableImpUtil::rehash<KEY_CONFIG>(
+        if (NodeUtil::k_CACHES_HASH_CODE) {
+            NodeUtil::rehash(&newAnchor, this->d_anchor.listRootAddress());
+        }
+        else {
+            bslalg::HashTableImpUtil::rehash<KEY_CONFIG>(
                                           &newAnchor,
                                           this->d_anchor.listRootAddress(),
                                           this->d_parameters.hasher());
+        }
     }
 
     cleanUpIfUserHashThrows.dismiss();
@@ -4438,6 +4655,31 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::removeAllImp()
     }
 }
 
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+inline
+void
+HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertNode(
+                                    bslalg::BidirectionalLink *newNode,
+                                    native_std::size_t         hashCode,
+                                    bslalg::BidirectionalLink *position)
+{
+    BSLS_ASSERT_SAFE(newNode);
+
+    NodeUtil::cacheHashCode(newNode, hashCode);
+
+    if (!position) {
+        bslalg::HashTableImpUtil::insertAtFrontOfBucket(&d_anchor,
+                                                        newNode,
+                                                        hashCode);
+    }
+    else {
+        bslalg::HashTableImpUtil::insertAtPosition(&d_anchor,
+                                                   newNode,
+                                                   hashCode,
+                                                   position);
+    }
+}
+
 // PRIVATE ACCESSORS
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
 template <class DEDUCED_KEY>
@@ -4447,11 +4689,36 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::find(
                                             DEDUCED_KEY&       key,
                                             native_std::size_t hashValue) const
 {
-    return bslalg::HashTableImpUtil::find<KEY_CONFIG>(
-                                                     d_anchor,
-                                                     key,
-                                                     d_parameters.comparator(),
-                                                     hashValue);
+    // This loop duplicates 'bslalg::HashTableImpUtil::find' so that a 'key'
+    // of a type other than 'KeyType' is passed to the comparator unconverted,
+    // and so that a cached hash code can reject a node without invoking the
+    // comparator.
+
+    typedef bslalg::HashTableImpUtil ImpUtil;
+
+    BSLS_ASSERT_SAFE(d_anchor.bucketArrayAddress());
+    BSLS_ASSERT_SAFE(d_anchor.bucketArraySize());
+
+    const bslalg::HashTableBucket& bucket = d_anchor.bucketArrayAddress()[
+                                        ImpUtil::computeBucketIndex(
+                                                  hashValue,
+                                                  d_anchor.bucketArraySize())];
+
+    for (bslalg::BidirectionalLink *cursor     = bucket.first(),
+                                   * const end = bucket.end();
+                                 end != cursor; cursor = cursor->nextLink()) {
+        if (NodeUtil::k_CACHES_HASH_CODE
+         && hashValue != NodeUtil::cachedHashCode(cursor)) {
+            continue;
+        }
+        if (d_parameters.comparator()(
+                                 key,
+                                 ImpUtil::extractKey<KEY_CONFIG>(cursor))) {
+            return cursor;                                            // RETURN
+        }
+    }
+
+    return 0;
 }
 
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
@@ -4473,6 +4740,10 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::hashCodeForNode(
 {
     BSLS_ASSERT_SAFE(node);
 
+    if (NodeUtil::k_CACHES_HASH_CODE) {
+        return NodeUtil::cachedHashCode(node);                        // RETURN
+    }
+
     return d_parameters.hashCodeForKey(
                        bslalg::HashTableImpUtil::extractKey<KEY_CONFIG>(node));
 }
@@ -4560,12 +4831,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -4611,12 +4877,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -4669,7 +4930,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -4710,12 +4971,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -4752,12 +5008,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -4797,12 +5048,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -4845,12 +5091,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -4896,12 +5137,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -4950,12 +5186,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -5007,12 +5238,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -5067,12 +5293,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -5130,12 +5351,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -5196,12 +5412,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -5265,12 +5476,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -5309,12 +5515,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5354,12 +5555,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5402,12 +5598,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5453,12 +5644,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5507,12 +5693,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5564,12 +5745,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5624,12 +5800,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5687,12 +5858,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5753,12 +5919,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5822,12 +5983,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5894,12 +6050,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -5945,7 +6096,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -5994,7 +6145,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6046,7 +6197,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6101,7 +6252,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6159,7 +6310,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6220,7 +6371,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6284,7 +6435,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6351,7 +6502,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6421,7 +6572,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6494,7 +6645,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6570,7 +6721,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6612,12 +6763,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplace(
                                       ImpUtil::extractKey<KEY_CONFIG>(newNode),
                                       hashCode);
 
-    if (!position) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, position);
-    }
+    this->insertNode(newNode, hashCode, position);
     nodeProctor.release();
 
     ++d_size;
@@ -6657,12 +6803,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceWithHint(
         hint = this->find(ImpUtil::extractKey<KEY_CONFIG>(newNode), hashCode);
     }
 
-    if (!hint) {
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
-    }
-    else {
-        ImpUtil::insertAtPosition(&d_anchor, newNode, hashCode, hint);
-    }
+    this->insertNode(newNode, hashCode, hint);
     nodeProctor.release();
 
     ++d_size;
@@ -6709,7 +6850,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::emplaceIfMissing(
             this->rehashForNumBuckets(numBuckets() * 2);
         }
 
-        ImpUtil::insertAtFrontOfBucket(&d_anchor, newNode, hashCode);
+        this->insertNode(newNode, hashCode, 0);
         nodeProctor.release();
 
         ++d_size;
@@ -6755,9 +6896,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
                                                        defaultMapped.object());
 #endif
 
-        bslalg::HashTableImpUtil::insertAtFrontOfBucket(&d_anchor,
-                                                        position,
-                                                        hashCode);
+        this->insertNode(position, hashCode, 0);
         ++d_size;
     }
     return position;
@@ -6785,9 +6924,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
         }
 
         position = d_parameters.nodeFactory().emplaceIntoNewNode(value);
-        bslalg::HashTableImpUtil::insertAtFrontOfBucket(&d_anchor,
-                                                        position,
-                                                        hashCode);
+        this->insertNode(position, hashCode, 0);
         ++d_size;
     }
 
@@ -6819,9 +6956,7 @@ HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::insertIfMissing(
 
         position = d_parameters.nodeFactory().emplaceIntoNewNode(
                                                        MoveUtil::move(lvalue));
-        bslalg::HashTableImpUtil::insertAtFrontOfBucket(&d_anchor,
-                                                        position,
-                                                        hashCode);
+        this->insertNode(position, hashCode, 0);
         ++d_size;
     }
 
@@ -7066,11 +7201,17 @@ bslalg::BidirectionalLink *
 HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::find(
                                                       const KeyType& key) const
 {
-    return bslalg::HashTableImpUtil::find<KEY_CONFIG>(
-                                             d_anchor,
-                                             key,
-                                             d_parameters.comparator(),
-                                             d_parameters.hashCodeForKey(key));
+    return this->find(key, d_parameters.hashCodeForKey(key));
+}
+
+template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
+template <class LOOKUP_KEY>
+inline
+bslalg::BidirectionalLink *
+HashTable<KEY_CONFIG, HASHER, COMPARATOR, ALLOCATOR>::findTransparent(
+                                                  const LOOKUP_KEY& key) const
+{
+    return this->find(key, d_parameters.hashCodeForKey(key));
 }
 
 template <class KEY_CONFIG, class HASHER, class COMPARATOR, class ALLOCATOR>
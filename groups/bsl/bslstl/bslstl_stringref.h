@@ -13,6 +13,7 @@ BSLS_IDENT("$Id: $")
 //   bslstl::StringRefImp: reference wrapper for a generic string
 //      bslstl::StringRef: reference wrapper for a 'char' string
 //  bslstl::StringRefWide: reference wrapper for a 'wchar_t' string
+//  bslstl::TransparentStringHash: transparent hash functor for 'char' strings
 //
 //@DESCRIPTION: This component defines two classes, 'bslstl::StringRef' and
 // 'bslstl::StringRefWide', each providing a reference to a non-modifiable
@@ -67,6 +68,17 @@ BSLS_IDENT("$Id: $")
 // enable the use of 'bslstl::StringRef' with STL hash containers (e.g.,
 // 'bsl::unordered_set' and 'bsl::unordered_map').
 //
+// In addition, 'bslstl::TransparentStringHash' is a hash functor that accepts
+// any argument convertible to 'bslstl::StringRef', and returns the same value
+// for a 'bsl::string', a 'bslstl::StringRef', and a null-terminated 'char'
+// string having the same value.  It is *transparent* (it declares a nested
+// 'is_transparent' type, see {'bslmf_istransparentpredicate'}), so that,
+// together with 'bsl::equal_to<>', it allows a 'bsl::unordered_map' keyed by
+// 'bsl::string' to be searched by 'bslstl::StringRef' or by string literal
+// without creating a temporary 'bsl::string'.  It also has the
+// 'bslstl::CacheHashCode' trait, requesting that hashed containers store the
+// hash code of each key alongside the element (see {'bslstl_hash'}).
+//
 ///How to include 'bslstl::StringRef'
 ///----------------------------------
 // To include 'bslstl::StringRef' use '#include <bsl_string.h>' (*not*
@@ -274,6 +286,10 @@ BSLS_IDENT("$Id: $")
 #include <bslmf_isintegral.h>
 #endif
 
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_NIL
 #include <bslmf_nil.h>
 #endif
@@ -282,6 +298,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_assert.h>
 #endif
 
+#ifndef INCLUDED_BSLSTL_HASH
+#include <bslstl_hash.h>
+#endif
+
 #ifndef INCLUDED_BSLSTL_ITERATOR
 #include <bslstl_iterator.h>
 #endif
@@ -781,6 +801,32 @@ void hashAppend(HASHALG& hashAlg, const StringRefImp<CHAR_TYPE>&  input);
 typedef StringRefImp<char>       StringRef;
 typedef StringRefImp<wchar_t>    StringRefWide;
 
+                        // ===========================
+                        // class TransparentStringHash
+                        // ===========================
+
+struct TransparentStringHash {
+    // This 'struct' provides a transparent hash functor for 'char' strings,
+    // accepting any argument convertible to 'StringRef' and returning the
+    // same value for equal strings regardless of their representation.
+
+    // TYPES
+    typedef void is_transparent;
+        // Type indicating that this functor may be invoked with arguments of
+        // types other than the key type of a container.
+
+    typedef native_std::size_t result_type;
+        // Type of the hash value returned by this functor.
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(TransparentStringHash, CacheHashCode);
+
+    // ACCESSORS
+    native_std::size_t operator()(const StringRef& key) const;
+        // Return a hash value computed from the characters of the specified
+        // 'key'.
+};
+
 // ============================================================================
 //                        INLINE FUNCTION DEFINITIONS
 // ============================================================================
@@ -1057,6 +1103,18 @@ int StringRefImp<CHAR_TYPE>::compare(
     return result;
 }
 
+                        // ---------------------------
+                        // class TransparentStringHash
+                        // ---------------------------
+
+// ACCESSORS
+inline
+native_std::size_t TransparentStringHash::operator()(
+                                                  const StringRef& key) const
+{
+    return bslh::Hash<>()(key);
+}
+
 }  // close package namespace
 
 // FREE OPERATORS
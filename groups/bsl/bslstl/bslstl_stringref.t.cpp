@@ -5,9 +5,12 @@
 #include <bslma_testallocator.h>
 #include <bslma_defaultallocatorguard.h>
 
+#include <bslmf_istransparentpredicate.h>
+
 #include <bsls_asserttest.h>
 #include <bsls_bsltestutil.h>
 #include <bsls_nativestd.h>
+#include <bsls_types.h>
 
 #include <bsltf_templatetestfacility.h>
 
@@ -121,6 +124,7 @@ using namespace bsl;  // automatically added by script
 // [ 7] basic_string basic_string::operator+=(const StringRefData& strRf);
 // [ 8] bsl::hash<BloombergLP::bslstl::StringRef>
 // [ 8] bslh::Hash<>
+// [13] size_t TransparentStringHash::operator()(const StringRef&) const;
 //
 // OTHER COMPONENTS
 // [11] bsl::string::operator=(const bslstl::StringRefData&);
@@ -700,6 +704,101 @@ int main(int argc, char *argv[])
     std::cout << "TEST " << __FILE__ << " CASE " << test << std::endl;
 
     switch (test) { case 0:
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING 'TransparentStringHash'
+        //
+        // Concerns:
+        //: 1 'TransparentStringHash' returns the same value for a
+        //:   'bsl::string', a 'bslstl::StringRef', a 'native_std::string', and
+        //:   a null-terminated string having the same value, including
+        //:   strings with embedded null characters (for the types able to
+        //:   represent them).
+        //:
+        //: 2 The value equals that of 'bslh::Hash<>' for 'bslstl::StringRef'.
+        //:
+        //: 3 'TransparentStringHash' is transparent and has the
+        //:   'bslstl::CacheHashCode' trait.
+        //:
+        //: 4 Hashing allocates no memory.
+        //
+        // Plan:
+        //: 1 For a table of strings, compare the hash of each representation.
+        //:   (C-1..2)
+        //:
+        //: 2 Use 'bslmf::IsTransparentPredicate' and 'bslstl::CacheHashCode'
+        //:   to check the traits.  (C-3)
+        //:
+        //: 3 Install a test allocator as the default allocator, and verify
+        //:   that it is not used when hashing the 'StringRef' and C-string
+        //:   representations.  (C-4)
+        //
+        // Testing:
+        //   size_t TransparentStringHash::operator()(const StringRef&) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) std::cout << "\nTesting 'TransparentStringHash'"
+                               << "\n===============================\n";
+
+        typedef bslstl::TransparentStringHash Hash;
+
+        ASSERT((bslmf::IsTransparentPredicate<Hash,
+                                              bslstl::StringRef>::value));
+        ASSERT(bslstl::CacheHashCode<Hash>::value);
+
+        static const struct {
+            int         d_line;
+            const char *d_str;
+            int         d_length;
+        } DATA[] = {
+            //line string                                length
+            //---- ------------------------------------- ------
+            { L_,  "",                                        0 },
+            { L_,  "a",                                       1 },
+            { L_,  "ab",                                      2 },
+            { L_,  "abc\0def",                                7 },
+            { L_,  "\0",                                      1 },
+            { L_,  "a string too long for the small buffer", 38 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        const Hash HASH = Hash();
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE   = DATA[ti].d_line;
+            const char *const STR    = DATA[ti].d_str;
+            const int         LENGTH = DATA[ti].d_length;
+
+            const bslstl::StringRef  REF(STR, LENGTH);
+            const bsl::string        BSTR(STR, LENGTH);
+            const native_std::string NSTR(STR, LENGTH);
+
+            const bsls::Types::Int64 NUM_ALLOCS = da.numAllocations();
+
+            const native_std::size_t EXP = bslh::Hash<>()(REF);
+
+            ASSERTV(LINE, EXP == HASH(REF));
+            if (static_cast<int>(strlen(STR)) == LENGTH) {
+                ASSERTV(LINE, EXP == HASH(STR));
+            }
+            ASSERTV(LINE, NUM_ALLOCS == da.numAllocations());
+
+            ASSERTV(LINE, EXP == HASH(BSTR));
+            ASSERTV(LINE, EXP == HASH(NSTR));
+            ASSERTV(LINE, EXP == bslh::Hash<>()(BSTR));
+
+            for (int tj = 0; tj < NUM_DATA; ++tj) {
+                const bslstl::StringRef OTHER(DATA[tj].d_str,
+                                              DATA[tj].d_length);
+
+                ASSERTV(LINE, DATA[tj].d_line,
+                        (ti == tj) == (HASH(REF) == HASH(OTHER)));
+            }
+        }
+      } break;
       case 12: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
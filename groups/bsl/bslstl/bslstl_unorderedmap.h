@@ -399,6 +399,41 @@ BSLS_IDENT("$Id: $")
 // adapting the existing default hash functions for primitive types, an
 // approach that may not always prove adequate.
 //
+///Heterogeneous Lookup
+///--------------------
+// If both 'HASH' and 'EQUAL' are *transparent* (i.e., each declares a nested
+// type named 'is_transparent', see {'bslmf_istransparentpredicate'}), then
+// 'find', 'count', and 'equal_range' accept a key of any type that the two
+// functors accept, and pass it to them unconverted.  This avoids creating a
+// temporary 'key_type' object (and, for string keys, a memory allocation) for
+// each lookup.  The behavior is undefined unless 'HASH' returns the same
+// value for such a key as for every 'key_type' object that compares equal to
+// it.
+//
+// For 'bsl::string' keys, 'bslstl::TransparentStringHash' and
+// 'bsl::equal_to<>' meet these requirements:
+//..
+//  typedef bsl::unordered_map<bsl::string,
+//                             int,
+//                             bslstl::TransparentStringHash,
+//                             bsl::equal_to<> > Dictionary;
+//
+//  Dictionary dictionary;
+//  dictionary["apple"] = 1;
+//
+//  bslstl::StringRef apple("apple");
+//  assert(dictionary.end() != dictionary.find(apple));  // no allocation
+//  assert(1                == dictionary.count("apple"));
+//..
+// In addition, a hash functor having the 'bslstl::CacheHashCode' trait (as
+// 'bslstl::TransparentStringHash' does) causes each element to be stored
+// together with the hash code of its key.  The hash functor is then not
+// invoked on the elements of the map when it is rehashed or when an element
+// is erased, and a lookup invokes 'EQUAL' only for elements whose hash code
+// matches that of the sought key, at the cost of one 'size_t' per element.
+// This is worthwhile for keys that are expensive to hash or to compare, such
+// as long strings.
+//
 ///Usage
 ///-----
 // In this section we show intended use of this component.
@@ -1031,6 +1066,10 @@ BSL_OVERRIDES_STD mode"
 #include <bslmf_isconvertible.h>
 #endif
 
+#ifndef INCLUDED_BSLMF_ISTRANSPARENTPREDICATE
+#include <bslmf_istransparentpredicate.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_MOVABLEREF
 #include <bslmf_movableref.h>
 #endif
@@ -1563,6 +1602,22 @@ class unordered_map {
         // 'key', if such an entry exists, and the past-the-end iterator
         // ('end') otherwise.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+                BloombergLP::bslmf::IsTransparentPredicate<HASH,
+                                                           LOOKUP_KEY>::value
+             && BloombergLP::bslmf::IsTransparentPredicate<EQUAL,
+                                                           LOOKUP_KEY>::value,
+             iterator>::type
+    find(const LOOKUP_KEY& key);
+        // Return an iterator providing modifiable access to the 'value_type'
+        // object in this unordered map with a key equivalent to the specified
+        // 'key', if such an entry exists, and the past-the-end iterator
+        // ('end') otherwise.  'key' is passed to the hash and key-equality
+        // functors without being converted to 'key_type'.  This overload
+        // participates in overload resolution only if both 'HASH' and 'EQUAL'
+        // are transparent (see {Heterogeneous Lookup}).
+
     pair<iterator, bool> insert(const value_type& value);
         // Insert the specified 'value' into this unordered map if the key (the
         // 'first' element) of the object referred to by 'value' does not
@@ -1719,6 +1774,22 @@ class unordered_map {
         // value, 'end()'.  Note that since an unordered map maintains unique
         // keys, the range will contain at most one element.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+                BloombergLP::bslmf::IsTransparentPredicate<HASH,
+                                                           LOOKUP_KEY>::value
+             && BloombergLP::bslmf::IsTransparentPredicate<EQUAL,
+                                                           LOOKUP_KEY>::value,
+             pair<iterator, iterator> >::type
+    equal_range(const LOOKUP_KEY& key);
+        // Return a pair of iterators providing modifiable access to the
+        // sequence of 'value_type' objects in this unordered map having a key
+        // equivalent to the specified 'key', as for the 'equal_range'
+        // overload taking a 'key_type', without converting 'key' to
+        // 'key_type'.  This overload participates in overload resolution only
+        // if both 'HASH' and 'EQUAL' are transparent (see
+        // {Heterogeneous Lookup}).
+
     void max_load_factor(float newMaxLoadFactor);
         // Set the maximum load factor of this unordered map to the specified
         // 'newMaxLoadFactor'.  If 'newMaxLoadFactor < loadFactor()', this
@@ -1824,6 +1895,20 @@ class unordered_map {
         // unordered map maintains unique keys, the returned value will be
         // either 0 or 1.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+                BloombergLP::bslmf::IsTransparentPredicate<HASH,
+                                                           LOOKUP_KEY>::value
+             && BloombergLP::bslmf::IsTransparentPredicate<EQUAL,
+                                                           LOOKUP_KEY>::value,
+             size_type>::type
+    count(const LOOKUP_KEY& key) const;
+        // Return the number of 'value_type' objects contained within this
+        // unordered map having a key equivalent to the specified 'key',
+        // without converting 'key' to 'key_type'.  This overload participates
+        // in overload resolution only if both 'HASH' and 'EQUAL' are
+        // transparent (see {Heterogeneous Lookup}).
+
     bool empty() const BSLS_CPP11_NOEXCEPT;
         // Return 'true' if this unordered map contains no elements, and
         // 'false' otherwise.
@@ -1839,12 +1924,44 @@ class unordered_map {
         // value, 'end()'.  Note that since an unordered map maintains unique
         // keys, the range will contain at most one element.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+                BloombergLP::bslmf::IsTransparentPredicate<HASH,
+                                                           LOOKUP_KEY>::value
+             && BloombergLP::bslmf::IsTransparentPredicate<EQUAL,
+                                                           LOOKUP_KEY>::value,
+             pair<const_iterator, const_iterator> >::type
+    equal_range(const LOOKUP_KEY& key) const;
+        // Return a pair of iterators providing non-modifiable access to the
+        // sequence of 'value_type' objects in this unordered map having a key
+        // equivalent to the specified 'key', as for the 'equal_range'
+        // overload taking a 'key_type', without converting 'key' to
+        // 'key_type'.  This overload participates in overload resolution only
+        // if both 'HASH' and 'EQUAL' are transparent (see
+        // {Heterogeneous Lookup}).
+
     const_iterator find(const key_type& key) const;
         // Return an iterator providing non-modifiable access to the
         // 'value_type' object in this unordered map with a key equivalent to
         // the specified 'key', if such an entry exists, and the past-the-end
         // iterator ('end') otherwise.
 
+    template <class LOOKUP_KEY>
+    typename enable_if<
+                BloombergLP::bslmf::IsTransparentPredicate<HASH,
+                                                           LOOKUP_KEY>::value
+             && BloombergLP::bslmf::IsTransparentPredicate<EQUAL,
+                                                           LOOKUP_KEY>::value,
+             const_iterator>::type
+    find(const LOOKUP_KEY& key) const;
+        // Return an iterator providing non-modifiable access to the
+        // 'value_type' object in this unordered map with a key equivalent to
+        // the specified 'key', if such an entry exists, and the past-the-end
+        // iterator ('end') otherwise.  'key' is passed to the hash and
+        // key-equality functors without being converted to 'key_type'.  This
+        // overload participates in overload resolution only if both 'HASH'
+        // and 'EQUAL' are transparent (see {Heterogeneous Lookup}).
+
     allocator_type get_allocator() const BSLS_CPP11_NOEXCEPT;
         // Return (a copy of) the allocator used for memory allocation by this
         // unordered map.
@@ -2542,6 +2659,20 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::find(const key_type& key)
     return iterator(d_impl.find(key));
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class LOOKUP_KEY>
+inline
+typename enable_if<
+    BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+ && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+    typename
+    unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator>::type
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::find(
+                                                         const LOOKUP_KEY& key)
+{
+    return iterator(d_impl.findTransparent(key));
+}
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 inline
 pair<typename unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::iterator,
@@ -2618,6 +2749,26 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::equal_range(
          : ResultType(iterator(0),     iterator(0));
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class LOOKUP_KEY>
+typename enable_if<
+    BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+ && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+    bsl::pair<typename unordered_map<KEY, VALUE, HASH, EQUAL,
+                                     ALLOCATOR>::iterator,
+              typename unordered_map<KEY, VALUE, HASH, EQUAL,
+                                     ALLOCATOR>::iterator> >::type
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::equal_range(
+                                                         const LOOKUP_KEY& key)
+{
+    typedef bsl::pair<iterator, iterator> ResultType;
+
+    HashTableLink *first = d_impl.findTransparent(key);
+    return first
+         ? ResultType(iterator(first), iterator(first->nextLink()))
+         : ResultType(iterator(0),     iterator(0));
+}
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 inline
 void
@@ -2799,6 +2950,20 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::count(
     return d_impl.find(key) != 0;
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class LOOKUP_KEY>
+inline
+typename enable_if<
+    BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+ && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+    typename
+    unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::size_type>::type
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::count(
+                                                   const LOOKUP_KEY& key) const
+{
+    return d_impl.findTransparent(key) != 0;
+}
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 inline
 bool
@@ -2830,6 +2995,26 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::equal_range(
          : ResultType(const_iterator(0),     const_iterator(0));
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class LOOKUP_KEY>
+typename enable_if<
+    BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+ && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+    bsl::pair<typename unordered_map<KEY, VALUE, HASH, EQUAL,
+                                     ALLOCATOR>::const_iterator,
+              typename unordered_map<KEY, VALUE, HASH, EQUAL,
+                                     ALLOCATOR>::const_iterator> >::type
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::equal_range(
+                                                   const LOOKUP_KEY& key) const
+{
+    typedef bsl::pair<const_iterator, const_iterator> ResultType;
+
+    HashTableLink *first = d_impl.findTransparent(key);
+    return first
+         ? ResultType(const_iterator(first), const_iterator(first->nextLink()))
+         : ResultType(const_iterator(0),     const_iterator(0));
+}
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 inline
 typename
@@ -2840,6 +3025,20 @@ unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::find(
     return const_iterator(d_impl.find(key));
 }
 
+template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
+template <class LOOKUP_KEY>
+inline
+typename enable_if<
+    BloombergLP::bslmf::IsTransparentPredicate<HASH, LOOKUP_KEY>::value
+ && BloombergLP::bslmf::IsTransparentPredicate<EQUAL, LOOKUP_KEY>::value,
+    typename
+    unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::const_iterator>::type
+unordered_map<KEY, VALUE, HASH, EQUAL, ALLOCATOR>::find(
+                                                   const LOOKUP_KEY& key) const
+{
+    return const_iterator(d_impl.findTransparent(key));
+}
+
 template <class KEY, class VALUE, class HASH, class EQUAL, class ALLOCATOR>
 inline
 ALLOCATOR
@@ -4,6 +4,7 @@
 #include <bslstl_hash.h>
 #include <bslstl_pair.h>
 #include <bslstl_string.h>
+#include <bslstl_stringref.h>
 #include <bslstl_vector.h>
 
 #include <bslalg_swaputil.h>
@@ -12,6 +13,7 @@
 #include <bslma_default.h>
 #include <bslma_defaultallocatorguard.h>
 #include <bslma_destructorguard.h>
+#include <bslma_newdeleteallocator.h>
 #include <bslma_testallocator.h>
 #include <bslma_testallocatormonitor.h>
 #include <bslma_usesbslmaallocator.h>
@@ -31,6 +33,7 @@
 #include <bsls_nameof.h>
 #include <bsls_objectbuffer.h>
 #include <bsls_platform.h>
+#include <bsls_stopwatch.h>
 #include <bsls_types.h>
 #include <bsls_util.h>
 
@@ -190,6 +193,11 @@ using bsl::pair;
 // [13] pair<const_iter, const_iter> equal_range(const KEY&) const;
 // [ 4] iterator find(const KEY& key);
 // [ 4] const_iterator find(const KEY& key) const;
+// [39] size_type count(const LOOKUP_KEY& key) const;
+// [39] pair<iterator, iterator> equal_range(const LOOKUP_KEY& key);
+// [39] pair<const_iter, const_iter> equal_range(const LOOKUP_KEY&) const;
+// [39] iterator find(const LOOKUP_KEY& key);
+// [39] const_iterator find(const LOOKUP_KEY& key) const;
 //
 // non-local iterators:
 // [14] iterator begin();
@@ -250,6 +258,7 @@ using bsl::pair;
 // [25] CONCERN: Constructor of a template wrapper class compiles.
 // [26] CONCERN: The type provides the full interface defined by the standard.
 // [36] CONCERN: 'unordered_map' supports incomplete types.
+// [39] CONCERN: Cached hash codes remain correct across rehash and erase.
 
 // ============================================================================
 //                      STANDARD BDE ASSERT TEST MACROS
@@ -16819,6 +16828,184 @@ int main(int argc, char *argv[])
     bslma::Default::setDefaultAllocator(&testAlloc);
 
     switch (test) { case 0:
+      case 39: {
+        // --------------------------------------------------------------------
+        // HETEROGENEOUS LOOKUP AND HASH CODE CACHING
+        //
+        // Concerns:
+        //: 1 When both 'HASH' and 'EQUAL' are transparent, 'find', 'count',
+        //:   and 'equal_range' accept a 'bslstl::StringRef' or a string
+        //:   literal for a map keyed by 'bsl::string', and find the same
+        //:   elements as the lookup taking 'key_type'.
+        //:
+        //: 2 Such lookups allocate no memory.
+        //:
+        //: 3 The heterogeneous overloads do not participate in overload
+        //:   resolution unless both functors are transparent.
+        //:
+        //: 4 When the hash functor has the 'bslstl::CacheHashCode' trait, the
+        //:   map remains consistent after insertions, rehashes, erasures,
+        //:   copies, and swaps.
+        //
+        // Plan:
+        //: 1 Populate a map using 'bslstl::TransparentStringHash' and
+        //:   'bsl::equal_to<>', then look up each key, and some absent keys,
+        //:   through every heterogeneous overload, comparing with the
+        //:   'key_type' overloads.  (C-1)
+        //:
+        //: 2 Install a test allocator as the default allocator and verify
+        //:   that neither it nor the object allocator is used by the lookups
+        //:   in P-1.  (C-2)
+        //:
+        //: 3 Verify that a 'StringRef' passed to a map using the default
+        //:   functors is converted to 'bsl::string', by observing an
+        //:   allocation of a long key.  (C-3)
+        //:
+        //: 4 Erase every other element, force several rehashes, copy, and
+        //:   swap the map, verifying after each step that exactly the
+        //:   expected keys are found, using a parallel map with default
+        //:   functors as an oracle.  (C-4)
+        //
+        // Testing:
+        //   size_type count(const LOOKUP_KEY& key) const;
+        //   pair<iterator, iterator> equal_range(const LOOKUP_KEY& key);
+        //   pair<const_iter, const_iter> equal_range(const LOOKUP_KEY&) const;
+        //   iterator find(const LOOKUP_KEY& key);
+        //   const_iterator find(const LOOKUP_KEY& key) const;
+        //   CONCERN: Cached hash codes remain correct across rehash and erase.
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nHETEROGENEOUS LOOKUP AND HASH CODE CACHING"
+                            "\n==========================================\n");
+
+        typedef bsl::unordered_map<bsl::string,
+                                   int,
+                                   bslstl::TransparentStringHash,
+                                   bsl::equal_to<> > TObj;
+        typedef bsl::unordered_map<bsl::string, int>  DObj;
+
+        BSLMF_ASSERT(bslstl::CacheHashCode<
+                                     bslstl::TransparentStringHash>::value);
+
+        const int NUM_KEYS = 500;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::TestAllocator         oa("object",  veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        TObj mX(&oa);  const TObj& X = mX;
+        DObj mY(&oa);  const DObj& Y = mY;
+
+        char buffer[64];
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            sprintf(buffer, "a key too long for the short string buffer %d",
+                    i);
+            mX[bsl::string(buffer, &oa)] = i;
+            mY[bsl::string(buffer, &oa)] = i;
+        }
+        ASSERTV(X.size(), NUM_KEYS == static_cast<int>(X.size()));
+
+        if (verbose) printf("Heterogeneous lookup does not allocate.\n");
+        {
+            const bsls::Types::Int64 NUM_DA = da.numAllocations();
+            const bsls::Types::Int64 NUM_OA = oa.numAllocations();
+
+            for (int i = 0; i < NUM_KEYS + 10; ++i) {
+                sprintf(buffer,
+                        "a key too long for the short string buffer %d",
+                        i);
+                const bslstl::StringRef KEY(buffer);
+                const bool              EXP = i < NUM_KEYS;
+
+                TObj::iterator       it  = mX.find(KEY);
+                TObj::const_iterator cit = X.find(KEY);
+
+                ASSERTV(i, EXP == (X.end() != it));
+                ASSERTV(i, EXP == (X.end() != cit));
+                ASSERTV(i, EXP == (1 == X.count(KEY)));
+                ASSERTV(i, EXP == (1 == X.count(buffer)));
+                if (EXP) {
+                    ASSERTV(i, it->second,  i == it->second);
+                    ASSERTV(i, cit->second, i == cit->second);
+                }
+
+                bsl::pair<TObj::iterator, TObj::iterator> R =
+                                                         mX.equal_range(KEY);
+                bsl::pair<TObj::const_iterator, TObj::const_iterator> CR =
+                                                          X.equal_range(KEY);
+                ASSERTV(i, it  == R.first);
+                ASSERTV(i, cit == CR.first);
+                ASSERTV(i, EXP == (1 == bsl::distance(R.first, R.second)));
+                ASSERTV(i, EXP == (1 == bsl::distance(CR.first, CR.second)));
+            }
+            ASSERTV(X.end() != mX.find("a key too long for the short string "
+                                       "buffer 7"));
+
+            ASSERTV(da.numAllocations() - NUM_DA,
+                    NUM_DA == da.numAllocations());
+            ASSERTV(oa.numAllocations() - NUM_OA,
+                    NUM_OA == oa.numAllocations());
+        }
+
+        if (verbose) printf("Non-transparent functors convert the key.\n");
+        {
+            const bsls::Types::Int64 NUM_DA = da.numAllocations();
+
+            const bslstl::StringRef KEY(
+                              "a key too long for the short string buffer 3");
+            ASSERTV(Y.end() != Y.find(KEY));
+            ASSERTV(NUM_DA < da.numAllocations());
+        }
+
+        if (verbose) printf("Cached hash codes survive modification.\n");
+        {
+            for (int i = 0; i < NUM_KEYS; i += 2) {
+                sprintf(buffer,
+                        "a key too long for the short string buffer %d",
+                        i);
+                ASSERTV(i, 1 == mX.erase(bsl::string(buffer, &oa)));
+                ASSERTV(i, 1 == mY.erase(bsl::string(buffer, &oa)));
+            }
+
+            for (int iteration = 0; iteration < 4; ++iteration) {
+                if (1 == iteration) {
+                    mX.rehash(X.bucket_count() * 8);
+                }
+                else if (2 == iteration) {
+                    mX.max_load_factor(4.0f);
+                    mX.rehash(1);
+                }
+                else if (3 == iteration) {
+                    TObj mZ(X, &oa);
+                    mX.clear();
+                    mX.swap(mZ);
+                }
+
+                ASSERTV(iteration, X.size(), Y.size() == X.size());
+
+                for (int i = 0; i < NUM_KEYS; ++i) {
+                    sprintf(buffer,
+                            "a key too long for the short string buffer %d",
+                            i);
+                    const bool EXP = 1 == (i % 2);
+
+                    ASSERTV(iteration, i, EXP == (1 == X.count(buffer)));
+                    ASSERTV(iteration, i, EXP == (1 == Y.count(buffer)));
+                    ASSERTV(iteration, i, EXP ==
+                                       (1 == X.count(bsl::string(buffer))));
+                }
+
+                for (DObj::const_iterator it = Y.begin(); it != Y.end();
+                                                                       ++it) {
+                    TObj::const_iterator jt = X.find(it->first);
+                    ASSERTV(iteration, it->first.c_str(), X.end() != jt);
+                    ASSERTV(iteration, it->first.c_str(),
+                            X.end() == jt || jt->second == it->second);
+                }
+                ASSERTV(iteration, X.end() == X.find(""));
+            }
+        }
+      } break;
       case 38: {
         // --------------------------------------------------------------------
         // 'noexcept' SPECIFICATION
@@ -17882,6 +18069,138 @@ int main(int argc, char *argv[])
         if (veryVerbose)
             printf("Final message to confim the end of the breathing test.\n");
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE OF STRING LOOKUP
+        //
+        // Concerns:
+        //: 1 Measure the cost of looking up 'bsl::string' keys given as
+        //:   'bslstl::StringRef' objects with the default functors, which
+        //:   create a temporary 'bsl::string' for each lookup, compared with
+        //:   the transparent, hash-caching 'bslstl::TransparentStringHash'
+        //:   and 'bsl::equal_to<>'.
+        //:
+        //: 2 Measure the cost of rehashing in both configurations.
+        //
+        // Plan:
+        //: 1 Populate each map with the same long keys, and time repeated
+        //:   successful and unsuccessful lookups, and a sequence of rehashes.
+        //
+        // Testing:
+        //   PERFORMANCE OF STRING LOOKUP
+        // --------------------------------------------------------------------
+
+        if (verbose) printf("\nPERFORMANCE OF STRING LOOKUP"
+                            "\n============================\n");
+
+        typedef bsl::unordered_map<bsl::string, int>  DObj;
+        typedef bsl::unordered_map<bsl::string,
+                                   int,
+                                   bslstl::TransparentStringHash,
+                                   bsl::equal_to<> > TObj;
+
+        // Avoid the bookkeeping of the test allocator installed as default.
+
+        bslma::DefaultAllocatorGuard dag(
+                                  &bslma::NewDeleteAllocator::singleton());
+
+        const int NUM_KEYS = 100000;
+        const int NUM_REPS = 10;
+
+        bsl::vector<bsl::string>       keys;
+        bsl::vector<bslstl::StringRef> hits;
+        bsl::vector<bslstl::StringRef> misses;
+
+        char buffer[64];
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            sprintf(buffer, "/root/directory/path/of/some/length/%08d", i);
+            keys.push_back(buffer);
+        }
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            hits.push_back(keys[(i * 7919) % NUM_KEYS]);
+        }
+        bsl::vector<bsl::string> absent;
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            sprintf(buffer, "/root/directory/path/of/some/length/%08dx", i);
+            absent.push_back(buffer);
+        }
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            misses.push_back(absent[i]);
+        }
+
+        DObj mD;
+        TObj mT;
+        for (int i = 0; i < NUM_KEYS; ++i) {
+            mD[keys[i]] = i;
+            mT[keys[i]] = i;
+        }
+
+        bsls::Stopwatch timer;
+        long            total = 0;
+
+        timer.start(true);
+        for (int r = 0; r < NUM_REPS; ++r) {
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                total += mD.find(hits[i])->second;
+            }
+        }
+        timer.stop();
+        const double DHIT = timer.accumulatedWallTime();
+
+        timer.reset();
+        timer.start(true);
+        for (int r = 0; r < NUM_REPS; ++r) {
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                total += mT.find(hits[i])->second;
+            }
+        }
+        timer.stop();
+        const double THIT = timer.accumulatedWallTime();
+
+        timer.reset();
+        timer.start(true);
+        for (int r = 0; r < NUM_REPS; ++r) {
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                total += static_cast<long>(mD.count(misses[i]));
+            }
+        }
+        timer.stop();
+        const double DMISS = timer.accumulatedWallTime();
+
+        timer.reset();
+        timer.start(true);
+        for (int r = 0; r < NUM_REPS; ++r) {
+            for (int i = 0; i < NUM_KEYS; ++i) {
+                total += static_cast<long>(mT.count(misses[i]));
+            }
+        }
+        timer.stop();
+        const double TMISS = timer.accumulatedWallTime();
+
+        timer.reset();
+        timer.start(true);
+        for (int r = 1; r <= NUM_REPS; ++r) {
+            mD.rehash(NUM_KEYS * (r % 2 ? 4 : 2));
+        }
+        timer.stop();
+        const double DREHASH = timer.accumulatedWallTime();
+
+        timer.reset();
+        timer.start(true);
+        for (int r = 1; r <= NUM_REPS; ++r) {
+            mT.rehash(NUM_KEYS * (r % 2 ? 4 : 2));
+        }
+        timer.stop();
+        const double TREHASH = timer.accumulatedWallTime();
+
+        ASSERTV(total, 0 < total);
+
+        printf("%d keys, %d repetitions (seconds)\n", NUM_KEYS, NUM_REPS);
+        printf("%-10s %12s %12s\n", "", "default", "transparent");
+        printf("%-10s %12.4f %12.4f\n", "find hit",  DHIT,    THIT);
+        printf("%-10s %12.4f %12.4f\n", "count miss", DMISS,   TMISS);
+        printf("%-10s %12.4f %12.4f\n", "rehash",    DREHASH, TREHASH);
+      } break;
       default: {
         fprintf(stderr, "WARNING: CASE `%d' NOT FOUND.\n", test);
         testStatus = -1;
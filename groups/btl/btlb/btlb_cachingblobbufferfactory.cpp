@@ -0,0 +1,635 @@
+// btlb_cachingblobbufferfactory.cpp                                  -*-C++-*-
+#include <btlb_cachingblobbufferfactory.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(btlb_cachingblobbufferfactory_cpp,"$Id$ $CSID$")
+
+#include <bdlma_infrequentdeleteblocklist.h>
+
+#include <bslma_default.h>
+#include <bslma_sharedptrrep.h>
+#include <bslmt_lockguard.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_memory.h>
+#include <bsl_new.h>
+#include <bsl_typeinfo.h>
+
+// IMPLEMENTATION NOTES: Each buffer supplied by this factory is carved out of
+// a *block* that starts with the shared pointer representation of the buffer
+// (a 'CachingBlobBufferFactory_Rep'), followed by the buffer itself, suitably
+// aligned.  While a block is free, its first bytes are instead used as a
+// 'CachingBlobBufferFactory_Block' to link it in a magazine.  The first block
+// of a magazine stored in the depot of a size class additionally records the
+// number of blocks in the magazine, and links to the next magazine of the
+// depot.
+//
+// The cache of a thread holds, for each size class, a *loaded* magazine (from
+// which blocks are allocated and to which blocks are released) and a
+// *previous* magazine that is either empty or full, as described in "Magazines
+// and Vmem: Extending the Slab Allocator to Many CPUs and Arbitrary Resources"
+// (Bonwick and Adams, 2001).  When the loaded magazine is empty upon
+// allocation, it is exchanged with the previous magazine if that one is full,
+// and is refilled from the depot otherwise; when the loaded magazine is full
+// upon release, the previous magazine (if full) is returned to the depot, and
+// the loaded magazine becomes the previous one.  A thread alternating between
+// allocating and releasing a buffer therefore never accesses the depot, and
+// a thread accesses the depot at most once every 'magazineCapacity'
+// operations otherwise.
+//
+// If no thread-specific storage key could be created, there is no thread
+// cache: each block is popped from, or pushed onto, the first magazine of the
+// depot, under the lock of the depot, so that the magazines of the depot hold
+// at most 'magazineCapacity' blocks as usual.
+
+namespace BloombergLP {
+namespace btlb {
+
+                    // =====================================
+                    // struct CachingBlobBufferFactory_Block
+                    // =====================================
+
+struct CachingBlobBufferFactory_Block {
+    // This 'struct' overlays a free block.
+
+    // DATA
+    CachingBlobBufferFactory_Block *d_next_p;          // next free block of
+                                                       // the magazine
+
+    CachingBlobBufferFactory_Block *d_nextMagazine_p;  // first block of the
+                                                       // next magazine of the
+                                                       // depot
+
+    int                             d_numBlocks;       // number of blocks in
+                                                       // the magazine
+};
+
+                   // ========================================
+                   // struct CachingBlobBufferFactory_Magazine
+                   // ========================================
+
+struct CachingBlobBufferFactory_Magazine {
+    // This 'struct' holds a list of free blocks of a size class in the cache
+    // of a thread.
+
+    // DATA
+    CachingBlobBufferFactory_Block *d_head_p;     // first free block
+    int                             d_numBlocks;  // number of free blocks
+};
+
+                  // =========================================
+                  // struct CachingBlobBufferFactory_SizeClass
+                  // =========================================
+
+struct CachingBlobBufferFactory_SizeClass {
+    // This 'struct' holds the depot of a size class.
+
+    // DATA
+    bslmt::Mutex                     d_mutex;        // protects the following
+
+    CachingBlobBufferFactory_Block  *d_magazines_p;  // list of magazines in
+                                                     // the depot
+
+    bdlma::InfrequentDeleteBlockList d_slabs;        // memory from which new
+                                                     // blocks are carved
+
+    int                              d_bufferSize;   // size of the buffers
+
+    int                              d_blockSize;    // size of the blocks
+
+    // CREATORS
+    CachingBlobBufferFactory_SizeClass(int               bufferSize,
+                                       int               blockSize,
+                                       bslma::Allocator *basicAllocator)
+    : d_magazines_p(0)
+    , d_slabs(basicAllocator)
+    , d_bufferSize(bufferSize)
+    , d_blockSize(blockSize)
+    {
+    }
+};
+
+                 // ===========================================
+                 // struct CachingBlobBufferFactory_ThreadCache
+                 // ===========================================
+
+struct CachingBlobBufferFactory_ThreadCache {
+    // This 'struct' holds the free blocks cached by a thread, and is followed
+    // in memory by the 'd_loaded_p' and 'd_previous_p' arrays.
+
+    // DATA
+    CachingBlobBufferFactory             *d_factory_p;   // owning factory
+
+    CachingBlobBufferFactory_ThreadCache *d_next_p;      // next thread cache
+                                                         // of the factory
+
+    CachingBlobBufferFactory_ThreadCache *d_prev_p;      // previous thread
+                                                         // cache of the
+                                                         // factory
+
+    CachingBlobBufferFactory_Magazine    *d_loaded_p;    // loaded magazine of
+                                                         // each size class
+
+    CachingBlobBufferFactory_Magazine    *d_previous_p;  // previous magazine
+                                                         // of each size class
+
+    // CLASS METHODS
+    static void threadExit(void *cache)
+        // Release the specified 'cache' of an exiting thread.
+    {
+        CachingBlobBufferFactory_ThreadCache *threadCache =
+                    static_cast<CachingBlobBufferFactory_ThreadCache *>(cache);
+        threadCache->d_factory_p->releaseThreadCache(threadCache);
+    }
+};
+
+                     // ==================================
+                     // class CachingBlobBufferFactory_Rep
+                     // ==================================
+
+class CachingBlobBufferFactory_Rep : public bslma::SharedPtrRep {
+    // This class provides the shared pointer representation of a buffer
+    // supplied by a 'CachingBlobBufferFactory', located at the start of the
+    // block holding the buffer.
+
+    // DATA
+    CachingBlobBufferFactory *d_factory_p;  // owning factory
+    int                       d_sizeClass;  // size class of the block
+
+  public:
+    // CLASS DATA
+    static const int k_HEADER_SIZE;         // offset of the buffer in the
+                                            // block
+
+    // CREATORS
+    CachingBlobBufferFactory_Rep(CachingBlobBufferFactory *factory,
+                                 int                       sizeClass)
+        // Create a representation of the buffer of the block at the address
+        // of this object, of the specified 'sizeClass' of the specified
+        // 'factory'.
+    : d_factory_p(factory)
+    , d_sizeClass(sizeClass)
+    {
+    }
+
+    // MANIPULATORS
+    virtual void disposeObject()
+        // Do nothing: the buffer does not need to be destroyed.
+    {
+    }
+
+    virtual void disposeRep()
+        // Return the block holding this object to the factory.
+    {
+        d_factory_p->deallocateBlock(this, d_sizeClass);
+    }
+
+    virtual void *getDeleter(const std::type_info&)
+        // Return 0: buffers have no deleter.
+    {
+        return 0;
+    }
+
+    char *buffer()
+        // Return the address of the buffer of the block holding this object.
+    {
+        return reinterpret_cast<char *>(this) + k_HEADER_SIZE;
+    }
+
+    // ACCESSORS
+    virtual void *originalPtr() const
+        // Return the address of the buffer of the block holding this object.
+    {
+        return const_cast<char *>(reinterpret_cast<const char *>(this))
+                                                              + k_HEADER_SIZE;
+    }
+};
+
+const int CachingBlobBufferFactory_Rep::k_HEADER_SIZE =
+      static_cast<int>(bsls::AlignmentUtil::roundUpToMaximalAlignment(
+                                        sizeof(CachingBlobBufferFactory_Rep)));
+
+}  // close package namespace
+
+namespace {
+
+extern "C" void btlb_CachingBlobBufferFactory_threadExit(void *cache)
+    // Release the specified 'cache' of an exiting thread.
+{
+    btlb::CachingBlobBufferFactory_ThreadCache::threadExit(cache);
+}
+
+btlb::CachingBlobBufferFactory_Block *carveMagazine(char *slab,
+                                                    int   blockSize,
+                                                    int   numBlocks)
+    // Link the specified 'numBlocks' blocks of the specified 'blockSize'
+    // bytes, carved out of the specified 'slab', into a list, and return the
+    // first block of the list.  Note that the blocks are first touched by the
+    // calling thread.
+{
+    typedef btlb::CachingBlobBufferFactory_Block Block;
+
+    Block *head = 0;
+    for (int i = numBlocks - 1; 0 <= i; --i) {
+        Block *block = reinterpret_cast<Block *>(slab + i * blockSize);
+        block->d_next_p = head;
+        head            = block;
+    }
+    return head;
+}
+
+}  // close unnamed namespace
+
+namespace btlb {
+
+                       // ------------------------------
+                       // class CachingBlobBufferFactory
+                       // ------------------------------
+
+// PRIVATE MANIPULATORS
+void *CachingBlobBufferFactory::allocateFromDepot(int sizeClass)
+{
+    typedef CachingBlobBufferFactory_Block Block;
+
+    SizeClass& depot = *d_sizeClasses[sizeClass];
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+    Block *head = depot.d_magazines_p;
+    if (!head) {
+        char *slab = static_cast<char *>(depot.d_slabs.allocate(
+                                  static_cast<bsl::size_t>(d_magazineCapacity)
+                                                         * depot.d_blockSize));
+        head = carveMagazine(slab, depot.d_blockSize, d_magazineCapacity);
+        head->d_nextMagazine_p = 0;
+        head->d_numBlocks      = d_magazineCapacity;
+    }
+
+    if (1 < head->d_numBlocks) {
+        Block *next = head->d_next_p;
+        next->d_nextMagazine_p = head->d_nextMagazine_p;
+        next->d_numBlocks      = head->d_numBlocks - 1;
+        depot.d_magazines_p    = next;
+    }
+    else {
+        depot.d_magazines_p = head->d_nextMagazine_p;
+    }
+    return head;
+}
+
+void CachingBlobBufferFactory::allocateFromSizeClass(BlobBuffer *buffer,
+                                                     int         sizeClass)
+{
+    CachingBlobBufferFactory_Block *block;
+
+    if (d_hasKey) {
+        ThreadCache *cache = threadCache();
+
+        CachingBlobBufferFactory_Magazine& loaded =
+                                                 cache->d_loaded_p[sizeClass];
+        if (0 == loaded.d_numBlocks) {
+            CachingBlobBufferFactory_Magazine& previous =
+                                               cache->d_previous_p[sizeClass];
+            if (previous.d_numBlocks) {
+                loaded               = previous;
+                previous.d_head_p    = 0;
+                previous.d_numBlocks = 0;
+            }
+            else {
+                refill(cache, sizeClass);
+            }
+        }
+
+        block           = loaded.d_head_p;
+        loaded.d_head_p = block->d_next_p;
+        --loaded.d_numBlocks;
+    }
+    else {
+        block = static_cast<CachingBlobBufferFactory_Block *>(
+                                                 allocateFromDepot(sizeClass));
+    }
+
+    CachingBlobBufferFactory_Rep *rep =
+                           new (block) CachingBlobBufferFactory_Rep(this,
+                                                                    sizeClass);
+    buffer->reset(bsl::shared_ptr<char>(rep->buffer(), rep),
+                  d_sizeClasses[sizeClass]->d_bufferSize);
+}
+
+void CachingBlobBufferFactory::deallocateBlock(void *block, int sizeClass)
+{
+    typedef CachingBlobBufferFactory_Block Block;
+
+    if (!d_hasKey) {
+        SizeClass& depot = *d_sizeClasses[sizeClass];
+        Block     *first = static_cast<Block *>(block);
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+        Block *head = depot.d_magazines_p;
+        if (head && head->d_numBlocks < d_magazineCapacity) {
+            first->d_next_p         = head;
+            first->d_nextMagazine_p = head->d_nextMagazine_p;
+            first->d_numBlocks      = head->d_numBlocks + 1;
+        }
+        else {
+            first->d_next_p         = 0;
+            first->d_nextMagazine_p = head;
+            first->d_numBlocks      = 1;
+        }
+        depot.d_magazines_p = first;
+        return;                                                       // RETURN
+    }
+
+    ThreadCache *cache = threadCache();
+
+    CachingBlobBufferFactory_Magazine& loaded = cache->d_loaded_p[sizeClass];
+    if (d_magazineCapacity == loaded.d_numBlocks) {
+        CachingBlobBufferFactory_Magazine& previous =
+                                               cache->d_previous_p[sizeClass];
+        if (previous.d_numBlocks) {
+            SizeClass& depot = *d_sizeClasses[sizeClass];
+
+            CachingBlobBufferFactory_Block *head = previous.d_head_p;
+            head->d_numBlocks = previous.d_numBlocks;
+
+            bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+            head->d_nextMagazine_p = depot.d_magazines_p;
+            depot.d_magazines_p    = head;
+        }
+        previous.d_head_p    = loaded.d_head_p;
+        previous.d_numBlocks = loaded.d_numBlocks;
+        loaded.d_head_p      = 0;
+        loaded.d_numBlocks   = 0;
+    }
+
+    Block *freeBlock = static_cast<Block *>(block);
+    freeBlock->d_next_p = loaded.d_head_p;
+    loaded.d_head_p     = freeBlock;
+    ++loaded.d_numBlocks;
+}
+
+void CachingBlobBufferFactory::flushThreadCache(ThreadCache *cache)
+{
+    for (int i = 0; i < numSizeClasses(); ++i) {
+        CachingBlobBufferFactory_Magazine *magazines[] = {
+            cache->d_loaded_p + i,
+            cache->d_previous_p + i
+        };
+
+        for (int j = 0; j < 2; ++j) {
+            CachingBlobBufferFactory_Magazine& magazine = *magazines[j];
+            if (0 == magazine.d_numBlocks) {
+                continue;
+            }
+
+            SizeClass& depot = *d_sizeClasses[i];
+
+            CachingBlobBufferFactory_Block *head = magazine.d_head_p;
+            head->d_numBlocks = magazine.d_numBlocks;
+            {
+                bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+                head->d_nextMagazine_p = depot.d_magazines_p;
+                depot.d_magazines_p    = head;
+            }
+            magazine.d_head_p    = 0;
+            magazine.d_numBlocks = 0;
+        }
+    }
+}
+
+void CachingBlobBufferFactory::init(int numSizeClasses)
+{
+    BSLS_ASSERT(0 < (d_bufferSize >> (numSizeClasses - 1)));
+
+    // If the platform has no thread-specific storage key left, buffers are
+    // allocated from, and released to, the depots directly.
+
+    d_hasKey = 0 == bslmt::ThreadUtil::createKey(
+                                    &d_key,
+                                    &btlb_CachingBlobBufferFactory_threadExit);
+
+    d_sizeClasses.reserve(numSizeClasses);
+    for (int i = 0; i < numSizeClasses; ++i) {
+        const int size      = d_bufferSize >> i;
+        const int blockSize = static_cast<int>(
+                     CachingBlobBufferFactory_Rep::k_HEADER_SIZE
+                   + bsls::AlignmentUtil::roundUpToMaximalAlignment(size));
+
+        d_sizeClasses.push_back(new (*d_allocator_p) SizeClass(size,
+                                                               blockSize,
+                                                               d_allocator_p));
+    }
+}
+
+void CachingBlobBufferFactory::refill(ThreadCache *cache, int sizeClass)
+{
+    BSLS_ASSERT(0 == cache->d_loaded_p[sizeClass].d_numBlocks);
+
+    SizeClass&                         depot  = *d_sizeClasses[sizeClass];
+    CachingBlobBufferFactory_Magazine& loaded = cache->d_loaded_p[sizeClass];
+
+    char *slab;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+        CachingBlobBufferFactory_Block *head = depot.d_magazines_p;
+        if (head) {
+            depot.d_magazines_p = head->d_nextMagazine_p;
+            loaded.d_head_p     = head;
+            loaded.d_numBlocks  = head->d_numBlocks;
+            return;                                                   // RETURN
+        }
+
+        slab = static_cast<char *>(depot.d_slabs.allocate(
+                                  static_cast<bsl::size_t>(d_magazineCapacity)
+                                                         * depot.d_blockSize));
+    }
+
+    loaded.d_head_p    = carveMagazine(slab,
+                                       depot.d_blockSize,
+                                       d_magazineCapacity);
+    loaded.d_numBlocks = d_magazineCapacity;
+}
+
+void CachingBlobBufferFactory::releaseThreadCache(ThreadCache *cache)
+{
+    flushThreadCache(cache);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_threadCachesMutex);
+        if (cache->d_prev_p) {
+            cache->d_prev_p->d_next_p = cache->d_next_p;
+        }
+        else {
+            d_threadCaches_p = cache->d_next_p;
+        }
+        if (cache->d_next_p) {
+            cache->d_next_p->d_prev_p = cache->d_prev_p;
+        }
+    }
+
+    d_allocator_p->deallocate(cache);
+}
+
+CachingBlobBufferFactory::ThreadCache *
+CachingBlobBufferFactory::threadCache()
+{
+    ThreadCache *cache = static_cast<ThreadCache *>(
+                                       bslmt::ThreadUtil::getSpecific(d_key));
+    if (cache) {
+        return cache;                                                 // RETURN
+    }
+
+    const int numClasses = numSizeClasses();
+
+    cache = static_cast<ThreadCache *>(d_allocator_p->allocate(
+              sizeof(ThreadCache)
+            + 2 * numClasses * sizeof(CachingBlobBufferFactory_Magazine)));
+
+    cache->d_factory_p  = this;
+    cache->d_prev_p     = 0;
+    cache->d_loaded_p   =
+              reinterpret_cast<CachingBlobBufferFactory_Magazine *>(cache + 1);
+    cache->d_previous_p = cache->d_loaded_p + numClasses;
+    for (int i = 0; i < 2 * numClasses; ++i) {
+        cache->d_loaded_p[i].d_head_p    = 0;
+        cache->d_loaded_p[i].d_numBlocks = 0;
+    }
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_threadCachesMutex);
+        cache->d_next_p = d_threadCaches_p;
+        if (d_threadCaches_p) {
+            d_threadCaches_p->d_prev_p = cache;
+        }
+        d_threadCaches_p = cache;
+    }
+
+    bslmt::ThreadUtil::setSpecific(d_key, cache);
+    return cache;
+}
+
+// CREATORS
+CachingBlobBufferFactory::CachingBlobBufferFactory(
+                                              int               bufferSize,
+                                              bslma::Allocator *basicAllocator)
+: d_bufferSize(bufferSize)
+, d_magazineCapacity(k_DEFAULT_MAGAZINE_CAPACITY)
+, d_sizeClasses(basicAllocator)
+, d_hasKey(false)
+, d_threadCaches_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < bufferSize);
+
+    init(1);
+}
+
+CachingBlobBufferFactory::CachingBlobBufferFactory(
+                                              int               bufferSize,
+                                              int               numSizeClasses,
+                                              bslma::Allocator *basicAllocator)
+: d_bufferSize(bufferSize)
+, d_magazineCapacity(k_DEFAULT_MAGAZINE_CAPACITY)
+, d_sizeClasses(basicAllocator)
+, d_hasKey(false)
+, d_threadCaches_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < bufferSize);
+    BSLS_ASSERT(0 < numSizeClasses);
+
+    init(numSizeClasses);
+}
+
+CachingBlobBufferFactory::CachingBlobBufferFactory(
+                                            int               bufferSize,
+                                            int               numSizeClasses,
+                                            int               magazineCapacity,
+                                            bslma::Allocator *basicAllocator)
+: d_bufferSize(bufferSize)
+, d_magazineCapacity(magazineCapacity)
+, d_sizeClasses(basicAllocator)
+, d_hasKey(false)
+, d_threadCaches_p(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    BSLS_ASSERT(0 < bufferSize);
+    BSLS_ASSERT(0 < numSizeClasses);
+    BSLS_ASSERT(0 < magazineCapacity);
+
+    init(numSizeClasses);
+}
+
+CachingBlobBufferFactory::~CachingBlobBufferFactory()
+{
+    // Caches of threads that are still running are deallocated here; the
+    // deletion of the key ensures that they are not released again when these
+    // threads exit.
+
+    if (d_hasKey) {
+        bslmt::ThreadUtil::deleteKey(d_key);
+    }
+
+    while (d_threadCaches_p) {
+        ThreadCache *cache = d_threadCaches_p;
+        d_threadCaches_p = cache->d_next_p;
+        d_allocator_p->deallocate(cache);
+    }
+
+    for (bsl::size_t i = 0; i < d_sizeClasses.size(); ++i) {
+        d_allocator_p->deleteObject(d_sizeClasses[i]);
+    }
+}
+
+// MANIPULATORS
+void CachingBlobBufferFactory::allocate(BlobBuffer *buffer, int minSize)
+{
+    BSLS_ASSERT(0 <= minSize);
+    BSLS_ASSERT(minSize <= d_bufferSize);
+
+    int sizeClass = 0;
+    while (sizeClass + 1 < numSizeClasses()
+        && minSize <= d_sizeClasses[sizeClass + 1]->d_bufferSize) {
+        ++sizeClass;
+    }
+
+    allocateFromSizeClass(buffer, sizeClass);
+}
+
+void CachingBlobBufferFactory::flushThreadCache()
+{
+    if (!d_hasKey) {
+        return;                                                       // RETURN
+    }
+
+    ThreadCache *cache = static_cast<ThreadCache *>(
+                                       bslmt::ThreadUtil::getSpecific(d_key));
+    if (cache) {
+        flushThreadCache(cache);
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,384 @@
+// btlb_cachingblobbufferfactory.h                                    -*-C++-*-
+#ifndef INCLUDED_BTLB_CACHINGBLOBBUFFERFACTORY
+#define INCLUDED_BTLB_CACHINGBLOBBUFFERFACTORY
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a blob buffer factory with per-thread buffer caches.
+//
+//@CLASSES:
+//  btlb::CachingBlobBufferFactory: factory caching free buffers per thread
+//
+//@SEE_ALSO: btlb_pooledblobbufferfactory, btlb_blob
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'btlb::CachingBlobBufferFactory', implementing the 'btlb::BlobBufferFactory'
+// protocol for allocating 'btlb::BlobBuffer' objects from a small number of
+// fixed *size* *classes*, in a way that scales with the number of threads
+// allocating and releasing buffers concurrently.
+//
+// A 'btlb::PooledBlobBufferFactory' serves every thread from a single
+// concurrent pool, so that each allocation and each release of a buffer
+// modifies the same shared free list: when several threads (e.g., the
+// dispatcher threads of a 'btlmt::ChannelPool') churn through buffers, the
+// cache line holding the head of that list moves from processor to processor
+// on nearly every operation.  A 'btlb::CachingBlobBufferFactory' instead
+// gives each thread its own cache of free buffers, from which buffers are
+// allocated and to which they are released without any synchronization.
+// Only when a thread's cache runs empty, or overflows, does the thread access
+// the shared *depot*, exchanging a whole *magazine* of buffers (whose number
+// is the magazine capacity specified at construction) at once.  Buffers
+// released by a thread other than the one that allocated them (e.g., read
+// buffers handed over to a processing thread) thus travel back to the
+// allocating threads in batches, through the depot.  New buffers are carved
+// out of large slabs of memory, one magazine at a time, by the first thread
+// needing them, so that a thread's buffers are typically close together in
+// memory, and (with a first-touch memory policy) local to the NUMA node on
+// which that thread runs.
+//
+///Size Classes
+///------------
+// The factory supports a configurable number of size classes: the first size
+// class is the buffer size specified at construction, and each following size
+// class is half the size of the previous one.  'allocate(BlobBuffer *)' (the
+// 'btlb::BlobBufferFactory' protocol) always supplies buffers of the first
+// size class, whereas 'allocate(BlobBuffer *, int)' supplies a buffer of the
+// smallest size class holding at least the specified number of bytes.  Each
+// size class has its own magazines and depot.
+//
+///Memory Usage
+///------------
+// Memory supplied to the factory's allocator is not returned until the
+// factory is destroyed.  In addition to the buffers in use, each thread that
+// allocated or released buffers may hold up to two magazines of free buffers
+// per size class in its cache; the cache of a thread is returned to the depot
+// when the thread exits, or when the thread calls 'flushThreadCache'.  All
+// buffers supplied by the factory must be released before the factory is
+// destroyed.
+//
+///Thread-Specific Storage Keys
+///-----------------------------
+// Each 'btlb::CachingBlobBufferFactory' finds the cache of the calling thread
+// through a thread-specific storage key of its own (see
+// 'bslmt::ThreadUtil::createKey'), which it holds until it is destroyed.  The
+// number of such keys is limited by the platform (e.g., to
+// 'PTHREAD_KEYS_MAX', usually 1024, on POSIX platforms), and is shared with
+// every other component of the process; note that a 'btlmt::ChannelPool'
+// configured with 'threadCachedBuffers' creates two factories.  A factory
+// created when no key is available does not fail: it does not cache buffers
+// per thread, and instead allocates each buffer from, and releases each
+// buffer to, the depot of its size class, under the lock of the depot, so
+// that it behaves much like a 'btlb::PooledBlobBufferFactory'.  Applications
+// creating many factories should therefore prefer a
+// 'btlb::PooledBlobBufferFactory', or share a few caching factories.
+// 'isCaching' indicates whether a factory caches buffers per thread.
+//
+///Thread Safety
+///-------------
+// 'btlb::CachingBlobBufferFactory' is *fully* *thread-safe*, meaning that any
+// operation can be called on the *same* *instance* from any thread.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating Buffers of Different Sizes
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// First, we create a factory supplying buffers of 8192, 4096 and 2048 bytes,
+// which we use to supply the buffers of a blob:
+//..
+//  btlb::CachingBlobBufferFactory factory(8192, 3);
+//  assert(8192 == factory.bufferSize());
+//  assert(2048 == factory.sizeClassSize(2));
+//
+//  btlb::Blob blob(&factory);
+//  blob.setLength(10000);
+//  assert(2     == blob.numBuffers());
+//  assert(16384 == blob.totalSize());
+//..
+// Then, we append the remainder of a message, which we know to be small, in
+// a buffer of the smallest size class that can hold it:
+//..
+//  btlb::BlobBuffer buffer;
+//  factory.allocate(&buffer, 1500);
+//  assert(2048 == buffer.size());
+//
+//  blob.appendDataBuffer(buffer);
+//..
+// Finally, a thread that is about to stop allocating buffers for a long time
+// can make the buffers in its cache available to the other threads:
+//..
+//  factory.flushThreadCache();
+//..
+
+#ifndef INCLUDED_BTLSCM_VERSION
+#include <btlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BTLB_BLOB
+#include <btlb_blob.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace btlb {
+
+class CachingBlobBufferFactory_Rep;
+struct CachingBlobBufferFactory_SizeClass;
+struct CachingBlobBufferFactory_ThreadCache;
+
+                       // ==============================
+                       // class CachingBlobBufferFactory
+                       // ==============================
+
+class CachingBlobBufferFactory : public BlobBufferFactory {
+    // This class implements the 'BlobBufferFactory' protocol and provides a
+    // mechanism for allocating 'BlobBuffer' objects from a set of size
+    // classes, caching free buffers in per-thread magazines that are
+    // exchanged with a shared depot in batches.
+
+    // PRIVATE TYPES
+    typedef CachingBlobBufferFactory_SizeClass   SizeClass;
+    typedef CachingBlobBufferFactory_ThreadCache ThreadCache;
+
+    // DATA
+    int                      d_bufferSize;        // size of the buffers of the
+                                                  // first size class
+
+    int                      d_magazineCapacity;  // number of buffers in a
+                                                  // magazine
+
+    bsl::vector<SizeClass *> d_sizeClasses;       // depot of each size class
+                                                  // (owned)
+
+    bslmt::ThreadUtil::Key   d_key;               // key of the thread cache
+                                                  // of the calling thread
+
+    bool                     d_hasKey;            // 'true' if 'd_key' was
+                                                  // created, and buffers are
+                                                  // cached per thread
+
+    ThreadCache             *d_threadCaches_p;    // list of the thread caches
+                                                  // of all threads (owned)
+
+    bslmt::Mutex             d_threadCachesMutex; // protects
+                                                  // 'd_threadCaches_p'
+
+    bslma::Allocator        *d_allocator_p;       // memory allocator (held)
+
+    // FRIENDS
+    friend class CachingBlobBufferFactory_Rep;
+    friend struct CachingBlobBufferFactory_ThreadCache;
+
+  private:
+    // NOT IMPLEMENTED
+    CachingBlobBufferFactory(const CachingBlobBufferFactory&);
+    CachingBlobBufferFactory& operator=(const CachingBlobBufferFactory&);
+
+    // PRIVATE MANIPULATORS
+    void allocateFromSizeClass(BlobBuffer *buffer, int sizeClass);
+        // Allocate a buffer of the specified 'sizeClass' from the cache of the
+        // calling thread (or from the depot of 'sizeClass' if no
+        // thread-specific storage key is available), and load it into the
+        // specified 'buffer'.
+
+    void *allocateFromDepot(int sizeClass);
+        // Return the address of a free block of the specified 'sizeClass',
+        // taken directly from the depot of 'sizeClass', or carved out of a
+        // new slab if the depot is empty.  This method is used only if no
+        // thread-specific storage key is available.
+
+    void deallocateBlock(void *block, int sizeClass);
+        // Return the specified 'block' of the specified 'sizeClass' to the
+        // cache of the calling thread, or to the depot of 'sizeClass' if no
+        // thread-specific storage key is available.
+
+    void flushThreadCache(ThreadCache *cache);
+        // Return all the buffers held by the specified 'cache' to the depot of
+        // their size class.
+
+    void init(int numSizeClasses);
+        // Create the specified 'numSizeClasses' size classes of this factory,
+        // and the key of the thread caches if one is available.  This method
+        // is invoked only by the constructors.
+
+    void refill(ThreadCache *cache, int sizeClass);
+        // Load into the specified 'cache' a magazine of free buffers of the
+        // specified 'sizeClass', taken from the depot or, if the depot is
+        // empty, carved out of a new slab.  The behavior is undefined unless
+        // 'cache' holds no buffer of 'sizeClass'.
+
+    void releaseThreadCache(ThreadCache *cache);
+        // Flush and deallocate the specified 'cache'.  This method is invoked
+        // when the thread owning 'cache' exits.
+
+    ThreadCache *threadCache();
+        // Return the cache of the calling thread, creating it if needed.
+
+  public:
+    // CONSTANTS
+    enum {
+        k_DEFAULT_MAGAZINE_CAPACITY = 32  // magazine capacity used unless
+                                          // specified at construction
+    };
+
+    // CREATORS
+    explicit
+    CachingBlobBufferFactory(int               bufferSize,
+                             bslma::Allocator *basicAllocator = 0);
+    CachingBlobBufferFactory(int               bufferSize,
+                             int               numSizeClasses,
+                             bslma::Allocator *basicAllocator = 0);
+    CachingBlobBufferFactory(int               bufferSize,
+                             int               numSizeClasses,
+                             int               magazineCapacity,
+                             bslma::Allocator *basicAllocator = 0);
+        // Create a factory for allocating 'BlobBuffer' objects of the
+        // specified 'bufferSize'.  Optionally specify 'numSizeClasses', the
+        // number of size classes supplied by this factory, where the size of
+        // each class after the first is half the size of the previous one; if
+        // 'numSizeClasses' is not specified, 1 is used.  Optionally specify
+        // 'magazineCapacity', the number of buffers exchanged at once between
+        // the cache of a thread and the depot; if 'magazineCapacity' is not
+        // specified, 'k_DEFAULT_MAGAZINE_CAPACITY' is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 < bufferSize',
+        // '0 < numSizeClasses', '0 < bufferSize >> (numSizeClasses - 1)', and
+        // '0 < magazineCapacity'.  Note that, if no thread-specific storage
+        // key is available, the factory does not cache buffers per thread
+        // (see {Thread-Specific Storage Keys}).
+
+    virtual ~CachingBlobBufferFactory();
+        // Destroy this factory.  The behavior is undefined unless all the
+        // buffers allocated from this factory have been released.
+
+    // MANIPULATORS
+    virtual void allocate(BlobBuffer *buffer);
+        // Allocate a new buffer with the buffer size specified at construction
+        // and load it into the specified 'buffer'.
+
+    void allocate(BlobBuffer *buffer, int minSize);
+        // Allocate a new buffer of the smallest size class of this factory
+        // whose size is at least the specified 'minSize' and load it into the
+        // specified 'buffer'.  The behavior is undefined unless
+        // '0 <= minSize <= bufferSize()'.
+
+    void flushThreadCache();
+        // Return the free buffers cached by the calling thread to the depot,
+        // making them available to other threads.
+
+    // ACCESSORS
+    int bufferSize() const;
+        // Return the buffer size specified at construction of this factory.
+
+    bool isCaching() const;
+        // Return 'true' if this factory caches free buffers per thread, and
+        // 'false' if it allocates and releases buffers directly from the
+        // depots because no thread-specific storage key was available at
+        // construction.
+
+    int magazineCapacity() const;
+        // Return the number of buffers exchanged at once between the cache of
+        // a thread and the depot.
+
+    int numSizeClasses() const;
+        // Return the number of size classes supplied by this factory.
+
+    int sizeClassSize(int index) const;
+        // Return the size of the buffers of the size class at the specified
+        // 'index'.  The behavior is undefined unless
+        // '0 <= index < numSizeClasses()'.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                       // ------------------------------
+                       // class CachingBlobBufferFactory
+                       // ------------------------------
+
+// MANIPULATORS
+inline
+void CachingBlobBufferFactory::allocate(BlobBuffer *buffer)
+{
+    allocateFromSizeClass(buffer, 0);
+}
+
+// ACCESSORS
+inline
+int CachingBlobBufferFactory::bufferSize() const
+{
+    return d_bufferSize;
+}
+
+inline
+bool CachingBlobBufferFactory::isCaching() const
+{
+    return d_hasKey;
+}
+
+inline
+int CachingBlobBufferFactory::magazineCapacity() const
+{
+    return d_magazineCapacity;
+}
+
+inline
+int CachingBlobBufferFactory::numSizeClasses() const
+{
+    return static_cast<int>(d_sizeClasses.size());
+}
+
+inline
+int CachingBlobBufferFactory::sizeClassSize(int index) const
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numSizeClasses());
+
+    return d_bufferSize >> index;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,912 @@
+// btlb_cachingblobbufferfactory.t.cpp                                -*-C++-*-
+#include <btlb_cachingblobbufferfactory.h>
+
+#include <btlb_pooledblobbufferfactory.h>
+
+#include <bdlf_bind.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_set.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a mechanism implementing the
+// 'btlb::BlobBufferFactory' protocol.  We first verify that the buffers it
+// supplies have the expected sizes and are distinct and usable, then that
+// buffers are recycled through the caches of the threads and the depot, and
+// that the memory held by the factory is bounded and returned on destruction.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 1] CachingBlobBufferFactory(int, Allocator *);
+// [ 2] CachingBlobBufferFactory(int, int, Allocator *);
+// [ 3] CachingBlobBufferFactory(int, int, int, Allocator *);
+// [ 1] ~CachingBlobBufferFactory();
+//
+// MANIPULATORS
+// [ 1] void allocate(BlobBuffer *);
+// [ 2] void allocate(BlobBuffer *, int);
+// [ 3] void flushThreadCache();
+//
+// ACCESSORS
+// [ 1] int bufferSize() const;
+// [ 5] bool isCaching() const;
+// [ 3] int magazineCapacity() const;
+// [ 2] int numSizeClasses() const;
+// [ 2] int sizeClassSize(int) const;
+//-----------------------------------------------------------------------------
+// [ 4] CONCURRENCY
+// [ 5] CONCERN: MORE FACTORIES THAN THREAD-SPECIFIC STORAGE KEYS
+// [ 6] USAGE EXAMPLE
+// [-1] BUFFER CHURN BENCHMARK
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef btlb::CachingBlobBufferFactory Obj;
+
+static int verbose;
+static int veryVerbose;
+static int veryVeryVerbose;
+
+// ============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+void checkBlob(int         LINE,
+               int         bufferSize,
+               int         length,
+               int         maxLength,
+               btlb::Blob& mX)
+{
+    const int NUM_BUFFERS = (0 < maxLength) ? 1+(maxLength-1)/bufferSize : 0;
+    const btlb::Blob& X = mX;
+
+    LOOP2_ASSERT(bufferSize, LINE, bufferSize*NUM_BUFFERS == X.totalSize());
+    LOOP2_ASSERT(bufferSize, LINE, length == X.length());
+    LOOP2_ASSERT(bufferSize, LINE, NUM_BUFFERS == X.numBuffers());
+    for (int i = 0; i < X.numBuffers(); ++i) {
+        LOOP3_ASSERT(bufferSize, LINE, i, bufferSize == X.buffer(i).size());
+        bsl::memset(mX.buffer(i).data(), (char)i, X.buffer(i).size());
+    }
+    for (int i = 0; i < X.numBuffers(); ++i) {
+        LOOP3_ASSERT(bufferSize, LINE, i, X.buffer(i).data()[0] == (char)i);
+        LOOP3_ASSERT(bufferSize,
+                     LINE,
+                     i,
+                     X.buffer(i).data()[bufferSize - 1] == (char)i);
+    }
+}
+
+                        // ===============================
+                        // namespace TEST_CASE_CONCURRENCY
+                        // ===============================
+
+namespace TEST_CASE_CONCURRENCY {
+
+void allocateAndRelease(btlb::BlobBufferFactory *factory,
+                        bslmt::Barrier          *barrier,
+                        int                      id,
+                        int                      numIterations,
+                        int                      numBuffers)
+    // Wait on the specified 'barrier', then repeat the specified
+    // 'numIterations' times: allocate the specified 'numBuffers' buffers from
+    // the specified 'factory', fill each with a pattern that is a function of
+    // the specified 'id', verify the patterns, and release the buffers.
+{
+    bsl::vector<btlb::BlobBuffer> buffers(numBuffers);
+
+    barrier->wait();
+
+    for (int i = 0; i < numIterations; ++i) {
+        for (int j = 0; j < numBuffers; ++j) {
+            factory->allocate(&buffers[j]);
+            bsl::memset(buffers[j].data(), id + j, buffers[j].size());
+        }
+        for (int j = 0; j < numBuffers; ++j) {
+            const char *data = buffers[j].data();
+            for (int k = 0; k < buffers[j].size(); ++k) {
+                LOOP3_ASSERT(id, j, k, (char)(id + j) == data[k]);
+            }
+        }
+        for (int j = 0; j < numBuffers; ++j) {
+            buffers[j].reset();
+        }
+    }
+}
+
+void releaseBuffers(bsl::vector<btlb::BlobBuffer> *buffers)
+    // Release the specified 'buffers'.
+{
+    buffers->clear();
+}
+
+}  // close namespace TEST_CASE_CONCURRENCY
+
+                      // ===================================
+                      // namespace TEST_CASE_CHURN_BENCHMARK
+                      // ===================================
+
+namespace TEST_CASE_CHURN_BENCHMARK {
+
+void churn(btlb::BlobBufferFactory *factory,
+           bslmt::Barrier          *barrier,
+           int                      numConnections,
+           int                      numIterations)
+    // Simulate the dispatcher thread of a channel pool serving the specified
+    // 'numConnections' connections: wait on the specified 'barrier', then
+    // repeat the specified 'numIterations' times: allocate a buffer from the
+    // specified 'factory' for the next connection (in round-robin order),
+    // touch it, and release the buffer previously held for that connection.
+{
+    bsl::vector<btlb::BlobBuffer> connections(numConnections);
+
+    barrier->wait();
+
+    for (int i = 0; i < numIterations; ++i) {
+        btlb::BlobBuffer& buffer = connections[i % numConnections];
+        factory->allocate(&buffer);
+        buffer.data()[0] = static_cast<char>(i);
+    }
+}
+
+double measure(btlb::BlobBufferFactory *factory,
+               int                      numThreads,
+               int                      numConnections,
+               int                      numIterations)
+    // Run 'churn' in the specified 'numThreads' threads with the specified
+    // 'factory', 'numConnections' connections per thread and 'numIterations'
+    // iterations per thread, and return the elapsed wall time in seconds.
+{
+    bslmt::Barrier                          barrier(numThreads + 1);
+    bsl::vector<bslmt::ThreadUtil::Handle>  handles(numThreads);
+
+    for (int i = 0; i < numThreads; ++i) {
+        int rc = bslmt::ThreadUtil::create(&handles[i],
+                                           bdlf::BindUtil::bind(
+                                                           &churn,
+                                                           factory,
+                                                           &barrier,
+                                                           numConnections,
+                                                           numIterations));
+        BSLS_ASSERT_OPT(0 == rc);
+    }
+
+    bsls::Stopwatch timer;
+    timer.start(true);
+
+    barrier.wait();
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+
+    timer.stop();
+    return timer.elapsedTime();
+}
+
+}  // close namespace TEST_CASE_CHURN_BENCHMARK
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    verbose = argc > 2;
+    veryVerbose = argc > 3;
+    veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating Buffers of Different Sizes
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// First, we create a factory supplying buffers of 8192, 4096 and 2048 bytes,
+// which we use to supply the buffers of a blob:
+//..
+    btlb::CachingBlobBufferFactory factory(8192, 3);
+    ASSERT(8192 == factory.bufferSize());
+    ASSERT(2048 == factory.sizeClassSize(2));
+
+    btlb::Blob blob(&factory);
+    blob.setLength(10000);
+    ASSERT(2     == blob.numBuffers());
+    ASSERT(16384 == blob.totalSize());
+//..
+// Then, we append the remainder of a message, which we know to be small, in
+// a buffer of the smallest size class that can hold it:
+//..
+    btlb::BlobBuffer buffer;
+    factory.allocate(&buffer, 1500);
+    ASSERT(2048 == buffer.size());
+
+    blob.appendDataBuffer(buffer);
+//..
+// Finally, a thread that is about to stop allocating buffers for a long time
+// can make the buffers in its cache available to the other threads:
+//..
+    factory.flushThreadCache();
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCERN: MORE FACTORIES THAN THREAD-SPECIFIC STORAGE KEYS
+        //
+        // Concerns:
+        //: 1 More factories than the platform has thread-specific storage
+        //:   keys can be alive at the same time.
+        //:
+        //: 2 A factory created when no key is available supplies distinct,
+        //:   usable buffers of the expected sizes, from any number of
+        //:   threads, and recycles the released buffers.
+        //:
+        //: 3 The keys are returned when the factories are destroyed.
+        //
+        // Plan:
+        //: 1 Create 2000 factories (more than the 1024 keys of usual POSIX
+        //:   platforms), and allocate, fill, verify, and release buffers of
+        //:   each size class with each of them.  (C-1)
+        //:
+        //: 2 Verify that a factory that does not cache buffers per thread
+        //:   supplies the last released buffer on the next allocation of its
+        //:   size class, and run several threads allocating and releasing
+        //:   buffers concurrently with it.  (C-2)
+        //:
+        //: 3 Destroy the factories, and verify that a new factory caches
+        //:   buffers per thread.  (C-3)
+        //
+        // Testing:
+        //   bool isCaching() const;
+        //   CONCERN: MORE FACTORIES THAN THREAD-SPECIFIC STORAGE KEYS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+          << "CONCERN: MORE FACTORIES THAN THREAD-SPECIFIC STORAGE KEYS"
+          << endl
+          << "========================================================="
+          << endl;
+
+        using namespace TEST_CASE_CONCURRENCY;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+
+        {
+            const int k_NUM_FACTORIES = 2000;
+
+            bsl::vector<Obj *> factories;
+            int                numCaching = 0;
+
+            for (int i = 0; i < k_NUM_FACTORIES; ++i) {
+                Obj *factory = new (ta) Obj(64, 2, 2, &ta);
+                factories.push_back(factory);
+                numCaching += factory->isCaching();
+
+                btlb::BlobBuffer buffers[3];
+                for (int j = 0; j < 3; ++j) {
+                    factory->allocate(&buffers[j], 16 + 24 * j);
+                    bsl::memset(buffers[j].data(), j, buffers[j].size());
+                }
+                LOOP_ASSERT(i, 32 == buffers[0].size());
+                LOOP_ASSERT(i, 64 == buffers[1].size());
+                LOOP_ASSERT(i, 64 == buffers[2].size());
+                LOOP_ASSERT(i, buffers[1].data() != buffers[2].data());
+                for (int j = 0; j < 3; ++j) {
+                    for (int k = 0; k < buffers[j].size(); ++k) {
+                        LOOP3_ASSERT(i, j, k, j == buffers[j].data()[k]);
+                    }
+                    buffers[j].reset();
+                }
+
+                if (!factory->isCaching()) {
+                    btlb::BlobBuffer buffer;
+                    factory->allocate(&buffer);
+                    const char *data = buffer.data();
+                    buffer.reset();
+                    factory->allocate(&buffer);
+                    LOOP_ASSERT(i, data == buffer.data());
+                }
+            }
+            if (verbose) {
+                P(numCaching);
+            }
+
+            // Use the last factory, which does not cache buffers per thread
+            // on usual POSIX platforms, from several threads.
+
+            const int k_NUM_THREADS = 4;
+
+            bslmt::Barrier barrier(k_NUM_THREADS);
+            bsl::vector<bslmt::ThreadUtil::Handle> handles(k_NUM_THREADS);
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::create(
+                                        &handles[i],
+                                        bdlf::BindUtil::bind(
+                                                         &allocateAndRelease,
+                                                         factories.back(),
+                                                         &barrier,
+                                                         i * 16,
+                                                         200,
+                                                         i + 1)));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+
+            for (int i = 0; i < k_NUM_FACTORIES; ++i) {
+                ta.deleteObject(factories[i]);
+            }
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        {
+            Obj mX(64, &ta);  const Obj& X = mX;
+            ASSERT(X.isCaching());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Several threads can allocate and release buffers concurrently,
+        //:   and never obtain a buffer in use by another thread.
+        //:
+        //: 2 Buffers allocated by a thread and released by another one are
+        //:   made available to the allocating thread through the depot.
+        //:
+        //: 3 The cache of a thread is returned when the thread exits.
+        //
+        // Plan:
+        //: 1 Run several threads allocating buffers, filling them with a
+        //:   pattern specific to the thread, verifying the patterns, and
+        //:   releasing the buffers.  (C-1)
+        //:
+        //: 2 Allocate buffers in the main thread, release them in another
+        //:   thread, and allocate them again in the main thread: verify that
+        //:   no memory is allocated for the second round.  (C-2)
+        //:
+        //: 3 Verify that all memory allocated for the thread caches is
+        //:   released when the threads exit, by comparing the number of blocks
+        //:   in use with that of an idle factory.  (C-3)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        using namespace TEST_CASE_CONCURRENCY;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+
+        if (verbose) cout << "\nConcurrent allocation and release." << endl;
+        {
+            const int k_NUM_THREADS = 8;
+
+            Obj mX(96, 1, 4, &ta);
+
+            bslma::TestAllocator ua("unused", veryVeryVerbose);
+            Obj mY(96, 1, 4, &ua);
+            const bsls::Types::Int64 IDLE_BLOCKS = ua.numBlocksInUse();
+
+            bslmt::Barrier barrier(k_NUM_THREADS);
+            bsl::vector<bslmt::ThreadUtil::Handle> handles(k_NUM_THREADS);
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::create(
+                                        &handles[i],
+                                        bdlf::BindUtil::bind(
+                                                         &allocateAndRelease,
+                                                         &mX,
+                                                         &barrier,
+                                                         i * 16,
+                                                         200,
+                                                         i + 1)));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+
+            // Only the slabs remain allocated, in addition to the memory of
+            // an idle factory.
+
+            const bsls::Types::Int64 NUM_SLABS =
+                                          ta.numBlocksInUse() - IDLE_BLOCKS;
+            if (veryVerbose) { P(NUM_SLABS) }
+
+            // A thread holding 'n' buffers caches at most '2 * 4' free buffers
+            // in addition.
+
+            ASSERT(0 < NUM_SLABS);
+            ASSERT(NUM_SLABS <= (8 * 9 / 2 + k_NUM_THREADS * 8) / 4 + 1);
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\nRelease by another thread." << endl;
+        {
+            const int k_NUM_BUFFERS = 100;
+
+            Obj mX(64, 1, 10, &ta);
+
+            bsl::vector<btlb::BlobBuffer> buffers(k_NUM_BUFFERS);
+            bsl::set<const char *>        addresses;
+            for (int i = 0; i < k_NUM_BUFFERS; ++i) {
+                mX.allocate(&buffers[i]);
+                addresses.insert(buffers[i].data());
+            }
+            ASSERT(k_NUM_BUFFERS == static_cast<int>(addresses.size()));
+
+            const bsls::Types::Int64 NUM_ALLOCATIONS = ta.numAllocations();
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(
+                                   &handle,
+                                   bdlf::BindUtil::bind(&releaseBuffers,
+                                                        &buffers)));
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+            // All buffers are in the depot, now that the releasing thread has
+            // exited (having allocated, then released, its cache).
+
+            const bsls::Types::Int64 NUM_ALLOCATIONS2 = ta.numAllocations();
+            ASSERT(NUM_ALLOCATIONS + 1 == NUM_ALLOCATIONS2);
+
+            buffers.resize(k_NUM_BUFFERS);
+            for (int i = 0; i < k_NUM_BUFFERS; ++i) {
+                mX.allocate(&buffers[i]);
+                LOOP_ASSERT(i, 1 == addresses.count(buffers[i].data()));
+            }
+            ASSERT(NUM_ALLOCATIONS2 == ta.numAllocations());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // MAGAZINES AND 'flushThreadCache'
+        //
+        // Concerns:
+        //: 1 'magazineCapacity' returns the value specified at construction,
+        //:   or 'k_DEFAULT_MAGAZINE_CAPACITY'.
+        //:
+        //: 2 Memory is obtained from the allocator one magazine at a time.
+        //:
+        //: 3 Released buffers are reused, most recently released first.
+        //:
+        //: 4 'flushThreadCache' returns the cached buffers to the depot, from
+        //:   which they are reused, and has no effect if the calling thread
+        //:   has no cache.
+        //
+        // Plan:
+        //: 1 Create factories with and without a magazine capacity and verify
+        //:   'magazineCapacity'.  (C-1)
+        //:
+        //: 2 Allocate buffers and verify the number of allocations from the
+        //:   test allocator.  (C-2)
+        //:
+        //: 3 Release a buffer and allocate a new one: verify that the same
+        //:   memory is returned.  (C-3)
+        //:
+        //: 4 Flush the cache after releasing all buffers, then verify that
+        //:   allocating the same number of buffers does not allocate memory.
+        //:   (C-4)
+        //
+        // Testing:
+        //   CachingBlobBufferFactory(int, int, int, Allocator *);
+        //   void flushThreadCache();
+        //   int magazineCapacity() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MAGAZINES AND 'flushThreadCache'" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard dag(&da);
+        bslma::TestAllocator         ta("test", veryVeryVerbose);
+        bslma::TestAllocator         va("vector", veryVeryVerbose);
+
+        {
+            Obj mX(100, &ta);  const Obj& X = mX;
+            ASSERT(Obj::k_DEFAULT_MAGAZINE_CAPACITY == X.magazineCapacity());
+
+            mX.flushThreadCache();
+        }
+
+        const int CAPACITIES[] = { 1, 2, 3, 7, 16 };
+        const int NUM_CAPACITIES = sizeof CAPACITIES / sizeof *CAPACITIES;
+
+        for (int ti = 0; ti < NUM_CAPACITIES; ++ti) {
+            const int CAPACITY = CAPACITIES[ti];
+
+            Obj mX(100, 2, CAPACITY, &ta);  const Obj& X = mX;
+            ASSERT(CAPACITY == X.magazineCapacity());
+
+            const bsls::Types::Int64 BASE = ta.numAllocations();
+
+            // The first allocation allocates the thread cache and a slab.
+
+            bsl::vector<btlb::BlobBuffer> buffers(3 * CAPACITY, &va);
+            mX.allocate(&buffers[0]);
+            LOOP_ASSERT(CAPACITY, BASE + 2 == ta.numAllocations());
+
+            for (int i = 1; i < 3 * CAPACITY; ++i) {
+                mX.allocate(&buffers[i]);
+                LOOP2_ASSERT(CAPACITY, i,
+                             BASE + 2 + i / CAPACITY == ta.numAllocations());
+            }
+
+            const char *last = buffers.back().data();
+            buffers.back().reset();
+
+            btlb::BlobBuffer buffer;
+            mX.allocate(&buffer);
+            LOOP_ASSERT(CAPACITY, last == buffer.data());
+            buffers.back() = buffer;
+            buffer.reset();
+
+            const bsls::Types::Int64 NUM_ALLOCATIONS = ta.numAllocations();
+
+            buffers.clear();
+            mX.flushThreadCache();
+            mX.flushThreadCache();
+
+            buffers.resize(3 * CAPACITY);
+            for (int i = 0; i < 3 * CAPACITY; ++i) {
+                mX.allocate(&buffers[i]);
+            }
+            LOOP_ASSERT(CAPACITY, NUM_ALLOCATIONS == ta.numAllocations());
+
+            // Buffers of the other size class are allocated from another
+            // slab.
+
+            mX.allocate(&buffer, 50);
+            LOOP_ASSERT(CAPACITY, 50 == buffer.size());
+            LOOP_ASSERT(CAPACITY, NUM_ALLOCATIONS + 1 == ta.numAllocations());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // SIZE CLASSES
+        //
+        // Concerns:
+        //: 1 'numSizeClasses' returns the value specified at construction, or
+        //:   1.
+        //:
+        //: 2 The size of each size class is half that of the previous one.
+        //:
+        //: 3 'allocate(BlobBuffer *, int)' supplies a buffer of the smallest
+        //:   size class holding at least the requested number of bytes, and
+        //:   'allocate(BlobBuffer *)' a buffer of the first size class.
+        //
+        // Plan:
+        //: 1 Using a table-driven approach, create factories with various
+        //:   buffer sizes and numbers of size classes, and verify the
+        //:   accessors and the size of the buffers allocated for every minimum
+        //:   size from 0 to the buffer size.  (C-1..3)
+        //
+        // Testing:
+        //   CachingBlobBufferFactory(int, int, Allocator *);
+        //   void allocate(BlobBuffer *, int);
+        //   int numSizeClasses() const;
+        //   int sizeClassSize(int) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "SIZE CLASSES" << endl
+                          << "============" << endl;
+
+        bslma::TestAllocator ta("test", veryVeryVerbose);
+
+        static const struct {
+            int d_line;
+            int d_bufferSize;
+            int d_numSizeClasses;
+        } DATA[] = {
+            //LINE  SIZE  NUM
+            //----  ----  ---
+            { L_,      1,   1 },
+            { L_,      2,   2 },
+            { L_,      7,   3 },
+            { L_,    100,   1 },
+            { L_,    100,   4 },
+            { L_,    256,   9 },
+            { L_,   1000,   5 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE = DATA[ti].d_line;
+            const int SIZE = DATA[ti].d_bufferSize;
+            const int NUM  = DATA[ti].d_numSizeClasses;
+
+            if (veryVerbose) { P_(LINE) P_(SIZE) P(NUM) }
+
+            Obj mX(SIZE, NUM, &ta);  const Obj& X = mX;
+            LOOP_ASSERT(LINE, SIZE == X.bufferSize());
+            LOOP_ASSERT(LINE, NUM  == X.numSizeClasses());
+            for (int i = 0; i < NUM; ++i) {
+                LOOP2_ASSERT(LINE, i, (SIZE >> i) == X.sizeClassSize(i));
+            }
+
+            btlb::BlobBuffer buffer;
+            mX.allocate(&buffer);
+            LOOP_ASSERT(LINE, SIZE == buffer.size());
+
+            for (int minSize = 0; minSize <= SIZE; ++minSize) {
+                int expected = SIZE;
+                for (int i = 0; i < NUM; ++i) {
+                    if (minSize <= X.sizeClassSize(i)) {
+                        expected = X.sizeClassSize(i);
+                    }
+                }
+
+                mX.allocate(&buffer, minSize);
+                LOOP2_ASSERT(LINE, minSize, expected == buffer.size());
+                bsl::memset(buffer.data(), 0xab, buffer.size());
+            }
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        if (verbose) cout << "\nDefault number of size classes." << endl;
+        {
+            Obj mX(100, &ta);  const Obj& X = mX;
+            ASSERT(1 == X.numSizeClasses());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 For a range of buffer sizes, use the factory to supply the
+        //:   buffers of a blob, and verify the size and content of the
+        //:   buffers as the blob is manipulated.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   CachingBlobBufferFactory(int, Allocator *);
+        //   ~CachingBlobBufferFactory();
+        //   void allocate(BlobBuffer *);
+        //   int bufferSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        for (int bufferSize = 1;
+             bufferSize < static_cast<int>(32 * sizeof(void *));
+             ++bufferSize) {
+            bslma::TestAllocator         ta(veryVeryVerbose);
+            bslma::DefaultAllocatorGuard dag(&ta);
+
+            {
+                int maxLength = 0;
+                Obj factory(bufferSize, &ta);
+                ASSERT(bufferSize == factory.bufferSize());
+
+                btlb::Blob mX(&factory, &ta);  const btlb::Blob& X = mX;
+                ASSERT(0 == X.length());
+                ASSERT(0 == X.totalSize());
+                ASSERT(0 == X.numBuffers());
+
+                mX.setLength(maxLength = 1);
+                checkBlob(L_, bufferSize, 1, maxLength, mX);
+
+                mX.setLength(maxLength = 34);
+                checkBlob(L_, bufferSize, 34, maxLength, mX);
+
+                mX.setLength(maxLength = 512 * bufferSize);
+                checkBlob(L_, bufferSize, maxLength, maxLength, mX);
+
+                mX.removeBuffer(5);
+                maxLength -= bufferSize;
+                checkBlob(L_, bufferSize, maxLength, maxLength, mX);
+
+                mX.setLength(1);
+                checkBlob(L_, bufferSize, 1, maxLength, mX);
+
+                btlb::BlobBuffer buf;
+                factory.allocate(&buf);
+                mX.insertBuffer(0, buf);
+                maxLength += bufferSize;
+                checkBlob(L_, bufferSize, bufferSize + 1, maxLength, mX);
+
+                mX.removeAll();
+
+                mX.setLength(maxLength = 64 * bufferSize);
+                checkBlob(L_, bufferSize, maxLength, maxLength, mX);
+            }
+            ASSERT(0 <  ta.numAllocations());
+            ASSERT(0 == ta.numBytesInUse());
+        }
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // BUFFER CHURN BENCHMARK
+        //
+        // Concerns:
+        //: 1 Allocating and releasing buffers concurrently in many threads,
+        //:   each serving many connections, scales better with a
+        //:   'btlb::CachingBlobBufferFactory' than with a
+        //:   'btlb::PooledBlobBufferFactory'.
+        //
+        // Plan:
+        //: 1 For an increasing number of threads, each holding one buffer per
+        //:   connection and replacing the buffer of each connection in turn,
+        //:   measure the time taken with either factory.  (C-1)
+        //
+        // Testing:
+        //   BUFFER CHURN BENCHMARK
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "BUFFER CHURN BENCHMARK" << endl
+             << "======================" << endl;
+
+        using namespace TEST_CASE_CHURN_BENCHMARK;
+
+        const int k_BUFFER_SIZE     = 4096;
+        const int k_NUM_CONNECTIONS = argc > 2 ? atoi(argv[2]) : 1000;
+        const int k_NUM_ITERATIONS  = 1000000;
+
+        cout << "connections per thread: " << k_NUM_CONNECTIONS << endl;
+
+        for (int numThreads = 1; numThreads <= 16; numThreads *= 2) {
+            double pooledTime;
+            {
+                btlb::PooledBlobBufferFactory factory(k_BUFFER_SIZE);
+                pooledTime = measure(&factory,
+                                     numThreads,
+                                     k_NUM_CONNECTIONS,
+                                     k_NUM_ITERATIONS);
+            }
+
+            double cachingTime;
+            {
+                Obj factory(k_BUFFER_SIZE);
+                cachingTime = measure(&factory,
+                                      numThreads,
+                                      k_NUM_CONNECTIONS,
+                                      k_NUM_ITERATIONS);
+            }
+
+            cout << "threads: " << numThreads
+                 << "\tpooled: "  << pooledTime  << "s"
+                 << "\tcaching: " << cachingTime << "s" << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -19,14 +19,17 @@ BSLS_IDENT("$Id$ $CSID$")
 
 #include <btls_iovecutil.h>
 #include <btlso_endpoint.h>
+#include <btlso_inetstreamsocket.h>
 #include <btlso_resolveutil.h>
 #include <btlso_socketimputil.h>
 #include <btlso_lingeroptions.h>
 #include <btlso_socketoptions.h>
 #include <btlso_socketoptutil.h>
+#include <btlso_zerocopyutil.h>
 
 #include <bdlma_concurrentpool.h>
 #include <btlb_blob.h>
+#include <btlb_cachingblobbufferfactory.h>
 #include <btlb_pooledblobbufferfactory.h>
 #include <bdlma_deleter.h>
 #include <bslmt_lockguard.h>
@@ -54,7 +57,9 @@ BSLS_IDENT("$Id$ $CSID$")
 #include <bsls_types.h>
 
 #include <bsl_algorithm.h>
+#include <bsl_climits.h>
 #include <bsl_cstdlib.h>
+#include <bsl_deque.h>
 #include <bsl_functional.h>
 #include <bsl_string.h>
 #include <bsl_utility.h>
@@ -239,6 +244,9 @@ enum {
     // Spin optimization for enableRead waiting for e_CHANNEL_UP.
 
     k_MAX_SPIN           = 1000,         // iterations
+    k_MAX_COALESCED_READS = 16,          // reads per coalesced callback
+    k_READ_SIZE_WEIGHT   = 8,            // inverse weight of the last drain
+                                         // in the average read size
 
     // Exponential backoff parameters in acceptCb (if FD limit reached).
 
@@ -280,6 +288,23 @@ int getPlatformErrorCode()
 #endif
 }
 
+inline
+bool hasSharedBuffers(const btlb::Blob&)
+    // Return 'true', since the buffers of a blob message are shared with (not
+    // copied into) the outgoing data of a channel.
+{
+    return true;
+}
+
+template <class IOVEC>
+inline
+bool hasSharedBuffers(const ChannelPool_IovecArray<IOVEC>&)
+    // Return 'false', since the data of an iovec message not written right
+    // away is copied into the outgoing data of a channel.
+{
+    return false;
+}
+
                     // ===================
                     // local class Channel
                     // ===================
@@ -295,6 +320,14 @@ class Channel {
     // method extracts the data from the socket, appends it into a 'btlb::Blob'
     // and invokes the registered data callback as needed.
     //
+    // If reads are coalesced, 'readCb' instead reads from the socket until no
+    // more data is available (delivering the data at most every
+    // 'k_MAX_COALESCED_READS' reads), and invokes the data callback once for
+    // all the data read.  The number of buffers supplied to each read then
+    // follows the moving average of the number of bytes read per invocation
+    // of 'readCb', so that a channel receiving few small messages does not
+    // hold many read buffers, while a busy channel reads large chunks.
+    //
     // Writing is done first in the calling thread, and if no more space is
     // available on the socket, is enqueued into the outgoing message, or if
     // writing of an outgoing message is already in progress, enqueues data
@@ -311,6 +344,13 @@ class Channel {
     // Synchronization between these two modes is done using the outgoing flag,
     // while synchronizing between any outgoing element (outgoing blob,
     // message, or flag) is done using the outgoing mutex.
+    //
+    // If zero-copy transmission is enabled, 'writeCb' writes large batches of
+    // outgoing buffers without copying them, and retains those buffers until
+    // their transmission is reported in the error queue of the socket, which
+    // both 'readCb' and 'writeCb' drain.  Large blobs are then never written
+    // from the calling thread, so that the retained buffers are only accessed
+    // from the manager's dispatcher thread.
 
     // PRIVATE TYPES
     typedef ChannelPool::ChannelStateChangeCallback ChannelStateChangeCallback;
@@ -326,6 +366,10 @@ class Channel {
         // the channel lives at least as long as the callbacks that reference
         // it.
 
+    typedef bsl::pair<unsigned int, btlb::BlobBuffer> ZeroCopyBuffer;
+        // Blob buffer retained until the completion of the zero-copy write
+        // having the sequence number in 'first' is reported.
+
     enum HighWatermarkAlertState {
         // A channel in a channel-pool is designed to alert users when they
         // have surpassed a configured threshold ("high-watermark level") for
@@ -398,6 +442,14 @@ class Channel {
                                                          // invoking next user
                                                          // callback
 
+    int                              d_readBufferSize;   // size of the read
+                                                         // buffers, or 0 if
+                                                         // none allocated yet
+
+    int                              d_averageReadSize;  // moving average of
+                                                         // the bytes read per
+                                                         // 'readCb'
+
     // Channel outgoing data section
 
     btls::Iovec                      d_ovecs[k_MAX_IOVEC_SIZE];
@@ -437,6 +489,11 @@ class Channel {
 
     const int                        d_minIncomingMessageSize;
 
+    const bool                       d_coalesceReads;    // 'true' if 'readCb'
+                                                         // drains the socket
+                                                         // before invoking
+                                                         // the data callback
+
     // Channel state section (continued)
 
     bsls::AtomicInt                  d_channelDownFlag;  // are we down?
@@ -451,10 +508,42 @@ class Channel {
     // Channel managers section
     ChannelPool                     *d_channelPool_p;    // (held)
 
-    TcpTimerEventManager            *d_eventManager_p;   // (held)
+    bsls::AtomicPointer<TcpTimerEventManager>
+                                     d_eventManager_p;   // (held) manager
+                                                         // whose dispatcher
+                                                         // thread invokes the
+                                                         // callbacks of this
+                                                         // channel; modified
+                                                         // only under
+                                                         // 'd_migrationMutex'
 
     void                            *d_readTimeoutTimerId;
 
+    // Channel migration section
+
+    bslmt::Mutex                     d_migrationMutex;   // serializes the
+                                                         // enqueuing of
+                                                         // functors with
+                                                         // migrations
+
+    TcpTimerEventManager            *d_migrationTarget_p;// (held) manager to
+                                                         // which this channel
+                                                         // is being migrated,
+                                                         // or 0
+
+    bsl::vector<bsl::function<void()> >
+                                     d_deferredFunctors; // functors enqueued
+                                                         // during a migration,
+                                                         // to be executed by
+                                                         // the target manager
+
+    bsls::Types::Int64               d_numBytesAtLastRebalancing;
+                                                         // bytes read and
+                                                         // written as of the
+                                                         // last rebalancing,
+                                                         // accessed only by
+                                                         // 'metricsCb'
+
     // Channel statistics section
     bsls::TimeInterval               d_creationTime;     // time this object
                                                          // was created
@@ -489,6 +578,20 @@ class Channel {
                                                          // size of the write
                                                          // queue
 
+    bsls::AtomicInt64                d_numReads;         // successful reads
+                                                         // from the socket
+
+    bsls::AtomicInt64                d_numReadCallbacks; // invocations of the
+                                                         // data callback
+
+    bsls::AtomicInt                  d_averageReadSizeSnapshot;
+                                                         // copy of
+                                                         // 'd_averageReadSize'
+                                                         // for other threads
+
+    // Note that the read statistics above are only updated by 'readCb',
+    // which executes in the (single) event manager thread.
+
     // DO NOT CHANGE THE ORDER OF THESE TWO DATA MEMBERS
 
     btlb::BlobBufferFactory         *d_readBlobFactory_p;// factory for
@@ -531,6 +634,21 @@ class Channel {
                                                          // in
                                                          // d_writeActiveData)
 
+    // Channel zero-copy section (accessed only in the dispatcher thread)
+
+    int                              d_zeroCopyThreshold;// minimum number of
+                                                         // bytes written
+                                                         // without copying, or
+                                                         // 0 if disabled
+
+    unsigned int                     d_zeroCopyNextId;   // sequence number of
+                                                         // next zero-copy
+                                                         // write
+
+    bsl::deque<ZeroCopyBuffer>       d_zeroCopyBuffers;  // buffers of pending
+                                                         // zero-copy writes,
+                                                         // in write order
+
     bdlma::ConcurrentPoolAllocator  *d_sharedPtrRepAllocator_p;
 
     bslma::Allocator                *d_allocator_p;      // for memory
@@ -555,10 +673,27 @@ class Channel {
         // invoking the user callback if required, and adjusting the internal
         // data buffer as needed.
 
+    void updateReadSize(bsls::Types::Int64 numBytes);
+        // Update the average read size of this channel with the specified
+        // 'numBytes' read by the last invocation of 'readCb' and, if reads
+        // are coalesced, adapt the number of buffers supplied to the next
+        // read operations to that average.
+
     // PRIVATE METHODS
     void cancelAll();
         // Remove all the pending timers from the event manager.
 
+    void completeMigration(ChannelHandle self);
+        // Complete the migration of this channel requested by 'migrate':
+        // deregister the socket events and read timeout of this channel from
+        // the event manager currently associated with it, associate this
+        // channel with the target event manager, and enqueue for execution in
+        // the dispatcher thread of that manager the re-registration of those
+        // events followed by the functors deferred during the migration.  Note
+        // that this function is executed in the dispatcher thread of the
+        // source event manager, after every functor enqueued there for this
+        // channel before the migration was requested.
+
     void deregisterSocketRead(ChannelHandle self);
         // Deregister this channel for receiving socket read events.  Must be
         // called only when a read event is registered for the socket
@@ -571,6 +706,14 @@ class Channel {
         // underlying this channel in the event manager associated with this
         // channel.
 
+    void execute(const bsl::function<void()>& functor);
+        // Enqueue the specified 'functor' for execution in the dispatcher
+        // thread of the event manager associated with this channel or, if
+        // this channel is being migrated, defer it for execution in the
+        // dispatcher thread of the target event manager once the migration is
+        // complete.  Note that functors enqueued by this method are executed
+        // in the order in which they were enqueued, even across a migration.
+
     void invokeChannelDown(ChannelHandle              self,
                            ChannelPool::ChannelEvents type);
         // Invoke user-installed channel state callback with the specified
@@ -641,6 +784,15 @@ class Channel {
         // return non-zero, if there is more data enqueued in the outgoing
         // blob.  Otherwise, return 0.
 
+    void releaseZeroCopyBuffers();
+        // Release the blob buffers retained for the zero-copy writes whose
+        // completion is reported in the error queue of the socket underlying
+        // this channel.  Note that a pending completion is reported as both a
+        // read and a write event, so this function must be called from both
+        // 'readCb' and 'writeCb'; it should always be executed in the
+        // dispatcher thread of the event manager associated with this
+        // channel.
+
     void registerReadTimeoutCallback(bsls::TimeInterval   timeout,
                                      const ChannelHandle& self);
         // Register 'readTimeoutCb' to be called by the manager in its
@@ -655,6 +807,25 @@ class Channel {
         // also that the specified 'self' is guaranteed to live throughout the
         // lifetime of this function call.
 
+    void retainZeroCopyBuffers(int firstBuffer, int lastBuffer);
+        // Retain the buffers of the outgoing message having an index in the
+        // specified range '[firstBuffer .. lastBuffer]' until the completion
+        // of the zero-copy write that was just performed is reported, and
+        // assign the next sequence number to that write.  Note that this
+        // function should always be executed in the dispatcher thread of the
+        // event manager associated with this channel.
+
+    void resumeAfterMigration(ChannelHandle self,
+                              bool          readFlag,
+                              bool          writeFlag);
+        // Register with the event manager associated with this channel the
+        // socket read event (and read timeout) of this channel if the
+        // specified 'readFlag' is 'true', and its socket write event if the
+        // specified 'writeFlag' is 'true', as they were registered with the
+        // event manager from which this channel was migrated.  Note that this
+        // function should always be executed in the dispatcher thread of the
+        // event manager associated with this channel.
+
     void writeCb(ChannelHandle self);
         // Write the first message(s) enqueued for this channel to the
         // underlying 'StreamSocket'.  If more data is available for writing
@@ -709,6 +880,13 @@ class Channel {
         // Destroy this channel.
 
     // MANIPULATORS
+    void abortMigration();
+        // Abandon the migration of this channel in progress, if any,
+        // discarding the functors deferred during the migration.  This method
+        // is called when the functors enqueued in the event managers of the
+        // channel pool are discarded, as they may include the completion of
+        // the migration.
+
     void disableRead(ChannelHandle self, bool enqueueStateChangeCb);
         // Disable automatic reading of data from this channel enqueuing the
         // change state callback if the specified 'enqueueStateChangeCb' is
@@ -720,6 +898,18 @@ class Channel {
         // buffers (otherwise, processing this data would have to wait until
         // more data is enqueued and the read socket event triggered).
 
+    int migrate(TcpTimerEventManager *eventManager, ChannelHandle self);
+        // Request that the callbacks of this channel subsequently be invoked
+        // in the dispatcher thread of the specified 'eventManager', moving the
+        // registration of its socket events (and its read timeout) to
+        // 'eventManager', while preserving its outgoing message queue and the
+        // order of the functors enqueued for it.  Return 0 if the migration is
+        // scheduled, a positive value if this channel is already associated
+        // with 'eventManager' or is being migrated, and a negative value if
+        // this channel is down.  Note that the migration completes
+        // asynchronously, in the dispatcher thread of the event manager
+        // currently associated with this channel.
+
     void setUserData(void *userData);
         // Set the opaque user data associated to this channel.
 
@@ -825,6 +1015,19 @@ class Channel {
         // Return a snapshot of the maximum recorded size, in bytes, of the
         // queue of data to be written to this channel.
 
+    bsls::Types::Int64 numReads() const;
+        // Return the number of read operations that returned data from the
+        // socket underlying this channel since its construction.
+
+    bsls::Types::Int64 numReadCallbacks() const;
+        // Return the number of invocations of the data callback of this
+        // channel since its construction.
+
+    int averageReadSize() const;
+        // Return a snapshot of the moving average of the number of bytes read
+        // from the socket underlying this channel each time data was
+        // available for reading.
+
     StreamSocket *socket() const;
         // Return a pointer to this channel's underlying socket.
 
@@ -932,6 +1135,24 @@ int Channel::recordedMaxWriteQueueSize() const
     return d_recordedMaxWriteQueueSize.loadRelaxed();
 }
 
+inline
+bsls::Types::Int64 Channel::numReads() const
+{
+    return d_numReads.loadRelaxed();
+}
+
+inline
+bsls::Types::Int64 Channel::numReadCallbacks() const
+{
+    return d_numReadCallbacks.loadRelaxed();
+}
+
+inline
+int Channel::averageReadSize() const
+{
+    return d_averageReadSizeSnapshot.loadRelaxed();
+}
+
 inline
 StreamSocket *Channel::socket() const
 {
@@ -1206,6 +1427,8 @@ void Channel::initDataBufferForReads()
     btlb::BlobBuffer buffer, newBuffer;
     d_readBlobFactory_p->allocate(&newBuffer);
 
+    d_readBufferSize = newBuffer.size();
+
     buffer.setSize(newBuffer.size());
     d_blobReadData.appendBuffer(buffer);
 
@@ -1262,6 +1485,7 @@ void Channel::processReadData(int numBytes)
         // shed additional unused buffers in 'blob', but they are
         // regrown inside the calling 'readCb'.
 
+        d_numReadCallbacks.addRelaxed(1);
         d_blobBasedReadCb(&minBytesBeforeNextCb,
                           &d_blobReadData,
                           d_channelId,
@@ -1271,6 +1495,40 @@ void Channel::processReadData(int numBytes)
         d_minBytesBeforeNextCb = minBytesBeforeNextCb;
     }
 }
+
+void Channel::updateReadSize(bsls::Types::Int64 numBytes)
+{
+    BSLS_ASSERT(0 < numBytes);
+
+    const int readSize = numBytes < INT_MAX ? static_cast<int>(numBytes)
+                                            : INT_MAX;
+
+    if (0 == d_averageReadSize) {
+        d_averageReadSize = readSize;
+    }
+    else {
+        d_averageReadSize += (readSize - d_averageReadSize)
+                                                         / k_READ_SIZE_WEIGHT;
+    }
+    d_averageReadSizeSnapshot.storeRelaxed(d_averageReadSize);
+
+    if (!d_coalesceReads || 0 == d_readBufferSize) {
+        return;                                                       // RETURN
+    }
+
+    // Supply enough buffers to hold the average amount of data drained, so
+    // that a typical drain reads all the data in a single read.  Note that a
+    // drain always ends with a read that would block (see 'readCb'), since a
+    // short read from a stream socket does not tell that the socket is
+    // drained.
+
+    const int numBuffers = (d_averageReadSize + d_readBufferSize - 1)
+                                                          / d_readBufferSize;
+
+    d_numUsedIVecs = numBuffers < k_MAX_IOVEC_SIZE ? numBuffers
+                                                   : k_MAX_IOVEC_SIZE;
+    allocateNextReadBuffers(0, 0);
+}
 }  // close package namespace
 
 // ============================================================================
@@ -1288,6 +1546,78 @@ namespace btlmt {
                     // -------------------
 
 // PRIVATE MANIPULATORS
+void Channel::completeMigration(ChannelHandle self)
+{
+    (void)self; BSLS_ASSERT(bslmt::ThreadUtil::isEqual(
+                                  bslmt::ThreadUtil::self(),
+                                  d_eventManager_p->dispatcherThreadHandle()));
+    BSLS_ASSERT(this == self.get());
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_migrationMutex);
+
+    if (!d_migrationTarget_p) {
+        // The migration was aborted.
+
+        return;                                                       // RETURN
+    }
+
+    // Every functor enqueued for this channel before the migration was
+    // requested has been executed, and those enqueued since then have been
+    // deferred, so that only the socket events and read timeout of this
+    // channel remain registered with the source manager.
+
+    TcpTimerEventManager *source = d_eventManager_p;
+    TcpTimerEventManager *target = d_migrationTarget_p;
+
+    const btlso::SocketHandle::Handle handle = socket()->handle();
+
+    const bool readFlag  = source->isRegistered(handle,
+                                                btlso::EventType::e_READ);
+    const bool writeFlag = source->isRegistered(handle,
+                                                btlso::EventType::e_WRITE);
+
+    if (readFlag || writeFlag) {
+        source->deregisterSocket(handle);
+    }
+
+    if (d_readTimeoutTimerId) {
+        source->deregisterTimer(d_readTimeoutTimerId);
+        d_readTimeoutTimerId = 0;
+    }
+
+    d_eventManager_p    = target;
+    d_migrationTarget_p = 0;
+
+    bsl::function<void()> resumeFunctor(bdlf::BindUtil::bind(
+                                                &Channel::resumeAfterMigration,
+                                                this,
+                                                self,
+                                                readFlag,
+                                                writeFlag));
+    target->execute(resumeFunctor);
+
+    for (bsl::size_t i = 0; i < d_deferredFunctors.size(); ++i) {
+        target->execute(d_deferredFunctors[i]);
+    }
+    d_deferredFunctors.clear();
+
+    guard.release()->unlock();
+
+    d_channelPool_p->migrationComplete(self);
+}
+
+void Channel::execute(const bsl::function<void()>& functor)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_migrationMutex);
+
+    if (d_migrationTarget_p) {
+        d_deferredFunctors.push_back(functor);
+    }
+    else {
+        d_eventManager_p->execute(functor);
+    }
+}
+
 void Channel::invokeChannelDown(ChannelHandle              self,
                                 ChannelPool::ChannelEvents type)
 {
@@ -1448,7 +1778,7 @@ void Channel::notifyChannelDown(ChannelHandle              self,
                                             this,
                                             self,
                                             ChannelPool::e_CHANNEL_DOWN_READ));
-            d_eventManager_p->execute(cb);
+            execute(cb);
         }
     }
 
@@ -1464,7 +1794,7 @@ void Channel::notifyChannelDown(ChannelHandle              self,
                                            this,
                                            self,
                                            ChannelPool::e_CHANNEL_DOWN_WRITE));
-            d_eventManager_p->execute(cb);
+            execute(cb);
         }
     }
 
@@ -1509,7 +1839,7 @@ void Channel::notifyChannelDown(ChannelHandle              self,
                                                  self,
                                                  ChannelPool::e_CHANNEL_DOWN));
 
-            d_eventManager_p->execute(cb);
+            execute(cb);
         }
     }
 }
@@ -1543,6 +1873,14 @@ void Channel::readCb(ChannelHandle self)
         return;                                                       // RETURN
     }
 
+    if (!d_zeroCopyBuffers.empty()) {
+        // This read event may only report the completion of zero-copy
+        // writes, which must be read off the socket or the event will be
+        // reported again.
+
+        releaseZeroCopyBuffers();
+    }
+
     if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!d_enableReadFlag)) {
         // This readCb was still pending while we were executing 'disableRead'
         // and didn't get properly deregistered.  We abort now to avoid
@@ -1598,6 +1936,12 @@ void Channel::readCb(ChannelHandle self)
         lastRead = bdlt::CurrentTime::now();
     }
 
+    // Note that 'numBytesDrained' and 'numPendingReads' are used only to
+    // update the read size, and to coalesce the data callbacks, respectively.
+
+    bsls::Types::Int64 numBytesDrained = 0;
+    int                numPendingReads = 0;
+
     int readRet = 0;
     while (1) {
         // Because buffered sockets (e.g. OpenSsl) may hold data internally,
@@ -1631,6 +1975,12 @@ void Channel::readCb(ChannelHandle self)
 
             BSLS_ASSERT(btlso::SocketHandle::e_ERROR_INTERRUPTED != readRet);
 
+            if (numPendingReads) {
+                // Deliver the data read before the connection was closed.
+
+                processReadData(0);
+            }
+
             notifyChannelDown(self, btlso::Flags::e_SHUTDOWN_RECEIVE);
             return;                                                   // RETURN
         }
@@ -1642,23 +1992,55 @@ void Channel::readCb(ChannelHandle self)
         // executes in the (single) event manager thread.
 
         d_numBytesRead.addRelaxed(readRet);
+        d_numReads.addRelaxed(1);
+        numBytesDrained += readRet;
 
         if (d_useReadTimeout) {
             lastRead = bdlt::CurrentTime::now();
         }
 
-        processReadData(readRet);
+        if (d_coalesceReads) {
+            // Read until the socket is drained (i.e., until a read would
+            // block, whatever the count of the previous read), delivering the
+            // data only every 'k_MAX_COALESCED_READS' reads to bound the
+            // memory held by a busy channel.
+
+            d_blobReadData.setLength(d_blobReadData.length() + readRet);
+
+            if (++numPendingReads < k_MAX_COALESCED_READS) {
+                allocateNextReadBuffers(readRet, totalBufferSize);
+                continue;
+            }
+            numPendingReads = 0;
+            processReadData(0);
+        }
+        else {
+            processReadData(readRet);
+        }
         allocateNextReadBuffers(readRet, totalBufferSize);
 
         if (!d_enableReadFlag) {
             return;                                                   // RETURN
         }
 
-        if (readRet != totalBufferSize) {
+        if (!d_coalesceReads && readRet != totalBufferSize) {
             break;
         }
     }
 
+    if (numPendingReads) {
+        processReadData(0);
+        allocateNextReadBuffers(0, 0);
+
+        if (!d_enableReadFlag) {
+            return;                                                   // RETURN
+        }
+    }
+
+    if (numBytesDrained) {
+        updateReadSize(numBytesDrained);
+    }
+
     if (d_useReadTimeout) {
         const bsls::TimeInterval timeout = lastRead + d_readTimeout;
 
@@ -1719,6 +2101,38 @@ int Channel::refillOutgoingMsg()
     return 1;
 }
 
+void Channel::releaseZeroCopyBuffers()
+{
+    unsigned int first, last;
+    bool         isCopied;
+
+    while (0 == btlso::ZeroCopyUtil::readCompletion(&first,
+                                                    &last,
+                                                    &isCopied,
+                                                    socket()->handle())) {
+        // Completions are normally reported in order, but this is not
+        // guaranteed: release the buffers of the completed writes wherever
+        // they are in 'd_zeroCopyBuffers', then pop the released buffers off
+        // its front.  Note that sequence numbers wrap around, and that those
+        // in 'd_zeroCopyBuffers' are increasing (modulo 2^32).
+
+        bsl::deque<ZeroCopyBuffer>::iterator it = d_zeroCopyBuffers.begin();
+        for (; it != d_zeroCopyBuffers.end(); ++it) {
+            if (0 < static_cast<int>(it->first - last)) {
+                break;
+            }
+            if (it->first - first <= last - first) {
+                it->second.reset();
+            }
+        }
+
+        while (!d_zeroCopyBuffers.empty()
+            && 0 == d_zeroCopyBuffers.front().second.data()) {
+            d_zeroCopyBuffers.pop_front();
+        }
+    }
+}
+
 void Channel::registerReadTimeoutCallback(bsls::TimeInterval   timeout,
                                           const ChannelHandle& self)
 {
@@ -1770,6 +2184,68 @@ void Channel::registerWriteCb(ChannelHandle self)
     // We simply wait until the socket calls us back.
 }
 
+void Channel::retainZeroCopyBuffers(int firstBuffer, int lastBuffer)
+{
+    BSLS_ASSERT(0 <= firstBuffer);
+    BSLS_ASSERT(firstBuffer <= lastBuffer);
+    BSLS_ASSERT(lastBuffer < d_writeActiveData->numDataBuffers());
+
+    for (int i = firstBuffer; i <= lastBuffer; ++i) {
+        d_zeroCopyBuffers.push_back(
+                     ZeroCopyBuffer(d_zeroCopyNextId,
+                                    d_writeActiveData->buffer(i)));
+    }
+    ++d_zeroCopyNextId;
+}
+
+void Channel::resumeAfterMigration(ChannelHandle self,
+                                   bool          readFlag,
+                                   bool          writeFlag)
+{
+    if (0 != protectAndCheckCallback(self)) {
+        return;                                                       // RETURN
+    }
+
+    const btlso::SocketHandle::Handle handle = socket()->handle();
+
+    if (readFlag
+     && d_enableReadFlag
+     && !isChannelDown(e_CLOSED_RECEIVE_MASK)
+     && !d_eventManager_p->isRegistered(handle, btlso::EventType::e_READ)) {
+        bsl::function<void()> readFunctor(bdlf::BindUtil::bind(
+                                                             &Channel::readCb,
+                                                             this,
+                                                             self));
+
+        if (0 != d_eventManager_p->registerSocketEvent(
+                                                      handle,
+                                                      btlso::EventType::e_READ,
+                                                      readFunctor)) {
+            notifyChannelDown(self, btlso::Flags::e_SHUTDOWN_RECEIVE);
+        }
+        else if (d_useReadTimeout && !d_readTimeoutTimerId) {
+            registerReadTimeoutCallback(
+                               bdlt::CurrentTime::now() + d_readTimeout, self);
+        }
+    }
+
+    if (writeFlag
+     && !isChannelDown(e_CLOSED_SEND_MASK)
+     && !d_eventManager_p->isRegistered(handle, btlso::EventType::e_WRITE)) {
+        bsl::function<void()> writeFunctor(bdlf::BindUtil::bind(
+                                                            &Channel::writeCb,
+                                                            this,
+                                                            self));
+
+        if (0 != d_eventManager_p->registerSocketEvent(
+                                                     handle,
+                                                     btlso::EventType::e_WRITE,
+                                                     writeFunctor)) {
+            notifyChannelDown(self, btlso::Flags::e_SHUTDOWN_SEND);
+        }
+    }
+}
+
 void Channel::writeCb(ChannelHandle self)
 {
     // This callback is executed whenever the write buffer of 'd_socket_p' has
@@ -1779,6 +2255,10 @@ void Channel::writeCb(ChannelHandle self)
         return;                                                       // RETURN
     }
 
+    if (!d_zeroCopyBuffers.empty()) {
+        releaseZeroCopyBuffers();
+    }
+
     // This method is always executed in the dispatcher thread of the event
     // manager, and thus there is no race with 'writeMessage', as long as the
     // outgoing flag is set (since 'writeMessage' will append to the outgoing
@@ -1819,6 +2299,7 @@ void Channel::writeCb(ChannelHandle self)
         int numVecs = 1;
         int numMaxVecs = bsl::min(numBuffers - currentBuffer,
                                   static_cast<int>(k_MAX_IOVEC_SIZE));
+        int numBytes = bufSize - currentOffset;
 
         d_ovecs[0].setBuffer(
                d_writeActiveData->buffer(currentBuffer).data() + currentOffset,
@@ -1835,9 +2316,26 @@ void Channel::writeCb(ChannelHandle self)
                                   i < numBuffers - 1
                                   ? blobBuffer.size()
                                   : d_writeActiveData->lastDataBufferLength());
+            numBytes += d_ovecs[numVecs].length();
         }
 
-        int writeRet = socket()->writev(d_ovecs, numVecs);
+        // Large writes are performed without copying the data, if enabled,
+        // in which case the buffers written must be retained until the
+        // kernel reports their transmission (see 'retainZeroCopyBuffers').
+
+        bool isZeroCopyPending = false;
+        int  writeRet;
+
+        if (d_zeroCopyThreshold && d_zeroCopyThreshold <= numBytes) {
+            writeRet = btlso::ZeroCopyUtil::writev(
+                                 &isZeroCopyPending,
+                                 socket()->handle(),
+                                 reinterpret_cast<const btls::Ovec *>(d_ovecs),
+                                 numVecs);
+        }
+        else {
+            writeRet = socket()->writev(d_ovecs, numVecs);
+        }
 
         if (btlso::SocketHandle::e_ERROR_WOULDBLOCK == writeRet) {
             // In theory, this is the only writing thread so if 'writeCb' we
@@ -1912,7 +2410,7 @@ void Channel::writeCb(ChannelHandle self)
                                         &Channel::invokeWriteQueueLowWatermark,
                                         this,
                                         self));
-                    d_eventManager_p->execute(functor);
+                    execute(functor);
                 }
                 else {
                     prevHighWatermarkState =
@@ -1948,6 +2446,8 @@ void Channel::writeCb(ChannelHandle self)
         // bytes written in the iovec write buffers, and should be 0, except if
         // the last buffer is not completely written.
 
+        const int firstBuffer = currentBuffer;
+
         while (0 < writeRet && bufSize <= writeRet + currentOffset) {
             writeRet -= bufSize - currentOffset;
             ++currentBuffer;
@@ -1959,6 +2459,12 @@ void Channel::writeCb(ChannelHandle self)
         currentOffset += writeRet;
         BSLS_ASSERT(currentBuffer <= numBuffers);
 
+        if (isZeroCopyPending) {
+            retainZeroCopyBuffers(firstBuffer,
+                                  currentOffset ? currentBuffer
+                                                : currentBuffer - 1);
+        }
+
         // Update the outgoing message with the new current buffer and offset
         // information.
 
@@ -2043,6 +2549,8 @@ Channel::Channel(bslma::ManagedPtr<StreamSocket> *socket,
 , d_userData(static_cast<void *>(0))
 , d_numUsedIVecs(0)
 , d_minBytesBeforeNextCb(config.minIncomingMessageSize())
+, d_readBufferSize(0)
+, d_averageReadSize(0)
 , d_highWatermarkAlertState(e_HIGH_WATERMARK_ALERT_NOT_ACTIVE)
 , d_channelType(channelType)
 , d_enableReadFlag(false)
@@ -2052,17 +2560,25 @@ Channel::Channel(bslma::ManagedPtr<StreamSocket> *socket,
 , d_writeQueueLowWater(config.writeQueueLowWatermark())
 , d_writeQueueHighWater(config.writeQueueHighWatermark())
 , d_minIncomingMessageSize(config.minIncomingMessageSize())
+, d_coalesceReads(config.coalesceReads())
 , d_channelDownFlag(0)
 , d_channelUpFlag(0)
 , d_shutdownSendWhenQueueDrained(0)
 , d_channelPool_p(channelPool)
 , d_eventManager_p(eventManager)
 , d_readTimeoutTimerId(0)
+, d_migrationMutex()
+, d_migrationTarget_p(0)
+, d_deferredFunctors(basicAllocator)
+, d_numBytesAtLastRebalancing(0)
 , d_creationTime(bdlt::CurrentTime::now())
 , d_numBytesRead(0)
 , d_numBytesWritten(0)
 , d_numBytesRequestedToBeWritten(0)
 , d_recordedMaxWriteQueueSize(0)
+, d_numReads(0)
+, d_numReadCallbacks(0)
+, d_averageReadSizeSnapshot(0)
 , d_readBlobFactory_p(readBlobBufferPool)
 , d_blobReadData(d_readBlobFactory_p, basicAllocator)
 , d_writeBlobFactory_p(writeBlobBufferPool)
@@ -2070,6 +2586,9 @@ Channel::Channel(bslma::ManagedPtr<StreamSocket> *socket,
 , d_writeActiveDataCurrentOffset(0)
 , d_isWriteActive(false)
 , d_writeActiveQueueSize(0)
+, d_zeroCopyThreshold(0)
+, d_zeroCopyNextId(0)
+, d_zeroCopyBuffers(basicAllocator)
 , d_sharedPtrRepAllocator_p(sharedPtrAllocator)
 , d_allocator_p(basicAllocator)
 {
@@ -2089,6 +2608,18 @@ Channel::Channel(bslma::ManagedPtr<StreamSocket> *socket,
     (void)ret; BSLS_ASSERT( -1 != ret);
 #endif
 
+    // Zero-copy transmission bypasses the socket object, and so is enabled
+    // only for plain TCP sockets (e.g., not for sockets encrypting their data
+    // before writing it).
+
+    typedef btlso::InetStreamSocket<btlso::IPv4Address> InetStreamSocket;
+
+    if (0 < config.zeroCopyThreshold()
+     && dynamic_cast<InetStreamSocket *>(this->socket())
+     && 0 == btlso::ZeroCopyUtil::enable(this->socket()->handle())) {
+        d_zeroCopyThreshold = config.zeroCopyThreshold();
+    }
+
     d_writeEnqueuedData.createInplace(d_allocator_p,
                                       d_writeBlobFactory_p,
                                       d_allocator_p);
@@ -2116,6 +2647,14 @@ Channel::~Channel()
 }
 
 // MANIPULATORS
+void Channel::abortMigration()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_migrationMutex);
+
+    d_migrationTarget_p = 0;
+    d_deferredFunctors.clear();
+}
+
 void Channel::disableRead(ChannelHandle self, bool enqueueStateChangeCb)
 {
     BSLS_ASSERT(bslmt::ThreadUtil::isEqual(
@@ -2139,7 +2678,7 @@ void Channel::disableRead(ChannelHandle self, bool enqueueStateChangeCb)
                                              ChannelPool::e_AUTO_READ_DISABLED,
                                              d_userData));
 
-        d_eventManager_p->execute(stateCbFunctor);
+        execute(stateCbFunctor);
     }
     else {
         d_channelStateCb(d_channelId,
@@ -2189,6 +2728,34 @@ int Channel::initiateReadSequence(ChannelHandle self)
     return rCode;
 }
 
+int Channel::migrate(TcpTimerEventManager *eventManager, ChannelHandle self)
+{
+    BSLS_ASSERT(eventManager);
+    BSLS_ASSERT(this == self.get());
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_migrationMutex);
+
+    if (isChannelDown(e_CLOSED_BOTH_MASK)) {
+        return -1;                                                    // RETURN
+    }
+
+    if (d_migrationTarget_p || eventManager == d_eventManager_p) {
+        return 1;                                                     // RETURN
+    }
+
+    // Enqueue the completion of the migration in the source manager while
+    // holding the lock, so that it executes after every functor previously
+    // enqueued for this channel, and before none enqueued subsequently.
+
+    bsl::function<void()> migrateFunctor(bdlf::BindUtil::bind(
+                                                   &Channel::completeMigration,
+                                                   this,
+                                                   self));
+    d_migrationTarget_p = eventManager;
+    d_eventManager_p->execute(migrateFunctor);
+    return 0;
+}
+
 template <class MessageType>
 int Channel::writeMessage(const MessageType&   msg,
                           int                  enqueueWatermark,
@@ -2239,7 +2806,7 @@ int Channel::writeMessage(const MessageType&   msg,
                                       this,
                                       self));
 
-            d_eventManager_p->execute(functor);
+            execute(functor);
 
             // We must release the mutex AFTER 'functor' is enqueued to be
             // executed.  Otherwise, another thread can come in between and
@@ -2285,9 +2852,18 @@ int Channel::writeMessage(const MessageType&   msg,
 
         oGuard.release()->unlock();
 
-        // Let's first attempt to write the blob directly using iovec.
+        // Let's first attempt to write the blob directly using iovec.  A blob
+        // large enough to be written without copying its data is instead
+        // handed over to 'writeCb' (as if the socket would block), since the
+        // buffers of zero-copy writes are retained only in the dispatcher
+        // thread.
 
-        int writeRet = MessageUtil::write(this->socket(), d_ovecs, msg);
+        int writeRet = d_zeroCopyThreshold
+                    && d_zeroCopyThreshold <= dataLength
+                    && hasSharedBuffers(msg)
+                       ? static_cast<int>(
+                                       btlso::SocketHandle::e_ERROR_WOULDBLOCK)
+                       : MessageUtil::write(this->socket(), d_ovecs, msg);
 
         if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(0 < writeRet)) {
             // 'd_numBytesWritten' is modified only in the 'writeCb' or
@@ -2352,7 +2928,7 @@ int Channel::writeMessage(const MessageType&   msg,
                                                      this,
                                                      self));
 
-        d_eventManager_p->execute(initWriteFunctor);
+        execute(initWriteFunctor);
         return ChannelStatus::e_SUCCESS;                              // RETURN
     }
     BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
@@ -2410,7 +2986,7 @@ void Channel::setWriteQueueHighWatermarkRaw(int numBytes, ChannelHandle self)
                                      this,
                                      self));
 
-            d_eventManager_p->execute(functor);
+            execute(functor);
         }
      }
 
@@ -2453,7 +3029,7 @@ void Channel::setWriteQueueLowWatermarkRaw(int numBytes, ChannelHandle self)
                                         this,
                                         self));
 
-            d_eventManager_p->execute(functor);
+            execute(functor);
         }
         else {
             // We are guaranteed that 'd_highWatermarkAlertState' will not
@@ -2475,7 +3051,7 @@ void Channel::setWriteQueueLowWatermarkRaw(int numBytes, ChannelHandle self)
                                         this,
                                         self));
 
-                d_eventManager_p->execute(functor);
+                execute(functor);
             }
         }
     }
@@ -2587,8 +3163,11 @@ void ChannelPool::init()
 
     for (int i = 0; i < maxThread; ++i) {
         TcpTimerEventManager *manager =
-                new (*d_allocator_p) TcpTimerEventManager(d_collectTimeMetrics,
-                                                          d_allocator_p);
+                new (*d_allocator_p) TcpTimerEventManager(
+                                                   d_collectTimeMetrics,
+                                                   false,
+                                                   d_config.edgeTriggered(),
+                                                   d_allocator_p);
 
         manager->disable();
         d_managers.push_back(manager);
@@ -2603,19 +3182,37 @@ void ChannelPool::init()
     // new objects into them if they are uninitialized.
 
     if (!d_writeBlobFactory) {
-        d_writeBlobFactory.load(
-           new (*d_allocator_p) btlb::PooledBlobBufferFactory(
+        if (d_config.threadCachedBuffers()) {
+            d_writeBlobFactory.load(
+               new (*d_allocator_p) btlb::CachingBlobBufferFactory(
+                                             d_config.maxOutgoingMessageSize(),
+                                             d_allocator_p),
+               d_allocator_p);
+        }
+        else {
+            d_writeBlobFactory.load(
+               new (*d_allocator_p) btlb::PooledBlobBufferFactory(
                                              d_config.maxOutgoingMessageSize(),
                                              d_allocator_p),
-           d_allocator_p);
+               d_allocator_p);
+        }
     }
 
     if (!d_readBlobFactory) {
-        d_readBlobFactory.load(
-           new (*d_allocator_p) btlb::PooledBlobBufferFactory(
+        if (d_config.threadCachedBuffers()) {
+            d_readBlobFactory.load(
+               new (*d_allocator_p) btlb::CachingBlobBufferFactory(
+                                             d_config.maxIncomingMessageSize(),
+                                             d_allocator_p),
+               d_allocator_p);
+        }
+        else {
+            d_readBlobFactory.load(
+               new (*d_allocator_p) btlb::PooledBlobBufferFactory(
                                              d_config.maxIncomingMessageSize(),
                                              d_allocator_p),
-           d_allocator_p);
+               d_allocator_p);
+        }
     }
 }
 
@@ -3444,6 +4041,48 @@ void ChannelPool::importCb(
 
                                   // *** Clock management ***
 
+int ChannelPool::migrateChannelImp(const ChannelHandle&  channelHandle,
+                                   TcpTimerEventManager *manager)
+{
+    // Lock 'd_migratingChannelsLock' before requesting the migration, so that
+    // its completion, which may occur immediately in another thread, cannot
+    // attempt to remove the channel from 'd_migratingChannels' before it is
+    // added.
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_migratingChannelsLock);
+
+    const int rc = channelHandle->migrate(manager, channelHandle);
+    if (0 == rc) {
+        d_migratingChannels.insert(channelHandle);
+    }
+    return rc;
+}
+
+void ChannelPool::migrationComplete(const ChannelHandle& channelHandle)
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_migratingChannelsLock);
+
+    d_migratingChannels.erase(channelHandle);
+}
+
+void ChannelPool::abortMigrations()
+{
+    bsl::set<ChannelHandle> migratingChannels(d_allocator_p);
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_migratingChannelsLock);
+
+        d_migratingChannels.swap(migratingChannels);
+    }
+
+    typedef bsl::set<ChannelHandle>::const_iterator Iterator;
+
+    for (Iterator it = migratingChannels.begin();
+         it != migratingChannels.end();
+         ++it) {
+        (*it)->abortMigration();
+    }
+}
+
 void ChannelPool::timerCb(int clockId)
 {
     bslmt::LockGuard<bslmt::Mutex> tGuard(&d_timersLock);
@@ -3497,8 +4136,10 @@ void ChannelPool::metricsCb()
     BSLS_ASSERT(0 < numManagers);
     BSLS_ASSERT(0 < d_config.maxThreads());
 
+    bsl::vector<int> workloads(numManagers, 0, d_allocator_p);
     for (size_type i = 0; i < numManagers; ++i) {
-        s += d_managers[i]->timeMetrics()->percentage(e_CPU_BOUND);
+        workloads[i] = d_managers[i]->timeMetrics()->percentage(e_CPU_BOUND);
+        s += workloads[i];
         d_managers[i]->timeMetrics()->resetAll();
     }
 
@@ -3509,12 +4150,97 @@ void ChannelPool::metricsCb()
 
     d_capacity.storeRelaxed(static_cast<int>(d));
 
+    if (0 < d_loadBalancingThreshold && 1 < numManagers && d_startFlag) {
+        rebalance(workloads);
+    }
+
     d_metricsTimerId.makeValue(
         d_managers[0]->registerTimer(
                          bdlt::CurrentTime::now() + d_config.metricsInterval(),
                          d_metricsFunctor));
 }
 
+void ChannelPool::rebalance(const bsl::vector<int>& workloads)
+{
+    typedef bsl::pair<bsls::Types::Int64, ChannelHandle> Candidate;
+
+    const int numManagers = static_cast<int>(workloads.size());
+    BSLS_ASSERT(numManagers == static_cast<int>(d_managers.size()));
+
+    int busiest = 0;
+    int idlest  = 0;
+    for (int i = 1; i < numManagers; ++i) {
+        if (workloads[i] > workloads[busiest]) {
+            busiest = i;
+        }
+        if (workloads[i] < workloads[idlest]) {
+            idlest = i;
+        }
+    }
+
+    // Take a snapshot of the traffic of every channel, so that the traffic of
+    // each channel over the last interval is available to the next call, and
+    // estimate which channels contribute to the workload of the busiest
+    // manager.
+
+    bsl::vector<Candidate> candidates(d_allocator_p);
+    bsls::Types::Int64     busiestTraffic = 0;
+
+    for (bdlcc::ObjectCatalogIter<ChannelHandle> it(d_channels); it; ++it) {
+        const ChannelHandle channel = it().second;
+        if (!channel) {
+            continue;
+        }
+
+        const bsls::Types::Int64 numBytes = channel->numBytesRead()
+                                          + channel->numBytesWritten();
+        const bsls::Types::Int64 traffic  = numBytes
+                                   - channel->d_numBytesAtLastRebalancing;
+        channel->d_numBytesAtLastRebalancing = numBytes;
+
+        if (0 < traffic
+         && d_managers[busiest] == channel->eventManager()
+         && !channel->isChannelDown(e_CLOSED_BOTH_MASK)) {
+            candidates.push_back(Candidate(traffic, channel));
+            busiestTraffic += traffic;
+        }
+    }
+
+    if (workloads[busiest] - workloads[idlest] < d_loadBalancingThreshold
+     || 0 == busiestTraffic) {
+        return;                                                       // RETURN
+    }
+
+    // Attribute the workload of the busiest manager to its channels in
+    // proportion to their traffic, and select the channel whose migration to
+    // the idlest manager minimizes the higher of the two resulting workloads.
+    // Note that a channel is never migrated if doing so would make the idlest
+    // manager at least as busy as the busiest one is now (e.g., a single hot
+    // channel is never moved back and forth between managers).
+
+    double        peakWorkload = workloads[busiest];
+    ChannelHandle selected;
+
+    for (bsl::size_t i = 0; i < candidates.size(); ++i) {
+        const double estimate = static_cast<double>(workloads[busiest])
+                              * static_cast<double>(candidates[i].first)
+                              / static_cast<double>(busiestTraffic);
+
+        const double source = workloads[busiest] - estimate;
+        const double target = workloads[idlest]  + estimate;
+        const double peak   = source < target ? target : source;
+
+        if (peak < peakWorkload) {
+            peakWorkload = peak;
+            selected     = candidates[i].second;
+        }
+    }
+
+    if (selected) {
+        migrateChannelImp(selected, d_managers[idlest]);
+    }
+}
+
 // CREATORS
 ChannelPool::ChannelPool(ChannelStateChangeCallback       channelStateCb,
                          BlobBasedReadCallback            blobBasedReadCb,
@@ -3534,6 +4260,9 @@ ChannelPool::ChannelPool(ChannelStateChangeCallback       channelStateCb,
 , d_config(parameters)
 , d_startFlag(0)
 , d_collectTimeMetrics(parameters.collectTimeMetrics())
+, d_loadBalancingThreshold(0)
+, d_migratingChannelsLock()
+, d_migratingChannels(basicAllocator)
 , d_channelStateCb(channelStateCb)
 , d_poolStateCb(poolStateCb)
 , d_blobBasedReadCb(blobBasedReadCb)
@@ -3568,6 +4297,9 @@ ChannelPool::ChannelPool(btlb::BlobBufferFactory         *blobBufferFactory,
 , d_config(parameters)
 , d_startFlag(0)
 , d_collectTimeMetrics(parameters.collectTimeMetrics())
+, d_loadBalancingThreshold(0)
+, d_migratingChannelsLock()
+, d_migratingChannels(basicAllocator)
 , d_channelStateCb(channelStateCb)
 , d_poolStateCb(poolStateCb)
 , d_blobBasedReadCb(blobBasedReadCb)
@@ -3636,6 +4368,11 @@ ChannelPool::~ChannelPool()
     for (size_type i = 0; i < numEventManagers; ++i) {
         d_allocator_p->deleteObjectRaw(d_managers[i]);
     }
+
+    // Release the channels whose migration was pending in the execute queue
+    // of a deallocated event manager.
+
+    abortMigrations();
 }
 
                        // *** Server related section ***
@@ -3805,7 +4542,7 @@ int ChannelPool::disableRead(int channelId)
                                                          channelHandle,
                                                          false));
 
-        channel->eventManager()->execute(disableReadCommand);
+        channel->execute(disableReadCommand);
     }
     return 0;
 }
@@ -3827,7 +4564,7 @@ int ChannelPool::enableRead(int channelId)
                                                 channel,
                                                 channelHandle));
 
-    channel->eventManager()->execute(initiateReadCommand);
+    channel->execute(initiateReadCommand);
     return 0;
 }
 
@@ -3959,6 +4696,11 @@ int ChannelPool::stopAndRemoveAllChannels()
         d_managers[i]->clearExecuteQueue();
     }
 
+    // The execute queues may have held the completion of pending channel
+    // migrations.
+
+    abortMigrations();
+
     return 0;
 }
 
@@ -4070,6 +4812,23 @@ int ChannelPool::stop()
 
                          // *** Outgoing messages ***
 
+int ChannelPool::migrateChannel(int channelId, int threadIndex)
+{
+    enum { e_NOT_FOUND = -1, e_INVALID_THREAD_INDEX = -2 };
+
+    if (0 > threadIndex
+     || static_cast<int>(d_managers.size()) <= threadIndex) {
+        return e_INVALID_THREAD_INDEX;                                // RETURN
+    }
+
+    ChannelHandle channelHandle;
+    if (0 != findChannelHandle(&channelHandle, channelId)) {
+        return e_NOT_FOUND;                                           // RETURN
+    }
+
+    return migrateChannelImp(channelHandle, d_managers[threadIndex]);
+}
+
 void ChannelPool::setChannelContext(int channelId, void *context)
 {
     ChannelHandle channelHandle;
@@ -4452,6 +5211,14 @@ double ChannelPool::reportWeightedAverageReset()
            : -1;
 }
 
+void ChannelPool::setLoadBalancingThreshold(int percentage)
+{
+    BSLS_ASSERT(0 <= percentage);
+    BSLS_ASSERT(100 >= percentage);
+
+    d_loadBalancingThreshold.storeRelaxed(percentage);
+}
+
 void ChannelPool::totalBytesReadReset(bsls::Types::Int64 *result)
 {
     // Note that this lock must be held to ensure that updating the adjustment
@@ -4531,6 +5298,25 @@ ChannelPool::streamSocket(int channelId) const
     return bsl::shared_ptr<const btlso::StreamSocket<btlso::IPv4Address> >();
 }
 
+int ChannelPool::getChannelReadStatistics(
+                                  bsls::Types::Int64 *numReads,
+                                  bsls::Types::Int64 *numReadCallbacks,
+                                  int                *averageReadSize,
+                                  int                 channelId) const
+{
+    ChannelHandle channelHandle;
+    if (0 == findChannelHandle(&channelHandle, channelId)) {
+        Channel *channel = channelHandle.get();
+
+        *numReads         = channel->numReads();
+        *numReadCallbacks = channel->numReadCallbacks();
+        *averageReadSize  = channel->averageReadSize();
+
+        return 0;                                                     // RETURN
+    }
+    return 1;
+}
+
 int ChannelPool::getChannelStatistics(
                                    bsls::Types::Int64 *numRead,
                                    bsls::Types::Int64 *numRequestedToBeWritten,
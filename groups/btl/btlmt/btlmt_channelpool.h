@@ -51,6 +51,50 @@ BSLS_IDENT("$Id: $")
 // write side, the channel pool adopts ownership of the buffers passed to
 // 'write()'.
 //
+// The data written to a socket is, however, normally copied by the kernel
+// into the socket's send buffer.  If the 'zeroCopyThreshold' attribute of the
+// 'ChannelPoolConfiguration' is positive, each write to a socket of at least
+// that many bytes is instead performed without copying the data (on Linux,
+// using 'MSG_ZEROCOPY'; see 'btlso_zerocopyutil'), and the blob buffers
+// holding that data are retained by the channel until the kernel reports
+// their transmission.  Writes of fewer bytes, and data written from an array
+// of iovecs (whose memory is not owned by the channel pool), are copied as
+// usual.  Zero-copy transmission costs pinning the pages of the data and
+// reading the completion notifications, and therefore pays off only for large
+// writes; a threshold of at least 10KB is recommended.  It is enabled only
+// for the channels whose sockets are plain TCP sockets (e.g., not for the
+// imported sockets that encrypt their data), and only where supported; note
+// that the kernel copies the data anyway over the loopback interface.  The
+// buffers of a channel that is closed before the transmission of its data
+// completes are released when the channel is destroyed.
+//
+// By default, the data callback of a channel is invoked after each read from
+// its socket that brings the data received to at least the number of bytes
+// requested by the previous invocation.  If the 'coalesceReads' attribute of
+// the 'ChannelPoolConfiguration' is 'true', the channel pool instead reads
+// from the socket until a read would block, and invokes the data callback
+// once with all the data read (or every 16 reads, if data keeps arriving).
+// The number of read buffers supplied to each read then follows the average
+// amount of data read each time the socket is readable, so that idle
+// channels hold few buffers and busy channels read large chunks.  Note that
+// each time the socket is readable this takes at least two reads, the last
+// of which would block.  When
+// many channels each receive small messages, this trades a slightly higher
+// latency for fewer system calls and data callbacks.  The resulting
+// per-channel statistics are available from 'getChannelReadStatistics'.
+//
+// Unless a blob buffer factory is supplied at construction, the read and
+// write buffers of all channels are allocated from two
+// 'btlb::PooledBlobBufferFactory' objects shared by all the threads of the
+// channel pool.  If the 'threadCachedBuffers' attribute of the
+// 'ChannelPoolConfiguration' is 'true', 'btlb::CachingBlobBufferFactory'
+// objects are used instead, so that each thread allocating or releasing
+// buffers (e.g., the thread reading from a channel, and the thread processing
+// the data read) does so from its own cache, exchanging buffers with the
+// other threads only in batches.  This avoids contention on the shared pools
+// when many channels are served by several threads, at the cost of a number
+// of free buffers retained by each such thread.
+//
 ///Channel Identification
 ///----------------------
 // Each channel is identified by an integer ID that is (a) assigned by the
@@ -157,6 +201,34 @@ BSLS_IDENT("$Id: $")
 //            T
 //..
 //
+///Channel Migration and Load Balancing
+///------------------------------------
+// All the callbacks of a channel are invoked in the dispatcher thread of the
+// event manager to which the channel is assigned (the most idle one) when it
+// is created.  A channel can subsequently be migrated to another dispatcher
+// thread using 'migrateChannel'.  The migration completes asynchronously in
+// the channel's current thread, once the callbacks of the channel already
+// pending there have been invoked: the socket events and read timeout of the
+// channel are then moved to the new thread, and the callbacks requested in
+// the meantime are invoked there, in order.  Data enqueued for writing on the
+// channel is not affected by a migration, and the callbacks of a channel are
+// never invoked concurrently nor out of order across a migration.  Note that
+// the clocks registered for a channel (see 'registerClock') remain with the
+// thread to which the channel was assigned when the clock was registered.
+//
+// The channel pool can also migrate channels automatically, to even out the
+// workloads of its dispatcher threads: if a load balancing threshold is set
+// using 'setLoadBalancingThreshold', then each time metrics are collected
+// (see {Metrics and Capacity}), and if the workloads of the busiest and most
+// idle threads differ by at least that threshold, the channel of the busiest
+// thread whose migration to the most idle thread best evens out their
+// workloads is migrated.  The workload of a thread is attributed to its
+// channels in proportion to the number of bytes that each channel read and
+// wrote during the last interval, and a channel is not migrated if this would
+// make the most idle thread at least as busy as the busiest one (so that, for
+// example, a single busy channel does not bounce between threads).  At most
+// one channel is migrated per interval.
+//
 ///Thread Safety
 ///-------------
 // The channel pool is *thread-enabled* meaning that any operation on the same
@@ -656,6 +728,10 @@ BSLS_IDENT("$Id: $")
 #include <bsl_memory.h>
 #endif
 
+#ifndef INCLUDED_BSL_SET
+#include <bsl_set.h>
+#endif
+
 #ifndef INCLUDED_BSL_VECTOR
 #include <bsl_vector.h>
 #endif
@@ -926,6 +1002,23 @@ class ChannelPool {
                                                // whether to collect time
                                                // metrics
 
+                                        // *** Load balancing ***
+
+    bsls::AtomicInt                     d_loadBalancingThreshold;
+                                               // minimum difference, in
+                                               // percent, between the
+                                               // workloads of the busiest
+                                               // and most idle event
+                                               // managers for a channel to
+                                               // be migrated (0 if
+                                               // disabled)
+
+    bslmt::Mutex                        d_migratingChannelsLock;
+
+    bsl::set<ChannelHandle>             d_migratingChannels;
+                                               // channels whose migration
+                                               // is pending
+
                                         // *** Capacity monitoring ***
 
     bdlb::NullableValue<void *>         d_metricsTimerId;
@@ -1132,6 +1225,26 @@ class ChannelPool {
         // 'streamSocket' can be imported into this channel pool, irrespective
         // of the value of 'allowHalfOpenConnections'.
 
+    void abortMigrations();
+        // Abandon the pending migrations of channels, releasing the channels
+        // being migrated.  Note that this method must be called whenever the
+        // functors enqueued in the event managers are discarded, as these may
+        // include the completion of a migration.
+
+    int migrateChannelImp(const ChannelHandle&  channelHandle,
+                          TcpTimerEventManager *manager);
+        // Request the migration of the channel referred to by the specified
+        // 'channelHandle' to the specified 'manager', and record it as being
+        // migrated on success.  Return 0 on success, a positive value if the
+        // channel is already associated with 'manager' or is being migrated,
+        // and a negative value if the channel is down.
+
+    void migrationComplete(const ChannelHandle& channelHandle);
+        // Record that the migration of the channel referred to by the
+        // specified 'channelHandle' is complete.  Note that this method is
+        // invoked by the channel in the dispatcher thread of the event manager
+        // from which it migrated.
+
                                   // *** Clock management ***
 
     void timerCb(int timerId);
@@ -1142,7 +1255,16 @@ class ChannelPool {
 
                                   // *** Metrics ***
     void metricsCb();
-        // Update metrics for each event manager.
+        // Update metrics for each event manager, and rebalance the channels
+        // among event managers if load balancing is enabled.
+
+    void rebalance(const bsl::vector<int>& workloads);
+        // Migrate, if the specified 'workloads' of the event managers of this
+        // channel pool differ by at least the load balancing threshold, the
+        // channel of the busiest event manager whose migration to the most
+        // idle event manager best evens out their workloads, as estimated
+        // from the traffic of each channel since the previous call.  Note
+        // that at most one channel is migrated per call.
 
     // PRIVATE ACCESSORS
     int findChannelHandle(ChannelHandle *handle, int channelId) const;
@@ -1317,6 +1439,21 @@ class ChannelPool {
         // half-closed 'streamSocket' can be imported into this channel pool,
         // irrespective of the value of 'allowHalfOpenConnections'.
 
+    int migrateChannel(int channelId, int threadIndex);
+        // Request that the callbacks of the channel having the specified
+        // 'channelId' subsequently be invoked in the dispatcher thread having
+        // the specified 'threadIndex', preserving the data enqueued for
+        // writing on the channel and the order in which its callbacks are
+        // invoked.  Return 0 if the migration is scheduled, a positive value
+        // if the channel is already handled by that thread or is already
+        // being migrated, and a negative value if no channel having
+        // 'channelId' is up, or if 'threadIndex' is not in the range
+        // '[0 .. maxThreads - 1]' of the configuration supplied at
+        // construction.  Note that the migration completes asynchronously,
+        // once the callbacks of the channel that are pending in its current
+        // thread have been invoked; see {Channel Migration and Load
+        // Balancing}.
+
     void setChannelContext(int channelId, void *context);
         // Associate the specified (opaque) 'context' with the channel having
         // the specified 'channelId'.  The channel context will be reported on
@@ -1573,6 +1710,16 @@ class ChannelPool {
         // up at the time of the previous reset, this method will return the
         // same number as 'numChannels()'.  0 means that they were all down.
 
+    void setLoadBalancingThreshold(int percentage);
+        // Enable the periodic migration of channels from the busiest to the
+        // most idle dispatcher thread whenever their workloads differ by at
+        // least the specified 'percentage', or disable it if 'percentage' is
+        // 0.  The behavior is undefined unless '0 <= percentage <= 100'.  Note
+        // that load balancing is disabled by default, and has no effect
+        // unless the 'collectTimeMetrics' property of the configuration
+        // supplied at construction is 'true'; see {Channel Migration and Load
+        // Balancing}.
+
     void totalBytesReadReset(bsls::Types::Int64 *result);
         // Load, into the specified 'result', and atomically reset the total
         // number of bytes read by the pool.
@@ -1600,6 +1747,24 @@ class ChannelPool {
         // 'channelId', and '(void *)0' if no such channel exists or the user
         // context for this channel was explicitly set to '(void *)0'.
 
+    int getChannelReadStatistics(bsls::Types::Int64 *numReads,
+                                 bsls::Types::Int64 *numReadCallbacks,
+                                 int                *averageReadSize,
+                                 int                 channelId) const;
+        // Load into the specified 'numReads' and 'numReadCallbacks'
+        // respectively the number of read operations that returned data from
+        // the socket of the channel identified by the specified 'channelId'
+        // and the number of invocations of the data callback for that
+        // channel, and load into the specified 'averageReadSize' the moving
+        // average of the number of bytes read from that socket each time
+        // data was available for reading; return 0 if 'channelId' is a valid
+        // channel id.  Otherwise, return a non-zero value.  Note that
+        // 'numReads / numReadCallbacks' measures how many reads are coalesced
+        // into each data callback (see the 'coalesceReads' attribute of
+        // 'ChannelPoolConfiguration').  Also note that for performance
+        // reasons this *sequence* is not captured atomically: by the time one
+        // of the values is captured, another may already have changed.
+
     int getChannelStatistics(bsls::Types::Int64 *numRead,
                              bsls::Types::Int64 *numRequestedToBeWritten,
                              bsls::Types::Int64 *numWritten,
@@ -1689,6 +1854,11 @@ class ChannelPool {
         // externally synchronize with start and stop operations on this
         // channel pool.
 
+    int loadBalancingThreshold() const;
+        // Return the minimum difference, in percent, between the workloads of
+        // the busiest and most idle dispatcher threads for a channel to be
+        // migrated between them, or 0 if load balancing is disabled.
+
     int numBytesRead(bsls::Types::Int64 *result, int channelId) const;
         // Load, into the specified 'result', the number of bytes read by the
         // channel identified by the specified 'channelId' and return 0 if the
@@ -1982,6 +2152,12 @@ bool ChannelPool::isRunning() const
     return static_cast<bool>(d_startFlag);
 }
 
+inline
+int ChannelPool::loadBalancingThreshold() const
+{
+    return d_loadBalancingThreshold.loadRelaxed();
+}
+
 inline
 int ChannelPool::numChannels() const
 {
@@ -13,6 +13,8 @@
 #include <btlmt_asyncchannel.h>
 
 #include <btlb_blobutil.h>
+#include <btlb_cachingblobbufferfactory.h>
+#include <btlb_pooledblobbufferfactory.h>
 #include <btls_iovecutil.h>
 #include <btlso_flags.h>
 #include <btlso_inetstreamsocketfactory.h>
@@ -21,6 +23,7 @@
 #include <btlso_socketoptions.h>
 #include <btlso_socketoptutil.h>
 #include <btlso_streamsocket.h>
+#include <btlso_zerocopyutil.h>
 #include <btlsos_tcpchannel.h>
 #include <btlsos_tcptimedacceptor.h>
 #include <btlsos_tcptimedchannel.h>
@@ -136,6 +139,11 @@ using namespace bdlf::PlaceHolders;
 // [28]  int btlmt::ChannelPool::busyMetrics() const;
 // [14]  int btlmt::ChannelPool::getChannelStatistics*(...);
 // [40]  bool btlmt::ChannelPool::isRunning() const;
+// [42]  int btlmt::ChannelPool::migrateChannel(int, int);
+// [42]  void btlmt::ChannelPool::setLoadBalancingThreshold(int);
+// [43]  int btlmt::ChannelPool::write(...); // zero-copy transmission
+// [44]  int getChannelReadStatistics(Int64 *, Int64 *, int *, int) const;
+// [42]  int btlmt::ChannelPool::loadBalancingThreshold() const;
 // [14]  int btlmt::ChannelPool::numBytes*(...);
 // [14]  int btlmt::ChannelPool::totalBytes*(...);
 // [  ]  const btlso::IPv4Address *ChannelPool::serverAddress(...) const;
@@ -165,7 +173,11 @@ using namespace bdlf::PlaceHolders;
 // [28] TESTING: 'busyMetrics' and time metrics collection.
 // [28] CONCERN: Event Manager Allocation
 // [30] Implementing a QueueProcessor
-// [42] USAGE EXAMPLE
+// [42] CONCERN: Channel migration and load balancing
+// [43] CONCERN: Zero-copy transmission
+// [44] CONCERN: Coalesced reads
+// [45] CONCERN: Thread-cached blob buffers
+// [46] USAGE EXAMPLE
 //=============================================================================
 //                       STANDARD BDE ASSERT TEST MACROS
 //-----------------------------------------------------------------------------
@@ -712,6 +724,366 @@ void populateMessage(btlb::Blob       *msg,
     msg->appendDataBuffer(blobBuffer);
 }
 
+//-----------------------------------------------------------------------------
+// TEST_CASE_COALESCE_READS
+//-----------------------------------------------------------------------------
+
+namespace TEST_CASE_COALESCE_READS {
+
+struct ByteCounter {
+    // This 'struct' provides a data callback counting, and consuming, the
+    // bytes read from all the channels of a channel pool.
+
+    bsls::AtomicInt64 d_numBytes;  // bytes read
+
+    void dataCb(int *numNeeded, btlb::Blob *msg, int, void *)
+        // Count and consume the data of the specified 'msg', and load 1 into
+        // the specified 'numNeeded'.
+    {
+        d_numBytes.addRelaxed(msg->length());
+        btlb::BlobUtil::erase(msg, 0, msg->length());
+        *numNeeded = 1;
+    }
+};
+
+}  // close namespace TEST_CASE_COALESCE_READS
+
+//-----------------------------------------------------------------------------
+// TEST_CASE_ZERO_COPY
+//-----------------------------------------------------------------------------
+
+namespace TEST_CASE_ZERO_COPY {
+
+static
+void loadMessage(btlb::Blob       *result,
+                 bsl::string      *data,
+                 int               numBuffers,
+                 int               bufferSize,
+                 int               seed,
+                 bslma::Allocator *allocator)
+    // Append to the specified 'result' the specified 'numBuffers' buffers of
+    // the specified 'bufferSize' bytes, each allocated from the specified
+    // 'allocator', holding data depending on the specified 'seed', and append
+    // that data to the specified 'data'.
+{
+    for (int i = 0; i < numBuffers; ++i) {
+        bsl::shared_ptr<char> buffer =
+            bslstl::SharedPtrUtil::createInplaceUninitializedBuffer(bufferSize,
+                                                                    allocator);
+        for (int j = 0; j < bufferSize; ++j) {
+            buffer.get()[j] = static_cast<char>('a' + (seed + i + j) % 26);
+        }
+        data->append(buffer.get(), bufferSize);
+        result->appendDataBuffer(btlb::BlobBuffer(buffer, bufferSize));
+    }
+}
+
+static
+int waitForRelease(const bslma::TestAllocator& allocator,
+                   const bsls::TimeInterval&   timeout)
+    // Wait for up to the specified 'timeout' for all the memory allocated
+    // from the specified 'allocator' to be released.  Return 0 on success,
+    // and a non-zero value otherwise.
+{
+    const bsls::TimeInterval deadline = bdlt::CurrentTime::now() + timeout;
+    while (0 != allocator.numBlocksInUse()) {
+        if (deadline < bdlt::CurrentTime::now()) {
+            return -1;                                                // RETURN
+        }
+        bslmt::ThreadUtil::microSleep(10 * 1000);
+    }
+    return 0;
+}
+
+struct Reader {
+    // This 'struct' provides a functor reading from a socket, and counting
+    // the bytes read, until the socket is closed.
+
+    btlso::StreamSocket<btlso::IPv4Address> *d_socket_p;  // source socket
+    bsls::AtomicInt64                       *d_numBytes_p;// bytes read
+
+    void operator()() const
+        // Read from the socket until it is closed.
+    {
+        bsl::vector<char> buffer(1024 * 1024);
+
+        while (1) {
+            const int rc = d_socket_p->read(buffer.data(),
+                                            static_cast<int>(buffer.size()));
+            if (0 >= rc) {
+                return;                                               // RETURN
+            }
+            d_numBytes_p->addRelaxed(rc);
+        }
+    }
+};
+
+}  // close namespace TEST_CASE_ZERO_COPY
+
+//-----------------------------------------------------------------------------
+// TEST_CASE_MIGRATE_CHANNEL
+//-----------------------------------------------------------------------------
+
+namespace TEST_CASE_MIGRATE_CHANNEL {
+
+class DataReceiver {
+    // This class records, for each channel of a channel pool, the data read
+    // from that channel and the thread in which it was last read, optionally
+    // spinning for a configurable amount of time per byte read to simulate
+    // CPU-bound processing.
+
+    // DATA
+    bsl::map<int, bsl::string> d_data;       // data read per channel id
+
+    bsl::map<int, ThreadId>    d_threadIds;  // last reading thread per
+                                             // channel id
+
+    int                        d_spinCount;  // iterations per byte read
+
+    mutable bslmt::Mutex       d_mutex;      // synchronize access to data
+
+  public:
+    // CREATORS
+    explicit DataReceiver(int spinCount, bslma::Allocator *basicAllocator = 0)
+        // Create a receiver spinning for the specified 'spinCount' iterations
+        // per byte read.  Optionally specify a 'basicAllocator' used to
+        // supply memory.
+    : d_data(basicAllocator)
+    , d_threadIds(basicAllocator)
+    , d_spinCount(spinCount)
+    , d_mutex()
+    {
+    }
+
+    // MANIPULATORS
+    void dataCb(int *numNeeded, btlb::Blob *msg, int channelId, void *)
+        // Append the data of the specified 'msg' to the data read from the
+        // channel having the specified 'channelId', and consume it.  Load 1
+        // into the specified 'numNeeded'.
+    {
+        const int length = msg->length();
+
+        volatile int sink = 0;
+        for (int i = 0; i < d_spinCount * length; ++i) {
+            sink = sink + i;
+        }
+
+        {
+            bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+            bsl::string& data = d_data[channelId];
+            const bsl::size_t offset = data.size();
+            data.resize(offset + length);
+            btlb::BlobUtil::copy(&data[offset], *msg, 0, length);
+            d_threadIds[channelId] = bslmt::ThreadUtil::selfIdAsUint64();
+        }
+
+        btlb::BlobUtil::erase(msg, 0, length);
+        *numNeeded = 1;
+    }
+
+    // ACCESSORS
+    bsl::string data(int channelId) const
+        // Return the data read from the channel having the specified
+        // 'channelId'.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        bsl::map<int, bsl::string>::const_iterator it =
+                                                       d_data.find(channelId);
+        return d_data.end() == it ? bsl::string() : it->second;
+    }
+
+    ThreadId threadId(int channelId) const
+        // Return the identifier of the thread in which data was last read
+        // from the channel having the specified 'channelId', or 0 if no data
+        // was read from that channel.
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        bsl::map<int, ThreadId>::const_iterator it =
+                                                  d_threadIds.find(channelId);
+        return d_threadIds.end() == it ? 0 : it->second;
+    }
+
+    int waitForData(int                       channelId,
+                    bsl::size_t               length,
+                    const bsls::TimeInterval& timeout) const
+        // Wait for up to the specified 'timeout' for at least the specified
+        // 'length' bytes to be read from the channel having the specified
+        // 'channelId'.  Return 0 on success, and a non-zero value otherwise.
+    {
+        const bsls::TimeInterval deadline = bdlt::CurrentTime::now()
+                                          + timeout;
+        do {
+            {
+                bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+                bsl::map<int, bsl::string>::const_iterator it =
+                                                       d_data.find(channelId);
+                if (d_data.end() != it && length <= it->second.size()) {
+                    return 0;                                         // RETURN
+                }
+            }
+            bslmt::ThreadUtil::microSleep(10 * 1000);
+        } while (bdlt::CurrentTime::now() < deadline);
+
+        return -1;
+    }
+};
+
+static
+int channelThread(bslmt::ThreadUtil::Handle *result,
+                  const Obj&                 pool,
+                  int                        channelId)
+    // Load into the specified 'result' the handle of the dispatcher thread of
+    // the specified 'pool' handling the channel having the specified
+    // 'channelId'.  Return 0 on success, and a non-zero value if no such
+    // channel exists.
+{
+    bsl::vector<Obj::HandleInfo> handles;
+    pool.getHandleStatistics(&handles);
+
+    for (bsl::size_t i = 0; i < handles.size(); ++i) {
+        if (channelId == handles[i].d_channelId) {
+            *result = handles[i].d_threadHandle;
+            return 0;                                                 // RETURN
+        }
+    }
+    return -1;
+}
+
+static
+bool isSameThread(const Obj& pool, int channelId1, int channelId2)
+    // Return 'true' if the channels of the specified 'pool' having the
+    // specified 'channelId1' and 'channelId2' are handled by the same
+    // dispatcher thread, and 'false' otherwise.
+{
+    bslmt::ThreadUtil::Handle thread1, thread2;
+
+    return 0 == channelThread(&thread1, pool, channelId1)
+        && 0 == channelThread(&thread2, pool, channelId2)
+        && bslmt::ThreadUtil::isEqual(thread1, thread2);
+}
+
+static
+void makePattern(bsl::string *result, int length, int seed)
+    // Load into the specified 'result' a string of the specified 'length'
+    // whose characters depend on the specified 'seed' and on their position.
+{
+    result->resize(length);
+    for (int i = 0; i < length; ++i) {
+        (*result)[i] = static_cast<char>('a' + (seed + i) % 26);
+    }
+}
+
+static
+int readFully(btlso::StreamSocket<btlso::IPv4Address> *socket,
+              bsl::string                             *result,
+              int                                      length)
+    // Read exactly the specified 'length' bytes from the specified 'socket'
+    // into the specified 'result'.  Return 0 on success, and a non-zero value
+    // otherwise.
+{
+    result->resize(length);
+
+    int offset = 0;
+    while (offset < length) {
+        const int rc = socket->read(&(*result)[offset], length - offset);
+        if (0 >= rc) {
+            return -1;                                                // RETURN
+        }
+        offset += rc;
+    }
+    return 0;
+}
+
+static
+int importChannel(btlso::StreamSocket<btlso::IPv4Address>            **client,
+                  ChannelPoolStateCbTester                            *tester,
+                  btlso::InetStreamSocketFactory<btlso::IPv4Address>  *factory)
+    // Import into the channel pool of the specified 'tester' one end of a new
+    // socket pair allocated by the specified 'factory', with automatic reading
+    // enabled, and load the other end into the specified 'client'.  Return
+    // the id of the imported channel on success, and a negative value
+    // otherwise.
+{
+    typedef btlso::StreamSocketFactoryDeleter Deleter;
+
+    btlso::SocketHandle::Handle handles[2];
+    if (0 != btlso::SocketImpUtil::socketPair<btlso::IPv4Address>(
+                                    handles,
+                                    btlso::SocketImpUtil::k_SOCKET_STREAM)) {
+        return -1;                                                    // RETURN
+    }
+
+    bslma::ManagedPtr<btlso::StreamSocket<btlso::IPv4Address> > server(
+                                   factory->allocate(handles[0]),
+                                   factory,
+                                   &Deleter::deleteObject<btlso::IPv4Address>);
+    *client = factory->allocate(handles[1]);
+
+    bsl::vector<ChannelPoolStateCbTester::ChannelState> states;
+    if (0 != tester->pool().import(&server, 0, true, false)
+     || 0 != tester->waitForState(&states,
+                                  btlmt::ChannelPool::e_CHANNEL_UP,
+                                  bsls::TimeInterval(5.0))) {
+        return -1;                                                    // RETURN
+    }
+    return tester->lastOpenedChannelId();
+}
+
+static
+int waitForSameThread(const Obj&                pool,
+                      const bsl::vector<int>&   channelIds,
+                      bool                      sameThread,
+                      const bsls::TimeInterval& timeout)
+    // Wait for up to the specified 'timeout' for the channels of the
+    // specified 'pool' having the specified 'channelIds' to be all handled by
+    // the same dispatcher thread if the specified 'sameThread' is 'true', and
+    // not all by the same thread otherwise.  Return 0 on success, and a
+    // non-zero value otherwise.
+{
+    const bsls::TimeInterval deadline = bdlt::CurrentTime::now() + timeout;
+    do {
+        bool allSame = true;
+        for (bsl::size_t i = 1; i < channelIds.size(); ++i) {
+            allSame = allSame
+                   && isSameThread(pool, channelIds[0], channelIds[i]);
+        }
+        if (allSame == sameThread) {
+            return 0;                                                 // RETURN
+        }
+        bslmt::ThreadUtil::microSleep(10 * 1000);
+    } while (bdlt::CurrentTime::now() < deadline);
+
+    return -1;
+}
+
+struct Sender {
+    // This 'struct' provides a functor writing fixed-size chunks of data to a
+    // socket until a flag is set.
+
+    btlso::StreamSocket<btlso::IPv4Address> *d_socket_p;  // target socket
+    bsls::AtomicBool                        *d_done_p;    // stop flag
+    int                                      d_chunkSize; // bytes per write
+
+    void operator()() const
+        // Write chunks of data to the socket until the stop flag is set.
+    {
+        bsl::string chunk;
+        makePattern(&chunk, d_chunkSize, 0);
+
+        while (!*d_done_p) {
+            if (0 >= d_socket_p->write(chunk.data(), d_chunkSize)) {
+                return;                                               // RETURN
+            }
+        }
+    }
+};
+
+}  // close namespace TEST_CASE_MIGRATE_CHANNEL
+
 //-----------------------------------------------------------------------------
 // TEST_CASE_WATERMARK_SEQUENCING
 //-----------------------------------------------------------------------------
@@ -8103,9 +8475,21 @@ class TestDriver {
 
   public:
     // TEST CASES
-    static void testCase42();
+    static void testCase46();
         // Test usage example.
 
+    static void testCase45();
+        // Test thread-cached blob buffers.
+
+    static void testCase44();
+        // Test coalesced reads.
+
+    static void testCase43();
+        // Test zero-copy transmission.
+
+    static void testCase42();
+        // Test channel migration and load balancing.
+
     static void testCase41();
         // Test that 'reuseAddress' option passed to 'listen' works as
         // expected.
@@ -8134,155 +8518,860 @@ class TestDriver {
         // Test that 'e_WRITE_QUEUE_LOWWATER' is invoked after the
         // 'enqueueWatermark' is exceeded on the 'write'.
 
-    static void testCase33();
-        // Test that additional write statistics are reported as expected.
+    static void testCase33();
+        // Test that additional write statistics are reported as expected.
+
+    static void testCase32();
+        // Test that 'peerAddress' is correctly returned.
+
+    static void testCase31();
+        // Test that 'disableRead' when called from dispatcher thread stops
+        // reading from the socket.
+
+    static void testCase30();
+        // Test a queue processor implementation.
+
+    static void testCase29();
+        // Test that channel pool does not read extra data even after
+        // numNeeded is set to 0.
+
+    static void testCase28();
+        // Test that providing socket options sets the appropriate options on
+        // the socket.
+
+    static void testCase27();
+        // Test that reading into a partially filled blob works as expected.
+
+    static void testCase26();
+        // Test that blob-based 'read' works as expected.
+
+    static void testCase25();
+        // Test that the allocation of event managers works as expected.
+
+    static void testCase24();
+        // Test that the time metrics are correctly computed.
+
+    static void testCase23();
+        // Test that read operations time out correctly.
+
+    static void testCase22();
+        // Test that 'btlmt::ChannelPool_MessageUtil' class works as expected.
+
+    static void testCase21();
+        // Test that 'setWriteQueue[Hi|Low]Watermark' and
+        // 'setWriteQueueWatermarks' work as expected.
+
+    static void testCase20();
+        // Test that reading from OpenSSL sockets works as expected.
+
+    static void testCase19();
+        // Test that 'import' works under high load.
+
+    static void testCase18();
+        // Test that channel pool fails to accept connections when its file
+        // descriptor limit is reached.
+
+    static void testCase17();
+        // Test that channel pool only creates 'maxConnections' channels.
+
+    static void testCase16();
+        // Test that CHANNEL_UP and CHANNEL_DOWN callbacks are correctly
+        // delivered.
+
+    static void testCase15();
+        // Test that 'shutdown' is correctly processed from within a channel
+        // state callback.
+
+    static void testCase14();
+        // Test that the 'getHandleStatistics' returns the correct statistics.
+
+    static void testCase13();
+        // Test that 'numBytes*', 'totalBytes*' and related accessors return
+        // the right values.
+
+    static void testCase12();
+        // Test that 'reportWeightedAverageReset' works as expected.
+
+    static void testCase11();
+        // Test that HIGHWATER and LOWWATER callbacks are correctly invoked.
+
+    static void testCase10();
+        // Test that 'enableRead' and 'disableRead' work as expected.
+
+    static void testCase9();
+        // Test that 'registerClock' AND 'deregisterClock' work as expected.
+
+    static void testCase8();
+        // Test that 'writeMessage' works as expected.
+
+    static void testCase7();
+        // Test that 'shutdown' works as expected.
+
+    static void testCase6();
+        // Test that a half-closed socket pair can be correctly imported and
+        // that the channel is correctly recognized as half-closed.
+
+    static void testCase5();
+        // Test that 'import' works as expected.
+
+    static void testCase4();
+        // Test that 'listen' works as expected.
+
+    static void testCase3();
+        // Test that 'connect' works as expected.
+
+    static void testCase2();
+        // Test that 'start' and 'stop' work as expected.
+
+    static void testCase1();
+        // Breathing test.
+};
+
+
+                               // --------------
+                               // TEST APPARATUS
+                               // --------------
+
+void TestDriver::testCase46()
+{
+        // --------------------------------------------------------------------
+        // TESTING USAGE EXAMPLE
+        //
+        // Concerns:
+        //   The usage example provided in the component header file must
+        //   compile, link, and execute as shown.
+        //
+        // Plan:
+        //   Incorporate the usage example from the header file into the test
+        //   driver.  Additionally, replace all calls to 'assert' in the usage
+        //   example with calls to 'ASSERT'.
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose)
+            cout << "\nTESTING USAGE EXAMPLE - AN ECHO SERVER"
+                 << "\n======================================" << endl;
+
+        using namespace USAGE_EXAMPLE_NAMESPACE;
+
+        enum {
+            MAX_CONNECTIONS = 1000,
+            NUM_MONITOR     = 10
+        };
+
+        my_EchoServer echoServer(&coutMutex, 0, MAX_CONNECTIONS);
+
+        if (verbose) {
+            MTCOUT << "monitor pool: count=" << NUM_MONITOR << MTENDL;
+        }
+        monitorPool(&coutMutex, echoServer.pool(), NUM_MONITOR);
+}
+
+void TestDriver::testCase45()
+{
+    // ------------------------------------------------------------------------
+    // TESTING THREAD-CACHED BLOB BUFFERS
+    //
+    // Concerns:
+    //: 1 By default, the channel pool allocates blob buffers from
+    //:   'btlb::PooledBlobBufferFactory' objects.
+    //:
+    //: 2 If the 'threadCachedBuffers' attribute is 'true', the channel pool
+    //:   allocates blob buffers from 'btlb::CachingBlobBufferFactory' objects
+    //:   of the configured message sizes, and data is read and written
+    //:   intact.
+    //:
+    //: 3 The attribute is ignored if a blob buffer factory is supplied at
+    //:   construction.
+    //
+    // Plan:
+    //: 1 For both values of the 'threadCachedBuffers' configuration
+    //:   attribute, verify the type and buffer size of the incoming and
+    //:   outbound blob buffer factories, then import a channel, exchange
+    //:   messages over it in both directions, and verify the data received.
+    //:   (C-1..2)
+    //:
+    //: 2 Create a channel pool supplying a blob buffer factory and verify
+    //:   that it is used for both directions.  (C-3)
+    //
+    // Testing:
+    //   CONCERN: Thread-cached blob buffers
+    // ------------------------------------------------------------------------
+
+    if (verbose)
+        cout << "TESTING THREAD-CACHED BLOB BUFFERS" << endl
+             << "==================================" << endl;
+
+    using namespace TEST_CASE_MIGRATE_CHANNEL;
+
+    typedef btlso::StreamSocket<btlso::IPv4Address> Socket;
+
+    enum {
+        k_INCOMING_SIZE = 512,
+        k_OUTGOING_SIZE = 256,
+        k_MESSAGE_SIZE  = 1000,
+        k_NUM_MESSAGES  = 64
+    };
+
+    btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+    Obj::PoolStateChangeCallback poolCb;
+    makeNull(&poolCb);
+
+    for (int cached = 0; cached < 2; ++cached) {
+        if (verbose) cout << "\tthreadCachedBuffers = " << cached << endl;
+
+        btlmt::ChannelPoolConfiguration config;
+        config.setMaxThreads(2);
+        config.setIncomingMessageSizes(1, 1, k_INCOMING_SIZE);
+        config.setOutgoingMessageSizes(1, 1, k_OUTGOING_SIZE);
+        config.setThreadCachedBuffers(cached);
+
+        DataReceiver               receiver(0);
+        Obj::BlobBasedReadCallback dataCb(bdlf::MemFnUtil::memFn(
+                                                         &DataReceiver::dataCb,
+                                                         &receiver));
+
+        ChannelPoolStateCbTester tester(config, dataCb, poolCb);
+
+        Obj& mX = tester.pool();
+        ASSERT(0 == mX.start());
+
+        typedef btlb::CachingBlobBufferFactory CachingFactory;
+        typedef btlb::PooledBlobBufferFactory  PooledFactory;
+
+        btlb::BlobBufferFactory *incoming = mX.incomingBlobBufferFactory();
+        btlb::BlobBufferFactory *outbound = mX.outboundBlobBufferFactory();
+
+        CachingFactory *incomingCaching =
+                                     dynamic_cast<CachingFactory *>(incoming);
+        CachingFactory *outboundCaching =
+                                     dynamic_cast<CachingFactory *>(outbound);
+        PooledFactory  *incomingPooled  =
+                                      dynamic_cast<PooledFactory *>(incoming);
+        PooledFactory  *outboundPooled  =
+                                      dynamic_cast<PooledFactory *>(outbound);
+
+        if (cached) {
+            ASSERT(incomingCaching);
+            ASSERT(outboundCaching);
+            ASSERT(!incomingPooled);
+            ASSERT(!outboundPooled);
+
+            ASSERT(k_INCOMING_SIZE == incomingCaching->bufferSize());
+            ASSERT(k_OUTGOING_SIZE == outboundCaching->bufferSize());
+        }
+        else {
+            ASSERT(!incomingCaching);
+            ASSERT(!outboundCaching);
+            ASSERT(incomingPooled);
+            ASSERT(outboundPooled);
+
+            ASSERT(k_INCOMING_SIZE == incomingPooled->bufferSize());
+            ASSERT(k_OUTGOING_SIZE == outboundPooled->bufferSize());
+        }
+
+        Socket    *client    = 0;
+        const int  channelId = importChannel(&client, &tester, &factory);
+        ASSERT(0 <= channelId);
+
+        bsl::string expected;
+        for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+            bsl::string message;
+            makePattern(&message, k_MESSAGE_SIZE, i);
+            LOOP_ASSERT(i, k_MESSAGE_SIZE == client->write(message.data(),
+                                                           k_MESSAGE_SIZE));
+            expected += message;
+        }
+        ASSERT(0 == receiver.waitForData(channelId,
+                                         expected.size(),
+                                         TimeInterval(5)));
+        ASSERT(expected == receiver.data(channelId));
+
+        expected.clear();
+        for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+            bsl::string message;
+            makePattern(&message, k_MESSAGE_SIZE, i + 1);
+
+            btlb::Blob blob(mX.outboundBlobBufferFactory());
+            btlb::BlobUtil::append(&blob, message.data(), k_MESSAGE_SIZE);
+            LOOP_ASSERT(i, 0 == mX.write(channelId, blob));
+            expected += message;
+        }
+
+        bsl::string received;
+        ASSERT(0 == readFully(client,
+                              &received,
+                              static_cast<int>(expected.size())));
+        ASSERT(expected == received);
+
+        ASSERT(0 == mX.stopAndRemoveAllChannels());
+        factory.deallocate(client);
+    }
+
+    if (verbose) cout << "\tSupplied blob buffer factory." << endl;
+    {
+        btlmt::ChannelPoolConfiguration config;
+        config.setThreadCachedBuffers(true);
+
+        btlb::PooledBlobBufferFactory blobFactory(100);
+
+        Obj::ChannelStateChangeCallback channelCb;
+        Obj::BlobBasedReadCallback      dataCb;
+        makeNull(&channelCb);
+        makeNull(&dataCb);
+
+        Obj mX(&blobFactory, channelCb, dataCb, poolCb, config);
+        ASSERT(&blobFactory == mX.incomingBlobBufferFactory());
+        ASSERT(&blobFactory == mX.outboundBlobBufferFactory());
+    }
+}
+
+void TestDriver::testCase44()
+{
+    // ------------------------------------------------------------------------
+    // TESTING COALESCED READS
+    //
+    // Concerns:
+    //: 1 By default, the data callback is invoked after each read returning
+    //:   data.
+    //:
+    //: 2 If reads are coalesced, the data available on a socket is read
+    //:   entirely (in several reads if needed) before the data callback is
+    //:   invoked once, and the data is delivered intact.
+    //:
+    //: 3 The average read size follows the amount of data available each
+    //:   time the socket is readable.
+    //:
+    //: 4 'getChannelReadStatistics' fails for an invalid channel id.
+    //
+    // Plan:
+    //: 1 For both values of the 'coalesceReads' configuration attribute,
+    //:   import a channel, disable reading on it, write to its peer socket
+    //:   many small messages, totalling many times the size of a read buffer,
+    //:   and re-enable reading.  Verify the data received and the read
+    //:   statistics of the channel.  (C-1..2)
+    //:
+    //: 2 Then write single small messages to the peer socket, waiting for
+    //:   each to be received, and verify that the average read size
+    //:   decreases to a value close to the size of those messages.  (C-3)
+    //:
+    //: 3 Call 'getChannelReadStatistics' with an invalid channel id.  (C-4)
+    //
+    // Testing:
+    //   int getChannelReadStatistics(Int64 *, Int64 *, int *, int) const;
+    // ------------------------------------------------------------------------
+
+    if (verbose)
+        cout << "TESTING COALESCED READS" << endl
+             << "=======================" << endl;
+
+    using namespace TEST_CASE_MIGRATE_CHANNEL;
+
+    typedef btlso::StreamSocket<btlso::IPv4Address> Socket;
+    typedef ChannelPoolStateCbTester::ChannelState  ChannelState;
+
+    enum {
+        k_BUFFER_SIZE   = 1024,
+        k_MESSAGE_SIZE  = 32,
+        k_NUM_MESSAGES  = 256,
+        k_NUM_SINGLES   = 64
+    };
+
+    btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+    Obj::PoolStateChangeCallback poolCb;
+    makeNull(&poolCb);
+
+    for (int coalesce = 0; coalesce < 2; ++coalesce) {
+        if (verbose) cout << "\tcoalesceReads = " << coalesce << endl;
+
+        btlmt::ChannelPoolConfiguration config;
+        config.setMaxThreads(1);
+        config.setIncomingMessageSizes(1, 1, k_BUFFER_SIZE);
+        config.setCoalesceReads(coalesce);
+
+        DataReceiver               receiver(0);
+        Obj::BlobBasedReadCallback dataCb(bdlf::MemFnUtil::memFn(
+                                                         &DataReceiver::dataCb,
+                                                         &receiver));
+
+        ChannelPoolStateCbTester tester(config, dataCb, poolCb);
+
+        Obj& mX = tester.pool();  const Obj& X = mX;
+        ASSERT(0 == mX.start());
+
+        Socket    *client    = 0;
+        const int  channelId = importChannel(&client, &tester, &factory);
+        ASSERT(0 <= channelId);
+
+        bsls::Types::Int64 numReads         = -1;
+        bsls::Types::Int64 numReadCallbacks = -1;
+        int                averageReadSize  = -1;
+
+        ASSERT(0 == X.getChannelReadStatistics(&numReads,
+                                               &numReadCallbacks,
+                                               &averageReadSize,
+                                               channelId));
+        LOOP_ASSERT(numReads,         0 == numReads);
+        LOOP_ASSERT(numReadCallbacks, 0 == numReadCallbacks);
+        LOOP_ASSERT(averageReadSize,  0 == averageReadSize);
+
+        bsl::vector<ChannelState> states;
+
+        ASSERT(0 == mX.disableRead(channelId));
+        ASSERT(0 == tester.waitForState(&states,
+                                        Obj::e_AUTO_READ_DISABLED,
+                                        TimeInterval(5)));
+
+        bsl::string expected;
+        for (int i = 0; i < k_NUM_MESSAGES; ++i) {
+            bsl::string message;
+            makePattern(&message, k_MESSAGE_SIZE, i);
+            LOOP_ASSERT(i, k_MESSAGE_SIZE == client->write(message.data(),
+                                                           k_MESSAGE_SIZE));
+            expected += message;
+        }
+
+        ASSERT(0 == mX.enableRead(channelId));
+        ASSERT(0 == receiver.waitForData(channelId,
+                                         expected.size(),
+                                         TimeInterval(5)));
+        ASSERT(expected == receiver.data(channelId));
+
+        ASSERT(0 == X.getChannelReadStatistics(&numReads,
+                                               &numReadCallbacks,
+                                               &averageReadSize,
+                                               channelId));
+        if (veryVerbose) {
+            P_(numReads) P_(numReadCallbacks) P(averageReadSize)
+        }
+
+        // The pending data cannot be read in a single read, since the number
+        // of buffers supplied to each read grows by one from a single buffer.
+
+        LOOP_ASSERT(numReads, 1 < numReads);
+
+        if (coalesce) {
+            LOOP2_ASSERT(numReads, numReadCallbacks,
+                         numReadCallbacks < numReads);
+            LOOP_ASSERT(averageReadSize,
+                        static_cast<int>(expected.size()) == averageReadSize);
+        }
+        else {
+            LOOP2_ASSERT(numReads, numReadCallbacks,
+                         numReadCallbacks == numReads);
+        }
+
+        for (int i = 0; i < k_NUM_SINGLES; ++i) {
+            bsl::string message;
+            makePattern(&message, k_MESSAGE_SIZE, i);
+            LOOP_ASSERT(i, k_MESSAGE_SIZE == client->write(message.data(),
+                                                           k_MESSAGE_SIZE));
+            expected += message;
+
+            LOOP_ASSERT(i, 0 == receiver.waitForData(channelId,
+                                                     expected.size(),
+                                                     TimeInterval(5)));
+        }
+        ASSERT(expected == receiver.data(channelId));
+
+        const int previousAverageReadSize = averageReadSize;
+
+        ASSERT(0 == X.getChannelReadStatistics(&numReads,
+                                               &numReadCallbacks,
+                                               &averageReadSize,
+                                               channelId));
+        if (veryVerbose) {
+            P_(numReads) P_(numReadCallbacks) P(averageReadSize)
+        }
+
+        LOOP2_ASSERT(previousAverageReadSize, averageReadSize,
+                     averageReadSize < previousAverageReadSize);
+        LOOP_ASSERT(averageReadSize, averageReadSize < 2 * k_MESSAGE_SIZE);
+
+        ASSERT(0 != X.getChannelReadStatistics(&numReads,
+                                               &numReadCallbacks,
+                                               &averageReadSize,
+                                               channelId + 1));
+
+        ASSERT(0 == mX.stopAndRemoveAllChannels());
+        factory.deallocate(client);
+    }
+}
+
+void TestDriver::testCase43()
+{
+    // ------------------------------------------------------------------------
+    // TESTING ZERO-COPY TRANSMISSION
+    //
+    // Concerns:
+    //: 1 The data written to a channel for which zero-copy transmission is
+    //:   enabled is received intact and in order, whether the messages are
+    //:   above or below the zero-copy threshold, and whether they are blobs
+    //:   or arrays of iovecs.
+    //:
+    //: 2 The blob buffers of the messages written are released once their
+    //:   transmission completes, while the channel is still open.
+    //:
+    //: 3 The blob buffers are released when the channel is closed.
+    //
+    // Plan:
+    //: 1 Import a channel into a channel pool having a zero-copy threshold,
+    //:   and write to it large blobs, small blobs and arrays of iovecs whose
+    //:   buffers are allocated from a test allocator.  Read the data from the
+    //:   peer socket and verify it.  (C-1)
+    //:
+    //: 2 Release the blobs written, and verify that all the memory of the
+    //:   test allocator is released while the channel is open.  (C-2)
+    //:
+    //: 3 Write more large blobs to the channel, without reading them from the
+    //:   peer socket, release the blobs, and close the channel.  Verify that
+    //:   all the memory of the test allocator is released.  (C-3)
+    //
+    // Testing:
+    //   int write(int channelId, const btlb::Blob& message);
+    // ------------------------------------------------------------------------
+
+    if (verbose)
+        cout << "TESTING ZERO-COPY TRANSMISSION" << endl
+             << "==============================" << endl;
+
+    using namespace TEST_CASE_ZERO_COPY;
+    using namespace TEST_CASE_MIGRATE_CHANNEL;
+
+    typedef btlso::StreamSocket<btlso::IPv4Address> Socket;
+
+    if (verbose && !btlso::ZeroCopyUtil::isSupported()) {
+        cout << "\tZero-copy transmission is not supported: the data is "
+             << "copied." << endl;
+    }
+
+    enum {
+        k_THRESHOLD   = 16 * 1024,
+        k_NUM_BUFFERS = 8,
+        k_BUFFER_SIZE = 32 * 1024,
+        k_NUM_BLOBS   = 32
+    };
+
+    btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+    bslma::TestAllocator                               ta(veryVeryVerbose);
+
+    btlmt::ChannelPoolConfiguration config;
+    config.setMaxThreads(1);
+    config.setZeroCopyThreshold(k_THRESHOLD);
+    config.setWriteQueueWatermarks(0, 64 * 1024 * 1024);
+
+    ChannelPoolStateCbTester tester(config);
+
+    Obj& mX = tester.pool();
+    ASSERT(0 == mX.start());
+
+    Socket    *client    = 0;
+    const int  channelId = importChannel(&client, &tester, &factory);
+    ASSERT(0 <= channelId);
+
+    if (verbose) cout << "\tWriting large and small messages." << endl;
+    {
+        bsl::string expected;
+        for (int i = 0; i < k_NUM_BLOBS; ++i) {
+            btlb::Blob blob;
+            loadMessage(&blob,
+                        &expected,
+                        i % 4 ? k_NUM_BUFFERS : 1,
+                        i % 8 ? k_BUFFER_SIZE : 100,
+                        i,
+                        &ta);
+            LOOP_ASSERT(i, 0 == mX.write(channelId, blob));
+
+            if (0 == i % 5) {
+                bsl::string iovecData;
+                makePattern(&iovecData, 2 * k_THRESHOLD, i);
+
+                btls::Iovec iovecs[2];
+                iovecs[0].setBuffer(&iovecData[0], k_THRESHOLD);
+                iovecs[1].setBuffer(&iovecData[k_THRESHOLD], k_THRESHOLD);
+
+                LOOP_ASSERT(i, 0 == mX.write(channelId, iovecs, 2));
+                expected += iovecData;
+            }
+        }
+
+        bsl::string received;
+        ASSERT(0 == readFully(client,
+                              &received,
+                              static_cast<int>(expected.size())));
+        ASSERT(expected == received);
+
+        ASSERT(0 == waitForRelease(ta, TimeInterval(5)));
+        LOOP_ASSERT(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+    }
+
+    if (verbose) cout << "\tClosing with pending messages." << endl;
+    {
+        bsl::string expected;
+        for (int i = 0; i < k_NUM_BLOBS; ++i) {
+            btlb::Blob blob;
+            loadMessage(&blob,
+                        &expected,
+                        k_NUM_BUFFERS,
+                        k_BUFFER_SIZE,
+                        i,
+                        &ta);
+            LOOP_ASSERT(i, 0 == mX.write(channelId, blob));
+        }
+        ASSERT(0 < ta.numBlocksInUse());
+
+        ASSERT(0 == mX.stopAndRemoveAllChannels());
+
+        ASSERT(0 == waitForRelease(ta, TimeInterval(5)));
+        LOOP_ASSERT(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+    }
+
+    factory.deallocate(client);
+}
+
+void TestDriver::testCase42()
+{
+    // ------------------------------------------------------------------------
+    // TESTING CHANNEL MIGRATION AND LOAD BALANCING
+    //
+    // Concerns:
+    //: 1 'migrateChannel' moves the handling of a channel to the dispatcher
+    //:   thread having the specified index.
+    //:
+    //: 2 'migrateChannel' returns a positive value if the channel is already
+    //:   handled by the specified thread, and a negative value if the channel
+    //:   id or the thread index is invalid.
+    //:
+    //: 3 The data read from a channel is delivered in order across
+    //:   migrations.
+    //:
+    //: 4 The data enqueued for writing on a channel is written in order
+    //:   across a migration.
+    //:
+    //: 5 The load balancing threshold is 0 by default, and is set by
+    //:   'setLoadBalancingThreshold'.
+    //:
+    //: 6 If load balancing is enabled, one of two busy channels handled by
+    //:   the same thread is migrated to an idle thread.
+    //
+    // Plan:
+    //: 1 Import a socket pair into a channel pool having two threads, migrate
+    //:   the channel to the thread not handling it, and verify the status
+    //:   returned and that the channel is subsequently handled by, and its
+    //:   data read in, that thread.  Call 'migrateChannel' with invalid
+    //:   arguments.  (C-1..2)
+    //:
+    //: 2 Write data to the peer socket in chunks, migrating the channel
+    //:   between the two threads after each chunk, and verify the data read.
+    //:   (C-3)
+    //:
+    //: 3 Write to the channel more data than the socket buffers can hold,
+    //:   migrating the channel midway, then read the data from the peer
+    //:   socket and verify it.  (C-4)
+    //:
+    //: 4 Set the load balancing threshold and verify its value.  (C-5)
+    //:
+    //: 5 Import two channels into a channel pool having two threads, whose
+    //:   data callback spins per byte read, and migrate them to the same
+    //:   thread.  Write to both channels continuously, enable load balancing,
+    //:   and verify that the channels end up being handled by different
+    //:   threads.  (C-6)
+    //
+    // Testing:
+    //   int migrateChannel(int channelId, int threadIndex);
+    //   void setLoadBalancingThreshold(int percentage);
+    //   int loadBalancingThreshold() const;
+    // ------------------------------------------------------------------------
+
+    if (verbose)
+        cout << "TESTING CHANNEL MIGRATION AND LOAD BALANCING" << endl
+             << "============================================" << endl;
+
+    using namespace TEST_CASE_MIGRATE_CHANNEL;
+
+    typedef btlso::StreamSocket<btlso::IPv4Address> Socket;
+
+    btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+    btlmt::ChannelPoolConfiguration config;
+    config.setMaxThreads(2);
+    config.setMetricsInterval(0.1);
+    config.setCollectTimeMetrics(true);
+    config.setWriteQueueWatermarks(0, 64 * 1024 * 1024);
 
-    static void testCase32();
-        // Test that 'peerAddress' is correctly returned.
+    Obj::PoolStateChangeCallback poolCb;
+    makeNull(&poolCb);
 
-    static void testCase31();
-        // Test that 'disableRead' when called from dispatcher thread stops
-        // reading from the socket.
+    {
+        DataReceiver               receiver(0);
+        Obj::BlobBasedReadCallback dataCb(bdlf::MemFnUtil::memFn(
+                                                         &DataReceiver::dataCb,
+                                                         &receiver));
 
-    static void testCase30();
-        // Test a queue processor implementation.
+        ChannelPoolStateCbTester tester(config, dataCb, poolCb);
 
-    static void testCase29();
-        // Test that channel pool does not read extra data even after
-        // numNeeded is set to 0.
+        Obj& mX = tester.pool();  const Obj& X = mX;
+        ASSERT(0 == mX.start());
 
-    static void testCase28();
-        // Test that providing socket options sets the appropriate options on
-        // the socket.
+        Socket    *client    = 0;
+        const int  channelId = importChannel(&client, &tester, &factory);
+        ASSERT(0 <= channelId);
 
-    static void testCase27();
-        // Test that reading into a partially filled blob works as expected.
+        if (verbose) cout << "\tTesting 'migrateChannel'." << endl;
 
-    static void testCase26();
-        // Test that blob-based 'read' works as expected.
+        int targetIndex = 0;
+        {
+            ASSERT(1 == client->write("x", 1));
+            ASSERT(0 == receiver.waitForData(channelId, 1, TimeInterval(5)));
 
-    static void testCase25();
-        // Test that the allocation of event managers works as expected.
+            const ThreadId initialThreadId = receiver.threadId(channelId);
 
-    static void testCase24();
-        // Test that the time metrics are correctly computed.
+            bslmt::ThreadUtil::Handle initialThread;
+            ASSERT(0 == channelThread(&initialThread, X, channelId));
 
-    static void testCase23();
-        // Test that read operations time out correctly.
+            // Migrate the channel to the first thread, or to the second one
+            // if it is already handled by the first.
 
-    static void testCase22();
-        // Test that 'btlmt::ChannelPool_MessageUtil' class works as expected.
+            int rc = mX.migrateChannel(channelId, 0);
+            if (0 < rc) {
+                targetIndex = 1;
+                rc          = mX.migrateChannel(channelId, 1);
+            }
+            ASSERT(0 == rc);
 
-    static void testCase21();
-        // Test that 'setWriteQueue[Hi|Low]Watermark' and
-        // 'setWriteQueueWatermarks' work as expected.
+            bslmt::ThreadUtil::Handle thread = initialThread;
+            for (int i = 0;
+                 i < 500 && bslmt::ThreadUtil::isEqual(thread, initialThread);
+                 ++i) {
+                bslmt::ThreadUtil::microSleep(10 * 1000);
+                ASSERT(0 == channelThread(&thread, X, channelId));
+            }
+            ASSERT(!bslmt::ThreadUtil::isEqual(thread, initialThread));
 
-    static void testCase20();
-        // Test that reading from OpenSSL sockets works as expected.
+            ASSERT(1 == client->write("y", 1));
+            ASSERT(0 == receiver.waitForData(channelId, 2, TimeInterval(5)));
 
-    static void testCase19();
-        // Test that 'import' works under high load.
+            ASSERT(initialThreadId != receiver.threadId(channelId));
+            ASSERT("xy"            == receiver.data(channelId));
 
-    static void testCase18();
-        // Test that channel pool fails to accept connections when its file
-        // descriptor limit is reached.
+            ASSERT(0 <  mX.migrateChannel(channelId, targetIndex));
 
-    static void testCase17();
-        // Test that channel pool only creates 'maxConnections' channels.
+            ASSERT(0 >  mX.migrateChannel(-1, 0));
+            ASSERT(0 >  mX.migrateChannel(channelId, -1));
+            ASSERT(0 >  mX.migrateChannel(channelId, 2));
+        }
 
-    static void testCase16();
-        // Test that CHANNEL_UP and CHANNEL_DOWN callbacks are correctly
-        // delivered.
+        if (verbose) cout << "\tTesting the order of data read." << endl;
+        {
+            enum { k_NUM_CHUNKS = 100, k_CHUNK_SIZE = 1000 };
 
-    static void testCase15();
-        // Test that 'shutdown' is correctly processed from within a channel
-        // state callback.
+            bsl::string expected = receiver.data(channelId);
+            for (int i = 0; i < k_NUM_CHUNKS; ++i) {
+                bsl::string chunk;
+                makePattern(&chunk, k_CHUNK_SIZE, i);
 
-    static void testCase14();
-        // Test that the 'getHandleStatistics' returns the correct statistics.
+                LOOP_ASSERT(i, k_CHUNK_SIZE == client->write(chunk.data(),
+                                                             k_CHUNK_SIZE));
+                expected += chunk;
 
-    static void testCase13();
-        // Test that 'numBytes*', 'totalBytes*' and related accessors return
-        // the right values.
+                mX.migrateChannel(channelId, i % 2);
+            }
 
-    static void testCase12();
-        // Test that 'reportWeightedAverageReset' works as expected.
+            ASSERT(0 == receiver.waitForData(channelId,
+                                             expected.size(),
+                                             TimeInterval(10)));
+            ASSERT(expected == receiver.data(channelId));
+        }
 
-    static void testCase11();
-        // Test that HIGHWATER and LOWWATER callbacks are correctly invoked.
+        if (verbose) cout << "\tTesting the order of data written." << endl;
+        {
+            enum { k_NUM_CHUNKS = 64, k_CHUNK_SIZE = 64 * 1024 };
 
-    static void testCase10();
-        // Test that 'enableRead' and 'disableRead' work as expected.
+            bsl::string expected;
+            makePattern(&expected, k_NUM_CHUNKS * k_CHUNK_SIZE, 7);
 
-    static void testCase9();
-        // Test that 'registerClock' AND 'deregisterClock' work as expected.
+            for (int i = 0; i < k_NUM_CHUNKS; ++i) {
+                btls::Iovec vec(&expected[i * k_CHUNK_SIZE], k_CHUNK_SIZE);
+                LOOP_ASSERT(i, 0 == mX.write(channelId, &vec, 1));
 
-    static void testCase8();
-        // Test that 'writeMessage' works as expected.
+                if (k_NUM_CHUNKS / 2 == i) {
+                    mX.migrateChannel(channelId, 1 - targetIndex);
+                }
+            }
 
-    static void testCase7();
-        // Test that 'shutdown' works as expected.
+            bsl::string received;
+            ASSERT(0 == readFully(client,
+                                  &received,
+                                  k_NUM_CHUNKS * k_CHUNK_SIZE));
+            ASSERT(expected == received);
+        }
 
-    static void testCase6();
-        // Test that a half-closed socket pair can be correctly imported and
-        // that the channel is correctly recognized as half-closed.
+        if (verbose) cout << "\tTesting 'setLoadBalancingThreshold'." << endl;
+        {
+            ASSERT(0  == X.loadBalancingThreshold());
 
-    static void testCase5();
-        // Test that 'import' works as expected.
+            mX.setLoadBalancingThreshold(20);
+            ASSERT(20 == X.loadBalancingThreshold());
 
-    static void testCase4();
-        // Test that 'listen' works as expected.
+            mX.setLoadBalancingThreshold(0);
+            ASSERT(0  == X.loadBalancingThreshold());
+        }
 
-    static void testCase3();
-        // Test that 'connect' works as expected.
+        ASSERT(0 == mX.stopAndRemoveAllChannels());
+        factory.deallocate(client);
+    }
 
-    static void testCase2();
-        // Test that 'start' and 'stop' work as expected.
+    if (verbose) cout << "\tTesting load balancing." << endl;
+    {
+        enum { k_NUM_CHANNELS = 2, k_SPIN_COUNT = 100 };
 
-    static void testCase1();
-        // Breathing test.
-};
+        DataReceiver               receiver(k_SPIN_COUNT);
+        Obj::BlobBasedReadCallback dataCb(bdlf::MemFnUtil::memFn(
+                                                         &DataReceiver::dataCb,
+                                                         &receiver));
 
+        ChannelPoolStateCbTester tester(config, dataCb, poolCb);
 
-                               // --------------
-                               // TEST APPARATUS
-                               // --------------
+        Obj& mX = tester.pool();  const Obj& X = mX;
+        ASSERT(0 == mX.start());
 
-void TestDriver::testCase42()
-{
-        // --------------------------------------------------------------------
-        // TESTING USAGE EXAMPLE
-        //
-        // Concerns:
-        //   The usage example provided in the component header file must
-        //   compile, link, and execute as shown.
-        //
-        // Plan:
-        //   Incorporate the usage example from the header file into the test
-        //   driver.  Additionally, replace all calls to 'assert' in the usage
-        //   example with calls to 'ASSERT'.
-        //
-        // Testing:
-        //   USAGE EXAMPLE
-        // --------------------------------------------------------------------
+        Socket           *clients[k_NUM_CHANNELS];
+        bsl::vector<int>  channelIds;
+        for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+            channelIds.push_back(importChannel(&clients[i],
+                                               &tester,
+                                               &factory));
+            LOOP_ASSERT(i, 0 <= channelIds[i]);
+            LOOP_ASSERT(i, 0 <= mX.migrateChannel(channelIds[i], 0));
+        }
+        ASSERT(0 == waitForSameThread(X, channelIds, true, TimeInterval(5)));
 
-        if (verbose)
-            cout << "\nTESTING USAGE EXAMPLE - AN ECHO SERVER"
-                 << "\n======================================" << endl;
+        bsls::AtomicBool          done(false);
+        bslmt::ThreadUtil::Handle senders[k_NUM_CHANNELS];
+        for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+            Sender sender = { clients[i], &done, 1024 };
+            LOOP_ASSERT(i, 0 == bslmt::ThreadUtil::create(&senders[i],
+                                                          sender));
+        }
 
-        using namespace USAGE_EXAMPLE_NAMESPACE;
+        mX.setLoadBalancingThreshold(20);
 
-        enum {
-            MAX_CONNECTIONS = 1000,
-            NUM_MONITOR     = 10
-        };
+        ASSERT(0 == waitForSameThread(X, channelIds, false, TimeInterval(10)));
 
-        my_EchoServer echoServer(&coutMutex, 0, MAX_CONNECTIONS);
+        done = true;
+        for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+            LOOP_ASSERT(i, 0 == bslmt::ThreadUtil::join(senders[i]));
+        }
 
-        if (verbose) {
-            MTCOUT << "monitor pool: count=" << NUM_MONITOR << MTENDL;
+        ASSERT(0 == mX.stopAndRemoveAllChannels());
+        for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+            factory.deallocate(clients[i]);
         }
-        monitorPool(&coutMutex, echoServer.pool(), NUM_MONITOR);
+    }
 }
 
 void TestDriver::testCase41()
@@ -16666,6 +17755,321 @@ static void negativeCase3()
 }
 
 
+static void negativeCase4()
+{
+        // --------------------------------------------------------------------
+        // BENCHMARK: LOAD BALANCING
+        //
+        // Plan:
+        //   Import 8 channels into a channel pool having 4 threads, whose
+        //   data callback spins for a fixed number of iterations per byte
+        //   read, and migrate them all to the same thread.  Write to every
+        //   channel continuously for 3 seconds, first with load balancing
+        //   disabled, then with a threshold of 10 percent, and report the
+        //   throughput, and the number of threads handling the channels at
+        //   the end of the run.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BENCHMARK: LOAD BALANCING" << endl
+                          << "=========================" << endl;
+
+        using namespace TEST_CASE_MIGRATE_CHANNEL;
+
+        typedef btlso::StreamSocket<btlso::IPv4Address> Socket;
+
+        enum {
+            k_NUM_THREADS  = 4,
+            k_NUM_CHANNELS = 8,
+            k_SPIN_COUNT   = 100,
+            k_CHUNK_SIZE   = 1024
+        };
+
+        const double DURATION = 3.0;
+
+        btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+        btlmt::ChannelPoolConfiguration config;
+        config.setMaxThreads(k_NUM_THREADS);
+        config.setMetricsInterval(0.1);
+        config.setCollectTimeMetrics(true);
+
+        Obj::PoolStateChangeCallback poolCb;
+        makeNull(&poolCb);
+
+        const int THRESHOLDS[] = { 0, 10 };
+        for (int ti = 0; ti < 2; ++ti) {
+            const int THRESHOLD = THRESHOLDS[ti];
+
+            DataReceiver               receiver(k_SPIN_COUNT);
+            Obj::BlobBasedReadCallback dataCb(bdlf::MemFnUtil::memFn(
+                                                         &DataReceiver::dataCb,
+                                                         &receiver));
+
+            ChannelPoolStateCbTester tester(config, dataCb, poolCb);
+
+            Obj& mX = tester.pool();  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+
+            Socket           *clients[k_NUM_CHANNELS];
+            bsl::vector<int>  channelIds;
+            for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+                channelIds.push_back(importChannel(&clients[i],
+                                                   &tester,
+                                                   &factory));
+                ASSERT(0 <= channelIds[i]);
+                mX.migrateChannel(channelIds[i], 0);
+            }
+            ASSERT(0 == waitForSameThread(X,
+                                          channelIds,
+                                          true,
+                                          TimeInterval(5)));
+
+            mX.setLoadBalancingThreshold(THRESHOLD);
+
+            bsls::AtomicBool          done(false);
+            bslmt::ThreadUtil::Handle senders[k_NUM_CHANNELS];
+            for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+                Sender sender = { clients[i], &done, k_CHUNK_SIZE };
+                ASSERT(0 == bslmt::ThreadUtil::create(&senders[i], sender));
+            }
+
+            bslmt::ThreadUtil::sleep(TimeInterval(DURATION));
+
+            bsls::Types::Int64 numBytes = 0;
+            for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+                numBytes += receiver.data(channelIds[i]).size();
+            }
+
+            bsl::vector<Obj::HandleInfo> handles;
+            X.getHandleStatistics(&handles);
+
+            int numThreadsUsed = 0;
+            for (bsl::size_t i = 0; i < handles.size(); ++i) {
+                bool isNew = true;
+                for (bsl::size_t j = 0; j < i; ++j) {
+                    isNew = isNew && !bslmt::ThreadUtil::isEqual(
+                                                    handles[i].d_threadHandle,
+                                                    handles[j].d_threadHandle);
+                }
+                numThreadsUsed += isNew;
+            }
+
+            cout << "threshold = "  << THRESHOLD
+                 << ", MB/s = "     << numBytes / DURATION / (1024 * 1024)
+                 << ", threads = "  << numThreadsUsed << endl;
+
+            done = true;
+            for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(senders[i]));
+            }
+
+            ASSERT(0 == mX.stopAndRemoveAllChannels());
+            for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+                factory.deallocate(clients[i]);
+            }
+        }
+}
+
+static void negativeCase5()
+{
+        // --------------------------------------------------------------------
+        // BENCHMARK: BULK TRANSFER WITH ZERO-COPY TRANSMISSION
+        //
+        // Plan:
+        //   Import a channel into a channel pool, and write blobs of a given
+        //   size, made of 64KB buffers, to the channel continuously for 2
+        //   seconds while a thread reads them from the peer socket over the
+        //   loopback interface.  Report the throughput with zero-copy
+        //   transmission disabled, then with a threshold of 16KB, for blobs
+        //   of 64KB, 1MB and 8MB.  Note that the kernel copies the data
+        //   anyway over the loopback interface, so this benchmark measures
+        //   the overhead of zero-copy transmission rather than its benefit,
+        //   which shows only with a physical network interface.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BENCHMARK: BULK TRANSFER" << endl
+                          << "========================" << endl;
+
+        using namespace TEST_CASE_ZERO_COPY;
+        using namespace TEST_CASE_MIGRATE_CHANNEL;
+
+        typedef btlso::StreamSocket<btlso::IPv4Address> Socket;
+
+        enum { k_BUFFER_SIZE = 64 * 1024 };
+
+        const double DURATION     = 2.0;
+        const int    BLOB_SIZES[] = { 64 * 1024, 1024 * 1024, 8192 * 1024 };
+        const int    THRESHOLDS[] = { 0, 16 * 1024 };
+
+        btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+        cout << "blob size\tthreshold\tMB/s" << endl;
+
+        for (int si = 0; si < 3; ++si) {
+            for (int ti = 0; ti < 2; ++ti) {
+                const int BLOB_SIZE = BLOB_SIZES[si];
+                const int THRESHOLD = THRESHOLDS[ti];
+
+                btlmt::ChannelPoolConfiguration config;
+                config.setMaxThreads(1);
+                config.setCollectTimeMetrics(false);
+                config.setZeroCopyThreshold(THRESHOLD);
+                config.setWriteQueueWatermarks(0, 4 * BLOB_SIZE);
+
+                ChannelPoolStateCbTester tester(config);
+
+                Obj& mX = tester.pool();
+                ASSERT(0 == mX.start());
+
+                Socket    *client    = 0;
+                const int  channelId = importChannel(&client,
+                                                     &tester,
+                                                     &factory);
+                ASSERT(0 <= channelId);
+
+                btlb::Blob  blob;
+                bsl::string data;
+                loadMessage(&blob,
+                            &data,
+                            BLOB_SIZE / k_BUFFER_SIZE,
+                            k_BUFFER_SIZE,
+                            0,
+                            bslma::Default::allocator());
+
+                bsls::AtomicInt64         numBytes(0);
+                bslmt::ThreadUtil::Handle reader;
+                Reader                    functor = { client, &numBytes };
+                ASSERT(0 == bslmt::ThreadUtil::create(&reader, functor));
+
+                bsls::Stopwatch timer;
+                timer.start();
+                while (timer.elapsedTime() < DURATION) {
+                    if (0 != mX.write(channelId, blob)) {
+                        // The write queue is full.
+
+                        bslmt::ThreadUtil::yield();
+                    }
+                }
+                const bsls::Types::Int64 total = numBytes;
+                timer.stop();
+
+                cout << BLOB_SIZE << "\t\t" << THRESHOLD << "\t\t"
+                     << total / timer.elapsedTime() / (1024 * 1024) << endl;
+
+                ASSERT(0 == mX.stopAndRemoveAllChannels());
+                ASSERT(0 == bslmt::ThreadUtil::join(reader));
+                factory.deallocate(client);
+            }
+        }
+}
+
+static void negativeCase6()
+{
+        // --------------------------------------------------------------------
+        // BENCHMARK: SMALL-MESSAGE FAN-IN WITH COALESCED READS
+        //
+        // Plan:
+        //   Import 256 channels into a channel pool having a single thread,
+        //   and have a thread write, in rounds, a burst of 64-byte messages
+        //   to the peer socket of each channel, for 2 seconds.  Report the
+        //   rate at which data is received, and the number of reads and data
+        //   callbacks per channel, without and with coalesced reads.
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BENCHMARK: SMALL-MESSAGE FAN-IN" << endl
+                          << "===============================" << endl;
+
+        using namespace TEST_CASE_COALESCE_READS;
+        using namespace TEST_CASE_MIGRATE_CHANNEL;
+
+        typedef btlso::StreamSocket<btlso::IPv4Address> Socket;
+
+        enum {
+            k_NUM_CHANNELS = 256,
+            k_MESSAGE_SIZE = 64,
+            k_BURST_SIZE   = 16
+        };
+
+        const double DURATION = 2.0;
+
+        btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+        Obj::PoolStateChangeCallback poolCb;
+        makeNull(&poolCb);
+
+        bsl::string message;
+        makePattern(&message, k_MESSAGE_SIZE, 0);
+
+        cout << "coalesce\tMB/s\treads\tcallbacks" << endl;
+
+        for (int coalesce = 0; coalesce < 2; ++coalesce) {
+            btlmt::ChannelPoolConfiguration config;
+            config.setMaxThreads(1);
+            config.setCollectTimeMetrics(false);
+            config.setReadTimeout(0);
+            config.setCoalesceReads(coalesce);
+
+            ByteCounter                counter;
+            Obj::BlobBasedReadCallback dataCb(bdlf::MemFnUtil::memFn(
+                                                          &ByteCounter::dataCb,
+                                                          &counter));
+
+            ChannelPoolStateCbTester tester(config, dataCb, poolCb);
+
+            Obj& mX = tester.pool();  const Obj& X = mX;
+            ASSERT(0 == mX.start());
+
+            bsl::vector<Socket *> clients(k_NUM_CHANNELS);
+            bsl::vector<int>      channelIds(k_NUM_CHANNELS);
+            for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+                channelIds[i] = importChannel(&clients[i], &tester, &factory);
+                LOOP_ASSERT(i, 0 <= channelIds[i]);
+            }
+
+            bsls::Types::Int64 numBytesWritten = 0;
+            bsls::Stopwatch    timer;
+            timer.start();
+            while (timer.elapsedTime() < DURATION) {
+                for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+                    for (int j = 0; j < k_BURST_SIZE; ++j) {
+                        numBytesWritten += clients[i]->write(message.data(),
+                                                             k_MESSAGE_SIZE);
+                    }
+                }
+            }
+            while (counter.d_numBytes < numBytesWritten) {
+                bslmt::ThreadUtil::yield();
+            }
+            timer.stop();
+
+            bsls::Types::Int64 totalReads     = 0;
+            bsls::Types::Int64 totalCallbacks = 0;
+            for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+                bsls::Types::Int64 numReads, numReadCallbacks;
+                int                averageReadSize;
+                ASSERT(0 == X.getChannelReadStatistics(&numReads,
+                                                       &numReadCallbacks,
+                                                       &averageReadSize,
+                                                       channelIds[i]));
+                totalReads     += numReads;
+                totalCallbacks += numReadCallbacks;
+            }
+
+            cout << coalesce << "\t\t"
+                 << numBytesWritten / timer.elapsedTime() / (1024 * 1024)
+                 << "\t" << totalReads / k_NUM_CHANNELS
+                 << "\t" << totalCallbacks / k_NUM_CHANNELS << endl;
+
+            ASSERT(0 == mX.stopAndRemoveAllChannels());
+            for (int i = 0; i < k_NUM_CHANNELS; ++i) {
+                factory.deallocate(clients[i]);
+            }
+        }
+}
+
 //=============================================================================
 //                              MAIN PROGRAM
 //-----------------------------------------------------------------------------
@@ -16703,6 +18107,10 @@ int main(int argc, char **argv)
 
     switch (test) { case 0:  // Zero is always the leading case.
 #define CASE(NUMBER) case NUMBER: TestDriver::testCase##NUMBER(); break
+      CASE(46);
+      CASE(45);
+      CASE(44);
+      CASE(43);
       CASE(42);
       CASE(41);
       CASE(40);
@@ -16754,6 +18162,15 @@ int main(int argc, char **argv)
       case -3: {
         negativeCase3();
       } break;
+      case -4: {
+        negativeCase4();
+      } break;
+      case -5: {
+        negativeCase5();
+      } break;
+      case -6: {
+        negativeCase6();
+      } break;
 #undef CASE
       default: {
         cerr << "WARNING: CASE " << test << " NOT FOUND." << endl;
@@ -128,6 +128,34 @@ const bdlat_AttributeInfo
         sizeof("CollectTimeMetrics") - 1,      // name length
         "",// annotation
         bdlat_FormattingMode::e_DEFAULT
+    },
+    {
+        e_ATTRIBUTE_ID_EDGE_TRIGGERED,
+        "EdgeTriggered",                       // name
+        sizeof("EdgeTriggered") - 1,           // name length
+        "",// annotation
+        bdlat_FormattingMode::e_DEFAULT
+    },
+    {
+        e_ATTRIBUTE_ID_ZERO_COPY_THRESHOLD,
+        "ZeroCopyThreshold",                   // name
+        sizeof("ZeroCopyThreshold") - 1,       // name length
+        "",// annotation
+        bdlat_FormattingMode::e_DEFAULT
+    },
+    {
+        e_ATTRIBUTE_ID_COALESCE_READS,
+        "CoalesceReads",                       // name
+        sizeof("CoalesceReads") - 1,           // name length
+        "",// annotation
+        bdlat_FormattingMode::e_DEFAULT
+    },
+    {
+        e_ATTRIBUTE_ID_THREAD_CACHED_BUFFERS,
+        "ThreadCachedBuffers",                 // name
+        sizeof("ThreadCachedBuffers") - 1,     // name length
+        "",// annotation
+        bdlat_FormattingMode::e_DEFAULT
     }
 };
 
@@ -170,6 +198,46 @@ const bdlat_AttributeInfo *ChannelPoolConfiguration::lookupAttributeInfo(
                                                                       // RETURN
         }
       } break;
+      case 13: {
+        switch(bsl::toupper(name[0])) {
+          case 'C': {
+            if (bsl::toupper(name[1])=='O'
+             && bsl::toupper(name[2])=='A'
+             && bsl::toupper(name[3])=='L'
+             && bsl::toupper(name[4])=='E'
+             && bsl::toupper(name[5])=='S'
+             && bsl::toupper(name[6])=='C'
+             && bsl::toupper(name[7])=='E'
+             && bsl::toupper(name[8])=='R'
+             && bsl::toupper(name[9])=='E'
+             && bsl::toupper(name[10])=='A'
+             && bsl::toupper(name[11])=='D'
+             && bsl::toupper(name[12])=='S') {
+                return
+                      &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COALESCE_READS];
+                                                                      // RETURN
+            }
+          } break;
+          case 'E': {
+            if (bsl::toupper(name[1])=='D'
+             && bsl::toupper(name[2])=='G'
+             && bsl::toupper(name[3])=='E'
+             && bsl::toupper(name[4])=='T'
+             && bsl::toupper(name[5])=='R'
+             && bsl::toupper(name[6])=='I'
+             && bsl::toupper(name[7])=='G'
+             && bsl::toupper(name[8])=='G'
+             && bsl::toupper(name[9])=='E'
+             && bsl::toupper(name[10])=='R'
+             && bsl::toupper(name[11])=='E'
+             && bsl::toupper(name[12])=='D') {
+                return
+                      &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_EDGE_TRIGGERED];
+                                                                      // RETURN
+            }
+          } break;
+        }
+      } break;
       case 14: {
         if (bsl::toupper(name[0])=='M'
          && bsl::toupper(name[1])=='A'
@@ -455,6 +523,28 @@ const bdlat_AttributeInfo *ChannelPoolConfiguration::lookupAttributeInfo(
                                                                       // RETURN
             }
           } break;
+          case 'Z': {
+            if (bsl::toupper(name[1])=='E'
+             && bsl::toupper(name[2])=='R'
+             && bsl::toupper(name[3])=='O'
+             && bsl::toupper(name[4])=='C'
+             && bsl::toupper(name[5])=='O'
+             && bsl::toupper(name[6])=='P'
+             && bsl::toupper(name[7])=='Y'
+             && bsl::toupper(name[8])=='T'
+             && bsl::toupper(name[9])=='H'
+             && bsl::toupper(name[10])=='R'
+             && bsl::toupper(name[11])=='E'
+             && bsl::toupper(name[12])=='S'
+             && bsl::toupper(name[13])=='H'
+             && bsl::toupper(name[14])=='O'
+             && bsl::toupper(name[15])=='L'
+             && bsl::toupper(name[16])=='D') {
+                return
+                 &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_ZERO_COPY_THRESHOLD];
+                                                                      // RETURN
+            }
+          } break;
         }
       } break;
       case 18: {
@@ -481,6 +571,31 @@ const bdlat_AttributeInfo *ChannelPoolConfiguration::lookupAttributeInfo(
                                                                       // RETURN
         }
       } break;
+      case 19: {
+        if (bsl::toupper(name[0])=='T'
+         && bsl::toupper(name[1])=='H'
+         && bsl::toupper(name[2])=='R'
+         && bsl::toupper(name[3])=='E'
+         && bsl::toupper(name[4])=='A'
+         && bsl::toupper(name[5])=='D'
+         && bsl::toupper(name[6])=='C'
+         && bsl::toupper(name[7])=='A'
+         && bsl::toupper(name[8])=='C'
+         && bsl::toupper(name[9])=='H'
+         && bsl::toupper(name[10])=='E'
+         && bsl::toupper(name[11])=='D'
+         && bsl::toupper(name[12])=='B'
+         && bsl::toupper(name[13])=='U'
+         && bsl::toupper(name[14])=='F'
+         && bsl::toupper(name[15])=='F'
+         && bsl::toupper(name[16])=='E'
+         && bsl::toupper(name[17])=='R'
+         && bsl::toupper(name[18])=='S') {
+            return &ATTRIBUTE_INFO_ARRAY[
+                                      e_ATTRIBUTE_INDEX_THREAD_CACHED_BUFFERS];
+                                                                      // RETURN
+        }
+      } break;
     }
     return 0;
 }
@@ -543,6 +658,22 @@ ChannelPoolConfiguration::lookupAttributeInfo(int id)
         return &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS];
                                                                       // RETURN
       }
+      case e_ATTRIBUTE_ID_EDGE_TRIGGERED: {
+        return &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_EDGE_TRIGGERED];
+                                                                      // RETURN
+      }
+      case e_ATTRIBUTE_ID_ZERO_COPY_THRESHOLD: {
+        return &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_ZERO_COPY_THRESHOLD];
+                                                                      // RETURN
+      }
+      case e_ATTRIBUTE_ID_COALESCE_READS: {
+        return &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COALESCE_READS];
+                                                                      // RETURN
+      }
+      case e_ATTRIBUTE_ID_THREAD_CACHED_BUFFERS: {
+        return &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_THREAD_CACHED_BUFFERS];
+                                                                      // RETURN
+      }
 
       default:
         return 0;                                                     // RETURN
@@ -565,6 +696,10 @@ ChannelPoolConfiguration::ChannelPoolConfiguration()
 , d_maxMessageSizeIn(1024)
 , d_threadStackSize(k_DEFAULT_THREAD_STACK_SIZE)
 , d_collectTimeMetrics(true)
+, d_edgeTriggered(false)
+, d_zeroCopyThreshold(0)
+, d_coalesceReads(false)
+, d_threadCachedBuffers(false)
 {
 }
 
@@ -584,6 +719,10 @@ ChannelPoolConfiguration::ChannelPoolConfiguration(
 , d_maxMessageSizeIn(original.d_maxMessageSizeIn)
 , d_threadStackSize(original.d_threadStackSize)
 , d_collectTimeMetrics(original.d_collectTimeMetrics)
+, d_edgeTriggered(original.d_edgeTriggered)
+, d_zeroCopyThreshold(original.d_zeroCopyThreshold)
+, d_coalesceReads(original.d_coalesceReads)
+, d_threadCachedBuffers(original.d_threadCachedBuffers)
 {
 }
 
@@ -623,6 +762,10 @@ ChannelPoolConfiguration::operator=(const ChannelPoolConfiguration& rhs)
         d_maxMessageSizeIn   = rhs.d_maxMessageSizeIn;
         d_threadStackSize    = rhs.d_threadStackSize;
         d_collectTimeMetrics = rhs.d_collectTimeMetrics;
+        d_edgeTriggered      = rhs.d_edgeTriggered;
+        d_zeroCopyThreshold  = rhs.d_zeroCopyThreshold;
+        d_coalesceReads      = rhs.d_coalesceReads;
+        d_threadCachedBuffers = rhs.d_threadCachedBuffers;
     }
     return *this;
 }
@@ -646,7 +789,11 @@ bool btlmt::operator==(const ChannelPoolConfiguration& lhs,
         && lhs.d_typMessageSizeIn   == rhs.d_typMessageSizeIn
         && lhs.d_maxMessageSizeIn   == rhs.d_maxMessageSizeIn
         && lhs.d_threadStackSize    == rhs.d_threadStackSize
-        && lhs.d_collectTimeMetrics == rhs.d_collectTimeMetrics;
+        && lhs.d_collectTimeMetrics == rhs.d_collectTimeMetrics
+        && lhs.d_edgeTriggered      == rhs.d_edgeTriggered
+        && lhs.d_zeroCopyThreshold  == rhs.d_zeroCopyThreshold
+        && lhs.d_coalesceReads      == rhs.d_coalesceReads
+        && lhs.d_threadCachedBuffers == rhs.d_threadCachedBuffers;
 }
 
 bsl::ostream& btlmt::operator<<(bsl::ostream&                   output,
@@ -669,7 +816,14 @@ bsl::ostream& btlmt::operator<<(bsl::ostream&                   output,
            << "\tmaxIncomingMessageSize : " << config.d_maxMessageSizeIn <<"\n"
            << "\tthreadStackSize        : " << config.d_threadStackSize  <<"\n"
            << "\tcollectTimeMetrics     : " << config.d_collectTimeMetrics
-           << "\n]\n";
+                                                                       <<"\n"
+           << "\tedgeTriggered          : " << config.d_edgeTriggered  <<"\n"
+           << "\tzeroCopyThreshold      : " << config.d_zeroCopyThreshold
+                                                                       <<"\n"
+           << "\tcoalesceReads          : " << config.d_coalesceReads  <<"\n"
+           << "\tthreadCachedBuffers    : " << config.d_threadCachedBuffers
+                                                                       <<"\n"
+           << "]\n";
 
     return output;
 }
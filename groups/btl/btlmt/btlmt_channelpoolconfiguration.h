@@ -85,6 +85,37 @@ BSLS_IDENT("$Id: $")
 //                               processing data, and if this value
 //                               is 'false', those metrics will not
 //                               be collected.
+//
+//   bool    edgeTriggered       indicates whether the configured         false
+//                               channel pool will monitor the
+//                               sockets of its channels for
+//                               incoming and outgoing data using
+//                               edge-triggered notifications, where
+//                               available.
+//
+//   int     zeroCopyThreshold   the minimum number of bytes in a             0
+//                               single write for the configured
+//                               channel pool to transmit the data
+//                               of its channels without copying
+//                               it, where available; if this value
+//                               is 0, zero-copy transmission is
+//                               disabled.
+//
+//   bool    coalesceReads       indicates whether the configured         false
+//                               channel pool will drain the
+//                               sockets of its channels before
+//                               invoking the data callback once
+//                               per drain, adapting the size of
+//                               each read to the observed data
+//                               rate.
+//
+//   bool    threadCachedBuffers indicates whether the configured         false
+//                               channel pool will allocate the
+//                               blob buffers of its channels from
+//                               per-thread caches (see
+//                               'btlb_cachingblobbufferfactory')
+//                               rather than from a single shared
+//                               pool.
 //..
 // The constraints are as follows:
 //..
@@ -111,6 +142,8 @@ BSLS_IDENT("$Id: $")
 //   +--------------------+---------------------------------------------+
 //   | threadStackSize    | 0 <= threadStackSize                        |
 //   +--------------------+---------------------------------------------+
+//   | zeroCopyThreshold  | 0 <= zeroCopyThreshold                      |
+//   +--------------------+---------------------------------------------+
 //..
 //
 ///Thread Safety
@@ -199,6 +232,10 @@ BSLS_IDENT("$Id: $")
 //         maxIncomingMessageSize : 3
 //         threadStackSize        : 1024
 //         collectTimeMetrics     : 1
+//         edgeTriggered          : 0
+//         zeroCopyThreshold      : 0
+//         coalesceReads          : 0
+//         threadCachedBuffers    : 0
 // ]
 //..
 
@@ -308,6 +345,19 @@ class ChannelPoolConfiguration {
 
     bool                  d_collectTimeMetrics;
 
+    bool                  d_edgeTriggered;     // use edge-triggered socket
+                                               // event notifications
+
+    int                   d_zeroCopyThreshold; // minimum size of zero-copy
+                                               // writes, or 0 if disabled
+
+    bool                  d_coalesceReads;     // drain sockets before
+                                               // invoking data callbacks
+
+    bool                  d_threadCachedBuffers;
+                                               // allocate blob buffers from
+                                               // per-thread caches
+
     friend bsl::ostream& operator<<(bsl::ostream&,
                                     const ChannelPoolConfiguration&);
 
@@ -317,7 +367,7 @@ class ChannelPoolConfiguration {
   public:
     // TYPES
     enum {
-        k_NUM_ATTRIBUTES = 14 // the number of attributes in this class
+        k_NUM_ATTRIBUTES = 18 // the number of attributes in this class
 
 
     };
@@ -362,9 +412,21 @@ class ChannelPoolConfiguration {
         e_ATTRIBUTE_INDEX_THREAD_STACK_SIZE    = 12,
             // index for 'ThreadStackSize' attribute
 
-        e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS = 13
+        e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS = 13,
             // index for 'CollectTimeMetrics' attribute
 
+        e_ATTRIBUTE_INDEX_EDGE_TRIGGERED       = 14,
+            // index for 'EdgeTriggered' attribute
+
+        e_ATTRIBUTE_INDEX_ZERO_COPY_THRESHOLD  = 15,
+            // index for 'ZeroCopyThreshold' attribute
+
+        e_ATTRIBUTE_INDEX_COALESCE_READS       = 16,
+            // index for 'CoalesceReads' attribute
+
+        e_ATTRIBUTE_INDEX_THREAD_CACHED_BUFFERS = 17
+            // index for 'ThreadCachedBuffers' attribute
+
 
     };
 
@@ -408,9 +470,21 @@ class ChannelPoolConfiguration {
         e_ATTRIBUTE_ID_THREAD_STACK_SIZE       = 13,
             // id for 'ThreadStackSize' attribute
 
-        e_ATTRIBUTE_ID_COLLECT_TIME_METRICS    = 14
+        e_ATTRIBUTE_ID_COLLECT_TIME_METRICS    = 14,
             // id for 'CollectTimeMetrics' attribute
 
+        e_ATTRIBUTE_ID_EDGE_TRIGGERED          = 15,
+            // id for 'EdgeTriggered' attribute
+
+        e_ATTRIBUTE_ID_ZERO_COPY_THRESHOLD     = 16,
+            // id for 'ZeroCopyThreshold' attribute
+
+        e_ATTRIBUTE_ID_COALESCE_READS          = 17,
+            // id for 'CoalesceReads' attribute
+
+        e_ATTRIBUTE_ID_THREAD_CACHED_BUFFERS   = 18
+            // id for 'ThreadCachedBuffers' attribute
+
 
     };
 
@@ -516,6 +590,53 @@ class ChannelPoolConfiguration {
         // estimate of work-load when it attempts to distribute work amongst
         // its managed threads.
 
+    int setEdgeTriggered(bool edgeTriggeredFlag);
+        // Set to the specified 'edgeTriggeredFlag' whether the configured
+        // channel pool will monitor the sockets of its channels using
+        // edge-triggered notifications.  Return 0.  Note that edge-triggered
+        // notifications are supported only on Linux (see
+        // 'btlso_defaulteventmanager_epolledge'); on other platforms this
+        // value is ignored.
+
+    int setZeroCopyThreshold(int numBytes);
+        // Set the zero-copy threshold attribute of this object to the
+        // specified 'numBytes' if '0 <= numBytes'.  Return 0 on success, and
+        // a non-zero value (with no effect on the state of this object)
+        // otherwise.  If 'numBytes' is positive, the configured channel pool
+        // transmits the data of a write of at least 'numBytes' bytes without
+        // copying it, where supported, retaining the blob buffers holding that
+        // data until the kernel reports their transmission; if 'numBytes' is
+        // 0, zero-copy transmission is disabled.  Note that zero-copy
+        // transmission is supported only on Linux (see 'btlso_zerocopyutil'),
+        // and only for the channels whose sockets are plain TCP sockets; on
+        // other platforms or sockets this value is ignored.
+
+    int setCoalesceReads(bool coalesceReadsFlag);
+        // Set to the specified 'coalesceReadsFlag' whether the configured
+        // channel pool will read from the socket of a channel until no more
+        // data is available before invoking the data callback of that channel
+        // (once for all the data read), and will adapt the number of buffers
+        // supplied to each read to the amount of data observed per drain.
+        // Return 0.  Note that coalescing reads reduces the number of data
+        // callbacks (and of system calls per byte) when many small messages
+        // arrive on many channels, at the cost of a higher latency for the
+        // first message of each drain.
+
+    int setThreadCachedBuffers(bool threadCachedBuffersFlag);
+        // Set to the specified 'threadCachedBuffersFlag' whether the
+        // configured channel pool will allocate the blob buffers used to read
+        // and write the data of its channels from a
+        // 'btlb::CachingBlobBufferFactory', caching free buffers in each
+        // thread, rather than from a 'btlb::PooledBlobBufferFactory' shared by
+        // all threads.  Return 0.  Note that thread caching avoids contention
+        // between the threads allocating and releasing buffers, at the cost of
+        // a number of free buffers retained by each such thread.  Also note
+        // that this value is ignored if a blob buffer factory is supplied to
+        // the channel pool at construction.  Also note that each such
+        // channel pool holds two thread-specific storage keys, and that its
+        // factories fall back to not caching buffers per thread if no key is
+        // available (see 'btlb_cachingblobbufferfactory').
+
     template<class MANIPULATOR>
     int manipulateAttributes(MANIPULATOR& manipulator);
         // Invoke the specified 'manipulator' sequentially on the address of
@@ -578,6 +699,26 @@ class ChannelPoolConfiguration {
         // pool cannot use that estimate of work-load when it attempts to
         // distribute work amongst its managed threads.
 
+    bool edgeTriggered() const;
+        // Return 'true' if the configured channel pool will monitor the
+        // sockets of its channels using edge-triggered notifications, where
+        // available, and 'false' otherwise.
+
+    int zeroCopyThreshold() const;
+        // Return the zero-copy threshold attribute of this object, i.e., the
+        // minimum number of bytes in a single write for the configured channel
+        // pool to transmit data without copying it, or 0 if zero-copy
+        // transmission is disabled.
+
+    bool coalesceReads() const;
+        // Return 'true' if the configured channel pool will drain the socket
+        // of a channel before invoking the data callback of that channel, and
+        // 'false' otherwise.
+
+    bool threadCachedBuffers() const;
+        // Return 'true' if the configured channel pool will allocate blob
+        // buffers from per-thread caches, and 'false' otherwise.
+
     const double& metricsInterval() const;
         // Return the metrics interval attribute of this object.
 
@@ -755,6 +896,38 @@ int ChannelPoolConfiguration::setCollectTimeMetrics(
     return 0;
 }
 
+inline
+int ChannelPoolConfiguration::setEdgeTriggered(bool edgeTriggeredFlag)
+{
+    d_edgeTriggered = edgeTriggeredFlag;
+    return 0;
+}
+
+inline
+int ChannelPoolConfiguration::setZeroCopyThreshold(int numBytes)
+{
+    if (0 <= numBytes) {
+        d_zeroCopyThreshold = numBytes;
+        return 0;                                                     // RETURN
+    }
+    return 1;
+}
+
+inline
+int ChannelPoolConfiguration::setCoalesceReads(bool coalesceReadsFlag)
+{
+    d_coalesceReads = coalesceReadsFlag;
+    return 0;
+}
+
+inline
+int ChannelPoolConfiguration::setThreadCachedBuffers(
+                                                  bool threadCachedBuffersFlag)
+{
+    d_threadCachedBuffers = threadCachedBuffersFlag;
+    return 0;
+}
+
 template <class MANIPULATOR>
 int ChannelPoolConfiguration::manipulateAttributes(MANIPULATOR& manipulator)
 {
@@ -855,6 +1028,32 @@ int ChannelPoolConfiguration::manipulateAttributes(MANIPULATOR& manipulator)
         return ret;                                                   // RETURN
     }
 
+    ret = manipulator(&d_edgeTriggered,
+                      ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_EDGE_TRIGGERED]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = manipulator(
+                  &d_zeroCopyThreshold,
+                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_ZERO_COPY_THRESHOLD]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = manipulator(&d_coalesceReads,
+                      ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COALESCE_READS]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = manipulator(
+                &d_threadCachedBuffers,
+                ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_THREAD_CACHED_BUFFERS]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
     return ret;
 }
 
@@ -949,6 +1148,30 @@ int ChannelPoolConfiguration::manipulateAttribute(MANIPULATOR& manipulator,
                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS]);
                                                                       // RETURN
       } break;
+      case e_ATTRIBUTE_ID_EDGE_TRIGGERED: {
+        return manipulator(
+                       &d_edgeTriggered,
+                       ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_EDGE_TRIGGERED]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_ZERO_COPY_THRESHOLD: {
+        return manipulator(
+                  &d_zeroCopyThreshold,
+                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_ZERO_COPY_THRESHOLD]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_COALESCE_READS: {
+        return manipulator(
+                       &d_coalesceReads,
+                       ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COALESCE_READS]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_THREAD_CACHED_BUFFERS: {
+        return manipulator(
+                &d_threadCachedBuffers,
+                ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_THREAD_CACHED_BUFFERS]);
+                                                                      // RETURN
+      } break;
 
       default:
         return k_NOT_FOUND;                                           // RETURN
@@ -1059,6 +1282,26 @@ bool ChannelPoolConfiguration::collectTimeMetrics() const {
     return d_collectTimeMetrics;
 }
 
+inline
+bool ChannelPoolConfiguration::edgeTriggered() const {
+    return d_edgeTriggered;
+}
+
+inline
+int ChannelPoolConfiguration::zeroCopyThreshold() const {
+    return d_zeroCopyThreshold;
+}
+
+inline
+bool ChannelPoolConfiguration::coalesceReads() const {
+    return d_coalesceReads;
+}
+
+inline
+bool ChannelPoolConfiguration::threadCachedBuffers() const {
+    return d_threadCachedBuffers;
+}
+
 template <class ACCESSOR>
 int ChannelPoolConfiguration::accessAttributes(ACCESSOR& accessor) const
 {
@@ -1157,6 +1400,32 @@ int ChannelPoolConfiguration::accessAttributes(ACCESSOR& accessor) const
         return ret;                                                   // RETURN
     }
 
+    ret = accessor(d_edgeTriggered,
+                   ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_EDGE_TRIGGERED]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = accessor(
+                  d_zeroCopyThreshold,
+                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_ZERO_COPY_THRESHOLD]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = accessor(d_coalesceReads,
+                   ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COALESCE_READS]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = accessor(
+                d_threadCachedBuffers,
+                ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_THREAD_CACHED_BUFFERS]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
     return ret;
 }
 
@@ -1249,6 +1518,30 @@ ChannelPoolConfiguration::accessAttribute(ACCESSOR& accessor, int id) const
                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS]);
                                                                       // RETURN
       } break;
+      case e_ATTRIBUTE_ID_EDGE_TRIGGERED: {
+        return accessor(
+                       d_edgeTriggered,
+                       ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_EDGE_TRIGGERED]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_ZERO_COPY_THRESHOLD: {
+        return accessor(
+                  d_zeroCopyThreshold,
+                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_ZERO_COPY_THRESHOLD]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_COALESCE_READS: {
+        return accessor(
+                       d_coalesceReads,
+                       ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COALESCE_READS]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_THREAD_CACHED_BUFFERS: {
+        return accessor(
+                d_threadCachedBuffers,
+                ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_THREAD_CACHED_BUFFERS]);
+                                                                      // RETURN
+      } break;
 
       default:
         return k_NOT_FOUND;                                           // RETURN
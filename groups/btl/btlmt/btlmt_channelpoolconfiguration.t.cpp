@@ -41,6 +41,10 @@ using namespace bsl;  // automatically added by script
 // [ 2] int setMaxThreads(int maxThreads);
 // [ 2] int setMetricsInterval(double metricsInterval);
 // [ 2] int setReadTimeout(double readTimeout);
+// [ 1] int setEdgeTriggered(bool edgeTriggeredFlag);
+// [ 2] int setZeroCopyThreshold(int numBytes);
+// [ 1] int setCoalesceReads(bool coalesceReadsFlag);
+// [ 1] int setThreadCachedBuffers(bool threadCachedBuffersFlag);
 // [ 1] int minIncomingMessageSize() const;
 // [ 1] int typicalIncomingMessageSize() const;
 // [ 1] int maxIncomingMessageSize() const;
@@ -51,6 +55,10 @@ using namespace bsl;  // automatically added by script
 // [ 1] int maxThreads() const;
 // [ 1] double metricsInterval() const;
 // [ 1] double readTimeout() const;
+// [ 1] bool edgeTriggered() const;
+// [ 1] int zeroCopyThreshold() const;
+// [ 1] bool coalesceReads() const;
+// [ 1] bool threadCachedBuffers() const;
 //
 // [ 1] bool operator==(const btlmt::ChannelPoolConfiguration& lhs, ...
 // [ 1] bool operator!=(const btlmt::ChannelPoolConfiguration& lhs, ...
@@ -348,6 +356,10 @@ int main(int argc, char *argv[])
                 "\tmaxIncomingMessageSize : 3" NL
                 "\tthreadStackSize        : 1024" NL
                 "\tcollectTimeMetrics     : 1" NL
+                "\tedgeTriggered          : 0" NL
+                "\tzeroCopyThreshold      : 0" NL
+                "\tcoalesceReads          : 0" NL
+                "\tthreadCachedBuffers    : 0" NL
                 "]" NL
                 ;
             ASSERT(os.str().c_str() == s);
@@ -380,7 +392,7 @@ int main(int argc, char *argv[])
                           << "\n==========================" << endl;
 
         enum {
-            NUM_ATTRIBUTES = 14
+            NUM_ATTRIBUTES = 18
         };
 
         ASSERT(NUM_ATTRIBUTES == Obj::k_NUM_ATTRIBUTES);
@@ -390,7 +402,8 @@ int main(int argc, char *argv[])
         "MinMessageSizeOut", "TypMessageSizeOut", "MaxMessageSizeOut",
         "MinMessageSizeIn", "TypMessageSizeIn", "MaxMessageSizeIn",
         "WriteQueueLowWater", "WriteQueueHighWater", "ThreadStackSize",
-        "CollectTimeMetrics"
+        "CollectTimeMetrics", "EdgeTriggered", "ZeroCopyThreshold",
+        "CoalesceReads", "ThreadCachedBuffers"
         };
 
         const int NUM_NAMES = sizeof NAMES / sizeof *NAMES;
@@ -564,6 +577,38 @@ int main(int argc, char *argv[])
                                                                     visitor,
                                                                     j + 1));
                   } break;
+                  case 14: {
+                    ASSERT(0 == mA.setEdgeTriggered(!COLLECTMETRICS[i]));
+                    AssignValue<bool> visitor(!COLLECTMETRICS[i]);
+                    LOOP2_ASSERT(i, j, 0 ==
+                       bdlat_SequenceFunctions::manipulateAttribute(&mB,
+                                                                    visitor,
+                                                                    j + 1));
+                  } break;
+                  case 15: {
+                    ASSERT(0 == mA.setZeroCopyThreshold(MAXWRITEQUEUE[i]));
+                    AssignValue<int> visitor(MAXWRITEQUEUE[i]);
+                    LOOP2_ASSERT(i, j, 0 ==
+                       bdlat_SequenceFunctions::manipulateAttribute(&mB,
+                                                                    visitor,
+                                                                    j + 1));
+                  } break;
+                  case 16: {
+                    ASSERT(0 == mA.setCoalesceReads(!COLLECTMETRICS[i]));
+                    AssignValue<bool> visitor(!COLLECTMETRICS[i]);
+                    LOOP2_ASSERT(i, j, 0 ==
+                       bdlat_SequenceFunctions::manipulateAttribute(&mB,
+                                                                    visitor,
+                                                                    j + 1));
+                  } break;
+                  case 17: {
+                    ASSERT(0 == mA.setThreadCachedBuffers(!COLLECTMETRICS[i]));
+                    AssignValue<bool> visitor(!COLLECTMETRICS[i]);
+                    LOOP2_ASSERT(i, j, 0 ==
+                       bdlat_SequenceFunctions::manipulateAttribute(&mB,
+                                                                    visitor,
+                                                                    j + 1));
+                  } break;
 
                   default:
                     ASSERT(0);
@@ -582,7 +627,7 @@ int main(int argc, char *argv[])
                                                                   avisitor,
                                                                   j + 1));
                 }
-                else if (j == 13) {
+                else if (j == 13 || j == 14 || j == 16 || j == 17) {
                     bool value;
                     GetValue<bool> gvisitor(&value);
                     ASSERT(0 ==
@@ -731,6 +776,18 @@ int main(int argc, char *argv[])
             ASSERT(1 == X1.typicalOutgoingMessageSize());
             ASSERT(2 == X1.maxOutgoingMessageSize());
         }
+
+        if (verbose) cout << "\t Check zeroCopyThreshold contraint. " << endl;
+        {
+            ASSERT(0 != mX1.setZeroCopyThreshold(-1));
+            ASSERT(0 == X1.zeroCopyThreshold());
+            ASSERT(0 == mX1.setZeroCopyThreshold(65536));
+            ASSERT(65536 == X1.zeroCopyThreshold());
+            ASSERT(0 != mX1.setZeroCopyThreshold(-65536));
+            ASSERT(65536 == X1.zeroCopyThreshold());
+            ASSERT(0 == mX1.setZeroCopyThreshold(0));
+            ASSERT(0 == X1.zeroCopyThreshold());
+        }
       } break;
       case 1: {
         // --------------------------------------------------------------------
@@ -1136,6 +1193,125 @@ int main(int argc, char *argv[])
 
         // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+        if (verbose) cout << "\t Change attribute 8." << endl;
+
+        ASSERT(false == X1.edgeTriggered());
+        ASSERT(0 == mX1.setEdgeTriggered(true));
+        ASSERT(true  == X1.edgeTriggered());
+        ASSERT(   COLLECTMETRICS[0] == X1.collectTimeMetrics());
+        ASSERT(  THREADSTACKSIZE[0] == X1.threadStackSize());
+
+        ASSERT(1 == (X1 == X1));          ASSERT(0 == (X1 != X1));
+        ASSERT(0 == (X1 == Z1));          ASSERT(1 == (X1 != Z1));
+        ASSERT(0 == (Z1 == X1));          ASSERT(1 == (Z1 != X1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+        {
+            Obj C(X1);
+            ASSERT(C == X1 == 1);          ASSERT(C != X1 == 0);
+        }
+
+        mY1 = X1;
+        ASSERT(1 == (Y1 == X1));          ASSERT(0 == (Y1 != X1));
+        ASSERT(0 == (Y1 == Z1));          ASSERT(1 == (Y1 != Z1));
+
+        ASSERT(0 == mX1.setEdgeTriggered(false));
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+
+        mX1 = mY1 = Z1;
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+        if (verbose) cout << "\t Change attribute 9." << endl;
+
+        ASSERT(0 == X1.zeroCopyThreshold());
+        ASSERT(0 == mX1.setZeroCopyThreshold(16384));
+        ASSERT(16384 == X1.zeroCopyThreshold());
+        ASSERT(false == X1.edgeTriggered());
+        ASSERT(THREADSTACKSIZE[0] == X1.threadStackSize());
+
+        ASSERT(1 == (X1 == X1));          ASSERT(0 == (X1 != X1));
+        ASSERT(0 == (X1 == Z1));          ASSERT(1 == (X1 != Z1));
+        ASSERT(0 == (Z1 == X1));          ASSERT(1 == (Z1 != X1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+        {
+            Obj C(X1);
+            ASSERT(C == X1 == 1);          ASSERT(C != X1 == 0);
+        }
+
+        mY1 = X1;
+        ASSERT(1 == (Y1 == X1));          ASSERT(0 == (Y1 != X1));
+        ASSERT(0 == (Y1 == Z1));          ASSERT(1 == (Y1 != Z1));
+
+        ASSERT(0 == mX1.setZeroCopyThreshold(0));
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+
+        mX1 = mY1 = Z1;
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+        if (verbose) cout << "\t Change attribute 10." << endl;
+
+        ASSERT(false == X1.coalesceReads());
+        ASSERT(0 == mX1.setCoalesceReads(true));
+        ASSERT(true  == X1.coalesceReads());
+        ASSERT(0 == X1.zeroCopyThreshold());
+        ASSERT(false == X1.edgeTriggered());
+
+        ASSERT(1 == (X1 == X1));          ASSERT(0 == (X1 != X1));
+        ASSERT(0 == (X1 == Z1));          ASSERT(1 == (X1 != Z1));
+        ASSERT(0 == (Z1 == X1));          ASSERT(1 == (Z1 != X1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+        {
+            Obj C(X1);
+            ASSERT(C == X1 == 1);          ASSERT(C != X1 == 0);
+        }
+
+        mY1 = X1;
+        ASSERT(1 == (Y1 == X1));          ASSERT(0 == (Y1 != X1));
+        ASSERT(0 == (Y1 == Z1));          ASSERT(1 == (Y1 != Z1));
+
+        ASSERT(0 == mX1.setCoalesceReads(false));
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+
+        mX1 = mY1 = Z1;
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+        if (verbose) cout << "\t Change attribute 11." << endl;
+
+        ASSERT(false == X1.threadCachedBuffers());
+        ASSERT(0 == mX1.setThreadCachedBuffers(true));
+        ASSERT(true  == X1.threadCachedBuffers());
+        ASSERT(false == X1.coalesceReads());
+
+        ASSERT(1 == (X1 == X1));          ASSERT(0 == (X1 != X1));
+        ASSERT(0 == (X1 == Z1));          ASSERT(1 == (X1 != Z1));
+        ASSERT(0 == (Z1 == X1));          ASSERT(1 == (Z1 != X1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+        {
+            Obj C(X1);
+            ASSERT(C == X1 == 1);          ASSERT(C != X1 == 0);
+        }
+
+        mY1 = X1;
+        ASSERT(1 == (Y1 == X1));          ASSERT(0 == (Y1 != X1));
+        ASSERT(0 == (Y1 == Z1));          ASSERT(1 == (Y1 != Z1));
+
+        ASSERT(0 == mX1.setThreadCachedBuffers(false));
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+
+        mX1 = mY1 = Z1;
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
         if (verbose) cout << "Testing output operator (<<)." << endl;
 
         ASSERT(0 == mY1.setIncomingMessageSizes(MINMESSAGESIZEIN[1],
@@ -1173,6 +1349,10 @@ int main(int argc, char *argv[])
                 "\tmaxIncomingMessageSize : 1024" NL
                 "\tthreadStackSize        : 1048576" NL
                 "\tcollectTimeMetrics     : 1" NL
+                "\tedgeTriggered          : 0" NL
+                "\tzeroCopyThreshold      : 0" NL
+                "\tcoalesceReads          : 0" NL
+                "\tthreadCachedBuffers    : 0" NL
                 "]" NL
                 ;
             ASSERT(buf == s);
@@ -1198,6 +1378,10 @@ int main(int argc, char *argv[])
                 "\tmaxIncomingMessageSize : 17" NL
                 "\tthreadStackSize        : 512" NL
                 "\tcollectTimeMetrics     : 1" NL
+                "\tedgeTriggered          : 0" NL
+                "\tzeroCopyThreshold      : 0" NL
+                "\tcoalesceReads          : 0" NL
+                "\tthreadCachedBuffers    : 0" NL
                 "]" NL
                 ;
             ASSERT(buf == s);
@@ -15,6 +15,7 @@ BSLS_IDENT_RCSID(btlmt_tcptimereventmanager_cpp,"$Id$ $CSID$")
 #include <btlso_defaulteventmanager.h>
 #include <btlso_defaulteventmanager_devpoll.h>
 #include <btlso_defaulteventmanager_epoll.h>
+#include <btlso_defaulteventmanager_epolledge.h>
 #include <btlso_defaulteventmanager_poll.h>
 #include <btlso_defaulteventmanager_select.h>
 #include <btlso_eventmanager.h>
@@ -860,15 +861,29 @@ int TcpTimerEventManager_ControlChannel::open()
 int TcpTimerEventManager_ControlChannel::serverRead()
 {
     int  rc = d_numPendingRequests.swap(0);
-    char byte;
+    char buffer[64];
 
-    const int numBytes = btlso::SocketImpUtil::read(&byte, serverFd(), 1);
+    // Drain the server buffer so that, if the event manager is edge-triggered,
+    // no signal byte is left unread when the next one arrives.
+
+    int numBytes = btlso::SocketImpUtil::read(buffer,
+                                              serverFd(),
+                                              sizeof buffer);
     if (numBytes <= 0) {
         return -1;                                                    // RETURN
     }
 
-    ++d_numServerReads;
-    d_numServerBytesRead += numBytes;
+    do {
+        ++d_numServerReads;
+        d_numServerBytesRead += numBytes;
+
+        if (static_cast<int>(sizeof buffer) != numBytes) {
+            break;
+        }
+        numBytes = btlso::SocketImpUtil::read(buffer,
+                                              serverFd(),
+                                              sizeof buffer);
+    } while (0 < numBytes);
 
     return rc;
 }
@@ -940,7 +955,7 @@ void TcpTimerEventManager_ExpiredTimersManager::disableAllCallbacks()
                          // --------------------------
 
 // PRIVATE METHODS
-void TcpTimerEventManager::initialize()
+void TcpTimerEventManager::initialize(bool edgeTriggered)
 {
     BSLS_ASSERT(d_allocator_p);
 
@@ -948,7 +963,14 @@ void TcpTimerEventManager::initialize()
 
     // Initialize the (managed) event manager.
 #ifdef BSLS_PLATFORM_OS_LINUX
-    if (btlso::DefaultEventManager<>::isSupported()) {
+    typedef btlso::DefaultEventManager<btlso::Platform::EPOLL_EDGE>
+                                                              EdgeEventManager;
+
+    if (edgeTriggered && EdgeEventManager::isSupported()) {
+        d_manager_p = new (*d_allocator_p) EdgeEventManager(metrics,
+                                                            d_allocator_p);
+    }
+    else if (btlso::DefaultEventManager<>::isSupported()) {
         d_manager_p = new (*d_allocator_p)
                                    btlso::DefaultEventManager<>(metrics,
                                                                 d_allocator_p);
@@ -959,6 +981,8 @@ void TcpTimerEventManager::initialize()
                                                                 d_allocator_p);
     }
 #else
+    (void)edgeTriggered;
+
     d_manager_p = new (*d_allocator_p)
                                    btlso::DefaultEventManager<>(metrics,
                                                                 d_allocator_p);
@@ -1352,6 +1376,29 @@ TcpTimerEventManager::TcpTimerEventManager(
     initialize();
 }
 
+TcpTimerEventManager::TcpTimerEventManager(
+                                        bool               collectTimeMetrics,
+                                        bool               poolTimerMemory,
+                                        bool               edgeTriggered,
+                                        bslma::Allocator  *threadSafeAllocator)
+: d_requestPool(sizeof(TcpTimerEventManager_Request), threadSafeAllocator)
+, d_requestQueue(threadSafeAllocator)
+, d_dispatcher(bslmt::ThreadUtil::invalidHandle())
+, d_state(e_DISABLED)
+, d_terminateThread(0)
+, d_expiredTimersManager_p(0)
+, d_timerQueue(poolTimerMemory, threadSafeAllocator)
+, d_metrics(btlso::TimeMetrics::e_MIN_NUM_CATEGORIES,
+            btlso::TimeMetrics::e_IO_BOUND,
+            threadSafeAllocator)
+, d_collectMetrics(collectTimeMetrics)
+, d_numTotalSocketEvents(0)
+, d_numControlChannelReinitializations(0)
+, d_allocator_p(bslma::Default::allocator(threadSafeAllocator))
+{
+    initialize(edgeTriggered);
+}
+
 TcpTimerEventManager::TcpTimerEventManager(
                                       btlso::EventManager *rawEventManager,
                                       bslma::Allocator    *threadSafeAllocator)
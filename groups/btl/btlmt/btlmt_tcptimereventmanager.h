@@ -486,8 +486,10 @@ class TcpTimerEventManager : public btlso::TimerEventManager {
     TcpTimerEventManager& operator=(const TcpTimerEventManager&);
 
     // PRIVATE MANIPULATORS
-    void initialize();
-        // Initialize this event manager.
+    void initialize(bool edgeTriggered = false);
+        // Initialize this event manager.  Optionally specify 'edgeTriggered'
+        // indicating whether socket events should be monitored by an
+        // edge-triggered event manager where supported.
 
     void dispatchThreadEntryPoint();
         // Entry point for the dispatch thread.
@@ -529,6 +531,26 @@ class TcpTimerEventManager : public btlso::TimerEventManager {
         // the dispatcher thread is NOT started by this method (i.e., it must
         // be started explicitly).
 
+    TcpTimerEventManager(bool              collectTimeMetrics,
+                         bool              poolTimerMemory,
+                         bool              edgeTriggered,
+                         bslma::Allocator *basicAllocator = 0);
+        // Create an event manager that collects timing metrics if the
+        // specified 'collectTimeMetrics' is 'true', pools the memory used for
+        // internal timers if the specified 'poolTimerMemory' is 'true', and,
+        // if the specified 'edgeTriggered' is 'true' and the platform
+        // supports it, monitors socket events with
+        // 'btlso::DefaultEventManager<btlso::Platform::EPOLL_EDGE>'.
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless 'basicAllocator' refers to a
+        // *thread* *safe* allocator.  Note that, when 'edgeTriggered' is
+        // 'true', read and write callbacks must consume all available data
+        // (or fill all available space) on each invocation, otherwise they
+        // may not be invoked again (see
+        // 'btlso_defaulteventmanager_epolledge').  Also note that the
+        // dispatcher thread is NOT started by this method.
+
     TcpTimerEventManager(btlso::EventManager *rawEventManager,
                          bslma::Allocator    *basicAllocator = 0);
         // Create an event manager with timer support that uses the specified
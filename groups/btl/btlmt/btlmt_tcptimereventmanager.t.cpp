@@ -12,6 +12,7 @@
 #include <btlso_socketimputil.h>
 #include <btlso_eventmanagertester.h>
 #include <btlso_inetstreamsocketfactory.h>
+#include <btlso_ioutil.h>
 #include <btlso_ipv4address.h>
 #include <btlso_streamsocket.h>
 
@@ -62,6 +63,7 @@ using namespace BloombergLP;
 // [12] TcpTimerEventManager(bslma::Allocator *basicAllocator = 0);
 // [12] TcpTimerEventManager(collectTimeMetrics, *basicAllocator = 0);
 // [12] TcpTimerEventManager(collectTimeMetrics, poolTimer, *ba = 0);
+// [18] TcpTimerEventManager(collectTimeMetrics, poolTimer, edge, *ba = 0);
 // [  ] TcpTimerEventManager(rawEventManager, *basicAllocator = 0);
 // [12] ~TcpTimerEventManager();
 //
@@ -98,6 +100,7 @@ using namespace BloombergLP;
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [16] USAGE EXAMPLE
+// [18] TESTING EDGE-TRIGGERED SOCKET EVENTS
 //=============================================================================
 
 //=============================================================================
@@ -278,6 +281,47 @@ void testIsEnabled(btlmt::TcpTimerEventManager *manager,
 
 }  // close namespace TEST_CASE_ENABLE_TEST
 
+//=============================================================================
+//       ADDITIONAL EDGE-TRIGGERED TEST:
+//-----------------------------------------------------------------------------
+
+namespace TEST_CASE_EDGE_TRIGGERED {
+
+void drainSocket(btlso::SocketHandle::Handle  handle,
+                 bsls::AtomicInt             *numBytesRead)
+    // Read from the specified non-blocking 'handle' until no data is
+    // available, and add the number of bytes read to the specified
+    // 'numBytesRead'.
+{
+    char buffer[16];
+    int  rc;
+    do {
+        rc = btlso::SocketImpUtil::read(buffer, handle, sizeof buffer);
+        if (0 < rc) {
+            numBytesRead->add(rc);
+        }
+    } while (static_cast<int>(sizeof buffer) == rc);
+}
+
+void increment(bsls::AtomicInt *counter)
+    // Increment the specified 'counter'.
+{
+    ++*counter;
+}
+
+bool waitFor(const bsls::AtomicInt& value, int expected)
+    // Wait for at most 5 seconds until the specified 'value' is equal to the
+    // specified 'expected' value, and return 'true' if it is, and 'false'
+    // otherwise.
+{
+    for (int i = 0; i < 500 && expected != value; ++i) {
+        bslmt::ThreadUtil::microSleep(10000);  // 10 ms
+    }
+    return expected == value;
+}
+
+}  // close namespace TEST_CASE_EDGE_TRIGGERED
+
 //=============================================================================
 //                              MAIN PROGRAM
 //-----------------------------------------------------------------------------
@@ -886,6 +930,87 @@ int main(int argc, char *argv[])
     }
 
     switch (test) { case 0:
+      case 18: {
+        // --------------------------------------------------------------------
+        // TESTING EDGE-TRIGGERED SOCKET EVENTS
+        //
+        // Concerns:
+        //: 1 An event manager created with 'edgeTriggered' set invokes a
+        //:   draining read callback each time data arrives.
+        //:
+        //: 2 Requests submitted from other threads (which are signaled
+        //:   through the internal control channel) are all processed.
+        //:
+        //: 3 The 'collectTimeMetrics' flag is honored.
+        //
+        // Plan:
+        //: 1 Create an edge-triggered event manager, enable it, register a
+        //:   draining read callback on one end of a socket pair, and write
+        //:   several times to the other end, waiting each time for the data
+        //:   to be read.  (C-1)
+        //:
+        //: 2 Submit many functors through 'execute', and wait for all of
+        //:   them to be invoked.  (C-2)
+        //:
+        //: 3 Verify 'hasTimeMetrics'.  (C-3)
+        //
+        // Testing:
+        //   TcpTimerEventManager(collectTimeMetrics, poolTimer, edge, *ba);
+        //   TESTING EDGE-TRIGGERED SOCKET EVENTS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "TESTING EDGE-TRIGGERED SOCKET EVENTS" << endl
+                          << "====================================" << endl;
+
+        using namespace TEST_CASE_EDGE_TRIGGERED;
+
+        {
+            Obj mX(true, false, true, &testAllocator);  const Obj& X = mX;
+            ASSERT(true == X.hasTimeMetrics());
+
+            Obj mY(false, true, true, &testAllocator);  const Obj& Y = mY;
+            ASSERT(false == Y.hasTimeMetrics());
+        }
+
+        Obj mX(false, false, true, &testAllocator);
+        ASSERT(0 == mX.enable());
+
+        btlso::SocketHandle::Handle handles[2];
+        ASSERT(0 == btlso::SocketImpUtil::socketPair<btlso::IPv4Address>(
+                                       handles,
+                                       btlso::SocketImpUtil::k_SOCKET_STREAM));
+        ASSERT(0 == btlso::IoUtil::setBlockingMode(
+                                               handles[1],
+                                               btlso::IoUtil::e_NONBLOCKING));
+
+        bsls::AtomicInt numBytesRead(0);
+        ASSERT(0 == mX.registerSocketEvent(
+                                    handles[1],
+                                    btlso::EventType::e_READ,
+                                    bdlf::BindUtil::bind(&drainSocket,
+                                                         handles[1],
+                                                         &numBytesRead)));
+
+        const char data[20] = { 0 };
+        for (int i = 1; i <= 10; ++i) {
+            ASSERT(20 == btlso::SocketImpUtil::write(handles[0], data, 20));
+            LOOP_ASSERT(i, waitFor(numBytesRead, 20 * i));
+        }
+
+        enum { k_NUM_REQUESTS = 1000 };
+
+        bsls::AtomicInt numExecuted(0);
+        for (int i = 0; i < k_NUM_REQUESTS; ++i) {
+            mX.execute(bdlf::BindUtil::bind(&increment, &numExecuted));
+        }
+        ASSERT(waitFor(numExecuted, k_NUM_REQUESTS));
+
+        mX.deregisterSocket(handles[1]);
+        ASSERT(0 == mX.disable());
+
+        btlso::SocketImpUtil::close(handles[0]);
+        btlso::SocketImpUtil::close(handles[1]);
+      } break;
       case 17: {
         // ----------------------------------------------------------------
         // TESTING USAGE EXAMPLE
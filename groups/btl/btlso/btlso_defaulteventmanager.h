@@ -42,6 +42,9 @@ BSLS_IDENT("$Id: $")
 //  +------------------------------------------------------------------------+
 //  | <btlso::Platform::EPOLL>   |         epoll         |       Linux*      |
 //  +------------------------------------------------------------------------+
+//  | <btlso::Platform::         |  epoll (edge-trigger- |       Linux       |
+//  |               EPOLL_EDGE>  |  ed read and write)   |                   |
+//  +------------------------------------------------------------------------+
 //  | <btlso::Platform::POLLSET> |        pollset        |       AIX*        |
 //  +------------------------------------------------------------------------+
 //  | <btlso::Platform::POLL>    |          poll         | Solaris, AIX,     |
@@ -93,6 +96,10 @@ BSLS_IDENT("$Id: $")
 #include <btlso_defaulteventmanager_epoll.h>
 #endif
 
+#ifndef INCLUDED_BTLSO_DEFAULTEVENTMANAGER_EPOLLEDGE
+#include <btlso_defaulteventmanager_epolledge.h>
+#endif
+
 #ifndef INCLUDED_BTLSO_DEFAULTEVENTMANAGER_POLL
 #include <btlso_defaulteventmanager_poll.h>
 #endif
@@ -0,0 +1,635 @@
+// btlso_defaulteventmanager_epolledge.cpp                            -*-C++-*-
+#include <btlso_defaulteventmanager_epolledge.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(btlso_defaulteventmanager_epolledge_cpp,"$Id$ $CSID$")
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+
+#include <btlso_flags.h>
+#include <btlso_timemetrics.h>
+
+#include <bdlb_bitmaskutil.h>
+#include <bdlb_bitutil.h>
+#include <bdlt_currenttime.h>
+
+#include <bslma_default.h>
+
+#include <bsls_assert.h>
+#include <bsls_performancehint.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdio.h>
+#include <bsl_c_errno.h>
+#include <bsl_c_limits.h>
+
+#include <time.h>
+#include <unistd.h>
+
+namespace BloombergLP {
+namespace btlso {
+
+namespace {
+
+#ifdef EPOLLEXCLUSIVE
+const bsl::uint32_t k_EPOLLEXCLUSIVE = EPOLLEXCLUSIVE;
+#else
+const bsl::uint32_t k_EPOLLEXCLUSIVE = 1u << 28;
+    // Value of 'EPOLLEXCLUSIVE' (Linux 4.5), for older system headers.  Older
+    // kernels ignore this flag.
+#endif
+
+const bsl::uint32_t k_IN_EVENTS = (1u << EventType::e_READ)
+                                | (1u << EventType::e_ACCEPT);
+    // events whose callback is held in 'Registration::d_inCallback'
+
+const bsl::uint32_t k_OUT_EVENTS = (1u << EventType::e_WRITE)
+                                 | (1u << EventType::e_CONNECT);
+    // events whose callback is held in 'Registration::d_outCallback'
+
+const bsl::uint32_t k_EDGE_TRIGGERED_EVENTS = (1u << EventType::e_READ)
+                                            | (1u << EventType::e_WRITE);
+    // events monitored in edge-triggered mode
+
+int sleep(int                       *resultErrno,
+          const bsls::TimeInterval&  timeout,
+          int                        flags,
+          TimeMetrics               *metrics)
+    // Sleep until the specified absolute 'timeout', recording the time spent
+    // as IO-bound in the specified 'metrics', if not 0.  Return 0 if 'timeout'
+    // is reached, and -1, loading 'EINTR' into the specified 'resultErrno',
+    // if the sleep is interrupted and the specified 'flags' contains
+    // 'Flags::k_ASYNC_INTERRUPT'.
+{
+    bsls::TimeInterval now(bdlt::CurrentTime::now());
+
+    while (timeout > now) {
+        bsls::TimeInterval currTimeout(timeout - now);
+        struct timespec    ts;
+
+        ts.tv_sec  = static_cast<time_t>(currTimeout.seconds());
+        ts.tv_nsec = static_cast<long>(currTimeout.nanoseconds());
+
+        int savedErrno;
+        int rc;
+        if (metrics) {
+            metrics->switchTo(TimeMetrics::e_IO_BOUND);
+            rc = nanosleep(&ts, 0);
+            savedErrno = errno;
+            metrics->switchTo(TimeMetrics::e_CPU_BOUND);
+        }
+        else {
+            rc = nanosleep(&ts, 0);
+            savedErrno = errno;
+        }
+
+        errno = 0;
+        *resultErrno = savedErrno;
+        if (0 > rc) {
+            BSLS_ASSERT(savedErrno == EINTR);
+
+            if (flags & Flags::k_ASYNC_INTERRUPT) {
+                return -1;                                            // RETURN
+            }
+        }
+        now = bdlt::CurrentTime::now();
+    }
+    return 0;
+}
+
+bsl::uint32_t epollEvents(bsl::uint32_t eventMask)
+    // Return the 'epoll' event flags monitoring the events in the specified
+    // 'eventMask'.  Read and write events are monitored in edge-triggered
+    // mode, accept and connect events in level-triggered mode, and accept
+    // events exclusively.
+{
+    bsl::uint32_t result = 0;
+
+    if (eventMask & k_IN_EVENTS) {
+        result |= EPOLLIN;
+    }
+    if (eventMask & k_OUT_EVENTS) {
+        result |= EPOLLOUT;
+    }
+    if (eventMask & k_EDGE_TRIGGERED_EVENTS) {
+        result |= EPOLLET;
+    }
+    if (eventMask & bdlb::BitMaskUtil::eq(EventType::e_ACCEPT)) {
+        result |= k_EPOLLEXCLUSIVE;
+    }
+    return result;
+}
+
+}  // close unnamed namespace
+
+        // -----------------------------------------------
+        // class DefaultEventManager<Platform::EPOLL_EDGE>
+        // -----------------------------------------------
+
+typedef DefaultEventManager<Platform::EPOLL_EDGE> EventManagerName;
+    // Alias for brevity.
+
+                          // ------------------
+                          // class Registration
+                          // ------------------
+
+// CREATORS
+EventManagerName::Registration::Registration(bslma::Allocator *basicAllocator)
+: d_mask(0)
+, d_inCallback(bsl::allocator_arg_t(), basicAllocator)
+, d_outCallback(bsl::allocator_arg_t(), basicAllocator)
+{
+}
+
+EventManagerName::Registration::Registration(
+                                         const Registration&  original,
+                                         bslma::Allocator    *basicAllocator)
+: d_mask(original.d_mask)
+, d_inCallback(bsl::allocator_arg_t(), basicAllocator, original.d_inCallback)
+, d_outCallback(bsl::allocator_arg_t(),
+                basicAllocator,
+                original.d_outCallback)
+{
+}
+
+// MANIPULATORS
+EventManagerName::Registration&
+EventManagerName::Registration::operator=(const Registration& rhs)
+{
+    d_mask        = rhs.d_mask;
+    d_inCallback  = rhs.d_inCallback;
+    d_outCallback = rhs.d_outCallback;
+    return *this;
+}
+
+// PRIVATE MANIPULATORS
+int EventManagerName::dispatchCallbacks(int numReady)
+{
+    const int numRegistrations = static_cast<int>(d_registrations.size());
+    int       numCallbacks     = 0;
+
+    for (int i = 0; i < numReady; ++i) {
+        const struct ::epoll_event& curEvent = d_signaled[i];
+        const int                   fd       = curEvent.data.fd;
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(fd >= numRegistrations)) {
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+            continue;
+        }
+
+        // Note that the registered events are tested again before invoking
+        // the write callback, as the read callback may have changed them.
+
+        Registration& registration = d_registrations[fd];
+
+        if (curEvent.events & (EPOLLIN | EPOLLERR | EPOLLHUP)
+         && registration.d_mask & k_IN_EVENTS) {
+            invoke(&registration.d_inCallback);
+            ++numCallbacks;
+        }
+
+        if (curEvent.events & (EPOLLOUT | EPOLLERR | EPOLLHUP)
+         && registration.d_mask & k_OUT_EVENTS) {
+            invoke(&registration.d_outCallback);
+            ++numCallbacks;
+        }
+    }
+
+    return numCallbacks;
+}
+
+int EventManagerName::dispatchImp(int                       flags,
+                                  const bsls::TimeInterval *timeout)
+{
+    bsls::TimeInterval now;
+    if (timeout) {
+        now = bdlt::CurrentTime::now();
+    }
+    int        numCallbacks = 0;             // number of callbacks dispatched
+    const bool allowAsyncInterrupts =
+                                     (0 != (Flags::k_ASYNC_INTERRUPT & flags));
+
+    do {
+        int numReady;                // number of returned sockets
+        int savedErrno = 0;          // saved errno value set by 'epoll_wait'
+        while (1) {
+            int epollTimeout = -1;
+            if (timeout) {
+                if (*timeout < now) {
+                    // The 'epoll_wait' should return immediately.
+
+                    epollTimeout = 0;
+                }
+                else {
+                    // Calculate the time remaining in ms
+
+                    bsls::TimeInterval curr_timeout(*timeout - now);
+                    bsls::Types::Int64 totalMs =
+                                              curr_timeout.totalMilliseconds();
+                    BSLS_ASSERT(totalMs < INT_MAX);
+
+                    // totalMs is rounded down
+
+                    epollTimeout = static_cast<int>(totalMs + 1);
+                }
+            }
+
+            d_signaled.resize(bsl::min(d_numSockets,
+                                       static_cast<int>(k_MAX_BATCH_SIZE)));
+            if (d_signaled.empty()) {
+                // No fds to wait for.  We'll just sleep if there is a timeout.
+
+                if (!timeout || 0 == epollTimeout) {
+                    numReady = 0;
+                    break;
+                }
+                numReady = sleep(&savedErrno, *timeout, flags, d_timeMetric_p);
+            }
+            else {
+                if (d_timeMetric_p) {
+                    d_timeMetric_p->switchTo(TimeMetrics::e_IO_BOUND);
+                }
+
+                numReady = epoll_wait(d_epollFd,
+                                      &d_signaled.front(),
+                                      static_cast<int>(d_signaled.size()),
+                                      epollTimeout);
+
+                BSLS_ASSERT(-1 != numReady || EINTR == errno);
+                savedErrno = errno;
+                if (d_timeMetric_p) {
+                    d_timeMetric_p->switchTo(TimeMetrics::e_CPU_BOUND);
+                }
+            }
+            errno = 0;
+            if (numReady > 0
+             || (numReady < 0
+              && EINTR == savedErrno
+              && allowAsyncInterrupts)) {
+                // Either a fd is ready or we've been interrupted and the user
+                // wants to know.
+
+                break;
+            }
+            if (timeout) {
+                now = bdlt::CurrentTime::now();
+                if (now >= *timeout) {
+                    // We reached the timeout.
+
+                    break;
+                }
+            }
+        }
+
+        if (0 >= numReady) {
+            return numReady
+                   ? -1 == numReady && EINTR == savedErrno
+                     ? -1
+                     : -2
+                   : 0;                                               // RETURN
+        }
+
+        BSLS_ASSERT(numReady <= static_cast<int>(d_signaled.size()));
+        numCallbacks += dispatchCallbacks(numReady);
+
+        // A batch of the maximum size suggests that more events are pending:
+        // collect them now, without blocking, rather than on the next
+        // 'dispatch'.  Note that a smaller batch that is full holds an event
+        // for every registered socket, so that only sockets re-armed, or left
+        // ready (for level-triggered events), by the callbacks would be
+        // reported again.
+
+        for (int numBatches = 1;
+             k_MAX_BATCH_SIZE == numReady && numBatches < k_MAX_NUM_BATCHES;
+             ++numBatches) {
+            d_signaled.resize(bsl::min(d_numSockets,
+                                       static_cast<int>(k_MAX_BATCH_SIZE)));
+            if (d_signaled.empty()) {
+                break;
+            }
+
+            if (d_timeMetric_p) {
+                d_timeMetric_p->switchTo(TimeMetrics::e_IO_BOUND);
+            }
+
+            numReady = epoll_wait(d_epollFd,
+                                  &d_signaled.front(),
+                                  static_cast<int>(d_signaled.size()),
+                                  0);
+
+            if (d_timeMetric_p) {
+                d_timeMetric_p->switchTo(TimeMetrics::e_CPU_BOUND);
+            }
+
+            if (0 >= numReady) {
+                errno = 0;
+                break;
+            }
+            numCallbacks += dispatchCallbacks(numReady);
+        }
+
+        if (timeout) {
+            now = bdlt::CurrentTime::now();
+        }
+    } while (0 == numCallbacks && (0 == timeout || now < *timeout));
+
+    return numCallbacks;
+}
+
+void EventManagerName::invoke(EventManager::Callback *callback)
+{
+    BSLS_ASSERT(callback);
+    BSLS_ASSERT(0 == d_invoked_p);
+
+    d_invoked_p = callback;
+    (*callback)();
+    d_invoked_p = 0;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(d_hasPendingCallback)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        callback->swap(d_pendingCallback);
+        d_pendingCallback    = EventManager::Callback();
+        d_hasPendingCallback = false;
+    }
+}
+
+void EventManagerName::setCallback(EventManager::Callback        *callback,
+                                   const EventManager::Callback&  value)
+{
+    BSLS_ASSERT(callback);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(callback == d_invoked_p)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // 'callback' must not be destroyed while it executes.
+
+        d_pendingCallback    = value;
+        d_hasPendingCallback = true;
+        return;                                                       // RETURN
+    }
+    *callback = value;
+}
+
+int EventManagerName::updateEpoll(int           handle,
+                                  bsl::uint32_t oldMask,
+                                  bsl::uint32_t newMask)
+{
+    struct epoll_event epollEvent = { 0, { 0 } };
+
+    if (0 == newMask) {
+        int ret = epoll_ctl(d_epollFd, EPOLL_CTL_DEL, handle, &epollEvent);
+
+        // epoll removes closed file descriptors automatically.
+
+        (void)ret; BSLS_ASSERT(0 == ret || ENOENT == errno || EBADF == errno);
+        return 0;                                                     // RETURN
+    }
+
+    epollEvent.events  = epollEvents(newMask);
+    epollEvent.data.fd = handle;
+
+    const int ret = epoll_ctl(d_epollFd,
+                              0 == oldMask ? EPOLL_CTL_ADD : EPOLL_CTL_MOD,
+                              handle,
+                              &epollEvent);
+    BSLS_ASSERT(0 == ret || ENOENT == errno || EBADF == errno);
+
+    return ret;
+}
+
+// PUBLIC CLASS METHODS
+bool EventManagerName::isSupported()
+{
+    int fd = epoll_create1(0);
+    if (-1 == fd) {
+        return false;                                                 // RETURN
+    }
+    close(fd);
+    return true;
+}
+
+// CREATORS
+EventManagerName::DefaultEventManager(TimeMetrics      *timeMetric,
+                                      bslma::Allocator *basicAllocator)
+: d_epollFd(-1)
+, d_signaled(basicAllocator)
+, d_registrations(basicAllocator)
+, d_numEvents(0)
+, d_numSockets(0)
+, d_invoked_p(0)
+, d_pendingCallback(bsl::allocator_arg_t(), basicAllocator)
+, d_hasPendingCallback(false)
+, d_timeMetric_p(timeMetric)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+    d_epollFd = epoll_create1(0);
+    if (-1 == d_epollFd) {
+        bsl::perror("epoll_create1 returned ");
+        BSLS_ASSERT_OPT("epoll_create1() failed" && 0);
+    }
+}
+
+EventManagerName::~DefaultEventManager()
+{
+    int rc = close(d_epollFd);
+    (void)rc; BSLS_ASSERT(0 == rc);
+}
+
+// MANIPULATORS
+void EventManagerName::deregisterAll()
+{
+    const int numRegistrations = static_cast<int>(d_registrations.size());
+
+    for (int fd = 0; fd < numRegistrations && 0 < d_numSockets; ++fd) {
+        Registration& registration = d_registrations[fd];
+        if (0 == registration.d_mask) {
+            continue;
+        }
+
+        updateEpoll(fd, registration.d_mask, 0);
+
+        d_numEvents -= bdlb::BitUtil::numBitsSet(registration.d_mask);
+        --d_numSockets;
+
+        registration.d_mask = 0;
+        setCallback(&registration.d_inCallback,  EventManager::Callback());
+        setCallback(&registration.d_outCallback, EventManager::Callback());
+    }
+
+    BSLS_ASSERT(0 == d_numEvents);
+    BSLS_ASSERT(0 == d_numSockets);
+}
+
+void EventManagerName::deregisterSocketEvent(
+                                           const SocketHandle::Handle& handle,
+                                           EventType::Type             event)
+{
+    const bsl::uint32_t bit = bdlb::BitMaskUtil::eq(event);
+
+    if (0 > handle
+     || handle >= static_cast<int>(d_registrations.size())
+     || 0 == (d_registrations[handle].d_mask & bit)) {
+        return;                                                       // RETURN
+    }
+
+    Registration&       registration = d_registrations[handle];
+    const bsl::uint32_t newMask      = registration.d_mask & ~bit;
+
+    // Note that modifying the remaining event of an edge-triggered socket
+    // re-arms it.
+
+    int ret = updateEpoll(handle, registration.d_mask, newMask);
+    (void)ret;
+
+    registration.d_mask = newMask;
+    setCallback(bit & k_IN_EVENTS ? &registration.d_inCallback
+                                  : &registration.d_outCallback,
+                EventManager::Callback());
+
+    --d_numEvents;
+    if (0 == newMask) {
+        --d_numSockets;
+    }
+}
+
+int EventManagerName::deregisterSocket(const SocketHandle::Handle& handle)
+{
+    if (0 > handle || handle >= static_cast<int>(d_registrations.size())) {
+        return 0;                                                     // RETURN
+    }
+
+    Registration& registration = d_registrations[handle];
+    if (0 == registration.d_mask) {
+        return 0;                                                     // RETURN
+    }
+
+    updateEpoll(handle, registration.d_mask, 0);
+
+    const int numEvents = bdlb::BitUtil::numBitsSet(registration.d_mask);
+    d_numEvents -= numEvents;
+    --d_numSockets;
+
+    registration.d_mask = 0;
+    setCallback(&registration.d_inCallback,  EventManager::Callback());
+    setCallback(&registration.d_outCallback, EventManager::Callback());
+
+    return numEvents;
+}
+
+int EventManagerName::dispatch(const bsls::TimeInterval& timeout,
+                               int                       flags)
+{
+    if (0 == numEvents()) {
+        int dummy;
+        return sleep(&dummy, timeout, flags, d_timeMetric_p);         // RETURN
+    }
+    return dispatchImp(flags, &timeout);
+}
+
+int EventManagerName::dispatch(int flags)
+{
+    if (0 == numEvents()) {
+        return 0;                                                     // RETURN
+    }
+    return dispatchImp(flags, 0);
+}
+
+int EventManagerName::registerSocketEvent(
+                                 const SocketHandle::Handle&   handle,
+                                 const EventType::Type         event,
+                                 const EventManager::Callback& callback)
+{
+    if (0 > handle) {
+        return -1;                                                    // RETURN
+    }
+
+    if (handle >= static_cast<int>(d_registrations.size())) {
+        // Growing a 'deque' at its end does not move its elements, so that a
+        // callback being invoked remains in place.
+
+        d_registrations.resize(handle + 1);
+    }
+
+    Registration&       registration = d_registrations[handle];
+    const bsl::uint32_t bit          = bdlb::BitMaskUtil::eq(event);
+    const bsl::uint32_t oldMask      = registration.d_mask;
+    EventManager::Callback *slot     = bit & k_IN_EVENTS
+                                       ? &registration.d_inCallback
+                                       : &registration.d_outCallback;
+
+    // Only 'e_READ' and 'e_WRITE' may be registered together.
+
+    BSLS_ASSERT(0 == oldMask
+             || (oldMask & bit)
+             || 0 == ((oldMask | bit) & ~k_EDGE_TRIGGERED_EVENTS));
+
+    if (oldMask & bit) {
+        // The event is already registered: replace the callback and, for an
+        // edge-triggered event, re-arm the socket so that a pending event is
+        // reported again.
+
+        setCallback(slot, callback);
+
+        if (bit & k_EDGE_TRIGGERED_EVENTS) {
+            updateEpoll(handle, oldMask, oldMask);
+        }
+        return 0;                                                     // RETURN
+    }
+
+    const bsl::uint32_t newMask = oldMask | bit;
+    if (0 != updateEpoll(handle, oldMask, newMask)) {
+        return -1;                                                    // RETURN
+    }
+
+    registration.d_mask = newMask;
+    setCallback(slot, callback);
+
+    ++d_numEvents;
+    if (0 == oldMask) {
+        ++d_numSockets;
+    }
+    return 0;
+}
+
+// ACCESSORS
+int EventManagerName::numSocketEvents(const SocketHandle::Handle& handle) const
+{
+    const Registration *registration = lookup(handle);
+
+    return registration
+           ? bdlb::BitUtil::numBitsSet(registration->d_mask)
+           : 0;
+}
+
+int EventManagerName::isRegistered(const SocketHandle::Handle& handle,
+                                   const EventType::Type       event) const
+{
+    const Registration *registration = lookup(handle);
+
+    return registration
+        && (registration->d_mask & bdlb::BitMaskUtil::eq(event)) ? 1 : 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,550 @@
+// btlso_defaulteventmanager_epolledge.h                              -*-C++-*-
+#ifndef INCLUDED_BTLSO_DEFAULTEVENTMANAGER_EPOLLEDGE
+#define INCLUDED_BTLSO_DEFAULTEVENTMANAGER_EPOLLEDGE
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an edge-triggered socket multiplexer using Linux 'epoll'.
+//
+//@CLASSES:
+//  btlso::DefaultEventManager<btlso::Platform::EPOLL_EDGE>: 'epoll' (ET)
+//
+//@SEE_ALSO: btlso_defaulteventmanager_epoll btlso_eventmanager
+//
+//@DESCRIPTION: This component provides an implementation of an event manager,
+// 'btlso::DefaultEventManager<btlso::Platform::EPOLL_EDGE>', that adheres to
+// the 'btlso::EventManager' protocol and uses the Linux 'epoll' system calls
+// in edge-triggered mode ('EPOLLET') to monitor sockets for read and write
+// events.  It is intended for servers holding many (mostly idle) connections,
+// and differs from 'btlso::DefaultEventManager<btlso::Platform::EPOLL>' in
+// three ways:
+//
+//: o Read and write readiness is reported once per transition (i.e., when
+//:   new data arrives, or when space becomes available in the send buffer),
+//:   so a socket with unread data is not reported again on every 'dispatch'.
+//:
+//: o Callbacks are held in a flat table indexed by socket handle, so that
+//:   dispatching an event, and registering or deregistering a callback, does
+//:   not hash, and dispatching an event does not allocate.
+//:
+//: o Ready events are collected in batches of up to 'k_MAX_BATCH_SIZE', and
+//:   a batch of 'k_MAX_BATCH_SIZE' events is followed by up to
+//:   'k_MAX_NUM_BATCHES - 1' additional non-blocking collections within the
+//:   same 'dispatch'.
+//
+///Edge-Triggered Semantics
+///------------------------
+// A callback registered for 'btlso::EventType::e_READ' or
+// 'btlso::EventType::e_WRITE' is invoked when the corresponding event *occurs*
+// rather than whenever the socket *is* ready.  Each such callback must
+// therefore read (or write) until the operation would block, or until a read
+// (or write) transfers fewer bytes than requested; otherwise, it will not be
+// invoked again until more data arrives (or until more space becomes
+// available).  Note that registering an event, or deregistering one of the
+// two events registered for a socket, re-evaluates the readiness of that
+// socket, so a callback that stops early may re-arm itself by re-registering.
+//
+// 'btlso::EventType::e_ACCEPT' and 'btlso::EventType::e_CONNECT' events are
+// monitored in level-triggered mode, so that a listening socket with a
+// backlog of several connections is reported until the backlog is drained.
+// Listening sockets are registered with 'EPOLLEXCLUSIVE' (on kernels
+// supporting it, i.e., 4.5 or later), so that when the same listening socket
+// is monitored by several event managers (e.g., one per thread), a pending
+// connection wakes up only one of them.
+//
+///Availability
+///------------
+// This component is supported only on Linux.  Direct use of this library
+// component on *any* platform may result in non-portable software.
+//
+///Thread Safety
+///-------------
+// This component depends on a 'bslma::Allocator' instance to supply memory.
+// If the allocator is not thread enabled then the instances of this component
+// that use the same allocator instance will consequently not be thread safe.
+// Otherwise, this component provides the following guarantees.
+//
+// Accessing an instance of the event manager provided by this component from
+// different threads may result in undefined behavior.  Accessing distinct
+// instances from different threads is safe.  The event manager is not
+// *async-safe*, meaning that one or more functions cannot be invoked safely
+// from a signal handler.
+//
+///Performance
+///-----------
+// Given that S is the number of socket events registered, R is the number of
+// events reported by the kernel in a 'dispatch', and H is the largest socket
+// handle ever registered, this component provides the following complexity
+// guarantees:
+//..
+//  +=======================================================================+
+//  |        FUNCTION          | EXPECTED COMPLEXITY | WORST CASE COMPLEXITY|
+//  +-----------------------------------------------------------------------+
+//  | dispatch                 |        O(R)         |        O(R)          |
+//  +-----------------------------------------------------------------------+
+//  | registerSocketEvent      |        O(1)         |        O(H)          |
+//  +-----------------------------------------------------------------------+
+//  | deregisterSocketEvent    |        O(1)         |        O(1)          |
+//  +-----------------------------------------------------------------------+
+//  | deregisterSocket         |        O(1)         |        O(1)          |
+//  +-----------------------------------------------------------------------+
+//  | deregisterAll            |        O(H)         |        O(H)          |
+//  +-----------------------------------------------------------------------+
+//  | numSocketEvents          |        O(1)         |        O(1)          |
+//  +-----------------------------------------------------------------------+
+//  | numEvents                |        O(1)         |        O(1)          |
+//  +-----------------------------------------------------------------------+
+//  | isRegistered             |        O(1)         |        O(1)          |
+//  +=======================================================================+
+//..
+// The worst case of 'registerSocketEvent' is reached when the table of
+// callbacks must grow to accommodate a new, larger socket handle.  The table
+// never shrinks, and its entries are never moved, so that a callback may
+// safely register and deregister events while it is being invoked.
+//
+///Metrics
+///-------
+// The event manager provided by this component can use external (i.e.,
+// user-installed) time metrics (see 'btlso_timemetrics' component) to record
+// times spend in IO-bound and CPU-bound operations using the category IDs
+// defined in 'btlso::TimeMetrics'.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Draining a Socket on Each Notification
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Since read events are reported only when new data arrives, a read callback
+// must consume all the data available on its socket.  First, we define a
+// callback that reads from a non-blocking socket until no more data is
+// available, accumulating the number of bytes read:
+//..
+//  static void drainCb(btlso::SocketHandle::Handle  handle,
+//                      int                         *numBytesRead)
+//  {
+//      char buffer[64];
+//      int  rc;
+//      do {
+//          rc = btlso::SocketImpUtil::read(buffer, handle, sizeof buffer);
+//          if (0 < rc) {
+//              *numBytesRead += rc;
+//          }
+//      } while (static_cast<int>(sizeof buffer) == rc);
+//  }
+//..
+// Then, we create the event manager and a (locally-connected) socket pair,
+// whose reading end is made non-blocking:
+//..
+//  btlso::DefaultEventManager<btlso::Platform::EPOLL_EDGE> mX;
+//
+//  btlso::SocketHandle::Handle socket[2];
+//  int rc = btlso::SocketImpUtil::socketPair<btlso::IPv4Address>(
+//                                      socket,
+//                                      btlso::SocketImpUtil::k_SOCKET_STREAM);
+//  assert(0 == rc);
+//
+//  rc = btlso::IoUtil::setBlockingMode(socket[1],
+//                                      btlso::IoUtil::e_NONBLOCKING);
+//  assert(0 == rc);
+//..
+// Next, we register our callback for read events on 'socket[1]':
+//..
+//  int                           numBytesRead = 0;
+//  btlso::EventManager::Callback readCb(bdlf::BindUtil::bind(&drainCb,
+//                                                            socket[1],
+//                                                            &numBytesRead));
+//  rc = mX.registerSocketEvent(socket[1], btlso::EventType::e_READ, readCb);
+//  assert(0 == rc);
+//..
+// Now, we write 100 bytes to 'socket[0]' and dispatch; our callback is invoked
+// once and reads all of the data:
+//..
+//  char data[100] = { 0 };
+//  rc = btlso::SocketImpUtil::write(socket[0], data, sizeof data);
+//  assert(static_cast<int>(sizeof data) == rc);
+//
+//  bsls::TimeInterval deadline = bdlt::CurrentTime::now() + 1;
+//  rc = mX.dispatch(deadline, 0);
+//  assert(1   == rc);
+//  assert(100 == numBytesRead);
+//..
+// Finally, we observe that, the socket having been drained, a subsequent
+// 'dispatch' times out without invoking the callback, and we clean up:
+//..
+//  deadline = bdlt::CurrentTime::now() + bsls::TimeInterval(0, 50000000);
+//  rc = mX.dispatch(deadline, 0);
+//  assert(0 == rc);
+//
+//  mX.deregisterAll();
+//  btlso::SocketImpUtil::close(socket[0]);
+//  btlso::SocketImpUtil::close(socket[1]);
+//..
+
+#ifndef INCLUDED_BTLSCM_VERSION
+#include <btlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BTLSO_DEFAULTEVENTMANAGERIMPL
+#include <btlso_defaulteventmanagerimpl.h>
+#endif
+
+#ifndef INCLUDED_BTLSO_EVENTMANAGER
+#include <btlso_eventmanager.h>
+#endif
+
+#ifndef INCLUDED_BTLSO_EVENTTYPE
+#include <btlso_eventtype.h>
+#endif
+
+#ifndef INCLUDED_BTLSO_PLATFORM
+#include <btlso_platform.h>
+#endif
+
+#ifndef INCLUDED_BTLSO_SOCKETHANDLE
+#include <btlso_sockethandle.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PLATFORM
+#include <bsls_platform.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDINT
+#include <bsl_cstdint.h>
+#endif
+
+#ifndef INCLUDED_BSL_DEQUE
+#include <bsl_deque.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+
+#ifndef INCLUDED_SYS_EPOLL
+#include <sys/epoll.h>
+#define INCLUDED_SYS_EPOLL
+#endif
+
+namespace BloombergLP {
+
+namespace bsls { class TimeInterval; }
+
+namespace btlso {
+
+class TimeMetrics;
+
+        // ===============================================
+        // class DefaultEventManager<Platform::EPOLL_EDGE>
+        // ===============================================
+
+template <>
+class DefaultEventManager<Platform::EPOLL_EDGE> : public EventManager
+{
+  public:
+    // PUBLIC CONSTANTS
+    enum {
+        k_MAX_BATCH_SIZE  = 1024,  // maximum number of events collected by a
+                                   // single 'epoll_wait'
+
+        k_MAX_NUM_BATCHES = 4      // maximum number of batches collected by
+                                   // a single 'dispatch'
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct Registration {
+        // This 'struct' holds the events registered for one socket handle,
+        // and their callbacks.  The callback for 'e_READ' or 'e_ACCEPT' (at
+        // most one of which may be registered) is held in 'd_inCallback', and
+        // that for 'e_WRITE' or 'e_CONNECT' in 'd_outCallback'.
+
+        // DATA
+        bsl::uint32_t          d_mask;         // bit mask of registered
+                                               // 'EventType::Type' values
+
+        EventManager::Callback d_inCallback;   // 'e_READ'/'e_ACCEPT' callback
+
+        EventManager::Callback d_outCallback;  // 'e_WRITE'/'e_CONNECT'
+                                               // callback
+
+        // TRAITS
+        BSLMF_NESTED_TRAIT_DECLARATION(Registration,
+                                       bslma::UsesBslmaAllocator);
+
+        // CREATORS
+        explicit
+        Registration(bslma::Allocator *basicAllocator = 0);
+            // Create a 'Registration' having no registered events.
+            // Optionally specify a 'basicAllocator' used to supply memory.  If
+            // 'basicAllocator' is 0, the currently installed default allocator
+            // is used.
+
+        Registration(const Registration&  original,
+                     bslma::Allocator    *basicAllocator = 0);
+            // Create a 'Registration' having the value of the specified
+            // 'original' registration.  Optionally specify a 'basicAllocator'
+            // used to supply memory.  If 'basicAllocator' is 0, the currently
+            // installed default allocator is used.
+
+        // MANIPULATORS
+        Registration& operator=(const Registration& rhs);
+            // Assign to this object the value of the specified 'rhs'
+            // registration, and return a reference providing modifiable
+            // access to this object.
+    };
+
+    // DATA
+    int                                d_epollFd;     // epoll file descriptor
+
+    bsl::vector<struct ::epoll_event>  d_signaled;    // events reported by
+                                                      // the last
+                                                      // 'epoll_wait'
+
+    bsl::deque<Registration>           d_registrations;
+                                                      // registrations indexed
+                                                      // by socket handle
+                                                      // (elements are never
+                                                      // moved)
+
+    int                                d_numEvents;   // number of registered
+                                                      // events
+
+    int                                d_numSockets;  // number of sockets
+                                                      // with registered
+                                                      // events
+
+    EventManager::Callback            *d_invoked_p;   // callback being
+                                                      // invoked, if any
+
+    EventManager::Callback             d_pendingCallback;
+                                                      // value to be given to
+                                                      // '*d_invoked_p' once
+                                                      // its invocation
+                                                      // completes
+
+    bool                               d_hasPendingCallback;
+                                                      // 'true' if
+                                                      // 'd_pendingCallback'
+                                                      // is to be applied
+
+    TimeMetrics                       *d_timeMetric_p;
+                                                      // metrics to use for
+                                                      // reporting percent-busy
+                                                      // statistics
+
+    bslma::Allocator                  *d_allocator_p; // supplies memory
+
+    // PRIVATE MANIPULATORS
+    int dispatchCallbacks(int numEvents);
+        // Invoke any registered callbacks for the first 'numEvents' events in
+        // 'd_signaled'.  Return the number of callbacks invoked.
+
+    int dispatchImp(int flags, const bsls::TimeInterval *timeout = 0);
+        // For each pending socket event, invoke the corresponding callback
+        // registered with this event manager.
+
+    void invoke(EventManager::Callback *callback);
+        // Invoke the specified 'callback', and then apply to it any change
+        // requested by the invocation (see 'setCallback').
+
+    void setCallback(EventManager::Callback        *callback,
+                     const EventManager::Callback&  value);
+        // Assign the specified 'value' to the specified 'callback'.  If
+        // 'callback' is being invoked, defer the assignment until the
+        // invocation completes.
+
+    int updateEpoll(int handle, bsl::uint32_t oldMask, bsl::uint32_t newMask);
+        // Reflect, in the 'epoll' set of this event manager, the change of
+        // the events registered for the specified 'handle' from the specified
+        // 'oldMask' to the specified 'newMask'.  Return 0 on success, and a
+        // non-zero value otherwise.
+
+    // PRIVATE ACCESSORS
+    const Registration *lookup(const SocketHandle::Handle& handle) const;
+        // Return the address of the registration for the specified 'handle',
+        // or 0 if 'handle' lies beyond the registration table.
+
+  private:
+    // NOT IMPLEMENTED
+    DefaultEventManager(const DefaultEventManager&);
+    DefaultEventManager& operator=(const DefaultEventManager&);
+
+  public:
+    // PUBLIC CLASS METHODS
+    static bool isSupported();
+        // Return true if the current kernel supports this event manager.
+
+    // CREATORS
+    explicit
+    DefaultEventManager(TimeMetrics      *timeMetric     = 0,
+                        bslma::Allocator *basicAllocator = 0);
+        // Create an edge-triggered 'epoll'-based event manager.  Optionally
+        // specify a 'timeMetric' to report time spent in CPU-bound and
+        // IO-bound operations.  If 'timeMetric' is not specified or is 0,
+        // these metrics are not reported.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the currently installed default allocator is used.
+
+    ~DefaultEventManager();
+        // Destroy this object.  Note that the registered callbacks are NOT
+        // invoked.
+
+    // MANIPULATORS
+    int dispatch(const bsls::TimeInterval& timeout, int flags);
+        // For each pending socket event, invoke the corresponding callback
+        // registered with this event manager.  If no event is pending, wait
+        // until either (1) at least one event occurs (in which case the
+        // corresponding callback(s) is invoked), (2) the specified absolute
+        // 'timeout' is reached, or (3) provided that the specified 'flags'
+        // contains 'btlso::Flags::k_ASYNC_INTERRUPT', an underlying system
+        // call is interrupted by a signal.  Return the number of dispatched
+        // callbacks on success, 0 if 'timeout' is reached, and a negative
+        // value otherwise; -1 is reserved to indicate that an underlying
+        // system call was interrupted.  When such an interruption occurs this
+        // method will return -1 if 'flags' contains
+        // 'btlso::Flags::k_ASYNC_INTERRUPT', and otherwise will automatically
+        // restart (i.e., reissue the identical system call).  Note that all
+        // callbacks are invoked in the same thread that invokes 'dispatch',
+        // and the order of invocation, relative to the order of registration,
+        // is unspecified.
+
+    int dispatch(int flags);
+        // For each pending socket event, invoke the corresponding callback
+        // registered with this event manager.  If no event is pending, wait
+        // until either (1) at least one event occurs (in which case the
+        // corresponding callback(s) is invoked) or (2) provided that the
+        // specified 'flags' contains 'btlso::Flags::k_ASYNC_INTERRUPT', an
+        // underlying system call is interrupted by a signal.  Return the
+        // number of dispatched callbacks on success, and a negative value
+        // otherwise; -1 is reserved to indicate that an underlying system call
+        // was interrupted.  When such an interruption occurs this method will
+        // return -1 if 'flags' contains 'btlso::Flags::k_ASYNC_INTERRUPT' and
+        // otherwise will automatically restart (i.e., reissue the identical
+        // system call).  Note that all callbacks are invoked in the same
+        // thread that invokes 'dispatch', and the order of invocation,
+        // relative to the order of registration, is unspecified.
+
+    int registerSocketEvent(const SocketHandle::Handle&   handle,
+                            const EventType::Type         event,
+                            const EventManager::Callback& callback);
+        // Register with this event manager the specified 'callback' to be
+        // invoked when the specified 'event' occurs on the specified socket
+        // 'handle'.  Each socket event registration stays in effect until it
+        // is subsequently deregistered; the callback is invoked each time the
+        // corresponding event is detected (see {Edge-Triggered Semantics}).
+        // 'EventType::e_READ' and 'EventType::e_WRITE' are the only events
+        // that can be registered simultaneously for a socket.  If a
+        // registration attempt is made for an event that is already
+        // registered, the callback associated with this event will be
+        // overwritten with the new one.  Simultaneous registration of
+        // incompatible events for the same socket 'handle' will result in
+        // undefined behavior.  Return 0 on success and a non-zero value on
+        // error.
+
+    void deregisterSocketEvent(const SocketHandle::Handle& handle,
+                               EventType::Type             event);
+        // Deregister from this event manager the callback associated with the
+        // specified 'event' on the specified 'handle' so that said callback
+        // will not be invoked should 'event' occur.
+
+    int deregisterSocket(const SocketHandle::Handle& handle);
+        // Deregister from this event manager all events associated with the
+        // specified socket 'handle'.  Return the number of deregistered
+        // callbacks.
+
+    void deregisterAll();
+        // Deregister from this event manager all events on every socket
+        // handle.
+
+    // ACCESSORS
+    bool hasLimitedSocketCapacity() const;
+        // Return 'true' if this event manager has a limited socket capacity,
+        // and 'false' otherwise.
+
+    int isRegistered(const SocketHandle::Handle& handle,
+                     const EventType::Type       event) const;
+        // Return 1 if the specified 'event' is registered with this event
+        // manager for the specified socket 'handle' and 0 otherwise.
+
+    int numEvents() const;
+        // Return the total number of all socket events currently registered
+        // with this event manager.
+
+    int numSocketEvents(const SocketHandle::Handle& handle) const;
+        // Return the number of socket events currently registered with this
+        // event manager for the specified 'handle'.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+        // -----------------------------------------------
+        // class DefaultEventManager<Platform::EPOLL_EDGE>
+        // -----------------------------------------------
+
+// PRIVATE ACCESSORS
+inline
+const DefaultEventManager<Platform::EPOLL_EDGE>::Registration *
+DefaultEventManager<Platform::EPOLL_EDGE>::lookup(
+                                      const SocketHandle::Handle& handle) const
+{
+    return 0 <= handle && handle < static_cast<int>(d_registrations.size())
+           ? &d_registrations[handle]
+           : 0;
+}
+
+// ACCESSORS
+inline
+bool
+DefaultEventManager<Platform::EPOLL_EDGE>::hasLimitedSocketCapacity() const
+{
+    return false;
+}
+
+inline
+int DefaultEventManager<Platform::EPOLL_EDGE>::numEvents() const
+{
+    return d_numEvents;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif // BSLS_PLATFORM_OS_LINUX
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
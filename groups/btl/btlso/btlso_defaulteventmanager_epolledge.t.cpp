@@ -0,0 +1,1339 @@
+// btlso_defaulteventmanager_epolledge.t.cpp                          -*-C++-*-
+#include <btlso_defaulteventmanager_epolledge.h>
+
+#include <btlso_defaulteventmanager_epoll.h>
+#include <btlso_eventmanagertester.h>
+#include <btlso_flags.h>
+#include <btlso_ioutil.h>
+#include <btlso_ipv4address.h>
+#include <btlso_platform.h>
+#include <btlso_socketimputil.h>
+#include <btlso_timemetrics.h>
+
+#include <bdlf_bind.h>
+#include <bdlt_currenttime.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_assert.h>
+#include <bsls_platform.h>
+#include <bsls_stopwatch.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_functional.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    #define BTLSO_EVENTMANAGER_ENABLETEST
+    typedef BloombergLP::btlso::DefaultEventManager<
+                             BloombergLP::btlso::Platform::EPOLL_EDGE> Obj;
+#endif
+
+#ifdef BTLSO_EVENTMANAGER_ENABLETEST
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              OVERVIEW
+// The component under test is an event manager monitoring read and write
+// events in edge-triggered mode.  The registration methods and accessors are
+// exercised with the "canned" tests of 'btlso::EventManagerTester', as for
+// the other event managers.  'dispatch' is tested directly, since the canned
+// test assumes level-triggered notifications: we verify that a read (write)
+// event is reported once per arrival of data (of space), that
+// (re-)registration re-arms a socket, that callbacks may change any
+// registration (including their own) while being invoked, that more than
+// 'k_MAX_BATCH_SIZE' ready sockets are dispatched in a single call, and that
+// accept events remain level-triggered.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 1] static bool isSupported();
+//
+// CREATORS
+// [ 2] DefaultEventManager(TimeMetrics *, bslma::Allocator *);
+// [ 2] ~DefaultEventManager();
+//
+// MANIPULATORS
+// [ 3] int registerSocketEvent(handle, event, callback);
+// [ 3] void deregisterSocketEvent(handle, event);
+// [ 3] int deregisterSocket(handle);
+// [ 3] void deregisterAll();
+// [ 4] int dispatch(const bsls::TimeInterval&, int);
+// [ 4] int dispatch(int);
+//
+// ACCESSORS
+// [ 2] bool hasLimitedSocketCapacity() const;
+// [ 2] int isRegistered(handle, event) const;
+// [ 2] int numEvents() const;
+// [ 2] int numSocketEvents(handle) const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] CALLBACKS CHANGING REGISTRATIONS
+// [ 6] DISPATCHING MORE THAN ONE BATCH
+// [ 7] LEVEL-TRIGGERED ACCEPT EVENTS
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE: MANY IDLE CONNECTIONS
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT(X) { aSsErT(!(X), #X, __LINE__); }
+
+#define LOOP_ASSERT(I,X) { \
+   if (!(X)) { cout << #I << ": " << I << "\n"; aSsErT(1, #X, __LINE__); }}
+
+#define LOOP2_ASSERT(I,J,X) { \
+   if (!(X)) { cout << #I << ": " << I << "\t" << #J << ": " \
+              << J << "\n"; aSsErT(1, #X, __LINE__); } }
+
+#define P(X) cout << #X " = " << (X) << endl;
+#define P_(X) cout << #X " = " << (X) << ", " << flush;
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef btlso::EventManagerTester  EventManagerTester;
+typedef btlso::EventManagerTestPair TestPair;
+typedef btlso::EventType            EventType;
+
+// ============================================================================
+//                            HELPER FUNCTIONS
+// ----------------------------------------------------------------------------
+
+namespace {
+
+void countCb(int *numInvocations)
+    // Increment the specified 'numInvocations'.
+{
+    ++*numInvocations;
+}
+
+void readCb(btlso::SocketHandle::Handle  handle,
+            int                          numBytes,
+            int                         *numInvocations,
+            int                         *numBytesRead)
+    // Increment the specified 'numInvocations', and read at most the
+    // specified 'numBytes' from the specified 'handle', adding the number of
+    // bytes read to the specified 'numBytesRead'.
+{
+    char buffer[8192];
+    BSLS_ASSERT(numBytes <= static_cast<int>(sizeof buffer));
+
+    ++*numInvocations;
+    int rc = btlso::SocketImpUtil::read(buffer, handle, numBytes);
+    if (0 < rc) {
+        *numBytesRead += rc;
+    }
+}
+
+void drainCb(btlso::SocketHandle::Handle  handle,
+             int                         *numBytesRead)
+    // Read from the specified non-blocking 'handle' until no more data is
+    // available, adding the number of bytes read to the specified
+    // 'numBytesRead'.
+{
+    char buffer[64];
+    int  rc;
+    do {
+        rc = btlso::SocketImpUtil::read(buffer, handle, sizeof buffer);
+        if (0 < rc) {
+            *numBytesRead += rc;
+        }
+    } while (static_cast<int>(sizeof buffer) == rc);
+}
+
+void deregisterSelfCb(Obj                         *mX,
+                      btlso::SocketHandle::Handle  handle,
+                      int                         *numInvocations)
+    // Increment the specified 'numInvocations', and deregister the read
+    // event of the specified 'handle' from the specified 'mX'.
+{
+    ++*numInvocations;
+    mX->deregisterSocketEvent(handle, EventType::e_READ);
+}
+
+void replaceSelfCb(Obj                           *mX,
+                   btlso::SocketHandle::Handle    handle,
+                   int                           *numInvocations,
+                   btlso::EventManager::Callback  replacement)
+    // Increment the specified 'numInvocations', and replace this read
+    // callback of the specified 'handle' in the specified 'mX' with the
+    // specified 'replacement'.
+{
+    ++*numInvocations;
+    ASSERT(0 == mX->registerSocketEvent(handle,
+                                        EventType::e_READ,
+                                        replacement));
+}
+
+void deregisterAllCb(Obj *mX, int *numInvocations)
+    // Increment the specified 'numInvocations', and deregister all events
+    // from the specified 'mX'.
+{
+    ++*numInvocations;
+    mX->deregisterAll();
+}
+
+void registerManyCb(Obj                                      *mX,
+                    const bsl::vector<btlso::SocketHandle::Handle>& handles,
+                    int                                      *numInvocations)
+    // Increment the specified 'numInvocations', and register a counting
+    // callback for read events on each of the specified 'handles' with the
+    // specified 'mX'.
+{
+    ++*numInvocations;
+    for (bsl::size_t i = 0; i < handles.size(); ++i) {
+        ASSERT(0 == mX->registerSocketEvent(
+                              handles[i],
+                              EventType::e_READ,
+                              bdlf::BindUtil::bind(&countCb, numInvocations)));
+    }
+}
+
+void acceptCb(btlso::SocketHandle::Handle  listener,
+              int                         *numAccepted)
+    // Accept one connection on the specified 'listener', close it, and
+    // increment the specified 'numAccepted'.
+{
+    int fd = ::accept(listener, 0, 0);
+    ASSERT(0 <= fd);
+    if (0 <= fd) {
+        ::close(fd);
+        ++*numAccepted;
+    }
+}
+
+int raiseFileLimit(int numFds)
+    // Raise the soft limit on the number of open file descriptors of this
+    // process to at least the specified 'numFds', if the hard limit allows.
+    // Return the resulting soft limit.
+{
+    struct rlimit limit;
+    if (0 != ::getrlimit(RLIMIT_NOFILE, &limit)) {
+        return 0;                                                     // RETURN
+    }
+    if (limit.rlim_cur < static_cast<rlim_t>(numFds)) {
+        limit.rlim_cur = bsl::min(limit.rlim_max,
+                                  static_cast<rlim_t>(numFds));
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+        ::getrlimit(RLIMIT_NOFILE, &limit);
+    }
+    return static_cast<int>(limit.rlim_cur);
+}
+
+int openPairs(bsl::vector<btlso::SocketHandle::Handle> *observed,
+              bsl::vector<btlso::SocketHandle::Handle> *control,
+              int                                       numPairs)
+    // Append to the specified 'observed' and 'control' the two ends of the
+    // specified 'numPairs' connected pairs of local sockets, the 'observed'
+    // end being non-blocking.  Return the number of pairs opened.
+{
+    for (int i = 0; i < numPairs; ++i) {
+        int fds[2];
+        if (0 != ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds)) {
+            return i;                                                 // RETURN
+        }
+        btlso::IoUtil::setBlockingMode(fds[0], btlso::IoUtil::e_NONBLOCKING);
+        observed->push_back(fds[0]);
+        control->push_back(fds[1]);
+    }
+    return numPairs;
+}
+
+void closeAll(const bsl::vector<btlso::SocketHandle::Handle>& handles)
+    // Close each of the specified 'handles'.
+{
+    for (bsl::size_t i = 0; i < handles.size(); ++i) {
+        ::close(handles[i]);
+    }
+}
+
+template <class MANAGER>
+double measureIdleDispatch(int numPairs, int numActive, int numIterations)
+    // Return the average time, in microseconds, taken by a 'MANAGER' to
+    // dispatch 'numActive' read events among the read events registered for
+    // the specified 'numPairs' connections, the others being idle, over the
+    // specified 'numIterations'.  Return a negative value if not enough
+    // sockets could be opened.
+{
+    bsl::vector<btlso::SocketHandle::Handle> observed, control;
+    if (numPairs != openPairs(&observed, &control, numPairs)) {
+        closeAll(observed);
+        closeAll(control);
+        return -1;                                                    // RETURN
+    }
+
+    MANAGER mX;
+    int     numBytesRead = 0;
+    for (int i = 0; i < numPairs; ++i) {
+        mX.registerSocketEvent(observed[i],
+                               EventType::e_READ,
+                               bdlf::BindUtil::bind(&drainCb,
+                                                    observed[i],
+                                                    &numBytesRead));
+    }
+
+    const char     byte     = 'x';
+    const int      stride   = numPairs / numActive;
+    bsls::Stopwatch stopwatch;
+
+    for (int iter = 0; iter < numIterations; ++iter) {
+        for (int i = 0; i < numActive; ++i) {
+            const int index = (i * stride + iter) % numPairs;
+            ::write(control[index], &byte, 1);
+        }
+
+        stopwatch.start();
+        int numDispatched = 0;
+        while (numDispatched < numActive) {
+            const int rc = mX.dispatch(0);
+            BSLS_ASSERT_OPT(0 < rc);
+            numDispatched += rc;
+        }
+        stopwatch.stop();
+    }
+
+    mX.deregisterAll();
+    closeAll(observed);
+    closeAll(control);
+
+    return stopwatch.elapsedTime() * 1e6 / numIterations;
+}
+
+}  // close unnamed namespace
+
+#endif  // BTLSO_EVENTMANAGER_ENABLETEST
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+#ifdef BTLSO_EVENTMANAGER_ENABLETEST
+    const int  test        = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose     = argc > 2;
+    const bool veryVerbose = argc > 3;
+    const bool veryVeryVerbose = argc > 4;
+
+    int controlFlag = 0;
+    if (veryVeryVerbose) {
+        controlFlag |= EventManagerTester::k_VERY_VERY_VERBOSE;
+    }
+    if (veryVerbose) {
+        controlFlag |= EventManagerTester::k_VERY_VERBOSE;
+    }
+    if (verbose) {
+        controlFlag |= EventManagerTester::k_VERBOSE;
+    }
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    btlso::SocketImpUtil::startup();
+
+    bslma::TestAllocator testAllocator("test", veryVeryVerbose);
+    btlso::TimeMetrics   timeMetric(btlso::TimeMetrics::e_MIN_NUM_CATEGORIES,
+                                    btlso::TimeMetrics::e_CPU_BOUND,
+                                    &testAllocator);
+
+    bslma::TestAllocator         defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard defaultAllocatorGuard(&defaultAllocator);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Example 1: Draining a Socket on Each Notification
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+        btlso::DefaultEventManager<btlso::Platform::EPOLL_EDGE> mX;
+
+        btlso::SocketHandle::Handle socket[2];
+        int rc = btlso::SocketImpUtil::socketPair<btlso::IPv4Address>(
+                                        socket,
+                                        btlso::SocketImpUtil::k_SOCKET_STREAM);
+        ASSERT(0 == rc);
+
+        rc = btlso::IoUtil::setBlockingMode(socket[1],
+                                            btlso::IoUtil::e_NONBLOCKING);
+        ASSERT(0 == rc);
+
+        int                           numBytesRead = 0;
+        btlso::EventManager::Callback readCb(bdlf::BindUtil::bind(
+                                                             &drainCb,
+                                                             socket[1],
+                                                             &numBytesRead));
+        rc = mX.registerSocketEvent(socket[1],
+                                    btlso::EventType::e_READ,
+                                    readCb);
+        ASSERT(0 == rc);
+
+        char data[100] = { 0 };
+        rc = btlso::SocketImpUtil::write(socket[0], data, sizeof data);
+        ASSERT(static_cast<int>(sizeof data) == rc);
+
+        bsls::TimeInterval deadline = bdlt::CurrentTime::now() + 1;
+        rc = mX.dispatch(deadline, 0);
+        ASSERT(1   == rc);
+        ASSERT(100 == numBytesRead);
+
+        deadline = bdlt::CurrentTime::now() + bsls::TimeInterval(0, 50000000);
+        rc = mX.dispatch(deadline, 0);
+        ASSERT(0 == rc);
+
+        mX.deregisterAll();
+        btlso::SocketImpUtil::close(socket[0]);
+        btlso::SocketImpUtil::close(socket[1]);
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // LEVEL-TRIGGERED ACCEPT EVENTS
+        //
+        // Concerns:
+        //: 1 An accept event is reported for as long as connections are
+        //:   pending, even if the callback accepts only one of them.
+        //:
+        //: 2 An accept event can be deregistered, and re-registered.
+        //
+        // Plan:
+        //: 1 Create a listening socket, connect three clients to it, and
+        //:   register an accept callback accepting one connection per
+        //:   invocation.  Verify that three successive dispatches each
+        //:   invoke the callback, and that a fourth one times out.  (C-1)
+        //:
+        //: 2 Deregister and re-register the accept event, connect one more
+        //:   client, and verify that it is accepted.  (C-2)
+        //
+        // Testing:
+        //   LEVEL-TRIGGERED ACCEPT EVENTS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "LEVEL-TRIGGERED ACCEPT EVENTS" << endl
+                          << "=============================" << endl;
+
+        int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT(0 <= listener);
+
+        struct sockaddr_in address;
+        bsl::memset(&address, 0, sizeof address);
+        address.sin_family      = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port        = 0;
+
+        ASSERT(0 == ::bind(listener,
+                           reinterpret_cast<struct sockaddr *>(&address),
+                           sizeof address));
+        ASSERT(0 == ::listen(listener, 16));
+
+        socklen_t addressLength = sizeof address;
+        ASSERT(0 == ::getsockname(
+                                listener,
+                                reinterpret_cast<struct sockaddr *>(&address),
+                                &addressLength));
+
+        bsl::vector<int> clients;
+        for (int i = 0; i < 3; ++i) {
+            int client = ::socket(AF_INET, SOCK_STREAM, 0);
+            ASSERT(0 == ::connect(
+                                client,
+                                reinterpret_cast<struct sockaddr *>(&address),
+                                sizeof address));
+            clients.push_back(client);
+        }
+
+        Obj mX(&timeMetric, &testAllocator);
+
+        int numAccepted = 0;
+        ASSERT(0 == mX.registerSocketEvent(
+                              listener,
+                              EventType::e_ACCEPT,
+                              bdlf::BindUtil::bind(&acceptCb,
+                                                   listener,
+                                                   &numAccepted)));
+        ASSERT(1 == mX.numEvents());
+
+        for (int i = 1; i <= 3; ++i) {
+            bsls::TimeInterval deadline = bdlt::CurrentTime::now() + 1;
+            LOOP_ASSERT(i, 1 == mX.dispatch(deadline, 0));
+            LOOP_ASSERT(i, i == numAccepted);
+        }
+        {
+            bsls::TimeInterval deadline = bdlt::CurrentTime::now()
+                                        + bsls::TimeInterval(0, 50000000);
+            ASSERT(0 == mX.dispatch(deadline, 0));
+        }
+
+        mX.deregisterSocketEvent(listener, EventType::e_ACCEPT);
+        ASSERT(0 == mX.numEvents());
+        ASSERT(0 == mX.registerSocketEvent(
+                              listener,
+                              EventType::e_ACCEPT,
+                              bdlf::BindUtil::bind(&acceptCb,
+                                                   listener,
+                                                   &numAccepted)));
+        {
+            int client = ::socket(AF_INET, SOCK_STREAM, 0);
+            ASSERT(0 == ::connect(
+                                client,
+                                reinterpret_cast<struct sockaddr *>(&address),
+                                sizeof address));
+            clients.push_back(client);
+
+            bsls::TimeInterval deadline = bdlt::CurrentTime::now() + 1;
+            ASSERT(1 == mX.dispatch(deadline, 0));
+            ASSERT(4 == numAccepted);
+        }
+
+        ASSERT(1 == mX.deregisterSocket(listener));
+        closeAll(clients);
+        ::close(listener);
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // DISPATCHING MORE THAN ONE BATCH
+        //
+        // Concerns:
+        //: 1 When more than 'k_MAX_BATCH_SIZE' sockets are ready, a single
+        //:   'dispatch' invokes the callbacks of all of them (up to
+        //:   'k_MAX_NUM_BATCHES' batches).
+        //:
+        //: 2 Each ready socket is reported exactly once.
+        //
+        // Plan:
+        //: 1 Open '2 * k_MAX_BATCH_SIZE + 10' socket pairs (raising the limit
+        //:   on open files if necessary), register a draining read callback
+        //:   for each, and write one byte on each.  Verify that one 'dispatch'
+        //:   invokes every callback once, and that a subsequent 'dispatch'
+        //:   times out.  (C-1..2)
+        //
+        // Testing:
+        //   DISPATCHING MORE THAN ONE BATCH
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DISPATCHING MORE THAN ONE BATCH" << endl
+                          << "===============================" << endl;
+
+        const int NUM_PAIRS = 2 * Obj::k_MAX_BATCH_SIZE + 10;
+
+        if (raiseFileLimit(2 * NUM_PAIRS + 64) < 2 * NUM_PAIRS + 64) {
+            if (verbose) cout << "\tNot enough file descriptors; skipped."
+                              << endl;
+            break;
+        }
+
+        bsl::vector<btlso::SocketHandle::Handle> observed, control;
+        ASSERT(NUM_PAIRS == openPairs(&observed, &control, NUM_PAIRS));
+
+        Obj mX(&timeMetric, &testAllocator);
+
+        bsl::vector<int> numBytesRead(NUM_PAIRS, 0);
+        for (int i = 0; i < NUM_PAIRS; ++i) {
+            ASSERT(0 == mX.registerSocketEvent(
+                                   observed[i],
+                                   EventType::e_READ,
+                                   bdlf::BindUtil::bind(&drainCb,
+                                                        observed[i],
+                                                        &numBytesRead[i])));
+        }
+        ASSERT(NUM_PAIRS == mX.numEvents());
+
+        const char byte = 'x';
+        for (int i = 0; i < NUM_PAIRS; ++i) {
+            ASSERT(1 == ::write(control[i], &byte, 1));
+        }
+
+        bsls::TimeInterval deadline = bdlt::CurrentTime::now() + 1;
+        const int rc = mX.dispatch(deadline, 0);
+        LOOP_ASSERT(rc, NUM_PAIRS == rc);
+
+        for (int i = 0; i < NUM_PAIRS; ++i) {
+            LOOP_ASSERT(i, 1 == numBytesRead[i]);
+        }
+
+        deadline = bdlt::CurrentTime::now() + bsls::TimeInterval(0, 50000000);
+        ASSERT(0 == mX.dispatch(deadline, 0));
+
+        mX.deregisterAll();
+        ASSERT(0 == mX.numEvents());
+
+        closeAll(observed);
+        closeAll(control);
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CALLBACKS CHANGING REGISTRATIONS
+        //
+        // Concerns:
+        //: 1 A callback can deregister itself while it is being invoked.
+        //:
+        //: 2 A callback can replace itself while it is being invoked, and the
+        //:   replacement is invoked on the next event.
+        //:
+        //: 3 A callback can deregister all events, including those of sockets
+        //:   that are ready in the same batch, whose callbacks are then not
+        //:   invoked.
+        //:
+        //: 4 A callback can register events for many sockets, growing the
+        //:   table of registrations, while it is being invoked.
+        //
+        // Plan:
+        //: 1 Perform each operation from a callback bound to arguments that
+        //:   allocate, and verify the number of invocations and the state of
+        //:   the event manager afterwards.  (C-1..4)
+        //
+        // Testing:
+        //   CALLBACKS CHANGING REGISTRATIONS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CALLBACKS CHANGING REGISTRATIONS" << endl
+                          << "================================" << endl;
+
+        const char         byte = 'x';
+        bsls::TimeInterval shortWait(0, 50000000);
+
+        if (verbose) cout << "\tDeregistering itself." << endl;
+        {
+            TestPair pair;
+            Obj      mX(&timeMetric, &testAllocator);
+
+            int numInvocations = 0;
+            ASSERT(0 == mX.registerSocketEvent(
+                                    pair.observedFd(),
+                                    EventType::e_READ,
+                                    bdlf::BindUtil::bind(&deregisterSelfCb,
+                                                         &mX,
+                                                         pair.observedFd(),
+                                                         &numInvocations)));
+
+            ASSERT(1 == ::write(pair.controlFd(), &byte, 1));
+            ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(1 == numInvocations);
+            ASSERT(0 == mX.numEvents());
+            ASSERT(0 == mX.isRegistered(pair.observedFd(), EventType::e_READ));
+        }
+
+        if (verbose) cout << "\tReplacing itself." << endl;
+        {
+            TestPair pair;
+            Obj      mX(&timeMetric, &testAllocator);
+
+            int numReplacementInvocations = 0;
+            int numBytesRead              = 0;
+            int numInvocations            = 0;
+
+            btlso::EventManager::Callback replacement(
+                                bsl::allocator_arg_t(),
+                                &testAllocator,
+                            bdlf::BindUtil::bind(&readCb,
+                                                 pair.observedFd(),
+                                                 1,
+                                                 &numReplacementInvocations,
+                                                 &numBytesRead));
+
+            ASSERT(0 == mX.registerSocketEvent(
+                                    pair.observedFd(),
+                                    EventType::e_READ,
+                                    bdlf::BindUtil::bind(&replaceSelfCb,
+                                                         &mX,
+                                                         pair.observedFd(),
+                                                         &numInvocations,
+                                                         replacement)));
+
+            // The original callback does not read, but replacing it re-arms
+            // the socket, so the replacement is invoked next.
+
+            ASSERT(1 == ::write(pair.controlFd(), &byte, 1));
+            ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(1 == numInvocations);
+            ASSERT(0 == numReplacementInvocations);
+            ASSERT(1 == mX.numEvents());
+
+            ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(1 == numInvocations);
+            ASSERT(1 == numReplacementInvocations);
+            ASSERT(1 == numBytesRead);
+        }
+
+        if (verbose) cout << "\tDeregistering all." << endl;
+        {
+            TestPair pairs[3];
+            Obj      mX(&timeMetric, &testAllocator);
+
+            int numInvocations = 0;
+            for (int i = 0; i < 3; ++i) {
+                ASSERT(0 == mX.registerSocketEvent(
+                                     pairs[i].observedFd(),
+                                     EventType::e_READ,
+                                     bdlf::BindUtil::bind(&deregisterAllCb,
+                                                          &mX,
+                                                          &numInvocations)));
+                ASSERT(1 == ::write(pairs[i].controlFd(), &byte, 1));
+            }
+            ASSERT(3 == mX.numEvents());
+
+            ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(1 == numInvocations);
+            ASSERT(0 == mX.numEvents());
+        }
+
+        if (verbose) cout << "\tGrowing the table." << endl;
+        {
+            TestPair pair;
+            Obj      mX(&timeMetric, &testAllocator);
+
+            bsl::vector<btlso::SocketHandle::Handle> observed(&testAllocator);
+            bsl::vector<btlso::SocketHandle::Handle> control(&testAllocator);
+            ASSERT(100 == openPairs(&observed, &control, 100));
+
+            int numInvocations = 0;
+            ASSERT(0 == mX.registerSocketEvent(
+                                      pair.observedFd(),
+                                      EventType::e_READ,
+                                      bdlf::BindUtil::bind(&registerManyCb,
+                                                           &mX,
+                                                           observed,
+                                                           &numInvocations)));
+
+            ASSERT(1 == ::write(pair.controlFd(), &byte, 1));
+            ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(1 == numInvocations);
+            ASSERT(101 == mX.numEvents());
+
+            ASSERT(1 == ::write(control[99], &byte, 1));
+            ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(2 == numInvocations);
+
+            mX.deregisterAll();
+            closeAll(observed);
+            closeAll(control);
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'dispatch'
+        //
+        // Concerns:
+        //: 1 A read event is reported once when data arrives, and not again
+        //:   until more data arrives, even if data remains unread.
+        //:
+        //: 2 Registering a second event, deregistering one of two events, and
+        //:   re-registering an event re-arm the socket.
+        //:
+        //: 3 A write event is reported when the socket becomes writable, and
+        //:   again when space becomes available after the send buffer was
+        //:   filled.
+        //:
+        //: 4 'dispatch' returns 0 on timeout, whether or not events are
+        //:   registered, and 'dispatch(int)' returns 0 if no event is
+        //:   registered.
+        //:
+        //: 5 Time spent waiting is reported as IO-bound.
+        //
+        // Plan:
+        //: 1 Using a socket pair, write data to the control end, and read
+        //:   only part of it from the observed end in the callback.  Verify
+        //:   the number of invocations through successive dispatches and
+        //:   writes.  (C-1)
+        //:
+        //: 2 Leave data unread, and verify that each of the operations
+        //:   re-arming the socket leads to one more invocation.  (C-2)
+        //:
+        //: 3 Register a write callback on one end of a local socket pair,
+        //:   fill the buffer, drain it from the other end, and verify the
+        //:   invocations.  (C-3)
+        //:
+        //: 4 Dispatch with short timeouts.  (C-4)
+        //:
+        //: 5 Verify that time metrics reflect the time spent waiting.  (C-5)
+        //
+        // Testing:
+        //   int dispatch(const bsls::TimeInterval&, int);
+        //   int dispatch(int);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'dispatch'" << endl
+                          << "==================" << endl;
+
+        const char         data[16] = { 0 };
+        bsls::TimeInterval shortWait(0, 50000000);
+
+        if (verbose) cout << "\tRead events are edge-triggered." << endl;
+        {
+            TestPair pair;
+            Obj      mX(&timeMetric, &testAllocator);
+
+            int numInvocations = 0;
+            int numBytesRead   = 0;
+            ASSERT(0 == mX.registerSocketEvent(
+                                      pair.observedFd(),
+                                      EventType::e_READ,
+                                      bdlf::BindUtil::bind(&readCb,
+                                                           pair.observedFd(),
+                                                           4,
+                                                           &numInvocations,
+                                                           &numBytesRead)));
+
+            ASSERT(16 == ::write(pair.controlFd(), data, 16));
+            ASSERT(1  == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(1  == numInvocations);
+            ASSERT(4  == numBytesRead);
+
+            // 12 bytes remain unread, but no new data arrived.
+
+            ASSERT(0 == mX.dispatch(bdlt::CurrentTime::now() + shortWait, 0));
+            ASSERT(1 == numInvocations);
+
+            ASSERT(1 == ::write(pair.controlFd(), data, 1));
+            ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(2 == numInvocations);
+            ASSERT(8 == numBytesRead);
+
+            if (verbose) cout << "\tRe-arming." << endl;
+
+            // Re-registering the same event re-arms the socket.
+
+            ASSERT(0 == mX.registerSocketEvent(
+                                      pair.observedFd(),
+                                      EventType::e_READ,
+                                      bdlf::BindUtil::bind(&readCb,
+                                                           pair.observedFd(),
+                                                           4,
+                                                           &numInvocations,
+                                                           &numBytesRead)));
+            ASSERT(1 == mX.numEvents());
+            ASSERT(1  == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(3  == numInvocations);
+            ASSERT(12 == numBytesRead);
+
+            // Registering, and then deregistering, a write event re-arms the
+            // socket.
+
+            int numWrites = 0;
+            ASSERT(0 == mX.registerSocketEvent(
+                                  pair.observedFd(),
+                                  EventType::e_WRITE,
+                                  bdlf::BindUtil::bind(&countCb, &numWrites)));
+            ASSERT(2 == mX.numEvents());
+            ASSERT(2 == mX.numSocketEvents(pair.observedFd()));
+
+            ASSERT(2  == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(4  == numInvocations);
+            ASSERT(1  == numWrites);
+            ASSERT(16 == numBytesRead);
+
+            ASSERT(1 == ::write(pair.controlFd(), data, 1));
+            mX.deregisterSocketEvent(pair.observedFd(), EventType::e_WRITE);
+            ASSERT(1 == mX.numEvents());
+
+            ASSERT(1  == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(5  == numInvocations);
+            ASSERT(1  == numWrites);
+            LOOP_ASSERT(numBytesRead, 18 == numBytesRead);
+
+            ASSERT(0 == mX.dispatch(bdlt::CurrentTime::now() + shortWait, 0));
+            ASSERT(5 == numInvocations);
+        }
+
+        if (verbose) cout << "\tWrite events are edge-triggered." << endl;
+        {
+            // Use a local socket pair: on a TCP connection, the space freed
+            // when data is transmitted would make the socket writable again.
+
+            bsl::vector<btlso::SocketHandle::Handle> observed(&testAllocator);
+            bsl::vector<btlso::SocketHandle::Handle> control(&testAllocator);
+            ASSERT(1 == openPairs(&observed, &control, 1));
+
+            Obj mX(&timeMetric, &testAllocator);
+
+            int numWrites = 0;
+            ASSERT(0 == mX.registerSocketEvent(
+                                  observed[0],
+                                  EventType::e_WRITE,
+                                  bdlf::BindUtil::bind(&countCb, &numWrites)));
+
+            ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(1 == numWrites);
+
+            // The socket remains writable, but is not reported again.
+
+            ASSERT(0 == mX.dispatch(bdlt::CurrentTime::now() + shortWait, 0));
+            ASSERT(1 == numWrites);
+
+            // Fill the send buffer, then drain it from the other end.
+
+            char buffer[1024] = { 0 };
+            int  numWritten   = 0;
+            int  rc;
+            while (0 < (rc = btlso::SocketImpUtil::write(observed[0],
+                                                         buffer,
+                                                         sizeof buffer))) {
+                numWritten += rc;
+            }
+            ASSERT(0 < numWritten);
+
+            ASSERT(0 == mX.dispatch(bdlt::CurrentTime::now() + shortWait, 0));
+            ASSERT(1 == numWrites);
+
+            while (0 < numWritten) {
+                rc = btlso::SocketImpUtil::read(buffer,
+                                                control[0],
+                                                sizeof buffer);
+                ASSERT(0 < rc);
+                if (0 >= rc) {
+                    break;
+                }
+                numWritten -= rc;
+            }
+
+            ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+            ASSERT(2 == numWrites);
+
+            mX.deregisterAll();
+            closeAll(observed);
+            closeAll(control);
+        }
+
+        if (verbose) cout << "\tTimeouts." << endl;
+        {
+            Obj mX(&timeMetric, &testAllocator);
+
+            ASSERT(0 == mX.dispatch(0));
+
+            for (int i = 0; i < 10; ++i) {
+                bsls::TimeInterval deadline = bdlt::CurrentTime::now();
+                deadline.addMilliseconds(i);
+
+                LOOP_ASSERT(i, 0 == mX.dispatch(
+                                             deadline,
+                                             btlso::Flags::k_ASYNC_INTERRUPT));
+                LOOP_ASSERT(i, deadline <= bdlt::CurrentTime::now());
+            }
+
+            TestPair pair;
+            int      numInvocations = 0;
+            ASSERT(0 == mX.registerSocketEvent(
+                             pair.observedFd(),
+                             EventType::e_READ,
+                             bdlf::BindUtil::bind(&countCb, &numInvocations)));
+
+            for (int i = 0; i < 10; ++i) {
+                bsls::TimeInterval deadline = bdlt::CurrentTime::now();
+                deadline.addMilliseconds(i);
+
+                LOOP_ASSERT(i, 0 == mX.dispatch(
+                                             deadline,
+                                             btlso::Flags::k_ASYNC_INTERRUPT));
+                LOOP_ASSERT(i, deadline <= bdlt::CurrentTime::now());
+            }
+            ASSERT(0 == numInvocations);
+        }
+
+        if (verbose) cout << "\tTime metrics." << endl;
+        {
+            btlso::TimeMetrics metrics(
+                                     btlso::TimeMetrics::e_MIN_NUM_CATEGORIES,
+                                     btlso::TimeMetrics::e_CPU_BOUND,
+                                     &testAllocator);
+
+            Obj      mX(&metrics, &testAllocator);
+            TestPair pair;
+            int      numInvocations = 0;
+            ASSERT(0 == mX.registerSocketEvent(
+                             pair.observedFd(),
+                             EventType::e_READ,
+                             bdlf::BindUtil::bind(&countCb, &numInvocations)));
+
+            ASSERT(0 == mX.dispatch(bdlt::CurrentTime::now() + shortWait, 0));
+
+            if (veryVerbose) {
+                P(metrics.percentage(btlso::TimeMetrics::e_IO_BOUND));
+            }
+            ASSERT(50 < metrics.percentage(btlso::TimeMetrics::e_IO_BOUND));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING REGISTRATION
+        //
+        // Concerns:
+        //: 1 The manipulators adhere to the 'btlso::EventManager' protocol.
+        //:
+        //: 2 A failed registration (e.g., of an invalid handle) has no effect.
+        //:
+        //: 3 Registering and deregistering sockets many more times than there
+        //:   are file descriptors does not grow the event manager.
+        //
+        // Plan:
+        //: 1 Run the canned tests of 'btlso::EventManagerTester'.  (C-1)
+        //:
+        //: 2 Register events for a closed handle and for a negative handle,
+        //:   and verify that registration fails and that the accessors are
+        //:   unaffected.  (C-2)
+        //:
+        //: 3 Repeatedly open a socket, register and deregister it, and close
+        //:   it, then verify that a 'dispatch' times out and that the memory
+        //:   in use is bounded.  (C-3)
+        //
+        // Testing:
+        //   int registerSocketEvent(handle, event, callback);
+        //   void deregisterSocketEvent(handle, event);
+        //   int deregisterSocket(handle);
+        //   void deregisterAll();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING REGISTRATION" << endl
+                          << "====================" << endl;
+
+        if (verbose) cout << "\tStandard tests." << endl;
+        {
+            Obj mX(&timeMetric, &testAllocator);
+            ASSERT(0 == EventManagerTester::testRegisterSocketEvent(
+                                                                 &mX,
+                                                                 controlFlag));
+        }
+        {
+            Obj mX(&timeMetric, &testAllocator);
+            ASSERT(0 == EventManagerTester::testDeregisterSocketEvent(
+                                                                 &mX,
+                                                                 controlFlag));
+        }
+        {
+            Obj mX(&timeMetric, &testAllocator);
+            ASSERT(0 == EventManagerTester::testDeregisterSocket(
+                                                                 &mX,
+                                                                 controlFlag));
+        }
+        {
+            Obj mX(&timeMetric, &testAllocator);
+            ASSERT(0 == EventManagerTester::testDeregisterAll(&mX,
+                                                              controlFlag));
+        }
+
+        if (verbose) cout << "\tFailed registrations." << endl;
+        {
+            Obj mX(&timeMetric, &testAllocator);
+
+            int numInvocations = 0;
+            btlso::EventManager::Callback cb(bdlf::BindUtil::bind(
+                                                           &countCb,
+                                                           &numInvocations));
+
+            int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            ASSERT(0 <= fd);
+            ::close(fd);
+
+            ASSERT(0 != mX.registerSocketEvent(fd, EventType::e_READ, cb));
+            ASSERT(0 == mX.numEvents());
+            ASSERT(0 == mX.numSocketEvents(fd));
+            ASSERT(0 == mX.isRegistered(fd, EventType::e_READ));
+
+            ASSERT(0 != mX.registerSocketEvent(-1, EventType::e_READ, cb));
+            ASSERT(0 == mX.numEvents());
+            ASSERT(0 == mX.numSocketEvents(-1));
+        }
+
+        if (verbose) cout << "\tRepeated registrations." << endl;
+        {
+            enum { k_NUM_ITERATIONS = 10000 };
+
+            Obj mX(&timeMetric, &testAllocator);
+
+            bsls::Types::Int64 numBytesInUse = -1;
+            for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+                int fd = ::socket(PF_INET, SOCK_STREAM, 0);
+                BSLS_ASSERT_OPT(fd != -1);
+
+                int numInvocations = 0;
+                mX.registerSocketEvent(
+                             fd,
+                             EventType::e_READ,
+                             bdlf::BindUtil::bind(&countCb, &numInvocations));
+                mX.deregisterSocket(fd);
+                ::close(fd);
+
+                if (0 == i) {
+                    numBytesInUse = testAllocator.numBytesInUse();
+                }
+            }
+            ASSERT(numBytesInUse == testAllocator.numBytesInUse());
+            ASSERT(0 == mX.numEvents());
+
+            ASSERT(0 == mX.dispatch(bdlt::CurrentTime::now()
+                                    + bsls::TimeInterval(0, 10000000),
+                                    0));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 A newly-created event manager has no registered events.
+        //:
+        //: 2 The accessors reflect the registered events.
+        //:
+        //: 3 Memory is supplied by the specified allocator.
+        //
+        // Plan:
+        //: 1 Create an event manager, and verify its initial state.  (C-1)
+        //:
+        //: 2 Run the canned accessor test of 'btlso::EventManagerTester'.
+        //:   (C-2)
+        //:
+        //: 3 Register an event, and verify that the memory comes from the
+        //:   supplied allocator, and is released on destruction.  (C-3)
+        //
+        // Testing:
+        //   DefaultEventManager(TimeMetrics *, bslma::Allocator *);
+        //   ~DefaultEventManager();
+        //   bool hasLimitedSocketCapacity() const;
+        //   int isRegistered(handle, event) const;
+        //   int numEvents() const;
+        //   int numSocketEvents(handle) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CREATORS AND ACCESSORS" << endl
+                          << "==============================" << endl;
+
+        {
+            Obj mX(&timeMetric, &testAllocator);  const Obj& X = mX;
+
+            ASSERT(0     == X.numEvents());
+            ASSERT(false == X.hasLimitedSocketCapacity());
+            ASSERT(0     == X.numSocketEvents(0));
+            ASSERT(0     == X.isRegistered(0, EventType::e_READ));
+        }
+        {
+            Obj mX(&timeMetric, &testAllocator);
+            ASSERT(0 == EventManagerTester::testAccessors(&mX, controlFlag));
+        }
+        {
+            bslma::TestAllocator ta("object", veryVeryVerbose);
+            {
+                TestPair pair;
+
+                const bsls::Types::Int64 NUM_DEFAULT_BLOCKS =
+                                             defaultAllocator.numBlocksTotal();
+
+                Obj mX(&timeMetric, &ta);
+
+                int numInvocations = 0;
+                ASSERT(0 == mX.registerSocketEvent(
+                             pair.observedFd(),
+                             EventType::e_READ,
+                             bdlf::BindUtil::bind(&countCb, &numInvocations)));
+                ASSERT(0 < ta.numBlocksInUse());
+
+                ASSERT(NUM_DEFAULT_BLOCKS == defaultAllocator.numBlocksTotal());
+            }
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic
+        //   functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Register read and write events on a socket pair, dispatch, and
+        //:   deregister them.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   static bool isSupported();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        ASSERT(Obj::isSupported());
+
+        TestPair pair;
+        Obj      mX(&timeMetric, &testAllocator);
+
+        int numBytesRead = 0;
+        int numWrites    = 0;
+
+        ASSERT(0 == mX.registerSocketEvent(
+                                       pair.observedFd(),
+                                       EventType::e_READ,
+                                       bdlf::BindUtil::bind(&drainCb,
+                                                            pair.observedFd(),
+                                                            &numBytesRead)));
+        ASSERT(0 == mX.registerSocketEvent(
+                                  pair.controlFd(),
+                                  EventType::e_WRITE,
+                                  bdlf::BindUtil::bind(&countCb, &numWrites)));
+        ASSERT(2 == mX.numEvents());
+
+        ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+        ASSERT(1 == numWrites);
+        ASSERT(0 == numBytesRead);
+
+        ASSERT(5 == ::write(pair.controlFd(), "hello", 5));
+
+        ASSERT(1 == mX.dispatch(bdlt::CurrentTime::now() + 1, 0));
+        ASSERT(5 == numBytesRead);
+
+        ASSERT(1 == mX.deregisterSocket(pair.controlFd()));
+        mX.deregisterSocketEvent(pair.observedFd(), EventType::e_READ);
+        ASSERT(0 == mX.numEvents());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: MANY IDLE CONNECTIONS
+        //   Compare the cost of dispatching a few active connections among
+        //   many idle ones with that of the level-triggered 'epoll' manager.
+        //
+        // Plan:
+        //: 1 For each of several numbers of connections (or for the number
+        //:   specified as the second argument), register a draining read
+        //:   callback on every connection, write one byte to 1% of them (at
+        //:   least one), and measure the time taken to dispatch all of the
+        //:   resulting events, averaged over a number of iterations.
+        //
+        // Testing:
+        //   PERFORMANCE: MANY IDLE CONNECTIONS
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE: MANY IDLE CONNECTIONS" << endl
+             << "==================================" << endl;
+
+        const int NUM_ITERATIONS = 1000;
+
+        bsl::vector<int> numPairs;
+        if (argc > 2 && 0 < atoi(argv[2])) {
+            numPairs.push_back(atoi(argv[2]));
+        }
+        else {
+            numPairs.push_back(100);
+            numPairs.push_back(1000);
+            numPairs.push_back(10000);
+            numPairs.push_back(50000);
+        }
+
+        cout << "connections  active   epoll (us)  epoll edge (us)" << endl;
+        for (bsl::size_t i = 0; i < numPairs.size(); ++i) {
+            const int NUM_PAIRS  = numPairs[i];
+            const int NUM_ACTIVE = bsl::max(1, NUM_PAIRS / 100);
+
+            if (raiseFileLimit(2 * NUM_PAIRS + 64) < 2 * NUM_PAIRS + 64) {
+                cout << NUM_PAIRS << ": not enough file descriptors" << endl;
+                continue;
+            }
+
+            const double LEVEL = measureIdleDispatch<
+                      btlso::DefaultEventManager<btlso::Platform::EPOLL> >(
+                                                               NUM_PAIRS,
+                                                               NUM_ACTIVE,
+                                                               NUM_ITERATIONS);
+            const double EDGE = measureIdleDispatch<Obj>(NUM_PAIRS,
+                                                         NUM_ACTIVE,
+                                                         NUM_ITERATIONS);
+
+            cout << NUM_PAIRS << "\t     " << NUM_ACTIVE << "\t      "
+                 << LEVEL << "\t  " << EDGE << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      } break;
+    }
+
+    btlso::SocketImpUtil::cleanup();
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+#else
+    return -1;
+#endif  // BTLSO_EVENTMANAGER_ENABLETEST
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -40,6 +40,12 @@ BSLS_IDENT("$Id: $")
 // platforms, a significant performance improvement can be achieved if the
 // registrations are infrequent.  For this situation, the currently installed
 // hint should be provided to this event manager for optimal performance.
+// Applications whose read and write callbacks consume all available data (or
+// fill all available space) on each invocation, and which monitor many mostly
+// idle sockets, can provide the 'e_EDGE_TRIGGERED' hint, which selects
+// 'btlso::DefaultEventManager<btlso::Platform::EPOLL_EDGE>' on Linux (see
+// 'btlso_defaulteventmanager_epolledge'), and is equivalent to 'e_NO_HINT' on
+// other platforms.
 //
 // When callbacks are being dispatched (through the 'dispatch' method) priority
 // is given to callbacks associated with socket events.  The timer- related
@@ -290,9 +296,10 @@ class TcpTimerEventManager : public TimerEventManager
   public:
     enum Hint {
         e_NO_HINT,                 // the registrations may be frequent
-        e_INFREQUENT_REGISTRATION  // the (de)registrations will be infrequent
-
-
+        e_INFREQUENT_REGISTRATION, // the (de)registrations will be infrequent
+        e_EDGE_TRIGGERED           // the read and write callbacks consume all
+                                   // available data (space) on each
+                                   // invocation, and many sockets may be idle
     };
 
   private:
@@ -9,6 +9,7 @@
 
 #include <btlso_tcptimereventmanager.h>
 
+#include <btlso_defaulteventmanager.h>
 #include <btlso_flags.h>
 #include <btlso_socketimputil.h>
 
@@ -1210,6 +1211,28 @@ int main(int argc, char *argv[])
             ASSERT(btlso::TimeMetrics::e_CPU_BOUND ==
                    metrics->currentCategory());
             }
+
+            {
+            bslma::TestAllocator testAllocator;
+            Obj mX(btlso::TcpTimerEventManager::e_EDGE_TRIGGERED,
+                   &testAllocator); const Obj& X = mX;
+
+            ASSERT(0 != testAllocator.numAllocations());
+            const btlso::EventManager *eventManager = X.socketEventManager();
+            ASSERT(eventManager); ASSERT(0 == eventManager->numEvents());
+#if defined(BSLS_PLATFORM_OS_LINUX)
+            ASSERT(0 != dynamic_cast<const btlso::DefaultEventManager<
+                                     btlso::Platform::EPOLL_EDGE> *>(
+                                                                eventManager));
+#endif
+            ASSERT(0 == X.numEvents()); ASSERT(0 == X.numTimers());
+            btlso::TimeMetrics *metrics = mX.timeMetrics();
+            ASSERT(metrics);
+            ASSERT(btlso::TimeMetrics::e_MIN_NUM_CATEGORIES
+                   == metrics->numCategories());
+            ASSERT(btlso::TimeMetrics::e_CPU_BOUND ==
+                   metrics->currentCategory());
+            }
         }
 
         if (verbose)
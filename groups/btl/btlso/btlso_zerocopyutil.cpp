@@ -0,0 +1,238 @@
+// btlso_zerocopyutil.cpp                                             -*-C++-*-
+#include <btlso_zerocopyutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(btlso_zerocopyutil_cpp,"$Id$ $CSID$")
+
+#include <btlso_socketimputil.h>
+
+#include <bsls_assert.h>
+#include <bsls_platform.h>
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+#include <bsl_c_errno.h>
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+
+// IMPLEMENTATION NOTES: The constants below are defined by the kernel headers
+// starting with Linux 4.14.  They are provided here when missing, so that a
+// binary built against older headers can still use zero-copy transmission
+// when run on a newer kernel; on an older kernel, 'enable' fails with
+// 'ENOPROTOOPT'.
+
+namespace BloombergLP {
+
+namespace {
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+
+enum {
+#if defined(SO_ZEROCOPY)
+    k_SO_ZEROCOPY                = SO_ZEROCOPY,
+#else
+    k_SO_ZEROCOPY                = 60,
+#endif
+#if defined(MSG_ZEROCOPY)
+    k_MSG_ZEROCOPY               = MSG_ZEROCOPY,
+#else
+    k_MSG_ZEROCOPY               = 0x4000000,
+#endif
+#if defined(SO_EE_ORIGIN_ZEROCOPY)
+    k_SO_EE_ORIGIN_ZEROCOPY      = SO_EE_ORIGIN_ZEROCOPY,
+#else
+    k_SO_EE_ORIGIN_ZEROCOPY      = 5,
+#endif
+#if defined(SO_EE_CODE_ZEROCOPY_COPIED)
+    k_SO_EE_CODE_ZEROCOPY_COPIED = SO_EE_CODE_ZEROCOPY_COPIED
+#else
+    k_SO_EE_CODE_ZEROCOPY_COPIED = 1
+#endif
+};
+
+#endif
+
+}  // close unnamed namespace
+
+namespace btlso {
+
+                            // -------------------
+                            // struct ZeroCopyUtil
+                            // -------------------
+
+// CLASS METHODS
+bool ZeroCopyUtil::isSupported()
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+int ZeroCopyUtil::enable(const SocketHandle::Handle&  handle,
+                         int                         *errorCode)
+{
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    int one = 1;
+    if (0 == ::setsockopt(handle,
+                          SOL_SOCKET,
+                          k_SO_ZEROCOPY,
+                          &one,
+                          sizeof one)) {
+        return 0;                                                     // RETURN
+    }
+
+    if (errorCode) {
+        *errorCode = errno;
+    }
+    return -1;
+#else
+    (void)handle;
+    (void)errorCode;
+
+    return -1;
+#endif
+}
+
+int ZeroCopyUtil::writev(bool                        *isPending,
+                         const SocketHandle::Handle&  handle,
+                         const btls::Ovec            *buffers,
+                         int                          numBuffers,
+                         int                         *errorCode)
+{
+    BSLS_ASSERT(isPending);
+    BSLS_ASSERT(buffers);
+    BSLS_ASSERT(0 < numBuffers);
+
+    *isPending = false;
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    ::msghdr message = ::msghdr();
+    message.msg_iov    = reinterpret_cast< ::iovec *>(
+                                          const_cast<btls::Ovec *>(buffers));
+    message.msg_iovlen = numBuffers;
+
+    ssize_t rc = ::sendmsg(handle,
+                           &message,
+                           k_MSG_ZEROCOPY | MSG_NOSIGNAL);
+    if (0 < rc) {
+        // Note that, if zero-copy transmission was not enabled on 'handle',
+        // the kernel ignores 'MSG_ZEROCOPY', in which case no completion
+        // will be reported.  It is up to the caller not to use this function
+        // on such a socket (as documented).
+
+        *isPending = true;
+        return static_cast<int>(rc);                                  // RETURN
+    }
+
+    if (ENOBUFS != errno) {
+        int errorNumber = SocketImpUtil_Util::getErrorCode();
+        if (errorNumber && errorCode) {
+            *errorCode = errorNumber;
+        }
+        return errorNumber ? SocketImpUtil_Util::mapErrorCode(errorNumber)
+                           : static_cast<int>(rc);                    // RETURN
+    }
+
+    // The kernel could not pin the pages of 'buffers' (the amount of memory
+    // that can be locked on behalf of a socket is limited): copy instead.
+#endif
+
+    return SocketImpUtil::writev(handle, buffers, numBuffers, errorCode);
+}
+
+int ZeroCopyUtil::readCompletion(unsigned int                *first,
+                                 unsigned int                *last,
+                                 bool                        *isCopied,
+                                 const SocketHandle::Handle&  handle,
+                                 int                         *errorCode)
+{
+    BSLS_ASSERT(first);
+    BSLS_ASSERT(last);
+    BSLS_ASSERT(isCopied);
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+    while (1) {
+        // The control message carries a 'sock_extended_err' followed by the
+        // address of the offending peer, if any.
+
+        char control[CMSG_SPACE(sizeof(::sock_extended_err)
+                              + sizeof(::sockaddr_in6))];
+
+        ::msghdr message = ::msghdr();
+        message.msg_control    = control;
+        message.msg_controllen = sizeof control;
+
+        if (0 > ::recvmsg(handle, &message, MSG_ERRQUEUE | MSG_DONTWAIT)) {
+            int errorNumber = SocketImpUtil_Util::getErrorCode();
+            if (errorCode) {
+                *errorCode = errorNumber;
+            }
+            return SocketImpUtil_Util::mapErrorCode(errorNumber);     // RETURN
+        }
+
+        for (::cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+             cmsg;
+             cmsg = CMSG_NXTHDR(&message, cmsg)) {
+            const bool isIpv4Error = SOL_IP     == cmsg->cmsg_level
+                                  && IP_RECVERR == cmsg->cmsg_type;
+            const bool isIpv6Error = SOL_IPV6     == cmsg->cmsg_level
+                                  && IPV6_RECVERR == cmsg->cmsg_type;
+
+            if (!isIpv4Error && !isIpv6Error) {
+                continue;
+            }
+
+            const ::sock_extended_err *error =
+                     reinterpret_cast<const ::sock_extended_err *>(
+                                                             CMSG_DATA(cmsg));
+
+            if (0 != error->ee_errno
+             || k_SO_EE_ORIGIN_ZEROCOPY != error->ee_origin) {
+                continue;
+            }
+
+            *first    = error->ee_info;
+            *last     = error->ee_data;
+            *isCopied = k_SO_EE_CODE_ZEROCOPY_COPIED == error->ee_code;
+            return 0;                                                 // RETURN
+        }
+
+        // This notification did not report a zero-copy completion: discard
+        // it and read the next one.
+    }
+#else
+    (void)first;
+    (void)last;
+    (void)isCopied;
+    (void)handle;
+    (void)errorCode;
+
+    return SocketHandle::e_ERROR_WOULDBLOCK;
+#endif
+}
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
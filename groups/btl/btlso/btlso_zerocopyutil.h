@@ -0,0 +1,188 @@
+// btlso_zerocopyutil.h                                               -*-C++-*-
+#ifndef INCLUDED_BTLSO_ZEROCOPYUTIL
+#define INCLUDED_BTLSO_ZEROCOPYUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide operations to transmit socket data without copying it.
+//
+//@CLASSES:
+//   btlso::ZeroCopyUtil: namespace for zero-copy transmission operations
+//
+//@SEE_ALSO: btlso_socketimputil btlso_ioutil
+//
+//@DESCRIPTION: This component provides a namespace, 'btlso::ZeroCopyUtil',
+// for a collection of pure procedures to write data to a stream socket
+// without copying it into the socket's send buffer.  Instead, the kernel pins
+// the pages holding the data and transmits directly from them, so the data
+// must stay unmodified (and its memory allocated) until the kernel reports
+// that it no longer references it.
+//
+// Zero-copy transmission must first be enabled on a socket with 'enable'.
+// Each successful call to 'writev' that reports a pending completion is
+// assigned a sequence number: the first is 0, and each following one is one
+// more than the previous (modulo 2^32).  Completions are read, in ranges of
+// sequence numbers, from the socket's error queue with 'readCompletion'.  A
+// non-empty error queue is reported as an error (and thus a read and write)
+// event by the event managers of this package, so the owner of a socket
+// enabled for zero-copy transmission must drain completions whenever it is
+// notified of either event.
+//
+// The kernel may decide to copy the data after all (e.g., when transmitting
+// over the loopback interface, where the receiving socket would otherwise
+// reference the sender's pages); a completion is still reported, and
+// 'readCompletion' indicates that the data was copied.  Because pinning
+// pages and reading completions has a cost of its own, zero-copy transmission
+// pays off only for large writes (typically more than 10KB).
+//
+///Platform Dependencies
+///---------------------
+// Zero-copy transmission is supported on Linux 4.14 and later, using
+// 'MSG_ZEROCOPY'.  On other platforms 'isSupported' returns 'false',
+// 'enable' fails, and 'writev' copies the data as 'SocketImpUtil::writev'
+// does, never reporting a pending completion.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sending a Large Buffer
+///- - - - - - - - - - - - - - - - -
+// First, we enable zero-copy transmission on a connected TCP socket, 'handle':
+//..
+//  int rc = btlso::ZeroCopyUtil::enable(handle);
+//  if (0 != rc) {
+//      // Zero-copy transmission is not available; use
+//      // 'btlso::SocketImpUtil::writev' instead.
+//  }
+//..
+// Then, we send a buffer that must not be modified until it is transmitted:
+//..
+//  btls::Ovec ovec(buffer, bufferSize);
+//
+//  bool isPending = false;
+//  int  numBytes  = btlso::ZeroCopyUtil::writev(&isPending, handle, &ovec, 1);
+//  assert(0 < numBytes);
+//  assert(isPending);                // sequence number 0
+//..
+// Finally, we wait for the transmission to complete before releasing
+// 'buffer':
+//..
+//  unsigned int first, last;
+//  bool         isCopied;
+//  while (btlso::SocketHandle::e_ERROR_WOULDBLOCK ==
+//         btlso::ZeroCopyUtil::readCompletion(&first,
+//                                             &last,
+//                                             &isCopied,
+//                                             handle)) {
+//      // wait for an error event on 'handle'
+//  }
+//  assert(0 == first);
+//  assert(0 == last);
+//..
+
+#ifndef INCLUDED_BTLSCM_VERSION
+#include <btlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BTLSO_SOCKETHANDLE
+#include <btlso_sockethandle.h>
+#endif
+
+#ifndef INCLUDED_BTLS_IOVEC
+#include <btls_iovec.h>
+#endif
+
+namespace BloombergLP {
+
+namespace btlso {
+
+                            // ===================
+                            // struct ZeroCopyUtil
+                            // ===================
+
+struct ZeroCopyUtil {
+    // This class provides a namespace for pure procedures to transmit data
+    // over a stream socket without copying it into the socket's send buffer.
+    // Note that all methods take an 'errorCode' as an optional parameter,
+    // which is loaded with a platform-specific error number if an error occurs
+    // during the operation.
+
+    // CLASS METHODS
+    static bool isSupported();
+        // Return 'true' if zero-copy transmission is supported on this
+        // platform, and 'false' otherwise.  Note that a socket may still fail
+        // to be enabled for zero-copy transmission on a supporting platform
+        // (e.g., if the running kernel predates the feature, or if the socket
+        // is not a TCP socket).
+
+    static int enable(const SocketHandle::Handle&  handle,
+                      int                         *errorCode = 0);
+        // Enable zero-copy transmission on the socket having the specified
+        // 'handle', and load into the optionally specified 'errorCode' the
+        // native error code of the operation, if any.  Return 0 (with no
+        // effect on 'errorCode') on success, and a non-zero value otherwise.
+
+    static int writev(bool                        *isPending,
+                      const SocketHandle::Handle&  handle,
+                      const btls::Ovec            *buffers,
+                      int                          numBuffers,
+                      int                         *errorCode = 0);
+        // Write to the socket having the specified 'handle' the data in the
+        // specified 'numBuffers' 'buffers' without copying it, if possible,
+        // and load into the specified 'isPending' flag whether the write
+        // consumed the next sequence number of the socket and is awaiting
+        // completion; the data written must not be modified nor deallocated
+        // until the completion is read by 'readCompletion'.  Return the
+        // number of bytes written on success, and a negative value otherwise,
+        // loading into the optionally specified 'errorCode' the native error
+        // code of the operation.  A return value of
+        // 'SocketHandle::e_ERROR_WOULDBLOCK' indicates that the socket buffer
+        // is full.  If zero-copy transmission was not enabled on the socket,
+        // or if the kernel cannot pin the pages of the data, the data is
+        // written (and copied) as by 'SocketImpUtil::writev' and 'isPending'
+        // is loaded with 'false'.  The behavior is undefined unless
+        // '0 < numBuffers' and 'handle' refers to a stream socket.
+
+    static int readCompletion(unsigned int                *first,
+                              unsigned int                *last,
+                              bool                        *isCopied,
+                              const SocketHandle::Handle&  handle,
+                              int                         *errorCode = 0);
+        // Read the next zero-copy completion from the error queue of the
+        // socket having the specified 'handle', without blocking, and load
+        // into the specified 'first' and 'last' the (inclusive) range of
+        // sequence numbers of the completed writes and into the specified
+        // 'isCopied' flag whether the kernel copied the data of any of them.
+        // Return 0 on success, 'SocketHandle::e_ERROR_WOULDBLOCK' if no
+        // completion is pending, and another negative value otherwise,
+        // loading into the optionally specified 'errorCode' the native error
+        // code of the operation.  Notifications in the error queue that do not
+        // report zero-copy completions are discarded.  Note that 'first' may
+        // be greater than 'last' if the range wraps around 2^32.
+};
+
+}  // close package namespace
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
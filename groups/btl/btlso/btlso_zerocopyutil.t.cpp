@@ -0,0 +1,631 @@
+// btlso_zerocopyutil.t.cpp                                           -*-C++-*-
+#include <btlso_zerocopyutil.h>
+
+#include <btlso_ioutil.h>
+#include <btlso_sockethandle.h>
+#include <btlso_socketimputil.h>
+
+#include <btls_iovec.h>
+
+#include <bsls_platform.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+#if defined(BSLS_PLATFORM_OS_UNIX)
+    #define BTLSO_ZEROCOPYUTIL_ENABLETEST
+#endif
+
+#ifdef BTLSO_ZEROCOPYUTIL_ENABLETEST
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                              TEST PLAN
+//-----------------------------------------------------------------------------
+//                              OVERVIEW
+// The component under test is a utility wrapping the system calls used for
+// zero-copy transmission.  We exercise it over TCP connections on the loopback
+// interface, where the kernel always ends up copying the data but otherwise
+// reports completions exactly as for a remote peer.  We verify that the data
+// is transmitted intact, that each write awaiting completion is assigned the
+// next sequence number, and that completions cover exactly those sequence
+// numbers.  If the running kernel does not support zero-copy transmission,
+// only the failure of 'enable' is verified.
+//-----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 1] static bool isSupported();
+// [ 2] static int enable(handle, errorCode);
+// [ 3] static int writev(isPending, handle, buffers, numBuffers, errorCode);
+// [ 3] static int readCompletion(first, last, isCopied, handle, errorCode);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT(X) { aSsErT(!(X), #X, __LINE__); }
+
+#define LOOP_ASSERT(I,X) { \
+   if (!(X)) { cout << #I << ": " << I << "\n"; aSsErT(1, #X, __LINE__); }}
+
+#define LOOP2_ASSERT(I,J,X) { \
+   if (!(X)) { cout << #I << ": " << I << "\t" << #J << ": " \
+              << J << "\n"; aSsErT(1, #X, __LINE__); } }
+
+#define P(X) cout << #X " = " << (X) << endl;
+#define P_(X) cout << #X " = " << (X) << ", " << flush;
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef btlso::ZeroCopyUtil         Obj;
+typedef btlso::SocketHandle::Handle Handle;
+
+// ============================================================================
+//                            HELPER FUNCTIONS
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int openTcpPair(Handle *client, Handle *server)
+    // Load into the specified 'client' and 'server' the handles of the two
+    // ends of a new non-blocking TCP connection over the loopback interface.
+    // Return 0 on success, and a non-zero value otherwise.
+{
+    Handle listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return -1;                                                    // RETURN
+    }
+
+    sockaddr_in address;
+    bsl::memset(&address, 0, sizeof address);
+    address.sin_family      = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port        = 0;
+
+    socklen_t length = sizeof address;
+    if (0 != ::bind(listener, (sockaddr *)&address, sizeof address)
+     || 0 != ::listen(listener, 1)
+     || 0 != ::getsockname(listener, (sockaddr *)&address, &length)) {
+        ::close(listener);
+        return -1;                                                    // RETURN
+    }
+
+    *client = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (*client < 0
+     || 0 != ::connect(*client, (sockaddr *)&address, sizeof address)) {
+        ::close(listener);
+        return -1;                                                    // RETURN
+    }
+
+    *server = ::accept(listener, 0, 0);
+    ::close(listener);
+    if (*server < 0) {
+        ::close(*client);
+        return -1;                                                    // RETURN
+    }
+
+    btlso::IoUtil::setBlockingMode(*client, btlso::IoUtil::e_NONBLOCKING);
+    btlso::IoUtil::setBlockingMode(*server, btlso::IoUtil::e_NONBLOCKING);
+    return 0;
+}
+
+int drain(bsl::vector<char> *result, Handle handle)
+    // Append to the specified 'result' all the data currently available on
+    // the socket having the specified 'handle'.  Return the number of bytes
+    // read.
+{
+    char buffer[65536];
+    int  total = 0;
+    while (1) {
+        int rc = static_cast<int>(::read(handle, buffer, sizeof buffer));
+        if (rc <= 0) {
+            return total;                                             // RETURN
+        }
+        result->insert(result->end(), buffer, buffer + rc);
+        total += rc;
+    }
+}
+
+void waitForEvent(Handle handle)
+    // Wait, for at most one second, until the socket having the specified
+    // 'handle' is readable, writable or has a pending error.
+{
+    pollfd pfd;
+    pfd.fd      = handle;
+    pfd.events  = POLLIN | POLLOUT;
+    pfd.revents = 0;
+    ::poll(&pfd, 1, 1000);
+}
+
+}  // close unnamed namespace
+
+#endif  // BTLSO_ZEROCOPYUTIL_ENABLETEST
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+#ifdef BTLSO_ZEROCOPYUTIL_ENABLETEST
+    const int  test        = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose     = argc > 2;
+    const bool veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    btlso::SocketImpUtil::startup();
+
+    switch (test) { case 0:
+      case 4: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, replace 'assert' with
+        //:   'ASSERT', and insert 'if (veryVerbose)' before all output
+        //:   operations.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        Handle handle, peer;
+        ASSERT(0 == openTcpPair(&handle, &peer));
+
+        const int bufferSize = 100 * 1024;
+        bsl::vector<char> storage(bufferSize, 'x');
+        char *buffer = storage.data();
+
+        int rc = btlso::ZeroCopyUtil::enable(handle);
+        if (0 != rc) {
+            // Zero-copy transmission is not available; use
+            // 'btlso::SocketImpUtil::writev' instead.
+
+            if (verbose) cout << "Zero-copy transmission unavailable."
+                              << endl;
+            ::close(handle);
+            ::close(peer);
+            break;
+        }
+
+        btls::Ovec ovec(buffer, bufferSize);
+
+        bool isPending = false;
+        int  numBytes  = btlso::ZeroCopyUtil::writev(&isPending,
+                                                     handle,
+                                                     &ovec,
+                                                     1);
+        ASSERT(0 < numBytes);
+        ASSERT(isPending);                // sequence number 0
+
+        unsigned int first, last;
+        bool         isCopied;
+        bsl::vector<char> received;
+        while (btlso::SocketHandle::e_ERROR_WOULDBLOCK ==
+               btlso::ZeroCopyUtil::readCompletion(&first,
+                                                   &last,
+                                                   &isCopied,
+                                                   handle)) {
+            // wait for an error event on 'handle'
+
+            drain(&received, peer);
+            waitForEvent(handle);
+        }
+        ASSERT(0 == first);
+        ASSERT(0 == last);
+
+        ::close(handle);
+        ::close(peer);
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'writev' AND 'readCompletion'
+        //
+        // Concerns:
+        //: 1 'writev' transmits the data of all the buffers, in order.
+        //:
+        //: 2 Each write on an enabled socket is awaiting completion, and is
+        //:   assigned the next sequence number, starting at 0.
+        //:
+        //: 3 'readCompletion' reports 'e_ERROR_WOULDBLOCK' when no completion
+        //:   is pending.
+        //:
+        //: 4 The ranges reported by 'readCompletion' cover every sequence
+        //:   number exactly once.
+        //:
+        //: 5 A socket with a pending completion is reported as readable or
+        //:   writable with an error by 'poll' (as it is by the event
+        //:   managers).
+        //
+        // Plan:
+        //: 1 Open a loopback TCP connection and enable zero-copy transmission
+        //:   on one end.  Verify that no completion is pending.  (C-3)
+        //:
+        //: 2 Write a number of multi-buffer messages with distinct contents,
+        //:   draining the other end and reading completions as they become
+        //:   available, until all the data is received and all the
+        //:   completions are read.  Verify the received data and the
+        //:   completion ranges.  (C-1..2, 4)
+        //:
+        //: 3 Write one more message, drain the other end, and verify that
+        //:   'poll' reports an error on the socket until its completion is
+        //:   read.  (C-5)
+        //
+        // Testing:
+        //   static int writev(isPending, handle, buffers, numBuffers, ...);
+        //   static int readCompletion(first, last, isCopied, handle, ...);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'writev' AND 'readCompletion'" << endl
+                          << "=====================================" << endl;
+
+        Handle client, server;
+        ASSERT(0 == openTcpPair(&client, &server));
+
+        if (0 != Obj::enable(client)) {
+            if (verbose) cout << "Zero-copy transmission unavailable."
+                              << endl;
+            ::close(client);
+            ::close(server);
+            break;
+        }
+
+        unsigned int first, last;
+        bool         isCopied;
+        ASSERT(btlso::SocketHandle::e_ERROR_WOULDBLOCK ==
+                        Obj::readCompletion(&first, &last, &isCopied, client));
+
+        enum {
+            k_NUM_MESSAGES = 64,
+            k_NUM_BUFFERS  = 4,
+            k_BUFFER_SIZE  = 16 * 1024,
+            k_MESSAGE_SIZE = k_NUM_BUFFERS * k_BUFFER_SIZE
+        };
+
+        bsl::vector<char> sent(k_NUM_MESSAGES * k_MESSAGE_SIZE);
+        for (int i = 0; i < static_cast<int>(sent.size()); ++i) {
+            sent[i] = static_cast<char>(i * 7 + i / k_BUFFER_SIZE);
+        }
+
+        bsl::vector<char> received;
+        bsl::vector<int>  numCompletions;
+        unsigned int      nextId      = 0;
+        int               numSent     = 0;
+        int               numReceived = 0;
+        int               numCopied   = 0;
+        int               numPending  = 0;
+        const int         total       = static_cast<int>(sent.size());
+
+        while (numReceived < total || 0 < numPending) {
+            if (numSent < total) {
+                // Write the remainder of the current message.
+
+                btls::Ovec ovecs[k_NUM_BUFFERS];
+                int        numVecs = 0;
+                int        offset  = numSent;
+                int        end     = (numSent / k_MESSAGE_SIZE + 1)
+                                                             * k_MESSAGE_SIZE;
+                while (offset < end) {
+                    int size = k_BUFFER_SIZE - offset % k_BUFFER_SIZE;
+                    ovecs[numVecs++].setBuffer(&sent[offset], size);
+                    offset += size;
+                }
+
+                bool isPending = false;
+                int  rc        = Obj::writev(&isPending,
+                                             client,
+                                             ovecs,
+                                             numVecs);
+                if (0 < rc) {
+                    LOOP_ASSERT(numSent, isPending);
+                    numSent += rc;
+                    if (isPending) {
+                        numCompletions.push_back(0);
+                        ++nextId;
+                        ++numPending;
+                    }
+                }
+                else {
+                    LOOP_ASSERT(rc,
+                              btlso::SocketHandle::e_ERROR_WOULDBLOCK == rc);
+                }
+            }
+
+            numReceived += drain(&received, server);
+
+            while (0 == Obj::readCompletion(&first,
+                                            &last,
+                                            &isCopied,
+                                            client)) {
+                LOOP2_ASSERT(first, last, first <= last);
+                LOOP2_ASSERT(last, nextId, last < nextId);
+                for (unsigned int id = first; id <= last; ++id) {
+                    if (id < numCompletions.size()) {
+                        ++numCompletions[id];
+                    }
+                    --numPending;
+                }
+                numCopied += isCopied;
+            }
+
+            if (numSent == total) {
+                waitForEvent(client);
+            }
+        }
+
+        if (veryVerbose) {
+            P_(nextId) P(numCopied)
+        }
+
+        ASSERT(0 == numPending);
+        ASSERT(sent == received);
+        for (unsigned int id = 0; id < nextId; ++id) {
+            LOOP2_ASSERT(id, numCompletions[id], 1 == numCompletions[id]);
+        }
+
+        if (verbose) cout << "\tError event on a pending completion." << endl;
+        {
+            btls::Ovec ovec(&sent[0], k_BUFFER_SIZE);
+            bool       isPending = false;
+            ASSERT(k_BUFFER_SIZE == Obj::writev(&isPending, client, &ovec, 1));
+            ASSERT(isPending);
+
+            received.clear();
+            while (static_cast<int>(received.size()) < k_BUFFER_SIZE) {
+                drain(&received, server);
+            }
+
+            pollfd pfd;
+            pfd.fd      = client;
+            pfd.events  = POLLIN;
+            pfd.revents = 0;
+
+            int rc = 0;
+            for (int i = 0; i < 100 && !(pfd.revents & POLLERR); ++i) {
+                rc = ::poll(&pfd, 1, 10);
+            }
+            ASSERT(1 == rc);
+            ASSERT(pfd.revents & POLLERR);
+
+            ASSERT(0 == Obj::readCompletion(&first,
+                                            &last,
+                                            &isCopied,
+                                            client));
+            LOOP_ASSERT(first, nextId == first);
+            LOOP_ASSERT(last,  nextId == last);
+
+            pfd.revents = 0;
+            ASSERT(0 == ::poll(&pfd, 1, 0));
+        }
+
+        ::close(client);
+        ::close(server);
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'enable'
+        //
+        // Concerns:
+        //: 1 'enable' succeeds on a TCP socket if zero-copy transmission is
+        //:   supported by the running kernel.
+        //:
+        //: 2 'enable' fails on a socket that is not a TCP socket, loading
+        //:   'errorCode'.
+        //:
+        //: 3 'enable' fails on an invalid handle, loading 'errorCode'.
+        //:
+        //: 4 'enable' always fails if 'isSupported' is 'false'.
+        //
+        // Plan:
+        //: 1 Call 'enable' on a TCP socket, a UNIX domain stream socket, and
+        //:   an invalid handle, and verify the results.  (C-1..4)
+        //
+        // Testing:
+        //   static int enable(handle, errorCode);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'enable'" << endl
+                          << "================" << endl;
+
+        Handle tcp = ::socket(AF_INET, SOCK_STREAM, 0);
+        ASSERT(0 <= tcp);
+
+        int errorCode = 0;
+        int rc        = Obj::enable(tcp, &errorCode);
+        if (!Obj::isSupported()) {
+            ASSERT(0 != rc);
+        }
+        else if (0 != rc) {
+            // Only an older kernel may reject the option on a TCP socket.
+
+            LOOP_ASSERT(errorCode, ENOPROTOOPT == errorCode);
+            if (verbose) cout << "Zero-copy transmission unavailable."
+                              << endl;
+        }
+        else {
+            ASSERT(0 == errorCode);
+        }
+        ::close(tcp);
+
+        Handle pair[2];
+        ASSERT(0 == ::socketpair(AF_UNIX, SOCK_STREAM, 0, pair));
+
+        errorCode = 0;
+        ASSERT(0 != Obj::enable(pair[0], &errorCode));
+        ASSERT(0 != errorCode || !Obj::isSupported());
+
+        ::close(pair[0]);
+        ::close(pair[1]);
+
+        errorCode = 0;
+        ASSERT(0 != Obj::enable(-1, &errorCode));
+        ASSERT(0 != errorCode || !Obj::isSupported());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Send a message with and without zero-copy transmission enabled
+        //:   over a loopback TCP connection, and verify that it is received,
+        //:   and that a completion is reported only in the former case.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        //   static bool isSupported();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+#if defined(BSLS_PLATFORM_OS_LINUX)
+        ASSERT(Obj::isSupported());
+#else
+        ASSERT(!Obj::isSupported());
+#endif
+
+        Handle client, server;
+        ASSERT(0 == openTcpPair(&client, &server));
+
+        const char MESSAGE[] = "Hello, world!";
+        const int  LENGTH    = sizeof MESSAGE - 1;
+
+        btls::Ovec ovec(MESSAGE, LENGTH);
+
+        unsigned int first, last;
+        bool         isCopied;
+
+        {
+            ASSERT(LENGTH == btlso::SocketImpUtil::writev(client, &ovec, 1));
+
+            bsl::vector<char> received;
+            while (static_cast<int>(received.size()) < LENGTH) {
+                drain(&received, server);
+            }
+            ASSERT(0 == bsl::memcmp(MESSAGE, received.data(), LENGTH));
+            ASSERT(btlso::SocketHandle::e_ERROR_WOULDBLOCK ==
+                        Obj::readCompletion(&first, &last, &isCopied, client));
+        }
+
+        if (0 == Obj::enable(client)) {
+            bool isPending = false;
+            ASSERT(LENGTH == Obj::writev(&isPending, client, &ovec, 1));
+            ASSERT(isPending);
+
+            bsl::vector<char> received;
+            while (static_cast<int>(received.size()) < LENGTH) {
+                drain(&received, server);
+            }
+            ASSERT(0 == bsl::memcmp(MESSAGE, received.data(), LENGTH));
+
+            int rc;
+            while (btlso::SocketHandle::e_ERROR_WOULDBLOCK ==
+                   (rc = Obj::readCompletion(&first,
+                                             &last,
+                                             &isCopied,
+                                             client))) {
+                waitForEvent(client);
+            }
+            ASSERT(0 == rc);
+            ASSERT(0 == first);
+            ASSERT(0 == last);
+
+            if (veryVerbose) { P(isCopied) }
+        }
+        else if (verbose) {
+            cout << "Zero-copy transmission unavailable." << endl;
+        }
+
+        ::close(client);
+        ::close(server);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      } break;
+    }
+
+    btlso::SocketImpUtil::cleanup();
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+#else
+    return -1;
+#endif  // BTLSO_ZEROCOPYUTIL_ENABLETEST
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2018 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------